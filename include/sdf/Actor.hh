@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <ignition/math/Pose3.hh>
 #include <ignition/utils/ImplPtr.hh>
@@ -182,10 +183,100 @@ namespace sdf
     /// \param[in] _waypoint Waypoint to be added.
     public: void AddWaypoint(const Waypoint &_waypoint);
 
+    /// \brief Get the times of the waypoints, in contiguous memory. The
+    /// waypoints are sorted by time, waypoints with the same time keeping
+    /// their order, so these are in the order of WaypointByIndex when the
+    /// waypoints are given in time order.
+    /// \return The time in seconds of each waypoint.
+    public: const std::vector<double> &WaypointTimes() const;
+
+    /// \brief Get the poses of the waypoints, in contiguous memory and in
+    /// the order of WaypointTimes().
+    /// \return The pose of each waypoint.
+    public: const std::vector<ignition::math::Pose3d> &WaypointPoses() const;
+
+    /// \brief Sample the trajectory. The position follows a cubic Hermite
+    /// spline through the waypoints, with tangents scaled by
+    /// 1 - Tension(): a tension of 0 is a Catmull-Rom spline and a tension
+    /// of 1 stops at each waypoint. The orientation is interpolated with a
+    /// spherical linear interpolation between waypoints. Times before the
+    /// first waypoint and after the last one get the pose of that waypoint.
+    /// \param[in] _time Time in seconds, counted from the beginning of the
+    /// script.
+    /// \return The pose at _time, or the identity pose if the trajectory
+    /// has no waypoint.
+    public: ignition::math::Pose3d Sample(double _time) const;
+
+    /// \brief Sample the trajectory, starting the search for the waypoints
+    /// around _time at a cursor. When the trajectory is sampled at
+    /// increasing times, the search only moves forward from the previous
+    /// sample, which takes constant time per sample. Other times fall back
+    /// to a binary search. Each sequence of samples, such as each actor
+    /// that follows the trajectory, uses its own cursor.
+    /// \param[in] _time Time in seconds, counted from the beginning of the
+    /// script.
+    /// \param[in,out] _cursor Index of the waypoint found by the previous
+    /// sample, updated for the next one. Start with 0.
+    /// \return The pose at _time.
+    /// \sa Sample(double) const
+    public: ignition::math::Pose3d Sample(double _time,
+                                          uint64_t &_cursor) const;
+
+    /// \brief Batched sampling reads the waypoint arrays directly.
+    /// \sa SampleTrajectories
+    public: friend SDFORMAT_VISIBLE void SampleTrajectories(
+        const std::vector<const Trajectory *> &_trajectories, double _time,
+        std::vector<ignition::math::Pose3d> &_poses);
+
+    /// \brief Batched sampling reads the waypoint arrays directly.
+    /// \sa SampleTrajectories
+    public: friend SDFORMAT_VISIBLE void SampleTrajectories(
+        const std::vector<const Trajectory *> &_trajectories, double _time,
+        std::vector<ignition::math::Pose3d> &_poses,
+        std::vector<uint64_t> &_cursors);
+
     /// \brief Private data pointer.
     IGN_UTILS_IMPL_PTR(dataPtr)
   };
 
+  /// \brief Sample many trajectories at the same time, such as the
+  /// trajectories of all the actors of a world. The result is the same as
+  /// calling Trajectory::Sample for each trajectory, but the waypoints of
+  /// all the trajectories are first gathered into contiguous arrays, which
+  /// are then interpolated in loops that the compiler can vectorize.
+  /// Trajectories that share their waypoint times, as actors that follow
+  /// the same script do, also share the search for the waypoints around
+  /// _time.
+  /// \param[in] _trajectories The trajectories. A null trajectory gets the
+  /// identity pose.
+  /// \param[in] _time Time in seconds, counted from the beginning of the
+  /// scripts.
+  /// \param[out] _poses The pose of each trajectory at _time, resized to
+  /// the number of trajectories.
+  /// \sa Trajectory::Sample(double) const
+  SDFORMAT_VISIBLE
+  void SampleTrajectories(
+      const std::vector<const Trajectory *> &_trajectories, double _time,
+      std::vector<ignition::math::Pose3d> &_poses);
+
+  /// \brief Sample many trajectories at the same time, with a cursor per
+  /// trajectory, as Trajectory::Sample(double, uint64_t &) const does.
+  /// \param[in] _trajectories The trajectories. A null trajectory gets the
+  /// identity pose.
+  /// \param[in] _time Time in seconds, counted from the beginning of the
+  /// scripts.
+  /// \param[out] _poses The pose of each trajectory at _time, resized to
+  /// the number of trajectories.
+  /// \param[in,out] _cursors The cursor of each trajectory, updated for
+  /// the next samples. It is resized to the number of trajectories, new
+  /// cursors starting at 0.
+  /// \sa Trajectory::Sample(double, uint64_t &) const
+  SDFORMAT_VISIBLE
+  void SampleTrajectories(
+      const std::vector<const Trajectory *> &_trajectories, double _time,
+      std::vector<ignition::math::Pose3d> &_poses,
+      std::vector<uint64_t> &_cursors);
+
 
   /// \brief Provides a description of an actor.
   class SDFORMAT_VISIBLE Actor
@@ -367,12 +458,24 @@ namespace sdf
     /// exists.
     public: bool AddLink(const Link &_link);
 
+    /// \brief Add a link to the actor, moving it instead of copying it.
+    /// \param[in] _link Link to add.
+    /// \return True if successful, false if a link with the name already
+    /// exists.
+    public: bool AddLink(Link &&_link);
+
     /// \brief Add a joint to the actor.
     /// \param[in] _link Joint to add.
     /// \return True if successful, false if a joint with the name already
     /// exists.
     public: bool AddJoint(const Joint &_joint);
 
+    /// \brief Add a joint to the actor, moving it instead of copying it.
+    /// \param[in] _link Joint to add.
+    /// \return True if successful, false if a joint with the name already
+    /// exists.
+    public: bool AddJoint(Joint &&_joint);
+
     /// \brief Remove all links.
     public: void ClearLinks();
 
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDF_BUNDLE_HH_
+#define SDF_BUNDLE_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/utils/ImplPtr.hh>
+
+#include "sdf/Error.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/ResourceProvider.hh"
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+
+// Forward declarations.
+class Root;
+
+/// \brief A document together with every file that is read to load it,
+/// such as included models and their model.config files, stored in a
+/// single bundle file. A bundle is read with one sequential read, and its
+/// files are then read from memory, so that loading it does not open the
+/// files one by one.
+///
+/// A bundle file starts with an index of its files, followed by the
+/// contents of each file, aligned to 8 bytes. The index also records how
+/// the URIs of the document were resolved when it was packed, so that it
+/// loads without the URI paths, SDF_PATH or find callback that were used
+/// to pack it.
+class SDFORMAT_VISIBLE Bundle
+{
+  /// \brief Default constructor, for a bundle without files.
+  public: Bundle();
+
+  /// \brief Load a document and write it to a bundle file, with every file
+  /// that was read to load it.
+  /// \param[in] _filename Name of the document.
+  /// \param[in] _bundlePath Path of the bundle file to write.
+  /// \param[in] _config Parser configuration used to load the document.
+  /// \return Errors of loading the document and of writing the bundle. The
+  /// bundle is only written if the document loads without errors.
+  public: static Errors Pack(const std::string &_filename,
+                             const std::string &_bundlePath,
+                             const ParserConfig &_config);
+
+  /// \brief Check whether a file is a bundle file, from its first bytes.
+  /// \param[in] _path Path of the file.
+  /// \return True if the file starts like a bundle file.
+  public: static bool IsBundleFile(const std::string &_path);
+
+  /// \brief Read a bundle file.
+  /// \param[in] _bundlePath Path of the bundle file.
+  /// \return Errors, which are empty if the bundle was read.
+  public: Errors Open(const std::string &_bundlePath);
+
+  /// \brief Get the path that the document of the bundle was loaded from
+  /// when it was packed.
+  /// \return The path, or an empty string if no bundle was read.
+  public: const std::string &MainFile() const;
+
+  /// \brief Get the paths of the files of the bundle.
+  /// \return The paths, in order.
+  public: std::vector<std::string> Files() const;
+
+  /// \brief Get the provider that reads the files of the bundle.
+  /// \return The provider, which stays valid when the bundle is destroyed.
+  public: std::shared_ptr<ResourceProvider> Provider() const;
+
+  /// \brief Configure a parser configuration to read the files of this
+  /// bundle. Its resource provider is set to Provider(), and the URIs that
+  /// were resolved when the bundle was packed resolve to the same files.
+  /// The find callback of the configuration is kept for the other URIs.
+  /// \param[in,out] _config The configuration.
+  public: void Configure(ParserConfig &_config) const;
+
+  /// \brief Load the document of the bundle.
+  /// \param[out] _root Root that the document is loaded into.
+  /// \param[in] _config Parser configuration, which is configured with
+  /// Configure before loading.
+  /// \return Errors of Root::Load.
+  public: Errors Load(Root &_root, const ParserConfig &_config) const;
+
+  /// \brief Private data pointer.
+  IGN_UTILS_IMPL_PTR(dataPtr)
+};
+}
+}
+#endif
@@ -18,6 +18,8 @@
 #define SDF_CAMERA_HH_
 
 #include <string>
+#include <vector>
+#include <ignition/math/Matrix3.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/utils/ImplPtr.hh>
 
@@ -56,6 +58,25 @@ namespace sdf
     BAYER_GRBG8,
   };
 
+  /// \brief Lookup table that undistorts the images of a camera. For each
+  /// pixel of the undistorted image, the table holds the coordinates of the
+  /// point of the distorted image to sample, in pixels. Pixels are stored
+  /// row by row, so the entry of pixel (u, v) is at index v * width + u.
+  struct CameraUndistortionMap
+  {
+    /// \brief Width of the image in pixels.
+    uint32_t width = 0;
+
+    /// \brief Height of the image in pixels.
+    uint32_t height = 0;
+
+    /// \brief X coordinates in the distorted image.
+    std::vector<float> x;
+
+    /// \brief Y coordinates in the distorted image.
+    std::vector<float> y;
+  };
+
   /// \brief Information about a monocular camera sensor.
   class SDFORMAT_VISIBLE Camera
   {
@@ -465,6 +486,23 @@ namespace sdf
     /// \param[in] _s The lens XY axis skew.
     public: void SetLensIntrinsicsSkew(double _s);
 
+    /// \brief Get the intrinsic matrix of the camera, which projects points
+    /// in the optical frame to pixels. The lens intrinsics are used if they
+    /// were set. Otherwise the focal length is derived from the horizontal
+    /// field of view and the image width, and the principal point is the
+    /// center of the image, as for a camera without custom intrinsics.
+    /// \return The matrix [fx s cx; 0 fy cy; 0 0 1].
+    public: ignition::math::Matrix3d IntrinsicsMatrix() const;
+
+    /// \brief Get the table that undistorts the images of the camera with
+    /// the Brown-Conrady model of the distortion coefficients, around the
+    /// distortion center, and with the focal lengths of IntrinsicsMatrix.
+    /// The table is computed on first use and kept until the image size,
+    /// field of view, intrinsics or distortion change.
+    /// \return The undistortion table. The reference is invalidated by the
+    /// next call after one of these parameters changes.
+    public: const CameraUndistortionMap &UndistortionMap() const;
+
     /// \brief Convert a string to a PixelFormatType.
     /// \param[in] _format String equivalent of a pixel format type to convert.
     /// \return The matching PixelFormatType.
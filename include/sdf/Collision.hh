@@ -33,6 +33,7 @@ namespace sdf
   inline namespace SDF_VERSION_NAMESPACE {
   //
   // Forward declaration.
+  class DomInterner;
   class Geometry;
   class Surface;
   struct PoseRelativeToGraph;
@@ -109,6 +110,17 @@ namespace sdf
     /// \return SemanticPose object for this link.
     public: sdf::SemanticPose SemanticPose() const;
 
+    /// \brief Resolve the pose of this collision relative to a frame, as
+    /// SemanticPose().Resolve() does, without constructing a SemanticPose.
+    /// If there are any errors resolving the pose, the output will not be
+    /// modified.
+    /// \param[out] _pose The resolved pose.
+    /// \param[in] _resolveTo The pose will be resolved with respect to this
+    /// frame. If unset or empty, the parent link will be used.
+    /// \return Errors in resolving pose.
+    public: Errors ResolvePose(ignition::math::Pose3d &_pose,
+                               const std::string &_resolveTo = "") const;
+
     /// \brief Get a pointer to the SDF element that was used during
     /// load.
     /// \return SDF element pointer. The value will be nullptr if Load has
@@ -135,11 +147,20 @@ namespace sdf
     private: void SetPoseRelativeToGraph(
         sdf::ScopedGraph<PoseRelativeToGraph> _graph);
 
+    /// \brief Share the geometry and surface of this collision with the
+    /// identical ones of other collisions. This is private and is intended
+    /// to be called by DomInterner when Root::Load shares identical objects.
+    /// \param[in,out] _interner The objects to share.
+    private: void ShareProperties(DomInterner &_interner);
+
     /// \brief Allow Link::SetPoseRelativeToGraph to call SetXmlParentName
     /// and SetPoseRelativeToGraph, but Link::SetPoseRelativeToGraph is
     /// a private function, so we need to befriend the entire class.
     friend class Link;
 
+    /// \brief Allow DomInterner to call ShareProperties.
+    friend class DomInterner;
+
     /// \brief Private data pointer.
     IGN_UTILS_IMPL_PTR(dataPtr)
   };
@@ -19,8 +19,10 @@
 #define SDF_CONSOLE_HH_
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <sdf/sdf_config.h>
@@ -92,6 +94,17 @@ namespace sdf
                           const std::string &_file,
                           unsigned int _line, int _color);
 
+      /// \brief Print a prefix to both terminal and log file. In
+      /// asynchronous mode, the prefix is only formatted when the message is
+      /// written, so the label and file must be string literals, such as
+      /// the ones given by the sdferr, sdfwarn, sdfmsg and sdfdbg macros.
+      /// \param[in] _lbl Text label
+      /// \param[in] _file File containing the error
+      /// \param[in] _line Line containing the error
+      /// \param[in] _color Color to make the label.  Used only on terminal.
+      public: void Prefix(const char *_lbl, const char *_file,
+                          unsigned int _line, int _color);
+
       /// \brief Set the stream object.
       /// \param[in] _stream Pointer to an output stream. This can be
       /// useful for redirecting the output, for example, to a std::stringstream
@@ -102,10 +115,23 @@ namespace sdf
       /// \return Pointer to current stream object.
       public: std::ostream *GetStream();
 
+      /// \brief Get the buffer of the message that the calling thread is
+      /// writing, when the console is in asynchronous mode.
+      /// \return The buffer, or nullptr if the console is synchronous.
+      private: std::ostream *AsyncBuffer();
+
+      /// \brief Queue the message that the calling thread is writing, if it
+      /// ends with a newline.
+      private: void AsyncCommit();
+
       /// \brief The ostream to log to; can be NULL/nullptr.
       private: std::ostream *stream;
     };
 
+    /// \brief Function that receives the log, one line at a time.
+    /// \param[in] _line A line of the log, with its final newline.
+    public: using LogCallback = std::function<void(const std::string &_line)>;
+
     /// \brief Default constructor
     private: Console();
 
@@ -122,6 +148,28 @@ namespace sdf
     /// \param[in] q True to prevent warning
     public: void SetQuiet(bool _q);
 
+    /// \brief Get whether warnings and messages are hidden from the
+    /// terminal.
+    /// \return True if the output is quiet.
+    /// \sa SetQuiet
+    public: bool Quiet() const;
+
+    /// \brief Get whether messages are written to a log, which is the log
+    /// file unless another sink was chosen with SetLogSink.
+    /// \return True if there is a log to write to.
+    public: bool HasLogSink() const;
+
+    /// \brief Get whether a warning written now would be shown on the
+    /// terminal or written to a log. Unlike Quiet and HasLogSink, this does
+    /// not lock the console, so it can be checked before every warning.
+    /// \return True if warnings are shown or logged.
+    public: static bool WarningsReported();
+
+    /// \brief Get whether a message written with Log now would be written
+    /// to a log, without locking the console.
+    /// \return True if there is a log to write to.
+    public: static bool LogReported();
+
     /// \brief Use this to output a colored message to the terminal
     /// \param[in] _lbl Text label
     /// \param[in] _file File containing the error
@@ -132,6 +180,17 @@ namespace sdf
                                     const std::string &file,
                                     unsigned int line, int color);
 
+    /// \brief Use this to output a colored message to the terminal. The
+    /// label and file must be string literals, as for
+    /// ConsoleStream::Prefix(const char *, const char *, unsigned int, int).
+    /// \param[in] _lbl Text label
+    /// \param[in] _file File containing the error
+    /// \param[in] _line Line containing the error
+    /// \param[in] _color Color to make the label
+    /// \return Reference to an output stream
+    public: ConsoleStream &ColorMsg(const char *_lbl, const char *_file,
+                                    unsigned int _line, int _color);
+
     /// \brief Use this to output a message to a log file at
     /// `$HOME/.sdformat/sdformat.log`.
     /// To disable this log file, define the following symbol when
@@ -141,6 +200,65 @@ namespace sdf
                                const std::string &file,
                                unsigned int line);
 
+    /// \brief Use this to output a message to the log file. The label and
+    /// file must be string literals, as for
+    /// ConsoleStream::Prefix(const char *, const char *, unsigned int, int).
+    /// \param[in] _lbl Text label
+    /// \param[in] _file File containing the message
+    /// \param[in] _line Line containing the message
+    /// \return Reference to output stream
+    public: ConsoleStream &Log(const char *_lbl, const char *_file,
+                               unsigned int _line);
+
+    /// \brief Enable or disable the asynchronous mode. In asynchronous mode,
+    /// each thread queues its messages in its own lock-free ring buffer,
+    /// and a background thread formats their prefixes and writes them to
+    /// the message stream and the log file. Threads that write many
+    /// messages then no longer wait for each other. A message is queued
+    /// when it ends with a newline. Messages of different threads may be
+    /// written in a different order than they were queued. Switch modes
+    /// while no other thread is writing messages.
+    /// \param[in] _async True to write the messages asynchronously, false
+    /// to write them synchronously, which is the default. Disabling the
+    /// asynchronous mode writes the queued messages first.
+    public: void SetAsync(bool _async);
+
+    /// \brief Get whether messages are written asynchronously.
+    /// \return True in asynchronous mode.
+    /// \sa SetAsync
+    public: bool Async() const;
+
+    /// \brief Wait until the messages queued in asynchronous mode are
+    /// written, such as before reading a stream given to
+    /// ConsoleStream::SetStream. Does nothing in synchronous mode.
+    public: void Flush();
+
+    /// \brief Write the log to a stream instead of the log file at
+    /// `$HOME/.sdformat/sdformat.log`. When this is called before the first
+    /// message, the console neither reads the environment nor touches the
+    /// filesystem. Otherwise the log file of the current console is closed.
+    /// \param[in] _stream Stream to write the log to, which must outlive its
+    /// use by the console, or nullptr to write no log.
+    public: static void SetLogSink(std::ostream *_stream);
+
+    /// \brief Give the log to a callback instead of writing it to the log
+    /// file at `$HOME/.sdformat/sdformat.log`. As for
+    /// SetLogSink(std::ostream *), the log file is then never created. The
+    /// callback is called while the log is locked, so it must not write
+    /// console messages.
+    /// \param[in] _callback Function that receives each line of the log.
+    public: static void SetLogSink(LogCallback _callback);
+
+    /// \brief Write the log to the log file at
+    /// `$HOME/.sdformat/sdformat.log` again, which is the default.
+    public: static void ResetLogSink();
+
+    /// \brief Enable or disable writing messages to the log file at
+    /// `$HOME/.sdformat/sdformat.log`. It is enabled by default.
+    /// \param[in] _enabled False to close the log file, true to open it
+    /// again and append to it.
+    public: void SetLogFileEnabled(bool _enabled);
+
     /// \brief Get the current message stream object. This can be
     /// useful for redirecting the output, for example, to a std::stringstream
     /// for testing.
@@ -173,21 +291,46 @@ namespace sdf
 
     /// \brief logfile stream
     public: std::ofstream logFileStream;
+
+    /// \brief Path of the log file, empty if there is none.
+    public: std::string logFilePath;
+
+    /// \brief Stream that the log is written to, which is logFileStream,
+    /// a stream given to Console::SetLogSink or logCallbackStream. Can be
+    /// NULL/nullptr.
+    public: std::ostream *logSink = nullptr;
+
+    /// \brief Stream that gives the log to a callback given to
+    /// Console::SetLogSink.
+    public: std::unique_ptr<std::ostream> logCallbackStream;
+
+    /// \brief Mutex that protects logFileStream and logSink, so that
+    /// messages can be written from several parsing threads.
+    public: std::mutex logFileMutex;
   };
 
   ///////////////////////////////////////////////
   template <class T>
   Console::ConsoleStream &Console::ConsoleStream::operator<<(const T &_rhs)
   {
+    if (std::ostream *buffer = this->AsyncBuffer())
+    {
+      *buffer << _rhs;
+      this->AsyncCommit();
+      return *this;
+    }
+
     if (this->stream)
     {
       *this->stream << _rhs;
     }
 
-    if (Console::Instance()->dataPtr->logFileStream.is_open())
+    ConsolePrivate *console = Console::Instance()->dataPtr.get();
+    std::lock_guard<std::mutex> lock(console->logFileMutex);
+    if (console->logSink)
     {
-      Console::Instance()->dataPtr->logFileStream << _rhs;
-      Console::Instance()->dataPtr->logFileStream.flush();
+      *console->logSink << _rhs;
+      console->logSink->flush();
     }
 
     return *this;
@@ -18,10 +18,17 @@
 #define SDF_ELEMENT_HH_
 
 #include <any>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -47,6 +54,7 @@ namespace sdf
   //
 
   class ElementPrivate;
+  class MemoryUsage;
   class SDFORMAT_VISIBLE Element;
 
   /// \def ElementPtr
@@ -68,6 +76,121 @@ namespace sdf
   /// \addtogroup sdf
   /// \{
 
+  /// \brief Range of child elements of an Element, returned by
+  /// Element::Children. It iterates over the vectors of the parent element by
+  /// reference, so iterating does not change reference counts nor search for
+  /// the current child in its parent. The range is invalidated when children
+  /// are added to or removed from the parent, or renamed.
+  class ElementChildren
+  {
+    /// \brief Iterator over the children of a range.
+    public: class Iterator
+    {
+      /// \brief Constructor.
+      /// \param[in] _it Position of the child in the vector.
+      /// \param[in] _end End of the vector.
+      /// \param[in] _name Name of the children to skip to, or nullptr to
+      /// iterate over all the children of the vector.
+      public: Iterator(ElementPtr_V::const_iterator _it,
+                       ElementPtr_V::const_iterator _end,
+                       const std::string *_name)
+        : it(_it), end(_end), name(_name)
+      {
+        this->SkipOtherNames();
+      }
+
+      /// \brief Get the current child.
+      /// \return Reference to the pointer of the child held by its parent.
+      public: const ElementPtr &operator*() const
+      {
+        return *this->it;
+      }
+
+      /// \brief Access the current child.
+      /// \return Pointer to the child.
+      public: Element *operator->() const
+      {
+        return this->it->get();
+      }
+
+      /// \brief Move to the next child.
+      /// \return Reference to this iterator.
+      public: Iterator &operator++()
+      {
+        ++this->it;
+        this->SkipOtherNames();
+        return *this;
+      }
+
+      /// \brief Equality operator.
+      /// \param[in] _other Iterator to compare to.
+      /// \return True if both iterators are at the same child.
+      public: bool operator==(const Iterator &_other) const
+      {
+        return this->it == _other.it;
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _other Iterator to compare to.
+      /// \return True if the iterators are at different children.
+      public: bool operator!=(const Iterator &_other) const
+      {
+        return this->it != _other.it;
+      }
+
+      /// \brief Skip the children that do not have the name of the range.
+      private: inline void SkipOtherNames();
+
+      /// \brief Position of the child.
+      private: ElementPtr_V::const_iterator it;
+
+      /// \brief End of the vector.
+      private: ElementPtr_V::const_iterator end;
+
+      /// \brief Name of the children, or nullptr.
+      private: const std::string *name;
+    };
+
+    /// \brief Constructor.
+    /// \param[in] _children Vector of children to iterate over.
+    /// \param[in] _name Name of the children to iterate over, or nullopt to
+    /// iterate over all the children of the vector.
+    public: ElementChildren(const ElementPtr_V &_children,
+                            std::optional<std::string> _name = std::nullopt)
+      : children(&_children), name(std::move(_name))
+    {
+    }
+
+    /// \brief Get an iterator to the first child.
+    /// \return The iterator.
+    public: Iterator begin() const
+    {
+      return Iterator(this->children->begin(), this->children->end(),
+                      this->name ? &*this->name : nullptr);
+    }
+
+    /// \brief Get an iterator past the last child.
+    /// \return The iterator.
+    public: Iterator end() const
+    {
+      return Iterator(this->children->end(), this->children->end(), nullptr);
+    }
+
+    /// \brief Check whether the range has no child.
+    /// \return True if there is no child.
+    public: bool empty() const
+    {
+      return this->begin() == this->end();
+    }
+
+    /// \brief Children to iterate over.
+    private: const ElementPtr_V *children;
+
+    /// \brief Name of the children to iterate over, or nullopt for all of
+    /// them.
+    private: std::optional<std::string> name;
+  };
+
   /// \class Element Element.hh sdf/sdf.hh
   /// \brief SDF Element class
   class SDFORMAT_VISIBLE Element :
@@ -80,6 +203,7 @@ namespace sdf
     public: virtual ~Element();
 
     /// \brief Create a copy of this Element.
+    /// The element descriptions are shared with the copy rather than cloned.
     /// \return A copy of this Element.
     public: ElementPtr Clone() const;
 
@@ -92,6 +216,14 @@ namespace sdf
     /// parent.
     public: ElementPtr GetParent() const;
 
+    /// \brief Get this Element's parent without taking a reference to it,
+    /// for read-only traversals of a tree that is kept alive, such as a
+    /// walk to the root.
+    /// \return Pointer to this Element's parent, nullptr if there is no
+    /// parent or if the parent was destroyed. The pointer is only valid
+    /// while the parent is alive.
+    public: Element *ParentRaw() const;
+
     /// \brief Set the parent of this Element.
     /// \param[in] _parent Parent for this element.
     public: void SetParent(const ElementPtr _parent);
@@ -139,6 +271,18 @@ namespace sdf
     /// \return True to copy child elements during parsing.
     public: bool GetCopyChildren() const;
 
+    /// \brief Set the XML text of this element, which is printed instead of
+    /// its attributes, value and children. The parser sets it on copied
+    /// elements when ParserConfig::CopyElementsAsRawXml is enabled.
+    /// \param[in] _xml The XML text of the element, or an empty string to
+    /// print the element from its attributes, value and children.
+    public: void SetRawXml(const std::string &_xml);
+
+    /// \brief Get the XML text of this element. The text is shared with
+    /// the clones of this element.
+    /// \return The XML text set with SetRawXml, or an empty string.
+    public: const std::string &RawXml() const;
+
     /// \brief Set reference SDF element.
     /// \param[in] _value Name of the reference sdf element.
     public: void SetReferenceSDF(const std::string &_value);
@@ -207,6 +351,34 @@ namespace sdf
         bool _includeDefaultAttributes,
         const PrintConfig &_config = PrintConfig()) const;
 
+    /// \brief Write the string representation of the element values to a
+    /// stream. The output is the same as the output of ToString, but it is
+    /// written as it is generated instead of being accumulated in a string,
+    /// which avoids holding a copy of large documents in memory.
+    /// \param[out] _out Stream to write to.
+    /// \param[in] _prefix String value to prefix to the output.
+    /// \param[in] _config Configuration for printing the values.
+    /// \sa ToString(const std::string &, const PrintConfig &) const
+    public: void ToStream(
+        std::ostream &_out,
+        const std::string &_prefix = "",
+        const PrintConfig &_config = PrintConfig()) const;
+
+    /// \brief Write the string representation of the element values to a
+    /// stream.
+    /// \param[out] _out Stream to write to.
+    /// \param[in] _prefix String value to prefix to the output.
+    /// \param[in] _includeDefaultElements flag to include default elements.
+    /// \param[in] _includeDefaultAttributes flag to include default attributes.
+    /// \param[in] _config Configuration for converting to string.
+    /// \sa ToString(const std::string &, bool, bool, const PrintConfig &) const
+    public: void ToStream(
+        std::ostream &_out,
+        const std::string &_prefix,
+        bool _includeDefaultElements,
+        bool _includeDefaultAttributes,
+        const PrintConfig &_config = PrintConfig()) const;
+
     /// \brief Add an attribute value.
     /// \param[in] _key Key value.
     /// \param[in] _type Type of data the attribute will hold.
@@ -267,15 +439,20 @@ namespace sdf
     /// \return The number of element descriptions.
     public: size_t GetElementDescriptionCount() const;
 
-    /// \brief Get an element description using an index
+    /// \brief Get an element description using an index. Descriptions are
+    /// shared by every element initialized from the same specification file,
+    /// so they are read-only; use Clone to get an element to modify.
     /// \param[in] _index the index of the element description to get.
     /// \return An Element pointer to the found element.
-    public: ElementPtr GetElementDescription(unsigned int _index) const;
+    public: ElementConstPtr GetElementDescription(unsigned int _index) const;
 
-    /// \brief Get an element description using a key
+    /// \brief Get an element description using a key. Descriptions are
+    /// shared by every element initialized from the same specification file,
+    /// so they are read-only; use Clone to get an element to modify.
     /// \param[in] _key the key to use to find the element.
     /// \return An Element pointer to the found element.
-    public: ElementPtr GetElementDescription(const std::string &_key) const;
+    public: ElementConstPtr GetElementDescription(
+                const std::string &_key) const;
 
     /// \brief Return true if an element description exists.
     /// \param[in] _name the name of the element to find.
@@ -339,6 +516,19 @@ namespace sdf
                      T &_param,
                      const T &_defaultValue) const;
 
+    /// \brief Get a pointer to the value of a key, without copying it. The
+    /// key is looked up like in Get, but no conversion is done if T is not
+    /// the type of the value.
+    /// \param[in] _key the name of a child attribute or element, or an empty
+    /// string for the value of this element.
+    /// \return Pointer to the value, or nullptr if _key is not found, T is
+    /// not the type of its value or the value could not be converted. The
+    /// pointer is valid until the value is changed or its element is
+    /// destroyed.
+    /// \sa Param::GetPtr
+    public: template<typename T>
+            const T *GetPtr(const std::string &_key = "") const;
+
     /// \brief Set the value of this element.
     /// \param[in] _value the value to set.
     /// \return True if the value was successfully set, false otherwise.
@@ -355,6 +545,27 @@ namespace sdf
     ///          sdf::ElementPtr(nullptr) if there are no children.
     public: ElementPtr GetFirstElement() const;
 
+    /// \brief Get the child elements, for iterating over them by reference
+    /// without copying their pointers, as GetFirstElement and
+    /// GetNextElement do.
+    /// \return The child elements, in document order. The reference is
+    /// invalidated when children are added or removed.
+    public: const ElementPtr_V &Elements() const;
+
+    /// \brief Get a range over the child elements, which can be iterated
+    /// without changing reference counts, for example
+    /// `for (const ElementPtr &child : elem->Children())`.
+    /// \return Range over the children, in document order.
+    public: ElementChildren Children() const;
+
+    /// \brief Get a range over the child elements with a name, which can be
+    /// iterated without changing reference counts nor searching for each
+    /// child, unlike GetNextElement. The name index of elements with many
+    /// children is used when there is one.
+    /// \param[in] _name Name of the children, such as "link".
+    /// \return Range over the children named _name, in document order.
+    public: ElementChildren Children(const std::string &_name) const;
+
     /// \brief Get the next sibling of this element.
     /// \param[in] _name if given then filter siblings by their xml tag.
     /// \remarks This function does not alter or store any state
@@ -476,6 +687,29 @@ namespace sdf
     /// \param[in] _child Pointer to the child to remove.
     public: void RemoveChild(ElementPtr _child);
 
+    /// \brief Replace a child element with another element, at the same
+    /// position among the children. The parent of the replacement is set to
+    /// this element.
+    /// \param[in] _child Pointer to the child to replace.
+    /// \param[in] _replacement Pointer to the element that replaces it.
+    /// \return True if _child is a child of this element and was replaced.
+    public: bool ReplaceChild(ElementPtr _child, ElementPtr _replacement);
+
+    /// \brief Remove the child elements that match a predicate, in a single
+    /// pass over the children, unlike calling RemoveChild for each of them.
+    /// The remaining children keep their order.
+    /// \param[in] _predicate Function that returns true for the children to
+    /// remove.
+    /// \return Number of children removed.
+    public: std::size_t RemoveChildrenIf(
+                const std::function<bool(const ElementPtr &)> &_predicate);
+
+    /// \brief Replace all the child elements at once. The parent of the new
+    /// children is set to this element, and the previous children that are
+    /// not among them no longer have a parent.
+    /// \param[in] _children The new children, in order.
+    public: void ReplaceChildren(ElementPtr_V _children);
+
     /// \brief Remove all child elements.
     public: void ClearElements();
 
@@ -487,9 +721,10 @@ namespace sdf
     ///        the embedded Param.
     public: void Update();
 
-    /// \brief Call reset on each element and element description
-    ///        before deleting all of them.  Also clear out the
-    ///        embedded Param.
+    /// \brief Call reset on each element before deleting all of them.
+    ///        References to the element descriptions, which may be
+    ///        shared with other elements, are released without resetting
+    ///        them. Also clear out the embedded Param.
     public: void Reset();
 
     /// \brief Set the <include> element that was used to load this element.
@@ -505,6 +740,17 @@ namespace sdf
     /// nullptr for Elements that cannot be included.
     public: sdf::ElementPtr GetIncludeElement() const;
 
+    /// \brief Get a hash of the contents of this element and its
+    /// descendants: the names, the values of the attributes, the values and
+    /// the raw XML of the elements, and the order of the children. File
+    /// paths, line numbers, XML paths and include elements are not part of
+    /// the contents, so equal subtrees read from different files have equal
+    /// hashes. The hash is computed from the hashes of the children, and is
+    /// cached until this element or one of its descendants is changed
+    /// through Element or Param functions.
+    /// \return The hash, which is never 0.
+    public: std::uint64_t ContentHash() const;
+
     /// \brief Set the path to the SDF document where this element came from.
     /// \param[in] _path Full path to SDF document.
     public: void SetFilePath(const std::string &_path);
@@ -558,7 +804,9 @@ namespace sdf
     /// \param[in] _desc the text description to set for the element.
     public: void SetDescription(const std::string &_desc);
 
-    /// \brief Add a new element description
+    /// \brief Add a new element description.
+    /// Element descriptions are shared by every Element created from them
+    /// and must not be modified once they have been added.
     /// \param[in] _elem the Element object to add to the descriptions.
     public: void AddElementDescription(ElementPtr _elem);
 
@@ -596,6 +844,25 @@ namespace sdf
                                   const PrintConfig &_config,
                                   std::ostringstream &_out) const;
 
+    /// \brief Write the string (XML) representation of this object and of
+    /// its children to a stream.
+    /// \param[in,out] _prefix Prefix of each line. The indentation of the
+    /// children is appended to it while they are written, so a single
+    /// buffer is used for every level, and removed afterwards.
+    /// \param[in] _includeDefaultElements flag to include default elements.
+    /// \param[in] _includeDefaultAttributes flag to include default attributes.
+    /// \param[in] _config Configuration for printing values.
+    /// \param[out] _out the std::ostream to write output to.
+    /// \param[in] _concurrent True if the children of this element, or of
+    /// its only child, may be written concurrently, as configured by
+    /// PrintConfig::SetThreadCount.
+    private: void WriteImpl(std::string &_prefix,
+                            bool _includeDefaultElements,
+                            bool _includeDefaultAttributes,
+                            const PrintConfig &_config,
+                            std::ostream &_out,
+                            bool _concurrent) const;
+
     /// \brief Create a new Param object and return it.
     /// \param[in] _key Key for the parameter.
     /// \param[in] _type String name for the value type (double,
@@ -610,42 +877,127 @@ namespace sdf
                                   bool _required,
                                   const std::string &_description = "");
 
+    /// \brief Append a child element and keep the child element name index
+    /// and position bookkeeping up to date.
+    /// \param[in] _elem Child element to append.
+    private: void PushElement(ElementPtr _elem);
+
+    /// \brief Remove the child element at the given position and keep the
+    /// child element name index and position bookkeeping up to date.
+    /// \param[in] _index Position of the child in the element list.
+    private: void EraseElement(std::size_t _index);
+
+    /// \brief Rebuild the child element name index from the element list.
+    /// The index is only built when the number of children is large enough
+    /// for a hash lookup to beat a linear scan.
+    private: void RebuildElementIndex();
+
+    /// \brief Get the position of this element in its parent's element list.
+    /// \param[in] _parent Parent of this element.
+    /// \return Position of this element, or the size of the parent's element
+    /// list if this element is not a child of _parent.
+    private: std::size_t IndexInParent(const Element &_parent) const;
+
+    /// \brief Discard the cached content hash of this element and of its
+    /// ancestors, after a change to this element.
+    private: void InvalidateContentHash();
+
+    /// \brief Allow MemoryUsage to account for the private data.
+    friend class MemoryUsage;
+
+    /// \brief Allow parameters to invalidate the content hash of their
+    /// element when their value changes.
+    friend class Param;
 
     /// \brief Private data pointer
     private: std::unique_ptr<ElementPrivate> dataPtr;
   };
 
+  /////////////////////////////////////////////////
+  void ElementChildren::Iterator::SkipOtherNames()
+  {
+    if (!this->name)
+      return;
+    while (this->it != this->end && (*this->it)->GetName() != *this->name)
+      ++this->it;
+  }
+
   /// \internal
-  /// \brief Private data for Element
-  class ElementPrivate
+  /// \brief One step of the XML path of an element. A node holds the part
+  /// of the path that follows the path of its parent node, so the elements
+  /// of a document share the common prefixes of their XML paths.
+  class XmlPathNode
   {
-    /// \brief Element name
-    public: std::string name;
+    /// \brief Constructor.
+    /// \param[in] _parent Node of the parent element's XML path.
+    /// \param[in] _segment Part of the XML path after the parent's path.
+    public: XmlPathNode(std::shared_ptr<const XmlPathNode> _parent,
+                        std::string _segment)
+      : parent(std::move(_parent)), segment(std::move(_segment))
+    {
+    }
 
-    /// \brief True if element is required
-    public: std::string required;
+    /// \brief Node of the parent element's XML path, or nullptr if the
+    /// segment is a full XML path.
+    public: std::shared_ptr<const XmlPathNode> parent;
 
-    /// \brief Element description
-    public: std::string description;
+    /// \brief Part of the XML path after the path of the parent node,
+    /// without the separating "/".
+    public: std::string segment;
 
-    /// \brief True if element's children should be copied.
-    public: bool copyChildren;
+    /// \brief Full XML path, assembled the first time it is requested.
+    public: mutable std::string path;
 
-    /// \brief Element's parent
-    public: ElementWeakPtr parent;
+    /// \brief Guards the assembly of the full XML path.
+    public: mutable std::once_flag pathOnce;
+  };
 
-    // Attributes of this element
-    public: Param_V attributes;
+  /// \internal
+  /// \brief Data of an element that comes from its description in the
+  /// specification, so it is the same for every element of a type. A
+  /// description shares its schema with the elements cloned from it, and an
+  /// element copies a shared schema before it modifies it.
+  class ElementSchema
+  {
+    /// \brief Index from a name to a position in a list of attributes or
+    /// element descriptions. Only the first position of a name is stored.
+    public: using NameIndex = std::unordered_map<std::string, std::size_t>;
 
-    // Value of this element
-    public: ParamPtr value;
+    /// \brief Element name. Names, requirement strings, descriptions and
+    /// reference names come from the specification, so they are interned
+    /// and shared between all elements with the same value.
+    public: InternedString name;
 
-    // The existing child elements
-    public: ElementPtr_V elements;
+    /// \brief True if element is required
+    public: InternedString required;
 
-    // The possible child elements
+    /// \brief Element description
+    public: InternedString description;
+
+    /// \brief Name of reference sdf.
+    public: InternedString referenceSDF;
+
+    /// \brief True if element's children should be copied.
+    public: bool copyChildren = false;
+
+    // The possible child elements. These are read-only schema descriptions.
     public: ElementPtr_V elementDescriptions;
 
+    /// \brief Index from element name to position in
+    /// `elementDescriptions`, or nullptr if there are no descriptions. It is
+    /// shared between copies of the schema until one of them changes it.
+    public: std::shared_ptr<NameIndex> descriptionIndex;
+  };
+
+  /// \internal
+  /// \brief Data of an element that most elements do not have. It is only
+  /// allocated when one of its members is set.
+  class ElementExtras
+  {
+    /// \brief XML text of the element, or nullptr. It is shared between
+    /// all clones of an element.
+    public: std::shared_ptr<const std::string> rawXml;
+
     /// \brief The <include> element that was used to load this entity. For
     /// example, given the following SDFormat:
     /// <sdf version='1.8'>
@@ -667,32 +1019,105 @@ namespace sdf
     /// <include> tag after the entity has been loaded. An example use case for
     /// this is when saving a loaded world back to SDFormat.
     public: ElementPtr includeElement;
+  };
 
-    /// \brief Name of reference sdf.
-    public: std::string referenceSDF;
+  /// \internal
+  /// \brief Private data for Element. The data that is the same for every
+  /// element of a type is in the shared schema, and the data that is
+  /// usually empty is in the extras, so that a typical element stays small.
+  class ElementPrivate
+  {
+    /// \brief Index from a name to a position in a list of attributes.
+    public: using NameIndex = ElementSchema::NameIndex;
+
+    /// \brief Type-level data of the element. It is never null, and new
+    /// elements share an empty schema until they are modified.
+    public: std::shared_ptr<const ElementSchema> schema;
+
+    /// \brief Get the schema to modify it, copying it first if it is
+    /// shared with other elements.
+    /// \return The schema of this element only.
+    public: ElementSchema &MutableSchema();
+
+    /// \brief Rarely set data, or nullptr if none of it is set.
+    public: std::unique_ptr<ElementExtras> extras;
+
+    /// \brief Get the extras to modify them, allocating them if needed.
+    /// \return The extras of this element.
+    public: ElementExtras &MutableExtras();
+
+    /// \brief Element's parent
+    public: ElementWeakPtr parent;
 
-    /// \brief Path to file where this element came from
-    public: std::string path;
+    /// \brief Pointer to the element's parent, set with `parent`, so that it
+    /// can be used without locking `parent` once it is known to be alive.
+    public: Element *parentRaw = nullptr;
 
-    /// \brief Spec version that this was originally parsed from.
-    public: std::string originalVersion;
+    // Attributes of this element
+    public: Param_V attributes;
+
+    /// \brief Index from attribute key to position in `attributes`, or
+    /// nullptr if it is not known. It is built while the schema is read and
+    /// shared with the clones of the element, which have the same attributes
+    /// in the same order. A shared index is copied before it is modified.
+    public: std::shared_ptr<NameIndex> attributeIndex;
+
+    // Value of this element
+    public: ParamPtr value;
+
+    // The existing child elements
+    public: ElementPtr_V elements;
+
+    /// \brief Index from child element name to the child elements with that
+    /// name, in document order, or nullptr. It is only populated for
+    /// elements with many children, and is kept consistent with `elements`
+    /// by every function that adds or removes children.
+    public: std::unique_ptr<std::unordered_map<std::string, ElementPtr_V>>
+                elementIndex;
+
+    /// \brief Position of this element in its parent's `elements` list.
+    public: std::uint32_t indexInParent = 0;
+
+    /// \brief Position of this element in its parent's `elementIndex` list
+    /// for this element's name. Only meaningful when the parent's index is
+    /// populated.
+    public: std::uint32_t indexInNamedList = 0;
+
+    /// \brief Path to file where this element came from, or nullptr if it is
+    /// empty. File paths are interned, so all the elements read from a file
+    /// share the same string.
+    public: std::shared_ptr<const std::string> path;
+
+    /// \brief Spec version that this was originally parsed from. Versions
+    /// are interned, as all the elements of a file have the same one.
+    public: InternedString originalVersion;
+
+    /// \brief Line number in file where this element came from, if
+    /// hasLineNumber is true.
+    public: int lineNumber = 0;
 
     /// \brief True if the element was set in the SDF file.
-    public: bool explicitlySetInFile;
+    public: bool explicitlySetInFile : 1;
 
-    /// \brief Line number in file where this element came from
-    public: std::optional<int> lineNumber;
+    /// \brief True if lineNumber is set.
+    public: bool hasLineNumber : 1;
 
-    /// \brief XML path of this element.
-    public: std::string xmlPath;
+    /// \brief XML path of this element, or nullptr if it is empty. Copies
+    /// and clones of the element share the same nodes.
+    public: std::shared_ptr<const XmlPathNode> xmlPath;
+
+    /// \brief Cached hash of the contents of the element, or 0 if it has to
+    /// be computed, see Element::ContentHash. If it is cached, the hashes of
+    /// all the descendants are cached too.
+    public: mutable std::atomic<std::uint64_t> contentHash{0};
 
     /// \brief Generate the string (XML) for the attributes.
     /// \param[in] _includeDefaultAttributes flag to include default attributes.
     /// \param[in] _config Configuration for printing attributes.
-    /// \param[out] _out the std::ostringstream to write output to.
+    /// \param[out] _out the std::ostream to write output to.
     public: void PrintAttributes(bool _includeDefaultAttributes,
                                  const PrintConfig &_config,
-                                 std::ostringstream &_out) const;
+                                 std::ostream &_out) const;
   };
 
   ///////////////////////////////////////////////
@@ -730,18 +1155,21 @@ namespace sdf
     }
     else if (!_key.empty())
     {
+      // Each of the attributes, children and descriptions is searched at
+      // most once.
       ParamPtr param = this->GetAttribute(_key);
       if (param)
       {
         param->Get(result.first);
       }
-      else if (this->HasElement(_key))
+      else if (ElementPtr child = this->GetElementImpl(_key))
       {
-        result.first = this->GetElementImpl(_key)->Get<T>();
+        result.first = child->Get<T>();
       }
-      else if (this->HasElementDescription(_key))
+      else if (ElementConstPtr description =
+                   this->GetElementDescription(_key))
       {
-        result.first = this->GetElementDescription(_key)->Get<T>();
+        result.first = description->Get<T>();
       }
       else
       {
@@ -756,6 +1184,27 @@ namespace sdf
     return result;
   }
 
+  ///////////////////////////////////////////////
+  template<typename T>
+  const T *Element::GetPtr(const std::string &_key) const
+  {
+    if (_key.empty())
+    {
+      if (this->dataPtr->value)
+        return this->dataPtr->value->GetPtr<T>();
+      return nullptr;
+    }
+
+    ParamPtr param = this->GetAttribute(_key);
+    if (param)
+      return param->GetPtr<T>();
+    if (ElementPtr child = this->GetElementImpl(_key))
+      return child->GetPtr<T>();
+    if (ElementConstPtr description = this->GetElementDescription(_key))
+      return description->GetPtr<T>();
+    return nullptr;
+  }
+
   ///////////////////////////////////////////////
   template<typename T>
   bool Element::Set(const T &_value)
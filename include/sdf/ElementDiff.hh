@@ -0,0 +1,115 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_ELEMENTDIFF_HH_
+#define SDF_ELEMENTDIFF_HH_
+
+#include <string>
+#include <vector>
+
+#include "sdf/Element.hh"
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+  class Root;
+
+  /// \enum ElementDifferenceType
+  /// \brief The kinds of differences between two element trees.
+  enum class ElementDifferenceType
+  {
+    /// \brief An element is only in the second tree.
+    ELEMENT_ADDED,
+
+    /// \brief An element is only in the first tree.
+    ELEMENT_REMOVED,
+
+    /// \brief An attribute is only in the second tree.
+    ATTRIBUTE_ADDED,
+
+    /// \brief An attribute is only in the first tree.
+    ATTRIBUTE_REMOVED,
+
+    /// \brief An attribute has different values in the two trees.
+    ATTRIBUTE_CHANGED,
+
+    /// \brief An element has different values, or different raw XML, in the
+    /// two trees.
+    VALUE_CHANGED,
+  };
+
+  /// \brief A difference between two element trees, see diffElements.
+  struct ElementDifference
+  {
+    /// \brief Kind of difference.
+    ElementDifferenceType type = ElementDifferenceType::VALUE_CHANGED;
+
+    /// \brief XML path of the element that differs, such as
+    /// /sdf/world[@name="default"]/model[@name="box"]/static. Children that
+    /// are not named are numbered from 0 when there are several of them.
+    std::string xmlPath;
+
+    /// \brief Name of the attribute that differs, or an empty string if the
+    /// difference is not about an attribute.
+    std::string attribute;
+
+    /// \brief Value in the first tree, or an empty string. The value of an
+    /// element that was removed is its XML.
+    std::string before;
+
+    /// \brief Value in the second tree, or an empty string. The value of an
+    /// element that was added is its XML.
+    std::string after;
+  };
+
+  /// \brief Compare two element trees structurally. Children are matched
+  /// by element name and name attribute, or by their position among the
+  /// children with the same element name if they are not named, so that
+  /// the order of named children does not matter. Values are compared as
+  /// numbers when both are lists of numbers, such as doubles, vectors and
+  /// poses, so that the formatting of numbers does not matter. Subtrees
+  /// with the same Element::ContentHash are skipped without being compared.
+  /// \param[in] _before The first tree.
+  /// \param[in] _after The second tree.
+  /// \param[in] _tolerance Largest absolute difference between numbers that
+  /// are considered equal.
+  /// \return The differences, in the order of the first tree, followed by
+  /// the elements that were added. The vector is empty if the trees are
+  /// equivalent.
+  SDFORMAT_VISIBLE
+  std::vector<ElementDifference> diffElements(const ElementPtr &_before,
+      const ElementPtr &_after, double _tolerance = 0.0);
+
+  /// \brief Compare the DOM of two Root objects, through the elements
+  /// generated by Root::ToElement, so that elements added with default
+  /// values while loading and elements set through the DOM are both taken
+  /// into account. See diffElements.
+  /// \param[in] _before The first Root.
+  /// \param[in] _after The second Root.
+  /// \param[in] _tolerance Largest absolute difference between numbers that
+  /// are considered equal.
+  /// \return The differences. The vector is empty if the DOMs are
+  /// equivalent.
+  SDFORMAT_VISIBLE
+  std::vector<ElementDifference> diffRoots(const Root &_before,
+      const Root &_after, double _tolerance = 0.0);
+  }
+}
+#endif
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDF_ENTITYTABLES_HH_
+#define SDF_ENTITYTABLES_HH_
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Inertial.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "sdf/Geometry.hh"
+#include "sdf/Joint.hh"
+#include "sdf/Sensor.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+
+/// \brief Tables of the models, links, collisions, joints and sensors of a
+/// world, resolved by World::ResolveEntityTables for consumers that process
+/// every entity of a world, such as physics engines and renderers. Each
+/// table is a set of columns with one entry per entity, and each column is
+/// a contiguous array, so a table can be processed in parallel loops
+/// without following pointers between the DOM objects.
+///
+/// The entities of all levels of nesting are in the same tables, in the
+/// order of Model::ResolveAllPoses, and refer to the entities that contain
+/// them by their index in the other tables. The names of the entities are
+/// not scoped. The poses are resolved relative to the world frame.
+struct EntityTables
+{
+  /// \brief Value of the indices that do not refer to an entity, such as
+  /// the parent of a model that is not nested.
+  static constexpr uint64_t kNoIndex = std::numeric_limits<uint64_t>::max();
+
+  /// \brief Table of the models, where a model always comes after its
+  /// parent model.
+  struct ModelTable
+  {
+    /// \brief Name of each model.
+    std::vector<std::string> names;
+
+    /// \brief Index of the parent model of each model, or kNoIndex for a
+    /// model of the world.
+    std::vector<uint64_t> parents;
+
+    /// \brief Pose of each model.
+    std::vector<ignition::math::Pose3d> poses;
+  };
+
+  /// \brief Table of the links.
+  struct LinkTable
+  {
+    /// \brief Name of each link.
+    std::vector<std::string> names;
+
+    /// \brief Index of the model of each link.
+    std::vector<uint64_t> models;
+
+    /// \brief Inertial of each link, relative to the link frame.
+    std::vector<ignition::math::Inertiald> inertials;
+
+    /// \brief Pose of each link.
+    std::vector<ignition::math::Pose3d> poses;
+  };
+
+  /// \brief Table of the collisions.
+  struct CollisionTable
+  {
+    /// \brief Name of each collision.
+    std::vector<std::string> names;
+
+    /// \brief Index of the link of each collision.
+    std::vector<uint64_t> links;
+
+    /// \brief Type of the geometry of each collision.
+    std::vector<GeometryType> geometryTypes;
+
+    /// \brief Dimensions of the geometry of each collision, which depend on
+    /// its type:
+    /// - box: the size;
+    /// - sphere: the radius, then zeros;
+    /// - cylinder and capsule: the radius, the length, then zero;
+    /// - ellipsoid: the radii;
+    /// - plane: the size, then zero;
+    /// - heightmap: the size;
+    /// - mesh: the scale;
+    /// - other types: zeros.
+    std::vector<ignition::math::Vector3d> geometryParameters;
+
+    /// \brief Pose of each collision.
+    std::vector<ignition::math::Pose3d> poses;
+  };
+
+  /// \brief Table of the joints.
+  struct JointTable
+  {
+    /// \brief Name of each joint.
+    std::vector<std::string> names;
+
+    /// \brief Index of the model of each joint.
+    std::vector<uint64_t> models;
+
+    /// \brief Type of each joint.
+    std::vector<JointType> types;
+
+    /// \brief Index of the resolved parent link of each joint, or kNoIndex
+    /// if the parent is the world or is not resolved.
+    std::vector<uint64_t> parentLinks;
+
+    /// \brief Index of the resolved child link of each joint, or kNoIndex
+    /// if it is not resolved.
+    std::vector<uint64_t> childLinks;
+
+    /// \brief Pose of each joint.
+    std::vector<ignition::math::Pose3d> poses;
+  };
+
+  /// \brief Table of the sensors of the links and the joints.
+  struct SensorTable
+  {
+    /// \brief Name of each sensor.
+    std::vector<std::string> names;
+
+    /// \brief Index of the link of each sensor, or kNoIndex for a sensor of
+    /// a joint.
+    std::vector<uint64_t> links;
+
+    /// \brief Index of the joint of each sensor, or kNoIndex for a sensor of
+    /// a link.
+    std::vector<uint64_t> joints;
+
+    /// \brief Type of each sensor.
+    std::vector<SensorType> types;
+
+    /// \brief Update rate of each sensor, in Hz.
+    std::vector<double> updateRates;
+
+    /// \brief Pose of each sensor.
+    std::vector<ignition::math::Pose3d> poses;
+  };
+
+  /// \brief The models.
+  ModelTable models;
+
+  /// \brief The links.
+  LinkTable links;
+
+  /// \brief The collisions.
+  CollisionTable collisions;
+
+  /// \brief The joints.
+  JointTable joints;
+
+  /// \brief The sensors.
+  SensorTable sensors;
+};
+}
+}
+#endif
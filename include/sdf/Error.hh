@@ -20,6 +20,7 @@
 #include <iostream>
 #include <string>
 #include <optional>
+#include <vector>
 #include <ignition/utils/ImplPtr.hh>
 #include <sdf/sdf_config.h>
 #include "sdf/system_util.hh"
@@ -147,6 +148,20 @@ namespace sdf
     /// \brief Merge include is unspported for the type of entity being
     /// included, or the custom parser does not support merge includes.
     MERGE_INCLUDE_UNSUPPORTED,
+
+    /// \brief Indicates that writing an SDF file failed.
+    FILE_WRITE,
+
+    /// \brief Loading was cancelled before it completed.
+    LOAD_CANCELLED,
+
+    /// \brief Loading stopped because the number of errors reached the
+    /// limit set with ParserConfig::SetMaxErrors.
+    ERROR_LIMIT_REACHED,
+
+    /// \brief The joints of a model do not form a tree, because a link is
+    /// the child of several joints or the joints form a loop.
+    KINEMATIC_TREE_INVALID,
   };
 
   class SDFORMAT_VISIBLE Error
@@ -178,6 +193,34 @@ namespace sdf
     public: Error(const ErrorCode _code, const std::string &_message,
                   const std::string &_filePath, int _lineNumber);
 
+    /// \brief Constructor for an error whose message is given as a format
+    /// and arguments, and is only formatted when it is read with Message().
+    /// Each "{}" in the format is replaced by the next argument. This saves
+    /// formatting messages of errors that are handled by their code or
+    /// discarded.
+    /// \param[in] _code The error code.
+    /// \param[in] _format Format of the message, with a "{}" for each
+    /// argument.
+    /// \param[in] _args Arguments of the message, such as the names of the
+    /// elements the error is about.
+    /// \sa ErrorCode.
+    public: Error(const ErrorCode _code, const std::string &_format,
+                  std::vector<std::string> _args);
+
+    /// \brief Constructor for an error whose message is given as a format
+    /// and arguments, and is only formatted when it is read with Message().
+    /// \param[in] _code The error code.
+    /// \param[in] _format Format of the message, with a "{}" for each
+    /// argument.
+    /// \param[in] _args Arguments of the message.
+    /// \param[in] _filePath The file path that is related to this error.
+    /// \param[in] _lineNumber The line number in the provided file path where
+    /// this error was raised.
+    /// \sa ErrorCode.
+    public: Error(const ErrorCode _code, const std::string &_format,
+                  std::vector<std::string> _args,
+                  const std::string &_filePath, int _lineNumber);
+
     /// \brief Get the error code.
     /// \return An error code.
     /// \sa ErrorCode.
@@ -187,6 +230,12 @@ namespace sdf
     /// \return Error message.
     public: std::string Message() const;
 
+    /// \brief Get the arguments of a message that was given as a format and
+    /// arguments.
+    /// \return The arguments, in the order of the format. Empty if the
+    /// message was given whole.
+    public: const std::vector<std::string> &MessageArgs() const;
+
     /// \brief Get the file path associated with this error.
     /// \return Returns the path of the file that this error is related to,
     /// nullopt otherwise.
@@ -18,8 +18,10 @@
 #ifndef SDF_FILESYSTEM_HH_
 #define SDF_FILESYSTEM_HH_
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <ignition/utils/ImplPtr.hh>
 #include <sdf/sdf_config.h>
@@ -45,6 +47,13 @@ namespace sdf
     SDFORMAT_VISIBLE
     bool is_directory(const std::string &_path);
 
+    /// \brief Determine whether the given path is a regular file, following
+    ///        symbolic links.
+    /// \param[in] _path  The path to check.
+    /// \return True if _path is a regular file, false otherwise.
+    SDFORMAT_VISIBLE
+    bool is_regular_file(const std::string &_path);
+
     /// \brief Create a new directory on the filesystem.  Intermediate
     ///        directories must already exist.
     /// \param[in] _path  The new directory path to create
@@ -87,6 +96,115 @@ namespace sdf
     SDFORMAT_VISIBLE
     std::string basename(const std::string &_path);
 
+    /// \brief Get the time at which a file was last modified.
+    /// \param[in] _path  The path of the file.
+    /// \param[out] _time  The modification time, in nanoseconds since an
+    ///        unspecified epoch. It is only meant to be compared with other
+    ///        times returned by this function.
+    /// \return True if the modification time could be read, false otherwise.
+    SDFORMAT_VISIBLE
+    bool last_write_time(const std::string &_path, std::int64_t &_time);
+
+    /// \brief Create a directory along with any missing parent directories.
+    /// \param[in] _path  The path of the directory to create.
+    /// \return True if the directory exists after the call, false otherwise.
+    SDFORMAT_VISIBLE
+    bool create_directories(const std::string &_path);
+
+    /// \brief Rename a file, replacing the file at the new path if there is
+    ///        one. Where the file system supports it, such as on POSIX
+    ///        systems, the replacement is atomic, so that a file can be
+    ///        written to a temporary path and then moved to its final path.
+    /// \param[in] _from  The current path of the file.
+    /// \param[in] _to  The new path of the file.
+    /// \return True if the file was renamed, false otherwise.
+    SDFORMAT_VISIBLE
+    bool rename(const std::string &_from, const std::string &_to);
+
+    /// \brief Remove a file or an empty directory.
+    /// \param[in] _path  The path to remove.
+    /// \return True if the path was removed, false otherwise, including
+    ///         when it did not exist.
+    SDFORMAT_VISIBLE
+    bool remove(const std::string &_path);
+
+    /// \brief Determine whether a path is absolute.
+    /// \param[in] _path  The path to check.
+    /// \return True if _path is an absolute path, false otherwise.
+    SDFORMAT_VISIBLE
+    bool is_absolute(const std::string &_path);
+
+    /// \brief Get the path of the directory that contains a path, without
+    ///        accessing the file system.
+    /// \param[in] _path  The path.
+    /// \return _path without its last component, or an empty string if it
+    ///         has only one component.
+    SDFORMAT_VISIBLE
+    std::string parent_path(const std::string &_path);
+
+    /// \brief Determine whether two paths refer to the same file.
+    /// \param[in] _path1  The first path.
+    /// \param[in] _path2  The second path.
+    /// \return True if both paths exist and refer to the same file, false
+    ///         otherwise.
+    SDFORMAT_VISIBLE
+    bool equivalent(const std::string &_path1, const std::string &_path2);
+
+    /// \brief Get an absolute form of a path, without "." or ".."
+    ///        components and with symbolic links resolved for the part of
+    ///        the path that exists, so that paths to the same file can be
+    ///        compared.
+    /// \param[in] _path  The path.
+    /// \return The resolved path, or _path unchanged if it could not be
+    ///         resolved.
+    SDFORMAT_VISIBLE
+    std::string weakly_canonical(const std::string &_path);
+
+    /// \brief Type of a directory entry.
+    enum class FileType
+    {
+      /// \brief The type could not be determined.
+      UNKNOWN,
+
+      /// \brief A regular file.
+      REGULAR,
+
+      /// \brief A directory.
+      DIRECTORY,
+
+      /// \brief A symbolic link. The link is not followed, so it may point
+      /// to a file, a directory or nothing.
+      SYMLINK,
+
+      /// \brief Any other kind of file, such as a device or a socket.
+      OTHER
+    };
+
+    /// \brief An entry of a directory.
+    struct DirEntry
+    {
+      /// \brief Name of the entry, without the directory path.
+      std::string name;
+
+      /// \brief Type of the entry.
+      FileType type = FileType::UNKNOWN;
+    };
+
+    /// \brief Read all the entries of a directory at once, skipping the . and
+    ///        .. entries. Unlike DirIter, the type of each entry is returned
+    ///        along with its name, taken from the directory listing where the
+    ///        file system provides it, so enumerating a directory tree does
+    ///        not require a call to is_directory for every entry. Full paths
+    ///        are not built; use append on the names that are needed.
+    /// \param[in] _path  The directory to read.
+    /// \param[out] _entries  The entries of the directory, in the order the
+    ///        file system returns them. The vector is cleared first, so it
+    ///        can be reused to read several directories without allocating.
+    /// \return True if the directory could be read, false otherwise.
+    SDFORMAT_VISIBLE
+    bool read_directory(const std::string &_path,
+                        std::vector<DirEntry> &_entries);
+
     /// \class DirIter Filesystem.hh
     /// \brief A class for iterating over all items in a directory.
     class SDFORMAT_VISIBLE DirIter
@@ -35,6 +35,8 @@ namespace sdf
   // Forward declaration.
   struct FrameAttachedToGraph;
   struct PoseRelativeToGraph;
+  template <typename T> class NameIndex;
+  class NameIndexRenames;
   template <typename T> class ScopedGraph;
 
   /// \brief A Frame element descibes the properties associated with an
@@ -124,6 +126,18 @@ namespace sdf
     /// \return SemanticPose object for this link.
     public: sdf::SemanticPose SemanticPose() const;
 
+    /// \brief Resolve the pose of this frame relative to a frame, as
+    /// SemanticPose().Resolve() does, without constructing a SemanticPose.
+    /// If there are any errors resolving the pose, the output will not be
+    /// modified.
+    /// \param[out] _pose The resolved pose.
+    /// \param[in] _resolveTo The pose will be resolved with respect to this
+    /// frame. If unset or empty, the model or world frame of its scope will
+    /// be used.
+    /// \return Errors in resolving pose.
+    public: Errors ResolvePose(ignition::math::Pose3d &_pose,
+                               const std::string &_resolveTo = "") const;
+
     /// \brief Give a scoped FrameAttachedToGraph to be used for resolving
     /// attached bodies. This is private and is intended to be called by
     /// Model::Load or World::Load.
@@ -138,6 +152,16 @@ namespace sdf
     private: void SetPoseRelativeToGraph(
         sdf::ScopedGraph<PoseRelativeToGraph> _graph);
 
+    /// \brief Set the record of the names that the frames of the vector
+    /// holding this frame were renamed to, which SetName adds to. This is
+    /// private and is intended to be called by the NameIndex of the vector.
+    /// \param[in] _renames The record.
+    private: void SetNameIndexRenames(
+        std::shared_ptr<NameIndexRenames> _renames);
+
+    /// \brief Allow NameIndex to call SetNameIndexRenames.
+    template <typename T> friend class NameIndex;
+
     /// \brief Allow Model::Load and World::Load to call SetPoseRelativeToGraph.
     friend class Model;
     friend class World;
@@ -17,6 +17,10 @@
 #ifndef SDF_GEOMETRY_HH_
 #define SDF_GEOMETRY_HH_
 
+#include <cstdint>
+#include <optional>
+
+#include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/utils/ImplPtr.hh>
 #include <sdf/Error.hh>
 #include <sdf/Element.hh>
@@ -183,6 +187,34 @@ namespace sdf
     /// \param[in] _heightmap The heightmap shape.
     public: void SetHeightmapShape(const Heightmap &_heightmap);
 
+    /// \brief Get the smallest axis-aligned box that contains the shape, in
+    /// the frame of the geometry. Planes are infinite, except along a normal
+    /// that is aligned with an axis. The bounds of a mesh are its extents,
+    /// given by Mesh::SetExtents, multiplied by its scale.
+    /// \return The box, which is empty for an EMPTY geometry, or nullopt if
+    /// the bounds of the shape are not known, such as for a mesh without
+    /// extents.
+    public: std::optional<ignition::math::AxisAlignedBox>
+                AxisAlignedBox() const;
+
+    /// \brief Get an ID of the shape, so that the users of several
+    /// geometries with the same shape, such as physics engines, can share
+    /// the objects they make for it. The ID is a hash of the element that
+    /// the geometry was loaded from, or of ToElement() once a setter was
+    /// called, and of the file path and extents of a mesh and the file path
+    /// of a heightmap. It is the same on every run, and geometries loaded
+    /// from identical elements of any file have the same ID, unless their
+    /// relative URIs are resolved from different files.
+    /// \return The ID.
+    public: std::uint64_t ShapeId() const;
+
+    /// \brief Check whether a geometry has the same shape as this one,
+    /// comparing what ShapeId is a hash of instead of the hashes, so that
+    /// geometries whose IDs collide are told apart.
+    /// \param[in] _geom The other geometry.
+    /// \return True if the geometries have the same shape.
+    public: bool SameShape(const Geometry &_geom) const;
+
     /// \brief Get a pointer to the SDF element that was used during
     /// load.
     /// \return SDF element pointer. The value will be nullptr if Load has
@@ -196,6 +228,12 @@ namespace sdf
     /// \return SDF element pointer with updated geometry values.
     public: sdf::ElementPtr ToElement() const;
 
+    /// \brief Get the element that ShapeId and SameShape read the shape
+    /// from: the element the geometry was loaded from, or ToElement() once
+    /// a setter was called.
+    /// \return The element.
+    private: sdf::ElementPtr ShapeElement() const;
+
     /// \brief Private data pointer.
     IGN_UTILS_IMPL_PTR(dataPtr)
   };
@@ -53,6 +53,13 @@ using InterfaceModelConstPtr = std::shared_ptr<const InterfaceModel>;
 using RepostureFunction =
     std::function<void(const sdf::InterfaceModelPoseGraph &)>;
 
+/// \brief Function signature for the callback that adds the children of an
+/// interface model on demand. The links, frames, joints and nested models
+/// added to the model passed to the callback are appended to the children of
+/// the interface model.
+using InterfaceModelChildrenFunction =
+    std::function<void(sdf::InterfaceModel &)>;
+
 /// \brief Interface element representing a Model
 class SDFORMAT_VISIBLE InterfaceModel
 {
@@ -78,10 +85,18 @@ class SDFORMAT_VISIBLE InterfaceModel
   /// \return Local name of the model.
   public: const std::string &Name() const;
 
+  /// \brief Set the name of the model.
+  /// \param[in] _name The *local* name of the model.
+  public: void SetName(const std::string &_name);
+
   /// \brief Get whether the model is static.
   /// \return Whether the model is static.
   public: bool Static() const;
 
+  /// \brief Set whether the model is static.
+  /// \param[in] _static Whether the model is static.
+  public: void SetStatic(bool _static);
+
   /// \brief Get the canonical link name.
   /// \remark Unlike Model::CanonicalLinkName which simply returns
   /// the value of //model/@canonical_link without resolving to an actual link,
@@ -93,6 +108,27 @@ class SDFORMAT_VISIBLE InterfaceModel
   /// \return Pose of this model in the parent model frame.
   public: const ignition::math::Pose3d &ModelFramePoseInParentFrame() const;
 
+  /// \brief Set a callback that adds the children of the model the first
+  /// time they are needed, which lets a custom parser defer the parsing of
+  /// the internals of large models. The callback is called once, from the
+  /// first call to NestedModels, Frames, Joints or Links. Children added
+  /// with AddNestedModel, AddFrame, AddJoint and AddLink are available
+  /// without calling the callback and must include the canonical link.
+  ///
+  /// While the frame graphs are built, the callback is only called for
+  /// models that have a reposture function or a placement frame, or whose
+  /// name is used as a scope (e.g. "model::link") by a reference of the
+  /// document that includes them. The graphs of the other models only
+  /// contain the children added without the callback.
+  /// \param[in] _function The callback, or nullptr to unset it.
+  public: void SetChildrenFunction(
+              const sdf::InterfaceModelChildrenFunction &_function);
+
+  /// \brief Get whether the callback set with SetChildrenFunction was
+  /// called.
+  /// \return True if the model has no such callback or if it was called.
+  public: bool ChildrenLoaded() const;
+
   /// \brief Provided so that hierarchy can still be leveraged from SDFormat.
   /// \param[in] _nestedModel A child interface model.
   public: void AddNestedModel(sdf::InterfaceModelConstPtr _nestedModel);
@@ -132,6 +168,35 @@ class SDFORMAT_VISIBLE InterfaceModel
   /// \brief[in] _val True if the custom parser supports merge-include.
   public: void SetParserSupportsMergeInclude(bool _val);
 
+  /// \brief Call the callback set with SetChildrenFunction, if it was not
+  /// called yet.
+  private: void LoadChildren() const;
+
+  /// \brief Check whether a reposture callback is set.
+  /// \return True if the model has a reposture callback.
+  private: bool HasRepostureFunction() const;
+
+  /// \brief Get the child interface models added so far, without calling
+  /// the callback set with SetChildrenFunction.
+  /// \return The child interface models.
+  private: const std::vector<sdf::InterfaceModelConstPtr> &
+               AddedNestedModels() const;
+
+  /// \brief Get the child interface frames added so far, without calling
+  /// the callback set with SetChildrenFunction.
+  /// \return The child interface frames.
+  private: const std::vector<sdf::InterfaceFrame> &AddedFrames() const;
+
+  /// \brief Get the child interface joints added so far, without calling
+  /// the callback set with SetChildrenFunction.
+  /// \return The child interface joints.
+  private: const std::vector<sdf::InterfaceJoint> &AddedJoints() const;
+
+  /// \brief Get the child interface links added so far, without calling
+  /// the callback set with SetChildrenFunction.
+  /// \return The child interface links.
+  private: const std::vector<sdf::InterfaceLink> &AddedLinks() const;
+
   /// \brief Recursively invoke the reposture callback if a the callback is set.
   /// \param[in] _poseGraph Object used for resolving poses.
   /// \param[in] _name Override name of graph scope.
@@ -141,6 +206,9 @@ class SDFORMAT_VISIBLE InterfaceModel
 
   friend World;
   friend Model;
+  // Allow ModelWrapper from FrameSemantics.cc to wrap the children of models
+  // that are not loaded yet
+  friend struct ModelWrapper;
   /// \brief Private data pointer.
   IGN_UTILS_IMPL_PTR(dataPtr)
 };
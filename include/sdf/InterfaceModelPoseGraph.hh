@@ -20,6 +20,7 @@
 
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include <ignition/math/Pose3.hh>
@@ -56,6 +57,19 @@ class SDFORMAT_VISIBLE InterfaceModelPoseGraph
               const std::string &_frameName,
               const std::string &_relativeTo = "world") const;
 
+  /// \brief Resolve the pose of every frame within the model's scope
+  /// relative to world, with a single traversal of the model's frame graph
+  /// instead of one per frame as ResolveNestedFramePose does.
+  /// \param[out] _poses Resolved poses keyed by the name of the frame in the
+  /// model's scope, for example "link", "nested_model" or
+  /// "nested_model::link". The frame of the model itself is keyed by
+  /// "__model__".
+  /// Frames whose pose could not be resolved are left out.
+  /// \return Errors for each frame whose pose could not be resolved.
+  public: sdf::Errors ResolveAllNestedFramePoses(
+              std::unordered_map<std::string, ignition::math::Pose3d> &_poses)
+              const;
+
   /// \brief Private constructor
   /// \param[in] _name Interface model associated with this object
   /// \param[in] _graph Pose relative-to graph at the scope of the interface
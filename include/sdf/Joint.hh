@@ -37,6 +37,8 @@ namespace sdf
   class JointAxis;
   struct FrameAttachedToGraph;
   struct PoseRelativeToGraph;
+  template <typename T> class NameIndex;
+  class NameIndexRenames;
   template <typename T> class ScopedGraph;
   class Sensor;
 
@@ -202,6 +204,17 @@ namespace sdf
     /// \return SemanticPose object for this link.
     public: sdf::SemanticPose SemanticPose() const;
 
+    /// \brief Resolve the pose of this joint relative to a frame, as
+    /// SemanticPose().Resolve() does, without constructing a SemanticPose.
+    /// If there are any errors resolving the pose, the output will not be
+    /// modified.
+    /// \param[out] _pose The resolved pose.
+    /// \param[in] _resolveTo The pose will be resolved with respect to this
+    /// frame. If unset or empty, the child link will be used.
+    /// \return Errors in resolving pose.
+    public: Errors ResolvePose(ignition::math::Pose3d &_pose,
+                               const std::string &_resolveTo = "") const;
+
     /// \brief Get the number of sensors.
     /// \return Number of sensors contained in this Joint object.
     public: uint64_t SensorCount() const;
@@ -238,6 +251,12 @@ namespace sdf
     /// exists.
     public: bool AddSensor(const Sensor &_sensor);
 
+    /// \brief Add a sensors to the joint, moving it instead of copying it.
+    /// \param[in] _sensor Sensor to add.
+    /// \return True if successful, false if a sensor with the name already
+    /// exists.
+    public: bool AddSensor(Sensor &&_sensor);
+
     /// \brief Remove all sensors.
     public: void ClearSensors();
 
@@ -254,6 +273,16 @@ namespace sdf
     private: void SetPoseRelativeToGraph(
         sdf::ScopedGraph<PoseRelativeToGraph> _graph);
 
+    /// \brief Set the record of the names that the joints of the vector
+    /// holding this joint were renamed to, which SetName adds to. This is
+    /// private and is intended to be called by the NameIndex of the vector.
+    /// \param[in] _renames The record.
+    private: void SetNameIndexRenames(
+        std::shared_ptr<NameIndexRenames> _renames);
+
+    /// \brief Allow NameIndex to call SetNameIndexRenames.
+    template <typename T> friend class NameIndex;
+
     /// \brief Allow Model::Load to call SetPoseRelativeToGraph.
     friend class Model;
 
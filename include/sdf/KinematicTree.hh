@@ -0,0 +1,72 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDF_KINEMATICTREE_HH_
+#define SDF_KINEMATICTREE_HH_
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+
+/// \brief Kinematic tree of the links of a model, resolved by
+/// Model::ResolveKinematicTree. The arrays have one entry per link of the
+/// model, in topological order: every link comes after its parent link, so
+/// articulated-body algorithms can traverse the tree by iterating over the
+/// entries forward or backward.
+///
+/// The parent frame of an entry is the frame of its parent link, or the
+/// model frame for a root link. Its joint frame is the frame of the joint
+/// that connects the link to its parent link or to the world, or the model
+/// frame for a root link that has no such joint.
+struct KinematicTree
+{
+  /// \brief Value of the parent and joint indices of entries that have no
+  /// parent link or no joint.
+  static constexpr uint64_t kNoIndex = std::numeric_limits<uint64_t>::max();
+
+  /// \brief Index of the link of each entry, as given to
+  /// Model::LinkByIndex.
+  std::vector<uint64_t> links;
+
+  /// \brief Entry of the parent link of each entry, which is smaller than
+  /// the entry, or kNoIndex for root links.
+  std::vector<uint64_t> parents;
+
+  /// \brief Index of the joint of each entry, as given to
+  /// Model::JointByIndex, or kNoIndex for root links without a joint to the
+  /// world.
+  std::vector<uint64_t> joints;
+
+  /// \brief Pose of the joint frame of each entry relative to its parent
+  /// frame.
+  std::vector<ignition::math::Pose3d> jointPoses;
+
+  /// \brief Pose of the link of each entry relative to its joint frame.
+  std::vector<ignition::math::Pose3d> linkPoses;
+};
+}
+}
+#endif
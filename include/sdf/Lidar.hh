@@ -17,6 +17,8 @@
 #ifndef SDF_LIDAR_HH_
 #define SDF_LIDAR_HH_
 
+#include <vector>
+
 #include <ignition/math/Angle.hh>
 #include <ignition/utils/ImplPtr.hh>
 
@@ -32,6 +34,29 @@ namespace sdf
   inline namespace SDF_VERSION_NAMESPACE {
   //
 
+  /// \brief Unit direction vectors of the rays of a lidar in the sensor
+  /// frame, in structure of arrays form. The rays of a horizontal sweep are
+  /// stored next to each other, one sweep per vertical angle starting from
+  /// the minimum vertical angle, so the ray with horizontal index h and
+  /// vertical index v is at index v * horizontalCount + h.
+  struct LidarRayDirections
+  {
+    /// \brief Number of rays in a horizontal sweep.
+    unsigned int horizontalCount = 0;
+
+    /// \brief Number of horizontal sweeps.
+    unsigned int verticalCount = 0;
+
+    /// \brief X components of the directions.
+    std::vector<float> x;
+
+    /// \brief Y components of the directions.
+    std::vector<float> y;
+
+    /// \brief Z components of the directions.
+    std::vector<float> z;
+  };
+
   /// \brief Lidar contains information about a Lidar sensor.
   /// This sensor can be attached to a link. The Lidar sensor can be defined
   /// SDF XML using either the "ray" or "lidar" types. The "lidar" type is
@@ -189,6 +214,18 @@ namespace sdf
     /// \param[in] Maximum angle for vertical scan.
     public: void SetVerticalScanMaxAngle(const ignition::math::Angle &_max);
 
+    /// \brief Get the direction of every ray of the lidar. The number of
+    /// rays in each direction is the number of samples multiplied by the
+    /// resolution, rounded to the nearest integer, and the rays are spread
+    /// evenly from the minimum to the maximum angle. A single ray points at
+    /// the minimum angle. The horizontal angle is a rotation around the Z
+    /// axis starting from the X axis, and the vertical angle is an
+    /// elevation towards the Z axis. The directions are computed on first
+    /// use and kept until a scan parameter is changed.
+    /// \return The ray directions. The reference is invalidated by the
+    /// setters of the scan parameters and by Load.
+    public: const LidarRayDirections &RayDirections() const;
+
     /// \brief Get minimum distance for each lidar ray.
     /// \return Minimum distance for each lidar ray.
     public: double RangeMin() const;
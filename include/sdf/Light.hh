@@ -118,6 +118,17 @@ namespace sdf
     /// \return SemanticPose object for this link.
     public: sdf::SemanticPose SemanticPose() const;
 
+    /// \brief Resolve the pose of this light relative to a frame, as
+    /// SemanticPose().Resolve() does, without constructing a SemanticPose.
+    /// If there are any errors resolving the pose, the output will not be
+    /// modified.
+    /// \param[out] _pose The resolved pose.
+    /// \param[in] _resolveTo The pose will be resolved with respect to this
+    /// frame. If unset or empty, the parent object will be used.
+    /// \return Errors in resolving pose.
+    public: Errors ResolvePose(ignition::math::Pose3d &_pose,
+                               const std::string &_resolveTo = "") const;
+
     /// \brief Get whether the light casts shadows.
     /// \return True if the light casts shadows.
     public: bool CastShadows() const;
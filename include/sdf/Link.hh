@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/utils/ImplPtr.hh>
 #include "sdf/Element.hh"
@@ -40,6 +41,8 @@ namespace sdf
   class Sensor;
   class Visual;
   struct PoseRelativeToGraph;
+  template <typename T> class NameIndex;
+  class NameIndexRenames;
   template <typename T> class ScopedGraph;
 
   class SDFORMAT_VISIBLE Link
@@ -296,12 +299,45 @@ namespace sdf
     /// \return SemanticPose object for this link.
     public: sdf::SemanticPose SemanticPose() const;
 
+    /// \brief Resolve the pose of this link relative to a frame, as
+    /// SemanticPose().Resolve() does, without constructing a SemanticPose.
+    /// If there are any errors resolving the pose, the output will not be
+    /// modified.
+    /// \param[out] _pose The resolved pose.
+    /// \param[in] _resolveTo The pose will be resolved with respect to this
+    /// frame. If unset or empty, the model frame will be used.
+    /// \return Errors in resolving pose.
+    public: Errors ResolvePose(ignition::math::Pose3d &_pose,
+                               const std::string &_resolveTo = "") const;
+
+    /// \brief Resolve the bounds of the collisions of this link, as the
+    /// smallest axis-aligned box in the link frame that contains the
+    /// Geometry::AxisAlignedBox of each collision placed at its resolved
+    /// pose. The poses are cached with the pose graph, and the shapes are
+    /// read on each call.
+    /// \param[out] _bounds The bounds. Empty if the link has no collisions,
+    /// and infinite if the bounds of a collision's shape are not known.
+    /// \return Errors in resolving the poses of the collisions, which are
+    /// left out of the bounds.
+    public: Errors ResolveCollisionBounds(
+                ignition::math::AxisAlignedBox &_bounds) const;
+
     /// \brief Give the scoped PoseRelativeToGraph to be used for resolving
     /// poses. This is private and is intended to be called by Model::Load.
     /// \param[in] _graph scoped PoseRelativeToGraph object.
     private: void SetPoseRelativeToGraph(
         sdf::ScopedGraph<PoseRelativeToGraph> _graph);
 
+    /// \brief Set the record of the names that the links of the vector
+    /// holding this link were renamed to, which SetName adds to. This is
+    /// private and is intended to be called by the NameIndex of the vector.
+    /// \param[in] _renames The record.
+    private: void SetNameIndexRenames(
+        std::shared_ptr<NameIndexRenames> _renames);
+
+    /// \brief Allow NameIndex to call SetNameIndexRenames.
+    template <typename T> friend class NameIndex;
+
     /// \brief Allow Model::Load to call SetPoseRelativeToGraph.
     friend class Model;
 
@@ -323,30 +359,61 @@ namespace sdf
     /// exists.
     public: bool AddCollision(const Collision &_collision);
 
+    /// \brief Add a collision to the link, moving it instead of copying it.
+    /// \param[in] _collision Collision to add.
+    /// \return True if successful, false if a collision with the name already
+    /// exists.
+    public: bool AddCollision(Collision &&_collision);
+
     /// \brief Add a visual to the link.
     /// \param[in] _visual Visual to add.
     /// \return True if successful, false if a visual with the name already
     /// exists.
     public: bool AddVisual(const Visual &_visual);
 
+    /// \brief Add a visual to the link, moving it instead of copying it.
+    /// \param[in] _visual Visual to add.
+    /// \return True if successful, false if a visual with the name already
+    /// exists.
+    public: bool AddVisual(Visual &&_visual);
+
     /// \brief Add a light to the link.
     /// \param[in] _light Light to add.
     /// \return True if successful, false if a light with the name already
     /// exists.
     public: bool AddLight(const Light &_light);
 
+    /// \brief Add a light to the link, moving it instead of copying it.
+    /// \param[in] _light Light to add.
+    /// \return True if successful, false if a light with the name already
+    /// exists.
+    public: bool AddLight(Light &&_light);
+
     /// \brief Add a sensor to the link.
     /// \param[in] _sensor Sensor to add.
     /// \return True if successful, false if a sensor with the name already
     /// exists.
     public: bool AddSensor(const Sensor &_sensor);
 
+    /// \brief Add a sensor to the link, moving it instead of copying it.
+    /// \param[in] _sensor Sensor to add.
+    /// \return True if successful, false if a sensor with the name already
+    /// exists.
+    public: bool AddSensor(Sensor &&_sensor);
+
     /// \brief Add a particle emitter to the link.
     /// \param[in] _emitter Particle emitter to add.
     /// \return True if successful, false if a particle emitter with the name
     /// already exists.
     public: bool AddParticleEmitter(const ParticleEmitter &_sensor);
 
+    /// \brief Add a particle emitter to the link, moving it instead of copying
+    /// it.
+    /// \param[in] _emitter Particle emitter to add.
+    /// \return True if successful, false if a particle emitter with the name
+    /// already exists.
+    public: bool AddParticleEmitter(ParticleEmitter &&_emitter);
+
     /// \brief Remove all collisions
     public: void ClearCollisions();
 
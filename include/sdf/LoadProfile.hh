@@ -0,0 +1,147 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_LOADPROFILE_HH_
+#define SDF_LOADPROFILE_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <ignition/utils/ImplPtr.hh>
+
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+
+/// \brief Phases of loading a document, as recorded by LoadProfile.
+enum class LoadPhase
+{
+  /// \brief Parsing the XML of files and strings with tinyxml2.
+  XML_PARSE,
+
+  /// \brief Converting documents of older SDFormat versions.
+  CONVERSION,
+
+  /// \brief Converting URDF documents to SDFormat.
+  URDF_CONVERSION,
+
+  /// \brief Reading the XML elements into sdf::Element objects, excluding
+  /// the other phases that happen meanwhile.
+  READ_XML,
+
+  /// \brief Resolving the files of <include> elements and getting them from
+  /// the include cache, excluding the reading of the included files.
+  INCLUDE,
+
+  /// \brief Applying the <experimental:params> of <include> elements.
+  PARAM_PASSING,
+
+  /// \brief Loading sdf::Element objects into the DOM classes, such as
+  /// sdf::World and sdf::Model, excluding the graph building and the
+  /// validation.
+  DOM_LOAD,
+
+  /// \brief Building the frame attached-to and pose relative-to graphs.
+  GRAPH_BUILD,
+
+  /// \brief Checking documents, for example their names, joints and frame
+  /// graphs.
+  VALIDATION,
+};
+
+/// \brief Time and number of runs of the phases of loading documents,
+/// and of the files they include. A profile is filled by the parser when
+/// it is set on the ParserConfig used to load documents, with
+/// ParserConfig::SetProfile. Recording a phase only reads a steady clock and
+/// updates atomic counters, so that profiles can be left enabled.
+///
+/// The time of a phase excludes the time of the phases that run within it,
+/// for example the time of READ_XML excludes the time spent parsing and
+/// reading included files, so that the durations of all the phases add up
+/// to the time spent loading. When included files are loaded on several
+/// threads, see ParserConfig::SetIncludeLoadThreadCount, the times of all
+/// the threads are added.
+///
+/// A profile can be shared by several configurations and filled from
+/// several threads.
+class SDFORMAT_VISIBLE LoadProfile
+{
+  /// \brief Default constructor.
+  public: LoadProfile();
+
+  /// \brief Get the total time spent in a phase.
+  /// \param[in] _phase The phase.
+  /// \return The time spent in the phase, excluding the phases that ran
+  /// within it.
+  public: std::chrono::nanoseconds Duration(LoadPhase _phase) const;
+
+  /// \brief Get the number of times a phase ran.
+  /// \param[in] _phase The phase.
+  /// \return The number of times the phase ran.
+  public: std::uint64_t Count(LoadPhase _phase) const;
+
+  /// \brief Get the files that were included, in alphabetical order.
+  /// \return Full paths of the files read for <include> elements.
+  public: std::vector<std::string> IncludedFiles() const;
+
+  /// \brief Get the total time spent including a file.
+  /// \param[in] _fileName Full path of the file, as returned by
+  /// IncludedFiles.
+  /// \return The time spent on the <include> elements of the file,
+  /// including the time spent parsing and reading it and the files it
+  /// includes, or zero if the file was not included.
+  public: std::chrono::nanoseconds IncludeDuration(
+              const std::string &_fileName) const;
+
+  /// \brief Get the number of times a file was included.
+  /// \param[in] _fileName Full path of the file, as returned by
+  /// IncludedFiles.
+  /// \return The number of <include> elements of the file.
+  public: std::uint64_t IncludeCount(const std::string &_fileName) const;
+
+  /// \brief Add a run of a phase. This is called by the parser.
+  /// \param[in] _phase The phase.
+  /// \param[in] _duration Time spent in the phase, excluding the phases that
+  /// ran within it.
+  public: void Record(LoadPhase _phase, std::chrono::nanoseconds _duration);
+
+  /// \brief Add an inclusion of a file. This is called by the parser.
+  /// \param[in] _fileName Full path of the file.
+  /// \param[in] _duration Time spent including the file.
+  public: void RecordInclude(const std::string &_fileName,
+                             std::chrono::nanoseconds _duration);
+
+  /// \brief Clear the recorded times and counts.
+  public: void Reset();
+
+  /// \brief Get the name of a phase, for printing.
+  /// \param[in] _phase The phase.
+  /// \return Name of the phase, such as "xml_parse".
+  public: static std::string PhaseName(LoadPhase _phase);
+
+  /// \brief Private data pointer.
+  IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+}
+}
+#endif
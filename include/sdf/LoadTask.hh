@@ -0,0 +1,120 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_LOADTASK_HH_
+#define SDF_LOADTASK_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <ignition/utils/ImplPtr.hh>
+
+#include "sdf/Error.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+
+// Forward declarations.
+class Root;
+
+/// \brief Progress of a document that is loaded by a LoadTask.
+struct LoadProgress
+{
+  /// \brief Number of files that were parsed, including the document and
+  /// the files of its <include> elements. Included files that are taken
+  /// from the include cache are not parsed, and are not counted.
+  std::uint64_t filesParsed = 0;
+
+  /// \brief Number of models that were loaded into the DOM, including
+  /// nested models.
+  std::uint64_t modelsLoaded = 0;
+};
+
+/// \brief Handle to a document that is loaded into an sdf::Root on a
+/// background thread, returned by Root::LoadAsync. The load can be waited
+/// for, polled and cancelled from any thread. Destroying the handle cancels
+/// the load if it is still running and waits for the thread to finish.
+class SDFORMAT_VISIBLE LoadTask
+{
+  /// \brief Function called with the progress of a load. It is called on
+  /// the threads that load the document, but never concurrently.
+  public: using ProgressCallback = std::function<void(const LoadProgress &)>;
+
+  /// \brief Default constructor, for a handle without a load.
+  public: LoadTask();
+
+  /// \brief Start loading a file. Use Root::LoadAsync instead.
+  /// \param[in] _filename Name of the SDF file to load.
+  /// \param[in] _config Custom parser configuration. The included files are
+  /// loaded on several threads if it enables it.
+  /// \param[in] _callback Function called when the progress changes, or an
+  /// empty function.
+  public: LoadTask(const std::string &_filename, const ParserConfig &_config,
+                   ProgressCallback _callback);
+
+  /// \brief Check whether this handle refers to a load.
+  /// \return True if a load was started.
+  public: bool Valid() const;
+
+  /// \brief Request the load to stop. Loading stops before the next
+  /// included file or model is loaded, and the errors of the load then
+  /// only contain an error with the LOAD_CANCELLED code.
+  public: void Cancel();
+
+  /// \brief Check whether the load was cancelled.
+  /// \return True if Cancel() was called.
+  public: bool Cancelled() const;
+
+  /// \brief Check whether the load is finished.
+  /// \return True if the load is finished, or if there is no load.
+  public: bool Ready() const;
+
+  /// \brief Wait for the load to finish.
+  public: void Wait() const;
+
+  /// \brief Wait for the load to finish, or for a duration to elapse.
+  /// \param[in] _timeout Maximum time to wait.
+  /// \return True if the load is finished.
+  public: bool WaitFor(std::chrono::milliseconds _timeout) const;
+
+  /// \brief Get the progress of the load.
+  /// \return The current progress.
+  public: LoadProgress Progress() const;
+
+  /// \brief Wait for the load to finish and get its errors.
+  /// \return The errors of Root::Load.
+  public: const Errors &LoadErrors() const;
+
+  /// \brief Wait for the load to finish and take the loaded document. The
+  /// root can only be taken once.
+  /// \return The loaded document, which is empty if the load was cancelled,
+  /// if the root was already taken, or if there is no load.
+  public: Root TakeRoot();
+
+  /// \brief Private data pointer.
+  IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+}
+}
+#endif
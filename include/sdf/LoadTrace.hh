@@ -0,0 +1,102 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_LOADTRACE_HH_
+#define SDF_LOADTRACE_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include <ignition/utils/ImplPtr.hh>
+
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+
+/// \brief Timeline of the functions run while loading documents, which can
+/// be written in the Chrome trace event format and opened with
+/// chrome://tracing or https://ui.perfetto.dev. A trace is filled by the
+/// parser when it is set on the ParserConfig used to load documents, with
+/// ParserConfig::SetTrace. Events are recorded for reading files, resolving
+/// <include> elements, converting documents, applying
+/// <experimental:params>, loading the DOM classes, and building and
+/// validating the frame graphs.
+///
+/// Setting the SDF_TRACE_FILE environment variable to the path of a file
+/// traces all the configurations that are not given another trace, and
+/// writes the trace to the file when the program exits.
+///
+/// A trace can be shared by several configurations and filled from several
+/// threads.
+class SDFORMAT_VISIBLE LoadTrace
+{
+  /// \brief Default constructor. The timestamps of the events are relative
+  /// to the creation of the trace.
+  public: LoadTrace();
+
+  /// \brief Add a complete event. This is called by the parser.
+  /// \param[in] _name Name of the event, such as "Model::Load".
+  /// \param[in] _category Category of the event, such as "dom".
+  /// \param[in] _start Time at which the event started.
+  /// \param[in] _duration Duration of the event.
+  /// \param[in] _detail Optional detail shown with the event, such as the
+  /// name of a file.
+  public: void Record(const std::string &_name, const std::string &_category,
+                      std::chrono::steady_clock::time_point _start,
+                      std::chrono::nanoseconds _duration,
+                      const std::string &_detail = "");
+
+  /// \brief Get the number of recorded events.
+  /// \return Number of events.
+  public: std::size_t EventCount() const;
+
+  /// \brief Get the number of recorded events with a name.
+  /// \param[in] _name Name of the events.
+  /// \return Number of events named _name.
+  public: std::size_t EventCount(const std::string &_name) const;
+
+  /// \brief Write the events in the Chrome trace event JSON format.
+  /// \param[in] _out Stream to write to.
+  public: void WriteJson(std::ostream &_out) const;
+
+  /// \brief Write the events in the Chrome trace event JSON format to a
+  /// file.
+  /// \param[in] _fileName Path of the file, which is overwritten.
+  /// \return True if the file was written.
+  public: bool WriteJson(const std::string &_fileName) const;
+
+  /// \brief Remove the recorded events.
+  public: void Reset();
+
+  /// \brief Get the trace enabled by the SDF_TRACE_FILE environment
+  /// variable, which is written to the file when the program exits.
+  /// \return The trace, or nullptr if the variable is not set or empty.
+  public: static std::shared_ptr<LoadTrace> FromEnvironment();
+
+  /// \brief Private data pointer.
+  IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+}
+}
+#endif
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDF_MAPPEDENTITYTABLES_HH_
+#define SDF_MAPPEDENTITYTABLES_HH_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <ignition/math/Inertial.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/utils/ImplPtr.hh>
+
+#include "sdf/EntityTables.hh"
+#include "sdf/Geometry.hh"
+#include "sdf/Joint.hh"
+#include "sdf/Sensor.hh"
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+
+/// \brief Read-only view of EntityTables stored in a file, which is mapped
+/// into memory and read in place. Several processes on one machine that
+/// open the same file share its pages, so the tables of a large world are
+/// only held in memory once. For example, one process loads the world,
+/// resolves its tables with World::ResolveEntityTables and writes them to a
+/// file in /dev/shm, and the other processes open the file instead of
+/// loading the world.
+///
+/// The file only stores fixed-size values and offsets relative to its
+/// start, so it can be mapped at any address. It is meant to be shared by
+/// processes on the same machine that use the same version of the library,
+/// and is rejected if it was written with another byte order or layout.
+/// The file must not be modified while it is open; Write replaces it with a
+/// rename so that processes that have it open keep the previous version.
+class SDFORMAT_VISIBLE MappedEntityTables
+{
+  /// \brief The tables of EntityTables.
+  public: enum class Table
+  {
+    /// \brief EntityTables::models.
+    MODELS,
+
+    /// \brief EntityTables::links.
+    LINKS,
+
+    /// \brief EntityTables::collisions.
+    COLLISIONS,
+
+    /// \brief EntityTables::joints.
+    JOINTS,
+
+    /// \brief EntityTables::sensors.
+    SENSORS
+  };
+
+  /// \brief Default constructor, for a view without a file.
+  public: MappedEntityTables();
+
+  /// \brief Write tables to a file that can be opened with Open. The file
+  /// is written to a temporary file next to it first, and then renamed.
+  /// \param[in] _path Path of the file.
+  /// \param[in] _tables The tables.
+  /// \return True if the file was written.
+  public: static bool Write(const std::string &_path,
+                            const EntityTables &_tables);
+
+  /// \brief Map a file written by Write read-only, replacing the file that
+  /// was open. On platforms without memory mapping, the file is read into
+  /// memory instead.
+  /// \param[in] _path Path of the file.
+  /// \return True if the file was mapped and is valid. The view is empty
+  /// otherwise.
+  public: bool Open(const std::string &_path);
+
+  /// \brief Unmap the file, leaving an empty view.
+  public: void Close();
+
+  /// \brief Check whether a file is open.
+  /// \return True if a valid file is open.
+  public: bool Valid() const;
+
+  /// \brief Get the number of entities of a table.
+  /// \param[in] _table The table.
+  /// \return Number of entities, or 0 if no file is open.
+  public: uint64_t Count(Table _table) const;
+
+  /// \brief Get the name of an entity.
+  /// \param[in] _table The table of the entity.
+  /// \param[in] _index Index of the entity in the table. It has to be less
+  /// than Count(_table), as for all the accessors below.
+  /// \return The name, which points into the mapped file.
+  public: std::string_view Name(Table _table, uint64_t _index) const;
+
+  /// \brief Get the pose of an entity.
+  /// \param[in] _table The table of the entity.
+  /// \param[in] _index Index of the entity in the table.
+  /// \return The pose, relative to the world frame.
+  public: ignition::math::Pose3d Pose(Table _table, uint64_t _index) const;
+
+  /// \brief Get the parent of a model.
+  /// \param[in] _index Index of the model.
+  /// \return Index of the parent model, or EntityTables::kNoIndex.
+  public: uint64_t ModelParent(uint64_t _index) const;
+
+  /// \brief Get the model of a link.
+  /// \param[in] _index Index of the link.
+  /// \return Index of the model.
+  public: uint64_t LinkModel(uint64_t _index) const;
+
+  /// \brief Get the inertial of a link.
+  /// \param[in] _index Index of the link.
+  /// \return The inertial, relative to the link frame.
+  public: ignition::math::Inertiald LinkInertial(uint64_t _index) const;
+
+  /// \brief Get the link of a collision.
+  /// \param[in] _index Index of the collision.
+  /// \return Index of the link.
+  public: uint64_t CollisionLink(uint64_t _index) const;
+
+  /// \brief Get the type of the geometry of a collision.
+  /// \param[in] _index Index of the collision.
+  /// \return The type.
+  public: GeometryType CollisionGeometryType(uint64_t _index) const;
+
+  /// \brief Get the dimensions of the geometry of a collision.
+  /// \param[in] _index Index of the collision.
+  /// \return The dimensions, see
+  /// EntityTables::CollisionTable::geometryParameters.
+  public: ignition::math::Vector3d CollisionGeometryParameters(
+              uint64_t _index) const;
+
+  /// \brief Get the model of a joint.
+  /// \param[in] _index Index of the joint.
+  /// \return Index of the model.
+  public: uint64_t JointModel(uint64_t _index) const;
+
+  /// \brief Get the type of a joint.
+  /// \param[in] _index Index of the joint.
+  /// \return The type.
+  public: sdf::JointType JointType(uint64_t _index) const;
+
+  /// \brief Get the parent link of a joint.
+  /// \param[in] _index Index of the joint.
+  /// \return Index of the parent link, or EntityTables::kNoIndex.
+  public: uint64_t JointParentLink(uint64_t _index) const;
+
+  /// \brief Get the child link of a joint.
+  /// \param[in] _index Index of the joint.
+  /// \return Index of the child link, or EntityTables::kNoIndex.
+  public: uint64_t JointChildLink(uint64_t _index) const;
+
+  /// \brief Get the link of a sensor.
+  /// \param[in] _index Index of the sensor.
+  /// \return Index of the link, or EntityTables::kNoIndex.
+  public: uint64_t SensorLink(uint64_t _index) const;
+
+  /// \brief Get the joint of a sensor.
+  /// \param[in] _index Index of the sensor.
+  /// \return Index of the joint, or EntityTables::kNoIndex.
+  public: uint64_t SensorJoint(uint64_t _index) const;
+
+  /// \brief Get the type of a sensor.
+  /// \param[in] _index Index of the sensor.
+  /// \return The type.
+  public: sdf::SensorType SensorType(uint64_t _index) const;
+
+  /// \brief Get the update rate of a sensor.
+  /// \param[in] _index Index of the sensor.
+  /// \return The update rate, in Hz.
+  public: double SensorUpdateRate(uint64_t _index) const;
+
+  /// \brief Copy the tables out of the file.
+  /// \param[out] _tables The tables, which are empty if no file is open.
+  public: void CopyTo(EntityTables &_tables) const;
+
+  /// \brief Private data pointer.
+  IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+}
+}
+#endif
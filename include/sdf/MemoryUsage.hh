@@ -0,0 +1,129 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_MEMORYUSAGE_HH_
+#define SDF_MEMORYUSAGE_HH_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <ignition/utils/ImplPtr.hh>
+
+#include "sdf/Element.hh"
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+
+// Forward declarations.
+class Root;
+
+/// \brief Number of elements and parameters of element trees and an
+/// approximation of the memory they use, in total and by element name.
+/// The bytes are estimated from the sizes of the element and parameter
+/// objects and of the strings and containers they own, not measured from
+/// the allocator, so they are meant to compare documents and find the
+/// elements that use the most memory. The DOM objects, such as sdf::World,
+/// are not accounted for.
+///
+/// Element descriptions, which are shared by all the elements parsed from
+/// the same specification, are accounted for separately, once each.
+/// The <include> elements kept by included elements are accounted for as
+/// part of the tree.
+class SDFORMAT_VISIBLE MemoryUsage
+{
+  /// \brief Default constructor, with nothing accounted for.
+  public: MemoryUsage();
+
+  /// \brief Constructor accounting for an element tree.
+  /// \param[in] _elem Root of the tree.
+  public: explicit MemoryUsage(const ElementPtr &_elem);
+
+  /// \brief Constructor accounting for the elements of a Root.
+  /// \param[in] _root The Root, with a loaded document.
+  public: explicit MemoryUsage(const Root &_root);
+
+  /// \brief Account for another element tree. Elements, descriptions,
+  /// file paths and XML paths shared with the trees already accounted for
+  /// are only counted once.
+  /// \param[in] _elem Root of the tree.
+  public: void Add(const ElementPtr &_elem);
+
+  /// \brief Get the number of elements.
+  /// \return The number of elements of the trees.
+  public: std::uint64_t ElementCount() const;
+
+  /// \brief Get the number of elements with a name.
+  /// \param[in] _name Element name, such as "link".
+  /// \return The number of elements named _name.
+  public: std::uint64_t ElementCount(const std::string &_name) const;
+
+  /// \brief Get the number of parameters, that is attributes and values.
+  /// \return The number of parameters of the elements of the trees.
+  public: std::uint64_t ParamCount() const;
+
+  /// \brief Get the number of distinct element descriptions used by the
+  /// trees, including the descriptions of their child descriptions. When
+  /// descriptions are shared, this is at most the number of elements of the
+  /// specification.
+  /// \return The number of distinct element descriptions.
+  public: std::uint64_t DescriptionCount() const;
+
+  /// \brief Get the number of references from the elements of the trees to
+  /// their element descriptions.
+  /// \return The number of references to element descriptions.
+  public: std::uint64_t DescriptionReferenceCount() const;
+
+  /// \brief Get the approximate memory used by the elements.
+  /// \return Approximate bytes of the elements, their parameters and
+  /// their file paths, excluding the descriptions.
+  public: std::uint64_t Bytes() const;
+
+  /// \brief Get the approximate memory used by the elements with a name.
+  /// \param[in] _name Element name, such as "link".
+  /// \return Approximate bytes of the elements named _name and their
+  /// parameters, excluding their child elements.
+  public: std::uint64_t Bytes(const std::string &_name) const;
+
+  /// \brief Get the approximate memory used by the element descriptions.
+  /// \return Approximate bytes of the distinct element descriptions.
+  public: std::uint64_t DescriptionBytes() const;
+
+  /// \brief Get the names of the elements, ordered from the ones using the
+  /// most memory to the ones using the least.
+  /// \return The element names.
+  public: std::vector<std::string> ElementNames() const;
+
+  /// \brief Output a report, with the totals and a table of the memory
+  /// used by each element name.
+  /// \param[in] _out The output stream.
+  /// \param[in] _usage The memory usage to print.
+  /// \return The output stream.
+  public: friend SDFORMAT_VISIBLE std::ostream &operator<<(
+              std::ostream &_out, const MemoryUsage &_usage);
+
+  /// \brief Private data pointer.
+  IGN_UTILS_IMPL_PTR(dataPtr)
+};
+}
+}
+#endif
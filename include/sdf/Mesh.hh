@@ -17,7 +17,9 @@
 #ifndef SDF_MESH_HH_
 #define SDF_MESH_HH_
 
+#include <optional>
 #include <string>
+#include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/utils/ImplPtr.hh>
 #include <sdf/Element.hh>
@@ -92,6 +94,22 @@ namespace sdf
     /// \param[in] _center True to center the submesh.
     public: void SetCenterSubmesh(const bool _center);
 
+    /// \brief Get the extents of the mesh, as a box in the frame of the mesh
+    /// before it is scaled. The extents are not part of the SDF description,
+    /// and are only known if they are set by the application that loads the
+    /// mesh file, for example to compute the bounds of Geometry.
+    /// \return The extents, or nullopt if they are not set.
+    public: std::optional<ignition::math::AxisAlignedBox> Extents() const;
+
+    /// \brief Set the extents of the mesh. See Extents() for more
+    /// information.
+    /// \param[in] _extents Box that contains the unscaled mesh.
+    public: void SetExtents(const ignition::math::AxisAlignedBox &_extents);
+
+    /// \brief Forget the extents of the mesh, so that Extents() returns
+    /// nullopt.
+    public: void ClearExtents();
+
     /// \brief Get a pointer to the SDF element that was used during load.
     /// \return SDF element pointer. The value will be nullptr if Load has
     /// not been called.
@@ -19,11 +19,15 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Inertial.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/utils/ImplPtr.hh>
 #include "sdf/Element.hh"
+#include "sdf/KinematicTree.hh"
 #include "sdf/ParserConfig.hh"
 #include "sdf/Plugin.hh"
 #include "sdf/SemanticPose.hh"
@@ -46,6 +50,8 @@ namespace sdf
   class NestedInclude;
   struct PoseRelativeToGraph;
   struct FrameAttachedToGraph;
+  template <typename T> class NameIndex;
+  class NameIndexRenames;
   template <typename T> class ScopedGraph;
   using InterfaceModelConstPtr = std::shared_ptr<const InterfaceModel>;
 
@@ -373,6 +379,91 @@ namespace sdf
     /// \return SemanticPose object for this link.
     public: sdf::SemanticPose SemanticPose() const;
 
+    /// \brief Resolve the pose of this model relative to a frame, as
+    /// SemanticPose().Resolve() does, without constructing a SemanticPose.
+    /// If there are any errors resolving the pose, the output will not be
+    /// modified.
+    /// \param[out] _pose The resolved pose.
+    /// \param[in] _resolveTo The pose will be resolved with respect to this
+    /// frame. If unset or empty, the parent model or world frame will be used.
+    /// \return Errors in resolving pose.
+    public: Errors ResolvePose(ignition::math::Pose3d &_pose,
+                               const std::string &_resolveTo = "") const;
+
+    /// \brief Resolve the poses of this model and of every entity it
+    /// contains with a single traversal of the pose graph. This gives the
+    /// same poses as calling SemanticPose().Resolve() with _resolveTo on each
+    /// entity, but is much faster for large models.
+    ///
+    /// The poses are stored in depth first order, which is the same order
+    /// as Root::EntityById: this model, then each link followed by its
+    /// collisions, visuals and sensors, then each joint followed by its
+    /// sensors, then the frames and finally each nested model with its
+    /// entities in the same order.
+    /// \param[out] _poses Resolved poses. Poses that could not be resolved
+    /// are set to zero and reported in the returned errors. Empty if
+    /// _resolveTo could not be resolved.
+    /// \param[in] _resolveTo Name of the frame to resolve the poses relative
+    /// to. It must be a frame of this model or its nested models, such as
+    /// a link or "nested_model::link". Empty to resolve relative to this
+    /// model's frame.
+    /// \return Errors.
+    public: Errors ResolveAllPoses(
+        std::vector<ignition::math::Pose3d> &_poses,
+        const std::string &_resolveTo = "") const;
+
+    /// \brief Resolve the composite inertial of a link and of every link
+    /// welded to it by fixed joints, in this model or its nested models, as
+    /// when fixed joints are lumped into a single body. Joints to the world
+    /// are not followed.
+    ///
+    /// The welded links and their poses are cached with the pose graph of
+    /// the model, and are found again without traversing the graphs until
+    /// the graphs are rebuilt. The inertials of the links are read on each
+    /// call.
+    /// \param[out] _inertial The composite inertial. Its pose is the center
+    /// of mass relative to _resolveTo, with the moments of inertia expressed
+    /// in the axes of _resolveTo.
+    /// \param[in] _linkName Name of a link of this model or of its nested
+    /// models, such as "link" or "nested_model::link".
+    /// \param[in] _resolveTo Name of the frame to resolve the inertial
+    /// relative to, with the same rules as for ResolveAllPoses. Empty to
+    /// resolve relative to this model's frame.
+    /// \return Errors.
+    public: Errors ResolveCompositeInertial(
+        ignition::math::Inertiald &_inertial,
+        const std::string &_linkName,
+        const std::string &_resolveTo = "") const;
+
+    /// \brief Resolve the kinematic tree of the links of this model, in
+    /// topological order, with the poses of the joints relative to their
+    /// parent links. Only the joints between links of this model, and from
+    /// the world to a link of this model, are part of the tree; links of
+    /// nested models and joints to them are not.
+    ///
+    /// Like the groups of ResolveCompositeInertial, the tree is cached with
+    /// the pose graph of the model, and is returned again without traversing
+    /// the graphs until the graphs are rebuilt.
+    /// \param[out] _tree The kinematic tree. Empty if there are errors.
+    /// \return Errors, including a KINEMATIC_TREE_INVALID error if a link is
+    /// the child of several joints or if the joints form a loop.
+    public: Errors ResolveKinematicTree(sdf::KinematicTree &_tree) const;
+
+    /// \brief Resolve the bounds of the collisions of the links of this
+    /// model and of its nested models, as the smallest axis-aligned box in
+    /// the model frame that contains the Geometry::AxisAlignedBox of each
+    /// collision placed at its resolved pose.
+    ///
+    /// The poses of the collisions are resolved with a single traversal of
+    /// the pose graph, as in ResolveAllPoses, and are cached with the pose
+    /// graph of the model until the graphs are rebuilt. The shapes are read
+    /// on each call.
+    /// \param[out] _bounds The bounds. Empty if there are no collisions, and
+    /// infinite if the bounds of a collision's shape are not known.
+    /// \return Errors in resolving the poses of the collisions, which are
+    /// left out of the bounds.
+    public: Errors ResolveBounds(ignition::math::AxisAlignedBox &_bounds) const;
+
     /// \brief Get the name of the placement frame of the model.
     /// \return Name of the placement frame attribute of the model.
     public: const std::string &PlacementFrameName() const;
@@ -452,24 +543,48 @@ namespace sdf
     /// exists.
     public: bool AddLink(const Link &_link);
 
+    /// \brief Add a link to the model, moving it instead of copying it.
+    /// \param[in] _link Link to add.
+    /// \return True if successful, false if a link with the name already
+    /// exists.
+    public: bool AddLink(Link &&_link);
+
     /// \brief Add a joint to the model.
     /// \param[in] _link Joint to add.
     /// \return True if successful, false if a joint with the name already
     /// exists.
     public: bool AddJoint(const Joint &_joint);
 
+    /// \brief Add a joint to the model, moving it instead of copying it.
+    /// \param[in] _link Joint to add.
+    /// \return True if successful, false if a joint with the name already
+    /// exists.
+    public: bool AddJoint(Joint &&_joint);
+
     /// \brief Add a model to the model.
     /// \param[in] _model Model to add.
     /// \return True if successful, false if a model with the name already
     /// exists.
     public: bool AddModel(const Model &_model);
 
+    /// \brief Add a model to the model, moving it instead of copying it.
+    /// \param[in] _model Model to add.
+    /// \return True if successful, false if a model with the name already
+    /// exists.
+    public: bool AddModel(Model &&_model);
+
     /// \brief Add a frame to the model.
     /// \param[in] _frame Frame to add.
     /// \return True if successful, false if a frame with the name already
     /// exists.
     public: bool AddFrame(const Frame &_frame);
 
+    /// \brief Add a frame to the model, moving it instead of copying it.
+    /// \param[in] _frame Frame to add.
+    /// \return True if successful, false if a frame with the name already
+    /// exists.
+    public: bool AddFrame(Frame &&_frame);
+
     /// \brief Remove all links.
     public: void ClearLinks();
 
@@ -523,14 +638,55 @@ namespace sdf
     private: void SetFrameAttachedToGraph(
         sdf::ScopedGraph<FrameAttachedToGraph> _graph);
 
+    /// \brief Resolve the poses of the frames of this model and of its nested
+    /// models relative to their model frames, and store them in the pose
+    /// graph. This is private and is intended to be called by Root::Freeze
+    /// and World::Freeze.
+    private: void StoreResolvedPoses() const;
+
     /// \brief Get the list of merged interface models.
     /// \return The list of merged interface models.
     private: const std::vector<std::pair<std::optional<sdf::NestedInclude>,
              sdf::InterfaceModelConstPtr>> &MergedInterfaceModels() const;
 
+    /// \brief Get a nested model by its possibly scoped name, such as
+    /// "a::b::c", without copying parts of the name.
+    /// \param[in] _name Name of the model.
+    /// \return The model, or nullptr if it does not exist.
+    private: const Model *ModelByScopedName(ScopedName _name) const;
+
+    /// \brief Get a link by its possibly scoped name without copying parts
+    /// of the name.
+    /// \param[in] _name Name of the link.
+    /// \return The link, or nullptr if it does not exist.
+    private: const Link *LinkByScopedName(ScopedName _name) const;
+
+    /// \brief Get a joint by its possibly scoped name without copying parts
+    /// of the name.
+    /// \param[in] _name Name of the joint.
+    /// \return The joint, or nullptr if it does not exist.
+    private: const Joint *JointByScopedName(ScopedName _name) const;
+
+    /// \brief Get an explicit frame by its possibly scoped name without
+    /// copying parts of the name.
+    /// \param[in] _name Name of the frame.
+    /// \return The frame, or nullptr if it does not exist.
+    private: const Frame *FrameByScopedName(ScopedName _name) const;
+
+    /// \brief Set the record of the names that the models of the vector
+    /// holding this model were renamed to, which SetName adds to. This is
+    /// private and is intended to be called by the NameIndex of the vector.
+    /// \param[in] _renames The record.
+    private: void SetNameIndexRenames(
+        std::shared_ptr<NameIndexRenames> _renames);
+
+    /// \brief Allow NameIndex to call SetNameIndexRenames.
+    template <typename T> friend class NameIndex;
+
     /// \brief Allow Root::Load, World::SetPoseRelativeToGraph, or
     /// World::SetFrameAttachedToGraph to call SetPoseRelativeToGraph and
-    /// SetFrameAttachedToGraph
+    /// SetFrameAttachedToGraph, and World to look up scoped names and to
+    /// store the resolved poses.
     friend class Root;
     friend class World;
 
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_NOISESAMPLER_HH_
+#define SDF_NOISESAMPLER_HH_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <ignition/utils/ImplPtr.hh>
+#include <sdf/Noise.hh>
+#include <sdf/sdf_config.h>
+#include <sdf/system_util.hh>
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  /// \brief Draws the noise described by a Noise and adds it to
+  /// measurements. Each noise value is a function of the seed, of a stream
+  /// number and of the index of the measurement in the stream, computed
+  /// with a counter-based generator instead of a generator with state. The
+  /// same measurements therefore get the same noise whatever the order
+  /// they are sampled in, and a buffer can be split across threads that
+  /// each sample their own range. A sensor would typically use its update
+  /// count as the stream, and the index of each value in its output buffer
+  /// as the index.
+  ///
+  /// Gaussian noise is drawn with the mean and standard deviation of the
+  /// Noise, and a constant bias is drawn once from the bias mean and
+  /// standard deviation, with a random sign. Quantized noise rounds the
+  /// noisy measurements to the precision. The dynamic bias is a random walk
+  /// that depends on the update rate of the sensor, and is not applied.
+  class SDFORMAT_VISIBLE NoiseSampler
+  {
+    /// \brief Default constructor, for a sampler that adds no noise.
+    public: NoiseSampler();
+
+    /// \brief Constructor.
+    /// \param[in] _noise Description of the noise.
+    /// \param[in] _seed Seed of the generator. Samplers with the same noise
+    /// and seed draw the same values.
+    public: explicit NoiseSampler(const Noise &_noise, uint64_t _seed = 0);
+
+    /// \brief Get the description of the noise.
+    /// \return The noise.
+    public: const Noise &NoiseModel() const;
+
+    /// \brief Get the seed of the generator.
+    /// \return The seed.
+    public: uint64_t Seed() const;
+
+    /// \brief Get the constant bias added to every measurement.
+    /// \return The bias, which is zero if the noise type is NONE.
+    public: double Bias() const;
+
+    /// \brief Get the noise added to a measurement, including the bias but
+    /// without quantization.
+    /// \param[in] _stream Stream of the measurement.
+    /// \param[in] _index Index of the measurement in the stream.
+    /// \return The noise value.
+    public: double Sample(uint64_t _stream, uint64_t _index) const;
+
+    /// \brief Add noise to a measurement.
+    /// \param[in] _value The measurement.
+    /// \param[in] _stream Stream of the measurement.
+    /// \param[in] _index Index of the measurement in the stream.
+    /// \return The noisy measurement.
+    public: double Apply(double _value, uint64_t _stream,
+                         uint64_t _index) const;
+
+    /// \brief Add noise to a buffer of measurements.
+    /// \param[in,out] _data The measurements.
+    /// \param[in] _count Number of measurements in _data.
+    /// \param[in] _stream Stream of the measurements.
+    /// \param[in] _first Index in the stream of the first measurement, so
+    /// that _data[i] has index _first + i.
+    public: void Apply(double *_data, std::size_t _count, uint64_t _stream,
+                       uint64_t _first = 0) const;
+
+    /// \brief Add noise to a buffer of measurements.
+    /// \param[in,out] _data The measurements.
+    /// \param[in] _count Number of measurements in _data.
+    /// \param[in] _stream Stream of the measurements.
+    /// \param[in] _first Index in the stream of the first measurement, so
+    /// that _data[i] has index _first + i.
+    public: void Apply(float *_data, std::size_t _count, uint64_t _stream,
+                       uint64_t _first = 0) const;
+
+    /// \brief Private data pointer.
+    IGN_UTILS_IMPL_PTR(dataPtr)
+  };
+  }
+}
+#endif
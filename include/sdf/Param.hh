@@ -29,7 +29,9 @@
 #include <optional>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <typeinfo>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -70,6 +72,10 @@ namespace sdf
 
   /// \internal
   class ParamPrivate;
+  struct ParamCustomValueType;
+  class ParamUpdateTable;
+  class BinarySdf;
+  class MemoryUsage;
 
   template<class T>
   struct ParamStreamer
@@ -79,6 +85,25 @@ namespace sdf
 
   template<class T> ParamStreamer(T) -> ParamStreamer<T>;
 
+  /// \internal
+  /// \brief Check whether a type is one of the alternatives of a variant.
+  template<class T, class V>
+  struct IsVariantAlternative : std::false_type {};
+
+  template<class T, class... Ts>
+  struct IsVariantAlternative<T, std::variant<Ts...>>
+    : std::disjunction<std::is_same<T, Ts>...> {};
+
+  /// \internal
+  /// \brief Check whether a type can be written to a stream.
+  template<class T, class = void>
+  struct IsStreamable : std::false_type {};
+
+  template<class T>
+  struct IsStreamable<T, std::void_t<decltype(
+      std::declval<std::ostream &>() << std::declval<const T &>())>>
+    : std::true_type {};
+
   template<class T>
   std::ostream& operator<<(std::ostream &os, ParamStreamer<T> s)
   {
@@ -205,11 +230,34 @@ namespace sdf
     /// \param[in] _value New value for the parameter in string form.
     public: bool SetFromString(const std::string &_value);
 
+    /// \brief Set the parameter value from a string without converting it
+    /// to the type of the parameter yet. The string is converted, and checked
+    /// against the minimum and maximum allowed values, the first time the
+    /// value is needed, for example by Get, GetAny, GetAsString or
+    /// ValidateValue. If it cannot be converted then the error is reported on
+    /// the console, the call that needed the value fails, and the parameter
+    /// is reset to its default value. Since the conversion modifies the
+    /// parameter, a parameter set this way must not be read from several
+    /// threads at once until its value has been converted.
+    /// \param[in] _value New value for the parameter in string form.
+    /// \return False if the string is empty and the parameter is required,
+    /// true otherwise.
+    /// \sa ParserConfig::SetLazyParamParsing
+    public: bool SetFromStringLazy(const std::string &_value);
+
     /// \brief Get the parent Element of this Param.
     /// \return Pointer to this Param's parent Element, nullptr if there is no
     /// parent Element.
     public: ElementPtr GetParentElement() const;
 
+    /// \brief Get the parent Element of this Param without taking a
+    /// reference to it, for read-only traversals of a tree that is kept
+    /// alive.
+    /// \return Pointer to this Param's parent Element, nullptr if there is
+    /// no parent Element or if it was destroyed. The pointer is only valid
+    /// while the parent Element is alive.
+    public: Element *ParentElementRaw() const;
+
     /// \brief Set the parent Element of this Param.
     /// \param[in] _parentElement Pointer to new parent Element. A nullptr can
     /// provided to remove the current parent Element.
@@ -227,7 +275,9 @@ namespace sdf
     /// element. For example, the rotation component of a pose element can
     /// be parsed as degrees or radians, depending on the attribute @degrees
     /// of the parent element. If however the value was explicitly set using the
-    /// Set<T> function, reparsing would not change the value.
+    /// Set<T> function, reparsing would not change the value. Values of types
+    /// that do not depend on those attributes are kept as they are, without
+    /// being converted from their string again.
     /// \return True if the parameter value has been reparsed successfully.
     /// \sa bool SetFromString(const std::string &_value)
     /// \sa bool Set(const T &_value)
@@ -255,6 +305,12 @@ namespace sdf
     /// \return True if the parameter has been set.
     public: bool GetSet() const;
 
+    /// \brief Get the string that the value was last set from.
+    /// \return The trimmed string given to SetFromString or
+    /// SetFromStringLazy, or nullopt if the value was not set from a string
+    /// or was reset.
+    public: std::optional<std::string> GetOriginalString() const;
+
     /// \brief Return true if the parameter ignores the parent element's
     /// attributes, or if the parameter has no parent element.
     /// \return True if the parameter ignores the parent element's attributes,
@@ -295,6 +351,16 @@ namespace sdf
     public: template<typename T>
             bool Get(T &_value) const;
 
+    /// \brief Get a pointer to the value of the parameter, without copying
+    /// it. Unlike Get, no conversion is done if T is not the type of the
+    /// parameter.
+    /// \return Pointer to the value, or nullptr if T is not the type of the
+    /// parameter or its value could not be converted. The pointer is valid
+    /// until the value of the parameter is changed or the parameter is
+    /// destroyed.
+    public: template<typename T>
+            const T *GetPtr() const;
+
     /// \brief Get the default value of the parameter.
     /// \param[out] _value The default value of the parameter.
     /// \return True if parameter was successfully cast to the value type
@@ -325,39 +391,99 @@ namespace sdf
       return _out;
     }
 
+    /// \brief Convert the string given to SetFromStringLazy, if it has not
+    /// been converted yet. The other functions convert it on first use,
+    /// which modifies the parameter, so this is called before a parameter
+    /// is read from several threads.
+    /// \return False if the string could not be converted or is not an
+    /// allowed value.
+    /// \sa Root::Freeze
+    public: bool ParseLazyValue() const;
+
+    /// \brief Register a value type that is not built in. Parameters whose
+    /// type name is _typeName are converted from their string once, with
+    /// _fromString, and keep the converted value, such as a
+    /// std::vector<double> for a long array of numbers, next to the values of
+    /// the built-in types. Get, GetPtr and Set then read and write that value
+    /// without a string, as long as they are given its type, and GetAsString
+    /// converts it back with _toString. Only params created after the type is
+    /// registered use it, so types are registered before the descriptions
+    /// that use them are loaded. The values of elements that have no
+    /// description, such as the contents of a <plugin>, are strings, and can
+    /// be converted by replacing them with Element::AddValue and the name of
+    /// the registered type. Minimum and maximum values are not supported for
+    /// these types.
+    ///
+    /// Whitespace separated lists of numbers of any length are registered
+    /// already, as "double_array", "float_array" and "int_array", which hold
+    /// a std::vector<double>, std::vector<float> and std::vector<int>.
+    /// \param[in] _typeName Name of the type, as used in descriptions.
+    /// \param[in] _fromString Function that converts a trimmed string to a
+    /// value, or returns false if the string is not valid. It is also called
+    /// with the default value of each param, which may be empty.
+    /// \param[in] _toString Function that converts a value to a string.
+    /// \return False if _typeName is a built-in type or was already
+    /// registered, or if a function is empty.
+    public: template<typename T>
+            static bool RegisterValueType(const std::string &_typeName,
+                std::function<bool(const std::string &, T &)> _fromString,
+                std::function<std::string(const T &)> _toString);
+
+    /// \brief Discard the cached content hash of the parent element, after
+    /// the value of this parameter changed.
+    private: void InvalidateParentContentHash();
+
+    /// \brief Add a value type to the types registered by RegisterValueType.
+    /// \param[in] _type The type.
+    /// \return False if the name of the type is a built-in type or was
+    /// already registered.
+    private: static bool RegisterCustomValueType(
+                 std::shared_ptr<const ParamCustomValueType> _type);
+
+    /// \brief Set the value of a param of a registered value type.
+    /// \param[in] _value The value, which holds the registered type.
+    /// \return True.
+    private: bool SetCustomValue(std::any &&_value);
+
+    /// \brief Allow MemoryUsage to account for the private data.
+    friend class MemoryUsage;
+
+    /// \brief Allow ParamUpdateTable to set values without update functions.
+    friend class ParamUpdateTable;
+
+    /// \brief Allow BinarySdf to read and write values without strings.
+    friend class BinarySdf;
+
     /// \brief Private data
     private: std::unique_ptr<ParamPrivate> dataPtr;
   };
 
   /// \internal
-  /// \brief Private data for the param class
-  class ParamPrivate
+  /// \brief Value type registered with Param::RegisterValueType.
+  struct ParamCustomValueType
   {
-    /// \brief Key value
-    public: std::string key;
-
-    /// \brief True if the parameter is required.
-    public: bool required;
-
-    /// \brief True if the parameter is set.
-    public: bool set;
+    /// \brief Name of the type.
+    std::string typeName;
 
-    //// \brief Name of the type.
-    public: std::string typeName;
+    /// \brief C++ type of the values.
+    const std::type_info *type = nullptr;
 
-    /// \brief Description of the parameter.
-    public: std::string description;
+    /// \brief Convert a string to a value, or return false.
+    std::function<bool(const std::string &, std::any &)> fromString;
 
-    /// \brief Parent element.
-    public: ElementWeakPtr parentElement;
-
-    /// \brief Update function pointer.
-    public: std::function<std::any ()> updateFunc;
+    /// \brief Convert a value to a string.
+    std::function<std::string(const std::any &)> toString;
+  };
 
+  /// \internal
+  /// \brief Private data for the param class
+  class ParamPrivate
+  {
     /// \def ParamVariant
     /// \brief Variant type def.
     /// Note: When a new variant is added, add variant to functions
-    /// ParamPrivate::TypeToString and ParamPrivate::ValueFromStringImpl
+    /// ParamPrivate::TypeToString and ParamPrivate::ValueFromStringImpl,
+    /// and to ValueType
     public: typedef std::variant<bool, char, std::string, int, std::uint64_t,
                                    unsigned int, double, float, sdf::Time,
                                    ignition::math::Angle,
@@ -368,28 +494,139 @@ namespace sdf
                                    ignition::math::Quaterniond,
                                    ignition::math::Pose3d> ParamVariant;
 
-    /// \brief This parameter's value
-    public: ParamVariant value;
+    /// \brief Type of the value of a parameter. Type names are resolved once
+    /// into a ValueType, so that converting values does not compare strings.
+    public: enum class ValueType : std::uint8_t
+    {
+      UNKNOWN,
+      BOOL,
+      CHAR,
+      STRING,
+      INT,
+      UINT64,
+      UNSIGNED_INT,
+      DOUBLE,
+      FLOAT,
+      TIME,
+      ANGLE,
+      COLOR,
+      VECTOR2I,
+      VECTOR2D,
+      VECTOR3D,
+      POSE,
+      QUATERNION
+    };
+
+    /// \brief Get the type of value that a type name refers to.
+    /// \param[in] _typeName Name of the type, such as "double", "vector3" or
+    /// "ignition::math::Vector3d".
+    /// \return The type, or ValueType::UNKNOWN if the name is not known.
+    public: static ValueType SDFORMAT_VISIBLE ValueTypeFromName(
+                const std::string &_typeName);
+
+    /// \brief Properties of a parameter that come from the specification and
+    /// are the same for all copies of it.
+    public: struct Description
+    {
+      /// \brief Key value. Keys come from the specification, so they are
+      /// interned and shared between all params with the same key.
+      public: InternedString key;
+
+      /// \brief True if the parameter is required.
+      public: bool required = false;
+
+      //// \brief Name of the type.
+      public: InternedString typeName;
+
+      /// \brief Type of the value, resolved from typeName.
+      public: ValueType valueType = ValueType::UNKNOWN;
+
+      /// \brief Description of the parameter.
+      public: InternedString description;
+
+      /// \brief This parameter's default value that was provided as a string
+      public: std::string defaultStrValue;
+
+      /// \brief This parameter's default value
+      public: ParamVariant defaultValue;
+
+      /// \brief This parameter's minimum allowed value
+      public: std::optional<ParamVariant> minValue;
+
+      /// \brief This parameter's maximum allowed value
+      public: std::optional<ParamVariant> maxValue;
+
+      /// \brief Type registered with Param::RegisterValueType, or nullptr
+      /// for built-in types. The value of such a parameter is kept in
+      /// customValue, and `value` holds a string.
+      public: std::shared_ptr<const ParamCustomValueType> customType;
+
+      /// \brief Default value of a parameter whose type is customType.
+      public: std::any customDefaultValue;
+    };
+
+    /// \brief Properties from the specification. Copies of a parameter,
+    /// such as the parameters of elements cloned from the description of an
+    /// element, share the same object; it is replaced rather than modified
+    /// when one of them changes.
+    public: std::shared_ptr<const Description> desc;
+
+    /// \brief True if the parameter is set.
+    public: bool set;
 
     /// \brief True if the value has been parsed while ignoring its parent
     /// element's attributes, and will continue to ignore them for subsequent
     /// reparses.
     public: bool ignoreParentAttributes;
 
-    /// \brief This parameter's value that was provided as a string
-    public: std::optional<std::string> strValue;
+    /// \brief True if strValue was set by Param::SetFromStringLazy and has
+    /// not been converted to value yet.
+    public: bool lazyValuePending = false;
+
+    /// \brief True if the value set by Param::SetFromStringLazy is checked
+    /// against the minimum and maximum allowed values when it is converted.
+    public: bool checkLazyValue = true;
+
+    /// \brief Parent element.
+    public: ElementWeakPtr parentElement;
+
+    /// \brief Pointer to the parent element, set with `parentElement`, so
+    /// that it can be used without locking `parentElement`.
+    public: Element *parentElementRaw = nullptr;
 
-    /// \brief This parameter's default value that was provided as a string
-    public: std::string defaultStrValue;
+    /// \brief Get the parent element without changing its reference counts.
+    /// \return The parent element, or nullptr if there is none or if it was
+    /// destroyed.
+    public: Element *ParentElement() const
+    {
+      return this->parentElement.expired() ? nullptr : this->parentElementRaw;
+    }
+
+    /// \brief Check whether the value was converted from a string whose
+    /// meaning depends on the attributes of the parent element, as the
+    /// rotation of a pose depends on @degrees and @rotation_format. Other
+    /// values do not change when those attributes change, and need not be
+    /// reparsed.
+    /// \return True if the value is a pose that was not set while ignoring
+    /// the attributes of the parent element.
+    public: bool DependsOnParentAttributes() const
+    {
+      return !this->ignoreParentAttributes &&
+          std::holds_alternative<ignition::math::Pose3d>(this->value);
+    }
 
-    /// \brief This parameter's default value
-    public: ParamVariant defaultValue;
+    /// \brief Update function pointer.
+    public: std::function<std::any ()> updateFunc;
+
+    /// \brief This parameter's value
+    public: ParamVariant value;
 
-    /// \brief This parameter's minimum allowed value
-    public: std::optional<ParamVariant> minValue;
+    /// \brief Value of a parameter whose type was registered with
+    /// Param::RegisterValueType, see Description::customType.
+    public: std::any customValue;
 
-    /// \brief This parameter's maximum allowed value
-    public: std::optional<ParamVariant> maxValue;
+    /// \brief This parameter's value that was provided as a string
+    public: std::optional<std::string> strValue;
 
     /// \brief Method used to set the Param from a passed-in string
     /// \param[in] _typeName The data type of the value to set
@@ -401,23 +638,33 @@ namespace sdf
                                     const std::string &_valueStr,
                                     ParamVariant &_valueToSet) const;
 
+    /// \brief Method used to set the Param from a passed-in string
+    /// \param[in] _type The data type of the value to set
+    /// \param[in] _valueStr The value as a string
+    /// \param[out] _valueToSet The value to set
+    /// \return True if the value was successfully set, false otherwise
+    public: bool SDFORMAT_VISIBLE ValueFromStringImpl(
+                                    ValueType _type,
+                                    const std::string &_valueStr,
+                                    ParamVariant &_valueToSet) const;
+
     /// \brief Method used to get the string representation from a ParamVariant,
     /// or the string that was used to set it.
     /// \param[in] _config Print configuration for the string output
-    /// \param[in] _typeName The data type of the value
+    /// \param[in] _type The data type of the value
     /// \param[in] _value The value
     /// \param[out] _valueStr The output string.
     /// \return True if the string was successfully retrieved, false otherwise.
     public: bool StringFromValueImpl(
                 const PrintConfig &_config,
-                const std::string &_typeName,
+                ValueType _type,
                 const ParamVariant &_value,
                 std::string &_valueStr) const;
 
     /// \brief Method used to get the string representation from a ParamVariant,
     /// or the string that was used to set it.
     /// \param[in] _config Print configuration for the string output
-    /// \param[in] _typeName The data type of the value
+    /// \param[in] _type The data type of the value
     /// \param[in] _value The value
     /// \param[in] _orignalStr The original string that was used to set the
     /// value. A nullopt can be passed in if it is not available.
@@ -425,7 +672,7 @@ namespace sdf
     /// \return True if the string was successfully retrieved, false otherwise.
     public: bool StringFromValueImpl(
                 const PrintConfig &_config,
-                const std::string &_typeName,
+                ValueType _type,
                 const ParamVariant &_value,
                 const std::optional<std::string> &_originalStr,
                 std::string &_valueStr) const;
@@ -484,22 +731,64 @@ namespace sdf
     this->dataPtr->updateFunc = _updateFunc;
   }
 
+  ///////////////////////////////////////////////
+  template<typename T>
+  bool Param::RegisterValueType(const std::string &_typeName,
+      std::function<bool(const std::string &, T &)> _fromString,
+      std::function<std::string(const T &)> _toString)
+  {
+    if (!_fromString || !_toString)
+      return false;
+
+    auto type = std::make_shared<ParamCustomValueType>();
+    type->typeName = _typeName;
+    type->type = &typeid(T);
+    type->fromString = [_fromString](const std::string &_str, std::any &_out)
+    {
+      T value{};
+      if (!_fromString(_str, value))
+        return false;
+      _out = std::move(value);
+      return true;
+    };
+    type->toString = [_toString](const std::any &_value)
+    {
+      return _toString(std::any_cast<const T &>(_value));
+    };
+    return RegisterCustomValueType(std::move(type));
+  }
+
   ///////////////////////////////////////////////
   template<typename T>
   bool Param::Set(const T &_value)
   {
-    try
+    const auto &customType = this->dataPtr->desc->customType;
+    if (customType && *customType->type == typeid(T))
+      return this->SetCustomValue(std::any(_value));
+
+    if constexpr (IsStreamable<T>::value)
     {
-      std::stringstream ss;
-      ss << _value;
-      return this->SetFromString(ss.str(), true);
+      try
+      {
+        std::stringstream ss;
+        ss << _value;
+        return this->SetFromString(ss.str(), true);
+      }
+      catch(...)
+      {
+        sdferr << "Unable to set parameter["
+               << this->dataPtr->desc->key << "]."
+               << "Type used must have a stream input and output operator,"
+               << "which allows proper functioning of Param.\n";
+        return false;
+      }
     }
-    catch(...)
+    else
     {
       sdferr << "Unable to set parameter["
-             << this->dataPtr->key << "]."
-             << "Type used must have a stream input and output operator,"
-             << "which allows proper functioning of Param.\n";
+             << this->dataPtr->desc->key << "] of type["
+             << this->dataPtr->desc->typeName << "] from type["
+             << typeid(T).name() << "].\n";
       return false;
     }
   }
@@ -508,8 +797,33 @@ namespace sdf
   template<typename T>
   bool Param::Get(T &_value) const
   {
-    T *value = std::get_if<T>(&this->dataPtr->value);
-    if (value)
+    if (!this->ParseLazyValue())
+      return false;
+
+    if (this->dataPtr->desc->customType)
+    {
+      if (const T *value = std::any_cast<T>(&this->dataPtr->customValue))
+      {
+        _value = *value;
+        return true;
+      }
+      if constexpr (std::is_same_v<T, std::string>)
+      {
+        _value = this->GetAsString();
+        return true;
+      }
+      sdferr << "Unable to get parameter[" << this->dataPtr->desc->key
+             << "] of type[" << this->dataPtr->desc->typeName
+             << "] as type[" << typeid(T).name() << "]\n";
+      return false;
+    }
+
+    if constexpr (!IsVariantAlternative<T, ParamPrivate::ParamVariant>::value)
+    {
+      sdferr << "Unknown parameter type[" << typeid(T).name() << "]\n";
+      return false;
+    }
+    else if (T *value = std::get_if<T>(&this->dataPtr->value))
     {
       _value = *value;
     }
@@ -530,7 +844,7 @@ namespace sdf
       {
         _value = std::get<T>(pv);
       }
-      else if (typeStr == "bool" && this->dataPtr->typeName == "string")
+      else if (typeStr == "bool" && this->dataPtr->desc->typeName == "string")
       {
         // this section for handling bool types is to keep backward behavior
         // TODO(anyone) remove for Fortress. For more details:
@@ -553,35 +867,80 @@ namespace sdf
     return true;
   }
 
+  ///////////////////////////////////////////////
+  template<typename T>
+  const T *Param::GetPtr() const
+  {
+    if (!this->ParseLazyValue())
+      return nullptr;
+
+    if (this->dataPtr->desc->customType)
+      return std::any_cast<T>(&this->dataPtr->customValue);
+
+    if constexpr (IsVariantAlternative<T, ParamPrivate::ParamVariant>::value)
+      return std::get_if<T>(&this->dataPtr->value);
+    else
+      return nullptr;
+  }
+
   ///////////////////////////////////////////////
   template<typename T>
   bool Param::GetDefault(T &_value) const
   {
-    std::stringstream ss;
+    if (this->dataPtr->desc->customType)
+    {
+      if (const T *value =
+          std::any_cast<T>(&this->dataPtr->desc->customDefaultValue))
+      {
+        _value = *value;
+        return true;
+      }
+      sdferr << "Unable to get the default value of parameter["
+             << this->dataPtr->desc->key << "] of type["
+             << this->dataPtr->desc->typeName << "] as type["
+             << typeid(T).name() << "]\n";
+      return false;
+    }
 
-    try
+    if constexpr (IsStreamable<T>::value)
     {
-      ss << ParamStreamer{this->dataPtr->defaultValue};
-      ss >> _value;
+      std::stringstream ss;
+
+      try
+      {
+        ss << ParamStreamer{this->dataPtr->desc->defaultValue};
+        ss >> _value;
+      }
+      catch(...)
+      {
+        sdferr << "Unable to convert parameter["
+               << this->dataPtr->desc->key << "] "
+               << "whose type is["
+               << this->dataPtr->desc->typeName << "], to "
+               << "type[" << typeid(T).name() << "]\n";
+        return false;
+      }
+
+      return true;
     }
-    catch(...)
+    else
     {
-      sdferr << "Unable to convert parameter["
-             << this->dataPtr->key << "] "
-             << "whose type is["
-             << this->dataPtr->typeName << "], to "
-             << "type[" << typeid(T).name() << "]\n";
+      sdferr << "Unknown parameter type[" << typeid(T).name() << "]\n";
       return false;
     }
-
-    return true;
   }
 
   ///////////////////////////////////////////////
   template<typename Type>
   bool Param::IsType() const
   {
-    return std::holds_alternative<Type>(this->dataPtr->value);
+    if (this->dataPtr->desc->customType)
+      return *this->dataPtr->desc->customType->type == typeid(Type);
+
+    if constexpr (IsVariantAlternative<Type, ParamPrivate::ParamVariant>::value)
+      return std::holds_alternative<Type>(this->dataPtr->value);
+    else
+      return false;
   }
   }
 }
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_PARAMUPDATETABLE_HH_
+#define SDF_PARAMUPDATETABLE_HH_
+
+#include <cstddef>
+#include <string>
+#include <variant>
+
+#include <ignition/utils/ImplPtr.hh>
+
+#include "sdf/Element.hh"
+#include "sdf/Param.hh"
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+
+/// \brief Table of typed bindings from variables of the application to
+/// parameters of an element tree, to update many parameters at once, for
+/// example to write live simulation state into the elements before
+/// Element::ToString. Unlike Param::SetUpdateFunc and Element::Update, an
+/// update copies each variable straight into its parameter, without calling
+/// a std::function nor converting through std::any, and the bindings can be
+/// updated on several threads.
+///
+/// The table keeps the bound parameters alive. The variables must outlive
+/// the table, and must not be written while the table is updated.
+class SDFORMAT_VISIBLE ParamUpdateTable
+{
+  /// \brief Default constructor.
+  public: ParamUpdateTable();
+
+  /// \brief Bind a variable to a parameter.
+  /// \param[in] _param The parameter.
+  /// \param[in] _source The variable that the parameter is set to on each
+  /// update. Its type must be the type of the parameter.
+  /// \return False if _param or _source is nullptr, or if the parameter has
+  /// another type.
+  public: template <typename T>
+          bool Add(const ParamPtr &_param, const T *_source);
+
+  /// \brief Bind a variable to the value or to an attribute of an element.
+  /// \param[in] _elem The element.
+  /// \param[in] _key Name of the attribute, or an empty string for the
+  /// value of the element.
+  /// \param[in] _source The variable that the parameter is set to on each
+  /// update. Its type must be the type of the parameter.
+  /// \return False if the element has no such parameter, if _source is
+  /// nullptr, or if the parameter has another type.
+  public: template <typename T>
+          bool Add(const ElementPtr &_elem, const std::string &_key,
+                   const T *_source);
+
+  /// \brief Get the number of bindings.
+  /// \return Number of bindings.
+  public: std::size_t Size() const;
+
+  /// \brief Remove all the bindings.
+  public: void Clear();
+
+  /// \brief Set all the bound parameters to the current values of their
+  /// variables.
+  /// \param[in] _threadCount Number of tasks to split the update into,
+  /// which run on the pool of TaskExecutor::Threaded. 0 and 1 update the
+  /// parameters on the calling thread.
+  public: void Update(std::size_t _threadCount = 1) const;
+
+  /// \brief Function that copies a variable into a parameter.
+  private: using AssignFunction = void (*)(Param &, const void *);
+
+  /// \brief Add a binding.
+  /// \param[in] _param The parameter.
+  /// \param[in] _source The variable.
+  /// \param[in] _assign Function that copies the variable into the parameter.
+  private: void AddBinding(const ParamPtr &_param, const void *_source,
+                           AssignFunction _assign);
+
+  /// \brief Copy a variable into a parameter, as Param::Update does.
+  /// \param[in] _param The parameter.
+  /// \param[in] _source The variable, a pointer to T.
+  private: template <typename T>
+           static void Assign(Param &_param, const void *_source);
+
+  /// \brief Private data pointer.
+  IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+
+///////////////////////////////////////////////
+template <typename T>
+bool ParamUpdateTable::Add(const ParamPtr &_param, const T *_source)
+{
+  if (!_param || !_source ||
+      !std::holds_alternative<T>(_param->dataPtr->value))
+  {
+    return false;
+  }
+  this->AddBinding(_param, _source, &ParamUpdateTable::Assign<T>);
+  return true;
+}
+
+///////////////////////////////////////////////
+template <typename T>
+bool ParamUpdateTable::Add(const ElementPtr &_elem, const std::string &_key,
+    const T *_source)
+{
+  if (!_elem)
+    return false;
+  return this->Add(_key.empty() ? _elem->GetValue() :
+                   _elem->GetAttribute(_key), _source);
+}
+
+///////////////////////////////////////////////
+template <typename T>
+void ParamUpdateTable::Assign(Param &_param, const void *_source)
+{
+  _param.dataPtr->lazyValuePending = false;
+  _param.InvalidateParentContentHash();
+  std::get<T>(_param.dataPtr->value) = *static_cast<const T *>(_source);
+}
+}
+}
+#endif
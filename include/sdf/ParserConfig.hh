@@ -18,15 +18,24 @@
 #ifndef SDF_PARSER_CONFIG_HH_
 #define SDF_PARSER_CONFIG_HH_
 
+#include <cstddef>
 #include <functional>
+#include <future>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/utils/ImplPtr.hh>
 
 #include "sdf/Error.hh"
 #include "sdf/InterfaceElements.hh"
+#include "sdf/LoadProfile.hh"
+#include "sdf/LoadTrace.hh"
+#include "sdf/ResourceProvider.hh"
+#include "sdf/TaskExecutor.hh"
 #include "sdf/sdf_config.h"
 #include "sdf/system_util.hh"
 
@@ -48,9 +57,36 @@ enum class EnforcementPolicy
   LOG,
 };
 
+/// \brief How thoroughly documents are validated while they are loaded
+enum class ValidationLevel
+{
+  /// \brief Run every check
+  FULL,
+
+  /// \brief Check the structure of documents, such as unique names, joint
+  /// parent and child frames and the frame graphs, but do not check values
+  /// against their minimum and maximum allowed values
+  STRUCTURAL,
+
+  /// \brief Trust documents that were already validated and skip the name,
+  /// joint and frame graph checks as well as the value range checks. The
+  /// frame graphs needed to resolve poses are still built, and errors found
+  /// while building them are still reported.
+  NONE,
+};
+
 // Forward declare private data class.
 class ParserConfigPrivate;
 
+// Forward declare the caches of included files and file lookups.
+class FindFileCache;
+class FindFileRequests;
+class IncludeCache;
+class InterfaceModelCache;
+class LoadMonitor;
+class ModelConfigCache;
+class XmlDocumentPool;
+
 /// This class contains configuration options for the libsdformat parser.
 ///
 /// The configuration options include:
@@ -66,6 +102,13 @@ class ParserConfigPrivate;
 /// the ParserConfig object is omitted, these functions will use the singleton
 /// ParserConfig object.
 ///
+/// All parsing state is taken from the ParserConfig object that is passed in,
+/// so documents can be parsed concurrently on different threads, each with its
+/// own ParserConfig. A ParserConfig object may also be shared between threads
+/// as long as it is not modified while it is in use. The singleton returned by
+/// ParserConfig::GlobalConfig() is not synchronized, so sdf::setFindCallback()
+/// and sdf::addURIPath() must not be called while other threads are parsing.
+///
 /// Example:
 /// To set an additional URI scheme search directory without affecting the
 /// global config,
@@ -87,6 +130,22 @@ class SDFORMAT_VISIBLE ParserConfig
   public: using SchemeToPathMap =
           std::map<std::string, std::vector<std::string> >;
 
+  /// \brief Function that starts resolving a file name, and returns a
+  /// future for the complete path of the file, or for an empty string if
+  /// the file was not found.
+  public: using AsyncFindFileCallback =
+          std::function<std::future<std::string>(const std::string &)>;
+
+  /// \brief Function that decides whether an element is read.
+  /// \param[in] _parentName Name of the parent of the element.
+  /// \param[in] _name Name of the element.
+  /// \param[in] _type Value of the "type" attribute of the element, or an
+  /// empty string if it has none.
+  /// \return True to read the element, false to skip it.
+  public: using ElementFilterFunction = std::function<bool(
+              const std::string &_parentName, const std::string &_name,
+              const std::string &_type)>;
+
   /// \brief Default constructor
   public: ParserConfig();
 
@@ -117,6 +176,25 @@ class SDFORMAT_VISIBLE ParserConfig
   public: void SetFindCallback(
               std::function<std::string(const std::string &)> _cb);
 
+  /// \brief Set a callback that resolves files asynchronously, such as by
+  /// downloading the models of remote URIs. When it is set, it is used
+  /// instead of the find callback. Before the children of an element are
+  /// read, it is called for the URI of each <include> child that is not
+  /// found in the search paths of sdf::findFile(), so that the URIs are
+  /// resolved concurrently, and the parser waits for the path of each one
+  /// when it reads its <include>. The callback should return promptly and
+  /// do its work in the background. It may be called from several threads,
+  /// but only once at a time. A future that throws an exception is treated
+  /// as a file that was not found.
+  /// \param[in] _cb The callback, or an empty function to use the find
+  /// callback.
+  /// \sa SetFindCallback
+  public: void SetAsyncFindCallback(AsyncFindFileCallback _cb);
+
+  /// \brief Get the callback that resolves files asynchronously.
+  /// \return The callback, or an empty function if it is not set.
+  public: AsyncFindFileCallback AsyncFindCallback() const;
+
   /// \brief Get the URI scheme to search directories map
   /// \return Immutable reference to the URI scheme to search directories map
   public: const SchemeToPathMap &URIPathMap() const;
@@ -168,12 +246,67 @@ class SDFORMAT_VISIBLE ParserConfig
   /// \brief Get the registered custom model parsers
   public: const std::vector<CustomModelParser> &CustomModelParsers() const;
 
+  /// \brief Set whether the interface models parsed by the custom model
+  /// parsers are cached. When enabled, the custom model parsers are called
+  /// once per resolved file, in one document or in successive calls to
+  /// Root::Load with this configuration, with a NestedInclude that only has
+  /// its URI and resolved file name set. Every include of that file gets a
+  /// copy of the cached interface model with the //include/name and
+  /// //include/static overrides applied, and whose nested models are shared
+  /// with the cached model; //include/pose is applied by libsdformat as
+  /// usual. Files that none of the custom model parsers handle are cached
+  /// too, so the parsers are not called again for them. A cached file is
+  /// parsed again if its modification time changes, and files that fail to
+  /// parse are not cached. Copies of this configuration share the same
+  /// cache.
+  /// \param[in] _useInterfaceModelCache True to cache interface models. The
+  /// default is false.
+  public: void SetUseInterfaceModelCache(bool _useInterfaceModelCache);
+
+  /// \brief Get whether the interface models parsed by the custom model
+  /// parsers are cached.
+  /// \return True if interface models are cached.
+  public: bool UseInterfaceModelCache() const;
+
+  /// \brief Remove all files from the interface model cache.
+  /// \sa SetUseInterfaceModelCache
+  public: void ClearInterfaceModelCache();
+
+  /// \brief Set whether the registered custom model parsers can be called
+  /// from several threads at once. When enabled, the <include> elements of
+  /// a model or world are parsed by the custom model parsers concurrently,
+  /// and the resulting interface models and errors are merged in document
+  /// order, so they are the same as when parsing serially.
+  /// \param[in] _threadSafe True if the custom model parsers are
+  /// thread-safe. The default is false.
+  public: void SetCustomModelParsersThreadSafe(bool _threadSafe);
+
+  /// \brief Get whether the registered custom model parsers can be called
+  /// from several threads at once.
+  /// \return True if the custom model parsers are thread-safe.
+  public: bool CustomModelParsersThreadSafe() const;
+
   /// \brief Set the preserveFixedJoint flag.
   public: void URDFSetPreserveFixedJoint(bool _preserveFixedJoint);
 
   /// \brief Get the preserveFixedJoint flag value.
   public: bool URDFPreserveFixedJoint() const;
 
+  /// \brief Set a directory where the SDF documents converted from URDF
+  /// files are cached. A converted document is stored in a file named after
+  /// a hash of the content of the URDF file, the URDF options of this
+  /// configuration and the SDFormat version, and is read instead of
+  /// converting a URDF file with the same key again, even by another
+  /// process. The directory is created when the first document is stored.
+  /// \param[in] _directory Path of the cache directory, or an empty string
+  /// to convert every URDF file. The default is an empty string.
+  public: void URDFSetCacheDirectory(const std::string &_directory);
+
+  /// \brief Get the directory where converted URDF files are cached.
+  /// \return Path of the cache directory, or an empty string if converted
+  /// URDF files are not cached.
+  public: const std::string &URDFCacheDirectory() const;
+
   /// \brief Several DOM classes have ToElement() methods that return an
   /// XML Element populated from the contents of the DOM object. When
   /// populating the details of a model that was included using the
@@ -196,6 +329,469 @@ class SDFORMAT_VISIBLE ParserConfig
   /// if the fully populated model is returned instead.
   public: bool ToElementUseIncludeTag() const;
 
+  /// \brief Set the number of threads used to load the files referenced by
+  /// the <include> elements of a document. All includes that are children of
+  /// the same element are resolved and parsed concurrently, and the results
+  /// are merged in document order, so the parsed document and the reported
+  /// errors are the same as when loading serially. Includes nested inside an
+  /// included file are loaded serially by the thread that loads that file.
+  /// When more than one thread is used, the find file callback may be called
+  /// from several threads at once.
+  /// \param[in] _count Number of threads. Values of 0 and 1 load includes
+  /// serially. The default is 0.
+  public: void SetIncludeLoadThreadCount(std::size_t _count);
+
+  /// \brief Get the number of threads used to load the files referenced by
+  /// <include> elements.
+  /// \return Number of threads. A value of 0 or 1 means that includes are
+  /// loaded serially.
+  public: std::size_t IncludeLoadThreadCount() const;
+
+  /// \brief Set the number of threads used to build the frame graphs of the
+  /// worlds of a document in Root::Load and Root::UpdateGraphs. The graphs of
+  /// the top-level models of a world are built concurrently, each one on its
+  /// own, and then stitched into the graphs of the world in document order,
+  /// so the graphs and the reported errors are the same as when building
+  /// them serially.
+  /// \param[in] _count Number of threads. Values of 0 and 1 build graphs
+  /// serially. The default is 0.
+  public: void SetGraphBuildThreadCount(std::size_t _count);
+
+  /// \brief Get the number of threads used to build the frame graphs of
+  /// worlds.
+  /// \return Number of threads. A value of 0 or 1 means that graphs are
+  /// built serially.
+  public: std::size_t GraphBuildThreadCount() const;
+
+  /// \brief Set the number of threads used to load the worlds of a document
+  /// in Root::Load. Each world is loaded and its frame graphs are built on
+  /// one thread, and the worlds and the reported errors are then collected
+  /// in document order, so they are the same as when loading serially.
+  /// Worlds are loaded serially if there are custom model parsers that are
+  /// not thread-safe, see SetCustomModelParsersThreadSafe.
+  /// \param[in] _count Number of threads. Values of 0 and 1 load worlds
+  /// serially. The default is 0.
+  public: void SetWorldLoadThreadCount(std::size_t _count);
+
+  /// \brief Get the number of threads used to load the worlds of a
+  /// document.
+  /// \return Number of threads. A value of 0 or 1 means that worlds are
+  /// loaded serially.
+  public: std::size_t WorldLoadThreadCount() const;
+
+  /// \brief Set the number of threads used to load the links, joints and
+  /// frames of a model in Model::Load. They are loaded concurrently, and
+  /// their names are then checked and the objects and errors collected in
+  /// document order, so they are the same as when loading serially. Models
+  /// with fewer than 64 links, joints and frames are loaded serially, since
+  /// starting the threads costs more than it saves.
+  /// \param[in] _count Number of threads. Values of 0 and 1 load the
+  /// contents of models serially. The default is 0.
+  public: void SetModelLoadThreadCount(std::size_t _count);
+
+  /// \brief Get the number of threads used to load the links, joints and
+  /// frames of a model.
+  /// \return Number of threads. A value of 0 or 1 means that the contents
+  /// of models are loaded serially.
+  public: std::size_t ModelLoadThreadCount() const;
+
+  /// \brief Set the number of errors after which loading a document stops.
+  /// Once this many errors are found, parsing stops before the next element
+  /// and adds an error with the ERROR_LIMIT_REACHED code, the DOM objects
+  /// are not loaded from a document that has this many parsing errors, and
+  /// validation is skipped. The worlds of a document are loaded in document
+  /// order until they have this many errors, and the worlds after them are
+  /// not loaded and their errors are not reported. The same worlds are
+  /// loaded whether worlds are loaded concurrently or serially, see
+  /// SetWorldLoadThreadCount.
+  /// \param[in] _maxErrors Number of errors, or 0 for no limit. The default
+  /// is 0.
+  public: void SetMaxErrors(std::size_t _maxErrors);
+
+  /// \brief Get the number of errors after which loading a document stops.
+  /// \return Number of errors, or 0 if there is no limit.
+  public: std::size_t MaxErrors() const;
+
+  /// \brief Set the executor that runs the parallel parts of loading
+  /// documents with this configuration: loading included files, building
+  /// the frame graphs of worlds, loading worlds and loading the contents of
+  /// models. The thread count options above give the number of tasks that
+  /// each of them submits to it.
+  /// \param[in] _executor The executor, or nullptr for the default, which
+  /// is TaskExecutor::Threaded.
+  public: void SetExecutor(std::shared_ptr<TaskExecutor> _executor);
+
+  /// \brief Get the executor that runs the parallel parts of loading
+  /// documents with this configuration.
+  /// \return The executor, which is never nullptr.
+  public: std::shared_ptr<TaskExecutor> Executor() const;
+
+  /// \brief Set the provider that files are found in and read from,
+  /// instead of the filesystem. It is used by sdf::findFile, to read the
+  /// model.config of model directories and to read SDFormat and URDF files,
+  /// including included files. Files of a provider are not cached by the
+  /// include and model configuration caches, and their upgraded copies are
+  /// not used, see SetUseUpgradedFiles. Top-level models are not streamed
+  /// from them either, see SetStreamWorldModels. Setting a provider clears
+  /// the find file cache of this configuration. The directories of
+  /// AddURIPath must exist in the provider, so it is set before them.
+  /// \param[in] _provider The provider, or nullptr to read files from the
+  /// filesystem, which is the default.
+  public: void SetResourceProvider(
+              std::shared_ptr<ResourceProvider> _provider);
+
+  /// \brief Get the provider that files are found in and read from.
+  /// \return The provider, or nullptr if files are read from the
+  /// filesystem.
+  public: std::shared_ptr<ResourceProvider> GetResourceProvider() const;
+
+  /// \brief Set whether the top-level models of the worlds of a file are
+  /// read one at a time. When enabled, sdf::readFile scans the file once
+  /// without building an XML document for it, then parses the XML of each
+  /// <model> child of a <world> on its own, right before it is converted to
+  /// sdf::Element objects, and frees it right after. The peak memory used
+  /// while reading a world with many models is then close to the size of the
+  /// parsed elements. The parsed document, line numbers and errors are the
+  /// same as when the option is disabled. Files that need to be converted
+  /// from an older SDFormat version, and documents read from strings, are
+  /// read as a whole.
+  /// \param[in] _streamWorldModels True to read world models one at a time.
+  /// The default is false.
+  public: void SetStreamWorldModels(bool _streamWorldModels);
+
+  /// \brief Get whether the top-level models of the worlds of a file are
+  /// read one at a time.
+  /// \return True if world models are read one at a time.
+  public: bool StreamWorldModels() const;
+
+  /// \brief Set whether the upgraded copies of files that are written by
+  /// `ign sdf --upgrade` are read instead of the files. When enabled,
+  /// sdf::readFile reads the copy named after the current SDFormat version
+  /// next to a file, for example model-1_9.sdf next to model.sdf, if the
+  /// copy was made from the current content of the file, and skips the
+  /// conversion of the file. Upgraded copies that are named by a
+  /// model.config are read only if their source file was not modified
+  /// after it was upgraded; otherwise the source file is read and
+  /// converted. Files read without conversion are never replaced.
+  /// \param[in] _useUpgradedFiles True to read upgraded copies of files.
+  /// The default is true.
+  public: void SetUseUpgradedFiles(bool _useUpgradedFiles);
+
+  /// \brief Get whether the upgraded copies of files are read instead of
+  /// the files.
+  /// \return True if upgraded copies of files are read.
+  public: bool UseUpgradedFiles() const;
+
+  /// \brief Set whether the files read for <include> elements are cached.
+  /// When enabled, a file that is included several times, in one document or
+  /// in successive calls to Root::Load with this configuration, is read and
+  /// converted once and the parsed elements are copied for every other
+  /// include of that file. A cached file is read again if its modification
+  /// time changes. Changes to files included by a cached file, or to this
+  /// configuration, are not detected; call ClearIncludeCache() after making
+  /// them. Copies of this configuration share the same cache.
+  /// \param[in] _useIncludeCache True to cache included files. The default
+  /// is false.
+  public: void SetUseIncludeCache(bool _useIncludeCache);
+
+  /// \brief Get whether the files read for <include> elements are cached.
+  /// \return True if included files are cached.
+  public: bool UseIncludeCache() const;
+
+  /// \brief Remove all files from the include cache.
+  /// \sa SetUseIncludeCache
+  public: void ClearIncludeCache();
+
+  /// \brief Set whether the tinyxml2 documents that files and strings are
+  /// parsed into are reused. When enabled, a document that was used to read
+  /// a file, a string or a streamed world model is cleared and kept for the
+  /// next one, instead of being destroyed, so that the memory pools of
+  /// tinyxml2 are not allocated and freed again for every document. This
+  /// helps programs that load many small documents at a high rate. Copies
+  /// of this configuration share the same documents.
+  /// \param[in] _reuseXmlDocuments True to reuse XML documents. The default
+  /// is false.
+  public: void SetReuseXmlDocuments(bool _reuseXmlDocuments);
+
+  /// \brief Get whether the tinyxml2 documents that files and strings are
+  /// parsed into are reused.
+  /// \return True if XML documents are reused.
+  public: bool ReuseXmlDocuments() const;
+
+  /// \brief Set whether the model files chosen from the model.config of
+  /// model directories are cached. When enabled, the model.config (or
+  /// manifest.xml) of a directory that is included several times, in one
+  /// document or in successive calls to Root::Load with this configuration,
+  /// is read once by sdf::getModelFilePath, and the chosen model file and
+  /// its version are reused for every other include of that directory. A
+  /// cached directory is read again if the modification time of its
+  /// configuration file changes. Copies of this configuration share the
+  /// same cache.
+  /// \param[in] _useModelConfigCache True to cache model configurations.
+  /// The default is false.
+  public: void SetUseModelConfigCache(bool _useModelConfigCache);
+
+  /// \brief Get whether the model files chosen from model configurations
+  /// are cached.
+  /// \return True if model configurations are cached.
+  public: bool UseModelConfigCache() const;
+
+  /// \brief Remove all model directories from the model configuration
+  /// cache.
+  /// \sa SetUseModelConfigCache
+  public: void ClearModelConfigCache();
+
+  /// \brief Set whether the results of sdf::findFile() are cached. When
+  /// enabled, each file name is searched for once and later lookups of the
+  /// same name return the cached path without touching the file system.
+  /// Files that were not found are cached as well. Results that can change
+  /// are discarded when AddURIPath() or SetFindCallback() is called. Call
+  /// ClearFindFileCache() after other changes that affect the search, such
+  /// as files being created or removed, the SDF_PATH environment variable or
+  /// the working directory changing. Copies of this configuration get a copy
+  /// of the cache.
+  /// \param[in] _useFindFileCache True to cache file lookups. The default is
+  /// false.
+  public: void SetUseFindFileCache(bool _useFindFileCache);
+
+  /// \brief Get whether the results of sdf::findFile() are cached.
+  /// \return True if file lookups are cached.
+  public: bool UseFindFileCache() const;
+
+  /// \brief Remove all results from the find file cache.
+  /// \sa SetUseFindFileCache
+  public: void ClearFindFileCache();
+
+  /// \brief Set whether the values and attributes read from a file are
+  /// converted to their types when they are first used instead of while
+  /// parsing. When enabled, the parser only stores the string of each value
+  /// with Param::SetFromStringLazy, so that values which are never read,
+  /// for example those of <gui> or <plugin> elements, are never converted.
+  /// Values that cannot be converted, or that are outside of their allowed
+  /// range, are then reported on the console when they are first used
+  /// instead of as parsing errors, and the parameter keeps its default value.
+  /// \param[in] _lazyParamParsing True to convert values when they are first
+  /// used. The default is false.
+  public: void SetLazyParamParsing(bool _lazyParamParsing);
+
+  /// \brief Get whether values are converted when they are first used.
+  /// \return True if values are converted when they are first used.
+  public: bool LazyParamParsing() const;
+
+  /// \brief Set whether the elements that are copied without being
+  /// interpreted, which are the contents of <plugin> elements and the
+  /// elements that are not part of the specification such as custom
+  /// (xmlns) elements, are kept as XML text. When enabled, each of these
+  /// elements only stores its name and its XML text, available from
+  /// Element::RawXml, instead of being converted to a tree of elements and
+  /// string parameters. Their attributes, values and children can then
+  /// only be read by parsing the text.
+  /// \param[in] _rawXml True to keep copied elements as XML text. The
+  /// default is false.
+  public: void SetCopyElementsAsRawXml(bool _rawXml);
+
+  /// \brief Get whether copied elements are kept as XML text.
+  /// \return True if copied elements are kept as XML text.
+  public: bool CopyElementsAsRawXml() const;
+
+  /// \brief Set whether the DOM objects loaded by Root::Load release the
+  /// elements they are loaded from. By default, every DOM object keeps a
+  /// reference to its element, so a loaded sdf::Root keeps the whole tree of
+  /// elements and parameters alive. When enabled, the elements are freed
+  /// once Root::Load completes and only the DOM objects stay in memory.
+  /// The Element() functions of Root and of the objects it loads then
+  /// return nullptr, and the children of the interface models returned by
+  /// custom model parsers are loaded while building the frame graphs even
+  /// if they are not referenced.
+  /// \param[in] _releaseElements True to release the elements. The default
+  /// is false.
+  public: void SetReleaseElements(bool _releaseElements);
+
+  /// \brief Get whether the DOM objects loaded by Root::Load release the
+  /// elements they are loaded from.
+  /// \return True if the elements are released.
+  public: bool ReleaseElements() const;
+
+  /// \brief Set whether Root::Load shares the identical Geometry, Surface
+  /// and Material objects of collisions and visuals. Worlds that repeat the
+  /// same shapes and materials then keep one copy of each, and the Geom(),
+  /// Surface() and Material() functions of identical collisions and
+  /// visuals return the same pointer. Objects are identical when they are
+  /// loaded from elements with equal Element::ContentHash, and geometries
+  /// when they have the same Geometry::ShapeId. The shared objects are
+  /// never modified: Collision::SetGeom and the other setters replace the
+  /// object of their collision or visual only. The Element() functions of a
+  /// shared object return the element of the first identical object.
+  /// \param[in] _share True to share identical objects. The default is
+  /// false.
+  public: void SetShareIdenticalObjects(bool _share);
+
+  /// \brief Get whether Root::Load shares identical objects.
+  /// \return True if identical objects are shared.
+  public: bool ShareIdenticalObjects() const;
+
+  /// \brief Set whether the top-level models of worlds are loaded into
+  /// sdf::Model objects when they are first used instead of by World::Load.
+  /// When enabled, World::Load only reads the name and the pose of each
+  /// model, which World::ModelStubByIndex returns without loading the
+  /// model, so that tools which list the models of large worlds do not load
+  /// their links, joints and sensors. World::ModelByIndex and
+  /// World::ModelByName load a model the first time they return it, and
+  /// the errors of that load are reported on the console.
+  ///
+  /// Building the frame and pose graphs of a world, assigning entity IDs,
+  /// checking joints and sharing identical objects would load every model,
+  /// so Root::Load skips them for worlds. A model loaded on first use has
+  /// graphs of its own instead, in which the poses of its entities resolve
+  /// relative to the model frame but not to the world. Root::UpdateGraphs
+  /// loads every model and builds the graphs of the worlds.
+  /// \param[in] _lazyWorldModels True to load world models when they are
+  /// first used. The default is false.
+  public: void SetLazyWorldModels(bool _lazyWorldModels);
+
+  /// \brief Get whether world models are loaded when they are first used.
+  /// \return True if world models are loaded when they are first used.
+  public: bool LazyWorldModels() const;
+
+  /// \brief Skip the elements with the given name, and their children,
+  /// while reading documents. Skipped elements never become sdf::Element
+  /// objects, so they are not loaded into the DOM either. A skipped element
+  /// that is required by its parent is not reported as missing, and no
+  /// default element is added in its place. Skipping an element that the
+  /// DOM needs, such as the <parent> of a joint, still causes the DOM load
+  /// to fail.
+  /// \param[in] _name Name of the elements to skip, such as "visual".
+  /// \sa SetElementFilter
+  public: void AddSkippedElement(const std::string &_name);
+
+  /// \brief Get the names of the elements that are skipped.
+  /// \return Names of the skipped elements.
+  public: const std::vector<std::string> &SkippedElements() const;
+
+  /// \brief Set a function that decides which elements are read, in
+  /// addition to the names added with AddSkippedElement(). The function is
+  /// called for every child element of the documents that are read,
+  /// including included files, so it can also be used as an allow-list. It
+  /// is not called for the elements that are skipped by name, nor for the
+  /// contents of elements that are copied as they are, such as <plugin>.
+  /// Skipped elements are handled as described in AddSkippedElement(). Call
+  /// ClearIncludeCache() after changing the filter if the include cache is
+  /// used.
+  /// \param[in] _filter The filter, or an empty function to read every
+  /// element that is not skipped by name.
+  public: void SetElementFilter(ElementFilterFunction _filter);
+
+  /// \brief Get the function that decides which elements are read.
+  /// \return The filter, which is empty if none is set.
+  public: const ElementFilterFunction &ElementFilter() const;
+
+  /// \brief Only read the top-level models of worlds whose position is
+  /// inside a region. The position of each <model> and <include> child of a
+  /// <world> is read from its <pose> before the model is read or the
+  /// included file is loaded, and models outside the region are skipped
+  /// entirely. Models without a pose are at the origin of the world. Models
+  /// whose pose is relative to another frame than the world cannot be
+  /// placed early, so they are always read. Frames, joints and poses of the
+  /// world that refer to skipped models fail to load.
+  /// \param[in] _region Region, in the world frame, of the models to read.
+  public: void SetRegionOfInterest(
+              const ignition::math::AxisAlignedBox &_region);
+
+  /// \brief Read the top-level models of worlds wherever they are. This is
+  /// the default.
+  /// \sa SetRegionOfInterest
+  public: void ClearRegionOfInterest();
+
+  /// \brief Get the region of the top-level models of worlds that are read.
+  /// \return The region, or nullopt if all models are read.
+  public: std::optional<ignition::math::AxisAlignedBox>
+              RegionOfInterest() const;
+
+  /// \brief Set how thoroughly documents are validated by sdf::readFile,
+  /// sdf::readString and Root::Load. Lower levels are meant for documents
+  /// that were already validated, for example by running `ign sdf --check`
+  /// when they were produced.
+  /// \param[in] _level Validation level. The default is
+  /// ValidationLevel::FULL.
+  public: void SetValidationLevel(ValidationLevel _level);
+
+  /// \brief Get how thoroughly documents are validated.
+  /// \return The validation level.
+  public: sdf::ValidationLevel GetValidationLevel() const;
+
+  /// \brief Set a profile to record the time spent in each phase of loading
+  /// documents and included files with this configuration, for example by
+  /// sdf::readFile and Root::Load. The profile keeps accumulating until it
+  /// is reset with LoadProfile::Reset.
+  /// \param[in] _profile The profile, or nullptr to stop recording. The
+  /// default is nullptr.
+  public: void SetProfile(std::shared_ptr<LoadProfile> _profile);
+
+  /// \brief Get the profile that documents loaded with this configuration
+  /// are recorded to.
+  /// \return The profile, or nullptr if loading is not recorded.
+  public: std::shared_ptr<LoadProfile> Profile() const;
+
+  /// \brief Set a trace to record the timeline of loading documents with
+  /// this configuration, in the Chrome trace event format. The trace keeps
+  /// accumulating events until it is reset with LoadTrace::Reset.
+  /// \param[in] _trace The trace, or nullptr to stop recording. The default
+  /// is the trace of LoadTrace::FromEnvironment, which is nullptr unless the
+  /// SDF_TRACE_FILE environment variable is set.
+  public: void SetTrace(std::shared_ptr<LoadTrace> _trace);
+
+  /// \brief Get the trace that documents loaded with this configuration are
+  /// recorded to.
+  /// \return The trace, or nullptr if loading is not traced.
+  public: std::shared_ptr<LoadTrace> Trace() const;
+
+  /// \brief Get the cache of included files.
+  /// \return The cache, or nullptr if included files are not cached.
+  private: std::shared_ptr<IncludeCache> IncludeFileCache() const;
+
+  /// \brief Get the cache of interface models.
+  /// \return The cache, or nullptr if interface models are not cached.
+  private: std::shared_ptr<InterfaceModelCache>
+           InterfaceModelFileCache() const;
+
+  /// \brief Get the cache of model configurations.
+  /// \return The cache, or nullptr if model configurations are not cached.
+  private: std::shared_ptr<ModelConfigCache> ModelConfigFileCache() const;
+
+  /// \brief Get the cache of file lookups.
+  /// \return The cache, or nullptr if file lookups are not cached.
+  private: FindFileCache *FindFileCacheInstance() const;
+
+  /// \brief Get the requests of the asynchronous find callback.
+  /// \return The requests, or nullptr if there is no asynchronous find
+  /// callback.
+  private: std::shared_ptr<FindFileRequests> FindFileRequestsInstance() const;
+
+  /// \brief Get the pool of XML documents of this configuration.
+  /// \return The pool, or nullptr if XML documents are not reused.
+  private: std::shared_ptr<XmlDocumentPool> XmlDocuments() const;
+
+  /// \brief Set the monitor of an asynchronous load.
+  /// \param[in] _monitor The monitor, or nullptr if loading is not
+  /// monitored.
+  private: void SetLoadMonitor(std::shared_ptr<LoadMonitor> _monitor);
+
+  /// \brief Get the monitor of an asynchronous load.
+  /// \return The monitor, or nullptr if loading is not monitored.
+  private: LoadMonitor *LoadMonitorInstance() const;
+
+  /// \brief Allow the caches to be retrieved from a configuration.
+  friend class FindFileCache;
+  friend class FindFileRequests;
+  friend class IncludeCache;
+  friend class InterfaceModelCache;
+  friend class ModelConfigCache;
+  friend class XmlDocumentPool;
+
+  /// \brief Allow asynchronous loads to be monitored.
+  friend class LoadMonitor;
+  friend class LoadTask;
+
   /// \brief Private data pointer.
   IGN_UTILS_IMPL_PTR(dataPtr)
 };
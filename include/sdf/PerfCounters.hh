@@ -0,0 +1,103 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_PERFCOUNTERS_HH_
+#define SDF_PERFCOUNTERS_HH_
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+
+/// \brief Number of times the operations that dominate the loading of
+/// large documents ran, in the whole process, since it started or since the
+/// counters were reset with ResetPerfCounters. Counting only updates
+/// relaxed atomic counters. To remove the counters, define the following
+/// symbol when compiling: SDFORMAT_DISABLE_PERF_COUNTERS, in which case all
+/// the counters remain zero.
+struct PerfCounters
+{
+  /// \brief Number of calls of Element::Clone, excluding the calls made by
+  /// Element::Clone to clone the descendants.
+  std::uint64_t elementCloneCalls = 0;
+
+  /// \brief Number of elements cloned by Element::Clone, including the
+  /// descendants.
+  std::uint64_t elementsCloned = 0;
+
+  /// \brief Number of calls of Element::AddElement.
+  std::uint64_t addElementCalls = 0;
+
+  /// \brief Number of child names compared, or children looked up in the
+  /// index of an element, when getting a child element by name.
+  std::uint64_t getElementComparisons = 0;
+
+  /// \brief Number of calls of Param::SetFromString, by name of the type of
+  /// the parameter, such as "double" or "pose". Types without calls are
+  /// left out.
+  std::map<std::string, std::uint64_t> paramSetFromStringCalls;
+
+  /// \brief Number of calls of sdf::findFile.
+  std::uint64_t findFileCalls = 0;
+
+  /// \brief Number of paths checked for existence by sdf::findFile,
+  /// excluding the ones found in the cache of found files.
+  std::uint64_t findFileProbes = 0;
+
+  /// \brief Number of XML elements visited while converting documents of
+  /// older SDFormat versions.
+  std::uint64_t converterNodeVisits = 0;
+
+  /// \brief Number of vertices added to frame attached-to and pose
+  /// relative-to graphs.
+  std::uint64_t graphVerticesBuilt = 0;
+
+  /// \brief Number of poses of frames relative to the scope of a pose
+  /// relative-to graph that were resolved by walking the graph, instead of
+  /// being read from the poses stored by the graph.
+  std::uint64_t poseGraphWalks = 0;
+
+  /// \brief Number of lookups of links, joints, frames and models by name
+  /// that searched linearly, because the name is not in the name index of
+  /// the model or world, or because an object was renamed to it.
+  std::uint64_t nameLookupLinearSearches = 0;
+};
+
+/// \brief Get the current values of the performance counters.
+/// \return The counters.
+SDFORMAT_VISIBLE
+PerfCounters GetPerfCounters();
+
+/// \brief Set all the performance counters to zero.
+SDFORMAT_VISIBLE
+void ResetPerfCounters();
+
+/// \brief Check whether the performance counters were compiled in.
+/// \return False if the library was compiled with
+/// SDFORMAT_DISABLE_PERF_COUNTERS.
+SDFORMAT_VISIBLE
+bool PerfCountersEnabled();
+}
+}
+#endif
@@ -87,7 +87,11 @@ namespace sdf
     public: void ClearContents();
 
     /// \brief Get the plugin contents. This is all the SDF elements that
-    /// are children of the `<plugin>`.
+    /// are children of the `<plugin>`. The elements are shared with the
+    /// element passed to Load and with the copies of this plugin, and
+    /// should not be modified. When the plugin was parsed with
+    /// ParserConfig::CopyElementsAsRawXml enabled, each element only holds
+    /// its name and its XML text, which is available from Element::RawXml.
     /// \return The child elements of this plugin.
     public: const std::vector<sdf::ElementPtr> &Contents() const;
 
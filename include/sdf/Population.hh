@@ -0,0 +1,230 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_POPULATION_HH_
+#define SDF_POPULATION_HH_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/utils/ImplPtr.hh>
+
+#include "sdf/Box.hh"
+#include "sdf/Cylinder.hh"
+#include "sdf/Element.hh"
+#include "sdf/Model.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/Types.hh"
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \enum PopulationDistributionType
+  /// \brief The types of distribution of the models of a population.
+  enum class PopulationDistributionType
+  {
+    /// \brief Models placed at random in the region.
+    RANDOM = 0,
+
+    /// \brief Models approximately placed in a 2D grid pattern over the
+    /// region, with control over the number of models.
+    UNIFORM = 1,
+
+    /// \brief Models evenly placed in a 2D grid pattern of rows and columns.
+    GRID = 2,
+
+    /// \brief Models evenly placed in a row along the x axis of the region.
+    LINEAR_X = 3,
+
+    /// \brief Models evenly placed in a row along the y axis of the region.
+    LINEAR_Y = 4,
+
+    /// \brief Models evenly placed in a row along the z axis of the region.
+    LINEAR_Z = 5,
+  };
+
+  /// \brief A population is a set of copies of a model, which are placed
+  /// according to a distribution. The population only holds the model and
+  /// the poses of its instances, and an instance is only copied into an
+  /// sdf::Model by InstanceModel.
+  ///
+  /// The instances are not part of the frame graphs of the world, so the
+  /// poses of their frames cannot be resolved with sdf::SemanticPose.
+  class SDFORMAT_VISIBLE Population
+  {
+    /// \brief Default constructor
+    public: Population();
+
+    /// \brief Load the population based on an element pointer. This is *not*
+    /// the usual entry point. Typical usage of the SDF DOM is through the Root
+    /// object.
+    /// \param[in] _sdf The SDF Element pointer
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors Load(ElementPtr _sdf);
+
+    /// \brief Load the population based on an element pointer. This is *not*
+    /// the usual entry point. Typical usage of the SDF DOM is through the Root
+    /// object.
+    /// \param[in] _sdf The SDF Element pointer
+    /// \param[in] _config Parser configuration
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors Load(ElementPtr _sdf, const ParserConfig &_config);
+
+    /// \brief Get the name of the population.
+    /// \return Name of the population.
+    public: const std::string &Name() const;
+
+    /// \brief Set the name of the population.
+    /// \param[in] _name Name of the population.
+    public: void SetName(const std::string &_name);
+
+    /// \brief Get the number of models to place. It is not used by the GRID
+    /// distribution, which places Rows() * Cols() models.
+    /// \return The number of models.
+    public: uint64_t ModelCount() const;
+
+    /// \brief Set the number of models to place.
+    /// \param[in] _count The number of models.
+    public: void SetModelCount(uint64_t _count);
+
+    /// \brief Get the type of distribution of the models.
+    /// \return The type of distribution.
+    public: PopulationDistributionType DistributionType() const;
+
+    /// \brief Set the type of distribution of the models.
+    /// \param[in] _type The type of distribution.
+    public: void SetDistributionType(PopulationDistributionType _type);
+
+    /// \brief Get the number of rows of the GRID distribution.
+    /// \return The number of rows.
+    public: uint64_t Rows() const;
+
+    /// \brief Set the number of rows of the GRID distribution.
+    /// \param[in] _rows The number of rows.
+    public: void SetRows(uint64_t _rows);
+
+    /// \brief Get the number of columns of the GRID distribution.
+    /// \return The number of columns.
+    public: uint64_t Cols() const;
+
+    /// \brief Set the number of columns of the GRID distribution.
+    /// \param[in] _cols The number of columns.
+    public: void SetCols(uint64_t _cols);
+
+    /// \brief Get the distance between the models of the GRID distribution,
+    /// along the x axis between columns and along the y axis between rows.
+    /// \return The distance between the models.
+    public: const ignition::math::Vector3d &Step() const;
+
+    /// \brief Set the distance between the models of the GRID distribution.
+    /// \param[in] _step The distance between the models.
+    public: void SetStep(const ignition::math::Vector3d &_step);
+
+    /// \brief Get the box region where models are placed, centered at the
+    /// frame of the population.
+    /// \return The box, or nullptr if the region is not a box.
+    public: const sdf::Box *RegionBox() const;
+
+    /// \brief Set a box region where models are placed. This replaces a
+    /// cylinder region.
+    /// \param[in] _box The box.
+    public: void SetRegionBox(const sdf::Box &_box);
+
+    /// \brief Get the cylinder region where models are placed, centered at
+    /// the frame of the population.
+    /// \return The cylinder, or nullptr if the region is not a cylinder.
+    public: const sdf::Cylinder *RegionCylinder() const;
+
+    /// \brief Set a cylinder region where models are placed. This replaces a
+    /// box region.
+    /// \param[in] _cylinder The cylinder.
+    public: void SetRegionCylinder(const sdf::Cylinder &_cylinder);
+
+    /// \brief Get the seed of the generator of the RANDOM distribution,
+    /// which places the models at the same poses for the same seed.
+    /// \return The seed. The default is 0.
+    public: uint32_t Seed() const;
+
+    /// \brief Set the seed of the generator of the RANDOM distribution.
+    /// \param[in] _seed The seed.
+    public: void SetSeed(uint32_t _seed);
+
+    /// \brief Get the pose of the frame of the population, relative to the
+    /// world.
+    /// \return The pose of the population.
+    public: const ignition::math::Pose3d &RawPose() const;
+
+    /// \brief Set the pose of the frame of the population, relative to the
+    /// world.
+    /// \param[in] _pose The pose of the population.
+    public: void SetRawPose(const ignition::math::Pose3d &_pose);
+
+    /// \brief Get the model that is copied for each instance.
+    /// \return The model.
+    public: const sdf::Model *Model() const;
+
+    /// \brief Set the model that is copied for each instance. Its pose is
+    /// relative to the position of each instance in the population frame.
+    /// \param[in] _model The model.
+    public: void SetModel(const sdf::Model &_model);
+
+    /// \brief Get the number of instances of the model. No instances are
+    /// placed if more than 1000000 are requested, which Load reports as an
+    /// error.
+    /// \return The number of instances.
+    public: uint64_t InstanceCount() const;
+
+    /// \brief Get the poses of all the instances, relative to the world.
+    /// The poses are generated when the population is loaded or modified.
+    /// \return The pose of each instance.
+    public: const std::vector<ignition::math::Pose3d> &InstancePoses() const;
+
+    /// \brief Copy the model of an instance.
+    /// \param[in] _index Index of the instance, in the range
+    /// [0..InstanceCount()).
+    /// \return A copy of the model, named "<model name>_clone_<_index>", with
+    /// the pose of the instance relative to the world. An empty model is
+    /// returned if the index is out of range.
+    public: sdf::Model InstanceModel(uint64_t _index) const;
+
+    /// \brief Get a pointer to the SDF element that was used during load.
+    /// \return SDF element pointer. The value will be nullptr if Load has
+    /// not been called.
+    public: sdf::ElementPtr Element() const;
+
+    /// \brief Create and return an SDF element filled with data from this
+    /// population.
+    /// Note that parameter passing functionality is not captured with this
+    /// function.
+    /// \return SDF element pointer with updated population values.
+    public: sdf::ElementPtr ToElement() const;
+
+    /// \brief Private data pointer.
+    IGN_UTILS_IMPL_PTR(dataPtr)
+  };
+  }
+}
+#endif
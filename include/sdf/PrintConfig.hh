@@ -17,9 +17,12 @@
 #ifndef SDF_PRINTCONFIG_HH_
 #define SDF_PRINTCONFIG_HH_
 
+#include <cstddef>
+#include <memory>
 #include <optional>
 #include <ignition/utils/ImplPtr.hh>
 
+#include "sdf/TaskExecutor.hh"
 #include "sdf/sdf_config.h"
 #include "sdf/system_util.hh"
 
@@ -75,6 +78,32 @@ namespace sdf
     /// False if they are to be expanded.
     public: bool PreserveIncludes() const;
 
+    /// \brief Set the number of threads used to convert elements to strings.
+    /// Below the root element and any chain of elements with a single child,
+    /// the children of the first element that has several of them, such as
+    /// the top-level models of a world, are each converted into a buffer of
+    /// their own concurrently. The buffers are then written in document
+    /// order, so the output is the same as when converting serially.
+    /// \param[in] _count Number of threads. Values of 0 and 1 convert
+    /// elements serially. The default is 0.
+    public: void SetThreadCount(std::size_t _count);
+
+    /// \brief Get the number of threads used to convert elements to strings.
+    /// \return Number of threads. A value of 0 or 1 means that elements are
+    /// converted serially.
+    public: std::size_t ThreadCount() const;
+
+    /// \brief Set the executor that runs the threads that convert elements
+    /// to strings, see SetThreadCount.
+    /// \param[in] _executor The executor, or nullptr for the default, which
+    /// is TaskExecutor::Threaded.
+    public: void SetExecutor(std::shared_ptr<TaskExecutor> _executor);
+
+    /// \brief Get the executor that runs the threads that convert elements
+    /// to strings.
+    /// \return The executor, which is never nullptr.
+    public: std::shared_ptr<TaskExecutor> Executor() const;
+
     /// \brief Return true if both PrintConfig objects contain the same values.
     /// \param[in] _config PrintConfig to compare.
     /// \return True if 'this' == _config.
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDF_RESOURCEPROVIDER_HH_
+#define SDF_RESOURCEPROVIDER_HH_
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+
+/// \brief Contents of a file read by a ResourceProvider.
+struct ResourceData
+{
+  /// \brief The bytes of the file.
+  std::string_view data;
+
+  /// \brief Object that owns the bytes, such as a buffer or the mapping of
+  /// an archive. The bytes stay valid while it is alive.
+  std::shared_ptr<const void> owner;
+};
+
+/// \brief Interface to the files that documents are read from. It is set
+/// on a ParserConfig with ParserConfig::SetResourceProvider, so that
+/// documents and the files that they include can be read from memory or
+/// from an archive instead of from the filesystem.
+///
+/// The provider is used to find files with sdf::findFile, to read the
+/// model.config of model directories, and to read SDFormat and URDF files.
+/// Paths are the ones that libsdformat would use on the filesystem, after
+/// URIs are resolved with the URI path map of the configuration.
+/// Included files may be read on several threads, so the functions may be
+/// called concurrently.
+class SDFORMAT_VISIBLE ResourceProvider
+{
+  /// \brief Destructor.
+  public: virtual ~ResourceProvider();
+
+  /// \brief Check whether a file or directory exists.
+  /// \param[in] _path Path of the file or directory.
+  /// \return True if it exists.
+  public: virtual bool Exists(const std::string &_path) const = 0;
+
+  /// \brief Check whether a path is a directory, such as a model directory
+  /// with a model.config file.
+  /// \param[in] _path Path to check.
+  /// \return True if it is a directory.
+  public: virtual bool IsDirectory(const std::string &_path) const = 0;
+
+  /// \brief Read the contents of a file.
+  /// \param[in] _path Path of the file.
+  /// \param[out] _data Contents of the file.
+  /// \return True if the file was read.
+  public: virtual bool Read(const std::string &_path,
+                            ResourceData &_data) const = 0;
+};
+}
+}
+#endif
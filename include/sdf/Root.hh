@@ -17,10 +17,19 @@
 #ifndef SDF_ROOT_HH_
 #define SDF_ROOT_HH_
 
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <ignition/math/Pose3.hh>
 #include <ignition/utils/ImplPtr.hh>
 
+#include "sdf/LoadTask.hh"
 #include "sdf/ParserConfig.hh"
+#include "sdf/PrintConfig.hh"
 #include "sdf/SDFImpl.hh"
 #include "sdf/Types.hh"
 #include "sdf/sdf_config.h"
@@ -34,10 +43,62 @@ namespace sdf
 
   // Forward declarations.
   class Actor;
+  class Collision;
+  class Frame;
+  class Joint;
   class Light;
+  class Link;
   class Model;
+  class Sensor;
+  class Visual;
   class World;
 
+  /// \brief Types of the assets referenced by a document.
+  enum class AssetType
+  {
+    /// \brief Mesh of a geometry.
+    MESH,
+
+    /// \brief Heightmap of a geometry.
+    HEIGHTMAP,
+
+    /// \brief Texture of a heightmap or a material.
+    TEXTURE,
+
+    /// \brief Script of a material.
+    MATERIAL_SCRIPT,
+
+    /// \brief Skin of an actor.
+    SKIN,
+
+    /// \brief Animation of an actor.
+    ANIMATION,
+
+    /// \brief Library of a plugin.
+    PLUGIN
+  };
+
+  /// \brief An asset referenced by a document, as returned by
+  /// Root::CollectAssetReferences.
+  struct AssetReference
+  {
+    /// \brief URI of the asset. A relative URI is joined to the directory
+    /// of the file it is written in, except for plugin libraries, which are
+    /// kept as written.
+    public: std::string uri;
+
+    /// \brief Type of the asset.
+    public: AssetType type = AssetType::MESH;
+
+    /// \brief Number of references to the asset.
+    public: uint64_t referenceCount = 0;
+
+    /// \brief Sorted IDs of the entities that refer to the asset, see
+    /// Root::EntityById. References from worlds, actors and the models of
+    /// populations are counted, but they have no entity ID.
+    public: std::vector<uint64_t> entityIds;
+  };
+
   /// \brief Root class that acts as an entry point to the SDF document
   /// model.
   ///
@@ -52,6 +113,10 @@ namespace sdf
   ///
   /// \snippet examples/dom.cc rootUsage
   ///
+  /// Different Root objects may be loaded concurrently on different
+  /// threads, provided that the ParserConfig objects they use are not
+  /// modified during the calls to Load. See sdf::ParserConfig for details.
+  ///
   class SDFORMAT_VISIBLE Root
   {
     /// \brief Default constructor
@@ -73,6 +138,41 @@ namespace sdf
     public: Errors Load(
                 const std::string &_filename, const ParserConfig &_config);
 
+    /// \brief Parse the given SDF file like Load(), using a binary cache of
+    /// the parsed elements to skip reading XML when the cache is up to date.
+    /// The cache holds the elements after conversion, includes and parameter
+    /// passing, and is used only if it was written for the same file name by
+    /// the same version of the library, and the size and contents of every
+    /// file the elements were read from are unchanged. Otherwise the file is
+    /// parsed and, if no errors were found while reading it, the cache file
+    /// is written. The objects are then generated from the elements as in
+    /// Load(SDFPtr, ParserConfig), including the frame graphs. The cache
+    /// does not record the parser configuration, so it must be used with the
+    /// same configuration, such as the same URI paths and find file
+    /// callback, every time.
+    /// \param[in] _filename Name of the SDF file to parse.
+    /// \param[in] _cacheFile Path of the cache file to read or write.
+    /// \param[in] _config Custom parser configuration
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors LoadCached(const std::string &_filename,
+                const std::string &_cacheFile, const ParserConfig &_config);
+
+    /// \brief Parse the given SDF file like Load(), on a background thread.
+    /// The returned task reports the number of files parsed and models
+    /// loaded so far, and can be cancelled, which stops loading before the
+    /// next included file or model. The configuration is copied, so its
+    /// settings such as the number of threads that load included files and
+    /// its caches are used, and it may be changed while the file is loaded.
+    /// \param[in] _filename Name of the SDF file to parse.
+    /// \param[in] _config Custom parser configuration
+    /// \param[in] _callback Function called when the progress changes, or
+    /// an empty function.
+    /// \return The task that loads the file.
+    public: static LoadTask LoadAsync(const std::string &_filename,
+                const ParserConfig &_config,
+                LoadTask::ProgressCallback _callback = {});
+
     /// \brief Parse the given SDF string, and generate objects based on types
     /// specified in the SDF file.
     /// \param[in] _sdf SDF string to parse.
@@ -89,6 +189,32 @@ namespace sdf
     public: Errors LoadSdfString(
                 const std::string &_sdf, const ParserConfig &_config);
 
+    /// \brief Parse an SDF string from a buffer, such as a network payload
+    /// or a std::string_view, without copying it into a std::string first,
+    /// and generate objects based on types specified in the SDF file.
+    /// \param[in] _data SDF string to parse, which does not have to be null
+    /// terminated.
+    /// \param[in] _size Number of characters of _data.
+    /// \param[in] _config Custom parser configuration
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors LoadSdfString(const char *_data, std::size_t _size,
+                                 const ParserConfig &_config);
+
+    /// \brief Parse many SDF strings, each one into its own Root, in one
+    /// call. The strings share the element descriptions and the tinyxml2
+    /// documents they are parsed into, even if _config does not reuse XML
+    /// documents, so that loading many small documents does not allocate
+    /// the memory pools of a document for each one.
+    /// \param[in] _sdfs SDF strings to parse.
+    /// \param[out] _roots One Root for each string of _sdfs, in the same
+    /// order.
+    /// \param[in] _config Custom parser configuration
+    /// \return The errors of loading each string, in the order of _sdfs.
+    public: static std::vector<Errors> LoadSdfStrings(
+                const std::vector<std::string_view> &_sdfs,
+                std::vector<Root> &_roots, const ParserConfig &_config);
+
     /// \brief Parse the given SDF pointer, and generate objects based on types
     /// specified in the SDF file.
     /// \param[in] _sdf SDF pointer to parse.
@@ -182,10 +308,20 @@ namespace sdf
     /// an error code and message. An empty vector indicates no error.
     public: Errors AddWorld(const World &_world);
 
+    /// \brief Add a world to the root, moving it instead of copying it.
+    /// \param[in] _world World to add.
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors AddWorld(World &&_world);
+
     /// \brief Remove all worlds.
     public: void ClearWorlds();
 
     /// \brief Deep copy this Root object and return the new Root object.
+    /// The frame and pose graphs are not built again: the clone shares them
+    /// with this Root object until one of the two modifies the graphs of a
+    /// world in place, with UpdateGraphs(const std::string &, const
+    /// std::string &) or RemoveModel, which first copies them.
     /// \return A clone of this Root object.
     /// Deprecate this function in SDF version 13, and use
     /// IGN_UTILS_IMPL_PTR instead.
@@ -199,6 +335,199 @@ namespace sdf
     /// an error code and message. An empty vector indicates no error.
     public: Errors UpdateGraphs();
 
+    /// \brief Update the frame and pose graphs of a world for one of its
+    /// models, for example after adding it with World::AddModel or editing
+    /// it. Only the graphs of that model are built and validated, and they
+    /// replace the vertices of the model that are already in the graphs of
+    /// the world. If other frames of the world refer to the model, the graphs
+    /// of the whole world are rebuilt instead. IDs are assigned again, see
+    /// EntityById.
+    /// \param[in] _worldName Name of the world that contains the model.
+    /// \param[in] _modelName Name of the model.
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors UpdateGraphs(const std::string &_worldName,
+                                const std::string &_modelName);
+
+    /// \brief Finish all the state that is computed on first use, so that
+    /// the const functions of this Root object and of its DOM objects can
+    /// be called from several threads at once without locking. This builds
+    /// the graphs of worlds that were loaded with
+    /// ParserConfig::SetLazyWorldModels, calls World::Freeze on every
+    /// world, converts the values of parameters that were parsed lazily,
+    /// see ParserConfig::SetLazyParamParsing, resolves the pose of every frame
+    /// relative to its model or world frame and makes the poses cached by
+    /// the frame graphs read-only. Poses relative to other frames are then
+    /// computed from the cached poses. The camera undistortion maps and lidar
+    /// ray directions are still computed on first use, under their own
+    /// locks. Calling a non-const function of this object or of one of its
+    /// DOM objects may undo part of this, so Freeze should be called again
+    /// after editing the DOM.
+    /// \return Errors from building the graphs of lazily loaded worlds. An
+    /// empty vector indicates no error.
+    public: Errors Freeze();
+
+    /// \brief Remove a model from a world, together with its vertices in the
+    /// frame and pose graphs of the world. If other frames of the world refer
+    /// to the model, the graphs of the whole world are rebuilt, which reports
+    /// those frames as errors. IDs are assigned again, see EntityById.
+    /// \param[in] _worldName Name of the world that contains the model.
+    /// \param[in] _modelName Name of the model to remove.
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors RemoveModel(const std::string &_worldName,
+                               const std::string &_modelName);
+
+    /// \brief Get the files that the models of the worlds were read from
+    /// through an <include>, including nested includes. These are the files
+    /// that ReloadIncludedFile can read again.
+    /// \return The paths of the files, sorted and without duplicates.
+    public: std::vector<std::string> IncludedFiles() const;
+
+    /// \brief Get the content hash of each top-level model of a world, see
+    /// Element::ContentHash. A model whose hash is unchanged has the same
+    /// contents. Models that were not loaded from elements, or whose
+    /// elements were released, are hashed from Model::ToElement.
+    /// \param[in] _worldName Name of the world.
+    /// \return The hashes, by model name. The map is empty if there is no
+    /// world with that name.
+    public: std::map<std::string, std::uint64_t> ModelContentHashes(
+                const std::string &_worldName) const;
+
+    /// \brief Read a file that models of the worlds were included from
+    /// again, for example after it was edited, without loading the rest of
+    /// the document. Every outermost <include> of the file is read again and
+    /// its element replaces the previous one. The top-level models that
+    /// contain them are then loaded again from their elements, and the
+    /// graphs of the worlds are updated for those models only, as with
+    /// UpdateGraphs(const std::string &, const std::string &). The elements
+    /// of the document must have been kept, see
+    /// ParserConfig::SetReleaseElements. Models merged into their parent
+    /// with merge="true" are not read again.
+    /// \param[in] _filename Path of the changed file.
+    /// \param[in] _config Custom parser configuration
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors ReloadIncludedFile(const std::string &_filename,
+                                      const ParserConfig &_config);
+
+    /// \brief Get the number of entities that have an ID. Every model, link,
+    /// joint, frame, collision, visual and sensor of the worlds or the model
+    /// of this Root has an ID between 0 and EntityCount() - 1.
+    /// \return Number of entities that have an ID.
+    /// \sa EntityById
+    public: uint64_t EntityCount() const;
+
+    /// \brief Get an entity by its ID. IDs are assigned by Load and
+    /// UpdateGraphs in depth first order: each model is followed by its
+    /// links, each link by its collisions, visuals and sensors, then the
+    /// model's joints, each followed by its sensors, its frames and finally
+    /// its nested models. Worlds are numbered in order, each one followed by
+    /// its frames.
+    ///
+    /// An ID keeps referring to the same entity if objects are added to the
+    /// DOM after IDs were assigned, since the entity is found through the
+    /// indices of the objects that contain it and not through a pointer or
+    /// its name. Objects added after IDs were assigned get an ID the next
+    /// time UpdateGraphs is called.
+    /// \tparam T One of sdf::Model, sdf::Link, sdf::Joint, sdf::Frame,
+    /// sdf::Collision, sdf::Visual or sdf::Sensor.
+    /// \param[in] _id ID of the entity.
+    /// \return Pointer to the entity, or nullptr if no entity of type T has
+    /// the given ID.
+    public: template <typename T>
+            const T *EntityById(const uint64_t _id) const;
+
+    /// \brief Get a mutable entity by its ID.
+    /// \tparam T One of sdf::Model, sdf::Link, sdf::Joint, sdf::Frame,
+    /// sdf::Collision, sdf::Visual or sdf::Sensor.
+    /// \param[in] _id ID of the entity.
+    /// \return Pointer to the entity, or nullptr if no entity of type T has
+    /// the given ID.
+    /// \sa EntityById(const uint64_t) const
+    public: template <typename T>
+            T *EntityById(const uint64_t _id);
+
+    /// \brief Resolve the poses of every entity that has an ID, with one
+    /// traversal of the pose graph of each top-level model, see
+    /// Model::ResolveAllPoses. The poses of the entities of a world are
+    /// relative to the world frame, and the poses of the entities of the
+    /// model of this Root are relative to that model's frame.
+    /// \param[out] _poses Resolved poses, indexed by entity ID, with
+    /// EntityCount() poses. Poses that could not be resolved are set to zero
+    /// and reported in the returned errors.
+    /// \return Errors. An error with code ELEMENT_INVALID is also returned if
+    /// entities were added to or removed from the DOM since IDs were
+    /// assigned, in which case UpdateGraphs has to be called first.
+    /// \sa EntityById
+    public: Errors ResolveAllPoses(
+                std::vector<ignition::math::Pose3d> &_poses) const;
+
+    /// \brief Set the raw pose of every entity that has an ID at once, for
+    /// example to write the state of a running simulation back to the DOM
+    /// before ToElement or WriteFile. Each pose is set with SetRawPose, and,
+    /// if the entity keeps its element, is copied into the value of the
+    /// element's <pose> child without being converted to a string, see
+    /// ParamUpdateTable. Entities whose pose is unchanged are skipped, so
+    /// only the elements of the entities that moved get a new content hash,
+    /// see Element::ContentHash. The frame and pose graphs are not changed,
+    /// so UpdateGraphs has to be called before poses are resolved again.
+    /// \param[in] _poses Raw poses, indexed by entity ID, with EntityCount()
+    /// poses. Each pose is relative to the frame of the entity's
+    /// PoseRelativeTo().
+    /// \return Errors. An error with code ELEMENT_INVALID is returned, and no
+    /// pose is set, if _poses does not have EntityCount() poses.
+    /// \sa EntityById
+    public: Errors SetRawPoses(
+                const std::vector<ignition::math::Pose3d> &_poses);
+
+    /// \brief Resolve the URIs of the assets of the worlds and the model of
+    /// this root, so that the assets can be prefetched while the rest of
+    /// the simulation is set up. The assets are the meshes and heightmaps
+    /// of the collisions and visuals, the textures of the heightmaps and the
+    /// scripts, normal maps and PBR maps of the materials. Each URI is
+    /// resolved once with sdf::findFile, using the find callback of
+    /// _config, and the distinct URIs are resolved concurrently. This
+    /// replaces the table of a previous call.
+    ///
+    /// A relative URI is first looked up relative to the directory of the
+    /// file it is written in.
+    /// \param[in] _config Custom parser configuration. If the assets are
+    /// resolved on several threads, its find callback must be thread-safe.
+    /// \param[in] _threadCount Number of threads. A value of 0 uses one
+    /// thread per hardware thread, and 1 resolves the URIs serially.
+    /// \return Errors with code URI_LOOKUP for the assets that were not
+    /// found. An empty vector indicates that every asset was found.
+    /// \sa ResolvedAssets
+    public: Errors ResolveAssets(
+        const ParserConfig &_config = ParserConfig::GlobalConfig(),
+        std::size_t _threadCount = 0);
+
+    /// \brief Collect every asset referenced by the worlds and the model or
+    /// actor of this root: the meshes and heightmaps of geometries, the
+    /// textures of heightmaps and materials, the scripts of materials, the
+    /// skins and animations of actors, and the libraries of the plugins of
+    /// worlds, GUIs, models, visuals, sensors and actors.
+    /// \return One reference per distinct type and URI, sorted by type and
+    /// then by URI.
+    public: std::vector<AssetReference> CollectAssetReferences() const;
+
+    /// \brief Get the table of resolved asset paths built by ResolveAssets.
+    /// \return Map from each asset URI to its path, which is empty if the
+    /// asset was not found. Relative URIs are keys once they are joined to
+    /// the directory of the file they are written in.
+    /// \sa ResolvedAssetPath
+    public: const std::map<std::string, std::string> &ResolvedAssets() const;
+
+    /// \brief Get the resolved path of an asset.
+    /// \param[in] _uri URI of the asset, such as sdf::Mesh::Uri().
+    /// \param[in] _filePath Path of the file the URI is written in, such as
+    /// sdf::Mesh::FilePath(), to look up relative URIs.
+    /// \return The path of the asset, or an empty string if it was not
+    /// found or not resolved by ResolveAssets.
+    public: std::string ResolvedAssetPath(const std::string &_uri,
+        const std::string &_filePath = "") const;
+
     /// \brief Create and return an SDF element filled with data from this
     /// root.
     /// Note that parameter passing functionality is not captured with this
@@ -208,6 +537,31 @@ namespace sdf
     public: sdf::ElementPtr ToElement(
         const ParserConfig &_config = ParserConfig::GlobalConfig()) const;
 
+    /// \brief Write the SDFormat document of this root to a stream. The
+    /// document is the one of ToElement, preceded by the XML declaration,
+    /// and it is written while it is generated instead of being accumulated
+    /// in a string.
+    /// \param[out] _out Stream to write to.
+    /// \param[in] _printConfig Configuration for printing the values.
+    /// \param[in] _config Custom parser configuration
+    public: void ToStream(std::ostream &_out,
+        const PrintConfig &_printConfig = PrintConfig(),
+        const ParserConfig &_config = ParserConfig::GlobalConfig()) const;
+
+    /// \brief Write the SDFormat document of this root to a file. The
+    /// document is written to a temporary file that replaces _filename once
+    /// it is complete, so that _filename always holds a complete document,
+    /// such as the previous snapshot of a world.
+    /// \param[in] _filename Name of the file to write.
+    /// \param[in] _printConfig Configuration for printing the values.
+    /// \param[in] _config Custom parser configuration
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    /// \sa ToStream
+    public: Errors WriteFile(const std::string &_filename,
+        const PrintConfig &_printConfig = PrintConfig(),
+        const ParserConfig &_config = ParserConfig::GlobalConfig()) const;
+
     /// \brief Private data pointer
     IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
   };
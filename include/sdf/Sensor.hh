@@ -133,6 +133,9 @@ namespace sdf
   };
 
   /// \brief Information about an SDF sensor.
+  /// A sensor holds the type-specific data of a single kind of sensor,
+  /// so setting, for example, the IMU sensor discards a previously set
+  /// camera sensor.
   class SDFORMAT_VISIBLE Sensor
   {
     /// \brief Default constructor
@@ -201,6 +204,17 @@ namespace sdf
     /// \return SemanticPose object for this link.
     public: sdf::SemanticPose SemanticPose() const;
 
+    /// \brief Resolve the pose of this sensor relative to a frame, as
+    /// SemanticPose().Resolve() does, without constructing a SemanticPose.
+    /// If there are any errors resolving the pose, the output will not be
+    /// modified.
+    /// \param[out] _pose The resolved pose.
+    /// \param[in] _resolveTo The pose will be resolved with respect to this
+    /// frame. If unset or empty, the parent object will be used.
+    /// \return Errors in resolving pose.
+    public: Errors ResolvePose(ignition::math::Pose3d &_pose,
+                               const std::string &_resolveTo = "") const;
+
     /// \brief Get a pointer to the SDF element that was used during
     /// load.
     /// \return SDF element pointer. The value will be nullptr if Load has
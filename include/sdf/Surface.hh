@@ -54,6 +54,17 @@ namespace sdf
     /// \brief Set the collide bitmask parameter.
     public: void SetCollideBitmask(const uint16_t _bitmask);
 
+    /// \brief Get the category bitmask parameter. Two collisions collide if
+    /// the category bitmask of either one shares a bit with the collide
+    /// bitmask of the other.
+    /// \return The category bitmask parameter, which is the collide bitmask
+    /// if it is not set.
+    public: uint16_t CategoryBitmask() const;
+
+    /// \brief Set the category bitmask parameter.
+    /// \param[in] _bitmask The category bitmask.
+    public: void SetCategoryBitmask(const uint16_t _bitmask);
+
     /// \brief Private data pointer.
     IGN_UTILS_IMPL_PTR(dataPtr)
   };
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_TASKEXECUTOR_HH_
+#define SDF_TASKEXECUTOR_HH_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+
+/// \brief Interface to the threads that run the parallel parts of loading
+/// documents, such as loading included files, building the graphs of the
+/// models of a world and loading worlds. It is set on a ParserConfig with
+/// ParserConfig::SetExecutor, so that an application can run them on its
+/// own task scheduler instead of threads created by libsdformat.
+///
+/// The number of tasks of a group is given by the thread count options of
+/// ParserConfig. Each task of a group takes work from a queue shared by the
+/// group until the queue is empty, so running the tasks of a group one after
+/// the other is always correct.
+class SDFORMAT_VISIBLE TaskExecutor
+{
+  /// \brief Destructor.
+  public: virtual ~TaskExecutor();
+
+  /// \brief Run a group of tasks and wait for all of them to finish. The
+  /// tasks may run on any thread, including the calling thread, and
+  /// concurrently with each other. A task may itself run groups of tasks,
+  /// for example when an included file includes other files.
+  /// \param[in] _count Number of tasks.
+  /// \param[in] _task Function that runs a task, called once with each index
+  /// from 0 to _count - 1. The loaders do not throw from their tasks, but
+  /// an executor should still let an exception thrown by a task reach the
+  /// caller of RunAndWait instead of terminating the process.
+  public: virtual void RunAndWait(
+              std::size_t _count,
+              const std::function<void(std::size_t)> &_task) = 0;
+
+  /// \brief Get an executor that runs the tasks of all groups on one pool
+  /// of threads, with one thread per hardware thread including the calling
+  /// thread, which also runs tasks of the group it waits for. If tasks
+  /// throw, RunAndWait rethrows the first exception once all the tasks of
+  /// the group finished. This is the default executor of ParserConfig.
+  /// \return The executor, which is shared by all its users.
+  public: static std::shared_ptr<TaskExecutor> Threaded();
+
+  /// \brief Get an executor that runs the tasks of a group one after the
+  /// other on the calling thread.
+  /// \return The executor, which is shared by all its users.
+  public: static std::shared_ptr<TaskExecutor> Inline();
+};
+}
+}
+#endif
@@ -20,8 +20,10 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -91,6 +93,66 @@ namespace sdf
   SDFORMAT_VISIBLE
   std::string trim(const std::string &_in);
 
+  /// \brief Trim leading and trailing whitespace from a string without
+  /// copying it. The whitespace characters are the same as for trim().
+  /// \param[in] _in The string to trim.
+  /// \return A view of the trimmed part of _in, which is only valid as long
+  /// as the characters of _in are.
+  SDFORMAT_VISIBLE
+  std::string_view trimView(std::string_view _in);
+
+  /// \brief Splits a string on a delimiter one token at a time, without
+  /// allocating. The tokens are the ones split() returns, as views of the
+  /// original string, so they are only valid as long as its characters are.
+  ///
+  /// E.g.:
+  /// \code
+  /// sdf::Tokenizer tokens(str, " ");
+  /// for (std::string_view token; tokens.Next(token);)
+  ///   ...
+  /// \endcode
+  class Tokenizer
+  {
+    /// \brief Constructor.
+    /// \param[in] _str The string to split.
+    /// \param[in] _splitter The delimiter to use.
+    public: Tokenizer(std::string_view _str, std::string_view _splitter)
+      : str(_str), splitter(_splitter)
+    {
+    }
+
+    /// \brief Get the next token.
+    /// \param[out] _token The next token, which may be empty.
+    /// \return False if all the tokens have been returned.
+    public: bool Next(std::string_view &_token)
+    {
+      if (this->done)
+        return false;
+
+      const std::size_t pos = this->splitter.empty() ?
+          std::string_view::npos : this->str.find(this->splitter);
+      if (pos == std::string_view::npos)
+      {
+        _token = this->str;
+        this->done = true;
+        return true;
+      }
+
+      _token = this->str.substr(0, pos);
+      this->str.remove_prefix(pos + this->splitter.size());
+      return true;
+    }
+
+    /// \brief The part of the string that has not been split yet.
+    private: std::string_view str;
+
+    /// \brief The delimiter.
+    private: std::string_view splitter;
+
+    /// \brief True once the last token has been returned.
+    private: bool done = false;
+  };
+
   /// \brief check if two values are equal, within a tolerance
   /// \param[in] _a the first value
   /// \param[in] _b the second value
@@ -175,6 +237,109 @@ namespace sdf
     public: double mass;
   };
 
+  /// \brief A string stored in a process-wide table of unique strings.
+  /// Copying an InternedString only copies a pointer, and two InternedString
+  /// objects with the same text always refer to the same table entry, so
+  /// comparing two of them is a pointer comparison. An entry is freed with
+  /// the last InternedString that refers to it, so names and descriptions
+  /// of custom elements and attributes read from documents do not make the
+  /// table grow without bound in long-running processes.
+  class SDFORMAT_VISIBLE InternedString
+  {
+    /// \brief Default constructor, holds the empty string.
+    public: InternedString();
+
+    /// \brief Constructor.
+    /// \param[in] _str Text to intern.
+    // cppcheck-suppress noExplicitConstructor
+    public: InternedString(const std::string &_str);
+
+    /// \brief Constructor.
+    /// \param[in] _str Text to intern.
+    // cppcheck-suppress noExplicitConstructor
+    public: InternedString(const char *_str);
+
+    /// \brief Get the interned text.
+    /// \return Reference to the interned text, which stays valid as long as
+    /// an InternedString with the same text exists.
+    public: const std::string &Str() const
+    {
+      return *this->str;
+    }
+
+    /// \brief Implicit conversion to the interned text.
+    /// \return Reference to the interned text.
+    public: operator const std::string &() const
+    {
+      return *this->str;
+    }
+
+    /// \brief Equality operator. This is a pointer comparison.
+    /// \param[in] _other Interned string to compare against.
+    /// \return True if both hold the same text.
+    public: bool operator==(const InternedString &_other) const
+    {
+      return this->str == _other.str;
+    }
+
+    /// \brief Equality operator.
+    /// \param[in] _other String to compare against.
+    /// \return True if both hold the same text.
+    public: bool operator==(const std::string &_other) const
+    {
+      return *this->str == _other;
+    }
+
+    /// \brief Equality operator.
+    /// \param[in] _other String to compare against.
+    /// \return True if both hold the same text.
+    public: bool operator==(const char *_other) const
+    {
+      return *this->str == _other;
+    }
+
+    /// \brief Inequality operator.
+    /// \param[in] _other Value to compare against.
+    /// \return True if the text differs.
+    public: template<typename T>
+            bool operator!=(const T &_other) const
+    {
+      return !(*this == _other);
+    }
+
+    /// \brief Stream insertion operator.
+    /// \param[out] _out The output stream.
+    /// \param[in] _str Interned string to write.
+    /// \return The output stream.
+    public: friend std::ostream &operator<<(std::ostream &_out,
+                                            const InternedString &_str)
+    {
+      _out << *_str.str;
+      return _out;
+    }
+
+    /// \brief Text of the entry in the intern table.
+    private: std::shared_ptr<const std::string> str;
+  };
+
+  /// \brief Equality operator.
+  /// \param[in] _a String to compare.
+  /// \param[in] _b Interned string to compare.
+  /// \return True if both hold the same text.
+  inline bool operator==(const std::string &_a, const InternedString &_b)
+  {
+    return _b == _a;
+  }
+
+  /// \brief Inequality operator.
+  /// \param[in] _a String to compare.
+  /// \param[in] _b Interned string to compare.
+  /// \return True if the text differs.
+  inline bool operator!=(const std::string &_a, const InternedString &_b)
+  {
+    return !(_b == _a);
+  }
+
   /// \brief Transforms a string to its lowercase equivalent
   /// \param[in] _in String to convert to lowercase
   /// \return Lowercase equilvalent of _in.
@@ -196,6 +361,146 @@ namespace sdf
   SDFORMAT_VISIBLE
   std::string JoinName(
       const std::string &_scopeName, const std::string &_localName);
+
+  /// \brief A view of a scoped name such as "a::b::c", along with the
+  /// positions of its first and last "::" delimiters, so that it can be split
+  /// into its scope and local name, or its first segment and the rest,
+  /// without copying. The parts are views of the same characters, so they
+  /// are only valid as long as the original string is.
+  class ScopedName
+  {
+    /// \brief Constructor.
+    /// \param[in] _name The scoped name.
+    // cppcheck-suppress noExplicitConstructor
+    public: ScopedName(std::string_view _name)
+      : name(_name), first(_name.find("::")), last(_name.rfind("::"))
+    {
+    }
+
+    /// \brief Constructor.
+    /// \param[in] _name The scoped name.
+    // cppcheck-suppress noExplicitConstructor
+    public: ScopedName(const std::string &_name)
+      : ScopedName(std::string_view(_name))
+    {
+    }
+
+    /// \brief Constructor.
+    /// \param[in] _name The scoped name.
+    // cppcheck-suppress noExplicitConstructor
+    public: ScopedName(const char *_name)
+      : ScopedName(std::string_view(_name))
+    {
+    }
+
+    /// \brief Get the whole name.
+    /// \return The name.
+    public: std::string_view Name() const
+    {
+      return this->name;
+    }
+
+    /// \brief Get whether the name has a scope.
+    /// \return True if the name contains a "::" delimiter.
+    public: bool IsScoped() const
+    {
+      return this->first != std::string_view::npos;
+    }
+
+    /// \brief Get the part of the name before the first delimiter.
+    /// \return "a" for "a::b::c", or the whole name if it is not scoped.
+    public: std::string_view FirstSegment() const
+    {
+      return this->name.substr(0, this->first);
+    }
+
+    /// \brief Get the part of the name after the first delimiter.
+    /// \return "b::c" for "a::b::c", or an empty name if it is not scoped.
+    public: ScopedName WithoutFirstSegment() const
+    {
+      if (!this->IsScoped())
+        return ScopedName(std::string_view(), std::string_view::npos,
+                          std::string_view::npos);
+
+      const std::size_t offset = this->first + 2;
+      const std::string_view rest = this->name.substr(offset);
+      const std::size_t restFirst = this->first == this->last ?
+          std::string_view::npos : rest.find("::");
+      return ScopedName(rest, restFirst,
+          restFirst == std::string_view::npos ?
+          std::string_view::npos : this->last - offset);
+    }
+
+    /// \brief Get the part of the name after the last delimiter.
+    /// \return "c" for "a::b::c", or the whole name if it is not scoped.
+    public: std::string_view LocalName() const
+    {
+      return this->IsScoped() ? this->name.substr(this->last + 2) : this->name;
+    }
+
+    /// \brief Get the part of the name before the last delimiter.
+    /// \return "a::b" for "a::b::c", or an empty name if it is not scoped.
+    public: ScopedName ScopeName() const
+    {
+      if (!this->IsScoped())
+        return ScopedName(std::string_view(), std::string_view::npos,
+                          std::string_view::npos);
+
+      const std::string_view scope = this->name.substr(0, this->last);
+      const std::size_t scopeLast = this->first == this->last ?
+          std::string_view::npos : scope.rfind("::");
+      return ScopedName(scope,
+          scopeLast == std::string_view::npos ?
+          std::string_view::npos : this->first, scopeLast);
+    }
+
+    /// \brief Append a local name to a scope name in place, with the same
+    /// result as JoinName, so that building a name from several segments
+    /// only grows one string.
+    /// \param[in,out] _scopeName The scope name, which becomes the joined
+    /// name.
+    /// \param[in] _localName The local name to append.
+    public: static void Join(std::string &_scopeName,
+                             std::string_view _localName)
+    {
+      if (_localName.empty())
+        return;
+      if (_scopeName.empty())
+      {
+        _scopeName.assign(_localName);
+        return;
+      }
+
+      const bool scopeNameEndsWithDelimiter = _scopeName.size() >= 2 &&
+          _scopeName.compare(_scopeName.size() - 2, 2, "::") == 0;
+      const bool localNameStartsWithDelimiter =
+          _localName.substr(0, 2) == "::";
+      if (scopeNameEndsWithDelimiter && localNameStartsWithDelimiter)
+        _localName.remove_prefix(2);
+      else if (!scopeNameEndsWithDelimiter && !localNameStartsWithDelimiter)
+        _scopeName.append("::");
+      _scopeName.append(_localName);
+    }
+
+    /// \brief Constructor with known delimiter positions.
+    /// \param[in] _name The scoped name.
+    /// \param[in] _first Position of the first delimiter.
+    /// \param[in] _last Position of the last delimiter.
+    private: ScopedName(std::string_view _name, std::size_t _first,
+                        std::size_t _last)
+      : name(_name), first(_first), last(_last)
+    {
+    }
+
+    /// \brief The scoped name.
+    private: std::string_view name;
+
+    /// \brief Position of the first delimiter, or npos.
+    private: std::size_t first;
+
+    /// \brief Position of the last delimiter, or npos.
+    private: std::size_t last;
+  };
   }
 }
 #endif
@@ -40,6 +40,7 @@ namespace sdf
   //
 
   // Forward declarations.
+  class DomInterner;
   class Geometry;
   struct PoseRelativeToGraph;
   template <typename T> class ScopedGraph;
@@ -119,6 +120,17 @@ namespace sdf
     /// \return SemanticPose object for this link.
     public: sdf::SemanticPose SemanticPose() const;
 
+    /// \brief Resolve the pose of this visual relative to a frame, as
+    /// SemanticPose().Resolve() does, without constructing a SemanticPose.
+    /// If there are any errors resolving the pose, the output will not be
+    /// modified.
+    /// \param[out] _pose The resolved pose.
+    /// \param[in] _resolveTo The pose will be resolved with respect to this
+    /// frame. If unset or empty, the parent link will be used.
+    /// \return Errors in resolving pose.
+    public: Errors ResolvePose(ignition::math::Pose3d &_pose,
+                               const std::string &_resolveTo = "") const;
+
     /// \brief Get a pointer to the SDF element that was used during
     /// load.
     /// \return SDF element pointer. The value will be nullptr if Load has
@@ -198,11 +210,20 @@ namespace sdf
     private: void SetPoseRelativeToGraph(
         sdf::ScopedGraph<PoseRelativeToGraph> _graph);
 
+    /// \brief Share the geometry and material of this visual with the
+    /// identical ones of other visuals. This is private and is intended to
+    /// be called by DomInterner when Root::Load shares identical objects.
+    /// \param[in,out] _interner The objects to share.
+    private: void ShareProperties(DomInterner &_interner);
+
     /// \brief Allow Link::SetPoseRelativeToGraph to call SetXmlParentName
     /// and SetPoseRelativeToGraph, but Link::SetPoseRelativeToGraph is
     /// a private function, so we need to befriend the entire class.
     friend class Link;
 
+    /// \brief Allow DomInterner to call ShareProperties.
+    friend class DomInterner;
+
     /// \brief Private data pointer.
     IGN_UTILS_IMPL_PTR(dataPtr)
   };
@@ -17,15 +17,20 @@
 #ifndef SDF_WORLD_HH_
 #define SDF_WORLD_HH_
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/SphericalCoordinates.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/utils/ImplPtr.hh>
 
 #include "sdf/Atmosphere.hh"
 #include "sdf/Element.hh"
+#include "sdf/EntityTables.hh"
 #include "sdf/Gui.hh"
 #include "sdf/ParserConfig.hh"
 #include "sdf/Plugin.hh"
@@ -48,11 +53,41 @@ namespace sdf
   class Model;
   class ParserConfig;
   class Physics;
+  class Population;
   class NestedInclude;
   struct PoseRelativeToGraph;
   struct FrameAttachedToGraph;
   template <typename T> class ScopedGraph;
 
+  /// \brief Contact filtering bitmasks of every collision of a world, in
+  /// flat arrays indexed by collision. Collisions with the same pair of
+  /// bitmasks share a group, and whether two groups collide is precomputed,
+  /// so that a broadphase can filter pairs of collisions with a lookup or
+  /// with mask tests on the arrays.
+  struct CollisionFilterTable
+  {
+    /// \brief Scoped names of the collisions relative to the world, such
+    /// as "model::link::collision".
+    std::vector<std::string> names;
+
+    /// \brief Collide bitmask of each collision.
+    std::vector<uint16_t> collideBitmasks;
+
+    /// \brief Category bitmask of each collision.
+    std::vector<uint16_t> categoryBitmasks;
+
+    /// \brief Group of each collision, between 0 and groupCount - 1.
+    std::vector<uint32_t> groupIds;
+
+    /// \brief Number of groups.
+    uint32_t groupCount = 0;
+
+    /// \brief Whether the collisions of two groups collide, such that the
+    /// collisions of groups a and b collide if groupCollides[a * groupCount
+    /// + b] is not zero.
+    std::vector<uint8_t> groupCollides;
+  };
+
   class SDFORMAT_VISIBLE World
   {
     /// \brief Default constructor
@@ -151,6 +186,55 @@ namespace sdf
     public: void SetSphericalCoordinates(
         const ignition::math::SphericalCoordinates &_coord);
 
+    /// \brief Convert positions in the world frame to geodetic coordinates,
+    /// with the spherical coordinates of the world origin. The results are
+    /// those of SphericalCoordinates()->PositionTransform from the LOCAL to
+    /// the SPHERICAL type, but the rotations between the world frame and
+    /// Earth-centered, Earth-fixed coordinates are only computed when the
+    /// spherical coordinates are set, so converting many positions at once,
+    /// such as the positions of Root::ResolveAllPoses, is much faster.
+    /// \param[in] _positions Positions in the world frame, in meters.
+    /// \param[out] _geodetic Latitudes and longitudes in radians and
+    /// altitudes in meters, in the order of _positions.
+    /// \return Errors, including an ELEMENT_MISSING error if the world has no
+    /// spherical coordinates.
+    public: Errors LocalToGeodetic(
+                const std::vector<ignition::math::Vector3d> &_positions,
+                std::vector<ignition::math::Vector3d> &_geodetic) const;
+
+    /// \brief Convert geodetic coordinates to positions in the world frame,
+    /// like LocalToGeodetic does the other way, with the results of
+    /// PositionTransform from the SPHERICAL to the LOCAL type.
+    /// \param[in] _geodetic Latitudes and longitudes in radians and
+    /// altitudes in meters.
+    /// \param[out] _positions Positions in the world frame, in meters, in
+    /// the order of _geodetic.
+    /// \return Errors, including an ELEMENT_MISSING error if the world has no
+    /// spherical coordinates.
+    public: Errors GeodeticToLocal(
+                const std::vector<ignition::math::Vector3d> &_geodetic,
+                std::vector<ignition::math::Vector3d> &_positions) const;
+
+    /// \brief Resolve the tables of the models, links, collisions, joints
+    /// and sensors of this world and of its nested models, for consumers
+    /// that process every entity of the world in bulk. The poses are
+    /// resolved with one traversal of the pose graph of each model, as in
+    /// Model::ResolveAllPoses. Interface models are not part of the tables.
+    /// \param[out] _tables The tables. Poses that could not be resolved are
+    /// set to zero, and joint links that could not be resolved are set to
+    /// EntityTables::kNoIndex.
+    /// \return Errors in resolving the poses and the joint links.
+    public: Errors ResolveEntityTables(sdf::EntityTables &_tables) const;
+
+    /// \brief Finish the state that this world computes on first use, so
+    /// that const functions can be called from several threads without
+    /// locking. This loads the lazily loaded models and the children of
+    /// the interface models, builds the spatial indices of the models and
+    /// lights, and makes the poses cached by the frame graphs read-only.
+    /// Calling a non-const function of the world, or of one of its objects,
+    /// may undo part of this. Root::Freeze calls this on every world.
+    public: void Freeze();
+
     /// \brief Get the number of models that are immediate (not nested) children
     /// of this World object.
     /// \remark ModelByName() can find nested models that are not immediate
@@ -174,6 +258,25 @@ namespace sdf
     /// \sa uint64_t ModelCount() const
     public: Model *ModelByIndex(uint64_t _index);
 
+    /// \brief Get an immediate child model based on an index, without
+    /// loading it if the world was loaded with
+    /// ParserConfig::SetLazyWorldModels and the model was not used yet.
+    /// \param[in] _index Index of the model. The index should be in the range
+    /// [0..ModelCount()).
+    /// \return Pointer to the model, of which only the name, the raw pose and
+    /// the pose relative_to frame are set if ModelLoaded is false. Nullptr if
+    /// the index does not exist.
+    /// \sa ParserConfig::SetLazyWorldModels
+    public: const Model *ModelStubByIndex(const uint64_t _index) const;
+
+    /// \brief Get whether a model was loaded, which is only false for the
+    /// models of a world loaded with ParserConfig::SetLazyWorldModels that
+    /// were not used yet.
+    /// \param[in] _index Index of the model.
+    /// \return True if the model is loaded, false if it is not loaded or if
+    /// the index does not exist.
+    public: bool ModelLoaded(const uint64_t _index) const;
+
     /// \brief Get a model based on a name.
     /// \param[in] _name Name of the model.
     /// To get a model nested in other models, prefix the model name
@@ -199,45 +302,140 @@ namespace sdf
     /// \return True if there exists a model with the given name.
     public: bool ModelNameExists(const std::string &_name) const;
 
+    /// \brief Build the table of the contact filtering bitmasks of every
+    /// collision of the models of this world, including nested models. Two
+    /// collisions collide if the category bitmask of either one shares a bit
+    /// with the collide bitmask of the other. Collisions are listed model by
+    /// model, link by link, in the order they appear in the world.
+    /// \return The table.
+    public: CollisionFilterTable CollisionFilters() const;
+
+    /// \brief Get the models whose bounds intersect a sphere. The bounds of
+    /// a model are a sphere around its resolved pose that contains the
+    /// shapes of its collisions and visuals, including those of nested
+    /// models, from Geometry::AxisAlignedBox. Models with planes or with
+    /// meshes without extents, and models whose poses can not be resolved,
+    /// have no bounds and are always returned. The bounds are
+    /// kept in a bounding volume hierarchy that is built on first use and
+    /// updated by AddModel, and that is built again after models are
+    /// removed, are accessed through mutable pointers, or after the pose
+    /// graph is updated by Root::UpdateGraphs.
+    /// \param[in] _point Center of the sphere, in the world frame.
+    /// \param[in] _radius Radius of the sphere.
+    /// \return The models, in the order of ModelByIndex.
+    public: std::vector<const Model *> ModelsInRadius(
+                const ignition::math::Vector3d &_point, double _radius) const;
+
+    /// \brief Get the models whose bounds intersect a box. The bounds are
+    /// the ones of ModelsInRadius.
+    /// \param[in] _box The box, in the world frame.
+    /// \return The models, in the order of ModelByIndex.
+    public: std::vector<const Model *> ModelsInBox(
+                const ignition::math::AxisAlignedBox &_box) const;
+
+    /// \brief Get the lights whose range intersects a sphere. The bounds of
+    /// a point or spot light are a sphere around its resolved pose with its
+    /// attenuation range as radius. Directional lights, and lights whose
+    /// poses can not be resolved, are always returned. The bounds are kept
+    /// up to date like the ones of ModelsInRadius, and are updated by
+    /// AddLight.
+    /// \param[in] _point Center of the sphere, in the world frame.
+    /// \param[in] _radius Radius of the sphere.
+    /// \return The lights, in the order of LightByIndex.
+    public: std::vector<const Light *> LightsInRadius(
+                const ignition::math::Vector3d &_point, double _radius) const;
+
+    /// \brief Get the lights whose range intersects a box. The bounds are
+    /// the ones of LightsInRadius.
+    /// \param[in] _box The box, in the world frame.
+    /// \return The lights, in the order of LightByIndex.
+    public: std::vector<const Light *> LightsInBox(
+                const ignition::math::AxisAlignedBox &_box) const;
+
     /// \brief Add a model to the world.
     /// \param[in] _model Model to add.
     /// \return True if successful, false if a model with the name already
     /// exists.
     public: bool AddModel(const Model &_model);
 
+    /// \brief Add a model to the world, moving it instead of copying it.
+    /// \param[in] _model Model to add.
+    /// \return True if successful, false if a model with the name already
+    /// exists.
+    public: bool AddModel(Model &&_model);
+
     /// \brief Add an actor to the world.
     /// \param[in] _actor Actor to add.
     /// \return True if successful, false if an actor with the name already
     /// exists.
     public: bool AddActor(const Actor &_actor);
 
+    /// \brief Add an actor to the world, moving it instead of copying it.
+    /// \param[in] _actor Actor to add.
+    /// \return True if successful, false if an actor with the name already
+    /// exists.
+    public: bool AddActor(Actor &&_actor);
+
+    /// \brief Add a population to the world.
+    /// \param[in] _population Population to add.
+    /// \return True if successful, false if a population with the name
+    /// already exists.
+    public: bool AddPopulation(const Population &_population);
+
     /// \brief Add a light to the world.
     /// \param[in] _light Light to add.
     /// \return True if successful, false if a light with the name already
     /// exists.
     public: bool AddLight(const Light &_light);
 
+    /// \brief Add a light to the world, moving it instead of copying it.
+    /// \param[in] _light Light to add.
+    /// \return True if successful, false if a light with the name already
+    /// exists.
+    public: bool AddLight(Light &&_light);
+
     /// \brief Add a physics object to the world.
     /// \param[in] _physics Physics to add.
     /// \return True if successful, false if a physics object with the name
     /// already exists.
     public: bool AddPhysics(const Physics &_physics);
 
+    /// \brief Add a physics object to the world, moving it instead of copying
+    /// it.
+    /// \param[in] _physics Physics to add.
+    /// \return True if successful, false if a physics object with the name
+    /// already exists.
+    public: bool AddPhysics(Physics &&_physics);
+
     /// \brief Add a frame object to the world.
     /// \param[in] _frame Frame to add.
     /// \return True if successful, false if a frames object with the name
     /// already exists.
     public: bool AddFrame(const Frame &_frame);
 
+    /// \brief Add a frame object to the world, moving it instead of copying it.
+    /// \param[in] _frame Frame to add.
+    /// \return True if successful, false if a frames object with the name
+    /// already exists.
+    public: bool AddFrame(Frame &&_frame);
+
     /// \brief Remove all models.
     public: void ClearModels();
 
+    /// \brief Remove a model from the world.
+    /// \param[in] _name Name of the model to remove.
+    /// \return True if a model with the given name was removed.
+    public: bool RemoveModelByName(const std::string &_name);
+
     /// \brief Remove all models.
     public: void ClearActors();
 
     /// \brief Remove all models.
     public: void ClearLights();
 
+    /// \brief Remove all populations.
+    public: void ClearPopulations();
+
     /// \brief Remove all physics.
     public: void ClearPhysics();
 
@@ -267,6 +465,32 @@ namespace sdf
     /// \return True if there exists an actor with the given name.
     public: bool ActorNameExists(const std::string &_name) const;
 
+    /// \brief Get the number of populations. The models of the populations
+    /// are not models of the world, see sdf::Population.
+    /// \return Number of populations contained in this World object.
+    public: uint64_t PopulationCount() const;
+
+    /// \brief Get a population based on an index.
+    /// \param[in] _index Index of the population. The index should be in the
+    /// range [0..PopulationCount()).
+    /// \return Pointer to the population. Nullptr if the index does not
+    /// exist.
+    /// \sa uint64_t PopulationCount() const
+    public: const Population *PopulationByIndex(const uint64_t _index) const;
+
+    /// \brief Get a mutable population based on an index.
+    /// \param[in] _index Index of the population. The index should be in the
+    /// range [0..PopulationCount()).
+    /// \return Pointer to the population. Nullptr if the index does not
+    /// exist.
+    /// \sa uint64_t PopulationCount() const
+    public: Population *PopulationByIndex(uint64_t _index);
+
+    /// \brief Get whether a population name exists.
+    /// \param[in] _name Name of the population to check.
+    /// \return True if there exists a population with the given name.
+    public: bool PopulationNameExists(const std::string &_name) const;
+
     /// \brief Get the number of explicit frames that are immediate (not nested)
     /// children of this World object.
     /// \remark FrameByName() can find explicit frames that are not immediate
@@ -468,6 +692,12 @@ namespace sdf
     private: void SetFrameAttachedToGraph(
         sdf::ScopedGraph<FrameAttachedToGraph> _graph);
 
+    /// \brief Get a model by its possibly scoped name, such as "a::b::c",
+    /// without copying parts of the name.
+    /// \param[in] _name Name of the model.
+    /// \return The model, or nullptr if it does not exist.
+    private: const Model *ModelByScopedName(ScopedName _name) const;
+
     /// \brief Allow Root::Load to call SetPoseRelativeToGraph and
     /// SetFrameAttachedToGraph
     friend class Root;
@@ -0,0 +1,342 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_WORLDSTATE_HH_
+#define SDF_WORLDSTATE_HH_
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/utils/ImplPtr.hh>
+
+#include "sdf/Element.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/Types.hh"
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief A snapshot of the state of a world, as described by a <state>
+  /// element.
+  ///
+  /// The state is stored as a structure of arrays instead of a tree of
+  /// objects. The models of all levels of nesting are in one set of arrays,
+  /// loaded in depth-first order, and a model always comes after its parent.
+  /// The links and joints of all the models are in other sets of arrays,
+  /// which refer to their model by index. Entities are addressed by index,
+  /// and ModelIndex, LinkIndex and JointIndex find the index of a scoped
+  /// name such as "model::nested_model::link".
+  ///
+  /// The frame and collision states, the light states and the pose
+  /// relative_to attributes are not stored. The <insertions> element is kept
+  /// as an element.
+  class SDFORMAT_VISIBLE WorldState
+  {
+    /// \brief The parent index of a model that is not nested.
+    public: static constexpr uint64_t kNoParent =
+        std::numeric_limits<uint64_t>::max();
+
+    /// \brief Default constructor
+    public: WorldState();
+
+    /// \brief Load the state based on an element pointer. This is *not* the
+    /// usual entry point. Typical usage of the SDF DOM is through the Root
+    /// object.
+    /// \param[in] _sdf The SDF Element pointer
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors Load(ElementPtr _sdf);
+
+    /// \brief Load the state based on an element pointer. This is *not* the
+    /// usual entry point. Typical usage of the SDF DOM is through the Root
+    /// object.
+    /// \param[in] _sdf The SDF Element pointer
+    /// \param[in] _config Parser configuration
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors Load(ElementPtr _sdf, const ParserConfig &_config);
+
+    /// \brief Get the name of the world this state applies to.
+    /// \return Name of the world.
+    public: const std::string &WorldName() const;
+
+    /// \brief Set the name of the world this state applies to.
+    /// \param[in] _name Name of the world.
+    public: void SetWorldName(const std::string &_name);
+
+    /// \brief Get the simulation time stamp of the state.
+    /// \return The simulation time.
+    public: const sdf::Time &SimTime() const;
+
+    /// \brief Set the simulation time stamp of the state.
+    /// \param[in] _time The simulation time.
+    public: void SetSimTime(const sdf::Time &_time);
+
+    /// \brief Get the wall time stamp of the state.
+    /// \return The wall time.
+    public: const sdf::Time &WallTime() const;
+
+    /// \brief Set the wall time stamp of the state.
+    /// \param[in] _time The wall time.
+    public: void SetWallTime(const sdf::Time &_time);
+
+    /// \brief Get the real time stamp of the state.
+    /// \return The real time.
+    public: const sdf::Time &RealTime() const;
+
+    /// \brief Set the real time stamp of the state.
+    /// \param[in] _time The real time.
+    public: void SetRealTime(const sdf::Time &_time);
+
+    /// \brief Get the number of simulation iterations.
+    /// \return The number of iterations.
+    public: uint64_t Iterations() const;
+
+    /// \brief Set the number of simulation iterations.
+    /// \param[in] _iterations The number of iterations.
+    public: void SetIterations(uint64_t _iterations);
+
+    /// \brief Get the <insertions> element, which describes the models and
+    /// lights inserted in the world.
+    /// \return The element, or nullptr if nothing was inserted.
+    public: sdf::ElementPtr Insertions() const;
+
+    /// \brief Set the <insertions> element.
+    /// \param[in] _insertions The element, or nullptr to remove it.
+    public: void SetInsertions(sdf::ElementPtr _insertions);
+
+    /// \brief Get the names of the entities deleted from the world.
+    /// \return The names of the deleted entities.
+    public: const std::vector<std::string> &Deletions() const;
+
+    /// \brief Add the name of an entity deleted from the world.
+    /// \param[in] _name Name of the deleted entity.
+    public: void AddDeletion(const std::string &_name);
+
+    /// \brief Get the number of model states, at all levels of nesting.
+    /// \return The number of models.
+    public: uint64_t ModelCount() const;
+
+    /// \brief Get the names of the models, which are not scoped.
+    /// \return The name of each model.
+    public: const std::vector<std::string> &ModelNames() const;
+
+    /// \brief Get the indices of the parents of the models.
+    /// \return The index of the parent model of each model, or kNoParent
+    /// for a model that is not nested.
+    public: const std::vector<uint64_t> &ModelParents() const;
+
+    /// \brief Get the poses of the models.
+    /// \return The pose of each model.
+    public: const std::vector<ignition::math::Pose3d> &ModelPoses() const;
+
+    /// \brief Get the mutable poses of the models, to update a state in
+    /// place.
+    /// \return The pose of each model.
+    public: std::vector<ignition::math::Pose3d> &ModelPoses();
+
+    /// \brief Get the scales of the models.
+    /// \return The scale of each model.
+    public: const std::vector<ignition::math::Vector3d> &ModelScales() const;
+
+    /// \brief Get the mutable scales of the models, to update a state in
+    /// place.
+    /// \return The scale of each model.
+    public: std::vector<ignition::math::Vector3d> &ModelScales();
+
+    /// \brief Find a model by scoped name.
+    /// \param[in] _scopedName Name of the model, scoped by the names of its
+    /// parent models, such as "model::nested_model".
+    /// \return The index of the model, or std::nullopt if it does not exist.
+    public: std::optional<uint64_t> ModelIndex(
+                const std::string &_scopedName) const;
+
+    /// \brief Add a model state, with an identity pose and a unit scale.
+    /// \param[in] _name Name of the model.
+    /// \param[in] _parent Index of the parent model, or kNoParent.
+    /// \return The index of the model, or std::nullopt if the parent does
+    /// not exist.
+    public: std::optional<uint64_t> AddModel(const std::string &_name,
+                uint64_t _parent = kNoParent);
+
+    /// \brief Get the number of link states, of all the models.
+    /// \return The number of links.
+    public: uint64_t LinkCount() const;
+
+    /// \brief Get the indices of the models of the links.
+    /// \return The index of the model of each link.
+    public: const std::vector<uint64_t> &LinkModels() const;
+
+    /// \brief Get the names of the links, which are not scoped.
+    /// \return The name of each link.
+    public: const std::vector<std::string> &LinkNames() const;
+
+    /// \brief Get the poses of the links.
+    /// \return The pose of each link.
+    public: const std::vector<ignition::math::Pose3d> &LinkPoses() const;
+
+    /// \brief Get the mutable poses of the links, to update a state in
+    /// place.
+    /// \return The pose of each link.
+    public: std::vector<ignition::math::Pose3d> &LinkPoses();
+
+    /// \brief Get the velocities of the links. The position of each pose is
+    /// the linear velocity, and its roll, pitch and yaw are the angular
+    /// velocity.
+    /// \return The velocity of each link.
+    public: const std::vector<ignition::math::Pose3d> &LinkVelocities() const;
+
+    /// \brief Get the mutable velocities of the links, to update a state in
+    /// place.
+    /// \return The velocity of each link.
+    public: std::vector<ignition::math::Pose3d> &LinkVelocities();
+
+    /// \brief Get the accelerations of the links, stored like the
+    /// velocities.
+    /// \return The acceleration of each link.
+    public: const std::vector<ignition::math::Pose3d> &
+                LinkAccelerations() const;
+
+    /// \brief Get the mutable accelerations of the links, to update a state
+    /// in place.
+    /// \return The acceleration of each link.
+    public: std::vector<ignition::math::Pose3d> &LinkAccelerations();
+
+    /// \brief Get the wrenches applied to the links. The position of each
+    /// pose is the force, and its roll, pitch and yaw are the torque.
+    /// \return The wrench of each link.
+    public: const std::vector<ignition::math::Pose3d> &LinkWrenches() const;
+
+    /// \brief Get the mutable wrenches of the links, to update a state in
+    /// place.
+    /// \return The wrench of each link.
+    public: std::vector<ignition::math::Pose3d> &LinkWrenches();
+
+    /// \brief Find a link by scoped name.
+    /// \param[in] _scopedName Name of the link, scoped by the names of its
+    /// models, such as "model::link".
+    /// \return The index of the link, or std::nullopt if it does not exist.
+    public: std::optional<uint64_t> LinkIndex(
+                const std::string &_scopedName) const;
+
+    /// \brief Add a link state, with identity pose, velocity, acceleration
+    /// and wrench.
+    /// \param[in] _name Name of the link.
+    /// \param[in] _model Index of the model of the link.
+    /// \return The index of the link, or std::nullopt if the model does not
+    /// exist.
+    public: std::optional<uint64_t> AddLink(const std::string &_name,
+                uint64_t _model);
+
+    /// \brief Get the number of joint states, of all the models.
+    /// \return The number of joints.
+    public: uint64_t JointCount() const;
+
+    /// \brief Get the indices of the models of the joints.
+    /// \return The index of the model of each joint.
+    public: const std::vector<uint64_t> &JointModels() const;
+
+    /// \brief Get the names of the joints, which are not scoped.
+    /// \return The name of each joint.
+    public: const std::vector<std::string> &JointNames() const;
+
+    /// \brief Get the offsets of the angles of each joint in JointAngles()
+    /// and JointAxes(). The angles of joint i are in the range
+    /// [JointAngleOffsets()[i]..JointAngleOffsets()[i + 1]).
+    /// \return JointCount() + 1 offsets.
+    public: const std::vector<uint64_t> &JointAngleOffsets() const;
+
+    /// \brief Get the angles of the axes of all the joints.
+    /// \return The angles.
+    /// \sa JointAngleOffsets
+    public: const std::vector<double> &JointAngles() const;
+
+    /// \brief Get the mutable angles of the axes of all the joints, to
+    /// update a state in place.
+    /// \return The angles.
+    public: std::vector<double> &JointAngles();
+
+    /// \brief Get the index of the axis of each angle of JointAngles().
+    /// \return The axis indices.
+    public: const std::vector<unsigned int> &JointAxes() const;
+
+    /// \brief Find a joint by scoped name.
+    /// \param[in] _scopedName Name of the joint, scoped by the names of its
+    /// models, such as "model::joint".
+    /// \return The index of the joint, or std::nullopt if it does not exist.
+    public: std::optional<uint64_t> JointIndex(
+                const std::string &_scopedName) const;
+
+    /// \brief Add a joint state, with an angle of 0 for each axis.
+    /// \param[in] _name Name of the joint.
+    /// \param[in] _model Index of the model of the joint.
+    /// \param[in] _axisCount Number of axes of the joint.
+    /// \return The index of the joint, or std::nullopt if the model does not
+    /// exist.
+    public: std::optional<uint64_t> AddJoint(const std::string &_name,
+                uint64_t _model, unsigned int _axisCount = 1);
+
+    /// \brief Compute the difference between two states, to store a stream
+    /// of states compactly. The difference is a state that only contains
+    /// the models, links and joints that are new or changed in _to, with
+    /// the models that contain them, and the time stamps, iterations and
+    /// insertions of _to. Its deletions are the deletions of _to, followed
+    /// by the scoped names of the entities of _from that are not in _to.
+    /// Poses and angles are compared with a tolerance of 1e-6.
+    /// \param[in] _from The previous state.
+    /// \param[in] _to The next state.
+    /// \return The difference, which can be written with ToElement.
+    /// \sa ApplyDiff
+    public: static WorldState Diff(const WorldState &_from,
+                                   const WorldState &_to);
+
+    /// \brief Apply a difference computed by Diff. The entities named by
+    /// the deletions of _diff are removed with their nested entities, then
+    /// the entities of _diff are updated, or added if they do not exist.
+    /// The time stamps, iterations, insertions and deletions of this state
+    /// are replaced by those of _diff.
+    /// \param[in] _diff The difference.
+    public: void ApplyDiff(const WorldState &_diff);
+
+    /// \brief Remove all the model, link and joint states.
+    public: void ClearEntities();
+
+    /// \brief Get a pointer to the SDF element that was used during load.
+    /// \return SDF element pointer. The value will be nullptr if Load has
+    /// not been called.
+    public: sdf::ElementPtr Element() const;
+
+    /// \brief Create and return an SDF element filled with data from this
+    /// state.
+    /// \return SDF element pointer with updated state values.
+    public: sdf::ElementPtr ToElement() const;
+
+    /// \brief Private data pointer.
+    IGN_UTILS_IMPL_PTR(dataPtr)
+  };
+  }
+}
+#endif
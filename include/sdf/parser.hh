@@ -17,6 +17,8 @@
 #ifndef SDF_PARSER_HH_
 #define SDF_PARSER_HH_
 
+#include <cstddef>
+#include <ostream>
 #include <string>
 
 #include "sdf/SDFImpl.hh"
@@ -229,6 +231,24 @@ namespace sdf
   bool readString(const std::string &_xmlString, const ParserConfig &_config,
       SDFPtr _sdf, Errors &_errors);
 
+  /// \brief Populate the SDF values from a buffer
+  ///
+  /// This is the same as readString, but the XML is read from a buffer
+  /// that does not have to be a null-terminated std::string, such as a
+  /// network payload or a std::string_view, so that it does not have to be
+  /// copied into a string first. A URDF document is still copied to be
+  /// converted.
+  /// \param[in] _data XML to be parsed, which does not have to be null
+  /// terminated.
+  /// \param[in] _size Number of characters of _data.
+  /// \param[in] _config Custom parser configuration
+  /// \param[out] _sdf Pointer to an SDF object.
+  /// \param[out] _errors Parsing errors will be appended to this variable.
+  /// \return True if successful.
+  SDFORMAT_VISIBLE
+  bool readString(const char *_data, std::size_t _size,
+      const ParserConfig &_config, SDFPtr _sdf, Errors &_errors);
+
   /// \brief Populate the SDF values from a string
   ///
   /// This populates the SDF pointer from a string. If the string is a URDF
@@ -315,6 +335,18 @@ namespace sdf
   SDFORMAT_VISIBLE
   std::string getModelFilePath(const std::string &_modelDirPath);
 
+  /// \brief Get the file path to the model file
+  /// \param[in] _modelDirPath directory system path of the model
+  /// \param[in] _config Custom parser configuration. Its model
+  /// configuration cache, if enabled, is used and updated.
+  /// \return string with the full filesystem path to the best version (greater
+  ///         SDF protocol supported by this sdformat version) of the .sdf
+  ///         model files hosted by _modelDirPath.
+  /// \sa ParserConfig::SetUseModelConfigCache
+  SDFORMAT_VISIBLE
+  std::string getModelFilePath(const std::string &_modelDirPath,
+                               const ParserConfig &_config);
+
   /// \brief Convert an SDF file to a specific SDF version.
   /// \param[in] _filename Name of the SDF file to convert.
   /// \param[in] _version Version to convert _filename to.
@@ -353,6 +385,32 @@ namespace sdf
   bool convertString(const std::string &_sdfString, const std::string &_version,
                      const ParserConfig &_config, SDFPtr _sdf);
 
+  /// \brief Encode a document in the binary SDFormat encoding. Binary
+  /// documents are read by readFile, readString and Root::Load like XML
+  /// documents, but without parsing text or numbers, which suits documents
+  /// that are generated and never read by people. The elements are stored
+  /// as they were loaded, with their includes expanded, in the version of
+  /// the specification of this library. A binary document can only be read
+  /// by a library whose specification has the same element descriptions.
+  /// \param[in] _sdf The <sdf> element of a loaded document, such as
+  /// SDF::Root() or Root::Element().
+  /// \param[out] _data The encoded document.
+  /// \param[out] _errors Errors will be appended to this variable.
+  /// \return True if the document was encoded.
+  SDFORMAT_VISIBLE
+  bool encodeBinary(ElementPtr _sdf, std::string &_data, Errors &_errors);
+
+  /// \brief Encode a document in the binary SDFormat encoding.
+  /// \param[in] _sdf The <sdf> element of a loaded document.
+  /// \param[in] _config Custom parser configuration.
+  /// \param[out] _data The encoded document.
+  /// \param[out] _errors Errors will be appended to this variable.
+  /// \return True if the document was encoded.
+  /// \sa encodeBinary(ElementPtr, std::string &, Errors &)
+  SDFORMAT_VISIBLE
+  bool encodeBinary(ElementPtr _sdf, const ParserConfig &_config,
+                    std::string &_data, Errors &_errors);
+
   /// \brief Check that for each model, the canonical_link attribute value
   /// matches the name of a link in the model if the attribute is set and
   /// not empty.
@@ -444,6 +502,48 @@ namespace sdf
   SDFORMAT_VISIBLE
   bool recursiveSiblingNoDoubleColonInNames(sdf::ElementPtr _elem);
 
+  /// \brief Check the rules of recursiveSameTypeUniqueNames,
+  /// recursiveSiblingUniqueNames and recursiveSiblingNoDoubleColonInNames that
+  /// are enabled, visiting each element only once. The errors printed for
+  /// each rule are the same as those of the individual functions.
+  /// This checks recursively and should check the files exhaustively
+  /// rather than terminating early when the first error is found.
+  /// \param[in] _elem SDF Element to check recursively.
+  /// \param[in] _sameTypeUniqueNames True to check that sibling elements of
+  /// the same type have unique names.
+  /// \param[in] _siblingUniqueNames True to check that sibling elements of
+  /// any type have unique names.
+  /// \param[in] _noDoubleColonInNames True to check that element names do
+  /// not contain the delimiter '::'.
+  /// \return True if all enabled rules are satisfied.
+  SDFORMAT_VISIBLE
+  bool recursiveCheckNames(sdf::ElementPtr _elem,
+                           bool _sameTypeUniqueNames = true,
+                           bool _siblingUniqueNames = true,
+                           bool _noDoubleColonInNames = true);
+
+  /// \brief Run the checks of checkCanonicalLinkNames,
+  /// checkJointParentChildLinkNames, checkFrameAttachedToGraph,
+  /// checkPoseRelativeToGraph and recursiveSiblingUniqueNames in a single
+  /// traversal of the worlds and models of a root, followed by a single
+  /// traversal of its elements. These are the checks run by
+  /// `ign sdf --check`.
+  /// This checks recursively and should check the files exhaustively
+  /// rather than terminating early when the first error is found.
+  /// \param[in] _root SDF Root object to check recursively.
+  /// \return True if all checks pass.
+  SDFORMAT_VISIBLE
+  bool checkRoot(const sdf::Root *_root);
+
+  /// \brief Run the checks of checkRoot, writing the errors to a stream
+  /// instead of std::cerr, so that the caller can keep them with the other
+  /// output of the same file.
+  /// \param[in] _root SDF Root object to check recursively.
+  /// \param[out] _err Stream for the errors, in the order they are found.
+  /// \return True if all checks pass.
+  SDFORMAT_VISIBLE
+  bool checkRoot(const sdf::Root *_root, std::ostream &_err);
+
   /// \brief Check whether the element should be validated. If this returns
   /// false, validators such as the unique name and reserve name checkers should
   /// skip this element and its descendants.
@@ -9,16 +9,23 @@ supportedSdfVersions = ['1.9', '1.8', '1.7', '1.6', '1.5', '1.4', '1.3', '1.2']
 supportedSdfConversions = ['1.9', '1.8', '1.7', '1.6', '1.5', '1.4', '1.3']
 
 puts %q!
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+
 #include "EmbeddedSdf.hh"
 
 namespace sdf {
 inline namespace SDF_VERSION_NAMESPACE {
 
-const std::map<std::string, std::string> &GetEmbeddedSdf() {
-  static const std::map<std::string, std::string> result{
+namespace {
+/// \brief The embedded files, sorted by pathname so that they can be found
+/// with a binary search. The contents are string literals in static
+/// storage, so nothing is allocated or copied to read them.
+constexpr EmbeddedSdfFile kEmbeddedSdfFiles[] = {
 !
 
-# Stores the contents of the file in the map.
+# Stores the contents of the file in the table.
 def embed(pathname)
   puts "{\"#{pathname}\", R\"__sdf_literal__("
   infile = File.open(pathname)
@@ -26,20 +33,259 @@ def embed(pathname)
   puts ")__sdf_literal__\"},"
 end
 
-# Embed the supported *.sdf files.
-supportedSdfVersions.each do |version|
-  Dir.glob("#{version}/*.sdf").sort.each { |file| embed(file) }
+# Embed the supported *.sdf and *.convert files, sorted by pathname.
+embeddedFiles =
+  supportedSdfVersions.flat_map { |version| Dir.glob("#{version}/*.sdf") } +
+  supportedSdfConversions.flat_map { |version|
+    Dir.glob("#{version}/*.convert") }
+embeddedFiles.sort.each { |file| embed(file) }
+puts <<~'CPP'
+  };
+  }
+
+  EmbeddedSdfRange GetEmbeddedSdf()
+  {
+    return {std::begin(kEmbeddedSdfFiles), std::end(kEmbeddedSdfFiles)};
+  }
+
+  const EmbeddedSdfFile *FindEmbeddedSdf(std::string_view _pathname)
+  {
+    const auto *begin = std::begin(kEmbeddedSdfFiles);
+    const auto *end = std::end(kEmbeddedSdfFiles);
+    const auto *it = std::lower_bound(begin, end, _pathname,
+        [](const EmbeddedSdfFile &_file, std::string_view _name)
+        {
+          return _file.pathname < _name;
+        });
+    if (it == end || it->pathname != _pathname)
+      return nullptr;
+    return it;
+  }
+CPP
+
+# Minimal reader for the specification files. It keeps the parts of the XML
+# that initXml in src/parser.cc reads, and handles text the way tinyxml2 does
+# in COLLAPSE_WHITESPACE mode, which is how the embedded files are parsed.
+SpecElement = Struct.new(:name, :attributes, :children)
+SpecText = Struct.new(:kind, :value)
+
+def unescapeXml(str)
+  str.gsub(/&(#x[0-9a-fA-F]+|#[0-9]+|quot|amp|apos|lt|gt);/) do
+    entity = Regexp.last_match(1)
+    case entity
+    when 'quot' then '"'
+    when 'amp' then '&'
+    when 'apos' then "'"
+    when 'lt' then '<'
+    when 'gt' then '>'
+    when /^#x/ then [entity[2..].to_i(16)].pack('U')
+    else [entity[1..].to_i].pack('U')
+    end
+  end
+end
+
+def parseSpec(pathname)
+  xml = File.read(pathname, mode: 'rb').gsub(/\r\n?/, "\n")
+  document = SpecElement.new(nil, {}, [])
+  stack = [document]
+  pos = 0
+  while pos < xml.size
+    if xml[pos, 2] == '<?'
+      pos = xml.index('?>', pos) + 2
+    elsif xml[pos, 4] == '<!--'
+      pos = xml.index('-->', pos) + 3
+      stack.last.children << SpecText.new(:comment, nil)
+    elsif xml[pos, 9] == '<![CDATA['
+      finish = xml.index(']]>', pos)
+      stack.last.children << SpecText.new(:cdata, xml[pos + 9...finish])
+      pos = finish + 3
+    elsif xml[pos, 2] == '<!'
+      pos = xml.index('>', pos) + 1
+    elsif xml[pos, 2] == '</'
+      finish = xml.index('>', pos)
+      name = xml[pos + 2...finish].strip
+      if stack.size < 2 || stack.last.name != name
+        raise "#{pathname}: unexpected closing tag </#{name}>"
+      end
+      stack.pop
+      pos = finish + 1
+    elsif xml[pos] == '<'
+      match = /\G<([^\s\/>]+)((?:\s+[^\s=]+\s*=\s*(?:"[^"]*"|'[^']*'))*)\s*(\/?)>/m
+        .match(xml, pos)
+      raise "#{pathname}: invalid tag at offset #{pos}" unless match
+      attributes = {}
+      match[2].scan(/([^\s=]+)\s*=\s*(?:"([^"]*)"|'([^']*)')/m) do |name, dq, sq|
+        attributes[name] = unescapeXml(dq || sq)
+      end
+      element = SpecElement.new(match[1], attributes, [])
+      stack.last.children << element
+      stack << element if match[3].empty?
+      pos = match.end(0)
+    else
+      finish = xml.index('<', pos) || xml.size
+      text = unescapeXml(xml[pos...finish]).strip.gsub(/[ \t\n\v\f\r]+/, ' ')
+      stack.last.children << SpecText.new(:text, text) unless text.empty?
+      pos = finish
+    end
+  end
+  raise "#{pathname}: unclosed element <#{stack.last.name}>" if stack.size > 1
+  document.children.find { |child| child.is_a?(SpecElement) &&
+                                    child.name == 'element' } or
+    raise "#{pathname}: missing <element>"
 end
 
-# Embed the supported *.convert files.
-supportedSdfConversions.each do |version|
-  Dir.glob("#{version}/*.convert").sort.each { |file| embed(file) }
+# Return the child elements with a given name.
+def specChildren(element, name)
+  element.children.select { |child| child.is_a?(SpecElement) &&
+                                    child.name == name }
 end
-puts %q!
+
+# Return the text of the <description> child of an element like
+# tinyxml2::XMLElement::GetText does, or nil.
+def specDescription(element)
+  description = specChildren(element, 'description').first
+  return nil unless description
+  first = description.children.first
+  first.is_a?(SpecText) && first.kind != :comment ? first.value : nil
+end
+
+# Quote a string as a C++ string literal, or nullptr for nil.
+def cString(str)
+  return 'nullptr' if str.nil?
+  '"' + str.bytes.map do |byte|
+    if byte == 0x22 || byte == 0x5c
+      '\\' + byte.chr
+    elsif byte >= 0x20 && byte < 0x7f && byte != 0x3f
+      byte.chr
+    else
+      format('\\%03o', byte)
+    end
+  end.join + '"'
+end
+
+# Write the table of one specification file. Elements are listed
+# breadth-first so that the children of each element are contiguous, with
+# the <element> children before the <include> children, as initXml adds
+# them.
+def embedSchema(pathname, index)
+  root = parseSpec(pathname)
+  elements = []
+  attributes = []
+  queue = [[root, nil]]
+  rows = [nil]
+  head = 0
+  while head < queue.size
+    xml, includeDescription = queue[head]
+    row = { element: xml, firstChild: 0, childCount: 0,
+            firstAttribute: attributes.size, attributeCount: 0 }
+    if xml.name == 'include'
+      filename = xml.attributes['filename'] or
+        raise "#{pathname}: <include> is missing the filename attribute"
+      row[:include] = filename
+      row[:description] = specDescription(xml)
+    else
+      row[:name] = xml.attributes['name'] or
+        raise "#{pathname}: element is missing the name attribute"
+      row[:required] = xml.attributes['required'] or
+        raise "#{pathname}: element [#{row[:name]}] is missing required"
+      row[:ref] = xml.attributes['ref']
+      row[:type] = xml.attributes['type']
+      row[:default] = xml.attributes['default']
+      if row[:type] && row[:default].nil?
+        raise "#{pathname}: element [#{row[:name]}] is missing a default"
+      end
+      row[:min] = xml.attributes['min'] || ''
+      row[:max] = xml.attributes['max'] || ''
+      row[:description] = specDescription(xml)
+      specChildren(xml, 'attribute').each do |attribute|
+        name = attribute.attributes['name']
+        values = %w[type default required].map do |key|
+          attribute.attributes[key] or
+            raise "#{pathname}: attribute [#{name}] is missing #{key}"
+        end
+        raise "#{pathname}: attribute is missing a name" unless name
+        attributes << [name, values[0], values[1], values[2].strip == '1',
+                       specDescription(attribute)]
+      end
+      row[:attributeCount] = attributes.size - row[:firstAttribute]
+
+      children = []
+      specChildren(xml, 'element').each do |child|
+        copyData = child.attributes['copy_data']
+        if copyData == 'true' || copyData == '1'
+          row[:copyChildren] = true
+        else
+          children << child
+        end
+      end
+      children += specChildren(xml, 'include')
+      row[:firstChild] = queue.size
+      row[:childCount] = children.size
+      children.each { |child| queue << [child, nil] }
+    end
+    elements << row
+    head += 1
+  end
+
+  puts "constexpr EmbeddedSchemaAttribute kAttributes#{index}[] = {"
+  attributes.each do |name, type, default, required, description|
+    puts "  {#{cString(name)}, #{cString(type)}, #{cString(default)}, " \
+         "#{required}, #{cString(description)}},"
+  end
+  puts "  {nullptr, nullptr, nullptr, false, nullptr}"
+  puts '};'
+  puts "constexpr EmbeddedSchemaElement kElements#{index}[] = {"
+  elements.each do |row|
+    puts "  {#{cString(row[:include])}, #{cString(row[:name])}, " \
+         "#{cString(row[:required])}, #{cString(row[:ref])}, " \
+         "#{cString(row[:type])}, #{cString(row[:default])}, " \
+         "#{cString(row[:min])}, #{cString(row[:max])}, " \
+         "#{cString(row[:description])}, #{row[:copyChildren] ? true : false}, " \
+         "#{row[:firstAttribute]}, #{row[:attributeCount]}, " \
+         "#{row[:firstChild]}, #{row[:childCount]}},"
+  end
+  puts '};'
+end
+
+# Embed the supported *.sdf files pre-parsed, so that the description of a
+# specification can be built without parsing XML.
+schemaFiles = supportedSdfVersions.flat_map { |version|
+  Dir.glob("#{version}/*.sdf") }.sort
+puts 'namespace {'
+schemaFiles.each_with_index { |file, index| embedSchema(file, index) }
+puts <<~'CPP'
+
+  /// \brief Pre-parsed specification file and its pathname.
+  struct EmbeddedSchemaEntry
+  {
+    const char *pathname;
+    EmbeddedSchemaFile file;
   };
-  return result;
-}
+CPP
+puts 'constexpr EmbeddedSchemaEntry kEmbeddedSchemas[] = {'
+schemaFiles.each_with_index do |file, index|
+  puts "  {#{cString(file)}, {kElements#{index}, kAttributes#{index}}},"
+end
+puts '};'
+puts '}'
 
-}
-}
-!
+puts <<~'CPP'
+
+  const EmbeddedSchemaFile *GetEmbeddedSchema(const std::string &_pathname)
+  {
+    // The entries are sorted by pathname.
+    const auto *begin = std::begin(kEmbeddedSchemas);
+    const auto *end = std::end(kEmbeddedSchemas);
+    const auto *it = std::lower_bound(begin, end, _pathname,
+        [](const EmbeddedSchemaEntry &_entry, const std::string &_name)
+        {
+          return _name.compare(_entry.pathname) > 0;
+        });
+    if (it == end || _pathname != it->pathname)
+      return nullptr;
+    return &it->file;
+  }
+
+  }
+  }
+CPP
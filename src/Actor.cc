@@ -14,13 +14,21 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 #include <ignition/math/Pose3.hh>
+#include <ignition/math/Quaternion.hh>
+#include <ignition/math/Vector3.hh>
 #include "sdf/Actor.hh"
 #include "sdf/Error.hh"
 #include "sdf/parser.hh"
 #include "sdf/Plugin.hh"
+#include "ScopedTraceEvent.hh"
 #include "Utils.hh"
 
 using namespace sdf;
@@ -68,8 +76,239 @@ class sdf::Trajectory::Implementation
 
     /// \brief Each points in the trajectory.
     public: std::vector<Waypoint> waypoints;
+
+    /// \brief Insert a waypoint in the arrays sorted by time.
+    /// \param[in] _waypoint The waypoint.
+    public: void InsertSorted(const Waypoint &_waypoint);
+
+    /// \brief Compute the tangent of the position spline at a waypoint.
+    /// \param[in] _index Index of the waypoint in the sorted arrays.
+    public: void UpdateTangent(std::size_t _index);
+
+    /// \brief Find the waypoint that starts the segment containing a time.
+    /// \param[in] _time The time.
+    /// \param[in] _hint Index of the waypoint found for an earlier time.
+    /// \return The index i of the last waypoint with times[i] <= _time, or 0
+    /// if _time is before the first waypoint.
+    public: std::size_t Segment(double _time, std::size_t _hint) const;
+
+    /// \brief Times of the waypoints, sorted.
+    public: std::vector<double> times;
+
+    /// \brief Poses of the waypoints, in the order of times.
+    public: std::vector<ignition::math::Pose3d> poses;
+
+    /// \brief Tangents of the position spline at each waypoint, in the
+    /// order of times.
+    public: std::vector<ignition::math::Vector3d> tangents;
 };
 
+/////////////////////////////////////////////////
+void Trajectory::Implementation::InsertSorted(const Waypoint &_waypoint)
+{
+  // Waypoints are usually given in time order, so they are appended
+  const auto it = std::upper_bound(this->times.begin(), this->times.end(),
+                                   _waypoint.Time());
+  const auto index = static_cast<std::size_t>(it - this->times.begin());
+  this->times.insert(it, _waypoint.Time());
+  this->poses.insert(this->poses.begin() + index, _waypoint.Pose());
+  this->tangents.insert(this->tangents.begin() + index,
+                        ignition::math::Vector3d::Zero);
+
+  // Only the tangents of the waypoint and its neighbors change
+  for (std::size_t i = index > 0 ? index - 1 : 0;
+       i <= index + 1 && i < this->times.size(); ++i)
+  {
+    this->UpdateTangent(i);
+  }
+}
+
+/////////////////////////////////////////////////
+void Trajectory::Implementation::UpdateTangent(std::size_t _index)
+{
+  // Catmull-Rom tangents, where a missing neighbor of the first or last
+  // waypoint is the waypoint itself, scaled by the tension
+  const std::size_t prev = _index > 0 ? _index - 1 : _index;
+  const std::size_t next =
+      _index + 1 < this->poses.size() ? _index + 1 : _index;
+  this->tangents[_index] = (this->poses[next].Pos() -
+      this->poses[prev].Pos()) * (0.5 * (1.0 - this->tension));
+}
+
+/////////////////////////////////////////////////
+std::size_t Trajectory::Implementation::Segment(double _time,
+    std::size_t _hint) const
+{
+  // Move forward from the hint for increasing times, which usually stay in
+  // the same segment or move to the next one
+  if (_hint < this->times.size() && this->times[_hint] <= _time)
+  {
+    while (_hint + 1 < this->times.size() && this->times[_hint + 1] <= _time)
+      ++_hint;
+    return _hint;
+  }
+
+  const auto it = std::upper_bound(this->times.begin(), this->times.end(),
+                                   _time);
+  if (it == this->times.begin())
+    return 0;
+  return static_cast<std::size_t>(it - this->times.begin()) - 1;
+}
+
+namespace
+{
+/// \brief Trajectory segments gathered by SampleTrajectories. Each
+/// component of the segments is stored contiguously, so that all the
+/// segments are interpolated together in loops without branches or
+/// indirections.
+struct SegmentBatch
+{
+  /// \brief Reserve memory for segments.
+  /// \param[in] _count Number of segments.
+  void Reserve(std::size_t _count)
+  {
+    this->outputs.reserve(_count);
+    this->s.reserve(_count);
+    for (std::size_t a = 0; a < 3; ++a)
+    {
+      this->p0[a].reserve(_count);
+      this->m0[a].reserve(_count);
+      this->p1[a].reserve(_count);
+      this->m1[a].reserve(_count);
+    }
+    for (std::size_t a = 0; a < 4; ++a)
+    {
+      this->q0[a].reserve(_count);
+      this->q1[a].reserve(_count);
+    }
+  }
+
+  /// \brief Add a segment.
+  /// \param[in] _output Index of the pose to write.
+  /// \param[in] _s Interpolation parameter in [0, 1].
+  /// \param[in] _start Pose at the start of the segment.
+  /// \param[in] _startTangent Position tangent at the start.
+  /// \param[in] _end Pose at the end of the segment.
+  /// \param[in] _endTangent Position tangent at the end.
+  void Add(std::size_t _output, double _s,
+           const ignition::math::Pose3d &_start,
+           const ignition::math::Vector3d &_startTangent,
+           const ignition::math::Pose3d &_end,
+           const ignition::math::Vector3d &_endTangent)
+  {
+    this->outputs.push_back(_output);
+    this->s.push_back(_s);
+    for (std::size_t a = 0; a < 3; ++a)
+    {
+      this->p0[a].push_back(_start.Pos()[a]);
+      this->m0[a].push_back(_startTangent[a]);
+      this->p1[a].push_back(_end.Pos()[a]);
+      this->m1[a].push_back(_endTangent[a]);
+    }
+    const auto &r0 = _start.Rot();
+    const auto &r1 = _end.Rot();
+    const std::array<double, 4> c0 = {r0.W(), r0.X(), r0.Y(), r0.Z()};
+    const std::array<double, 4> c1 = {r1.W(), r1.X(), r1.Y(), r1.Z()};
+    for (std::size_t a = 0; a < 4; ++a)
+    {
+      this->q0[a].push_back(c0[a]);
+      this->q1[a].push_back(c1[a]);
+    }
+  }
+
+  /// \brief Interpolate the segments, as Trajectory::Sample does, and
+  /// write the poses.
+  /// \param[out] _poses Poses indexed by the outputs of the segments.
+  void Interpolate(std::vector<ignition::math::Pose3d> &_poses) const
+  {
+    const std::size_t count = this->s.size();
+
+    // Cubic Hermite spline of the positions
+    std::array<std::vector<double>, 3> pos;
+    for (std::size_t a = 0; a < 3; ++a)
+    {
+      pos[a].resize(count);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        const double t = this->s[i];
+        const double t2 = t * t;
+        const double t3 = t2 * t;
+        pos[a][i] = this->p0[a][i] * (2 * t3 - 3 * t2 + 1) +
+            this->m0[a][i] * (t3 - 2 * t2 + t) +
+            this->p1[a][i] * (-2 * t3 + 3 * t2) +
+            this->m1[a][i] * (t3 - t2);
+      }
+    }
+
+    // Spherical linear interpolation of the orientations along the
+    // shortest path, with the same tolerance as Quaterniond::Slerp for a
+    // linear interpolation of close orientations
+    std::vector<double> k0(count);
+    std::vector<double> k1(count);
+    std::vector<double> linear(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const double dot = this->q0[0][i] * this->q1[0][i] +
+          this->q0[1][i] * this->q1[1][i] +
+          this->q0[2][i] * this->q1[2][i] +
+          this->q0[3][i] * this->q1[3][i];
+      const double sign = dot < 0 ? -1.0 : 1.0;
+      const double cosAngle = dot * sign;
+      const double t = this->s[i];
+      linear[i] = std::abs(cosAngle) < 1 - 1e-03 ? 0.0 : 1.0;
+      const double sinAngle =
+          std::sqrt(std::max(0.0, 1 - cosAngle * cosAngle));
+      const double angle = std::atan2(sinAngle, cosAngle);
+      const double invSin = linear[i] > 0 ? 0.0 : 1.0 / sinAngle;
+      k0[i] = linear[i] > 0 ? 1 - t : std::sin((1 - t) * angle) * invSin;
+      k1[i] = sign * (linear[i] > 0 ? t : std::sin(t * angle) * invSin);
+    }
+
+    std::array<std::vector<double>, 4> rot;
+    for (std::size_t a = 0; a < 4; ++a)
+    {
+      rot[a].resize(count);
+      for (std::size_t i = 0; i < count; ++i)
+        rot[a][i] = this->q0[a][i] * k0[i] + this->q1[a][i] * k1[i];
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      ignition::math::Quaterniond q(rot[0][i], rot[1][i], rot[2][i],
+                                    rot[3][i]);
+      if (linear[i] > 0)
+        q.Normalize();
+      _poses[this->outputs[i]] = ignition::math::Pose3d(
+          ignition::math::Vector3d(pos[0][i], pos[1][i], pos[2][i]), q);
+    }
+  }
+
+  /// \brief Index of the pose to write for each segment.
+  std::vector<std::size_t> outputs;
+
+  /// \brief Interpolation parameter of each segment.
+  std::vector<double> s;
+
+  /// \brief Start positions, by axis.
+  std::array<std::vector<double>, 3> p0;
+
+  /// \brief Position tangents at the start, by axis.
+  std::array<std::vector<double>, 3> m0;
+
+  /// \brief End positions, by axis.
+  std::array<std::vector<double>, 3> p1;
+
+  /// \brief Position tangents at the end, by axis.
+  std::array<std::vector<double>, 3> m1;
+
+  /// \brief Start orientations, by w, x, y and z component.
+  std::array<std::vector<double>, 4> q0;
+
+  /// \brief End orientations, by w, x, y and z component.
+  std::array<std::vector<double>, 4> q1;
+};
+}
+
 /// \brief Actor private data.
 class sdf::Actor::Implementation
 {
@@ -307,6 +546,12 @@ Errors Trajectory::Load(ElementPtr _sdf)
   errors.insert(errors.end(), waypointLoadErrors.begin(),
                     waypointLoadErrors.end());
 
+  this->dataPtr->times.clear();
+  this->dataPtr->poses.clear();
+  this->dataPtr->tangents.clear();
+  for (const Waypoint &waypoint : this->dataPtr->waypoints)
+    this->dataPtr->InsertSorted(waypoint);
+
   return errors;
 }
 
@@ -344,6 +589,8 @@ double Trajectory::Tension() const
 void Trajectory::SetTension(double _tension)
 {
   this->dataPtr->tension = _tension;
+  for (std::size_t i = 0; i < this->dataPtr->times.size(); ++i)
+    this->dataPtr->UpdateTangent(i);
 }
 
 /////////////////////////////////////////////////
@@ -364,6 +611,60 @@ const Waypoint *Trajectory::WaypointByIndex(uint64_t _index) const
 void Trajectory::AddWaypoint(const Waypoint &_waypoint)
 {
   this->dataPtr->waypoints.push_back(_waypoint);
+  this->dataPtr->InsertSorted(_waypoint);
+}
+
+/////////////////////////////////////////////////
+const std::vector<double> &Trajectory::WaypointTimes() const
+{
+  return this->dataPtr->times;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Pose3d> &Trajectory::WaypointPoses() const
+{
+  return this->dataPtr->poses;
+}
+
+/////////////////////////////////////////////////
+ignition::math::Pose3d Trajectory::Sample(double _time) const
+{
+  uint64_t cursor = this->dataPtr->times.size();
+  return this->Sample(_time, cursor);
+}
+
+/////////////////////////////////////////////////
+ignition::math::Pose3d Trajectory::Sample(double _time,
+    uint64_t &_cursor) const
+{
+  const auto &times = this->dataPtr->times;
+  const auto &poses = this->dataPtr->poses;
+  if (times.empty())
+    return ignition::math::Pose3d::Zero;
+
+  const std::size_t i =
+      this->dataPtr->Segment(_time, static_cast<std::size_t>(_cursor));
+  _cursor = i;
+  if (_time <= times[i] || i + 1 == times.size())
+    return poses[i];
+
+  const double duration = times[i + 1] - times[i];
+  const double s = (_time - times[i]) / duration;
+  const double s2 = s * s;
+  const double s3 = s2 * s;
+
+  // Cubic Hermite basis functions
+  const double h00 = 2 * s3 - 3 * s2 + 1;
+  const double h10 = s3 - 2 * s2 + s;
+  const double h01 = -2 * s3 + 3 * s2;
+  const double h11 = s3 - s2;
+
+  const auto &tangents = this->dataPtr->tangents;
+  return ignition::math::Pose3d(
+      poses[i].Pos() * h00 + tangents[i] * h10 +
+      poses[i + 1].Pos() * h01 + tangents[i + 1] * h11,
+      ignition::math::Quaterniond::Slerp(
+          s, poses[i].Rot(), poses[i + 1].Rot(), true));
 }
 
 /////////////////////////////////////////////////
@@ -375,9 +676,10 @@ Actor::Actor()
 /////////////////////////////////////////////////
 Errors Actor::Load(ElementPtr _sdf)
 {
+  ScopedTraceEvent event("Actor::Load", "dom");
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
   this->dataPtr->filePath = _sdf->FilePath();
 
   if (_sdf->GetName() != "actor")
@@ -701,6 +1003,15 @@ bool Actor::AddLink(const Link &_link)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Actor::AddLink(Link &&_link)
+{
+  if (this->LinkNameExists(_link.Name()))
+    return false;
+  this->dataPtr->links.push_back(std::move(_link));
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool Actor::AddJoint(const Joint &_joint)
 {
@@ -710,6 +1021,15 @@ bool Actor::AddJoint(const Joint &_joint)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Actor::AddJoint(Joint &&_joint)
+{
+  if (this->JointNameExists(_joint.Name()))
+    return false;
+  this->dataPtr->joints.push_back(std::move(_joint));
+  return true;
+}
+
 //////////////////////////////////////////////////
 void Actor::ClearLinks()
 {
@@ -819,3 +1139,75 @@ void Actor::AddPlugin(const Plugin &_plugin)
 {
   this->dataPtr->plugins.push_back(_plugin);
 }
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+
+/////////////////////////////////////////////////
+void SampleTrajectories(
+    const std::vector<const Trajectory *> &_trajectories, double _time,
+    std::vector<ignition::math::Pose3d> &_poses)
+{
+  // No cursor is valid, so each search starts from the segment found for
+  // the previous trajectory
+  std::vector<uint64_t> cursors(_trajectories.size(),
+                                std::numeric_limits<uint64_t>::max());
+  SampleTrajectories(_trajectories, _time, _poses, cursors);
+}
+
+/////////////////////////////////////////////////
+void SampleTrajectories(
+    const std::vector<const Trajectory *> &_trajectories, double _time,
+    std::vector<ignition::math::Pose3d> &_poses,
+    std::vector<uint64_t> &_cursors)
+{
+  _poses.assign(_trajectories.size(), ignition::math::Pose3d::Zero);
+  _cursors.resize(_trajectories.size(), 0);
+
+  SegmentBatch batch;
+  batch.Reserve(_trajectories.size());
+
+  const Trajectory::Implementation *previous = nullptr;
+  std::size_t previousSegment = 0;
+  for (std::size_t k = 0; k < _trajectories.size(); ++k)
+  {
+    if (!_trajectories[k] || _trajectories[k]->dataPtr->times.empty())
+      continue;
+    const Trajectory::Implementation *traj = &*_trajectories[k]->dataPtr;
+    const auto &times = traj->times;
+
+    // Repeated trajectories share their segment, and trajectories with as
+    // many waypoints often have their segment at the same index, which
+    // makes it a good start for the search when there is no cursor
+    std::size_t i = previousSegment;
+    if (traj != previous)
+    {
+      std::size_t hint = static_cast<std::size_t>(_cursors[k]);
+      if (hint >= times.size() && previous &&
+          previous->times.size() == times.size())
+      {
+        hint = previousSegment;
+      }
+      i = traj->Segment(_time, hint);
+    }
+    _cursors[k] = i;
+    previous = traj;
+    previousSegment = i;
+
+    if (_time <= times[i] || i + 1 == times.size())
+    {
+      _poses[k] = traj->poses[i];
+      continue;
+    }
+
+    batch.Add(k, (_time - times[i]) / (times[i + 1] - times[i]),
+              traj->poses[i], traj->tangents[i],
+              traj->poses[i + 1], traj->tangents[i + 1]);
+  }
+
+  batch.Interpolate(_poses);
+}
+}
+}
@@ -16,6 +16,8 @@
 */
 
 #include <gtest/gtest.h>
+#include <utility>
+#include <vector>
 #include <ignition/math/Pose3.hh>
 #include "sdf/Actor.hh"
 #include "sdf/Plugin.hh"
@@ -633,3 +635,104 @@ TEST(DOMActor, Plugins)
   actor.ClearPlugins();
   EXPECT_TRUE(actor.Plugins().empty());
 }
+
+/////////////////////////////////////////////////
+TEST(DOMActor, TrajectorySample)
+{
+  sdf::Trajectory trajectory;
+  EXPECT_EQ(ignition::math::Pose3d::Zero, trajectory.Sample(1.0));
+
+  // Waypoints are sorted by time in the arrays
+  for (const auto &[time, x] : {std::make_pair(0.0, 0.0),
+       std::make_pair(2.0, 2.0), std::make_pair(1.0, 1.0),
+       std::make_pair(3.0, 3.0)})
+  {
+    sdf::Waypoint waypoint;
+    waypoint.SetTime(time);
+    waypoint.SetPose({x, 0, 0, 0, 0, time * 0.5});
+    trajectory.AddWaypoint(waypoint);
+  }
+  EXPECT_EQ(std::vector<double>({0, 1, 2, 3}), trajectory.WaypointTimes());
+  ASSERT_EQ(4u, trajectory.WaypointPoses().size());
+  EXPECT_DOUBLE_EQ(2.0, trajectory.WaypointPoses()[2].Pos().X());
+  EXPECT_DOUBLE_EQ(2.0, trajectory.WaypointByIndex(1)->Time());
+
+  // The waypoints are reached, and the ends are held
+  EXPECT_EQ(trajectory.WaypointPoses()[1], trajectory.Sample(1.0));
+  EXPECT_EQ(trajectory.WaypointPoses()[0], trajectory.Sample(-1.0));
+  EXPECT_EQ(trajectory.WaypointPoses()[3], trajectory.Sample(5.0));
+
+  // Evenly spaced waypoints on a line give a linear interpolation between
+  // the inner waypoints, and the orientation is interpolated
+  ignition::math::Pose3d pose = trajectory.Sample(1.5);
+  EXPECT_NEAR(1.5, pose.Pos().X(), 1e-9);
+  EXPECT_NEAR(0.75, pose.Rot().Yaw(), 1e-9);
+
+  // With a tension of 1, the spline stops at each waypoint
+  trajectory.SetTension(1.0);
+  pose = trajectory.Sample(1.25);
+  EXPECT_NEAR(1.0 + (3 * 0.0625 - 2 * 0.015625), pose.Pos().X(), 1e-9);
+
+  // Sampling at increasing times with a cursor matches the binary search
+  uint64_t cursor = 0;
+  for (double time = -0.5; time < 3.5; time += 0.1)
+  {
+    EXPECT_EQ(trajectory.Sample(time), trajectory.Sample(time, cursor))
+        << time;
+  }
+  EXPECT_EQ(3u, cursor);
+
+  // Going back in time with a cursor still finds the right segment
+  EXPECT_EQ(trajectory.Sample(0.5), trajectory.Sample(0.5, cursor));
+  EXPECT_EQ(0u, cursor);
+}
+
+/////////////////////////////////////////////////
+TEST(DOMActor, SampleTrajectories)
+{
+  sdf::Trajectory walk;
+  sdf::Trajectory turn;
+  walk.SetTension(0.5);
+  for (int i = 0; i < 4; ++i)
+  {
+    sdf::Waypoint waypoint;
+    waypoint.SetTime(i);
+    waypoint.SetPose({i * 1.0, i * i * 0.5, 0, 0, 0, i * 0.3});
+    walk.AddWaypoint(waypoint);
+    waypoint.SetPose({0, 0, i * 0.1, i * 1.2, 0, -i * 1.0});
+    turn.AddWaypoint(waypoint);
+  }
+  sdf::Trajectory empty;
+
+  const std::vector<const sdf::Trajectory *> trajectories =
+      {&walk, &turn, &walk, nullptr, &empty, &turn};
+  std::vector<ignition::math::Pose3d> poses;
+  std::vector<uint64_t> cursors;
+  for (double time = -0.5; time < 3.5; time += 0.1)
+  {
+    // The batch matches the samples of each trajectory
+    sdf::SampleTrajectories(trajectories, time, poses, cursors);
+    ASSERT_EQ(trajectories.size(), poses.size());
+    ASSERT_EQ(trajectories.size(), cursors.size());
+    for (std::size_t k = 0; k < trajectories.size(); ++k)
+    {
+      const auto expected = trajectories[k] ?
+          trajectories[k]->Sample(time) : ignition::math::Pose3d::Zero;
+      EXPECT_TRUE(expected.Pos().Equal(poses[k].Pos(), 1e-9))
+          << time << " " << k;
+      EXPECT_TRUE(expected.Rot().Equal(poses[k].Rot(), 1e-9))
+          << time << " " << k;
+    }
+
+    std::vector<ignition::math::Pose3d> posesWithoutCursors;
+    sdf::SampleTrajectories(trajectories, time, posesWithoutCursors);
+    EXPECT_EQ(poses, posesWithoutCursors);
+  }
+  EXPECT_EQ(3u, cursors[0]);
+  EXPECT_EQ(0u, cursors[4]);
+
+  // Going back in time with the cursors still finds the right segments
+  sdf::SampleTrajectories(trajectories, 1.5, poses, cursors);
+  EXPECT_EQ(1u, cursors[1]);
+  EXPECT_TRUE(turn.Sample(1.5).Rot().Equal(poses[5].Rot(), 1e-9));
+}
@@ -18,6 +18,7 @@
 #include <string>
 #include "sdf/AirPressure.hh"
 #include "sdf/parser.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
@@ -45,7 +46,7 @@ Errors AirPressure::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <airPressure> element.
   // This is an error that cannot be recovered, so return an error.
@@ -0,0 +1,1028 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <ignition/math/Angle.hh>
+#include <ignition/math/Color.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Quaternion.hh>
+#include <ignition/math/Vector2.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "sdf/Element.hh"
+#include "sdf/Exception.hh"
+#include "sdf/Param.hh"
+#include "sdf/Types.hh"
+#include "sdf/parser.hh"
+
+#include "BinarySdf.hh"
+#include "ParamValueChecks.hh"
+#include "Utils.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+namespace
+{
+/// \brief First bytes of a binary document. The first byte is not valid in
+/// XML or USD files.
+constexpr char kMagic[] = {'\0', 'S', 'D', 'F', 'B', 'I', 'N', '\n'};
+
+/// \brief Version of the layout of binary documents. Increment it when the
+/// layout changes.
+constexpr std::uint64_t kFormatVersion = 1;
+
+/// \brief Maximum nesting depth of the elements of a binary document.
+/// Deeper documents are rejected, so that a corrupt or crafted document
+/// cannot overflow the stack of the recursive reader.
+constexpr std::size_t kMaxElementDepth = 500;
+
+/// \brief Flags stored for each element.
+enum ElementFlags : std::uint8_t
+{
+  /// \brief Element::GetExplicitlySetInFile() is true.
+  EXPLICITLY_SET = 1 << 0,
+
+  /// \brief The element has a value.
+  HAS_VALUE = 1 << 1,
+
+  /// \brief The element has raw XML.
+  HAS_RAW_XML = 1 << 2,
+
+  /// \brief The element has a line number.
+  HAS_LINE_NUMBER = 1 << 3,
+
+  /// \brief The XML path of the element is stored, instead of being built
+  /// from the path of its parent.
+  HAS_XML_PATH = 1 << 4,
+
+  /// \brief The element has an include element.
+  HAS_INCLUDE = 1 << 5
+};
+
+/// \brief Flags stored for each parameter.
+enum ParamFlags : std::uint8_t
+{
+  /// \brief The value of the parameter was set.
+  SET = 1 << 0,
+
+  /// \brief The value ignores the attributes of its element.
+  IGNORES_PARENT_ATTRIBUTES = 1 << 1,
+
+  /// \brief The parameter is required. Only stored for parameters that are
+  /// not in the specification.
+  REQUIRED = 1 << 2,
+
+  /// \brief The value is stored as the string it was read from, and not in
+  /// the binary form of its type.
+  AS_STRING = 1 << 3
+};
+
+/////////////////////////////////////////////////
+/// \brief Add an element description and its descendants to a hash. The
+/// descriptions that an element refers to are only hashed by name, since
+/// they are hashed where they are described.
+/// \param[in,out] _hash The hash.
+/// \param[in] _desc The description.
+void hashDescription(std::uint64_t &_hash, const ElementConstPtr &_desc)
+{
+  hashString(_hash, _desc->GetName());
+  hashString(_hash, _desc->ReferenceSDF());
+  hashString(_hash, _desc->GetCopyChildren() ? "1" : "0");
+  for (const auto &attribute : _desc->GetAttributes())
+  {
+    hashString(_hash, attribute->GetKey());
+    hashString(_hash, attribute->GetTypeName());
+  }
+  if (_desc->GetValue())
+    hashString(_hash, _desc->GetValue()->GetTypeName());
+  for (std::size_t i = 0; i < _desc->GetElementDescriptionCount(); ++i)
+  {
+    hashDescription(_hash,
+        _desc->GetElementDescription(static_cast<unsigned int>(i)));
+  }
+  hashString(_hash, "");
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the fingerprint of the element descriptions of the
+/// specification. The descriptions are built in the library, so the
+/// fingerprint is computed once.
+/// \param[in] _root An <sdf> element initialized with sdf::init.
+/// \return The fingerprint.
+std::uint64_t schemaFingerprint(const ElementPtr &_root)
+{
+  static const std::uint64_t kFingerprint = [&_root]()
+  {
+    std::uint64_t hash = kFnvOffsetBasis;
+    hashString(hash, SDF::Version());
+    hashDescription(hash, _root);
+    return hash;
+  }();
+  return kFingerprint;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the index of the description of a child element.
+/// \param[in] _parent The parent element.
+/// \param[in] _name Name of the child element.
+/// \return The index, or the number of descriptions if there is no
+/// description with that name.
+std::size_t descriptionIndex(const ElementPtr &_parent,
+    const std::string &_name)
+{
+  const std::size_t count = _parent->GetElementDescriptionCount();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (_parent->GetElementDescription(static_cast<unsigned int>(i))
+        ->GetName() == _name)
+    {
+      return i;
+    }
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a child element from its description, the same way the
+/// parser creates it.
+/// \param[in] _desc The description.
+/// \param[in] _config Parser configuration.
+/// \return The new element.
+ElementPtr elementFromDescription(const ElementConstPtr &_desc,
+    const ParserConfig &_config)
+{
+  ElementPtr elem = _desc->Clone();
+  const std::string refSDFStr = elem->ReferenceSDF();
+  if (!refSDFStr.empty())
+  {
+    ElementPtr refSDF(new Element);
+    initFile(refSDFStr + ".sdf", _config, refSDF);
+    elem->Copy(refSDF);
+  }
+  return elem;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the index of an attribute.
+/// \param[in] _elem The element.
+/// \param[in] _param The attribute.
+/// \return Index of the attribute of _elem with the key and type of
+/// _param, or the number of attributes if there is none.
+std::size_t attributeIndex(const ElementPtr &_elem, const ParamPtr &_param)
+{
+  const Param_V &attributes = _elem->GetAttributes();
+  for (std::size_t i = 0; i < attributes.size(); ++i)
+  {
+    if (attributes[i]->GetKey() == _param->GetKey())
+    {
+      return attributes[i]->GetTypeName() == _param->GetTypeName() ?
+          i : attributes.size();
+    }
+  }
+  return attributes.size();
+}
+}
+
+/////////////////////////////////////////////////
+bool BinarySdfWriter::WriteParam(const ParamPtr &_param, bool _described,
+    Errors &_errors)
+{
+  // Values that keep their source are parsed again by the reader, so lazy
+  // values are not parsed here.
+  if (!this->keepSource && !_param->ParseLazyValue())
+  {
+    _errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Unable to encode the value of [" + _param->GetKey() + "]."});
+    return false;
+  }
+
+  std::uint8_t flags = 0;
+  if (_param->GetSet())
+    flags |= SET;
+  if (_param->GetParentElement() && _param->IgnoresParentElementAttribute())
+    flags |= IGNORES_PARENT_ATTRIBUTES;
+  if (_param->GetRequired())
+    flags |= REQUIRED;
+  if (this->keepSource)
+    flags |= AS_STRING;
+
+  if (!_described)
+  {
+    this->String(_param->GetTypeName());
+    this->String(_param->GetDefaultAsString());
+  }
+  this->U8(flags);
+
+  if (!_param->GetSet())
+    return true;
+
+  // The original string is kept when there is one, since converting some
+  // values back to strings loses precision.
+  if (this->keepSource)
+  {
+    this->String(_param->GetOriginalString().value_or(_param->GetAsString()));
+    return true;
+  }
+
+  if (!BinarySdf::WriteValue(*this, *_param))
+  {
+    _errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Unable to encode the value of [" + _param->GetKey() + "] of "
+        "type [" + _param->GetTypeName() + "]."});
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BinarySdfWriter::WriteElement(const ElementPtr &_elem,
+    const ElementPtr &_desc, Errors &_errors)
+{
+  const bool describedValue = _desc && _desc->GetValue() &&
+      _elem->GetValue() &&
+      _desc->GetValue()->GetTypeName() == _elem->GetValue()->GetTypeName();
+  const auto lineNumber =
+      this->keepSource ? _elem->LineNumber() : std::nullopt;
+  const bool hasInclude = this->keepSource && _elem->GetIncludeElement();
+
+  std::uint8_t flags = 0;
+  if (_elem->GetExplicitlySetInFile())
+    flags |= EXPLICITLY_SET;
+  if (_elem->GetValue())
+    flags |= HAS_VALUE;
+  if (!_elem->RawXml().empty())
+    flags |= HAS_RAW_XML;
+  if (lineNumber.has_value())
+    flags |= HAS_LINE_NUMBER;
+  if (this->keepSource)
+    flags |= HAS_XML_PATH;
+  if (hasInclude)
+    flags |= HAS_INCLUDE;
+  this->U8(flags);
+
+  // Elements read from the file of the document are stored without a
+  // path, and get the path that the binary document is read from.
+  static const std::string kEmptyPath;
+  const std::string &path = _elem->FilePath() == this->rootPath ?
+      kEmptyPath : _elem->FilePath();
+  const auto source = this->sources.emplace(
+      std::make_pair(path, _elem->OriginalVersion()),
+      this->sources.size()).first;
+  this->U64(source->second);
+
+  if (lineNumber.has_value())
+    this->U64(static_cast<std::uint64_t>(lineNumber.value()));
+  if (this->keepSource)
+    this->String(_elem->XmlPath());
+
+  // Attributes that were not set keep the defaults of their description.
+  // An attribute of the description is tagged with its index plus one,
+  // and other attributes with zero followed by their key.
+  std::size_t setCount = 0;
+  for (const auto &attribute : _elem->GetAttributes())
+  {
+    if (attribute->GetSet())
+      ++setCount;
+  }
+  this->U64(setCount);
+  for (const auto &attribute : _elem->GetAttributes())
+  {
+    if (!attribute->GetSet())
+      continue;
+    const std::size_t index = _desc ?
+        attributeIndex(_desc, attribute) : 0u;
+    const bool described = _desc && index < _desc->GetAttributeCount();
+    this->U64(described ? index + 1 : 0u);
+    if (!described)
+      this->String(attribute->GetKey());
+    if (!this->WriteParam(attribute, described, _errors))
+      return false;
+  }
+
+  if (_elem->GetValue())
+  {
+    this->U8(describedValue ? 1u : 0u);
+    if (!this->WriteParam(_elem->GetValue(), describedValue, _errors))
+      return false;
+  }
+
+  if (!_elem->RawXml().empty())
+    this->String(_elem->RawXml());
+
+  std::size_t childCount = 0;
+  for (ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    ++childCount;
+  }
+  this->U64(childCount);
+  for (ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    if (!this->WriteTagged(_elem, child, _errors))
+      return false;
+  }
+
+  // The <include> element that an element was included with is described
+  // by the parent of the element, and is not one of its children.
+  if (hasInclude &&
+      !this->WriteTagged(_elem->GetParent(), _elem->GetIncludeElement(),
+                         _errors))
+  {
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void BinarySdfWriter::WriteSources(const BinarySdfWriter &_elements)
+{
+  std::vector<const std::pair<std::string, std::string> *> sourceList(
+      _elements.sources.size());
+  for (const auto &source : _elements.sources)
+    sourceList[source.second] = &source.first;
+
+  this->U64(sourceList.size());
+  for (const auto *source : sourceList)
+  {
+    this->String(source->first);
+    this->String(source->second);
+  }
+}
+
+/////////////////////////////////////////////////
+bool BinarySdfWriter::WriteTagged(const ElementPtr &_parent,
+    const ElementPtr &_elem, Errors &_errors)
+{
+  // An element of the description is tagged with the index of its
+  // description plus one, and other elements with zero followed by their
+  // name.
+  const std::size_t count =
+      _parent ? _parent->GetElementDescriptionCount() : 0u;
+  const std::size_t index =
+      _parent ? descriptionIndex(_parent, _elem->GetName()) : count;
+  ElementPtr desc;
+  if (index < count)
+  {
+    this->U64(index + 1);
+    desc = this->Description(
+        _parent->GetElementDescription(static_cast<unsigned int>(index)));
+  }
+  else
+  {
+    this->U64(0u);
+    this->String(_elem->GetName());
+  }
+  return this->WriteElement(_elem, desc, _errors);
+}
+
+/////////////////////////////////////////////////
+ElementPtr BinarySdfWriter::Description(const ElementConstPtr &_desc)
+{
+  auto it = this->descriptions.find(_desc.get());
+  if (it == this->descriptions.end())
+  {
+    it = this->descriptions.emplace(_desc.get(),
+        elementFromDescription(_desc, this->config)).first;
+  }
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+bool BinarySdfReader::ReadParam(const ElementPtr &_elem, ParamPtr _param,
+    const std::string &_key)
+{
+  if (!_param)
+  {
+    std::string typeName;
+    std::string defaultValue;
+    if (!this->String(typeName) || !this->String(defaultValue) ||
+        this->end == this->pos)
+    {
+      return false;
+    }
+    const bool required = (*this->pos & REQUIRED) != 0;
+
+    // The type and the default come from the document, and the Param
+    // constructor throws if they are not valid.
+    try
+    {
+      if (!_key.empty())
+      {
+        _param = _elem->GetAttribute(_key);
+        if (!_param)
+        {
+          _elem->AddAttribute(_key, typeName, defaultValue, required);
+          _param = _elem->GetAttribute(_key);
+        }
+      }
+      else
+      {
+        if (!_elem->GetValue())
+          _elem->AddValue(typeName, defaultValue, required);
+        _param = _elem->GetValue();
+      }
+    }
+    catch (const sdf::AssertionInternalError &)
+    {
+      this->error = "Invalid type [" + typeName + "] or default value [" +
+          defaultValue + "] of " + (_key.empty() ?
+            "the value" : "attribute [" + _key + "]") + " of element [" +
+          _elem->GetName() + "]";
+      return false;
+    }
+    if (!_param)
+      return false;
+  }
+
+  std::uint8_t flags = 0;
+  if (!this->U8(flags))
+    return false;
+  if ((flags & SET) == 0)
+    return true;
+
+  if ((flags & AS_STRING) != 0)
+  {
+    std::string value;
+    if (!this->String(value))
+      return false;
+    if ((flags & IGNORES_PARENT_ATTRIBUTES) != 0)
+      return _param->SetFromString(value, true);
+    return this->config.LazyParamParsing() ?
+        _param->SetFromStringLazy(value) : _param->SetFromString(value);
+  }
+
+  return BinarySdf::ReadValue(*this, *_param,
+                              (flags & IGNORES_PARENT_ATTRIBUTES) != 0);
+}
+
+/////////////////////////////////////////////////
+bool BinarySdfReader::ReadElement(const ElementPtr &_elem, std::size_t _depth)
+{
+  if (_depth >= kMaxElementDepth)
+  {
+    this->error = "Elements are nested deeper than " +
+        std::to_string(kMaxElementDepth) + " levels";
+    return false;
+  }
+
+  std::uint8_t flags = 0;
+  std::uint64_t sourceIndex = 0;
+  if (!this->U8(flags) || !this->U64(sourceIndex) ||
+      sourceIndex >= this->sources.size())
+  {
+    return false;
+  }
+  _elem->SetFilePath(this->sources[sourceIndex].first);
+  _elem->SetOriginalVersion(this->sources[sourceIndex].second);
+  _elem->SetExplicitlySetInFile((flags & EXPLICITLY_SET) != 0);
+
+  if ((flags & HAS_LINE_NUMBER) != 0)
+  {
+    std::uint64_t lineNumber = 0;
+    if (!this->U64(lineNumber))
+      return false;
+    _elem->SetLineNumber(static_cast<int>(lineNumber));
+  }
+
+  std::string xmlPath;
+  if ((flags & HAS_XML_PATH) != 0 && !this->String(xmlPath))
+    return false;
+
+  std::uint64_t attributeCount = 0;
+  if (!this->U64(attributeCount))
+    return false;
+  for (std::uint64_t i = 0; i < attributeCount; ++i)
+  {
+    std::uint64_t tag = 0;
+    std::string key;
+    if (!this->U64(tag) || (tag == 0 && !this->String(key)) ||
+        tag > _elem->GetAttributeCount())
+    {
+      return false;
+    }
+    const ParamPtr attribute = tag > 0 ?
+        _elem->GetAttribute(static_cast<unsigned int>(tag - 1)) : nullptr;
+    if (!this->ReadParam(_elem, attribute, key))
+      return false;
+  }
+
+  // Paths that were not stored are built like the parser builds them, for
+  // the errors of the DOM.
+  if ((flags & HAS_XML_PATH) != 0)
+  {
+    _elem->SetXmlPath(xmlPath);
+  }
+  else if (const ElementPtr parent = _elem->GetParent())
+  {
+    xmlPath = parent->XmlPath() + "/" + _elem->GetName();
+    const ParamPtr name = _elem->GetAttribute("name");
+    if (name && name->GetSet())
+      xmlPath += "[@name=\"" + name->GetAsString() + "\"]";
+    _elem->SetXmlPath(xmlPath);
+  }
+
+  if ((flags & HAS_VALUE) != 0)
+  {
+    std::uint8_t described = 0;
+    if (!this->U8(described) || (described != 0 && !_elem->GetValue()) ||
+        !this->ReadParam(_elem,
+                         described != 0 ? _elem->GetValue() : nullptr, ""))
+    {
+      return false;
+    }
+  }
+
+  if ((flags & HAS_RAW_XML) != 0)
+  {
+    std::string rawXml;
+    if (!this->String(rawXml))
+      return false;
+    _elem->SetRawXml(rawXml);
+  }
+
+  std::uint64_t childCount = 0;
+  if (!this->U64(childCount))
+    return false;
+  for (std::uint64_t i = 0; i < childCount; ++i)
+  {
+    ElementPtr child;
+    if (!this->ReadTagged(_elem, true, _depth + 1, child))
+      return false;
+    _elem->InsertElement(child);
+  }
+
+  if ((flags & HAS_INCLUDE) != 0)
+  {
+    ElementPtr includeElem;
+    if (!this->ReadTagged(_elem->GetParent(), false, _depth + 1,
+                          includeElem))
+    {
+      return false;
+    }
+    _elem->SetIncludeElement(includeElem);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BinarySdfReader::ReadSources(const std::string &_rootPath)
+{
+  std::uint64_t sourceCount = 0;
+  if (!this->U64(sourceCount))
+    return false;
+  for (std::uint64_t i = 0; i < sourceCount; ++i)
+  {
+    std::pair<std::string, std::string> source;
+    if (!this->String(source.first) || !this->String(source.second))
+      return false;
+    if (source.first.empty())
+      source.first = _rootPath;
+    this->sources.push_back(std::move(source));
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BinarySdfReader::ReadTagged(const ElementPtr &_parent, bool _setParent,
+    std::size_t _depth, ElementPtr &_elem)
+{
+  const std::size_t count =
+      _parent ? _parent->GetElementDescriptionCount() : 0u;
+  std::uint64_t tag = 0;
+  if (!this->U64(tag) || tag > count)
+    return false;
+
+  if (tag > 0)
+  {
+    _elem = elementFromDescription(_parent->GetElementDescription(
+        static_cast<unsigned int>(tag - 1)), this->config);
+  }
+  else
+  {
+    std::string name;
+    if (!this->String(name))
+      return false;
+    _elem.reset(new sdf::Element);
+    _elem->SetName(name);
+  }
+  if (_setParent)
+    _elem->SetParent(_parent);
+  return this->ReadElement(_elem, _depth);
+}
+
+/////////////////////////////////////////////////
+bool BinarySdf::WriteValue(BinarySdfWriter &_out, const Param &_param)
+{
+  using ValueType = ParamPrivate::ValueType;
+  const ValueType type = _param.dataPtr->desc->valueType;
+  if (type == ValueType::UNKNOWN)
+  {
+    _out.String(_param.GetAsString());
+    return true;
+  }
+
+  // The value is written in the form that ReadValue reads for the type of
+  // the parameter, so it must hold that type.
+  return std::visit([&_out, type](const auto &_value)
+  {
+    using T = std::decay_t<decltype(_value)>;
+    if constexpr (std::is_same_v<T, bool>)
+    {
+      if (type != ValueType::BOOL)
+        return false;
+      _out.U8(_value ? 1u : 0u);
+    }
+    else if constexpr (std::is_same_v<T, char>)
+    {
+      if (type != ValueType::CHAR)
+        return false;
+      _out.Raw(_value);
+    }
+    else if constexpr (std::is_same_v<T, std::string>)
+    {
+      if (type != ValueType::STRING)
+        return false;
+      _out.String(_value);
+    }
+    else if constexpr (std::is_same_v<T, int>)
+    {
+      if (type != ValueType::INT)
+        return false;
+      _out.I64(_value);
+    }
+    else if constexpr (std::is_same_v<T, std::uint64_t>)
+    {
+      if (type != ValueType::UINT64)
+        return false;
+      _out.U64(_value);
+    }
+    else if constexpr (std::is_same_v<T, unsigned int>)
+    {
+      if (type != ValueType::UNSIGNED_INT)
+        return false;
+      _out.U64(_value);
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+      if (type != ValueType::DOUBLE)
+        return false;
+      _out.Raw(_value);
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+      if (type != ValueType::FLOAT)
+        return false;
+      _out.Raw(_value);
+    }
+    else if constexpr (std::is_same_v<T, sdf::Time>)
+    {
+      if (type != ValueType::TIME)
+        return false;
+      _out.I64(_value.sec);
+      _out.I64(_value.nsec);
+    }
+    else if constexpr (std::is_same_v<T, ignition::math::Angle>)
+    {
+      if (type != ValueType::ANGLE)
+        return false;
+      _out.Raw(_value.Radian());
+    }
+    else if constexpr (std::is_same_v<T, ignition::math::Color>)
+    {
+      if (type != ValueType::COLOR)
+        return false;
+      _out.Raw(_value.R());
+      _out.Raw(_value.G());
+      _out.Raw(_value.B());
+      _out.Raw(_value.A());
+    }
+    else if constexpr (std::is_same_v<T, ignition::math::Vector2i>)
+    {
+      if (type != ValueType::VECTOR2I)
+        return false;
+      _out.I64(_value.X());
+      _out.I64(_value.Y());
+    }
+    else if constexpr (std::is_same_v<T, ignition::math::Vector2d>)
+    {
+      if (type != ValueType::VECTOR2D)
+        return false;
+      _out.Raw(_value.X());
+      _out.Raw(_value.Y());
+    }
+    else if constexpr (std::is_same_v<T, ignition::math::Vector3d>)
+    {
+      if (type != ValueType::VECTOR3D)
+        return false;
+      _out.Raw(_value.X());
+      _out.Raw(_value.Y());
+      _out.Raw(_value.Z());
+    }
+    else if constexpr (std::is_same_v<T, ignition::math::Quaterniond>)
+    {
+      if (type != ValueType::QUATERNION)
+        return false;
+      _out.Raw(_value.W());
+      _out.Raw(_value.X());
+      _out.Raw(_value.Y());
+      _out.Raw(_value.Z());
+    }
+    else if constexpr (std::is_same_v<T, ignition::math::Pose3d>)
+    {
+      if (type != ValueType::POSE)
+        return false;
+      _out.Raw(_value.Pos().X());
+      _out.Raw(_value.Pos().Y());
+      _out.Raw(_value.Pos().Z());
+      _out.Raw(_value.Rot().W());
+      _out.Raw(_value.Rot().X());
+      _out.Raw(_value.Rot().Y());
+      _out.Raw(_value.Rot().Z());
+    }
+    return true;
+  }, _param.dataPtr->value);
+}
+
+/////////////////////////////////////////////////
+bool BinarySdf::ReadValue(BinarySdfReader &_in, Param &_param,
+    bool _ignoreParentAttributes)
+{
+  using ValueType = ParamPrivate::ValueType;
+  ParamPrivate::ParamVariant value;
+  bool read = false;
+  switch (_param.dataPtr->desc->valueType)
+  {
+    case ValueType::BOOL:
+    {
+      std::uint8_t v = 0;
+      read = _in.U8(v) && v <= 1u;
+      value = v != 0;
+      break;
+    }
+    case ValueType::CHAR:
+    {
+      char v = 0;
+      read = _in.Raw(v);
+      value = v;
+      break;
+    }
+    case ValueType::STRING:
+    {
+      std::string v;
+      read = _in.String(v);
+      value = std::move(v);
+      break;
+    }
+    case ValueType::INT:
+    {
+      std::int64_t v = 0;
+      read = _in.I64(v);
+      value = static_cast<int>(v);
+      break;
+    }
+    case ValueType::UINT64:
+    {
+      std::uint64_t v = 0;
+      read = _in.U64(v);
+      value = v;
+      break;
+    }
+    case ValueType::UNSIGNED_INT:
+    {
+      std::uint64_t v = 0;
+      read = _in.U64(v);
+      value = static_cast<unsigned int>(v);
+      break;
+    }
+    case ValueType::DOUBLE:
+    {
+      double v = 0;
+      read = _in.Raw(v);
+      value = v;
+      break;
+    }
+    case ValueType::FLOAT:
+    {
+      float v = 0;
+      read = _in.Raw(v);
+      value = v;
+      break;
+    }
+    case ValueType::TIME:
+    {
+      std::int64_t sec = 0;
+      std::int64_t nsec = 0;
+      read = _in.I64(sec) && _in.I64(nsec);
+      value = sdf::Time(static_cast<int32_t>(sec),
+                        static_cast<int32_t>(nsec));
+      break;
+    }
+    case ValueType::ANGLE:
+    {
+      double v = 0;
+      read = _in.Raw(v);
+      value = ignition::math::Angle(v);
+      break;
+    }
+    case ValueType::COLOR:
+    {
+      float v[4] = {};
+      read = _in.Raw(v[0]) && _in.Raw(v[1]) && _in.Raw(v[2]) && _in.Raw(v[3]);
+      value = ignition::math::Color(v[0], v[1], v[2], v[3]);
+      break;
+    }
+    case ValueType::VECTOR2I:
+    {
+      std::int64_t v[2] = {};
+      read = _in.I64(v[0]) && _in.I64(v[1]);
+      value = ignition::math::Vector2i(static_cast<int>(v[0]),
+                                       static_cast<int>(v[1]));
+      break;
+    }
+    case ValueType::VECTOR2D:
+    {
+      double v[2] = {};
+      read = _in.Raw(v[0]) && _in.Raw(v[1]);
+      value = ignition::math::Vector2d(v[0], v[1]);
+      break;
+    }
+    case ValueType::VECTOR3D:
+    {
+      double v[3] = {};
+      read = _in.Raw(v[0]) && _in.Raw(v[1]) && _in.Raw(v[2]);
+      value = ignition::math::Vector3d(v[0], v[1], v[2]);
+      break;
+    }
+    case ValueType::QUATERNION:
+    {
+      double v[4] = {};
+      read = _in.Raw(v[0]) && _in.Raw(v[1]) && _in.Raw(v[2]) && _in.Raw(v[3]);
+      value = ignition::math::Quaterniond(v[0], v[1], v[2], v[3]);
+      break;
+    }
+    case ValueType::POSE:
+    {
+      double v[7] = {};
+      read = true;
+      for (double &component : v)
+        read = read && _in.Raw(component);
+      value = ignition::math::Pose3d(v[0], v[1], v[2], v[3], v[4], v[5],
+                                     v[6]);
+      break;
+    }
+    case ValueType::UNKNOWN:
+    default:
+    {
+      std::string v;
+      return _in.String(v) && _param.SetFromString(v, _ignoreParentAttributes);
+    }
+  }
+  if (!read)
+    return false;
+
+  // The value is set as it is, and has no string to convert again when the
+  // attributes of the parent element change.
+  ParamPrivate &data = *_param.dataPtr;
+  const ParamPrivate::ParamVariant oldValue = std::move(data.value);
+  data.value = std::move(value);
+  data.strValue.reset();
+  data.lazyValuePending = false;
+  data.ignoreParentAttributes = _ignoreParentAttributes;
+  _param.InvalidateParentContentHash();
+  if (ScopedParamValueChecks::Enabled() && !_param.ValidateValue())
+  {
+    data.value = oldValue;
+    return false;
+  }
+  data.set = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BinarySdf::Encode(const ElementPtr &_sdf, const ParserConfig &_config,
+    std::string &_data, Errors &_errors)
+{
+  if (!_sdf || _sdf->GetName() != "sdf")
+  {
+    _errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Only <sdf> elements can be encoded as binary documents."});
+    return false;
+  }
+
+  BinarySdfWriter elements(_config);
+  elements.rootPath = _sdf->FilePath();
+  if (!elements.WriteElement(_sdf, nullptr, _errors))
+    return false;
+
+  BinarySdfWriter out(_config);
+  out.buffer.append(kMagic, sizeof(kMagic));
+  out.String(SDF::Version());
+  out.U64(kFormatVersion);
+  out.Raw(schemaFingerprint(_sdf));
+  out.WriteSources(elements);
+  out.buffer += elements.buffer;
+
+  _data = std::move(out.buffer);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BinarySdf::Decode(std::string_view _data, const std::string &_source,
+    const ParserConfig &_config, SDFPtr _sdf, Errors &_errors)
+{
+  const ErrorCode errorCode = _source == kSdfStringSource ?
+      ErrorCode::STRING_READ : ErrorCode::FILE_READ;
+  if (!_sdf || !_sdf->Root())
+  {
+    _errors.push_back({errorCode, "SDF pointer or its Root is null."});
+    return false;
+  }
+  const ElementPtr root = _sdf->Root();
+
+  BinarySdfReader in(_data, _config);
+  std::string version;
+  std::uint64_t formatVersion = 0;
+  std::uint64_t fingerprint = 0;
+  if (!in.Expect(kMagic, sizeof(kMagic)) || !in.String(version) ||
+      !in.U64(formatVersion) || !in.Raw(fingerprint))
+  {
+    _errors.push_back({errorCode,
+        "Unable to read the header of binary document.", _source});
+    return false;
+  }
+  if (version != SDF::Version() || formatVersion != kFormatVersion ||
+      fingerprint != schemaFingerprint(root))
+  {
+    _errors.push_back({errorCode,
+        "Binary document was encoded for SDFormat " + version +
+        " by another version of the library, and must be encoded again.",
+        _source});
+    return false;
+  }
+
+  const std::string filePath =
+      _source == kSdfStringSource ? std::string() : _source;
+  if (!in.ReadSources(filePath))
+  {
+    _errors.push_back({errorCode, "Binary document is truncated.", _source});
+    return false;
+  }
+
+  // Values are checked like the parser checks them.
+  ScopedParamValueChecks valueChecks(
+      _config.GetValidationLevel() == ValidationLevel::FULL);
+
+  root->SetXmlPath("/sdf");
+  if (!in.ReadElement(root) || !in.AtEnd())
+  {
+    _errors.push_back({errorCode, "Binary document is invalid or truncated" +
+        (in.error.empty() ? std::string(".") : ": " + in.error + "."),
+        _source});
+    return false;
+  }
+
+  if (!filePath.empty())
+    _sdf->SetFilePath(filePath);
+  if (_sdf->OriginalVersion().empty())
+    _sdf->SetOriginalVersion(root->OriginalVersion());
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BinarySdf::Sniff(std::string_view _start, std::string &_version)
+{
+  BinarySdfReader in(_start, ParserConfig::GlobalConfig());
+  if (!in.Expect(kMagic, sizeof(kMagic)))
+    return false;
+  if (!in.String(_version))
+    _version.clear();
+  return true;
+}
+}
+}
@@ -0,0 +1,403 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_BINARYSDF_HH
+#define SDFORMAT_BINARYSDF_HH
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "sdf/Element.hh"
+#include "sdf/Error.hh"
+#include "sdf/Param.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  class BinarySdfReader;
+  class BinarySdfWriter;
+
+  /// \brief Binary encoding of SDFormat documents, read by readFile,
+  /// readString and Root::Load in place of XML. A binary document holds the
+  /// element tree of a document in the specification version of this
+  /// library. Each element and attribute of the specification is tagged
+  /// with its index in the description of its parent, and values are stored
+  /// in the binary form of their type, so reading a document parses no text
+  /// and no numbers. Elements and attributes that are not in the
+  /// specification, such as the contents of plugins, are stored with their
+  /// names.
+  ///
+  /// Documents begin with a magic number and the specification version,
+  /// followed by a fingerprint of the element descriptions that the tags
+  /// refer to. Documents whose fingerprint does not match the descriptions
+  /// of the library that reads them are rejected, and have to be encoded
+  /// again from XML.
+  ///
+  /// The element cache of Root::LoadCached stores its element trees with
+  /// the same BinarySdfWriter and BinarySdfReader, in the mode that keeps
+  /// the source of the elements.
+  class BinarySdf
+  {
+    /// \brief Encode the element tree of a document.
+    /// \param[in] _sdf The <sdf> element of the document.
+    /// \param[in] _config Parser configuration, used to get the descriptions
+    /// of elements that refer to other descriptions.
+    /// \param[out] _data The encoded document.
+    /// \param[out] _errors Errors, such as values that cannot be encoded.
+    /// \return True if the document was encoded.
+    public: static bool Encode(const ElementPtr &_sdf,
+                               const ParserConfig &_config,
+                               std::string &_data, Errors &_errors);
+
+    /// \brief Decode a document into an SDF object.
+    /// \param[in] _data The encoded document.
+    /// \param[in] _source File the document was read from, or
+    /// kSdfStringSource for a string.
+    /// \param[in] _config Parser configuration.
+    /// \param[in,out] _sdf SDF object initialized with sdf::init, whose root
+    /// element receives the decoded elements.
+    /// \param[out] _errors Errors of decoding the document.
+    /// \return True if the document was decoded.
+    public: static bool Decode(std::string_view _data,
+                               const std::string &_source,
+                               const ParserConfig &_config,
+                               SDFPtr _sdf, Errors &_errors);
+
+    /// \brief Check whether a document is a binary document, from its first
+    /// bytes.
+    /// \param[in] _start The document, or its first bytes.
+    /// \param[out] _version Specification version of the document, if it is
+    /// a binary document.
+    /// \return True if the document starts with the magic number of binary
+    /// documents.
+    public: static bool Sniff(std::string_view _start, std::string &_version);
+
+    /// \brief Append the value of a parameter in the binary form of its
+    /// type.
+    /// \param[in,out] _out Encoded data.
+    /// \param[in] _param The parameter, whose value is set.
+    /// \return False if the value does not have the type of the parameter.
+    private: static bool WriteValue(BinarySdfWriter &_out,
+                                    const Param &_param);
+
+    /// \brief Read the value of a parameter written by WriteValue and set
+    /// it, without converting it from a string.
+    /// \param[in,out] _in Encoded data.
+    /// \param[in,out] _param The parameter.
+    /// \param[in] _ignoreParentAttributes True if the value ignores the
+    /// attributes of the parent element.
+    /// \return False if the value could not be read or is not allowed.
+    private: static bool ReadValue(BinarySdfReader &_in, Param &_param,
+                                   bool _ignoreParentAttributes);
+
+    /// \brief Allow the element functions of the encoding to read and write
+    /// values.
+    friend class BinarySdfReader;
+    friend class BinarySdfWriter;
+  };
+
+  /// \brief Appends values and element trees to encoded data.
+  class BinarySdfWriter
+  {
+    /// \brief Constructor.
+    /// \param[in] _config Parser configuration.
+    public: explicit BinarySdfWriter(const ParserConfig &_config)
+      : config(_config)
+    {
+    }
+
+    /// \brief Append a byte.
+    /// \param[in] _value Value to append.
+    public: void U8(std::uint8_t _value)
+    {
+      this->buffer.push_back(static_cast<char>(_value));
+    }
+
+    /// \brief Append an unsigned integer, 7 bits at a time.
+    /// \param[in] _value Value to append.
+    public: void U64(std::uint64_t _value)
+    {
+      while (_value >= 0x80u)
+      {
+        this->U8(static_cast<std::uint8_t>(_value | 0x80u));
+        _value >>= 7;
+      }
+      this->U8(static_cast<std::uint8_t>(_value));
+    }
+
+    /// \brief Append a signed integer, zigzag encoded so that small
+    /// negative values are short.
+    /// \param[in] _value Value to append.
+    public: void I64(std::int64_t _value)
+    {
+      this->U64((static_cast<std::uint64_t>(_value) << 1) ^
+                static_cast<std::uint64_t>(_value >> 63));
+    }
+
+    /// \brief Append the bytes of a value, in the byte order of this
+    /// machine.
+    /// \param[in] _value Value to append.
+    public: template<typename T>
+            void Raw(T _value)
+    {
+      char bytes[sizeof(T)];
+      std::memcpy(bytes, &_value, sizeof(T));
+      this->buffer.append(bytes, sizeof(T));
+    }
+
+    /// \brief Append a string, preceded by its size.
+    /// \param[in] _value Value to append.
+    public: void String(std::string_view _value)
+    {
+      this->U64(_value.size());
+      this->buffer.append(_value.data(), _value.size());
+    }
+
+    /// \brief Append a parameter.
+    /// \param[in] _param The parameter.
+    /// \param[in] _described True if the reader has the description of the
+    /// parameter. Otherwise its type, default value and requirement are
+    /// written too.
+    /// \param[out] _errors Errors.
+    /// \return True if the parameter was written.
+    public: bool WriteParam(const ParamPtr &_param, bool _described,
+                            Errors &_errors);
+
+    /// \brief Append the contents of an element and its descendants. The
+    /// name of the element is not written.
+    /// \param[in] _elem The element.
+    /// \param[in] _desc Element created from the description of _elem the
+    /// way the reader creates it, or nullptr if it has no description.
+    /// \param[out] _errors Errors.
+    /// \return True if the element was written.
+    public: bool WriteElement(const ElementPtr &_elem,
+                              const ElementPtr &_desc, Errors &_errors);
+
+    /// \brief Append the file path and original version of every element
+    /// written by another writer, in the order of their indices.
+    /// \param[in] _elements The other writer.
+    public: void WriteSources(const BinarySdfWriter &_elements);
+
+    /// \brief Append an element tagged with the index of its description
+    /// in a parent element, or with its name if it has none.
+    /// \param[in] _parent Element whose descriptions are searched.
+    /// \param[in] _elem The element.
+    /// \param[out] _errors Errors.
+    /// \return True if the element was written.
+    private: bool WriteTagged(const ElementPtr &_parent,
+                              const ElementPtr &_elem, Errors &_errors);
+
+    /// \brief Get an element created from a description, the way the
+    /// reader creates it.
+    /// \param[in] _desc The description.
+    /// \return The element, which is created once per description.
+    private: ElementPtr Description(const ElementConstPtr &_desc);
+
+    /// \brief Contents of the buffer.
+    public: std::string buffer;
+
+    /// \brief File path of the elements that are written without a path.
+    /// The reader gives them the path it is told to.
+    public: std::string rootPath;
+
+    /// \brief True to keep the source of the elements: their line numbers,
+    /// XML paths and include elements, and the strings their values were
+    /// read from. Values are then parsed again by the reader, and not
+    /// stored in the binary form of their type.
+    public: bool keepSource = false;
+
+    /// \brief Index of each pair of file path and original version of the
+    /// elements.
+    public: std::map<std::pair<std::string, std::string>, std::uint64_t>
+        sources;
+
+    /// \brief Elements created from each description that was written.
+    private: std::map<const sdf::Element *, ElementPtr> descriptions;
+
+    /// \brief Parser configuration.
+    private: const ParserConfig &config;
+  };
+
+  /// \brief Reads values and element trees from encoded data. Every read
+  /// fails once the end of the data has been passed.
+  class BinarySdfReader
+  {
+    /// \brief Constructor.
+    /// \param[in] _data Data to read. It must outlive the reader.
+    /// \param[in] _config Parser configuration.
+    public: BinarySdfReader(std::string_view _data,
+                            const ParserConfig &_config)
+      : pos(_data.data()), end(_data.data() + _data.size()), config(_config)
+    {
+    }
+
+    /// \brief Read a byte.
+    /// \param[out] _value Value read.
+    /// \return True if the value was read.
+    public: bool U8(std::uint8_t &_value)
+    {
+      if (this->pos == this->end)
+        return false;
+      _value = static_cast<std::uint8_t>(*this->pos++);
+      return true;
+    }
+
+    /// \brief Read an unsigned integer written by BinarySdfWriter::U64.
+    /// \param[out] _value Value read.
+    /// \return True if the value was read.
+    public: bool U64(std::uint64_t &_value)
+    {
+      _value = 0;
+      for (unsigned int shift = 0; shift < 64u; shift += 7)
+      {
+        std::uint8_t byte = 0;
+        if (!this->U8(byte))
+          return false;
+        _value |= static_cast<std::uint64_t>(byte & 0x7fu) << shift;
+        if ((byte & 0x80u) == 0)
+          return true;
+      }
+      return false;
+    }
+
+    /// \brief Read a signed integer written by BinarySdfWriter::I64.
+    /// \param[out] _value Value read.
+    /// \return True if the value was read.
+    public: bool I64(std::int64_t &_value)
+    {
+      std::uint64_t encoded = 0;
+      if (!this->U64(encoded))
+        return false;
+      _value = static_cast<std::int64_t>(encoded >> 1) ^
+          -static_cast<std::int64_t>(encoded & 1u);
+      return true;
+    }
+
+    /// \brief Read a value written by BinarySdfWriter::Raw.
+    /// \param[out] _value Value read.
+    /// \return True if the value was read.
+    public: template<typename T>
+            bool Raw(T &_value)
+    {
+      if (sizeof(T) > static_cast<std::size_t>(this->end - this->pos))
+        return false;
+      std::memcpy(&_value, this->pos, sizeof(T));
+      this->pos += sizeof(T);
+      return true;
+    }
+
+    /// \brief Read a string written by BinarySdfWriter::String.
+    /// \param[out] _value Value read.
+    /// \return True if the value was read.
+    public: bool String(std::string &_value)
+    {
+      std::uint64_t size = 0;
+      if (!this->U64(size) ||
+          size > static_cast<std::uint64_t>(this->end - this->pos))
+      {
+        return false;
+      }
+      _value.assign(this->pos, static_cast<std::size_t>(size));
+      this->pos += size;
+      return true;
+    }
+
+    /// \brief Read raw bytes and compare them.
+    /// \param[in] _data Expected bytes.
+    /// \param[in] _size Number of bytes.
+    /// \return True if the bytes were read and match _data.
+    public: bool Expect(const char *_data, std::size_t _size)
+    {
+      if (_size > static_cast<std::size_t>(this->end - this->pos) ||
+          std::memcmp(this->pos, _data, _size) != 0)
+      {
+        return false;
+      }
+      this->pos += _size;
+      return true;
+    }
+
+    /// \brief Check whether the whole data was read.
+    /// \return True at the end of the data.
+    public: bool AtEnd() const
+    {
+      return this->pos == this->end;
+    }
+
+    /// \brief Read a parameter written by BinarySdfWriter::WriteParam.
+    /// \param[in] _elem Element of the parameter.
+    /// \param[in] _param The parameter that has the description, or
+    /// nullptr if the parameter was written with its description.
+    /// \param[in] _key Key of an attribute that was written with its
+    /// description, or an empty string for a value.
+    /// \return True if the parameter was read.
+    public: bool ReadParam(const ElementPtr &_elem, ParamPtr _param,
+                           const std::string &_key);
+
+    /// \brief Read the contents of an element and its descendants, written
+    /// by BinarySdfWriter::WriteElement.
+    /// \param[in] _elem The element, created from its description if it
+    /// has one.
+    /// \param[in] _depth Nesting depth of the element.
+    /// \return True if the element was read.
+    public: bool ReadElement(const ElementPtr &_elem, std::size_t _depth = 0);
+
+    /// \brief Read the sources written by BinarySdfWriter::WriteSources.
+    /// \param[in] _rootPath File path of the elements that were written
+    /// without a path.
+    /// \return True if the sources were read.
+    public: bool ReadSources(const std::string &_rootPath);
+
+    /// \brief Read an element written by BinarySdfWriter::WriteTagged.
+    /// \param[in] _parent Element whose descriptions the tag refers to.
+    /// \param[in] _setParent True to make _parent the parent of the new
+    /// element.
+    /// \param[in] _depth Nesting depth of the new element.
+    /// \param[out] _elem The new element.
+    /// \return True if the element was read.
+    private: bool ReadTagged(const ElementPtr &_parent, bool _setParent,
+                             std::size_t _depth, ElementPtr &_elem);
+
+    /// \brief File path and original version of the elements, by index.
+    public: std::vector<std::pair<std::string, std::string>> sources;
+
+    /// \brief Description of why the last read failed, if it did not fail
+    /// because the data ended.
+    public: std::string error;
+
+    /// \brief Next byte to read.
+    private: const char *pos;
+
+    /// \brief End of the data.
+    private: const char *end;
+
+    /// \brief Parser configuration.
+    private: const ParserConfig &config;
+  };
+  }
+}
+#endif
@@ -0,0 +1,254 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <ignition/math/Angle.hh>
+#include <ignition/math/Pose3.hh>
+
+#include "sdf/Element.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/Joint.hh"
+#include "sdf/JointAxis.hh"
+#include "sdf/Link.hh"
+#include "sdf/Model.hh"
+#include "sdf/Plugin.hh"
+#include "sdf/Root.hh"
+#include "sdf/World.hh"
+#include "sdf/parser.hh"
+#include "BinarySdf.hh"
+#include "DocumentFormat.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// \brief World with nested models, poses in degrees, joints and plugins.
+const char kWorld[] = R"(<?xml version='1.0'?>
+<sdf version='1.9'>
+  <world name='generated'>
+    <gravity>0 0 -9.5</gravity>
+    <model name='robot'>
+      <pose degrees='true'>1 2 3 0 0 90</pose>
+      <static>false</static>
+      <link name='base'>
+        <inertial>
+          <mass>2.5</mass>
+        </inertial>
+      </link>
+      <link name='arm'>
+        <pose relative_to='base'>0 0 0.1 0 0 0</pose>
+      </link>
+      <joint name='elbow' type='revolute'>
+        <parent>base</parent>
+        <child>arm</child>
+        <axis>
+          <xyz>0 1 0</xyz>
+          <limit>
+            <lower>-1.5</lower>
+            <upper>1.5</upper>
+          </limit>
+        </axis>
+      </joint>
+      <model name='sensor_head'>
+        <link name='head'/>
+      </model>
+      <plugin name='controller' filename='libcontroller.so'>
+        <gain type='p'>0.25</gain>
+        <topic>/robot/cmd</topic>
+      </plugin>
+    </model>
+  </world>
+</sdf>)";
+
+/////////////////////////////////////////////////
+TEST(BinarySdf, RoundTrip)
+{
+  sdf::Root xmlRoot;
+  ASSERT_TRUE(xmlRoot.LoadSdfString(kWorld).empty());
+
+  std::string data;
+  sdf::Errors errors;
+  ASSERT_TRUE(sdf::encodeBinary(xmlRoot.Element(), data, errors));
+  EXPECT_TRUE(errors.empty());
+
+  const sdf::DocumentInfo info = sdf::sniffDocument(data);
+  EXPECT_EQ(sdf::DocumentFormat::BINARY_SDF, info.format);
+  EXPECT_EQ(sdf::SDF::Version(), info.version);
+
+  sdf::Root root;
+  errors = root.LoadSdfString(data);
+  ASSERT_TRUE(errors.empty()) << errors;
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  EXPECT_EQ("generated", world->Name());
+  EXPECT_EQ(ignition::math::Vector3d(0, 0, -9.5), world->Gravity());
+
+  const sdf::Model *model = world->ModelByName("robot");
+  ASSERT_NE(nullptr, model);
+  EXPECT_EQ(xmlRoot.WorldByIndex(0)->ModelByName("robot")->RawPose(),
+            model->RawPose());
+  EXPECT_DOUBLE_EQ(IGN_PI_2, model->RawPose().Rot().Yaw());
+  EXPECT_EQ(3u, model->LinkCount());
+  ASSERT_NE(nullptr, model->LinkByName("base"));
+  EXPECT_DOUBLE_EQ(2.5,
+      model->LinkByName("base")->Inertial().MassMatrix().Mass());
+  ASSERT_NE(nullptr, model->LinkByName("arm"));
+  EXPECT_EQ("base", model->LinkByName("arm")->PoseRelativeTo());
+  ASSERT_NE(nullptr, model->ModelByName("sensor_head"));
+  EXPECT_NE(nullptr, model->ModelByName("sensor_head")->LinkByName("head"));
+
+  const sdf::Joint *joint = model->JointByName("elbow");
+  ASSERT_NE(nullptr, joint);
+  EXPECT_EQ(sdf::JointType::REVOLUTE, joint->Type());
+  EXPECT_EQ("base", joint->ParentLinkName());
+  EXPECT_EQ("arm", joint->ChildLinkName());
+  ASSERT_NE(nullptr, joint->Axis(0));
+  EXPECT_EQ(ignition::math::Vector3d::UnitY, joint->Axis(0)->Xyz());
+  EXPECT_DOUBLE_EQ(-1.5, joint->Axis(0)->Lower());
+
+  // Elements that are not in the specification keep their names,
+  // attributes and values.
+  ASSERT_EQ(1u, model->Plugins().size());
+  const sdf::Plugin &plugin = model->Plugins()[0];
+  EXPECT_EQ("controller", plugin.Name());
+  EXPECT_EQ("libcontroller.so", plugin.Filename());
+  ASSERT_EQ(2u, plugin.Contents().size());
+  EXPECT_EQ("gain", plugin.Contents()[0]->GetName());
+  EXPECT_EQ("p", plugin.Contents()[0]->Get<std::string>("type"));
+  EXPECT_EQ("0.25", plugin.Contents()[0]->Get<std::string>());
+  EXPECT_EQ("/robot/cmd", plugin.Contents()[1]->Get<std::string>());
+
+  // Nothing is lost, so the decoded elements encode to the same data.
+  std::string decodedData;
+  ASSERT_TRUE(sdf::encodeBinary(root.Element(), decodedData, errors));
+  EXPECT_EQ(data, decodedData);
+
+  // Paths are built for the errors of the DOM.
+  EXPECT_EQ("/sdf/world[@name=\"generated\"]/model[@name=\"robot\"]",
+            root.Element()->GetElement("world")->GetElement("model")
+                ->XmlPath());
+}
+
+/////////////////////////////////////////////////
+TEST(BinarySdf, LoadFile)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string dir = sdf::filesystem::append(tmpDir, "binary_sdf");
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const std::string path = sdf::filesystem::append(dir, "world.sdfbin");
+
+  sdf::Root xmlRoot;
+  ASSERT_TRUE(xmlRoot.LoadSdfString(kWorld).empty());
+  std::string data;
+  sdf::Errors errors;
+  ASSERT_TRUE(sdf::encodeBinary(xmlRoot.Element(), data, errors));
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+  }
+
+  sdf::Root root;
+  errors = root.Load(path);
+  ASSERT_TRUE(errors.empty()) << errors;
+  ASSERT_NE(nullptr, root.WorldByIndex(0));
+  EXPECT_NE(nullptr, root.WorldByIndex(0)->ModelByName("robot"));
+  EXPECT_EQ(path, root.Element()->FilePath());
+  EXPECT_EQ(path, root.Element()->GetElement("world")->FilePath());
+  EXPECT_EQ("1.9", root.Element()->OriginalVersion());
+}
+
+/////////////////////////////////////////////////
+TEST(BinarySdf, Invalid)
+{
+  sdf::Root xmlRoot;
+  ASSERT_TRUE(xmlRoot.LoadSdfString(kWorld).empty());
+  std::string data;
+  sdf::Errors errors;
+  ASSERT_TRUE(sdf::encodeBinary(xmlRoot.Element(), data, errors));
+
+  // Only <sdf> elements are encoded.
+  std::string worldData;
+  EXPECT_FALSE(sdf::encodeBinary(
+      xmlRoot.Element()->GetElement("world"), worldData, errors));
+  EXPECT_FALSE(errors.empty());
+
+  // Truncated documents.
+  for (std::size_t size : {std::size_t{12}, data.size() / 2, data.size() - 1})
+  {
+    sdf::Root root;
+    errors = root.LoadSdfString(data.substr(0, size));
+    EXPECT_FALSE(errors.empty()) << size;
+  }
+
+  // Documents encoded for other element descriptions. The fingerprint
+  // follows the magic number and the version.
+  std::string otherSchema = data;
+  const std::size_t fingerprint = 8 + 1 + sdf::SDF::Version().size() + 1;
+  otherSchema[fingerprint] = static_cast<char>(otherSchema[fingerprint] ^ 1);
+  sdf::Root root;
+  errors = root.LoadSdfString(otherSchema);
+  ASSERT_FALSE(errors.empty());
+  EXPECT_EQ(sdf::ErrorCode::STRING_READ, errors[0].Code());
+  EXPECT_NE(std::string::npos,
+            errors[0].Message().find("must be encoded again"));
+
+  // Types of parameters that are not in the specification are read from
+  // the document, and unknown types are reported as errors.
+  std::string unknownType = data;
+  for (std::size_t pos = unknownType.find("string");
+       pos != std::string::npos; pos = unknownType.find("string", pos))
+  {
+    unknownType.replace(pos, 6, "nosuch");
+  }
+  errors = root.LoadSdfString(unknownType);
+  ASSERT_FALSE(errors.empty());
+  EXPECT_NE(std::string::npos, errors[0].Message().find("Invalid type"))
+    << errors;
+}
+
+/////////////////////////////////////////////////
+TEST(BinarySdf, DeepNesting)
+{
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf);
+  sdf::ElementPtr parent = sdf->Root();
+  for (int i = 0; i < 1000; ++i)
+  {
+    sdf::ElementPtr child(new sdf::Element);
+    child->SetName("nested");
+    child->SetParent(parent);
+    parent->InsertElement(child);
+    parent = child;
+  }
+
+  std::string data;
+  sdf::Errors errors;
+  ASSERT_TRUE(sdf::encodeBinary(sdf->Root(), data, errors));
+
+  // Documents nested too deeply are rejected instead of overflowing the
+  // stack.
+  sdf::Root root;
+  errors = root.LoadSdfString(data);
+  ASSERT_FALSE(errors.empty());
+  EXPECT_NE(std::string::npos, errors[0].Message().find("nested deeper"))
+    << errors;
+}
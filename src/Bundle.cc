@@ -0,0 +1,464 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+#include "sdf/Bundle.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/Root.hh"
+#include "sdf/SDFImpl.hh"
+
+#include "FindFileCache.hh"
+
+using namespace sdf;
+
+namespace
+{
+/// \brief First bytes of a bundle file.
+constexpr char kMagic[] = {'S', 'D', 'F', 'B'};
+
+/// \brief Version of the layout of bundle files. Increment it when the
+/// layout changes.
+constexpr std::uint32_t kFormatVersion = 1;
+
+/// \brief Alignment of the contents of the files in a bundle file.
+constexpr std::size_t kAlignment = 8;
+
+/// \brief Round a size up to kAlignment.
+/// \param[in] _size The size.
+/// \return The aligned size.
+std::size_t aligned(std::size_t _size)
+{
+  return (_size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+/// \brief Append a little-endian unsigned integer to a buffer.
+/// \param[in,out] _buffer The buffer.
+/// \param[in] _value Value to append.
+/// \param[in] _size Number of bytes of the value.
+void appendUint(std::string &_buffer, std::uint64_t _value,
+    std::size_t _size = 8)
+{
+  for (std::size_t i = 0; i < _size; ++i)
+    _buffer.push_back(static_cast<char>((_value >> (8 * i)) & 0xFFu));
+}
+
+/// \brief Append a string, preceded by its size, to a buffer.
+/// \param[in,out] _buffer The buffer.
+/// \param[in] _value Value to append.
+void appendString(std::string &_buffer, const std::string &_value)
+{
+  appendUint(_buffer, _value.size());
+  _buffer += _value;
+}
+
+/// \brief Reads the values of a bundle file. Every read fails once the end
+/// of the data has been passed.
+class Reader
+{
+  /// \brief Constructor.
+  /// \param[in] _data Data to read. It must outlive the reader.
+  public: explicit Reader(std::string_view _data)
+    : data(_data)
+  {
+  }
+
+  /// \brief Read a little-endian unsigned integer.
+  /// \param[out] _value Value read.
+  /// \param[in] _size Number of bytes of the value.
+  /// \return True if the value was read.
+  public: bool Uint(std::uint64_t &_value, std::size_t _size = 8)
+  {
+    if (this->data.size() < _size)
+      return false;
+    _value = 0;
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+      _value |= static_cast<std::uint64_t>(
+          static_cast<unsigned char>(this->data[i])) << (8 * i);
+    }
+    this->data.remove_prefix(_size);
+    return true;
+  }
+
+  /// \brief Read a string, preceded by its size.
+  /// \param[out] _value Value read.
+  /// \return True if the value was read.
+  public: bool String(std::string &_value)
+  {
+    std::uint64_t size = 0;
+    if (!this->Uint(size) || this->data.size() < size)
+      return false;
+    _value.assign(this->data.substr(0, size));
+    this->data.remove_prefix(size);
+    return true;
+  }
+
+  /// \brief Data that is left to read.
+  private: std::string_view data;
+};
+
+/// \brief Provider that reads files from another provider, or from the
+/// filesystem, and keeps the contents of every file that it reads.
+class FileRecorder : public ResourceProvider
+{
+  /// \brief Constructor.
+  /// \param[in] _provider Provider that files are read from, or nullptr to
+  /// read them from the filesystem.
+  public: explicit FileRecorder(std::shared_ptr<ResourceProvider> _provider)
+    : provider(std::move(_provider))
+  {
+  }
+
+  // Documentation inherited.
+  public: bool Exists(const std::string &_path) const override
+  {
+    return this->provider ? this->provider->Exists(_path) :
+        sdf::filesystem::exists(_path);
+  }
+
+  // Documentation inherited.
+  public: bool IsDirectory(const std::string &_path) const override
+  {
+    return this->provider ? this->provider->IsDirectory(_path) :
+        sdf::filesystem::is_directory(_path);
+  }
+
+  // Documentation inherited.
+  public: bool Read(const std::string &_path,
+                    ResourceData &_data) const override
+  {
+    auto contents = std::make_shared<std::string>();
+    if (this->provider)
+    {
+      ResourceData data;
+      if (!this->provider->Read(_path, data))
+        return false;
+      contents->assign(data.data);
+    }
+    else
+    {
+      std::ifstream in(_path, std::ios::binary);
+      if (!in)
+        return false;
+      std::ostringstream stream;
+      stream << in.rdbuf();
+      if (in.bad())
+        return false;
+      *contents = stream.str();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->files[_path] = contents;
+    }
+    _data.data = *contents;
+    _data.owner = contents;
+    return true;
+  }
+
+  /// \brief Contents of the files that were read, by path.
+  public: mutable std::map<std::string, std::shared_ptr<const std::string>>
+          files;
+
+  /// \brief Provider that files are read from, or nullptr.
+  private: std::shared_ptr<ResourceProvider> provider;
+
+  /// \brief Mutex that protects files.
+  private: mutable std::mutex mutex;
+};
+
+/// \brief Provider of the files of a bundle file that was read.
+class BundleProvider : public ResourceProvider
+{
+  // Documentation inherited.
+  public: bool Exists(const std::string &_path) const override
+  {
+    return this->files.count(_path) > 0 || this->IsDirectory(_path);
+  }
+
+  // Documentation inherited.
+  public: bool IsDirectory(const std::string &_path) const override
+  {
+    return this->directories.count(_path) > 0;
+  }
+
+  // Documentation inherited.
+  public: bool Read(const std::string &_path,
+                    ResourceData &_data) const override
+  {
+    auto it = this->files.find(_path);
+    if (it == this->files.end())
+      return false;
+    _data.data = it->second;
+    _data.owner = this->buffer;
+    return true;
+  }
+
+  /// \brief Contents of the bundle file.
+  public: std::shared_ptr<const std::string> buffer;
+
+  /// \brief Contents of the files, in buffer, by path.
+  public: std::map<std::string, std::string_view> files;
+
+  /// \brief Directories that contain the files.
+  public: std::set<std::string> directories;
+
+  /// \brief Paths that URIs resolved to when the bundle was packed.
+  public: std::map<std::string, std::string> resolutions;
+};
+}
+
+/// \brief Private data for Bundle.
+class sdf::Bundle::Implementation
+{
+  /// \brief Path that the document was loaded from when it was packed.
+  public: std::string mainFile;
+
+  /// \brief Provider of the files of the bundle.
+  public: std::shared_ptr<BundleProvider> provider =
+      std::make_shared<BundleProvider>();
+};
+
+/////////////////////////////////////////////////
+Bundle::Bundle()
+  : dataPtr(ignition::utils::MakeImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+Errors Bundle::Pack(const std::string &_filename,
+    const std::string &_bundlePath, const ParserConfig &_config)
+{
+  // The document is loaded through a provider that keeps every file that
+  // is read, and the file lookups are cached to record how URIs resolve.
+  ParserConfig config = _config;
+  auto recorder = std::make_shared<FileRecorder>(
+      _config.GetResourceProvider());
+  config.SetUseFindFileCache(true);
+  config.SetResourceProvider(recorder);
+
+  Root root;
+  Errors errors = root.Load(_filename, config);
+  if (!errors.empty())
+    return errors;
+
+  const std::string mainFile = sdf::findFile(_filename, true, true, config);
+  const std::map<std::string, std::string> resolutions =
+      FindFileCache::Of(config)->FoundPaths();
+
+  std::string index;
+  appendString(index, mainFile);
+  appendUint(index, recorder->files.size());
+  std::size_t offset = 0;
+  for (const auto &[path, contents] : recorder->files)
+  {
+    appendString(index, path);
+    appendUint(index, offset);
+    appendUint(index, contents->size());
+    offset = aligned(offset + contents->size());
+  }
+  appendUint(index, resolutions.size());
+  for (const auto &[uri, path] : resolutions)
+  {
+    appendString(index, uri);
+    appendString(index, path);
+  }
+
+  std::string header(kMagic, sizeof(kMagic));
+  appendUint(header, kFormatVersion, 4);
+  appendUint(header, index.size());
+
+  std::string bundle = header + index;
+  bundle.resize(aligned(bundle.size()), '\0');
+  for (const auto &file : recorder->files)
+  {
+    bundle += *file.second;
+    bundle.resize(aligned(bundle.size()), '\0');
+  }
+
+  std::ofstream out(_bundlePath, std::ios::binary);
+  out.write(bundle.data(), static_cast<std::streamsize>(bundle.size()));
+  if (!out.flush())
+  {
+    errors.push_back({ErrorCode::FILE_WRITE,
+        "Unable to write bundle file [" + _bundlePath + "]."});
+  }
+  return errors;
+}
+
+/////////////////////////////////////////////////
+bool Bundle::IsBundleFile(const std::string &_path)
+{
+  char magic[sizeof(kMagic)] = {};
+  std::ifstream in(_path, std::ios::binary);
+  return in.read(magic, sizeof(magic)) &&
+      std::equal(magic, magic + sizeof(magic), kMagic);
+}
+
+/////////////////////////////////////////////////
+Errors Bundle::Open(const std::string &_bundlePath)
+{
+  this->dataPtr->mainFile.clear();
+  this->dataPtr->provider = std::make_shared<BundleProvider>();
+
+  // The whole bundle is read at once, and the files are views of it.
+  auto buffer = std::make_shared<std::string>();
+  std::ifstream in(_bundlePath, std::ios::binary | std::ios::ate);
+  if (in)
+  {
+    buffer->resize(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(buffer->data(), static_cast<std::streamsize>(buffer->size()));
+  }
+  if (!in)
+  {
+    return {{ErrorCode::FILE_READ,
+        "Unable to read bundle file [" + _bundlePath + "]."}};
+  }
+
+  const Errors invalid = {{ErrorCode::FILE_READ,
+      "File [" + _bundlePath + "] is not a valid bundle file."}};
+
+  std::string_view data(*buffer);
+  if (data.substr(0, sizeof(kMagic)) !=
+      std::string_view(kMagic, sizeof(kMagic)))
+  {
+    return invalid;
+  }
+
+  Reader header(data.substr(sizeof(kMagic)));
+  std::uint64_t version = 0;
+  std::uint64_t indexSize = 0;
+  const std::size_t headerSize = sizeof(kMagic) + 4 + 8;
+  if (!header.Uint(version, 4) || version != kFormatVersion ||
+      !header.Uint(indexSize) || indexSize > data.size() - headerSize)
+  {
+    return invalid;
+  }
+
+  const std::size_t dataBegin = aligned(headerSize + indexSize);
+  const std::string_view contents =
+      data.substr(std::min(dataBegin, data.size()));
+  Reader index(data.substr(headerSize, indexSize));
+  auto provider = std::make_shared<BundleProvider>();
+  std::string mainFile;
+  std::uint64_t fileCount = 0;
+  if (!index.String(mainFile) || !index.Uint(fileCount))
+    return invalid;
+
+  for (std::uint64_t i = 0; i < fileCount; ++i)
+  {
+    std::string path;
+    std::uint64_t offset = 0;
+    std::uint64_t size = 0;
+    if (!index.String(path) || !index.Uint(offset) || !index.Uint(size) ||
+        offset > contents.size() || size > contents.size() - offset)
+    {
+      return invalid;
+    }
+    provider->files[path] = contents.substr(offset, size);
+
+    for (std::string dir = filesystem::parent_path(path);
+         !dir.empty() && provider->directories.insert(dir).second;)
+    {
+      std::string parent = filesystem::parent_path(dir);
+      if (parent == dir)
+        break;
+      dir = std::move(parent);
+    }
+  }
+
+  std::uint64_t resolutionCount = 0;
+  if (!index.Uint(resolutionCount))
+    return invalid;
+  for (std::uint64_t i = 0; i < resolutionCount; ++i)
+  {
+    std::string uri;
+    std::string path;
+    if (!index.String(uri) || !index.String(path))
+      return invalid;
+    provider->resolutions[uri] = path;
+  }
+
+  provider->buffer = std::move(buffer);
+  this->dataPtr->provider = std::move(provider);
+  this->dataPtr->mainFile = std::move(mainFile);
+  return {};
+}
+
+/////////////////////////////////////////////////
+const std::string &Bundle::MainFile() const
+{
+  return this->dataPtr->mainFile;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> Bundle::Files() const
+{
+  std::vector<std::string> files;
+  for (const auto &file : this->dataPtr->provider->files)
+    files.push_back(file.first);
+  return files;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<ResourceProvider> Bundle::Provider() const
+{
+  return this->dataPtr->provider;
+}
+
+/////////////////////////////////////////////////
+void Bundle::Configure(ParserConfig &_config) const
+{
+  _config.SetResourceProvider(this->dataPtr->provider);
+
+  // The find callback is only used for the URIs that are not found in the
+  // search paths of the configuration.
+  std::shared_ptr<const BundleProvider> provider = this->dataPtr->provider;
+  auto callback = _config.FindFileCallback();
+  _config.SetFindCallback(
+      [provider, callback](const std::string &_uri) -> std::string
+      {
+        auto it = provider->resolutions.find(_uri);
+        if (it != provider->resolutions.end())
+          return it->second;
+        return callback ? callback(_uri) : std::string();
+      });
+}
+
+/////////////////////////////////////////////////
+Errors Bundle::Load(Root &_root, const ParserConfig &_config) const
+{
+  if (this->dataPtr->mainFile.empty())
+  {
+    return {{ErrorCode::FILE_READ,
+        "The bundle does not hold a document to load."}};
+  }
+
+  ParserConfig config = _config;
+  this->Configure(config);
+  return _root.Load(this->dataPtr->mainFile, config);
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "sdf/Bundle.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/Model.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/Root.hh"
+#include "sdf/World.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _content Content of the file.
+static void writeFile(const std::string &_path, const std::string &_content)
+{
+  std::ofstream out(_path, std::ios::binary);
+  out << _content;
+}
+
+/////////////////////////////////////////////////
+TEST(Bundle, PackAndLoad)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string dir = sdf::filesystem::append(tmpDir, "bundle");
+  const std::string modelDir = sdf::filesystem::append(dir, "models", "box");
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(modelDir);
+
+  const std::string worldFile = sdf::filesystem::append(dir, "world.sdf");
+  writeFile(worldFile,
+      "<?xml version='1.0'?><sdf version='1.8'><world name='default'>"
+      "<include><uri>model://box</uri><name>box_a</name></include>"
+      "<include><uri>model://box</uri><name>box_b</name></include>"
+      "</world></sdf>");
+  writeFile(sdf::filesystem::append(modelDir, "model.config"),
+      "<?xml version='1.0'?><model><name>box</name>"
+      "<sdf version='1.6'>model.sdf</sdf></model>");
+  writeFile(sdf::filesystem::append(modelDir, "model.sdf"),
+      "<?xml version='1.0'?><sdf version='1.6'><model name='box'>"
+      "<link name='link'/></model></sdf>");
+
+  sdf::ParserConfig config;
+  config.AddURIPath("model://", sdf::filesystem::append(dir, "models"));
+  const std::string bundlePath = sdf::filesystem::append(dir, "world.sdfb");
+  sdf::Errors errors = sdf::Bundle::Pack(worldFile, bundlePath, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_TRUE(sdf::Bundle::IsBundleFile(bundlePath));
+  EXPECT_FALSE(sdf::Bundle::IsBundleFile(worldFile));
+
+  // The bundle loads once its files are removed, without the URI paths.
+  std::filesystem::remove_all(modelDir);
+  std::filesystem::remove(worldFile);
+
+  sdf::Bundle bundle;
+  errors = bundle.Open(bundlePath);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(worldFile, bundle.MainFile());
+  EXPECT_EQ(3u, bundle.Files().size());
+
+  sdf::Root root;
+  errors = bundle.Load(root, sdf::ParserConfig());
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  ASSERT_EQ(2u, world->ModelCount());
+  EXPECT_EQ("box_a", world->ModelByIndex(0)->Name());
+  EXPECT_EQ("box_b", world->ModelByIndex(1)->Name());
+  EXPECT_EQ(1u, world->ModelByIndex(1)->LinkCount());
+
+  // The provider outlives the bundle.
+  auto provider = bundle.Provider();
+  bundle = sdf::Bundle();
+  EXPECT_TRUE(provider->IsDirectory(modelDir));
+  sdf::ResourceData data;
+  ASSERT_TRUE(provider->Read(sdf::filesystem::append(modelDir, "model.sdf"),
+      data));
+  EXPECT_NE(std::string::npos, data.data.find("<model name='box'>"));
+}
+
+/////////////////////////////////////////////////
+TEST(Bundle, Errors)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string dir = sdf::filesystem::append(tmpDir, "bundle_errors");
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+
+  // Documents with errors are not packed.
+  const std::string worldFile = sdf::filesystem::append(dir, "world.sdf");
+  writeFile(worldFile,
+      "<?xml version='1.0'?><sdf version='1.8'><world name='default'>"
+      "<include><uri>model://missing</uri></include>"
+      "</world></sdf>");
+  const std::string bundlePath = sdf::filesystem::append(dir, "world.sdfb");
+  sdf::Errors errors =
+      sdf::Bundle::Pack(worldFile, bundlePath, sdf::ParserConfig());
+  EXPECT_FALSE(errors.empty());
+  EXPECT_FALSE(std::filesystem::exists(bundlePath));
+
+  // Files that are not bundles, or are truncated, are not read.
+  sdf::Bundle bundle;
+  errors = bundle.Open(worldFile);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::FILE_READ, errors[0].Code());
+
+  writeFile(worldFile,
+      "<?xml version='1.0'?><sdf version='1.8'><world name='default'/>"
+      "</sdf>");
+  errors = sdf::Bundle::Pack(worldFile, bundlePath, sdf::ParserConfig());
+  EXPECT_TRUE(errors.empty()) << errors;
+  std::filesystem::resize_file(bundlePath,
+      std::filesystem::file_size(bundlePath) - 20);
+  errors = bundle.Open(bundlePath);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::FILE_READ, errors[0].Code());
+  EXPECT_TRUE(bundle.MainFile().empty());
+
+  sdf::Root root;
+  errors = bundle.Load(root, sdf::ParserConfig());
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::FILE_READ, errors[0].Code());
+}
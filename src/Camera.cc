@@ -15,6 +15,10 @@
  *
 */
 #include <array>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <string>
 #include "sdf/Camera.hh"
 #include "sdf/parser.hh"
 #include "Utils.hh"
@@ -46,6 +50,160 @@ static std::array<std::string, 19> kPixelFormatNames =
   "BAYER_GRBG8"
 };
 
+namespace
+{
+/// \brief Storage for a group of rarely set camera parameters. All the
+/// cameras that leave the group at its defaults share a single immutable
+/// instance, and a camera gets its own copy the first time it modifies it.
+template<typename T>
+class CopyOnWrite
+{
+  /// \brief Constructor, referring to the shared default values.
+  public: CopyOnWrite()
+    : data(Defaults())
+  {
+  }
+
+  /// \brief Access the values.
+  /// \return Pointer to the values, which may be shared.
+  public: const T *operator->() const
+  {
+    return this->data.get();
+  }
+
+  /// \brief Access the values.
+  /// \return Reference to the values, which may be shared.
+  public: const T &operator*() const
+  {
+    return *this->data;
+  }
+
+  /// \brief Get the values for modification.
+  /// \return Values that are not shared with another camera.
+  public: T &Mutable()
+  {
+    if (this->data.use_count() > 1)
+      this->data = std::make_shared<T>(*this->data);
+    return *this->data;
+  }
+
+  /// \brief Get the shared default values.
+  /// \return Shared pointer to the defaults, which are never modified.
+  private: static const std::shared_ptr<T> &Defaults()
+  {
+    static const std::shared_ptr<T> defaults = std::make_shared<T>();
+    return defaults;
+  }
+
+  /// \brief The values.
+  private: std::shared_ptr<T> data;
+};
+
+/// \brief Distortion parameters of a camera.
+class CameraDistortion
+{
+  /// \brief The radial distortion coefficient k1.
+  public: double k1{0.0};
+
+  /// \brief The radial distortion coefficient k2.
+  public: double k2{0.0};
+
+  /// \brief The radial distortion coefficient k3.
+  public: double k3{0.0};
+
+  /// \brief Thecw tangential distortion coefficient p1.
+  public: double p1{0.0};
+
+  /// \brief Thecw tangential distortion coefficient p2.
+  public: double p2{0.0};
+
+  /// \brief The distortion center or principal point
+  public: ignition::math::Vector2d center{0.5, 0.5};
+};
+
+/// \brief Lens parameters of a camera.
+class CameraLens
+{
+  /// \brief Lens type.
+  public: std::string type{"stereographic"};
+
+  /// \brief Lens scale to hfov.
+  public: bool scaleToHfov{true};
+
+  /// \brief Lens c1.
+  public: double c1{1.0};
+
+  /// \brief Lens c2.
+  public: double c2{1.0};
+
+  /// \brief Lens c3.
+  public: double c3{0.0};
+
+  /// \brief Lens F.
+  public: double f{1.0};
+
+  /// \brief Lens fun.
+  public: std::string fun{"tan"};
+
+  /// \brief Lens cutoff angle.
+  public: ignition::math::Angle cutoffAngle{IGN_PI_2};
+
+  /// \brief lens environment texture size.
+  public: int envTextureSize{256};
+
+  /// \brief lens instrinsics fx.
+  public: double intrinsicsFx{277.0};
+
+  /// \brief lens instrinsics fy.
+  public: double intrinsicsFy{277.0};
+
+  /// \brief lens instrinsics cx.
+  public: double intrinsicsCx{160.0};
+
+  /// \brief lens instrinsics cy.
+  public: double intrinsicsCy{120.0};
+
+  /// \brief lens instrinsics s.
+  public: double intrinsicsS{1.0};
+
+  /// \brief True if this camera has custom intrinsics values
+  public: bool hasIntrinsics = false;
+};
+
+/// \brief Undistortion table computed on demand by Camera::UndistortionMap,
+/// with the parameters it was computed from. A copy of a camera computes
+/// its table again.
+class UndistortionMapCache
+{
+  /// \brief Default constructor.
+  public: UndistortionMapCache() = default;
+
+  /// \brief Copy constructor.
+  public: UndistortionMapCache(const UndistortionMapCache &)
+  {
+  }
+
+  /// \brief Copy assignment operator.
+  /// \return Reference to this cache.
+  public: UndistortionMapCache &operator=(const UndistortionMapCache &)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->key.clear();
+    return *this;
+  }
+
+  /// \brief Mutex that protects the table while it is computed.
+  public: std::mutex mutex;
+
+  /// \brief Parameters the table was computed from, empty if there is no
+  /// table.
+  public: std::vector<double> key;
+
+  /// \brief The table.
+  public: CameraUndistortionMap map;
+};
+}
+
 // Private data class
 class sdf::Camera::Implementation
 {
@@ -112,80 +270,26 @@ class sdf::Camera::Implementation
   /// \brief Path in which to save frames.
   public: std::string savePath{""};
 
-  /// \brief The image noise value.
-  public: Noise imageNoise;
-
-  /// \brief The radial distortion coefficient k1.
-  public: double distortionK1{0.0};
-
-  /// \brief The radial distortion coefficient k2.
-  public: double distortionK2{0.0};
-
-  /// \brief The radial distortion coefficient k3.
-  public: double distortionK3{0.0};
-
-  /// \brief Thecw tangential distortion coefficient p1.
-  public: double distortionP1{0.0};
-
-  /// \brief Thecw tangential distortion coefficient p2.
-  public: double distortionP2{0.0};
-
-  /// \brief The distortion center or principal point
-  public: ignition::math::Vector2d distortionCenter{0.5, 0.5};
-
   /// \brief Pose of the link
   public: ignition::math::Pose3d pose = ignition::math::Pose3d::Zero;
 
   /// \brief Frame of the pose.
   public: std::string poseRelativeTo = "";
 
-  /// \brief Lens type.
-  public: std::string lensType{"stereographic"};
-
-  /// \brief Lens scale to hfov.
-  public: bool lensScaleToHfov{true};
-
-  /// \brief Lens c1.
-  public: double lensC1{1.0};
-
-  /// \brief Lens c2.
-  public: double lensC2{1.0};
-
-  /// \brief Lens c3.
-  public: double lensC3{0.0};
-
-  /// \brief Lens F.
-  public: double lensF{1.0};
-
-  /// \brief Lens fun.
-  public: std::string lensFun{"tan"};
-
-  /// \brief Lens cutoff angle.
-  public: ignition::math::Angle lensCutoffAngle{IGN_PI_2};
-
-  /// \brief lens environment texture size.
-  public: int lensEnvTextureSize{256};
-
-  /// \brief lens instrinsics fx.
-  public: double lensIntrinsicsFx{277.0};
-
-  /// \brief lens instrinsics fy.
-  public: double lensIntrinsicsFy{277.0};
+  /// \brief The image noise value.
+  public: CopyOnWrite<Noise> imageNoise;
 
-  /// \brief lens instrinsics cx.
-  public: double lensIntrinsicsCx{160.0};
+  /// \brief The distortion parameters.
+  public: CopyOnWrite<CameraDistortion> distortion;
 
-  /// \brief lens instrinsics cy.
-  public: double lensIntrinsicsCy{120.0};
-
-  /// \brief lens instrinsics s.
-  public: double lensIntrinsicsS{1.0};
-
-  /// \brief True if this camera has custom intrinsics values
-  public: bool hasIntrinsics = false;
+  /// \brief The lens parameters.
+  public: CopyOnWrite<CameraLens> lens;
 
   /// \brief Visibility mask of a camera. Defaults to 0xFFFFFFFF
   public: uint32_t visibilityMask{4294967295u};
+
+  /// \brief Undistortion table computed from the parameters above.
+  public: mutable UndistortionMapCache undistortionMap;
 };
 
 /////////////////////////////////////////////////
@@ -199,7 +303,7 @@ Errors Camera::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that sdf is a valid pointer
   if (!_sdf)
@@ -235,20 +339,16 @@ Errors Camera::Load(ElementPtr _sdf)
   if (_sdf->HasElement("distortion"))
   {
     sdf::ElementPtr elem = _sdf->GetElement("distortion");
-    this->dataPtr->distortionK1 = elem->Get<double>("k1",
-      this->dataPtr->distortionK1).first;
-    this->dataPtr->distortionK2 = elem->Get<double>("k2",
-      this->dataPtr->distortionK2).first;
-    this->dataPtr->distortionK3 = elem->Get<double>("k3",
-      this->dataPtr->distortionK3).first;
-
-    this->dataPtr->distortionP1 = elem->Get<double>("p1",
-      this->dataPtr->distortionP1).first;
-    this->dataPtr->distortionP2 = elem->Get<double>("p2",
-      this->dataPtr->distortionP2).first;
-
-    this->dataPtr->distortionCenter = elem->Get<ignition::math::Vector2d>(
-        "center", this->dataPtr->distortionCenter).first;
+    CameraDistortion &distortion = this->dataPtr->distortion.Mutable();
+    distortion.k1 = elem->Get<double>("k1", distortion.k1).first;
+    distortion.k2 = elem->Get<double>("k2", distortion.k2).first;
+    distortion.k3 = elem->Get<double>("k3", distortion.k3).first;
+
+    distortion.p1 = elem->Get<double>("p1", distortion.p1).first;
+    distortion.p2 = elem->Get<double>("p2", distortion.p2).first;
+
+    distortion.center = elem->Get<ignition::math::Vector2d>(
+        "center", distortion.center).first;
   }
 
   if (_sdf->HasElement("image"))
@@ -334,7 +434,8 @@ Errors Camera::Load(ElementPtr _sdf)
   // Load the noise values.
   if (_sdf->HasElement("noise"))
   {
-    Errors noiseErr = this->dataPtr->imageNoise.Load(_sdf->GetElement("noise"));
+    Errors noiseErr = this->dataPtr->imageNoise.Mutable().Load(
+        _sdf->GetElement("noise"));
     errors.insert(errors.end(), noiseErr.begin(), noiseErr.end());
   }
 
@@ -345,45 +446,38 @@ Errors Camera::Load(ElementPtr _sdf)
   if (_sdf->HasElement("lens"))
   {
     sdf::ElementPtr elem = _sdf->GetElement("lens");
+    CameraLens &lens = this->dataPtr->lens.Mutable();
 
-    this->dataPtr->lensType = elem->Get<std::string>("type",
-        this->dataPtr->lensType).first;
-    this->dataPtr->lensScaleToHfov = elem->Get<bool>("scale_to_hfov",
-        this->dataPtr->lensScaleToHfov).first;
-    this->dataPtr->lensCutoffAngle = elem->Get<ignition::math::Angle>(
-        "cutoff_angle", this->dataPtr->lensCutoffAngle).first;
-    this->dataPtr->lensEnvTextureSize = elem->Get<int>("env_texture_size",
-        this->dataPtr->lensEnvTextureSize).first;
+    lens.type = elem->Get<std::string>("type", lens.type).first;
+    lens.scaleToHfov = elem->Get<bool>("scale_to_hfov", lens.scaleToHfov).first;
+    lens.cutoffAngle = elem->Get<ignition::math::Angle>(
+        "cutoff_angle", lens.cutoffAngle).first;
+    lens.envTextureSize = elem->Get<int>("env_texture_size",
+        lens.envTextureSize).first;
 
     if (elem->HasElement("custom_function"))
     {
       sdf::ElementPtr func = elem->GetElement("custom_function");
-      this->dataPtr->lensC1 = func->Get<double>("c1",
-          this->dataPtr->lensC1).first;
-      this->dataPtr->lensC2 = func->Get<double>("c2",
-          this->dataPtr->lensC2).first;
-      this->dataPtr->lensC3 = func->Get<double>("c3",
-          this->dataPtr->lensC3).first;
-      this->dataPtr->lensF = func->Get<double>("f",
-          this->dataPtr->lensF).first;
-      this->dataPtr->lensFun = func->Get<std::string>("fun",
-          this->dataPtr->lensFun).first;
+      lens.c1 = func->Get<double>("c1", lens.c1).first;
+      lens.c2 = func->Get<double>("c2", lens.c2).first;
+      lens.c3 = func->Get<double>("c3", lens.c3).first;
+      lens.f = func->Get<double>("f", lens.f).first;
+      lens.fun = func->Get<std::string>("fun", lens.fun).first;
     }
 
     if (elem->HasElement("intrinsics"))
     {
       sdf::ElementPtr intrinsics = elem->GetElement("intrinsics");
-      this->dataPtr->lensIntrinsicsFx = intrinsics->Get<double>("fx",
-          this->dataPtr->lensIntrinsicsFx).first;
-      this->dataPtr->lensIntrinsicsFy = intrinsics->Get<double>("fy",
-          this->dataPtr->lensIntrinsicsFy).first;
-      this->dataPtr->lensIntrinsicsCx = intrinsics->Get<double>("cx",
-          this->dataPtr->lensIntrinsicsCx).first;
-      this->dataPtr->lensIntrinsicsCy = intrinsics->Get<double>("cy",
-          this->dataPtr->lensIntrinsicsCy).first;
-      this->dataPtr->lensIntrinsicsS = intrinsics->Get<double>("s",
-          this->dataPtr->lensIntrinsicsS).first;
-      this->dataPtr->hasIntrinsics = true;
+      lens.intrinsicsFx = intrinsics->Get<double>("fx",
+          lens.intrinsicsFx).first;
+      lens.intrinsicsFy = intrinsics->Get<double>("fy",
+          lens.intrinsicsFy).first;
+      lens.intrinsicsCx = intrinsics->Get<double>("cx",
+          lens.intrinsicsCx).first;
+      lens.intrinsicsCy = intrinsics->Get<double>("cy",
+          lens.intrinsicsCy).first;
+      lens.intrinsicsS = intrinsics->Get<double>("s", lens.intrinsicsS).first;
+      lens.hasIntrinsics = true;
     }
   }
 
@@ -685,85 +779,85 @@ bool Camera::operator!=(const Camera &_alt) const
 //////////////////////////////////////////////////
 const Noise &Camera::ImageNoise() const
 {
-  return this->dataPtr->imageNoise;
+  return *this->dataPtr->imageNoise;
 }
 
 //////////////////////////////////////////////////
 void Camera::SetImageNoise(const Noise &_noise)
 {
-  this->dataPtr->imageNoise = _noise;
+  this->dataPtr->imageNoise.Mutable() = _noise;
 }
 
 //////////////////////////////////////////////////
 double Camera::DistortionK1() const
 {
-  return this->dataPtr->distortionK1;
+  return this->dataPtr->distortion->k1;
 }
 
 //////////////////////////////////////////////////
 void Camera::SetDistortionK1(double _k1)
 {
-  this->dataPtr->distortionK1 = _k1;
+  this->dataPtr->distortion.Mutable().k1 = _k1;
 }
 
 //////////////////////////////////////////////////
 double Camera::DistortionK2() const
 {
-  return this->dataPtr->distortionK2;
+  return this->dataPtr->distortion->k2;
 }
 
 //////////////////////////////////////////////////
 void Camera::SetDistortionK2(double _k2)
 {
-  this->dataPtr->distortionK2 = _k2;
+  this->dataPtr->distortion.Mutable().k2 = _k2;
 }
 
 //////////////////////////////////////////////////
 double Camera::DistortionK3() const
 {
-  return this->dataPtr->distortionK3;
+  return this->dataPtr->distortion->k3;
 }
 
 //////////////////////////////////////////////////
 void Camera::SetDistortionK3(double _k3)
 {
-  this->dataPtr->distortionK3 = _k3;
+  this->dataPtr->distortion.Mutable().k3 = _k3;
 }
 
 //////////////////////////////////////////////////
 double Camera::DistortionP1() const
 {
-  return this->dataPtr->distortionP1;
+  return this->dataPtr->distortion->p1;
 }
 
 //////////////////////////////////////////////////
 void Camera::SetDistortionP1(double _p1)
 {
-  this->dataPtr->distortionP1 = _p1;
+  this->dataPtr->distortion.Mutable().p1 = _p1;
 }
 
 //////////////////////////////////////////////////
 double Camera::DistortionP2() const
 {
-  return this->dataPtr->distortionP2;
+  return this->dataPtr->distortion->p2;
 }
 
 //////////////////////////////////////////////////
 void Camera::SetDistortionP2(double _p2)
 {
-  this->dataPtr->distortionP2 = _p2;
+  this->dataPtr->distortion.Mutable().p2 = _p2;
 }
 
 //////////////////////////////////////////////////
 const ignition::math::Vector2d &Camera::DistortionCenter() const
 {
-  return this->dataPtr->distortionCenter;
+  return this->dataPtr->distortion->center;
 }
 
 //////////////////////////////////////////////////
 void Camera::SetDistortionCenter(const ignition::math::Vector2d &_center)
 {
-  this->dataPtr->distortionCenter = _center;
+  this->dataPtr->distortion.Mutable().center = _center;
 }
 
 /////////////////////////////////////////////////
@@ -793,174 +887,174 @@ void Camera::SetPoseRelativeTo(const std::string &_frame)
 /////////////////////////////////////////////////
 std::string Camera::LensType() const
 {
-  return this->dataPtr->lensType;
+  return this->dataPtr->lens->type;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensType(const std::string &_type)
 {
-  this->dataPtr->lensType = _type;
+  this->dataPtr->lens.Mutable().type = _type;
 }
 
 /////////////////////////////////////////////////
 bool Camera::LensScaleToHfov() const
 {
-  return this->dataPtr->lensScaleToHfov;
+  return this->dataPtr->lens->scaleToHfov;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensScaleToHfov(bool _scale)
 {
-  this->dataPtr->lensScaleToHfov = _scale;
+  this->dataPtr->lens.Mutable().scaleToHfov = _scale;
 }
 
 /////////////////////////////////////////////////
 double Camera::LensC1() const
 {
-  return this->dataPtr->lensC1;
+  return this->dataPtr->lens->c1;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensC1(double _c1)
 {
-  this->dataPtr->lensC1 = _c1;
+  this->dataPtr->lens.Mutable().c1 = _c1;
 }
 
 /////////////////////////////////////////////////
 double Camera::LensC2() const
 {
-  return this->dataPtr->lensC2;
+  return this->dataPtr->lens->c2;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensC2(double _c2)
 {
-  this->dataPtr->lensC2 = _c2;
+  this->dataPtr->lens.Mutable().c2 = _c2;
 }
 
 /////////////////////////////////////////////////
 double Camera::LensC3() const
 {
-  return this->dataPtr->lensC3;
+  return this->dataPtr->lens->c3;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensC3(double _c3)
 {
-  this->dataPtr->lensC3 = _c3;
+  this->dataPtr->lens.Mutable().c3 = _c3;
 }
 
 /////////////////////////////////////////////////
 double Camera::LensFocalLength() const
 {
-  return this->dataPtr->lensF;
+  return this->dataPtr->lens->f;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensFocalLength(double _f)
 {
-  this->dataPtr->lensF = _f;
+  this->dataPtr->lens.Mutable().f = _f;
 }
 
 /////////////////////////////////////////////////
 const std::string &Camera::LensFunction() const
 {
-  return this->dataPtr->lensFun;
+  return this->dataPtr->lens->fun;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensFunction(const std::string &_fun)
 {
-  this->dataPtr->lensFun = _fun;
+  this->dataPtr->lens.Mutable().fun = _fun;
 }
 
 /////////////////////////////////////////////////
 ignition::math::Angle Camera::LensCutoffAngle() const
 {
-  return this->dataPtr->lensCutoffAngle;
+  return this->dataPtr->lens->cutoffAngle;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensCutoffAngle(const ignition::math::Angle &_angle)
 {
-  this->dataPtr->lensCutoffAngle = _angle;
+  this->dataPtr->lens.Mutable().cutoffAngle = _angle;
 }
 
 /////////////////////////////////////////////////
 int Camera::LensEnvironmentTextureSize() const
 {
-  return this->dataPtr->lensEnvTextureSize;
+  return this->dataPtr->lens->envTextureSize;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensEnvironmentTextureSize(int _size)
 {
-  this->dataPtr->lensEnvTextureSize = _size;
+  this->dataPtr->lens.Mutable().envTextureSize = _size;
 }
 
 /////////////////////////////////////////////////
 double Camera::LensIntrinsicsFx() const
 {
-  return this->dataPtr->lensIntrinsicsFx;
+  return this->dataPtr->lens->intrinsicsFx;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensIntrinsicsFx(double _fx)
 {
-  this->dataPtr->lensIntrinsicsFx = _fx;
-  this->dataPtr->hasIntrinsics = true;
+  this->dataPtr->lens.Mutable().intrinsicsFx = _fx;
+  this->dataPtr->lens.Mutable().hasIntrinsics = true;
 }
 
 /////////////////////////////////////////////////
 double Camera::LensIntrinsicsFy() const
 {
-  return this->dataPtr->lensIntrinsicsFy;
+  return this->dataPtr->lens->intrinsicsFy;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensIntrinsicsFy(double _fy)
 {
-  this->dataPtr->lensIntrinsicsFy = _fy;
-  this->dataPtr->hasIntrinsics = true;
+  this->dataPtr->lens.Mutable().intrinsicsFy = _fy;
+  this->dataPtr->lens.Mutable().hasIntrinsics = true;
 }
 
 /////////////////////////////////////////////////
 double Camera::LensIntrinsicsCx() const
 {
-  return this->dataPtr->lensIntrinsicsCx;
+  return this->dataPtr->lens->intrinsicsCx;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensIntrinsicsCx(double _cx)
 {
-  this->dataPtr->lensIntrinsicsCx = _cx;
-  this->dataPtr->hasIntrinsics = true;
+  this->dataPtr->lens.Mutable().intrinsicsCx = _cx;
+  this->dataPtr->lens.Mutable().hasIntrinsics = true;
 }
 
 /////////////////////////////////////////////////
 double Camera::LensIntrinsicsCy() const
 {
-  return this->dataPtr->lensIntrinsicsCy;
+  return this->dataPtr->lens->intrinsicsCy;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensIntrinsicsCy(double _cy)
 {
-  this->dataPtr->lensIntrinsicsCy = _cy;
-  this->dataPtr->hasIntrinsics = true;
+  this->dataPtr->lens.Mutable().intrinsicsCy = _cy;
+  this->dataPtr->lens.Mutable().hasIntrinsics = true;
 }
 
 /////////////////////////////////////////////////
 double Camera::LensIntrinsicsSkew() const
 {
-  return this->dataPtr->lensIntrinsicsS;
+  return this->dataPtr->lens->intrinsicsS;
 }
 
 /////////////////////////////////////////////////
 void Camera::SetLensIntrinsicsSkew(double _s)
 {
-  this->dataPtr->lensIntrinsicsS = _s;
-  this->dataPtr->hasIntrinsics = true;
+  this->dataPtr->lens.Mutable().intrinsicsS = _s;
+  this->dataPtr->lens.Mutable().hasIntrinsics = true;
 }
 
 /////////////////////////////////////////////////
@@ -1020,7 +1114,81 @@ void Camera::SetVisibilityMask(uint32_t _mask)
 /////////////////////////////////////////////////
 bool Camera::HasLensIntrinsics() const
 {
-  return this->dataPtr->hasIntrinsics;
+  return this->dataPtr->lens->hasIntrinsics;
+}
+
+/////////////////////////////////////////////////
+ignition::math::Matrix3d Camera::IntrinsicsMatrix() const
+{
+  const CameraLens &lens = *this->dataPtr->lens;
+  if (lens.hasIntrinsics)
+  {
+    return ignition::math::Matrix3d(
+        lens.intrinsicsFx, lens.intrinsicsS, lens.intrinsicsCx,
+        0.0, lens.intrinsicsFy, lens.intrinsicsCy,
+        0.0, 0.0, 1.0);
+  }
+
+  const double width = this->dataPtr->imageWidth;
+  const double height = this->dataPtr->imageHeight;
+  const double f = width / (2.0 * std::tan(this->dataPtr->hfov.Radian() / 2.0));
+  return ignition::math::Matrix3d(
+      f, 0.0, width / 2.0,
+      0.0, f, height / 2.0,
+      0.0, 0.0, 1.0);
+}
+
+/////////////////////////////////////////////////
+const CameraUndistortionMap &Camera::UndistortionMap() const
+{
+  const ignition::math::Matrix3d intrinsics = this->IntrinsicsMatrix();
+  const CameraDistortion &distortion = *this->dataPtr->distortion;
+  const uint32_t width = this->dataPtr->imageWidth;
+  const uint32_t height = this->dataPtr->imageHeight;
+  const double fx = intrinsics(0, 0);
+  const double fy = intrinsics(1, 1);
+  const double centerX = distortion.center.X() * width;
+  const double centerY = distortion.center.Y() * height;
+
+  const std::vector<double> key = {
+      static_cast<double>(width), static_cast<double>(height), fx, fy,
+      distortion.k1, distortion.k2, distortion.k3, distortion.p1,
+      distortion.p2, centerX, centerY};
+
+  auto &cache = this->dataPtr->undistortionMap;
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  if (cache.key == key)
+    return cache.map;
+
+  CameraUndistortionMap &map = cache.map;
+  map.width = width;
+  map.height = height;
+  const std::size_t size = static_cast<std::size_t>(width) * height;
+  map.x.resize(size);
+  map.y.resize(size);
+
+  for (uint32_t v = 0; v < height; ++v)
+  {
+    const double yn = (v - centerY) / fy;
+    for (uint32_t u = 0; u < width; ++u)
+    {
+      const double xn = (u - centerX) / fx;
+      const double r2 = xn * xn + yn * yn;
+      const double radial = 1.0 + r2 * (distortion.k1 +
+          r2 * (distortion.k2 + r2 * distortion.k3));
+      const double xd = xn * radial + 2.0 * distortion.p1 * xn * yn +
+          distortion.p2 * (r2 + 2.0 * xn * xn);
+      const double yd = yn * radial + distortion.p1 * (r2 + 2.0 * yn * yn) +
+          2.0 * distortion.p2 * xn * yn;
+
+      const std::size_t index = static_cast<std::size_t>(v) * width + u;
+      map.x[index] = static_cast<float>(xd * fx + centerX);
+      map.y[index] = static_cast<float>(yd * fy + centerY);
+    }
+  }
+
+  cache.key = key;
+  return map;
 }
 
 /////////////////////////////////////////////////
@@ -1064,7 +1232,7 @@ sdf::ElementPtr Camera::ToElement() const
 
   sdf::ElementPtr noiseElem = elem->GetElement("noise");
   std::string noiseType;
-  switch (this->dataPtr->imageNoise.Type())
+  switch (this->dataPtr->imageNoise->Type())
   {
     case sdf::NoiseType::NONE:
       noiseType = "none";
@@ -1081,9 +1249,10 @@ sdf::ElementPtr Camera::ToElement() const
 
   // camera does not use noise.sdf description
   noiseElem->GetElement("type")->Set<std::string>(noiseType);
-  noiseElem->GetElement("mean")->Set<double>(this->dataPtr->imageNoise.Mean());
+  noiseElem->GetElement("mean")->Set<double>(
+      this->dataPtr->imageNoise->Mean());
   noiseElem->GetElement("stddev")->Set<double>(
-      this->dataPtr->imageNoise.StdDev());
+      this->dataPtr->imageNoise->StdDev());
 
   sdf::ElementPtr distortionElem = elem->GetElement("distortion");
   distortionElem->GetElement("k1")->Set<double>(this->DistortionK1());
@@ -264,3 +264,99 @@ TEST(DOMCamera, ToElement)
   cam3.Load(cam2Elem);
   EXPECT_DOUBLE_EQ(0.33, cam3.NearClip());
 }
+
+/////////////////////////////////////////////////
+TEST(DOMCamera, SharedDefaults)
+{
+  // Cameras start out sharing their default parameter groups, so modifying
+  // one camera must not be visible through another.
+  sdf::Camera cam;
+  sdf::Camera cam2;
+  cam2.SetDistortionK1(0.1);
+  cam2.SetLensType("custom");
+  EXPECT_DOUBLE_EQ(0.0, cam.DistortionK1());
+  EXPECT_EQ("stereographic", cam.LensType());
+  EXPECT_DOUBLE_EQ(0.1, cam2.DistortionK1());
+  EXPECT_EQ("custom", cam2.LensType());
+
+  sdf::Camera cam3(cam2);
+  cam3.SetDistortionK1(0.2);
+  cam3.SetLensIntrinsicsFx(1.0);
+  sdf::Noise noise;
+  noise.SetMean(0.5);
+  cam3.SetImageNoise(noise);
+  EXPECT_DOUBLE_EQ(0.1, cam2.DistortionK1());
+  EXPECT_FALSE(cam2.HasLensIntrinsics());
+  EXPECT_DOUBLE_EQ(0.0, cam2.ImageNoise().Mean());
+  EXPECT_DOUBLE_EQ(0.2, cam3.DistortionK1());
+  EXPECT_TRUE(cam3.HasLensIntrinsics());
+  EXPECT_EQ("custom", cam3.LensType());
+  EXPECT_DOUBLE_EQ(0.5, cam3.ImageNoise().Mean());
+
+  sdf::Camera cam4;
+  EXPECT_DOUBLE_EQ(0.0, cam4.DistortionK1());
+  EXPECT_FALSE(cam4.HasLensIntrinsics());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMCamera, IntrinsicsMatrix)
+{
+  sdf::Camera cam;
+  cam.SetImageWidth(640);
+  cam.SetImageHeight(480);
+  cam.SetHorizontalFov(IGN_PI_2);
+
+  // Without lens intrinsics, the matrix comes from the field of view.
+  ignition::math::Matrix3d intrinsics = cam.IntrinsicsMatrix();
+  EXPECT_NEAR(320.0, intrinsics(0, 0), 1e-9);
+  EXPECT_NEAR(320.0, intrinsics(1, 1), 1e-9);
+  EXPECT_DOUBLE_EQ(0.0, intrinsics(0, 1));
+  EXPECT_DOUBLE_EQ(320.0, intrinsics(0, 2));
+  EXPECT_DOUBLE_EQ(240.0, intrinsics(1, 2));
+  EXPECT_DOUBLE_EQ(1.0, intrinsics(2, 2));
+
+  cam.SetLensIntrinsicsFx(300);
+  cam.SetLensIntrinsicsFy(310);
+  cam.SetLensIntrinsicsCx(330);
+  cam.SetLensIntrinsicsCy(250);
+  cam.SetLensIntrinsicsSkew(0.5);
+  EXPECT_EQ(ignition::math::Matrix3d(300, 0.5, 330, 0, 310, 250, 0, 0, 1),
+            cam.IntrinsicsMatrix());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMCamera, UndistortionMap)
+{
+  sdf::Camera cam;
+  cam.SetImageWidth(4);
+  cam.SetImageHeight(2);
+
+  // Without distortion, every pixel maps to itself.
+  const sdf::CameraUndistortionMap *map = &cam.UndistortionMap();
+  EXPECT_EQ(4u, map->width);
+  EXPECT_EQ(2u, map->height);
+  ASSERT_EQ(8u, map->x.size());
+  ASSERT_EQ(8u, map->y.size());
+  for (uint32_t v = 0; v < 2; ++v)
+  {
+    for (uint32_t u = 0; u < 4; ++u)
+    {
+      EXPECT_NEAR(u, map->x[v * 4 + u], 1e-5);
+      EXPECT_NEAR(v, map->y[v * 4 + u], 1e-5);
+    }
+  }
+
+  // The table is kept until a parameter changes.
+  EXPECT_EQ(map, &cam.UndistortionMap());
+  const std::vector<float> undistorted = map->x;
+
+  // With barrel distortion, pixels away from the distortion center sample
+  // the distorted image closer to the center.
+  cam.SetDistortionK1(-0.5);
+  map = &cam.UndistortionMap();
+  ASSERT_EQ(8u, map->x.size());
+  EXPECT_GT(map->x[0], undistorted[0]);
+  EXPECT_LT(map->x[3], undistorted[3]);
+  EXPECT_NEAR(2.0f, map->x[2], 1e-5);
+  EXPECT_NEAR(1.0f, map->y[2 + 4], 1e-5);
+}
@@ -17,6 +17,7 @@
 #include <sstream>
 #include "sdf/Capsule.hh"
 #include "sdf/parser.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
@@ -41,7 +42,7 @@ Errors Capsule::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that sdf is a valid pointer
   if (!_sdf)
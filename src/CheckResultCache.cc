@@ -0,0 +1,176 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "sdf/Filesystem.hh"
+#include "CheckResultCache.hh"
+#include "UpgradedFile.hh"
+#include "Utils.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/// \brief First line of the files that store check results.
+static constexpr char kCheckResultHeader[] = "sdformat-check-result 1";
+
+/////////////////////////////////////////////////
+/// \brief Get the text that the files that store check results are keyed
+/// by, besides the path of the checked file: the version of the library,
+/// which decides what is valid, and the paths that included models are
+/// found in.
+/// \return The text.
+static std::string checkResultContext()
+{
+  const char *sdfPath = std::getenv("SDF_PATH");
+  return std::string(SDF_VERSION_FULL) + "\n" +
+      (sdfPath ? sdfPath : "") + "\n";
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a text preceded by its size, so that it may contain any
+/// character.
+/// \param[in,out] _out Stream to write to.
+/// \param[in] _text The text.
+static void writeSizedText(std::ostream &_out, const std::string &_text)
+{
+  _out << _text.size() << "\n" << _text;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a text written by writeSizedText.
+/// \param[in,out] _in Stream to read from.
+/// \param[out] _text The text.
+/// \return True if the text was read.
+static bool readSizedText(std::istream &_in, std::string &_text)
+{
+  std::size_t size = 0;
+  if (!(_in >> size) || _in.get() != '\n')
+    return false;
+  _text.resize(size);
+  return size == 0 || static_cast<bool>(
+      _in.read(&_text[0], static_cast<std::streamsize>(size)));
+}
+
+/////////////////////////////////////////////////
+std::string checkResultPath(const std::string &_cacheDir,
+    const std::string &_path)
+{
+  std::uint64_t hash = kFnvOffsetBasis;
+  hashString(hash, checkResultContext());
+  hashString(hash, _path);
+
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash << ".check";
+  return filesystem::append(_cacheDir, name.str());
+}
+
+/////////////////////////////////////////////////
+bool readCheckResult(const std::string &_cacheDir, const std::string &_path,
+    CheckResultEntry &_entry)
+{
+  std::ifstream in(checkResultPath(_cacheDir, _path), std::ios::binary);
+  if (!in)
+    return false;
+
+  // The key is stored too, so that hash collisions are not mistaken for
+  // results of the file.
+  std::string line;
+  std::string key;
+  if (!std::getline(in, line) || line != kCheckResultHeader ||
+      !readSizedText(in, key) || key != checkResultContext() + _path)
+  {
+    return false;
+  }
+
+  CheckResultEntry entry;
+  std::size_t fileCount = 0;
+  if (!(in >> entry.result >> fileCount) || in.get() != '\n')
+    return false;
+  for (std::size_t i = 0; i < fileCount; ++i)
+  {
+    std::string hash;
+    std::string file;
+    if (!std::getline(in, hash) || !std::getline(in, file))
+      return false;
+    const std::string currentHash = fileContentHash(file);
+    if (currentHash.empty() || currentHash != hash)
+      return false;
+    entry.files.insert(file);
+  }
+
+  if (!readSizedText(in, entry.output) || !readSizedText(in, entry.errors))
+    return false;
+
+  _entry = std::move(entry);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool writeCheckResult(const std::string &_cacheDir, const std::string &_path,
+    const CheckResultEntry &_entry)
+{
+  std::ostringstream content;
+  content << kCheckResultHeader << "\n";
+  writeSizedText(content, checkResultContext() + _path);
+  content << _entry.result << " " << _entry.files.size() << "\n";
+  for (const std::string &file : _entry.files)
+  {
+    const std::string hash = fileContentHash(file);
+    // A file that was read by the check and cannot be hashed now would
+    // never match, so the result is not worth storing.
+    if (hash.empty() || file.find('\n') != std::string::npos)
+      return false;
+    content << hash << "\n" << file << "\n";
+  }
+  writeSizedText(content, _entry.output);
+  writeSizedText(content, _entry.errors);
+
+  filesystem::create_directories(_cacheDir);
+  const std::string path = checkResultPath(_cacheDir, _path);
+  std::ostringstream tmpName;
+  tmpName << path << ".tmp" << std::random_device()();
+  const std::string tmpPath = tmpName.str();
+  {
+    std::ofstream out(tmpPath, std::ios::binary);
+    const std::string text = content.str();
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    if (!out)
+    {
+      out.close();
+      filesystem::remove(tmpPath);
+      return false;
+    }
+  }
+
+  if (!filesystem::rename(tmpPath, path))
+  {
+    filesystem::remove(tmpPath);
+    return false;
+  }
+  return true;
+}
+}
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_CHECKRESULTCACHE_HH
+#define SDFORMAT_CHECKRESULTCACHE_HH
+
+#include <set>
+#include <string>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Result of checking a file with `ign sdf --check`, as it is
+  /// stored in a check result cache directory.
+  struct CheckResultEntry
+  {
+    /// \brief Zero if the file is valid, negative one otherwise.
+    int result = -1;
+
+    /// \brief Text written to the standard output by the check.
+    std::string output;
+
+    /// \brief Text written to the standard error by the check.
+    std::string errors;
+
+    /// \brief Paths of the files that the check read, such as the checked
+    /// file and the files of its included models.
+    std::set<std::string> files;
+  };
+
+  /// \brief Get the path of the file that stores the result of checking a
+  /// file in a cache directory. There is one file for each checked file,
+  /// version of the library and value of the SDF_PATH environment variable.
+  /// \param[in] _cacheDir The cache directory.
+  /// \param[in] _path Path of the checked file.
+  /// \return Path of the file that stores the result.
+  std::string checkResultPath(const std::string &_cacheDir,
+      const std::string &_path);
+
+  /// \brief Read the stored result of checking a file. The result is only
+  /// returned if none of the files that the check read has changed since,
+  /// as told by their content hashes.
+  /// \param[in] _cacheDir The cache directory.
+  /// \param[in] _path Path of the checked file.
+  /// \param[out] _entry The stored result.
+  /// \return True if a result is stored and is still current.
+  bool readCheckResult(const std::string &_cacheDir, const std::string &_path,
+      CheckResultEntry &_entry);
+
+  /// \brief Store the result of checking a file, with the content hashes of
+  /// the files that the check read. The file is written under a temporary
+  /// name and then renamed, so that concurrent checks never read partial
+  /// results.
+  /// \param[in] _cacheDir The cache directory, which is created if needed.
+  /// \param[in] _path Path of the checked file.
+  /// \param[in] _entry The result to store.
+  /// \return True if the result was stored.
+  bool writeCheckResult(const std::string &_cacheDir, const std::string &_path,
+      const CheckResultEntry &_entry);
+  }
+}
+#endif
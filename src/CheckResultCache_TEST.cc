@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "sdf/Filesystem.hh"
+#include "CheckResultCache.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _content Content of the file.
+static void writeFile(const std::string &_path, const std::string &_content)
+{
+  std::ofstream out(_path, std::ios::binary);
+  out << _content;
+}
+
+/////////////////////////////////////////////////
+TEST(CheckResultCache, ReadWrite)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string dir = sdf::filesystem::append(tmpDir, "check_cache");
+  const std::string cacheDir = sdf::filesystem::append(dir, "cache");
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+
+  const std::string world = sdf::filesystem::append(dir, "world.sdf");
+  const std::string model = sdf::filesystem::append(dir, "model.sdf");
+  writeFile(world, "<sdf version='1.9'><world name='w'/></sdf>");
+  writeFile(model, "<sdf version='1.9'><model name='m'/></sdf>");
+
+  sdf::CheckResultEntry entry;
+  EXPECT_FALSE(sdf::readCheckResult(cacheDir, world, entry));
+
+  entry.result = 0;
+  entry.output = "Valid.\n";
+  entry.errors = "Warning:\nwith two lines\n";
+  entry.files = {world, model};
+  EXPECT_TRUE(sdf::writeCheckResult(cacheDir, world, entry));
+  EXPECT_TRUE(std::filesystem::exists(
+      sdf::checkResultPath(cacheDir, world)));
+  EXPECT_NE(sdf::checkResultPath(cacheDir, world),
+            sdf::checkResultPath(cacheDir, model));
+
+  sdf::CheckResultEntry stored;
+  ASSERT_TRUE(sdf::readCheckResult(cacheDir, world, stored));
+  EXPECT_EQ(0, stored.result);
+  EXPECT_EQ(entry.output, stored.output);
+  EXPECT_EQ(entry.errors, stored.errors);
+  EXPECT_EQ(entry.files, stored.files);
+
+  // There is no result for the other file.
+  EXPECT_FALSE(sdf::readCheckResult(cacheDir, model, stored));
+
+  // The result is stale once a file that was read changes.
+  writeFile(model, "<sdf version='1.9'><model name='n'/></sdf>");
+  EXPECT_FALSE(sdf::readCheckResult(cacheDir, world, stored));
+
+  EXPECT_TRUE(sdf::writeCheckResult(cacheDir, world, entry));
+  EXPECT_TRUE(sdf::readCheckResult(cacheDir, world, stored));
+
+  // And when it is removed.
+  std::filesystem::remove(model);
+  EXPECT_FALSE(sdf::readCheckResult(cacheDir, world, stored));
+
+  // A result is not stored if a file cannot be read.
+  EXPECT_FALSE(sdf::writeCheckResult(cacheDir, world, entry));
+}
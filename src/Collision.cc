@@ -23,8 +23,10 @@
 #include "sdf/parser.hh"
 #include "sdf/Surface.hh"
 #include "sdf/Types.hh"
+#include "DomInterner.hh"
 #include "FrameSemantics.hh"
 #include "ScopedGraph.hh"
+#include "ScopedTraceEvent.hh"
 #include "Utils.hh"
 
 using namespace sdf;
@@ -40,11 +42,15 @@ class sdf::Collision::Implementation
   /// \brief Frame of the pose.
   public: std::string poseRelativeTo = "";
 
-  /// \brief The collision's geometry.
-  public: Geometry geom;
+  /// \brief The collision's geometry, which may be shared with other
+  /// collisions and visuals and is replaced instead of modified.
+  public: std::shared_ptr<const Geometry> geom =
+      std::make_shared<const Geometry>();
 
-  /// \brief The collision's surface parameters.
-  public: sdf::Surface surface;
+  /// \brief The collision's surface parameters, which may be shared like
+  /// the geometry.
+  public: std::shared_ptr<const sdf::Surface> surface =
+      std::make_shared<const sdf::Surface>();
 
   /// \brief The SDF element pointer used during load.
   public: sdf::ElementPtr sdf;
@@ -65,9 +71,10 @@ Collision::Collision()
 /////////////////////////////////////////////////
 Errors Collision::Load(ElementPtr _sdf)
 {
+  ScopedTraceEvent event("Collision::Load", "dom");
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <collision>
   // This is an error that cannot be recovered, so return an error.
@@ -98,13 +105,17 @@ Errors Collision::Load(ElementPtr _sdf)
   loadPose(_sdf, this->dataPtr->pose, this->dataPtr->poseRelativeTo);
 
   // Load the geometry
-  Errors geomErr = this->dataPtr->geom.Load(_sdf->GetElement("geometry"));
+  auto geom = std::make_shared<Geometry>();
+  Errors geomErr = geom->Load(_sdf->GetElement("geometry"));
   errors.insert(errors.end(), geomErr.begin(), geomErr.end());
+  this->dataPtr->geom = std::move(geom);
 
   // Load the surface parameters if they are given
   if (_sdf->HasElement("surface"))
   {
-    this->dataPtr->surface.Load(_sdf->GetElement("surface"));
+    auto surface = std::make_shared<sdf::Surface>();
+    surface->Load(_sdf->GetElement("surface"));
+    this->dataPtr->surface = std::move(surface);
   }
 
   return errors;
@@ -125,25 +136,32 @@ void Collision::SetName(const std::string &_name)
 /////////////////////////////////////////////////
 const Geometry *Collision::Geom() const
 {
-  return &this->dataPtr->geom;
+  return this->dataPtr->geom.get();
 }
 
 /////////////////////////////////////////////////
 void Collision::SetGeom(const Geometry &_geom)
 {
-  this->dataPtr->geom = _geom;
+  this->dataPtr->geom = std::make_shared<const Geometry>(_geom);
 }
 
 /////////////////////////////////////////////////
 const sdf::Surface *Collision::Surface() const
 {
-  return &this->dataPtr->surface;
+  return this->dataPtr->surface.get();
 }
 
 /////////////////////////////////////////////////
 void Collision::SetSurface(const sdf::Surface &_surface)
 {
-  this->dataPtr->surface = _surface;
+  this->dataPtr->surface = std::make_shared<const sdf::Surface>(_surface);
+}
+
+/////////////////////////////////////////////////
+void Collision::ShareProperties(DomInterner &_interner)
+{
+  this->dataPtr->geom = _interner.Share(this->dataPtr->geom);
+  this->dataPtr->surface = _interner.Share(this->dataPtr->surface);
 }
 
 /////////////////////////////////////////////////
@@ -193,6 +211,15 @@ sdf::SemanticPose Collision::SemanticPose() const
       this->dataPtr->poseRelativeToGraph);
 }
 
+/////////////////////////////////////////////////
+Errors Collision::ResolvePose(ignition::math::Pose3d &_pose,
+    const std::string &_resolveTo) const
+{
+  return resolveSemanticPose(_pose, this->dataPtr->poseRelativeToGraph, "",
+      this->dataPtr->pose, this->dataPtr->poseRelativeTo,
+      this->dataPtr->xmlParentName, _resolveTo);
+}
+
 /////////////////////////////////////////////////
 sdf::ElementPtr Collision::Element() const
 {
@@ -217,10 +244,10 @@ sdf::ElementPtr Collision::ToElement() const
   poseElem->Set<ignition::math::Pose3d>(this->RawPose());
 
   // Set the geometry
-  elem->InsertElement(this->dataPtr->geom.ToElement(), true);
+  elem->InsertElement(this->dataPtr->geom->ToElement(), true);
 
   // Set the surface
-  elem->InsertElement(this->dataPtr->surface.ToElement(), true);
+  elem->InsertElement(this->dataPtr->surface->ToElement(), true);
 
   return elem;
 }
@@ -15,11 +15,22 @@
  *
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <streambuf>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "sdf/Console.hh"
 #include "sdf/Filesystem.hh"
@@ -35,16 +46,519 @@ static std::mutex g_instance_mutex;
 /// \todo Output disabled for windows, to allow tests to pass. We should
 /// disable output just for tests on windows.
 #ifndef _WIN32
-static bool g_quiet = false;
+static std::atomic<bool> g_quiet{false};
 #else
-static bool g_quiet = true;
+static std::atomic<bool> g_quiet{true};
 #endif
 
 static Console::ConsoleStream g_NullStream(nullptr);
 
+/// \brief True when messages are written asynchronously.
+static std::atomic<bool> g_async{false};
+
+/// \brief True once the console instance is created, so that the flags
+/// below describe it.
+static std::atomic<bool> g_created{false};
+
+/// \brief True when the console instance has a log sink. Updated with its
+/// logFileMutex held, and read without locking by Console::LogReported.
+static std::atomic<bool> g_hasLogSink{false};
+
+/// \brief Message stream of the console instance.
+static std::atomic<Console::ConsoleStream *> g_instanceMsgStream{nullptr};
+
+/// \brief True when the message stream of the console instance has a
+/// stream to write to.
+static std::atomic<bool> g_hasMsgStream{true};
+
+/// \brief Log sink chosen with Console::SetLogSink, protected by
+/// g_instance_mutex.
+struct LogSinkSetting
+{
+  /// \brief True to write to the log file in the home directory.
+  bool useFile = true;
+
+  /// \brief Stream to write to when useFile is false and there is no
+  /// callback.
+  std::ostream *stream = nullptr;
+
+  /// \brief Callback that receives the lines of the log.
+  Console::LogCallback callback;
+};
+
+/// \brief The chosen log sink.
+static LogSinkSetting g_logSinkSetting;
+
+namespace
+{
+/// \brief A message queued in asynchronous mode.
+struct AsyncMessage
+{
+  /// \brief Text of the message, without its prefix.
+  std::string text;
+
+  /// \brief Stream to write the message to, besides the log file.
+  std::ostream *stream = nullptr;
+
+  /// \brief True if the message starts with a prefix.
+  bool hasPrefix = false;
+
+  /// \brief Label of the prefix when it is a string literal.
+  const char *label = nullptr;
+
+  /// \brief File of the prefix when it is a string literal.
+  const char *file = nullptr;
+
+  /// \brief Label of the prefix when it is copied.
+  std::string ownedLabel;
+
+  /// \brief File of the prefix when it is copied.
+  std::string ownedFile;
+
+  /// \brief Line of the prefix.
+  unsigned int line = 0;
+
+  /// \brief Color of the label of the prefix.
+  int color = 0;
+};
+
+/// \brief Stream buffer that appends to a string.
+class StringAppendBuffer : public std::streambuf
+{
+  /// \brief Constructor.
+  /// \param[in] _str String to append to.
+  public: explicit StringAppendBuffer(std::string &_str) : str(_str) {}
+
+  // Documentation inherited.
+  protected: int_type overflow(int_type _c) override
+  {
+    if (!traits_type::eq_int_type(_c, traits_type::eof()))
+      this->str.push_back(traits_type::to_char_type(_c));
+    return traits_type::not_eof(_c);
+  }
+
+  // Documentation inherited.
+  protected: std::streamsize xsputn(const char *_s, std::streamsize _n)
+      override
+  {
+    this->str.append(_s, static_cast<std::size_t>(_n));
+    return _n;
+  }
+
+  /// \brief String to append to.
+  private: std::string &str;
+};
+
+/// \brief Stream buffer that gives complete lines to a callback.
+class CallbackBuffer : public std::streambuf
+{
+  /// \brief Constructor.
+  /// \param[in] _callback Function that receives the lines.
+  public: explicit CallbackBuffer(Console::LogCallback _callback)
+          : callback(std::move(_callback)) {}
+
+  // Documentation inherited.
+  protected: int_type overflow(int_type _c) override
+  {
+    if (!traits_type::eq_int_type(_c, traits_type::eof()))
+    {
+      const char c = traits_type::to_char_type(_c);
+      this->xsputn(&c, 1);
+    }
+    return traits_type::not_eof(_c);
+  }
+
+  // Documentation inherited.
+  protected: std::streamsize xsputn(const char *_s, std::streamsize _n)
+      override
+  {
+    std::string_view text(_s, static_cast<std::size_t>(_n));
+    for (auto end = text.find('\n'); end != std::string_view::npos;
+         end = text.find('\n'))
+    {
+      this->line.append(text.substr(0, end + 1));
+      this->callback(this->line);
+      this->line.clear();
+      text.remove_prefix(end + 1);
+    }
+    this->line.append(text);
+    return _n;
+  }
+
+  /// \brief Function that receives the lines.
+  private: Console::LogCallback callback;
+
+  /// \brief Line being written.
+  private: std::string line;
+};
+
+/// \brief Stream that gives complete lines to a callback.
+class CallbackStream : public std::ostream
+{
+  /// \brief Constructor.
+  /// \param[in] _callback Function that receives the lines.
+  public: explicit CallbackStream(Console::LogCallback _callback)
+          : std::ostream(nullptr), buffer(std::move(_callback))
+  {
+    this->rdbuf(&this->buffer);
+  }
+
+  /// \brief The buffer.
+  private: CallbackBuffer buffer;
+};
+
+/// \brief Message that a thread is writing in asynchronous mode.
+struct PendingMessage
+{
+  /// \brief Constructor.
+  PendingMessage() : buffer(message.text), stream(&buffer) {}
+
+  /// \brief The message.
+  AsyncMessage message;
+
+  /// \brief Buffer that appends to the text of the message.
+  StringAppendBuffer buffer;
+
+  /// \brief Stream that formats values into the text of the message.
+  std::ostream stream;
+};
+
+/// \brief Lock-free ring buffer of the messages of one thread, which is the
+/// only producer, consumed by the writer thread.
+class AsyncRing
+{
+  /// \brief Queue a message.
+  /// \param[in,out] _message The message, moved from if it is queued.
+  /// \return False if the ring is full.
+  public: bool TryPush(AsyncMessage &_message)
+  {
+    const std::size_t head = this->head.load(std::memory_order_relaxed);
+    if (head - this->tail.load(std::memory_order_acquire) == kCapacity)
+      return false;
+    this->messages[head % kCapacity] = std::move(_message);
+    this->head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// \brief Take the oldest message.
+  /// \param[out] _message The message.
+  /// \return False if the ring is empty.
+  public: bool TryPop(AsyncMessage &_message)
+  {
+    const std::size_t tail = this->tail.load(std::memory_order_relaxed);
+    if (tail == this->head.load(std::memory_order_acquire))
+      return false;
+    _message = std::move(this->messages[tail % kCapacity]);
+    this->tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// \brief Check if the ring is empty.
+  /// \return True if there is no message in the ring.
+  public: bool Empty() const
+  {
+    return this->tail.load(std::memory_order_acquire) ==
+        this->head.load(std::memory_order_acquire);
+  }
+
+  /// \brief Number of messages that a ring holds.
+  private: static constexpr std::size_t kCapacity = 256;
+
+  /// \brief The messages.
+  private: std::array<AsyncMessage, kCapacity> messages;
+
+  /// \brief Number of messages pushed.
+  private: std::atomic<std::size_t> head {0};
+
+  /// \brief Number of messages popped.
+  private: std::atomic<std::size_t> tail {0};
+};
+
+/// \brief Function that writes a batch of messages.
+using AsyncWriteFunction = std::function<void(std::vector<AsyncMessage> &)>;
+
+/// \brief Background thread that writes the messages of all the rings.
+class AsyncWriter
+{
+  /// \brief Destructor. Writes the queued messages.
+  public: ~AsyncWriter()
+  {
+    this->Stop();
+  }
+
+  /// \brief Start the writer thread, if it is not running.
+  /// \param[in] _write Function that writes messages.
+  public: void Start(AsyncWriteFunction _write)
+  {
+    std::lock_guard<std::mutex> lock(this->controlMutex);
+    if (this->running)
+      return;
+    this->write = std::move(_write);
+    this->running = true;
+    this->thread = std::thread(&AsyncWriter::Run, this);
+  }
+
+  /// \brief Stop the writer thread once it has written the queued
+  /// messages.
+  public: void Stop()
+  {
+    std::lock_guard<std::mutex> lock(this->controlMutex);
+    if (!this->running)
+      return;
+    this->running = false;
+    this->wake.notify_one();
+    this->thread.join();
+    this->Drain();
+  }
+
+  /// \brief Queue a message of the calling thread.
+  /// \param[in,out] _message The message, moved from.
+  public: void Push(AsyncMessage &_message)
+  {
+    AsyncRing &ring = this->ThreadRing();
+    ++this->queued;
+    while (!ring.TryPush(_message))
+    {
+      // The writer is behind, or was stopped, in which case the queued
+      // messages are written here to make room
+      if (!this->running)
+      {
+        this->DrainStopped();
+        continue;
+      }
+      this->wake.notify_one();
+      std::this_thread::yield();
+    }
+
+    if (this->running)
+    {
+      this->wake.notify_one();
+      return;
+    }
+
+    // The writer was stopped, possibly after the message was started, and
+    // will not take it from the ring
+    this->DrainStopped();
+  }
+
+  /// \brief Wait until the messages queued so far are written.
+  public: void Flush()
+  {
+    const uint64_t target = this->queued;
+    while (this->running && this->written < target)
+    {
+      this->wake.notify_one();
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+
+  /// \brief Body of the writer thread.
+  private: void Run()
+  {
+    while (this->running)
+    {
+      if (!this->Drain())
+      {
+        std::unique_lock<std::mutex> lock(this->wakeMutex);
+        this->wake.wait_for(lock, std::chrono::milliseconds(10));
+      }
+    }
+    this->Drain();
+  }
+
+  /// \brief Write the messages of all the rings if the writer thread is
+  /// stopped. This is serialized with Start and Stop, so that the messages
+  /// are not written at the same time as the last ones of Stop.
+  private: void DrainStopped()
+  {
+    std::lock_guard<std::mutex> lock(this->controlMutex);
+    if (!this->running)
+      this->Drain();
+  }
+
+  /// \brief Write the messages of all the rings.
+  /// \return True if there were messages.
+  private: bool Drain()
+  {
+    std::vector<std::shared_ptr<AsyncRing>> rings;
+    {
+      // Rings of threads that exited are dropped once they are empty
+      std::lock_guard<std::mutex> lock(this->ringsMutex);
+      auto unused = [](const std::shared_ptr<AsyncRing> &_ring)
+      {
+        return _ring.use_count() == 1 && _ring->Empty();
+      };
+      this->rings.erase(std::remove_if(this->rings.begin(), this->rings.end(),
+          unused), this->rings.end());
+      rings = this->rings;
+    }
+
+    this->batch.clear();
+    AsyncMessage message;
+    for (const auto &ring : rings)
+    {
+      while (ring->TryPop(message))
+        this->batch.push_back(std::move(message));
+    }
+    if (this->batch.empty())
+      return false;
+
+    this->write(this->batch);
+    this->written += this->batch.size();
+    return true;
+  }
+
+  /// \brief Get the ring of the calling thread, creating it on first use.
+  /// \return The ring.
+  private: AsyncRing &ThreadRing()
+  {
+    thread_local std::shared_ptr<AsyncRing> ring;
+    if (!ring)
+    {
+      ring = std::make_shared<AsyncRing>();
+      std::lock_guard<std::mutex> lock(this->ringsMutex);
+      this->rings.push_back(ring);
+    }
+    return *ring;
+  }
+
+  /// \brief Rings of the threads that queued messages.
+  private: std::vector<std::shared_ptr<AsyncRing>> rings;
+
+  /// \brief Mutex that protects rings.
+  private: std::mutex ringsMutex;
+
+  /// \brief Messages taken from the rings by the writer thread.
+  private: std::vector<AsyncMessage> batch;
+
+  /// \brief Function that writes messages.
+  private: AsyncWriteFunction write;
+
+  /// \brief The writer thread.
+  private: std::thread thread;
+
+  /// \brief True while the writer thread runs.
+  private: std::atomic<bool> running {false};
+
+  /// \brief Mutex that serializes Start, Stop and DrainStopped.
+  private: std::mutex controlMutex;
+
+  /// \brief Mutex for wake.
+  private: std::mutex wakeMutex;
+
+  /// \brief Wakes up the writer thread when messages are queued.
+  private: std::condition_variable wake;
+
+  /// \brief Number of messages queued.
+  private: std::atomic<uint64_t> queued {0};
+
+  /// \brief Number of messages written.
+  private: std::atomic<uint64_t> written {0};
+};
+}
+
+/// \brief Writer of the asynchronous mode. It is defined after the console
+/// instance so that it writes the queued messages before the instance is
+/// destroyed at exit.
+static AsyncWriter g_asyncWriter;
+
 //////////////////////////////////////////////////
-Console::Console()
-  : dataPtr(new ConsolePrivate)
+/// \brief Get the message that the calling thread is writing in
+/// asynchronous mode.
+/// \return The message.
+static PendingMessage &threadPendingMessage()
+{
+  thread_local PendingMessage pending;
+  return pending;
+}
+
+//////////////////////////////////////////////////
+/// \brief Queue the message that the calling thread is writing.
+/// \param[in,out] _pending The message, which is cleared.
+static void commitPendingMessage(PendingMessage &_pending)
+{
+  g_asyncWriter.Push(_pending.message);
+  _pending.message.text.clear();
+  _pending.message.hasPrefix = false;
+  _pending.message.label = nullptr;
+  _pending.message.file = nullptr;
+  _pending.message.ownedLabel.clear();
+  _pending.message.ownedFile.clear();
+}
+
+//////////////////////////////////////////////////
+/// \brief Start a message with a prefix in asynchronous mode.
+/// \param[in] _stream Stream to write the message to.
+/// \param[in] _line Line of the prefix.
+/// \param[in] _color Color of the label of the prefix.
+/// \return The message, whose label and file are to be set.
+static AsyncMessage &startAsyncMessage(std::ostream *_stream,
+    unsigned int _line, int _color)
+{
+  // Text without a final newline is written as a message of its own
+  PendingMessage &pending = threadPendingMessage();
+  if (!pending.message.text.empty())
+    commitPendingMessage(pending);
+
+  pending.message.stream = _stream;
+  pending.message.hasPrefix = true;
+  pending.message.line = _line;
+  pending.message.color = _color;
+  return pending.message;
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a message prefix.
+/// \param[out] _out Stream to write to.
+/// \param[in] _lbl Text label.
+/// \param[in] _file File containing the message, of which only the name
+/// is written.
+/// \param[in] _line Line containing the message.
+/// \param[in] _color Color to make the label.
+/// \param[in] _colored True to color the label, which is only done on
+/// terminals.
+static void writePrefix(std::ostream &_out, std::string_view _lbl,
+    std::string_view _file, unsigned int _line, int _color, bool _colored)
+{
+  _file.remove_prefix(_file.find_last_of("/") + 1);
+
+  (void)_color;
+  (void)_colored;
+#ifndef _WIN32
+  if (_colored)
+  {
+    _out << "\033[1;" << _color << "m" << _lbl << " [" << _file << ":" <<
+      _line << "]\033[0m ";
+    return;
+  }
+#endif
+  _out << _lbl << " [" << _file << ":" << _line << "] ";
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a message prefix to a stream and to the log file.
+/// \param[in] _stream Stream to write to, can be nullptr.
+/// \param[in] _console Console that holds the log file.
+/// \param[in] _lbl Text label.
+/// \param[in] _file File containing the message.
+/// \param[in] _line Line containing the message.
+/// \param[in] _color Color to make the label on the stream.
+static void writeSyncPrefix(std::ostream *_stream, ConsolePrivate &_console,
+    std::string_view _lbl, std::string_view _file, unsigned int _line,
+    int _color)
+{
+  if (_stream)
+    writePrefix(*_stream, _lbl, _file, _line, _color, true);
+
+  std::lock_guard<std::mutex> lock(_console.logFileMutex);
+  if (_console.logSink)
+    writePrefix(*_console.logSink, _lbl, _file, _line, _color, false);
+}
+
+//////////////////////////////////////////////////
+/// \brief Open the log file in the home directory.
+/// \param[in,out] _console Console to open the log file of.
+static void openLogFile(ConsolePrivate &_console)
 {
 #ifndef SDFORMAT_DISABLE_CONSOLE_LOGFILE
   // Set up the file that we'll log to.
@@ -73,10 +587,55 @@ Console::Console()
     return;
   }
   std::string logFile = sdf::filesystem::append(logDir, "sdformat.log");
-  this->dataPtr->logFileStream.open(logFile.c_str(), std::ios::out);
+  _console.logFilePath = logFile;
+  _console.logFileStream.open(logFile.c_str(), std::ios::out);
+  if (_console.logFileStream.is_open())
+    _console.logSink = &_console.logFileStream;
+#else
+  (void)_console;
 #endif
 }
 
+//////////////////////////////////////////////////
+/// \brief Set up the log sink of a console.
+/// \param[in,out] _console The console.
+/// \param[in] _setting The log sink to use.
+static void applyLogSink(ConsolePrivate &_console,
+                         const LogSinkSetting &_setting)
+{
+  std::lock_guard<std::mutex> lock(_console.logFileMutex);
+  _console.logSink = nullptr;
+  _console.logFileStream.close();
+  _console.logFilePath.clear();
+  _console.logCallbackStream.reset();
+
+  if (_setting.useFile)
+  {
+    openLogFile(_console);
+  }
+  else if (_setting.callback)
+  {
+    _console.logCallbackStream =
+        std::make_unique<CallbackStream>(_setting.callback);
+    _console.logSink = _console.logCallbackStream.get();
+  }
+  else
+  {
+    _console.logSink = _setting.stream;
+  }
+  g_hasLogSink = _console.logSink != nullptr;
+}
+
+//////////////////////////////////////////////////
+Console::Console()
+  : dataPtr(new ConsolePrivate)
+{
+  // Instance holds g_instance_mutex, which protects g_logSinkSetting
+  applyLogSink(*this->dataPtr, g_logSinkSetting);
+  g_instanceMsgStream = &this->dataPtr->msgStream;
+  g_hasMsgStream = this->dataPtr->msgStream.GetStream() != nullptr;
+}
+
 //////////////////////////////////////////////////
 Console::~Console()
 {
@@ -89,6 +648,7 @@ ConsolePtr Console::Instance()
   if (!myself)
   {
     myself.reset(new Console());
+    g_created = true;
   }
 
   return myself;
@@ -100,6 +660,7 @@ void Console::Clear()
   std::lock_guard<std::mutex> lock(g_instance_mutex);
 
   myself = nullptr;
+  g_created = false;
 }
 
 //////////////////////////////////////////////////
@@ -108,6 +669,155 @@ void Console::SetQuiet(bool _quiet)
   g_quiet = _quiet;
 }
 
+//////////////////////////////////////////////////
+void Console::SetAsync(bool _async)
+{
+  if (!_async)
+  {
+    g_async = false;
+    g_asyncWriter.Stop();
+    return;
+  }
+
+  g_asyncWriter.Start([](std::vector<AsyncMessage> &_messages)
+  {
+    auto label = [](const AsyncMessage &_message)
+    {
+      return _message.label ? std::string_view(_message.label) :
+          std::string_view(_message.ownedLabel);
+    };
+    auto file = [](const AsyncMessage &_message)
+    {
+      return _message.file ? std::string_view(_message.file) :
+          std::string_view(_message.ownedFile);
+    };
+
+    for (const auto &message : _messages)
+    {
+      if (!message.stream)
+        continue;
+      if (message.hasPrefix)
+      {
+        writePrefix(*message.stream, label(message), file(message),
+                    message.line, message.color, true);
+      }
+      *message.stream << message.text;
+    }
+
+    ConsolePtr instance = Console::Instance();
+    ConsolePrivate *console = instance->dataPtr.get();
+    std::lock_guard<std::mutex> lock(console->logFileMutex);
+    if (!console->logSink)
+      return;
+    for (const auto &message : _messages)
+    {
+      if (message.hasPrefix)
+      {
+        writePrefix(*console->logSink, label(message), file(message),
+                    message.line, message.color, false);
+      }
+      *console->logSink << message.text;
+    }
+    console->logSink->flush();
+  });
+  g_async = true;
+}
+
+//////////////////////////////////////////////////
+bool Console::Async() const
+{
+  return g_async;
+}
+
+//////////////////////////////////////////////////
+void Console::Flush()
+{
+  g_asyncWriter.Flush();
+}
+
+//////////////////////////////////////////////////
+void Console::SetLogFileEnabled(bool _enabled)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->logFileMutex);
+  if (!_enabled)
+  {
+    if (this->dataPtr->logSink == &this->dataPtr->logFileStream)
+      this->dataPtr->logSink = nullptr;
+    this->dataPtr->logFileStream.close();
+  }
+  else if (!this->dataPtr->logFileStream.is_open() &&
+           !this->dataPtr->logFilePath.empty())
+  {
+    this->dataPtr->logFileStream.open(this->dataPtr->logFilePath.c_str(),
+                                      std::ios::out | std::ios::app);
+    if (this->dataPtr->logFileStream.is_open())
+      this->dataPtr->logSink = &this->dataPtr->logFileStream;
+  }
+  g_hasLogSink = this->dataPtr->logSink != nullptr;
+}
+
+//////////////////////////////////////////////////
+void Console::SetLogSink(std::ostream *_stream)
+{
+  std::lock_guard<std::mutex> lock(g_instance_mutex);
+  g_logSinkSetting = LogSinkSetting();
+  g_logSinkSetting.useFile = false;
+  g_logSinkSetting.stream = _stream;
+  if (myself)
+    applyLogSink(*myself->dataPtr, g_logSinkSetting);
+}
+
+//////////////////////////////////////////////////
+void Console::SetLogSink(LogCallback _callback)
+{
+  std::lock_guard<std::mutex> lock(g_instance_mutex);
+  g_logSinkSetting = LogSinkSetting();
+  g_logSinkSetting.useFile = false;
+  g_logSinkSetting.callback = std::move(_callback);
+  if (myself)
+    applyLogSink(*myself->dataPtr, g_logSinkSetting);
+}
+
+//////////////////////////////////////////////////
+void Console::ResetLogSink()
+{
+  std::lock_guard<std::mutex> lock(g_instance_mutex);
+  g_logSinkSetting = LogSinkSetting();
+  if (myself)
+    applyLogSink(*myself->dataPtr, g_logSinkSetting);
+}
+
+//////////////////////////////////////////////////
+bool Console::Quiet() const
+{
+  return g_quiet;
+}
+
+//////////////////////////////////////////////////
+bool Console::HasLogSink() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->logFileMutex);
+  return this->dataPtr->logSink != nullptr;
+}
+
+//////////////////////////////////////////////////
+bool Console::WarningsReported()
+{
+  // Creating the console sets up its log sink, so the flags only describe
+  // it afterwards
+  if (!g_created)
+    Console::Instance();
+  return (!g_quiet && g_hasMsgStream) || g_hasLogSink;
+}
+
+//////////////////////////////////////////////////
+bool Console::LogReported()
+{
+  if (!g_created)
+    Console::Instance();
+  return g_hasLogSink;
+}
+
 //////////////////////////////////////////////////
 sdf::Console::ConsoleStream &Console::GetMsgStream()
 {
@@ -145,38 +855,89 @@ Console::ConsoleStream &Console::Log(const std::string &lbl,
   return this->dataPtr->logStream;
 }
 
+//////////////////////////////////////////////////
+Console::ConsoleStream &Console::ColorMsg(const char *_lbl,
+                                          const char *_file,
+                                          unsigned int _line, int _color)
+{
+  if (!g_quiet)
+  {
+    this->dataPtr->msgStream.Prefix(_lbl, _file, _line, _color);
+    return this->dataPtr->msgStream;
+  }
+  else
+  {
+    return g_NullStream;
+  }
+}
+
+//////////////////////////////////////////////////
+Console::ConsoleStream &Console::Log(const char *_lbl, const char *_file,
+                                     unsigned int _line)
+{
+  this->dataPtr->logStream.Prefix(_lbl, _file, _line, 0);
+  return this->dataPtr->logStream;
+}
+
 //////////////////////////////////////////////////
 void Console::ConsoleStream::Prefix(const std::string &_lbl,
                                     const std::string &_file,
                                     unsigned int _line,
                                     int _color)
 {
-  size_t index = _file.find_last_of("/") + 1;
-
-  (void)_color;
-  if (this->stream)
+  if (g_async)
   {
-#ifndef _WIN32
-    *this->stream << "\033[1;" << _color << "m" << _lbl << " [" <<
-      _file.substr(index , _file.size() - index) << ":" << _line <<
-      "]\033[0m ";
-#else
-    *this->stream << _lbl << " [" <<
-      _file.substr(index , _file.size() - index) << ":" << _line << "] ";
-#endif
+    AsyncMessage &message = startAsyncMessage(this->stream, _line, _color);
+    message.ownedLabel = _lbl;
+    message.ownedFile = _file;
+    return;
   }
 
-  if (Console::Instance()->dataPtr->logFileStream.is_open())
+  writeSyncPrefix(this->stream, *Console::Instance()->dataPtr, _lbl, _file,
+                  _line, _color);
+}
+
+//////////////////////////////////////////////////
+void Console::ConsoleStream::Prefix(const char *_lbl, const char *_file,
+                                    unsigned int _line, int _color)
+{
+  if (g_async)
   {
-    Console::Instance()->dataPtr->logFileStream << _lbl << " [" <<
-      _file.substr(index , _file.size() - index)<< ":" << _line << "] ";
+    AsyncMessage &message = startAsyncMessage(this->stream, _line, _color);
+    message.label = _lbl;
+    message.file = _file;
+    return;
   }
+
+  writeSyncPrefix(this->stream, *Console::Instance()->dataPtr, _lbl, _file,
+                  _line, _color);
+}
+
+//////////////////////////////////////////////////
+std::ostream *Console::ConsoleStream::AsyncBuffer()
+{
+  if (!g_async)
+    return nullptr;
+
+  PendingMessage &pending = threadPendingMessage();
+  pending.message.stream = this->stream;
+  return &pending.stream;
+}
+
+//////////////////////////////////////////////////
+void Console::ConsoleStream::AsyncCommit()
+{
+  PendingMessage &pending = threadPendingMessage();
+  if (!pending.message.text.empty() && pending.message.text.back() == '\n')
+    commitPendingMessage(pending);
 }
 
 //////////////////////////////////////////////////
 void Console::ConsoleStream::SetStream(std::ostream *_stream)
 {
   this->stream = _stream;
+  if (this == g_instanceMsgStream)
+    g_hasMsgStream = _stream != nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -15,7 +15,11 @@
  *
  */
 
+#include <fstream>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -121,6 +125,162 @@ TEST(Console, quiet)
   con->SetQuiet(false);
 }
 
+////////////////////////////////////////////////////
+/// Test writing messages from several threads in asynchronous mode.
+TEST(Console, Async)
+{
+  sdf::ConsolePtr con = sdf::Console::Instance();
+  std::stringstream buffer;
+  std::ostream *oldStream = con->GetMsgStream().GetStream();
+  con->GetMsgStream().SetStream(&buffer);
+
+  con->SetAsync(true);
+  EXPECT_TRUE(con->Async());
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([i]()
+    {
+      for (int j = 0; j < 1000; ++j)
+        sdfwarn << "Warning " << i << " " << j << ".\n";
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  con->Flush();
+
+  // Each message is written whole, with its prefix
+  int count = 0;
+  std::string line;
+  while (std::getline(buffer, line))
+  {
+    EXPECT_NE(std::string::npos, line.find("Warning [Console_TEST.cc:"))
+        << line;
+    EXPECT_EQ('.', line.back()) << line;
+    ++count;
+  }
+  EXPECT_EQ(4000, count);
+
+  // Messages queued before the mode is disabled are written
+  buffer.clear();
+  buffer.str("");
+  sdferr << "Last " << 1 << ".\n";
+  con->SetAsync(false);
+  EXPECT_FALSE(con->Async());
+  EXPECT_NE(std::string::npos, buffer.str().find("Last 1.")) << buffer.str();
+
+  con->GetMsgStream().SetStream(oldStream);
+}
+
+#ifndef _WIN32
+////////////////////////////////////////////////////
+/// Test disabling the log file.
+TEST(Console, LogFileEnabled)
+{
+  sdf::Console::Clear();
+
+  std::string temp_dir;
+  ASSERT_TRUE(create_new_temp_dir(temp_dir));
+  ASSERT_EQ(setenv("HOME", temp_dir.c_str(), 1), 0);
+  sdf::ConsolePtr con = sdf::Console::Instance();
+  const std::string logFile = temp_dir + "/.sdformat/sdformat.log";
+
+  con->SetLogFileEnabled(false);
+  sdfdbg << "Not logged.\n";
+  con->SetLogFileEnabled(true);
+  sdfdbg << "Logged.\n";
+
+  std::ifstream log(logFile);
+  if (log.is_open())
+  {
+    std::stringstream contents;
+    contents << log.rdbuf();
+    EXPECT_EQ(std::string::npos, contents.str().find("Not logged."));
+    EXPECT_NE(std::string::npos, contents.str().find("Logged."));
+  }
+  sdf::Console::Clear();
+}
+
+////////////////////////////////////////////////////
+/// Test writing the log to a stream or a callback instead of the log file.
+TEST(Console, LogSink)
+{
+  sdf::Console::Clear();
+
+  std::string temp_dir;
+  ASSERT_TRUE(create_new_temp_dir(temp_dir));
+  ASSERT_EQ(setenv("HOME", temp_dir.c_str(), 1), 0);
+
+  std::vector<std::string> lines;
+  sdf::Console::SetLogSink([&lines](const std::string &_line)
+  {
+    lines.push_back(_line);
+  });
+  sdfdbg << "First " << 1 << ".\n";
+  sdfdbg << "Second.\n";
+  ASSERT_EQ(2u, lines.size());
+  EXPECT_NE(std::string::npos, lines[0].find("Dbg [Console_TEST.cc:"));
+  EXPECT_NE(std::string::npos, lines[0].find("First 1.\n"));
+  EXPECT_NE(std::string::npos, lines[1].find("Second.\n"));
+
+  // The log directory is never created
+  FILE *fp = fopen((temp_dir + "/.sdformat").c_str(), "r");
+  EXPECT_EQ(nullptr, fp);
+  if (fp)
+    fclose(fp);
+
+  std::stringstream buffer;
+  sdf::Console::SetLogSink(&buffer);
+  sdfdbg << "Third.\n";
+  EXPECT_NE(std::string::npos, buffer.str().find("Third.\n"));
+  EXPECT_EQ(2u, lines.size());
+
+  sdf::Console::SetLogSink(nullptr);
+  sdfdbg << "Dropped.\n";
+  EXPECT_EQ(std::string::npos, buffer.str().find("Dropped."));
+
+  sdf::Console::ResetLogSink();
+  sdf::Console::Clear();
+}
+
+////////////////////////////////////////////////////
+/// Test the lock-free checks of whether messages are shown or logged.
+TEST(Console, Reported)
+{
+  sdf::Console::Clear();
+  sdf::Console::SetLogSink(nullptr);
+  sdf::ConsolePtr con = sdf::Console::Instance();
+  con->SetQuiet(false);
+  EXPECT_TRUE(sdf::Console::WarningsReported());
+  EXPECT_FALSE(sdf::Console::LogReported());
+
+  con->SetQuiet(true);
+  EXPECT_FALSE(sdf::Console::WarningsReported());
+
+  con->SetQuiet(false);
+  std::ostream *stream = con->GetMsgStream().GetStream();
+  con->GetMsgStream().SetStream(nullptr);
+  EXPECT_FALSE(sdf::Console::WarningsReported());
+  con->GetMsgStream().SetStream(stream);
+  EXPECT_TRUE(sdf::Console::WarningsReported());
+
+  std::stringstream buffer;
+  sdf::Console::SetLogSink(&buffer);
+  con->SetQuiet(true);
+  EXPECT_TRUE(sdf::Console::WarningsReported());
+  EXPECT_TRUE(sdf::Console::LogReported());
+
+  // A console created after Clear reports its own log sink
+  sdf::Console::Clear();
+  sdf::Console::SetLogSink(nullptr);
+  EXPECT_FALSE(sdf::Console::LogReported());
+
+  con->SetQuiet(false);
+  sdf::Console::ResetLogSink();
+  sdf::Console::Clear();
+}
+#endif  // _WIN32
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
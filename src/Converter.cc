@@ -17,9 +17,11 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -30,10 +32,296 @@
 
 #include "Converter.hh"
 #include "EmbeddedSdf.hh"
+#include "PerfCounting.hh"
+#include "ScopedTraceEvent.hh"
+#include "Utils.hh"
 #include "XmlUtils.hh"
 
 using namespace sdf;
 
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE
+{
+/////////////////////////////////////////////////
+/// \brief The map, copy and move operations of a convert xml document,
+/// with their paths split into tokens and their value maps built once. A
+/// recipe is applied to every matching element of the converted document,
+/// so this saves splitting and comparing the same strings at every element.
+/// The plan is only read once it is built, so it can be shared by
+/// concurrent conversions.
+class ConversionPlan
+{
+  /// \brief Compiled <map> operation.
+  public: struct MapOperation
+  {
+    /// \brief Error printed whenever the operation is applied, if the
+    /// <map> element is malformed.
+    std::string error;
+
+    /// \brief Names of the elements above the 'from' element or attribute.
+    std::vector<std::string> fromParents;
+
+    /// \brief Last token of the 'from' path.
+    std::string fromLeaf;
+
+    /// \brief Names of the elements above the 'to' element or attribute.
+    std::vector<std::string> toParents;
+
+    /// \brief Last token of the 'to' path.
+    std::string toLeaf;
+
+    /// \brief Number of leading elements of toParents that are the same
+    /// as those of fromParents, which are found by the 'from' lookup.
+    std::size_t sharedParents = 0;
+
+    /// \brief Output values keyed by input value.
+    std::map<std::string, std::string> values;
+  };
+
+  /// \brief Compiled <copy> or <move> operation.
+  public: struct MoveOperation
+  {
+    /// \brief False if the element lacks a <from> or <to> child.
+    bool valid = false;
+
+    /// \brief Whether the <from> and <to> elements have element and
+    /// attribute attributes.
+    bool fromElement = false;
+    bool fromAttribute = false;
+    bool toElement = false;
+    bool toAttribute = false;
+
+    /// \brief Attribute attribute of the <to> element.
+    std::string toAttributeName;
+
+    /// \brief Tokens of the 'from' and 'to' paths.
+    std::vector<std::string> fromTokens;
+    std::vector<std::string> toTokens;
+
+    /// \brief Number of leading parent elements of toTokens that are the
+    /// same as those of fromTokens.
+    std::size_t sharedParents = 0;
+  };
+
+  /// \brief Compile the operations of a convert element and its children.
+  /// \param[in] _convert Root element of a convert xml document, or null.
+  public: explicit ConversionPlan(const tinyxml2::XMLElement *_convert)
+  {
+    if (_convert)
+      this->Compile(_convert);
+  }
+
+  /// \brief Get a compiled <map> operation.
+  /// \param[in] _mapElem A <map> element of the convert xml document.
+  /// \return The compiled operation.
+  public: const MapOperation &Map(const tinyxml2::XMLElement *_mapElem) const
+  {
+    auto it = this->maps.find(_mapElem);
+    SDF_ASSERT(it != this->maps.end(), "Map element is not in the plan");
+    return it->second;
+  }
+
+  /// \brief Get a compiled <copy> or <move> operation.
+  /// \param[in] _moveElem A <copy> or <move> element of the convert xml
+  /// document.
+  /// \return The compiled operation.
+  public: const MoveOperation &Move(
+              const tinyxml2::XMLElement *_moveElem) const
+  {
+    auto it = this->moves.find(_moveElem);
+    SDF_ASSERT(it != this->moves.end(), "Move element is not in the plan");
+    return it->second;
+  }
+
+  /// \brief Check whether the convert xml document lists deprecated
+  /// elements. Most recipes do not, so the converted document is not
+  /// searched for them.
+  /// \return True if the document has a <deprecated> element.
+  public: bool HasDeprecations() const
+  {
+    return this->deprecations;
+  }
+
+  /// \brief Count the leading tokens that two parent paths share.
+  /// \param[in] _a Tokens of the first path, including its leaf.
+  /// \param[in] _b Tokens of the second path, including its leaf.
+  /// \return Number of shared leading parent tokens.
+  private: static std::size_t SharedParents(
+               const std::vector<std::string> &_a,
+               const std::vector<std::string> &_b)
+  {
+    std::size_t count = 0;
+    while (count + 1 < _a.size() && count + 1 < _b.size() &&
+           _a[count] == _b[count])
+    {
+      ++count;
+    }
+    return count;
+  }
+
+  /// \brief Compile the operations below an element.
+  /// \param[in] _elem Element of the convert xml document.
+  private: void Compile(const tinyxml2::XMLElement *_elem)
+  {
+    for (auto *child = _elem->FirstChildElement(); child;
+         child = child->NextSiblingElement())
+    {
+      const char *name = child->Name();
+      if (strcmp(name, "map") == 0)
+        this->maps[child] = CompileMap(child);
+      else if (strcmp(name, "copy") == 0 || strcmp(name, "move") == 0)
+        this->moves[child] = CompileMove(child);
+      else if (strcmp(name, "convert") == 0)
+        this->Compile(child);
+      else if (strcmp(name, "deprecated") == 0)
+        this->deprecations = true;
+    }
+  }
+
+  /// \brief Compile a <map> element.
+  /// \param[in] _mapElem The <map> element.
+  /// \return The compiled operation.
+  private: static MapOperation CompileMap(
+               const tinyxml2::XMLElement *_mapElem)
+  {
+    MapOperation op;
+    auto *fromConvertElem = _mapElem->FirstChildElement("from");
+    auto *toConvertElem = _mapElem->FirstChildElement("to");
+
+    if (!fromConvertElem)
+    {
+      op.error = "<map> element requires a <from> child element.\n";
+      return op;
+    }
+    if (!toConvertElem)
+    {
+      op.error = "<map> element requires a <to> child element.\n";
+      return op;
+    }
+
+    const char *fromNameStr = fromConvertElem->Attribute("name");
+    const char *toNameStr = toConvertElem->Attribute("name");
+
+    if (!fromNameStr || strlen(fromNameStr) == 0)
+    {
+      op.error = "Map: <from> element requires a non-empty name attribute.\n";
+      return op;
+    }
+    if (!toNameStr || strlen(toNameStr) == 0)
+    {
+      op.error = "Map: <to> element requires a non-empty name attribute.\n";
+      return op;
+    }
+
+    // create map of input and output values
+    auto *fromValueElem = fromConvertElem->FirstChildElement("value");
+    auto *toValueElem = toConvertElem->FirstChildElement("value");
+    if (!fromValueElem)
+    {
+      op.error =
+          "Map: <from> element requires at least one <value> element.\n";
+      return op;
+    }
+    if (!toValueElem)
+    {
+      op.error = "Map: <to> element requires at least one <value> element.\n";
+      return op;
+    }
+    while (fromValueElem)
+    {
+      if (!fromValueElem->GetText())
+      {
+        op.error = "Map: from value must not be empty.\n";
+        return op;
+      }
+      if (!toValueElem->GetText())
+      {
+        op.error = "Map: to value must not be empty.\n";
+        return op;
+      }
+      op.values[fromValueElem->GetText()] = toValueElem->GetText();
+
+      fromValueElem = fromValueElem->NextSiblingElement("value");
+      if (fromValueElem && toValueElem->NextSiblingElement("value"))
+      {
+        toValueElem = toValueElem->NextSiblingElement("value");
+      }
+    }
+
+    // split() always returns at least one element, even with the
+    // empty string.
+    std::vector<std::string> fromTokens = split(fromNameStr, "/");
+    std::vector<std::string> toTokens = split(toNameStr, "/");
+    op.sharedParents = SharedParents(fromTokens, toTokens);
+    op.fromLeaf = fromTokens.back();
+    fromTokens.pop_back();
+    op.fromParents = std::move(fromTokens);
+    op.toLeaf = toTokens.back();
+    toTokens.pop_back();
+    op.toParents = std::move(toTokens);
+    return op;
+  }
+
+  /// \brief Compile a <copy> or <move> element.
+  /// \param[in] _moveElem The <copy> or <move> element.
+  /// \return The compiled operation.
+  private: static MoveOperation CompileMove(
+               const tinyxml2::XMLElement *_moveElem)
+  {
+    MoveOperation op;
+    auto *fromConvertElem = _moveElem->FirstChildElement("from");
+    auto *toConvertElem = _moveElem->FirstChildElement("to");
+    if (!fromConvertElem || !toConvertElem)
+      return op;
+    op.valid = true;
+
+    const char *fromElemStr = fromConvertElem->Attribute("element");
+    const char *fromAttrStr = fromConvertElem->Attribute("attribute");
+    const char *toElemStr = toConvertElem->Attribute("element");
+    const char *toAttrStr = toConvertElem->Attribute("attribute");
+
+    op.fromElement = fromElemStr != nullptr;
+    op.fromAttribute = fromAttrStr != nullptr;
+    op.toElement = toElemStr != nullptr;
+    op.toAttribute = toAttrStr != nullptr;
+    if (toAttrStr)
+      op.toAttributeName = toAttrStr;
+
+    // tokenize 'from' and 'to' strs
+    std::string fromStr = "";
+    if (fromElemStr)
+      fromStr = fromElemStr;
+    else if (fromAttrStr)
+      fromStr = fromAttrStr;
+    std::string toStr = "";
+    if (toElemStr)
+      toStr = toElemStr;
+    else if (toAttrStr)
+      toStr = toAttrStr;
+
+    // split() always returns at least one element, even with the
+    // empty string.
+    op.fromTokens = split(fromStr, "::");
+    op.toTokens = split(toStr, "::");
+    op.sharedParents = SharedParents(op.fromTokens, op.toTokens);
+    return op;
+  }
+
+  /// \brief Compiled <map> operations keyed by element.
+  private: std::unordered_map<const tinyxml2::XMLElement *, MapOperation>
+      maps;
+
+  /// \brief Compiled <copy> and <move> operations keyed by element.
+  private: std::unordered_map<const tinyxml2::XMLElement *, MoveOperation>
+      moves;
+
+  /// \brief True if the document has a <deprecated> element.
+  private: bool deprecations = false;
+};
+}
+}
+
 namespace {
 bool EndsWith(const std::string& _a, const std::string& _b)
 {
@@ -41,6 +329,62 @@ bool EndsWith(const std::string& _a, const std::string& _b)
       (_a.compare(_a.size() - _b.size(), _b.size(), _b) == 0);
 }
 
+/////////////////////////////////////////////////
+/// \brief One step of the version upgrade, parsed from an embedded
+/// conversion recipe.
+struct ConversionStep
+{
+  /// \brief Version that this step converts to.
+  std::string toVersion;
+
+  /// \brief Parsed conversion recipe. It is only ever read, so it can be
+  /// shared by concurrent conversions.
+  std::unique_ptr<tinyxml2::XMLDocument> xmlDoc;
+
+  /// \brief Compiled operations of the recipe.
+  std::unique_ptr<ConversionPlan> plan;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the conversion steps of the embedded files database, keyed by
+/// the version they convert from. The recipes are parsed the first time this
+/// is called and then reused for every conversion in the process.
+/// \return Map from source version to conversion step.
+const std::map<std::string, ConversionStep> &ConversionSteps()
+{
+  static const std::map<std::string, ConversionStep> steps = []()
+  {
+    // The conversion recipes within the embedded files database are named,
+    // e.g., "1.8/1_7.convert" to upgrade from 1.7 to 1.8.
+    const std::string extension = ".convert";
+    std::map<std::string, ConversionStep> result;
+    for (const EmbeddedSdfFile &file : GetEmbeddedSdf())
+    {
+      const std::string pathname(file.pathname);
+      const std::size_t slash = pathname.rfind('/');
+      if (slash == std::string::npos || !EndsWith(pathname, extension))
+        continue;
+
+      std::string fromVersion = pathname.substr(slash + 1,
+          pathname.size() - slash - 1 - extension.size());
+      std::replace(fromVersion.begin(), fromVersion.end(), '_', '.');
+
+      // Keep the first match for a version, as the linear search did.
+      if (result.find(fromVersion) != result.end())
+        continue;
+
+      ConversionStep &step = result[fromVersion];
+      step.toVersion = pathname.substr(0, slash);
+      step.xmlDoc = std::make_unique<tinyxml2::XMLDocument>();
+      step.xmlDoc->Parse(file.content.data(), file.content.size());
+      step.plan = std::make_unique<ConversionPlan>(
+          step.xmlDoc->FirstChildElement("convert"));
+    }
+    return result;
+  }();
+  return steps;
+}
+
 /////////////////////////////////////////////////
 // returns true if the element is not one of the listed for Unflatten conversion
 bool IsNotFlattenedElement(const std::string &_elemName)
@@ -49,6 +393,86 @@ bool IsNotFlattenedElement(const std::string &_elemName)
           && _elemName != "model" && _elemName != "gripper");
 }
 
+/////////////////////////////////////////////////
+/// \brief Collect the element and attribute names that a convert element
+/// and its children refer to.
+/// \param[in] _convert Convert xml element tree.
+/// \param[out] _names Names referred to by _convert.
+/// \return False if _convert contains an operation that can touch elements
+/// that are not named in it, such as unflatten.
+bool CollectConvertNames(const tinyxml2::XMLElement *_convert,
+                         std::set<std::string> &_names)
+{
+  if (strcmp(_convert->Name(), "unflatten") == 0)
+    return false;
+
+  for (const char *attrName : {"name", "descendant_name", "element",
+                               "attribute"})
+  {
+    const char *value = _convert->Attribute(attrName);
+    if (!value)
+      continue;
+
+    for (const auto &path : split(value, "/"))
+    {
+      for (auto token : split(path, "::"))
+      {
+        if (!token.empty() && token[0] == '@')
+          token.erase(0, 1);
+        _names.insert(token);
+      }
+    }
+  }
+
+  for (auto *child = _convert->FirstChildElement(); child;
+       child = child->NextSiblingElement())
+  {
+    if (!CollectConvertNames(child, _names))
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the descendant conversions, starting at _first, that can be
+/// applied in a single traversal of the document. Conversions only modify
+/// the subtree of the element they match, so consecutive descendant
+/// conversions that refer to disjoint sets of names cannot observe each
+/// other's changes and give the same result in any interleaving.
+/// \param[in] _first Convert element with a descendant_name attribute.
+/// \return _first followed by the sibling conversions that can share its
+/// traversal.
+std::vector<tinyxml2::XMLElement *> FusableDescendantConverts(
+    tinyxml2::XMLElement *_first)
+{
+  std::vector<tinyxml2::XMLElement *> group = {_first};
+
+  std::set<std::string> groupNames;
+  if (!CollectConvertNames(_first, groupNames))
+    return group;
+
+  for (auto *next = _first->NextSiblingElement("convert");
+       next && next->Attribute("descendant_name") && !next->Attribute("name");
+       next = next->NextSiblingElement("convert"))
+  {
+    std::set<std::string> names;
+    if (!CollectConvertNames(next, names))
+      break;
+
+    bool disjoint = std::none_of(names.begin(), names.end(),
+        [&groupNames](const std::string &_name)
+        {
+          return groupNames.count(_name) > 0;
+        });
+    if (!disjoint)
+      break;
+
+    groupNames.insert(names.begin(), names.end());
+    group.push_back(next);
+  }
+  return group;
+}
+
 /////////////////////////////////////////////////
 // used to update //pose/@relative_to in FindNewModelElements()
 void UpdatePose(tinyxml2::XMLElement *_elem,
@@ -78,6 +502,7 @@ bool Converter::Convert(tinyxml2::XMLDocument *_doc,
                         bool _quiet)
 {
   SDF_ASSERT(_doc != nullptr, "SDF XML doc is NULL");
+  ScopedTraceEvent event("Converter::Convert", "conversion", _toVersion);
 
   tinyxml2::XMLElement *elem = _doc->FirstChildElement("sdf");
 
@@ -111,43 +536,29 @@ bool Converter::Convert(tinyxml2::XMLDocument *_doc,
 
   elem->SetAttribute("version", _toVersion.c_str());
 
-  // The conversion recipes within the embedded files database are named, e.g.,
-  // "1.8/1_7.convert" to upgrade from 1.7 to 1.8.
-  const std::map<std::string, std::string> &embedded = GetEmbeddedSdf();
+  const std::map<std::string, ConversionStep> &steps = ConversionSteps();
 
   // Apply the conversions one at a time until we reach the desired _toVersion.
   std::string curVersion = origVersion;
   while (curVersion != _toVersion)
   {
-    // Find the (at most one) file named, e.g., ".../1_7.convert".
-    std::string snakeVersion = curVersion;
-    std::replace(snakeVersion.begin(), snakeVersion.end(), '.', '_');
-    const std::string suffix = "/" + snakeVersion + ".convert";
-    const char* convertXml = nullptr;
-    for (const auto& [pathname, data] : embedded)
-    {
-      if (EndsWith(pathname, suffix))
-      {
-        curVersion = pathname.substr(0, pathname.size() - suffix.size());
-        convertXml = data.c_str();
-        break;
-      }
-    }
-    if (convertXml == nullptr)
+    auto stepIter = steps.find(curVersion);
+    if (stepIter == steps.end())
     {
       break;
     }
 
-    // Parse and apply the conversion XML.
-    tinyxml2::XMLDocument xmlDoc;
-    xmlDoc.Parse(convertXml);
-    if (xmlDoc.Error())
+    // Apply the cached conversion XML.
+    const ConversionStep &step = stepIter->second;
+    curVersion = step.toVersion;
+    if (step.xmlDoc->Error())
     {
       sdferr << "Error parsing XML from string: "
-             << xmlDoc.ErrorStr() << '\n';
+             << step.xmlDoc->ErrorStr() << '\n';
       return false;
     }
-    ConvertImpl(elem, xmlDoc.FirstChildElement("convert"));
+    ConvertImpl(elem, step.xmlDoc->FirstChildElement("convert"),
+                *step.plan);
   }
 
   // Check that we actually converted to the desired final version.
@@ -168,18 +579,16 @@ void Converter::Convert(tinyxml2::XMLDocument *_doc,
   SDF_ASSERT(_doc != NULL, "SDF XML doc is NULL");
   SDF_ASSERT(_convertDoc != NULL, "Convert XML doc is NULL");
 
-  ConvertImpl(_doc->FirstChildElement(), _convertDoc->FirstChildElement());
+  const ConversionPlan plan(_convertDoc->FirstChildElement());
+  ConvertImpl(_doc->FirstChildElement(), _convertDoc->FirstChildElement(),
+              plan);
 }
 
 /////////////////////////////////////////////////
 void Converter::ConvertDescendantsImpl(tinyxml2::XMLElement *_e,
-                                       tinyxml2::XMLElement *_c)
+    const std::vector<tinyxml2::XMLElement *> &_c,
+    const ConversionPlan &_plan)
 {
-  if (!_c->Attribute("descendant_name"))
-  {
-    return;
-  }
-
   if (strcmp(_e->Name(), "plugin") == 0)
   {
     return;
@@ -193,23 +602,34 @@ void Converter::ConvertDescendantsImpl(tinyxml2::XMLElement *_e,
   tinyxml2::XMLElement *e = _e->FirstChildElement();
   while (e)
   {
-    if (strcmp(e->Name(), _c->Attribute("descendant_name")) == 0)
+    for (auto *c : _c)
     {
-      ConvertImpl(e, _c);
+      if (strcmp(e->Name(), c->Attribute("descendant_name")) == 0)
+      {
+        ConvertImpl(e, c, _plan);
+      }
     }
-    ConvertDescendantsImpl(e, _c);
+    ConvertDescendantsImpl(e, _c, _plan);
     e = e->NextSiblingElement();
   }
 }
 
 /////////////////////////////////////////////////
 void Converter::ConvertImpl(tinyxml2::XMLElement *_elem,
-                            tinyxml2::XMLElement *_convert)
+                            tinyxml2::XMLElement *_convert,
+                            const ConversionPlan &_plan)
 {
   SDF_ASSERT(_elem != NULL, "SDF element is NULL");
   SDF_ASSERT(_convert != NULL, "Convert element is NULL");
+  countPerf(PerfCounter::CONVERTER_NODE_VISITS);
 
-  CheckDeprecation(_elem, _convert);
+  // The deprecated values are only printed as warnings, so they are not
+  // searched for if the recipe has none or if warnings are dropped.
+  if (_plan.HasDeprecations() &&
+      isPolicyConditionReported(EnforcementPolicy::WARN))
+  {
+    CheckDeprecation(_elem, _convert);
+  }
 
   for (auto *convertElem = _convert->FirstChildElement("convert");
        convertElem; convertElem = convertElem->NextSiblingElement("convert"))
@@ -220,13 +640,22 @@ void Converter::ConvertImpl(tinyxml2::XMLElement *_elem,
           convertElem->Attribute("name"));
       while (elem)
       {
-        ConvertImpl(elem, convertElem);
+        ConvertImpl(elem, convertElem, _plan);
         elem = elem->NextSiblingElement(convertElem->Attribute("name"));
       }
     }
     if (convertElem->Attribute("descendant_name"))
     {
-      ConvertDescendantsImpl(_elem, convertElem);
+      if (convertElem->Attribute("name"))
+      {
+        ConvertDescendantsImpl(_elem, {convertElem}, _plan);
+      }
+      else
+      {
+        auto group = FusableDescendantConverts(convertElem);
+        ConvertDescendantsImpl(_elem, group, _plan);
+        convertElem = group.back();
+      }
     }
   }
 
@@ -241,15 +670,15 @@ void Converter::ConvertImpl(tinyxml2::XMLElement *_elem,
     }
     else if (name == "copy")
     {
-      Move(_elem, childElem, true);
+      Move(_elem, childElem, true, _plan);
     }
     else if (name == "map")
     {
-      Map(_elem, childElem);
+      Map(_elem, childElem, _plan);
     }
     else if (name == "move")
     {
-      Move(_elem, childElem, false);
+      Move(_elem, childElem, false, _plan);
     }
     else if (name == "add")
     {
@@ -281,15 +710,42 @@ void Converter::Unflatten(tinyxml2::XMLElement *_elem)
 
   tinyxml2::XMLDocument *doc = _elem->GetDocument();
 
-  tinyxml2::XMLElement *nextElem = nullptr, *firstUnflatModel = nullptr;
+  // Index the children once. The elements of a new model are those whose
+  // name starts with the name of the model, so the names are kept sorted to
+  // find them as a range instead of scanning every child for each model.
+  // The //gripper elements are candidates of every model.
+  std::vector<tinyxml2::XMLElement *> children;
+  std::vector<bool> removed;
+  std::multimap<std::string, std::size_t> namedChildren;
+  std::vector<std::size_t> grippers;
+  auto addChild = [&](tinyxml2::XMLElement *_child)
+  {
+    const std::size_t index = children.size();
+    children.push_back(_child);
+    removed.push_back(false);
+
+    const char *name = _child->Attribute("name");
+    if (strcmp(_child->Name(), "gripper") == 0)
+      grippers.push_back(index);
+    else if (name && name[0] != '\0' && !IsNotFlattenedElement(_child->Name()))
+      namedChildren.emplace(name, index);
+  };
   for (tinyxml2::XMLElement *elem = _elem->FirstChildElement();
       elem;
-      elem = nextElem)
+      elem = elem->NextSiblingElement())
   {
-    // break loop if reached the first unflattened model
-    if (firstUnflatModel == elem) break;
+    addChild(elem);
+  }
 
-    nextElem = elem->NextSiblingElement();
+  // new models are added at the end, and are not visited
+  const std::size_t originalCount = children.size();
+  for (std::size_t i = 0; i < originalCount; ++i)
+  {
+    // skip elements that were moved into a new model
+    if (removed[i])
+      continue;
+
+    tinyxml2::XMLElement *elem = children[i];
     std::string elemName = elem->Name();
 
     // skip element if not one of the following or if missing name attribute
@@ -315,34 +771,67 @@ void Converter::Unflatten(tinyxml2::XMLElement *_elem)
     tinyxml2::XMLElement *newModel = doc->NewElement("model");
     newModel->SetAttribute("name", newModelName.c_str());
 
-    if (FindNewModelElements(_elem, newModel, found + 2))
+    // candidates of the new model, in document order
+    auto isPrefixed = [&newModelName](
+        const std::pair<const std::string, std::size_t> &_entry)
     {
-      Unflatten(newModel);
-      _elem->InsertEndChild(newModel);
+      return _entry.first.compare(0, newModelName.size(), newModelName) == 0;
+    };
+    std::vector<std::size_t> candidates = grippers;
+    for (auto it = namedChildren.lower_bound(newModelName);
+        it != namedChildren.end() && isPrefixed(*it); ++it)
+    {
+      candidates.push_back(it->second);
+    }
+    std::sort(candidates.begin(), candidates.end());
 
-      // since newModel is inserted at the end, point back to the top element
-      nextElem = _elem->FirstChildElement();
+    std::vector<tinyxml2::XMLElement *> candidateElems;
+    candidateElems.reserve(candidates.size());
+    for (std::size_t index : candidates)
+      candidateElems.push_back(children[index]);
 
-      if (!firstUnflatModel)
-        firstUnflatModel = newModel;
+    std::vector<bool> moved;
+    if (FindNewModelElements(_elem, newModel, found + 2, candidateElems,
+                             moved))
+    {
+      for (std::size_t c = 0; c < candidates.size(); ++c)
+        removed[candidates[c]] = moved[c];
+
+      for (auto it = namedChildren.lower_bound(newModelName);
+          it != namedChildren.end() && isPrefixed(*it);)
+      {
+        if (removed[it->second])
+          it = namedChildren.erase(it);
+        else
+          ++it;
+      }
+      grippers.erase(std::remove_if(grippers.begin(), grippers.end(),
+          [&removed](std::size_t _index) { return removed[_index]; }),
+          grippers.end());
+
+      Unflatten(newModel);
+      _elem->InsertEndChild(newModel);
+      addChild(newModel);
     }
   }
 }
 
 /////////////////////////////////////////////////
 bool Converter::FindNewModelElements(tinyxml2::XMLElement *_elem,
-                                    tinyxml2::XMLElement *_newModel,
-                                    const size_t &_childNameIdx)
+    tinyxml2::XMLElement *_newModel,
+    const size_t &_childNameIdx,
+    const std::vector<tinyxml2::XMLElement *> &_candidates,
+    std::vector<bool> &_moved)
 {
   bool unflattenedNewModel = false;
   std::string newModelName = _newModel->Attribute("name");
   size_t newModelNameSize = newModelName.size();
+  _moved.assign(_candidates.size(), false);
 
-  // loop through looking for new model elements
-  tinyxml2::XMLElement *elem = _elem->FirstChildElement(), *nextElem = nullptr;
-  while (elem)
+  // loop through the new model elements
+  for (std::size_t c = 0; c < _candidates.size(); ++c)
   {
-    nextElem = elem->NextSiblingElement();
+    tinyxml2::XMLElement *elem = _candidates[c];
 
     std::string elemName = elem->Name();
     std::string elemAttrName;
@@ -350,19 +839,6 @@ bool Converter::FindNewModelElements(tinyxml2::XMLElement *_elem,
     if (elem->Attribute("name"))
       elemAttrName = elem->Attribute("name");
 
-    if (elemAttrName.empty() ||
-        elemAttrName.compare(0, newModelNameSize, newModelName) != 0 ||
-        IsNotFlattenedElement(elemName))
-    {
-      // since //gripper/@name may not be flattened but the children are
-      // & elemAttrName.compare will evaluate to true, don't skip this element
-      if (elemName != "gripper")
-      {
-        elem = nextElem;
-        continue;
-      }
-    }
-
     // Child attribute name w/ newModelName prefix stripped except for
     // possibly //gripper, which may or may not have a prefix
     std::string childAttrName;
@@ -520,7 +996,6 @@ bool Converter::FindNewModelElements(tinyxml2::XMLElement *_elem,
       // don't add to new model
       if (!hasPrefix)
       {
-        elem = nextElem;
         continue;
       }
 
@@ -539,9 +1014,8 @@ bool Converter::FindNewModelElements(tinyxml2::XMLElement *_elem,
     }  // gripper
 
     unflattenedNewModel = true;
+    _moved[c] = true;
     _newModel->InsertEndChild(elem);
-
-    elem = nextElem;
   }
 
   return unflattenedNewModel;
@@ -563,7 +1037,23 @@ void Converter::Rename(tinyxml2::XMLElement *_elem,
   const char *toElemName = toConvertElem->Attribute("element");
   const char *toAttrName = toConvertElem->Attribute("attribute");
 
-  const char *value = GetValue(fromElemName, fromAttrName, _elem);
+  // Find the renamed child once, as it is both the source of the value and
+  // the element that is replaced.
+  tinyxml2::XMLElement *replaceFrom = nullptr;
+  const char *value = nullptr;
+  if (fromElemName)
+  {
+    replaceFrom = _elem->FirstChildElement(fromElemName);
+    if (replaceFrom)
+    {
+      value = fromAttrName ? replaceFrom->Attribute(fromAttrName) :
+          replaceFrom->GetText();
+    }
+  }
+  else
+  {
+    value = GetValue(nullptr, fromAttrName, _elem);
+  }
   if (!value)
   {
     return;
@@ -589,7 +1079,6 @@ void Converter::Rename(tinyxml2::XMLElement *_elem,
 
   if (fromElemName)
   {
-    tinyxml2::XMLElement *replaceFrom = _elem->FirstChildElement(fromElemName);
     _elem->InsertAfterChild(replaceFrom, replaceTo);
     _elem->DeleteChild(replaceFrom);
   }
@@ -686,108 +1175,36 @@ void Converter::Remove(tinyxml2::XMLElement *_elem,
 }
 
 /////////////////////////////////////////////////
-void Converter::Map(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_mapElem)
+void Converter::Map(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_mapElem,
+                    const ConversionPlan &_plan)
 {
   SDF_ASSERT(_elem != nullptr, "SDF element is nullptr");
   SDF_ASSERT(_mapElem != nullptr, "Map element is nullptr");
 
-  tinyxml2::XMLElement *fromConvertElem = _mapElem->FirstChildElement("from");
-  tinyxml2::XMLElement *toConvertElem = _mapElem->FirstChildElement("to");
-
-  if (!fromConvertElem)
-  {
-    sdferr << "<map> element requires a <from> child element.\n";
-    return;
-  }
-  if (!toConvertElem)
-  {
-    sdferr << "<map> element requires a <to> child element.\n";
-    return;
-  }
-
-  const char *fromNameStr = fromConvertElem->Attribute("name");
-  const char *toNameStr = toConvertElem->Attribute("name");
-
-  if (!fromNameStr || strlen(fromNameStr) == 0)
-  {
-    sdferr << "Map: <from> element requires a non-empty name attribute.\n";
-    return;
-  }
-  if (!toNameStr || strlen(toNameStr) == 0)
-  {
-    sdferr << "Map: <to> element requires a non-empty name attribute.\n";
-    return;
-  }
-
-  // create map of input and output values
-  std::map<std::string, std::string> valueMap;
-  auto *fromValueElem = fromConvertElem->FirstChildElement("value");
-  auto *toValueElem = toConvertElem->FirstChildElement("value");
-  if (!fromValueElem)
-  {
-    sdferr << "Map: <from> element requires at least one <value> element.\n";
-    return;
-  }
-  if (!toValueElem)
-  {
-    sdferr << "Map: <to> element requires at least one <value> element.\n";
-    return;
-  }
-  if (!fromValueElem->GetText())
+  const ConversionPlan::MapOperation &op = _plan.Map(_mapElem);
+  if (!op.error.empty())
   {
-    sdferr << "Map: from value must not be empty.\n";
+    sdferr << op.error;
     return;
   }
-  if (!toValueElem->GetText())
-  {
-    sdferr << "Map: to value must not be empty.\n";
-    return;
-  }
-  valueMap[fromValueElem->GetText()] = toValueElem->GetText();
-  while (fromValueElem->NextSiblingElement("value"))
-  {
-    fromValueElem = fromValueElem->NextSiblingElement("value");
-    if (toValueElem->NextSiblingElement("value"))
-    {
-      toValueElem = toValueElem->NextSiblingElement("value");
-    }
-    if (!fromValueElem->GetText())
-    {
-      sdferr << "Map: from value must not be empty.\n";
-      return;
-    }
-    if (!toValueElem->GetText())
-    {
-      sdferr << "Map: to value must not be empty.\n";
-      return;
-    }
-    valueMap[fromValueElem->GetText()] = toValueElem->GetText();
-  }
-
-  // tokenize 'from' and 'to' name attributes
-  std::string fromStr = fromNameStr;
-  std::string toStr = toNameStr;
-
-  std::vector<std::string> fromTokens = split(fromStr, "/");
-  std::vector<std::string> toTokens = split(toStr, "/");
-
-  // split() always returns at least one element, even with the
-  // empty string.  Thus we don't check if the fromTokens or toTokens are empty.
 
   // get value of the 'from' element/attribute
   tinyxml2::XMLElement *fromElem = _elem;
-  for (unsigned int i = 0; i < fromTokens.size()-1; ++i)
+  tinyxml2::XMLElement *sharedElem = nullptr;
+  for (std::size_t i = 0; i < op.fromParents.size(); ++i)
   {
-    fromElem = fromElem->FirstChildElement(fromTokens[i].c_str());
+    fromElem = fromElem->FirstChildElement(op.fromParents[i].c_str());
     if (!fromElem)
     {
       // Return when the tokens don't match. Don't output an error message
       // because it spams the console.
       return;
     }
+    if (i + 1 == op.sharedParents)
+      sharedElem = fromElem;
   }
 
-  const char *fromLeaf = fromTokens.back().c_str();
+  const char *fromLeaf = op.fromLeaf.c_str();
   if (fromLeaf[0] == '\0' ||
       (fromLeaf[0] == '@' && fromLeaf[1] == '\0'))
   {
@@ -806,21 +1223,33 @@ void Converter::Map(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_mapElem)
     fromValue = GetValue(fromLeaf, nullptr, fromElem);
   }
 
-  if (!fromValue || valueMap.end() == valueMap.find(std::string(fromValue)))
+  if (!fromValue)
   {
     // No match, no message to avoid spam.
     return;
   }
-  const char *toValue = valueMap[std::string(fromValue)].c_str();
-  // sdfdbg << "Map from [" << fromValue << "] to [" << toValue << "]\n";
+  auto valueIter = op.values.find(fromValue);
+  if (valueIter == op.values.end())
+  {
+    return;
+  }
+  const char *toValue = valueIter->second.c_str();
 
-  // check if destination elements before leaf exist and create if necessary
-  unsigned int newDirIndex = 0;
+  // check if destination elements before leaf exist and create if necessary.
+  // The elements that the 'to' path shares with the 'from' path were found
+  // above.
+  std::size_t newDirIndex = 0;
   tinyxml2::XMLElement *toElem = _elem;
   tinyxml2::XMLElement *childElem = NULL;
-  for (unsigned int i = 0; i < toTokens.size()-1; ++i)
+  std::size_t i = 0;
+  if (sharedElem)
   {
-    childElem = toElem->FirstChildElement(toTokens[i].c_str());
+    toElem = childElem = sharedElem;
+    i = op.sharedParents;
+  }
+  for (; i < op.toParents.size(); ++i)
+  {
+    childElem = toElem->FirstChildElement(op.toParents[i].c_str());
     if (!childElem)
     {
       newDirIndex = i;
@@ -830,7 +1259,7 @@ void Converter::Map(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_mapElem)
   }
 
   // get the destination leaf name
-  const char *toLeaf = toTokens.back().c_str();
+  const char *toLeaf = op.toLeaf.c_str();
   if (toLeaf[0] == '\0' ||
       (toLeaf[0] == '@' && toLeaf[1] == '\0'))
   {
@@ -845,16 +1274,18 @@ void Converter::Map(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_mapElem)
   // elements if they aren't empty
   if (!childElem)
   {
-    int offset = toAttribute ? 1 : 0;
-    while (newDirIndex < (toTokens.size()-offset))
+    const std::size_t count = op.toParents.size() + (toAttribute ? 0 : 1);
+    while (newDirIndex < count)
     {
-      if (toTokens[newDirIndex].empty())
+      const std::string &token = newDirIndex < op.toParents.size() ?
+          op.toParents[newDirIndex] : op.toLeaf;
+      if (token.empty())
       {
         sdferr << "Map: <to> has invalid name attribute\n";
         return;
       }
 
-      auto *newElem = doc->NewElement(toTokens[newDirIndex].c_str());
+      auto *newElem = doc->NewElement(token.c_str());
       toElem->LinkEndChild(newElem);
       toElem = newElem;
       newDirIndex++;
@@ -875,49 +1306,27 @@ void Converter::Map(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_mapElem)
 /////////////////////////////////////////////////
 void Converter::Move(tinyxml2::XMLElement *_elem,
                      tinyxml2::XMLElement *_moveElem,
-                     const bool _copy)
+                     const bool _copy,
+                     const ConversionPlan &_plan)
 {
   SDF_ASSERT(_elem != NULL, "SDF element is NULL");
   SDF_ASSERT(_moveElem != NULL, "Move element is NULL");
 
-  tinyxml2::XMLElement *fromConvertElem = _moveElem->FirstChildElement("from");
-  tinyxml2::XMLElement *toConvertElem = _moveElem->FirstChildElement("to");
-
-  const char *fromElemStr = fromConvertElem->Attribute("element");
-  const char *fromAttrStr = fromConvertElem->Attribute("attribute");
-
-  const char *toElemStr = toConvertElem->Attribute("element");
-  const char *toAttrStr = toConvertElem->Attribute("attribute");
-
-  // tokenize 'from' and 'to' strs
-  std::string fromStr = "";
-  if (fromElemStr)
-  {
-    fromStr = fromElemStr;
-  }
-  else if (fromAttrStr)
+  const ConversionPlan::MoveOperation &op = _plan.Move(_moveElem);
+  if (!op.valid)
   {
-    fromStr = fromAttrStr;
-  }
-  std::string toStr = "";
-  if (toElemStr)
-  {
-    toStr = toElemStr;
-  }
-  else if (toAttrStr)
-  {
-    toStr = toAttrStr;
+    sdferr << "<" << _moveElem->Name()
+           << "> element requires <from> and <to> child elements.\n";
+    return;
   }
 
-  std::vector<std::string> fromTokens = split(fromStr, "::");
-  std::vector<std::string> toTokens = split(toStr, "::");
-
-  // split() always returns at least one element, even with the
-  // empty string.  Thus we don't check if the fromTokens or toTokens are empty.
+  const std::vector<std::string> &fromTokens = op.fromTokens;
+  const std::vector<std::string> &toTokens = op.toTokens;
 
   // get value of the 'from' element/attribute
   tinyxml2::XMLElement *fromElem = _elem;
-  for (unsigned int i = 0; i < fromTokens.size()-1; ++i)
+  tinyxml2::XMLElement *sharedElem = nullptr;
+  for (std::size_t i = 0; i < fromTokens.size()-1; ++i)
   {
     fromElem = fromElem->FirstChildElement(fromTokens[i].c_str());
     if (!fromElem)
@@ -926,17 +1335,26 @@ void Converter::Move(tinyxml2::XMLElement *_elem,
       // because it spams the console.
       return;
     }
+    if (i + 1 == op.sharedParents)
+      sharedElem = fromElem;
   }
 
   const char *fromName = fromTokens.back().c_str();
   const char *value = nullptr;
 
-  unsigned int newDirIndex = 0;
-  // get the new element/attribute name
+  std::size_t newDirIndex = 0;
+  // get the new element/attribute name. The elements that the 'to' path
+  // shares with the 'from' path were found above.
   const char *toName = toTokens.back().c_str();
   tinyxml2::XMLElement *toElem = _elem;
   tinyxml2::XMLElement *childElem = nullptr;
-  for (unsigned int i = 0; i < toTokens.size()-1; ++i)
+  std::size_t i = 0;
+  if (sharedElem)
+  {
+    toElem = childElem = sharedElem;
+    i = op.sharedParents;
+  }
+  for (; i < toTokens.size()-1; ++i)
   {
     childElem = toElem->FirstChildElement(toTokens[i].c_str());
     if (!childElem)
@@ -951,7 +1369,7 @@ void Converter::Move(tinyxml2::XMLElement *_elem,
   // elements
   if (!childElem)
   {
-    int offset = toElemStr != nullptr && toAttrStr != nullptr ? 0 : 1;
+    int offset = op.toElement && op.toAttribute ? 0 : 1;
     while (newDirIndex < (toTokens.size()-offset))
     {
       auto *doc = toElem->GetDocument();
@@ -964,7 +1382,7 @@ void Converter::Move(tinyxml2::XMLElement *_elem,
 
   // Get value, or return if no element/attribute found as they don't have to
   // be specified in the sdf.
-  if (fromElemStr)
+  if (op.fromElement)
   {
     tinyxml2::XMLElement *moveFrom = fromElem->FirstChildElement(fromName);
 
@@ -974,8 +1392,17 @@ void Converter::Move(tinyxml2::XMLElement *_elem,
       return;
     }
 
-    if (toElemStr && !toAttrStr)
+    if (op.toElement && !op.toAttribute)
     {
+      // The element is relinked instead of copied when it is removed from
+      // its parent, unless it is moved into itself.
+      tinyxml2::XMLNode *moved = _copy ? nullptr : MoveNode(toElem, moveFrom);
+      if (moved)
+      {
+        moved->SetValue(toName);
+        return;
+      }
+
       tinyxml2::XMLNode *cloned = DeepClone(moveFrom->GetDocument(), moveFrom);
       tinyxml2::XMLElement *moveTo = static_cast<tinyxml2::XMLElement*>(cloned);
 
@@ -991,7 +1418,7 @@ void Converter::Move(tinyxml2::XMLElement *_elem,
       }
       std::string valueStr = value;
 
-      toElem->SetAttribute(toAttrStr, valueStr.c_str());
+      toElem->SetAttribute(op.toAttributeName.c_str(), valueStr.c_str());
     }
 
     if (!_copy)
@@ -999,7 +1426,7 @@ void Converter::Move(tinyxml2::XMLElement *_elem,
       fromElem->DeleteChild(moveFrom);
     }
   }
-  else if (fromAttrStr)
+  else if (op.fromAttribute)
   {
     value = GetValue(nullptr, fromName, fromElem);
 
@@ -1010,7 +1437,7 @@ void Converter::Move(tinyxml2::XMLElement *_elem,
 
     std::string valueStr = value;
 
-    if (toElemStr)
+    if (op.toElement)
     {
       auto *doc = toElem->GetDocument();
       tinyxml2::XMLElement *moveTo = doc->NewElement(toName);
@@ -1018,12 +1445,12 @@ void Converter::Move(tinyxml2::XMLElement *_elem,
       moveTo->LinkEndChild(text);
       toElem->LinkEndChild(moveTo);
     }
-    else if (toAttrStr)
+    else if (op.toAttribute)
     {
       toElem->SetAttribute(toName, valueStr.c_str());
     }
 
-    if (!_copy && fromAttrStr)
+    if (!_copy)
     {
       fromElem->DeleteAttribute(fromName);
     }
@@ -21,6 +21,7 @@
 
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include <sdf/sdf_config.h>
 #include "sdf/system_util.hh"
@@ -31,6 +32,9 @@ namespace sdf
   inline namespace SDF_VERSION_NAMESPACE {
   //
 
+  // Forward declarations.
+  class ConversionPlan;
+
   /// \brief Convert from one version of SDF to another
   class Converter
   {
@@ -55,15 +59,21 @@ namespace sdf
     /// \brief Implementation of Convert functionality.
     /// \param[in] _elem SDF xml element tree to convert.
     /// \param[in] _convert Convert xml element tree.
+    /// \param[in] _plan Compiled operations of the convert xml document.
     private: static void ConvertImpl(tinyxml2::XMLElement *_elem,
-                                     tinyxml2::XMLElement *_convert);
+                                     tinyxml2::XMLElement *_convert,
+                                     const ConversionPlan &_plan);
 
     /// \brief Recursive helper function for ConvertImpl that converts
-    /// elements named by the descendant_name attribute.
+    /// elements named by the descendant_name attribute. Several independent
+    /// descendant conversions are applied in a single traversal.
     /// \param[in] _e SDF xml element tree to convert.
-    /// \param[in] _c Convert xml element tree.
+    /// \param[in] _c Convert xml element trees, each with a descendant_name
+    /// attribute.
+    /// \param[in] _plan Compiled operations of the convert xml document.
     private: static void ConvertDescendantsImpl(tinyxml2::XMLElement *_e,
-                                                tinyxml2::XMLElement *_c);
+        const std::vector<tinyxml2::XMLElement *> &_c,
+        const ConversionPlan &_plan);
 
     /// \brief Rename an element or attribute.
     /// \param[in] _elem The element to be renamed, or the element which
@@ -78,8 +88,11 @@ namespace sdf
     /// be mapped.
     /// \param[in] _mapElem A 'convert' element that describes the map
     /// operation.
+    /// \param[in] _plan Compiled operations of the convert xml document,
+    /// which include the paths and values of _mapElem.
     private: static void Map(tinyxml2::XMLElement *_elem,
-                             tinyxml2::XMLElement *_mapElem);
+                             tinyxml2::XMLElement *_mapElem,
+                             const ConversionPlan &_plan);
 
     /// \brief Move an element or attribute within a common ancestor element.
     /// \param[in] _elem Ancestor element of the element or attribute to
@@ -87,9 +100,12 @@ namespace sdf
     /// \param[in] _moveElem A 'convert' element that describes the move
     /// operation.
     /// \param[in] _copy True to copy the element
+    /// \param[in] _plan Compiled operations of the convert xml document,
+    /// which include the paths of _moveElem.
     private: static void Move(tinyxml2::XMLElement *_elem,
                               tinyxml2::XMLElement *_moveElem,
-                              const bool _copy);
+                              const bool _copy,
+                              const ConversionPlan &_plan);
 
     /// \brief Add an element or attribute to an element.
     /// \param[in] _elem The element to receive the value.
@@ -112,15 +128,22 @@ namespace sdf
     /// \param[in] _elem The element to unflatten
     private: static void Unflatten(tinyxml2::XMLElement *_elem);
 
-    /// \brief Finds all elements related to the unflattened model
+    /// \brief Moves the elements related to the unflattened model into it
     /// \param[in] _elem The element to unflatten
     /// \param[in] _newModel The new unflattened model element
     /// \param[in] _childNameIdx The beginning index of child element names
     /// (e.g., in newModelName::childName then _childNameIdx = 14)
+    /// \param[in] _candidates Children of _elem that are flattened elements
+    /// with a name that starts with the name of _newModel, and the //gripper
+    /// children, in document order
+    /// \param[out] _moved Whether each candidate was moved into _newModel
+    /// or removed
     /// \return True if unflattened new model elements
     private: static bool FindNewModelElements(tinyxml2::XMLElement *_elem,
-                                              tinyxml2::XMLElement *_newModel,
-                                              const size_t &_childNameIdx);
+        tinyxml2::XMLElement *_newModel,
+        const size_t &_childNameIdx,
+        const std::vector<tinyxml2::XMLElement *> &_candidates,
+        std::vector<bool> &_moved);
 
     private: static const char *GetValue(const char *_valueElem,
                                          const char *_valueAttr,
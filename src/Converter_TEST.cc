@@ -622,6 +622,50 @@ TEST(Converter, RemoveDescendantElement)
   ASSERT_TRUE(convertedElem == nullptr);
 }
 
+////////////////////////////////////////////////////
+/// Ensure that several descendant conversions are all applied, both when
+/// they are independent and when one depends on the result of another
+TEST(Converter, MultipleDescendantConversions)
+{
+  tinyxml2::XMLDocument xmlDoc;
+  xmlDoc.Parse(getXmlString().c_str());
+
+  std::stringstream convertStream;
+  convertStream << "<convert name='elemA'>"
+                << "  <convert descendant_name='elemB'>"
+                << "    <add attribute='attrX' value='X'/>"
+                << "  </convert>"
+                << "  <convert descendant_name='elemD'>"
+                << "    <add attribute='attrY' value='Y'/>"
+                << "  </convert>"
+                << "  <convert descendant_name='elemC'>"
+                << "    <rename>"
+                << "      <from element='elemD'/>"
+                << "      <to element='elemE'/>"
+                << "    </rename>"
+                << "  </convert>"
+                << "  <convert descendant_name='elemE'>"
+                << "    <add attribute='attrZ' value='Z'/>"
+                << "  </convert>"
+                << "</convert>";
+  tinyxml2::XMLDocument convertXmlDoc;
+  convertXmlDoc.Parse(convertStream.str().c_str());
+  sdf::Converter::Convert(&xmlDoc, &convertXmlDoc);
+
+  tinyxml2::XMLElement *elemA = xmlDoc.FirstChildElement("elemA");
+  ASSERT_NE(nullptr, elemA);
+  tinyxml2::XMLElement *elemB = elemA->FirstChildElement("elemB");
+  ASSERT_NE(nullptr, elemB);
+  EXPECT_STREQ("X", elemB->Attribute("attrX"));
+  tinyxml2::XMLElement *elemC = elemB->FirstChildElement("elemC");
+  ASSERT_NE(nullptr, elemC);
+  EXPECT_EQ(nullptr, elemC->FirstChildElement("elemD"));
+  tinyxml2::XMLElement *elemE = elemC->FirstChildElement("elemE");
+  ASSERT_NE(nullptr, elemE);
+  EXPECT_STREQ("D", elemE->GetText());
+  EXPECT_STREQ("Z", elemE->Attribute("attrZ"));
+}
+
 ////////////////////////////////////////////////////
 /// Ensure that Converter::Remove function is working
 /// Test removing empty elements only
@@ -1845,6 +1889,66 @@ TEST(Converter, MapAttrElemMultipleLevels)
   EXPECT_STREQ(convertedElem->Name(), "elemD");
 }
 
+////////////////////////////////////////////////////
+/// Ensure that Converter::Map and Converter::Move work when the 'from' and
+/// 'to' paths share parent elements and the same operation is applied to
+/// several elements
+TEST(Converter, MapMoveSharedParentsRepeated)
+{
+  tinyxml2::XMLDocument xmlDoc;
+  xmlDoc.Parse("<root>"
+               "  <elemA><elemB><elemC>x</elemC></elemB></elemA>"
+               "  <elemA><elemB><elemC>y</elemC></elemB></elemA>"
+               "  <elemA><elemB><elemC>x</elemC></elemB></elemA>"
+               "</root>");
+  std::stringstream convertStream;
+  convertStream << "<convert name='root'>"
+                << "  <convert name='elemA'>"
+                << "    <map>"
+                << "      <from name='elemB/elemC'>"
+                << "        <value>x</value>"
+                << "      </from>"
+                << "      <to name='elemB/@mapped'>"
+                << "        <value>X</value>"
+                << "      </to>"
+                << "    </map>"
+                << "    <move>"
+                << "      <from element='elemB::elemC'/>"
+                << "      <to element='elemB::elemD'/>"
+                << "    </move>"
+                << "  </convert>"
+                << "</convert>";
+  tinyxml2::XMLDocument convertXmlDoc;
+  convertXmlDoc.Parse(convertStream.str().c_str());
+  sdf::Converter::Convert(&xmlDoc, &convertXmlDoc);
+
+  const std::array<const char *, 3> mapped = {"X", nullptr, "X"};
+  const std::array<const char *, 3> texts = {"x", "y", "x"};
+  tinyxml2::XMLElement *elemA =
+      xmlDoc.FirstChildElement()->FirstChildElement("elemA");
+  for (std::size_t i = 0; i < mapped.size(); ++i)
+  {
+    ASSERT_NE(nullptr, elemA);
+    tinyxml2::XMLElement *elemB = elemA->FirstChildElement("elemB");
+    ASSERT_NE(nullptr, elemB);
+    if (mapped[i])
+    {
+      ASSERT_NE(nullptr, elemB->Attribute("mapped"));
+      EXPECT_STREQ(mapped[i], elemB->Attribute("mapped"));
+    }
+    else
+    {
+      EXPECT_EQ(nullptr, elemB->Attribute("mapped"));
+    }
+    EXPECT_EQ(nullptr, elemB->FirstChildElement("elemC"));
+    ASSERT_NE(nullptr, elemB->FirstChildElement("elemD"));
+    EXPECT_STREQ(texts[i], elemB->FirstChildElement("elemD")->GetText());
+    EXPECT_EQ(nullptr, elemB->NextSiblingElement());
+    elemA = elemA->NextSiblingElement("elemA");
+  }
+  EXPECT_EQ(nullptr, elemA);
+}
+
 ////////////////////////////////////////////////////
 TEST(Converter, RenameElemElem)
 {
@@ -2089,6 +2193,36 @@ TEST(Converter, MuchNewerVersion)
   ASSERT_TRUE(sdf::Converter::Convert(&xmlDoc, "1.6"));
 }
 
+////////////////////////////////////////////////////
+/// Converting several documents reuses the cached conversion recipes and
+/// gives the same result every time.
+TEST(Converter, RepeatedConversion)
+{
+  std::string xmlString(
+      "<sdf version='1.4'>"
+      "  <model name='m'>"
+      "    <link name='l'><pose>1 2 3 0 0 0</pose></link>"
+      "  </model>"
+      "</sdf>");
+
+  std::string firstOutput;
+  for (int i = 0; i < 3; ++i)
+  {
+    tinyxml2::XMLDocument xmlDoc;
+    xmlDoc.Parse(xmlString.c_str());
+    ASSERT_TRUE(sdf::Converter::Convert(&xmlDoc, SDF_PROTOCOL_VERSION));
+    EXPECT_STREQ(SDF_PROTOCOL_VERSION,
+        xmlDoc.FirstChildElement("sdf")->Attribute("version"));
+
+    tinyxml2::XMLPrinter printer;
+    xmlDoc.Print(&printer);
+    if (i == 0)
+      firstOutput = printer.CStr();
+    else
+      EXPECT_EQ(firstOutput, printer.CStr());
+  }
+}
+
 static std::string ConvertDoc_15_16()
 {
   return sdf::testing::SourceFile("sdf", "1.6", "1_5.convert");
@@ -2727,6 +2861,67 @@ TEST(Converter, World_17_to_18)
   EXPECT_STREQ(convertedElem->NextSiblingElement()->Name(), "geometry");
 }
 
+/////////////////////////////////////////////////
+/// Test unflattening models whose elements are interleaved in 1.7 to 1.8
+TEST(Converter, World_17_to_18_Interleaved)
+{
+  // for ElementToString
+  using namespace sdf;
+
+  std::string xmlString = R"(
+  <?xml version="1.0" ?>
+  <sdf version='1.7'>
+    <world name="default">
+      <model name='interleaved'>
+        <link name='base'/>
+        <link name='A::l1'/>
+        <joint name='B::j' type='fixed'>
+          <parent>B::l1</parent>
+          <child>B::l2</child>
+        </joint>
+        <link name='A::l2'/>
+        <link name='B::l1'/>
+        <link name='B::l2'/>
+      </model>
+    </world>
+  </sdf>)";
+
+  tinyxml2::XMLDocument xmlDoc;
+  xmlDoc.Parse(xmlString.c_str());
+
+  // Convert
+  tinyxml2::XMLDocument convertXmlDoc;
+  convertXmlDoc.LoadFile(ConvertDoc_17_18().c_str());
+  sdf::Converter::Convert(&xmlDoc, &convertXmlDoc);
+
+  std::string expectedXmlStr = R"(
+  <sdf version="1.7">
+      <world name="default">
+          <model name="interleaved">
+              <link name="base"/>
+              <model name="A">
+                  <link name="l1"/>
+                  <link name="l2"/>
+              </model>
+              <model name="B">
+                  <joint name="j" type="fixed">
+                      <parent>l1</parent>
+                      <child>l2</child>
+                  </joint>
+                  <link name="l1"/>
+                  <link name="l2"/>
+              </model>
+          </model>
+      </world>
+  </sdf>)";
+
+  tinyxml2::XMLDocument expectedXmlDoc;
+  expectedXmlDoc.Parse(expectedXmlStr.c_str());
+
+  EXPECT_EQ(ElementToString(expectedXmlDoc.RootElement()),
+            ElementToString(xmlDoc.RootElement()));
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
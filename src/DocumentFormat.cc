@@ -0,0 +1,197 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "BinarySdf.hh"
+#include "DocumentFormat.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/////////////////////////////////////////////////
+/// \brief Check whether a character is XML white space.
+/// \param[in] _c The character.
+/// \return True for a space, tab, carriage return or line feed.
+static bool isXmlSpace(char _c)
+{
+  return _c == ' ' || _c == '\t' || _c == '\r' || _c == '\n';
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the position of the first character after white space.
+/// \param[in] _text The text.
+/// \param[in] _pos Position to start at.
+/// \return Position of the first character that is not white space.
+static std::size_t skipXmlSpace(std::string_view _text, std::size_t _pos)
+{
+  while (_pos < _text.size() && isXmlSpace(_text[_pos]))
+    ++_pos;
+  return _pos;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the position after the end of a construct.
+/// \param[in] _text The text.
+/// \param[in] _pos Position of the construct.
+/// \param[in] _end Characters that end the construct.
+/// \return Position after the end, or npos if it is not in the text.
+static std::size_t skipPast(std::string_view _text, std::size_t _pos,
+    std::string_view _end)
+{
+  const std::size_t end = _text.find(_end, _pos);
+  return end == std::string_view::npos ? end : end + _end.size();
+}
+
+/////////////////////////////////////////////////
+/// \brief Sniff a text or binary USD file.
+/// \param[in] _start The first bytes of the file.
+/// \param[out] _info The format and version, if it is a USD file.
+/// \return True if it is a USD file.
+static bool sniffUsd(std::string_view _start, DocumentInfo &_info)
+{
+  if (_start.substr(0, 8) == "PXR-USDC")
+  {
+    _info.format = DocumentFormat::USD;
+    return true;
+  }
+
+  constexpr std::string_view usda = "#usda ";
+  if (_start.substr(0, usda.size()) != usda)
+    return false;
+
+  _info.format = DocumentFormat::USD;
+  std::size_t end = usda.size();
+  while (end < _start.size() && !isXmlSpace(_start[end]))
+    ++end;
+  _info.version = std::string(_start.substr(usda.size(), end - usda.size()));
+  return true;
+}
+
+/////////////////////////////////////////////////
+DocumentInfo sniffDocument(std::string_view _start)
+{
+  DocumentInfo info;
+  if (sniffUsd(_start, info))
+    return info;
+  if (BinarySdf::Sniff(_start, info.version))
+  {
+    info.format = DocumentFormat::BINARY_SDF;
+    return info;
+  }
+
+  // Skip the byte order mark, the XML declaration, processing
+  // instructions, comments and the document type.
+  std::size_t pos = 0;
+  if (_start.substr(0, 3) == "\xEF\xBB\xBF")
+    pos = 3;
+  while (true)
+  {
+    pos = skipXmlSpace(_start, pos);
+    if (pos >= _start.size() || _start[pos] != '<')
+      return info;
+
+    const std::string_view rest = _start.substr(pos);
+    if (rest.substr(0, 2) == "<?")
+      pos = skipPast(_start, pos, "?>");
+    else if (rest.substr(0, 4) == "<!--")
+      pos = skipPast(_start, pos, "-->");
+    else if (rest.substr(0, 2) == "<!")
+      pos = skipPast(_start, pos, ">");
+    else
+      break;
+
+    if (pos == std::string_view::npos)
+      return info;
+  }
+
+  // Read the name of the root element.
+  const std::size_t nameBegin = ++pos;
+  while (pos < _start.size() && !isXmlSpace(_start[pos]) &&
+         _start[pos] != '>' && _start[pos] != '/')
+  {
+    ++pos;
+  }
+  if (pos >= _start.size() || pos == nameBegin)
+    return info;
+
+  const std::string_view name = _start.substr(nameBegin, pos - nameBegin);
+  if (name == "robot")
+  {
+    info.format = DocumentFormat::URDF;
+    return info;
+  }
+  if (name != "sdf")
+  {
+    info.format = DocumentFormat::OTHER_XML;
+    return info;
+  }
+  info.format = DocumentFormat::SDF;
+
+  // Read the attributes of the root element until the version is found.
+  while (true)
+  {
+    pos = skipXmlSpace(_start, pos);
+    if (pos >= _start.size() || _start[pos] == '>' || _start[pos] == '/')
+      return info;
+
+    const std::size_t keyBegin = pos;
+    while (pos < _start.size() && !isXmlSpace(_start[pos]) &&
+           _start[pos] != '=')
+    {
+      ++pos;
+    }
+    const std::string_view key = _start.substr(keyBegin, pos - keyBegin);
+
+    pos = skipXmlSpace(_start, pos);
+    if (pos >= _start.size() || _start[pos] != '=')
+      return info;
+    pos = skipXmlSpace(_start, pos + 1);
+    if (pos >= _start.size() || (_start[pos] != '"' && _start[pos] != '\''))
+      return info;
+
+    const std::size_t valueBegin = pos + 1;
+    const std::size_t valueEnd = _start.find(_start[pos], valueBegin);
+    if (valueEnd == std::string_view::npos)
+      return info;
+
+    if (key == "version")
+    {
+      info.version =
+          std::string(_start.substr(valueBegin, valueEnd - valueBegin));
+      return info;
+    }
+    pos = valueEnd + 1;
+  }
+}
+
+/////////////////////////////////////////////////
+DocumentInfo sniffFile(const std::string &_path)
+{
+  std::ifstream in(_path, std::ios::binary);
+  if (!in)
+    return DocumentInfo();
+
+  std::string start(kDocumentSniffSize, '\0');
+  in.read(&start[0], static_cast<std::streamsize>(start.size()));
+  start.resize(static_cast<std::size_t>(in.gcount()));
+  return sniffDocument(start);
+}
+}
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDFORMAT_DOCUMENTFORMAT_HH
+#define SDFORMAT_DOCUMENTFORMAT_HH
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Format of a document, as found from its first bytes.
+  enum class DocumentFormat
+  {
+    /// \brief The format could not be found, for example because the root
+    /// element does not start in the first bytes. The document must be
+    /// parsed to find its format.
+    UNKNOWN,
+
+    /// \brief XML document with an <sdf> root element.
+    SDF,
+
+    /// \brief XML document with a <robot> root element.
+    URDF,
+
+    /// \brief Text or binary USD file.
+    USD,
+
+    /// \brief XML document with another root element.
+    OTHER_XML,
+
+    /// \brief Binary SDFormat document, written by sdf::encodeBinary.
+    BINARY_SDF
+  };
+
+  /// \brief Format and version of a document.
+  struct DocumentInfo
+  {
+    /// \brief Format of the document.
+    DocumentFormat format = DocumentFormat::UNKNOWN;
+
+    /// \brief Version of the document: the version attribute of the <sdf>
+    /// element, the specification version of a binary document, or the
+    /// version of a text USD file. Empty if it is unknown.
+    std::string version;
+  };
+
+  /// \brief Number of bytes at the start of a file that sniffFile reads.
+  constexpr std::size_t kDocumentSniffSize = 8192;
+
+  /// \brief Find the format and version of a document from its start,
+  /// without parsing the document. Only the XML declaration, comments,
+  /// document type and the start tag of the root element are read.
+  /// \param[in] _start The document, or its first bytes.
+  /// \return The format and version of the document.
+  DocumentInfo sniffDocument(std::string_view _start);
+
+  /// \brief Find the format and version of a file from its first
+  /// kDocumentSniffSize bytes.
+  /// \param[in] _path Path of the file.
+  /// \return The format and version of the file, with an UNKNOWN format if
+  /// it cannot be read.
+  DocumentInfo sniffFile(const std::string &_path);
+  }
+}
+#endif
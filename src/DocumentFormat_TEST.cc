@@ -0,0 +1,109 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "sdf/Filesystem.hh"
+#include "DocumentFormat.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+TEST(DocumentFormat, SniffSdf)
+{
+  sdf::DocumentInfo info = sdf::sniffDocument(
+      "<?xml version='1.0'?>\n<sdf version='1.6'><model name='m'/></sdf>");
+  EXPECT_EQ(sdf::DocumentFormat::SDF, info.format);
+  EXPECT_EQ("1.6", info.version);
+
+  // Byte order mark, comments, document type and other attributes.
+  info = sdf::sniffDocument(
+      "\xEF\xBB\xBF<?xml version=\"1.0\" ?>\n"
+      "<!-- A comment with <sdf version='1.0'> in it -->\n"
+      "<!DOCTYPE sdf>\n"
+      "<sdf xmlns:custom=\"http://example.org\"\n"
+      "     version = \"1.9\">\n");
+  EXPECT_EQ(sdf::DocumentFormat::SDF, info.format);
+  EXPECT_EQ("1.9", info.version);
+
+  // The version is unknown if it is not in the start tag.
+  info = sdf::sniffDocument("<sdf><model name='m'/></sdf>");
+  EXPECT_EQ(sdf::DocumentFormat::SDF, info.format);
+  EXPECT_TRUE(info.version.empty());
+  info = sdf::sniffDocument("<sdf/>");
+  EXPECT_EQ(sdf::DocumentFormat::SDF, info.format);
+  info = sdf::sniffDocument("<sdf vers");
+  EXPECT_EQ(sdf::DocumentFormat::SDF, info.format);
+  EXPECT_TRUE(info.version.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(DocumentFormat, SniffOther)
+{
+  EXPECT_EQ(sdf::DocumentFormat::URDF,
+      sdf::sniffDocument("<?xml version='1.0'?>\n<robot name='r'/>").format);
+  EXPECT_EQ(sdf::DocumentFormat::OTHER_XML,
+      sdf::sniffDocument("<model><name>Box</name></model>").format);
+
+  sdf::DocumentInfo info = sdf::sniffDocument("#usda 1.0\n(\n)\n");
+  EXPECT_EQ(sdf::DocumentFormat::USD, info.format);
+  EXPECT_EQ("1.0", info.version);
+  EXPECT_EQ(sdf::DocumentFormat::USD,
+      sdf::sniffDocument(std::string("PXR-USDC\0\0", 10)).format);
+
+  // Documents that end before the root element are unknown.
+  EXPECT_EQ(sdf::DocumentFormat::UNKNOWN, sdf::sniffDocument("").format);
+  EXPECT_EQ(sdf::DocumentFormat::UNKNOWN,
+      sdf::sniffDocument("not xml").format);
+  EXPECT_EQ(sdf::DocumentFormat::UNKNOWN,
+      sdf::sniffDocument("<?xml version='1.0'?>\n<!-- unterminated").format);
+  EXPECT_EQ(sdf::DocumentFormat::UNKNOWN,
+      sdf::sniffDocument("<?xml version='1.0'?>\n<sd").format);
+}
+
+/////////////////////////////////////////////////
+TEST(DocumentFormat, SniffFile)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  std::filesystem::create_directories(tmpDir);
+  const std::string path =
+      sdf::filesystem::append(tmpDir, "document_format.sdf");
+
+  // Only the start of the file is read.
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "<sdf version='1.5'>\n"
+        << std::string(2 * sdf::kDocumentSniffSize, ' ') << "</sdf>\n";
+  }
+  sdf::DocumentInfo info = sdf::sniffFile(path);
+  EXPECT_EQ(sdf::DocumentFormat::SDF, info.format);
+  EXPECT_EQ("1.5", info.version);
+
+  // The root element is too far from the start.
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "<!--" << std::string(sdf::kDocumentSniffSize, ' ') << "-->\n"
+        << "<sdf version='1.5'/>\n";
+  }
+  EXPECT_EQ(sdf::DocumentFormat::UNKNOWN, sdf::sniffFile(path).format);
+
+  EXPECT_EQ(sdf::DocumentFormat::UNKNOWN,
+      sdf::sniffFile(path + ".missing").format);
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <memory>
+
+#include "sdf/Collision.hh"
+#include "sdf/Link.hh"
+#include "sdf/Model.hh"
+#include "sdf/Visual.hh"
+#include "sdf/World.hh"
+#include "DomInterner.hh"
+#include "Utils.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/////////////////////////////////////////////////
+/// \brief Get the element that an object was loaded from, or the element
+/// made from it if the element was released.
+/// \param[in] _object The object.
+/// \return The element.
+template <typename T>
+static ElementPtr objectElement(const T &_object)
+{
+  ElementPtr elem = _object.Element();
+  if (!elem)
+    elem = _object.ToElement();
+  return elem;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the content hash of the element of an object, see
+/// objectElement.
+/// \param[in] _object The object.
+/// \return The hash.
+template <typename T>
+static std::uint64_t objectHash(const T &_object)
+{
+  return objectElement(_object)->ContentHash();
+}
+
+/////////////////////////////////////////////////
+bool identicalObjects(const Geometry &_a, const Geometry &_b)
+{
+  return _a.SameShape(_b);
+}
+
+/////////////////////////////////////////////////
+bool identicalObjects(const Surface &_a, const Surface &_b)
+{
+  return identicalContent(*objectElement(_a), *objectElement(_b));
+}
+
+/////////////////////////////////////////////////
+bool identicalObjects(const Material &_a, const Material &_b)
+{
+  return _a.FilePath() == _b.FilePath() &&
+      identicalContent(*objectElement(_a), *objectElement(_b));
+}
+
+/////////////////////////////////////////////////
+void DomInterner::Share(World &_world)
+{
+  for (uint64_t i = 0; i < _world.ModelCount(); ++i)
+    this->Share(*_world.ModelByIndex(i));
+}
+
+/////////////////////////////////////////////////
+void DomInterner::Share(Model &_model)
+{
+  for (uint64_t i = 0; i < _model.LinkCount(); ++i)
+  {
+    Link *link = _model.LinkByIndex(i);
+    for (uint64_t j = 0; j < link->CollisionCount(); ++j)
+      link->CollisionByIndex(j)->ShareProperties(*this);
+    for (uint64_t j = 0; j < link->VisualCount(); ++j)
+      link->VisualByIndex(j)->ShareProperties(*this);
+  }
+
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+    this->Share(*_model.ModelByIndex(i));
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const Geometry> DomInterner::Share(
+    const std::shared_ptr<const Geometry> &_geom)
+{
+  return this->geometries.Share(_geom->ShapeId(), _geom);
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const Surface> DomInterner::Share(
+    const std::shared_ptr<const Surface> &_surface)
+{
+  return this->surfaces.Share(objectHash(*_surface), _surface);
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const Material> DomInterner::Share(
+    const std::shared_ptr<const Material> &_material)
+{
+  // The URIs of scripts and textures are resolved from the file path
+  std::uint64_t key = kFnvOffsetBasis;
+  hashNumber(key, objectHash(*_material));
+  hashString(key, _material->FilePath());
+  return this->materials.Share(key, _material);
+}
+
+/////////////////////////////////////////////////
+std::size_t DomInterner::SharedCount() const
+{
+  return this->geometries.ReplacedCount() + this->surfaces.ReplacedCount() +
+      this->materials.ReplacedCount();
+}
+}
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_DOMINTERNER_HH
+#define SDFORMAT_DOMINTERNER_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "sdf/Geometry.hh"
+#include "sdf/Material.hh"
+#include "sdf/Surface.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  // Forward declarations.
+  class Model;
+  class World;
+
+  /// \brief Check whether two geometries are identical, see
+  /// Geometry::SameShape.
+  /// \param[in] _a The first geometry.
+  /// \param[in] _b The second geometry.
+  /// \return True if the geometries are identical.
+  bool identicalObjects(const Geometry &_a, const Geometry &_b);
+
+  /// \brief Check whether two surfaces were loaded from elements with the
+  /// same content.
+  /// \param[in] _a The first surface.
+  /// \param[in] _b The second surface.
+  /// \return True if the surfaces are identical.
+  bool identicalObjects(const Surface &_a, const Surface &_b);
+
+  /// \brief Check whether two materials were loaded from elements with the
+  /// same content and from the same file.
+  /// \param[in] _a The first material.
+  /// \param[in] _b The second material.
+  /// \return True if the materials are identical.
+  bool identicalObjects(const Material &_a, const Material &_b);
+
+  /// \brief Objects shared by a DomInterner, by the hash of their content.
+  /// Different objects may have the same hash, so an object is only
+  /// replaced by a shared object with its hash that is identical to it.
+  /// \tparam T Geometry, Surface or Material.
+  template <typename T>
+  class SharedObjects
+  {
+    /// \brief Get the shared object identical to an object, or share the
+    /// object.
+    /// \param[in] _hash Hash of the content of the object.
+    /// \param[in] _object The object.
+    /// \return The first identical object that was shared, or _object.
+    public: std::shared_ptr<const T> Share(std::uint64_t _hash,
+                const std::shared_ptr<const T> &_object);
+
+    /// \brief Get the number of objects that were replaced by an identical
+    /// one.
+    /// \return The number of objects.
+    public: std::size_t ReplacedCount() const;
+
+    /// \brief Shared objects, by hash. There is more than one object with a
+    /// hash only if the hashes of different objects collide.
+    private: std::unordered_map<std::uint64_t,
+                 std::vector<std::shared_ptr<const T>>> objects;
+
+    /// \brief Number of objects that were replaced.
+    private: std::size_t replacedCount = 0;
+  };
+
+  /// \brief Shares the identical Geometry, Surface and Material objects of
+  /// the collisions and visuals of a document, so that a world that repeats
+  /// the same <geometry>, <surface> or <material> many times keeps a single
+  /// copy of each. Objects are identical when the elements they were loaded
+  /// from have the same content, and, for objects that resolve relative
+  /// URIs, the same file path. Objects are looked up by a hash of these,
+  /// see Element::ContentHash, and compared when the hashes are equal. The
+  /// shared objects are never
+  /// modified: the setters of Collision and Visual replace them.
+  class DomInterner
+  {
+    /// \brief Share the objects of the models of a world.
+    /// \param[in,out] _world The world.
+    public: void Share(World &_world);
+
+    /// \brief Share the objects of a model and of its nested models.
+    /// \param[in,out] _model The model.
+    public: void Share(Model &_model);
+
+    /// \brief Get the shared geometry identical to a geometry.
+    /// \param[in] _geom The geometry.
+    /// \return The first identical geometry that was shared, or _geom.
+    public: std::shared_ptr<const Geometry> Share(
+                const std::shared_ptr<const Geometry> &_geom);
+
+    /// \brief Get the shared surface identical to a surface.
+    /// \param[in] _surface The surface.
+    /// \return The first identical surface that was shared, or _surface.
+    public: std::shared_ptr<const Surface> Share(
+                const std::shared_ptr<const Surface> &_surface);
+
+    /// \brief Get the shared material identical to a material.
+    /// \param[in] _material The material.
+    /// \return The first identical material that was shared, or _material.
+    public: std::shared_ptr<const Material> Share(
+                const std::shared_ptr<const Material> &_material);
+
+    /// \brief Get the number of objects that were replaced by an identical
+    /// one.
+    /// \return The number of objects.
+    public: std::size_t SharedCount() const;
+
+    /// \brief Shared geometries, by shape ID.
+    private: SharedObjects<Geometry> geometries;
+
+    /// \brief Shared surfaces, by content hash.
+    private: SharedObjects<Surface> surfaces;
+
+    /// \brief Shared materials, by content hash and file path.
+    private: SharedObjects<Material> materials;
+  };
+
+  /////////////////////////////////////////////////
+  template <typename T>
+  std::shared_ptr<const T> SharedObjects<T>::Share(std::uint64_t _hash,
+      const std::shared_ptr<const T> &_object)
+  {
+    std::vector<std::shared_ptr<const T>> &candidates = this->objects[_hash];
+    for (const std::shared_ptr<const T> &candidate : candidates)
+    {
+      if (candidate == _object)
+        return candidate;
+      if (identicalObjects(*candidate, *_object))
+      {
+        ++this->replacedCount;
+        return candidate;
+      }
+    }
+    candidates.push_back(_object);
+    return _object;
+  }
+
+  /////////////////////////////////////////////////
+  template <typename T>
+  std::size_t SharedObjects<T>::ReplacedCount() const
+  {
+    return this->replacedCount;
+  }
+  }
+}
+#endif
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include <ignition/math/Color.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "sdf/Box.hh"
+#include "sdf/Geometry.hh"
+#include "sdf/Material.hh"
+#include "DomInterner.hh"
+
+/////////////////////////////////////////////////
+/// \brief Make a box geometry.
+/// \param[in] _size Size of the box.
+/// \return The geometry.
+static std::shared_ptr<const sdf::Geometry> makeBox(
+    const ignition::math::Vector3d &_size)
+{
+  auto geom = std::make_shared<sdf::Geometry>();
+  geom->SetType(sdf::GeometryType::BOX);
+  sdf::Box box;
+  box.SetSize(_size);
+  geom->SetBoxShape(box);
+  return geom;
+}
+
+/////////////////////////////////////////////////
+/// \brief Make a material.
+/// \param[in] _ambient Ambient color of the material.
+/// \param[in] _filePath File the material was read from.
+/// \return The material.
+static std::shared_ptr<const sdf::Material> makeMaterial(
+    const ignition::math::Color &_ambient, const std::string &_filePath)
+{
+  auto material = std::make_shared<sdf::Material>();
+  material->SetAmbient(_ambient);
+  material->SetFilePath(_filePath);
+  return material;
+}
+
+/////////////////////////////////////////////////
+TEST(DomInterner, Share)
+{
+  sdf::DomInterner interner;
+  auto box = makeBox({1, 2, 3});
+  EXPECT_EQ(box, interner.Share(box));
+  EXPECT_EQ(box, interner.Share(box));
+  EXPECT_EQ(box, interner.Share(makeBox({1, 2, 3})));
+  auto otherBox = makeBox({1, 2, 4});
+  EXPECT_EQ(otherBox, interner.Share(otherBox));
+
+  auto material = makeMaterial({1, 0, 0, 1}, "/a/model.sdf");
+  EXPECT_EQ(material, interner.Share(material));
+  EXPECT_EQ(material, interner.Share(
+      makeMaterial({1, 0, 0, 1}, "/a/model.sdf")));
+
+  // Relative URIs of materials read from different files are resolved
+  // from different directories.
+  auto otherFile = makeMaterial({1, 0, 0, 1}, "/b/model.sdf");
+  EXPECT_EQ(otherFile, interner.Share(otherFile));
+  EXPECT_EQ(2u, interner.SharedCount());
+}
+
+/////////////////////////////////////////////////
+TEST(DomInterner, HashCollision)
+{
+  // Objects whose hashes collide are not shared unless they are identical.
+  sdf::SharedObjects<sdf::Geometry> geometries;
+  auto box = makeBox({1, 2, 3});
+  auto otherBox = makeBox({4, 5, 6});
+  EXPECT_EQ(box, geometries.Share(7, box));
+  EXPECT_EQ(otherBox, geometries.Share(7, otherBox));
+  EXPECT_EQ(box, geometries.Share(7, makeBox({1, 2, 3})));
+  EXPECT_EQ(otherBox, geometries.Share(7, makeBox({4, 5, 6})));
+  EXPECT_EQ(otherBox, geometries.Share(7, otherBox));
+  EXPECT_EQ(2u, geometries.ReplacedCount());
+
+  sdf::SharedObjects<sdf::Material> materials;
+  auto material = makeMaterial({1, 0, 0, 1}, "/a/model.sdf");
+  auto otherColor = makeMaterial({0, 1, 0, 1}, "/a/model.sdf");
+  auto otherFile = makeMaterial({1, 0, 0, 1}, "/b/model.sdf");
+  EXPECT_EQ(material, materials.Share(7, material));
+  EXPECT_EQ(otherColor, materials.Share(7, otherColor));
+  EXPECT_EQ(otherFile, materials.Share(7, otherFile));
+  EXPECT_EQ(material, materials.Share(
+      7, makeMaterial({1, 0, 0, 1}, "/a/model.sdf")));
+  EXPECT_EQ(1u, materials.ReplacedCount());
+}
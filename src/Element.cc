@@ -16,22 +16,141 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "sdf/Assert.hh"
 #include "sdf/Element.hh"
 #include "sdf/Filesystem.hh"
 
+#include "PerfCounting.hh"
+#include "Utils.hh"
+
 using namespace sdf;
 
+/// \brief Number of children above which an element keeps a name index of
+/// its children. Below this a linear scan is cheaper than hashing the name.
+static constexpr std::size_t kElementIndexThreshold = 16;
+
+/////////////////////////////////////////////////
+/// \brief Get the shared copy of a file path from the table of file paths.
+/// Unlike InternedString, an entry only lives as long as the elements that
+/// refer to it, since documents can be loaded from any number of files.
+/// \param[in] _path File path, which must not be empty.
+/// \return Shared copy of _path.
+static std::shared_ptr<const std::string> internFilePath(
+    const std::string &_path)
+{
+  static std::mutex mutex;
+  // Intentionally leaked so that it outlives any static elements.
+  static auto *table =
+      new std::unordered_map<std::string, std::weak_ptr<const std::string>>();
+  static std::size_t pruneSize = 64;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::weak_ptr<const std::string> &entry = (*table)[_path];
+  std::shared_ptr<const std::string> path = entry.lock();
+  if (!path)
+  {
+    path = std::make_shared<const std::string>(_path);
+    entry = path;
+  }
+
+  // Drop the paths that no element refers to anymore once the table has
+  // doubled in size since it was last pruned.
+  if (table->size() >= pruneSize)
+  {
+    for (auto it = table->begin(); it != table->end();)
+    {
+      if (it->second.expired())
+        it = table->erase(it);
+      else
+        ++it;
+    }
+    pruneSize = std::max<std::size_t>(64, 2 * table->size());
+  }
+  return path;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the full XML path of a node, assembling it from the paths
+/// of its parent nodes the first time it is requested.
+/// \param[in] _node Node of an XML path.
+/// \return Full XML path of _node.
+static const std::string &fullXmlPath(const XmlPathNode &_node)
+{
+  std::call_once(_node.pathOnce, [&_node]
+  {
+    if (!_node.parent)
+    {
+      _node.path = _node.segment;
+      return;
+    }
+    const std::string &parentPath = fullXmlPath(*_node.parent);
+    _node.path.reserve(parentPath.size() + 1 + _node.segment.size());
+    _node.path = parentPath;
+    _node.path += '/';
+    _node.path += _node.segment;
+  });
+  return _node.path;
+}
+
+/////////////////////////////////////////////////
+/// \brief Match the start of an XML path against the path of a node.
+/// \param[in] _node Node of an XML path.
+/// \param[in] _path Full XML path.
+/// \return Length of the prefix of _path that is the path of _node, or
+/// std::string::npos if _path does not start with it.
+static std::size_t matchXmlPath(const XmlPathNode &_node,
+    const std::string &_path)
+{
+  std::size_t pos = 0;
+  if (_node.parent)
+  {
+    pos = matchXmlPath(*_node.parent, _path);
+    if (pos == std::string::npos || pos >= _path.size() || _path[pos] != '/')
+      return std::string::npos;
+    ++pos;
+  }
+
+  if (_path.compare(pos, _node.segment.size(), _node.segment) != 0)
+    return std::string::npos;
+  return pos + _node.segment.size();
+}
+
+/////////////////////////////////////////////////
+ElementSchema &ElementPrivate::MutableSchema()
+{
+  // The empty schema of new elements is always shared, so it is copied too.
+  if (this->schema.use_count() > 1)
+    this->schema = std::make_shared<const ElementSchema>(*this->schema);
+
+  // Schemas are only ever created as non-const objects.
+  return const_cast<ElementSchema &>(*this->schema);
+}
+
+/////////////////////////////////////////////////
+ElementExtras &ElementPrivate::MutableExtras()
+{
+  if (!this->extras)
+    this->extras = std::make_unique<ElementExtras>();
+  return *this->extras;
+}
+
 /////////////////////////////////////////////////
 Element::Element()
   : dataPtr(new ElementPrivate)
 {
-  this->dataPtr->copyChildren = false;
-  this->dataPtr->referenceSDF = "";
+  static const std::shared_ptr<const ElementSchema> kEmptySchema =
+      std::make_shared<const ElementSchema>();
+  this->dataPtr->schema = kEmptySchema;
   this->dataPtr->explicitlySetInFile = true;
+  this->dataPtr->hasLineNumber = false;
 }
 
 /////////////////////////////////////////////////
@@ -45,16 +164,27 @@ ElementPtr Element::GetParent() const
   return this->dataPtr->parent.lock();
 }
 
+/////////////////////////////////////////////////
+Element *Element::ParentRaw() const
+{
+  // Checking whether the parent expired does not change its reference
+  // counts, unlike locking it.
+  if (this->dataPtr->parent.expired())
+    return nullptr;
+  return this->dataPtr->parentRaw;
+}
+
 /////////////////////////////////////////////////
 void Element::SetParent(const ElementPtr _parent)
 {
   this->dataPtr->parent = _parent;
+  this->dataPtr->parentRaw = _parent.get();
 
   // If this element doesn't have a path, get it from the parent
   if (nullptr != _parent && (this->FilePath().empty() ||
-      this->FilePath() == std::string(kSdfStringSource)))
+      this->FilePath() == kSdfStringSource))
   {
-    this->SetFilePath(_parent->FilePath());
+    this->dataPtr->path = _parent->dataPtr->path;
   }
 
   // If this element doesn't have an original version, get it from the parent
@@ -67,31 +197,46 @@ void Element::SetParent(const ElementPtr _parent)
 /////////////////////////////////////////////////
 void Element::SetName(const std::string &_name)
 {
-  this->dataPtr->name = _name;
+  if (this->dataPtr->schema->name == _name)
+    return;
+
+  this->dataPtr->MutableSchema().name = _name;
+  this->InvalidateContentHash();
+
+  // The parent's name index is keyed on the child name, so it has to be
+  // rebuilt when an indexed child is renamed.
+  Element *parent = this->ParentRaw();
+  if (parent && parent->dataPtr->elementIndex &&
+      this->IndexInParent(*parent) < parent->dataPtr->elements.size())
+  {
+    parent->RebuildElementIndex();
+  }
 }
 
 /////////////////////////////////////////////////
 const std::string &Element::GetName() const
 {
-  return this->dataPtr->name;
+  return this->dataPtr->schema->name;
 }
 
 /////////////////////////////////////////////////
 void Element::SetRequired(const std::string &_req)
 {
-  this->dataPtr->required = _req;
+  if (this->dataPtr->schema->required != _req)
+    this->dataPtr->MutableSchema().required = _req;
 }
 
 /////////////////////////////////////////////////
 const std::string &Element::GetRequired() const
 {
-  return this->dataPtr->required;
+  return this->dataPtr->schema->required;
 }
 
 /////////////////////////////////////////////////
 void Element::SetCopyChildren(bool _value)
 {
-  this->dataPtr->copyChildren = _value;
+  if (this->dataPtr->schema->copyChildren != _value)
+    this->dataPtr->MutableSchema().copyChildren = _value;
 }
 
 /////////////////////////////////////////////////
@@ -116,19 +261,44 @@ bool Element::GetExplicitlySetInFile() const
 /////////////////////////////////////////////////
 bool Element::GetCopyChildren() const
 {
-  return this->dataPtr->copyChildren;
+  return this->dataPtr->schema->copyChildren;
+}
+
+/////////////////////////////////////////////////
+void Element::SetRawXml(const std::string &_xml)
+{
+  if (_xml.empty())
+  {
+    if (this->dataPtr->extras)
+      this->dataPtr->extras->rawXml.reset();
+  }
+  else
+  {
+    this->dataPtr->MutableExtras().rawXml =
+        std::make_shared<const std::string>(_xml);
+  }
+  this->InvalidateContentHash();
+}
+
+/////////////////////////////////////////////////
+const std::string &Element::RawXml() const
+{
+  static const std::string kEmpty;
+  const ElementExtras *extras = this->dataPtr->extras.get();
+  return extras && extras->rawXml ? *extras->rawXml : kEmpty;
 }
 
 /////////////////////////////////////////////////
 void Element::SetReferenceSDF(const std::string &_value)
 {
-  this->dataPtr->referenceSDF = _value;
+  if (this->dataPtr->schema->referenceSDF != _value)
+    this->dataPtr->MutableSchema().referenceSDF = _value;
 }
 
 /////////////////////////////////////////////////
 std::string Element::ReferenceSDF() const
 {
-  return this->dataPtr->referenceSDF;
+  return this->dataPtr->schema->referenceSDF;
 }
 
 /////////////////////////////////////////////////
@@ -137,8 +307,9 @@ void Element::AddValue(const std::string &_type,
                        bool _required,
                        const std::string &_description)
 {
-  this->dataPtr->value = this->CreateParam(this->dataPtr->name,
+  this->dataPtr->value = this->CreateParam(this->dataPtr->schema->name,
       _type, _defaultValue, _required, _description);
+  this->InvalidateContentHash();
 }
 
 /////////////////////////////////////////////////
@@ -150,10 +321,11 @@ void Element::AddValue(const std::string &_type,
                        const std::string &_description)
 {
   this->dataPtr->value =
-      std::make_shared<Param>(this->dataPtr->name, _type, _defaultValue,
+      std::make_shared<Param>(this->dataPtr->schema->name, _type, _defaultValue,
                               _required, _minValue, _maxValue, _description);
   SDF_ASSERT(this->dataPtr->value->SetParentElement(shared_from_this()),
       "Cannot set parent Element of value to itself.");
+  this->InvalidateContentHash();
 }
 
 /////////////////////////////////////////////////
@@ -170,6 +342,22 @@ ParamPtr Element::CreateParam(const std::string &_key,
   return param;
 }
 
+/////////////////////////////////////////////////
+/// \brief Add a name to an index, copying the index first if it is shared
+/// with other elements. The index keeps the first position of a name.
+/// \param[in,out] _index Index to add to, created if it is null.
+/// \param[in] _name Name to add.
+/// \param[in] _position Position of the name.
+static void addToNameIndex(std::shared_ptr<ElementPrivate::NameIndex> &_index,
+                           const std::string &_name, std::size_t _position)
+{
+  if (!_index)
+    _index = std::make_shared<ElementPrivate::NameIndex>();
+  else if (_index.use_count() > 1)
+    _index = std::make_shared<ElementPrivate::NameIndex>(*_index);
+  _index->emplace(_name, _position);
+}
+
 /////////////////////////////////////////////////
 void Element::AddAttribute(const std::string &_key,
                            const std::string &_type,
@@ -179,19 +367,28 @@ void Element::AddAttribute(const std::string &_key,
 {
   this->dataPtr->attributes.push_back(
       this->CreateParam(_key, _type, _defaultValue, _required, _description));
+  if (this->dataPtr->attributes.size() == 1 || this->dataPtr->attributeIndex)
+  {
+    addToNameIndex(this->dataPtr->attributeIndex, _key,
+                   this->dataPtr->attributes.size() - 1);
+  }
+  this->InvalidateContentHash();
 }
 
 /////////////////////////////////////////////////
 ElementPtr Element::Clone() const
 {
-  ElementPtr clone(new Element);
-  clone->dataPtr->description = this->dataPtr->description;
-  clone->dataPtr->name = this->dataPtr->name;
-  clone->dataPtr->required = this->dataPtr->required;
-  clone->dataPtr->copyChildren = this->dataPtr->copyChildren;
-  clone->dataPtr->referenceSDF = this->dataPtr->referenceSDF;
+  ScopedOutermostCall<PerfCounter::ELEMENT_CLONE_CALLS> call;
+  countPerf(PerfCounter::ELEMENTS_CLONED);
+  ElementPtr clone = std::make_shared<Element>();
+  // The schema, including the element descriptions, is shared with the
+  // clone instead of being deep copied.
+  clone->dataPtr->schema = this->dataPtr->schema;
+  if (this->dataPtr->extras && this->dataPtr->extras->rawXml)
+    clone->dataPtr->MutableExtras().rawXml = this->dataPtr->extras->rawXml;
   clone->dataPtr->path = this->dataPtr->path;
   clone->dataPtr->lineNumber = this->dataPtr->lineNumber;
+  clone->dataPtr->hasLineNumber = this->dataPtr->hasLineNumber;
   clone->dataPtr->xmlPath = this->dataPtr->xmlPath;
   clone->dataPtr->originalVersion = this->dataPtr->originalVersion;
   clone->dataPtr->explicitlySetInFile = this->dataPtr->explicitlySetInFile;
@@ -206,19 +403,15 @@ ElementPtr Element::Clone() const
         "Element.");
     clone->dataPtr->attributes.push_back(clonedAttribute);
   }
+  clone->dataPtr->attributeIndex = this->dataPtr->attributeIndex;
 
   ElementPtr_V::const_iterator eiter;
-  for (eiter = this->dataPtr->elementDescriptions.begin();
-      eiter != this->dataPtr->elementDescriptions.end(); ++eiter)
-  {
-    clone->dataPtr->elementDescriptions.push_back((*eiter)->Clone());
-  }
-
   for (eiter = this->dataPtr->elements.begin();
        eiter != this->dataPtr->elements.end(); ++eiter)
   {
-    clone->dataPtr->elements.push_back((*eiter)->Clone());
-    clone->dataPtr->elements.back()->SetParent(clone);
+    ElementPtr child = (*eiter)->Clone();
+    child->SetParent(clone);
+    clone->PushElement(child);
   }
 
   if (this->dataPtr->value)
@@ -228,40 +421,61 @@ ElementPtr Element::Clone() const
         "Cannot set parent Element of cloned value Param to cloned Element.");
   }
 
-  if (this->dataPtr->includeElement)
+  if (this->dataPtr->extras && this->dataPtr->extras->includeElement)
   {
-    clone->dataPtr->includeElement = this->dataPtr->includeElement->Clone();
+    clone->dataPtr->MutableExtras().includeElement =
+        this->dataPtr->extras->includeElement->Clone();
   }
 
+  // The clone has the same contents, and its children have their hashes.
+  clone->dataPtr->contentHash = this->dataPtr->contentHash.load();
+
   return clone;
 }
 
 /////////////////////////////////////////////////
 void Element::Copy(const ElementPtr _elem)
 {
-  this->dataPtr->name = _elem->GetName();
-  this->dataPtr->description = _elem->GetDescription();
-  this->dataPtr->required = _elem->GetRequired();
-  this->dataPtr->copyChildren = _elem->GetCopyChildren();
-  this->dataPtr->referenceSDF = _elem->ReferenceSDF();
-  this->dataPtr->originalVersion = _elem->OriginalVersion();
-  this->dataPtr->path = _elem->FilePath();
-  this->dataPtr->lineNumber = _elem->LineNumber();
-  this->dataPtr->xmlPath = _elem->XmlPath();
+  this->dataPtr->schema = _elem->dataPtr->schema;
+  if (_elem->dataPtr->extras && _elem->dataPtr->extras->rawXml)
+    this->dataPtr->MutableExtras().rawXml = _elem->dataPtr->extras->rawXml;
+  else if (this->dataPtr->extras)
+    this->dataPtr->extras->rawXml.reset();
+  this->dataPtr->originalVersion = _elem->dataPtr->originalVersion;
+  this->dataPtr->path = _elem->dataPtr->path;
+  this->dataPtr->lineNumber = _elem->dataPtr->lineNumber;
+  this->dataPtr->hasLineNumber = _elem->dataPtr->hasLineNumber;
+  this->dataPtr->xmlPath = _elem->dataPtr->xmlPath;
   this->dataPtr->explicitlySetInFile = _elem->GetExplicitlySetInFile();
 
+  // Elements initialized from a description, as by sdf::initFile, have no
+  // attributes yet, so their attributes are cloned without being looked up
+  // and assigned.
+  const bool hadAttributes = !this->dataPtr->attributes.empty();
   for (Param_V::iterator iter = _elem->dataPtr->attributes.begin();
        iter != _elem->dataPtr->attributes.end(); ++iter)
   {
+    if (!hadAttributes)
+    {
+      ParamPtr param = (*iter)->Clone();
+      SDF_ASSERT(param->SetParentElement(shared_from_this()),
+          "Cannot set parent Element of copied attribute Param to itself.");
+      this->dataPtr->attributes.push_back(param);
+      continue;
+    }
+
     if (!this->HasAttribute((*iter)->GetKey()))
     {
       this->dataPtr->attributes.push_back((*iter)->Clone());
+      this->dataPtr->attributeIndex.reset();
     }
     ParamPtr param = this->GetAttribute((*iter)->GetKey());
     (*param) = (**iter);
     SDF_ASSERT(param->SetParentElement(shared_from_this()),
         "Cannot set parent Element of copied attribute Param to itself.");
   }
+  if (!hadAttributes)
+    this->dataPtr->attributeIndex = _elem->dataPtr->attributeIndex;
 
   if (_elem->GetValue())
   {
@@ -277,42 +491,39 @@ void Element::Copy(const ElementPtr _elem)
         "Cannot set parent Element of copied value Param to itself.");
   }
 
-  this->dataPtr->elementDescriptions.clear();
-  for (ElementPtr_V::const_iterator iter =
-       _elem->dataPtr->elementDescriptions.begin();
-       iter != _elem->dataPtr->elementDescriptions.end(); ++iter)
-  {
-    this->dataPtr->elementDescriptions.push_back((*iter)->Clone());
-  }
-
   this->dataPtr->elements.clear();
+  this->dataPtr->elementIndex.reset();
   for (ElementPtr_V::iterator iter = _elem->dataPtr->elements.begin();
        iter != _elem->dataPtr->elements.end(); ++iter)
   {
+    // Clone already copies the whole subtree
     ElementPtr elem = (*iter)->Clone();
-    elem->Copy(*iter);
     elem->SetParent(shared_from_this());
-    this->dataPtr->elements.push_back(elem);
+    this->PushElement(elem);
   }
 
-  if (_elem->dataPtr->includeElement)
+  if (_elem->dataPtr->extras && _elem->dataPtr->extras->includeElement)
   {
-    if (!this->dataPtr->includeElement)
+    const ElementPtr &includeElement = _elem->dataPtr->extras->includeElement;
+    ElementExtras &extras = this->dataPtr->MutableExtras();
+    if (!extras.includeElement)
     {
-      this->dataPtr->includeElement = _elem->dataPtr->includeElement->Clone();
+      extras.includeElement = includeElement->Clone();
     }
     else
     {
-      this->dataPtr->includeElement->Copy(_elem->dataPtr->includeElement);
+      extras.includeElement->Copy(includeElement);
     }
   }
+
+  this->InvalidateContentHash();
 }
 
 /////////////////////////////////////////////////
 void Element::PrintDescription(const std::string &_prefix) const
 {
-  std::cout << _prefix << "<element name ='" << this->dataPtr->name
-            << "' required ='" << this->dataPtr->required << "'";
+  std::cout << _prefix << "<element name ='" << this->dataPtr->schema->name
+            << "' required ='" << this->dataPtr->schema->required << "'";
 
   if (this->dataPtr->value)
   {
@@ -336,7 +547,7 @@ void Element::PrintDescription(const std::string &_prefix) const
   std::cout << ">\n";
 
   std::cout << _prefix << "  <description><![CDATA["
-            << this->dataPtr->description
+            << this->dataPtr->schema->description
             << "]]></description>\n";
 
   Param_V::iterator aiter;
@@ -366,9 +577,9 @@ void Element::PrintDescription(const std::string &_prefix) const
               << "' required ='*'/>\n";
   }
 
-  ElementPtr_V::iterator eiter;
-  for (eiter = this->dataPtr->elementDescriptions.begin();
-      eiter != this->dataPtr->elementDescriptions.end(); ++eiter)
+  ElementPtr_V::const_iterator eiter;
+  for (eiter = this->dataPtr->schema->elementDescriptions.begin();
+      eiter != this->dataPtr->schema->elementDescriptions.end(); ++eiter)
   {
     (*eiter)->PrintDescription(_prefix + "  ");
   }
@@ -381,28 +592,28 @@ void Element::PrintDocRightPane(std::string &_html, int _spacing,
                                 int &_index) const
 {
   std::ostringstream stream;
-  ElementPtr_V::iterator eiter;
+  ElementPtr_V::const_iterator eiter;
 
   int start = _index++;
 
   std::string childHTML;
-  for (eiter = this->dataPtr->elementDescriptions.begin();
-      eiter != this->dataPtr->elementDescriptions.end(); ++eiter)
+  for (eiter = this->dataPtr->schema->elementDescriptions.begin();
+      eiter != this->dataPtr->schema->elementDescriptions.end(); ++eiter)
   {
     (*eiter)->PrintDocRightPane(childHTML, _spacing + 4, _index);
   }
 
-  stream << "<a name=\"" << this->dataPtr->name << start
-         << "\">&lt" << this->dataPtr->name << "&gt</a>";
+  stream << "<a name=\"" << this->dataPtr->schema->name << start
+         << "\">&lt" << this->dataPtr->schema->name << "&gt</a>";
 
   stream << "<div style='padding-left:" << _spacing << "px;'>\n";
 
   stream << "<div style='background-color: #ffffff'>\n";
 
   stream << "<font style='font-weight:bold'>Description: </font>";
-  if (!this->dataPtr->description.empty())
+  if (!this->dataPtr->schema->description.Str().empty())
   {
-    stream << this->dataPtr->description << "<br>\n";
+    stream << this->dataPtr->schema->description << "<br>\n";
   }
   else
   {
@@ -410,7 +621,7 @@ void Element::PrintDocRightPane(std::string &_html, int _spacing,
   }
 
   stream << "<font style='font-weight:bold'>Required: </font>"
-         << this->dataPtr->required << "&nbsp;&nbsp;&nbsp;\n";
+         << this->dataPtr->schema->required << "&nbsp;&nbsp;&nbsp;\n";
 
   stream << "<font style='font-weight:bold'>Type: </font>";
   if (this->dataPtr->value)
@@ -477,20 +688,20 @@ void Element::PrintDocLeftPane(std::string &_html, int _spacing,
                                int &_index) const
 {
   std::ostringstream stream;
-  ElementPtr_V::iterator eiter;
+  ElementPtr_V::const_iterator eiter;
 
   int start = _index++;
 
   std::string childHTML;
-  for (eiter = this->dataPtr->elementDescriptions.begin();
-      eiter != this->dataPtr->elementDescriptions.end(); ++eiter)
+  for (eiter = this->dataPtr->schema->elementDescriptions.begin();
+      eiter != this->dataPtr->schema->elementDescriptions.end(); ++eiter)
   {
     (*eiter)->PrintDocLeftPane(childHTML, _spacing + 4, _index);
   }
 
   stream << "<a id='" << start << "' onclick='highlight(" << start
-         << ");' href=\"#" << this->dataPtr->name << start
-         << "\">&lt" << this->dataPtr->name << "&gt</a>";
+         << ");' href=\"#" << this->dataPtr->schema->name << start
+         << "\">&lt" << this->dataPtr->schema->name << "&gt</a>";
 
   stream << "<div style='padding-left:" << _spacing << "px;'>\n";
 
@@ -505,38 +716,113 @@ void Element::PrintValuesImpl(const std::string &_prefix,
                               bool _includeDefaultAttributes,
                               const PrintConfig &_config,
                               std::ostringstream &_out) const
+{
+  std::string prefix = _prefix;
+  this->WriteImpl(prefix,
+                  _includeDefaultElements,
+                  _includeDefaultAttributes,
+                  _config,
+                  _out,
+                  true);
+}
+
+/////////////////////////////////////////////////
+void Element::WriteImpl(std::string &_prefix,
+                        bool _includeDefaultElements,
+                        bool _includeDefaultAttributes,
+                        const PrintConfig &_config,
+                        std::ostream &_out,
+                        bool _concurrent) const
 {
   if (_config.PreserveIncludes() && this->GetIncludeElement() != nullptr)
   {
-    _out << this->GetIncludeElement()->ToString(_prefix, _config);
+    this->GetIncludeElement()->WriteImpl(
+        _prefix, true, false, _config, _out, false);
+  }
+  else if (!this->RawXml().empty())
+  {
+    // Indent every line of the text
+    const std::string &xml = this->RawXml();
+    for (std::size_t begin = 0; begin < xml.size();)
+    {
+      std::size_t end = xml.find('\n', begin);
+      if (end == std::string::npos)
+        end = xml.size();
+      _out << _prefix;
+      _out.write(xml.data() + begin, end - begin);
+      _out << "\n";
+      begin = end + 1;
+    }
   }
   else if (this->GetExplicitlySetInFile() || _includeDefaultElements)
   {
-    _out << _prefix << "<" << this->dataPtr->name;
+    _out << _prefix << "<" << this->dataPtr->schema->name;
 
     this->dataPtr->PrintAttributes(_includeDefaultAttributes, _config, _out);
 
     if (this->dataPtr->elements.size() > 0)
     {
       _out << ">\n";
-      ElementPtr_V::const_iterator eiter;
-      for (eiter = this->dataPtr->elements.begin();
-           eiter != this->dataPtr->elements.end(); ++eiter)
+      _prefix += "  ";
+      const ElementPtr_V &children = this->dataPtr->elements;
+      if (_concurrent && _config.ThreadCount() > 1 && children.size() > 1)
+      {
+        // Write each child into a buffer of its own, and then write the
+        // buffers in order, so the output is the same as when writing the
+        // children serially. Each task writes whole subtrees, so the values
+        // that are parsed lazily while writing are never shared by tasks.
+        std::vector<std::string> buffers(children.size());
+        std::atomic<std::size_t> nextIndex{0};
+        auto work = [&](std::size_t)
+        {
+          std::ostringstream buffer;
+          std::string prefix;
+          for (std::size_t i = nextIndex++; i < children.size();
+               i = nextIndex++)
+          {
+            buffer.str("");
+            prefix = _prefix;
+            children[i]->WriteImpl(prefix,
+                                   _includeDefaultElements,
+                                   _includeDefaultAttributes,
+                                   _config,
+                                   buffer,
+                                   false);
+            buffers[i] = buffer.str();
+          }
+        };
+        _config.Executor()->RunAndWait(
+            std::min(_config.ThreadCount(), children.size()), work);
+        for (const std::string &buffer : buffers)
+        {
+          _out << buffer;
+        }
+      }
+      else
       {
-        (*eiter)->ToString(_prefix + "  ",
+        // Look for an element with several children below a chain of
+        // elements with a single child, such as the models of the world of
+        // an <sdf> element.
+        const bool concurrent = _concurrent && children.size() == 1;
+        for (const ElementPtr &child : children)
+        {
+          child->WriteImpl(_prefix,
                            _includeDefaultElements,
                            _includeDefaultAttributes,
                            _config,
-                           _out);
+                           _out,
+                           concurrent);
+        }
       }
-      _out << _prefix << "</" << this->dataPtr->name << ">\n";
+      _prefix.resize(_prefix.size() - 2);
+      _out << _prefix << "</" << this->dataPtr->schema->name << ">\n";
     }
     else
     {
       if (this->dataPtr->value)
       {
         _out << ">" << this->dataPtr->value->GetAsString(_config)
-             << "</" << this->dataPtr->name << ">\n";
+             << "</" << this->dataPtr->schema->name << ">\n";
       }
       else
       {
@@ -549,14 +835,14 @@ void Element::PrintValuesImpl(const std::string &_prefix,
 /////////////////////////////////////////////////
 void ElementPrivate::PrintAttributes(bool _includeDefaultAttributes,
                                      const PrintConfig &_config,
-                                     std::ostringstream &_out) const
+                                     std::ostream &_out) const
 {
   // Attribute exceptions are used in the event of a non-default PrintConfig
   // which modifies the Attributes of this Element that are printed out. The
   // modifications to an Attribute by a PrintConfig will overwrite the original
   // existing Attribute when this Element is printed.
   std::set<std::string> attributeExceptions;
-  if (this->name == "pose")
+  if (this->schema->name == "pose")
   {
     if (_config.RotationInDegrees() || _config.RotationSnapToDegrees())
     {
@@ -651,6 +937,30 @@ void Element::ToString(const std::string &_prefix,
                   _out);
 }
 
+/////////////////////////////////////////////////
+void Element::ToStream(std::ostream &_out,
+                       const std::string &_prefix,
+                       const PrintConfig &_config) const
+{
+  this->ToStream(_out, _prefix, true, false, _config);
+}
+
+/////////////////////////////////////////////////
+void Element::ToStream(std::ostream &_out,
+                       const std::string &_prefix,
+                       bool _includeDefaultElements,
+                       bool _includeDefaultAttributes,
+                       const PrintConfig &_config) const
+{
+  std::string prefix = _prefix;
+  this->WriteImpl(prefix,
+                  _includeDefaultElements,
+                  _includeDefaultAttributes,
+                  _config,
+                  _out,
+                  true);
+}
+
 /////////////////////////////////////////////////
 bool Element::HasAttribute(const std::string &_key) const
 {
@@ -680,6 +990,8 @@ void Element::RemoveAttribute(const std::string &_key)
     if ((*iter)->GetKey() == _key)
     {
       this->dataPtr->attributes.erase(iter);
+      this->dataPtr->attributeIndex.reset();
+      this->InvalidateContentHash();
       break;
     }
   }
@@ -689,11 +1001,21 @@ void Element::RemoveAttribute(const std::string &_key)
 void Element::RemoveAllAttributes()
 {
   this->dataPtr->attributes.clear();
+  this->dataPtr->attributeIndex.reset();
+  this->InvalidateContentHash();
 }
 
 /////////////////////////////////////////////////
 ParamPtr Element::GetAttribute(const std::string &_key) const
 {
+  if (const auto &index = this->dataPtr->attributeIndex)
+  {
+    auto it = index->find(_key);
+    if (it == index->end())
+      return ParamPtr();
+    return this->dataPtr->attributes[it->second];
+  }
+
   Param_V::const_iterator iter;
   for (iter = this->dataPtr->attributes.begin();
       iter != this->dataPtr->attributes.end(); ++iter)
@@ -733,26 +1055,34 @@ ParamPtr Element::GetAttribute(unsigned int _index) const
 /////////////////////////////////////////////////
 size_t Element::GetElementDescriptionCount() const
 {
-  return this->dataPtr->elementDescriptions.size();
+  return this->dataPtr->schema->elementDescriptions.size();
 }
 
 /////////////////////////////////////////////////
-ElementPtr Element::GetElementDescription(unsigned int _index) const
+ElementConstPtr Element::GetElementDescription(unsigned int _index) const
 {
-  ElementPtr result;
-  if (_index < this->dataPtr->elementDescriptions.size())
+  ElementConstPtr result;
+  if (_index < this->dataPtr->schema->elementDescriptions.size())
   {
-    result = this->dataPtr->elementDescriptions[_index];
+    result = this->dataPtr->schema->elementDescriptions[_index];
   }
   return result;
 }
 
 /////////////////////////////////////////////////
-ElementPtr Element::GetElementDescription(const std::string &_key) const
+ElementConstPtr Element::GetElementDescription(const std::string &_key) const
 {
+  if (const auto &index = this->dataPtr->schema->descriptionIndex)
+  {
+    auto it = index->find(_key);
+    if (it == index->end())
+      return nullptr;
+    return this->dataPtr->schema->elementDescriptions[it->second];
+  }
+
   ElementPtr_V::const_iterator iter;
-  for (iter = this->dataPtr->elementDescriptions.begin();
-       iter != this->dataPtr->elementDescriptions.end(); ++iter)
+  for (iter = this->dataPtr->schema->elementDescriptions.begin();
+       iter != this->dataPtr->schema->elementDescriptions.end(); ++iter)
   {
     if ((*iter)->GetName() == _key)
     {
@@ -760,7 +1090,7 @@ ElementPtr Element::GetElementDescription(const std::string &_key) const
     }
   }
 
-  return ElementPtr();
+  return nullptr;
 }
 
 /////////////////////////////////////////////////
@@ -778,16 +1108,29 @@ bool Element::HasElement(const std::string &_name) const
 /////////////////////////////////////////////////
 ElementPtr Element::GetElementImpl(const std::string &_name) const
 {
+  if (const auto &elementIndex = this->dataPtr->elementIndex)
+  {
+    countPerf(PerfCounter::GET_ELEMENT_COMPARISONS);
+    auto it = elementIndex->find(_name);
+    if (it == elementIndex->end() || it->second.empty())
+      return ElementPtr();
+    return it->second.front();
+  }
+
+  std::uint64_t comparisons = 0;
   ElementPtr_V::const_iterator iter;
   for (iter = this->dataPtr->elements.begin();
        iter != this->dataPtr->elements.end(); ++iter)
   {
+    ++comparisons;
     if ((*iter)->GetName() == _name)
     {
+      countPerf(PerfCounter::GET_ELEMENT_COMPARISONS, comparisons);
       return (*iter);
     }
   }
 
+  countPerf(PerfCounter::GET_ELEMENT_COMPARISONS, comparisons);
   return ElementPtr();
 }
 
@@ -804,39 +1147,95 @@ ElementPtr Element::GetFirstElement() const
   }
 }
 
+/////////////////////////////////////////////////
+const ElementPtr_V &Element::Elements() const
+{
+  return this->dataPtr->elements;
+}
+
+/////////////////////////////////////////////////
+ElementChildren Element::Children() const
+{
+  return ElementChildren(this->dataPtr->elements);
+}
+
+/////////////////////////////////////////////////
+ElementChildren Element::Children(const std::string &_name) const
+{
+  if (const auto &elementIndex = this->dataPtr->elementIndex)
+  {
+    // The named list only holds children with the name, in document order.
+    static const ElementPtr_V kNoChildren;
+    auto it = elementIndex->find(_name);
+    if (it == elementIndex->end())
+      return ElementChildren(kNoChildren);
+    return ElementChildren(it->second);
+  }
+  return ElementChildren(this->dataPtr->elements, _name);
+}
+
 /////////////////////////////////////////////////
 ElementPtr Element::GetNextElement(const std::string &_name) const
 {
-  auto parent = this->dataPtr->parent.lock();
+  const Element *parent = this->ParentRaw();
   if (parent)
   {
-    ElementPtr_V::const_iterator iter;
-    iter = std::find(parent->dataPtr->elements.begin(),
-        parent->dataPtr->elements.end(), shared_from_this());
-
-    if (iter == parent->dataPtr->elements.end())
-    {
-      return ElementPtr();
-    }
-
-    ++iter;
-    if (iter == parent->dataPtr->elements.end())
+    const ElementPtr_V &siblings = parent->dataPtr->elements;
+    const std::size_t index = this->IndexInParent(*parent);
+    if (index + 1 >= siblings.size())
     {
       return ElementPtr();
     }
     else if (_name.empty())
     {
-      return *(iter);
+      return siblings[index + 1];
     }
-    else
+
+    if (const auto &elementIndex = parent->dataPtr->elementIndex)
     {
-      for (; iter != parent->dataPtr->elements.end(); ++iter)
+      auto it = elementIndex->find(_name);
+      if (it == elementIndex->end())
+      {
+        return ElementPtr();
+      }
+
+      const ElementPtr_V &named = it->second;
+      if (_name == this->dataPtr->schema->name)
       {
-        if ((*iter)->GetName() == _name)
+        std::size_t namedIndex = this->dataPtr->indexInNamedList;
+        if (namedIndex + 1 < named.size() &&
+            named[namedIndex].get() == this)
         {
-          return (*iter);
+          return named[namedIndex + 1];
         }
       }
+
+      // The named list is in document order, so the first entry after this
+      // element can be found with a binary search on the sibling positions.
+      auto next = std::upper_bound(named.begin(), named.end(), index,
+          [](std::size_t _index, const ElementPtr &_elem)
+          {
+            return _index < _elem->dataPtr->indexInParent;
+          });
+      if (next == named.end())
+      {
+        return ElementPtr();
+      }
+      else if ((*next)->IndexInParent(*parent) ==
+          (*next)->dataPtr->indexInParent)
+      {
+        return *next;
+      }
+      // Positions are stale, fall back to the linear scan below.
+    }
+
+    for (auto iter = siblings.begin() + index + 1; iter != siblings.end();
+         ++iter)
+    {
+      if ((*iter)->GetName() == _name)
+      {
+        return (*iter);
+      }
     }
   }
 
@@ -956,7 +1355,7 @@ ElementConstPtr Element::FindElement(const std::string &_name) const
 /////////////////////////////////////////////////
 void Element::InsertElement(ElementPtr _elem)
 {
-  this->dataPtr->elements.push_back(_elem);
+  this->PushElement(_elem);
 }
 
 /////////////////////////////////////////////////
@@ -964,55 +1363,192 @@ void Element::InsertElement(ElementPtr _elem,  bool _setParentToSelf)
 {
   if (_setParentToSelf)
     _elem->SetParent(shared_from_this());
+  this->PushElement(_elem);
+}
+
+/////////////////////////////////////////////////
+void Element::PushElement(ElementPtr _elem)
+{
+  _elem->dataPtr->indexInParent =
+      static_cast<std::uint32_t>(this->dataPtr->elements.size());
   this->dataPtr->elements.push_back(_elem);
+  this->InvalidateContentHash();
+
+  if (this->dataPtr->elementIndex)
+  {
+    ElementPtr_V &named = (*this->dataPtr->elementIndex)[_elem->GetName()];
+    _elem->dataPtr->indexInNamedList =
+        static_cast<std::uint32_t>(named.size());
+    named.push_back(_elem);
+  }
+  else if (this->dataPtr->elements.size() >= kElementIndexThreshold)
+  {
+    this->RebuildElementIndex();
+  }
+}
+
+/////////////////////////////////////////////////
+void Element::EraseElement(std::size_t _index)
+{
+  ElementPtr_V &elements = this->dataPtr->elements;
+  ElementPtr elem = elements[_index];
+  elements.erase(elements.begin() + _index);
+  for (std::size_t i = _index; i < elements.size(); ++i)
+  {
+    elements[i]->dataPtr->indexInParent = static_cast<std::uint32_t>(i);
+  }
+  this->InvalidateContentHash();
+
+  auto &elementIndex = this->dataPtr->elementIndex;
+  if (!elementIndex)
+    return;
+  auto it = elementIndex->find(elem->GetName());
+  if (it != elementIndex->end())
+  {
+    ElementPtr_V &named = it->second;
+    auto namedIter = std::find(named.begin(), named.end(), elem);
+    if (namedIter != named.end())
+    {
+      namedIter = named.erase(namedIter);
+      for (; namedIter != named.end(); ++namedIter)
+      {
+        (*namedIter)->dataPtr->indexInNamedList =
+          static_cast<std::uint32_t>(namedIter - named.begin());
+      }
+    }
+    if (named.empty())
+    {
+      elementIndex->erase(it);
+      if (elementIndex->empty())
+        elementIndex.reset();
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void Element::RebuildElementIndex()
+{
+  this->dataPtr->elementIndex.reset();
+  if (this->dataPtr->elements.size() < kElementIndexThreshold)
+    return;
+
+  auto elementIndex =
+      std::make_unique<std::unordered_map<std::string, ElementPtr_V>>();
+  for (std::size_t i = 0; i < this->dataPtr->elements.size(); ++i)
+  {
+    const ElementPtr &elem = this->dataPtr->elements[i];
+    elem->dataPtr->indexInParent = static_cast<std::uint32_t>(i);
+    ElementPtr_V &named = (*elementIndex)[elem->GetName()];
+    elem->dataPtr->indexInNamedList =
+        static_cast<std::uint32_t>(named.size());
+    named.push_back(elem);
+  }
+  this->dataPtr->elementIndex = std::move(elementIndex);
+}
+
+/////////////////////////////////////////////////
+std::size_t Element::IndexInParent(const Element &_parent) const
+{
+  const ElementPtr_V &siblings = _parent.dataPtr->elements;
+  const std::size_t index = this->dataPtr->indexInParent;
+  if (index < siblings.size() && siblings[index].get() == this)
+    return index;
+
+  // The cached position is stale, e.g. because this element was also
+  // inserted into another parent, so fall back to a linear search.
+  for (std::size_t i = 0; i < siblings.size(); ++i)
+  {
+    if (siblings[i].get() == this)
+      return i;
+  }
+  return siblings.size();
+}
+
+/////////////////////////////////////////////////
+std::uint64_t Element::ContentHash() const
+{
+  std::uint64_t hash = this->dataPtr->contentHash.load();
+  if (hash != 0)
+    return hash;
+
+  hash = kFnvOffsetBasis;
+  hashString(hash, this->dataPtr->schema->name);
+  hashNumber(hash, this->dataPtr->attributes.size());
+  for (const ParamPtr &attribute : this->dataPtr->attributes)
+  {
+    hashString(hash, attribute->GetKey());
+    hashString(hash, attribute->GetAsString());
+  }
+  hashNumber(hash, this->dataPtr->value ? 1 : 0);
+  if (this->dataPtr->value)
+    hashString(hash, this->dataPtr->value->GetAsString());
+  hashString(hash, this->RawXml());
+
+  hashNumber(hash, this->dataPtr->elements.size());
+  for (const ElementPtr &child : this->dataPtr->elements)
+    hashNumber(hash, child->ContentHash());
+
+  // 0 marks a hash that is not cached.
+  if (hash == 0)
+    hash = 1;
+  this->dataPtr->contentHash = hash;
+  return hash;
+}
+
+/////////////////////////////////////////////////
+void Element::InvalidateContentHash()
+{
+  // The ancestors of an element whose hash is not cached do not have a
+  // cached hash either, so the walk stops there.
+  if (this->dataPtr->contentHash.exchange(0) == 0)
+    return;
+
+  if (Element *parent = this->ParentRaw())
+    parent->InvalidateContentHash();
 }
 
 /////////////////////////////////////////////////
 bool Element::HasElementDescription(const std::string &_name) const
 {
-  return this->GetElementDescription(_name) != ElementPtr();
+  return this->GetElementDescription(_name) != nullptr;
 }
 
 /////////////////////////////////////////////////
 ElementPtr Element::AddElement(const std::string &_name)
 {
+  countPerf(PerfCounter::ADD_ELEMENT_CALLS);
+
   // if this element is a reference sdf and does not have any element
   // descriptions then get them from its parent
-  auto parent = this->dataPtr->parent.lock();
-  if (!this->dataPtr->referenceSDF.empty() &&
-      this->dataPtr->elementDescriptions.empty() && parent &&
-      parent->GetName() == this->dataPtr->name)
+  const Element *parent = this->ParentRaw();
+  if (!this->dataPtr->schema->referenceSDF.Str().empty() &&
+      this->dataPtr->schema->elementDescriptions.empty() && parent &&
+      parent->GetName() == this->dataPtr->schema->name)
   {
-    for (unsigned int i = 0; i < parent->GetElementDescriptionCount(); ++i)
-    {
-      this->dataPtr->elementDescriptions.push_back(
-          parent->GetElementDescription(i)->Clone());
-    }
+    ElementSchema &schema = this->dataPtr->MutableSchema();
+    schema.elementDescriptions = parent->dataPtr->schema->elementDescriptions;
+    schema.descriptionIndex = parent->dataPtr->schema->descriptionIndex;
   }
 
-  ElementPtr_V::const_iterator iter, iter2;
-  for (iter = this->dataPtr->elementDescriptions.begin();
-      iter != this->dataPtr->elementDescriptions.end(); ++iter)
+  ElementPtr_V::const_iterator iter2;
+  if (ElementConstPtr desc = this->GetElementDescription(_name))
   {
-    if ((*iter)->dataPtr->name == _name)
-    {
-      ElementPtr elem = (*iter)->Clone();
-      elem->SetParent(shared_from_this());
-      this->dataPtr->elements.push_back(elem);
+    ElementPtr elem = desc->Clone();
+    elem->SetParent(shared_from_this());
+    this->PushElement(elem);
 
-      // Add all child elements.
-      for (iter2 = elem->dataPtr->elementDescriptions.begin();
-           iter2 != elem->dataPtr->elementDescriptions.end(); ++iter2)
+    // Add all child elements.
+    for (iter2 = elem->dataPtr->schema->elementDescriptions.begin();
+         iter2 != elem->dataPtr->schema->elementDescriptions.end(); ++iter2)
+    {
+      // Add only required child element
+      if ((*iter2)->GetRequired() == "1")
       {
-        // Add only required child element
-        if ((*iter2)->GetRequired() == "1")
-        {
-          elem->AddElement((*iter2)->dataPtr->name);
-        }
+        elem->AddElement((*iter2)->dataPtr->schema->name);
       }
-
-      return this->dataPtr->elements.back();
     }
+
+    return this->dataPtr->elements.back();
   }
 
   sdferr << "Missing element description for [" << _name << "]\n";
@@ -1023,10 +1559,10 @@ ElementPtr Element::AddElement(const std::string &_name)
 void Element::Clear()
 {
   this->ClearElements();
-  this->dataPtr->originalVersion.clear();
-  this->dataPtr->path.clear();
-  this->dataPtr->lineNumber = std::nullopt;
-  this->dataPtr->xmlPath.clear();
+  this->dataPtr->originalVersion = InternedString();
+  this->dataPtr->path.reset();
+  this->dataPtr->hasLineNumber = false;
+  this->dataPtr->xmlPath.reset();
 }
 
 /////////////////////////////////////////////////
@@ -1039,6 +1575,8 @@ void Element::ClearElements()
   }
 
   this->dataPtr->elements.clear();
+  this->dataPtr->elementIndex.reset();
+  this->InvalidateContentHash();
 }
 
 /////////////////////////////////////////////////
@@ -1075,81 +1613,127 @@ void Element::Reset()
     (*iter).reset();
   }
 
-  for (ElementPtr_V::iterator iter = this->dataPtr->elementDescriptions.begin();
-      iter != this->dataPtr->elementDescriptions.end(); ++iter)
+  // Element descriptions may be shared with other elements, so only the
+  // references held by this element are released.
+  this->dataPtr->elements.clear();
+  this->dataPtr->elementIndex.reset();
+  if (!this->dataPtr->schema->elementDescriptions.empty())
   {
-    if (*iter)
-    {
-      (*iter)->Reset();
-    }
-    (*iter).reset();
+    ElementSchema schema;
+    schema.name = this->dataPtr->schema->name;
+    schema.required = this->dataPtr->schema->required;
+    schema.description = this->dataPtr->schema->description;
+    schema.referenceSDF = this->dataPtr->schema->referenceSDF;
+    schema.copyChildren = this->dataPtr->schema->copyChildren;
+    this->dataPtr->schema = std::make_shared<const ElementSchema>(
+        std::move(schema));
   }
-  this->dataPtr->elements.clear();
-  this->dataPtr->elementDescriptions.clear();
 
   this->dataPtr->value.reset();
 
   this->dataPtr->parent.reset();
+  this->dataPtr->parentRaw = nullptr;
 }
 
 /////////////////////////////////////////////////
 void Element::AddElementDescription(ElementPtr _elem)
 {
-  this->dataPtr->elementDescriptions.push_back(_elem);
+  ElementSchema &schema = this->dataPtr->MutableSchema();
+  schema.elementDescriptions.push_back(_elem);
+  addToNameIndex(schema.descriptionIndex, _elem->GetName(),
+                 schema.elementDescriptions.size() - 1);
 }
 
 /////////////////////////////////////////////////
 void Element::SetIncludeElement(sdf::ElementPtr _includeElem)
 {
-  this->dataPtr->includeElement = _includeElem;
+  if (_includeElem)
+    this->dataPtr->MutableExtras().includeElement = _includeElem;
+  else if (this->dataPtr->extras)
+    this->dataPtr->extras->includeElement.reset();
 }
 
 /////////////////////////////////////////////////
 sdf::ElementPtr Element::GetIncludeElement() const
 {
-  return this->dataPtr->includeElement;
+  if (!this->dataPtr->extras)
+    return ElementPtr();
+  return this->dataPtr->extras->includeElement;
 }
 
 /////////////////////////////////////////////////
 void Element::SetFilePath(const std::string &_path)
 {
-  this->dataPtr->path = _path;
+  if (_path.empty())
+    this->dataPtr->path.reset();
+  else if (!this->dataPtr->path || *this->dataPtr->path != _path)
+    this->dataPtr->path = internFilePath(_path);
 }
 
 /////////////////////////////////////////////////
 const std::string &Element::FilePath() const
 {
-  return this->dataPtr->path;
+  static const std::string kEmptyPath;
+  return this->dataPtr->path ? *this->dataPtr->path : kEmptyPath;
 }
 
 /////////////////////////////////////////////////
 void Element::SetLineNumber(int _lineNumber)
 {
   this->dataPtr->lineNumber = _lineNumber;
+  this->dataPtr->hasLineNumber = true;
 }
 
 /////////////////////////////////////////////////
 std::optional<int> Element::LineNumber() const
 {
+  if (!this->dataPtr->hasLineNumber)
+    return std::nullopt;
   return this->dataPtr->lineNumber;
 }
 
 /////////////////////////////////////////////////
 void Element::SetXmlPath(const std::string &_path)
 {
-  this->dataPtr->xmlPath = _path;
+  if (_path.empty())
+  {
+    this->dataPtr->xmlPath.reset();
+    return;
+  }
+
+  // Store only the part after the parent's path when it extends it, which
+  // is the case for all the elements read by the parser.
+  const Element *parent = this->ParentRaw();
+  if (parent && parent->dataPtr->xmlPath)
+  {
+    const std::size_t pos = matchXmlPath(*parent->dataPtr->xmlPath, _path);
+    if (pos != std::string::npos && pos + 1 < _path.size() &&
+        _path[pos] == '/')
+    {
+      this->dataPtr->xmlPath = std::make_shared<const XmlPathNode>(
+          parent->dataPtr->xmlPath, _path.substr(pos + 1));
+      return;
+    }
+  }
+
+  this->dataPtr->xmlPath =
+      std::make_shared<const XmlPathNode>(nullptr, _path);
 }
 
 /////////////////////////////////////////////////
 const std::string &Element::XmlPath() const
 {
-  return this->dataPtr->xmlPath;
+  static const std::string empty;
+  if (!this->dataPtr->xmlPath)
+    return empty;
+  return fullXmlPath(*this->dataPtr->xmlPath);
 }
 
 /////////////////////////////////////////////////
 void Element::SetOriginalVersion(const std::string &_version)
 {
-  this->dataPtr->originalVersion = _version;
+  if (this->dataPtr->originalVersion != _version)
+    this->dataPtr->originalVersion = _version;
 }
 
 /////////////////////////////////////////////////
@@ -1161,13 +1745,14 @@ const std::string &Element::OriginalVersion() const
 /////////////////////////////////////////////////
 std::string Element::GetDescription() const
 {
-  return this->dataPtr->description;
+  return this->dataPtr->schema->description;
 }
 
 /////////////////////////////////////////////////
 void Element::SetDescription(const std::string &_desc)
 {
-  this->dataPtr->description = _desc;
+  if (this->dataPtr->schema->description != _desc)
+    this->dataPtr->MutableSchema().description = _desc;
 }
 
 /////////////////////////////////////////////////
@@ -1176,13 +1761,10 @@ void Element::RemoveFromParent()
   auto parent = this->dataPtr->parent.lock();
   if (parent)
   {
-    ElementPtr_V::iterator iter;
-    iter = std::find(parent->dataPtr->elements.begin(),
-        parent->dataPtr->elements.end(), shared_from_this());
-
-    if (iter != parent->dataPtr->elements.end())
+    const std::size_t index = this->IndexInParent(*parent);
+    if (index < parent->dataPtr->elements.size())
     {
-      parent->dataPtr->elements.erase(iter);
+      parent->EraseElement(index);
       parent.reset();
     }
   }
@@ -1193,15 +1775,84 @@ void Element::RemoveChild(ElementPtr _child)
 {
   SDF_ASSERT(_child, "Cannot remove a nullptr child pointer");
 
-  ElementPtr_V::iterator iter;
-  iter = std::find(this->dataPtr->elements.begin(),
-                   this->dataPtr->elements.end(), _child);
-
-  if (iter != this->dataPtr->elements.end())
+  const std::size_t index = _child->IndexInParent(*this);
+  if (index < this->dataPtr->elements.size())
   {
     _child->SetParent(ElementPtr());
-    this->dataPtr->elements.erase(iter);
+    this->EraseElement(index);
+  }
+}
+
+/////////////////////////////////////////////////
+bool Element::ReplaceChild(ElementPtr _child, ElementPtr _replacement)
+{
+  SDF_ASSERT(_child, "Cannot replace a nullptr child pointer");
+  SDF_ASSERT(_replacement, "Cannot replace a child with a nullptr pointer");
+
+  const std::size_t index = _child->IndexInParent(*this);
+  if (index >= this->dataPtr->elements.size())
+    return false;
+
+  _child->SetParent(ElementPtr());
+  _replacement->SetParent(shared_from_this());
+  _replacement->dataPtr->indexInParent = static_cast<std::uint32_t>(index);
+  this->dataPtr->elements[index] = _replacement;
+  this->InvalidateContentHash();
+
+  // The replacement may have another name, so the name index is rebuilt.
+  if (this->dataPtr->elementIndex)
+    this->RebuildElementIndex();
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::size_t Element::RemoveChildrenIf(
+    const std::function<bool(const ElementPtr &)> &_predicate)
+{
+  ElementPtr_V &elements = this->dataPtr->elements;
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < elements.size(); ++i)
+  {
+    if (_predicate(elements[i]))
+    {
+      elements[i]->SetParent(ElementPtr());
+      continue;
+    }
+    if (kept != i)
+      elements[kept] = std::move(elements[i]);
+    elements[kept]->dataPtr->indexInParent =
+        static_cast<std::uint32_t>(kept);
+    ++kept;
+  }
+
+  const std::size_t removed = elements.size() - kept;
+  if (removed == 0)
+    return 0;
+
+  elements.resize(kept);
+  this->InvalidateContentHash();
+  if (this->dataPtr->elementIndex)
+    this->RebuildElementIndex();
+  return removed;
+}
+
+/////////////////////////////////////////////////
+void Element::ReplaceChildren(ElementPtr_V _children)
+{
+  for (const ElementPtr &child : this->dataPtr->elements)
+    child->SetParent(ElementPtr());
+
+  this->dataPtr->elements = std::move(_children);
+  const ElementPtr self = shared_from_this();
+  for (std::size_t i = 0; i < this->dataPtr->elements.size(); ++i)
+  {
+    const ElementPtr &child = this->dataPtr->elements[i];
+    SDF_ASSERT(child, "Cannot add a nullptr child pointer");
+    child->SetParent(self);
+    child->dataPtr->indexInParent = static_cast<std::uint32_t>(i);
   }
+  this->InvalidateContentHash();
+  this->RebuildElementIndex();
 }
 
 /////////////////////////////////////////////////
@@ -1235,10 +1886,10 @@ std::any Element::GetAny(const std::string &_key) const
       }
       else
       {
-        tmp = this->GetElementDescription(_key);
-        if (tmp != ElementPtr())
+        ElementConstPtr desc = this->GetElementDescription(_key);
+        if (desc != nullptr)
         {
-          result = tmp->GetAny();
+          result = desc->GetAny();
         }
         else
         {
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "sdf/Filesystem.hh"
+#include "sdf/parser.hh"
+
+#include "BinarySdf.hh"
+#include "ElementCache.hh"
+#include "ParamValueChecks.hh"
+#include "Utils.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+namespace
+{
+/// \brief First bytes of a cache file.
+constexpr char kMagic[] = {'S', 'D', 'F', 'C'};
+
+/// \brief Version of the layout of cache files. Increment it when the
+/// layout changes.
+constexpr std::uint32_t kFormatVersion = 2;
+}
+
+/////////////////////////////////////////////////
+bool ElementCache::Write(const std::string &_cacheFile,
+    const std::string &_filename, const ParserConfig &_config,
+    const SDFPtr &_sdf)
+{
+  if (!_sdf || !_sdf->Root())
+    return false;
+
+  // The elements are encoded like binary documents, but with their line
+  // numbers, XML paths, include elements and original value strings, so
+  // that they are the elements that the parser returned.
+  BinarySdfWriter elements(_config);
+  elements.keepSource = true;
+  Errors errors;
+  if (!elements.WriteElement(_sdf->Root(), nullptr, errors))
+    return false;
+
+  std::set<std::string> files;
+  for (const auto &source : elements.sources)
+  {
+    if (!source.first.first.empty())
+      files.insert(source.first.first);
+  }
+
+  BinarySdfWriter out(_config);
+  out.buffer.append(kMagic, sizeof(kMagic));
+  out.U64(kFormatVersion);
+  out.String(SDF_VERSION_FULL);
+  out.String(SDF::Version());
+  out.String(_filename);
+
+  out.U64(files.size());
+  for (const auto &file : files)
+  {
+    std::uint64_t hash = 0;
+    std::uint64_t size = 0;
+    if (!hashFile(file, hash, size))
+      return false;
+    out.String(file);
+    out.U64(size);
+    out.U64(hash);
+  }
+
+  out.String(_sdf->FilePath());
+  out.String(_sdf->OriginalVersion());
+  out.WriteSources(elements);
+  out.buffer += elements.buffer;
+
+  // Write to a temporary file first, so that processes reading the cache
+  // never see a partially written file.
+  const std::string tmpFile = _cacheFile + ".tmp";
+  {
+    std::ofstream file(tmpFile, std::ios::binary | std::ios::trunc);
+    if (!file.write(out.buffer.data(),
+                    static_cast<std::streamsize>(out.buffer.size())))
+    {
+      return false;
+    }
+  }
+
+  if (!filesystem::rename(tmpFile, _cacheFile))
+  {
+    filesystem::remove(tmpFile);
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ElementCache::Read(const std::string &_cacheFile,
+    const std::string &_filename, const ParserConfig &_config,
+    SDFPtr &_sdf)
+{
+  std::string buffer;
+  {
+    std::ifstream file(_cacheFile, std::ios::binary);
+    if (!file)
+      return false;
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    buffer = contents.str();
+  }
+
+  BinarySdfReader in(buffer, _config);
+  std::uint64_t formatVersion = 0;
+  std::string libraryVersion;
+  std::string specVersion;
+  std::string filename;
+  if (!in.Expect(kMagic, sizeof(kMagic)) || !in.U64(formatVersion) ||
+      formatVersion != kFormatVersion || !in.String(libraryVersion) ||
+      libraryVersion != SDF_VERSION_FULL || !in.String(specVersion) ||
+      specVersion != SDF::Version() || !in.String(filename) ||
+      filename != _filename)
+  {
+    return false;
+  }
+
+  std::uint64_t fileCount = 0;
+  if (!in.U64(fileCount))
+    return false;
+  for (std::uint64_t i = 0; i < fileCount; ++i)
+  {
+    std::string file;
+    std::uint64_t cachedSize = 0;
+    std::uint64_t cachedHash = 0;
+    std::uint64_t size = 0;
+    std::uint64_t hash = 0;
+    if (!in.String(file) || !in.U64(cachedSize) || !in.U64(cachedHash) ||
+        !hashFile(file, hash, size) || size != cachedSize ||
+        hash != cachedHash)
+    {
+      return false;
+    }
+  }
+
+  std::string filePath;
+  std::string originalVersion;
+  if (!in.String(filePath) || !in.String(originalVersion) ||
+      !in.ReadSources(""))
+  {
+    return false;
+  }
+
+  // Values were checked when the cache was written.
+  ScopedParamValueChecks valueChecks(false);
+
+  SDFPtr sdfCached(new SDF());
+  init(sdfCached, _config);
+  sdfCached->SetFilePath(filePath);
+  sdfCached->SetOriginalVersion(originalVersion);
+  if (!in.ReadElement(sdfCached->Root()) || !in.AtEnd())
+    return false;
+
+  _sdf = sdfCached;
+  return true;
+}
+}
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_ELEMENTCACHE_HH
+#define SDFORMAT_ELEMENTCACHE_HH
+
+#include <string>
+
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Binary cache of the elements parsed from a file, used by
+  /// Root::LoadCached. A cache file holds the element tree of a document
+  /// after conversion, includes and parameter passing, together with the
+  /// library and specification versions it was written with and the size
+  /// and content hash of every file its elements were read from. It is only
+  /// used when all of them still match. The elements are encoded with
+  /// BinarySdfWriter, keeping their source.
+  class ElementCache
+  {
+    /// \brief Write the elements of a document to a cache file.
+    /// \param[in] _cacheFile Path of the cache file.
+    /// \param[in] _filename File name the document was loaded from, as given
+    /// to Root::LoadCached.
+    /// \param[in] _config Parser configuration, used to get the element
+    /// descriptions.
+    /// \param[in] _sdf The document.
+    /// \return True if the cache file was written. False if it could not be
+    /// written, or if an element was not read from a file that can be
+    /// hashed.
+    public: static bool Write(const std::string &_cacheFile,
+                              const std::string &_filename,
+                              const ParserConfig &_config,
+                              const SDFPtr &_sdf);
+
+    /// \brief Read the elements of a document from a cache file.
+    /// \param[in] _cacheFile Path of the cache file.
+    /// \param[in] _filename File name the document is loaded from, as given
+    /// to Root::LoadCached.
+    /// \param[in] _config Parser configuration, used to get the element
+    /// descriptions.
+    /// \param[out] _sdf New document with the cached elements.
+    /// \return True if the cache file exists, was written for _filename by
+    /// this version of the library, and none of its input files changed.
+    public: static bool Read(const std::string &_cacheFile,
+                             const std::string &_filename,
+                             const ParserConfig &_config,
+                             SDFPtr &_sdf);
+  };
+  }
+}
+#endif
@@ -0,0 +1,284 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <locale>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sdf/ElementDiff.hh"
+#include "sdf/Root.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/////////////////////////////////////////////////
+/// \brief Read a value as a list of numbers.
+/// \param[in] _value The value.
+/// \param[out] _numbers The numbers.
+/// \return True if the value is a non-empty list of numbers.
+static bool parseNumbers(const std::string &_value,
+    std::vector<double> &_numbers)
+{
+  std::istringstream in(_value);
+  in.imbue(std::locale::classic());
+  double number = 0;
+  while (in >> number)
+    _numbers.push_back(number);
+  return in.eof() && !_numbers.empty();
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether two values are equivalent.
+/// \param[in] _before The first value.
+/// \param[in] _after The second value.
+/// \param[in] _tolerance Largest difference between equal numbers.
+/// \return True if the values are equal strings, or lists of equal numbers.
+static bool equivalentValues(const std::string &_before,
+    const std::string &_after, double _tolerance)
+{
+  if (_before == _after)
+    return true;
+
+  std::vector<double> before;
+  std::vector<double> after;
+  if (!parseNumbers(_before, before) || !parseNumbers(_after, after) ||
+      before.size() != after.size())
+  {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < before.size(); ++i)
+  {
+    if (!(std::abs(before[i] - after[i]) <= _tolerance))
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief A child element, with the key it is matched by.
+struct KeyedChild
+{
+  /// \brief Element name, followed by the name attribute if it has one.
+  std::string segment;
+
+  /// \brief Number of previous children with the same segment.
+  std::size_t occurrence = 0;
+
+  /// \brief The child.
+  ElementPtr elem;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the segment of an element in its XML path.
+/// \param[in] _elem The element.
+/// \return The element name, followed by the name attribute if it is set.
+static std::string pathSegment(const ElementPtr &_elem)
+{
+  std::string segment = _elem->GetName();
+  ParamPtr name = _elem->GetAttribute("name");
+  if (name && !name->GetAsString().empty())
+    segment += "[@name=\"" + name->GetAsString() + "\"]";
+  return segment;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the children of an element with their keys.
+/// \param[in] _elem The element.
+/// \param[in,out] _counts Number of children with each segment. The
+/// largest number of the two compared elements is kept.
+/// \return The children, in order.
+static std::vector<KeyedChild> keyedChildren(const ElementPtr &_elem,
+    std::map<std::string, std::size_t> &_counts)
+{
+  std::vector<KeyedChild> children;
+  std::map<std::string, std::size_t> counts;
+  for (ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    std::string segment = pathSegment(child);
+    const std::size_t occurrence = counts[segment]++;
+    children.push_back({std::move(segment), occurrence, child});
+  }
+
+  for (const auto &[segment, count] : counts)
+  {
+    std::size_t &maxCount = _counts[segment];
+    maxCount = std::max(maxCount, count);
+  }
+  return children;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the XML path of a child.
+/// \param[in] _parentPath XML path of the parent.
+/// \param[in] _child The child.
+/// \param[in] _counts Number of children with each segment.
+/// \return The XML path.
+static std::string childPath(const std::string &_parentPath,
+    const KeyedChild &_child, const std::map<std::string, std::size_t> &_counts)
+{
+  std::string path = _parentPath + "/" + _child.segment;
+  if (_counts.at(_child.segment) > 1)
+    path += "[" + std::to_string(_child.occurrence) + "]";
+  return path;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the value of an element as a string.
+/// \param[in] _elem The element.
+/// \return The value, or an empty string if it has no value.
+static std::string elementValue(const ElementPtr &_elem)
+{
+  return _elem->GetValue() ? _elem->GetValue()->GetAsString() : "";
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare two elements with the same path and their descendants.
+/// \param[in] _before The first element.
+/// \param[in] _after The second element.
+/// \param[in] _path XML path of the elements.
+/// \param[in] _tolerance Largest difference between equal numbers.
+/// \param[in,out] _diffs The differences.
+static void diffElement(const ElementPtr &_before, const ElementPtr &_after,
+    const std::string &_path, double _tolerance,
+    std::vector<ElementDifference> &_diffs)
+{
+  if (_before->ContentHash() == _after->ContentHash())
+    return;
+
+  for (const ParamPtr &attribute : _before->GetAttributes())
+  {
+    const std::string &key = attribute->GetKey();
+    ParamPtr other = _after->GetAttribute(key);
+    if (!other)
+    {
+      _diffs.push_back({ElementDifferenceType::ATTRIBUTE_REMOVED, _path, key,
+          attribute->GetAsString(), ""});
+    }
+    else if (!equivalentValues(attribute->GetAsString(),
+                               other->GetAsString(), _tolerance))
+    {
+      _diffs.push_back({ElementDifferenceType::ATTRIBUTE_CHANGED, _path, key,
+          attribute->GetAsString(), other->GetAsString()});
+    }
+  }
+  for (const ParamPtr &attribute : _after->GetAttributes())
+  {
+    const std::string &key = attribute->GetKey();
+    if (!_before->GetAttribute(key))
+    {
+      _diffs.push_back({ElementDifferenceType::ATTRIBUTE_ADDED, _path, key,
+          "", attribute->GetAsString()});
+    }
+  }
+
+  const std::string beforeValue = elementValue(_before);
+  const std::string afterValue = elementValue(_after);
+  if (!equivalentValues(beforeValue, afterValue, _tolerance))
+  {
+    _diffs.push_back({ElementDifferenceType::VALUE_CHANGED, _path, "",
+        beforeValue, afterValue});
+  }
+  if (_before->RawXml() != _after->RawXml())
+  {
+    _diffs.push_back({ElementDifferenceType::VALUE_CHANGED, _path, "",
+        _before->RawXml(), _after->RawXml()});
+  }
+
+  std::map<std::string, std::size_t> counts;
+  const std::vector<KeyedChild> beforeChildren =
+      keyedChildren(_before, counts);
+  const std::vector<KeyedChild> afterChildren = keyedChildren(_after, counts);
+
+  std::map<std::pair<std::string, std::size_t>, std::size_t> afterIndex;
+  for (std::size_t i = 0; i < afterChildren.size(); ++i)
+  {
+    afterIndex[{afterChildren[i].segment, afterChildren[i].occurrence}] = i;
+  }
+
+  std::vector<bool> matched(afterChildren.size(), false);
+  for (const KeyedChild &child : beforeChildren)
+  {
+    const std::string path = childPath(_path, child, counts);
+    auto it = afterIndex.find({child.segment, child.occurrence});
+    if (it == afterIndex.end())
+    {
+      _diffs.push_back({ElementDifferenceType::ELEMENT_REMOVED, path, "",
+          child.elem->ToString(""), ""});
+      continue;
+    }
+
+    matched[it->second] = true;
+    diffElement(child.elem, afterChildren[it->second].elem, path, _tolerance,
+        _diffs);
+  }
+
+  for (std::size_t i = 0; i < afterChildren.size(); ++i)
+  {
+    if (!matched[i])
+    {
+      _diffs.push_back({ElementDifferenceType::ELEMENT_ADDED,
+          childPath(_path, afterChildren[i], counts), "", "",
+          afterChildren[i].elem->ToString("")});
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+std::vector<ElementDifference> diffElements(const ElementPtr &_before,
+    const ElementPtr &_after, double _tolerance)
+{
+  std::vector<ElementDifference> diffs;
+  if (!_before && !_after)
+    return diffs;
+
+  const std::string beforePath = _before ? "/" + pathSegment(_before) : "";
+  const std::string afterPath = _after ? "/" + pathSegment(_after) : "";
+  if (beforePath != afterPath)
+  {
+    if (_before)
+    {
+      diffs.push_back({ElementDifferenceType::ELEMENT_REMOVED, beforePath, "",
+          _before->ToString(""), ""});
+    }
+    if (_after)
+    {
+      diffs.push_back({ElementDifferenceType::ELEMENT_ADDED, afterPath, "",
+          "", _after->ToString("")});
+    }
+    return diffs;
+  }
+
+  diffElement(_before, _after, beforePath, _tolerance, diffs);
+  return diffs;
+}
+
+/////////////////////////////////////////////////
+std::vector<ElementDifference> diffRoots(const Root &_before,
+    const Root &_after, double _tolerance)
+{
+  return diffElements(_before.ToElement(), _after.ToElement(), _tolerance);
+}
+}
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "sdf/ElementDiff.hh"
+#include "sdf/Model.hh"
+#include "sdf/Root.hh"
+#include "sdf/World.hh"
+#include "sdf/parser.hh"
+
+/////////////////////////////////////////////////
+/// \brief Read an SDF string into elements.
+/// \param[in] _sdf The SDF string.
+/// \return The root element.
+sdf::ElementPtr readElements(const std::string &_sdf)
+{
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  sdf::init(sdfParsed);
+  EXPECT_TRUE(sdf::readString(_sdf, sdfParsed));
+  return sdfParsed->Root();
+}
+
+/////////////////////////////////////////////////
+TEST(ElementDiff, Elements)
+{
+  const sdf::ElementPtr before = readElements(R"(
+<sdf version='1.9'>
+  <model name='m'>
+    <static>false</static>
+    <pose>1 2 3 0 0 0</pose>
+    <link name='a'>
+      <pose>0 0 0.5 0 0 0</pose>
+    </link>
+    <link name='b'/>
+  </model>
+</sdf>)");
+  const sdf::ElementPtr after = readElements(R"(
+<sdf version='1.9'>
+  <model name='m'>
+    <static>true</static>
+    <pose>1.0 2.00 3 0 0 0</pose>
+    <link name='b'/>
+    <link name='a'>
+      <pose>0 0 0.5001 0 0 0</pose>
+    </link>
+    <link name='c'/>
+  </model>
+</sdf>)");
+
+  EXPECT_TRUE(sdf::diffElements(before, before).empty());
+  EXPECT_TRUE(sdf::diffElements(before, before->Clone()).empty());
+  EXPECT_TRUE(sdf::diffElements(nullptr, nullptr).empty());
+
+  // The formatting of numbers and the order of named children are ignored.
+  std::vector<sdf::ElementDifference> diffs =
+      sdf::diffElements(before, after, 1e-3);
+  ASSERT_EQ(2u, diffs.size());
+  EXPECT_EQ(sdf::ElementDifferenceType::VALUE_CHANGED, diffs[0].type);
+  EXPECT_EQ("/sdf/model[@name=\"m\"]/static", diffs[0].xmlPath);
+  EXPECT_TRUE(diffs[0].attribute.empty());
+  EXPECT_EQ("false", diffs[0].before);
+  EXPECT_EQ("true", diffs[0].after);
+  EXPECT_EQ(sdf::ElementDifferenceType::ELEMENT_ADDED, diffs[1].type);
+  EXPECT_EQ("/sdf/model[@name=\"m\"]/link[@name=\"c\"]", diffs[1].xmlPath);
+  EXPECT_TRUE(diffs[1].before.empty());
+  EXPECT_NE(std::string::npos, diffs[1].after.find("<link name='c'"));
+
+  // Without a tolerance, the pose of link a differs.
+  diffs = sdf::diffElements(before, after);
+  ASSERT_EQ(3u, diffs.size());
+  EXPECT_EQ(sdf::ElementDifferenceType::VALUE_CHANGED, diffs[1].type);
+  EXPECT_EQ("/sdf/model[@name=\"m\"]/link[@name=\"a\"]/pose",
+            diffs[1].xmlPath);
+
+  // Attributes are compared, and so are the roots.
+  const sdf::ElementPtr renamed = before->Clone();
+  renamed->GetElement("model")->GetAttribute("name")->Set("n");
+  diffs = sdf::diffElements(before, renamed);
+  ASSERT_EQ(2u, diffs.size());
+  EXPECT_EQ(sdf::ElementDifferenceType::ELEMENT_REMOVED, diffs[0].type);
+  EXPECT_EQ("/sdf/model[@name=\"m\"]", diffs[0].xmlPath);
+  EXPECT_EQ(sdf::ElementDifferenceType::ELEMENT_ADDED, diffs[1].type);
+  EXPECT_EQ("/sdf/model[@name=\"n\"]", diffs[1].xmlPath);
+
+  diffs = sdf::diffElements(before->GetElement("model"),
+                            renamed->GetElement("model"));
+  ASSERT_EQ(2u, diffs.size());
+  EXPECT_EQ(sdf::ElementDifferenceType::ELEMENT_REMOVED, diffs[0].type);
+  EXPECT_EQ("/model[@name=\"m\"]", diffs[0].xmlPath);
+
+  diffs = sdf::diffElements(before, nullptr);
+  ASSERT_EQ(1u, diffs.size());
+  EXPECT_EQ(sdf::ElementDifferenceType::ELEMENT_REMOVED, diffs[0].type);
+  EXPECT_EQ("/sdf", diffs[0].xmlPath);
+}
+
+/////////////////////////////////////////////////
+TEST(ElementDiff, UnnamedChildren)
+{
+  const sdf::ElementPtr before = readElements(R"(
+<sdf version='1.9'>
+  <model name='m'>
+    <link name='a'>
+      <visual name='v'>
+        <geometry>
+          <box><size>1 1 1</size></box>
+        </geometry>
+      </visual>
+    </link>
+  </model>
+</sdf>)");
+  const sdf::ElementPtr after = before->Clone();
+  after->GetElement("model")->GetElement("link")->GetElement("visual")
+      ->GetElement("geometry")->GetElement("box")->GetElement("size")
+      ->Set("1 2 1");
+
+  const std::vector<sdf::ElementDifference> diffs =
+      sdf::diffElements(before, after);
+  ASSERT_EQ(1u, diffs.size());
+  EXPECT_EQ(sdf::ElementDifferenceType::VALUE_CHANGED, diffs[0].type);
+  EXPECT_EQ("/sdf/model[@name=\"m\"]/link[@name=\"a\"]/visual[@name=\"v\"]"
+            "/geometry/box/size", diffs[0].xmlPath);
+  EXPECT_EQ("1 2 1", diffs[0].after);
+}
+
+/////////////////////////////////////////////////
+TEST(ElementDiff, Roots)
+{
+  const std::string sdf = R"(
+<sdf version='1.9'>
+  <world name='default'>
+    <model name='box'>
+      <link name='link'/>
+    </model>
+  </world>
+</sdf>)";
+  sdf::Root before;
+  EXPECT_TRUE(before.LoadSdfString(sdf).empty());
+  sdf::Root after;
+  EXPECT_TRUE(after.LoadSdfString(sdf).empty());
+  EXPECT_TRUE(sdf::diffRoots(before, after).empty());
+
+  after.WorldByIndex(0)->ModelByIndex(0)->SetStatic(true);
+  const std::vector<sdf::ElementDifference> diffs =
+      sdf::diffRoots(before, after);
+  ASSERT_EQ(1u, diffs.size());
+  EXPECT_EQ(
+      "/sdf/world[@name=\"default\"]/model[@name=\"box\"]/static",
+      diffs[0].xmlPath);
+  EXPECT_EQ("true", diffs[0].after);
+}
@@ -17,9 +17,16 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "sdf/Element.hh"
 #include "sdf/Filesystem.hh"
 #include "sdf/Param.hh"
+#include "sdf/PrintConfig.hh"
+#include "sdf/TaskExecutor.hh"
 
 /////////////////////////////////////////////////
 TEST(Element, New)
@@ -46,6 +53,100 @@ TEST(Element, Child)
   ASSERT_NE(child.GetParent(), nullptr);
   EXPECT_EQ("/parent/path/model.sdf", child.FilePath());
   EXPECT_EQ("1.5", child.OriginalVersion());
+
+  // The child shares the path string of its parent.
+  EXPECT_EQ(&parent->FilePath(), &child.FilePath());
+  child.SetFilePath("/parent/path/model.sdf");
+  EXPECT_EQ(&parent->FilePath(), &child.FilePath());
+  child.SetFilePath("/other/path/model.sdf");
+  EXPECT_EQ("/other/path/model.sdf", child.FilePath());
+  EXPECT_EQ("/parent/path/model.sdf", parent->FilePath());
+  child.SetFilePath("");
+  EXPECT_TRUE(child.FilePath().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, ParentRaw)
+{
+  sdf::Element child;
+  EXPECT_EQ(nullptr, child.ParentRaw());
+
+  {
+    sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+    child.SetParent(parent);
+    EXPECT_EQ(parent.get(), child.ParentRaw());
+    EXPECT_EQ(1, parent.use_count());
+  }
+
+  // The parent was destroyed.
+  EXPECT_EQ(nullptr, child.ParentRaw());
+
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  child.SetParent(parent);
+  child.SetParent(nullptr);
+  EXPECT_EQ(nullptr, child.ParentRaw());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, Elements)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  EXPECT_TRUE(parent->Elements().empty());
+
+  sdf::ElementPtr first = std::make_shared<sdf::Element>();
+  first->SetName("first");
+  sdf::ElementPtr second = std::make_shared<sdf::Element>();
+  second->SetName("second");
+  parent->InsertElement(first, true);
+  parent->InsertElement(second, true);
+
+  const sdf::ElementPtr_V &elements = parent->Elements();
+  ASSERT_EQ(2u, elements.size());
+  EXPECT_EQ(first, elements[0]);
+  EXPECT_EQ(second, elements[1]);
+  for (const sdf::ElementPtr &elem : elements)
+    EXPECT_EQ(parent.get(), elem->ParentRaw());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, Children)
+{
+  // Ranges over few children, and over enough children for the name index
+  // to be used.
+  for (const int count : {3, 40})
+  {
+    sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+    EXPECT_TRUE(parent->Children().empty());
+    EXPECT_TRUE(parent->Children("link").empty());
+
+    for (int i = 0; i < count; ++i)
+    {
+      sdf::ElementPtr child = std::make_shared<sdf::Element>();
+      child->SetName(i % 3 == 0 ? "link" : "joint");
+      parent->InsertElement(child, true);
+    }
+
+    int all = 0;
+    for (const sdf::ElementPtr &child : parent->Children())
+    {
+      EXPECT_EQ(parent->Elements()[all], child);
+      ++all;
+    }
+    EXPECT_EQ(count, all);
+
+    int links = 0;
+    sdf::ElementPtr expected = parent->GetElementImpl("link");
+    for (const sdf::ElementPtr &link : parent->Children("link"))
+    {
+      EXPECT_EQ(expected, link);
+      EXPECT_EQ("link", link->GetName());
+      expected = link->GetNextElement("link");
+      ++links;
+    }
+    EXPECT_EQ(nullptr, expected);
+    EXPECT_EQ((count + 2) / 3, links);
+    EXPECT_TRUE(parent->Children("frame").empty());
+  }
 }
 
 /////////////////////////////////////////////////
@@ -349,18 +450,18 @@ TEST(Element, AddElementReferenceSDF)
 
   ASSERT_EQ(child->GetElementDescriptionCount(), 1UL);
 
-  sdf::ElementPtr check = child->GetElementDescription(4);
-  ASSERT_EQ(check, sdf::ElementPtr());
+  sdf::ElementConstPtr check = child->GetElementDescription(4);
+  ASSERT_EQ(check, nullptr);
 
   check = child->GetElementDescription(0);
-  ASSERT_NE(check, sdf::ElementPtr());
+  ASSERT_NE(check, nullptr);
   ASSERT_EQ(check->GetName(), "parent");
 
   check = child->GetElementDescription("bad");
-  ASSERT_EQ(check, sdf::ElementPtr());
+  ASSERT_EQ(check, nullptr);
 
   check = child->GetElementDescription("parent");
-  ASSERT_NE(check, sdf::ElementPtr());
+  ASSERT_NE(check, nullptr);
   ASSERT_EQ(check->GetName(), "parent");
 
   ASSERT_FALSE(child->HasElement("foo"));
@@ -390,6 +491,41 @@ TEST(Element, GetTemplates)
   ASSERT_EQ(found, true);
 }
 
+/////////////////////////////////////////////////
+TEST(Element, GetPtr)
+{
+  sdf::ElementPtr elem = std::make_shared<sdf::Element>();
+  elem->AddAttribute("test", "string", "foo", false, "foo description");
+  elem->AddValue("double", "1.5", false, "value description");
+
+  sdf::ElementPtr child = std::make_shared<sdf::Element>();
+  child->SetName("child");
+  child->AddValue("int", "3", false, "child description");
+  elem->InsertElement(child);
+
+  const std::string *str = elem->GetPtr<std::string>("test");
+  ASSERT_NE(nullptr, str);
+  EXPECT_EQ("foo", *str);
+  EXPECT_EQ(str, elem->GetAttribute("test")->GetPtr<std::string>());
+
+  const double *value = elem->GetPtr<double>();
+  ASSERT_NE(nullptr, value);
+  EXPECT_DOUBLE_EQ(1.5, *value);
+
+  const int *childValue = elem->GetPtr<int>("child");
+  ASSERT_NE(nullptr, childValue);
+  EXPECT_EQ(3, *childValue);
+
+  // No conversion is done to other types.
+  EXPECT_EQ(nullptr, elem->GetPtr<int>("test"));
+  EXPECT_EQ(nullptr, elem->GetPtr<float>());
+  EXPECT_EQ(nullptr, elem->GetPtr<std::string>("missing"));
+
+  // The pointer refers to the current value.
+  elem->GetAttribute("test")->Set<std::string>("bar");
+  EXPECT_EQ("bar", *str);
+}
+
 /////////////////////////////////////////////////
 TEST(Element, Clone)
 {
@@ -444,6 +580,174 @@ TEST(Element, Clone)
   EXPECT_EQ(newelem, clonedAttribs[0]->GetParentElement());
 }
 
+/////////////////////////////////////////////////
+TEST(Element, RawXml)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  parent->SetName("parent");
+  sdf::ElementPtr child = std::make_shared<sdf::Element>();
+  child->SetName("custom");
+  EXPECT_TRUE(child->RawXml().empty());
+
+  child->SetRawXml("<custom a=\"1\">\n  <value>2</value>\n</custom>\n");
+  EXPECT_EQ("<custom a=\"1\">\n  <value>2</value>\n</custom>\n",
+            child->RawXml());
+  parent->InsertElement(child);
+
+  // The text is printed instead of the attributes, value and children
+  EXPECT_EQ("<parent>\n  <custom a=\"1\">\n    <value>2</value>\n"
+            "  </custom>\n</parent>\n", parent->ToString(""));
+
+  // Clones share the text
+  sdf::ElementPtr clone = child->Clone();
+  EXPECT_EQ(&child->RawXml(), &clone->RawXml());
+
+  child->SetRawXml("");
+  EXPECT_TRUE(child->RawXml().empty());
+  EXPECT_EQ("<custom/>\n", child->ToString(""));
+  EXPECT_FALSE(clone->RawXml().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, CloneSharesElementDescriptions)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  sdf::ElementPtr desc = std::make_shared<sdf::Element>();
+  sdf::ElementPtr grandChildDesc = std::make_shared<sdf::Element>();
+
+  parent->SetName("parent");
+  desc->SetName("child");
+  desc->SetRequired("*");
+  grandChildDesc->SetName("grandchild");
+  grandChildDesc->SetRequired("*");
+  desc->AddElementDescription(grandChildDesc);
+  parent->AddElementDescription(desc);
+
+  sdf::ElementPtr newelem = parent->Clone();
+  ASSERT_EQ(1UL, newelem->GetElementDescriptionCount());
+  EXPECT_EQ(desc, newelem->GetElementDescription(0));
+
+  // Elements created from a description point into the same schema nodes.
+  sdf::ElementPtr child = newelem->AddElement("child");
+  ASSERT_NE(nullptr, child);
+  EXPECT_NE(desc, child);
+  ASSERT_EQ(1UL, child->GetElementDescriptionCount());
+  EXPECT_EQ(grandChildDesc, child->GetElementDescription(0));
+
+  // Resetting an element must not reset the shared descriptions.
+  newelem->Reset();
+  EXPECT_EQ(0UL, newelem->GetElementDescriptionCount());
+  EXPECT_EQ(1UL, parent->GetElementDescriptionCount());
+  EXPECT_EQ(1UL, desc->GetElementDescriptionCount());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, CloneCopiesSchemaOnWrite)
+{
+  sdf::ElementPtr desc = std::make_shared<sdf::Element>();
+  desc->SetName("desc");
+  desc->SetRequired("*");
+  desc->SetDescription("a description");
+  desc->SetReferenceSDF("ref");
+  desc->SetCopyChildren(true);
+  desc->AddElementDescription(std::make_shared<sdf::Element>());
+
+  sdf::ElementPtr clone = desc->Clone();
+  EXPECT_EQ("desc", clone->GetName());
+  EXPECT_EQ("*", clone->GetRequired());
+  EXPECT_EQ("a description", clone->GetDescription());
+  EXPECT_EQ("ref", clone->ReferenceSDF());
+  EXPECT_TRUE(clone->GetCopyChildren());
+  EXPECT_EQ(1UL, clone->GetElementDescriptionCount());
+
+  // Modifying the clone must not modify the element it was cloned from.
+  clone->SetName("clone");
+  clone->SetRequired("1");
+  clone->SetDescription("another description");
+  clone->SetReferenceSDF("");
+  clone->SetCopyChildren(false);
+  clone->AddElementDescription(std::make_shared<sdf::Element>());
+
+  EXPECT_EQ("desc", desc->GetName());
+  EXPECT_EQ("*", desc->GetRequired());
+  EXPECT_EQ("a description", desc->GetDescription());
+  EXPECT_EQ("ref", desc->ReferenceSDF());
+  EXPECT_TRUE(desc->GetCopyChildren());
+  EXPECT_EQ(1UL, desc->GetElementDescriptionCount());
+
+  EXPECT_EQ("clone", clone->GetName());
+  EXPECT_EQ("1", clone->GetRequired());
+  EXPECT_EQ("another description", clone->GetDescription());
+  EXPECT_EQ("", clone->ReferenceSDF());
+  EXPECT_FALSE(clone->GetCopyChildren());
+  EXPECT_EQ(2UL, clone->GetElementDescriptionCount());
+
+  // Line numbers are per element.
+  EXPECT_FALSE(desc->LineNumber().has_value());
+  clone->SetLineNumber(0);
+  ASSERT_TRUE(clone->LineNumber().has_value());
+  EXPECT_EQ(0, *clone->LineNumber());
+  EXPECT_FALSE(desc->LineNumber().has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, IndexedLookup)
+{
+  sdf::ElementPtr desc = std::make_shared<sdf::Element>();
+  desc->SetName("parent");
+  desc->AddAttribute("a", "string", "1", false, "");
+  desc->AddAttribute("b", "string", "2", false, "");
+  for (const std::string name : {"x", "y", "x"})
+  {
+    sdf::ElementPtr childDesc = std::make_shared<sdf::Element>();
+    childDesc->SetName(name);
+    childDesc->SetDescription(name + std::to_string(
+        desc->GetElementDescriptionCount()));
+    desc->AddElementDescription(childDesc);
+  }
+
+  // The first description with a name is found, as with a linear search.
+  sdf::ElementPtr clone = desc->Clone();
+  ASSERT_NE(nullptr, clone->GetElementDescription("x"));
+  EXPECT_EQ("x0", clone->GetElementDescription("x")->GetDescription());
+  EXPECT_EQ("y1", clone->GetElementDescription("y")->GetDescription());
+  EXPECT_TRUE(clone->HasElementDescription("y"));
+  EXPECT_FALSE(clone->HasElementDescription("z"));
+
+  // Attributes of the clone are found in the clone, not in the description.
+  ASSERT_NE(nullptr, clone->GetAttribute("b"));
+  EXPECT_NE(desc->GetAttribute("b"), clone->GetAttribute("b"));
+  EXPECT_EQ("b", clone->GetAttribute("b")->GetKey());
+  EXPECT_EQ(nullptr, clone->GetAttribute("c"));
+
+  // Adding to a clone does not change the description.
+  clone->AddAttribute("c", "string", "3", false, "");
+  ASSERT_NE(nullptr, clone->GetAttribute("c"));
+  EXPECT_EQ(nullptr, desc->GetAttribute("c"));
+
+  // Removing an attribute keeps the others reachable.
+  clone->RemoveAttribute("a");
+  EXPECT_EQ(nullptr, clone->GetAttribute("a"));
+  ASSERT_NE(nullptr, clone->GetAttribute("b"));
+  EXPECT_EQ("b", clone->GetAttribute("b")->GetKey());
+  ASSERT_NE(nullptr, clone->GetAttribute("c"));
+  EXPECT_EQ("c", clone->GetAttribute("c")->GetKey());
+  clone->AddAttribute("a", "string", "1", false, "");
+  ASSERT_NE(nullptr, clone->GetAttribute("a"));
+  ASSERT_NE(nullptr, desc->GetAttribute("a"));
+
+  // Copied elements use the descriptions of the source.
+  sdf::ElementPtr copy = std::make_shared<sdf::Element>();
+  copy->Copy(desc);
+  EXPECT_EQ("y1", copy->GetElementDescription("y")->GetDescription());
+  ASSERT_NE(nullptr, copy->GetAttribute("b"));
+  EXPECT_EQ("b", copy->GetAttribute("b")->GetKey());
+
+  copy->Reset();
+  EXPECT_FALSE(copy->HasElementDescription("x"));
+  EXPECT_TRUE(desc->HasElementDescription("x"));
+}
+
 /////////////////////////////////////////////////
 TEST(Element, ClearElements)
 {
@@ -674,6 +978,94 @@ TEST(Element, ToStringDefaultAttributes)
   EXPECT_EQ(element->ToString("", false, true), stream2.str());
 }
 
+/////////////////////////////////////////////////
+TEST(Element, ToStream)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  parent->SetName("parent");
+  parent->AddAttribute("test", "string", "foo", false, "foo description");
+  sdf::ElementPtr child = std::make_shared<sdf::Element>();
+  child->SetName("child");
+  child->AddValue("double", "0.1", false, "double description");
+  parent->InsertElement(child);
+  sdf::ElementPtr grandChild = std::make_shared<sdf::Element>();
+  grandChild->SetName("grand_child");
+  grandChild->AddValue("float", "-2.5e-7", false, "float description");
+  sdf::ElementPtr middle = std::make_shared<sdf::Element>();
+  middle->SetName("middle");
+  middle->InsertElement(grandChild);
+  parent->InsertElement(middle);
+  parent->InsertElement(child->Clone());
+
+  const std::string expected =
+    "<!-- prefix --><parent>\n"
+    "<!-- prefix -->  <child>0.1</child>\n"
+    "<!-- prefix -->  <middle>\n"
+    "<!-- prefix -->    <grand_child>-2.5e-07</grand_child>\n"
+    "<!-- prefix -->  </middle>\n"
+    "<!-- prefix -->  <child>0.1</child>\n"
+    "<!-- prefix --></parent>\n";
+  EXPECT_EQ(expected, parent->ToString("<!-- prefix -->"));
+
+  std::ostringstream stream;
+  parent->ToStream(stream, "<!-- prefix -->");
+  EXPECT_EQ(expected, stream.str());
+
+  for (bool includeDefaultElements : {false, true})
+  {
+    for (bool includeDefaultAttributes : {false, true})
+    {
+      std::ostringstream defaultsStream;
+      parent->ToStream(defaultsStream, "",
+          includeDefaultElements, includeDefaultAttributes);
+      EXPECT_EQ(parent->ToString("",
+            includeDefaultElements, includeDefaultAttributes),
+          defaultsStream.str());
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Element, ToStringConcurrent)
+{
+  sdf::ElementPtr root = std::make_shared<sdf::Element>();
+  root->SetName("root");
+  sdf::ElementPtr world = std::make_shared<sdf::Element>();
+  world->SetName("world");
+  world->AddAttribute("name", "string", "", false, "name description");
+  world->GetAttribute("name")->Set<std::string>("default");
+  root->InsertElement(world);
+  for (int i = 0; i < 20; ++i)
+  {
+    sdf::ElementPtr model = std::make_shared<sdf::Element>();
+    model->SetName("model");
+    sdf::ElementPtr value = std::make_shared<sdf::Element>();
+    value->SetName("value");
+    value->AddValue("double", std::to_string(i * 0.5), false, "value");
+    model->InsertElement(value);
+    model->InsertElement(value->Clone());
+    world->InsertElement(model);
+  }
+
+  sdf::PrintConfig config;
+  const std::string serial = root->ToString("  ", config);
+  std::ostringstream serialStream;
+  root->ToStream(serialStream, "  ", false, true, config);
+
+  config.SetThreadCount(4);
+  EXPECT_EQ(serial, root->ToString("  ", config));
+  std::ostringstream stream;
+  root->ToStream(stream, "  ", false, true, config);
+  EXPECT_EQ(serialStream.str(), stream.str());
+
+  // The children of the element that is converted are written concurrently
+  // if it has several of them.
+  EXPECT_EQ(world->GetFirstElement()->ToString(""),
+            world->GetFirstElement()->ToString("", config));
+  config.SetExecutor(sdf::TaskExecutor::Inline());
+  EXPECT_EQ(serial, root->ToString("  ", config));
+}
+
 /////////////////////////////////////////////////
 TEST(Element, DocLeftPane)
 {
@@ -875,6 +1267,160 @@ TEST(Element, GetNextElementMultiple)
   ASSERT_EQ(child2->GetNextElement(""), nullptr);
 }
 
+/////////////////////////////////////////////////
+TEST(Element, GetNextElementManyChildren)
+{
+  // Use enough children for the parent to build its child name index.
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  std::vector<sdf::ElementPtr> links;
+  std::vector<sdf::ElementPtr> joints;
+  for (int i = 0; i < 20; ++i)
+  {
+    sdf::ElementPtr link = std::make_shared<sdf::Element>();
+    link->SetName("link");
+    parent->InsertElement(link, true);
+    links.push_back(link);
+
+    sdf::ElementPtr joint = std::make_shared<sdf::Element>();
+    joint->SetName("joint");
+    parent->InsertElement(joint, true);
+    joints.push_back(joint);
+  }
+
+  EXPECT_EQ(links[0], parent->GetElement("link"));
+  EXPECT_EQ(joints[0], parent->GetElement("joint"));
+  EXPECT_FALSE(parent->HasElement("frame"));
+
+  std::size_t count = 0;
+  for (sdf::ElementPtr elem = parent->GetElement("link"); elem;
+       elem = elem->GetNextElement("link"))
+  {
+    ASSERT_LT(count, links.size());
+    EXPECT_EQ(links[count], elem);
+    ++count;
+  }
+  EXPECT_EQ(links.size(), count);
+
+  EXPECT_EQ(joints[0], links[0]->GetNextElement("joint"));
+  EXPECT_EQ(joints[0], links[0]->GetNextElement(""));
+  EXPECT_EQ(links[1], joints[0]->GetNextElement("link"));
+  EXPECT_EQ(nullptr, joints.back()->GetNextElement(""));
+  EXPECT_EQ(nullptr, links.back()->GetNextElement("link"));
+
+  // Removing children keeps lookups and iteration consistent.
+  parent->RemoveChild(links[0]);
+  links[2]->RemoveFromParent();
+  EXPECT_EQ(links[1], parent->GetElement("link"));
+  EXPECT_EQ(links[3], links[1]->GetNextElement("link"));
+  EXPECT_EQ(joints[1], links[1]->GetNextElement("joint"));
+
+  // Renaming a child updates the parent's index.
+  links[1]->SetName("frame");
+  EXPECT_EQ(links[1], parent->GetElement("frame"));
+  EXPECT_EQ(links[3], parent->GetElement("link"));
+
+  // Replacing a child keeps its position.
+  sdf::ElementPtr model = std::make_shared<sdf::Element>();
+  model->SetName("model");
+  EXPECT_TRUE(parent->ReplaceChild(links[3], model));
+  EXPECT_FALSE(parent->ReplaceChild(links[3], model));
+  EXPECT_EQ(nullptr, links[3]->GetParent());
+  EXPECT_EQ(parent, model->GetParent());
+  EXPECT_EQ(model, parent->GetElement("model"));
+  EXPECT_EQ(links[4], parent->GetElement("link"));
+  EXPECT_EQ(joints[3], joints[2]->GetNextElement("")->GetNextElement(""));
+  EXPECT_EQ(model, joints[2]->GetNextElement(""));
+
+  parent->ClearElements();
+  EXPECT_FALSE(parent->HasElement("link"));
+  EXPECT_EQ(nullptr, parent->GetFirstElement());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, RemoveChildrenIf)
+{
+  // Use enough children for the parent to build its child name index.
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  std::vector<sdf::ElementPtr> links;
+  std::vector<sdf::ElementPtr> visuals;
+  for (int i = 0; i < 20; ++i)
+  {
+    sdf::ElementPtr link = std::make_shared<sdf::Element>();
+    link->SetName("link");
+    parent->InsertElement(link, true);
+    links.push_back(link);
+
+    sdf::ElementPtr visual = std::make_shared<sdf::Element>();
+    visual->SetName("visual");
+    parent->InsertElement(visual, true);
+    visuals.push_back(visual);
+  }
+
+  EXPECT_EQ(0u, parent->RemoveChildrenIf(
+      [](const sdf::ElementPtr &) { return false; }));
+  EXPECT_EQ(40u, parent->Elements().size());
+
+  EXPECT_EQ(20u, parent->RemoveChildrenIf(
+      [](const sdf::ElementPtr &_child)
+      {
+        return _child->GetName() == "visual";
+      }));
+  EXPECT_FALSE(parent->HasElement("visual"));
+  EXPECT_EQ(nullptr, visuals[0]->GetParent());
+  EXPECT_EQ(links, parent->Elements());
+  EXPECT_EQ(links[1], links[0]->GetNextElement(""));
+  EXPECT_EQ(links[1], links[0]->GetNextElement("link"));
+
+  // Removing children in the middle keeps the order of the others.
+  EXPECT_EQ(10u, parent->RemoveChildrenIf(
+      [&](const sdf::ElementPtr &_child)
+      {
+        return (std::find(links.begin(), links.end(), _child) -
+                links.begin()) % 2 == 1;
+      }));
+  ASSERT_EQ(10u, parent->Elements().size());
+  for (std::size_t i = 0; i < 10; ++i)
+    EXPECT_EQ(links[2 * i], parent->Elements()[i]);
+  EXPECT_EQ(links[2], links[0]->GetNextElement("link"));
+  EXPECT_EQ(links[0], parent->GetElement("link"));
+}
+
+/////////////////////////////////////////////////
+TEST(Element, ReplaceChildren)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  sdf::ElementPtr kept = std::make_shared<sdf::Element>();
+  kept->SetName("link");
+  sdf::ElementPtr removed = std::make_shared<sdf::Element>();
+  removed->SetName("visual");
+  parent->InsertElement(kept, true);
+  parent->InsertElement(removed, true);
+
+  sdf::ElementPtr_V children;
+  for (int i = 0; i < 20; ++i)
+  {
+    sdf::ElementPtr child = std::make_shared<sdf::Element>();
+    child->SetName("joint");
+    children.push_back(child);
+  }
+  children.push_back(kept);
+
+  parent->ReplaceChildren(children);
+  EXPECT_EQ(children, parent->Elements());
+  EXPECT_EQ(nullptr, removed->GetParent());
+  EXPECT_EQ(parent, kept->GetParent());
+  EXPECT_EQ(parent, children[0]->GetParent());
+  EXPECT_FALSE(parent->HasElement("visual"));
+  EXPECT_EQ(kept, parent->GetElement("link"));
+  EXPECT_EQ(children[0], parent->GetElement("joint"));
+  EXPECT_EQ(children[1], children[0]->GetNextElement("joint"));
+  EXPECT_EQ(kept, children[19]->GetNextElement(""));
+
+  parent->ReplaceChildren({});
+  EXPECT_EQ(nullptr, parent->GetFirstElement());
+  EXPECT_EQ(nullptr, kept->GetParent());
+}
+
 /////////////////////////////////////////////////
 /// Helper function to add child elements without having to create descriptions
 sdf::ElementPtr addChildElement(sdf::ElementPtr _parent,
@@ -1049,3 +1595,89 @@ int main(int argc, char **argv)
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
+
+/////////////////////////////////////////////////
+TEST(Element, SharedSourceLocations)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  parent->SetName("model");
+  parent->SetFilePath("/path/to/file.sdf");
+  parent->SetXmlPath("/sdf/model[@name=\"m\"]");
+
+  sdf::ElementPtr child = std::make_shared<sdf::Element>();
+  child->SetName("link");
+  child->SetParent(parent);
+  child->SetXmlPath("/sdf/model[@name=\"m\"]/link[@name=\"l\"]");
+  EXPECT_EQ("/sdf/model[@name=\"m\"]/link[@name=\"l\"]", child->XmlPath());
+
+  // Elements read from the same file share its path
+  sdf::ElementPtr other = std::make_shared<sdf::Element>();
+  other->SetFilePath("/path/to/file.sdf");
+  EXPECT_EQ(&parent->FilePath(), &child->FilePath());
+  EXPECT_EQ(&parent->FilePath(), &other->FilePath());
+
+  // A path that does not extend the parent's is kept as given
+  sdf::ElementPtr plugin = std::make_shared<sdf::Element>();
+  plugin->SetParent(parent);
+  plugin->SetXmlPath("/sdf/include[0]/plugin[1]");
+  EXPECT_EQ("/sdf/include[0]/plugin[1]", plugin->XmlPath());
+  plugin->SetXmlPath("/sdf/model[@name=\"m\"]");
+  EXPECT_EQ("/sdf/model[@name=\"m\"]", plugin->XmlPath());
+
+  // Changing the path of the parent does not change the child's, nor does
+  // moving the child to another parent
+  parent->SetXmlPath("/sdf/model[@name=\"renamed\"]");
+  EXPECT_EQ("/sdf/model[@name=\"m\"]/link[@name=\"l\"]", child->XmlPath());
+  child->SetParent(other);
+  EXPECT_EQ("/sdf/model[@name=\"m\"]/link[@name=\"l\"]", child->XmlPath());
+  EXPECT_EQ("/sdf/model[@name=\"m\"]/link[@name=\"l\"]",
+            child->Clone()->XmlPath());
+
+  child->SetXmlPath("");
+  EXPECT_TRUE(child->XmlPath().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, ContentHash)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  parent->SetName("model");
+  parent->AddAttribute("name", "string", "__default__", true);
+  sdf::ElementPtr child = std::make_shared<sdf::Element>();
+  child->SetName("static");
+  child->AddValue("bool", "false", false);
+  parent->InsertElement(child, true);
+
+  const std::uint64_t hash = parent->ContentHash();
+  EXPECT_NE(0u, hash);
+  EXPECT_EQ(hash, parent->ContentHash());
+
+  // Clones have the same contents, wherever they were read from.
+  sdf::ElementPtr clone = parent->Clone();
+  clone->SetFilePath("/path/to/other.sdf");
+  clone->SetLineNumber(12);
+  EXPECT_EQ(hash, clone->ContentHash());
+
+  // Changing a value of a descendant changes the hashes of its ancestors.
+  const std::uint64_t childHash = child->ContentHash();
+  child->Set(true);
+  EXPECT_NE(childHash, child->ContentHash());
+  EXPECT_NE(hash, parent->ContentHash());
+  child->Set(false);
+  EXPECT_EQ(childHash, child->ContentHash());
+  EXPECT_EQ(hash, parent->ContentHash());
+
+  // So does changing an attribute, or the children.
+  parent->GetAttribute("name")->Set("robot");
+  const std::uint64_t namedHash = parent->ContentHash();
+  EXPECT_NE(hash, namedHash);
+  sdf::ElementPtr link = std::make_shared<sdf::Element>();
+  link->SetName("link");
+  parent->InsertElement(link, true);
+  EXPECT_NE(namedHash, parent->ContentHash());
+  parent->RemoveChild(link);
+  EXPECT_EQ(namedHash, parent->ContentHash());
+
+  // The clone is unaffected.
+  EXPECT_EQ(hash, clone->ContentHash());
+}
@@ -18,8 +18,9 @@
 #ifndef SDF_EMBEDDEDSDF_HH_
 #define SDF_EMBEDDEDSDF_HH_
 
-#include <map>
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 #include "sdf/Types.hh"
 
@@ -31,10 +32,134 @@ namespace sdf
 
   /// \internal
 
-  /// A map where the keys are a source-relative pathnames within the "sdf"
-  /// directory such as "1.8/root.sdf", and the values are the contents of
-  /// that source file.
-  const std::map<std::string, std::string> &GetEmbeddedSdf();
+  /// \brief Source file of the "sdf" directory embedded in the library.
+  struct EmbeddedSdfFile
+  {
+    /// \brief Source-relative pathname within the "sdf" directory, such as
+    /// "1.8/root.sdf".
+    std::string_view pathname;
+
+    /// \brief Contents of the file.
+    std::string_view content;
+  };
+
+  /// \brief Range of embedded files, which can be iterated over.
+  struct EmbeddedSdfRange
+  {
+    /// \brief Get the first file.
+    /// \return Pointer to the first file.
+    const EmbeddedSdfFile *begin() const { return this->first; }
+
+    /// \brief Get the end of the range.
+    /// \return Pointer past the last file.
+    const EmbeddedSdfFile *end() const { return this->last; }
+
+    /// \brief Pointer to the first file.
+    const EmbeddedSdfFile *first;
+
+    /// \brief Pointer past the last file.
+    const EmbeddedSdfFile *last;
+  };
+
+  /// \brief Get all the embedded files.
+  /// \return The files, sorted by pathname.
+  EmbeddedSdfRange GetEmbeddedSdf();
+
+  /// \brief Find an embedded file.
+  /// \param[in] _pathname Source-relative pathname within the "sdf"
+  /// directory, such as "1.8/root.sdf".
+  /// \return The file, or nullptr if there is no such file.
+  const EmbeddedSdfFile *FindEmbeddedSdf(std::string_view _pathname);
+
+  /// \brief Attribute of an element in a pre-parsed specification file.
+  struct EmbeddedSchemaAttribute
+  {
+    /// \brief Name of the attribute.
+    const char *name;
+
+    /// \brief Type of the attribute.
+    const char *type;
+
+    /// \brief Default value of the attribute.
+    const char *defaultValue;
+
+    /// \brief True if the attribute is required.
+    bool required;
+
+    /// \brief Description of the attribute, or nullptr if it has none.
+    const char *description;
+  };
+
+  /// \brief Element, or <include> of another file, in a pre-parsed
+  /// specification file. The fields hold the XML attributes and description
+  /// that initXml reads. The fields of an <include> other than
+  /// includeFilename and description are unused.
+  struct EmbeddedSchemaElement
+  {
+    /// \brief Name of the included file, or nullptr for an element.
+    const char *includeFilename;
+
+    /// \brief Name of the element.
+    const char *name;
+
+    /// \brief Required string of the element, such as "0", "1" or "*".
+    const char *required;
+
+    /// \brief Name of the referenced specification, or nullptr.
+    const char *ref;
+
+    /// \brief Type of the value of the element, or nullptr if it has no
+    /// value.
+    const char *type;
+
+    /// \brief Default value of the element, if it has a type.
+    const char *defaultValue;
+
+    /// \brief Minimum allowed value, or an empty string.
+    const char *minValue;
+
+    /// \brief Maximum allowed value, or an empty string.
+    const char *maxValue;
+
+    /// \brief Description of the element, or nullptr if it has none. For
+    /// an <include>, the description that overrides the description of the
+    /// included element.
+    const char *description;
+
+    /// \brief True if the children of the element are copied.
+    bool copyChildren;
+
+    /// \brief Index of the first attribute of the element in the
+    /// attributes of the file.
+    std::size_t firstAttribute;
+
+    /// \brief Number of attributes of the element.
+    std::size_t attributeCount;
+
+    /// \brief Index of the first child of the element in the elements of
+    /// the file. The children are contiguous, with child elements before
+    /// included files.
+    std::size_t firstChild;
+
+    /// \brief Number of children of the element.
+    std::size_t childCount;
+  };
+
+  /// \brief Specification file pre-parsed when building the library.
+  struct EmbeddedSchemaFile
+  {
+    /// \brief Elements of the file, starting with its root element.
+    const EmbeddedSchemaElement *elements;
+
+    /// \brief Attributes of the elements of the file.
+    const EmbeddedSchemaAttribute *attributes;
+  };
+
+  /// \brief Get a pre-parsed specification file.
+  /// \param[in] _pathname Source-relative pathname within the "sdf"
+  /// directory, such as "1.8/root.sdf".
+  /// \return The pre-parsed file, or nullptr if there is no such file.
+  const EmbeddedSchemaFile *GetEmbeddedSchema(const std::string &_pathname);
 }
 }
 #endif
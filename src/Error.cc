@@ -15,6 +15,10 @@
  *
 */
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "sdf/Error.hh"
 
 using namespace sdf;
@@ -24,9 +28,13 @@ class sdf::Error::Implementation
   /// \brief The error code value.
   public: ErrorCode code = ErrorCode::NONE;
 
-  /// \brief Description of the error.
+  /// \brief Description of the error, or its format when there are
+  /// arguments.
   public: std::string message = "";
 
+  /// \brief Arguments of the message.
+  public: std::vector<std::string> args;
+
   /// \brief Xml path where the error was raised.
   public: std::optional<std::string> xmlPath = std::nullopt;
 
@@ -71,6 +79,29 @@ Error::Error(const ErrorCode _code, const std::string &_message,
   this->dataPtr->lineNumber = _lineNumber;
 }
 
+/////////////////////////////////////////////////
+Error::Error(const ErrorCode _code, const std::string &_format,
+             std::vector<std::string> _args)
+  : dataPtr(ignition::utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->code = _code;
+  this->dataPtr->message = _format;
+  this->dataPtr->args = std::move(_args);
+}
+
+/////////////////////////////////////////////////
+Error::Error(const ErrorCode _code, const std::string &_format,
+             std::vector<std::string> _args, const std::string &_filePath,
+             int _lineNumber)
+  : dataPtr(ignition::utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->code = _code;
+  this->dataPtr->message = _format;
+  this->dataPtr->args = std::move(_args);
+  this->dataPtr->filePath = _filePath;
+  this->dataPtr->lineNumber = _lineNumber;
+}
+
 /////////////////////////////////////////////////
 ErrorCode Error::Code() const
 {
@@ -80,7 +111,36 @@ ErrorCode Error::Code() const
 /////////////////////////////////////////////////
 std::string Error::Message() const
 {
-  return this->dataPtr->message;
+  const std::string &format = this->dataPtr->message;
+  const auto &args = this->dataPtr->args;
+  if (args.empty())
+    return format;
+
+  std::size_t size = format.size();
+  for (const auto &arg : args)
+    size += arg.size();
+  std::string message;
+  message.reserve(size);
+
+  // Placeholders without an argument are kept as they are
+  std::size_t start = 0;
+  for (const auto &arg : args)
+  {
+    const std::size_t placeholder = format.find("{}", start);
+    if (placeholder == std::string::npos)
+      break;
+    message.append(format, start, placeholder - start);
+    message.append(arg);
+    start = placeholder + 2;
+  }
+  message.append(format, start, std::string::npos);
+  return message;
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &Error::MessageArgs() const
+{
+  return this->dataPtr->args;
 }
 
 /////////////////////////////////////////////////
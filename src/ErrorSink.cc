@@ -0,0 +1,87 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <iterator>
+
+#include "ErrorSink.hh"
+
+using namespace sdf;
+
+/////////////////////////////////////////////////
+ErrorSink::ErrorSink(std::size_t _taskCount, std::size_t _limit)
+  : taskErrors(_taskCount), limit(_limit), finished(_taskCount, false)
+{
+}
+
+/////////////////////////////////////////////////
+Errors &ErrorSink::TaskErrors(std::size_t _task)
+{
+  return this->taskErrors[_task];
+}
+
+/////////////////////////////////////////////////
+void ErrorSink::Finish(std::size_t _task)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->finished[_task] = true;
+  while (this->finishedPrefix < this->finished.size() &&
+         this->finished[this->finishedPrefix])
+  {
+    this->finishedPrefixErrors +=
+        this->taskErrors[this->finishedPrefix].size();
+    ++this->finishedPrefix;
+  }
+}
+
+/////////////////////////////////////////////////
+bool ErrorSink::Skip(std::size_t _task) const
+{
+  if (this->limit == 0)
+    return false;
+
+  // The errors of the finished prefix are a lower bound of the errors of
+  // the tasks before _task when the prefix ends before it.
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->finishedPrefix <= _task &&
+      this->finishedPrefixErrors >= this->limit;
+}
+
+/////////////////////////////////////////////////
+bool ErrorSink::Reported(std::size_t _task) const
+{
+  if (this->limit == 0)
+    return true;
+
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < _task && count < this->limit; ++i)
+    count += this->taskErrors[i].size();
+  return count < this->limit;
+}
+
+/////////////////////////////////////////////////
+void ErrorSink::MergeInto(Errors &_errors)
+{
+  std::size_t count = 0;
+  for (auto &errors : this->taskErrors)
+  {
+    if (this->limit != 0 && count >= this->limit)
+      break;
+    count += errors.size();
+    std::move(errors.begin(), errors.end(), std::back_inserter(_errors));
+    errors.clear();
+  }
+}
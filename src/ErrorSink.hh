@@ -0,0 +1,102 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_ERRORSINK_HH
+#define SDFORMAT_ERRORSINK_HH
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "sdf/Error.hh"
+#include "sdf/Types.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Errors of a group of tasks that may run concurrently, such as
+  /// loading the worlds of a document, merged in the order of the tasks.
+  /// Tasks are numbered in document order and each one records its errors
+  /// in its own list, so the merged errors are the same whether the tasks
+  /// run concurrently or serially.
+  ///
+  /// With a limit on the number of errors, a task is reported only if the
+  /// tasks before it have fewer errors than the limit, as when the tasks are
+  /// run serially and stop at the limit. Tasks can check Skip to avoid
+  /// running when they would not be reported.
+  class ErrorSink
+  {
+    /// \brief Constructor.
+    /// \param[in] _taskCount Number of tasks.
+    /// \param[in] _limit Number of errors after which later tasks are not
+    /// reported, or 0 for no limit.
+    public: explicit ErrorSink(std::size_t _taskCount, std::size_t _limit = 0);
+
+    /// \brief Get the errors of a task. Only the task itself may use them
+    /// until it is finished.
+    /// \param[in] _task Index of the task.
+    /// \return The errors of the task.
+    public: Errors &TaskErrors(std::size_t _task);
+
+    /// \brief Mark a task as finished. Its errors must not change after
+    /// this.
+    /// \param[in] _task Index of the task.
+    public: void Finish(std::size_t _task);
+
+    /// \brief Check whether a task does not need to run, because the tasks
+    /// before it are finished and have reached the limit. This may return
+    /// false for a task that will not be reported, if the tasks before it
+    /// are still running.
+    /// \param[in] _task Index of the task.
+    /// \return True if the task will not be reported.
+    public: bool Skip(std::size_t _task) const;
+
+    /// \brief Check whether the errors of a task are reported, once all the
+    /// tasks before it are finished.
+    /// \param[in] _task Index of the task.
+    /// \return True if the tasks before it have fewer errors than the limit.
+    public: bool Reported(std::size_t _task) const;
+
+    /// \brief Append the errors of the reported tasks, in task order, once
+    /// all the tasks are finished.
+    /// \param[in,out] _errors Errors to append to.
+    public: void MergeInto(Errors &_errors);
+
+    /// \brief Errors of each task.
+    private: std::vector<Errors> taskErrors;
+
+    /// \brief Number of errors after which tasks are not reported, or 0.
+    private: std::size_t limit;
+
+    /// \brief Protects the members below.
+    private: mutable std::mutex mutex;
+
+    /// \brief Whether each task is finished.
+    private: std::vector<bool> finished;
+
+    /// \brief Number of tasks at the start of the group that are finished.
+    private: std::size_t finishedPrefix = 0;
+
+    /// \brief Number of errors of the tasks in the finished prefix.
+    private: std::size_t finishedPrefixErrors = 0;
+  };
+  }
+}
+#endif
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sdf/ParserConfig.hh"
+#include "sdf/Root.hh"
+#include "ErrorSink.hh"
+
+/////////////////////////////////////////////////
+/// \brief Add numbered errors to a list.
+/// \param[in,out] _errors The list.
+/// \param[in] _first Number of the first error.
+/// \param[in] _count Number of errors.
+static void addErrors(sdf::Errors &_errors, int _first, int _count)
+{
+  for (int i = _first; i < _first + _count; ++i)
+    _errors.emplace_back(sdf::ErrorCode::ELEMENT_INVALID, std::to_string(i));
+}
+
+/////////////////////////////////////////////////
+TEST(ErrorSink, MergeInTaskOrder)
+{
+  sdf::ErrorSink sink(3);
+  std::vector<std::thread> threads;
+  for (int task = 2; task >= 0; --task)
+  {
+    threads.emplace_back([&sink, task]()
+    {
+      addErrors(sink.TaskErrors(task), task * 2, 2);
+      sink.Finish(task);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_FALSE(sink.Skip(1));
+  EXPECT_TRUE(sink.Reported(2));
+  sdf::Errors errors;
+  sink.MergeInto(errors);
+  ASSERT_EQ(6u, errors.size());
+  for (int i = 0; i < 6; ++i)
+    EXPECT_EQ(std::to_string(i), errors[i].Message());
+}
+
+/////////////////////////////////////////////////
+TEST(ErrorSink, Limit)
+{
+  sdf::ErrorSink sink(4, 3);
+
+  // Task 2 finishes first, while the limit can not be decided yet.
+  addErrors(sink.TaskErrors(2), 20, 5);
+  sink.Finish(2);
+  EXPECT_FALSE(sink.Skip(3));
+
+  addErrors(sink.TaskErrors(0), 0, 2);
+  sink.Finish(0);
+  EXPECT_FALSE(sink.Skip(1));
+  addErrors(sink.TaskErrors(1), 10, 1);
+  sink.Finish(1);
+
+  // Tasks 0 and 1 have 3 errors, which reaches the limit.
+  EXPECT_TRUE(sink.Skip(3));
+  sink.Finish(3);
+  EXPECT_TRUE(sink.Reported(0));
+  EXPECT_TRUE(sink.Reported(1));
+  EXPECT_FALSE(sink.Reported(2));
+  EXPECT_FALSE(sink.Reported(3));
+
+  sdf::Errors errors;
+  sink.MergeInto(errors);
+  ASSERT_EQ(3u, errors.size());
+  EXPECT_EQ("0", errors[0].Message());
+  EXPECT_EQ("1", errors[1].Message());
+  EXPECT_EQ("10", errors[2].Message());
+}
+
+/////////////////////////////////////////////////
+TEST(ErrorSink, RootMaxErrors)
+{
+  std::string sdf = "<?xml version=\"1.0\"?><sdf version=\"1.8\">";
+  for (int i = 0; i < 6; ++i)
+  {
+    sdf += "<world name=\"world" + std::to_string(i) + "\">"
+           "<frame name=\"frame\" attached_to=\"missing\"/>"
+           "</world>";
+  }
+  sdf += "</sdf>";
+
+  sdf::ParserConfig serialConfig;
+  serialConfig.SetMaxErrors(1);
+  sdf::Root serialRoot;
+  sdf::Errors serialErrors = serialRoot.LoadSdfString(sdf, serialConfig);
+  EXPECT_FALSE(serialErrors.empty());
+  EXPECT_EQ(1u, serialRoot.WorldCount());
+
+  // Loading the worlds concurrently loads and reports the same worlds.
+  sdf::ParserConfig config = serialConfig;
+  config.SetWorldLoadThreadCount(4);
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf, config);
+  EXPECT_EQ(serialRoot.WorldCount(), root.WorldCount());
+  ASSERT_EQ(serialErrors.size(), errors.size());
+  for (std::size_t i = 0; i < errors.size(); ++i)
+    EXPECT_EQ(serialErrors[i].Message(), errors[i].Message());
+
+  // Without a limit every world is loaded.
+  sdf::Root unlimitedRoot;
+  EXPECT_FALSE(unlimitedRoot.LoadSdfString(sdf).empty());
+  EXPECT_EQ(6u, unlimitedRoot.WorldCount());
+}
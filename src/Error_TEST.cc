@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 #include <optional>
+#include <string>
+#include <vector>
 #include "sdf/sdf_config.h"
 #include "sdf/Error.hh"
 
@@ -134,3 +136,31 @@ TEST(Error, ValueConstructionWithXmlPath)
     FAIL();
 }
 
+
+/////////////////////////////////////////////////
+TEST(Error, ValueConstructionWithArgs)
+{
+  sdf::Error error(sdf::ErrorCode::ELEMENT_INCORRECT_TYPE,
+      "XML Element[{}], child of element[{}], not defined in SDF.",
+      std::vector<std::string>{"foo", "model"});
+  EXPECT_EQ(error.Code(), sdf::ErrorCode::ELEMENT_INCORRECT_TYPE);
+  EXPECT_EQ(error.Message(),
+      "XML Element[foo], child of element[model], not defined in SDF.");
+  EXPECT_EQ(error.MessageArgs(), std::vector<std::string>({"foo", "model"}));
+  EXPECT_FALSE(error.FilePath().has_value());
+
+  // Extra placeholders are kept, and extra arguments are ignored
+  sdf::Error fewer(sdf::ErrorCode::ELEMENT_INVALID, "[{}] [{}]",
+      std::vector<std::string>{"a"}, "file.sdf", 3);
+  EXPECT_EQ(fewer.Message(), "[a] [{}]");
+  ASSERT_TRUE(fewer.LineNumber().has_value());
+  EXPECT_EQ(fewer.LineNumber().value(), 3);
+  sdf::Error more(sdf::ErrorCode::ELEMENT_INVALID, "[{}]",
+      std::vector<std::string>{"a", "b"});
+  EXPECT_EQ(more.Message(), "[a]");
+
+  // Messages given whole have no arguments
+  sdf::Error whole(sdf::ErrorCode::ELEMENT_INVALID, "{} stays");
+  EXPECT_EQ(whole.Message(), "{} stays");
+  EXPECT_TRUE(whole.MessageArgs().empty());
+}
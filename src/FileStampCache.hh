@@ -0,0 +1,203 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDFORMAT_FILESTAMPCACHE_HH
+#define SDFORMAT_FILESTAMPCACHE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "sdf/Filesystem.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Map from keys to values read from files, which may be used on
+  /// several threads. An entry can be stamped with the modification time of
+  /// a file, and is discarded when it is looked up after that file changed.
+  /// Entries without a file stay until they are erased.
+  /// \tparam Key Type of the keys.
+  /// \tparam T Type of the values.
+  template <typename Key, typename T>
+  class FileStampCache
+  {
+    /// \brief Default constructor.
+    public: FileStampCache() = default;
+
+    /// \brief Copy constructor.
+    /// \param[in] _cache Cache to copy.
+    public: FileStampCache(const FileStampCache &_cache)
+    {
+      std::lock_guard<std::mutex> lock(_cache.mutex);
+      this->entries = _cache.entries;
+    }
+
+    /// \brief Copy assignment operator.
+    /// \param[in] _cache Cache to copy.
+    /// \return Reference to this cache.
+    public: FileStampCache &operator=(const FileStampCache &_cache)
+    {
+      if (this != &_cache)
+      {
+        std::scoped_lock lock(this->mutex, _cache.mutex);
+        this->entries = _cache.entries;
+      }
+      return *this;
+    }
+
+    /// \brief Look up a value. The file of the entry is checked without
+    /// holding the lock.
+    /// \param[in] _key Key of the value.
+    /// \param[out] _value Copy of the cached value.
+    /// \return True if the key is cached and its file, if it has one, was
+    /// not modified since the value was inserted.
+    public: bool Find(const Key &_key, T &_value)
+    {
+      Entry entry;
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto it = this->entries.find(_key);
+        if (it == this->entries.end())
+          return false;
+        entry = it->second;
+      }
+
+      std::int64_t time;
+      if (!entry.file.empty() &&
+          (!filesystem::last_write_time(entry.file, time) ||
+           time != entry.modificationTime))
+      {
+        // Another thread may have inserted a current value meanwhile
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto it = this->entries.find(_key);
+        if (it != this->entries.end() &&
+            it->second.file == entry.file &&
+            it->second.modificationTime == entry.modificationTime)
+        {
+          this->entries.erase(it);
+        }
+        return false;
+      }
+
+      _value = std::move(entry.value);
+      return true;
+    }
+
+    /// \brief Add or replace a value.
+    /// \param[in] _key Key of the value.
+    /// \param[in] _value The value.
+    /// \param[in] _file File the value was read from, whose modification
+    /// time stamps the entry, or an empty string for a value that does not
+    /// depend on a file.
+    /// \return False if the modification time of _file could not be read,
+    /// in which case nothing is cached.
+    public: bool Insert(const Key &_key, T _value,
+                        const std::string &_file = "")
+    {
+      Entry entry;
+      if (!_file.empty() &&
+          !filesystem::last_write_time(_file, entry.modificationTime))
+      {
+        return false;
+      }
+      entry.file = _file;
+      entry.value = std::move(_value);
+
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->entries[_key] = std::move(entry);
+      return true;
+    }
+
+    /// \brief Remove a value.
+    /// \param[in] _key Key of the value.
+    public: void Erase(const Key &_key)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->entries.erase(_key);
+    }
+
+    /// \brief Remove the values that match a predicate.
+    /// \param[in] _predicate Function called with each key and value, which
+    /// returns true if the value is removed.
+    public: template <typename Predicate>
+            void EraseIf(Predicate _predicate)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      for (auto it = this->entries.begin(); it != this->entries.end();)
+      {
+        if (_predicate(it->first, it->second.value))
+          it = this->entries.erase(it);
+        else
+          ++it;
+      }
+    }
+
+    /// \brief Call a function with each key and value, in key order, while
+    /// holding the lock. Entries are not checked against their files.
+    /// \param[in] _function Function called with each key and value.
+    public: template <typename Function>
+            void ForEach(Function _function) const
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      for (const auto &[key, entry] : this->entries)
+        _function(key, entry.value);
+    }
+
+    /// \brief Remove all values.
+    public: void Clear()
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->entries.clear();
+    }
+
+    /// \brief Get the number of cached values.
+    /// \return Number of cached values.
+    public: std::size_t Size() const
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      return this->entries.size();
+    }
+
+    /// \brief A cached value.
+    private: struct Entry
+    {
+      /// \brief File the value was read from, or empty if there is none.
+      public: std::string file;
+
+      /// \brief Modification time of the file when the value was inserted.
+      public: std::int64_t modificationTime = 0;
+
+      /// \brief The value.
+      public: T value;
+    };
+
+    /// \brief Mutex that protects the entries.
+    private: mutable std::mutex mutex;
+
+    /// \brief Cached values.
+    private: std::map<Key, Entry> entries;
+  };
+  }
+}
+#endif
@@ -35,13 +35,17 @@
  * libs/filesystem/include/boost/filesystem/operations.hpp.
  */
 
+#include <chrono>
+#include <filesystem>
 #include <sstream>
 #include <string>
+#include <system_error>
 #include <vector>
 
 #ifndef _WIN32
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
 #include <stdlib.h>
 #include <string.h>
@@ -208,6 +212,83 @@ void DirIter::close_handle()
   closedir(reinterpret_cast<DIR*>(this->dataPtr->handle));
 }
 
+//////////////////////////////////////////////////
+/// \brief Get the type of a file from the mode returned by stat.
+/// \param[in] _mode File mode.
+/// \return Type of the file.
+static FileType file_type_from_mode(mode_t _mode)
+{
+  if (S_ISREG(_mode))
+    return FileType::REGULAR;
+  if (S_ISDIR(_mode))
+    return FileType::DIRECTORY;
+  if (S_ISLNK(_mode))
+    return FileType::SYMLINK;
+  return FileType::OTHER;
+}
+
+//////////////////////////////////////////////////
+bool read_directory(const std::string &_path, std::vector<DirEntry> &_entries)
+{
+  _entries.clear();
+
+  DIR *dirp = opendir(_path.c_str());
+  if (dirp == nullptr)
+  {
+    return false;
+  }
+
+  // readdir() already reads the directory in large batches, so the cost per
+  // entry is a copy of its name.  See DirIter::next() for why readdir() is
+  // safe to use here.
+  while (struct dirent *entry = readdir(dirp))  // NOLINT
+  {
+    const char *name = entry->d_name;
+    if (name[0] == '.' &&
+        (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+    {
+      continue;
+    }
+
+    FileType type = FileType::UNKNOWN;
+#ifdef _DIRENT_HAVE_D_TYPE
+    switch (entry->d_type)
+    {
+      case DT_REG:
+        type = FileType::REGULAR;
+        break;
+      case DT_DIR:
+        type = FileType::DIRECTORY;
+        break;
+      case DT_LNK:
+        type = FileType::SYMLINK;
+        break;
+      case DT_UNKNOWN:
+        break;
+      default:
+        type = FileType::OTHER;
+        break;
+    }
+#endif
+
+    // Some file systems do not fill in d_type, so fall back to lstat on
+    // those entries only.
+    if (type == FileType::UNKNOWN)
+    {
+      struct stat path_stat;
+      if (::fstatat(dirfd(dirp), name, &path_stat, AT_SYMLINK_NOFOLLOW) == 0)
+      {
+        type = file_type_from_mode(path_stat.st_mode);
+      }
+    }
+
+    _entries.push_back({name, type});
+  }
+
+  closedir(dirp);
+  return true;
+}
+
 #else  // Windows
 
 static const char preferred_separator = '\\';
@@ -491,6 +572,54 @@ void DirIter::close_handle()
   ::FindClose(this->dataPtr->handle);
 }
 
+//////////////////////////////////////////////////
+bool read_directory(const std::string &_path, std::vector<DirEntry> &_entries)
+{
+  _entries.clear();
+
+  if (_path.empty())
+  {
+    return false;
+  }
+
+  std::string dirpath(_path);
+  dirpath += (dirpath[dirpath.size()-1] != '\\'
+              && dirpath[dirpath.size()-1] != '/'
+              && dirpath[dirpath.size()-1] != ':')? "\\*" : "*";
+
+  // The attributes of each entry are part of the listing, so no entry needs
+  // to be checked on its own.
+  WIN32_FIND_DATAA data;
+  HANDLE handle = ::FindFirstFileA(dirpath.c_str(), &data);
+  if (handle == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+
+  do
+  {
+    const std::string name(data.cFileName);
+    if (name == "." || name == "..")
+    {
+      continue;
+    }
+
+    FileType type = FileType::REGULAR;
+    if ((data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0)
+      type = FileType::SYMLINK;
+    else if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+      type = FileType::DIRECTORY;
+    else if ((data.dwFileAttributes & FILE_ATTRIBUTE_DEVICE) != 0)
+      type = FileType::OTHER;
+
+    _entries.push_back({name, type});
+  }
+  while (::FindNextFileA(handle, &data) != 0);
+
+  ::FindClose(handle);
+  return true;
+}
+
 #endif  // _WIN32
 
 //////////////////////////////////////////////////
@@ -541,6 +670,76 @@ std::string basename(const std::string &_path)
   return basename;
 }
 
+//////////////////////////////////////////////////
+bool last_write_time(const std::string &_path, std::int64_t &_time)
+{
+  std::error_code ec;
+  const auto time = std::filesystem::last_write_time(_path, ec);
+  if (ec)
+    return false;
+  _time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      time.time_since_epoch()).count();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool is_regular_file(const std::string &_path)
+{
+  std::error_code ec;
+  return std::filesystem::is_regular_file(_path, ec);
+}
+
+//////////////////////////////////////////////////
+bool create_directories(const std::string &_path)
+{
+  std::error_code ec;
+  std::filesystem::create_directories(_path, ec);
+  return !ec && is_directory(_path);
+}
+
+//////////////////////////////////////////////////
+bool rename(const std::string &_from, const std::string &_to)
+{
+  std::error_code ec;
+  std::filesystem::rename(_from, _to, ec);
+  return !ec;
+}
+
+//////////////////////////////////////////////////
+bool remove(const std::string &_path)
+{
+  std::error_code ec;
+  return std::filesystem::remove(_path, ec);
+}
+
+//////////////////////////////////////////////////
+bool is_absolute(const std::string &_path)
+{
+  return std::filesystem::path(_path).is_absolute();
+}
+
+//////////////////////////////////////////////////
+std::string parent_path(const std::string &_path)
+{
+  return std::filesystem::path(_path).parent_path().string();
+}
+
+//////////////////////////////////////////////////
+bool equivalent(const std::string &_path1, const std::string &_path2)
+{
+  std::error_code ec;
+  return std::filesystem::equivalent(_path1, _path2, ec);
+}
+
+//////////////////////////////////////////////////
+std::string weakly_canonical(const std::string &_path)
+{
+  std::error_code ec;
+  const std::filesystem::path path =
+      std::filesystem::weakly_canonical(_path, ec);
+  return ec ? _path : path.string();
+}
+
 //////////////////////////////////////////////////
 DirIter::DirIter() : dataPtr(ignition::utils::MakeUniqueImpl<Implementation>())
 {
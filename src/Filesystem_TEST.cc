@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
 #ifndef _WIN32
 #include <fcntl.h>
 #include <limits.h>
@@ -362,6 +367,82 @@ TEST(Filesystem, directory_iterator)
   EXPECT_EQ(found_items.size(), 0UL);
 }
 
+/////////////////////////////////////////////////
+TEST(Filesystem, read_directory)
+{
+  std::string new_temp_dir;
+  ASSERT_TRUE(create_and_switch_to_temp_dir(new_temp_dir));
+  ASSERT_TRUE(create_new_empty_file("newfile"));
+  ASSERT_TRUE(sdf::filesystem::create_directory("newdir"));
+#ifndef _MSC_VER
+  ASSERT_TRUE(create_new_dir_symlink("symlink-dir", "newdir"));
+#endif
+
+  std::vector<sdf::filesystem::DirEntry> entries;
+  ASSERT_TRUE(sdf::filesystem::read_directory(".", entries));
+  std::map<std::string, sdf::filesystem::FileType> types;
+  for (const auto &entry : entries)
+    types[entry.name] = entry.type;
+
+  EXPECT_EQ(sdf::filesystem::FileType::REGULAR, types["newfile"]);
+  EXPECT_EQ(sdf::filesystem::FileType::DIRECTORY, types["newdir"]);
+#ifndef _MSC_VER
+  EXPECT_EQ(sdf::filesystem::FileType::SYMLINK, types["symlink-dir"]);
+  EXPECT_EQ(3u, entries.size());
+#else
+  EXPECT_EQ(2u, entries.size());
+#endif
+
+  // The entries are replaced when the vector is reused.
+  ASSERT_TRUE(sdf::filesystem::read_directory("newdir", entries));
+  EXPECT_TRUE(entries.empty());
+  ASSERT_TRUE(create_new_empty_file(
+      sdf::filesystem::append("newdir", "inner")));
+  ASSERT_TRUE(sdf::filesystem::read_directory("newdir", entries));
+  ASSERT_EQ(1u, entries.size());
+  EXPECT_EQ("inner", entries[0].name);
+
+  EXPECT_FALSE(sdf::filesystem::read_directory("nonexistent", entries));
+  EXPECT_TRUE(entries.empty());
+  EXPECT_FALSE(sdf::filesystem::read_directory("", entries));
+}
+
+/////////////////////////////////////////////////
+TEST(Filesystem, last_write_time)
+{
+  std::string new_temp_dir;
+  ASSERT_TRUE(create_and_switch_to_temp_dir(new_temp_dir));
+  ASSERT_TRUE(create_new_empty_file("newfile"));
+
+  std::int64_t time = 0;
+  ASSERT_TRUE(sdf::filesystem::last_write_time("newfile", time));
+  std::int64_t sameTime = 0;
+  ASSERT_TRUE(sdf::filesystem::last_write_time("newfile", sameTime));
+  EXPECT_EQ(time, sameTime);
+
+  EXPECT_FALSE(sdf::filesystem::last_write_time("nonexistent", time));
+  EXPECT_EQ(sameTime, time);
+}
+
+/////////////////////////////////////////////////
+TEST(Filesystem, rename_remove)
+{
+  std::string new_temp_dir;
+  ASSERT_TRUE(create_and_switch_to_temp_dir(new_temp_dir));
+  ASSERT_TRUE(create_new_empty_file("newfile"));
+  ASSERT_TRUE(create_new_empty_file("oldfile"));
+
+  // Renaming replaces the file at the new path.
+  EXPECT_TRUE(sdf::filesystem::rename("newfile", "oldfile"));
+  EXPECT_FALSE(sdf::filesystem::exists("newfile"));
+  EXPECT_TRUE(sdf::filesystem::exists("oldfile"));
+  EXPECT_FALSE(sdf::filesystem::rename("newfile", "otherfile"));
+
+  EXPECT_TRUE(sdf::filesystem::remove("oldfile"));
+  EXPECT_FALSE(sdf::filesystem::exists("oldfile"));
+  EXPECT_FALSE(sdf::filesystem::remove("oldfile"));
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -369,3 +450,79 @@ int main(int argc, char **argv)
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
+
+/////////////////////////////////////////////////
+TEST(Filesystem, is_absolute_parent_path)
+{
+  const std::string dir = sdf::filesystem::append("dir1", "dir2");
+  const std::string file = sdf::filesystem::append(dir, "file");
+
+  EXPECT_FALSE(sdf::filesystem::is_absolute(file));
+  EXPECT_TRUE(sdf::filesystem::is_absolute(
+        sdf::filesystem::append(sdf::filesystem::current_path(), file)));
+
+  EXPECT_EQ(dir, sdf::filesystem::parent_path(file));
+  EXPECT_EQ("dir1", sdf::filesystem::parent_path(dir));
+  EXPECT_EQ("", sdf::filesystem::parent_path("dir1"));
+}
+
+/////////////////////////////////////////////////
+TEST(Filesystem, weakly_canonical)
+{
+  std::string new_temp_dir;
+  ASSERT_TRUE(create_and_switch_to_temp_dir(new_temp_dir));
+  ASSERT_TRUE(sdf::filesystem::create_directory("dir1"));
+
+  const std::string cwd = sdf::filesystem::current_path();
+  EXPECT_EQ(sdf::filesystem::weakly_canonical(
+        sdf::filesystem::append(cwd, "dir1", "file")),
+      sdf::filesystem::weakly_canonical(
+        sdf::filesystem::append("dir1", "..", "dir1", ".", "file")));
+  EXPECT_TRUE(sdf::filesystem::is_absolute(
+        sdf::filesystem::weakly_canonical("dir1")));
+}
+
+/////////////////////////////////////////////////
+TEST(Filesystem, create_directories)
+{
+  std::string new_temp_dir;
+  ASSERT_TRUE(create_and_switch_to_temp_dir(new_temp_dir));
+
+  const std::string dir = sdf::filesystem::append("dir1", "dir2", "dir3");
+  EXPECT_TRUE(sdf::filesystem::create_directories(dir));
+  EXPECT_TRUE(sdf::filesystem::is_directory(dir));
+  // The directory already exists.
+  EXPECT_TRUE(sdf::filesystem::create_directories(dir));
+
+  ASSERT_TRUE(create_new_empty_file("file"));
+  EXPECT_FALSE(sdf::filesystem::create_directories("file"));
+}
+
+/////////////////////////////////////////////////
+TEST(Filesystem, is_regular_file)
+{
+  std::string new_temp_dir;
+  ASSERT_TRUE(create_and_switch_to_temp_dir(new_temp_dir));
+  ASSERT_TRUE(create_new_empty_file("newfile"));
+  ASSERT_TRUE(sdf::filesystem::create_directory("dir1"));
+
+  EXPECT_TRUE(sdf::filesystem::is_regular_file("newfile"));
+  EXPECT_FALSE(sdf::filesystem::is_regular_file("dir1"));
+  EXPECT_FALSE(sdf::filesystem::is_regular_file("nonexistent"));
+}
+
+/////////////////////////////////////////////////
+TEST(Filesystem, equivalent)
+{
+  std::string new_temp_dir;
+  ASSERT_TRUE(create_and_switch_to_temp_dir(new_temp_dir));
+  ASSERT_TRUE(create_new_empty_file("newfile"));
+  ASSERT_TRUE(create_new_empty_file("otherfile"));
+
+  EXPECT_TRUE(sdf::filesystem::equivalent("newfile",
+        sdf::filesystem::append(".", "newfile")));
+  EXPECT_TRUE(sdf::filesystem::equivalent("newfile",
+        sdf::filesystem::append(sdf::filesystem::current_path(), "newfile")));
+  EXPECT_FALSE(sdf::filesystem::equivalent("newfile", "otherfile"));
+  EXPECT_FALSE(sdf::filesystem::equivalent("newfile", "nonexistent"));
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "sdf/SDFImpl.hh"
+
+#include "FindFileCache.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/////////////////////////////////////////////////
+FindFileCache *FindFileCache::Of(const ParserConfig &_config)
+{
+  return _config.FindFileCacheInstance();
+}
+
+/////////////////////////////////////////////////
+bool FindFileCache::Find(const std::string &_fileName, bool _searchLocalPath,
+    bool _useCallback, Result &_result)
+{
+  return this->results.Find(
+      {_fileName, _searchLocalPath, _useCallback, SDF::Version()}, _result);
+}
+
+/////////////////////////////////////////////////
+void FindFileCache::Insert(const std::string &_fileName,
+    bool _searchLocalPath, bool _useCallback, const Result &_result)
+{
+  this->results.Insert(
+      {_fileName, _searchLocalPath, _useCallback, SDF::Version()}, _result);
+}
+
+/////////////////////////////////////////////////
+void FindFileCache::InvalidateURIScheme(const std::string &_uriScheme)
+{
+  this->results.EraseIf([&_uriScheme](const Key &_key, const Result &_result)
+  {
+    return std::get<0>(_key).find(_uriScheme) == 0 &&
+        _result.uriScheme != _uriScheme;
+  });
+}
+
+/////////////////////////////////////////////////
+void FindFileCache::InvalidateCallback()
+{
+  this->results.EraseIf([](const Key &_key, const Result &_result)
+  {
+    return std::get<2>(_key) &&
+        (_result.path.empty() || _result.searchRoot == kCallbackRoot);
+  });
+}
+
+/////////////////////////////////////////////////
+void FindFileCache::Clear()
+{
+  this->results.Clear();
+}
+
+/////////////////////////////////////////////////
+std::map<std::string, std::string> FindFileCache::FoundPaths() const
+{
+  std::map<std::string, std::string> paths;
+  this->results.ForEach([&paths](const Key &_key, const Result &_result)
+  {
+    if (!_result.path.empty())
+      paths.emplace(std::get<0>(_key), _result.path);
+  });
+  return paths;
+}
+
+/////////////////////////////////////////////////
+std::size_t FindFileCache::Size() const
+{
+  return this->results.Size();
+}
+}
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_FINDFILECACHE_HH
+#define SDFORMAT_FINDFILECACHE_HH
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "sdf/ParserConfig.hh"
+#include "sdf/sdf_config.h"
+#include "FileStampCache.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Cache of the results of sdf::findFile for one ParserConfig.
+  /// Files that were not found are cached as well. Each result remembers the
+  /// search root it was found in, so that adding a URI path or changing the
+  /// find callback only discards the results that the change can affect.
+  class FindFileCache
+  {
+    /// \brief A cached lookup.
+    public: struct Result
+    {
+      /// \brief Path of the file, or an empty string if it was not found.
+      public: std::string path;
+
+      /// \brief Search root the file was found in: a directory of the URI
+      /// path map, the install path, a directory of SDF_PATH, the current
+      /// directory, or kCallbackRoot when the file was found by the find
+      /// callback. Empty if the file was not found, or if the file name was
+      /// used as is.
+      public: std::string searchRoot;
+
+      /// \brief The URI scheme whose search directory matched, or an empty
+      /// string if the file was not found through the URI path map.
+      public: std::string uriScheme;
+    };
+
+    /// \brief Value of Result::searchRoot for files found by the find
+    /// callback.
+    public: static constexpr const char *kCallbackRoot = "<find callback>";
+
+    /// \brief Get the find file cache of a parser configuration.
+    /// \param[in] _config Parser configuration.
+    /// \return The cache, or nullptr if lookups are not cached.
+    public: static FindFileCache *Of(const ParserConfig &_config);
+
+    /// \brief Look up a cached result.
+    /// \param[in] _fileName File name passed to sdf::findFile.
+    /// \param[in] _searchLocalPath Whether the local path is searched.
+    /// \param[in] _useCallback Whether the find callback is used.
+    /// \param[out] _result The cached result.
+    /// \return True if the lookup is cached.
+    public: bool Find(const std::string &_fileName, bool _searchLocalPath,
+                bool _useCallback, Result &_result);
+
+    /// \brief Cache the result of a lookup.
+    /// \param[in] _fileName File name passed to sdf::findFile.
+    /// \param[in] _searchLocalPath Whether the local path is searched.
+    /// \param[in] _useCallback Whether the find callback is used.
+    /// \param[in] _result The result of the lookup.
+    public: void Insert(const std::string &_fileName, bool _searchLocalPath,
+                bool _useCallback, const Result &_result);
+
+    /// \brief Discard the results that can change when a search directory is
+    /// added for a URI scheme. Directories are appended to the list of a
+    /// scheme, so results found through that scheme remain valid.
+    /// \param[in] _uriScheme The URI scheme.
+    public: void InvalidateURIScheme(const std::string &_uriScheme);
+
+    /// \brief Discard the results that can change when the find callback
+    /// changes.
+    public: void InvalidateCallback();
+
+    /// \brief Remove all results from the cache.
+    public: void Clear();
+
+    /// \brief Get the paths of the files that were found.
+    /// \return The path of each file name passed to sdf::findFile that was
+    /// found.
+    public: std::map<std::string, std::string> FoundPaths() const;
+
+    /// \brief Get the number of cached results.
+    /// \return Number of cached results.
+    public: std::size_t Size() const;
+
+    /// \brief Key of a lookup: the file name, whether the local path is
+    /// searched, whether the callback is used and the SDFormat version.
+    private: using Key = std::tuple<std::string, bool, bool, std::string>;
+
+    /// \brief Cached results. They do not depend on a single file, so they
+    /// are not stamped, and are only discarded by the Invalidate functions.
+    private: FileStampCache<Key, Result> results;
+  };
+  }
+}
+#endif
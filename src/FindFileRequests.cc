@@ -0,0 +1,96 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <exception>
+#include <utility>
+
+#include "sdf/Console.hh"
+
+#include "FindFileRequests.hh"
+
+using namespace sdf;
+
+/////////////////////////////////////////////////
+FindFileRequests::FindFileRequests(
+    ParserConfig::AsyncFindFileCallback _callback)
+  : callback(std::move(_callback))
+{
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<FindFileRequests> FindFileRequests::Of(
+    const ParserConfig &_config)
+{
+  return _config.FindFileRequestsInstance();
+}
+
+/////////////////////////////////////////////////
+const ParserConfig::AsyncFindFileCallback &FindFileRequests::Callback() const
+{
+  return this->callback;
+}
+
+/////////////////////////////////////////////////
+std::shared_future<std::string> FindFileRequests::Request(
+    const std::string &_fileName)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto it = this->requests.find(_fileName);
+  if (it != this->requests.end())
+    return it->second;
+
+  std::shared_future<std::string> request = this->callback(_fileName).share();
+  this->requests.emplace(_fileName, request);
+  return request;
+}
+
+/////////////////////////////////////////////////
+void FindFileRequests::Start(const std::string &_fileName)
+{
+  this->Request(_fileName);
+}
+
+/////////////////////////////////////////////////
+std::string FindFileRequests::Wait(const std::string &_fileName)
+{
+  std::shared_future<std::string> request = this->Request(_fileName);
+
+  std::string path;
+  if (request.valid())
+  {
+    try
+    {
+      path = request.get();
+    }
+    catch (const std::exception &_e)
+    {
+      sdferr << "Asynchronous find callback failed for [" << _fileName
+             << "]: " << _e.what() << "\n";
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->requests.erase(_fileName);
+  return path;
+}
+
+/////////////////////////////////////////////////
+std::size_t FindFileRequests::Size() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->requests.size();
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_FINDFILEREQUESTS_HH
+#define SDFORMAT_FINDFILEREQUESTS_HH
+
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "sdf/ParserConfig.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Requests of the asynchronous find callback of a ParserConfig
+  /// that are in progress. The parser starts a request for each include of
+  /// an element whose URI is not found in the search paths, before the
+  /// includes are read, and sdf::findFile waits for the request of a URI
+  /// when it needs its path. A request is removed once it has completed and
+  /// its path was used.
+  class FindFileRequests
+  {
+    /// \brief Constructor.
+    /// \param[in] _callback Asynchronous find callback.
+    public: explicit FindFileRequests(
+                ParserConfig::AsyncFindFileCallback _callback);
+
+    /// \brief Get the requests of a parser configuration.
+    /// \param[in] _config Parser configuration.
+    /// \return The requests, or nullptr if the configuration has no
+    /// asynchronous find callback.
+    public: static std::shared_ptr<FindFileRequests> Of(
+                const ParserConfig &_config);
+
+    /// \brief Get the asynchronous find callback.
+    /// \return The callback.
+    public: const ParserConfig::AsyncFindFileCallback &Callback() const;
+
+    /// \brief Start a request for a file name, unless one is in progress.
+    /// \param[in] _fileName File name to resolve.
+    public: void Start(const std::string &_fileName);
+
+    /// \brief Wait for the request of a file name, starting it if it was not
+    /// started.
+    /// \param[in] _fileName File name to resolve.
+    /// \return Path of the file, or an empty string if it was not found or
+    /// the request failed.
+    public: std::string Wait(const std::string &_fileName);
+
+    /// \brief Get the number of requests in progress.
+    /// \return Number of requests that were started and not waited for.
+    public: std::size_t Size() const;
+
+    /// \brief Get the request of a file name, starting it if needed.
+    /// \param[in] _fileName File name to resolve.
+    /// \return The request.
+    private: std::shared_future<std::string> Request(
+                 const std::string &_fileName);
+
+    /// \brief Asynchronous find callback.
+    private: ParserConfig::AsyncFindFileCallback callback;
+
+    /// \brief Mutex that protects the requests.
+    private: mutable std::mutex mutex;
+
+    /// \brief Requests in progress, by file name.
+    private: std::map<std::string, std::shared_future<std::string>> requests;
+  };
+  }
+}
+#endif
@@ -0,0 +1,276 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_FLATGRAPH_HH
+#define SDFORMAT_FLATGRAPH_HH
+
+#include <cstddef>
+#include <vector>
+
+#include <ignition/math/graph/Graph.hh>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Compact copy of the structure of a directed graph, used to answer
+  /// queries on a graph that is no longer being modified. Vertex IDs of
+  /// ignition::math graphs are handed out in increasing order, so every
+  /// array is indexed directly by vertex ID. For each vertex, the edge that
+  /// comes into it is stored next to the vertex when there is exactly one,
+  /// and the outgoing edges are stored in compressed sparse row form. The
+  /// sink vertex reached from each vertex is precomputed as well.
+  /// \tparam EdgeType Type of the data stored in each edge.
+  template <typename EdgeType>
+  class FlatGraph
+  {
+    /// \brief Vertex ID.
+    public: using VertexId = ignition::math::graph::VertexId;
+
+    /// \brief Build the flat copy of a graph.
+    /// \param[in] _graph Graph to copy.
+    /// \param[in] _revision Revision of the graph, which changes every time
+    /// the graph is modified.
+    public: template <typename VertexType>
+            void Build(const ignition::math::graph::DirectedGraph<
+                           VertexType, EdgeType> &_graph,
+                       std::size_t _revision)
+    {
+      const auto vertices = _graph.Vertices();
+      const std::size_t size =
+          vertices.empty() ? 0u : vertices.rbegin()->first + 1;
+
+      this->valid.assign(size, false);
+      this->inDegree.assign(size, 0u);
+      this->parents.assign(size, ignition::math::graph::kNullId);
+      this->parentEdges.assign(size, EdgeType());
+      this->childOffsets.assign(size + 1, 0u);
+
+      for (const auto &vertexPair : vertices)
+        this->valid[vertexPair.first] = true;
+
+      const auto edges = _graph.Edges();
+      for (const auto &edgePair : edges)
+      {
+        const auto &edge = edgePair.second.get();
+        const VertexId tail = edge.Tail();
+        const VertexId head = edge.Head();
+        ++this->inDegree[head];
+        this->parents[head] = tail;
+        this->parentEdges[head] = edge.Data();
+        ++this->childOffsets[tail + 1];
+      }
+
+      for (std::size_t i = 0; i < size; ++i)
+        this->childOffsets[i + 1] += this->childOffsets[i];
+
+      this->children.resize(edges.size());
+      this->childEdges.resize(edges.size());
+      std::vector<std::size_t> next(this->childOffsets.begin(),
+                                    this->childOffsets.end() - 1);
+      for (const auto &edgePair : edges)
+      {
+        const auto &edge = edgePair.second.get();
+        const std::size_t pos = next[edge.Tail()]++;
+        this->children[pos] = edge.Head();
+        this->childEdges[pos] = edge.Data();
+      }
+
+      this->BuildSinks();
+
+      this->revision = _revision;
+      this->built = true;
+    }
+
+    /// \brief Check if the flat copy matches a revision of the graph.
+    /// \param[in] _revision Current revision of the graph.
+    /// \return True if the flat copy was built from that revision.
+    public: bool Current(std::size_t _revision) const
+    {
+      return this->built && this->revision == _revision;
+    }
+
+    /// \brief Check if a vertex is in the graph.
+    /// \param[in] _id ID of the vertex.
+    /// \return True if the vertex exists.
+    public: bool Valid(VertexId _id) const
+    {
+      return _id < this->valid.size() && this->valid[_id];
+    }
+
+    /// \brief Get the number of edges that come into a vertex.
+    /// \param[in] _id ID of a valid vertex.
+    /// \return Number of incoming edges.
+    public: std::size_t InDegree(VertexId _id) const
+    {
+      return this->inDegree[_id];
+    }
+
+    /// \brief Get the vertex at the tail of the edge that comes into a vertex.
+    /// \param[in] _id ID of a valid vertex whose InDegree is 1.
+    /// \return ID of the parent vertex.
+    public: VertexId Parent(VertexId _id) const
+    {
+      return this->parents[_id];
+    }
+
+    /// \brief Get the data of the edge that comes into a vertex.
+    /// \param[in] _id ID of a valid vertex whose InDegree is 1.
+    /// \return Data of the incoming edge.
+    public: const EdgeType &ParentEdge(VertexId _id) const
+    {
+      return this->parentEdges[_id];
+    }
+
+    /// \brief Get the number of edges that go out of a vertex.
+    /// \param[in] _id ID of a valid vertex.
+    /// \return Number of outgoing edges.
+    public: std::size_t OutDegree(VertexId _id) const
+    {
+      return this->childOffsets[_id + 1] - this->childOffsets[_id];
+    }
+
+    /// \brief Get the vertex at the head of an edge that goes out of a
+    /// vertex.
+    /// \param[in] _id ID of a valid vertex.
+    /// \param[in] _index Index of the edge, less than OutDegree(_id).
+    /// \return ID of the child vertex.
+    public: VertexId Child(VertexId _id, std::size_t _index) const
+    {
+      return this->children[this->childOffsets[_id] + _index];
+    }
+
+    /// \brief Get the data of an edge that goes out of a vertex.
+    /// \param[in] _id ID of a valid vertex.
+    /// \param[in] _index Index of the edge, less than OutDegree(_id).
+    /// \return Data of the outgoing edge.
+    public: const EdgeType &ChildEdge(VertexId _id, std::size_t _index) const
+    {
+      return this->childEdges[this->childOffsets[_id] + _index];
+    }
+
+    /// \brief Get the sink vertex that is reached from a vertex by following
+    /// outgoing edges, such as the body a frame is attached to in a
+    /// FrameAttachedTo graph.
+    /// \param[in] _id ID of the vertex.
+    /// \return ID of the sink vertex, or kNullId if the vertex is invalid or
+    /// the path from it reaches a vertex with multiple outgoing edges or a
+    /// cycle.
+    public: VertexId Sink(VertexId _id) const
+    {
+      if (!this->Valid(_id))
+        return ignition::math::graph::kNullId;
+      return this->sinks[_id];
+    }
+
+    /// \brief Get the number of entries of the vertex arrays, which is one
+    /// more than the largest vertex ID. Any path in the graph that is longer
+    /// than this contains a cycle.
+    /// \return Size of the vertex arrays.
+    public: std::size_t Size() const
+    {
+      return this->valid.size();
+    }
+
+    /// \brief Find the sink vertex of every vertex. Each path is followed
+    /// once, and every vertex along it gets the sink found at its end.
+    private: void BuildSinks()
+    {
+      enum class State {UNVISITED, IN_PATH, DONE};
+      const std::size_t size = this->valid.size();
+      this->sinks.assign(size, ignition::math::graph::kNullId);
+      std::vector<State> states(size, State::UNVISITED);
+      std::vector<VertexId> path;
+
+      for (VertexId start = 0; start < size; ++start)
+      {
+        if (!this->valid[start] || states[start] == State::DONE)
+          continue;
+
+        VertexId sink = ignition::math::graph::kNullId;
+        VertexId id = start;
+        path.clear();
+        while (true)
+        {
+          if (states[id] == State::DONE)
+          {
+            sink = this->sinks[id];
+            break;
+          }
+          // A vertex that is already in the path means there is a cycle.
+          if (states[id] == State::IN_PATH)
+            break;
+
+          states[id] = State::IN_PATH;
+          path.push_back(id);
+
+          const std::size_t outDegree = this->OutDegree(id);
+          if (outDegree == 0)
+          {
+            sink = id;
+            break;
+          }
+          if (outDegree > 1 || !this->Valid(this->Child(id, 0)))
+            break;
+          id = this->Child(id, 0);
+        }
+
+        for (const VertexId pathId : path)
+        {
+          this->sinks[pathId] = sink;
+          states[pathId] = State::DONE;
+        }
+      }
+    }
+
+    /// \brief True once the flat copy was built.
+    private: bool built = false;
+
+    /// \brief Revision of the graph the flat copy was built from.
+    private: std::size_t revision = 0;
+
+    /// \brief Whether each vertex ID is in the graph.
+    private: std::vector<bool> valid;
+
+    /// \brief Number of incoming edges of each vertex.
+    private: std::vector<std::size_t> inDegree;
+
+    /// \brief Tail of the last incoming edge of each vertex.
+    private: std::vector<VertexId> parents;
+
+    /// \brief Data of the last incoming edge of each vertex.
+    private: std::vector<EdgeType> parentEdges;
+
+    /// \brief Offset of the first outgoing edge of each vertex in children
+    /// and childEdges, followed by the total number of edges.
+    private: std::vector<std::size_t> childOffsets;
+
+    /// \brief Heads of the outgoing edges, grouped by tail vertex.
+    private: std::vector<VertexId> children;
+
+    /// \brief Data of the outgoing edges, grouped by tail vertex.
+    private: std::vector<EdgeType> childEdges;
+
+    /// \brief Sink vertex of each vertex, or kNullId if it has none.
+    private: std::vector<VertexId> sinks;
+  };
+  }
+}
+#endif
@@ -17,6 +17,7 @@
 #include <string>
 #include "sdf/ForceTorque.hh"
 #include "sdf/parser.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
@@ -69,7 +70,7 @@ Errors ForceTorque::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <force_torque> element.
   // This is an error that cannot be recovered, so return an error.
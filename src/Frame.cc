@@ -14,13 +14,17 @@
  * limitations under the License.
  *
 */
+#include <memory>
 #include <string>
+#include <utility>
 #include <ignition/math/Pose3.hh>
 #include "sdf/Frame.hh"
 #include "sdf/Error.hh"
 #include "sdf/Types.hh"
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
+#include "ScopedTraceEvent.hh"
 #include "Utils.hh"
 
 using namespace sdf;
@@ -30,6 +34,11 @@ class sdf::Frame::Implementation
   /// \brief Name of the frame.
   public: std::string name = "";
 
+  /// \brief Names that the frames of the vector holding this frame were renamed
+  /// to, shared with the name index of the vector. Null if the frame is not
+  /// indexed.
+  public: std::shared_ptr<NameIndexRenames> nameIndexRenames;
+
   /// \brief Name of the attached-to frame.
   public: std::string attachedTo = "";
 
@@ -62,9 +71,10 @@ Frame::Frame()
 /////////////////////////////////////////////////
 Errors Frame::Load(ElementPtr _sdf)
 {
+  ScopedTraceEvent event("Frame::Load", "dom");
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <frame>
   // This is an error that cannot be recovered, so return an error.
@@ -116,9 +126,17 @@ const std::string &Frame::Name() const
 /////////////////////////////////////////////////
 void Frame::SetName(const std::string &_name)
 {
+  if (this->dataPtr->nameIndexRenames && this->dataPtr->name != _name)
+    this->dataPtr->nameIndexRenames->Add(_name);
   this->dataPtr->name = _name;
 }
 
+/////////////////////////////////////////////////
+void Frame::SetNameIndexRenames(std::shared_ptr<NameIndexRenames> _renames)
+{
+  this->dataPtr->nameIndexRenames = std::move(_renames);
+}
+
 /////////////////////////////////////////////////
 const std::string &Frame::AttachedTo() const
 {
@@ -212,6 +230,17 @@ sdf::SemanticPose Frame::SemanticPose() const
       this->dataPtr->poseRelativeToGraph);
 }
 
+/////////////////////////////////////////////////
+Errors Frame::ResolvePose(ignition::math::Pose3d &_pose,
+    const std::string &_resolveTo) const
+{
+  return resolveSemanticPose(_pose, this->dataPtr->poseRelativeToGraph,
+      this->dataPtr->name, this->dataPtr->pose,
+      this->dataPtr->poseRelativeTo.empty() ?
+          this->dataPtr->attachedTo : this->dataPtr->poseRelativeTo,
+      this->dataPtr->graphScopeContextName, _resolveTo);
+}
+
 /////////////////////////////////////////////////
 sdf::ElementPtr Frame::Element() const
 {
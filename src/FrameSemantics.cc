@@ -15,8 +15,13 @@
  *
 */
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <optional>
 #include <string>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -31,11 +36,16 @@
 #include "sdf/Joint.hh"
 #include "sdf/Link.hh"
 #include "sdf/Model.hh"
+#include "sdf/TaskExecutor.hh"
 #include "sdf/Types.hh"
 #include "sdf/World.hh"
 
+#include "ErrorSink.hh"
 #include "FrameSemantics.hh"
+#include "PerfCounting.hh"
+#include "PoseBatch.hh"
 #include "ScopedGraph.hh"
+#include "ScopedTraceEvent.hh"
 #include "Utils.hh"
 
 namespace sdf
@@ -199,6 +209,41 @@ FindSinkVertex(
   return PairType(vertex, edges);
 }
 
+/////////////////////////////////////////////////
+/// \brief Compose the poses on the path from the scope vertex of a
+/// PoseRelativeTo graph to a vertex using the flat copy of the graph, like
+/// FindSourceVertex followed by resolvePoseRelativeToRoot.
+/// \param[out] _pose Pose of the vertex relative to the scope vertex.
+/// \param[in] _graph Scope of the graph.
+/// \param[in] _id VertexId of the vertex.
+/// \return True if the pose was resolved. False if the graph was not frozen,
+/// the vertex is invalid, a vertex with multiple incoming edges is found, or
+/// the path does not reach the scope vertex; the graph has to be traversed
+/// with FindSourceVertex to report the error.
+static bool flatPoseRelativeToRoot(ignition::math::Pose3d &_pose,
+    const ScopedGraph<PoseRelativeToGraph> &_graph,
+    ignition::math::graph::VertexId _id)
+{
+  const auto *flat = _graph.Flat();
+  const auto scopeId = _graph.ScopeVertexId();
+  if (nullptr == flat || !flat->Valid(_id))
+    return false;
+
+  ignition::math::Pose3d pose;
+  std::size_t steps = 0;
+  while (_id != scopeId)
+  {
+    // A path longer than the number of vertices contains a cycle.
+    if (flat->InDegree(_id) != 1 || ++steps > flat->Size())
+      return false;
+    pose = flat->ParentEdge(_id) * pose;
+    _id = flat->Parent(_id);
+  }
+
+  _pose = pose;
+  return true;
+}
+
 /////////////////////////////////////////////////
 /// \brief Resolve the pose of a model taking into account the placement frame
 /// attribute. This function is used to calculate the pose of the edge between a
@@ -272,6 +317,113 @@ static Errors resolveModelPoseWithPlacementFrame(
   return errors;
 }
 
+/////////////////////////////////////////////////
+/// \brief Call a function with every index from 0 to _count - 1, on several
+/// threads. Each index is passed to exactly one call.
+/// \param[in] _count Number of indices.
+/// \param[in] _threadCount Maximum number of threads.
+/// \param[in] _executor Executor that runs the threads, or nullptr for
+/// TaskExecutor::Threaded.
+/// \param[in] _function Function to call with each index.
+template <typename FunctionT>
+void forEachIndexConcurrently(std::size_t _count, std::size_t _threadCount,
+                              TaskExecutor *_executor,
+                              const FunctionT &_function)
+{
+  std::atomic<std::size_t> nextIndex{0};
+  auto work = [&](std::size_t)
+  {
+    for (std::size_t i = nextIndex++; i < _count; i = nextIndex++)
+      _function(i);
+  };
+
+  const std::size_t taskCount = std::min(_threadCount, _count);
+  if (_executor)
+    _executor->RunAndWait(taskCount, work);
+  else
+    TaskExecutor::Threaded()->RunAndWait(taskCount, work);
+}
+
+/// \brief Names used as a scope (e.g. "model" in "model::link") by the
+/// references of a document.
+using ReferencedScopes = std::unordered_set<std::string>;
+
+/////////////////////////////////////////////////
+/// \brief Add the scopes used by the string values and attributes of an
+/// element and of its descendants. Every value is considered, so that the
+/// scopes used by references to frames, links and joints are all found.
+/// \param[in] _elem The element.
+/// \param[in,out] _scopes The scopes.
+void collectReferencedScopes(const ElementPtr &_elem,
+                             ReferencedScopes &_scopes)
+{
+  auto addScopes = [&_scopes](const ParamPtr &_param)
+  {
+    if (!_param || !_param->IsType<std::string>())
+      return;
+
+    const std::string value = _param->GetAsString();
+    for (std::size_t begin = 0, end = value.find(kSdfScopeDelimiter);
+         end != std::string::npos;
+         begin = end + kSdfScopeDelimiter.size(),
+         end = value.find(kSdfScopeDelimiter, begin))
+    {
+      _scopes.insert(value.substr(begin, end - begin));
+    }
+  };
+
+  for (const auto &attribute : _elem->GetAttributes())
+  {
+    addScopes(attribute);
+  }
+  addScopes(_elem->GetValue());
+
+  for (auto child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    collectReferencedScopes(child, _scopes);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a model contains interface models whose children
+/// are not loaded yet.
+/// \param[in] _model The model.
+/// \return True if a model or a nested model of _model has such interface
+/// models.
+bool hasLazyInterfaceModels(const sdf::Model &_model)
+{
+  for (uint64_t i = 0; i < _model.InterfaceModelCount(); ++i)
+  {
+    if (!_model.InterfaceModelByIndex(i)->ChildrenLoaded())
+      return true;
+  }
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+  {
+    if (hasLazyInterfaceModels(*_model.ModelByIndex(i)))
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the scopes referenced by a document, if it contains
+/// interface models whose children are not loaded yet.
+/// \param[in] _elem Element of the document.
+/// \param[in] _hasLazyModels Whether the document contains such models.
+/// \return The scopes, or nullopt if the document has no such models or
+/// if _elem is null, in which case every interface model is loaded.
+std::optional<ReferencedScopes> referencedScopes(const ElementPtr &_elem,
+                                                 bool _hasLazyModels)
+{
+  if (!_elem || !_hasLazyModels)
+    return std::nullopt;
+
+  ReferencedScopes scopes;
+  collectReferencedScopes(_elem, scopes);
+  return scopes;
+}
+
 /// \brief Base struct the contains a few common members. These structs provide
 /// a common API used by the build*Graph functions to access the various
 /// attributes and retrieve children of regular DOM objects and Interface
@@ -423,7 +575,13 @@ struct PlacementFrameInfo
 struct ModelWrapper : public WrapperBase
 {
   /// \brief Constructor that takes an sdf::Model
-  explicit ModelWrapper(const sdf::Model &_model)
+  /// \param[in] _model Model to wrap.
+  /// \param[in] _scopes Scopes referenced by the document that contains the
+  /// model, which tell which interface models are loaded (see
+  /// InterfaceModel::SetChildrenFunction). If null, they are collected from
+  /// the element of the model when needed.
+  explicit ModelWrapper(const sdf::Model &_model,
+                        const ReferencedScopes *_scopes = nullptr)
       : WrapperBase{_model.Name(), "Model",
                     _model.Static() ? FrameType::STATIC_MODEL
                                     : FrameType::MODEL},
@@ -434,6 +592,14 @@ struct ModelWrapper : public WrapperBase
         placementFrameName(_model.PlacementFrameName()),
         isStatic(_model.Static())
   {
+    std::optional<ReferencedScopes> ownScopes;
+    if (!_scopes)
+    {
+      ownScopes = referencedScopes(_model.Element(),
+                                   hasLazyInterfaceModels(_model));
+      _scopes = ownScopes ? &*ownScopes : nullptr;
+    }
+
     for (uint64_t i = 0; i < _model.LinkCount(); ++i)
     {
       this->links.emplace_back(*_model.LinkByIndex(i));
@@ -448,12 +614,12 @@ struct ModelWrapper : public WrapperBase
     }
     for (uint64_t i = 0; i < _model.ModelCount(); ++i)
     {
-      this->models.emplace_back(*_model.ModelByIndex(i));
+      this->models.emplace_back(*_model.ModelByIndex(i), _scopes);
     }
     for (uint64_t i = 0; i < _model.InterfaceModelCount(); ++i)
     {
       this->models.emplace_back(*_model.InterfaceModelNestedIncludeByIndex(i),
-                                *_model.InterfaceModelByIndex(i));
+                                *_model.InterfaceModelByIndex(i), _scopes);
     }
     for (const auto &[nestedInclude, model] : _model.MergedInterfaceModels())
     {
@@ -509,8 +675,13 @@ struct ModelWrapper : public WrapperBase
 
   /// \brief Constructor that takes an sdf::NestedInclude and
   /// sdf::InterfaceModel.
+  /// \param[in] _nestedInclude The include of the model.
+  /// \param[in] _ifaceModel Model to wrap.
+  /// \param[in] _scopes Scopes referenced by the document that includes the
+  /// model. If null, the children of the model are loaded.
   explicit ModelWrapper(const NestedInclude &_nestedInclude,
-                        const sdf::InterfaceModel &_ifaceModel)
+                        const sdf::InterfaceModel &_ifaceModel,
+                        const ReferencedScopes *_scopes = nullptr)
       : WrapperBase{_ifaceModel.Name(), "Interface Model",
                     _ifaceModel.Static() ? FrameType::STATIC_MODEL
                                          : FrameType::MODEL},
@@ -522,12 +693,16 @@ struct ModelWrapper : public WrapperBase
         placementFrameName(_nestedInclude.PlacementFrame().value_or("")),
         isStatic(_ifaceModel.Static())
   {
-    this->AddInterfaceChildren(_ifaceModel);
+    this->AddInterfaceChildren(_ifaceModel, _scopes);
   }
 
   /// \brief Constructor that takes an sdf::InterfaceModel. These are
   /// InterfaceModels nested under other InterfaceModels.
-  explicit ModelWrapper(const sdf::InterfaceModel &_ifaceModel)
+  /// \param[in] _ifaceModel Model to wrap.
+  /// \param[in] _scopes Scopes referenced by the document that includes the
+  /// model. If null, the children of the model are loaded.
+  explicit ModelWrapper(const sdf::InterfaceModel &_ifaceModel,
+                        const ReferencedScopes *_scopes = nullptr)
       : WrapperBase{_ifaceModel.Name(), "Interface Model",
                     _ifaceModel.Static() ? FrameType::STATIC_MODEL
                                          : FrameType::MODEL},
@@ -538,7 +713,7 @@ struct ModelWrapper : public WrapperBase
         placementFrameName(""),
         isStatic(_ifaceModel.Static())
   {
-    this->AddInterfaceChildren(_ifaceModel);
+    this->AddInterfaceChildren(_ifaceModel, _scopes);
   }
 
   /// \brief Raw pose of the entity.
@@ -566,24 +741,46 @@ struct ModelWrapper : public WrapperBase
   /// \brief Placement frame information for each merged model.
   std::vector<PlacementFrameInfo> mergedModelPlacements;
 
-  /// \brief Helper function to add children of interface models.
-  private: void AddInterfaceChildren(const sdf::InterfaceModel &_ifaceModel)
-  {
-    for (const auto &item : _ifaceModel.Links())
+  /// \brief Helper function to add children of interface models. The
+  /// children of a model that are not loaded yet are only loaded if the
+  /// model has a reposture function or a placement frame, if its name is
+  /// one of _scopes or if its canonical link is not loaded yet.
+  /// \param[in] _ifaceModel The model.
+  /// \param[in] _scopes Scopes referenced by the document that includes the
+  /// model. If null, the children of the model are loaded.
+  private: void AddInterfaceChildren(const sdf::InterfaceModel &_ifaceModel,
+                                     const ReferencedScopes *_scopes)
+  {
+    const auto &addedLinks = _ifaceModel.AddedLinks();
+    const bool load = _ifaceModel.ChildrenLoaded() || !_scopes ||
+        _ifaceModel.HasRepostureFunction() ||
+        !this->placementFrameName.empty() ||
+        _scopes->count(_ifaceModel.Name()) > 0 ||
+        std::none_of(addedLinks.begin(), addedLinks.end(),
+            [&](const sdf::InterfaceLink &_link)
+            {
+              return _link.Name() == this->canonicalLinkName;
+            });
+    if (load)
+    {
+      _ifaceModel.LoadChildren();
+    }
+
+    for (const auto &item : _ifaceModel.AddedLinks())
     {
       this->links.emplace_back(item);
     }
-    for (const auto &item : _ifaceModel.Frames())
+    for (const auto &item : _ifaceModel.AddedFrames())
     {
       this->frames.emplace_back(item);
     }
-    for (const auto &item : _ifaceModel.Joints())
+    for (const auto &item : _ifaceModel.AddedJoints())
     {
       this->joints.emplace_back(item);
     }
-    for (const auto &item : _ifaceModel.NestedModels())
+    for (const auto &item : _ifaceModel.AddedNestedModels())
     {
-      this->models.emplace_back(*item);
+      this->models.emplace_back(*item, _scopes);
     }
   }
 };
@@ -592,21 +789,56 @@ struct ModelWrapper : public WrapperBase
 struct WorldWrapper : public WrapperBase
 {
   /// \brief Constructor that takes an sdf::World
-  explicit WorldWrapper(const sdf::World &_world)
+  /// \param[in] _world World to wrap.
+  /// \param[in] _threadCount Number of threads used to wrap the models of
+  /// the world. Values of 0 and 1 wrap them serially.
+  /// \param[in] _executor Executor that runs the threads, or nullptr.
+  explicit WorldWrapper(const sdf::World &_world, std::size_t _threadCount = 0,
+                        TaskExecutor *_executor = nullptr)
       : WrapperBase{_world.Name(), "World", FrameType::WORLD}
   {
+    bool hasLazyModels = false;
+    for (uint64_t i = 0; i < _world.ModelCount() && !hasLazyModels; ++i)
+    {
+      hasLazyModels = hasLazyInterfaceModels(*_world.ModelByIndex(i));
+    }
+    for (uint64_t i = 0; i < _world.InterfaceModelCount() && !hasLazyModels;
+         ++i)
+    {
+      hasLazyModels = !_world.InterfaceModelByIndex(i)->ChildrenLoaded();
+    }
+    const auto scopes = referencedScopes(_world.Element(), hasLazyModels);
+    const ReferencedScopes *scopesPtr = scopes ? &*scopes : nullptr;
+
     for (uint64_t i = 0; i < _world.FrameCount(); ++i)
     {
       this->frames.emplace_back(*_world.FrameByIndex(i));
     }
-    for (uint64_t i = 0; i < _world.ModelCount(); ++i)
+    if (_threadCount < 2 || _world.ModelCount() < 2)
     {
-      this->models.emplace_back(*_world.ModelByIndex(i));
+      for (uint64_t i = 0; i < _world.ModelCount(); ++i)
+      {
+        this->models.emplace_back(*_world.ModelByIndex(i), scopesPtr);
+      }
+    }
+    else
+    {
+      std::vector<std::optional<ModelWrapper>> wrapped(_world.ModelCount());
+      forEachIndexConcurrently(wrapped.size(), _threadCount, _executor,
+          [&](std::size_t _index)
+          {
+            wrapped[_index].emplace(*_world.ModelByIndex(_index), scopesPtr);
+          });
+      this->models.reserve(wrapped.size() + _world.InterfaceModelCount());
+      for (auto &model : wrapped)
+      {
+        this->models.push_back(std::move(*model));
+      }
     }
     for (uint64_t i = 0; i < _world.InterfaceModelCount(); ++i)
     {
       this->models.emplace_back(*_world.InterfaceModelNestedIncludeByIndex(i),
-                                *_world.InterfaceModelByIndex(i));
+                                *_world.InterfaceModelByIndex(i), scopesPtr);
     }
   }
 
@@ -736,10 +968,16 @@ void addEdgesToGraph(ScopedGraph<PoseRelativeToGraph> &_out,
     {
       ignition::math::Pose3d resolvedModelPose = item.rawPose;
 
-      sdf::Errors resolveErrors = resolveModelPoseWithPlacementFrame(
-          item.rawPose, item.placementFrameName,
-          _out.ChildModelScope(item.name), resolvedModelPose);
-      _errors.insert(_errors.end(), resolveErrors.begin(), resolveErrors.end());
+      // Only make a scope for the nested model if it has a placement frame
+      // to resolve.
+      if (!item.placementFrameName.empty())
+      {
+        sdf::Errors resolveErrors = resolveModelPoseWithPlacementFrame(
+            item.rawPose, item.placementFrameName,
+            _out.ChildModelScope(item.name), resolvedModelPose);
+        _errors.insert(_errors.end(), resolveErrors.begin(),
+                       resolveErrors.end());
+      }
 
       _out.AddEdge({relativeToId, itemId}, resolvedModelPose);
     }
@@ -957,6 +1195,7 @@ Errors wrapperBuildFrameAttachedToGraph(ScopedGraph<FrameAttachedToGraph> &_out,
 Errors buildFrameAttachedToGraph(
     ScopedGraph<FrameAttachedToGraph> &_out, const Model *_model, bool _isRoot)
 {
+  ScopedTraceEvent event("buildFrameAttachedToGraph", "graph");
   if (!_model)
   {
     return Errors{{ErrorCode::ELEMENT_INVALID, "Invalid sdf::Model pointer."}};
@@ -968,6 +1207,7 @@ Errors buildFrameAttachedToGraph(
 Errors buildFrameAttachedToGraph(ScopedGraph<FrameAttachedToGraph> &_out,
                                  const InterfaceModel *_model)
 {
+  ScopedTraceEvent event("buildFrameAttachedToGraph", "graph");
   if (!_model)
   {
     return Errors{
@@ -977,9 +1217,114 @@ Errors buildFrameAttachedToGraph(ScopedGraph<FrameAttachedToGraph> &_out,
 }
 
 
+/////////////////////////////////////////////////
+Errors wrapperBuildPoseRelativeToGraph(ScopedGraph<PoseRelativeToGraph> &_out,
+                                       const ModelWrapper &_model,
+                                       bool _isRoot);
+
+/////////////////////////////////////////////////
+/// \brief Copy the vertices and edges of a graph that was built on its own
+/// into another graph. The scope vertices of both graphs are merged, and the
+/// other vertices keep their names, so both scopes must have the same prefix.
+/// \tparam GraphT Type of Graph. Either PoseRelativeToGraph or
+/// FrameAttachedToGraph.
+/// \param[in,out] _out The graph to which vertices and edges are added.
+/// \param[in] _in The graph to copy.
+template <typename GraphT>
+void mergeIntoGraph(ScopedGraph<GraphT> &_out, const ScopedGraph<GraphT> &_in)
+{
+  using ignition::math::graph::VertexId;
+
+  std::unordered_map<VertexId, VertexId> ids;
+  ids[_in.ScopeVertexId()] = _out.ScopeVertexId();
+  for (const auto &[id, vertex] : _in.Graph().Vertices())
+  {
+    if (id != _in.ScopeVertexId())
+    {
+      ids[id] = _out.AddVertex(vertex.get().Name(), vertex.get().Data()).Id();
+    }
+  }
+  for (const auto &edgePair : _in.Graph().Edges())
+  {
+    const auto &edge = edgePair.second.get();
+    auto &newEdge = _out.AddEdge(
+        {ids.at(edge.Tail()), ids.at(edge.Head())}, edge.Data());
+    // Keep the weight of aliasing edges.
+    newEdge.SetWeight(edge.Weight());
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Add the vertices of the models of a world to either the Frame
+/// attached to or Pose graph of the world, like addVerticesToGraph. When
+/// more than one thread is used, the graph of each model is built on its own
+/// graph concurrently, and the graphs are then merged into the world graph
+/// in order, so the result and the errors are the same as when building them
+/// serially.
+/// \tparam GraphT Type of Graph. Either PoseRelativeToGraph or
+/// FrameAttachedToGraph.
+/// \param[in,out] _out World scope of the graph.
+/// \param[in] _world The wrapped world.
+/// \param[in] _threadCount Number of threads. Values of 0 and 1 build the
+/// graphs serially.
+/// \param[in] _executor Executor that runs the threads, or nullptr.
+/// \param[out] _errors Errors encountered while adding vertices.
+template <typename GraphT>
+void addModelVerticesToWorldGraph(ScopedGraph<GraphT> &_out,
+                                  const WorldWrapper &_world,
+                                  std::size_t _threadCount,
+                                  TaskExecutor *_executor, Errors &_errors)
+{
+  if (_threadCount < 2 || _world.models.size() < 2)
+  {
+    addVerticesToGraph(_out, _world.models, _world, _errors);
+    return;
+  }
+
+  std::vector<std::optional<ScopedGraph<GraphT>>> modelGraphs(
+      _world.models.size());
+  ErrorSink modelErrors(modelGraphs.size());
+  forEachIndexConcurrently(modelGraphs.size(), _threadCount, _executor,
+      [&](std::size_t _index)
+      {
+        ScopedGraph<GraphT> graph(std::make_shared<GraphT>());
+        graph = graph.AddScopeVertex("", _out.ScopeContextName(),
+            _out.ScopeContextName(), _out.ScopeVertex().Data());
+        if constexpr (std::is_same_v<GraphT, FrameAttachedToGraph>)
+        {
+          modelErrors.TaskErrors(_index) = wrapperBuildFrameAttachedToGraph(
+              graph, _world.models[_index], false);
+        }
+        else
+        {
+          modelErrors.TaskErrors(_index) = wrapperBuildPoseRelativeToGraph(
+              graph, _world.models[_index], false);
+        }
+        modelGraphs[_index] = graph;
+        modelErrors.Finish(_index);
+      });
+
+  for (std::size_t i = 0; i < modelGraphs.size(); ++i)
+  {
+    const auto &model = _world.models[i];
+    if (_out.Count(model.name) > 0)
+    {
+      _errors.emplace_back(ErrorCode::DUPLICATE_NAME, model.elementType +
+          " with non-unique name [" + model.name + "] detected in " +
+          lowercase(_world.elementType) + " with name [" +
+          _world.name + "].");
+      continue;
+    }
+    mergeIntoGraph(_out, *modelGraphs[i]);
+    const Errors &errors = modelErrors.TaskErrors(i);
+    _errors.insert(_errors.end(), errors.begin(), errors.end());
+  }
+}
+
 /////////////////////////////////////////////////
 Errors buildFrameAttachedToGraph(
-            ScopedGraph<FrameAttachedToGraph> &_out, const WorldWrapper &_world)
+            ScopedGraph<FrameAttachedToGraph> &_out, const WorldWrapper &_world,
+            std::size_t _threadCount, TaskExecutor *_executor)
 {
   Errors errors;
 
@@ -989,7 +1334,7 @@ Errors buildFrameAttachedToGraph(
       "", scopeContextName, scopeContextName, sdf::FrameType::WORLD);
 
   // add model vertices
-  addVerticesToGraph(_out, _world.models, _world, errors);
+  addModelVerticesToWorldGraph(_out, _world, _threadCount, _executor, errors);
 
   // add frame vertices
   addVerticesToGraph(_out, _world.frames, _world, errors);
@@ -1002,14 +1347,18 @@ Errors buildFrameAttachedToGraph(
 
 /////////////////////////////////////////////////
 Errors buildFrameAttachedToGraph(
-            ScopedGraph<FrameAttachedToGraph> &_out, const World *_world)
+            ScopedGraph<FrameAttachedToGraph> &_out, const World *_world,
+            std::size_t _threadCount, TaskExecutor *_executor)
 {
+  ScopedTraceEvent event("buildFrameAttachedToGraph", "graph");
   if (!_world)
   {
     return Errors{{ErrorCode::ELEMENT_INVALID, "Invalid sdf::World pointer."}};
   }
 
-  return buildFrameAttachedToGraph(_out, WorldWrapper(*_world));
+  return buildFrameAttachedToGraph(
+      _out, WorldWrapper(*_world, _threadCount, _executor), _threadCount,
+      _executor);
 }
 
 /////////////////////////////////////////////////
@@ -1120,6 +1469,7 @@ Errors wrapperBuildPoseRelativeToGraph(ScopedGraph<PoseRelativeToGraph> &_out,
 Errors buildPoseRelativeToGraph(
     ScopedGraph<PoseRelativeToGraph> &_out, const Model *_model, bool _isRoot)
 {
+  ScopedTraceEvent event("buildPoseRelativeToGraph", "graph");
   if (!_model)
   {
     return Errors{{ErrorCode::ELEMENT_INVALID, "Invalid sdf::Model pointer."}};
@@ -1132,6 +1482,7 @@ Errors buildPoseRelativeToGraph(
 Errors buildPoseRelativeToGraph(ScopedGraph<PoseRelativeToGraph> &_out,
                                 const InterfaceModel *_model)
 {
+  ScopedTraceEvent event("buildPoseRelativeToGraph", "graph");
   if (!_model)
   {
     return Errors{
@@ -1142,7 +1493,8 @@ Errors buildPoseRelativeToGraph(ScopedGraph<PoseRelativeToGraph> &_out,
 
 /////////////////////////////////////////////////
 Errors wrapperBuildPoseRelativeToGraph(
-    ScopedGraph<PoseRelativeToGraph> &_out, const WorldWrapper &_world)
+    ScopedGraph<PoseRelativeToGraph> &_out, const WorldWrapper &_world,
+    std::size_t _threadCount, TaskExecutor *_executor)
 {
   Errors errors;
 
@@ -1159,7 +1511,7 @@ Errors wrapperBuildPoseRelativeToGraph(
 
   _out.AddEdge({rootId, worldFrameId}, {});
   // add model vertices
-  addVerticesToGraph(_out, _world.models, _world, errors);
+  addModelVerticesToWorldGraph(_out, _world, _threadCount, _executor, errors);
 
   // add frame vertices
   addVerticesToGraph(_out, _world.frames, _world, errors);
@@ -1177,20 +1529,156 @@ Errors wrapperBuildPoseRelativeToGraph(
 
 /////////////////////////////////////////////////
 Errors buildPoseRelativeToGraph(
-    ScopedGraph<PoseRelativeToGraph> &_out, const World *_world)
+    ScopedGraph<PoseRelativeToGraph> &_out, const World *_world,
+    std::size_t _threadCount, TaskExecutor *_executor)
 {
+  ScopedTraceEvent event("buildPoseRelativeToGraph", "graph");
   if (!_world)
   {
     return Errors{{ErrorCode::ELEMENT_INVALID, "Invalid sdf::World pointer."}};
   }
 
-  return wrapperBuildPoseRelativeToGraph(_out, WorldWrapper(*_world));
+  return wrapperBuildPoseRelativeToGraph(
+      _out, WorldWrapper(*_world, _threadCount, _executor), _threadCount,
+      _executor);
+}
+
+/////////////////////////////////////////////////
+/// \brief Helper function that adds a model to the graph of a world.
+/// \tparam GraphT Type of Graph. Either PoseRelativeToGraph or
+/// FrameAttachedToGraph.
+/// \param[in,out] _out World scope of the graph to extend.
+/// \param[in] _world World that contains the model.
+/// \param[in] _model Model to add to the graph.
+/// \return Errors.
+template <typename GraphT>
+Errors wrapperAddModelToWorldGraph(ScopedGraph<GraphT> &_out,
+                                   const World *_world, const Model *_model)
+{
+  if (!_world)
+  {
+    return Errors{{ErrorCode::ELEMENT_INVALID, "Invalid sdf::World pointer."}};
+  }
+  if (!_model)
+  {
+    return Errors{{ErrorCode::ELEMENT_INVALID, "Invalid sdf::Model pointer."}};
+  }
+
+  Errors errors;
+
+  // Only the name of the world is needed for error messages, so the rest of
+  // the world is not wrapped.
+  const WrapperBase world{_world->Name(), "World", FrameType::WORLD};
+  // References from the rest of the world may use the scopes of the
+  // interface models of the model.
+  const auto scopes = referencedScopes(_world->Element(),
+                                       hasLazyInterfaceModels(*_model));
+  std::vector<ModelWrapper> models;
+  models.emplace_back(*_model, scopes ? &*scopes : nullptr);
+
+  addVerticesToGraph(_out, models, world, errors);
+  if constexpr (std::is_same_v<GraphT, PoseRelativeToGraph>)
+  {
+    addEdgesToGraph(_out, models, world, errors);
+  }
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+Errors addModelToWorldGraph(ScopedGraph<FrameAttachedToGraph> &_out,
+                            const World *_world, const Model *_model)
+{
+  return wrapperAddModelToWorldGraph(_out, _world, _model);
+}
+
+/////////////////////////////////////////////////
+Errors addModelToWorldGraph(ScopedGraph<PoseRelativeToGraph> &_out,
+                            const World *_world, const Model *_model)
+{
+  return wrapperAddModelToWorldGraph(_out, _world, _model);
+}
+
+/////////////////////////////////////////////////
+/// \brief Helper function that removes a model from the graph of a world.
+/// \tparam GraphT Type of Graph. Either PoseRelativeToGraph or
+/// FrameAttachedToGraph.
+/// \param[in,out] _out World scope of the graph.
+/// \param[in] _modelName Name of the model to remove.
+/// \return False if vertices outside the model depend on it.
+template <typename GraphT>
+bool wrapperRemoveModelFromWorldGraph(ScopedGraph<GraphT> &_out,
+                                      const std::string &_modelName)
+{
+  using ignition::math::graph::VertexId;
+
+  const VertexId modelId = _out.VertexIdByName(_modelName);
+  if (ignition::math::graph::kNullId == modelId)
+    return true;
+
+  // The vertices of nested entities are named <model_name>::<name>, so they
+  // are found next to each other in the sorted map.
+  std::set<VertexId> modelIds{modelId};
+  const std::string prefix =
+      _out.Graph().VertexFromId(modelId).Name() + kSdfScopeDelimiter;
+  const auto &map = _out.Map();
+  for (auto it = map.lower_bound(prefix);
+       it != map.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+       ++it)
+  {
+    modelIds.insert(it->second);
+  }
+
+  // Edges point from a frame to the frame it is attached to in the
+  // FrameAttachedTo graph, and from the relative_to frame to the frame in the
+  // PoseRelativeTo graph. In both cases a vertex outside the model that
+  // depends on it would be left dangling.
+  for (const auto &id : modelIds)
+  {
+    if constexpr (std::is_same_v<GraphT, FrameAttachedToGraph>)
+    {
+      for (const auto &edgePair : _out.Graph().IncidentsTo(id))
+      {
+        if (modelIds.count(edgePair.second.get().Tail()) == 0)
+          return false;
+      }
+    }
+    else
+    {
+      for (const auto &edgePair : _out.Graph().IncidentsFrom(id))
+      {
+        if (modelIds.count(edgePair.second.get().Head()) == 0)
+          return false;
+      }
+    }
+  }
+
+  for (const auto &id : modelIds)
+  {
+    _out.RemoveVertex(id);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool removeModelFromWorldGraph(ScopedGraph<FrameAttachedToGraph> &_out,
+                               const std::string &_modelName)
+{
+  return wrapperRemoveModelFromWorldGraph(_out, _modelName);
+}
+
+/////////////////////////////////////////////////
+bool removeModelFromWorldGraph(ScopedGraph<PoseRelativeToGraph> &_out,
+                               const std::string &_modelName)
+{
+  return wrapperRemoveModelFromWorldGraph(_out, _modelName);
 }
 
 /////////////////////////////////////////////////
 Errors validateFrameAttachedToGraph(
     const ScopedGraph<FrameAttachedToGraph> &_in)
 {
+  ScopedTraceEvent event("validateFrameAttachedToGraph", "graph");
   Errors errors;
 
   // Check if scope points to a valid graph
@@ -1425,6 +1913,7 @@ Errors validateFrameAttachedToGraph(
 Errors validatePoseRelativeToGraph(
     const ScopedGraph<PoseRelativeToGraph> &_in)
 {
+  ScopedTraceEvent event("validatePoseRelativeToGraph", "graph");
   Errors errors;
 
   // Check if scope points to a valid graph
@@ -1603,11 +2092,23 @@ Errors validatePoseRelativeToGraph(
     }
   }
 
-  // check graph for cycles by resolving pose of each vertex relative to root
+  // Resolve the poses of all the vertices that are reachable from the scope
+  // vertex in one traversal. Walking from each vertex back to the scope
+  // vertex would take time proportional to the nesting depth of the models
+  // for every vertex.
+  std::unordered_map<ignition::math::graph::VertexId, ignition::math::Pose3d>
+      resolvedPoses;
+  resolvePosesRelativeToRoot(resolvedPoses, _in);
+
+  // check graph for cycles by resolving pose of each vertex relative to root.
+  // Only the vertices that were not reached above can have errors.
   for (auto const &name : _in.VertexNames())
   {
-    if (name == "__root__")
+    if (name == "__root__" ||
+        resolvedPoses.count(_in.VertexIdByName(name)) > 0)
+    {
       continue;
+    }
     ignition::math::Pose3d pose;
     Errors e = resolvePoseRelativeToRoot(pose, _in, name);
     errors.insert(errors.end(), e.begin(), e.end());
@@ -1633,6 +2134,14 @@ Errors resolveFrameAttachedToBody(
     return errors;
   }
 
+  // DOM objects resolve the same frames whenever they are asked to, so the
+  // bodies are stored until the graph is modified.
+  if (auto cached = _in.ResolvedBody(_vertexName))
+  {
+    _attachedToBody = *cached;
+    return errors;
+  }
+
   if (_in.Count(_vertexName) != 1)
   {
     errors.push_back({ErrorCode::FRAME_ATTACHED_TO_INVALID,
@@ -1642,8 +2151,12 @@ Errors resolveFrameAttachedToBody(
   }
   auto vertexId = _in.VertexIdByName(_vertexName);
 
-  auto sinkVertexEdges = FindSinkVertex(_in, vertexId, errors);
-  auto sinkVertex = sinkVertexEdges.first;
+  // Look up the sink vertex precomputed when the graph was frozen first, and
+  // only traverse the graph itself to report errors.
+  const auto sinkId = _in.SinkVertexId(vertexId);
+  const auto &sinkVertex = ignition::math::graph::kNullId != sinkId ?
+      _in.Graph().VertexFromId(sinkId) :
+      FindSinkVertex(_in, vertexId, errors).first;
 
   if (!errors.empty())
   {
@@ -1694,6 +2207,7 @@ Errors resolveFrameAttachedToBody(
   }
 
   _attachedToBody = _in.VertexLocalName(sinkVertex);
+  _in.SetResolvedBody(_vertexName, _attachedToBody);
 
   return errors;
 }
@@ -1725,6 +2239,21 @@ Errors resolvePoseRelativeToRoot(
 {
   Errors errors;
 
+  if (auto cached = _graph.ResolvedPose(_vertexId))
+  {
+    _pose = *cached;
+    return errors;
+  }
+
+  countPerf(PerfCounter::POSE_GRAPH_WALKS);
+  ignition::math::Pose3d pose;
+  if (flatPoseRelativeToRoot(pose, _graph, _vertexId))
+  {
+    _pose = pose;
+    _graph.SetResolvedPose(_vertexId, pose);
+    return errors;
+  }
+
   auto incomingVertexEdges = FindSourceVertex(_graph, _vertexId, errors);
 
   if (!errors.empty())
@@ -1749,7 +2278,6 @@ Errors resolvePoseRelativeToRoot(
     return errors;
   }
 
-  ignition::math::Pose3d pose;
   for (auto const &edge : incomingVertexEdges.second)
   {
     pose = edge.Data() * pose;
@@ -1758,11 +2286,84 @@ Errors resolvePoseRelativeToRoot(
   if (errors.empty())
   {
     _pose = pose;
+    _graph.SetResolvedPose(_vertexId, pose);
   }
 
   return errors;
 }
 
+/////////////////////////////////////////////////
+void resolvePosesRelativeToRoot(
+    std::unordered_map<ignition::math::graph::VertexId,
+                       ignition::math::Pose3d> &_poses,
+    const ScopedGraph<PoseRelativeToGraph> &_graph)
+{
+  _poses.clear();
+  if (!_graph)
+    return;
+
+  // Every vertex is visited, so a flat copy is worth building if the graph
+  // was not frozen.
+  FlatGraph<ignition::math::Pose3d> localFlat;
+  const auto *frozenFlat = _graph.Flat();
+  if (nullptr == frozenFlat)
+    localFlat.Build(_graph.Graph(), 0);
+  const auto &flat = nullptr != frozenFlat ? *frozenFlat : localFlat;
+
+  const auto scopeId = _graph.ScopeVertexId();
+  if (!flat.Valid(scopeId))
+    return;
+
+  // Breadth first traversal from the scope vertex along outgoing edges,
+  // one level at a time. The edges that leave a level are composed with the
+  // poses of the vertices they come from in one batch.
+  std::vector<ignition::math::graph::VertexId> level = {scopeId};
+  std::vector<ignition::math::graph::VertexId> nextLevel;
+  PoseBatch levelPoses;
+  levelPoses.Push(ignition::math::Pose3d::Zero);
+  PoseBatch parentPoses;
+  PoseBatch childPoses;
+  _poses[scopeId] = ignition::math::Pose3d::Zero;
+  while (!level.empty())
+  {
+    nextLevel.clear();
+    parentPoses.Clear();
+    childPoses.Clear();
+    for (std::size_t i = 0; i < level.size(); ++i)
+    {
+      for (std::size_t c = 0; c < flat.OutDegree(level[i]); ++c)
+      {
+        auto childId = flat.Child(level[i], c);
+        if (childId == scopeId || _poses.count(childId) > 0 ||
+            flat.InDegree(childId) != 1)
+        {
+          continue;
+        }
+        // Vertices with one incoming edge are only reached once.
+        _poses[childId] = ignition::math::Pose3d::Zero;
+        nextLevel.push_back(childId);
+        parentPoses.Push(levelPoses.Pose(i));
+        childPoses.Push(flat.ChildEdge(level[i], c));
+      }
+    }
+
+    PoseBatch::Compose(parentPoses, childPoses, levelPoses);
+    for (std::size_t i = 0; i < nextLevel.size(); ++i)
+      _poses[nextLevel[i]] = levelPoses.Pose(i);
+    level.swap(nextLevel);
+  }
+}
+
+/////////////////////////////////////////////////
+void storeResolvedPoses(const ScopedGraph<PoseRelativeToGraph> &_graph)
+{
+  std::unordered_map<ignition::math::graph::VertexId, ignition::math::Pose3d>
+      poses;
+  resolvePosesRelativeToRoot(poses, _graph);
+  for (const auto &[id, pose] : poses)
+    _graph.SetResolvedPose(id, pose);
+}
+
 /////////////////////////////////////////////////
 Errors resolvePose(ignition::math::Pose3d &_pose,
     const ScopedGraph<PoseRelativeToGraph> &_graph,
@@ -1796,6 +2397,12 @@ Errors resolvePose(
     const std::string &_resolveTo)
 {
   Errors errors;
+  if (auto cached = _graph.ResolvedRelativePose(_frameName, _resolveTo))
+  {
+    _pose = *cached;
+    return errors;
+  }
+
   if (_graph.Count(_frameName) != 1)
   {
     errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
@@ -1811,8 +2418,55 @@ Errors resolvePose(
     return errors;
   }
 
-  return resolvePose(_pose, _graph, _graph.VertexIdByName(_frameName),
+  ignition::math::Pose3d pose;
+  errors = resolvePose(pose, _graph, _graph.VertexIdByName(_frameName),
       _graph.VertexIdByName(_resolveTo));
+  if (errors.empty())
+  {
+    _pose = pose;
+    _graph.SetResolvedRelativePose(_frameName, _resolveTo, pose);
+  }
+  return errors;
+}
+
+/////////////////////////////////////////////////
+Errors resolveSemanticPose(
+    ignition::math::Pose3d &_pose,
+    const ScopedGraph<PoseRelativeToGraph> &_graph,
+    const std::string &_name,
+    const ignition::math::Pose3d &_rawPose,
+    const std::string &_relativeTo,
+    const std::string &_defaultResolveTo,
+    const std::string &_resolveTo)
+{
+  Errors errors;
+  if (!_graph)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "SemanticPose has invalid pointer to PoseRelativeToGraph."});
+    return errors;
+  }
+
+  const std::string &resolveTo =
+      _resolveTo.empty() ? _defaultResolveTo : _resolveTo;
+
+  ignition::math::Pose3d pose;
+  if (_name.empty())
+  {
+    errors = resolvePose(pose, _graph,
+        _relativeTo.empty() ? _defaultResolveTo : _relativeTo, resolveTo);
+    pose *= _rawPose;
+  }
+  else
+  {
+    errors = resolvePose(pose, _graph, _name, resolveTo);
+  }
+
+  if (errors.empty())
+  {
+    _pose = pose;
+  }
+  return errors;
 }
 }
 }
@@ -19,7 +19,9 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/graph/Graph.hh>
@@ -27,6 +29,7 @@
 #include "sdf/Error.hh"
 #include "sdf/InterfaceModel.hh"
 #include "sdf/Types.hh"
+#include "FlatGraph.hh"
 
 /// \ingroup sdf_frame_semantics
 /// \brief namespace for Simulation Description Format Frame Semantics Utilities
@@ -46,6 +49,7 @@ namespace sdf
   //
   // Forward declaration.
   class Model;
+  class TaskExecutor;
   class World;
   template <typename T> class ScopedGraph;
 
@@ -88,6 +92,16 @@ namespace sdf
 
     /// \brief Name of scope vertex, either __model__ or world.
     std::string scopeName;
+
+    /// \brief Number of times the graph was modified through a ScopedGraph.
+    std::size_t revision = 0;
+
+    /// \brief Flat copy of the graph used to resolve attached-to bodies.
+    FlatGraph<bool> flat;
+
+    /// \brief Revision at which the resolved bodies of the scopes of the
+    /// graph were made read-only by ScopedGraph::Seal, if any.
+    std::optional<std::size_t> sealedRevision;
   };
 
   /// \brief Data structure for pose relative_to graphs for Model or World.
@@ -108,6 +122,18 @@ namespace sdf
 
     /// \brief Name of source vertex, either __model__ or world.
     std::string sourceName;
+
+    /// \brief Number of times the graph was modified through a ScopedGraph.
+    /// Poses cached by resolvePoseRelativeToRoot are discarded when it
+    /// changes.
+    std::size_t revision = 0;
+
+    /// \brief Flat copy of the graph used to resolve poses.
+    FlatGraph<Pose3d> flat;
+
+    /// \brief Revision at which the resolved poses of the scopes of the
+    /// graph were made read-only by ScopedGraph::Seal, if any.
+    std::optional<std::size_t> sealedRevision;
   };
 
   /// \brief Build a FrameAttachedToGraph for a model.
@@ -129,9 +155,15 @@ namespace sdf
   /// \brief Build a FrameAttachedToGraph for a world.
   /// \param[out] _out Graph object to write.
   /// \param[in] _world World from which to build attached_to graph.
+  /// \param[in] _threadCount Number of threads used to build the graphs of
+  /// the models of the world. Values of 0 and 1 build them serially.
+  /// \param[in] _executor Executor that runs the threads, or nullptr for
+  /// TaskExecutor::Threaded.
   /// \return Errors.
   Errors buildFrameAttachedToGraph(
-              ScopedGraph<FrameAttachedToGraph> &_out, const World *_world);
+              ScopedGraph<FrameAttachedToGraph> &_out, const World *_world,
+              std::size_t _threadCount = 0,
+              TaskExecutor *_executor = nullptr);
 
   /// \brief Build a PoseRelativeToGraph for a model.
   /// \param[out] _out Graph object to write.
@@ -152,9 +184,55 @@ namespace sdf
   /// \brief Build a PoseRelativeToGraph for a world.
   /// \param[out] _out Graph object to write.
   /// \param[in] _world World from which to build attached_to graph.
+  /// \param[in] _threadCount Number of threads used to build the graphs of
+  /// the models of the world. Values of 0 and 1 build them serially.
+  /// \param[in] _executor Executor that runs the threads, or nullptr for
+  /// TaskExecutor::Threaded.
   /// \return Errors.
   Errors buildPoseRelativeToGraph(
-              ScopedGraph<PoseRelativeToGraph> &_out, const World *_world);
+              ScopedGraph<PoseRelativeToGraph> &_out, const World *_world,
+              std::size_t _threadCount = 0,
+              TaskExecutor *_executor = nullptr);
+
+  /// \brief Add a model of a world to the FrameAttachedToGraph of the world,
+  /// without rebuilding the rest of the graph. The model must not already be
+  /// in the graph.
+  /// \param[in,out] _out World scope of the graph to extend.
+  /// \param[in] _world World that contains the model.
+  /// \param[in] _model Model to add to the graph.
+  /// \return Errors.
+  Errors addModelToWorldGraph(ScopedGraph<FrameAttachedToGraph> &_out,
+              const World *_world, const Model *_model);
+
+  /// \brief Add a model of a world to the PoseRelativeToGraph of the world,
+  /// without rebuilding the rest of the graph. The model must not already be
+  /// in the graph.
+  /// \param[in,out] _out World scope of the graph to extend.
+  /// \param[in] _world World that contains the model.
+  /// \param[in] _model Model to add to the graph.
+  /// \return Errors.
+  Errors addModelToWorldGraph(ScopedGraph<PoseRelativeToGraph> &_out,
+              const World *_world, const Model *_model);
+
+  /// \brief Remove a model, and everything nested in it, from the
+  /// FrameAttachedToGraph of a world.
+  /// \param[in,out] _out World scope of the graph.
+  /// \param[in] _modelName Name of the model to remove.
+  /// \return False if frames outside the model are attached to it, in which
+  /// case the graph is not modified. True otherwise, including when the model
+  /// is not in the graph.
+  bool removeModelFromWorldGraph(ScopedGraph<FrameAttachedToGraph> &_out,
+              const std::string &_modelName);
+
+  /// \brief Remove a model, and everything nested in it, from the
+  /// PoseRelativeToGraph of a world.
+  /// \param[in,out] _out World scope of the graph.
+  /// \param[in] _modelName Name of the model to remove.
+  /// \return False if the poses of frames outside the model are relative to
+  /// it, in which case the graph is not modified. True otherwise, including
+  /// when the model is not in the graph.
+  bool removeModelFromWorldGraph(ScopedGraph<PoseRelativeToGraph> &_out,
+              const std::string &_modelName);
 
   /// \brief Confirm that FrameAttachedToGraph is valid by checking the number
   /// of outbound edges for each vertex and checking for graph cycles.
@@ -207,6 +285,26 @@ namespace sdf
       const ScopedGraph<PoseRelativeToGraph> &_graph,
       const ignition::math::graph::VertexId &_vertexId);
 
+  /// \brief Resolve the pose of every vertex relative to the scope vertex of
+  /// the graph with a single traversal, instead of walking the edges that
+  /// lead to each vertex separately. Vertices that resolvePoseRelativeToRoot
+  /// would report an error for, such as vertices with multiple incoming edges
+  /// and their descendants, are left out.
+  /// \param[out] _poses Pose relative to the scope vertex of every vertex
+  /// that can be resolved, keyed by vertex ID.
+  /// \param[in] _graph PoseRelativeToGraph to read from.
+  void resolvePosesRelativeToRoot(
+      std::unordered_map<ignition::math::graph::VertexId,
+                         ignition::math::Pose3d> &_poses,
+      const ScopedGraph<PoseRelativeToGraph> &_graph);
+
+  /// \brief Resolve the pose of every vertex relative to the scope vertex
+  /// of the graph with resolvePosesRelativeToRoot, and store the poses with
+  /// ScopedGraph::SetResolvedPose so that resolvePoseRelativeToRoot does
+  /// not walk the graph for them.
+  /// \param[in] _graph PoseRelativeToGraph to resolve the poses of.
+  void storeResolvedPoses(const ScopedGraph<PoseRelativeToGraph> &_graph);
+
   /// \brief Resolve pose of a frame relative to named frame.
   /// \param[out] _pose Pose object to write.
   /// \param[in] _graph PoseRelativeToGraph to read from.
@@ -233,6 +331,31 @@ namespace sdf
       const ScopedGraph<PoseRelativeToGraph> &_graph,
       const ignition::math::graph::VertexId &_frameVertexId,
       const ignition::math::graph::VertexId &_resolveToVertexId);
+
+  /// \brief Resolve the pose of a DOM object the way SemanticPose::Resolve
+  /// does, from the members of the object, without constructing a
+  /// SemanticPose and copying them into it.
+  /// \param[out] _pose Pose object to write. It is not modified if there are
+  /// errors.
+  /// \param[in] _graph PoseRelativeToGraph of the scope of the object.
+  /// \param[in] _name Name of the frame of the object in the graph, or an
+  /// empty string for objects that are not frames, such as visuals.
+  /// \param[in] _rawPose Raw pose of an object that is not a frame.
+  /// \param[in] _relativeTo Name of the frame that the raw pose of an object
+  /// that is not a frame is relative to, or an empty string for
+  /// _defaultResolveTo.
+  /// \param[in] _defaultResolveTo Default frame to resolve to.
+  /// \param[in] _resolveTo Frame to resolve to, or an empty string for
+  /// _defaultResolveTo.
+  /// \return Errors.
+  Errors resolveSemanticPose(
+      ignition::math::Pose3d &_pose,
+      const ScopedGraph<PoseRelativeToGraph> &_graph,
+      const std::string &_name,
+      const ignition::math::Pose3d &_rawPose,
+      const std::string &_relativeTo,
+      const std::string &_defaultResolveTo,
+      const std::string &_resolveTo);
   }
 }
 #endif
@@ -15,6 +15,7 @@
  *
  */
 
+#include <memory>
 #include <sstream>
 #include <string>
 
@@ -100,6 +101,19 @@ TEST(FrameSemantics, buildFrameAttachedToGraph_Model)
       errors[0].Message().find(
         "FrameAttachedToGraph unable to find unique frame with name ["
         "invalid] in graph."));
+
+  // Bodies are looked up in a table once the graph is frozen.
+  EXPECT_EQ(ignition::math::graph::kNullId,
+            graph.SinkVertexId(graph.VertexIdByName("F2")));
+  graph.Freeze();
+  for (const std::string name : {"L", "__model__", "F00", "F0", "F1", "F2"})
+  {
+    EXPECT_EQ(graph.VertexIdByName("L"),
+              graph.SinkVertexId(graph.VertexIdByName(name))) << name;
+    EXPECT_TRUE(
+      sdf::resolveFrameAttachedToBody(resolvedBody, graph, name).empty());
+    EXPECT_EQ("L", resolvedBody);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -297,6 +311,183 @@ TEST(FrameSemantics, buildPoseRelativeToGraph)
         "invalid] in graph."));
 }
 
+/////////////////////////////////////////////////
+TEST(FrameSemantics, ResolvedPoseCache)
+{
+  using ignition::math::Pose3d;
+  auto ownedGraph = std::make_shared<sdf::PoseRelativeToGraph>();
+  sdf::ScopedGraph<sdf::PoseRelativeToGraph> graph(ownedGraph);
+  graph = graph.AddScopeVertex(
+      "", "__model__", "__model__", sdf::FrameType::MODEL);
+  const auto rootId = graph.ScopeVertexId();
+  const auto aId = graph.AddVertex("A", sdf::FrameType::FRAME).Id();
+  const auto bId = graph.AddVertex("B", sdf::FrameType::FRAME).Id();
+  auto &edgeA = graph.AddEdge({rootId, aId}, Pose3d(1, 0, 0, 0, 0, 0));
+  graph.AddEdge({aId, bId}, Pose3d(0, 1, 0, 0, 0, 0));
+
+  EXPECT_FALSE(graph.ResolvedPose(bId).has_value());
+
+  Pose3d pose;
+  EXPECT_TRUE(sdf::resolvePoseRelativeToRoot(pose, graph, bId).empty());
+  EXPECT_EQ(Pose3d(1, 1, 0, 0, 0, 0), pose);
+  ASSERT_TRUE(graph.ResolvedPose(bId).has_value());
+  EXPECT_EQ(Pose3d(1, 1, 0, 0, 0, 0), graph.ResolvedPose(bId).value());
+
+  // Changing an edge discards the resolved poses.
+  graph.UpdateEdge(edgeA, Pose3d(2, 0, 0, 0, 0, 0));
+  EXPECT_FALSE(graph.ResolvedPose(bId).has_value());
+
+  EXPECT_TRUE(sdf::resolvePoseRelativeToRoot(pose, graph, bId).empty());
+  EXPECT_EQ(Pose3d(2, 1, 0, 0, 0, 0), pose);
+  ASSERT_TRUE(graph.ResolvedPose(bId).has_value());
+  EXPECT_EQ(Pose3d(2, 1, 0, 0, 0, 0), graph.ResolvedPose(bId).value());
+}
+
+/////////////////////////////////////////////////
+TEST(FrameSemantics, ResolvedBodyAndRelativePoseCache)
+{
+  using ignition::math::Pose3d;
+  auto ownedAttachedToGraph = std::make_shared<sdf::FrameAttachedToGraph>();
+  sdf::ScopedGraph<sdf::FrameAttachedToGraph> attachedToGraph(
+      ownedAttachedToGraph);
+  attachedToGraph = attachedToGraph.AddScopeVertex(
+      "", "__model__", "__model__", sdf::FrameType::MODEL);
+  const auto linkId =
+      attachedToGraph.AddVertex("L", sdf::FrameType::LINK).Id();
+  const auto frameId =
+      attachedToGraph.AddVertex("F", sdf::FrameType::FRAME).Id();
+  attachedToGraph.AddEdge({attachedToGraph.ScopeVertexId(), linkId}, true);
+  attachedToGraph.AddEdge({frameId, linkId}, true);
+
+  EXPECT_FALSE(attachedToGraph.ResolvedBody("F").has_value());
+  std::string body;
+  EXPECT_TRUE(
+      sdf::resolveFrameAttachedToBody(body, attachedToGraph, "F").empty());
+  EXPECT_EQ("L", body);
+  ASSERT_TRUE(attachedToGraph.ResolvedBody("F").has_value());
+  EXPECT_EQ("L", attachedToGraph.ResolvedBody("F").value());
+
+  // Frames that cannot be resolved are not stored.
+  EXPECT_FALSE(sdf::resolveFrameAttachedToBody(
+      body, attachedToGraph, "invalid").empty());
+  EXPECT_FALSE(attachedToGraph.ResolvedBody("invalid").has_value());
+
+  // Modifying the graph discards the resolved bodies.
+  attachedToGraph.AddVertex("F2", sdf::FrameType::FRAME);
+  EXPECT_FALSE(attachedToGraph.ResolvedBody("F").has_value());
+
+  auto ownedGraph = std::make_shared<sdf::PoseRelativeToGraph>();
+  sdf::ScopedGraph<sdf::PoseRelativeToGraph> graph(ownedGraph);
+  graph = graph.AddScopeVertex(
+      "", "__model__", "__model__", sdf::FrameType::MODEL);
+  const auto rootId = graph.ScopeVertexId();
+  const auto aId = graph.AddVertex("A", sdf::FrameType::FRAME).Id();
+  const auto bId = graph.AddVertex("B", sdf::FrameType::FRAME).Id();
+  auto &edgeA = graph.AddEdge({rootId, aId}, Pose3d(1, 0, 0, 0, 0, 0));
+  graph.AddEdge({rootId, bId}, Pose3d(0, 1, 0, 0, 0, 0));
+
+  Pose3d pose;
+  EXPECT_TRUE(sdf::resolvePose(pose, graph, "A", "B").empty());
+  EXPECT_EQ(Pose3d(1, -1, 0, 0, 0, 0), pose);
+  ASSERT_TRUE(graph.ResolvedRelativePose("A", "B").has_value());
+  EXPECT_EQ(Pose3d(1, -1, 0, 0, 0, 0),
+            graph.ResolvedRelativePose("A", "B").value());
+  EXPECT_FALSE(graph.ResolvedRelativePose("B", "A").has_value());
+
+  graph.UpdateEdge(edgeA, Pose3d(2, 0, 0, 0, 0, 0));
+  EXPECT_FALSE(graph.ResolvedRelativePose("A", "B").has_value());
+  EXPECT_TRUE(sdf::resolvePose(pose, graph, "A", "B").empty());
+  EXPECT_EQ(Pose3d(2, -1, 0, 0, 0, 0), pose);
+}
+
+/////////////////////////////////////////////////
+TEST(FrameSemantics, FlatGraph)
+{
+  using ignition::math::Pose3d;
+  auto ownedGraph = std::make_shared<sdf::PoseRelativeToGraph>();
+  sdf::ScopedGraph<sdf::PoseRelativeToGraph> graph(ownedGraph);
+  graph = graph.AddScopeVertex(
+      "", "__model__", "__model__", sdf::FrameType::MODEL);
+  const auto rootId = graph.ScopeVertexId();
+  const auto aId = graph.AddVertex("A", sdf::FrameType::FRAME).Id();
+  const auto bId = graph.AddVertex("B", sdf::FrameType::FRAME).Id();
+  const auto cId = graph.AddVertex("C", sdf::FrameType::FRAME).Id();
+  auto &edgeA = graph.AddEdge({rootId, aId}, Pose3d(1, 0, 0, 0, 0, 0));
+  graph.AddEdge({aId, bId}, Pose3d(0, 1, 0, 0, 0, 0));
+  graph.AddEdge({aId, cId}, Pose3d(0, 0, 1, 0, 0, 0));
+
+  EXPECT_EQ(nullptr, graph.Flat());
+  graph.Freeze();
+  const auto *flat = graph.Flat();
+  ASSERT_NE(nullptr, flat);
+
+  EXPECT_TRUE(flat->Valid(bId));
+  EXPECT_FALSE(flat->Valid(cId + 1));
+  EXPECT_EQ(0u, flat->InDegree(rootId));
+  EXPECT_EQ(1u, flat->InDegree(bId));
+  EXPECT_EQ(aId, flat->Parent(bId));
+  EXPECT_EQ(Pose3d(0, 1, 0, 0, 0, 0), flat->ParentEdge(bId));
+  ASSERT_EQ(2u, flat->OutDegree(aId));
+  EXPECT_EQ(0u, flat->OutDegree(bId));
+  for (std::size_t i = 0; i < flat->OutDegree(aId); ++i)
+  {
+    const auto child = flat->Child(aId, i);
+    EXPECT_TRUE(child == bId || child == cId);
+    EXPECT_EQ(flat->ParentEdge(child), flat->ChildEdge(aId, i));
+  }
+
+  Pose3d pose;
+  EXPECT_TRUE(sdf::resolvePoseRelativeToRoot(pose, graph, cId).empty());
+  EXPECT_EQ(Pose3d(1, 0, 1, 0, 0, 0), pose);
+
+  // Modifying the graph discards the flat copy, and poses are resolved from
+  // the graph itself.
+  graph.UpdateEdge(edgeA, Pose3d(2, 0, 0, 0, 0, 0));
+  EXPECT_EQ(nullptr, graph.Flat());
+  EXPECT_TRUE(sdf::resolvePoseRelativeToRoot(pose, graph, cId).empty());
+  EXPECT_EQ(Pose3d(2, 0, 1, 0, 0, 0), pose);
+
+  // Errors are still reported when the graph is frozen.
+  const auto dId = graph.AddVertex("D", sdf::FrameType::FRAME).Id();
+  graph.Freeze();
+  EXPECT_FALSE(sdf::resolvePoseRelativeToRoot(pose, graph, dId).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(FrameSemantics, FrozenScopeLookups)
+{
+  auto ownedGraph = std::make_shared<sdf::PoseRelativeToGraph>();
+  sdf::ScopedGraph<sdf::PoseRelativeToGraph> graph(ownedGraph);
+  auto modelGraph = graph.AddScopeVertex(
+      "M", "__model__", "__model__", sdf::FrameType::MODEL);
+  modelGraph.AddVertex("L", sdf::FrameType::LINK);
+  auto nestedGraph = modelGraph.AddScopeVertex(
+      "N", "__model__", "__model__", sdf::FrameType::MODEL);
+  nestedGraph.AddVertex("L", sdf::FrameType::LINK);
+  auto otherGraph = graph.AddScopeVertex(
+      "M2", "__model__", "__model__", sdf::FrameType::MODEL);
+  otherGraph.AddVertex("X", sdf::FrameType::LINK);
+
+  // Names are looked up relative to the scope once the graph is frozen.
+  graph.Freeze();
+  auto scope = graph.ChildModelScope("M");
+  EXPECT_EQ(ownedGraph->map.at("M::__model__"), scope.ScopeVertexId());
+  EXPECT_EQ(1u, scope.Count("L"));
+  EXPECT_EQ(1u, scope.Count("N::__model__"));
+  EXPECT_EQ(ownedGraph->map.at("M::N::L"), scope.VertexIdByName("N::L"));
+  EXPECT_EQ(0u, scope.Count("2::X"));
+  EXPECT_EQ(0u, scope.Count("invalid"));
+  EXPECT_EQ(ignition::math::graph::kNullId, scope.VertexIdByName("invalid"));
+  EXPECT_EQ(1u, graph.Count("M2::X"));
+
+  // Vertices added after the graph was frozen are found too.
+  const auto frameId = scope.AddVertex("F", sdf::FrameType::FRAME).Id();
+  EXPECT_EQ(frameId, scope.VertexIdByName("F"));
+  graph.Freeze();
+  EXPECT_EQ(frameId, scope.VertexIdByName("F"));
+  EXPECT_EQ(1u, scope.Count("N::L"));
+}
+
 /////////////////////////////////////////////////
 TEST(NestedFrameSemantics, buildFrameAttachedToGraph_Model)
 {
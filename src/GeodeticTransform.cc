@@ -0,0 +1,159 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cmath>
+
+#include "GeodeticTransform.hh"
+
+using namespace sdf;
+
+/// \brief Equatorial axis of the WGS84 ellipsoid, in meters.
+static constexpr double kWgs84AxisA = 6378137.0;
+
+/// \brief Polar axis of the WGS84 ellipsoid, in meters.
+static constexpr double kWgs84AxisB = 6356752.314245;
+
+/// \brief Distance between the positions that the affine maps are sampled
+/// at, large enough for the differences of ECEF coordinates to keep their
+/// precision.
+static constexpr double kSampleStep = 1000.0;
+
+namespace
+{
+/// \brief Coefficients of an affine map, copied out of the matrix and
+/// vector so that the loops read plain doubles.
+struct Coefficients
+{
+  /// \brief Constructor.
+  /// \param[in] _m Linear part of the map.
+  /// \param[in] _t Translation of the map.
+  Coefficients(const ignition::math::Matrix3d &_m,
+               const ignition::math::Vector3d &_t)
+    : m00(_m(0, 0)), m01(_m(0, 1)), m02(_m(0, 2)),
+      m10(_m(1, 0)), m11(_m(1, 1)), m12(_m(1, 2)),
+      m20(_m(2, 0)), m21(_m(2, 1)), m22(_m(2, 2)),
+      t0(_t.X()), t1(_t.Y()), t2(_t.Z())
+  {
+  }
+
+  /// \brief Entries of the linear part, by row and column.
+  const double m00, m01, m02, m10, m11, m12, m20, m21, m22;
+
+  /// \brief Entries of the translation.
+  const double t0, t1, t2;
+};
+}
+
+/////////////////////////////////////////////////
+GeodeticTransform::GeodeticTransform(
+    const ignition::math::SphericalCoordinates &_coordinates)
+{
+  using ignition::math::SphericalCoordinates;
+  using ignition::math::Vector3d;
+
+  // Sample the maps at the origin and along each axis, so that the results
+  // match PositionTransform in each direction.
+  this->localOriginInEcef = _coordinates.PositionTransform(
+      Vector3d::Zero, SphericalCoordinates::LOCAL, SphericalCoordinates::ECEF);
+  this->localOriginInLocal = _coordinates.PositionTransform(
+      this->localOriginInEcef, SphericalCoordinates::ECEF,
+      SphericalCoordinates::LOCAL);
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    Vector3d step = Vector3d::Zero;
+    step[i] = kSampleStep;
+    const Vector3d ecef = (_coordinates.PositionTransform(step,
+        SphericalCoordinates::LOCAL, SphericalCoordinates::ECEF) -
+        this->localOriginInEcef) / kSampleStep;
+    const Vector3d local = (_coordinates.PositionTransform(
+        this->localOriginInEcef + step, SphericalCoordinates::ECEF,
+        SphericalCoordinates::LOCAL) - this->localOriginInLocal) /
+        kSampleStep;
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      this->localToEcef(j, i) = ecef[j];
+      this->ecefToLocal(j, i) = local[j];
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void GeodeticTransform::LocalToGeodetic(
+    const ignition::math::Vector3d *_local, std::size_t _count,
+    ignition::math::Vector3d *_geodetic) const
+{
+  const double a = kWgs84AxisA;
+  const double b = kWgs84AxisB;
+  const double e2 = 1.0 - (b * b) / (a * a);
+  const double ep2 = (a * a) / (b * b) - 1.0;
+  const Coefficients c(this->localToEcef, this->localOriginInEcef);
+
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double lx = _local[i].X();
+    const double ly = _local[i].Y();
+    const double lz = _local[i].Z();
+    const double x = c.t0 + c.m00 * lx + c.m01 * ly + c.m02 * lz;
+    const double y = c.t1 + c.m10 * lx + c.m11 * ly + c.m12 * lz;
+    const double z = c.t2 + c.m20 * lx + c.m21 * ly + c.m22 * lz;
+
+    // Bowring's formula, as used by PositionTransform
+    const double p = std::sqrt(x * x + y * y);
+    const double theta = std::atan((z * a) / (p * b));
+    const double sinTheta = std::sin(theta);
+    const double cosTheta = std::cos(theta);
+    const double lat = std::atan(
+        (z + ep2 * b * sinTheta * sinTheta * sinTheta) /
+        (p - e2 * a * cosTheta * cosTheta * cosTheta));
+    const double lon = std::atan2(y, x);
+    const double sinLat = std::sin(lat);
+    const double n = a / std::sqrt(1.0 - e2 * sinLat * sinLat);
+    _geodetic[i].Set(lat, lon, p / std::cos(lat) - n);
+  }
+}
+
+/////////////////////////////////////////////////
+void GeodeticTransform::GeodeticToLocal(
+    const ignition::math::Vector3d *_geodetic, std::size_t _count,
+    ignition::math::Vector3d *_local) const
+{
+  const double a = kWgs84AxisA;
+  const double e2 = 1.0 - (kWgs84AxisB * kWgs84AxisB) / (a * a);
+  const Coefficients c(this->ecefToLocal, this->localOriginInLocal);
+  const double ox = this->localOriginInEcef.X();
+  const double oy = this->localOriginInEcef.Y();
+  const double oz = this->localOriginInEcef.Z();
+
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double sinLat = std::sin(_geodetic[i].X());
+    const double cosLat = std::cos(_geodetic[i].X());
+    const double sinLon = std::sin(_geodetic[i].Y());
+    const double cosLon = std::cos(_geodetic[i].Y());
+    const double alt = _geodetic[i].Z();
+    const double n = a / std::sqrt(1.0 - e2 * sinLat * sinLat);
+
+    // Relative to the origin of the local frame, to keep the precision of
+    // positions near it.
+    const double x = (n + alt) * cosLat * cosLon - ox;
+    const double y = (n + alt) * cosLat * sinLon - oy;
+    const double z = (n * (1.0 - e2) + alt) * sinLat - oz;
+    _local[i].Set(
+        c.t0 + c.m00 * x + c.m01 * y + c.m02 * z,
+        c.t1 + c.m10 * x + c.m11 * y + c.m12 * z,
+        c.t2 + c.m20 * x + c.m21 * y + c.m22 * z);
+  }
+}
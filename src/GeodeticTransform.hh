@@ -0,0 +1,82 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_GEODETICTRANSFORM_HH
+#define SDFORMAT_GEODETICTRANSFORM_HH
+
+#include <cstddef>
+
+#include <ignition/math/Matrix3.hh>
+#include <ignition/math/SphericalCoordinates.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Converts many positions between the local frame of spherical
+  /// coordinates and geodetic coordinates. It gives the results of
+  /// ignition::math::SphericalCoordinates::PositionTransform between the
+  /// LOCAL and SPHERICAL types, but the affine maps between the local frame
+  /// and Earth-centered, Earth-fixed (ECEF) coordinates are computed once,
+  /// and the positions are converted in tight loops over arrays.
+  class GeodeticTransform
+  {
+    /// \brief Constructor.
+    /// \param[in] _coordinates The spherical coordinates of the origin of
+    /// the local frame. Only the EARTH_WGS84 surface is supported.
+    public: explicit GeodeticTransform(
+                const ignition::math::SphericalCoordinates &_coordinates);
+
+    /// \brief Convert local positions to geodetic coordinates.
+    /// \param[in] _local Positions in the local frame, in meters.
+    /// \param[in] _count Number of positions.
+    /// \param[out] _geodetic Latitudes and longitudes in radians and
+    /// altitudes in meters, which may be the same array as _local.
+    public: void LocalToGeodetic(const ignition::math::Vector3d *_local,
+                std::size_t _count,
+                ignition::math::Vector3d *_geodetic) const;
+
+    /// \brief Convert geodetic coordinates to local positions.
+    /// \param[in] _geodetic Latitudes and longitudes in radians and
+    /// altitudes in meters.
+    /// \param[in] _count Number of positions.
+    /// \param[out] _local Positions in the local frame, in meters, which
+    /// may be the same array as _geodetic.
+    public: void GeodeticToLocal(const ignition::math::Vector3d *_geodetic,
+                std::size_t _count,
+                ignition::math::Vector3d *_local) const;
+
+    /// \brief Rotation part of the map from local to ECEF coordinates.
+    private: ignition::math::Matrix3d localToEcef;
+
+    /// \brief ECEF coordinates of the origin of the local frame.
+    private: ignition::math::Vector3d localOriginInEcef;
+
+    /// \brief Rotation part of the map from ECEF to local coordinates.
+    private: ignition::math::Matrix3d ecefToLocal;
+
+    /// \brief Local coordinates of the ECEF coordinates of the origin of
+    /// the local frame, which are zero up to rounding.
+    private: ignition::math::Vector3d localOriginInLocal;
+  };
+  }
+}
+#endif
@@ -15,7 +15,11 @@
  *
 */
 
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <sstream>
 
 #include "sdf/Geometry.hh"
 #include "sdf/Box.hh"
@@ -64,6 +68,10 @@ class sdf::Geometry::Implementation
 
   /// \brief The SDF element pointer used during load.
   public: sdf::ElementPtr sdf;
+
+  /// \brief Whether sdf still describes the geometry, which is the case
+  /// from Load until a setter is called.
+  public: bool sdfCurrent = false;
 };
 
 /////////////////////////////////////////////////
@@ -77,7 +85,7 @@ Errors Geometry::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that sdf is a valid pointer
   if (!_sdf)
@@ -155,6 +163,7 @@ Errors Geometry::Load(ElementPtr _sdf)
     errors.insert(errors.end(), err.begin(), err.end());
   }
 
+  this->dataPtr->sdfCurrent = true;
   return errors;
 }
 
@@ -167,6 +176,7 @@ GeometryType Geometry::Type() const
 /////////////////////////////////////////////////
 void Geometry::SetType(const GeometryType _type)
 {
+  this->dataPtr->sdfCurrent = false;
   this->dataPtr->type = _type;
 }
 
@@ -179,6 +189,7 @@ const Box *Geometry::BoxShape() const
 /////////////////////////////////////////////////
 void Geometry::SetBoxShape(const Box &_box)
 {
+  this->dataPtr->sdfCurrent = false;
   this->dataPtr->box = _box;
 }
 
@@ -191,6 +202,7 @@ const Sphere *Geometry::SphereShape() const
 /////////////////////////////////////////////////
 void Geometry::SetSphereShape(const Sphere &_sphere)
 {
+  this->dataPtr->sdfCurrent = false;
   this->dataPtr->sphere = _sphere;
 }
 
@@ -203,6 +215,7 @@ const Capsule *Geometry::CapsuleShape() const
 /////////////////////////////////////////////////
 void Geometry::SetCapsuleShape(const Capsule &_capsule)
 {
+  this->dataPtr->sdfCurrent = false;
   this->dataPtr->capsule = _capsule;
 }
 
@@ -215,6 +228,7 @@ const Cylinder *Geometry::CylinderShape() const
 /////////////////////////////////////////////////
 void Geometry::SetCylinderShape(const Cylinder &_cylinder)
 {
+  this->dataPtr->sdfCurrent = false;
   this->dataPtr->cylinder = _cylinder;
 }
 
@@ -227,6 +241,7 @@ const Ellipsoid *Geometry::EllipsoidShape() const
 /////////////////////////////////////////////////
 void Geometry::SetEllipsoidShape(const Ellipsoid &_ellipsoid)
 {
+  this->dataPtr->sdfCurrent = false;
   this->dataPtr->ellipsoid = _ellipsoid;
 }
 
@@ -239,6 +254,7 @@ const Plane *Geometry::PlaneShape() const
 /////////////////////////////////////////////////
 void Geometry::SetPlaneShape(const Plane &_plane)
 {
+  this->dataPtr->sdfCurrent = false;
   this->dataPtr->plane = _plane;
 }
 
@@ -251,6 +267,7 @@ const Mesh *Geometry::MeshShape() const
 /////////////////////////////////////////////////
 void Geometry::SetMeshShape(const Mesh &_mesh)
 {
+  this->dataPtr->sdfCurrent = false;
   this->dataPtr->mesh = _mesh;
 }
 
@@ -263,9 +280,164 @@ const Heightmap *Geometry::HeightmapShape() const
 /////////////////////////////////////////////////
 void Geometry::SetHeightmapShape(const Heightmap &_heightmap)
 {
+  this->dataPtr->sdfCurrent = false;
   this->dataPtr->heightmap = _heightmap;
 }
 
+/////////////////////////////////////////////////
+std::optional<ignition::math::AxisAlignedBox> Geometry::AxisAlignedBox() const
+{
+  using Box3d = ignition::math::AxisAlignedBox;
+  using ignition::math::Vector3d;
+  const double inf = std::numeric_limits<double>::infinity();
+
+  switch (this->dataPtr->type)
+  {
+    case GeometryType::EMPTY:
+      return Box3d();
+    case GeometryType::BOX:
+      if (this->dataPtr->box)
+      {
+        const Vector3d half = this->dataPtr->box->Size() / 2.0;
+        return Box3d(-half, half);
+      }
+      break;
+    case GeometryType::CAPSULE:
+      if (this->dataPtr->capsule)
+      {
+        const double r = this->dataPtr->capsule->Radius();
+        const Vector3d half(
+            r, r, r + this->dataPtr->capsule->Length() / 2.0);
+        return Box3d(-half, half);
+      }
+      break;
+    case GeometryType::CYLINDER:
+      if (this->dataPtr->cylinder)
+      {
+        const double r = this->dataPtr->cylinder->Radius();
+        const Vector3d half(
+            r, r, this->dataPtr->cylinder->Length() / 2.0);
+        return Box3d(-half, half);
+      }
+      break;
+    case GeometryType::ELLIPSOID:
+      if (this->dataPtr->ellipsoid)
+      {
+        const Vector3d half = this->dataPtr->ellipsoid->Radii();
+        return Box3d(-half, half);
+      }
+      break;
+    case GeometryType::SPHERE:
+      if (this->dataPtr->sphere)
+      {
+        const double r = this->dataPtr->sphere->Radius();
+        return Box3d(Vector3d(-r, -r, -r), Vector3d(r, r, r));
+      }
+      break;
+    case GeometryType::PLANE:
+      if (this->dataPtr->plane)
+      {
+        // Planes are infinite, and only have no thickness along their
+        // normal when it is aligned with an axis.
+        Vector3d half(inf, inf, inf);
+        const Vector3d normal = this->dataPtr->plane->Normal();
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+          if (normal[(i + 1) % 3] == 0.0 && normal[(i + 2) % 3] == 0.0 &&
+              normal[i] != 0.0)
+          {
+            half[i] = 0.0;
+          }
+        }
+        return Box3d(-half, half);
+      }
+      break;
+    case GeometryType::HEIGHTMAP:
+      if (this->dataPtr->heightmap)
+      {
+        // The terrain rises from the position of the heightmap.
+        const Vector3d size = this->dataPtr->heightmap->Size();
+        const Vector3d pos = this->dataPtr->heightmap->Position();
+        return Box3d(pos - Vector3d(size.X() / 2.0, size.Y() / 2.0, 0.0),
+                     pos + Vector3d(size.X() / 2.0, size.Y() / 2.0, size.Z()));
+      }
+      break;
+    case GeometryType::MESH:
+      if (this->dataPtr->mesh && this->dataPtr->mesh->Extents())
+      {
+        const Box3d extents = *this->dataPtr->mesh->Extents();
+        if (isEmptyBox(extents))
+          return extents;
+        const Vector3d scale = this->dataPtr->mesh->Scale();
+        return Box3d(extents.Min() * scale, extents.Max() * scale);
+      }
+      break;
+    default:
+      break;
+  }
+  return std::nullopt;
+}
+
+/////////////////////////////////////////////////
+ElementPtr Geometry::ShapeElement() const
+{
+  ElementPtr elem = this->dataPtr->sdfCurrent ? this->dataPtr->sdf : nullptr;
+  if (!elem)
+    elem = this->ToElement();
+  return elem;
+}
+
+/////////////////////////////////////////////////
+std::uint64_t Geometry::ShapeId() const
+{
+  ElementPtr elem = this->ShapeElement();
+  std::uint64_t id = kFnvOffsetBasis;
+  hashNumber(id, elem->ContentHash());
+
+  // Relative URIs of meshes and heightmaps are found from the file that
+  // they are read from, and the extents of meshes are not in the element.
+  if (this->dataPtr->type == GeometryType::MESH && this->dataPtr->mesh)
+  {
+    hashString(id, this->dataPtr->mesh->FilePath());
+    if (auto extents = this->dataPtr->mesh->Extents())
+    {
+      std::ostringstream stream;
+      stream << extents->Min() << " " << extents->Max();
+      hashString(id, stream.str());
+    }
+  }
+  else if (this->dataPtr->type == GeometryType::HEIGHTMAP &&
+           this->dataPtr->heightmap)
+  {
+    hashString(id, this->dataPtr->heightmap->FilePath());
+  }
+  return id;
+}
+
+/////////////////////////////////////////////////
+bool Geometry::SameShape(const Geometry &_geom) const
+{
+  if (this == &_geom)
+    return true;
+  if (!identicalContent(*this->ShapeElement(), *_geom.ShapeElement()))
+    return false;
+
+  if (this->dataPtr->type == GeometryType::MESH && this->dataPtr->mesh)
+  {
+    return _geom.dataPtr->mesh &&
+        this->dataPtr->mesh->FilePath() == _geom.dataPtr->mesh->FilePath() &&
+        this->dataPtr->mesh->Extents() == _geom.dataPtr->mesh->Extents();
+  }
+  if (this->dataPtr->type == GeometryType::HEIGHTMAP &&
+      this->dataPtr->heightmap)
+  {
+    return _geom.dataPtr->heightmap &&
+        this->dataPtr->heightmap->FilePath() ==
+            _geom.dataPtr->heightmap->FilePath();
+  }
+  return true;
+}
+
 /////////////////////////////////////////////////
 sdf::ElementPtr Geometry::Element() const
 {
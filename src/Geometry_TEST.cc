@@ -16,6 +16,8 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <ignition/math/AxisAlignedBox.hh>
 #include "sdf/Box.hh"
 #include "sdf/Capsule.hh"
 #include "sdf/Cylinder.hh"
@@ -464,3 +466,131 @@ TEST(DOMGeometry, ToElement)
     EXPECT_NE(nullptr, geom2.HeightmapShape());
   }
 }
+
+/////////////////////////////////////////////////
+TEST(DOMGeometry, AxisAlignedBox)
+{
+  using ignition::math::Vector3d;
+
+  sdf::Geometry geom;
+  auto box = geom.AxisAlignedBox();
+  ASSERT_TRUE(box.has_value());
+  EXPECT_GT(box->Min().X(), box->Max().X());
+
+  // A type without its shape has unknown bounds.
+  geom.SetType(sdf::GeometryType::BOX);
+  EXPECT_FALSE(geom.AxisAlignedBox().has_value());
+
+  sdf::Box boxShape;
+  boxShape.SetSize(Vector3d(1, 2, 3));
+  geom.SetBoxShape(boxShape);
+  box = geom.AxisAlignedBox();
+  ASSERT_TRUE(box.has_value());
+  EXPECT_EQ(Vector3d(-0.5, -1, -1.5), box->Min());
+  EXPECT_EQ(Vector3d(0.5, 1, 1.5), box->Max());
+
+  geom.SetType(sdf::GeometryType::CAPSULE);
+  sdf::Capsule capsule;
+  capsule.SetRadius(0.5);
+  capsule.SetLength(2);
+  geom.SetCapsuleShape(capsule);
+  box = geom.AxisAlignedBox();
+  ASSERT_TRUE(box.has_value());
+  EXPECT_EQ(Vector3d(-0.5, -0.5, -1.5), box->Min());
+  EXPECT_EQ(Vector3d(0.5, 0.5, 1.5), box->Max());
+
+  geom.SetType(sdf::GeometryType::CYLINDER);
+  sdf::Cylinder cylinder;
+  cylinder.SetRadius(0.5);
+  cylinder.SetLength(2);
+  geom.SetCylinderShape(cylinder);
+  box = geom.AxisAlignedBox();
+  ASSERT_TRUE(box.has_value());
+  EXPECT_EQ(Vector3d(-0.5, -0.5, -1), box->Min());
+  EXPECT_EQ(Vector3d(0.5, 0.5, 1), box->Max());
+
+  geom.SetType(sdf::GeometryType::ELLIPSOID);
+  sdf::Ellipsoid ellipsoid;
+  ellipsoid.SetRadii(Vector3d(1, 2, 3));
+  geom.SetEllipsoidShape(ellipsoid);
+  box = geom.AxisAlignedBox();
+  ASSERT_TRUE(box.has_value());
+  EXPECT_EQ(Vector3d(-1, -2, -3), box->Min());
+  EXPECT_EQ(Vector3d(1, 2, 3), box->Max());
+
+  geom.SetType(sdf::GeometryType::SPHERE);
+  sdf::Sphere sphere;
+  sphere.SetRadius(2);
+  geom.SetSphereShape(sphere);
+  box = geom.AxisAlignedBox();
+  ASSERT_TRUE(box.has_value());
+  EXPECT_EQ(Vector3d(-2, -2, -2), box->Min());
+  EXPECT_EQ(Vector3d(2, 2, 2), box->Max());
+
+  // Planes are flat along a normal aligned with an axis.
+  geom.SetType(sdf::GeometryType::PLANE);
+  sdf::Plane plane;
+  geom.SetPlaneShape(plane);
+  box = geom.AxisAlignedBox();
+  ASSERT_TRUE(box.has_value());
+  EXPECT_TRUE(std::isinf(box->Min().X()));
+  EXPECT_TRUE(std::isinf(box->Max().Y()));
+  EXPECT_DOUBLE_EQ(0.0, box->Min().Z());
+  EXPECT_DOUBLE_EQ(0.0, box->Max().Z());
+  plane.SetNormal(Vector3d(0, 1, 1));
+  geom.SetPlaneShape(plane);
+  box = geom.AxisAlignedBox();
+  ASSERT_TRUE(box.has_value());
+  EXPECT_TRUE(std::isinf(box->Max().Z()));
+
+  geom.SetType(sdf::GeometryType::HEIGHTMAP);
+  sdf::Heightmap heightmap;
+  heightmap.SetSize(Vector3d(10, 20, 5));
+  heightmap.SetPosition(Vector3d(1, 0, -1));
+  geom.SetHeightmapShape(heightmap);
+  box = geom.AxisAlignedBox();
+  ASSERT_TRUE(box.has_value());
+  EXPECT_EQ(Vector3d(-4, -10, -1), box->Min());
+  EXPECT_EQ(Vector3d(6, 10, 4), box->Max());
+
+  // Meshes are scaled from their extents, and unknown without them.
+  geom.SetType(sdf::GeometryType::MESH);
+  sdf::Mesh mesh;
+  geom.SetMeshShape(mesh);
+  EXPECT_FALSE(geom.AxisAlignedBox().has_value());
+  mesh.SetExtents(ignition::math::AxisAlignedBox(
+      Vector3d(-1, 0, 0), Vector3d(1, 2, 3)));
+  mesh.SetScale(Vector3d(2, -1, 1));
+  geom.SetMeshShape(mesh);
+  box = geom.AxisAlignedBox();
+  ASSERT_TRUE(box.has_value());
+  EXPECT_EQ(Vector3d(-2, -2, 0), box->Min());
+  EXPECT_EQ(Vector3d(2, 0, 3), box->Max());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMGeometry, ShapeId)
+{
+  sdf::Box box;
+  box.SetSize(ignition::math::Vector3d(1, 2, 3));
+  sdf::Geometry geom;
+  geom.SetType(sdf::GeometryType::BOX);
+  geom.SetBoxShape(box);
+
+  sdf::Geometry same = geom;
+  EXPECT_EQ(geom.ShapeId(), same.ShapeId());
+
+  box.SetSize(ignition::math::Vector3d(3, 2, 1));
+  same.SetBoxShape(box);
+  EXPECT_NE(geom.ShapeId(), same.ShapeId());
+
+  // Meshes with relative URIs depend on the file they are read from.
+  sdf::Mesh mesh;
+  mesh.SetUri("mesh.dae");
+  geom.SetType(sdf::GeometryType::MESH);
+  geom.SetMeshShape(mesh);
+  same.SetType(sdf::GeometryType::MESH);
+  mesh.SetFilePath("/other/model.sdf");
+  same.SetMeshShape(mesh);
+  EXPECT_NE(geom.ShapeId(), same.ShapeId());
+}
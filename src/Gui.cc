@@ -44,7 +44,7 @@ Errors Gui::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <gui> element.
   // This is an error that cannot be recovered, so return an error.
@@ -18,6 +18,7 @@
 #include <string>
 #include "sdf/Imu.hh"
 #include "sdf/parser.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
@@ -81,7 +82,7 @@ Errors Imu::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <imu> element.
   // This is an error that cannot be recovered, so return an error.
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <utility>
+
+#include "IncludeCache.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/////////////////////////////////////////////////
+std::shared_ptr<IncludeCache> IncludeCache::Of(const ParserConfig &_config)
+{
+  return _config.IncludeFileCache();
+}
+
+/////////////////////////////////////////////////
+bool IncludeCache::Find(const std::string &_fileName, SDFPtr &_sdf,
+    Errors &_errors)
+{
+  Entry entry;
+  if (!this->entries.Find({_fileName, SDF::Version()}, entry))
+    return false;
+
+  _sdf.reset(new SDF);
+  _sdf->Root(entry.root->Clone());
+  _sdf->SetFilePath(entry.filePath);
+  _sdf->SetOriginalVersion(entry.originalVersion);
+  _errors.insert(_errors.end(), entry.errors.begin(), entry.errors.end());
+  return true;
+}
+
+/////////////////////////////////////////////////
+void IncludeCache::Insert(const std::string &_fileName, const SDFPtr &_sdf,
+    const Errors &_errors)
+{
+  Entry entry;
+  entry.root = _sdf->Root()->Clone();
+  entry.filePath = _sdf->FilePath();
+  entry.originalVersion = _sdf->OriginalVersion();
+  entry.errors = _errors;
+  this->entries.Insert({_fileName, SDF::Version()}, std::move(entry),
+                       _fileName);
+}
+
+/////////////////////////////////////////////////
+void IncludeCache::Clear()
+{
+  this->entries.Clear();
+}
+
+/////////////////////////////////////////////////
+std::size_t IncludeCache::Size() const
+{
+  return this->entries.Size();
+}
+}
+}
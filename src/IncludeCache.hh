@@ -0,0 +1,100 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_INCLUDECACHE_HH
+#define SDFORMAT_INCLUDECACHE_HH
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "sdf/Element.hh"
+#include "sdf/Error.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/sdf_config.h"
+#include "FileStampCache.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Cache of the files read for <include> elements. Entries are keyed
+  /// on the resolved file name and the version the file was converted to,
+  /// and are invalidated when the modification time of the file changes.
+  /// Each lookup returns a clone of the cached elements, since the parser
+  /// modifies included elements when it applies the overrides of an
+  /// <include>.
+  class IncludeCache
+  {
+    /// \brief Get the include cache of a parser configuration.
+    /// \param[in] _config Parser configuration.
+    /// \return The cache, or nullptr if included files are not cached.
+    public: static std::shared_ptr<IncludeCache> Of(
+                const ParserConfig &_config);
+
+    /// \brief Look up a file.
+    /// \param[in] _fileName Resolved name of the included file.
+    /// \param[out] _sdf New SDF object with a copy of the cached elements.
+    /// \param[out] _errors Errors found when the file was read are appended
+    /// to this variable.
+    /// \return True if the file was found in the cache and has not been
+    /// modified since it was read.
+    public: bool Find(const std::string &_fileName, SDFPtr &_sdf,
+                Errors &_errors);
+
+    /// \brief Add a file that was read successfully to the cache.
+    /// \param[in] _fileName Resolved name of the included file.
+    /// \param[in] _sdf The SDF object read from the file. Its elements are
+    /// copied into the cache.
+    /// \param[in] _errors Errors found while reading the file.
+    public: void Insert(const std::string &_fileName, const SDFPtr &_sdf,
+                const Errors &_errors);
+
+    /// \brief Remove all files from the cache.
+    public: void Clear();
+
+    /// \brief Get the number of cached files.
+    /// \return Number of cached files.
+    public: std::size_t Size() const;
+
+    /// \brief A cached file.
+    private: struct Entry
+    {
+      /// \brief Root element of the file.
+      public: ElementPtr root;
+
+      /// \brief File path stored in the SDF object.
+      public: std::string filePath;
+
+      /// \brief Original version of the file.
+      public: std::string originalVersion;
+
+      /// \brief Errors found while reading the file.
+      public: Errors errors;
+    };
+
+    /// \brief Cached files, keyed on the resolved file name and the version
+    /// the file was converted to, and stamped with the file.
+    private: FileStampCache<std::pair<std::string, std::string>, Entry>
+                 entries;
+  };
+  }
+}
+#endif
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "sdf/Element.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "IncludeCache.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+TEST(IncludeCache, FindAndInsert)
+{
+  sdf::ParserConfig config;
+  EXPECT_EQ(nullptr, sdf::IncludeCache::Of(config));
+  config.SetUseIncludeCache(true);
+  auto cache = sdf::IncludeCache::Of(config);
+  ASSERT_NE(nullptr, cache);
+  EXPECT_EQ(0u, cache->Size());
+
+  // Copies of the configuration share the cache.
+  sdf::ParserConfig configCopy = config;
+  EXPECT_EQ(cache, sdf::IncludeCache::Of(configCopy));
+
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  std::filesystem::create_directories(tmpDir);
+  const std::string fileName =
+      sdf::filesystem::append(tmpDir, "include_cache_unit.sdf");
+  {
+    std::ofstream out(fileName);
+    out << "<sdf version='1.9'/>";
+  }
+
+  sdf::SDFPtr found;
+  sdf::Errors errors;
+  EXPECT_FALSE(cache->Find(fileName, found, errors));
+
+  sdf::SDFPtr sdfParsed(new sdf::SDF);
+  sdfParsed->Root()->SetName("sdf");
+  sdfParsed->SetFilePath(fileName);
+  sdfParsed->SetOriginalVersion("1.6");
+  cache->Insert(fileName, sdfParsed,
+      {sdf::Error(sdf::ErrorCode::ELEMENT_DEPRECATED, "deprecated")});
+  EXPECT_EQ(1u, cache->Size());
+
+  ASSERT_TRUE(cache->Find(fileName, found, errors));
+  ASSERT_NE(nullptr, found);
+  EXPECT_NE(sdfParsed->Root(), found->Root());
+  EXPECT_EQ("sdf", found->Root()->GetName());
+  EXPECT_EQ(fileName, found->FilePath());
+  EXPECT_EQ("1.6", found->OriginalVersion());
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_DEPRECATED, errors[0].Code());
+
+  // A modified file is removed from the cache.
+  std::filesystem::last_write_time(fileName,
+      std::filesystem::last_write_time(fileName) + std::chrono::seconds(1));
+  EXPECT_FALSE(cache->Find(fileName, found, errors));
+  EXPECT_EQ(0u, cache->Size());
+
+  cache->Insert(fileName, sdfParsed, {});
+  EXPECT_EQ(1u, cache->Size());
+  configCopy.ClearIncludeCache();
+  EXPECT_EQ(0u, cache->Size());
+
+  config.SetUseIncludeCache(false);
+  EXPECT_EQ(nullptr, sdf::IncludeCache::Of(config));
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
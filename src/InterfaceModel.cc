@@ -15,6 +15,13 @@
  *
  */
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "sdf/InterfaceModel.hh"
 #include "FrameSemantics.hh"
 #include "ScopedGraph.hh"
@@ -23,6 +30,41 @@ namespace sdf
 {
 inline namespace SDF_VERSION_NAMESPACE
 {
+/// \brief The callback that adds the children of a model on demand. A copy
+/// of a model whose children are not loaded yet loads them on its own.
+struct ChildrenLoader
+{
+  /// \brief Default constructor.
+  ChildrenLoader() = default;
+
+  /// \brief Copy constructor.
+  /// \param[in] _other The loader to copy.
+  ChildrenLoader(const ChildrenLoader &_other)
+      : function(_other.function), loaded(_other.loaded.load())
+  {
+  }
+
+  /// \brief Copy assignment operator.
+  /// \param[in] _other The loader to copy.
+  /// \return Reference to this loader.
+  ChildrenLoader &operator=(const ChildrenLoader &_other)
+  {
+    this->function = _other.function;
+    this->once = std::make_unique<std::once_flag>();
+    this->loaded = _other.loaded.load();
+    return *this;
+  }
+
+  /// \brief The callback.
+  InterfaceModelChildrenFunction function;
+
+  /// \brief Flag that makes sure the callback is called once.
+  std::unique_ptr<std::once_flag> once = std::make_unique<std::once_flag>();
+
+  /// \brief Whether the callback was called.
+  std::atomic<bool> loaded {false};
+};
+
 class InterfaceModel::Implementation
 {
   /// \brief Name of this interface model.
@@ -41,20 +83,25 @@ class InterfaceModel::Implementation
   /// \brief Model frame pose relative to the parent frame.
   public: ignition::math::Pose3d poseInParentFrame;
 
-  /// \brief Collection of child interface models
-  public: std::vector<sdf::InterfaceModelConstPtr> nestedModels;
+  /// \brief Collection of child interface models. The collections of
+  /// children are mutable since the children added by the callback of
+  /// childrenLoader are appended on first access.
+  public: mutable std::vector<sdf::InterfaceModelConstPtr> nestedModels;
 
   /// \brief Collection of child interface frames
-  public: std::vector<sdf::InterfaceFrame> frames;
+  public: mutable std::vector<sdf::InterfaceFrame> frames;
 
   /// \brief Collection of child interface joints
-  public: std::vector<sdf::InterfaceJoint> joints;
+  public: mutable std::vector<sdf::InterfaceJoint> joints;
 
   /// \brief Collection of child interface links
-  public: std::vector<sdf::InterfaceLink> links;
+  public: mutable std::vector<sdf::InterfaceLink> links;
 
   /// \brief Whether the custom parser supports merge-includes
   public: bool parserSupportsMergeInclude {false};
+
+  /// \brief Callback that adds the children on demand.
+  public: mutable ChildrenLoader childrenLoader;
 };
 
 InterfaceModel::InterfaceModel(const std::string &_name,
@@ -77,12 +124,24 @@ const std::string &InterfaceModel::Name() const
   return this->dataPtr->name;
 }
 
+/////////////////////////////////////////////////
+void InterfaceModel::SetName(const std::string &_name)
+{
+  this->dataPtr->name = _name;
+}
+
 /////////////////////////////////////////////////
 bool InterfaceModel::Static() const
 {
   return this->dataPtr->isStatic;
 }
 
+/////////////////////////////////////////////////
+void InterfaceModel::SetStatic(bool _static)
+{
+  this->dataPtr->isStatic = _static;
+}
+
 /////////////////////////////////////////////////
 const std::string &InterfaceModel::CanonicalLinkName() const
 {
@@ -106,6 +165,7 @@ void InterfaceModel::AddNestedModel(sdf::InterfaceModelConstPtr _nestedmodel)
 const std::vector<sdf::InterfaceModelConstPtr> &
 InterfaceModel::NestedModels() const
 {
+  this->LoadChildren();
   return this->dataPtr->nestedModels;
 }
 
@@ -118,6 +178,7 @@ void InterfaceModel::AddFrame(sdf::InterfaceFrame _frame)
 /////////////////////////////////////////////////
 const std::vector<sdf::InterfaceFrame> &InterfaceModel::Frames() const
 {
+  this->LoadChildren();
   return this->dataPtr->frames;
 }
 
@@ -130,6 +191,7 @@ void InterfaceModel::AddJoint(sdf::InterfaceJoint _joint)
 /////////////////////////////////////////////////
 const std::vector<sdf::InterfaceJoint> &InterfaceModel::Joints() const
 {
+  this->LoadChildren();
   return this->dataPtr->joints;
 }
 
@@ -142,6 +204,7 @@ void InterfaceModel::AddLink(sdf::InterfaceLink _link)
 /////////////////////////////////////////////////
 const std::vector<sdf::InterfaceLink> &InterfaceModel::Links() const
 {
+  this->LoadChildren();
   return this->dataPtr->links;
 }
 
@@ -157,6 +220,79 @@ void InterfaceModel::SetParserSupportsMergeInclude(bool _val)
   this->dataPtr->parserSupportsMergeInclude = _val;
 }
 
+/////////////////////////////////////////////////
+void InterfaceModel::SetChildrenFunction(
+    const sdf::InterfaceModelChildrenFunction &_function)
+{
+  this->dataPtr->childrenLoader = ChildrenLoader();
+  this->dataPtr->childrenLoader.function = _function;
+}
+
+/////////////////////////////////////////////////
+bool InterfaceModel::ChildrenLoaded() const
+{
+  return !this->dataPtr->childrenLoader.function ||
+      this->dataPtr->childrenLoader.loaded;
+}
+
+/////////////////////////////////////////////////
+bool InterfaceModel::HasRepostureFunction() const
+{
+  return static_cast<bool>(this->dataPtr->repostureFunction);
+}
+
+/////////////////////////////////////////////////
+const std::vector<sdf::InterfaceModelConstPtr> &
+InterfaceModel::AddedNestedModels() const
+{
+  return this->dataPtr->nestedModels;
+}
+
+/////////////////////////////////////////////////
+const std::vector<sdf::InterfaceFrame> &InterfaceModel::AddedFrames() const
+{
+  return this->dataPtr->frames;
+}
+
+/////////////////////////////////////////////////
+const std::vector<sdf::InterfaceJoint> &InterfaceModel::AddedJoints() const
+{
+  return this->dataPtr->joints;
+}
+
+/////////////////////////////////////////////////
+const std::vector<sdf::InterfaceLink> &InterfaceModel::AddedLinks() const
+{
+  return this->dataPtr->links;
+}
+
+/////////////////////////////////////////////////
+void InterfaceModel::LoadChildren() const
+{
+  auto &loader = this->dataPtr->childrenLoader;
+  if (!loader.function || loader.loaded)
+    return;
+
+  std::call_once(*loader.once, [&]()
+  {
+    InterfaceModel children(this->dataPtr->name, nullptr,
+        this->dataPtr->isStatic, this->dataPtr->canonicalLinkName,
+        this->dataPtr->poseInParentFrame);
+    loader.function(children);
+
+    auto append = [](auto &_to, auto &_from)
+    {
+      _to.insert(_to.end(), std::make_move_iterator(_from.begin()),
+                 std::make_move_iterator(_from.end()));
+    };
+    append(this->dataPtr->nestedModels, children.dataPtr->nestedModels);
+    append(this->dataPtr->frames, children.dataPtr->frames);
+    append(this->dataPtr->joints, children.dataPtr->joints);
+    append(this->dataPtr->links, children.dataPtr->links);
+    loader.loaded = true;
+  });
+}
+
 /////////////////////////////////////////////////
 void InterfaceModel::InvokeRepostureFunction(
     sdf::ScopedGraph<PoseRelativeToGraph> _graph,
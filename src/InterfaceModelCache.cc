@@ -0,0 +1,70 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <utility>
+
+#include "InterfaceModelCache.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/////////////////////////////////////////////////
+std::shared_ptr<InterfaceModelCache> InterfaceModelCache::Of(
+    const ParserConfig &_config)
+{
+  return _config.InterfaceModelFileCache();
+}
+
+/////////////////////////////////////////////////
+bool InterfaceModelCache::Find(const std::string &_fileName,
+    InterfaceModelConstPtr &_model)
+{
+  return this->entries.Find(_fileName, _model);
+}
+
+/////////////////////////////////////////////////
+void InterfaceModelCache::Insert(const std::string &_fileName,
+    InterfaceModelConstPtr _model)
+{
+  this->entries.Insert(_fileName, std::move(_model), _fileName);
+}
+
+/////////////////////////////////////////////////
+void InterfaceModelCache::Clear()
+{
+  this->entries.Clear();
+}
+
+/////////////////////////////////////////////////
+std::size_t InterfaceModelCache::Size() const
+{
+  return this->entries.Size();
+}
+
+/////////////////////////////////////////////////
+InterfaceModelPtr InterfaceModelCache::Instantiate(
+    const InterfaceModel &_model, const NestedInclude &_include)
+{
+  auto model = std::make_shared<InterfaceModel>(_model);
+  if (_include.LocalModelName().has_value())
+    model->SetName(*_include.LocalModelName());
+  if (_include.IsStatic().has_value())
+    model->SetStatic(*_include.IsStatic());
+  return model;
+}
+}
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_INTERFACEMODELCACHE_HH
+#define SDFORMAT_INTERFACEMODELCACHE_HH
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "sdf/InterfaceElements.hh"
+#include "sdf/InterfaceModel.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/sdf_config.h"
+#include "FileStampCache.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Cache of the interface models parsed by the custom model parsers
+  /// for <include> elements. Entries are keyed on the resolved file name and
+  /// are invalidated when the modification time of the file changes. A file
+  /// that none of the custom model parsers handled is cached as well, with a
+  /// null model.
+  class InterfaceModelCache
+  {
+    /// \brief Get the interface model cache of a parser configuration.
+    /// \param[in] _config Parser configuration.
+    /// \return The cache, or nullptr if interface models are not cached.
+    public: static std::shared_ptr<InterfaceModelCache> Of(
+                const ParserConfig &_config);
+
+    /// \brief Look up a file.
+    /// \param[in] _fileName Resolved name of the included file.
+    /// \param[out] _model The cached interface model, which is nullptr if
+    /// the custom model parsers did not handle the file.
+    /// \return True if the file was found in the cache and has not been
+    /// modified since it was parsed.
+    public: bool Find(const std::string &_fileName,
+                InterfaceModelConstPtr &_model);
+
+    /// \brief Add a file that was parsed without errors to the cache.
+    /// \param[in] _fileName Resolved name of the included file.
+    /// \param[in] _model The interface model parsed from the file, or
+    /// nullptr if the custom model parsers did not handle the file.
+    public: void Insert(const std::string &_fileName,
+                InterfaceModelConstPtr _model);
+
+    /// \brief Remove all files from the cache.
+    public: void Clear();
+
+    /// \brief Get the number of cached files.
+    /// \return Number of cached files.
+    public: std::size_t Size() const;
+
+    /// \brief Make the interface model of an include from a cached model,
+    /// applying the name and static overrides of the include. The nested
+    /// models are shared with the cached model.
+    /// \param[in] _model The cached interface model.
+    /// \param[in] _include The include.
+    /// \return The interface model of the include.
+    public: static InterfaceModelPtr Instantiate(
+                const InterfaceModel &_model, const NestedInclude &_include);
+
+    /// \brief Cached interface models, keyed and stamped with the resolved
+    /// file name.
+    private: FileStampCache<std::string, InterfaceModelConstPtr> entries;
+  };
+  }
+}
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "sdf/Filesystem.hh"
+#include "sdf/InterfaceElements.hh"
+#include "sdf/InterfaceModel.hh"
+#include "sdf/ParserConfig.hh"
+#include "InterfaceModelCache.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+TEST(InterfaceModelCache, FindAndInsert)
+{
+  sdf::ParserConfig config;
+  EXPECT_FALSE(config.UseInterfaceModelCache());
+  EXPECT_EQ(nullptr, sdf::InterfaceModelCache::Of(config));
+  config.SetUseInterfaceModelCache(true);
+  EXPECT_TRUE(config.UseInterfaceModelCache());
+  auto cache = sdf::InterfaceModelCache::Of(config);
+  ASSERT_NE(nullptr, cache);
+  EXPECT_EQ(0u, cache->Size());
+
+  // Copies of the configuration share the cache.
+  sdf::ParserConfig configCopy = config;
+  EXPECT_EQ(cache, sdf::InterfaceModelCache::Of(configCopy));
+
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  std::filesystem::create_directories(tmpDir);
+  const std::string fileName =
+      sdf::filesystem::append(tmpDir, "interface_model_cache_unit.model");
+  {
+    std::ofstream out(fileName);
+    out << "model";
+  }
+
+  sdf::InterfaceModelConstPtr found;
+  EXPECT_FALSE(cache->Find(fileName, found));
+
+  // Files that do not exist are not cached.
+  const std::string missingFile =
+      sdf::filesystem::append(tmpDir, "interface_model_cache_missing.model");
+  cache->Insert(missingFile, nullptr);
+  EXPECT_EQ(0u, cache->Size());
+  EXPECT_FALSE(cache->Find(missingFile, found));
+
+  auto model = std::make_shared<sdf::InterfaceModel>(
+      "model", nullptr, false, "link");
+  model->AddLink({"link", {}});
+  cache->Insert(fileName, model);
+  EXPECT_EQ(1u, cache->Size());
+  ASSERT_TRUE(cache->Find(fileName, found));
+  EXPECT_EQ(model, found);
+
+  // A modified file is parsed again.
+  std::filesystem::last_write_time(fileName,
+      std::filesystem::last_write_time(fileName) + std::chrono::seconds(1));
+  EXPECT_FALSE(cache->Find(fileName, found));
+
+  // Files that no custom parser handled are cached with a null model.
+  cache->Insert(fileName, nullptr);
+  EXPECT_EQ(1u, cache->Size());
+  found = model;
+  ASSERT_TRUE(cache->Find(fileName, found));
+  EXPECT_EQ(nullptr, found);
+
+  configCopy.ClearInterfaceModelCache();
+  EXPECT_EQ(0u, cache->Size());
+
+  config.SetUseInterfaceModelCache(false);
+  EXPECT_EQ(nullptr, sdf::InterfaceModelCache::Of(config));
+}
+
+/////////////////////////////////////////////////
+TEST(InterfaceModelCache, Instantiate)
+{
+  auto model = std::make_shared<sdf::InterfaceModel>("model", nullptr, false,
+      "link", ignition::math::Pose3d(1, 2, 3, 0, 0, 0));
+  model->AddLink({"link", {}});
+  model->AddFrame({"frame", "__model__", {}});
+  auto nested = std::make_shared<sdf::InterfaceModel>(
+      "nested", nullptr, false, "nested_link");
+  model->AddNestedModel(nested);
+  model->SetParserSupportsMergeInclude(true);
+
+  sdf::NestedInclude include;
+  auto instance = sdf::InterfaceModelCache::Instantiate(*model, include);
+  ASSERT_NE(nullptr, instance);
+  EXPECT_NE(model, instance);
+  EXPECT_EQ("model", instance->Name());
+  EXPECT_FALSE(instance->Static());
+  EXPECT_EQ("link", instance->CanonicalLinkName());
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0),
+            instance->ModelFramePoseInParentFrame());
+  EXPECT_TRUE(instance->ParserSupportsMergeInclude());
+  ASSERT_EQ(1u, instance->Links().size());
+  EXPECT_EQ("link", instance->Links()[0].Name());
+  ASSERT_EQ(1u, instance->Frames().size());
+  ASSERT_EQ(1u, instance->NestedModels().size());
+  EXPECT_EQ(nested, instance->NestedModels()[0]);
+
+  include.SetLocalModelName("renamed");
+  include.SetIsStatic(true);
+  instance = sdf::InterfaceModelCache::Instantiate(*model, include);
+  ASSERT_NE(nullptr, instance);
+  EXPECT_EQ("renamed", instance->Name());
+  EXPECT_TRUE(instance->Static());
+  EXPECT_EQ(nested, instance->NestedModels()[0]);
+
+  // The cached model is unchanged
+  EXPECT_EQ("model", model->Name());
+  EXPECT_FALSE(model->Static());
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,6 +15,9 @@
  *
  */
 
+#include <string>
+#include <unordered_map>
+
 #include "sdf/InterfaceModelPoseGraph.hh"
 
 #include "FrameSemantics.hh"
@@ -72,5 +75,44 @@ sdf::Errors InterfaceModelPoseGraph::ResolveNestedFramePose(
   return sdf::resolvePose(
       _pose, this->dataPtr->modelGraph, _frameName, _relativeTo);
 }
+
+sdf::Errors InterfaceModelPoseGraph::ResolveAllNestedFramePoses(
+    std::unordered_map<std::string, ignition::math::Pose3d> &_poses) const
+{
+  _poses.clear();
+  const auto &modelGraph = this->dataPtr->modelGraph;
+
+  ignition::math::Pose3d modelPose;
+  sdf::Errors errors = sdf::resolvePose(modelPose, this->dataPtr->rootGraph,
+      modelGraph.ScopeVertexId(), this->dataPtr->rootGraph.ScopeVertexId());
+  if (!errors.empty())
+    return errors;
+
+  std::unordered_map<ignition::math::graph::VertexId, ignition::math::Pose3d>
+      vertexPoses;
+  sdf::resolvePosesRelativeToRoot(vertexPoses, modelGraph);
+
+  for (const std::string &name : modelGraph.VertexNames())
+  {
+    const auto vertexId = modelGraph.VertexIdByName(name);
+    auto it = vertexPoses.find(vertexId);
+    if (it != vertexPoses.end())
+    {
+      _poses[name] = modelPose * it->second;
+      continue;
+    }
+
+    // Vertices that the traversal leaves out are resolved on their own,
+    // which reports why they failed.
+    ignition::math::Pose3d pose;
+    sdf::Errors frameErrors = sdf::resolvePose(pose,
+        this->dataPtr->rootGraph, vertexId,
+        this->dataPtr->rootGraph.ScopeVertexId());
+    if (frameErrors.empty())
+      _poses[name] = pose;
+    errors.insert(errors.end(), frameErrors.begin(), frameErrors.end());
+  }
+  return errors;
+}
 }
 }
@@ -27,7 +27,9 @@
 #include "sdf/Sensor.hh"
 #include "sdf/Types.hh"
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
+#include "ScopedTraceEvent.hh"
 #include "Utils.hh"
 
 using namespace sdf;
@@ -37,6 +39,11 @@ class sdf::Joint::Implementation
   /// \brief Name of the joint.
   public: std::string name = "";
 
+  /// \brief Names that the joints of the vector holding this joint were renamed
+  /// to, shared with the name index of the vector. Null if the joint is not
+  /// indexed.
+  public: std::shared_ptr<NameIndexRenames> nameIndexRenames;
+
   /// \brief Name of the parent link.
   public: std::string parentLinkName = "";
 
@@ -80,9 +87,10 @@ Joint::Joint()
 /////////////////////////////////////////////////
 Errors Joint::Load(ElementPtr _sdf)
 {
+  ScopedTraceEvent event("Joint::Load", "dom");
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <joint>
   // This is an error that cannot be recovered, so return an error.
@@ -235,9 +243,17 @@ const std::string &Joint::Name() const
 /////////////////////////////////////////////////
 void Joint::SetName(const std::string &_name)
 {
+  if (this->dataPtr->nameIndexRenames && this->dataPtr->name != _name)
+    this->dataPtr->nameIndexRenames->Add(_name);
   this->dataPtr->name = _name;
 }
 
+/////////////////////////////////////////////////
+void Joint::SetNameIndexRenames(std::shared_ptr<NameIndexRenames> _renames)
+{
+  this->dataPtr->nameIndexRenames = std::move(_renames);
+}
+
 /////////////////////////////////////////////////
 JointType Joint::Type() const
 {
@@ -396,6 +412,15 @@ sdf::SemanticPose Joint::SemanticPose() const
       this->dataPtr->poseRelativeToGraph);
 }
 
+/////////////////////////////////////////////////
+Errors Joint::ResolvePose(ignition::math::Pose3d &_pose,
+    const std::string &_resolveTo) const
+{
+  return resolveSemanticPose(_pose, this->dataPtr->poseRelativeToGraph,
+      this->dataPtr->name, this->dataPtr->pose, this->dataPtr->poseRelativeTo,
+      this->ChildLinkName(), _resolveTo);
+}
+
 /////////////////////////////////////////////////
 double Joint::ThreadPitch() const
 {
@@ -538,6 +563,15 @@ bool Joint::AddSensor(const Sensor &_sensor)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Joint::AddSensor(Sensor &&_sensor)
+{
+  if (this->SensorNameExists(_sensor.Name()))
+    return false;
+  this->dataPtr->sensors.push_back(std::move(_sensor));
+  return true;
+}
+
 //////////////////////////////////////////////////
 void Joint::ClearSensors()
 {
@@ -100,7 +100,7 @@ Errors JointAxis::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Read the xyz values.
   if (_sdf->HasElement("xyz"))
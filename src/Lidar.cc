@@ -14,12 +14,53 @@
  * limitations under the License.
  *
  */
+#include <cmath>
+#include <mutex>
+
 #include "sdf/Lidar.hh"
 #include "sdf/parser.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 using namespace ignition;
 
+/// \brief Ray directions computed on demand by Lidar::RayDirections. A copy
+/// of a lidar computes its directions again.
+struct RayDirectionCache
+{
+  /// \brief Default constructor.
+  RayDirectionCache() = default;
+
+  /// \brief Copy constructor.
+  RayDirectionCache(const RayDirectionCache &)
+  {
+  }
+
+  /// \brief Copy assignment operator.
+  /// \return Reference to this cache.
+  RayDirectionCache &operator=(const RayDirectionCache &)
+  {
+    this->Invalidate();
+    return *this;
+  }
+
+  /// \brief Discard the directions.
+  void Invalidate()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->valid = false;
+  }
+
+  /// \brief Mutex that protects the directions while they are computed.
+  std::mutex mutex;
+
+  /// \brief Whether the directions match the scan parameters.
+  bool valid = false;
+
+  /// \brief The directions.
+  LidarRayDirections directions;
+};
+
 /// \brief Private lidar data.
 class sdf::Lidar::Implementation
 {
@@ -61,8 +102,37 @@ class sdf::Lidar::Implementation
 
   /// \brief The SDF element pointer used during load.
   public: sdf::ElementPtr sdf{nullptr};
+
+  /// \brief Ray directions computed from the scan parameters.
+  public: mutable RayDirectionCache rayDirections;
 };
 
+//////////////////////////////////////////////////
+/// \brief Get the number of rays that a scan direction is sampled with.
+/// \param[in] _samples Number of samples.
+/// \param[in] _resolution Resolution that the samples are multiplied by.
+/// \return The number of rays.
+static unsigned int rayCount(unsigned int _samples, double _resolution)
+{
+  const double count = std::round(_samples * _resolution);
+  return count > 0.0 ? static_cast<unsigned int>(count) : 0u;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the angle of a ray.
+/// \param[in] _min Angle of the first ray.
+/// \param[in] _max Angle of the last ray.
+/// \param[in] _index Index of the ray.
+/// \param[in] _count Number of rays.
+/// \return The angle of the ray.
+static double rayAngle(double _min, double _max, unsigned int _index,
+    unsigned int _count)
+{
+  if (_count < 2u)
+    return _min;
+  return _min + (_max - _min) * _index / (_count - 1u);
+}
+
 //////////////////////////////////////////////////
 Lidar::Lidar()
   : dataPtr(ignition::utils::MakeImpl<Implementation>())
@@ -80,7 +150,8 @@ Errors Lidar::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
+  this->dataPtr->rayDirections.Invalidate();
 
   // Check that sdf is a valid pointer
   if (!_sdf)
@@ -192,6 +263,7 @@ unsigned int Lidar::HorizontalScanSamples() const
 void Lidar::SetHorizontalScanSamples(unsigned int _samples)
 {
   this->dataPtr->horizontalScanSamples = _samples;
+  this->dataPtr->rayDirections.Invalidate();
 }
 
 //////////////////////////////////////////////////
@@ -204,6 +276,7 @@ double Lidar::HorizontalScanResolution() const
 void Lidar::SetHorizontalScanResolution(double _res)
 {
   this->dataPtr->horizontalScanResolution = _res;
+  this->dataPtr->rayDirections.Invalidate();
 }
 
 //////////////////////////////////////////////////
@@ -216,6 +289,7 @@ math::Angle Lidar::HorizontalScanMinAngle() const
 void Lidar::SetHorizontalScanMinAngle(const math::Angle &_min)
 {
   this->dataPtr->horizontalScanMinAngle = _min;
+  this->dataPtr->rayDirections.Invalidate();
 }
 
 //////////////////////////////////////////////////
@@ -228,6 +302,7 @@ math::Angle Lidar::HorizontalScanMaxAngle() const
 void Lidar::SetHorizontalScanMaxAngle(const math::Angle &_max)
 {
   this->dataPtr->horizontalScanMaxAngle = _max;
+  this->dataPtr->rayDirections.Invalidate();
 }
 
 //////////////////////////////////////////////////
@@ -240,6 +315,7 @@ unsigned int Lidar::VerticalScanSamples() const
 void Lidar::SetVerticalScanSamples(unsigned int _samples)
 {
   this->dataPtr->verticalScanSamples = _samples;
+  this->dataPtr->rayDirections.Invalidate();
 }
 
 //////////////////////////////////////////////////
@@ -252,6 +328,7 @@ double Lidar::VerticalScanResolution() const
 void Lidar::SetVerticalScanResolution(double _res)
 {
   this->dataPtr->verticalScanResolution = _res;
+  this->dataPtr->rayDirections.Invalidate();
 }
 
 //////////////////////////////////////////////////
@@ -264,6 +341,7 @@ math::Angle Lidar::VerticalScanMinAngle() const
 void Lidar::SetVerticalScanMinAngle(const math::Angle &_min)
 {
   this->dataPtr->verticalScanMinAngle = _min;
+  this->dataPtr->rayDirections.Invalidate();
 }
 
 //////////////////////////////////////////////////
@@ -276,6 +354,65 @@ math::Angle Lidar::VerticalScanMaxAngle() const
 void Lidar::SetVerticalScanMaxAngle(const math::Angle &_max)
 {
   this->dataPtr->verticalScanMaxAngle = _max;
+  this->dataPtr->rayDirections.Invalidate();
+}
+
+//////////////////////////////////////////////////
+const LidarRayDirections &Lidar::RayDirections() const
+{
+  auto &cache = this->dataPtr->rayDirections;
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  if (cache.valid)
+    return cache.directions;
+
+  LidarRayDirections &directions = cache.directions;
+  directions.horizontalCount = rayCount(
+      this->dataPtr->horizontalScanSamples,
+      this->dataPtr->horizontalScanResolution);
+  directions.verticalCount = rayCount(
+      this->dataPtr->verticalScanSamples,
+      this->dataPtr->verticalScanResolution);
+
+  const std::size_t size =
+      static_cast<std::size_t>(directions.horizontalCount) *
+      directions.verticalCount;
+  directions.x.resize(size);
+  directions.y.resize(size);
+  directions.z.resize(size);
+
+  // The horizontal angles are shared by every sweep.
+  std::vector<double> cosH(directions.horizontalCount);
+  std::vector<double> sinH(directions.horizontalCount);
+  for (unsigned int h = 0; h < directions.horizontalCount; ++h)
+  {
+    const double angle = rayAngle(
+        this->dataPtr->horizontalScanMinAngle.Radian(),
+        this->dataPtr->horizontalScanMaxAngle.Radian(), h,
+        directions.horizontalCount);
+    cosH[h] = std::cos(angle);
+    sinH[h] = std::sin(angle);
+  }
+
+  for (unsigned int v = 0; v < directions.verticalCount; ++v)
+  {
+    const double angle = rayAngle(
+        this->dataPtr->verticalScanMinAngle.Radian(),
+        this->dataPtr->verticalScanMaxAngle.Radian(), v,
+        directions.verticalCount);
+    const double cosV = std::cos(angle);
+    const float sinV = static_cast<float>(std::sin(angle));
+    const std::size_t offset =
+        static_cast<std::size_t>(v) * directions.horizontalCount;
+    for (unsigned int h = 0; h < directions.horizontalCount; ++h)
+    {
+      directions.x[offset + h] = static_cast<float>(cosV * cosH[h]);
+      directions.y[offset + h] = static_cast<float>(cosV * sinH[h]);
+      directions.z[offset + h] = sinV;
+    }
+  }
+
+  cache.valid = true;
+  return directions;
 }
 
 //////////////////////////////////////////////////
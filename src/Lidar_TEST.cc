@@ -95,6 +95,55 @@ TEST(DOMLidar, Set)
   EXPECT_EQ(lidarAssigned, lidarCopied);
 }
 
+/////////////////////////////////////////////////
+TEST(DOMLidar, RayDirections)
+{
+  sdf::Lidar lidar;
+  lidar.SetHorizontalScanSamples(3);
+  lidar.SetHorizontalScanResolution(1.0);
+  lidar.SetHorizontalScanMinAngle(-IGN_PI_2);
+  lidar.SetHorizontalScanMaxAngle(IGN_PI_2);
+  lidar.SetVerticalScanSamples(1);
+  lidar.SetVerticalScanMinAngle(0.0);
+
+  const sdf::LidarRayDirections *directions = &lidar.RayDirections();
+  EXPECT_EQ(3u, directions->horizontalCount);
+  EXPECT_EQ(1u, directions->verticalCount);
+  ASSERT_EQ(3u, directions->x.size());
+  ASSERT_EQ(3u, directions->y.size());
+  ASSERT_EQ(3u, directions->z.size());
+  EXPECT_NEAR(0.0f, directions->x[0], 1e-6f);
+  EXPECT_NEAR(-1.0f, directions->y[0], 1e-6f);
+  EXPECT_NEAR(1.0f, directions->x[1], 1e-6f);
+  EXPECT_NEAR(0.0f, directions->y[1], 1e-6f);
+  EXPECT_NEAR(0.0f, directions->x[2], 1e-6f);
+  EXPECT_NEAR(1.0f, directions->y[2], 1e-6f);
+  for (float z : directions->z)
+    EXPECT_NEAR(0.0f, z, 1e-6f);
+
+  // Directions are cached until the scan changes.
+  EXPECT_EQ(directions, &lidar.RayDirections());
+
+  // The resolution multiplies the number of rays, and sweeps are stored
+  // one after the other.
+  lidar.SetHorizontalScanResolution(2.0);
+  lidar.SetVerticalScanSamples(2);
+  lidar.SetVerticalScanMaxAngle(IGN_PI_2);
+  directions = &lidar.RayDirections();
+  EXPECT_EQ(6u, directions->horizontalCount);
+  EXPECT_EQ(2u, directions->verticalCount);
+  ASSERT_EQ(12u, directions->z.size());
+  EXPECT_NEAR(0.0f, directions->z[5], 1e-6f);
+  EXPECT_NEAR(1.0f, directions->z[6], 1e-6f);
+  EXPECT_NEAR(0.0f, directions->x[6], 1e-6f);
+  EXPECT_NEAR(0.0f, directions->y[6], 1e-6f);
+
+  // Copies compute their directions on their own.
+  sdf::Lidar copy(lidar);
+  EXPECT_EQ(12u, copy.RayDirections().x.size());
+  EXPECT_NE(&lidar.RayDirections(), &copy.RayDirections());
+}
+
 /////////////////////////////////////////////////
 TEST(DOMLidar, Load)
 {
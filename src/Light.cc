@@ -21,6 +21,7 @@
 #include "sdf/parser.hh"
 #include "FrameSemantics.hh"
 #include "ScopedGraph.hh"
+#include "ScopedTraceEvent.hh"
 #include "Utils.hh"
 
 using namespace sdf;
@@ -101,9 +102,10 @@ Light::Light()
 /////////////////////////////////////////////////
 Errors Light::Load(ElementPtr _sdf)
 {
+  ScopedTraceEvent event("Light::Load", "dom");
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <light>
   // This is an error that cannot be recovered, so return an error.
@@ -299,6 +301,15 @@ sdf::SemanticPose Light::SemanticPose() const
       this->dataPtr->poseRelativeToGraph);
 }
 
+/////////////////////////////////////////////////
+Errors Light::ResolvePose(ignition::math::Pose3d &_pose,
+    const std::string &_resolveTo) const
+{
+  return resolveSemanticPose(_pose, this->dataPtr->poseRelativeToGraph, "",
+      this->dataPtr->pose, this->dataPtr->poseRelativeTo,
+      this->dataPtr->xmlParentName, _resolveTo);
+}
+
 /////////////////////////////////////////////////
 sdf::ElementPtr Light::Element() const
 {
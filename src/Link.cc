@@ -16,6 +16,7 @@
 */
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <ignition/math/Inertial.hh>
 #include <ignition/math/Pose3.hh>
@@ -32,7 +33,9 @@
 #include "sdf/Visual.hh"
 
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
+#include "ScopedTraceEvent.hh"
 #include "Utils.hh"
 
 using namespace sdf;
@@ -42,6 +45,11 @@ class sdf::Link::Implementation
   /// \brief Name of the link.
   public: std::string name = "";
 
+  /// \brief Names that the links of the vector holding this link were renamed
+  /// to, shared with the name index of the vector. Null if the link is not
+  /// indexed.
+  public: std::shared_ptr<NameIndexRenames> nameIndexRenames;
+
   /// \brief Pose of the link
   public: ignition::math::Pose3d pose = ignition::math::Pose3d::Zero;
 
@@ -87,9 +95,10 @@ Link::Link()
 /////////////////////////////////////////////////
 Errors Link::Load(ElementPtr _sdf)
 {
+  ScopedTraceEvent event("Link::Load", "dom");
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <link>
   // This is an error that cannot be recovered, so return an error.
@@ -201,9 +210,17 @@ std::string Link::Name() const
 /////////////////////////////////////////////////
 void Link::SetName(const std::string &_name)
 {
+  if (this->dataPtr->nameIndexRenames && this->dataPtr->name != _name)
+    this->dataPtr->nameIndexRenames->Add(_name);
   this->dataPtr->name = _name;
 }
 
+/////////////////////////////////////////////////
+void Link::SetNameIndexRenames(std::shared_ptr<NameIndexRenames> _renames)
+{
+  this->dataPtr->nameIndexRenames = std::move(_renames);
+}
+
 /////////////////////////////////////////////////
 uint64_t Link::VisualCount() const
 {
@@ -490,6 +507,35 @@ sdf::SemanticPose Link::SemanticPose() const
       this->dataPtr->poseRelativeToGraph);
 }
 
+/////////////////////////////////////////////////
+Errors Link::ResolvePose(ignition::math::Pose3d &_pose,
+    const std::string &_resolveTo) const
+{
+  return resolveSemanticPose(_pose, this->dataPtr->poseRelativeToGraph,
+      this->dataPtr->name, this->dataPtr->pose, this->dataPtr->poseRelativeTo,
+      "__model__", _resolveTo);
+}
+
+/////////////////////////////////////////////////
+Errors Link::ResolveCollisionBounds(
+    ignition::math::AxisAlignedBox &_bounds) const
+{
+  Errors errors;
+  _bounds = ignition::math::AxisAlignedBox();
+  for (const Collision &collision : this->dataPtr->collisions)
+  {
+    ignition::math::Pose3d pose;
+    Errors poseErrors = collision.ResolvePose(pose);
+    if (!poseErrors.empty())
+    {
+      errors.insert(errors.end(), poseErrors.begin(), poseErrors.end());
+      continue;
+    }
+    _bounds += placedGeometryBounds(collision.Geom(), pose);
+  }
+  return errors;
+}
+
 /////////////////////////////////////////////////
 const Visual *Link::VisualByName(const std::string &_name) const
 {
@@ -578,6 +624,15 @@ bool Link::AddCollision(const Collision &_collision)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Link::AddCollision(Collision &&_collision)
+{
+  if (this->CollisionNameExists(_collision.Name()))
+    return false;
+  this->dataPtr->collisions.push_back(std::move(_collision));
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool Link::AddVisual(const Visual &_visual)
 {
@@ -587,6 +642,15 @@ bool Link::AddVisual(const Visual &_visual)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Link::AddVisual(Visual &&_visual)
+{
+  if (this->VisualNameExists(_visual.Name()))
+    return false;
+  this->dataPtr->visuals.push_back(std::move(_visual));
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool Link::AddLight(const Light &_light)
 {
@@ -596,6 +660,15 @@ bool Link::AddLight(const Light &_light)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Link::AddLight(Light &&_light)
+{
+  if (this->LightNameExists(_light.Name()))
+    return false;
+  this->dataPtr->lights.push_back(std::move(_light));
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool Link::AddSensor(const Sensor &_sensor)
 {
@@ -605,6 +678,15 @@ bool Link::AddSensor(const Sensor &_sensor)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Link::AddSensor(Sensor &&_sensor)
+{
+  if (this->SensorNameExists(_sensor.Name()))
+    return false;
+  this->dataPtr->sensors.push_back(std::move(_sensor));
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool Link::AddParticleEmitter(const ParticleEmitter &_emitter)
 {
@@ -614,6 +696,15 @@ bool Link::AddParticleEmitter(const ParticleEmitter &_emitter)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Link::AddParticleEmitter(ParticleEmitter &&_emitter)
+{
+  if (this->ParticleEmitterNameExists(_emitter.Name()))
+    return false;
+  this->dataPtr->emitters.push_back(std::move(_emitter));
+  return true;
+}
+
 //////////////////////////////////////////////////
 void Link::ClearCollisions()
 {
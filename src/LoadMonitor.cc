@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <utility>
+
+#include "LoadMonitor.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/////////////////////////////////////////////////
+LoadMonitor::LoadMonitor(LoadTask::ProgressCallback _callback)
+  : callback(std::move(_callback))
+{
+}
+
+/////////////////////////////////////////////////
+LoadMonitor *LoadMonitor::Of(const ParserConfig &_config)
+{
+  return _config.LoadMonitorInstance();
+}
+
+/////////////////////////////////////////////////
+bool LoadMonitor::Cancelled(const ParserConfig &_config)
+{
+  const LoadMonitor *monitor = Of(_config);
+  return monitor && monitor->Cancelled();
+}
+
+/////////////////////////////////////////////////
+void LoadMonitor::FileParsed()
+{
+  ++this->filesParsed;
+  this->Notify();
+}
+
+/////////////////////////////////////////////////
+void LoadMonitor::ModelLoaded()
+{
+  ++this->modelsLoaded;
+  this->Notify();
+}
+
+/////////////////////////////////////////////////
+void LoadMonitor::Cancel()
+{
+  this->cancelled = true;
+}
+
+/////////////////////////////////////////////////
+bool LoadMonitor::Cancelled() const
+{
+  return this->cancelled;
+}
+
+/////////////////////////////////////////////////
+LoadProgress LoadMonitor::Progress() const
+{
+  LoadProgress progress;
+  progress.filesParsed = this->filesParsed;
+  progress.modelsLoaded = this->modelsLoaded;
+  return progress;
+}
+
+/////////////////////////////////////////////////
+void LoadMonitor::Notify()
+{
+  if (!this->callback)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->callbackMutex);
+  this->callback(this->Progress());
+}
+}
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_LOADMONITOR_HH
+#define SDFORMAT_LOADMONITOR_HH
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "sdf/LoadTask.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Progress and cancellation state of a LoadTask. The monitor is
+  /// attached to the parser configuration of the load, so that the parser
+  /// and the DOM can report progress and stop early on every thread that
+  /// loads the document.
+  class LoadMonitor
+  {
+    /// \brief Constructor.
+    /// \param[in] _callback Function called when the progress changes, or
+    /// an empty function.
+    public: explicit LoadMonitor(LoadTask::ProgressCallback _callback);
+
+    /// \brief Get the monitor of a parser configuration.
+    /// \param[in] _config Parser configuration.
+    /// \return The monitor, or nullptr if loading is not monitored.
+    public: static LoadMonitor *Of(const ParserConfig &_config);
+
+    /// \brief Check whether the load that uses a parser configuration was
+    /// cancelled.
+    /// \param[in] _config Parser configuration.
+    /// \return True if the configuration is monitored and the load was
+    /// cancelled.
+    public: static bool Cancelled(const ParserConfig &_config);
+
+    /// \brief Record that a file was parsed.
+    public: void FileParsed();
+
+    /// \brief Record that a model was loaded.
+    public: void ModelLoaded();
+
+    /// \brief Request the load to stop.
+    public: void Cancel();
+
+    /// \brief Check whether the load was cancelled.
+    /// \return True if Cancel() was called.
+    public: bool Cancelled() const;
+
+    /// \brief Get the progress of the load.
+    /// \return The current progress.
+    public: LoadProgress Progress() const;
+
+    /// \brief Call the progress callback, if there is one.
+    private: void Notify();
+
+    /// \brief Number of files that were parsed.
+    private: std::atomic<std::uint64_t> filesParsed{0};
+
+    /// \brief Number of models that were loaded.
+    private: std::atomic<std::uint64_t> modelsLoaded{0};
+
+    /// \brief Whether the load was cancelled.
+    private: std::atomic<bool> cancelled{false};
+
+    /// \brief Mutex that serializes the calls to the progress callback.
+    private: std::mutex callbackMutex;
+
+    /// \brief Function called when the progress changes.
+    private: LoadTask::ProgressCallback callback;
+  };
+  }
+}
+#endif
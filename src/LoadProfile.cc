@@ -0,0 +1,165 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+#include "sdf/LoadProfile.hh"
+
+using namespace sdf;
+
+/// \brief Number of phases. VALIDATION must remain the last phase.
+static constexpr std::size_t kPhaseCount =
+    static_cast<std::size_t>(LoadPhase::VALIDATION) + 1;
+
+/// \brief Time and number of inclusions of an included file.
+struct IncludeStats
+{
+  /// \brief Number of inclusions.
+  std::uint64_t count = 0;
+
+  /// \brief Total time of the inclusions.
+  std::chrono::nanoseconds duration{0};
+};
+
+class sdf::LoadProfile::Implementation
+{
+  /// \brief Time spent in each phase, in nanoseconds.
+  public: std::array<std::atomic<std::int64_t>, kPhaseCount> durations{};
+
+  /// \brief Number of runs of each phase.
+  public: std::array<std::atomic<std::uint64_t>, kPhaseCount> counts{};
+
+  /// \brief Mutex protecting includes.
+  public: mutable std::mutex includesMutex;
+
+  /// \brief Statistics of the included files, by full path.
+  public: std::map<std::string, IncludeStats> includes;
+};
+
+/////////////////////////////////////////////////
+LoadProfile::LoadProfile()
+  : dataPtr(ignition::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+std::chrono::nanoseconds LoadProfile::Duration(LoadPhase _phase) const
+{
+  return std::chrono::nanoseconds(
+      this->dataPtr->durations[static_cast<std::size_t>(_phase)].load(
+          std::memory_order_relaxed));
+}
+
+/////////////////////////////////////////////////
+std::uint64_t LoadProfile::Count(LoadPhase _phase) const
+{
+  return this->dataPtr->counts[static_cast<std::size_t>(_phase)].load(
+      std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> LoadProfile::IncludedFiles() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->includesMutex);
+  std::vector<std::string> files;
+  files.reserve(this->dataPtr->includes.size());
+  for (const auto &include : this->dataPtr->includes)
+    files.push_back(include.first);
+  return files;
+}
+
+/////////////////////////////////////////////////
+std::chrono::nanoseconds LoadProfile::IncludeDuration(
+    const std::string &_fileName) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->includesMutex);
+  auto it = this->dataPtr->includes.find(_fileName);
+  if (it == this->dataPtr->includes.end())
+    return std::chrono::nanoseconds(0);
+  return it->second.duration;
+}
+
+/////////////////////////////////////////////////
+std::uint64_t LoadProfile::IncludeCount(const std::string &_fileName) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->includesMutex);
+  auto it = this->dataPtr->includes.find(_fileName);
+  if (it == this->dataPtr->includes.end())
+    return 0;
+  return it->second.count;
+}
+
+/////////////////////////////////////////////////
+void LoadProfile::Record(LoadPhase _phase, std::chrono::nanoseconds _duration)
+{
+  const auto index = static_cast<std::size_t>(_phase);
+  this->dataPtr->durations[index].fetch_add(_duration.count(),
+      std::memory_order_relaxed);
+  this->dataPtr->counts[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+void LoadProfile::RecordInclude(const std::string &_fileName,
+    std::chrono::nanoseconds _duration)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->includesMutex);
+  IncludeStats &stats = this->dataPtr->includes[_fileName];
+  ++stats.count;
+  stats.duration += _duration;
+}
+
+/////////////////////////////////////////////////
+void LoadProfile::Reset()
+{
+  for (std::size_t i = 0; i < kPhaseCount; ++i)
+  {
+    this->dataPtr->durations[i].store(0, std::memory_order_relaxed);
+    this->dataPtr->counts[i].store(0, std::memory_order_relaxed);
+  }
+  std::lock_guard<std::mutex> lock(this->dataPtr->includesMutex);
+  this->dataPtr->includes.clear();
+}
+
+/////////////////////////////////////////////////
+std::string LoadProfile::PhaseName(LoadPhase _phase)
+{
+  switch (_phase)
+  {
+    case LoadPhase::XML_PARSE:
+      return "xml_parse";
+    case LoadPhase::CONVERSION:
+      return "conversion";
+    case LoadPhase::URDF_CONVERSION:
+      return "urdf_conversion";
+    case LoadPhase::READ_XML:
+      return "read_xml";
+    case LoadPhase::INCLUDE:
+      return "include";
+    case LoadPhase::PARAM_PASSING:
+      return "param_passing";
+    case LoadPhase::DOM_LOAD:
+      return "dom_load";
+    case LoadPhase::GRAPH_BUILD:
+      return "graph_build";
+    case LoadPhase::VALIDATION:
+      return "validation";
+  }
+  return "";
+}
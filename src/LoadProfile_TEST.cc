@@ -0,0 +1,105 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sdf/LoadProfile.hh"
+
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(LoadProfile, Construction)
+{
+  sdf::LoadProfile profile;
+  EXPECT_EQ(0u, profile.Count(sdf::LoadPhase::XML_PARSE));
+  EXPECT_EQ(0u, profile.Count(sdf::LoadPhase::VALIDATION));
+  EXPECT_EQ(0ns, profile.Duration(sdf::LoadPhase::READ_XML));
+  EXPECT_TRUE(profile.IncludedFiles().empty());
+  EXPECT_EQ(0u, profile.IncludeCount("model.sdf"));
+  EXPECT_EQ(0ns, profile.IncludeDuration("model.sdf"));
+}
+
+/////////////////////////////////////////////////
+TEST(LoadProfile, Record)
+{
+  sdf::LoadProfile profile;
+  profile.Record(sdf::LoadPhase::XML_PARSE, 10ns);
+  profile.Record(sdf::LoadPhase::XML_PARSE, 5ns);
+  profile.Record(sdf::LoadPhase::GRAPH_BUILD, 7ns);
+  EXPECT_EQ(2u, profile.Count(sdf::LoadPhase::XML_PARSE));
+  EXPECT_EQ(15ns, profile.Duration(sdf::LoadPhase::XML_PARSE));
+  EXPECT_EQ(1u, profile.Count(sdf::LoadPhase::GRAPH_BUILD));
+  EXPECT_EQ(7ns, profile.Duration(sdf::LoadPhase::GRAPH_BUILD));
+  EXPECT_EQ(0u, profile.Count(sdf::LoadPhase::READ_XML));
+
+  profile.RecordInclude("b/model.sdf", 3ns);
+  profile.RecordInclude("a/model.sdf", 4ns);
+  profile.RecordInclude("b/model.sdf", 6ns);
+  const std::vector<std::string> files = profile.IncludedFiles();
+  ASSERT_EQ(2u, files.size());
+  EXPECT_EQ("a/model.sdf", files[0]);
+  EXPECT_EQ("b/model.sdf", files[1]);
+  EXPECT_EQ(1u, profile.IncludeCount("a/model.sdf"));
+  EXPECT_EQ(4ns, profile.IncludeDuration("a/model.sdf"));
+  EXPECT_EQ(2u, profile.IncludeCount("b/model.sdf"));
+  EXPECT_EQ(9ns, profile.IncludeDuration("b/model.sdf"));
+
+  profile.Reset();
+  EXPECT_EQ(0u, profile.Count(sdf::LoadPhase::XML_PARSE));
+  EXPECT_EQ(0ns, profile.Duration(sdf::LoadPhase::XML_PARSE));
+  EXPECT_TRUE(profile.IncludedFiles().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(LoadProfile, ConcurrentRecord)
+{
+  sdf::LoadProfile profile;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&profile]()
+    {
+      for (int i = 0; i < 1000; ++i)
+      {
+        profile.Record(sdf::LoadPhase::INCLUDE, 1ns);
+        profile.RecordInclude("model.sdf", 2ns);
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(4000u, profile.Count(sdf::LoadPhase::INCLUDE));
+  EXPECT_EQ(4000ns, profile.Duration(sdf::LoadPhase::INCLUDE));
+  EXPECT_EQ(4000u, profile.IncludeCount("model.sdf"));
+  EXPECT_EQ(8000ns, profile.IncludeDuration("model.sdf"));
+}
+
+/////////////////////////////////////////////////
+TEST(LoadProfile, PhaseName)
+{
+  EXPECT_EQ("xml_parse",
+      sdf::LoadProfile::PhaseName(sdf::LoadPhase::XML_PARSE));
+  EXPECT_EQ("include", sdf::LoadProfile::PhaseName(sdf::LoadPhase::INCLUDE));
+  EXPECT_EQ("validation",
+      sdf::LoadProfile::PhaseName(sdf::LoadPhase::VALIDATION));
+}
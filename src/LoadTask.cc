@@ -0,0 +1,173 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "sdf/LoadTask.hh"
+#include "sdf/Root.hh"
+
+#include "LoadMonitor.hh"
+
+using namespace sdf;
+
+class sdf::LoadTask::Implementation
+{
+  /// \brief Monitor of the load, or nullptr if there is no load.
+  public: std::shared_ptr<LoadMonitor> monitor;
+
+  /// \brief Thread that loads the document.
+  public: std::thread thread;
+
+  /// \brief Mutex that protects the fields below.
+  public: mutable std::mutex mutex;
+
+  /// \brief Notified when the load is finished.
+  public: mutable std::condition_variable doneCondition;
+
+  /// \brief Whether the load is finished.
+  public: bool done = true;
+
+  /// \brief The loaded document.
+  public: Root root;
+
+  /// \brief Errors of the load.
+  public: Errors errors;
+
+  /// \brief Wait for the load to finish.
+  public: void Wait() const
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->doneCondition.wait(lock, [this] { return this->done; });
+  }
+
+  /// \brief Destructor, which stops the load.
+  public: ~Implementation()
+  {
+    if (this->monitor)
+      this->monitor->Cancel();
+    if (this->thread.joinable())
+      this->thread.join();
+  }
+};
+
+/////////////////////////////////////////////////
+LoadTask::LoadTask()
+  : dataPtr(ignition::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+LoadTask::LoadTask(const std::string &_filename,
+    const ParserConfig &_config, ProgressCallback _callback)
+  : dataPtr(ignition::utils::MakeUniqueImpl<Implementation>())
+{
+  auto monitor = std::make_shared<LoadMonitor>(std::move(_callback));
+  this->dataPtr->monitor = monitor;
+  this->dataPtr->done = false;
+
+  // The configuration is copied so that the caller may change or destroy
+  // its own while the document is loaded.
+  ParserConfig config = _config;
+  config.SetLoadMonitor(monitor);
+
+  Implementation *impl = this->dataPtr.get();
+  impl->thread = std::thread([impl, monitor, _filename, config]()
+  {
+    Root root;
+    Errors errors = root.Load(_filename, config);
+
+    // A cancelled load leaves a partial document, which is discarded.
+    if (monitor->Cancelled())
+    {
+      root = Root();
+      errors = {{ErrorCode::LOAD_CANCELLED,
+          "Loading of file [" + _filename + "] was cancelled."}};
+    }
+
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    impl->root = std::move(root);
+    impl->errors = std::move(errors);
+    impl->done = true;
+    impl->doneCondition.notify_all();
+  });
+}
+
+/////////////////////////////////////////////////
+bool LoadTask::Valid() const
+{
+  return nullptr != this->dataPtr->monitor;
+}
+
+/////////////////////////////////////////////////
+void LoadTask::Cancel()
+{
+  if (this->dataPtr->monitor)
+    this->dataPtr->monitor->Cancel();
+}
+
+/////////////////////////////////////////////////
+bool LoadTask::Cancelled() const
+{
+  return this->dataPtr->monitor && this->dataPtr->monitor->Cancelled();
+}
+
+/////////////////////////////////////////////////
+bool LoadTask::Ready() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->done;
+}
+
+/////////////////////////////////////////////////
+void LoadTask::Wait() const
+{
+  this->dataPtr->Wait();
+}
+
+/////////////////////////////////////////////////
+bool LoadTask::WaitFor(std::chrono::milliseconds _timeout) const
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->doneCondition.wait_for(lock, _timeout,
+      [this] { return this->dataPtr->done; });
+}
+
+/////////////////////////////////////////////////
+LoadProgress LoadTask::Progress() const
+{
+  if (!this->dataPtr->monitor)
+    return {};
+  return this->dataPtr->monitor->Progress();
+}
+
+/////////////////////////////////////////////////
+const Errors &LoadTask::LoadErrors() const
+{
+  this->dataPtr->Wait();
+  return this->dataPtr->errors;
+}
+
+/////////////////////////////////////////////////
+Root LoadTask::TakeRoot()
+{
+  this->dataPtr->Wait();
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return std::exchange(this->dataPtr->root, Root());
+}
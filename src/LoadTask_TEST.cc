@@ -0,0 +1,149 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <string>
+
+#include "sdf/Filesystem.hh"
+#include "sdf/LoadTask.hh"
+#include "sdf/Model.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/Root.hh"
+#include "sdf/World.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// \brief Write a world that includes a model with a nested model.
+/// \param[in] _name Name of the directory of the files.
+/// \return Path of the world file.
+std::string writeWorld(const std::string &_name)
+{
+  std::string tmpDir;
+  EXPECT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string dir = sdf::filesystem::append(tmpDir, _name);
+  const std::string modelDir = sdf::filesystem::append(dir, "robot");
+  std::filesystem::create_directories(modelDir);
+
+  std::ofstream(sdf::filesystem::append(modelDir, "model.config"))
+      << "<?xml version='1.0'?>\n"
+      << "<model>\n"
+      << "  <name>robot</name>\n"
+      << "  <sdf version='1.9'>model.sdf</sdf>\n"
+      << "</model>\n";
+  std::ofstream(sdf::filesystem::append(modelDir, "model.sdf"))
+      << "<sdf version='1.9'>\n"
+      << "  <model name='robot'>\n"
+      << "    <link name='base'/>\n"
+      << "    <model name='arm'>\n"
+      << "      <link name='link'/>\n"
+      << "    </model>\n"
+      << "  </model>\n"
+      << "</sdf>\n";
+
+  const std::string worldFile = sdf::filesystem::append(dir, "world.sdf");
+  std::ofstream(worldFile)
+      << "<sdf version='1.9'>\n"
+      << "  <world name='default'>\n"
+      << "    <model name='box'>\n"
+      << "      <link name='link'/>\n"
+      << "    </model>\n"
+      << "    <include>\n"
+      << "      <uri>" << modelDir << "</uri>\n"
+      << "    </include>\n"
+      << "  </world>\n"
+      << "</sdf>\n";
+  return worldFile;
+}
+
+/////////////////////////////////////////////////
+TEST(LoadTask, Construction)
+{
+  sdf::LoadTask task;
+  EXPECT_FALSE(task.Valid());
+  EXPECT_TRUE(task.Ready());
+  EXPECT_FALSE(task.Cancelled());
+  EXPECT_EQ(0u, task.Progress().filesParsed);
+  EXPECT_TRUE(task.LoadErrors().empty());
+  EXPECT_EQ(0u, task.TakeRoot().WorldCount());
+}
+
+/////////////////////////////////////////////////
+TEST(LoadTask, Load)
+{
+  const std::string worldFile = writeWorld("load_task");
+
+  sdf::ParserConfig config;
+  config.SetIncludeLoadThreadCount(2);
+  sdf::LoadProgress lastProgress;
+  sdf::LoadTask task = sdf::Root::LoadAsync(worldFile, config,
+      [&lastProgress](const sdf::LoadProgress &_progress)
+      {
+        lastProgress = _progress;
+      });
+  EXPECT_TRUE(task.Valid());
+  EXPECT_TRUE(task.WaitFor(std::chrono::seconds(30)));
+  EXPECT_TRUE(task.Ready());
+  EXPECT_TRUE(task.LoadErrors().empty()) << task.LoadErrors();
+  EXPECT_FALSE(task.Cancelled());
+
+  // The world and the included model were parsed, and the three models,
+  // including the nested one, were loaded.
+  EXPECT_EQ(2u, task.Progress().filesParsed);
+  EXPECT_EQ(3u, task.Progress().modelsLoaded);
+  EXPECT_EQ(2u, lastProgress.filesParsed);
+  EXPECT_EQ(3u, lastProgress.modelsLoaded);
+
+  sdf::Root root = task.TakeRoot();
+  ASSERT_NE(nullptr, root.WorldByIndex(0));
+  const sdf::World *world = root.WorldByIndex(0);
+  EXPECT_EQ(2u, world->ModelCount());
+  EXPECT_TRUE(world->ModelNameExists("box"));
+  EXPECT_TRUE(world->ModelNameExists("robot"));
+
+  // The root can only be taken once.
+  EXPECT_EQ(0u, task.TakeRoot().WorldCount());
+}
+
+/////////////////////////////////////////////////
+TEST(LoadTask, Cancel)
+{
+  const std::string worldFile = writeWorld("load_task_cancel");
+
+  // Hold the load after the world file is parsed until it is cancelled.
+  std::promise<void> cancelled;
+  std::shared_future<void> cancelledFuture = cancelled.get_future().share();
+  sdf::LoadTask task = sdf::Root::LoadAsync(worldFile, sdf::ParserConfig(),
+      [cancelledFuture](const sdf::LoadProgress &)
+      {
+        cancelledFuture.wait();
+      });
+  task.Cancel();
+  cancelled.set_value();
+  EXPECT_TRUE(task.Cancelled());
+
+  task.Wait();
+  ASSERT_EQ(1u, task.LoadErrors().size()) << task.LoadErrors();
+  EXPECT_EQ(sdf::ErrorCode::LOAD_CANCELLED, task.LoadErrors()[0].Code());
+  EXPECT_EQ(1u, task.Progress().filesParsed);
+  EXPECT_EQ(0u, task.Progress().modelsLoaded);
+  EXPECT_EQ(0u, task.TakeRoot().WorldCount());
+}
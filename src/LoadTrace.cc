@@ -0,0 +1,249 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "sdf/LoadTrace.hh"
+
+using namespace sdf;
+
+/// \brief A complete event of a trace.
+struct TraceEvent
+{
+  /// \brief Name of the event.
+  std::string name;
+
+  /// \brief Category of the event.
+  std::string category;
+
+  /// \brief Detail of the event, or an empty string.
+  std::string detail;
+
+  /// \brief Start time relative to the creation of the trace.
+  std::chrono::nanoseconds start{0};
+
+  /// \brief Duration of the event.
+  std::chrono::nanoseconds duration{0};
+
+  /// \brief Index of the thread that recorded the event.
+  std::size_t thread = 0;
+};
+
+class sdf::LoadTrace::Implementation
+{
+  /// \brief Time at which the trace was created.
+  public: std::chrono::steady_clock::time_point epoch =
+      std::chrono::steady_clock::now();
+
+  /// \brief Mutex protecting events and threads.
+  public: mutable std::mutex mutex;
+
+  /// \brief Recorded events.
+  public: std::vector<TraceEvent> events;
+
+  /// \brief Indices of the threads that recorded events, numbered in the
+  /// order in which they recorded their first event.
+  public: std::map<std::thread::id, std::size_t> threads;
+};
+
+/////////////////////////////////////////////////
+/// \brief Write a string as a JSON string literal.
+/// \param[in] _out Stream to write to.
+/// \param[in] _str The string.
+static void writeJsonString(std::ostream &_out, const std::string &_str)
+{
+  _out << '"';
+  for (const char c : _str)
+  {
+    switch (c)
+    {
+      case '"':
+        _out << "\\\"";
+        break;
+      case '\\':
+        _out << "\\\\";
+        break;
+      case '\n':
+        _out << "\\n";
+        break;
+      case '\t':
+        _out << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char escaped[7];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+              static_cast<unsigned int>(c));
+          _out << escaped;
+        }
+        else
+        {
+          _out << c;
+        }
+    }
+  }
+  _out << '"';
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a duration in microseconds, the unit of trace timestamps.
+/// \param[in] _out Stream to write to.
+/// \param[in] _duration The duration.
+static void writeMicroseconds(std::ostream &_out,
+    std::chrono::nanoseconds _duration)
+{
+  const std::int64_t ns = _duration.count();
+  char str[32];
+  std::snprintf(str, sizeof(str), "%lld.%03lld",
+      static_cast<long long>(ns / 1000), static_cast<long long>(ns % 1000));
+  _out << str;
+}
+
+/////////////////////////////////////////////////
+LoadTrace::LoadTrace()
+  : dataPtr(ignition::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+void LoadTrace::Record(const std::string &_name, const std::string &_category,
+    std::chrono::steady_clock::time_point _start,
+    std::chrono::nanoseconds _duration, const std::string &_detail)
+{
+  TraceEvent event;
+  event.name = _name;
+  event.category = _category;
+  event.detail = _detail;
+  event.start = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _start - this->dataPtr->epoch);
+  event.duration = _duration;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &threads = this->dataPtr->threads;
+  event.thread = threads.emplace(
+      std::this_thread::get_id(), threads.size() + 1).first->second;
+  this->dataPtr->events.push_back(std::move(event));
+}
+
+/////////////////////////////////////////////////
+std::size_t LoadTrace::EventCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->events.size();
+}
+
+/////////////////////////////////////////////////
+std::size_t LoadTrace::EventCount(const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::size_t count = 0;
+  for (const TraceEvent &event : this->dataPtr->events)
+  {
+    if (event.name == _name)
+      ++count;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+void LoadTrace::WriteJson(std::ostream &_out) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  _out << "{\"traceEvents\":[";
+  bool first = true;
+  for (const TraceEvent &event : this->dataPtr->events)
+  {
+    _out << (first ? "\n" : ",\n") << "{\"name\":";
+    first = false;
+    writeJsonString(_out, event.name);
+    _out << ",\"cat\":";
+    writeJsonString(_out, event.category);
+    _out << ",\"ph\":\"X\",\"ts\":";
+    writeMicroseconds(_out, event.start);
+    _out << ",\"dur\":";
+    writeMicroseconds(_out, event.duration);
+    _out << ",\"pid\":1,\"tid\":" << event.thread;
+    if (!event.detail.empty())
+    {
+      _out << ",\"args\":{\"detail\":";
+      writeJsonString(_out, event.detail);
+      _out << '}';
+    }
+    _out << '}';
+  }
+  _out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+/////////////////////////////////////////////////
+bool LoadTrace::WriteJson(const std::string &_fileName) const
+{
+  std::ofstream out(_fileName, std::ios::out | std::ios::trunc);
+  if (!out)
+    return false;
+  this->WriteJson(out);
+  return static_cast<bool>(out);
+}
+
+/////////////////////////////////////////////////
+void LoadTrace::Reset()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->events.clear();
+  this->dataPtr->threads.clear();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<LoadTrace> LoadTrace::FromEnvironment()
+{
+  /// \brief Trace of the environment variable, written on destruction.
+  struct EnvironmentTrace
+  {
+    EnvironmentTrace()
+    {
+      const char *fileName = std::getenv("SDF_TRACE_FILE");
+      if (fileName && *fileName)
+      {
+        this->fileName = fileName;
+        this->trace = std::make_shared<LoadTrace>();
+      }
+    }
+
+    ~EnvironmentTrace()
+    {
+      if (this->trace)
+        this->trace->WriteJson(this->fileName);
+    }
+
+    /// \brief Path of the file to write.
+    std::string fileName;
+
+    /// \brief The trace, or nullptr.
+    std::shared_ptr<LoadTrace> trace;
+  };
+
+  static EnvironmentTrace environmentTrace;
+  return environmentTrace.trace;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "sdf/LoadTrace.hh"
+
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(LoadTrace, Construction)
+{
+  sdf::LoadTrace trace;
+  EXPECT_EQ(0u, trace.EventCount());
+  EXPECT_EQ(0u, trace.EventCount("readFile"));
+
+  std::ostringstream json;
+  trace.WriteJson(json);
+  EXPECT_EQ("{\"traceEvents\":[\n],\"displayTimeUnit\":\"ms\"}\n",
+            json.str());
+}
+
+/////////////////////////////////////////////////
+TEST(LoadTrace, Record)
+{
+  sdf::LoadTrace trace;
+  const auto start = std::chrono::steady_clock::now();
+  trace.Record("readFile", "parser", start, 1500ns, "a \"quoted\"\\path");
+  trace.Record("Model::Load", "dom", start + 2us, 250ns);
+  std::thread([&]()
+  {
+    trace.Record("Model::Load", "dom", start, 1us);
+  }).join();
+
+  EXPECT_EQ(3u, trace.EventCount());
+  EXPECT_EQ(1u, trace.EventCount("readFile"));
+  EXPECT_EQ(2u, trace.EventCount("Model::Load"));
+  EXPECT_EQ(0u, trace.EventCount("include"));
+
+  std::ostringstream json;
+  trace.WriteJson(json);
+  const std::string str = json.str();
+  EXPECT_NE(std::string::npos, str.find(
+      "{\"name\":\"readFile\",\"cat\":\"parser\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, str.find("\"dur\":1.500,\"pid\":1,\"tid\":1"));
+  EXPECT_NE(std::string::npos,
+            str.find("\"args\":{\"detail\":\"a \\\"quoted\\\"\\\\path\"}"));
+  EXPECT_NE(std::string::npos, str.find("\"dur\":0.250,\"pid\":1,\"tid\":1}"));
+  EXPECT_NE(std::string::npos, str.find("\"dur\":1.000,\"pid\":1,\"tid\":2}"));
+
+  trace.Reset();
+  EXPECT_EQ(0u, trace.EventCount());
+}
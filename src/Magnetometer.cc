@@ -18,6 +18,7 @@
 #include <string>
 #include "sdf/Magnetometer.hh"
 #include "sdf/parser.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
@@ -42,7 +43,7 @@ Errors Magnetometer::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <magnetometer> element.
   // This is an error that cannot be recovered, so return an error.
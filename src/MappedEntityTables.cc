@@ -0,0 +1,793 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "sdf/Filesystem.hh"
+#include "sdf/MappedEntityTables.hh"
+
+using namespace sdf;
+
+namespace
+{
+/// \brief First word of a file, "SDFETBL" followed by a NUL.
+constexpr char kMagic[8] = {'S', 'D', 'F', 'E', 'T', 'B', 'L', '\0'};
+
+/// \brief Version of the layout of the files. Increment it when the layout
+/// changes.
+constexpr std::uint64_t kFormatVersion = 1;
+
+/// \brief Word that reads differently with another byte order.
+constexpr std::uint64_t kByteOrder = 0x0102030405060708u;
+
+/// \brief Number of tables.
+constexpr std::size_t kTableCount = 5;
+
+/// \brief Columns of the tables, in the order they are stored.
+enum Column : std::size_t
+{
+  MODEL_NAMES,
+  MODEL_PARENTS,
+  MODEL_POSES,
+  LINK_NAMES,
+  LINK_MODELS,
+  LINK_INERTIALS,
+  LINK_POSES,
+  COLLISION_NAMES,
+  COLLISION_LINKS,
+  COLLISION_TYPES,
+  COLLISION_PARAMETERS,
+  COLLISION_POSES,
+  JOINT_NAMES,
+  JOINT_MODELS,
+  JOINT_TYPES,
+  JOINT_PARENT_LINKS,
+  JOINT_CHILD_LINKS,
+  JOINT_POSES,
+  SENSOR_NAMES,
+  SENSOR_LINKS,
+  SENSOR_JOINTS,
+  SENSOR_TYPES,
+  SENSOR_UPDATE_RATES,
+  SENSOR_POSES,
+  COLUMN_COUNT
+};
+
+/// \brief Layout of a column.
+struct ColumnLayout
+{
+  /// \brief Table of the column.
+  MappedEntityTables::Table table;
+
+  /// \brief Number of 8-byte words stored per entity. Name columns store
+  /// the offset of each name in the strings, and one more offset for the
+  /// end of the last name.
+  std::size_t words;
+
+  /// \brief True for a column of names.
+  bool names;
+};
+
+using Table = MappedEntityTables::Table;
+
+/// \brief Layout of each column, by Column.
+constexpr ColumnLayout kColumns[COLUMN_COUNT] = {
+  {Table::MODELS, 1, true},
+  {Table::MODELS, 1, false},
+  {Table::MODELS, 7, false},
+  {Table::LINKS, 1, true},
+  {Table::LINKS, 1, false},
+  {Table::LINKS, 14, false},
+  {Table::LINKS, 7, false},
+  {Table::COLLISIONS, 1, true},
+  {Table::COLLISIONS, 1, false},
+  {Table::COLLISIONS, 1, false},
+  {Table::COLLISIONS, 3, false},
+  {Table::COLLISIONS, 7, false},
+  {Table::JOINTS, 1, true},
+  {Table::JOINTS, 1, false},
+  {Table::JOINTS, 1, false},
+  {Table::JOINTS, 1, false},
+  {Table::JOINTS, 1, false},
+  {Table::JOINTS, 7, false},
+  {Table::SENSORS, 1, true},
+  {Table::SENSORS, 1, false},
+  {Table::SENSORS, 1, false},
+  {Table::SENSORS, 1, false},
+  {Table::SENSORS, 1, false},
+  {Table::SENSORS, 7, false},
+};
+
+/// \brief Column of the names of each table, by Table.
+constexpr Column kNameColumns[kTableCount] = {
+  MODEL_NAMES, LINK_NAMES, COLLISION_NAMES, JOINT_NAMES, SENSOR_NAMES};
+
+/// \brief Column of the poses of each table, by Table.
+constexpr Column kPoseColumns[kTableCount] = {
+  MODEL_POSES, LINK_POSES, COLLISION_POSES, JOINT_POSES, SENSOR_POSES};
+
+/// \brief Header of a file, which is followed by the columns and then the
+/// strings. All offsets are in bytes from the start of the file.
+struct Header
+{
+  /// \brief kMagic.
+  char magic[8];
+
+  /// \brief kFormatVersion.
+  std::uint64_t formatVersion;
+
+  /// \brief kByteOrder.
+  std::uint64_t byteOrder;
+
+  /// \brief Size of the file.
+  std::uint64_t fileSize;
+
+  /// \brief Number of entities of each table, by Table.
+  std::uint64_t counts[kTableCount];
+
+  /// \brief Offset of each column, by Column.
+  std::uint64_t columns[COLUMN_COUNT];
+
+  /// \brief Offset of the strings.
+  std::uint64_t strings;
+
+  /// \brief Size of the strings.
+  std::uint64_t stringsSize;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the index of a table.
+/// \param[in] _table The table.
+/// \return Index of the table.
+std::size_t tableIndex(Table _table)
+{
+  return static_cast<std::size_t>(_table);
+}
+
+/////////////////////////////////////////////////
+/// \brief Number of words of a column.
+/// \param[in] _column The column.
+/// \param[in] _counts Number of entities of each table, which must be the
+/// sizes of tables in memory.
+/// \return Number of 8-byte words.
+std::uint64_t columnWords(Column _column,
+    const std::uint64_t (&_counts)[kTableCount])
+{
+  const ColumnLayout &layout = kColumns[_column];
+  const std::uint64_t count = _counts[tableIndex(layout.table)];
+  return layout.names ? count + 1 : count * layout.words;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether the words of a column fit in a number of bytes.
+/// The counts come from a file, so the number of words is not computed,
+/// since it can overflow.
+/// \param[in] _column The column.
+/// \param[in] _counts Number of entities of each table.
+/// \param[in] _available Number of bytes available for the column.
+/// \return True if the column fits.
+bool columnFits(Column _column, const std::uint64_t (&_counts)[kTableCount],
+    std::uint64_t _available)
+{
+  const ColumnLayout &layout = kColumns[_column];
+  const std::uint64_t count = _counts[tableIndex(layout.table)];
+  const std::uint64_t availableWords = _available / sizeof(std::uint64_t);
+  return layout.names ? count < availableWords :
+      count <= availableWords / layout.words;
+}
+
+/// \brief Buffer that a file is written to.
+struct Writer
+{
+  /// \brief Append a word.
+  /// \param[in] _value The word.
+  void U64(std::uint64_t _value)
+  {
+    this->words.push_back(_value);
+  }
+
+  /// \brief Append a double as a word.
+  /// \param[in] _value The double.
+  void Double(double _value)
+  {
+    std::uint64_t word;
+    std::memcpy(&word, &_value, sizeof(word));
+    this->words.push_back(word);
+  }
+
+  /// \brief Append a pose as 7 words: the position, then the rotation
+  /// w, x, y and z.
+  /// \param[in] _pose The pose.
+  void Pose(const ignition::math::Pose3d &_pose)
+  {
+    this->Double(_pose.Pos().X());
+    this->Double(_pose.Pos().Y());
+    this->Double(_pose.Pos().Z());
+    this->Double(_pose.Rot().W());
+    this->Double(_pose.Rot().X());
+    this->Double(_pose.Rot().Y());
+    this->Double(_pose.Rot().Z());
+  }
+
+  /// \brief Append a vector as 3 words.
+  /// \param[in] _vector The vector.
+  void Vector(const ignition::math::Vector3d &_vector)
+  {
+    this->Double(_vector.X());
+    this->Double(_vector.Y());
+    this->Double(_vector.Z());
+  }
+
+  /// \brief Append the offsets of names, and add the names to the strings.
+  /// \param[in] _names The names.
+  void Names(const std::vector<std::string> &_names)
+  {
+    for (const std::string &name : _names)
+    {
+      this->U64(this->strings.size());
+      this->strings += name;
+    }
+    this->U64(this->strings.size());
+  }
+
+  /// \brief Start a column.
+  /// \param[in] _column The column.
+  void Start(Column _column)
+  {
+    this->columns[_column] = this->words.size() * sizeof(std::uint64_t);
+  }
+
+  /// \brief Words of the columns.
+  std::vector<std::uint64_t> words;
+
+  /// \brief Offset of each column from the first column.
+  std::uint64_t columns[COLUMN_COUNT] = {};
+
+  /// \brief The names, one after the other.
+  std::string strings;
+};
+}
+
+/// \brief Private data of MappedEntityTables.
+class MappedEntityTables::Implementation
+{
+  /// \brief Destructor, unmapping the file.
+  public: ~Implementation()
+  {
+    this->Unmap();
+  }
+
+  /// \brief Unmap the file and forget the columns.
+  public: void Unmap()
+  {
+#ifndef _WIN32
+    if (this->mapped)
+      ::munmap(const_cast<unsigned char *>(this->data), this->size);
+    this->mapped = false;
+#endif
+    this->buffer.clear();
+    this->buffer.shrink_to_fit();
+    this->data = nullptr;
+    this->size = 0;
+    for (std::uint64_t &count : this->counts)
+      count = 0;
+  }
+
+  /// \brief Check the header and the columns of the data.
+  /// \return True if the data is a valid file.
+  public: bool Parse()
+  {
+    Header header;
+    if (this->size < sizeof(header))
+      return false;
+    std::memcpy(&header, this->data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.formatVersion != kFormatVersion ||
+        header.byteOrder != kByteOrder || header.fileSize != this->size ||
+        header.strings > this->size ||
+        header.stringsSize > this->size - header.strings)
+    {
+      return false;
+    }
+
+    for (std::size_t c = 0; c < COLUMN_COUNT; ++c)
+    {
+      const Column column = static_cast<Column>(c);
+      const std::uint64_t offset = header.columns[c];
+      const std::uint64_t available =
+          offset <= header.strings ? header.strings - offset : 0;
+      if (offset < sizeof(header) || offset % sizeof(std::uint64_t) != 0 ||
+          !columnFits(column, header.counts, available))
+      {
+        return false;
+      }
+      this->columns[c] = this->data + offset;
+    }
+    this->strings = reinterpret_cast<const char *>(this->data) +
+        header.strings;
+
+    // The names are checked once here, so that reading them does not
+    // check them. Their columns fit in the file, so the counts are less
+    // than the number of words of the file and the loops end.
+    for (std::size_t t = 0; t < kTableCount; ++t)
+    {
+      std::uint64_t previous = 0;
+      for (std::uint64_t i = 0; i <= header.counts[t]; ++i)
+      {
+        const std::uint64_t offset = this->Word(kNameColumns[t], i);
+        if (offset < previous || offset > header.stringsSize)
+          return false;
+        previous = offset;
+      }
+    }
+
+    for (std::size_t t = 0; t < kTableCount; ++t)
+      this->counts[t] = header.counts[t];
+    return true;
+  }
+
+  /// \brief Read a word of a column.
+  /// \param[in] _column The column.
+  /// \param[in] _index Index of the word in the column.
+  /// \return The word.
+  public: std::uint64_t Word(Column _column, std::uint64_t _index) const
+  {
+    std::uint64_t word;
+    std::memcpy(&word, this->columns[_column] + _index * sizeof(word),
+                sizeof(word));
+    return word;
+  }
+
+  /// \brief Read a double of a column.
+  /// \param[in] _column The column.
+  /// \param[in] _index Index of the word in the column.
+  /// \return The double.
+  public: double Double(Column _column, std::uint64_t _index) const
+  {
+    double value;
+    std::memcpy(&value, this->columns[_column] + _index * sizeof(value),
+                sizeof(value));
+    return value;
+  }
+
+  /// \brief Read a pose stored at a word of a column.
+  /// \param[in] _column The column.
+  /// \param[in] _index Index of the first word of the pose.
+  /// \return The pose.
+  public: ignition::math::Pose3d PoseAt(Column _column,
+                                        std::uint64_t _index) const
+  {
+    return ignition::math::Pose3d(
+        this->Double(_column, _index), this->Double(_column, _index + 1),
+        this->Double(_column, _index + 2), this->Double(_column, _index + 3),
+        this->Double(_column, _index + 4), this->Double(_column, _index + 5),
+        this->Double(_column, _index + 6));
+  }
+
+  /// \brief Start of the file.
+  public: const unsigned char *data = nullptr;
+
+  /// \brief Size of the file.
+  public: std::size_t size = 0;
+
+#ifndef _WIN32
+  /// \brief True if data is mapped, false if it points into buffer.
+  public: bool mapped = false;
+#endif
+
+  /// \brief Contents of the file on platforms without memory mapping.
+  public: std::string buffer;
+
+  /// \brief Number of entities of each table, by Table.
+  public: std::uint64_t counts[kTableCount] = {};
+
+  /// \brief Start of each column, by Column.
+  public: const unsigned char *columns[COLUMN_COUNT] = {};
+
+  /// \brief Start of the strings.
+  public: const char *strings = nullptr;
+};
+
+/////////////////////////////////////////////////
+MappedEntityTables::MappedEntityTables()
+  : dataPtr(ignition::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+bool MappedEntityTables::Write(const std::string &_path,
+    const EntityTables &_tables)
+{
+  Writer out;
+
+  out.Start(MODEL_NAMES);
+  out.Names(_tables.models.names);
+  out.Start(MODEL_PARENTS);
+  for (uint64_t parent : _tables.models.parents)
+    out.U64(parent);
+  out.Start(MODEL_POSES);
+  for (const auto &pose : _tables.models.poses)
+    out.Pose(pose);
+
+  out.Start(LINK_NAMES);
+  out.Names(_tables.links.names);
+  out.Start(LINK_MODELS);
+  for (uint64_t model : _tables.links.models)
+    out.U64(model);
+  out.Start(LINK_INERTIALS);
+  for (const auto &inertial : _tables.links.inertials)
+  {
+    const auto &massMatrix = inertial.MassMatrix();
+    out.Double(massMatrix.Mass());
+    out.Vector(massMatrix.DiagonalMoments());
+    out.Vector(massMatrix.OffDiagonalMoments());
+    out.Pose(inertial.Pose());
+  }
+  out.Start(LINK_POSES);
+  for (const auto &pose : _tables.links.poses)
+    out.Pose(pose);
+
+  out.Start(COLLISION_NAMES);
+  out.Names(_tables.collisions.names);
+  out.Start(COLLISION_LINKS);
+  for (uint64_t link : _tables.collisions.links)
+    out.U64(link);
+  out.Start(COLLISION_TYPES);
+  for (GeometryType type : _tables.collisions.geometryTypes)
+    out.U64(static_cast<std::uint64_t>(type));
+  out.Start(COLLISION_PARAMETERS);
+  for (const auto &parameters : _tables.collisions.geometryParameters)
+    out.Vector(parameters);
+  out.Start(COLLISION_POSES);
+  for (const auto &pose : _tables.collisions.poses)
+    out.Pose(pose);
+
+  out.Start(JOINT_NAMES);
+  out.Names(_tables.joints.names);
+  out.Start(JOINT_MODELS);
+  for (uint64_t model : _tables.joints.models)
+    out.U64(model);
+  out.Start(JOINT_TYPES);
+  for (sdf::JointType type : _tables.joints.types)
+    out.U64(static_cast<std::uint64_t>(type));
+  out.Start(JOINT_PARENT_LINKS);
+  for (uint64_t link : _tables.joints.parentLinks)
+    out.U64(link);
+  out.Start(JOINT_CHILD_LINKS);
+  for (uint64_t link : _tables.joints.childLinks)
+    out.U64(link);
+  out.Start(JOINT_POSES);
+  for (const auto &pose : _tables.joints.poses)
+    out.Pose(pose);
+
+  out.Start(SENSOR_NAMES);
+  out.Names(_tables.sensors.names);
+  out.Start(SENSOR_LINKS);
+  for (uint64_t link : _tables.sensors.links)
+    out.U64(link);
+  out.Start(SENSOR_JOINTS);
+  for (uint64_t joint : _tables.sensors.joints)
+    out.U64(joint);
+  out.Start(SENSOR_TYPES);
+  for (sdf::SensorType type : _tables.sensors.types)
+    out.U64(static_cast<std::uint64_t>(type));
+  out.Start(SENSOR_UPDATE_RATES);
+  for (double rate : _tables.sensors.updateRates)
+    out.Double(rate);
+  out.Start(SENSOR_POSES);
+  for (const auto &pose : _tables.sensors.poses)
+    out.Pose(pose);
+
+  Header header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.formatVersion = kFormatVersion;
+  header.byteOrder = kByteOrder;
+  header.counts[tableIndex(Table::MODELS)] = _tables.models.names.size();
+  header.counts[tableIndex(Table::LINKS)] = _tables.links.names.size();
+  header.counts[tableIndex(Table::COLLISIONS)] =
+      _tables.collisions.names.size();
+  header.counts[tableIndex(Table::JOINTS)] = _tables.joints.names.size();
+  header.counts[tableIndex(Table::SENSORS)] = _tables.sensors.names.size();
+
+  // The columns of a table have to be as long as its names.
+  for (std::size_t c = 0; c < COLUMN_COUNT; ++c)
+  {
+    const Column column = static_cast<Column>(c);
+    const std::uint64_t end = c + 1 < COLUMN_COUNT ?
+        out.columns[c + 1] : out.words.size() * sizeof(std::uint64_t);
+    if (end - out.columns[c] !=
+        columnWords(column, header.counts) * sizeof(std::uint64_t))
+    {
+      return false;
+    }
+    header.columns[c] = sizeof(header) + out.columns[c];
+  }
+  header.strings = sizeof(header) + out.words.size() * sizeof(std::uint64_t);
+  header.stringsSize = out.strings.size();
+  header.fileSize = header.strings + header.stringsSize;
+
+  // Write to a temporary file first, so that processes opening the file
+  // never see a partially written file, and processes that have it mapped
+  // keep the previous one.
+  const std::string tmpFile = _path + ".tmp";
+  {
+    std::ofstream file(tmpFile, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char *>(&header), sizeof(header)) ||
+        !file.write(reinterpret_cast<const char *>(out.words.data()),
+                    static_cast<std::streamsize>(
+                        out.words.size() * sizeof(std::uint64_t))) ||
+        !file.write(out.strings.data(),
+                    static_cast<std::streamsize>(out.strings.size())))
+    {
+      return false;
+    }
+  }
+
+  if (!filesystem::rename(tmpFile, _path))
+  {
+    filesystem::remove(tmpFile);
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool MappedEntityTables::Open(const std::string &_path)
+{
+  this->Close();
+  Implementation &impl = *this->dataPtr;
+
+#ifndef _WIN32
+  const int fd = ::open(_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat status;
+  if (::fstat(fd, &status) != 0 || status.st_size <= 0)
+  {
+    ::close(fd);
+    return false;
+  }
+  const std::size_t size = static_cast<std::size_t>(status.st_size);
+  void *addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED)
+    return false;
+  impl.data = static_cast<const unsigned char *>(addr);
+  impl.size = size;
+  impl.mapped = true;
+#else
+  {
+    std::ifstream file(_path, std::ios::binary);
+    if (!file)
+      return false;
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    impl.buffer = contents.str();
+  }
+  impl.data = reinterpret_cast<const unsigned char *>(impl.buffer.data());
+  impl.size = impl.buffer.size();
+#endif
+
+  if (!impl.Parse())
+  {
+    this->Close();
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void MappedEntityTables::Close()
+{
+  this->dataPtr->Unmap();
+}
+
+/////////////////////////////////////////////////
+bool MappedEntityTables::Valid() const
+{
+  return nullptr != this->dataPtr->data;
+}
+
+/////////////////////////////////////////////////
+uint64_t MappedEntityTables::Count(Table _table) const
+{
+  return this->dataPtr->counts[tableIndex(_table)];
+}
+
+/////////////////////////////////////////////////
+std::string_view MappedEntityTables::Name(Table _table,
+    uint64_t _index) const
+{
+  const Column column = kNameColumns[tableIndex(_table)];
+  const std::uint64_t begin = this->dataPtr->Word(column, _index);
+  const std::uint64_t end = this->dataPtr->Word(column, _index + 1);
+  return std::string_view(this->dataPtr->strings + begin,
+                          static_cast<std::size_t>(end - begin));
+}
+
+/////////////////////////////////////////////////
+ignition::math::Pose3d MappedEntityTables::Pose(Table _table,
+    uint64_t _index) const
+{
+  return this->dataPtr->PoseAt(kPoseColumns[tableIndex(_table)], _index * 7);
+}
+
+/////////////////////////////////////////////////
+uint64_t MappedEntityTables::ModelParent(uint64_t _index) const
+{
+  return this->dataPtr->Word(MODEL_PARENTS, _index);
+}
+
+/////////////////////////////////////////////////
+uint64_t MappedEntityTables::LinkModel(uint64_t _index) const
+{
+  return this->dataPtr->Word(LINK_MODELS, _index);
+}
+
+/////////////////////////////////////////////////
+ignition::math::Inertiald MappedEntityTables::LinkInertial(
+    uint64_t _index) const
+{
+  const Implementation &impl = *this->dataPtr;
+  const std::uint64_t first = _index * 14;
+  const ignition::math::MassMatrix3d massMatrix(
+      impl.Double(LINK_INERTIALS, first),
+      ignition::math::Vector3d(impl.Double(LINK_INERTIALS, first + 1),
+                               impl.Double(LINK_INERTIALS, first + 2),
+                               impl.Double(LINK_INERTIALS, first + 3)),
+      ignition::math::Vector3d(impl.Double(LINK_INERTIALS, first + 4),
+                               impl.Double(LINK_INERTIALS, first + 5),
+                               impl.Double(LINK_INERTIALS, first + 6)));
+  return ignition::math::Inertiald(massMatrix,
+      impl.PoseAt(LINK_INERTIALS, first + 7));
+}
+
+/////////////////////////////////////////////////
+uint64_t MappedEntityTables::CollisionLink(uint64_t _index) const
+{
+  return this->dataPtr->Word(COLLISION_LINKS, _index);
+}
+
+/////////////////////////////////////////////////
+GeometryType MappedEntityTables::CollisionGeometryType(uint64_t _index) const
+{
+  return static_cast<GeometryType>(
+      this->dataPtr->Word(COLLISION_TYPES, _index));
+}
+
+/////////////////////////////////////////////////
+ignition::math::Vector3d MappedEntityTables::CollisionGeometryParameters(
+    uint64_t _index) const
+{
+  const std::uint64_t first = _index * 3;
+  return ignition::math::Vector3d(
+      this->dataPtr->Double(COLLISION_PARAMETERS, first),
+      this->dataPtr->Double(COLLISION_PARAMETERS, first + 1),
+      this->dataPtr->Double(COLLISION_PARAMETERS, first + 2));
+}
+
+/////////////////////////////////////////////////
+uint64_t MappedEntityTables::JointModel(uint64_t _index) const
+{
+  return this->dataPtr->Word(JOINT_MODELS, _index);
+}
+
+/////////////////////////////////////////////////
+sdf::JointType MappedEntityTables::JointType(uint64_t _index) const
+{
+  return static_cast<sdf::JointType>(
+      this->dataPtr->Word(JOINT_TYPES, _index));
+}
+
+/////////////////////////////////////////////////
+uint64_t MappedEntityTables::JointParentLink(uint64_t _index) const
+{
+  return this->dataPtr->Word(JOINT_PARENT_LINKS, _index);
+}
+
+/////////////////////////////////////////////////
+uint64_t MappedEntityTables::JointChildLink(uint64_t _index) const
+{
+  return this->dataPtr->Word(JOINT_CHILD_LINKS, _index);
+}
+
+/////////////////////////////////////////////////
+uint64_t MappedEntityTables::SensorLink(uint64_t _index) const
+{
+  return this->dataPtr->Word(SENSOR_LINKS, _index);
+}
+
+/////////////////////////////////////////////////
+uint64_t MappedEntityTables::SensorJoint(uint64_t _index) const
+{
+  return this->dataPtr->Word(SENSOR_JOINTS, _index);
+}
+
+/////////////////////////////////////////////////
+sdf::SensorType MappedEntityTables::SensorType(uint64_t _index) const
+{
+  return static_cast<sdf::SensorType>(
+      this->dataPtr->Word(SENSOR_TYPES, _index));
+}
+
+/////////////////////////////////////////////////
+double MappedEntityTables::SensorUpdateRate(uint64_t _index) const
+{
+  return this->dataPtr->Double(SENSOR_UPDATE_RATES, _index);
+}
+
+/////////////////////////////////////////////////
+void MappedEntityTables::CopyTo(EntityTables &_tables) const
+{
+  _tables = EntityTables();
+
+  for (uint64_t i = 0; i < this->Count(Table::MODELS); ++i)
+  {
+    _tables.models.names.emplace_back(this->Name(Table::MODELS, i));
+    _tables.models.parents.push_back(this->ModelParent(i));
+    _tables.models.poses.push_back(this->Pose(Table::MODELS, i));
+  }
+
+  for (uint64_t i = 0; i < this->Count(Table::LINKS); ++i)
+  {
+    _tables.links.names.emplace_back(this->Name(Table::LINKS, i));
+    _tables.links.models.push_back(this->LinkModel(i));
+    _tables.links.inertials.push_back(this->LinkInertial(i));
+    _tables.links.poses.push_back(this->Pose(Table::LINKS, i));
+  }
+
+  for (uint64_t i = 0; i < this->Count(Table::COLLISIONS); ++i)
+  {
+    _tables.collisions.names.emplace_back(this->Name(Table::COLLISIONS, i));
+    _tables.collisions.links.push_back(this->CollisionLink(i));
+    _tables.collisions.geometryTypes.push_back(
+        this->CollisionGeometryType(i));
+    _tables.collisions.geometryParameters.push_back(
+        this->CollisionGeometryParameters(i));
+    _tables.collisions.poses.push_back(this->Pose(Table::COLLISIONS, i));
+  }
+
+  for (uint64_t i = 0; i < this->Count(Table::JOINTS); ++i)
+  {
+    _tables.joints.names.emplace_back(this->Name(Table::JOINTS, i));
+    _tables.joints.models.push_back(this->JointModel(i));
+    _tables.joints.types.push_back(this->JointType(i));
+    _tables.joints.parentLinks.push_back(this->JointParentLink(i));
+    _tables.joints.childLinks.push_back(this->JointChildLink(i));
+    _tables.joints.poses.push_back(this->Pose(Table::JOINTS, i));
+  }
+
+  for (uint64_t i = 0; i < this->Count(Table::SENSORS); ++i)
+  {
+    _tables.sensors.names.emplace_back(this->Name(Table::SENSORS, i));
+    _tables.sensors.links.push_back(this->SensorLink(i));
+    _tables.sensors.joints.push_back(this->SensorJoint(i));
+    _tables.sensors.types.push_back(this->SensorType(i));
+    _tables.sensors.updateRates.push_back(this->SensorUpdateRate(i));
+    _tables.sensors.poses.push_back(this->Pose(Table::SENSORS, i));
+  }
+}
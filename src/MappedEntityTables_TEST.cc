@@ -0,0 +1,223 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+
+#include "sdf/EntityTables.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/MappedEntityTables.hh"
+#include "sdf/Root.hh"
+#include "sdf/World.hh"
+#include "test_config.h"
+
+using Table = sdf::MappedEntityTables::Table;
+
+/////////////////////////////////////////////////
+/// \brief Resolve the tables of a world with every kind of entity.
+/// \param[out] _tables The tables.
+void resolveTables(sdf::EntityTables &_tables)
+{
+  const std::string sdfString = R"(
+  <sdf version='1.8'>
+    <world name='default'>
+      <model name='robot'>
+        <pose>1 0 0 0 0 0</pose>
+        <link name='base'>
+          <inertial>
+            <mass>2</mass>
+            <inertia>
+              <ixx>1</ixx><iyy>2</iyy><izz>3</izz>
+            </inertia>
+          </inertial>
+          <collision name='box'>
+            <geometry>
+              <box><size>1 2 3</size></box>
+            </geometry>
+          </collision>
+          <sensor name='imu' type='imu'>
+            <update_rate>100</update_rate>
+          </sensor>
+        </link>
+        <link name='arm'>
+          <pose>0 0 1 0 0 0</pose>
+        </link>
+        <joint name='elbow' type='revolute'>
+          <parent>base</parent>
+          <child>arm</child>
+          <axis><xyz>0 0 1</xyz></axis>
+        </joint>
+        <model name='camera'>
+          <link name='body'/>
+        </model>
+      </model>
+    </world>
+  </sdf>)";
+
+  sdf::Root root;
+  ASSERT_TRUE(root.LoadSdfString(sdfString).empty());
+  ASSERT_NE(nullptr, root.WorldByIndex(0));
+  ASSERT_TRUE(root.WorldByIndex(0)->ResolveEntityTables(_tables).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(MappedEntityTables, WriteAndOpen)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string dir = sdf::filesystem::append(tmpDir, "mapped_tables");
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const std::string path = sdf::filesystem::append(dir, "world.tables");
+
+  sdf::EntityTables tables;
+  resolveTables(tables);
+  ASSERT_EQ(2u, tables.models.names.size());
+  ASSERT_TRUE(sdf::MappedEntityTables::Write(path, tables));
+  EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+
+  sdf::MappedEntityTables mapped;
+  EXPECT_FALSE(mapped.Valid());
+  ASSERT_TRUE(mapped.Open(path));
+  EXPECT_TRUE(mapped.Valid());
+
+  ASSERT_EQ(2u, mapped.Count(Table::MODELS));
+  EXPECT_EQ("robot", mapped.Name(Table::MODELS, 0));
+  EXPECT_EQ("camera", mapped.Name(Table::MODELS, 1));
+  EXPECT_EQ(sdf::EntityTables::kNoIndex, mapped.ModelParent(0));
+  EXPECT_EQ(0u, mapped.ModelParent(1));
+  EXPECT_EQ(tables.models.poses[0], mapped.Pose(Table::MODELS, 0));
+
+  ASSERT_EQ(3u, mapped.Count(Table::LINKS));
+  for (uint64_t i = 0; i < mapped.Count(Table::LINKS); ++i)
+  {
+    EXPECT_EQ(tables.links.names[i], mapped.Name(Table::LINKS, i));
+    EXPECT_EQ(tables.links.models[i], mapped.LinkModel(i));
+    EXPECT_EQ(tables.links.inertials[i], mapped.LinkInertial(i));
+    EXPECT_EQ(tables.links.poses[i], mapped.Pose(Table::LINKS, i));
+  }
+  EXPECT_DOUBLE_EQ(2.0, mapped.LinkInertial(0).MassMatrix().Mass());
+
+  ASSERT_EQ(1u, mapped.Count(Table::COLLISIONS));
+  EXPECT_EQ("box", mapped.Name(Table::COLLISIONS, 0));
+  EXPECT_EQ(tables.collisions.links[0], mapped.CollisionLink(0));
+  EXPECT_EQ(sdf::GeometryType::BOX, mapped.CollisionGeometryType(0));
+  EXPECT_EQ(ignition::math::Vector3d(1, 2, 3),
+            mapped.CollisionGeometryParameters(0));
+
+  ASSERT_EQ(1u, mapped.Count(Table::JOINTS));
+  EXPECT_EQ("elbow", mapped.Name(Table::JOINTS, 0));
+  EXPECT_EQ(0u, mapped.JointModel(0));
+  EXPECT_EQ(sdf::JointType::REVOLUTE, mapped.JointType(0));
+  EXPECT_EQ(tables.joints.parentLinks[0], mapped.JointParentLink(0));
+  EXPECT_EQ(tables.joints.childLinks[0], mapped.JointChildLink(0));
+
+  ASSERT_EQ(1u, mapped.Count(Table::SENSORS));
+  EXPECT_EQ("imu", mapped.Name(Table::SENSORS, 0));
+  EXPECT_EQ(tables.sensors.links[0], mapped.SensorLink(0));
+  EXPECT_EQ(sdf::EntityTables::kNoIndex, mapped.SensorJoint(0));
+  EXPECT_EQ(sdf::SensorType::IMU, mapped.SensorType(0));
+  EXPECT_DOUBLE_EQ(100.0, mapped.SensorUpdateRate(0));
+
+  // The tables can be copied out of the file.
+  sdf::EntityTables copy;
+  mapped.CopyTo(copy);
+  EXPECT_EQ(tables.models.names, copy.models.names);
+  EXPECT_EQ(tables.models.parents, copy.models.parents);
+  EXPECT_EQ(tables.models.poses, copy.models.poses);
+  EXPECT_EQ(tables.links.names, copy.links.names);
+  EXPECT_EQ(tables.links.inertials, copy.links.inertials);
+  EXPECT_EQ(tables.collisions.geometryTypes, copy.collisions.geometryTypes);
+  EXPECT_EQ(tables.collisions.geometryParameters,
+            copy.collisions.geometryParameters);
+  EXPECT_EQ(tables.joints.types, copy.joints.types);
+  EXPECT_EQ(tables.joints.childLinks, copy.joints.childLinks);
+  EXPECT_EQ(tables.sensors.types, copy.sensors.types);
+  EXPECT_EQ(tables.sensors.updateRates, copy.sensors.updateRates);
+
+  // Replacing the file does not change the tables that are open.
+  ASSERT_TRUE(sdf::MappedEntityTables::Write(path, sdf::EntityTables()));
+  EXPECT_EQ("robot", mapped.Name(Table::MODELS, 0));
+
+  ASSERT_TRUE(mapped.Open(path));
+  EXPECT_EQ(0u, mapped.Count(Table::MODELS));
+  EXPECT_EQ(0u, mapped.Count(Table::SENSORS));
+
+  mapped.Close();
+  EXPECT_FALSE(mapped.Valid());
+  EXPECT_EQ(0u, mapped.Count(Table::LINKS));
+}
+
+/////////////////////////////////////////////////
+TEST(MappedEntityTables, InvalidFiles)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string dir =
+      sdf::filesystem::append(tmpDir, "mapped_tables_invalid");
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const std::string path = sdf::filesystem::append(dir, "world.tables");
+
+  sdf::MappedEntityTables mapped;
+  EXPECT_FALSE(mapped.Open(path));
+  EXPECT_FALSE(mapped.Valid());
+
+  // A file that is not a table file.
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "<sdf version='1.8'><world name='default'/></sdf>";
+  }
+  EXPECT_FALSE(mapped.Open(path));
+  EXPECT_FALSE(mapped.Valid());
+
+  // A truncated file.
+  sdf::EntityTables tables;
+  resolveTables(tables);
+  ASSERT_TRUE(sdf::MappedEntityTables::Write(path, tables));
+  const auto size = std::filesystem::file_size(path);
+  std::filesystem::resize_file(path, size - 1);
+  EXPECT_FALSE(mapped.Open(path));
+  EXPECT_FALSE(mapped.Valid());
+
+  // Counts so large that the number of words of their columns overflows.
+  // The counts follow the magic number, the format version, the byte order
+  // and the file size.
+  for (const std::uint64_t count :
+       {std::numeric_limits<std::uint64_t>::max(),
+        std::numeric_limits<std::uint64_t>::max() / 7 + 1})
+  {
+    ASSERT_TRUE(sdf::MappedEntityTables::Write(path, tables));
+    {
+      std::fstream file(path,
+          std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(4 * sizeof(std::uint64_t));
+      file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    }
+    EXPECT_FALSE(mapped.Open(path)) << count;
+    EXPECT_FALSE(mapped.Valid());
+  }
+
+  // Tables whose columns are not as long as their names are not written.
+  tables.links.poses.pop_back();
+  EXPECT_FALSE(sdf::MappedEntityTables::Write(path, tables));
+}
@@ -83,7 +83,7 @@ Errors Material::Load(sdf::ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   this->dataPtr->filePath = _sdf->FilePath();
 
@@ -0,0 +1,337 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+
+#include "sdf/MemoryUsage.hh"
+#include "sdf/Param.hh"
+#include "sdf/Root.hh"
+
+using namespace sdf;
+
+/// \brief Approximate size of the control block of a shared pointer created
+/// from a raw pointer: a virtual table pointer, the use and weak counts and
+/// the owned pointer.
+static constexpr std::uint64_t kControlBlockBytes = 4 * sizeof(void *);
+
+/// \brief Approximate size of a node of an unordered_map, in addition to
+/// its value: the next node pointer and the cached hash.
+static constexpr std::uint64_t kHashNodeBytes = 2 * sizeof(void *);
+
+/////////////////////////////////////////////////
+/// \brief Get the bytes allocated by a string for its characters.
+/// \param[in] _str The string.
+/// \return Zero if the characters are stored in the string object itself,
+/// and the capacity of the string plus its terminator otherwise.
+static std::uint64_t stringHeapBytes(const std::string &_str)
+{
+  static const std::size_t kInlineCapacity = std::string().capacity();
+  return _str.capacity() > kInlineCapacity ? _str.capacity() + 1 : 0;
+}
+
+/// \brief Number and approximate bytes of the elements with a name.
+struct ElementNameUsage
+{
+  /// \brief Number of elements.
+  std::uint64_t count = 0;
+
+  /// \brief Approximate bytes.
+  std::uint64_t bytes = 0;
+};
+
+class sdf::MemoryUsage::Implementation
+{
+  /// \brief Total number of elements.
+  public: std::uint64_t elementCount = 0;
+
+  /// \brief Total number of parameters.
+  public: std::uint64_t paramCount = 0;
+
+  /// \brief Number of references to element descriptions.
+  public: std::uint64_t descriptionReferenceCount = 0;
+
+  /// \brief Total approximate bytes of the elements.
+  public: std::uint64_t bytes = 0;
+
+  /// \brief Total approximate bytes of the element descriptions.
+  public: std::uint64_t descriptionBytes = 0;
+
+  /// \brief Usage by element name.
+  public: std::map<std::string, ElementNameUsage> names;
+
+  /// \brief Elements accounted for.
+  public: std::unordered_set<const Element *> elements;
+
+  /// \brief Element descriptions accounted for.
+  public: std::unordered_set<const Element *> descriptions;
+
+  /// \brief Shared element schemas accounted for.
+  public: std::unordered_set<const ElementSchema *> schemas;
+
+  /// \brief Shared file path strings accounted for.
+  public: std::unordered_set<const std::string *> paths;
+
+  /// \brief Shared XML path nodes accounted for.
+  public: std::unordered_set<const XmlPathNode *> xmlPathNodes;
+};
+
+/////////////////////////////////////////////////
+MemoryUsage::MemoryUsage()
+  : dataPtr(ignition::utils::MakeImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+MemoryUsage::MemoryUsage(const ElementPtr &_elem)
+  : MemoryUsage()
+{
+  this->Add(_elem);
+}
+
+/////////////////////////////////////////////////
+MemoryUsage::MemoryUsage(const Root &_root)
+  : MemoryUsage()
+{
+  this->Add(_root.Element());
+}
+
+/////////////////////////////////////////////////
+void MemoryUsage::Add(const ElementPtr &_elem)
+{
+  auto paramBytes = [](const ParamPtr &_param) -> std::uint64_t
+  {
+    if (!_param)
+      return 0;
+
+    const ParamPrivate &data = *_param->dataPtr;
+    std::uint64_t bytes =
+        sizeof(Param) + sizeof(ParamPrivate) + kControlBlockBytes;
+    if (const auto *str = std::get_if<std::string>(&data.value))
+      bytes += stringHeapBytes(*str);
+    if (data.strValue)
+      bytes += stringHeapBytes(*data.strValue);
+    return bytes;
+  };
+
+  // Bytes of an element and its parameters, excluding its child elements
+  // and its descriptions. A schema shared by several elements is accounted
+  // for with the first of them.
+  auto elementBytes = [&](const Element &_e) -> std::uint64_t
+  {
+    const ElementPrivate &data = *_e.dataPtr;
+    std::uint64_t bytes =
+        sizeof(Element) + sizeof(ElementPrivate) + kControlBlockBytes;
+    if (this->dataPtr->schemas.insert(data.schema.get()).second)
+    {
+      bytes += sizeof(ElementSchema) + kControlBlockBytes +
+          data.schema->elementDescriptions.capacity() * sizeof(ElementPtr);
+    }
+    if (data.extras)
+    {
+      bytes += sizeof(ElementExtras);
+      if (data.extras->rawXml)
+        bytes += stringHeapBytes(*data.extras->rawXml);
+    }
+    bytes += data.elements.capacity() * sizeof(ElementPtr);
+    bytes += data.attributes.capacity() * sizeof(ParamPtr);
+    if (data.elementIndex)
+    {
+      bytes += sizeof(*data.elementIndex) +
+          data.elementIndex->bucket_count() * sizeof(void *);
+      for (const auto &index : *data.elementIndex)
+      {
+        bytes += sizeof(index) + kHashNodeBytes +
+            stringHeapBytes(index.first) +
+            index.second.capacity() * sizeof(ElementPtr);
+      }
+    }
+    for (const auto &attribute : data.attributes)
+      bytes += paramBytes(attribute);
+    bytes += paramBytes(data.value);
+    return bytes;
+  };
+
+  // Queue the descriptions of an element that are not accounted for yet.
+  std::vector<const Element *> pendingDescriptions;
+  auto addDescriptions = [&](const Element &_e)
+  {
+    for (const auto &desc : _e.dataPtr->schema->elementDescriptions)
+    {
+      if (desc && this->dataPtr->descriptions.insert(desc.get()).second)
+        pendingDescriptions.push_back(desc.get());
+    }
+  };
+
+  std::vector<const Element *> pending;
+  if (_elem && this->dataPtr->elements.insert(_elem.get()).second)
+    pending.push_back(_elem.get());
+  while (!pending.empty())
+  {
+    const Element *elem = pending.back();
+    pending.pop_back();
+    const ElementPrivate &data = *elem->dataPtr;
+
+    std::uint64_t bytes = elementBytes(*elem);
+    if (data.path && this->dataPtr->paths.insert(data.path.get()).second)
+      bytes += sizeof(std::string) + kControlBlockBytes +
+          stringHeapBytes(*data.path);
+    for (const XmlPathNode *node = data.xmlPath.get();
+         node && this->dataPtr->xmlPathNodes.insert(node).second;
+         node = node->parent.get())
+    {
+      bytes += sizeof(XmlPathNode) + kControlBlockBytes +
+          stringHeapBytes(node->segment) +
+          stringHeapBytes(node->path);
+    }
+
+    ++this->dataPtr->elementCount;
+    this->dataPtr->paramCount +=
+        data.attributes.size() + (data.value ? 1 : 0);
+    this->dataPtr->bytes += bytes;
+    ElementNameUsage &usage =
+        this->dataPtr->names[data.schema->name.Str()];
+    ++usage.count;
+    usage.bytes += bytes;
+
+    this->dataPtr->descriptionReferenceCount +=
+        data.schema->elementDescriptions.size();
+    addDescriptions(*elem);
+
+    for (const auto &child : data.elements)
+    {
+      if (child && this->dataPtr->elements.insert(child.get()).second)
+        pending.push_back(child.get());
+    }
+    const Element *includeElement =
+        data.extras ? data.extras->includeElement.get() : nullptr;
+    if (includeElement && this->dataPtr->elements.insert(includeElement).second)
+    {
+      pending.push_back(includeElement);
+    }
+  }
+
+  while (!pendingDescriptions.empty())
+  {
+    const Element *desc = pendingDescriptions.back();
+    pendingDescriptions.pop_back();
+    this->dataPtr->descriptionBytes += elementBytes(*desc);
+    addDescriptions(*desc);
+  }
+}
+
+/////////////////////////////////////////////////
+std::uint64_t MemoryUsage::ElementCount() const
+{
+  return this->dataPtr->elementCount;
+}
+
+/////////////////////////////////////////////////
+std::uint64_t MemoryUsage::ElementCount(const std::string &_name) const
+{
+  auto it = this->dataPtr->names.find(_name);
+  return it == this->dataPtr->names.end() ? 0 : it->second.count;
+}
+
+/////////////////////////////////////////////////
+std::uint64_t MemoryUsage::ParamCount() const
+{
+  return this->dataPtr->paramCount;
+}
+
+/////////////////////////////////////////////////
+std::uint64_t MemoryUsage::DescriptionCount() const
+{
+  return this->dataPtr->descriptions.size();
+}
+
+/////////////////////////////////////////////////
+std::uint64_t MemoryUsage::DescriptionReferenceCount() const
+{
+  return this->dataPtr->descriptionReferenceCount;
+}
+
+/////////////////////////////////////////////////
+std::uint64_t MemoryUsage::Bytes() const
+{
+  return this->dataPtr->bytes;
+}
+
+/////////////////////////////////////////////////
+std::uint64_t MemoryUsage::Bytes(const std::string &_name) const
+{
+  auto it = this->dataPtr->names.find(_name);
+  return it == this->dataPtr->names.end() ? 0 : it->second.bytes;
+}
+
+/////////////////////////////////////////////////
+std::uint64_t MemoryUsage::DescriptionBytes() const
+{
+  return this->dataPtr->descriptionBytes;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> MemoryUsage::ElementNames() const
+{
+  std::vector<std::pair<std::uint64_t, std::string>> sorted;
+  sorted.reserve(this->dataPtr->names.size());
+  for (const auto &name : this->dataPtr->names)
+    sorted.emplace_back(name.second.bytes, name.first);
+  // Sort by decreasing bytes, then by name.
+  std::stable_sort(sorted.begin(), sorted.end(),
+      [](const auto &_a, const auto &_b)
+      {
+        return _a.first > _b.first;
+      });
+
+  std::vector<std::string> names;
+  names.reserve(sorted.size());
+  for (auto &name : sorted)
+    names.push_back(std::move(name.second));
+  return names;
+}
+
+/////////////////////////////////////////////////
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE
+{
+std::ostream &operator<<(std::ostream &_out, const MemoryUsage &_usage)
+{
+  _out << "Elements: " << _usage.ElementCount() << "\n"
+       << "Params: " << _usage.ParamCount() << "\n"
+       << "Element descriptions: " << _usage.DescriptionCount()
+       << " distinct, " << _usage.DescriptionReferenceCount()
+       << " references\n"
+       << "Approximate bytes: " << _usage.Bytes() << " (descriptions: "
+       << _usage.DescriptionBytes() << ")\n\n"
+       << std::setw(12) << "Bytes" << std::setw(10) << "Count"
+       << "  Element\n";
+  for (const auto &name : _usage.ElementNames())
+  {
+    _out << std::setw(12) << _usage.Bytes(name)
+         << std::setw(10) << _usage.ElementCount(name)
+         << "  " << name << "\n";
+  }
+  return _out;
+}
+}
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "sdf/Element.hh"
+#include "sdf/MemoryUsage.hh"
+#include "sdf/Model.hh"
+#include "sdf/Root.hh"
+
+/////////////////////////////////////////////////
+TEST(MemoryUsage, Construction)
+{
+  sdf::MemoryUsage usage;
+  EXPECT_EQ(0u, usage.ElementCount());
+  EXPECT_EQ(0u, usage.ParamCount());
+  EXPECT_EQ(0u, usage.DescriptionCount());
+  EXPECT_EQ(0u, usage.DescriptionReferenceCount());
+  EXPECT_EQ(0u, usage.Bytes());
+  EXPECT_EQ(0u, usage.DescriptionBytes());
+  EXPECT_TRUE(usage.ElementNames().empty());
+  EXPECT_EQ(0u, usage.ElementCount("link"));
+  EXPECT_EQ(0u, usage.Bytes("link"));
+
+  usage.Add(nullptr);
+  EXPECT_EQ(0u, usage.ElementCount());
+}
+
+/////////////////////////////////////////////////
+TEST(MemoryUsage, Element)
+{
+  sdf::ElementPtr parent(new sdf::Element);
+  parent->SetName("parent");
+  parent->AddAttribute("name", "string", "p", true);
+  parent->AddValue("double", "1.0", false);
+
+  sdf::ElementPtr child(new sdf::Element);
+  child->SetName("child");
+  child->AddAttribute("name", "string",
+      "a value that is too long to be stored in the string itself", true);
+  parent->InsertElement(child);
+
+  sdf::ElementPtr desc(new sdf::Element);
+  desc->SetName("child");
+  parent->AddElementDescription(desc);
+
+  sdf::MemoryUsage usage(parent);
+  EXPECT_EQ(2u, usage.ElementCount());
+  EXPECT_EQ(1u, usage.ElementCount("parent"));
+  EXPECT_EQ(1u, usage.ElementCount("child"));
+  EXPECT_EQ(3u, usage.ParamCount());
+  EXPECT_EQ(1u, usage.DescriptionCount());
+  EXPECT_EQ(1u, usage.DescriptionReferenceCount());
+  EXPECT_LT(0u, usage.DescriptionBytes());
+
+  EXPECT_LT(0u, usage.Bytes("parent"));
+  EXPECT_LT(0u, usage.Bytes("child"));
+  EXPECT_EQ(usage.Bytes(), usage.Bytes("parent") + usage.Bytes("child"));
+
+  // The characters of long attribute values are accounted for.
+  sdf::ElementPtr shortChild(new sdf::Element);
+  shortChild->SetName("child");
+  shortChild->AddAttribute("name", "string", "c", true);
+  EXPECT_LT(sdf::MemoryUsage(shortChild).Bytes() + 40,
+            sdf::MemoryUsage(child).Bytes());
+
+  // Elements already accounted for are not counted again.
+  const auto bytes = usage.Bytes();
+  usage.Add(child);
+  EXPECT_EQ(2u, usage.ElementCount());
+  EXPECT_EQ(bytes, usage.Bytes());
+}
+
+/////////////////////////////////////////////////
+TEST(MemoryUsage, Root)
+{
+  const std::string sdfString = R"(
+<sdf version='1.9'>
+  <model name='model'>
+    <link name='link1'>
+      <visual name='visual'>
+        <geometry><box><size>1 1 1</size></box></geometry>
+      </visual>
+    </link>
+    <link name='link2'/>
+  </model>
+</sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  sdf::MemoryUsage usage(root);
+  EXPECT_EQ(2u, usage.ElementCount("link"));
+  EXPECT_EQ(1u, usage.ElementCount("model"));
+  EXPECT_EQ(1u, usage.ElementCount("visual"));
+  EXPECT_LT(usage.ElementCount("link"), usage.ElementCount());
+  EXPECT_LT(0u, usage.ParamCount());
+  EXPECT_LT(0u, usage.DescriptionCount());
+  EXPECT_LT(0u, usage.DescriptionReferenceCount());
+
+  // Both links share their descriptions, which are only counted once.
+  sdf::ElementPtr link1 = root.Model()->Element()->GetElement("link");
+  sdf::ElementPtr link2 = link1->GetNextElement("link");
+  ASSERT_NE(nullptr, link2);
+  sdf::MemoryUsage linkUsage(link1);
+  const auto descriptionCount = linkUsage.DescriptionCount();
+  const auto referenceCount = linkUsage.DescriptionReferenceCount();
+  linkUsage.Add(link2);
+  EXPECT_EQ(2u, linkUsage.ElementCount("link"));
+  EXPECT_EQ(descriptionCount, linkUsage.DescriptionCount());
+  EXPECT_LT(referenceCount, linkUsage.DescriptionReferenceCount());
+
+  std::uint64_t bytes = 0;
+  std::uint64_t count = 0;
+  std::uint64_t previousBytes = usage.Bytes();
+  for (const auto &name : usage.ElementNames())
+  {
+    EXPECT_GE(previousBytes, usage.Bytes(name)) << name;
+    previousBytes = usage.Bytes(name);
+    bytes += usage.Bytes(name);
+    count += usage.ElementCount(name);
+  }
+  EXPECT_EQ(usage.Bytes(), bytes);
+  EXPECT_EQ(usage.ElementCount(), count);
+
+  std::ostringstream report;
+  report << usage;
+  EXPECT_NE(std::string::npos, report.str().find(
+      "Elements: " + std::to_string(usage.ElementCount()) + "\n"));
+  EXPECT_NE(std::string::npos, report.str().find("  link\n"));
+}
@@ -16,6 +16,7 @@
 */
 #include "sdf/parser.hh"
 #include "sdf/Mesh.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
@@ -37,6 +38,9 @@ class sdf::Mesh::Implementation
   /// \brief True to center the submesh.
   public: bool centerSubmesh = false;
 
+  /// \brief Extents of the unscaled mesh, if they are known.
+  public: std::optional<ignition::math::AxisAlignedBox> extents;
+
   /// \brief The SDF element pointer used during load.
   public: sdf::ElementPtr sdf = nullptr;
 };
@@ -52,7 +56,7 @@ Errors Mesh::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that sdf is a valid pointer
   if (!_sdf)
@@ -178,6 +182,24 @@ void Mesh::SetCenterSubmesh(const bool _center)
   this->dataPtr->centerSubmesh = _center;
 }
 
+/////////////////////////////////////////////////
+std::optional<ignition::math::AxisAlignedBox> Mesh::Extents() const
+{
+  return this->dataPtr->extents;
+}
+
+/////////////////////////////////////////////////
+void Mesh::SetExtents(const ignition::math::AxisAlignedBox &_extents)
+{
+  this->dataPtr->extents = _extents;
+}
+
+/////////////////////////////////////////////////
+void Mesh::ClearExtents()
+{
+  this->dataPtr->extents.reset();
+}
+
 /////////////////////////////////////////////////
 sdf::ElementPtr Mesh::ToElement() const
 {
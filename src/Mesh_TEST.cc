@@ -29,6 +29,7 @@ TEST(DOMMesh, Construction)
   EXPECT_EQ(std::string(), mesh.Submesh());
   EXPECT_TRUE(ignition::math::Vector3d(1, 1, 1) == mesh.Scale());
   EXPECT_FALSE(mesh.CenterSubmesh());
+  EXPECT_FALSE(mesh.Extents().has_value());
 }
 
 /////////////////////////////////////////////////
@@ -201,3 +202,21 @@ TEST(DOMMesh, ToElement)
   EXPECT_EQ(mesh.Submesh(), mesh2.Submesh());
   EXPECT_EQ(mesh.CenterSubmesh(), mesh2.CenterSubmesh());
 }
+
+/////////////////////////////////////////////////
+TEST(DOMMesh, Extents)
+{
+  sdf::Mesh mesh;
+  const ignition::math::AxisAlignedBox extents(
+      ignition::math::Vector3d(-1, -2, -3), ignition::math::Vector3d(1, 2, 3));
+  mesh.SetExtents(extents);
+  ASSERT_TRUE(mesh.Extents().has_value());
+  EXPECT_EQ(extents, *mesh.Extents());
+
+  sdf::Mesh mesh2(mesh);
+  ASSERT_TRUE(mesh2.Extents().has_value());
+  EXPECT_EQ(extents, *mesh2.Extents());
+
+  mesh.ClearExtents();
+  EXPECT_FALSE(mesh.Extents().has_value());
+}
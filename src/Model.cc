@@ -14,12 +14,20 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
+#include <ignition/math/Inertial.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/SemanticVersion.hh>
+#include "sdf/Collision.hh"
 #include "sdf/Error.hh"
 #include "sdf/Frame.hh"
 #include "sdf/InterfaceElements.hh"
@@ -30,9 +38,15 @@
 #include "sdf/Link.hh"
 #include "sdf/Model.hh"
 #include "sdf/ParserConfig.hh"
+#include "sdf/Sensor.hh"
 #include "sdf/Types.hh"
+#include "sdf/Visual.hh"
 #include "FrameSemantics.hh"
+#include "LoadMonitor.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
+#include "ScopedLoadPhase.hh"
+#include "ScopedTraceEvent.hh"
 #include "Utils.hh"
 #include "sdf/parser.hh"
 
@@ -43,6 +57,11 @@ class sdf::Model::Implementation
   /// \brief Name of the model.
   public: std::string name = "";
 
+  /// \brief Names that the models of the vector holding this model were renamed
+  /// to, shared with the name index of the vector. Null if the model is not
+  /// indexed.
+  public: std::shared_ptr<NameIndexRenames> nameIndexRenames;
+
   /// \brief True if this model is specified as static, false otherwise.
   public: bool isStatic = false;
 
@@ -80,6 +99,18 @@ class sdf::Model::Implementation
   /// \brief The nested models specified in this model.
   public: std::vector<Model> models;
 
+  /// \brief Index of the links by name.
+  public: NameIndex<Link> linkIndex;
+
+  /// \brief Index of the joints by name.
+  public: NameIndex<Joint> jointIndex;
+
+  /// \brief Index of the frames by name.
+  public: NameIndex<Frame> frameIndex;
+
+  /// \brief Index of the nested models by name.
+  public: NameIndex<Model> modelIndex;
+
   /// \brief The interface models specified in this model.
   public: std::vector<std::pair<std::optional<sdf::NestedInclude>,
           sdf::InterfaceModelConstPtr>> interfaceModels;
@@ -100,6 +131,10 @@ class sdf::Model::Implementation
   /// \brief Scoped Pose Relative-To graph at the parent model or world scope.
   public: sdf::ScopedGraph<sdf::PoseRelativeToGraph> poseGraph;
 
+  /// \brief Scoped Pose Relative-To graph at the scope of this model, which
+  /// is given to its links, joints, frames and nested models.
+  public: sdf::ScopedGraph<sdf::PoseRelativeToGraph> childPoseGraph;
+
   /// \brief Scope name of parent Pose Relative-To Graph (world or __model__).
   public: std::string poseGraphScopeVertexName;
 
@@ -140,12 +175,171 @@ Errors Model::Load(ElementPtr _sdf)
   return this->Load(_sdf, ParserConfig::GlobalConfig());
 }
 
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Objects loaded from the child elements of one type of a model,
+/// which can be loaded concurrently and are then collected in document
+/// order.
+template <typename Class>
+class ChildLoads
+{
+  /// \brief Constructor.
+  /// \param[in] _sdf The model element.
+  /// \param[in] _sdfName Name of the child elements, such as "link".
+  public: ChildLoads(const ElementPtr &_sdf, const std::string &_sdfName)
+    : sdfName(_sdfName)
+  {
+    for (const ElementPtr &elem : _sdf->Children(_sdfName))
+      this->elements.push_back(elem);
+    this->objects.resize(this->elements.size());
+    this->errors.resize(this->elements.size());
+  }
+
+  /// \brief Get the number of child elements.
+  /// \return Number of child elements.
+  public: std::size_t Size() const
+  {
+    return this->elements.size();
+  }
+
+  /// \brief Load the object of a child element.
+  /// \param[in] _index Index of the child element.
+  public: void Load(std::size_t _index)
+  {
+    this->errors[_index] = this->objects[_index].Load(this->elements[_index]);
+  }
+
+  /// \brief Add the loaded objects with unique names to a vector, like
+  /// loadUniqueRepeated does.
+  /// \param[out] _objs Vector the objects are added to.
+  /// \return The load errors and the duplicate name errors.
+  public: Errors Collect(std::vector<Class> &_objs)
+  {
+    Errors result;
+    std::unordered_set<std::string> names;
+    for (std::size_t i = 0; i < this->elements.size(); ++i)
+    {
+      std::string name;
+      sdf::loadName(this->elements[i], name);
+      if (!names.insert(name).second)
+      {
+        result.push_back({ErrorCode::DUPLICATE_NAME,
+            this->sdfName + " with name[" + name + "] already exists."});
+      }
+      else
+      {
+        _objs.push_back(std::move(this->objects[i]));
+      }
+      result.insert(result.end(), this->errors[i].begin(),
+                    this->errors[i].end());
+    }
+    return result;
+  }
+
+  /// \brief Name of the child elements.
+  private: std::string sdfName;
+
+  /// \brief The child elements, in document order.
+  private: std::vector<ElementPtr> elements;
+
+  /// \brief Object loaded from each child element.
+  private: std::vector<Class> objects;
+
+  /// \brief Load errors of each child element.
+  private: std::vector<Errors> errors;
+};
+
+/////////////////////////////////////////////////
+/// \brief The links, joints and frames of a model, loaded concurrently.
+/// They do not refer to each other until their names are checked by
+/// Model::Load.
+class ModelChildLoads
+{
+  /// \brief Constructor.
+  /// \param[in] _sdf The model element.
+  public: explicit ModelChildLoads(const ElementPtr &_sdf)
+    : links(_sdf, "link"), joints(_sdf, "joint"), frames(_sdf, "frame")
+  {
+  }
+
+  /// \brief Get the number of links, joints and frames.
+  /// \return Number of child elements.
+  public: std::size_t Size() const
+  {
+    return this->links.Size() + this->joints.Size() + this->frames.Size();
+  }
+
+  /// \brief Load all the objects on the executor of a configuration.
+  /// \param[in] _config Parser configuration.
+  public: void Run(const ParserConfig &_config)
+  {
+    const std::size_t count = this->Size();
+    const bool release = elementsReleased();
+    std::atomic<std::size_t> next{0};
+    auto loadChildren = [&](std::size_t)
+    {
+      ScopedTraceEvent workerEvent(_config, "Model::LoadChildren", "dom");
+      ScopedLoadPhase workerPhase(_config, LoadPhase::DOM_LOAD);
+      ScopedElementRelease workerRelease(release);
+      for (std::size_t i = next++; i < count; i = next++)
+        this->Load(i);
+    };
+
+    _config.Executor()->RunAndWait(
+        std::min(_config.ModelLoadThreadCount(), count), loadChildren);
+  }
+
+  /// \brief Load the object of a child element.
+  /// \param[in] _index Index of the child element, counting the links,
+  /// then the joints, then the frames.
+  private: void Load(std::size_t _index)
+  {
+    if (_index < this->links.Size())
+    {
+      this->links.Load(_index);
+      return;
+    }
+    _index -= this->links.Size();
+    if (_index < this->joints.Size())
+    {
+      this->joints.Load(_index);
+      return;
+    }
+    this->frames.Load(_index - this->joints.Size());
+  }
+
+  /// \brief The links.
+  public: ChildLoads<Link> links;
+
+  /// \brief The joints.
+  public: ChildLoads<Joint> joints;
+
+  /// \brief The frames.
+  public: ChildLoads<Frame> frames;
+};
+}
+
+/// \brief Number of links, joints and frames from which a model is loaded
+/// concurrently, see ParserConfig::SetModelLoadThreadCount.
+static constexpr std::size_t kMinConcurrentModelChildren = 64;
+
 /////////////////////////////////////////////////
 Errors Model::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
 {
+  ScopedTraceEvent event(_config, "Model::Load", "dom");
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  // Stop before loading the model if an asynchronous load was cancelled.
+  LoadMonitor *monitor = LoadMonitor::Of(_config);
+  if (monitor && monitor->Cancelled())
+  {
+    errors.push_back({ErrorCode::LOAD_CANCELLED,
+        "Loading was cancelled before the model was loaded."});
+    return errors;
+  }
+
+  this->dataPtr->sdf = retainedElement(_sdf);
   ignition::math::SemanticVersion sdfVersion(_sdf->OriginalVersion());
 
   // Check that the provided SDF element is a <model>
@@ -198,14 +392,19 @@ Errors Model::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
   // Load the pose. Ignore the return value since the model pose is optional.
   loadPose(_sdf, this->dataPtr->pose, this->dataPtr->poseRelativeTo);
 
-  for (const auto &[name, size] :
-       _sdf->CountNamedElements("", Element::NameUniquenessExceptions()))
+  // Root::Load checks the names of all its worlds and models at once.
+  if (_config.GetValidationLevel() != ValidationLevel::NONE &&
+      !childNamesChecked(_sdf))
   {
-    if (size > 1)
+    for (const auto &[name, size] :
+         _sdf->CountNamedElements("", Element::NameUniquenessExceptions()))
     {
-      sdfwarn << "Non-unique name[" << name << "] detected " << size
-              << " times in XML children of model with name[" << this->Name()
-              << "].\n";
+      if (size > 1)
+      {
+        sdfwarn << "Non-unique name[" << name << "] detected " << size
+                << " times in XML children of model with name["
+                << this->Name() << "].\n";
+      }
     }
   }
 
@@ -277,9 +476,22 @@ Errors Model::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
     }
   }
 
+  // The links, joints and frames of large models are loaded concurrently,
+  // and their names are then checked in document order as below.
+  std::optional<ModelChildLoads> childLoads;
+  if (_config.ModelLoadThreadCount() > 1)
+  {
+    childLoads.emplace(_sdf);
+    if (childLoads->Size() >= kMinConcurrentModelChildren)
+      childLoads->Run(_config);
+    else
+      childLoads.reset();
+  }
+
   // Load all the links.
-  Errors linkLoadErrors = loadUniqueRepeated<Link>(_sdf, "link",
-    this->dataPtr->links);
+  Errors linkLoadErrors = childLoads ?
+    childLoads->links.Collect(this->dataPtr->links) :
+    loadUniqueRepeated<Link>(_sdf, "link", this->dataPtr->links);
   errors.insert(errors.end(), linkLoadErrors.begin(), linkLoadErrors.end());
 
   // Check links for name collisions and modify and warn if so.
@@ -326,8 +538,9 @@ Errors Model::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
   }
 
   // Load all the joints.
-  Errors jointLoadErrors = loadUniqueRepeated<Joint>(_sdf, "joint",
-    this->dataPtr->joints);
+  Errors jointLoadErrors = childLoads ?
+    childLoads->joints.Collect(this->dataPtr->joints) :
+    loadUniqueRepeated<Joint>(_sdf, "joint", this->dataPtr->joints);
   errors.insert(errors.end(), jointLoadErrors.begin(), jointLoadErrors.end());
 
   // Check joints for name collisions and modify and warn if so.
@@ -363,8 +576,9 @@ Errors Model::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
   }
 
   // Load all the frames.
-  Errors frameLoadErrors = loadUniqueRepeated<Frame>(_sdf, "frame",
-    this->dataPtr->frames);
+  Errors frameLoadErrors = childLoads ?
+    childLoads->frames.Collect(this->dataPtr->frames) :
+    loadUniqueRepeated<Frame>(_sdf, "frame", this->dataPtr->frames);
   errors.insert(errors.end(), frameLoadErrors.begin(), frameLoadErrors.end());
 
   // Check frames for name collisions and modify and warn if so.
@@ -417,6 +631,15 @@ Errors Model::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
         includePluginErrors.end());
   }
 
+  // Index the names after any renaming above.
+  this->dataPtr->linkIndex.Rebuild(this->dataPtr->links);
+  this->dataPtr->jointIndex.Rebuild(this->dataPtr->joints);
+  this->dataPtr->frameIndex.Rebuild(this->dataPtr->frames);
+  this->dataPtr->modelIndex.Rebuild(this->dataPtr->models);
+
+  if (monitor)
+    monitor->ModelLoaded();
+
   return errors;
 }
 
@@ -440,9 +663,17 @@ std::string Model::Name() const
 /////////////////////////////////////////////////
 void Model::SetName(const std::string &_name)
 {
+  if (this->dataPtr->nameIndexRenames && this->dataPtr->name != _name)
+    this->dataPtr->nameIndexRenames->Add(_name);
   this->dataPtr->name = _name;
 }
 
+/////////////////////////////////////////////////
+void Model::SetNameIndexRenames(std::shared_ptr<NameIndexRenames> _renames)
+{
+  this->dataPtr->nameIndexRenames = std::move(_renames);
+}
+
 /////////////////////////////////////////////////
 bool Model::Static() const
 {
@@ -548,36 +779,35 @@ bool Model::JointNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 const Joint *Model::JointByName(const std::string &_name) const
 {
-  auto index = _name.rfind("::");
-  if (index != std::string::npos)
+  return this->JointByScopedName(_name);
+}
+
+/////////////////////////////////////////////////
+const Joint *Model::JointByScopedName(ScopedName _name) const
+{
+  if (_name.IsScoped())
   {
-    const Model *model = this->ModelByName(_name.substr(0, index));
+    const Model *model = this->ModelByScopedName(_name.ScopeName());
     if (nullptr != model)
     {
-      return model->JointByName(_name.substr(index + 2));
+      return model->JointByScopedName(_name.LocalName());
     }
 
     // The nested model name preceding the last "::" could not be found.
-    // For now, try to find a link that matches _name exactly.
+    // For now, try to find a joint that matches _name exactly.
     // When "::" are reserved and not allowed in names, then uncomment
     // the following line to return a nullptr.
     // return nullptr;
   }
 
-  for (auto const &j : this->dataPtr->joints)
-  {
-    if (j.Name() == _name)
-    {
-      return &j;
-    }
-  }
-  return nullptr;
-
+  return this->dataPtr->jointIndex.Find(this->dataPtr->joints,
+      _name.Name());
 }
 
 /////////////////////////////////////////////////
 Joint *Model::JointByName(const std::string &_name)
 {
+  this->dataPtr->jointIndex.Refresh(this->dataPtr->joints);
   return const_cast<Joint*>(
       static_cast<const Model*>(this)->JointByName(_name));
 }
@@ -612,35 +842,35 @@ bool Model::FrameNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 const Frame *Model::FrameByName(const std::string &_name) const
 {
-  auto index = _name.rfind("::");
-  if (index != std::string::npos)
+  return this->FrameByScopedName(_name);
+}
+
+/////////////////////////////////////////////////
+const Frame *Model::FrameByScopedName(ScopedName _name) const
+{
+  if (_name.IsScoped())
   {
-    const Model *model = this->ModelByName(_name.substr(0, index));
+    const Model *model = this->ModelByScopedName(_name.ScopeName());
     if (nullptr != model)
     {
-      return model->FrameByName(_name.substr(index + 2));
+      return model->FrameByScopedName(_name.LocalName());
     }
 
     // The nested model name preceding the last "::" could not be found.
-    // For now, try to find a link that matches _name exactly.
+    // For now, try to find a frame that matches _name exactly.
     // When "::" are reserved and not allowed in names, then uncomment
     // the following line to return a nullptr.
     // return nullptr;
   }
 
-  for (auto const &f : this->dataPtr->frames)
-  {
-    if (f.Name() == _name)
-    {
-      return &f;
-    }
-  }
-  return nullptr;
+  return this->dataPtr->frameIndex.Find(this->dataPtr->frames,
+      _name.Name());
 }
 
 /////////////////////////////////////////////////
 Frame *Model::FrameByName(const std::string &_name)
 {
+  this->dataPtr->frameIndex.Refresh(this->dataPtr->frames);
   return const_cast<Frame*>(
       static_cast<const Model*>(this)->FrameByName(_name));
 }
@@ -675,30 +905,27 @@ bool Model::ModelNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 const Model *Model::ModelByName(const std::string &_name) const
 {
-  auto index = _name.find("::");
-  const std::string nextModelName = _name.substr(0, index);
-  const Model *nextModel = nullptr;
+  return this->ModelByScopedName(_name);
+}
 
-  for (auto const &m : this->dataPtr->models)
-  {
-    if (m.Name() == nextModelName)
-    {
-      nextModel = &m;
-      break;
-    }
-  }
+/////////////////////////////////////////////////
+const Model *Model::ModelByScopedName(ScopedName _name) const
+{
+  const Model *nextModel =
+      this->dataPtr->modelIndex.Find(this->dataPtr->models,
+                                     _name.FirstSegment());
 
-  if (nullptr != nextModel && index != std::string::npos)
+  if (nullptr != nextModel && _name.IsScoped())
   {
-    return nextModel->ModelByName(_name.substr(index + 2));
+    return nextModel->ModelByScopedName(_name.WithoutFirstSegment());
   }
   return nextModel;
-
 }
 
 /////////////////////////////////////////////////
 Model *Model::ModelByName(const std::string &_name)
 {
+  this->dataPtr->modelIndex.Refresh(this->dataPtr->models);
   return const_cast<Model*>(
       static_cast<const Model*>(this)->ModelByName(_name));
 }
@@ -819,8 +1046,9 @@ void Model::SetPoseRelativeToGraph(sdf::ScopedGraph<PoseRelativeToGraph> _graph)
   this->dataPtr->poseGraphScopeVertexName =
       _graph.VertexLocalName(_graph.ScopeVertexId());
 
-  auto childPoseGraph =
+  this->dataPtr->childPoseGraph =
       this->dataPtr->poseGraph.ChildModelScope(this->Name());
+  const auto &childPoseGraph = this->dataPtr->childPoseGraph;
   for (auto &model : this->dataPtr->models)
   {
     model.SetPoseRelativeToGraph(childPoseGraph);
@@ -853,6 +1081,15 @@ void Model::SetPoseRelativeToGraph(sdf::ScopedGraph<PoseRelativeToGraph> _graph)
   }
 }
 
+/////////////////////////////////////////////////
+void Model::StoreResolvedPoses() const
+{
+  if (this->dataPtr->childPoseGraph)
+    storeResolvedPoses(this->dataPtr->childPoseGraph);
+  for (const Model &model : this->dataPtr->models)
+    model.StoreResolvedPoses();
+}
+
 /////////////////////////////////////////////////
 void Model::SetFrameAttachedToGraph(
     sdf::ScopedGraph<FrameAttachedToGraph> _graph)
@@ -886,16 +1123,579 @@ sdf::SemanticPose Model::SemanticPose() const
       this->dataPtr->poseGraph);
 }
 
+/////////////////////////////////////////////////
+Errors Model::ResolvePose(ignition::math::Pose3d &_pose,
+    const std::string &_resolveTo) const
+{
+  return resolveSemanticPose(_pose, this->dataPtr->poseGraph,
+      this->dataPtr->name, this->dataPtr->pose, this->dataPtr->poseRelativeTo,
+      this->dataPtr->poseGraphScopeVertexName, _resolveTo);
+}
+
+/////////////////////////////////////////////////
+/// \brief Poses of the vertices of a model's pose graph, resolved with one
+/// traversal by Model::ResolveAllPoses.
+struct ResolvedModelPoses
+{
+  /// \brief Pose graph scoped to the model that poses are resolved for.
+  ScopedGraph<PoseRelativeToGraph> graph;
+
+  /// \brief Poses of the vertices relative to the model frame.
+  std::unordered_map<ignition::math::graph::VertexId,
+                     ignition::math::Pose3d> poses;
+
+  /// \brief Pose of the model frame relative to the frame that poses are
+  /// resolved relative to.
+  ignition::math::Pose3d modelPose;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the resolved pose of a vertex of the pose graph.
+/// \param[in] _resolved Poses resolved by Model::ResolveAllPoses.
+/// \param[in] _id ID of the vertex.
+/// \param[out] _errors Errors if the pose of the vertex is not resolved.
+/// \return The pose, or zero if it is not resolved.
+static ignition::math::Pose3d resolvedVertexPose(
+    const ResolvedModelPoses &_resolved,
+    const ignition::math::graph::VertexId _id, Errors &_errors)
+{
+  auto it = _resolved.poses.find(_id);
+  if (it != _resolved.poses.end())
+    return _resolved.modelPose * it->second;
+
+  // Resolve the vertex on its own to report why it failed.
+  ignition::math::Pose3d pose;
+  Errors errors = resolvePoseRelativeToRoot(pose, _resolved.graph, _id);
+  if (errors.empty())
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "PoseRelativeToGraph unable to resolve the pose of vertex with id [" +
+        std::to_string(_id) + "]."});
+  }
+  _errors.insert(_errors.end(), errors.begin(), errors.end());
+  return ignition::math::Pose3d::Zero;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the resolved pose of a frame of the pose graph.
+/// \param[in] _resolved Poses resolved by Model::ResolveAllPoses.
+/// \param[in] _graph Pose graph scoped to the model that contains the frame.
+/// \param[in] _name Name of the frame.
+/// \param[out] _errors Errors if the pose of the frame is not resolved.
+/// \return The pose, or zero if it is not resolved.
+static ignition::math::Pose3d resolvedFramePose(
+    const ResolvedModelPoses &_resolved,
+    const ScopedGraph<PoseRelativeToGraph> &_graph,
+    const std::string &_name, Errors &_errors)
+{
+  if (_graph.Count(_name) != 1)
+  {
+    _errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+        "PoseRelativeToGraph unable to find unique frame with name [" +
+        _name + "] in graph."});
+    return ignition::math::Pose3d::Zero;
+  }
+  return resolvedVertexPose(_resolved, _graph.VertexIdByName(_name), _errors);
+}
+
+/////////////////////////////////////////////////
+/// \brief Append the resolved poses of a model and its entities in the
+/// order documented by Model::ResolveAllPoses.
+/// \param[in] _model The model.
+/// \param[in] _graph Pose graph scoped to _model.
+/// \param[in] _resolved Poses resolved by Model::ResolveAllPoses.
+/// \param[out] _poses Poses to append to.
+/// \param[out] _errors Errors for poses that are not resolved.
+static void appendResolvedPoses(const Model &_model,
+    const ScopedGraph<PoseRelativeToGraph> &_graph,
+    const ResolvedModelPoses &_resolved,
+    std::vector<ignition::math::Pose3d> &_poses, Errors &_errors)
+{
+  // Poses of collisions, visuals and sensors are given relative to a frame
+  // that defaults to the link or joint that contains them.
+  auto childPose = [&](const auto &_child, const std::string &_parentName)
+  {
+    const std::string &relativeTo = _child.PoseRelativeTo().empty() ?
+        _parentName : _child.PoseRelativeTo();
+    return resolvedFramePose(_resolved, _graph, relativeTo, _errors) *
+        _child.RawPose();
+  };
+
+  _poses.push_back(
+      resolvedVertexPose(_resolved, _graph.ScopeVertexId(), _errors));
+
+  for (uint64_t i = 0; i < _model.LinkCount(); ++i)
+  {
+    const Link *link = _model.LinkByIndex(i);
+    _poses.push_back(
+        resolvedFramePose(_resolved, _graph, link->Name(), _errors));
+    for (uint64_t j = 0; j < link->CollisionCount(); ++j)
+      _poses.push_back(childPose(*link->CollisionByIndex(j), link->Name()));
+    for (uint64_t j = 0; j < link->VisualCount(); ++j)
+      _poses.push_back(childPose(*link->VisualByIndex(j), link->Name()));
+    for (uint64_t j = 0; j < link->SensorCount(); ++j)
+      _poses.push_back(childPose(*link->SensorByIndex(j), link->Name()));
+  }
+
+  for (uint64_t i = 0; i < _model.JointCount(); ++i)
+  {
+    const Joint *joint = _model.JointByIndex(i);
+    _poses.push_back(
+        resolvedFramePose(_resolved, _graph, joint->Name(), _errors));
+    for (uint64_t j = 0; j < joint->SensorCount(); ++j)
+      _poses.push_back(childPose(*joint->SensorByIndex(j), joint->Name()));
+  }
+
+  for (uint64_t i = 0; i < _model.FrameCount(); ++i)
+  {
+    _poses.push_back(resolvedFramePose(
+        _resolved, _graph, _model.FrameByIndex(i)->Name(), _errors));
+  }
+
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+  {
+    const Model *nested = _model.ModelByIndex(i);
+    appendResolvedPoses(*nested, _graph.ChildModelScope(nested->Name()),
+                        _resolved, _poses, _errors);
+  }
+}
+
+/////////////////////////////////////////////////
+Errors Model::ResolveAllPoses(std::vector<ignition::math::Pose3d> &_poses,
+                              const std::string &_resolveTo) const
+{
+  Errors errors;
+  _poses.clear();
+
+  if (!this->dataPtr->poseGraph)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "Model has invalid pointer to PoseRelativeToGraph."});
+    return errors;
+  }
+
+  ResolvedModelPoses resolved;
+  resolved.graph = this->dataPtr->poseGraph.ChildModelScope(this->Name());
+  resolvePosesRelativeToRoot(resolved.poses, resolved.graph);
+
+  if (!_resolveTo.empty())
+  {
+    resolved.modelPose = resolvedFramePose(
+        resolved, resolved.graph, _resolveTo, errors).Inverse();
+    if (!errors.empty())
+      return errors;
+  }
+
+  appendResolvedPoses(*this, resolved.graph, resolved, _poses, errors);
+  return errors;
+}
+
+/////////////////////////////////////////////////
+/// \brief Append the links welded by the fixed joints of a model and of its
+/// nested models.
+/// \param[in] _model The model.
+/// \param[in] _prefix Scope of _model relative to the model that the link
+/// names are relative to, empty for that model.
+/// \param[out] _welds Scoped names of the parent and child links of each
+/// fixed joint.
+/// \param[out] _errors Errors for joints whose links are not resolved.
+static void appendWeldedLinks(const Model &_model, const std::string &_prefix,
+    std::vector<std::pair<std::string, std::string>> &_welds,
+    Errors &_errors)
+{
+  for (uint64_t i = 0; i < _model.JointCount(); ++i)
+  {
+    const Joint *joint = _model.JointByIndex(i);
+    if (joint->Type() != JointType::FIXED)
+      continue;
+
+    std::string parent;
+    std::string child;
+    Errors errors = joint->ResolveParentLink(parent);
+    Errors childErrors = joint->ResolveChildLink(child);
+    errors.insert(errors.end(), childErrors.begin(), childErrors.end());
+    if (!errors.empty())
+    {
+      _errors.insert(_errors.end(), errors.begin(), errors.end());
+      continue;
+    }
+
+    if (parent != "world")
+      _welds.emplace_back(JoinName(_prefix, parent), JoinName(_prefix, child));
+  }
+
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+  {
+    const Model *nested = _model.ModelByIndex(i);
+    appendWeldedLinks(*nested, JoinName(_prefix, nested->Name()), _welds,
+                      _errors);
+  }
+}
+
+/////////////////////////////////////////////////
+Errors Model::ResolveCompositeInertial(ignition::math::Inertiald &_inertial,
+    const std::string &_linkName, const std::string &_resolveTo) const
+{
+  Errors errors;
+
+  if (!this->dataPtr->poseGraph)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "Model has invalid pointer to PoseRelativeToGraph."});
+    return errors;
+  }
+
+  if (nullptr == this->LinkByName(_linkName))
+  {
+    errors.push_back({ErrorCode::ELEMENT_MISSING,
+        "Model [" + this->Name() + "] has no link with name [" + _linkName +
+        "]."});
+    return errors;
+  }
+
+  // The groups are stored on the scope of the parent graph, which is kept by
+  // the model and shared with its siblings
+  const std::string scopedLinkName = JoinName(this->Name(), _linkName);
+  auto group = this->dataPtr->poseGraph.ResolvedLinkGroup(
+      scopedLinkName, _resolveTo);
+  if (!group)
+  {
+    std::vector<std::pair<std::string, std::string>> welds;
+    appendWeldedLinks(*this, "", welds, errors);
+    if (!errors.empty())
+      return errors;
+
+    // Flood the welds from the link, visiting each weld once
+    std::vector<std::string> links = {_linkName};
+    std::unordered_set<std::string> visited = {_linkName};
+    std::vector<bool> used(welds.size(), false);
+    for (std::size_t next = 0; next < links.size(); ++next)
+    {
+      for (std::size_t i = 0; i < welds.size(); ++i)
+      {
+        if (used[i] || (welds[i].first != links[next] &&
+                        welds[i].second != links[next]))
+        {
+          continue;
+        }
+        used[i] = true;
+        const std::string &other = welds[i].first == links[next] ?
+            welds[i].second : welds[i].first;
+        if (visited.insert(other).second)
+          links.push_back(other);
+      }
+    }
+
+    ResolvedModelPoses resolved;
+    resolved.graph = this->dataPtr->poseGraph.ChildModelScope(this->Name());
+    resolvePosesRelativeToRoot(resolved.poses, resolved.graph);
+    if (!_resolveTo.empty())
+    {
+      resolved.modelPose = resolvedFramePose(
+          resolved, resolved.graph, _resolveTo, errors).Inverse();
+    }
+
+    group.emplace();
+    for (const auto &link : links)
+    {
+      group->emplace_back(link,
+          resolvedFramePose(resolved, resolved.graph, link, errors));
+    }
+    if (!errors.empty())
+      return errors;
+
+    this->dataPtr->poseGraph.SetResolvedLinkGroup(
+        scopedLinkName, _resolveTo, *group);
+  }
+
+  // Sum the inertials in the resolved frame, which accounts for the offsets
+  // of the centers of mass with the parallel axis theorem
+  _inertial = ignition::math::Inertiald();
+  for (const auto &[name, pose] : *group)
+  {
+    const Link *link = this->LinkByName(name);
+    if (nullptr == link)
+    {
+      errors.push_back({ErrorCode::ELEMENT_MISSING,
+          "Model [" + this->Name() + "] has no link with name [" + name +
+          "]."});
+      continue;
+    }
+    ignition::math::Inertiald inertial = link->Inertial();
+    inertial.SetPose(pose * inertial.Pose());
+    _inertial += inertial;
+  }
+  return errors;
+}
+
+/////////////////////////////////////////////////
+Errors Model::ResolveKinematicTree(KinematicTree &_tree) const
+{
+  Errors errors;
+  _tree = KinematicTree();
+
+  if (!this->dataPtr->poseGraph)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "Model has invalid pointer to PoseRelativeToGraph."});
+    return errors;
+  }
+
+  // Like the link groups, the trees are stored on the scope of the parent
+  // graph, which is kept by the model and shared with its siblings
+  if (auto cached = this->dataPtr->poseGraph.ResolvedKinematicTree(
+          this->Name()))
+  {
+    _tree = std::move(*cached);
+    return errors;
+  }
+
+  const uint64_t kNoIndex = KinematicTree::kNoIndex;
+  const std::vector<Link> &links = this->dataPtr->links;
+  auto linkIndex = [this, &links](const std::string &_name)
+  {
+    const Link *link = this->dataPtr->linkIndex.Find(links, _name);
+    return nullptr == link ? KinematicTree::kNoIndex :
+        static_cast<uint64_t>(link - links.data());
+  };
+
+  // The joint to the parent link of each link, and the children of each
+  // link, by link index
+  std::vector<uint64_t> parentJoints(links.size(), kNoIndex);
+  std::vector<uint64_t> parentLinks(links.size(), kNoIndex);
+  std::vector<std::vector<uint64_t>> children(links.size());
+  for (uint64_t i = 0; i < this->dataPtr->joints.size(); ++i)
+  {
+    const Joint &joint = this->dataPtr->joints[i];
+    std::string parent;
+    std::string child;
+    Errors jointErrors = joint.ResolveParentLink(parent);
+    Errors childErrors = joint.ResolveChildLink(child);
+    jointErrors.insert(jointErrors.end(), childErrors.begin(),
+                       childErrors.end());
+    if (!jointErrors.empty())
+    {
+      errors.insert(errors.end(), jointErrors.begin(), jointErrors.end());
+      continue;
+    }
+
+    const uint64_t childIndex = linkIndex(child);
+    const uint64_t parentIndex =
+        parent == "world" ? kNoIndex : linkIndex(parent);
+    if (childIndex == kNoIndex ||
+        (parent != "world" && parentIndex == kNoIndex))
+    {
+      continue;
+    }
+
+    if (parentJoints[childIndex] != kNoIndex)
+    {
+      errors.push_back({ErrorCode::KINEMATIC_TREE_INVALID,
+          "Link [" + child + "] of model [" + this->Name() +
+          "] is the child of joints [" +
+          this->dataPtr->joints[parentJoints[childIndex]].Name() + "] and [" +
+          joint.Name() + "]."});
+      continue;
+    }
+    parentJoints[childIndex] = i;
+    parentLinks[childIndex] = parentIndex;
+    if (parentIndex != kNoIndex)
+      children[parentIndex].push_back(childIndex);
+  }
+  if (!errors.empty())
+    return errors;
+
+  // Breadth first traversal from the roots, in the order of the links
+  KinematicTree tree;
+  auto append = [&tree, &parentJoints](uint64_t _link, uint64_t _parent)
+  {
+    tree.links.push_back(_link);
+    tree.parents.push_back(_parent);
+    tree.joints.push_back(parentJoints[_link]);
+  };
+  for (uint64_t i = 0; i < links.size(); ++i)
+  {
+    if (parentLinks[i] == kNoIndex)
+      append(i, kNoIndex);
+  }
+  for (uint64_t next = 0; next < tree.links.size(); ++next)
+  {
+    for (const uint64_t child : children[tree.links[next]])
+      append(child, next);
+  }
+
+  // The links that are not reached are on loops of joints
+  if (tree.links.size() != links.size())
+  {
+    std::vector<bool> reached(links.size(), false);
+    for (const uint64_t link : tree.links)
+      reached[link] = true;
+    for (uint64_t i = 0; i < links.size(); ++i)
+    {
+      if (!reached[i])
+      {
+        errors.push_back({ErrorCode::KINEMATIC_TREE_INVALID,
+            "Link [" + links[i].Name() + "] of model [" + this->Name() +
+            "] is on a loop of joints."});
+      }
+    }
+    return errors;
+  }
+
+  ResolvedModelPoses resolved;
+  resolved.graph = this->dataPtr->poseGraph.ChildModelScope(this->Name());
+  resolvePosesRelativeToRoot(resolved.poses, resolved.graph);
+  for (uint64_t i = 0; i < tree.links.size(); ++i)
+  {
+    const ignition::math::Pose3d parentPose = tree.parents[i] == kNoIndex ?
+        ignition::math::Pose3d::Zero :
+        resolvedFramePose(resolved, resolved.graph,
+            links[tree.links[tree.parents[i]]].Name(), errors);
+    const ignition::math::Pose3d jointPose = tree.joints[i] == kNoIndex ?
+        ignition::math::Pose3d::Zero :
+        resolvedFramePose(resolved, resolved.graph,
+            this->dataPtr->joints[tree.joints[i]].Name(), errors);
+    const ignition::math::Pose3d linkPose = resolvedFramePose(
+        resolved, resolved.graph, links[tree.links[i]].Name(), errors);
+    tree.jointPoses.push_back(parentPose.Inverse() * jointPose);
+    tree.linkPoses.push_back(jointPose.Inverse() * linkPose);
+  }
+  if (!errors.empty())
+    return errors;
+
+  this->dataPtr->poseGraph.SetResolvedKinematicTree(this->Name(), tree);
+  _tree = std::move(tree);
+  return errors;
+}
+
+/////////////////////////////////////////////////
+/// \brief Append the resolved poses of the collisions of a model and of its
+/// nested models, link by link, with the nested models last.
+/// \param[in] _model The model.
+/// \param[in] _graph Pose graph scoped to _model.
+/// \param[in] _resolved Poses resolved by Model::ResolveBounds.
+/// \param[out] _poses Poses to append to.
+/// \param[out] _errors Errors for poses that are not resolved.
+static void appendCollisionPoses(const Model &_model,
+    const ScopedGraph<PoseRelativeToGraph> &_graph,
+    const ResolvedModelPoses &_resolved,
+    std::vector<ignition::math::Pose3d> &_poses, Errors &_errors)
+{
+  for (uint64_t i = 0; i < _model.LinkCount(); ++i)
+  {
+    const Link *link = _model.LinkByIndex(i);
+    for (uint64_t j = 0; j < link->CollisionCount(); ++j)
+    {
+      const Collision *collision = link->CollisionByIndex(j);
+      const std::string &relativeTo = collision->PoseRelativeTo().empty() ?
+          link->Name() : collision->PoseRelativeTo();
+      _poses.push_back(
+          resolvedFramePose(_resolved, _graph, relativeTo, _errors) *
+          collision->RawPose());
+    }
+  }
+
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+  {
+    const Model *nested = _model.ModelByIndex(i);
+    appendCollisionPoses(*nested, _graph.ChildModelScope(nested->Name()),
+                         _resolved, _poses, _errors);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Grow a box to contain the collisions of a model and of its nested
+/// models, in the order of appendCollisionPoses.
+/// \param[in] _model The model.
+/// \param[in] _poses Poses of the collisions.
+/// \param[in,out] _index Index in _poses of the first collision of _model,
+/// moved past the collisions of _model.
+/// \param[in,out] _bounds The box to grow.
+/// \return False if _poses has fewer poses than there are collisions.
+static bool growCollisionBounds(const Model &_model,
+    const std::vector<ignition::math::Pose3d> &_poses, std::size_t &_index,
+    ignition::math::AxisAlignedBox &_bounds)
+{
+  for (uint64_t i = 0; i < _model.LinkCount(); ++i)
+  {
+    const Link *link = _model.LinkByIndex(i);
+    for (uint64_t j = 0; j < link->CollisionCount(); ++j)
+    {
+      if (_index >= _poses.size())
+        return false;
+      _bounds += placedGeometryBounds(
+          link->CollisionByIndex(j)->Geom(), _poses[_index++]);
+    }
+  }
+
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+  {
+    if (!growCollisionBounds(*_model.ModelByIndex(i), _poses, _index,
+                             _bounds))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+Errors Model::ResolveBounds(ignition::math::AxisAlignedBox &_bounds) const
+{
+  Errors errors;
+  _bounds = ignition::math::AxisAlignedBox();
+
+  if (!this->dataPtr->poseGraph)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "Model has invalid pointer to PoseRelativeToGraph."});
+    return errors;
+  }
+
+  // Collisions that were added since the poses were cached leave the cached
+  // poses short, and are resolved again with the others
+  if (auto cached = this->dataPtr->poseGraph.ResolvedCollisionPoses(
+          this->Name()))
+  {
+    std::size_t index = 0;
+    if (growCollisionBounds(*this, *cached, index, _bounds) &&
+        index == cached->size())
+    {
+      return errors;
+    }
+    _bounds = ignition::math::AxisAlignedBox();
+  }
+
+  ResolvedModelPoses resolved;
+  resolved.graph = this->dataPtr->poseGraph.ChildModelScope(this->Name());
+  resolvePosesRelativeToRoot(resolved.poses, resolved.graph);
+
+  std::vector<ignition::math::Pose3d> poses;
+  appendCollisionPoses(*this, resolved.graph, resolved, poses, errors);
+  if (!errors.empty())
+    return errors;
+
+  std::size_t index = 0;
+  growCollisionBounds(*this, poses, index, _bounds);
+  this->dataPtr->poseGraph.SetResolvedCollisionPoses(this->Name(), poses);
+  return errors;
+}
+
 /////////////////////////////////////////////////
 const Link *Model::LinkByName(const std::string &_name) const
 {
-  auto index = _name.rfind("::");
-  if (index != std::string::npos)
+  return this->LinkByScopedName(_name);
+}
+
+/////////////////////////////////////////////////
+const Link *Model::LinkByScopedName(ScopedName _name) const
+{
+  if (_name.IsScoped())
   {
-    const Model *model = this->ModelByName(_name.substr(0, index));
+    const Model *model = this->ModelByScopedName(_name.ScopeName());
     if (nullptr != model)
     {
-      return model->LinkByName(_name.substr(index + 2));
+      return model->LinkByScopedName(_name.LocalName());
     }
 
     // The nested model name preceding the last "::" could not be found.
@@ -905,20 +1705,14 @@ const Link *Model::LinkByName(const std::string &_name) const
     // return nullptr;
   }
 
-  for (auto const &l : this->dataPtr->links)
-  {
-    if (l.Name() == _name)
-    {
-      return &l;
-    }
-  }
-  return nullptr;
-
+  return this->dataPtr->linkIndex.Find(this->dataPtr->links,
+      _name.Name());
 }
 
 /////////////////////////////////////////////////
 Link *Model::LinkByName(const std::string &_name)
 {
+  this->dataPtr->linkIndex.Refresh(this->dataPtr->links);
   return const_cast<Link*>(
       static_cast<const Model*>(this)->LinkByName(_name));
 }
@@ -1058,6 +1852,19 @@ bool Model::AddLink(const Link &_link)
   if (this->LinkNameExists(_link.Name()))
     return false;
   this->dataPtr->links.push_back(_link);
+  this->dataPtr->linkIndex.Add(
+      this->dataPtr->links, this->dataPtr->links.size() - 1);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Model::AddLink(Link &&_link)
+{
+  if (this->LinkNameExists(_link.Name()))
+    return false;
+  this->dataPtr->links.push_back(std::move(_link));
+  this->dataPtr->linkIndex.Add(
+      this->dataPtr->links, this->dataPtr->links.size() - 1);
   return true;
 }
 
@@ -1067,6 +1874,19 @@ bool Model::AddJoint(const Joint &_joint)
   if (this->JointNameExists(_joint.Name()))
     return false;
   this->dataPtr->joints.push_back(_joint);
+  this->dataPtr->jointIndex.Add(
+      this->dataPtr->joints, this->dataPtr->joints.size() - 1);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Model::AddJoint(Joint &&_joint)
+{
+  if (this->JointNameExists(_joint.Name()))
+    return false;
+  this->dataPtr->joints.push_back(std::move(_joint));
+  this->dataPtr->jointIndex.Add(
+      this->dataPtr->joints, this->dataPtr->joints.size() - 1);
   return true;
 }
 
@@ -1076,6 +1896,19 @@ bool Model::AddModel(const Model &_model)
   if (this->ModelNameExists(_model.Name()))
     return false;
   this->dataPtr->models.push_back(_model);
+  this->dataPtr->modelIndex.Add(
+      this->dataPtr->models, this->dataPtr->models.size() - 1);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Model::AddModel(Model &&_model)
+{
+  if (this->ModelNameExists(_model.Name()))
+    return false;
+  this->dataPtr->models.push_back(std::move(_model));
+  this->dataPtr->modelIndex.Add(
+      this->dataPtr->models, this->dataPtr->models.size() - 1);
   return true;
 }
 
@@ -1083,18 +1916,21 @@ bool Model::AddModel(const Model &_model)
 void Model::ClearLinks()
 {
   this->dataPtr->links.clear();
+  this->dataPtr->linkIndex.Clear();
 }
 
 //////////////////////////////////////////////////
 void Model::ClearJoints()
 {
   this->dataPtr->joints.clear();
+  this->dataPtr->jointIndex.Clear();
 }
 
 //////////////////////////////////////////////////
 void Model::ClearModels()
 {
   this->dataPtr->models.clear();
+  this->dataPtr->modelIndex.Clear();
 }
 
 //////////////////////////////////////////////////
@@ -1103,6 +1939,19 @@ bool Model::AddFrame(const Frame &_frame)
   if (this->FrameNameExists(_frame.Name()))
     return false;
   this->dataPtr->frames.push_back(_frame);
+  this->dataPtr->frameIndex.Add(
+      this->dataPtr->frames, this->dataPtr->frames.size() - 1);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Model::AddFrame(Frame &&_frame)
+{
+  if (this->FrameNameExists(_frame.Name()))
+    return false;
+  this->dataPtr->frames.push_back(std::move(_frame));
+  this->dataPtr->frameIndex.Add(
+      this->dataPtr->frames, this->dataPtr->frames.size() - 1);
   return true;
 }
 
@@ -1110,6 +1959,7 @@ bool Model::AddFrame(const Frame &_frame)
 void Model::ClearFrames()
 {
   this->dataPtr->frames.clear();
+  this->dataPtr->frameIndex.Clear();
 }
 
 /////////////////////////////////////////////////
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "sdf/Filesystem.hh"
+#include "ModelConfigCache.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/////////////////////////////////////////////////
+std::shared_ptr<ModelConfigCache> ModelConfigCache::Of(
+    const ParserConfig &_config)
+{
+  return _config.ModelConfigFileCache();
+}
+
+/////////////////////////////////////////////////
+bool ModelConfigCache::Find(const std::string &_modelDirPath,
+    std::string &_modelFilePath, std::string &_version)
+{
+  Entry entry;
+  if (!this->entries.Find(_modelDirPath, entry))
+    return false;
+
+  // A model.config takes precedence over a manifest.xml.
+  const std::string modelConfigPath =
+      sdf::filesystem::append(_modelDirPath, "model.config");
+  if (entry.configFilePath != modelConfigPath &&
+      sdf::filesystem::exists(modelConfigPath))
+  {
+    this->entries.Erase(_modelDirPath);
+    return false;
+  }
+
+  _modelFilePath = entry.modelFilePath;
+  _version = entry.version;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void ModelConfigCache::Insert(const std::string &_modelDirPath,
+    const std::string &_configFilePath, const std::string &_modelFilePath,
+    const std::string &_version)
+{
+  this->entries.Insert(_modelDirPath,
+      {_configFilePath, _modelFilePath, _version}, _configFilePath);
+}
+
+/////////////////////////////////////////////////
+void ModelConfigCache::Clear()
+{
+  this->entries.Clear();
+}
+
+/////////////////////////////////////////////////
+std::size_t ModelConfigCache::Size() const
+{
+  return this->entries.Size();
+}
+}
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_MODELCONFIGCACHE_HH
+#define SDFORMAT_MODELCONFIGCACHE_HH
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "sdf/ParserConfig.hh"
+#include "sdf/sdf_config.h"
+#include "FileStampCache.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Cache of the model files chosen from the model.config (or
+  /// manifest.xml) of model directories. Entries are keyed on the model
+  /// directory and are invalidated when the modification time of the
+  /// configuration file changes, or when a model.config appears in a
+  /// directory whose manifest.xml was used.
+  class ModelConfigCache
+  {
+    /// \brief Get the model configuration cache of a parser configuration.
+    /// \param[in] _config Parser configuration.
+    /// \return The cache, or nullptr if model configurations are not cached.
+    public: static std::shared_ptr<ModelConfigCache> Of(
+                const ParserConfig &_config);
+
+    /// \brief Look up a model directory.
+    /// \param[in] _modelDirPath Path of the model directory.
+    /// \param[out] _modelFilePath Full path of the chosen model file.
+    /// \param[out] _version SDFormat version of the chosen model file.
+    /// \return True if the directory was found in the cache and its
+    /// configuration file has not been modified since it was read.
+    public: bool Find(const std::string &_modelDirPath,
+                std::string &_modelFilePath, std::string &_version);
+
+    /// \brief Add a model directory whose configuration file was read
+    /// successfully to the cache.
+    /// \param[in] _modelDirPath Path of the model directory.
+    /// \param[in] _configFilePath Path of the configuration file that was
+    /// read.
+    /// \param[in] _modelFilePath Full path of the chosen model file.
+    /// \param[in] _version SDFormat version of the chosen model file.
+    public: void Insert(const std::string &_modelDirPath,
+                const std::string &_configFilePath,
+                const std::string &_modelFilePath,
+                const std::string &_version);
+
+    /// \brief Remove all model directories from the cache.
+    public: void Clear();
+
+    /// \brief Get the number of cached model directories.
+    /// \return Number of cached model directories.
+    public: std::size_t Size() const;
+
+    /// \brief A cached model directory.
+    private: struct Entry
+    {
+      /// \brief Path of the configuration file that was read.
+      public: std::string configFilePath;
+
+      /// \brief Full path of the chosen model file.
+      public: std::string modelFilePath;
+
+      /// \brief SDFormat version of the chosen model file.
+      public: std::string version;
+    };
+
+    /// \brief Cached model directories, keyed on their path and stamped
+    /// with their configuration file.
+    private: FileStampCache<std::string, Entry> entries;
+  };
+  }
+}
+#endif
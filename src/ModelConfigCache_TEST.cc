@@ -0,0 +1,106 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/parser.hh"
+#include "ModelConfigCache.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// \brief Write a model.config that points to a model file.
+/// \param[in] _configFilePath Path of the model.config.
+/// \param[in] _modelFile Name of the model file.
+void writeModelConfig(const std::string &_configFilePath,
+    const std::string &_modelFile)
+{
+  std::ofstream out(_configFilePath);
+  out << "<?xml version='1.0'?>\n"
+      << "<model>\n"
+      << "  <name>cached</name>\n"
+      << "  <sdf version='1.9'>" << _modelFile << "</sdf>\n"
+      << "</model>\n";
+}
+
+/////////////////////////////////////////////////
+TEST(ModelConfigCache, GetModelFilePath)
+{
+  sdf::ParserConfig config;
+  EXPECT_EQ(nullptr, sdf::ModelConfigCache::Of(config));
+  config.SetUseModelConfigCache(true);
+  auto cache = sdf::ModelConfigCache::Of(config);
+  ASSERT_NE(nullptr, cache);
+  EXPECT_EQ(0u, cache->Size());
+
+  // Copies of the configuration share the cache.
+  sdf::ParserConfig configCopy = config;
+  EXPECT_EQ(cache, sdf::ModelConfigCache::Of(configCopy));
+
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string modelDir =
+      sdf::filesystem::append(tmpDir, "model_config_cache_unit");
+  std::filesystem::create_directories(modelDir);
+  const std::string configFilePath =
+      sdf::filesystem::append(modelDir, "model.config");
+  writeModelConfig(configFilePath, "a.sdf");
+
+  std::string modelFilePath;
+  std::string version;
+  EXPECT_FALSE(cache->Find(modelDir, modelFilePath, version));
+
+  EXPECT_EQ(sdf::filesystem::append(modelDir, "a.sdf"),
+            sdf::getModelFilePath(modelDir, config));
+  EXPECT_EQ(1u, cache->Size());
+  ASSERT_TRUE(cache->Find(modelDir, modelFilePath, version));
+  EXPECT_EQ(sdf::filesystem::append(modelDir, "a.sdf"), modelFilePath);
+  EXPECT_EQ("1.9", version);
+
+  // The cached file is returned while the model.config is not modified.
+  cache->Insert(modelDir, configFilePath,
+      sdf::filesystem::append(modelDir, "b.sdf"), "1.9");
+  EXPECT_EQ(sdf::filesystem::append(modelDir, "b.sdf"),
+            sdf::getModelFilePath(modelDir, configCopy));
+
+  // A modified model.config is read again.
+  std::filesystem::last_write_time(configFilePath,
+      std::filesystem::last_write_time(configFilePath) +
+      std::chrono::seconds(1));
+  EXPECT_EQ(sdf::filesystem::append(modelDir, "a.sdf"),
+            sdf::getModelFilePath(modelDir, config));
+
+  configCopy.ClearModelConfigCache();
+  EXPECT_EQ(0u, cache->Size());
+
+  config.SetUseModelConfigCache(false);
+  EXPECT_EQ(nullptr, sdf::ModelConfigCache::Of(config));
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -21,6 +21,9 @@
 #include "sdf/Joint.hh"
 #include "sdf/Link.hh"
 #include "sdf/Model.hh"
+#include "sdf/PerfCounters.hh"
+#include "sdf/Root.hh"
+#include "sdf/World.hh"
 #include "sdf/parser.hh"
 #include "test_config.h"
 
@@ -622,6 +625,185 @@ TEST(DOMModel, MutableByName)
   EXPECT_TRUE(model.FrameNameExists("frame2"));
 }
 
+/////////////////////////////////////////////////
+TEST(DOMModel, ScopedNameLookup)
+{
+  sdf::Model inner;
+  inner.SetName("inner");
+  for (const std::string name : {"a", "b", "c"})
+  {
+    sdf::Link link;
+    link.SetName(name);
+    EXPECT_TRUE(inner.AddLink(link));
+    sdf::Frame frame;
+    frame.SetName(name + "_frame");
+    EXPECT_TRUE(inner.AddFrame(frame));
+  }
+
+  sdf::Model middle;
+  middle.SetName("middle");
+  EXPECT_TRUE(middle.AddModel(inner));
+
+  sdf::Model outer;
+  outer.SetName("outer");
+  EXPECT_TRUE(outer.AddModel(middle));
+
+  ASSERT_NE(nullptr, outer.LinkByName("middle::inner::b"));
+  EXPECT_EQ(outer.ModelByName("middle::inner")->LinkByIndex(1),
+            outer.LinkByName("middle::inner::b"));
+  ASSERT_NE(nullptr, outer.FrameByName("middle::inner::c_frame"));
+  EXPECT_EQ("c_frame", outer.FrameByName("middle::inner::c_frame")->Name());
+  EXPECT_EQ(nullptr, outer.LinkByName("middle::inner::d"));
+  EXPECT_EQ(nullptr, outer.LinkByName("middle::missing::a"));
+
+  // Objects that are renamed through mutable pointers are still found.
+  sdf::Model *mutableInner = outer.ModelByName("middle::inner");
+  ASSERT_NE(nullptr, mutableInner);
+  mutableInner->LinkByName("a")->SetName("renamed");
+  EXPECT_EQ(nullptr, mutableInner->LinkByName("a"));
+  ASSERT_NE(nullptr, mutableInner->LinkByName("renamed"));
+  EXPECT_EQ(mutableInner->LinkByIndex(0), mutableInner->LinkByName("renamed"));
+
+  // Copies keep their own index.
+  sdf::Model copy = outer;
+  EXPECT_NE(outer.LinkByName("middle::inner::b"),
+            copy.LinkByName("middle::inner::b"));
+  EXPECT_EQ(copy.ModelByName("middle::inner")->LinkByIndex(1),
+            copy.LinkByName("middle::inner::b"));
+
+  mutableInner->ClearLinks();
+  EXPECT_EQ(nullptr, outer.LinkByName("middle::inner::b"));
+  EXPECT_NE(nullptr, copy.LinkByName("middle::inner::b"));
+}
+
+/////////////////////////////////////////////////
+TEST(DOMModel, RenamedLookup)
+{
+  sdf::Model model;
+  for (const std::string name : {"a", "b", "c"})
+  {
+    sdf::Link link;
+    link.SetName(name);
+    EXPECT_TRUE(model.AddLink(link));
+    sdf::Frame frame;
+    frame.SetName(name + "_frame");
+    EXPECT_TRUE(model.AddFrame(frame));
+  }
+  const sdf::Model &constModel = model;
+
+  // Renaming the first link to the name of the third makes it the first
+  // match, as with a linear search.
+  model.LinkByIndex(0)->SetName("c");
+  EXPECT_EQ(model.LinkByIndex(0), constModel.LinkByName("c"));
+  EXPECT_EQ(model.LinkByIndex(0), model.LinkByName("c"));
+  EXPECT_EQ(model.LinkByIndex(0), constModel.LinkByName("c"));
+  EXPECT_EQ(nullptr, constModel.LinkByName("a"));
+
+  // Links added after a rename are found.
+  sdf::Link link;
+  link.SetName("d");
+  EXPECT_TRUE(model.AddLink(link));
+  EXPECT_EQ(model.LinkByIndex(3), constModel.LinkByName("d"));
+
+  model.FrameByIndex(1)->SetName("a_frame");
+  EXPECT_EQ(model.FrameByIndex(0), model.FrameByName("a_frame"));
+  model.FrameByIndex(0)->SetName("c_frame");
+  EXPECT_EQ(model.FrameByIndex(0), constModel.FrameByName("c_frame"));
+  EXPECT_EQ(model.FrameByIndex(1), model.FrameByName("a_frame"));
+}
+
+/////////////////////////////////////////////////
+/// \brief Expect a number of linear searches by name since the counters
+/// were reset, if the counters are enabled.
+/// \param[in] _searches The number of searches.
+static void expectLinearSearches(std::uint64_t _searches)
+{
+  if (sdf::PerfCountersEnabled())
+    EXPECT_EQ(_searches, sdf::GetPerfCounters().nameLookupLinearSearches);
+}
+
+/////////////////////////////////////////////////
+TEST(DOMModel, IndexedLookup)
+{
+  sdf::Model model;
+  for (const std::string name : {"a", "b", "c"})
+  {
+    sdf::Link link;
+    link.SetName(name);
+    EXPECT_TRUE(model.AddLink(link));
+  }
+  const sdf::Model &constModel = model;
+
+  // Renames in other models, and of links that are not in a model, do not
+  // affect the lookups of this model.
+  sdf::Model other;
+  sdf::Link link;
+  link.SetName("a");
+  EXPECT_TRUE(other.AddLink(link));
+  other.LinkByIndex(0)->SetName("x");
+  link.SetName("y");
+
+  // Renaming a link of the model only makes the lookups of its new name
+  // search linearly.
+  model.LinkByIndex(2)->SetName("d");
+
+  sdf::ResetPerfCounters();
+  EXPECT_EQ(model.LinkByIndex(0), constModel.LinkByName("a"));
+  EXPECT_EQ(model.LinkByIndex(1), constModel.LinkByName("b"));
+  EXPECT_TRUE(constModel.LinkNameExists("a"));
+  expectLinearSearches(0u);
+
+  EXPECT_EQ(model.LinkByIndex(2), constModel.LinkByName("d"));
+  expectLinearSearches(1u);
+
+  // The mutable lookups index the new names.
+  EXPECT_EQ(model.LinkByIndex(2), model.LinkByName("d"));
+  sdf::ResetPerfCounters();
+  EXPECT_EQ(model.LinkByIndex(2), constModel.LinkByName("d"));
+  EXPECT_EQ(model.LinkByIndex(0), constModel.LinkByName("a"));
+  expectLinearSearches(0u);
+}
+
+/////////////////////////////////////////////////
+TEST(DOMModel, IndexedLookupAfterCollisionRename)
+{
+  // The joint of the second model is renamed on load, since files older
+  // than 1.7 allow links and joints with the same name.
+  const std::string sdfString = R"(
+  <sdf version="1.6">
+    <world name="default">
+      <model name="first">
+        <link name="a"/>
+        <link name="b"/>
+      </model>
+      <model name="second">
+        <link name="c"/>
+        <link name="d"/>
+        <joint name="d" type="fixed">
+          <parent>c</parent>
+          <child>d</child>
+        </joint>
+      </model>
+    </world>
+  </sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString);
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+
+  sdf::ResetPerfCounters();
+  const sdf::Model *first = world->ModelByName("first");
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(first->LinkByIndex(1), first->LinkByName("b"));
+  const sdf::Model *second = world->ModelByName("second");
+  ASSERT_NE(nullptr, second);
+  EXPECT_EQ(second->JointByIndex(0), second->JointByName("d_joint"));
+  EXPECT_EQ(second->LinkByIndex(1), second->LinkByName("d"));
+  expectLinearSearches(0u);
+}
+
 /////////////////////////////////////////////////
 TEST(DOMModel, Plugins)
 {
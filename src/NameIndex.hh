@@ -0,0 +1,203 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_NAMEINDEX_HH
+#define SDFORMAT_NAMEINDEX_HH
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "sdf/sdf_config.h"
+
+#include "PerfCounting.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Names that the objects of one indexed vector were renamed to
+  /// since its index was built. The record is shared by the index and by
+  /// its objects, whose SetName adds the new name.
+  class NameIndexRenames
+  {
+    /// \brief Record that an object was renamed.
+    /// \param[in] _name New name of the object.
+    public: void Add(std::string_view _name)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->hashes.insert(std::hash<std::string_view>()(_name));
+      this->count.store(this->hashes.size(), std::memory_order_release);
+    }
+
+    /// \brief Check whether no object was renamed.
+    /// \return True if no rename was recorded.
+    public: bool Empty() const
+    {
+      return this->count.load(std::memory_order_acquire) == 0;
+    }
+
+    /// \brief Check whether an object may have been renamed to a name.
+    /// \param[in] _hash Hash of the name.
+    /// \return True if a rename to a name with that hash was recorded.
+    public: bool Contains(std::size_t _hash) const
+    {
+      if (this->Empty())
+        return false;
+      std::lock_guard<std::mutex> lock(this->mutex);
+      return this->hashes.count(_hash) > 0;
+    }
+
+    /// \brief Protects hashes.
+    private: mutable std::mutex mutex;
+
+    /// \brief Hashes of the new names.
+    private: std::unordered_set<std::size_t> hashes;
+
+    /// \brief Size of hashes, read without locking the mutex.
+    private: std::atomic<std::size_t> count{0};
+  };
+
+  /// \brief Hashed index from names to positions in a vector of DOM objects,
+  /// such as the links of a model. The index does not own the objects and
+  /// is kept up to date by the owner of the vector when objects are added or
+  /// removed. Objects can still be renamed through mutable pointers, which
+  /// the owner does not see, so the index gives its objects a
+  /// NameIndexRenames that their SetName adds the new names to. A rename
+  /// can make an earlier object match a name, so a name that an object was
+  /// renamed to is looked up with a linear search until the owner calls
+  /// Refresh, which the mutable lookups of the owner do. Other names keep
+  /// using the index. Every match is also checked against the current name,
+  /// and names that are not in the index are looked up with a linear
+  /// search.
+  template <typename T>
+  class NameIndex
+  {
+    /// \brief Index every object of a vector, replacing the current index.
+    /// \param[in] _items Objects to index.
+    public: void Rebuild(std::vector<T> &_items)
+    {
+      // The previous record may be shared with a copy of the owner, whose
+      // index still needs it, so it is replaced instead of cleared.
+      this->renames = std::make_shared<NameIndexRenames>();
+      this->positions.clear();
+      this->positions.reserve(_items.size());
+      for (std::size_t i = 0; i < _items.size(); ++i)
+        this->Add(_items, i);
+    }
+
+    /// \brief Rebuild the index if an object was renamed since it was
+    /// built.
+    /// \param[in] _items Objects to index.
+    public: void Refresh(std::vector<T> &_items)
+    {
+      if (this->renames && !this->renames->Empty())
+        this->Rebuild(_items);
+    }
+
+    /// \brief Index one object of a vector.
+    /// \param[in] _items Vector that holds the object.
+    /// \param[in] _position Position of the object in _items.
+    public: void Add(std::vector<T> &_items, std::size_t _position)
+    {
+      if (!this->renames)
+        this->renames = std::make_shared<NameIndexRenames>();
+      this->Track(_items[_position]);
+      const std::string name = _items[_position].Name();
+      this->positions.emplace(Hash(name), _position);
+    }
+
+    /// \brief Have the renames of an object that replaced an indexed object
+    /// with the same name recorded by this index.
+    /// \param[in] _item The object.
+    public: void Track(T &_item) const
+    {
+      if (this->renames)
+        _item.SetNameIndexRenames(this->renames);
+    }
+
+    /// \brief Remove every object from the index.
+    public: void Clear()
+    {
+      this->renames.reset();
+      this->positions.clear();
+    }
+
+    /// \brief Find the first object with a given name.
+    /// \param[in] _items Vector that holds the indexed objects.
+    /// \param[in] _name Name of the object.
+    /// \return The object, or nullptr if no object has that name.
+    public: const T *Find(const std::vector<T> &_items,
+                          std::string_view _name) const
+    {
+      const std::size_t hash = Hash(_name);
+      auto range = this->positions.equal_range(hash);
+      if (this->renames && this->renames->Contains(hash))
+        range.first = range.second;
+
+      const T *result = nullptr;
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        if (it->second < _items.size() &&
+            (nullptr == result || &_items[it->second] < result) &&
+            _items[it->second].Name() == _name)
+        {
+          result = &_items[it->second];
+        }
+      }
+
+      if (nullptr != result)
+        return result;
+
+      countPerf(PerfCounter::NAME_LOOKUP_LINEAR_SEARCHES);
+      for (const auto &item : _items)
+      {
+        if (item.Name() == _name)
+          return &item;
+      }
+      return nullptr;
+    }
+
+    /// \brief Hash a name.
+    /// \param[in] _name Name to hash.
+    /// \return Hash of the name.
+    private: static std::size_t Hash(std::string_view _name)
+    {
+      return std::hash<std::string_view>()(_name);
+    }
+
+    /// \brief Positions of the indexed objects, keyed by the hash of their
+    /// names. Names are not stored, since they are compared against the
+    /// objects themselves.
+    private: std::unordered_multimap<std::size_t, std::size_t> positions;
+
+    /// \brief Names that the indexed objects were renamed to since the
+    /// index was built, shared with the objects. Null if no object was
+    /// indexed.
+    private: std::shared_ptr<NameIndexRenames> renames;
+  };
+  }
+}
+#endif
@@ -15,6 +15,7 @@
  *
  */
 #include "sdf/NavSat.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 using namespace ignition;
@@ -49,7 +50,7 @@ Errors NavSat::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that sdf is a valid pointer
   if (!_sdf)
@@ -19,6 +19,7 @@
 #include "sdf/Noise.hh"
 #include "sdf/parser.hh"
 #include "sdf/Types.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
@@ -66,7 +67,7 @@ Errors Noise::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <noise> element.
   // This is an error that cannot be recovered, so return an error.
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <cmath>
+
+#include <ignition/math/Helpers.hh>
+
+#include "sdf/NoiseSampler.hh"
+
+using namespace sdf;
+
+/// \brief Private noise sampler data.
+class sdf::NoiseSampler::Implementation
+{
+  /// \brief The noise.
+  public: Noise noise;
+
+  /// \brief Seed of the generator.
+  public: uint64_t seed = 0;
+
+  /// \brief Key of the generator, derived from the seed.
+  public: uint64_t key = 0;
+
+  /// \brief Constant bias.
+  public: double bias = 0.0;
+
+  /// \brief Whether noisy measurements are rounded to the precision.
+  public: bool quantized = false;
+};
+
+/// \brief Stream reserved for the draws of the bias.
+static const uint64_t kBiasStream = ~uint64_t(0);
+
+/////////////////////////////////////////////////
+/// \brief Scramble the bits of a 64 bit value, with the finalizer of the
+/// SplitMix64 generator.
+/// \param[in] _z The value.
+/// \return The scrambled value.
+static uint64_t mix(uint64_t _z)
+{
+  _z += 0x9e3779b97f4a7c15ull;
+  _z = (_z ^ (_z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  _z = (_z ^ (_z >> 27)) * 0x94d049bb133111ebull;
+  return _z ^ (_z >> 31);
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert random bits to a uniform value in (0, 1].
+/// \param[in] _bits The random bits.
+/// \return The uniform value.
+static double uniform(uint64_t _bits)
+{
+  return static_cast<double>((_bits >> 11) + 1) * 0x1.0p-53;
+}
+
+/////////////////////////////////////////////////
+/// \brief Draw a value from the standard normal distribution with the Box
+/// Muller transform of two uniform values drawn for a counter.
+/// \param[in] _key Key of the generator.
+/// \param[in] _stream Stream of the value.
+/// \param[in] _index Index of the value in the stream.
+/// \return The value.
+static double standardNormal(uint64_t _key, uint64_t _stream,
+    uint64_t _index)
+{
+  const uint64_t counter = mix(_key ^ mix(_stream)) ^ _index;
+  const double u1 = uniform(mix(counter));
+  const double u2 = uniform(mix(counter ^ 0xd6e8feb86659fd93ull));
+  return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * IGN_PI * u2);
+}
+
+/////////////////////////////////////////////////
+NoiseSampler::NoiseSampler()
+  : dataPtr(ignition::utils::MakeImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+NoiseSampler::NoiseSampler(const Noise &_noise, uint64_t _seed)
+  : dataPtr(ignition::utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->noise = _noise;
+  this->dataPtr->seed = _seed;
+  this->dataPtr->key = mix(_seed);
+  this->dataPtr->quantized =
+      _noise.Type() == NoiseType::GAUSSIAN_QUANTIZED &&
+      _noise.Precision() > 0.0;
+
+  if (_noise.Type() != NoiseType::NONE)
+  {
+    // The bias is drawn once, and is negated half of the time.
+    double bias = _noise.BiasMean() + _noise.BiasStdDev() *
+        standardNormal(this->dataPtr->key, kBiasStream, 0);
+    if (uniform(mix(this->dataPtr->key ^ kBiasStream)) < 0.5)
+      bias = -bias;
+    this->dataPtr->bias = bias;
+  }
+}
+
+/////////////////////////////////////////////////
+const Noise &NoiseSampler::NoiseModel() const
+{
+  return this->dataPtr->noise;
+}
+
+/////////////////////////////////////////////////
+uint64_t NoiseSampler::Seed() const
+{
+  return this->dataPtr->seed;
+}
+
+/////////////////////////////////////////////////
+double NoiseSampler::Bias() const
+{
+  return this->dataPtr->bias;
+}
+
+/////////////////////////////////////////////////
+double NoiseSampler::Sample(uint64_t _stream, uint64_t _index) const
+{
+  const Noise &noise = this->dataPtr->noise;
+  if (noise.Type() == NoiseType::NONE)
+    return 0.0;
+
+  return noise.Mean() + this->dataPtr->bias + noise.StdDev() *
+      standardNormal(this->dataPtr->key, _stream, _index);
+}
+
+/////////////////////////////////////////////////
+double NoiseSampler::Apply(double _value, uint64_t _stream,
+    uint64_t _index) const
+{
+  if (this->dataPtr->noise.Type() == NoiseType::NONE)
+    return _value;
+
+  double value = _value + this->Sample(_stream, _index);
+  if (this->dataPtr->quantized)
+  {
+    const double precision = this->dataPtr->noise.Precision();
+    value = std::round(value / precision) * precision;
+  }
+  return value;
+}
+
+/////////////////////////////////////////////////
+/// \brief Add noise to a buffer of measurements.
+/// \param[in] _sampler The sampler.
+/// \param[in,out] _data The measurements.
+/// \param[in] _count Number of measurements in _data.
+/// \param[in] _stream Stream of the measurements.
+/// \param[in] _first Index in the stream of the first measurement.
+template <typename T>
+static void applyToBuffer(const NoiseSampler &_sampler, T *_data,
+    std::size_t _count, uint64_t _stream, uint64_t _first)
+{
+  if (nullptr == _data ||
+      _sampler.NoiseModel().Type() == NoiseType::NONE)
+  {
+    return;
+  }
+
+  // Every value only depends on its own index, so the iterations are
+  // independent.
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    _data[i] = static_cast<T>(
+        _sampler.Apply(static_cast<double>(_data[i]), _stream, _first + i));
+  }
+}
+
+/////////////////////////////////////////////////
+void NoiseSampler::Apply(double *_data, std::size_t _count,
+    uint64_t _stream, uint64_t _first) const
+{
+  applyToBuffer(*this, _data, _count, _stream, _first);
+}
+
+/////////////////////////////////////////////////
+void NoiseSampler::Apply(float *_data, std::size_t _count,
+    uint64_t _stream, uint64_t _first) const
+{
+  applyToBuffer(*this, _data, _count, _stream, _first);
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "sdf/Noise.hh"
+#include "sdf/NoiseSampler.hh"
+
+/////////////////////////////////////////////////
+TEST(DOMNoiseSampler, None)
+{
+  sdf::NoiseSampler sampler;
+  EXPECT_EQ(sdf::NoiseType::NONE, sampler.NoiseModel().Type());
+  EXPECT_DOUBLE_EQ(0.0, sampler.Bias());
+  EXPECT_DOUBLE_EQ(0.0, sampler.Sample(0, 0));
+  EXPECT_DOUBLE_EQ(1.5, sampler.Apply(1.5, 0, 0));
+
+  std::vector<float> data(4, 2.0f);
+  sampler.Apply(data.data(), data.size(), 0);
+  for (float value : data)
+    EXPECT_FLOAT_EQ(2.0f, value);
+}
+
+/////////////////////////////////////////////////
+TEST(DOMNoiseSampler, Gaussian)
+{
+  sdf::Noise noise;
+  noise.SetType(sdf::NoiseType::GAUSSIAN);
+  noise.SetMean(1.0);
+  noise.SetStdDev(0.5);
+
+  sdf::NoiseSampler sampler(noise, 7);
+  EXPECT_EQ(7u, sampler.Seed());
+  EXPECT_DOUBLE_EQ(0.0, sampler.Bias());
+
+  const std::size_t count = 100000;
+  std::vector<double> data(count, 0.0);
+  sampler.Apply(data.data(), count, 3);
+
+  double sum = 0.0;
+  double sumSquares = 0.0;
+  for (double value : data)
+  {
+    sum += value;
+    sumSquares += value * value;
+  }
+  const double mean = sum / count;
+  EXPECT_NEAR(1.0, mean, 0.01);
+  EXPECT_NEAR(0.5, std::sqrt(sumSquares / count - mean * mean), 0.01);
+
+  // Values only depend on the seed, the stream and the index, so a buffer
+  // can be sampled in parts.
+  std::vector<double> parts(count, 0.0);
+  sampler.Apply(parts.data(), count / 2, 3);
+  sampler.Apply(parts.data() + count / 2, count - count / 2, 3, count / 2);
+  EXPECT_EQ(data, parts);
+  EXPECT_DOUBLE_EQ(data[10], sampler.Sample(3, 10));
+
+  // Other streams and seeds draw other values.
+  EXPECT_NE(sampler.Sample(3, 10), sampler.Sample(4, 10));
+  EXPECT_NE(sampler.Sample(3, 10), sdf::NoiseSampler(noise, 8).Sample(3, 10));
+  EXPECT_DOUBLE_EQ(sampler.Sample(3, 10),
+                   sdf::NoiseSampler(noise, 7).Sample(3, 10));
+}
+
+/////////////////////////////////////////////////
+TEST(DOMNoiseSampler, BiasAndQuantization)
+{
+  sdf::Noise noise;
+  noise.SetType(sdf::NoiseType::GAUSSIAN_QUANTIZED);
+  noise.SetBiasMean(2.0);
+  noise.SetPrecision(0.25);
+
+  // Without a bias standard deviation, the bias is the mean with a random
+  // sign.
+  sdf::NoiseSampler sampler(noise, 1);
+  EXPECT_DOUBLE_EQ(2.0, std::abs(sampler.Bias()));
+  EXPECT_DOUBLE_EQ(sampler.Bias(), sampler.Sample(0, 5));
+
+  noise.SetStdDev(0.1);
+  sampler = sdf::NoiseSampler(noise, 1);
+  for (uint64_t i = 0; i < 100; ++i)
+  {
+    const double value = sampler.Apply(0.3, 0, i);
+    EXPECT_DOUBLE_EQ(value, std::round(value / 0.25) * 0.25);
+  }
+}
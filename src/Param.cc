@@ -17,10 +17,19 @@
 
 #include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <cmath>
 #include <cstdint>
+#include <iomanip>
+#include <limits>
 #include <locale>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 #include <array>
 
@@ -32,7 +41,11 @@
 #include "sdf/Types.hh"
 #include "sdf/Element.hh"
 
+#include "PerfCounting.hh"
+#include "ParamValueChecks.hh"
+
 using namespace sdf;
+using ValueType = ParamPrivate::ValueType;
 
 // For some locale, the decimal separator is not a point, but a
 // comma. To avoid that the SDF parsing is influenced by the current
@@ -59,27 +72,106 @@ namespace sdf
   }
 }
 
+//////////////////////////////////////////////////
+struct CustomValueTypes;
+
+/// \brief Add the arrays of numbers to the registered value types.
+/// \param[in, out] _types The registered types.
+static void addNumberArrayTypes(CustomValueTypes &_types);
+
+//////////////////////////////////////////////////
+/// \brief Value types registered with Param::RegisterValueType.
+struct CustomValueTypes
+{
+  /// \brief Constructor, which registers the arrays of numbers.
+  CustomValueTypes()
+  {
+    addNumberArrayTypes(*this);
+  }
+
+  /// \brief Protects types.
+  std::mutex mutex;
+
+  /// \brief The types, by name.
+  std::unordered_map<std::string, std::shared_ptr<const ParamCustomValueType>>
+      types;
+};
+
+//////////////////////////////////////////////////
+/// \brief Get the value types registered with Param::RegisterValueType.
+/// \return The registered types.
+static CustomValueTypes &customValueTypes()
+{
+  static CustomValueTypes types;
+  return types;
+}
+
+//////////////////////////////////////////////////
+/// \brief Find a value type registered with Param::RegisterValueType.
+/// \param[in] _typeName Name of the type.
+/// \return The type, or nullptr if no type has that name.
+static std::shared_ptr<const ParamCustomValueType> findCustomValueType(
+    const std::string &_typeName)
+{
+  CustomValueTypes &types = customValueTypes();
+  std::lock_guard<std::mutex> lock(types.mutex);
+  auto it = types.types.find(_typeName);
+  return it == types.types.end() ? nullptr : it->second;
+}
+
+//////////////////////////////////////////////////
+bool Param::RegisterCustomValueType(
+    std::shared_ptr<const ParamCustomValueType> _type)
+{
+  if (ParamPrivate::ValueTypeFromName(_type->typeName) != ValueType::UNKNOWN)
+    return false;
+
+  CustomValueTypes &types = customValueTypes();
+  std::lock_guard<std::mutex> lock(types.mutex);
+  return types.types.emplace(_type->typeName, std::move(_type)).second;
+}
+
 //////////////////////////////////////////////////
 Param::Param(const std::string &_key, const std::string &_typeName,
              const std::string &_default, bool _required,
              const std::string &_description)
   : dataPtr(new ParamPrivate)
 {
-  this->dataPtr->key = _key;
-  this->dataPtr->required = _required;
-  this->dataPtr->typeName = _typeName;
-  this->dataPtr->description = _description;
+  auto desc = std::make_shared<ParamPrivate::Description>();
+  desc->key = _key;
+  desc->required = _required;
+  desc->typeName = _typeName;
+  desc->valueType = ParamPrivate::ValueTypeFromName(_typeName);
+  desc->description = _description;
+  desc->defaultStrValue = _default;
+  this->dataPtr->desc = desc;
   this->dataPtr->set = false;
   this->dataPtr->ignoreParentAttributes = false;
-  this->dataPtr->defaultStrValue = _default;
+
+  // Values of registered types are kept in customValue, and the variant
+  // holds the default string.
+  if (desc->valueType == ValueType::UNKNOWN)
+    desc->customType = findCustomValueType(_typeName);
+  if (desc->customType)
+  {
+    SDF_ASSERT(
+        desc->customType->fromString(std::string(sdf::trimView(_default)),
+                                     desc->customDefaultValue),
+        "Invalid parameter");
+    desc->defaultValue = _default;
+    this->dataPtr->value = desc->defaultValue;
+    this->dataPtr->customValue = desc->customDefaultValue;
+    this->dataPtr->strValue = std::nullopt;
+    return;
+  }
 
   SDF_ASSERT(
       this->dataPtr->ValueFromStringImpl(
-          this->dataPtr->typeName,
+          desc->valueType,
           _default,
-          this->dataPtr->defaultValue),
+          desc->defaultValue),
       "Invalid parameter");
-  this->dataPtr->value = this->dataPtr->defaultValue;
+  this->dataPtr->value = desc->defaultValue;
   this->dataPtr->strValue = std::nullopt;
 }
 
@@ -90,13 +182,22 @@ Param::Param(const std::string &_key, const std::string &_typeName,
              const std::string &_description)
     : Param(_key, _typeName, _default, _required, _description)
 {
+  if (_minValue.empty() && _maxValue.empty())
+    return;
+
+  SDF_ASSERT(!this->dataPtr->desc->customType,
+      std::string("[min] and [max] are not supported by the type of [") +
+          _key + "]");
+
+  auto desc = std::make_shared<ParamPrivate::Description>(
+      *this->dataPtr->desc);
   if (!_minValue.empty())
   {
     SDF_ASSERT(
         this->dataPtr->ValueFromStringImpl(
-            this->dataPtr->typeName,
+            desc->valueType,
             _minValue,
-            this->dataPtr->minValue.emplace()),
+            desc->minValue.emplace()),
         std::string("Invalid [min] parameter in SDFormat description of [") +
             _key + "]");
   }
@@ -105,12 +206,13 @@ Param::Param(const std::string &_key, const std::string &_typeName,
   {
     SDF_ASSERT(
         this->dataPtr->ValueFromStringImpl(
-            this->dataPtr->typeName,
+            desc->valueType,
             _maxValue,
-            this->dataPtr->maxValue.emplace()),
+            desc->maxValue.emplace()),
         std::string("Invalid [max] parameter in SDFormat description of [") +
             _key + "]");
   }
+  this->dataPtr->desc = std::move(desc);
 }
 
 //////////////////////////////////////////////////
@@ -134,13 +236,20 @@ Param &Param::operator=(const Param &_param)
 
   // Restore the update func
   this->dataPtr->updateFunc = updateFuncCopy;
+  this->InvalidateParentContentHash();
   return *this;
 }
 
 //////////////////////////////////////////////////
 bool Param::GetAny(std::any &_anyVal) const
 {
-  if (this->IsType<int>())
+  if (this->dataPtr->desc->customType)
+  {
+    if (!this->ParseLazyValue())
+      return false;
+    _anyVal = this->dataPtr->customValue;
+  }
+  else if (this->IsType<int>())
   {
     int ret = 0;
     if (!this->Get<int>(ret))
@@ -291,6 +400,19 @@ void Param::Update()
     try
     {
       std::any newValue = this->dataPtr->updateFunc();
+      if (this->dataPtr->desc->customType)
+      {
+        if (newValue.type() == *this->dataPtr->desc->customType->type)
+        {
+          this->SetCustomValue(std::move(newValue));
+          return;
+        }
+        sdferr << "Unable to set value using Update for key["
+               << this->dataPtr->desc->key << "]\n";
+        return;
+      }
+      this->dataPtr->lazyValuePending = false;
+      this->InvalidateParentContentHash();
       std::visit([&](auto &&arg)
         {
           using T = std::decay_t<decltype(arg)>;
@@ -300,7 +422,7 @@ void Param::Update()
     catch(...)
     {
       sdferr << "Unable to set value using Update for key["
-             << this->dataPtr->key << "]\n";
+             << this->dataPtr->desc->key << "]\n";
     }
   }
 }
@@ -308,10 +430,18 @@ void Param::Update()
 //////////////////////////////////////////////////
 std::string Param::GetAsString(const PrintConfig &_config) const
 {
+  if (this->dataPtr->desc->customType)
+  {
+    if (this->ParseLazyValue() && this->GetSet())
+      return this->dataPtr->desc->customType->toString(
+          this->dataPtr->customValue);
+    return this->GetDefaultAsString(_config);
+  }
+
   std::string valueStr;
-  if (this->GetSet() &&
+  if (this->ParseLazyValue() && this->GetSet() &&
       this->dataPtr->StringFromValueImpl(_config,
-                                         this->dataPtr->typeName,
+                                         this->dataPtr->desc->valueType,
                                          this->dataPtr->value,
                                          this->dataPtr->strValue,
                                          valueStr))
@@ -325,12 +455,18 @@ std::string Param::GetAsString(const PrintConfig &_config) const
 //////////////////////////////////////////////////
 std::string Param::GetDefaultAsString(const PrintConfig &_config) const
 {
+  if (this->dataPtr->desc->customType)
+  {
+    return this->dataPtr->desc->customType->toString(
+        this->dataPtr->desc->customDefaultValue);
+  }
+
   std::string defaultStr;
   if (this->dataPtr->StringFromValueImpl(
         _config,
-        this->dataPtr->typeName,
-        this->dataPtr->defaultValue,
-        this->dataPtr->defaultStrValue,
+        this->dataPtr->desc->valueType,
+        this->dataPtr->desc->defaultValue,
+        this->dataPtr->desc->defaultStrValue,
         defaultStr))
   {
     return defaultStr;
@@ -339,7 +475,7 @@ std::string Param::GetDefaultAsString(const PrintConfig &_config) const
   sdferr << "Unable to get string from default value, "
          << "using ParamStreamer instead.\n";
   StringStreamClassicLocale ss;
-  ss << ParamStreamer{ this->dataPtr->defaultValue };
+  ss << ParamStreamer{ this->dataPtr->desc->defaultValue };
   return ss.str();
 }
 
@@ -347,13 +483,12 @@ std::string Param::GetDefaultAsString(const PrintConfig &_config) const
 std::optional<std::string> Param::GetMinValueAsString(
     const PrintConfig &_config) const
 {
-  if (this->dataPtr->minValue.has_value())
+  if (this->dataPtr->desc->minValue.has_value())
   {
     std::string valueStr;
-    if (!this->dataPtr->StringFromValueImpl(_config,
-                                            this->dataPtr->typeName,
-                                            this->dataPtr->minValue.value(),
-                                            valueStr))
+    const ParamPrivate::Description &desc = *this->dataPtr->desc;
+    if (!this->dataPtr->StringFromValueImpl(_config, desc.valueType,
+                                            desc.minValue.value(), valueStr))
     {
       sdferr << "Unable to get min value as string.\n";
       return std::nullopt;
@@ -368,13 +503,12 @@ std::optional<std::string> Param::GetMinValueAsString(
 std::optional<std::string> Param::GetMaxValueAsString(
     const PrintConfig &_config) const
 {
-  if (this->dataPtr->maxValue.has_value())
+  if (this->dataPtr->desc->maxValue.has_value())
   {
     std::string valueStr;
-    if (!this->dataPtr->StringFromValueImpl(_config,
-                                            this->dataPtr->typeName,
-                                            this->dataPtr->maxValue.value(),
-                                            valueStr))
+    const ParamPrivate::Description &desc = *this->dataPtr->desc;
+    if (!this->dataPtr->StringFromValueImpl(_config, desc.valueType,
+                                            desc.maxValue.value(), valueStr))
     {
       sdferr << "Unable to get max value as string.\n";
       return std::nullopt;
@@ -385,6 +519,236 @@ std::optional<std::string> Param::GetMaxValueAsString(
   return std::nullopt;
 }
 
+//////////////////////////////////////////////////
+/// \brief Check whether a character is whitespace in the classic locale, as
+/// skipped by operator>> of std::istream.
+/// \param[in] _c Character to check.
+/// \return True if _c is whitespace.
+inline bool isClassicSpace(char _c)
+{
+  return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\v' || _c == '\f' ||
+      _c == '\r';
+}
+
+//////////////////////////////////////////////////
+/// \brief Extract the next whitespace separated token from a string, like
+/// operator>> of std::istream does for std::string, without copying.
+/// \param[in,out] _str String to read from. The token and the whitespace
+/// before it are removed.
+/// \param[out] _token The token.
+/// \return True if a token was found.
+bool nextToken(std::string_view &_str, std::string_view &_token)
+{
+  std::size_t begin = 0;
+  while (begin < _str.size() && isClassicSpace(_str[begin]))
+    ++begin;
+  std::size_t end = begin;
+  while (end < _str.size() && !isClassicSpace(_str[end]))
+    ++end;
+
+  _token = _str.substr(begin, end - begin);
+  _str.remove_prefix(end);
+  return !_token.empty();
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse a number that spans the whole string with std::from_chars,
+/// which does not allocate and does not depend on the current locale. The
+/// accepted strings are a subset of those accepted by std::stoi, std::stoul,
+/// std::stod and std::stof, which give the same value for them. Callers fall
+/// back to those functions when this fails, so that error handling and the
+/// other accepted formats (such as a leading '+') are unchanged.
+/// \param[in] _str String to parse.
+/// \param[out] _value The parsed number.
+/// \param[in] _base Base of integer numbers.
+/// \return True if the whole string was parsed.
+template <typename T>
+bool fromCharsExact(std::string_view _str, T &_value, int _base = 10)
+{
+  const char *begin = _str.data();
+  const char *end = begin + _str.size();
+  std::from_chars_result result;
+  if constexpr (std::is_floating_point_v<T>)
+  {
+    (void)_base;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    result = std::from_chars(begin, end, _value);
+
+    // The C library functions report an error when the result underflows,
+    // so leave underflowing and subnormal results to them.
+    if (result.ec == std::errc() && (_value == 0 || !std::isnormal(_value)))
+    {
+      const char *exponent = std::find_if(begin, end,
+          [](char _c) {return _c == 'e' || _c == 'E';});
+      if (std::isfinite(_value) && std::find_if(begin, exponent,
+            [](char _c) {return _c >= '1' && _c <= '9';}) != exponent)
+      {
+        return false;
+      }
+    }
+#else
+    // Floating point std::from_chars is not provided by this standard
+    // library.
+    (void)begin;
+    (void)end;
+    (void)_value;
+    return false;
+#endif
+  }
+  else
+  {
+    result = std::from_chars(begin, end, _value, _base);
+  }
+  return !_str.empty() && result.ec == std::errc() && result.ptr == end;
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse a floating point token with std::from_chars, falling back to
+/// std::stod or std::stof.
+/// \param[in] _token Token to parse.
+/// \return The parsed number.
+/// \throws std::invalid_argument or std::out_of_range like std::stod and
+/// std::stof.
+template <typename T>
+T parseFloatingPointToken(std::string_view _token)
+{
+  T value;
+  if (fromCharsExact(_token, value))
+    return value;
+
+  if constexpr (std::is_same_v<T, float>)
+    return std::stof(std::string(_token));
+  else
+    return std::stod(std::string(_token));
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse a fixed number of whitespace separated numbers without a
+/// stream. This only succeeds for input that operator>> of a classic locale
+/// stream reads as exactly _values.size() numbers, so callers fall back to
+/// the stream for anything else.
+/// \param[in] _input Input string.
+/// \param[out] _values The parsed numbers.
+/// \return True if the input consists of exactly _values.size() numbers.
+template <typename T, std::size_t N>
+bool parseNumbersFast(std::string_view _input, std::array<T, N> &_values)
+{
+  std::string_view token;
+  for (auto &value : _values)
+  {
+    if (!nextToken(_input, token))
+      return false;
+
+    // Streams do not accept the "inf" and "nan" spellings or hexadecimal
+    // numbers, so leave any token with letters other than an exponent to the
+    // stream.
+    for (char c : token)
+    {
+      if (std::isalpha(static_cast<unsigned char>(c)) && c != 'e' && c != 'E')
+        return false;
+    }
+
+    if (!fromCharsExact(token, value))
+      return false;
+  }
+  return !nextToken(_input, token);
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse the numeric types that make up most values in SDFormat files
+/// without allocating and without touching the global locale. This accepts
+/// the common spellings of numbers only; anything else, including input that
+/// is invalid, is left to ParamPrivate::ValueFromStringImpl so that its
+/// semantics and error messages are unchanged.
+/// \param[in] _type Type of the value.
+/// \param[in] _valueStr String to parse.
+/// \param[out] _valueToSet This will be set with the parsed value.
+/// \return True if the value was parsed.
+bool ValueFromStringFast(ValueType _type,
+                         std::string_view _valueStr,
+                         ParamPrivate::ParamVariant &_valueToSet)
+{
+  // Trim like sdf::trim does.
+  const std::size_t begin = _valueStr.find_first_not_of(" \t\n");
+  if (begin == std::string_view::npos)
+    return false;
+  _valueStr = _valueStr.substr(
+      begin, _valueStr.find_last_not_of(" \t\n") - begin + 1);
+
+  // Numbers prefixed with 0x are parsed as hexadecimal by std::stoi and
+  // std::stoul. Signs after the prefix are left to them.
+  std::string_view intStr = _valueStr;
+  int numericBase = 10;
+  if (intStr.size() > 2 && intStr[0] == '0' &&
+      (intStr[1] == 'x' || intStr[1] == 'X') && intStr[2] != '-')
+  {
+    intStr.remove_prefix(2);
+    numericBase = 16;
+  }
+
+  if (_type == ValueType::INT)
+  {
+    int value;
+    if (!fromCharsExact(intStr, value, numericBase))
+      return false;
+    _valueToSet = value;
+  }
+  else if (_type == ValueType::UNSIGNED_INT)
+  {
+    unsigned int value;
+    if (!fromCharsExact(intStr, value, numericBase))
+      return false;
+    _valueToSet = value;
+  }
+  else if (_type == ValueType::UINT64)
+  {
+    std::uint64_t value;
+    if (!fromCharsExact(_valueStr, value))
+      return false;
+    _valueToSet = value;
+  }
+  else if (_type == ValueType::DOUBLE)
+  {
+    double value;
+    if (!fromCharsExact(_valueStr, value))
+      return false;
+    _valueToSet = value;
+  }
+  else if (_type == ValueType::FLOAT)
+  {
+    float value;
+    if (!fromCharsExact(_valueStr, value))
+      return false;
+    _valueToSet = value;
+  }
+  else if (_type == ValueType::VECTOR2I)
+  {
+    std::array<int, 2> values;
+    if (!parseNumbersFast(_valueStr, values))
+      return false;
+    _valueToSet = ignition::math::Vector2i(values[0], values[1]);
+  }
+  else if (_type == ValueType::VECTOR2D)
+  {
+    std::array<double, 2> values;
+    if (!parseNumbersFast(_valueStr, values))
+      return false;
+    _valueToSet = ignition::math::Vector2d(values[0], values[1]);
+  }
+  else if (_type == ValueType::VECTOR3D)
+  {
+    std::array<double, 3> values;
+    if (!parseNumbersFast(_valueStr, values))
+      return false;
+    _valueToSet = ignition::math::Vector3d(values[0], values[1], values[2]);
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 /// \brief Helper function for Param::ValueFromString
 /// \param[in] _input Input string.
@@ -420,16 +784,16 @@ bool ParseUsingStringStream(const std::string &_input, const std::string &_key,
 bool ParseColorUsingStringStream(const std::string &_input,
     const std::string &_key, ParamPrivate::ParamVariant &_value)
 {
-  StringStreamClassicLocale ss(_input);
-  std::string token;
+  std::string_view input = _input;
+  std::string_view token;
   std::vector<float> colors;
   float c;  // r,g,b,a values
   bool isValidColor = true;
-  while (ss >> token)
+  while (nextToken(input, token))
   {
     try
     {
-      c = std::stof(token);
+      c = parseFloatingPointToken<float>(token);
       colors.push_back(c);
     }
     // Catch invalid argument exception from std::stof
@@ -546,17 +910,17 @@ bool ParsePoseUsingStringStream(const std::string &_input,
     return true;
   }
 
-  StringStreamClassicLocale ss(_input);
-  std::string token;
+  std::string_view input = _input;
+  std::string_view token;
   std::array<double, 7> values;
   std::size_t valueIndex = 0;
   double v;
   bool isValidPose = true;
-  while (ss >> token)
+  while (nextToken(input, token))
   {
     try
     {
-      v = std::stod(token);
+      v = parseFloatingPointToken<double>(token);
     }
     // Catch invalid argument exception from std::stod
     catch(std::invalid_argument &)
@@ -627,21 +991,156 @@ bool ParsePoseUsingStringStream(const std::string &_input,
   return true;
 }
 
+//////////////////////////////////////////////////
+/// \brief Parse a pose and the attributes of its element that govern it,
+/// without allocating and without a stream. This accepts the same input as
+/// ParsePoseUsingStringStream for the common spellings of numbers only, and
+/// leaves anything else, including input that is invalid, to it.
+/// \param[in] _input Input string.
+/// \param[in] _attributes Attributes of the pose element, or nullptr.
+/// \param[out] _value This will be set with the parsed pose.
+/// \return True if the pose was parsed.
+bool PoseFromStringFast(std::string_view _input, const Param_V *_attributes,
+                        ParamPrivate::ParamVariant &_value)
+{
+  bool parseAsDegrees = false;
+  bool quaternion = false;
+  if (_attributes)
+  {
+    for (const auto &p : *_attributes)
+    {
+      const std::string &key = p->GetKey();
+      if (key == "degrees")
+      {
+        const bool *degrees = p->GetPtr<bool>();
+        if (!degrees)
+          return false;
+        parseAsDegrees = *degrees;
+      }
+      else if (key == "rotation_format")
+      {
+        const std::string *format = p->GetPtr<std::string>();
+        if (!format || (*format != "euler_rpy" && *format != "quat_xyzw"))
+          return false;
+        quaternion = *format == "quat_xyzw";
+      }
+    }
+  }
+
+  if (quaternion)
+  {
+    std::array<double, 7> values;
+    if (parseAsDegrees || !parseNumbersFast(_input, values))
+      return false;
+    for (double v : values)
+    {
+      if (!std::isfinite(v))
+        return false;
+    }
+    _value = ignition::math::Pose3d(values[0], values[1], values[2],
+        values[6], values[3], values[4], values[5]);
+    return true;
+  }
+
+  std::array<double, 6> values;
+  if (!parseNumbersFast(_input, values))
+    return false;
+  for (double v : values)
+  {
+    if (!std::isfinite(v))
+      return false;
+  }
+  if (parseAsDegrees)
+  {
+    _value = ignition::math::Pose3d(values[0], values[1], values[2],
+        IGN_DTOR(values[3]), IGN_DTOR(values[4]), IGN_DTOR(values[5]));
+  }
+  else
+  {
+    _value = ignition::math::Pose3d(values[0], values[1], values[2],
+        values[3], values[4], values[5]);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+ValueType ParamPrivate::ValueTypeFromName(const std::string &_typeName)
+{
+  static const std::unordered_map<std::string, ValueType> types = {
+    {"bool", ValueType::BOOL},
+    {"char", ValueType::CHAR},
+    {"std::string", ValueType::STRING},
+    {"string", ValueType::STRING},
+    {"int", ValueType::INT},
+    {"uint64_t", ValueType::UINT64},
+    {"unsigned int", ValueType::UNSIGNED_INT},
+    {"double", ValueType::DOUBLE},
+    {"float", ValueType::FLOAT},
+    {"sdf::Time", ValueType::TIME},
+    {"time", ValueType::TIME},
+    {"ignition::math::Angle", ValueType::ANGLE},
+    {"angle", ValueType::ANGLE},
+    {"ignition::math::Color", ValueType::COLOR},
+    {"color", ValueType::COLOR},
+    {"ignition::math::Vector2i", ValueType::VECTOR2I},
+    {"vector2i", ValueType::VECTOR2I},
+    {"ignition::math::Vector2d", ValueType::VECTOR2D},
+    {"vector2d", ValueType::VECTOR2D},
+    {"ignition::math::Vector3d", ValueType::VECTOR3D},
+    {"vector3", ValueType::VECTOR3D},
+    {"ignition::math::Pose3d", ValueType::POSE},
+    {"pose", ValueType::POSE},
+    {"Pose", ValueType::POSE},
+    {"ignition::math::Quaterniond", ValueType::QUATERNION},
+    {"quaternion", ValueType::QUATERNION},
+  };
+
+  auto it = types.find(_typeName);
+  return it == types.end() ? ValueType::UNKNOWN : it->second;
+}
+
 //////////////////////////////////////////////////
 bool ParamPrivate::ValueFromStringImpl(const std::string &_typeName,
                                        const std::string &_valueStr,
                                        ParamVariant &_valueToSet) const
 {
+  const ValueType type = ValueTypeFromName(_typeName);
+  if (type == ValueType::UNKNOWN)
+  {
+    sdferr << "Unknown parameter type[" << _typeName << "]\n";
+    return false;
+  }
+  return this->ValueFromStringImpl(type, _valueStr, _valueToSet);
+}
+
+//////////////////////////////////////////////////
+bool ParamPrivate::ValueFromStringImpl(ValueType _type,
+                                       const std::string &_valueStr,
+                                       ParamVariant &_valueToSet) const
+{
+  if (ValueFromStringFast(_type, _valueStr, _valueToSet))
+    return true;
+
+  if (_type == ValueType::POSE)
+  {
+    const Element *p = this->ParentElement();
+    if (PoseFromStringFast(_valueStr,
+          !this->ignoreParentAttributes && p ? &p->GetAttributes() : nullptr,
+          _valueToSet))
+    {
+      return true;
+    }
+  }
+
   // Under some circumstances, latin locales (es_ES or pt_BR) will return a
   // comma for decimal position instead of a dot, making the conversion
   // to fail. See bug #60 for more information. Force to use always C
   setlocale(LC_NUMERIC, "C");
-  std::string trimmed = sdf::trim(_valueStr);
-  std::string tmp(trimmed);
-  std::string lowerTmp = lowercase(trimmed);
+  std::string tmp(sdf::trimView(_valueStr));
+  std::string lowerTmp = lowercase(tmp);
 
   // "true" and "false" doesn't work properly (except for string)
-  if (_typeName != "string" && _typeName != "std::string")
+  if (_type != ValueType::STRING)
   {
     if (lowerTmp == "true")
     {
@@ -665,7 +1164,7 @@ bool ParamPrivate::ValueFromStringImpl(const std::string &_typeName,
       numericBase = 16;
     }
 
-    if (_typeName == "bool")
+    if (_type == ValueType::BOOL)
     {
       if (lowerTmp == "true" || lowerTmp == "1")
       {
@@ -681,94 +1180,84 @@ bool ParamPrivate::ValueFromStringImpl(const std::string &_typeName,
         return false;
       }
     }
-    else if (_typeName == "char")
+    else if (_type == ValueType::CHAR)
     {
       _valueToSet = tmp[0];
     }
-    else if (_typeName == "std::string" ||
-             _typeName == "string")
+    else if (_type == ValueType::STRING)
     {
       _valueToSet = tmp;
     }
-    else if (_typeName == "int")
+    else if (_type == ValueType::INT)
     {
       _valueToSet = std::stoi(tmp, nullptr, numericBase);
     }
-    else if (_typeName == "uint64_t")
+    else if (_type == ValueType::UINT64)
     {
-      return ParseUsingStringStream<std::uint64_t>(tmp, this->key,
+      return ParseUsingStringStream<std::uint64_t>(tmp, this->desc->key,
                                                    _valueToSet);
     }
-    else if (_typeName == "unsigned int")
+    else if (_type == ValueType::UNSIGNED_INT)
     {
       _valueToSet = static_cast<unsigned int>(
           std::stoul(tmp, nullptr, numericBase));
     }
-    else if (_typeName == "double")
+    else if (_type == ValueType::DOUBLE)
     {
       _valueToSet = std::stod(tmp);
     }
-    else if (_typeName == "float")
+    else if (_type == ValueType::FLOAT)
     {
       _valueToSet = std::stof(tmp);
     }
-    else if (_typeName == "sdf::Time" ||
-             _typeName == "time")
+    else if (_type == ValueType::TIME)
     {
-      return ParseUsingStringStream<sdf::Time>(tmp, this->key,
+      return ParseUsingStringStream<sdf::Time>(tmp, this->desc->key,
                                                _valueToSet);
     }
-    else if (_typeName == "ignition::math::Angle" ||
-             _typeName == "angle")
+    else if (_type == ValueType::ANGLE)
     {
       return ParseUsingStringStream<ignition::math::Angle>(
-          tmp, this->key, _valueToSet);
+          tmp, this->desc->key, _valueToSet);
     }
-    else if (_typeName == "ignition::math::Color" ||
-             _typeName == "color")
+    else if (_type == ValueType::COLOR)
     {
-      return ParseColorUsingStringStream(tmp, this->key, _valueToSet);
+      return ParseColorUsingStringStream(tmp, this->desc->key, _valueToSet);
     }
-    else if (_typeName == "ignition::math::Vector2i" ||
-             _typeName == "vector2i")
+    else if (_type == ValueType::VECTOR2I)
     {
       return ParseUsingStringStream<ignition::math::Vector2i>(
-          tmp, this->key, _valueToSet);
+          tmp, this->desc->key, _valueToSet);
     }
-    else if (_typeName == "ignition::math::Vector2d" ||
-             _typeName == "vector2d")
+    else if (_type == ValueType::VECTOR2D)
     {
       return ParseUsingStringStream<ignition::math::Vector2d>(
-          tmp, this->key, _valueToSet);
+          tmp, this->desc->key, _valueToSet);
     }
-    else if (_typeName == "ignition::math::Vector3d" ||
-             _typeName == "vector3")
+    else if (_type == ValueType::VECTOR3D)
     {
       return ParseUsingStringStream<ignition::math::Vector3d>(
-          tmp, this->key, _valueToSet);
+          tmp, this->desc->key, _valueToSet);
     }
-    else if (_typeName == "ignition::math::Pose3d" ||
-             _typeName == "pose" ||
-             _typeName == "Pose")
+    else if (_type == ValueType::POSE)
     {
-      const ElementPtr p = this->parentElement.lock();
+      const Element *p = this->ParentElement();
       if (!this->ignoreParentAttributes && p)
       {
         return ParsePoseUsingStringStream(
-            tmp, this->key, p->GetAttributes(), _valueToSet);
+            tmp, this->desc->key, p->GetAttributes(), _valueToSet);
       }
       return ParsePoseUsingStringStream(
-          tmp, this->key, {}, _valueToSet);
+          tmp, this->desc->key, {}, _valueToSet);
     }
-    else if (_typeName == "ignition::math::Quaterniond" ||
-             _typeName == "quaternion")
+    else if (_type == ValueType::QUATERNION)
     {
       return ParseUsingStringStream<ignition::math::Quaterniond>(
-          tmp, this->key, _valueToSet);
+          tmp, this->desc->key, _valueToSet);
     }
     else
     {
-      sdferr << "Unknown parameter type[" << _typeName << "]\n";
+      sdferr << "Unknown parameter type[" << this->desc->typeName << "]\n";
       return false;
     }
   }
@@ -777,7 +1266,7 @@ bool ParamPrivate::ValueFromStringImpl(const std::string &_typeName,
   {
     sdferr << "Invalid argument. Unable to set value ["
            << _valueStr << " ] for key["
-           << this->key << "].\n";
+           << this->desc->key << "].\n";
     return false;
   }
   // Catch out of range exception from std::stoi/stoul/stod/stof
@@ -785,13 +1274,248 @@ bool ParamPrivate::ValueFromStringImpl(const std::string &_typeName,
   {
     sdferr << "Out of range. Unable to set value ["
            << _valueStr << " ] for key["
-           << this->key << "].\n";
+           << this->desc->key << "].\n";
     return false;
   }
 
   return true;
 }
 
+//////////////////////////////////////////////////
+/// \brief Format a floating point number the way a stream with the classic
+/// locale and the given precision does, without constructing a stream.
+/// Documents are written with one such string per number, so this is on the
+/// hot path of serialization.
+/// \param[in] _value Number to format.
+/// \param[in] _precision Number of significant digits.
+/// \return The formatted number.
+template <typename T>
+std::string floatToString(T _value, int _precision)
+{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  char buffer[64];
+  const std::to_chars_result result = std::to_chars(buffer,
+      buffer + sizeof(buffer), _value, std::chars_format::general,
+      _precision);
+  if (result.ec == std::errc())
+  {
+    return std::string(buffer, result.ptr);
+  }
+#endif
+  // Floating point std::to_chars is not provided by this standard library.
+  StringStreamClassicLocale ss;
+  ss << std::setprecision(_precision) << _value;
+  return ss.str();
+}
+
+//////////////////////////////////////////////////
+/// \brief Check whether a formatted floating point number is written in
+/// scientific notation although shortestFloatToString uses the fixed
+/// notation for it.
+/// \param[in] _str The formatted number.
+/// \param[in] _value The number.
+/// \return True if _str should be written in the fixed notation.
+template <typename T>
+bool needsFixedNotation(std::string_view _str, T _value)
+{
+  const T magnitude = std::abs(_value);
+  return _str.find('e') != std::string_view::npos &&
+      magnitude >= static_cast<T>(1e-4) &&
+      magnitude < static_cast<T>(
+        std::pow(10.0, std::numeric_limits<T>::max_digits10));
+}
+
+//////////////////////////////////////////////////
+/// \brief Format a floating point number with the fewest significant digits
+/// that read back to the same number, without constructing a stream when
+/// floating point std::to_chars is available. The output is the same
+/// without it. Like a stream with a precision of max_digits10, the
+/// scientific notation is only used for exponents below -4 or of at least
+/// max_digits10, so that for instance 1e6 is written as 1000000.
+/// \param[in] _value Number to format.
+/// \return The formatted number.
+template <typename T>
+std::string shortestFloatToString(T _value)
+{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  char buffer[64];
+  char *end = buffer + sizeof(buffer);
+  std::to_chars_result result =
+      std::to_chars(buffer, end, _value, std::chars_format::general);
+  if (result.ec == std::errc())
+  {
+    if (needsFixedNotation(std::string_view(buffer, result.ptr - buffer),
+                           _value))
+    {
+      result = std::to_chars(buffer, end, _value, std::chars_format::fixed);
+    }
+    if (result.ec == std::errc())
+    {
+      return std::string(buffer, result.ptr);
+    }
+  }
+#endif
+  // Floating point std::to_chars is not provided by this standard library.
+  // The correctly rounded string with the fewest digits from digits10 that
+  // reads back to the same number has the digits of std::to_chars.
+  if (!std::isfinite(_value))
+    return floatToString(_value, std::numeric_limits<T>::digits10);
+
+  std::string str;
+  for (int precision = std::numeric_limits<T>::digits10;
+       precision <= std::numeric_limits<T>::max_digits10; ++precision)
+  {
+    str = floatToString(_value, precision);
+    StringStreamClassicLocale ss(str);
+    T value;
+    if ((ss >> value) && value == _value)
+      break;
+  }
+
+  // A number written with as many digits in the fixed notation is an
+  // integer, which std::to_chars writes exactly, with no decimals.
+  if (needsFixedNotation(str, _value))
+  {
+    StringStreamClassicLocale ss;
+    ss << std::fixed << std::setprecision(0) << _value;
+    return ss.str();
+  }
+  return str;
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse a whitespace separated list of numbers of any length into
+/// a vector. The tokens are counted first so that the numbers are written
+/// into a buffer of the right size, and each token is converted with
+/// std::from_chars. Tokens are accepted as a classic locale stream reads
+/// them.
+/// \param[in] _input Input string.
+/// \param[out] _values The parsed numbers.
+/// \return True if every token is a number.
+template <typename T>
+bool parseNumberArray(const std::string &_input, std::vector<T> &_values)
+{
+  std::string_view input(_input);
+  std::string_view token;
+  std::size_t count = 0;
+  while (nextToken(input, token))
+    ++count;
+
+  _values.resize(count);
+  input = _input;
+  for (T &value : _values)
+  {
+    nextToken(input, token);
+    if (token.size() > 1 && token[0] == '+' && token[1] != '-')
+      token.remove_prefix(1);
+
+    // Streams do not accept the "inf" and "nan" spellings or hexadecimal
+    // numbers.
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      for (char c : token)
+      {
+        if (std::isalpha(static_cast<unsigned char>(c)) && c != 'e' &&
+            c != 'E')
+        {
+          return false;
+        }
+      }
+    }
+
+    if (fromCharsExact(token, value))
+      continue;
+
+    // Floating point numbers that std::from_chars leaves out, such as
+    // subnormal numbers, are converted by the C library, which also reports
+    // the ones that underflow.
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      try
+      {
+        setlocale(LC_NUMERIC, "C");
+        const std::string str(token);
+        std::size_t end = 0;
+        if constexpr (std::is_same_v<T, float>)
+          value = std::stof(str, &end);
+        else
+          value = std::stod(str, &end);
+        if (end == str.size())
+          continue;
+      }
+      catch(...)
+      {
+      }
+    }
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a vector of numbers as a space separated list, with the
+/// shortest representation of each floating point number that reads back
+/// the same.
+/// \param[in] _values The numbers.
+/// \return The list.
+template <typename T>
+std::string numberArrayToString(const std::vector<T> &_values)
+{
+  std::string out;
+  out.reserve(_values.size() * 8);
+  for (std::size_t i = 0; i < _values.size(); ++i)
+  {
+    if (i > 0)
+      out += ' ';
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      out += shortestFloatToString(_values[i]);
+    }
+    else
+    {
+      char buffer[24];
+      std::to_chars_result result =
+          std::to_chars(buffer, buffer + sizeof(buffer), _values[i]);
+      out.append(buffer, result.ptr);
+    }
+  }
+  return out;
+}
+
+//////////////////////////////////////////////////
+/// \brief Register an array of numbers with the value types.
+/// \param[in, out] _types The registered types.
+/// \param[in] _typeName Name of the type.
+template <typename T>
+void addNumberArrayType(CustomValueTypes &_types,
+                        const std::string &_typeName)
+{
+  auto type = std::make_shared<ParamCustomValueType>();
+  type->typeName = _typeName;
+  type->type = &typeid(std::vector<T>);
+  type->fromString = [](const std::string &_str, std::any &_value)
+  {
+    std::vector<T> values;
+    if (!parseNumberArray(_str, values))
+      return false;
+    _value = std::move(values);
+    return true;
+  };
+  type->toString = [](const std::any &_value)
+  {
+    return numberArrayToString(std::any_cast<const std::vector<T> &>(_value));
+  };
+  _types.types.emplace(_typeName, std::move(type));
+}
+
+//////////////////////////////////////////////////
+void addNumberArrayTypes(CustomValueTypes &_types)
+{
+  addNumberArrayType<double>(_types, "double_array");
+  addNumberArrayType<float>(_types, "float_array");
+  addNumberArrayType<int>(_types, "int_array");
+}
+
 //////////////////////////////////////////////////
 /// \brief Helper function for StringFromValueImpl for pose.
 /// \param[in] _config Printing configuration for the output string.
@@ -877,19 +1601,15 @@ bool PoseStringFromValue(const PrintConfig &_config,
     posRotDelimiter = threeSpacedDelimiter;
   }
 
-  // Helper function that sanitizes zero values like '-0'
+  // Helper function that sanitizes zero values like '-0', and otherwise
+  // prints the number with the default precision of streams
   auto sanitizeZero = [](double _number)
   {
-    StringStreamClassicLocale stream;
     if (std::fpclassify(_number) == FP_ZERO)
     {
-      stream << 0;
-    }
-    else
-    {
-      stream << _number;
+      return std::string("0");
     }
-    return stream.str();
+    return floatToString(_number, 6);
   };
 
   // Returning pose string representations based on desired configurations.
@@ -971,13 +1691,13 @@ bool PoseStringFromValue(const PrintConfig &_config,
 /////////////////////////////////////////////////
 bool ParamPrivate::StringFromValueImpl(
     const PrintConfig &_config,
-    const std::string &_typeName,
+    ValueType _type,
     const ParamVariant &_value,
     std::string &_valueStr) const
 {
   return this->StringFromValueImpl(
       _config,
-      _typeName,
+      _type,
       _value,
       std::nullopt,
       _valueStr);
@@ -986,13 +1706,13 @@ bool ParamPrivate::StringFromValueImpl(
 /////////////////////////////////////////////////
 bool ParamPrivate::StringFromValueImpl(
     const PrintConfig &_config,
-    const std::string &_typeName,
+    ValueType _type,
     const ParamVariant &_value,
     const std::optional<std::string> &_originalStr,
     std::string &_valueStr) const
 {
   // This will be handled in a type specific manner
-  if (_typeName == "bool")
+  if (_type == ValueType::BOOL)
   {
     const bool *val = std::get_if<bool>(&_value);
     if (!val)
@@ -1004,11 +1724,9 @@ bool ParamPrivate::StringFromValueImpl(
     _valueStr = *val ? "true" : "false";
     return true;
   }
-  else if (_typeName == "ignition::math::Pose3d" ||
-      _typeName == "pose" ||
-      _typeName == "Pose")
+  else if (_type == ValueType::POSE)
   {
-    const ElementPtr p = this->parentElement.lock();
+    const Element *p = this->ParentElement();
     if (!this->ignoreParentAttributes && p)
     {
       return PoseStringFromValue(
@@ -1016,6 +1734,16 @@ bool ParamPrivate::StringFromValueImpl(
     }
     return PoseStringFromValue(_config, {}, _value, _originalStr, _valueStr);
   }
+  else if (const double *val = std::get_if<double>(&_value))
+  {
+    _valueStr = shortestFloatToString(*val);
+    return true;
+  }
+  else if (const float *val = std::get_if<float>(&_value))
+  {
+    _valueStr = shortestFloatToString(*val);
+    return true;
+  }
 
   StringStreamClassicLocale ss;
   ss << ParamStreamer{ _value };
@@ -1027,10 +1755,13 @@ bool ParamPrivate::StringFromValueImpl(
 bool Param::SetFromString(const std::string &_value,
                           bool _ignoreParentAttributes)
 {
+  countParamSetFromString(this->dataPtr->value.index());
   this->dataPtr->ignoreParentAttributes = _ignoreParentAttributes;
-  std::string str = sdf::trim(_value.c_str());
+  this->dataPtr->lazyValuePending = false;
+  this->InvalidateParentContentHash();
+  std::string str(sdf::trimView(_value));
 
-  if (str.empty() && this->dataPtr->required)
+  if (str.empty() && this->dataPtr->desc->required)
   {
     sdferr << "Empty string used when setting a required parameter. Key["
            << this->GetKey() << "]\n";
@@ -1038,13 +1769,30 @@ bool Param::SetFromString(const std::string &_value,
   }
   else if (str.empty())
   {
-    this->dataPtr->value = this->dataPtr->defaultValue;
+    this->dataPtr->value = this->dataPtr->desc->defaultValue;
+    this->dataPtr->customValue = this->dataPtr->desc->customDefaultValue;
     this->dataPtr->strValue = str;
     return true;
   }
 
+  if (const auto &customType = this->dataPtr->desc->customType)
+  {
+    std::any value;
+    if (!customType->fromString(str, value))
+    {
+      sdferr << "Unable to set value [" << str << "] for key["
+             << this->GetKey() << "] of type[" << customType->typeName
+             << "].\n";
+      return false;
+    }
+    this->dataPtr->customValue = std::move(value);
+    this->dataPtr->strValue = std::move(str);
+    this->dataPtr->set = true;
+    return true;
+  }
+
   auto oldValue = this->dataPtr->value;
-  if (!this->dataPtr->ValueFromStringImpl(this->dataPtr->typeName,
+  if (!this->dataPtr->ValueFromStringImpl(this->dataPtr->desc->valueType,
                                           str,
                                           this->dataPtr->value))
   {
@@ -1053,7 +1801,7 @@ bool Param::SetFromString(const std::string &_value,
   this->dataPtr->strValue = str;
 
   // Check if the value is permitted
-  if (!this->ValidateValue())
+  if (ScopedParamValueChecks::Enabled() && !this->ValidateValue())
   {
     this->dataPtr->value = oldValue;
     return false;
@@ -1069,21 +1817,92 @@ bool Param::SetFromString(const std::string &_value)
   return this->SetFromString(_value, false);
 }
 
+//////////////////////////////////////////////////
+bool Param::SetFromStringLazy(const std::string &_value)
+{
+  this->dataPtr->ignoreParentAttributes = false;
+  std::string str(sdf::trimView(_value));
+
+  if (str.empty())
+  {
+    // Empty strings need no conversion.
+    return this->SetFromString(str);
+  }
+
+  this->dataPtr->strValue = std::move(str);
+  this->dataPtr->lazyValuePending = true;
+  this->InvalidateParentContentHash();
+  this->dataPtr->checkLazyValue = ScopedParamValueChecks::Enabled();
+  this->dataPtr->set = true;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Param::ParseLazyValue() const
+{
+  if (!this->dataPtr->lazyValuePending)
+    return true;
+  this->dataPtr->lazyValuePending = false;
+
+  if (const auto &customType = this->dataPtr->desc->customType)
+  {
+    std::any value;
+    if (!customType->fromString(*this->dataPtr->strValue, value))
+    {
+      sdferr << "Unable to convert value [" << *this->dataPtr->strValue
+             << "] of key [" << this->GetKey()
+             << "], using the default value instead.\n";
+      this->dataPtr->customValue = this->dataPtr->desc->customDefaultValue;
+      this->dataPtr->strValue = std::nullopt;
+      this->dataPtr->set = false;
+      return false;
+    }
+    this->dataPtr->customValue = std::move(value);
+    return true;
+  }
+
+  // The value is converted against the current parent element, like it is
+  // when reparsing.
+  if (!this->dataPtr->ValueFromStringImpl(this->dataPtr->desc->valueType,
+                                          *this->dataPtr->strValue,
+                                          this->dataPtr->value) ||
+      (this->dataPtr->checkLazyValue && !this->ValidateValue()))
+  {
+    sdferr << "Unable to convert value [" << *this->dataPtr->strValue
+           << "] of key [" << this->GetKey()
+           << "], using the default value instead.\n";
+    this->dataPtr->value = this->dataPtr->desc->defaultValue;
+    this->dataPtr->strValue = std::nullopt;
+    this->dataPtr->set = false;
+    return false;
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 ElementPtr Param::GetParentElement() const
 {
   return this->dataPtr->parentElement.lock();
 }
 
+//////////////////////////////////////////////////
+Element *Param::ParentElementRaw() const
+{
+  return this->dataPtr->ParentElement();
+}
+
 //////////////////////////////////////////////////
 bool Param::SetParentElement(ElementPtr _parentElement)
 {
   auto prevParentElement = this->dataPtr->parentElement;
+  Element *prevParentElementRaw = this->dataPtr->parentElementRaw;
 
   this->dataPtr->parentElement = _parentElement;
+  this->dataPtr->parentElementRaw = _parentElement.get();
   if (!this->Reparse())
   {
     this->dataPtr->parentElement = prevParentElement;
+    this->dataPtr->parentElementRaw = prevParentElementRaw;
     return false;
   }
 
@@ -1093,14 +1912,53 @@ bool Param::SetParentElement(ElementPtr _parentElement)
 //////////////////////////////////////////////////
 void Param::Reset()
 {
-  this->dataPtr->value = this->dataPtr->defaultValue;
+  this->dataPtr->lazyValuePending = false;
+  this->InvalidateParentContentHash();
+  this->dataPtr->value = this->dataPtr->desc->defaultValue;
+  this->dataPtr->customValue = this->dataPtr->desc->customDefaultValue;
   this->dataPtr->strValue = std::nullopt;
   this->dataPtr->set = false;
 }
 
+//////////////////////////////////////////////////
+bool Param::SetCustomValue(std::any &&_value)
+{
+  this->dataPtr->lazyValuePending = false;
+  this->InvalidateParentContentHash();
+  this->dataPtr->customValue = std::move(_value);
+  this->dataPtr->strValue = std::nullopt;
+  this->dataPtr->set = true;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Param::InvalidateParentContentHash()
+{
+  if (Element *parentElement = this->dataPtr->ParentElement())
+    parentElement->InvalidateContentHash();
+}
+
 //////////////////////////////////////////////////
 bool Param::Reparse()
 {
+  // Values of poses depend on the attributes of the parent element.
+  this->InvalidateParentContentHash();
+
+  // Values that have not been converted yet are converted against the new
+  // parent element when they are first used.
+  if (this->dataPtr->lazyValuePending)
+    return true;
+
+  // The typed value of other params stays authoritative, as converting its
+  // string again would give the same value, or discard an Update().
+  if (!this->dataPtr->DependsOnParentAttributes())
+    return true;
+
+  // Values that were set without a string, as by binary documents, have no
+  // string to convert again.
+  if (this->dataPtr->set && !this->dataPtr->strValue.has_value())
+    return true;
+
   std::string strToReparse;
   if (this->dataPtr->strValue.has_value())
   {
@@ -1108,19 +1966,18 @@ bool Param::Reparse()
   }
   // A default PrintConfig can be used here, as Reparse() is not called in the
   // code path from the 'ign sdf -p' command.
-  else if (!this->dataPtr->StringFromValueImpl(PrintConfig(),
-                                               this->dataPtr->typeName,
-                                               this->dataPtr->defaultValue,
-                                               strToReparse))
+  else if (!this->dataPtr->StringFromValueImpl(
+               PrintConfig(), this->dataPtr->desc->valueType,
+               this->dataPtr->desc->defaultValue, strToReparse))
   {
     sdferr << "Failed to obtain string from default value during reparsing.\n";
     return false;
   }
 
   if (!this->dataPtr->ValueFromStringImpl(
-      this->dataPtr->typeName, strToReparse, this->dataPtr->value))
+      this->dataPtr->desc->valueType, strToReparse, this->dataPtr->value))
   {
-    if (const auto parentElement = this->dataPtr->parentElement.lock())
+    if (const Element *parentElement = this->dataPtr->ParentElement())
     {
       sdferr << "Failed to set value '" << strToReparse
           << "' to key [" << this->GetKey()
@@ -1140,7 +1997,7 @@ bool Param::Reparse()
   // should be, so if strToReparse is empty, assign the correct default value.
   if (strToReparse.empty())
   {
-    this->dataPtr->value = this->dataPtr->defaultValue;
+    this->dataPtr->value = this->dataPtr->desc->defaultValue;
   }
   return true;
 }
@@ -1154,31 +2011,34 @@ ParamPtr Param::Clone() const
 //////////////////////////////////////////////////
 const std::string &Param::GetTypeName() const
 {
-  return this->dataPtr->typeName;
+  return this->dataPtr->desc->typeName;
 }
 
 /////////////////////////////////////////////////
 void Param::SetDescription(const std::string &_desc)
 {
-  this->dataPtr->description = _desc;
+  auto desc = std::make_shared<ParamPrivate::Description>(
+      *this->dataPtr->desc);
+  desc->description = _desc;
+  this->dataPtr->desc = std::move(desc);
 }
 
 /////////////////////////////////////////////////
 std::string Param::GetDescription() const
 {
-  return this->dataPtr->description;
+  return this->dataPtr->desc->description;
 }
 
 /////////////////////////////////////////////////
 const std::string &Param::GetKey() const
 {
-  return this->dataPtr->key;
+  return this->dataPtr->desc->key;
 }
 
 /////////////////////////////////////////////////
 bool Param::GetRequired() const
 {
-  return this->dataPtr->required;
+  return this->dataPtr->desc->required;
 }
 
 /////////////////////////////////////////////////
@@ -1187,16 +2047,27 @@ bool Param::GetSet() const
   return this->dataPtr->set;
 }
 
+/////////////////////////////////////////////////
+std::optional<std::string> Param::GetOriginalString() const
+{
+  return this->dataPtr->strValue;
+}
+
 /////////////////////////////////////////////////
 bool Param::IgnoresParentElementAttribute() const
 {
-  const auto parentElement = this->dataPtr->parentElement.lock();
-  return !parentElement || this->dataPtr->ignoreParentAttributes;
+  return !this->dataPtr->ParentElement() ||
+      this->dataPtr->ignoreParentAttributes;
 }
 
 /////////////////////////////////////////////////
 bool Param::ValidateValue() const
 {
+  // The value is checked below even if the check was skipped when it was
+  // converted.
+  if (this->dataPtr->lazyValuePending && !this->ParseLazyValue())
+    return false;
+
   return std::visit(
       [this](const auto &_val) -> bool
       {
@@ -1205,9 +2076,9 @@ bool Param::ValidateValue() const
         // cppcheck-suppress unmatchedSuppression
         if constexpr (std::is_scalar_v<T>)
         {
-          if (this->dataPtr->minValue.has_value())
+          if (this->dataPtr->desc->minValue.has_value())
           {
-            if (_val < std::get<T>(*this->dataPtr->minValue))
+            if (_val < std::get<T>(*this->dataPtr->desc->minValue))
             {
               sdferr << "The value [" << _val
                      << "] is less than the minimum allowed value of ["
@@ -1216,9 +2087,9 @@ bool Param::ValidateValue() const
               return false;
             }
           }
-          if (this->dataPtr->maxValue.has_value())
+          if (this->dataPtr->desc->maxValue.has_value())
           {
-            if (_val > std::get<T>(*this->dataPtr->maxValue))
+            if (_val > std::get<T>(*this->dataPtr->desc->maxValue))
             {
               sdferr << "The value [" << _val
                      << "] is greater than the maximum allowed value of ["
@@ -14,8 +14,11 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "sdf/Filesystem.hh"
@@ -24,6 +27,7 @@
 
 #include "ParamPassing.hh"
 #include "parser_private.hh"
+#include "ScopedTraceEvent.hh"
 #include "XmlUtils.hh"
 
 namespace sdf
@@ -38,6 +42,26 @@ void updateParams(const ParserConfig &_config,
                   ElementPtr _includeSDF,
                   Errors &_errors)
 {
+  ScopedTraceEvent event(_config, "updateParams", "parser", _source);
+
+  // index the included model once instead of searching it for every
+  // element identifier
+  ElementIdIndex index(_includeSDF);
+
+  // Consecutive children with the same element identifier alter the same
+  // element, which is then retrieved once and re-indexed once after the
+  // last of them. The children are still handled in order, so later
+  // children see the alterations of earlier ones.
+  ElementPtr groupElem = nullptr;
+  std::string groupElemName;
+  std::string groupElemId;
+  auto endGroup = [&]()
+  {
+    if (groupElem)
+      index.Add(groupElem);
+    groupElem = nullptr;
+  };
+
   // loop through <experimental:params> children
   tinyxml2::XMLElement *childElemXml = nullptr;
   for (childElemXml = _childXmlParams->FirstChildElement();
@@ -117,10 +141,10 @@ void updateParams(const ParserConfig &_config,
       }
 
       std::string attrName = attr;
+      endGroup();
 
       // check that elem doesn't already exist (except for //plugin)
-      elem  = getElementById(_includeSDF, childElemXml->Name(),
-                            elemIdAttr + "::" + attrName);
+      elem = index.Find(childElemXml->Name(), elemIdAttr + "::" + attrName);
       if (elem != nullptr && elem->GetName() != "plugin")
       {
         _errors.push_back({ErrorCode::DUPLICATE_NAME,
@@ -141,14 +165,27 @@ void updateParams(const ParserConfig &_config,
       else
       {
         // get parent element of new element
-        elem = getElementById(_includeSDF, "",
-                              elemIdAttr,
-                              true);
+        elem = index.Find("", elemIdAttr, true);
       }
     }
+    else if (groupElem && groupElemName == childElemXml->Name() &&
+             groupElemId == elemIdAttr)
+    {
+      elem = groupElem;
+    }
     else
     {
-      elem  = getElementById(_includeSDF, childElemXml->Name(), elemIdAttr);
+      endGroup();
+      elem = index.Find(childElemXml->Name(), elemIdAttr);
+      if (elem)
+      {
+        // the element is indexed again at the end of the group, since the
+        // alterations may rename or remove its descendants
+        index.Remove(elem);
+        groupElem = elem;
+        groupElemName = childElemXml->Name();
+        groupElemId = elemIdAttr;
+      }
     }
 
     if (elem == nullptr)
@@ -163,6 +200,9 @@ void updateParams(const ParserConfig &_config,
 
     // *** Element modifications ***
 
+    const std::string nameBefore = elem->HasAttribute("name") ?
+        elem->GetAttribute("name")->GetAsString() : "";
+
     if (actionStr.empty())
     {
       // action attribute not in childElemXml so must be in all direct children
@@ -172,7 +212,8 @@ void updateParams(const ParserConfig &_config,
     }
     else if (actionStr == "add")
     {
-      add(_config, _source, childElemXml, elem, _errors);
+      index.Add(add(_config, _source, childElemXml, elem, _errors));
+      continue;
     }
     else if (actionStr == "modify")
     {
@@ -181,6 +222,13 @@ void updateParams(const ParserConfig &_config,
     else if (actionStr == "remove")
     {
       remove(childElemXml, elem, _errors);
+
+      // only the listed children are removed if there are any
+      if (childElemXml->NoChildren())
+      {
+        groupElem = nullptr;
+        continue;
+      }
     }
     else if (actionStr == "replace")
     {
@@ -200,75 +248,127 @@ void updateParams(const ParserConfig &_config,
 
       replace(newElem, elem);
     }
+
+    // a renamed element no longer has the identifier of the group
+    if (elem->HasAttribute("name") &&
+        elem->GetAttribute("name")->GetAsString() != nameBefore)
+    {
+      endGroup();
+    }
   }
+
+  endGroup();
 }
 
 //////////////////////////////////////////////////
-ElementPtr getElementById(const ElementPtr _sdf,
-                          const std::string &_elemName,
-                          const std::string &_elemId,
-                          const bool _isParentElement)
+ElementIdIndex::ElementIdIndex(const ElementPtr _sdf)
+  : model(_sdf ? _sdf->GetFirstElement() : nullptr)
 {
-  // child element of includeSDF
-  ElementPtr childElem = _sdf->GetFirstElement()->GetFirstElement();
-
-  // start and stop idx of elemId for finding longest substring
-  int64_t startIdx = 0, stopIdx = 0, longestIdx = 0;
-  ElementPtr matchingChild = nullptr;
+  if (this->model)
+    this->Update(this->model, "", true);
+}
 
-  // iterate through included model
-  while (childElem)
-  {
-    std::string childName;
-    if (childElem->HasAttribute("name"))
-    {
-      childName = childElem->GetAttribute("name")->GetAsString();
+//////////////////////////////////////////////////
+void ElementIdIndex::Add(const ElementPtr _elem)
+{
+  std::string elemId;
+  if (_elem && this->ElementId(_elem, elemId))
+    this->Update(_elem, elemId, true);
+}
 
-      // for add action, found parent element
-      if (_isParentElement && _elemId == childName)
-        return childElem;
+//////////////////////////////////////////////////
+void ElementIdIndex::Remove(const ElementPtr _elem)
+{
+  std::string elemId;
+  if (_elem && this->ElementId(_elem, elemId))
+    this->Update(_elem, elemId, false);
+}
 
-      stopIdx = findPrefixLastIndex(_elemId, startIdx, childName);
+//////////////////////////////////////////////////
+ElementPtr ElementIdIndex::Find(const std::string &_elemName,
+                                const std::string &_elemId,
+                                const bool _isParentElement) const
+{
+  auto it = this->elements.find(_elemId);
+  if (it == this->elements.end())
+    return nullptr;
 
-      if (stopIdx > longestIdx)
-      {
-        matchingChild = childElem;
+  for (const ElementPtr &elem : it->second)
+  {
+    if (_isParentElement || elem->GetName() == _elemName)
+      return elem;
+  }
 
-        // found matching element break out of included model iteration
-        if (!_isParentElement && childElem->GetName() == _elemName
-              && _elemId.substr(startIdx) == childName)
-          break;
-        else if (_isParentElement && _elemId.substr(startIdx) == childName)
-          break;
+  return nullptr;
+}
 
-        longestIdx = stopIdx;
-      }
+//////////////////////////////////////////////////
+void ElementIdIndex::Update(const ElementPtr _elem, const std::string &_elemId,
+                            const bool _add)
+{
+  if (_elem != this->model)
+  {
+    auto it = this->elements.find(_elemId);
+    if (_add)
+    {
+      this->elements[_elemId].push_back(_elem);
     }
+    else if (it != this->elements.end())
+    {
+      std::vector<ElementPtr> &entries = it->second;
+      entries.erase(std::remove(entries.begin(), entries.end(), _elem),
+                    entries.end());
+      if (entries.empty())
+        this->elements.erase(it);
+    }
+  }
 
-    childElem = childElem->GetNextElement();
+  for (ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    if (!child->HasAttribute("name"))
+      continue;
 
-    // when no more children & found potential match,
-    // set next iteration to first element of match
-    if (!childElem && matchingChild)
-    {
-      childElem = matchingChild->GetFirstElement();
-      matchingChild = nullptr;
-      startIdx = longestIdx;
+    const std::string childName = child->GetAttribute("name")->GetAsString();
+    if (childName.empty())
+      continue;
 
-      size_t found = _elemId.find("::", startIdx);
-      if (found != std::string::npos && (found - startIdx) == 1ul)
-      {
-        // past double colons
-        startIdx += 3;
-      }
-    }
+    this->Update(child,
+        _elemId.empty() ? childName : _elemId + "::" + childName, _add);
   }
+}
 
-  // found no element match
-  if (!matchingChild)
-    childElem = nullptr;
+//////////////////////////////////////////////////
+bool ElementIdIndex::ElementId(ElementPtr _elem, std::string &_elemId) const
+{
+  std::vector<std::string> names;
+  for (; _elem && _elem != this->model; _elem = _elem->GetParent())
+  {
+    if (!_elem->HasAttribute("name"))
+      return false;
+    names.push_back(_elem->GetAttribute("name")->GetAsString());
+  }
+
+  if (!_elem)
+    return false;
 
-  return childElem;
+  _elemId.clear();
+  for (auto name = names.rbegin(); name != names.rend(); ++name)
+  {
+    if (!_elemId.empty())
+      _elemId += "::";
+    _elemId += *name;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+ElementPtr getElementById(const ElementPtr _sdf,
+                          const std::string &_elemName,
+                          const std::string &_elemId,
+                          const bool _isParentElement)
+{
+  return ElementIdIndex(_sdf).Find(_elemName, _elemId, _isParentElement);
 }
 
 //////////////////////////////////////////////////
@@ -453,7 +553,10 @@ void handleIndividualChildActions(const ParserConfig &_config,
       continue;
     }
 
-    ElementPtr elemChild = elemDesc->GetElementDescription(elemName);
+    // the description may be shared with other elements, so it is cloned
+    // before being populated
+    ElementPtr elemChild =
+      elemDesc->GetElementDescription(elemName)->Clone();
 
     if (!xmlToSdf(_config, _source, xmlChild, elemChild, _errors))
     {
@@ -468,7 +571,7 @@ void handleIndividualChildActions(const ParserConfig &_config,
 
     if (actionStr == "add")
     {
-      _elem->InsertElement(elemChild->Clone(), true);
+      _elem->InsertElement(elemChild, true);
     }
     else if (actionStr == "replace")
     {
@@ -503,24 +606,25 @@ void handleIndividualChildActions(const ParserConfig &_config,
 
 
 //////////////////////////////////////////////////
-void add(const ParserConfig &_config, const std::string &_source,
-         tinyxml2::XMLElement *_childXml, ElementPtr _elem, Errors &_errors)
+ElementPtr add(const ParserConfig &_config, const std::string &_source,
+               tinyxml2::XMLElement *_childXml, ElementPtr _elem,
+               Errors &_errors)
 {
   ElementPtr newElem = initElementDescription(_childXml, _config, _errors);
   if (!newElem)
-    return;
+    return nullptr;
 
   if (xmlToSdf(_config, _source, _childXml, newElem, _errors))
   {
     _elem->InsertElement(newElem, true);
+    return newElem;
   }
-  else
-  {
-    _errors.push_back({ErrorCode::ELEMENT_INVALID,
-      "Unable to convert XML to SDF. Skipping element addition:\n"
-      + ElementToString(_childXml)
-    });
-  }
+
+  _errors.push_back({ErrorCode::ELEMENT_INVALID,
+    "Unable to convert XML to SDF. Skipping element addition:\n"
+    + ElementToString(_childXml)
+  });
+  return nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -656,6 +760,22 @@ void remove(const tinyxml2::XMLElement *_xml, ElementPtr _elem, Errors &_errors)
   }
   else
   {
+    // The children are removed together in one pass over the children of
+    // _elem. A child that is found again is removed with the children found
+    // before it, so that the next child with its name is found instead, as
+    // if the children were removed one at a time.
+    std::unordered_set<const Element *> toRemove;
+    auto removeChildren = [&]()
+    {
+      if (toRemove.empty())
+        return;
+      _elem->RemoveChildrenIf([&](const ElementPtr &_child)
+      {
+        return toRemove.count(_child.get()) > 0;
+      });
+      toRemove.clear();
+    };
+
     // iterate through children of _xml
     ElementPtr elemChild = nullptr;
     const tinyxml2::XMLElement *xmlChild = nullptr;
@@ -664,6 +784,12 @@ void remove(const tinyxml2::XMLElement *_xml, ElementPtr _elem, Errors &_errors)
          xmlChild = xmlChild->NextSiblingElement())
     {
       elemChild = getElementByName(_elem, xmlChild);
+      if (elemChild && toRemove.count(elemChild.get()) > 0)
+      {
+        removeChildren();
+        elemChild = getElementByName(_elem, xmlChild);
+      }
+
       if (elemChild == nullptr)
       {
         const tinyxml2::XMLElement *xmlParent = _xml->Parent()->ToElement();
@@ -678,8 +804,9 @@ void remove(const tinyxml2::XMLElement *_xml, ElementPtr _elem, Errors &_errors)
         continue;
       }
 
-      elemChild->RemoveFromParent();
+      toRemove.insert(elemChild.get());
     }
+    removeChildren();
   }
 }
 
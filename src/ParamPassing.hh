@@ -19,6 +19,8 @@
 
 #include <tinyxml2.h>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "sdf/ParserConfig.hh"
 #include "sdf/SDFImpl.hh"
@@ -31,6 +33,66 @@ namespace sdf
 
   namespace ParamPassing {
 
+    /// \brief Index of the elements of an included model by element
+    /// identifier, i.e. by the scoped name of the element relative to the
+    /// included model (e.g., "nested_model::link::visual"). The index is
+    /// built once per include so that each //experimental:params child is
+    /// found without searching the included model.
+    class ElementIdIndex
+    {
+      /// \brief Constructor, which indexes the named descendants of the
+      /// included model.
+      /// \param[in] _sdf The loaded (from include) SDF pointer
+      public: explicit ElementIdIndex(const ElementPtr _sdf);
+
+      /// \brief Add an element of the included model and its named
+      /// descendants to the index, e.g. after they were added or modified.
+      /// \param[in] _elem The element
+      public: void Add(const ElementPtr _elem);
+
+      /// \brief Remove an element of the included model and its named
+      /// descendants from the index, e.g. before they are removed or
+      /// modified.
+      /// \param[in] _elem The element
+      public: void Remove(const ElementPtr _elem);
+
+      /// \brief Retrieves the specified element by the element identifier
+      /// and element name
+      /// \param[in] _elemName The element name, such as "model", "link",
+      /// "collision", "visual".
+      /// \param[in] _elemId The element identifier
+      /// \param[in] _isParentElement Is true if _elemId is the parent and
+      /// does not use _elemName to verify the correct element is found.
+      /// \return ElementPtr to the specified element, nullptr if element could
+      /// not found
+      public: ElementPtr Find(const std::string &_elemName,
+                              const std::string &_elemId,
+                              const bool _isParentElement = false) const;
+
+      /// \brief Add or remove an element and its named descendants.
+      /// \param[in] _elem The element
+      /// \param[in] _elemId The element identifier of _elem
+      /// \param[in] _add True to add the elements, false to remove them
+      private: void Update(const ElementPtr _elem, const std::string &_elemId,
+                           const bool _add);
+
+      /// \brief Get the element identifier of an element.
+      /// \param[in] _elem The element
+      /// \param[out] _elemId The element identifier, empty for the included
+      /// model
+      /// \return False if _elem, or one of its ancestors, has no name or is
+      /// not part of the included model
+      private: bool ElementId(ElementPtr _elem, std::string &_elemId) const;
+
+      /// \brief The included model.
+      private: ElementPtr model;
+
+      /// \brief The indexed elements by element identifier, in the order
+      /// they were indexed.
+      private: std::unordered_map<std::string, std::vector<ElementPtr>>
+               elements;
+    };
+
     /// \brief Updates the included model (_includeSDF) with the specified
     /// modifications listed under //include/experimental:params
     /// \param[in] _config Custom parser configuration
@@ -58,6 +120,7 @@ namespace sdf
     /// the add action
     /// \return ElementPtr to the specified element, nullptr if element could
     /// not found
+    /// \sa ElementIdIndex
     ElementPtr getElementById(const ElementPtr _sdf,
                               const std::string &_elemName,
                               const std::string &_elemId,
@@ -127,9 +190,10 @@ namespace sdf
     /// \param[out] _elem The element from the included model to add the new
     /// element to
     /// \param[out] _errors Captures errors found during parsing
-    void add(const ParserConfig &_config, const std::string &_source,
-             tinyxml2::XMLElement *_childXml, ElementPtr _elem,
-             Errors &_errors);
+    /// \return The added element, nullptr if it could not be added
+    ElementPtr add(const ParserConfig &_config, const std::string &_source,
+                   tinyxml2::XMLElement *_childXml, ElementPtr _elem,
+                   Errors &_errors);
 
     /// \brief Modifies the attributes of an element from the included model
     /// \param[in] _xml Pointer to the xml element which contains the attributes
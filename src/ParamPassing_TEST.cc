@@ -91,3 +91,167 @@ TEST(ParamPassing, GetElement)
                                  "model::test_link::test_visual");
   EXPECT_EQ(nullptr, paramPassElem);
 }
+
+/////////////////////////////////////////////////
+TEST(ParamPassing, ElementIdIndex)
+{
+  std::ostringstream stream;
+  stream << "<?xml version=\"1.0\"?>"
+         << "<sdf version='1.7'>"
+         << "  <model name='test'>"
+         << "    <model name='test_model'>"
+         << "      <link name='test_link'>"
+         << "        <visual name='test_visual'>"
+         << "          <geometry><box><size>1 1 1</size></box></geometry>"
+         << "        </visual>"
+         << "      </link>"
+         << "      <frame name='test_link'/>"
+         << "    </model>"
+         << "  </model>"
+         << "</sdf>";
+
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf);
+  ASSERT_TRUE(sdf::readString(stream.str(), sdf));
+
+  sdf::ParamPassing::ElementIdIndex index(sdf->Root());
+  sdf::ElementPtr model = sdf->Root()->GetFirstElement()->GetElement("model");
+  sdf::ElementPtr link = model->GetElement("link");
+  sdf::ElementPtr frame = model->GetElement("frame");
+  EXPECT_EQ(model, index.Find("model", "test_model"));
+  EXPECT_EQ(link, index.Find("link", "test_model::test_link"));
+  EXPECT_EQ(frame, index.Find("frame", "test_model::test_link"));
+  EXPECT_EQ(link, index.Find("", "test_model::test_link", true));
+  EXPECT_EQ(link->GetElement("visual"),
+            index.Find("visual", "test_model::test_link::test_visual"));
+  EXPECT_EQ(nullptr, index.Find("collision", "test_model::test_link"));
+  EXPECT_EQ(nullptr, index.Find("model", "test"));
+  EXPECT_EQ(nullptr, index.Find("link", "test_link"));
+
+  // renamed elements are found by their new identifier once added again
+  index.Remove(link);
+  link->GetAttribute("name")->SetFromString("new_link");
+  index.Add(link);
+  EXPECT_EQ(nullptr, index.Find("link", "test_model::test_link"));
+  EXPECT_EQ(nullptr,
+            index.Find("visual", "test_model::test_link::test_visual"));
+  EXPECT_EQ(link, index.Find("link", "test_model::new_link"));
+  EXPECT_EQ(link->GetElement("visual"),
+            index.Find("visual", "test_model::new_link::test_visual"));
+  EXPECT_EQ(frame, index.Find("frame", "test_model::test_link"));
+
+  // removed elements are not found
+  index.Remove(link);
+  link->RemoveFromParent();
+  EXPECT_EQ(nullptr, index.Find("link", "test_model::new_link"));
+  EXPECT_EQ(nullptr,
+            index.Find("visual", "test_model::new_link::test_visual"));
+  EXPECT_EQ(model, index.Find("model", "test_model"));
+}
+
+/////////////////////////////////////////////////
+TEST(ParamPassing, UpdateParamsSameElement)
+{
+  std::ostringstream stream;
+  stream << "<?xml version=\"1.0\"?>"
+         << "<sdf version='1.7'>"
+         << "  <model name='test'>"
+         << "    <link name='test_link'>"
+         << "      <visual name='test_visual'>"
+         << "        <geometry><box><size>1 1 1</size></box></geometry>"
+         << "      </visual>"
+         << "    </link>"
+         << "  </model>"
+         << "</sdf>";
+
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf);
+  ASSERT_TRUE(sdf::readString(stream.str(), sdf));
+
+  // Consecutive children alter the same link, which is renamed by the
+  // first of them
+  tinyxml2::XMLDocument doc;
+  doc.Parse(
+    "<experimental:params>"
+    "  <link element_id='test_link' action='modify' name='new_link'/>"
+    "  <link element_id='test_link' action='modify'>"
+    "    <pose>1 0 0 0 0 0</pose>"
+    "  </link>"
+    "  <link element_id='new_link' action='modify'>"
+    "    <pose>1 2 3 0 0 0</pose>"
+    "  </link>"
+    "  <visual element_id='new_link::test_visual' action='remove'/>"
+    "  <visual element_id='new_link::test_visual' action='modify'>"
+    "    <pose>1 2 3 0 0 0</pose>"
+    "  </visual>"
+    "</experimental:params>");
+  ASSERT_NE(nullptr, doc.RootElement());
+
+  sdf::Errors errors;
+  sdf::ParamPassing::updateParams(sdf::ParserConfig::GlobalConfig(), "",
+      doc.RootElement(), sdf->Root(), errors);
+  ASSERT_EQ(2u, errors.size()) << errors;
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_MISSING, errors[0].Code());
+  EXPECT_NE(std::string::npos, errors[0].Message().find("'test_link'"))
+    << errors[0].Message();
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_MISSING, errors[1].Code());
+  EXPECT_NE(std::string::npos,
+            errors[1].Message().find("'new_link::test_visual'"))
+    << errors[1].Message();
+
+  sdf::ElementPtr link = sdf->Root()->GetFirstElement()->GetElement("link");
+  EXPECT_EQ("new_link", link->Get<std::string>("name"));
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0),
+            link->Get<ignition::math::Pose3d>("pose"));
+  EXPECT_FALSE(link->HasElement("visual"));
+}
+
+/////////////////////////////////////////////////
+TEST(ParamPassing, ReplaceLeavesDescriptionUnchanged)
+{
+  std::ostringstream stream;
+  stream << "<?xml version=\"1.0\"?>"
+         << "<sdf version='1.7'>"
+         << "  <model name='test'>"
+         << "    <link name='test_link'>"
+         << "      <visual name='test_visual'>"
+         << "        <geometry><box><size>1 1 1</size></box></geometry>"
+         << "      </visual>"
+         << "    </link>"
+         << "  </model>"
+         << "</sdf>";
+
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf);
+  ASSERT_TRUE(sdf::readString(stream.str(), sdf));
+
+  tinyxml2::XMLDocument doc;
+  doc.Parse(
+    "<experimental:params>"
+    "  <visual element_id='test_link::test_visual'>"
+    "    <geometry action='replace'>"
+    "      <sphere><radius>2</radius></sphere>"
+    "    </geometry>"
+    "  </visual>"
+    "</experimental:params>");
+  ASSERT_NE(nullptr, doc.RootElement());
+
+  sdf::Errors errors;
+  sdf::ParamPassing::updateParams(sdf::ParserConfig::GlobalConfig(), "",
+      doc.RootElement(), sdf->Root(), errors);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  sdf::ElementPtr visual = sdf->Root()->GetFirstElement()
+      ->GetElement("link")->GetElement("visual");
+  EXPECT_TRUE(visual->GetElement("geometry")->HasElement("sphere"));
+
+  // The replacement is built from a clone, so the description shared with
+  // every other element initialized from the specification stays empty
+  sdf::ElementConstPtr geometryDesc = sdf->Root()
+      ->GetElementDescription("model")
+      ->GetElementDescription("link")
+      ->GetElementDescription("visual")
+      ->GetElementDescription("geometry");
+  ASSERT_NE(nullptr, geometryDesc);
+  EXPECT_EQ(nullptr, geometryDesc->GetFirstElement());
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "sdf/ParamUpdateTable.hh"
+#include "sdf/TaskExecutor.hh"
+
+using namespace sdf;
+
+/// \brief Private data for ParamUpdateTable.
+class sdf::ParamUpdateTable::Implementation
+{
+  /// \brief A variable bound to a parameter.
+  public: struct Binding
+  {
+    /// \brief The parameter.
+    ParamPtr param;
+
+    /// \brief The variable.
+    const void *source;
+
+    /// \brief Function that copies the variable into the parameter.
+    AssignFunction assign;
+  };
+
+  /// \brief The bindings, in the order they were added.
+  public: std::vector<Binding> bindings;
+};
+
+/////////////////////////////////////////////////
+ParamUpdateTable::ParamUpdateTable()
+  : dataPtr(ignition::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+std::size_t ParamUpdateTable::Size() const
+{
+  return this->dataPtr->bindings.size();
+}
+
+/////////////////////////////////////////////////
+void ParamUpdateTable::Clear()
+{
+  this->dataPtr->bindings.clear();
+}
+
+/////////////////////////////////////////////////
+void ParamUpdateTable::AddBinding(const ParamPtr &_param,
+    const void *_source, AssignFunction _assign)
+{
+  this->dataPtr->bindings.push_back({_param, _source, _assign});
+}
+
+/////////////////////////////////////////////////
+void ParamUpdateTable::Update(std::size_t _threadCount) const
+{
+  const auto &bindings = this->dataPtr->bindings;
+
+  auto updateRange = [&bindings](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+      bindings[i].assign(*bindings[i].param, bindings[i].source);
+  };
+
+  // Each task updates a contiguous range of bindings on the shared pool,
+  // so no threads are created for an update
+  const std::size_t threadCount =
+      std::min(std::max<std::size_t>(_threadCount, 1), bindings.size());
+  if (threadCount <= 1)
+  {
+    updateRange(0, bindings.size());
+    return;
+  }
+
+  const std::size_t chunk = (bindings.size() + threadCount - 1) / threadCount;
+  const std::size_t taskCount = (bindings.size() + chunk - 1) / chunk;
+  TaskExecutor::Threaded()->RunAndWait(taskCount,
+      [&](std::size_t _task)
+      {
+        const std::size_t begin = _task * chunk;
+        updateRange(begin, std::min(begin + chunk, bindings.size()));
+      });
+}
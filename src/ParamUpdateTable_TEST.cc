@@ -0,0 +1,130 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+
+#include "sdf/Element.hh"
+#include "sdf/Param.hh"
+#include "sdf/ParamUpdateTable.hh"
+
+/////////////////////////////////////////////////
+TEST(ParamUpdateTable, Add)
+{
+  sdf::ElementPtr elem = std::make_shared<sdf::Element>();
+  elem->SetName("link");
+  elem->AddAttribute("name", "string", "__default__", true);
+  elem->AddValue("double", "0", false);
+
+  const double mass = 2.5;
+  const std::string name = "base";
+  const int wrongType = 3;
+
+  sdf::ParamUpdateTable table;
+  EXPECT_EQ(0u, table.Size());
+  EXPECT_TRUE(table.Add(elem, "", &mass));
+  EXPECT_TRUE(table.Add(elem, "name", &name));
+  EXPECT_EQ(2u, table.Size());
+
+  // Params of another type, missing params and null variables are not bound.
+  EXPECT_FALSE(table.Add(elem, "", &wrongType));
+  EXPECT_FALSE(table.Add(elem, "missing", &name));
+  EXPECT_FALSE(table.Add(elem, "", static_cast<const double *>(nullptr)));
+  EXPECT_FALSE(table.Add(sdf::ElementPtr(), "", &mass));
+  EXPECT_FALSE(table.Add(sdf::ParamPtr(), &mass));
+  EXPECT_EQ(2u, table.Size());
+
+  table.Clear();
+  EXPECT_EQ(0u, table.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(ParamUpdateTable, Update)
+{
+  sdf::ElementPtr model = std::make_shared<sdf::Element>();
+  model->SetName("model");
+  sdf::ElementPtr pose = std::make_shared<sdf::Element>();
+  pose->SetName("pose");
+  model->InsertElement(pose, true);
+  pose->AddValue("pose", "0 0 0 0 0 0", false);
+  model->AddAttribute("name", "string", "__default__", true);
+
+  ignition::math::Pose3d livePose(1, 2, 3, 0, 0, 0);
+  std::string liveName = "robot";
+
+  sdf::ParamUpdateTable table;
+  ASSERT_TRUE(table.Add(pose->GetValue(), &livePose));
+  ASSERT_TRUE(table.Add(model, "name", &liveName));
+
+  // Values are only copied on Update.
+  EXPECT_EQ(ignition::math::Pose3d::Zero,
+            pose->Get<ignition::math::Pose3d>());
+
+  const std::uint64_t hash = model->ContentHash();
+  table.Update();
+  EXPECT_EQ(livePose, pose->Get<ignition::math::Pose3d>());
+  EXPECT_EQ("robot", model->Get<std::string>("name"));
+
+  // The cached hashes of the ancestors are invalidated.
+  EXPECT_NE(hash, model->ContentHash());
+
+  livePose.Pos().X(10);
+  liveName = "other";
+  table.Update();
+  EXPECT_EQ(livePose, pose->Get<ignition::math::Pose3d>());
+  EXPECT_EQ("other", model->Get<std::string>("name"));
+}
+
+/////////////////////////////////////////////////
+TEST(ParamUpdateTable, UpdateOnThreads)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  parent->SetName("world");
+
+  const std::size_t count = 1000;
+  std::vector<sdf::ElementPtr> children;
+  std::vector<double> values(count);
+  sdf::ParamUpdateTable table;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    sdf::ElementPtr child = std::make_shared<sdf::Element>();
+    child->SetName("value");
+    parent->InsertElement(child, true);
+    child->AddValue("double", "0", false);
+    children.push_back(child);
+    ASSERT_TRUE(table.Add(child, "", &values[i]));
+  }
+
+  for (std::size_t threadCount : {0u, 1u, 3u, 8u, 2000u})
+  {
+    for (std::size_t i = 0; i < count; ++i)
+      values[i] = static_cast<double>(i + threadCount);
+
+    table.Update(threadCount);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      EXPECT_DOUBLE_EQ(static_cast<double>(i + threadCount),
+                       children[i]->Get<double>()) << threadCount;
+    }
+  }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_PARAMVALUECHECKS_HH
+#define SDFORMAT_PARAMVALUECHECKS_HH
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Enables or disables, for the lifetime of this object, the checks
+  /// of the values set with Param::SetFromString and
+  /// Param::SetFromStringLazy on the calling thread against their minimum
+  /// and maximum allowed values. The parser uses it to skip the checks for
+  /// documents loaded with a ValidationLevel below FULL. Scopes can be nested,
+  /// and the previous setting is restored when a scope ends.
+  class ScopedParamValueChecks
+  {
+    /// \brief Constructor.
+    /// \param[in] _enable True to check values, false to skip the checks.
+    public: explicit ScopedParamValueChecks(bool _enable)
+      : previous(Flag())
+    {
+      Flag() = _enable;
+    }
+
+    /// \brief Destructor. Restores the previous setting.
+    public: ~ScopedParamValueChecks()
+    {
+      Flag() = this->previous;
+    }
+
+    /// \brief No copy constructor.
+    public: ScopedParamValueChecks(const ScopedParamValueChecks &) = delete;
+
+    /// \brief No copy assignment.
+    public: ScopedParamValueChecks &operator=(
+                const ScopedParamValueChecks &) = delete;
+
+    /// \brief Check whether values set on the calling thread are checked.
+    /// \return True unless the checks are disabled by a scope.
+    public: static bool Enabled()
+    {
+      return Flag();
+    }
+
+    /// \brief Get the setting of the calling thread.
+    /// \return Reference to the setting.
+    private: static bool &Flag()
+    {
+      static thread_local bool enabled = true;
+      return enabled;
+    }
+
+    /// \brief Setting that was active when this object was created.
+    private: bool previous;
+  };
+  }
+}
+#endif
@@ -16,8 +16,13 @@
  */
 
 #include <any>
+#include <charconv>
 #include <cstdint>
+#include <iomanip>
 #include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -318,6 +323,202 @@ TEST(Param, Vector2i)
   EXPECT_EQ(value, ignition::math::Vector2i(0, 0));
 }
 
+////////////////////////////////////////////////////
+/// Test that numbers are parsed the same whether or not they take the
+/// allocation free path.
+TEST(Param, NumericFormats)
+{
+  sdf::Param intParam("key", "int", "0", false, "description");
+  int intValue;
+  EXPECT_TRUE(intParam.SetFromString(" \t42\n"));
+  EXPECT_TRUE(intParam.Get<int>(intValue));
+  EXPECT_EQ(42, intValue);
+  EXPECT_TRUE(intParam.SetFromString("-7"));
+  EXPECT_TRUE(intParam.Get<int>(intValue));
+  EXPECT_EQ(-7, intValue);
+  EXPECT_TRUE(intParam.SetFromString("+5"));
+  EXPECT_TRUE(intParam.Get<int>(intValue));
+  EXPECT_EQ(5, intValue);
+  EXPECT_TRUE(intParam.SetFromString("0XA"));
+  EXPECT_TRUE(intParam.Get<int>(intValue));
+  EXPECT_EQ(10, intValue);
+  EXPECT_TRUE(intParam.SetFromString("true"));
+  EXPECT_TRUE(intParam.Get<int>(intValue));
+  EXPECT_EQ(1, intValue);
+  EXPECT_FALSE(intParam.SetFromString("3000000000"));
+  EXPECT_FALSE(intParam.SetFromString("abc"));
+
+  sdf::Param uintParam("key", "unsigned int", "0", false, "description");
+  unsigned int uintValue;
+  EXPECT_TRUE(uintParam.SetFromString("4000000000"));
+  EXPECT_TRUE(uintParam.Get<unsigned int>(uintValue));
+  EXPECT_EQ(4000000000u, uintValue);
+
+  sdf::Param uint64Param("key", "uint64_t", "0", false, "description");
+  std::uint64_t uint64Value;
+  EXPECT_TRUE(uint64Param.SetFromString(" 12345678901234 "));
+  EXPECT_TRUE(uint64Param.Get<std::uint64_t>(uint64Value));
+  EXPECT_EQ(12345678901234u, uint64Value);
+
+  sdf::Param doubleParam("key", "double", "0", false, "description");
+  double doubleValue;
+  EXPECT_TRUE(doubleParam.SetFromString("1.5e3"));
+  EXPECT_TRUE(doubleParam.Get<double>(doubleValue));
+  EXPECT_DOUBLE_EQ(1500.0, doubleValue);
+  EXPECT_TRUE(doubleParam.SetFromString("-0.0"));
+  EXPECT_TRUE(doubleParam.Get<double>(doubleValue));
+  EXPECT_DOUBLE_EQ(0.0, doubleValue);
+  EXPECT_FALSE(doubleParam.SetFromString("1e400"));
+  EXPECT_FALSE(doubleParam.SetFromString("1e-400"));
+
+  sdf::Param floatParam("key", "float", "0", false, "description");
+  float floatValue;
+  EXPECT_TRUE(floatParam.SetFromString("0.25"));
+  EXPECT_TRUE(floatParam.Get<float>(floatValue));
+  EXPECT_FLOAT_EQ(0.25f, floatValue);
+  EXPECT_FALSE(floatParam.SetFromString("1e40"));
+
+  sdf::Param vector3Param("key", "vector3", "0 0 0", false, "description");
+  ignition::math::Vector3d vector3Value;
+  EXPECT_TRUE(vector3Param.SetFromString(" 1 -2.5\t3e1 "));
+  EXPECT_TRUE(vector3Param.Get<ignition::math::Vector3d>(vector3Value));
+  EXPECT_EQ(ignition::math::Vector3d(1, -2.5, 30), vector3Value);
+  EXPECT_TRUE(vector3Param.SetFromString("+1 2 3"));
+  EXPECT_TRUE(vector3Param.Get<ignition::math::Vector3d>(vector3Value));
+  EXPECT_EQ(ignition::math::Vector3d(1, 2, 3), vector3Value);
+  EXPECT_FALSE(vector3Param.SetFromString("1 2"));
+
+  sdf::Param vector2iParam("key", "vector2i", "0 0", false, "description");
+  ignition::math::Vector2i vector2iValue;
+  EXPECT_TRUE(vector2iParam.SetFromString("-3 4"));
+  EXPECT_TRUE(vector2iParam.Get<ignition::math::Vector2i>(vector2iValue));
+  EXPECT_EQ(ignition::math::Vector2i(-3, 4), vector2iValue);
+
+  sdf::Param colorParam("key", "color", "0 0 0 1", false, "description");
+  ignition::math::Color colorValue;
+  EXPECT_TRUE(colorParam.SetFromString("0.5\n0.25 1"));
+  EXPECT_TRUE(colorParam.Get<ignition::math::Color>(colorValue));
+  EXPECT_EQ(ignition::math::Color(0.5f, 0.25f, 1.0f, 1.0f), colorValue);
+  EXPECT_FALSE(colorParam.SetFromString("0.5 0.25 x"));
+
+  sdf::Param poseParam("key", "pose", "0 0 0 0 0 0", false, "description");
+  ignition::math::Pose3d poseValue;
+  EXPECT_TRUE(poseParam.SetFromString("1 2 3 0 0 0.5"));
+  EXPECT_TRUE(poseParam.Get<ignition::math::Pose3d>(poseValue));
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0.5), poseValue);
+  EXPECT_FALSE(poseParam.SetFromString("1 2 3 0 0 inf"));
+}
+
+////////////////////////////////////////////////////
+TEST(Param, ShortestRoundTripString)
+{
+  sdf::Param doubleParam("key", "double", "0", false, "description");
+  for (const double value : {0.1, 0.1 + 0.2, 1.0469999999999999, 1e-5,
+        0.0001, 1e6, 1e16, 1e17, -1.7976900000000001e+308,
+        1.5707963267948966, std::numeric_limits<double>::min(),
+        std::numeric_limits<double>::max()})
+  {
+    std::ostringstream valueStr;
+    valueStr << std::setprecision(std::numeric_limits<double>::max_digits10)
+             << value;
+    EXPECT_TRUE(doubleParam.SetFromString(valueStr.str()));
+    const std::string str = doubleParam.GetAsString();
+    EXPECT_LE(str.size(), valueStr.str().size()) << str;
+
+    sdf::Param parsed("key", "double", "0", false, "description");
+    EXPECT_TRUE(parsed.SetFromString(str)) << str;
+    double parsedValue;
+    EXPECT_TRUE(parsed.Get<double>(parsedValue));
+    EXPECT_EQ(value, parsedValue) << str;
+  }
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  // The fewest digits that read back to the same number are written, and
+  // the scientific notation is only used for very small or large numbers.
+  EXPECT_TRUE(doubleParam.SetFromString("0.10000000000000001"));
+  EXPECT_EQ("0.1", doubleParam.GetAsString());
+  EXPECT_TRUE(doubleParam.SetFromString("0.30000000000000004"));
+  EXPECT_EQ("0.30000000000000004", doubleParam.GetAsString());
+  EXPECT_TRUE(doubleParam.SetFromString("1e6"));
+  EXPECT_EQ("1000000", doubleParam.GetAsString());
+  EXPECT_TRUE(doubleParam.SetFromString("-1.7976900000000001e+308"));
+  EXPECT_EQ("-1.79769e+308", doubleParam.GetAsString());
+  EXPECT_TRUE(doubleParam.SetFromString("0.00000025"));
+  EXPECT_EQ("2.5e-07", doubleParam.GetAsString());
+
+  sdf::Param floatParam("key", "float", "0", false, "description");
+  EXPECT_TRUE(floatParam.SetFromString("0.1"));
+  EXPECT_EQ("0.1", floatParam.GetAsString());
+  EXPECT_TRUE(floatParam.SetFromString("-2.5e-7"));
+  EXPECT_EQ("-2.5e-07", floatParam.GetAsString());
+#endif
+}
+
+////////////////////////////////////////////////////
+TEST(Param, GetPtr)
+{
+  sdf::Param poseParam("key", "pose", "1 2 3 0 0 0", false, "description");
+  const ignition::math::Pose3d *pose =
+      poseParam.GetPtr<ignition::math::Pose3d>();
+  ASSERT_NE(nullptr, pose);
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0), *pose);
+  EXPECT_EQ(nullptr, poseParam.GetPtr<std::string>());
+
+  sdf::Param stringParam("key", "string", "foo", false, "description");
+  EXPECT_TRUE(stringParam.SetFromStringLazy("bar"));
+  const std::string *str = stringParam.GetPtr<std::string>();
+  ASSERT_NE(nullptr, str);
+  EXPECT_EQ("bar", *str);
+
+  sdf::Param doubleParam("key", "double", "1.0", false, "description");
+  EXPECT_TRUE(doubleParam.SetFromStringLazy("not_a_number"));
+  EXPECT_EQ(nullptr, doubleParam.GetPtr<double>());
+  ASSERT_NE(nullptr, doubleParam.GetPtr<double>());
+  EXPECT_DOUBLE_EQ(1.0, *doubleParam.GetPtr<double>());
+}
+
+////////////////////////////////////////////////////
+TEST(Param, SetFromStringLazy)
+{
+  sdf::Param doubleParam("key", "double", "1.0", false, "0", "10",
+                         "description");
+  EXPECT_TRUE(doubleParam.SetFromStringLazy(" 2.5 "));
+  EXPECT_TRUE(doubleParam.GetSet());
+
+  // Copies convert the value on their own.
+  sdf::Param copy(doubleParam);
+
+  double value;
+  EXPECT_TRUE(doubleParam.Get<double>(value));
+  EXPECT_DOUBLE_EQ(2.5, value);
+  EXPECT_EQ("2.5", doubleParam.GetAsString());
+  EXPECT_TRUE(copy.Get<double>(value));
+  EXPECT_DOUBLE_EQ(2.5, value);
+
+  // Invalid values are reported when the value is first used, and the
+  // default value is used instead.
+  EXPECT_TRUE(doubleParam.SetFromStringLazy("not_a_number"));
+  EXPECT_FALSE(doubleParam.Get<double>(value));
+  EXPECT_FALSE(doubleParam.GetSet());
+  EXPECT_TRUE(doubleParam.Get<double>(value));
+  EXPECT_DOUBLE_EQ(1.0, value);
+
+  // So are values outside of the allowed range.
+  EXPECT_TRUE(doubleParam.SetFromStringLazy("20"));
+  EXPECT_FALSE(doubleParam.ValidateValue());
+  EXPECT_EQ("1", doubleParam.GetAsString());
+
+  // Setting a value again replaces the pending string.
+  EXPECT_TRUE(doubleParam.SetFromStringLazy("not_a_number"));
+  EXPECT_TRUE(doubleParam.SetFromString("3"));
+  EXPECT_TRUE(doubleParam.Get<double>(value));
+  EXPECT_DOUBLE_EQ(3.0, value);
+
+  sdf::Param requiredParam("key", "int", "0", true, "description");
+  EXPECT_FALSE(requiredParam.SetFromStringLazy(" "));
+  EXPECT_FALSE(requiredParam.GetSet());
+}
+
 ////////////////////////////////////////////////////
 TEST(Param, InvalidConstructor)
 {
@@ -340,6 +541,32 @@ TEST(Param, SetDescription)
   uint64Param.SetDescription("new desc");
 
   ASSERT_EQ("new desc", uint64Param.GetDescription());
+
+  // Copies share the properties from the specification until one of them
+  // changes.
+  sdf::Param copy(uint64Param);
+  copy.SetDescription("copy desc");
+  EXPECT_EQ("copy desc", copy.GetDescription());
+  EXPECT_EQ("new desc", uint64Param.GetDescription());
+}
+
+////////////////////////////////////////////////////
+TEST(Param, CopiesKeepMinMax)
+{
+  sdf::Param param("key", "int", "5", true, "0", "10", "description");
+  sdf::Param copy(param);
+  EXPECT_EQ("key", copy.GetKey());
+  EXPECT_EQ("int", copy.GetTypeName());
+  EXPECT_TRUE(copy.GetRequired());
+  EXPECT_EQ("5", copy.GetDefaultAsString());
+  ASSERT_TRUE(copy.GetMinValueAsString().has_value());
+  EXPECT_EQ("0", *copy.GetMinValueAsString());
+  ASSERT_TRUE(copy.GetMaxValueAsString().has_value());
+  EXPECT_EQ("10", *copy.GetMaxValueAsString());
+  EXPECT_FALSE(copy.SetFromString("11"));
+  EXPECT_TRUE(copy.SetFromString("7"));
+  EXPECT_EQ("7", copy.GetAsString());
+  EXPECT_EQ("5", param.GetAsString());
 }
 
 ////////////////////////////////////////////////////
@@ -510,9 +737,20 @@ TEST(Param, SettingParentElement)
   ASSERT_NE(nullptr, doubleParam.GetParentElement());
   EXPECT_EQ(newParentElement, doubleParam.GetParentElement());
 
+  EXPECT_EQ(newParentElement.get(), doubleParam.ParentElementRaw());
+
   // Remove the parent Element
   ASSERT_TRUE(doubleParam.SetParentElement(nullptr));
   EXPECT_EQ(nullptr, doubleParam.GetParentElement());
+  EXPECT_EQ(nullptr, doubleParam.ParentElementRaw());
+
+  // The raw pointer is reset when the parent Element is destroyed.
+  {
+    sdf::ElementPtr tempParentElement = std::make_shared<sdf::Element>();
+    ASSERT_TRUE(doubleParam.SetParentElement(tempParentElement));
+    EXPECT_EQ(tempParentElement.get(), doubleParam.ParentElementRaw());
+  }
+  EXPECT_EQ(nullptr, doubleParam.ParentElementRaw());
 }
 
 //////////////////////////////////////////////////
@@ -607,6 +845,25 @@ TEST(Param, ReparsingAfterSetFromStringDouble)
   EXPECT_DOUBLE_EQ(value, 5.0);
 }
 
+//////////////////////////////////////////////////
+TEST(Param, ReparsingKeepsUpdatedValue)
+{
+  sdf::Param doubleParam("key", "double", "1.0", false, "description");
+  ASSERT_TRUE(doubleParam.SetFromString("5.0"));
+  doubleParam.SetUpdateFunc([]() { return 7.0; });
+  doubleParam.Update();
+
+  // The value does not depend on parent element attributes, so it is not
+  // converted from the original string again.
+  sdf::ElementPtr parentElement = std::make_shared<sdf::Element>();
+  ASSERT_TRUE(doubleParam.SetParentElement(parentElement));
+  EXPECT_TRUE(doubleParam.Reparse());
+
+  double value;
+  EXPECT_TRUE(doubleParam.Get<double>(value));
+  EXPECT_DOUBLE_EQ(value, 7.0);
+}
+
 /////////////////////////////////////////////////
 TEST(Param, ReparsingAfterSetPose)
 {
@@ -901,6 +1158,211 @@ TEST(Param, PoseWithDefaultValue)
   EXPECT_STREQ(expectedString.c_str(), poseElemClone->ToString("").c_str());
 }
 
+/////////////////////////////////////////////////
+TEST(Param, PoseAttributeFormats)
+{
+  using Pose = ignition::math::Pose3d;
+
+  auto poseElem = std::make_shared<sdf::Element>();
+  poseElem->SetName("pose");
+  poseElem->AddValue("pose", "0 0 0 0 0 0", false);
+  poseElem->AddAttribute("degrees", "bool", "false", false);
+  poseElem->AddAttribute("rotation_format", "string", "euler_rpy", false);
+  sdf::ParamPtr value = poseElem->GetValue();
+  ASSERT_NE(nullptr, value);
+
+  // Numbers that are parsed without a stream, and numbers that are not,
+  // give the same pose.
+  ASSERT_TRUE(value->SetFromString(" 1 2 3\t0.1 0.2 0.3 "));
+  EXPECT_EQ(Pose(1, 2, 3, 0.1, 0.2, 0.3), poseElem->Get<Pose>());
+  ASSERT_TRUE(value->SetFromString("+1 2 3 0.1 0.2 0.3"));
+  EXPECT_EQ(Pose(1, 2, 3, 0.1, 0.2, 0.3), poseElem->Get<Pose>());
+
+  ASSERT_TRUE(poseElem->GetAttribute("degrees")->Set<bool>(true));
+  ASSERT_TRUE(value->SetFromString("1 2 3 90 0 180"));
+  EXPECT_EQ(Pose(1, 2, 3, IGN_PI_2, 0, IGN_PI), poseElem->Get<Pose>());
+
+  // Degrees do not apply to quaternions.
+  ASSERT_TRUE(poseElem->GetAttribute("rotation_format")->Set<std::string>(
+      "quat_xyzw"));
+  EXPECT_FALSE(value->SetFromString("1 2 3 0 0 0 1"));
+
+  ASSERT_TRUE(poseElem->GetAttribute("degrees")->Set<bool>(false));
+  ASSERT_TRUE(value->SetFromString("1 2 3 0 0 0 1"));
+  EXPECT_EQ(Pose(1, 2, 3, 1, 0, 0, 0), poseElem->Get<Pose>());
+
+  // Invalid poses are still rejected.
+  EXPECT_FALSE(value->SetFromString("1 2 3 0 0 0"));
+  EXPECT_FALSE(value->SetFromString("1 2 3 0 0 0 1 0"));
+  EXPECT_FALSE(value->SetFromString("1 2 3 0 0 inf 1"));
+}
+
+/////////////////////////////////////////////////
+TEST(Param, ValueTypeFromName)
+{
+  using ValueType = sdf::ParamPrivate::ValueType;
+  EXPECT_EQ(ValueType::STRING,
+            sdf::ParamPrivate::ValueTypeFromName("string"));
+  EXPECT_EQ(ValueType::STRING,
+            sdf::ParamPrivate::ValueTypeFromName("std::string"));
+  EXPECT_EQ(ValueType::UNSIGNED_INT,
+            sdf::ParamPrivate::ValueTypeFromName("unsigned int"));
+  EXPECT_EQ(ValueType::VECTOR3D,
+            sdf::ParamPrivate::ValueTypeFromName("vector3"));
+  EXPECT_EQ(ValueType::VECTOR3D,
+            sdf::ParamPrivate::ValueTypeFromName("ignition::math::Vector3d"));
+  EXPECT_EQ(ValueType::POSE, sdf::ParamPrivate::ValueTypeFromName("Pose"));
+  EXPECT_EQ(ValueType::UNKNOWN,
+            sdf::ParamPrivate::ValueTypeFromName("vector3d"));
+
+  // Params with aliased type names convert in the same way.
+  sdf::Param angle1("key", "angle", "1.5", false);
+  sdf::Param angle2("key", "ignition::math::Angle", "1.5", false);
+  EXPECT_EQ(angle1.GetAsString(), angle2.GetAsString());
+  EXPECT_TRUE(angle1.SetFromString("0.5"));
+  ignition::math::Angle value;
+  EXPECT_TRUE(angle1.Get(value));
+  EXPECT_DOUBLE_EQ(0.5, value.Radian());
+
+  // Strings keep "true" as is, while other types convert it.
+  sdf::Param str("key", "string", "", false);
+  EXPECT_TRUE(str.SetFromString("true"));
+  EXPECT_EQ("true", str.GetAsString());
+  sdf::Param integer("key", "int", "0", false);
+  EXPECT_TRUE(integer.SetFromString("true"));
+  EXPECT_EQ("1", integer.GetAsString());
+}
+
+/////////////////////////////////////////////////
+TEST(Param, RegisterValueType)
+{
+  using Array = std::vector<double>;
+  std::function<bool(const std::string &, Array &)> fromString =
+      [](const std::string &_str, Array &_value)
+      {
+        std::istringstream in(_str);
+        in.imbue(std::locale::classic());
+        double number;
+        while (in >> number)
+          _value.push_back(number);
+        return in.eof();
+      };
+  std::function<std::string(const Array &)> toString =
+      [](const Array &_value)
+      {
+        std::ostringstream out;
+        out.imbue(std::locale::classic());
+        for (std::size_t i = 0; i < _value.size(); ++i)
+          out << (i > 0 ? " " : "") << _value[i];
+        return out.str();
+      };
+
+  EXPECT_TRUE(sdf::Param::RegisterValueType<Array>(
+      "test_double_array", fromString, toString));
+  EXPECT_FALSE(sdf::Param::RegisterValueType<Array>(
+      "test_double_array", fromString, toString));
+  EXPECT_FALSE(sdf::Param::RegisterValueType<Array>(
+      "double", fromString, toString));
+  EXPECT_FALSE(sdf::Param::RegisterValueType<Array>(
+      "test_empty", nullptr, toString));
+
+  sdf::Param param("key", "test_double_array", "1 2", false);
+  EXPECT_EQ("test_double_array", param.GetTypeName());
+  EXPECT_TRUE(param.IsType<Array>());
+  EXPECT_FALSE(param.IsType<std::string>());
+  EXPECT_EQ("1 2", param.GetAsString());
+  Array value;
+  EXPECT_TRUE(param.GetDefault(value));
+  EXPECT_EQ(Array({1, 2}), value);
+
+  // The string is converted once, and the value is read without a copy.
+  EXPECT_TRUE(param.SetFromString(" 0.5 1.5 2.5 "));
+  const Array *ptr = param.GetPtr<Array>();
+  ASSERT_NE(nullptr, ptr);
+  EXPECT_EQ(Array({0.5, 1.5, 2.5}), *ptr);
+  EXPECT_EQ(ptr, param.GetPtr<Array>());
+  EXPECT_EQ(nullptr, param.GetPtr<double>());
+  EXPECT_EQ("0.5 1.5 2.5", param.GetAsString());
+  std::string str;
+  EXPECT_TRUE(param.Get(str));
+  EXPECT_EQ("0.5 1.5 2.5", str);
+  double number;
+  EXPECT_FALSE(param.Get(number));
+  std::any any;
+  EXPECT_TRUE(param.GetAny(any));
+  EXPECT_EQ(Array({0.5, 1.5, 2.5}), std::any_cast<Array>(any));
+
+  // Invalid strings keep the value.
+  EXPECT_FALSE(param.SetFromString("1 x"));
+  EXPECT_EQ(Array({0.5, 1.5, 2.5}), *param.GetPtr<Array>());
+
+  // Values are set without a string.
+  EXPECT_TRUE(param.Set(Array({3, 4})));
+  EXPECT_TRUE(param.Get(value));
+  EXPECT_EQ(Array({3, 4}), value);
+  EXPECT_EQ("3 4", param.GetAsString());
+  EXPECT_FALSE(param.GetOriginalString().has_value());
+
+  // Copies and clones keep the value.
+  sdf::ParamPtr clone = param.Clone();
+  EXPECT_EQ(Array({3, 4}), *clone->GetPtr<Array>());
+
+  // Lazily set strings are converted on first use.
+  EXPECT_TRUE(param.SetFromStringLazy("5 6 7"));
+  EXPECT_EQ(Array({5, 6, 7}), *param.GetPtr<Array>());
+
+  param.Reset();
+  EXPECT_FALSE(param.GetSet());
+  EXPECT_EQ(Array({1, 2}), *param.GetPtr<Array>());
+
+  // The value of an element can use the type.
+  auto elem = std::make_shared<sdf::Element>();
+  elem->SetName("gains");
+  elem->AddValue("test_double_array", "", false);
+  EXPECT_TRUE(elem->GetValue()->SetFromString("1 2 3"));
+  ptr = elem->GetPtr<Array>();
+  ASSERT_NE(nullptr, ptr);
+  EXPECT_EQ(3u, ptr->size());
+  EXPECT_NE(std::string::npos, elem->ToString("").find(">1 2 3</gains>"));
+}
+
+/////////////////////////////////////////////////
+TEST(Param, NumberArrays)
+{
+  EXPECT_FALSE(sdf::Param::RegisterValueType<std::vector<double>>(
+      "double_array",
+      [](const std::string &, std::vector<double> &) {return true;},
+      [](const std::vector<double> &) {return std::string();}));
+
+  sdf::Param doubles("key", "double_array", "", false);
+  EXPECT_TRUE(doubles.IsType<std::vector<double>>());
+  ASSERT_NE(nullptr, doubles.GetPtr<std::vector<double>>());
+  EXPECT_TRUE(doubles.GetPtr<std::vector<double>>()->empty());
+  EXPECT_TRUE(doubles.SetFromString(" 1 2.5\n-3e2\t+4 0.1 "));
+  const std::vector<double> *values = doubles.GetPtr<std::vector<double>>();
+  ASSERT_NE(nullptr, values);
+  EXPECT_EQ(std::vector<double>({1, 2.5, -300, 4, 0.1}), *values);
+  EXPECT_EQ("1 2.5 -300 4 0.1", doubles.GetAsString());
+  EXPECT_FALSE(doubles.SetFromString("1 x"));
+  EXPECT_FALSE(doubles.SetFromString("1 inf"));
+  EXPECT_FALSE(doubles.SetFromString("1 0x10"));
+  EXPECT_EQ(5u, doubles.GetPtr<std::vector<double>>()->size());
+
+  sdf::Param floats("key", "float_array", "0.5 1.5", false);
+  std::vector<float> floatValues;
+  EXPECT_TRUE(floats.Get(floatValues));
+  EXPECT_EQ(std::vector<float>({0.5f, 1.5f}), floatValues);
+  EXPECT_TRUE(floats.SetFromString("0.1 0.2"));
+  EXPECT_EQ("0.1 0.2", floats.GetAsString());
+
+  sdf::Param ints("key", "int_array", "", false);
+  EXPECT_TRUE(ints.SetFromString("+1 -2 3"));
+  EXPECT_EQ(std::vector<int>({1, -2, 3}), *ints.GetPtr<std::vector<int>>());
+  EXPECT_EQ("1 -2 3", ints.GetAsString());
+  EXPECT_FALSE(ints.SetFromString("1 2.5"));
+  EXPECT_FALSE(ints.SetFromString("1 99999999999"));
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -15,12 +15,26 @@
  *
  */
 
+#include <algorithm>
+#include <memory>
 #include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "sdf/ParserConfig.hh"
 #include "sdf/Filesystem.hh"
 #include "sdf/Types.hh"
 
+#include "FindFileCache.hh"
+#include "FindFileRequests.hh"
+#include "IncludeCache.hh"
+#include "InterfaceModelCache.hh"
+#include "LoadMonitor.hh"
+#include "ModelConfigCache.hh"
+#include "Utils.hh"
+#include "XmlDocumentPool.hh"
+
 using namespace sdf;
 
 class sdf::ParserConfig::Implementation
@@ -28,6 +42,10 @@ class sdf::ParserConfig::Implementation
   public: ParserConfig::SchemeToPathMap uriPathMap;
   public: std::function<std::string(const std::string &)> findFileCB;
 
+  /// \brief Requests of the asynchronous find callback, or nullptr if it
+  /// is not set. Copies of a configuration share the requests.
+  public: std::shared_ptr<FindFileRequests> findFileRequests;
+
   /// \brief Indicates how warnings and errors are tolerated.
   /// Default is for warnings to be streamed via sdfwarn
   public: EnforcementPolicy warningsPolicy = EnforcementPolicy::WARN;
@@ -46,13 +64,105 @@ class sdf::ParserConfig::Implementation
   /// \brief Collection of custom model parsers.
   public: std::vector<CustomModelParser> customParsers;
 
+  /// \brief Flag to call the custom model parsers from several threads.
+  public: bool customParsersThreadSafe = false;
+
+  /// \brief Cache of interface models, or nullptr if interface models are
+  /// not cached.
+  public: std::shared_ptr<InterfaceModelCache> interfaceModelCache;
+
   /// \brief Flag to explicitly preserve fixed joints when
   /// reading the SDF/URDF file.
   public: bool preserveFixedJoint = false;
 
+  /// \brief Directory where converted URDF files are cached, or empty.
+  public: std::string urdfCacheDirectory;
+
   /// \brief Flag to use <include> tags within ToElement methods instead of
   /// the fully included model.
   public: bool toElementUseIncludeTag = true;
+
+  /// \brief Number of threads used to load included files.
+  public: std::size_t includeLoadThreadCount = 0;
+
+  /// \brief Number of threads used to build the frame graphs of worlds.
+  public: std::size_t graphBuildThreadCount = 0;
+
+  /// \brief Number of threads used to load the worlds of a document.
+  public: std::size_t worldLoadThreadCount = 0;
+
+  /// \brief Number of threads used to load the contents of models.
+  public: std::size_t modelLoadThreadCount = 0;
+
+  /// \brief Number of errors after which loading stops, or 0.
+  public: std::size_t maxErrors = 0;
+
+  /// \brief Executor of the parallel parts of loading documents.
+  public: std::shared_ptr<TaskExecutor> executor = TaskExecutor::Threaded();
+
+  /// \brief Provider of the files that are read, or nullptr to read files
+  /// from the filesystem.
+  public: std::shared_ptr<ResourceProvider> resourceProvider;
+
+  /// \brief Flag to read the top-level models of worlds one at a time.
+  public: bool streamWorldModels = false;
+
+  /// \brief Flag to read the upgraded copies of files.
+  public: bool useUpgradedFiles = true;
+
+  /// \brief Flag to convert values read from files when they are first
+  /// used.
+  public: bool lazyParamParsing = false;
+
+  /// \brief Flag to keep copied elements as XML text.
+  public: bool copyElementsAsRawXml = false;
+
+  /// \brief Flag to release the elements of loaded DOM objects.
+  public: bool releaseElements = false;
+
+  /// \brief Flag to share the identical objects of loaded DOM objects.
+  public: bool shareIdenticalObjects = false;
+
+  /// \brief Flag to load world models when they are first used.
+  public: bool lazyWorldModels = false;
+
+  /// \brief Names of the elements that are skipped while reading.
+  public: std::vector<std::string> skippedElements;
+
+  /// \brief Function that decides which elements are read.
+  public: ElementFilterFunction elementFilter;
+
+  /// \brief Region of the top-level world models that are read.
+  public: std::optional<ignition::math::AxisAlignedBox> regionOfInterest;
+
+  /// \brief How thoroughly documents are validated.
+  public: ValidationLevel validationLevel = ValidationLevel::FULL;
+
+  /// \brief Profile that loading is recorded to, or nullptr.
+  public: std::shared_ptr<LoadProfile> profile;
+
+  /// \brief Trace that loading is recorded to, or nullptr.
+  public: std::shared_ptr<LoadTrace> trace = LoadTrace::FromEnvironment();
+
+  /// \brief Cache of included files, or nullptr if included files are not
+  /// cached.
+  public: std::shared_ptr<IncludeCache> includeCache;
+
+  /// \brief Cache of model configurations, or nullptr if model
+  /// configurations are not cached.
+  public: std::shared_ptr<ModelConfigCache> modelConfigCache;
+
+  /// \brief Pool of reused XML documents, or nullptr if XML documents are
+  /// not reused. Copies of a configuration share the pool.
+  public: std::shared_ptr<XmlDocumentPool> xmlDocumentPool;
+
+  /// \brief Cache of file lookups, if they are cached. It is updated by
+  /// sdf::findFile, which only has const access to the configuration.
+  public: mutable std::optional<FindFileCache> findFileCache;
+
+  /// \brief Monitor of the asynchronous load that uses this configuration,
+  /// or nullptr.
+  public: std::shared_ptr<LoadMonitor> loadMonitor;
 };
 
 
@@ -82,6 +192,32 @@ void ParserConfig::SetFindCallback(
     std::function<std::string(const std::string &)> _cb)
 {
   this->dataPtr->findFileCB = _cb;
+  if (this->dataPtr->findFileCache)
+    this->dataPtr->findFileCache->InvalidateCallback();
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetAsyncFindCallback(AsyncFindFileCallback _cb)
+{
+  this->dataPtr->findFileRequests =
+      _cb ? std::make_shared<FindFileRequests>(std::move(_cb)) : nullptr;
+  if (this->dataPtr->findFileCache)
+    this->dataPtr->findFileCache->InvalidateCallback();
+}
+
+/////////////////////////////////////////////////
+ParserConfig::AsyncFindFileCallback ParserConfig::AsyncFindCallback() const
+{
+  if (!this->dataPtr->findFileRequests)
+    return {};
+  return this->dataPtr->findFileRequests->Callback();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<FindFileRequests>
+ParserConfig::FindFileRequestsInstance() const
+{
+  return this->dataPtr->findFileRequests;
 }
 
 /////////////////////////////////////////////////
@@ -104,9 +240,11 @@ void ParserConfig::AddURIPath(const std::string &_uri, const std::string &_path)
   for (const auto &part : sdf::split(_path, multiplePathSeparator))
   {
     // Only add valid paths
-    if (!part.empty() && sdf::filesystem::is_directory(part))
+    if (!part.empty() && resourceIsDirectory(*this, part))
     {
       this->dataPtr->uriPathMap[_uri].push_back(part);
+      if (this->dataPtr->findFileCache)
+        this->dataPtr->findFileCache->InvalidateURIScheme(_uri);
     }
   }
 }
@@ -162,6 +300,50 @@ const std::vector<CustomModelParser> &ParserConfig::CustomModelParsers() const
   return this->dataPtr->customParsers;
 }
 
+/////////////////////////////////////////////////
+void ParserConfig::SetCustomModelParsersThreadSafe(bool _threadSafe)
+{
+  this->dataPtr->customParsersThreadSafe = _threadSafe;
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::CustomModelParsersThreadSafe() const
+{
+  return this->dataPtr->customParsersThreadSafe;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetUseInterfaceModelCache(bool _useInterfaceModelCache)
+{
+  if (!_useInterfaceModelCache)
+    this->dataPtr->interfaceModelCache.reset();
+  else if (!this->dataPtr->interfaceModelCache)
+  {
+    this->dataPtr->interfaceModelCache =
+      std::make_shared<InterfaceModelCache>();
+  }
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::UseInterfaceModelCache() const
+{
+  return nullptr != this->dataPtr->interfaceModelCache;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::ClearInterfaceModelCache()
+{
+  if (this->dataPtr->interfaceModelCache)
+    this->dataPtr->interfaceModelCache->Clear();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<InterfaceModelCache>
+ParserConfig::InterfaceModelFileCache() const
+{
+  return this->dataPtr->interfaceModelCache;
+}
+
 /////////////////////////////////////////////////
 void ParserConfig::URDFSetPreserveFixedJoint(bool _preserveFixedJoint)
 {
@@ -174,6 +356,18 @@ bool ParserConfig::URDFPreserveFixedJoint() const
   return this->dataPtr->preserveFixedJoint;
 }
 
+/////////////////////////////////////////////////
+void ParserConfig::URDFSetCacheDirectory(const std::string &_directory)
+{
+  this->dataPtr->urdfCacheDirectory = _directory;
+}
+
+/////////////////////////////////////////////////
+const std::string &ParserConfig::URDFCacheDirectory() const
+{
+  return this->dataPtr->urdfCacheDirectory;
+}
+
 /////////////////////////////////////////////////
 void ParserConfig::SetToElementUseIncludeTag(bool _useIncludeTag)
 {
@@ -185,3 +379,376 @@ bool ParserConfig::ToElementUseIncludeTag() const
 {
   return this->dataPtr->toElementUseIncludeTag;
 }
+
+/////////////////////////////////////////////////
+void ParserConfig::SetIncludeLoadThreadCount(std::size_t _count)
+{
+  this->dataPtr->includeLoadThreadCount = _count;
+}
+
+/////////////////////////////////////////////////
+std::size_t ParserConfig::IncludeLoadThreadCount() const
+{
+  return this->dataPtr->includeLoadThreadCount;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetGraphBuildThreadCount(std::size_t _count)
+{
+  this->dataPtr->graphBuildThreadCount = _count;
+}
+
+/////////////////////////////////////////////////
+std::size_t ParserConfig::GraphBuildThreadCount() const
+{
+  return this->dataPtr->graphBuildThreadCount;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetWorldLoadThreadCount(std::size_t _count)
+{
+  this->dataPtr->worldLoadThreadCount = _count;
+}
+
+/////////////////////////////////////////////////
+std::size_t ParserConfig::WorldLoadThreadCount() const
+{
+  return this->dataPtr->worldLoadThreadCount;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetModelLoadThreadCount(std::size_t _count)
+{
+  this->dataPtr->modelLoadThreadCount = _count;
+}
+
+/////////////////////////////////////////////////
+std::size_t ParserConfig::ModelLoadThreadCount() const
+{
+  return this->dataPtr->modelLoadThreadCount;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetMaxErrors(std::size_t _maxErrors)
+{
+  this->dataPtr->maxErrors = _maxErrors;
+}
+
+/////////////////////////////////////////////////
+std::size_t ParserConfig::MaxErrors() const
+{
+  return this->dataPtr->maxErrors;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetExecutor(std::shared_ptr<TaskExecutor> _executor)
+{
+  this->dataPtr->executor =
+      _executor ? std::move(_executor) : TaskExecutor::Threaded();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<TaskExecutor> ParserConfig::Executor() const
+{
+  return this->dataPtr->executor;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetResourceProvider(
+    std::shared_ptr<ResourceProvider> _provider)
+{
+  this->dataPtr->resourceProvider = std::move(_provider);
+  if (this->dataPtr->findFileCache)
+    this->dataPtr->findFileCache->Clear();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<ResourceProvider> ParserConfig::GetResourceProvider() const
+{
+  return this->dataPtr->resourceProvider;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetStreamWorldModels(bool _streamWorldModels)
+{
+  this->dataPtr->streamWorldModels = _streamWorldModels;
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::StreamWorldModels() const
+{
+  return this->dataPtr->streamWorldModels;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetUseUpgradedFiles(bool _useUpgradedFiles)
+{
+  this->dataPtr->useUpgradedFiles = _useUpgradedFiles;
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::UseUpgradedFiles() const
+{
+  return this->dataPtr->useUpgradedFiles;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetUseIncludeCache(bool _useIncludeCache)
+{
+  if (!_useIncludeCache)
+    this->dataPtr->includeCache.reset();
+  else if (!this->dataPtr->includeCache)
+    this->dataPtr->includeCache = std::make_shared<IncludeCache>();
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::UseIncludeCache() const
+{
+  return nullptr != this->dataPtr->includeCache;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::ClearIncludeCache()
+{
+  if (this->dataPtr->includeCache)
+    this->dataPtr->includeCache->Clear();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<IncludeCache> ParserConfig::IncludeFileCache() const
+{
+  return this->dataPtr->includeCache;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetReuseXmlDocuments(bool _reuseXmlDocuments)
+{
+  if (!_reuseXmlDocuments)
+    this->dataPtr->xmlDocumentPool.reset();
+  else if (!this->dataPtr->xmlDocumentPool)
+    this->dataPtr->xmlDocumentPool = std::make_shared<XmlDocumentPool>();
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::ReuseXmlDocuments() const
+{
+  return nullptr != this->dataPtr->xmlDocumentPool;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<XmlDocumentPool> ParserConfig::XmlDocuments() const
+{
+  return this->dataPtr->xmlDocumentPool;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetUseModelConfigCache(bool _useModelConfigCache)
+{
+  if (!_useModelConfigCache)
+    this->dataPtr->modelConfigCache.reset();
+  else if (!this->dataPtr->modelConfigCache)
+    this->dataPtr->modelConfigCache = std::make_shared<ModelConfigCache>();
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::UseModelConfigCache() const
+{
+  return nullptr != this->dataPtr->modelConfigCache;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::ClearModelConfigCache()
+{
+  if (this->dataPtr->modelConfigCache)
+    this->dataPtr->modelConfigCache->Clear();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<ModelConfigCache> ParserConfig::ModelConfigFileCache() const
+{
+  return this->dataPtr->modelConfigCache;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetUseFindFileCache(bool _useFindFileCache)
+{
+  if (!_useFindFileCache)
+    this->dataPtr->findFileCache.reset();
+  else if (!this->dataPtr->findFileCache)
+    this->dataPtr->findFileCache.emplace();
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::UseFindFileCache() const
+{
+  return this->dataPtr->findFileCache.has_value();
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::ClearFindFileCache()
+{
+  if (this->dataPtr->findFileCache)
+    this->dataPtr->findFileCache->Clear();
+}
+
+/////////////////////////////////////////////////
+FindFileCache *ParserConfig::FindFileCacheInstance() const
+{
+  if (!this->dataPtr->findFileCache)
+    return nullptr;
+  return &this->dataPtr->findFileCache.value();
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetLazyParamParsing(bool _lazyParamParsing)
+{
+  this->dataPtr->lazyParamParsing = _lazyParamParsing;
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::LazyParamParsing() const
+{
+  return this->dataPtr->lazyParamParsing;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetCopyElementsAsRawXml(bool _rawXml)
+{
+  this->dataPtr->copyElementsAsRawXml = _rawXml;
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::CopyElementsAsRawXml() const
+{
+  return this->dataPtr->copyElementsAsRawXml;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetReleaseElements(bool _releaseElements)
+{
+  this->dataPtr->releaseElements = _releaseElements;
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::ReleaseElements() const
+{
+  return this->dataPtr->releaseElements;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetShareIdenticalObjects(bool _share)
+{
+  this->dataPtr->shareIdenticalObjects = _share;
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::ShareIdenticalObjects() const
+{
+  return this->dataPtr->shareIdenticalObjects;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetLazyWorldModels(bool _lazyWorldModels)
+{
+  this->dataPtr->lazyWorldModels = _lazyWorldModels;
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::LazyWorldModels() const
+{
+  return this->dataPtr->lazyWorldModels;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::AddSkippedElement(const std::string &_name)
+{
+  auto &skipped = this->dataPtr->skippedElements;
+  if (std::find(skipped.begin(), skipped.end(), _name) == skipped.end())
+    skipped.push_back(_name);
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &ParserConfig::SkippedElements() const
+{
+  return this->dataPtr->skippedElements;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetElementFilter(ElementFilterFunction _filter)
+{
+  this->dataPtr->elementFilter = std::move(_filter);
+}
+
+/////////////////////////////////////////////////
+const ParserConfig::ElementFilterFunction &ParserConfig::ElementFilter() const
+{
+  return this->dataPtr->elementFilter;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetRegionOfInterest(
+    const ignition::math::AxisAlignedBox &_region)
+{
+  this->dataPtr->regionOfInterest = _region;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::ClearRegionOfInterest()
+{
+  this->dataPtr->regionOfInterest.reset();
+}
+
+/////////////////////////////////////////////////
+std::optional<ignition::math::AxisAlignedBox>
+ParserConfig::RegionOfInterest() const
+{
+  return this->dataPtr->regionOfInterest;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetValidationLevel(ValidationLevel _level)
+{
+  this->dataPtr->validationLevel = _level;
+}
+
+/////////////////////////////////////////////////
+ValidationLevel ParserConfig::GetValidationLevel() const
+{
+  return this->dataPtr->validationLevel;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetProfile(std::shared_ptr<LoadProfile> _profile)
+{
+  this->dataPtr->profile = std::move(_profile);
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<LoadProfile> ParserConfig::Profile() const
+{
+  return this->dataPtr->profile;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetTrace(std::shared_ptr<LoadTrace> _trace)
+{
+  this->dataPtr->trace = std::move(_trace);
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<LoadTrace> ParserConfig::Trace() const
+{
+  return this->dataPtr->trace;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetLoadMonitor(std::shared_ptr<LoadMonitor> _monitor)
+{
+  this->dataPtr->loadMonitor = std::move(_monitor);
+}
+
+/////////////////////////////////////////////////
+LoadMonitor *ParserConfig::LoadMonitorInstance() const
+{
+  return this->dataPtr->loadMonitor.get();
+}
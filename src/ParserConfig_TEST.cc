@@ -17,9 +17,16 @@
 
 #include <gtest/gtest.h>
 
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "sdf/Filesystem.hh"
 #include "sdf/ParserConfig.hh"
+#include "sdf/Root.hh"
 #include "sdf/SDFImpl.hh"
+#include "sdf/World.hh"
 #include "test_config.h"
 
 /////////////////////////////////////////////////
@@ -28,7 +35,28 @@ TEST(ParserConfig, Construction)
 {
   sdf::ParserConfig config;
   EXPECT_FALSE(config.FindFileCallback());
+  EXPECT_FALSE(config.AsyncFindCallback());
   EXPECT_TRUE(config.URIPathMap().empty());
+  EXPECT_FALSE(config.CustomModelParsersThreadSafe());
+  EXPECT_EQ(0u, config.IncludeLoadThreadCount());
+  EXPECT_EQ(0u, config.GraphBuildThreadCount());
+  EXPECT_EQ(0u, config.WorldLoadThreadCount());
+  EXPECT_EQ(0u, config.ModelLoadThreadCount());
+  EXPECT_EQ(0u, config.MaxErrors());
+  EXPECT_EQ(sdf::TaskExecutor::Threaded(), config.Executor());
+  EXPECT_FALSE(config.StreamWorldModels());
+  EXPECT_TRUE(config.UseUpgradedFiles());
+  EXPECT_FALSE(config.UseIncludeCache());
+  EXPECT_FALSE(config.ReuseXmlDocuments());
+  EXPECT_FALSE(config.UseFindFileCache());
+  EXPECT_FALSE(config.LazyParamParsing());
+  EXPECT_FALSE(config.CopyElementsAsRawXml());
+  EXPECT_FALSE(config.ReleaseElements());
+  EXPECT_FALSE(config.ShareIdenticalObjects());
+  EXPECT_FALSE(config.LazyWorldModels());
+  EXPECT_EQ(sdf::ValidationLevel::FULL, config.GetValidationLevel());
+  EXPECT_EQ(nullptr, config.Profile());
+  EXPECT_EQ(sdf::LoadTrace::FromEnvironment(), config.Trace());
 
   // The directory used in AddURIPath must exist in the filesystem, so we'll use
   // the source path
@@ -51,6 +79,11 @@ TEST(ParserConfig, Construction)
   config.SetFindCallback(testFunc);
   ASSERT_TRUE(config.FindFileCallback());
   EXPECT_EQ("test/dir2", config.FindFileCallback()("empty"));
+
+  config.SetMaxErrors(5u);
+  EXPECT_EQ(5u, config.MaxErrors());
+  config.SetMaxErrors(0u);
+  EXPECT_EQ(0u, config.MaxErrors());
 }
 
 /////////////////////////////////////////////////
@@ -226,3 +259,56 @@ TEST(ParserConfig, CopyAssignmentAfterMove)
     EXPECT_EQ(it->second.front(), testDir1);
   }
 }
+
+/////////////////////////////////////////////////
+TEST(ParserConfig, AsyncFindCallback)
+{
+  const std::string modelDir = sdf::testing::TestFile("integration", "model",
+      "box");
+  std::mutex mutex;
+  std::vector<std::string> log;
+  sdf::ParserConfig config;
+  config.SetAsyncFindCallback([&](const std::string &_uri)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    log.push_back("start " + _uri);
+    return std::async(std::launch::deferred, [&, _uri]()
+    {
+      std::lock_guard<std::mutex> resolvedLock(mutex);
+      log.push_back("resolved " + _uri);
+      return _uri == "remote://missing" ? std::string() : modelDir;
+    });
+  });
+  ASSERT_TRUE(config.AsyncFindCallback());
+
+  const std::string sdf =
+      "<?xml version='1.0'?><sdf version='1.8'><world name='default'>"
+      "<include><uri>remote://a</uri><name>a</name></include>"
+      "<include><uri>remote://b</uri><name>b</name></include>"
+      "<include><uri>" + modelDir + "</uri><name>local</name></include>"
+      "</world></sdf>";
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+  ASSERT_NE(nullptr, root.WorldByIndex(0));
+  EXPECT_EQ(3u, root.WorldByIndex(0)->ModelCount());
+
+  // Every remote URI is requested before the first one is waited for, and
+  // URIs that are found in the search paths are not requested.
+  EXPECT_EQ((std::vector<std::string>{"start remote://a", "start remote://b",
+                "resolved remote://a", "resolved remote://b"}), log);
+
+  // A URI that is not found is reported as usual.
+  log.clear();
+  const std::string missing =
+      "<?xml version='1.0'?><sdf version='1.8'><world name='default'>"
+      "<include><uri>remote://missing</uri></include>"
+      "</world></sdf>";
+  sdf::Root missingRoot;
+  errors = missingRoot.LoadSdfString(missing, config);
+  ASSERT_FALSE(errors.empty());
+  EXPECT_EQ(sdf::ErrorCode::URI_LOOKUP, errors[0].Code());
+
+  config.SetAsyncFindCallback(nullptr);
+  EXPECT_FALSE(config.AsyncFindCallback());
+}
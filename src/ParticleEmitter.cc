@@ -130,7 +130,7 @@ Errors ParticleEmitter::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   this->dataPtr->filePath = _sdf->FilePath();
 
@@ -474,6 +474,15 @@ sdf::SemanticPose ParticleEmitter::SemanticPose() const
       this->dataPtr->poseRelativeToGraph);
 }
 
+/////////////////////////////////////////////////
+Errors ParticleEmitter::ResolvePose(ignition::math::Pose3d &_pose,
+    const std::string &_resolveTo) const
+{
+  return resolveSemanticPose(_pose, this->dataPtr->poseRelativeToGraph, "",
+      this->dataPtr->pose, this->dataPtr->poseRelativeTo,
+      this->dataPtr->xmlParentName, _resolveTo);
+}
+
 /////////////////////////////////////////////////
 sdf::ElementPtr ParticleEmitter::Element() const
 {
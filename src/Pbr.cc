@@ -129,7 +129,7 @@ Errors PbrWorkflow::Load(sdf::ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Load the workflow element
   sdf::ElementPtr workflowElem;
@@ -396,7 +396,7 @@ Errors Pbr::Load(sdf::ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <pbr>
   // This is an error that cannot be recovered, so return an error.
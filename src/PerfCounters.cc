@@ -0,0 +1,101 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <array>
+#include <variant>
+
+#include "sdf/Param.hh"
+#include "sdf/PerfCounters.hh"
+
+#include "PerfCounting.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+static_assert(std::variant_size_v<ParamPrivate::ParamVariant> ==
+    kParamTypeCount, "kParamTypeCount must match Param::ParamVariant");
+
+/// \brief Names of the alternatives of Param::ParamVariant, in order.
+static constexpr std::array<const char *, kParamTypeCount> kParamTypeNames =
+{
+  "bool", "char", "string", "int", "uint64_t", "unsigned int", "double",
+  "float", "time", "angle", "color", "vector2i", "vector2d", "vector3",
+  "quaternion", "pose"
+};
+
+std::array<std::atomic<std::uint64_t>, kPerfCounterCount> perfCounterValues{};
+
+/////////////////////////////////////////////////
+/// \brief Get the value of a counter.
+/// \param[in] _counter The counter.
+/// \return The value.
+static std::uint64_t perfCounterValue(PerfCounter _counter)
+{
+  return perfCounterValues[static_cast<std::size_t>(_counter)].load(
+      std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+PerfCounters GetPerfCounters()
+{
+  PerfCounters counters;
+  counters.elementCloneCalls =
+      perfCounterValue(PerfCounter::ELEMENT_CLONE_CALLS);
+  counters.elementsCloned = perfCounterValue(PerfCounter::ELEMENTS_CLONED);
+  counters.addElementCalls = perfCounterValue(PerfCounter::ADD_ELEMENT_CALLS);
+  counters.getElementComparisons =
+      perfCounterValue(PerfCounter::GET_ELEMENT_COMPARISONS);
+  counters.findFileCalls = perfCounterValue(PerfCounter::FIND_FILE_CALLS);
+  counters.findFileProbes = perfCounterValue(PerfCounter::FIND_FILE_PROBES);
+  counters.converterNodeVisits =
+      perfCounterValue(PerfCounter::CONVERTER_NODE_VISITS);
+  counters.graphVerticesBuilt =
+      perfCounterValue(PerfCounter::GRAPH_VERTICES_BUILT);
+  counters.poseGraphWalks = perfCounterValue(PerfCounter::POSE_GRAPH_WALKS);
+  counters.nameLookupLinearSearches =
+      perfCounterValue(PerfCounter::NAME_LOOKUP_LINEAR_SEARCHES);
+
+  const std::size_t paramOffset =
+      static_cast<std::size_t>(PerfCounter::PARAM_SET_FROM_STRING);
+  for (std::size_t i = 0; i < kParamTypeCount; ++i)
+  {
+    const std::uint64_t calls =
+        perfCounterValues[paramOffset + i].load(std::memory_order_relaxed);
+    if (calls > 0)
+      counters.paramSetFromStringCalls[kParamTypeNames[i]] = calls;
+  }
+  return counters;
+}
+
+/////////////////////////////////////////////////
+void ResetPerfCounters()
+{
+  for (auto &value : perfCounterValues)
+    value.store(0, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+bool PerfCountersEnabled()
+{
+#ifndef SDFORMAT_DISABLE_PERF_COUNTERS
+  return true;
+#else
+  return false;
+#endif
+}
+}
+}
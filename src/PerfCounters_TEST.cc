@@ -0,0 +1,117 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "sdf/Element.hh"
+#include "sdf/Param.hh"
+#include "sdf/PerfCounters.hh"
+#include "sdf/Root.hh"
+#include "sdf/parser.hh"
+
+/////////////////////////////////////////////////
+TEST(PerfCounters, Reset)
+{
+  sdf::ElementPtr elem(new sdf::Element);
+  elem->SetName("elem");
+  elem->Clone();
+
+  sdf::ResetPerfCounters();
+  const sdf::PerfCounters counters = sdf::GetPerfCounters();
+  EXPECT_EQ(0u, counters.elementCloneCalls);
+  EXPECT_EQ(0u, counters.elementsCloned);
+  EXPECT_EQ(0u, counters.addElementCalls);
+  EXPECT_EQ(0u, counters.getElementComparisons);
+  EXPECT_TRUE(counters.paramSetFromStringCalls.empty());
+  EXPECT_EQ(0u, counters.findFileCalls);
+  EXPECT_EQ(0u, counters.findFileProbes);
+  EXPECT_EQ(0u, counters.converterNodeVisits);
+  EXPECT_EQ(0u, counters.graphVerticesBuilt);
+  EXPECT_EQ(0u, counters.poseGraphWalks);
+  EXPECT_EQ(0u, counters.nameLookupLinearSearches);
+}
+
+/////////////////////////////////////////////////
+TEST(PerfCounters, Element)
+{
+  sdf::ElementPtr parent(new sdf::Element);
+  parent->SetName("parent");
+  sdf::ElementPtr child(new sdf::Element);
+  child->SetName("child");
+  child->SetParent(parent);
+  parent->InsertElement(child);
+  sdf::ElementPtr grandchild(new sdf::Element);
+  grandchild->SetName("grandchild");
+  grandchild->SetParent(child);
+  child->InsertElement(grandchild);
+
+  sdf::Param param("key", "double", "0", false);
+
+  sdf::ResetPerfCounters();
+  parent->Clone();
+  parent->GetElement("child");
+  EXPECT_TRUE(param.SetFromString("1.5"));
+  EXPECT_TRUE(param.SetFromString("2.5"));
+
+  const sdf::PerfCounters counters = sdf::GetPerfCounters();
+  if (!sdf::PerfCountersEnabled())
+  {
+    EXPECT_EQ(0u, counters.elementsCloned);
+    return;
+  }
+  EXPECT_EQ(1u, counters.elementCloneCalls);
+  EXPECT_EQ(3u, counters.elementsCloned);
+  EXPECT_LE(1u, counters.getElementComparisons);
+  ASSERT_EQ(1u, counters.paramSetFromStringCalls.size());
+  EXPECT_EQ(2u, counters.paramSetFromStringCalls.at("double"));
+}
+
+/////////////////////////////////////////////////
+TEST(PerfCounters, Load)
+{
+  const std::string sdfString = R"(
+<sdf version="1.6">
+  <model name="model">
+    <link name="link"/>
+    <frame name="frame" attached_to="link"/>
+  </model>
+</sdf>)";
+
+  sdf::ResetPerfCounters();
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  const sdf::PerfCounters counters = sdf::GetPerfCounters();
+  if (!sdf::PerfCountersEnabled())
+  {
+    EXPECT_EQ(0u, counters.addElementCalls);
+    return;
+  }
+  EXPECT_LT(0u, counters.addElementCalls);
+  EXPECT_LT(0u, counters.converterNodeVisits);
+  // The model frame, the link and the frame, in both graphs.
+  EXPECT_LE(6u, counters.graphVerticesBuilt);
+  EXPECT_EQ(1u, counters.paramSetFromStringCalls.count("string"));
+
+  sdf::ResetPerfCounters();
+  sdf::findFile("no_such_file.sdf", false, false);
+  EXPECT_EQ(1u, sdf::GetPerfCounters().findFileCalls);
+  EXPECT_LE(3u, sdf::GetPerfCounters().findFileProbes);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDFORMAT_PERFCOUNTING_HH
+#define SDFORMAT_PERFCOUNTING_HH
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "sdf/PerfCounters.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Counters of sdf::PerfCounters. The counters of
+  /// Param::SetFromString follow PARAM_SET_FROM_STRING, one for each
+  /// alternative of Param::ParamVariant.
+  enum class PerfCounter : std::size_t
+  {
+    ELEMENT_CLONE_CALLS,
+    ELEMENTS_CLONED,
+    ADD_ELEMENT_CALLS,
+    GET_ELEMENT_COMPARISONS,
+    FIND_FILE_CALLS,
+    FIND_FILE_PROBES,
+    CONVERTER_NODE_VISITS,
+    GRAPH_VERTICES_BUILT,
+    POSE_GRAPH_WALKS,
+    NAME_LOOKUP_LINEAR_SEARCHES,
+    PARAM_SET_FROM_STRING,
+  };
+
+  /// \brief Number of alternatives of Param::ParamVariant, checked in
+  /// PerfCounters.cc.
+  constexpr std::size_t kParamTypeCount = 16;
+
+  /// \brief Number of counters.
+  constexpr std::size_t kPerfCounterCount =
+      static_cast<std::size_t>(PerfCounter::PARAM_SET_FROM_STRING) +
+      kParamTypeCount;
+
+  /// \brief Values of the counters, defined in PerfCounters.cc.
+  extern std::array<std::atomic<std::uint64_t>, kPerfCounterCount>
+      perfCounterValues;
+
+  /// \brief Add to a counter. This does nothing when the counters are
+  /// disabled with SDFORMAT_DISABLE_PERF_COUNTERS.
+  /// \param[in] _counter The counter.
+  /// \param[in] _count Number to add.
+  inline void countPerf(PerfCounter _counter, std::uint64_t _count = 1)
+  {
+#ifndef SDFORMAT_DISABLE_PERF_COUNTERS
+    perfCounterValues[static_cast<std::size_t>(_counter)].fetch_add(
+        _count, std::memory_order_relaxed);
+#else
+    (void)_counter;
+    (void)_count;
+#endif
+  }
+
+  /// \brief Count a call of Param::SetFromString.
+  /// \param[in] _typeIndex Index of the type of the parameter in
+  /// Param::ParamVariant.
+  inline void countParamSetFromString(std::size_t _typeIndex)
+  {
+#ifndef SDFORMAT_DISABLE_PERF_COUNTERS
+    if (_typeIndex < kParamTypeCount)
+    {
+      perfCounterValues[static_cast<std::size_t>(
+          PerfCounter::PARAM_SET_FROM_STRING) + _typeIndex].fetch_add(
+              1, std::memory_order_relaxed);
+    }
+#else
+    (void)_typeIndex;
+#endif
+  }
+
+  /// \brief Counts a call of a recursive function, from the creation of
+  /// this object to its destruction, unless the function is called by itself
+  /// on the same thread.
+  /// \tparam Counter The counter of the outermost calls.
+  template <PerfCounter Counter>
+  class ScopedOutermostCall
+  {
+    /// \brief Constructor.
+    public: ScopedOutermostCall()
+    {
+#ifndef SDFORMAT_DISABLE_PERF_COUNTERS
+      if (Depth()++ == 0)
+        countPerf(Counter);
+#endif
+    }
+
+    /// \brief Destructor.
+    public: ~ScopedOutermostCall()
+    {
+#ifndef SDFORMAT_DISABLE_PERF_COUNTERS
+      --Depth();
+#endif
+    }
+
+    /// \brief No copy constructor.
+    public: ScopedOutermostCall(const ScopedOutermostCall &) = delete;
+
+    /// \brief No copy assignment.
+    public: ScopedOutermostCall &operator=(
+                const ScopedOutermostCall &) = delete;
+
+    /// \brief Get the number of nested calls on the calling thread.
+    /// \return Reference to the number of calls.
+    private: static int &Depth()
+    {
+      static thread_local int depth = 0;
+      return depth;
+    }
+  };
+  }
+}
+#endif
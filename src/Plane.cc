@@ -18,6 +18,7 @@
 #include <ignition/math/Vector3.hh>
 #include "sdf/parser.hh"
 #include "sdf/Plane.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
@@ -44,7 +45,7 @@ Errors Plane::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that sdf is a valid pointer
   if (!_sdf)
@@ -32,8 +32,23 @@ class sdf::PluginPrivate
   /// \brief The SDF element pointer used during load.
   public: sdf::ElementPtr sdf;
 
-  /// \brief SDF elements inside the plugin.
-  public: std::vector<sdf::ElementPtr> contents;
+  /// \brief SDF elements inside the plugin. The elements are immutable and
+  /// shared by the copies of the plugin, so the vector is copied before it
+  /// is modified if another plugin uses it.
+  public: std::shared_ptr<std::vector<sdf::ElementPtr>> contents =
+      std::make_shared<std::vector<sdf::ElementPtr>>();
+
+  /// \brief Get the contents for modification.
+  /// \return Contents that are not shared with another plugin.
+  public: std::vector<sdf::ElementPtr> &MutableContents()
+  {
+    if (this->contents.use_count() > 1)
+    {
+      this->contents =
+          std::make_shared<std::vector<sdf::ElementPtr>>(*this->contents);
+    }
+    return *this->contents;
+  }
 };
 
 /////////////////////////////////////////////////
@@ -64,7 +79,7 @@ Errors Plugin::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that sdf is a valid pointer
   if (!_sdf)
@@ -101,12 +116,10 @@ Errors Plugin::Load(ElementPtr _sdf)
         "A plugin filename is required, but the filename is not set."});
   }
 
-  // Copy the contents of the plugin
-  for (sdf::ElementPtr innerElem = _sdf->GetFirstElement();
-       innerElem; innerElem = innerElem->GetNextElement(""))
-  {
-    this->dataPtr->contents.push_back(innerElem->Clone());
-  }
+  // Share the contents of the plugin with the element
+  auto &contents = this->dataPtr->MutableContents();
+  const sdf::ElementPtr_V &innerElems = _sdf->Elements();
+  contents.insert(contents.end(), innerElems.begin(), innerElems.end());
 
   return errors;
 }
@@ -150,9 +163,9 @@ sdf::ElementPtr Plugin::ToElement() const
   elem->GetAttribute("name")->Set(this->Name());
   elem->GetAttribute("filename")->Set(this->Filename());
 
-  // Insert plugin content
-  for (const sdf::ElementPtr content : this->dataPtr->contents)
-    elem->InsertElement(content, true);
+  // Insert plugin content, which is cloned since it is shared
+  for (const sdf::ElementPtr &content : *this->dataPtr->contents)
+    elem->InsertElement(content->Clone(), true);
 
   return elem;
 }
@@ -160,19 +173,19 @@ sdf::ElementPtr Plugin::ToElement() const
 /////////////////////////////////////////////////
 void Plugin::ClearContents()
 {
-  this->dataPtr->contents.clear();
+  this->dataPtr->contents = std::make_shared<std::vector<sdf::ElementPtr>>();
 }
 
 /////////////////////////////////////////////////
 const std::vector<sdf::ElementPtr> &Plugin::Contents() const
 {
-  return this->dataPtr->contents;
+  return *this->dataPtr->contents;
 }
 
 /////////////////////////////////////////////////
 void Plugin::InsertContent(const sdf::ElementPtr _elem)
 {
-  this->dataPtr->contents.push_back(_elem->Clone());
+  this->dataPtr->MutableContents().push_back(_elem->Clone());
 }
 
 /////////////////////////////////////////////////
@@ -183,15 +196,10 @@ Plugin &Plugin::operator=(const Plugin &_plugin)
 
   this->dataPtr->name = _plugin.Name();
   this->dataPtr->filename = _plugin.Filename();
-  if (_plugin.Element())
-    this->dataPtr->sdf = _plugin.Element()->Clone();
+  this->dataPtr->sdf = _plugin.Element();
 
-  this->dataPtr->contents.clear();
-  // Copy the contents of the plugin
-  for (const sdf::ElementPtr content : _plugin.Contents())
-  {
-    this->dataPtr->contents.push_back(content->Clone());
-  }
+  // Share the contents of the plugin, which are copied on modification
+  this->dataPtr->contents = _plugin.dataPtr->contents;
 
   return *this;
 }
@@ -236,6 +236,48 @@ TEST(DOMPlugin, LoadWithChildren)
   EXPECT_EQ(pluginStr, toElem->ToString(""));
 }
 
+/////////////////////////////////////////////////
+TEST(DOMPlugin, SharedContents)
+{
+  std::string pluginStr = R"(<sdf version='1.9'>
+<plugin name='my-plugin' filename='filename.so'>
+  <waypoints>0 1 2 3</waypoints>
+</plugin>
+</sdf>)";
+  sdf::ElementPtr elem(new sdf::Element);
+  sdf::initFile("plugin.sdf", elem);
+  ASSERT_TRUE(sdf::readString(pluginStr, elem));
+
+  sdf::Plugin plugin;
+  EXPECT_TRUE(plugin.Load(elem).empty());
+  ASSERT_EQ(1u, plugin.Contents().size());
+  EXPECT_EQ(elem->GetFirstElement(), plugin.Contents()[0]);
+
+  // Copies share the contents until they are modified
+  sdf::Plugin plugin2(plugin);
+  ASSERT_EQ(1u, plugin2.Contents().size());
+  EXPECT_EQ(plugin.Contents()[0], plugin2.Contents()[0]);
+
+  sdf::ElementPtr content(new sdf::Element);
+  content->SetName("an-element");
+  plugin2.InsertContent(content);
+  EXPECT_EQ(1u, plugin.Contents().size());
+  ASSERT_EQ(2u, plugin2.Contents().size());
+  EXPECT_EQ(plugin.Contents()[0], plugin2.Contents()[0]);
+  EXPECT_NE(content, plugin2.Contents()[1]);
+
+  plugin2.ClearContents();
+  EXPECT_EQ(1u, plugin.Contents().size());
+  EXPECT_TRUE(plugin2.Contents().empty());
+
+  // The contents of the element are not modified by ToElement
+  sdf::ElementPtr toElem = plugin.ToElement();
+  ASSERT_NE(nullptr, toElem->GetFirstElement());
+  EXPECT_NE(plugin.Contents()[0], toElem->GetFirstElement());
+  EXPECT_EQ(elem, plugin.Contents()[0]->GetParent());
+  EXPECT_EQ(toElem, toElem->GetFirstElement()->GetParent());
+}
+
 /////////////////////////////////////////////////
 TEST(DOMPlugin, ToElement)
 {
@@ -0,0 +1,648 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+
+#include "sdf/Population.hh"
+#include "sdf/parser.hh"
+#include "ScopedTraceEvent.hh"
+#include "Utils.hh"
+
+using namespace sdf;
+
+/// \brief Names of the distribution types, in the order of
+/// PopulationDistributionType.
+static const std::vector<std::string> kDistributionTypeNames =
+{
+  "random", "uniform", "grid", "linear-x", "linear-y", "linear-z"
+};
+
+/// \brief Largest number of instances of a population. The counts come from
+/// the file, so a larger population is rejected instead of allocating its
+/// poses.
+static constexpr uint64_t kMaxInstanceCount = 1000000;
+
+/// \brief Private data for a Population.
+class sdf::Population::Implementation
+{
+  /// \brief Get the number of instances requested by the distribution,
+  /// saturated at the largest uint64_t instead of overflowing.
+  /// \return The number of instances.
+  public: uint64_t RequestedInstanceCount() const;
+
+  /// \brief Generate the poses of the instances.
+  public: void GeneratePoses();
+
+  /// \brief Generate the positions of the instances in a box region,
+  /// relative to the frame of the population.
+  /// \param[in] _box The region.
+  /// \param[out] _positions The positions.
+  public: void BoxPositions(const sdf::Box &_box,
+              std::vector<ignition::math::Vector3d> &_positions) const;
+
+  /// \brief Generate the positions of the instances in a cylinder region,
+  /// relative to the frame of the population.
+  /// \param[in] _cylinder The region.
+  /// \param[out] _positions The positions.
+  public: void CylinderPositions(const sdf::Cylinder &_cylinder,
+              std::vector<ignition::math::Vector3d> &_positions) const;
+
+  /// \brief Name of the population.
+  public: std::string name = "";
+
+  /// \brief Number of models to place.
+  public: uint64_t modelCount = 1;
+
+  /// \brief Type of distribution.
+  public: PopulationDistributionType distributionType =
+      PopulationDistributionType::RANDOM;
+
+  /// \brief Number of rows of the grid distribution.
+  public: uint64_t rows = 1;
+
+  /// \brief Number of columns of the grid distribution.
+  public: uint64_t cols = 1;
+
+  /// \brief Distance between the models of the grid distribution.
+  public: ignition::math::Vector3d step{0.5, 0.5, 0};
+
+  /// \brief Box region, if the region is a box.
+  public: std::optional<sdf::Box> box;
+
+  /// \brief Cylinder region, if the region is a cylinder.
+  public: std::optional<sdf::Cylinder> cylinder;
+
+  /// \brief Seed of the random distribution.
+  public: uint32_t seed = 0;
+
+  /// \brief Pose of the population.
+  public: ignition::math::Pose3d pose = ignition::math::Pose3d::Zero;
+
+  /// \brief The model copied for each instance.
+  public: sdf::Model model;
+
+  /// \brief Poses of the instances, relative to the world.
+  public: std::vector<ignition::math::Pose3d> instancePoses;
+
+  /// \brief The SDF element pointer used during load.
+  public: sdf::ElementPtr sdf;
+};
+
+/////////////////////////////////////////////////
+uint64_t Population::Implementation::RequestedInstanceCount() const
+{
+  if (this->distributionType != PopulationDistributionType::GRID)
+    return this->modelCount;
+  if (this->rows > 0 &&
+      this->cols > std::numeric_limits<uint64_t>::max() / this->rows)
+  {
+    return std::numeric_limits<uint64_t>::max();
+  }
+  return this->rows * this->cols;
+}
+
+/////////////////////////////////////////////////
+void Population::Implementation::GeneratePoses()
+{
+  // Load reports a population that is too large
+  this->instancePoses.clear();
+  if (this->RequestedInstanceCount() > kMaxInstanceCount)
+    return;
+
+  std::vector<ignition::math::Vector3d> positions;
+  if (this->distributionType == PopulationDistributionType::GRID)
+  {
+    positions.reserve(this->rows * this->cols);
+    for (uint64_t row = 0; row < this->rows; ++row)
+    {
+      for (uint64_t col = 0; col < this->cols; ++col)
+      {
+        positions.emplace_back(static_cast<double>(col) * this->step.X(),
+                               static_cast<double>(row) * this->step.Y(), 0);
+      }
+    }
+  }
+  else if (this->box)
+  {
+    this->BoxPositions(*this->box, positions);
+  }
+  else if (this->cylinder)
+  {
+    this->CylinderPositions(*this->cylinder, positions);
+  }
+
+  // The pose of the model is relative to the position of its instance in
+  // the frame of the population.
+  this->instancePoses.reserve(positions.size());
+  for (const auto &position : positions)
+  {
+    this->instancePoses.push_back(this->pose *
+        ignition::math::Pose3d(position, ignition::math::Quaterniond::Identity)
+        * this->model.RawPose());
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the offset of the center of a cell, for evenly placed models.
+/// \param[in] _index Index of the cell.
+/// \param[in] _count Number of cells.
+/// \param[in] _length Length covered by the cells.
+/// \return The offset, relative to the center of _length.
+static double cellCenter(uint64_t _index, uint64_t _count, double _length)
+{
+  return _length * ((static_cast<double>(_index) + 0.5) /
+                    static_cast<double>(_count) - 0.5);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a uniform random number. std::mt19937 produces the same
+/// sequence on every platform, unlike the standard distributions.
+/// \param[in,out] _generator The generator.
+/// \param[in] _min Minimum value.
+/// \param[in] _max Maximum value.
+/// \return A number in [_min, _max).
+static double uniform(std::mt19937 &_generator, double _min, double _max)
+{
+  return _min + (_max - _min) * (static_cast<double>(_generator()) /
+                                 4294967296.0);
+}
+
+/////////////////////////////////////////////////
+void Population::Implementation::BoxPositions(const sdf::Box &_box,
+    std::vector<ignition::math::Vector3d> &_positions) const
+{
+  const ignition::math::Vector3d size = _box.Size();
+  const uint64_t count = this->modelCount;
+  _positions.reserve(count);
+
+  switch (this->distributionType)
+  {
+    case PopulationDistributionType::RANDOM:
+    {
+      std::mt19937 generator(this->seed);
+      for (uint64_t i = 0; i < count; ++i)
+      {
+        const double x = uniform(generator, -size.X() / 2, size.X() / 2);
+        const double y = uniform(generator, -size.Y() / 2, size.Y() / 2);
+        const double z = uniform(generator, -size.Z() / 2, size.Z() / 2);
+        _positions.emplace_back(x, y, z);
+      }
+      break;
+    }
+    case PopulationDistributionType::UNIFORM:
+    {
+      // The models fill the cells of a grid over the xy plane of the box,
+      // with about as many columns as rows.
+      const uint64_t cols = static_cast<uint64_t>(
+          std::ceil(std::sqrt(static_cast<double>(count))));
+      const uint64_t rows = cols > 0 ? (count + cols - 1) / cols : 0;
+      for (uint64_t i = 0; i < count; ++i)
+      {
+        _positions.emplace_back(cellCenter(i % cols, cols, size.X()),
+                                cellCenter(i / cols, rows, size.Y()), 0);
+      }
+      break;
+    }
+    case PopulationDistributionType::LINEAR_X:
+    case PopulationDistributionType::LINEAR_Y:
+    case PopulationDistributionType::LINEAR_Z:
+    {
+      const auto axis = static_cast<std::size_t>(this->distributionType) -
+          static_cast<std::size_t>(PopulationDistributionType::LINEAR_X);
+      for (uint64_t i = 0; i < count; ++i)
+      {
+        ignition::math::Vector3d position;
+        position[axis] = cellCenter(i, count, size[axis]);
+        _positions.push_back(position);
+      }
+      break;
+    }
+    case PopulationDistributionType::GRID:
+      break;
+  }
+}
+
+/////////////////////////////////////////////////
+void Population::Implementation::CylinderPositions(
+    const sdf::Cylinder &_cylinder,
+    std::vector<ignition::math::Vector3d> &_positions) const
+{
+  const double radius = _cylinder.Radius();
+  const double length = _cylinder.Length();
+  const uint64_t count = this->modelCount;
+  _positions.reserve(count);
+
+  switch (this->distributionType)
+  {
+    case PopulationDistributionType::RANDOM:
+    {
+      std::mt19937 generator(this->seed);
+      for (uint64_t i = 0; i < count; ++i)
+      {
+        const double r = radius * std::sqrt(uniform(generator, 0, 1));
+        const double theta = uniform(generator, 0, 2 * IGN_PI);
+        const double z = uniform(generator, -length / 2, length / 2);
+        _positions.emplace_back(r * std::cos(theta), r * std::sin(theta), z);
+      }
+      break;
+    }
+    case PopulationDistributionType::UNIFORM:
+    {
+      // Points of a sunflower spiral, which spreads them evenly over the
+      // base of the cylinder.
+      const double goldenAngle = IGN_PI * (3 - std::sqrt(5.0));
+      for (uint64_t i = 0; i < count; ++i)
+      {
+        const double r = radius * std::sqrt(
+            (static_cast<double>(i) + 0.5) / static_cast<double>(count));
+        const double theta = goldenAngle * static_cast<double>(i);
+        _positions.emplace_back(r * std::cos(theta), r * std::sin(theta), 0);
+      }
+      break;
+    }
+    case PopulationDistributionType::LINEAR_X:
+    case PopulationDistributionType::LINEAR_Y:
+    case PopulationDistributionType::LINEAR_Z:
+    {
+      const auto axis = static_cast<std::size_t>(this->distributionType) -
+          static_cast<std::size_t>(PopulationDistributionType::LINEAR_X);
+      const double axisLength = axis == 2 ? length : 2 * radius;
+      for (uint64_t i = 0; i < count; ++i)
+      {
+        ignition::math::Vector3d position;
+        position[axis] = cellCenter(i, count, axisLength);
+        _positions.push_back(position);
+      }
+      break;
+    }
+    case PopulationDistributionType::GRID:
+      break;
+  }
+}
+
+/////////////////////////////////////////////////
+Population::Population()
+  : dataPtr(ignition::utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->GeneratePoses();
+}
+
+/////////////////////////////////////////////////
+Errors Population::Load(ElementPtr _sdf)
+{
+  return this->Load(_sdf, ParserConfig::GlobalConfig());
+}
+
+/////////////////////////////////////////////////
+Errors Population::Load(ElementPtr _sdf, const ParserConfig &_config)
+{
+  ScopedTraceEvent event(_config, "Population::Load", "dom");
+  Errors errors;
+
+  this->dataPtr->sdf = retainedElement(_sdf);
+
+  // Check that sdf is a valid pointer
+  if (!_sdf)
+  {
+    errors.push_back({ErrorCode::ELEMENT_MISSING,
+        "Attempting to load a population, but the provided SDF "
+        "element is null."});
+    return errors;
+  }
+
+  // Check that the provided SDF element is a <population>
+  // This is an error that cannot be recovered, so return an error.
+  if (_sdf->GetName() != "population")
+  {
+    errors.push_back({ErrorCode::ELEMENT_INCORRECT_TYPE,
+        "Attempting to load a Population, but the provided SDF element is "
+        "not a <population>."});
+    return errors;
+  }
+
+  // Read the population's name
+  if (!loadName(_sdf, this->dataPtr->name))
+  {
+    errors.push_back({ErrorCode::ATTRIBUTE_MISSING,
+        "A population name is required, but the name is not set."});
+  }
+
+  const int modelCount = _sdf->Get<int>("model_count", 1).first;
+  if (modelCount < 1)
+  {
+    errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "The <model_count> of population [" + this->dataPtr->name +
+        "] must be positive, but it is [" + std::to_string(modelCount) +
+        "]."});
+  }
+  this->dataPtr->modelCount = static_cast<uint64_t>(std::max(modelCount, 0));
+
+  sdf::ElementPtr distribution = _sdf->FindElement("distribution");
+  if (distribution)
+  {
+    const std::string type =
+        distribution->Get<std::string>("type", "random").first;
+    auto it = std::find(kDistributionTypeNames.begin(),
+                        kDistributionTypeNames.end(), type);
+    if (it == kDistributionTypeNames.end())
+    {
+      errors.push_back({ErrorCode::ELEMENT_INVALID,
+          "The distribution type [" + type + "] of population [" +
+          this->dataPtr->name + "] is not supported."});
+    }
+    else
+    {
+      this->dataPtr->distributionType = static_cast<PopulationDistributionType>(
+          it - kDistributionTypeNames.begin());
+    }
+
+    this->dataPtr->rows = static_cast<uint64_t>(
+        std::max(distribution->Get<int>("rows", 1).first, 0));
+    this->dataPtr->cols = static_cast<uint64_t>(
+        std::max(distribution->Get<int>("cols", 1).first, 0));
+    this->dataPtr->step = distribution->Get<ignition::math::Vector3d>(
+        "step", this->dataPtr->step).first;
+  }
+
+  const uint64_t instanceCount = this->dataPtr->RequestedInstanceCount();
+  if (instanceCount > kMaxInstanceCount)
+  {
+    errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Population [" + this->dataPtr->name + "] requests [" +
+        std::to_string(instanceCount) + "] instances, but at most [" +
+        std::to_string(kMaxInstanceCount) + "] are supported. No instances "
+        "are placed."});
+  }
+
+  // Load the pose. Ignore the return value since the pose is optional.
+  std::string poseRelativeTo;
+  loadPose(_sdf, this->dataPtr->pose, poseRelativeTo);
+
+  if (_sdf->HasElement("box"))
+  {
+    this->dataPtr->box.emplace();
+    Errors boxErrors = this->dataPtr->box->Load(_sdf->GetElement("box"));
+    errors.insert(errors.end(), boxErrors.begin(), boxErrors.end());
+  }
+  else if (_sdf->HasElement("cylinder"))
+  {
+    this->dataPtr->cylinder.emplace();
+    Errors cylinderErrors =
+        this->dataPtr->cylinder->Load(_sdf->GetElement("cylinder"));
+    errors.insert(errors.end(), cylinderErrors.begin(), cylinderErrors.end());
+  }
+  else if (this->dataPtr->distributionType != PopulationDistributionType::GRID)
+  {
+    errors.push_back({ErrorCode::ELEMENT_MISSING,
+        "Population [" + this->dataPtr->name + "] with a [" +
+        kDistributionTypeNames[
+            static_cast<std::size_t>(this->dataPtr->distributionType)] +
+        "] distribution requires a <box> or <cylinder> region."});
+  }
+
+  if (_sdf->HasElement("model"))
+  {
+    Errors modelErrors =
+        this->dataPtr->model.Load(_sdf->GetElement("model"), _config);
+    errors.insert(errors.end(), modelErrors.begin(), modelErrors.end());
+  }
+  else
+  {
+    errors.push_back({ErrorCode::ELEMENT_MISSING,
+        "Population [" + this->dataPtr->name + "] is missing a <model>."});
+  }
+
+  this->dataPtr->GeneratePoses();
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+const std::string &Population::Name() const
+{
+  return this->dataPtr->name;
+}
+
+/////////////////////////////////////////////////
+void Population::SetName(const std::string &_name)
+{
+  this->dataPtr->name = _name;
+}
+
+/////////////////////////////////////////////////
+uint64_t Population::ModelCount() const
+{
+  return this->dataPtr->modelCount;
+}
+
+/////////////////////////////////////////////////
+void Population::SetModelCount(uint64_t _count)
+{
+  this->dataPtr->modelCount = _count;
+  this->dataPtr->GeneratePoses();
+}
+
+/////////////////////////////////////////////////
+PopulationDistributionType Population::DistributionType() const
+{
+  return this->dataPtr->distributionType;
+}
+
+/////////////////////////////////////////////////
+void Population::SetDistributionType(PopulationDistributionType _type)
+{
+  this->dataPtr->distributionType = _type;
+  this->dataPtr->GeneratePoses();
+}
+
+/////////////////////////////////////////////////
+uint64_t Population::Rows() const
+{
+  return this->dataPtr->rows;
+}
+
+/////////////////////////////////////////////////
+void Population::SetRows(uint64_t _rows)
+{
+  this->dataPtr->rows = _rows;
+  this->dataPtr->GeneratePoses();
+}
+
+/////////////////////////////////////////////////
+uint64_t Population::Cols() const
+{
+  return this->dataPtr->cols;
+}
+
+/////////////////////////////////////////////////
+void Population::SetCols(uint64_t _cols)
+{
+  this->dataPtr->cols = _cols;
+  this->dataPtr->GeneratePoses();
+}
+
+/////////////////////////////////////////////////
+const ignition::math::Vector3d &Population::Step() const
+{
+  return this->dataPtr->step;
+}
+
+/////////////////////////////////////////////////
+void Population::SetStep(const ignition::math::Vector3d &_step)
+{
+  this->dataPtr->step = _step;
+  this->dataPtr->GeneratePoses();
+}
+
+/////////////////////////////////////////////////
+const sdf::Box *Population::RegionBox() const
+{
+  return optionalToPointer(this->dataPtr->box);
+}
+
+/////////////////////////////////////////////////
+void Population::SetRegionBox(const sdf::Box &_box)
+{
+  this->dataPtr->box = _box;
+  this->dataPtr->cylinder.reset();
+  this->dataPtr->GeneratePoses();
+}
+
+/////////////////////////////////////////////////
+const sdf::Cylinder *Population::RegionCylinder() const
+{
+  return optionalToPointer(this->dataPtr->cylinder);
+}
+
+/////////////////////////////////////////////////
+void Population::SetRegionCylinder(const sdf::Cylinder &_cylinder)
+{
+  this->dataPtr->cylinder = _cylinder;
+  this->dataPtr->box.reset();
+  this->dataPtr->GeneratePoses();
+}
+
+/////////////////////////////////////////////////
+uint32_t Population::Seed() const
+{
+  return this->dataPtr->seed;
+}
+
+/////////////////////////////////////////////////
+void Population::SetSeed(uint32_t _seed)
+{
+  this->dataPtr->seed = _seed;
+  this->dataPtr->GeneratePoses();
+}
+
+/////////////////////////////////////////////////
+const ignition::math::Pose3d &Population::RawPose() const
+{
+  return this->dataPtr->pose;
+}
+
+/////////////////////////////////////////////////
+void Population::SetRawPose(const ignition::math::Pose3d &_pose)
+{
+  this->dataPtr->pose = _pose;
+  this->dataPtr->GeneratePoses();
+}
+
+/////////////////////////////////////////////////
+const sdf::Model *Population::Model() const
+{
+  return &this->dataPtr->model;
+}
+
+/////////////////////////////////////////////////
+void Population::SetModel(const sdf::Model &_model)
+{
+  this->dataPtr->model = _model;
+  this->dataPtr->GeneratePoses();
+}
+
+/////////////////////////////////////////////////
+uint64_t Population::InstanceCount() const
+{
+  return this->dataPtr->instancePoses.size();
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Pose3d> &Population::InstancePoses() const
+{
+  return this->dataPtr->instancePoses;
+}
+
+/////////////////////////////////////////////////
+sdf::Model Population::InstanceModel(uint64_t _index) const
+{
+  if (_index >= this->dataPtr->instancePoses.size())
+    return sdf::Model();
+
+  sdf::Model instance = this->dataPtr->model;
+  instance.SetName(this->dataPtr->model.Name() + "_clone_" +
+                   std::to_string(_index));
+  instance.SetRawPose(this->dataPtr->instancePoses[_index]);
+  instance.SetPoseRelativeTo("");
+  return instance;
+}
+
+/////////////////////////////////////////////////
+sdf::ElementPtr Population::Element() const
+{
+  return this->dataPtr->sdf;
+}
+
+/////////////////////////////////////////////////
+sdf::ElementPtr Population::ToElement() const
+{
+  sdf::ElementPtr elem(new sdf::Element);
+  sdf::initFile("population.sdf", elem);
+
+  elem->GetAttribute("name")->Set(this->Name());
+  elem->GetElement("model_count")->Set<int>(
+      static_cast<int>(this->dataPtr->modelCount));
+
+  sdf::ElementPtr distributionElem = elem->GetElement("distribution");
+  distributionElem->GetElement("type")->Set<std::string>(
+      kDistributionTypeNames[
+          static_cast<std::size_t>(this->dataPtr->distributionType)]);
+  distributionElem->GetElement("rows")->Set<int>(
+      static_cast<int>(this->dataPtr->rows));
+  distributionElem->GetElement("cols")->Set<int>(
+      static_cast<int>(this->dataPtr->cols));
+  distributionElem->GetElement("step")->Set(this->dataPtr->step);
+
+  elem->GetElement("pose")->Set<ignition::math::Pose3d>(this->RawPose());
+
+  if (this->dataPtr->box)
+    elem->InsertElement(this->dataPtr->box->ToElement(), true);
+  else if (this->dataPtr->cylinder)
+    elem->InsertElement(this->dataPtr->cylinder->ToElement(), true);
+
+  elem->InsertElement(this->dataPtr->model.ToElement(), true);
+
+  return elem;
+}
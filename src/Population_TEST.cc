@@ -0,0 +1,253 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "sdf/Population.hh"
+#include "sdf/Root.hh"
+#include "sdf/World.hh"
+
+/////////////////////////////////////////////////
+TEST(DOMPopulation, Construction)
+{
+  sdf::Population population;
+  EXPECT_EQ(nullptr, population.Element());
+  EXPECT_TRUE(population.Name().empty());
+  EXPECT_EQ(1u, population.ModelCount());
+  EXPECT_EQ(sdf::PopulationDistributionType::RANDOM,
+            population.DistributionType());
+  EXPECT_EQ(1u, population.Rows());
+  EXPECT_EQ(1u, population.Cols());
+  EXPECT_EQ(ignition::math::Vector3d(0.5, 0.5, 0), population.Step());
+  EXPECT_EQ(nullptr, population.RegionBox());
+  EXPECT_EQ(nullptr, population.RegionCylinder());
+  EXPECT_EQ(0u, population.Seed());
+  EXPECT_EQ(ignition::math::Pose3d::Zero, population.RawPose());
+  ASSERT_NE(nullptr, population.Model());
+
+  // Without a region, only the grid distribution places models
+  EXPECT_EQ(0u, population.InstanceCount());
+  population.SetDistributionType(sdf::PopulationDistributionType::GRID);
+  EXPECT_EQ(1u, population.InstanceCount());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMPopulation, Distributions)
+{
+  sdf::Population population;
+  population.SetRawPose({1, 2, 3, 0, 0, 0});
+
+  population.SetDistributionType(sdf::PopulationDistributionType::GRID);
+  population.SetRows(2);
+  population.SetCols(3);
+  population.SetStep({1, 2, 0});
+  ASSERT_EQ(6u, population.InstanceCount());
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0),
+            population.InstancePoses()[0]);
+  EXPECT_EQ(ignition::math::Pose3d(3, 4, 3, 0, 0, 0),
+            population.InstancePoses()[5]);
+
+  sdf::Box box;
+  box.SetSize({4, 2, 2});
+  population.SetRegionBox(box);
+  population.SetModelCount(4);
+  population.SetDistributionType(sdf::PopulationDistributionType::LINEAR_X);
+  ASSERT_EQ(4u, population.InstanceCount());
+  EXPECT_EQ(ignition::math::Pose3d(-0.5, 2, 3, 0, 0, 0),
+            population.InstancePoses()[0]);
+  EXPECT_EQ(ignition::math::Pose3d(2.5, 2, 3, 0, 0, 0),
+            population.InstancePoses()[3]);
+
+  population.SetDistributionType(sdf::PopulationDistributionType::UNIFORM);
+  ASSERT_EQ(4u, population.InstanceCount());
+  EXPECT_EQ(ignition::math::Pose3d(0, 1.5, 3, 0, 0, 0),
+            population.InstancePoses()[0]);
+  EXPECT_EQ(ignition::math::Pose3d(2, 2.5, 3, 0, 0, 0),
+            population.InstancePoses()[3]);
+
+  // The random poses are in the region, and depend on the seed
+  population.SetModelCount(100);
+  population.SetDistributionType(sdf::PopulationDistributionType::RANDOM);
+  ASSERT_EQ(100u, population.InstanceCount());
+  const auto poses = population.InstancePoses();
+  for (const auto &pose : poses)
+  {
+    EXPECT_LE(-1.0, pose.Pos().X());
+    EXPECT_GE(3.0, pose.Pos().X());
+    EXPECT_LE(1.0, pose.Pos().Y());
+    EXPECT_GE(3.0, pose.Pos().Y());
+    EXPECT_LE(2.0, pose.Pos().Z());
+    EXPECT_GE(4.0, pose.Pos().Z());
+  }
+  population.SetSeed(population.Seed());
+  EXPECT_EQ(poses, population.InstancePoses());
+  population.SetSeed(1);
+  EXPECT_NE(poses, population.InstancePoses());
+
+  sdf::Cylinder cylinder;
+  cylinder.SetRadius(2);
+  cylinder.SetLength(1);
+  population.SetRegionCylinder(cylinder);
+  EXPECT_EQ(nullptr, population.RegionBox());
+  ASSERT_NE(nullptr, population.RegionCylinder());
+  ASSERT_EQ(100u, population.InstanceCount());
+  for (const auto &pose : population.InstancePoses())
+  {
+    const auto offset = pose.Pos() - population.RawPose().Pos();
+    EXPECT_GE(2.0, std::hypot(offset.X(), offset.Y()));
+    EXPECT_GE(0.5, std::abs(offset.Z()));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(DOMPopulation, LoadWorld)
+{
+  const std::string sdf = R"(
+<sdf version='1.9'>
+  <world name='default'>
+    <population name='forest'>
+      <model_count>3</model_count>
+      <distribution>
+        <type>linear-y</type>
+      </distribution>
+      <pose>10 0 0 0 0 0</pose>
+      <box>
+        <size>1 6 1</size>
+      </box>
+      <model name='tree'>
+        <pose>0 0 1 0 0 0</pose>
+        <link name='trunk'/>
+      </model>
+    </population>
+  </world>
+</sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf);
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  EXPECT_EQ(0u, world->ModelCount());
+  ASSERT_EQ(1u, world->PopulationCount());
+  EXPECT_TRUE(world->PopulationNameExists("forest"));
+  EXPECT_EQ(nullptr, world->PopulationByIndex(1));
+
+  const sdf::Population *population = world->PopulationByIndex(0);
+  ASSERT_NE(nullptr, population);
+  EXPECT_NE(nullptr, population->Element());
+  EXPECT_EQ("forest", population->Name());
+  EXPECT_EQ(3u, population->ModelCount());
+  EXPECT_EQ(sdf::PopulationDistributionType::LINEAR_Y,
+            population->DistributionType());
+  ASSERT_NE(nullptr, population->RegionBox());
+  EXPECT_EQ("tree", population->Model()->Name());
+  ASSERT_EQ(3u, population->InstanceCount());
+
+  // Instances are only copied into models when they are requested
+  const sdf::Model instance = population->InstanceModel(2);
+  EXPECT_EQ("tree_clone_2", instance.Name());
+  EXPECT_EQ(ignition::math::Pose3d(10, 2, 1, 0, 0, 0), instance.RawPose());
+  EXPECT_EQ(1u, instance.LinkCount());
+  EXPECT_TRUE(population->InstanceModel(3).Name().empty());
+
+  // The population survives a round trip through ToElement
+  sdf::Root root2;
+  errors = root2.LoadSdfString("<sdf version='1.9'>" +
+      world->ToElement()->ToString("") + "</sdf>");
+  EXPECT_TRUE(errors.empty()) << errors;
+  ASSERT_NE(nullptr, root2.WorldByIndex(0));
+  const sdf::Population *population2 =
+      root2.WorldByIndex(0)->PopulationByIndex(0);
+  ASSERT_NE(nullptr, population2);
+  EXPECT_EQ(population->InstancePoses(), population2->InstancePoses());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMPopulation, LoadErrors)
+{
+  const std::string sdf = R"(
+<sdf version='1.9'>
+  <world name='default'>
+    <population name='forest'>
+      <model_count>0</model_count>
+      <distribution>
+        <type>random</type>
+      </distribution>
+      <model name='tree'>
+        <link name='trunk'/>
+      </model>
+    </population>
+  </world>
+</sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf);
+  ASSERT_EQ(2u, errors.size()) << errors;
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_INVALID, errors[0].Code());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_MISSING, errors[1].Code());
+  EXPECT_NE(std::string::npos,
+            errors[1].Message().find("requires a <box> or <cylinder>"));
+}
+
+/////////////////////////////////////////////////
+TEST(DOMPopulation, LoadTooManyInstances)
+{
+  const std::string sdf = R"(
+<sdf version='1.9'>
+  <world name='default'>
+    <population name='forest'>
+      <distribution>
+        <type>grid</type>
+        <rows>2000000000</rows>
+        <cols>2000000000</cols>
+      </distribution>
+      <model name='tree'>
+        <link name='trunk'/>
+      </model>
+    </population>
+  </world>
+</sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf);
+  ASSERT_EQ(1u, errors.size()) << errors;
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_INVALID, errors[0].Code());
+  EXPECT_NE(std::string::npos,
+            errors[0].Message().find("at most [1000000]"))
+    << errors[0].Message();
+
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  const sdf::Population *population = world->PopulationByIndex(0);
+  ASSERT_NE(nullptr, population);
+  EXPECT_EQ(0u, population->InstanceCount());
+
+  // Setters do not place a population that is too large either
+  sdf::Population large;
+  large.SetDistributionType(sdf::PopulationDistributionType::GRID);
+  large.SetRows(std::numeric_limits<uint64_t>::max());
+  large.SetCols(2);
+  EXPECT_EQ(0u, large.InstanceCount());
+  large.SetRows(3);
+  EXPECT_EQ(6u, large.InstanceCount());
+}
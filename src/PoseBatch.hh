@@ -0,0 +1,183 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_POSEBATCH_HH
+#define SDFORMAT_POSEBATCH_HH
+
+#include <cstddef>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Poses stored in structure of arrays form, with one array per
+  /// component, so that many poses can be composed with loops that the
+  /// compiler vectorizes for the instruction set it targets.
+  class PoseBatch
+  {
+    /// \brief Get the number of poses.
+    /// \return Number of poses.
+    public: std::size_t Size() const
+    {
+      return this->px.size();
+    }
+
+    /// \brief Remove every pose.
+    public: void Clear()
+    {
+      this->Resize(0u);
+    }
+
+    /// \brief Change the number of poses. Added poses are zero poses.
+    /// \param[in] _size New number of poses.
+    public: void Resize(std::size_t _size)
+    {
+      this->px.resize(_size, 0.0);
+      this->py.resize(_size, 0.0);
+      this->pz.resize(_size, 0.0);
+      this->qw.resize(_size, 1.0);
+      this->qx.resize(_size, 0.0);
+      this->qy.resize(_size, 0.0);
+      this->qz.resize(_size, 0.0);
+    }
+
+    /// \brief Add a pose at the end.
+    /// \param[in] _pose Pose to add.
+    public: void Push(const ignition::math::Pose3d &_pose)
+    {
+      this->px.push_back(_pose.Pos().X());
+      this->py.push_back(_pose.Pos().Y());
+      this->pz.push_back(_pose.Pos().Z());
+      this->qw.push_back(_pose.Rot().W());
+      this->qx.push_back(_pose.Rot().X());
+      this->qy.push_back(_pose.Rot().Y());
+      this->qz.push_back(_pose.Rot().Z());
+    }
+
+    /// \brief Get a pose.
+    /// \param[in] _index Index of the pose, less than Size().
+    /// \return The pose.
+    public: ignition::math::Pose3d Pose(std::size_t _index) const
+    {
+      return ignition::math::Pose3d(
+          this->px[_index], this->py[_index], this->pz[_index],
+          this->qw[_index], this->qx[_index], this->qy[_index],
+          this->qz[_index]);
+    }
+
+    /// \brief Compose pairs of poses, such that the pose at each index of
+    /// _out is _parents.Pose(i) * _children.Pose(i). Both batches must have
+    /// the same size, and _out may be either of them.
+    /// \param[in] _parents Poses of the parent frames.
+    /// \param[in] _children Poses of the child frames relative to the
+    /// parent frames.
+    /// \param[out] _out Poses of the child frames relative to the frames
+    /// that the parent frames are relative to.
+    public: static void Compose(const PoseBatch &_parents,
+                                const PoseBatch &_children, PoseBatch &_out)
+    {
+      const std::size_t size = _children.Size();
+      _out.Resize(size);
+
+      const double *apx = _parents.px.data();
+      const double *apy = _parents.py.data();
+      const double *apz = _parents.pz.data();
+      const double *aqw = _parents.qw.data();
+      const double *aqx = _parents.qx.data();
+      const double *aqy = _parents.qy.data();
+      const double *aqz = _parents.qz.data();
+      const double *bpx = _children.px.data();
+      const double *bpy = _children.py.data();
+      const double *bpz = _children.pz.data();
+      const double *bqw = _children.qw.data();
+      const double *bqx = _children.qx.data();
+      const double *bqy = _children.qy.data();
+      const double *bqz = _children.qz.data();
+      double *opx = _out.px.data();
+      double *opy = _out.py.data();
+      double *opz = _out.pz.data();
+      double *oqw = _out.qw.data();
+      double *oqx = _out.qx.data();
+      double *oqy = _out.qy.data();
+      double *oqz = _out.qz.data();
+
+      // Each iteration only reads index i of the inputs before writing index
+      // i of the output, so the loop is free of loop-carried dependencies
+      // even when _out is one of the inputs.
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        const double aw = aqw[i];
+        const double ax = aqx[i];
+        const double ay = aqy[i];
+        const double az = aqz[i];
+        const double vx = bpx[i];
+        const double vy = bpy[i];
+        const double vz = bpz[i];
+        const double bw = bqw[i];
+        const double bx = bqx[i];
+        const double by = bqy[i];
+        const double bz = bqz[i];
+
+        // Rotate the child position by the parent rotation, with
+        // v + w * t + q x t where t = 2 * (q x v).
+        const double tx = 2.0 * (ay * vz - az * vy);
+        const double ty = 2.0 * (az * vx - ax * vz);
+        const double tz = 2.0 * (ax * vy - ay * vx);
+        const double rx = vx + aw * tx + (ay * tz - az * ty);
+        const double ry = vy + aw * ty + (az * tx - ax * tz);
+        const double rz = vz + aw * tz + (ax * ty - ay * tx);
+
+        opx[i] = apx[i] + rx;
+        opy[i] = apy[i] + ry;
+        opz[i] = apz[i] + rz;
+        oqw[i] = aw * bw - ax * bx - ay * by - az * bz;
+        oqx[i] = aw * bx + ax * bw + ay * bz - az * by;
+        oqy[i] = aw * by - ax * bz + ay * bw + az * bx;
+        oqz[i] = aw * bz + ax * by - ay * bx + az * bw;
+      }
+    }
+
+    /// \brief X components of the positions.
+    private: std::vector<double> px;
+
+    /// \brief Y components of the positions.
+    private: std::vector<double> py;
+
+    /// \brief Z components of the positions.
+    private: std::vector<double> pz;
+
+    /// \brief W components of the rotations.
+    private: std::vector<double> qw;
+
+    /// \brief X components of the rotations.
+    private: std::vector<double> qx;
+
+    /// \brief Y components of the rotations.
+    private: std::vector<double> qy;
+
+    /// \brief Z components of the rotations.
+    private: std::vector<double> qz;
+  };
+  }
+}
+#endif
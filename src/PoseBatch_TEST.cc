@@ -0,0 +1,86 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+
+#include "PoseBatch.hh"
+
+/////////////////////////////////////////////////
+TEST(PoseBatch, PushAndResize)
+{
+  using ignition::math::Pose3d;
+
+  sdf::PoseBatch batch;
+  EXPECT_EQ(0u, batch.Size());
+
+  const Pose3d pose(1, 2, 3, 0.1, 0.2, 0.3);
+  batch.Push(pose);
+  ASSERT_EQ(1u, batch.Size());
+  EXPECT_EQ(pose, batch.Pose(0));
+
+  batch.Resize(2);
+  ASSERT_EQ(2u, batch.Size());
+  EXPECT_EQ(pose, batch.Pose(0));
+  EXPECT_EQ(Pose3d::Zero, batch.Pose(1));
+
+  batch.Clear();
+  EXPECT_EQ(0u, batch.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(PoseBatch, Compose)
+{
+  using ignition::math::Pose3d;
+
+  const std::vector<Pose3d> parents = {
+    Pose3d::Zero,
+    Pose3d(1, 0, 0, 0, 0, 0),
+    Pose3d(0, 0, 0, 0, 0, IGN_PI_2),
+    Pose3d(1, -2, 3, 0.4, -0.5, 2.0),
+    Pose3d(-4, 5, 0.5, -1.2, 0.3, -0.7),
+  };
+  const std::vector<Pose3d> children = {
+    Pose3d(1, 2, 3, 0.1, 0.2, 0.3),
+    Pose3d(0, 1, 0, 0, 0, IGN_PI_2),
+    Pose3d(1, 0, 0, 0, 0, 0),
+    Pose3d(-0.5, 0.25, 2, 1.0, 0.1, -0.2),
+    Pose3d(3, 3, -3, 0, IGN_PI_4, 0),
+  };
+
+  sdf::PoseBatch parentBatch;
+  sdf::PoseBatch childBatch;
+  for (std::size_t i = 0; i < parents.size(); ++i)
+  {
+    parentBatch.Push(parents[i]);
+    childBatch.Push(children[i]);
+  }
+
+  sdf::PoseBatch out;
+  sdf::PoseBatch::Compose(parentBatch, childBatch, out);
+  ASSERT_EQ(parents.size(), out.Size());
+  for (std::size_t i = 0; i < parents.size(); ++i)
+    EXPECT_EQ(parents[i] * children[i], out.Pose(i)) << i;
+
+  // The output can be one of the inputs.
+  sdf::PoseBatch::Compose(parentBatch, childBatch, childBatch);
+  for (std::size_t i = 0; i < parents.size(); ++i)
+    EXPECT_EQ(parents[i] * children[i], childBatch.Pose(i)) << i;
+}
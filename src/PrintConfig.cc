@@ -15,6 +15,9 @@
  *
 */
 
+#include <memory>
+#include <utility>
+
 #include "sdf/PrintConfig.hh"
 #include "sdf/Console.hh"
 
@@ -36,6 +39,12 @@ class PrintConfig::Implementation
 
   /// \brief True to preserve <include> tags, false to expand.
   public: bool preserveIncludes = false;
+
+  /// \brief Number of threads used to convert elements to strings.
+  public: std::size_t threadCount = 0;
+
+  /// \brief Executor of the threads that convert elements to strings.
+  public: std::shared_ptr<TaskExecutor> executor = TaskExecutor::Threaded();
 };
 
 /////////////////////////////////////////////////
@@ -104,13 +113,40 @@ std::optional<double> PrintConfig::RotationSnapTolerance() const
   return this->dataPtr->rotationSnapTolerance;
 }
 
+/////////////////////////////////////////////////
+void PrintConfig::SetThreadCount(std::size_t _count)
+{
+  this->dataPtr->threadCount = _count;
+}
+
+/////////////////////////////////////////////////
+std::size_t PrintConfig::ThreadCount() const
+{
+  return this->dataPtr->threadCount;
+}
+
+/////////////////////////////////////////////////
+void PrintConfig::SetExecutor(std::shared_ptr<TaskExecutor> _executor)
+{
+  this->dataPtr->executor =
+      _executor ? std::move(_executor) : TaskExecutor::Threaded();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<TaskExecutor> PrintConfig::Executor() const
+{
+  return this->dataPtr->executor;
+}
+
 /////////////////////////////////////////////////
 bool PrintConfig::operator==(const PrintConfig &_config) const
 {
   if (this->RotationInDegrees() == _config.RotationInDegrees() &&
       this->RotationSnapToDegrees() == _config.RotationSnapToDegrees() &&
       this->RotationSnapTolerance() == _config.RotationSnapTolerance() &&
-      this->PreserveIncludes() == _config.PreserveIncludes())
+      this->PreserveIncludes() == _config.PreserveIncludes() &&
+      this->ThreadCount() == _config.ThreadCount() &&
+      this->Executor() == _config.Executor())
   {
     return true;
   }
@@ -105,3 +105,21 @@ TEST(PrintConfig, PreserveIncludes)
   config.SetPreserveIncludes(false);
   EXPECT_FALSE(config.PreserveIncludes());
 }
+
+/////////////////////////////////////////////////
+TEST(PrintConfig, ThreadCount)
+{
+  sdf::PrintConfig config;
+  EXPECT_EQ(0u, config.ThreadCount());
+  EXPECT_EQ(sdf::TaskExecutor::Threaded(), config.Executor());
+
+  config.SetThreadCount(4);
+  EXPECT_EQ(4u, config.ThreadCount());
+  EXPECT_FALSE(config == sdf::PrintConfig());
+
+  config.SetExecutor(sdf::TaskExecutor::Inline());
+  EXPECT_EQ(sdf::TaskExecutor::Inline(), config.Executor());
+
+  config.SetExecutor(nullptr);
+  EXPECT_EQ(sdf::TaskExecutor::Threaded(), config.Executor());
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "sdf/Error.hh"
+#include "sdf/Model.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/ResourceProvider.hh"
+#include "sdf/Root.hh"
+#include "sdf/World.hh"
+
+/// \brief Provider of files that are held in memory. A directory exists if
+/// a file is in it.
+class MemoryProvider : public sdf::ResourceProvider
+{
+  /// \brief Add a file.
+  /// \param[in] _path Path of the file.
+  /// \param[in] _contents Contents of the file.
+  public: void AddFile(const std::string &_path, const std::string &_contents)
+  {
+    this->files[_path] = std::make_shared<const std::string>(_contents);
+  }
+
+  // Documentation inherited.
+  public: bool Exists(const std::string &_path) const override
+  {
+    return this->files.count(_path) > 0 || this->IsDirectory(_path);
+  }
+
+  // Documentation inherited.
+  public: bool IsDirectory(const std::string &_path) const override
+  {
+    const std::string prefix = _path + "/";
+    auto it = this->files.lower_bound(prefix);
+    return it != this->files.end() && it->first.compare(
+        0, prefix.size(), prefix) == 0;
+  }
+
+  // Documentation inherited.
+  public: bool Read(const std::string &_path,
+                    sdf::ResourceData &_data) const override
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->reads[_path];
+    auto it = this->files.find(_path);
+    if (it == this->files.end())
+      return false;
+    _data.data = *it->second;
+    _data.owner = it->second;
+    return true;
+  }
+
+  /// \brief Number of times each file was read.
+  public: mutable std::map<std::string, int> reads;
+
+  /// \brief Files by path.
+  private: std::map<std::string, std::shared_ptr<const std::string>> files;
+
+  /// \brief Mutex that protects reads.
+  private: mutable std::mutex mutex;
+};
+
+/////////////////////////////////////////////////
+/// \brief Make a provider with a world that includes a model directory.
+/// \return The provider.
+static std::shared_ptr<MemoryProvider> makeProvider()
+{
+  auto provider = std::make_shared<MemoryProvider>();
+  provider->AddFile("/blob/world.sdf",
+      "<?xml version='1.0'?><sdf version='1.8'><world name='default'>"
+      "<include><uri>model://box</uri><name>box_a</name></include>"
+      "<include><uri>model://box</uri><name>box_b</name></include>"
+      "</world></sdf>");
+  provider->AddFile("/blob/models/box/model.config",
+      "<?xml version='1.0'?><model><name>box</name>"
+      "<sdf version='1.8'>model.sdf</sdf></model>");
+  provider->AddFile("/blob/models/box/model.sdf",
+      "<?xml version='1.0'?><sdf version='1.8'><model name='box'>"
+      "<link name='link'/></model></sdf>");
+  return provider;
+}
+
+/////////////////////////////////////////////////
+TEST(ResourceProvider, Default)
+{
+  sdf::ParserConfig config;
+  EXPECT_EQ(nullptr, config.GetResourceProvider());
+
+  auto provider = std::make_shared<MemoryProvider>();
+  config.SetResourceProvider(provider);
+  EXPECT_EQ(provider, config.GetResourceProvider());
+
+  config.SetResourceProvider(nullptr);
+  EXPECT_EQ(nullptr, config.GetResourceProvider());
+}
+
+/////////////////////////////////////////////////
+TEST(ResourceProvider, LoadIncludes)
+{
+  auto provider = makeProvider();
+  sdf::ParserConfig config;
+  config.SetResourceProvider(provider);
+  config.AddURIPath("model://", "/blob/models");
+  ASSERT_EQ(1u, config.URIPathMap().count("model://"));
+
+  sdf::Root root;
+  sdf::Errors errors = root.Load("/blob/world.sdf", config);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  ASSERT_EQ(2u, world->ModelCount());
+  EXPECT_EQ("box_a", world->ModelByIndex(0)->Name());
+  EXPECT_EQ("box_b", world->ModelByIndex(1)->Name());
+  EXPECT_EQ(1u, world->ModelByIndex(1)->LinkCount());
+
+  // Each file is read once per use, from the provider.
+  EXPECT_EQ(1, provider->reads["/blob/world.sdf"]);
+  EXPECT_EQ(2, provider->reads["/blob/models/box/model.config"]);
+  EXPECT_EQ(2, provider->reads["/blob/models/box/model.sdf"]);
+}
+
+/////////////////////////////////////////////////
+TEST(ResourceProvider, MissingFiles)
+{
+  auto provider = makeProvider();
+  provider->AddFile("/blob/broken.sdf",
+      "<?xml version='1.0'?><sdf version='1.8'><world name='default'>"
+      "<include><uri>model://missing</uri></include>"
+      "</world></sdf>");
+  sdf::ParserConfig config;
+  config.SetResourceProvider(provider);
+  config.AddURIPath("model://", "/blob/models");
+
+  sdf::Root root;
+  sdf::Errors errors = root.Load("/blob/broken.sdf", config);
+  ASSERT_FALSE(errors.empty());
+  EXPECT_EQ(sdf::ErrorCode::URI_LOOKUP, errors[0].Code());
+
+  // Files that are only in the provider are not found without it.
+  sdf::Root fileRoot;
+  errors = fileRoot.Load("/blob/world.sdf");
+  ASSERT_FALSE(errors.empty());
+  EXPECT_EQ(sdf::ErrorCode::FILE_READ, errors.back().Code());
+}
@@ -14,29 +14,142 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <variant>
 #include <vector>
 #include <utility>
 
 #include "sdf/Actor.hh"
+#include "sdf/Collision.hh"
+#include "sdf/Console.hh"
 #include "sdf/Error.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/Frame.hh"
+#include "sdf/Geometry.hh"
+#include "sdf/Gui.hh"
+#include "sdf/Heightmap.hh"
+#include "sdf/Joint.hh"
 #include "sdf/Light.hh"
+#include "sdf/Link.hh"
+#include "sdf/Material.hh"
+#include "sdf/Mesh.hh"
 #include "sdf/Model.hh"
+#include "sdf/ParamUpdateTable.hh"
+#include "sdf/Pbr.hh"
+#include "sdf/Plugin.hh"
+#include "sdf/Population.hh"
 #include "sdf/Root.hh"
+#include "sdf/Sensor.hh"
 #include "sdf/Types.hh"
+#include "sdf/Visual.hh"
 #include "sdf/World.hh"
 #include "sdf/parser.hh"
 #include "sdf/sdf_config.h"
+#include "DomInterner.hh"
+#include "ElementCache.hh"
+#include "ErrorSink.hh"
 #include "FrameSemantics.hh"
 #include "ScopedGraph.hh"
+#include "ScopedLoadPhase.hh"
+#include "ScopedTraceEvent.hh"
 #include "Utils.hh"
+#include "parser_private.hh"
 
 using namespace sdf;
 
+/// \brief Types of the entities that have an ID.
+enum class EntityType
+{
+  MODEL,
+  LINK,
+  JOINT,
+  FRAME,
+  COLLISION,
+  VISUAL,
+  SENSOR
+};
+
+/// \brief Get the type of entity of a DOM class.
+/// \tparam T DOM class.
+/// \return Type of entity.
+template <typename T>
+static constexpr EntityType entityTypeOf()
+{
+  if constexpr (std::is_same_v<T, sdf::Model>)
+    return EntityType::MODEL;
+  else if constexpr (std::is_same_v<T, sdf::Link>)
+    return EntityType::LINK;
+  else if constexpr (std::is_same_v<T, sdf::Joint>)
+    return EntityType::JOINT;
+  else if constexpr (std::is_same_v<T, sdf::Frame>)
+    return EntityType::FRAME;
+  else if constexpr (std::is_same_v<T, sdf::Collision>)
+    return EntityType::COLLISION;
+  else if constexpr (std::is_same_v<T, sdf::Visual>)
+    return EntityType::VISUAL;
+  else
+  {
+    static_assert(std::is_same_v<T, sdf::Sensor>,
+                  "Entity IDs are not assigned to this type");
+    return EntityType::SENSOR;
+  }
+}
+
+/// \brief Location of an entity that has an ID.
+struct EntityLocation
+{
+  /// \brief Type of the entity.
+  EntityType type;
+
+  /// \brief ID of the model, link or joint that contains the entity, or
+  /// kNoIndex if the entity is directly in a world or the root.
+  uint64_t parent;
+
+  /// \brief Index of the world that contains an entity that has no parent,
+  /// or kNoIndex for the model of the root.
+  uint64_t world;
+
+  /// \brief Index of the entity in the object that contains it.
+  uint64_t index;
+};
+
+/// \brief Value of EntityLocation fields that do not apply.
+static constexpr uint64_t kNoIndex = std::numeric_limits<uint64_t>::max();
+
 /// \brief Private data for sdf::Root
 class sdf::Root::Implementation
 {
+  /// \brief Assign an ID to every model, link, joint, frame, collision,
+  /// visual and sensor of the worlds and the model.
+  public: void AssignEntityIds();
+
+  /// \brief Assign an ID to a model and the entities it contains.
+  /// \param[in] _model Model to assign IDs to.
+  /// \param[in] _parent ID of the model that contains _model, or kNoIndex.
+  /// \param[in] _world Index of the world that contains _model, or kNoIndex.
+  /// \param[in] _index Index of _model in the object that contains it.
+  public: void AssignEntityIds(const sdf::Model &_model, uint64_t _parent,
+                               uint64_t _world, uint64_t _index);
+
+  /// \brief Find an entity by its ID.
+  /// \tparam T DOM class of the entity.
+  /// \param[in] _id ID of the entity.
+  /// \return The entity, or nullptr if no entity of type T has the ID.
+  public: template <typename T>
+          const T *EntityById(uint64_t _id) const;
+
   /// \brief Build frame and pose graphs for the provided world.
   /// \param[in, out] _world World object to build graphs for.
   /// \param[out] _errors The list of errors generated by this function.
@@ -47,6 +160,40 @@ class sdf::Root::Implementation
   /// \param[out] _errors The list of errors generated by this function.
   public: void UpdateGraphs(sdf::Model &_model, sdf::Errors &_errors);
 
+  /// \brief Replace the frame and pose graphs of a world that already has
+  /// graphs.
+  /// \param[in] _worldIndex Index of the world.
+  /// \param[out] _errors The list of errors generated by this function.
+  public: void RebuildGraphs(uint64_t _worldIndex, sdf::Errors &_errors);
+
+  /// \brief Find a world and check that it contains a model.
+  /// \param[in] _worldName Name of the world.
+  /// \param[in] _modelName Name of a model that is a direct child of the
+  /// world.
+  /// \param[out] _errors The list of errors generated by this function.
+  /// \return Index of the world, or kNoIndex if the world or the model was
+  /// not found.
+  public: uint64_t WorldIndexWithModel(const std::string &_worldName,
+                                       const std::string &_modelName,
+                                       sdf::Errors &_errors) const;
+
+  /// \brief Check if the frame and pose graphs of a world were built.
+  /// \param[in] _worldIndex Index of the world.
+  /// \return True if the world has graphs.
+  public: bool HasGraphs(uint64_t _worldIndex) const;
+
+  /// \brief Give a world its own copies of its frame and pose graphs if it
+  /// shares them with a clone of this root, so that they can be modified in
+  /// place.
+  /// \param[in] _worldIndex Index of a world that has graphs.
+  public: void DetachGraphs(uint64_t _worldIndex);
+
+  /// \brief Check if the graphs of the worlds and of the model were built
+  /// for the current worlds and model.
+  /// \return True if every world has graphs, and the model too if there is
+  /// one.
+  public: bool GraphsBuilt() const;
+
   /// \brief Version string
   public: std::string version = SDF_VERSION;
 
@@ -71,24 +218,66 @@ class sdf::Root::Implementation
   /// \brief Pose Relative-To Graph constructed when loading a Model.
   public: sdf::ScopedGraph<PoseRelativeToGraph> modelPoseRelativeToGraph;
 
+  /// \brief Tokens of the graphs of the worlds, in the order of
+  /// worldFrameAttachedToGraphs. Root::Clone shares the graphs of the worlds
+  /// with the clone, and the token of a world with them. Its use count is
+  /// greater than one while the graphs of the world are shared, so they are
+  /// copied before being modified in place.
+  public: std::vector<std::shared_ptr<const int>> worldGraphTokens;
+
   /// \brief The SDF element pointer generated during load.
   public: sdf::ElementPtr sdf;
+
+  /// \brief Locations of the entities that have an ID, indexed by ID.
+  public: std::vector<EntityLocation> entities;
+
+  /// \brief Number of threads used to build the graphs of the models of a
+  /// world, from ParserConfig::GraphBuildThreadCount.
+  public: std::size_t graphBuildThreadCount = 0;
+
+  /// \brief Executor of the threads that build the graphs of the models of
+  /// a world, from ParserConfig::Executor.
+  public: std::shared_ptr<TaskExecutor> executor = TaskExecutor::Threaded();
+
+  /// \brief True to validate the graphs after building them. It is false
+  /// when documents are loaded with ValidationLevel::NONE.
+  public: bool validateGraphs = true;
+
+  /// \brief Paths of the assets resolved by ResolveAssets, by URI.
+  public: std::map<std::string, std::string> resolvedAssets;
 };
 
 /////////////////////////////////////////////////
 template <typename T>
 sdf::ScopedGraph<FrameAttachedToGraph> createFrameAttachedToGraph(
-    const T &_domObj, sdf::Errors &_errors)
+    const T &_domObj, sdf::Errors &_errors, std::size_t _threadCount = 0,
+    bool _validate = true, TaskExecutor *_executor = nullptr)
 {
   auto frameGraph = sdf::ScopedGraph<FrameAttachedToGraph>(
       std::make_shared<FrameAttachedToGraph>());
 
-  sdf::Errors buildErrors =
-      sdf::buildFrameAttachedToGraph(frameGraph, &_domObj);
+  sdf::Errors buildErrors;
+  {
+    ScopedLoadPhase phase(LoadPhase::GRAPH_BUILD);
+    if constexpr (std::is_same_v<T, sdf::World>)
+    {
+      buildErrors = sdf::buildFrameAttachedToGraph(
+          frameGraph, &_domObj, _threadCount, _executor);
+    }
+    else
+    {
+      buildErrors = sdf::buildFrameAttachedToGraph(frameGraph, &_domObj);
+    }
+    frameGraph.Freeze();
+  }
   _errors.insert(_errors.end(), buildErrors.begin(), buildErrors.end());
 
-  sdf::Errors validateErrors = sdf::validateFrameAttachedToGraph(frameGraph);
-  _errors.insert(_errors.end(), validateErrors.begin(), validateErrors.end());
+  if (_validate)
+  {
+    ScopedLoadPhase phase(LoadPhase::VALIDATION);
+    sdf::Errors validateErrors = sdf::validateFrameAttachedToGraph(frameGraph);
+    _errors.insert(_errors.end(), validateErrors.begin(), validateErrors.end());
+  }
 
   return frameGraph;
 }
@@ -97,9 +286,11 @@ sdf::ScopedGraph<FrameAttachedToGraph> createFrameAttachedToGraph(
 template <typename T>
 sdf::ScopedGraph<FrameAttachedToGraph> addFrameAttachedToGraph(
     std::vector<sdf::ScopedGraph<sdf::FrameAttachedToGraph>> &_graphList,
-    const T &_domObj, sdf::Errors &_errors)
+    const T &_domObj, sdf::Errors &_errors, std::size_t _threadCount = 0,
+    bool _validate = true, TaskExecutor *_executor = nullptr)
 {
-  auto frameGraph = createFrameAttachedToGraph(_domObj, _errors);
+  auto frameGraph = createFrameAttachedToGraph(
+      _domObj, _errors, _threadCount, _validate, _executor);
   _graphList.push_back(frameGraph);
 
   return frameGraph;
@@ -108,16 +299,34 @@ sdf::ScopedGraph<FrameAttachedToGraph> addFrameAttachedToGraph(
 /////////////////////////////////////////////////
 template <typename T>
 ScopedGraph<PoseRelativeToGraph> createPoseRelativeToGraph(
-    const T &_domObj, Errors &_errors)
+    const T &_domObj, Errors &_errors, std::size_t _threadCount = 0,
+    bool _validate = true, TaskExecutor *_executor = nullptr)
 {
   auto poseGraph = ScopedGraph<PoseRelativeToGraph>(
       std::make_shared<sdf::PoseRelativeToGraph>());
 
-  Errors buildErrors = buildPoseRelativeToGraph(poseGraph, &_domObj);
+  Errors buildErrors;
+  {
+    ScopedLoadPhase phase(LoadPhase::GRAPH_BUILD);
+    if constexpr (std::is_same_v<T, sdf::World>)
+    {
+      buildErrors = buildPoseRelativeToGraph(
+          poseGraph, &_domObj, _threadCount, _executor);
+    }
+    else
+    {
+      buildErrors = buildPoseRelativeToGraph(poseGraph, &_domObj);
+    }
+    poseGraph.Freeze();
+  }
   _errors.insert(_errors.end(), buildErrors.begin(), buildErrors.end());
 
-  Errors validateErrors = validatePoseRelativeToGraph(poseGraph);
-  _errors.insert(_errors.end(), validateErrors.begin(), validateErrors.end());
+  if (_validate)
+  {
+    ScopedLoadPhase phase(LoadPhase::VALIDATION);
+    Errors validateErrors = validatePoseRelativeToGraph(poseGraph);
+    _errors.insert(_errors.end(), validateErrors.begin(), validateErrors.end());
+  }
 
   return poseGraph;
 }
@@ -126,9 +335,11 @@ ScopedGraph<PoseRelativeToGraph> createPoseRelativeToGraph(
 template <typename T>
 ScopedGraph<PoseRelativeToGraph> addPoseRelativeToGraph(
     std::vector<sdf::ScopedGraph<sdf::PoseRelativeToGraph>> &_graphList,
-    const T &_domObj, Errors &_errors)
+    const T &_domObj, Errors &_errors, std::size_t _threadCount = 0,
+    bool _validate = true, TaskExecutor *_executor = nullptr)
 {
-  auto poseGraph = createPoseRelativeToGraph(_domObj, _errors);
+  auto poseGraph = createPoseRelativeToGraph(
+      _domObj, _errors, _threadCount, _validate, _executor);
   _graphList.push_back(poseGraph);
 
   return poseGraph;
@@ -162,6 +373,46 @@ Errors Root::Load(const std::string &_filename, const ParserConfig &_config)
     return errors;
   }
 
+  // The DOM is not loaded once the errors reach the limit of _config.
+  if (maxErrorsReached(_config, errors))
+    return errors;
+
+  Errors loadErrors = this->Load(sdfParsed, _config);
+  errors.insert(errors.end(), loadErrors.begin(), loadErrors.end());
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+Errors Root::LoadCached(const std::string &_filename,
+    const std::string &_cacheFile, const ParserConfig &_config)
+{
+  SDFPtr sdfParsed;
+  if (ElementCache::Read(_cacheFile, _filename, _config, sdfParsed))
+    return this->Load(sdfParsed, _config);
+
+  Errors errors;
+  sdfParsed = readFile(_filename, _config, errors);
+  if (!sdfParsed)
+  {
+    errors.push_back(
+        {ErrorCode::FILE_READ, "Unable to read file:" + _filename});
+    return errors;
+  }
+
+  // Only files read without errors are cached, so that loading from the
+  // cache reports the same errors as loading the file. The cache is written
+  // before Load() since it may add elements that are not in the file.
+  if (errors.empty() &&
+      !ElementCache::Write(_cacheFile, _filename, _config, sdfParsed))
+  {
+    sdfdbg << "Unable to write cache file [" << _cacheFile << "] for ["
+           << _filename << "].\n";
+  }
+
+  if (maxErrorsReached(_config, errors))
+    return errors;
+
   Errors loadErrors = this->Load(sdfParsed, _config);
   errors.insert(errors.end(), loadErrors.begin(), loadErrors.end());
 
@@ -176,25 +427,64 @@ Errors Root::LoadSdfString(const std::string &_sdf)
 
 /////////////////////////////////////////////////
 Errors Root::LoadSdfString(const std::string &_sdf, const ParserConfig &_config)
+{
+  return this->LoadSdfString(_sdf.data(), _sdf.size(), _config);
+}
+
+/////////////////////////////////////////////////
+Errors Root::LoadSdfString(const char *_data, std::size_t _size,
+                           const ParserConfig &_config)
 {
   Errors errors;
   SDFPtr sdfParsed(new SDF());
   init(sdfParsed, _config);
 
   // Read an SDF string, and store the result in sdfParsed.
-  if (!readString(_sdf, _config, sdfParsed, errors))
+  if (!readString(_data, _size, _config, sdfParsed, errors))
   {
-    errors.push_back(
-        {ErrorCode::STRING_READ, "Unable to read SDF string: " + _sdf});
+    errors.push_back({ErrorCode::STRING_READ,
+        "Unable to read SDF string: " + std::string(_data, _size)});
     return errors;
   }
 
+  if (maxErrorsReached(_config, errors))
+    return errors;
+
   Errors loadErrors = this->Load(sdfParsed, _config);
   errors.insert(errors.end(), loadErrors.begin(), loadErrors.end());
 
   return errors;
 }
 
+/////////////////////////////////////////////////
+std::vector<Errors> Root::LoadSdfStrings(
+    const std::vector<std::string_view> &_sdfs, std::vector<Root> &_roots,
+    const ParserConfig &_config)
+{
+  // A copy of the configuration that reuses XML documents keeps one pool of
+  // documents for the whole batch.
+  ParserConfig config = _config;
+  if (!config.ReuseXmlDocuments())
+    config.SetReuseXmlDocuments(true);
+
+  std::vector<Errors> errors(_sdfs.size());
+  _roots.clear();
+  _roots.resize(_sdfs.size());
+  for (std::size_t i = 0; i < _sdfs.size(); ++i)
+  {
+    errors[i] = _roots[i].LoadSdfString(_sdfs[i].data(), _sdfs[i].size(),
+                                        config);
+  }
+  return errors;
+}
+
+/////////////////////////////////////////////////
+LoadTask Root::LoadAsync(const std::string &_filename,
+    const ParserConfig &_config, LoadTask::ProgressCallback _callback)
+{
+  return LoadTask(_filename, _config, std::move(_callback));
+}
+
 /////////////////////////////////////////////////
 Errors Root::Load(SDFPtr _sdf)
 {
@@ -204,13 +494,21 @@ Errors Root::Load(SDFPtr _sdf)
 /////////////////////////////////////////////////
 Errors Root::Load(SDFPtr _sdf, const ParserConfig &_config)
 {
+  ScopedTraceEvent event(_config, "Root::Load", "dom");
+  ScopedLoadPhase phase(_config, LoadPhase::DOM_LOAD);
+  ScopedElementRelease release(_config.ReleaseElements());
   Errors errors;
 
-  this->dataPtr->sdf = _sdf->Root();
+  const ElementPtr root = _sdf->Root();
+  this->dataPtr->sdf = retainedElement(root);
+  this->dataPtr->graphBuildThreadCount = _config.GraphBuildThreadCount();
+  this->dataPtr->executor = _config.Executor();
+  this->dataPtr->validateGraphs =
+      _config.GetValidationLevel() != ValidationLevel::NONE;
 
   // Get the SDF version.
   std::pair<std::string, bool> versionPair =
-    this->dataPtr->sdf->Get<std::string>("version", this->dataPtr->version);
+    root->Get<std::string>("version", this->dataPtr->version);
 
   // Check that the version exists. Exit if the version is missing.
   // readFile will fail if the version is missing, so this
@@ -235,46 +533,105 @@ Errors Root::Load(SDFPtr _sdf, const ParserConfig &_config)
 
   this->dataPtr->version = versionPair.first;
 
-  // Read all the worlds
-  if (this->dataPtr->sdf->HasElement("world"))
+  // Read all the worlds. They are loaded concurrently if _config allows
+  // it, each one on its own, and added in document order.
+  std::vector<ElementPtr> worldElems;
+  for (ElementPtr elem = root->HasElement("world") ?
+           root->GetElement("world") : nullptr;
+       elem; elem = elem->GetNextElement("world"))
   {
-    ElementPtr elem = this->dataPtr->sdf->GetElement("world");
-    while (elem)
-    {
-      World world;
+    worldElems.push_back(elem);
+  }
 
-      Errors worldErrors = world.Load(elem, _config);
+  // The names of the worlds and models are checked in a single traversal
+  // of the document, instead of by each World::Load and Model::Load. The
+  // models of lazy worlds are checked when they are loaded.
+  ElementPtr checkedNames;
+  if (_config.GetValidationLevel() != ValidationLevel::NONE &&
+      !(_config.LazyWorldModels() && !worldElems.empty()))
+  {
+    ScopedLoadPhase validationPhase(_config, LoadPhase::VALIDATION);
+    recursiveCheckNames(root, false, false, false, true, std::cerr);
+    checkedNames = root;
+  }
+  ScopedCheckedNames namesChecked(checkedNames);
 
-      this->dataPtr->UpdateGraphs(world, worldErrors);
+  std::vector<World> worlds(worldElems.size());
+  ErrorSink worldErrors(worldElems.size(), _config.MaxErrors());
+  const bool releaseElements = _config.ReleaseElements();
+  auto loadWorld = [&](std::size_t _index)
+  {
+    if (!worldErrors.Skip(_index))
+    {
+      Errors &errs = worldErrors.TaskErrors(_index);
+      errs = worlds[_index].Load(worldElems[_index], _config);
+      if (!_config.LazyWorldModels())
+        this->dataPtr->UpdateGraphs(worlds[_index], errs);
+    }
+    worldErrors.Finish(_index);
+  };
 
-      // Attempt to load the world
-      if (worldErrors.empty())
+  std::size_t threadCount =
+      std::min(_config.WorldLoadThreadCount(), worldElems.size());
+  if (!_config.CustomModelParsers().empty() &&
+      !_config.CustomModelParsersThreadSafe())
+  {
+    threadCount = 1;
+  }
+  if (threadCount > 1)
+  {
+    std::atomic<std::size_t> nextWorld{0};
+    auto loadWorlds = [&](std::size_t)
+    {
+      ScopedTraceEvent workerEvent(_config, "Root::LoadWorlds", "dom");
+      ScopedLoadPhase workerPhase(_config, LoadPhase::DOM_LOAD);
+      ScopedElementRelease workerRelease(releaseElements);
+      ScopedCheckedNames workerNamesChecked(checkedNames);
+      for (std::size_t i = nextWorld++; i < worldElems.size();
+           i = nextWorld++)
       {
-        // Check that the world's name does not exist.
-        if (this->WorldNameExists(world.Name()))
-        {
-          errors.push_back({ErrorCode::DUPLICATE_NAME,
-                "World with name[" + world.Name() + "] already exists."
-                " Each world must have a unique name. Skipping this world."});
-        }
+        loadWorld(i);
       }
-      else
+    };
+
+    _config.Executor()->RunAndWait(threadCount, loadWorlds);
+  }
+  else
+  {
+    for (std::size_t i = 0; i < worldElems.size(); ++i)
+      loadWorld(i);
+  }
+
+  for (std::size_t i = 0; i < worlds.size() && worldErrors.Reported(i); ++i)
+  {
+    World &world = worlds[i];
+    Errors &errs = worldErrors.TaskErrors(i);
+
+    // Attempt to load the world
+    if (errs.empty())
+    {
+      // Check that the world's name does not exist.
+      if (this->WorldNameExists(world.Name()))
       {
-        std::move(worldErrors.begin(), worldErrors.end(),
-                  std::back_inserter(errors));
-        errors.push_back({ErrorCode::ELEMENT_INVALID,
-                          "Failed to load a world."});
+        errors.push_back({ErrorCode::DUPLICATE_NAME,
+              "World with name[" + world.Name() + "] already exists."
+              " Each world must have a unique name. Skipping this world."});
       }
-
-      this->dataPtr->worlds.push_back(std::move(world));
-      elem = elem->GetNextElement("world");
     }
+    else
+    {
+      std::move(errs.begin(), errs.end(), std::back_inserter(errors));
+      errors.push_back({ErrorCode::ELEMENT_INVALID,
+                        "Failed to load a world."});
+    }
+
+    this->dataPtr->worlds.push_back(std::move(world));
   }
 
   // Load all the models.
   std::vector<sdf::Model> models;
   Errors modelLoadErrors = loadUniqueRepeated<sdf::Model>(
-      this->dataPtr->sdf, "model", models, _config);
+      root, "model", models, _config);
   errors.insert(errors.end(), modelLoadErrors.begin(), modelLoadErrors.end());
   if (!models.empty())
   {
@@ -292,7 +649,7 @@ Errors Root::Load(SDFPtr _sdf, const ParserConfig &_config)
   // Load all the lights.
   std::vector<sdf::Light> lights;
   Errors lightLoadErrors =
-      loadUniqueRepeated<sdf::Light>(this->dataPtr->sdf, "light", lights);
+      loadUniqueRepeated<sdf::Light>(root, "light", lights);
   errors.insert(errors.end(), lightLoadErrors.begin(), lightLoadErrors.end());
   if (!lights.empty())
   {
@@ -319,7 +676,7 @@ Errors Root::Load(SDFPtr _sdf, const ParserConfig &_config)
   // Load all the actors.
   std::vector<sdf::Actor> actors;
   Errors actorLoadErrors =
-      loadUniqueRepeated<sdf::Actor>(this->dataPtr->sdf, "actor", actors);
+      loadUniqueRepeated<sdf::Actor>(root, "actor", actors);
   errors.insert(errors.end(), actorLoadErrors.begin(), actorLoadErrors.end());
   if (!actors.empty())
   {
@@ -343,9 +700,36 @@ Errors Root::Load(SDFPtr _sdf, const ParserConfig &_config)
     }
   }
 
+  // The models of lazy worlds are only loaded on first use, so the checks,
+  // sharing and entity IDs below that visit every model are left to
+  // Root::UpdateGraphs.
+  const bool lazyWorlds =
+      _config.LazyWorldModels() && !this->dataPtr->worlds.empty();
+
   // Check that Joint parent and child names resolve to valid and
-  // different frames.
-  checkJointParentChildNames(this, errors);
+  // different frames. Validation is skipped once the errors reach the limit
+  // of _config.
+  if (_config.GetValidationLevel() != ValidationLevel::NONE &&
+      !lazyWorlds && !maxErrorsReached(_config, errors))
+  {
+    ScopedLoadPhase validationPhase(_config, LoadPhase::VALIDATION);
+    checkJointParentChildNames(this, errors);
+  }
+
+  if (_config.ShareIdenticalObjects() && !lazyWorlds)
+  {
+    DomInterner interner;
+    for (World &world : this->dataPtr->worlds)
+      interner.Share(world);
+    if (sdf::Model *model = std::get_if<sdf::Model>(
+            &this->dataPtr->modelLightOrActor))
+    {
+      interner.Share(*model);
+    }
+  }
+
+  if (!lazyWorlds)
+    this->dataPtr->AssignEntityIds();
 
   return errors;
 }
@@ -455,12 +839,30 @@ sdf::Errors Root::AddWorld(const World &_world)
   return errors;
 }
 
+/////////////////////////////////////////////////
+sdf::Errors Root::AddWorld(World &&_world)
+{
+  if (!this->WorldNameExists(_world.Name()))
+  {
+    this->dataPtr->worlds.push_back(std::move(_world));
+    return this->UpdateGraphs();
+  }
+
+  sdf::Errors errors;
+  errors.push_back({ErrorCode::DUPLICATE_NAME,
+      "World with name[" + _world.Name() + "] already exists."});
+
+  return errors;
+}
+
 /////////////////////////////////////////////////
 void Root::ClearWorlds()
 {
   this->dataPtr->worlds.clear();
   this->dataPtr->worldFrameAttachedToGraphs.clear();
   this->dataPtr->worldPoseRelativeToGraphs.clear();
+  this->dataPtr->worldGraphTokens.clear();
+  this->dataPtr->AssignEntityIds();
 }
 
 /////////////////////////////////////////////////
@@ -470,7 +872,30 @@ sdf::Root Root::Clone() const
   r.dataPtr->version = this->dataPtr->version;
   r.dataPtr->worlds = this->dataPtr->worlds;
   r.dataPtr->modelLightOrActor = this->dataPtr->modelLightOrActor;
-  r.UpdateGraphs();
+  r.dataPtr->graphBuildThreadCount = this->dataPtr->graphBuildThreadCount;
+  r.dataPtr->executor = this->dataPtr->executor;
+  r.dataPtr->validateGraphs = this->dataPtr->validateGraphs;
+  r.dataPtr->resolvedAssets = this->dataPtr->resolvedAssets;
+
+  if (!this->dataPtr->GraphsBuilt())
+  {
+    r.UpdateGraphs();
+    return r;
+  }
+
+  // The copied DOM objects point to the graphs of this root, which are
+  // shared with the clone instead of being built again. They are copied
+  // before either root modifies them in place, see DetachGraphs.
+  r.dataPtr->worldFrameAttachedToGraphs =
+      this->dataPtr->worldFrameAttachedToGraphs;
+  r.dataPtr->worldPoseRelativeToGraphs =
+      this->dataPtr->worldPoseRelativeToGraphs;
+  r.dataPtr->worldGraphTokens = this->dataPtr->worldGraphTokens;
+  r.dataPtr->modelFrameAttachedToGraph =
+      this->dataPtr->modelFrameAttachedToGraph;
+  r.dataPtr->modelPoseRelativeToGraph =
+      this->dataPtr->modelPoseRelativeToGraph;
+  r.dataPtr->entities = this->dataPtr->entities;
   return r;
 }
 
@@ -481,6 +906,7 @@ Errors Root::UpdateGraphs()
 
   this->dataPtr->worldFrameAttachedToGraphs.clear();
   this->dataPtr->worldPoseRelativeToGraphs.clear();
+  this->dataPtr->worldGraphTokens.clear();
 
   // Build graphs for each world.
   for (World &world : this->dataPtr->worlds)
@@ -495,61 +921,1173 @@ Errors Root::UpdateGraphs()
     this->dataPtr->UpdateGraphs(model, errors);
   }
 
+  this->dataPtr->AssignEntityIds();
+
   return errors;
 }
 
-//////////////////////////////////////////////////
-void Root::Implementation::UpdateGraphs(sdf::World &_world,
-    sdf::Errors &_errors)
+/////////////////////////////////////////////////
+/// \brief Convert the values of the parameters of an element and of its
+/// descendants that were set lazily.
+/// \param[in] _elem The element.
+static void parseLazyValues(const ElementPtr &_elem)
 {
-  // Build the frame graph.
-  auto frameAttachedToGraph = addFrameAttachedToGraph(
-      this->worldFrameAttachedToGraphs, _world, _errors);
-  _world.SetFrameAttachedToGraph(frameAttachedToGraph);
-
-  // Build the pose graph.
-  auto poseRelativeToGraph = addPoseRelativeToGraph(
-      this->worldPoseRelativeToGraphs, _world, _errors);
-  _world.SetPoseRelativeToGraph(poseRelativeToGraph);
+  if (ParamPtr value = _elem->GetValue())
+    value->ParseLazyValue();
+  for (unsigned int i = 0; i < _elem->GetAttributeCount(); ++i)
+    _elem->GetAttribute(i)->ParseLazyValue();
+  for (ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    parseLazyValues(child);
+  }
 }
 
-//////////////////////////////////////////////////
-void Root::Implementation::UpdateGraphs(sdf::Model &_model,
-    sdf::Errors &_errors)
+/////////////////////////////////////////////////
+Errors Root::Freeze()
 {
-  this->modelFrameAttachedToGraph = createFrameAttachedToGraph(_model, _errors);
-  _model.SetFrameAttachedToGraph(this->modelFrameAttachedToGraph);
+  Errors errors;
 
-  this->modelPoseRelativeToGraph = createPoseRelativeToGraph(_model, _errors);
-  _model.SetPoseRelativeToGraph(this->modelPoseRelativeToGraph);
+  // Lazily loaded worlds have no graphs until they are built here.
+  for (std::size_t i = 0; i < this->dataPtr->worlds.size(); ++i)
+  {
+    if (!this->dataPtr->HasGraphs(i))
+    {
+      errors = this->UpdateGraphs();
+      break;
+    }
+  }
+
+  for (World &world : this->dataPtr->worlds)
+    world.Freeze();
+
+  if (this->dataPtr->modelFrameAttachedToGraph)
+    this->dataPtr->modelFrameAttachedToGraph.Seal();
+  if (this->dataPtr->modelPoseRelativeToGraph)
+  {
+    storeResolvedPoses(this->dataPtr->modelPoseRelativeToGraph);
+    if (const sdf::Model *model = this->Model())
+      model->StoreResolvedPoses();
+    this->dataPtr->modelPoseRelativeToGraph.Seal();
+  }
+
+  if (this->dataPtr->sdf)
+    parseLazyValues(this->dataPtr->sdf);
+
+  return errors;
 }
 
 /////////////////////////////////////////////////
-sdf::ElementPtr Root::ToElement(const ParserConfig &_config) const
+Errors Root::UpdateGraphs(const std::string &_worldName,
+                          const std::string &_modelName)
 {
-  sdf::ElementPtr elem(new sdf::Element);
-  sdf::initFile("root.sdf", _config, elem);
+  sdf::Errors errors;
 
-  elem->GetAttribute("version")->Set(this->Version());
+  const uint64_t worldIndex =
+      this->dataPtr->WorldIndexWithModel(_worldName, _modelName, errors);
+  if (kNoIndex == worldIndex)
+    return errors;
 
-  if (this->Model() != nullptr)
+  // Build everything if the world was added without building its graphs.
+  if (!this->dataPtr->HasGraphs(worldIndex))
+    return this->UpdateGraphs();
+
+  this->dataPtr->DetachGraphs(worldIndex);
+  World &world = this->dataPtr->worlds[worldIndex];
+  auto &frameGraph = this->dataPtr->worldFrameAttachedToGraphs[worldIndex];
+  auto &poseGraph = this->dataPtr->worldPoseRelativeToGraphs[worldIndex];
+
+  // Remove the previous vertices of the model, if it was already in the
+  // graphs, unless other frames of the world refer to them.
+  if (!removeModelFromWorldGraph(frameGraph, _modelName) ||
+      !removeModelFromWorldGraph(poseGraph, _modelName))
   {
-    elem->InsertElement(this->Model()->ToElement(_config), true);
+    this->dataPtr->RebuildGraphs(worldIndex, errors);
+    this->dataPtr->AssignEntityIds();
+    return errors;
   }
-  else if (this->Light() != nullptr)
+
+  sdf::Model *model = world.ModelByName(_modelName);
+
+  // The rest of the world was validated when its graphs were built, so only
+  // the graphs of the model are validated, on their own. Errors in building
+  // them are reported below when the model is added to the world graphs.
+  auto modelFrameGraph = ScopedGraph<FrameAttachedToGraph>(
+      std::make_shared<FrameAttachedToGraph>());
+  if (buildFrameAttachedToGraph(modelFrameGraph, model).empty())
   {
-    elem->InsertElement(this->Light()->ToElement(), true);
+    Errors validateErrors = validateFrameAttachedToGraph(modelFrameGraph);
+    errors.insert(errors.end(), validateErrors.begin(), validateErrors.end());
   }
-  else if (this->Actor() != nullptr)
+  auto modelPoseGraph = ScopedGraph<PoseRelativeToGraph>(
+      std::make_shared<PoseRelativeToGraph>());
+  if (buildPoseRelativeToGraph(modelPoseGraph, model).empty())
   {
-    elem->InsertElement(this->Actor()->ToElement(), true);
+    Errors validateErrors = validatePoseRelativeToGraph(modelPoseGraph);
+    errors.insert(errors.end(), validateErrors.begin(), validateErrors.end());
+  }
+
+  Errors frameErrors = addModelToWorldGraph(frameGraph, &world, model);
+  errors.insert(errors.end(), frameErrors.begin(), frameErrors.end());
+  frameGraph.Freeze();
+  model->SetFrameAttachedToGraph(frameGraph);
+
+  Errors poseErrors = addModelToWorldGraph(poseGraph, &world, model);
+  errors.insert(errors.end(), poseErrors.begin(), poseErrors.end());
+  poseGraph.Freeze();
+  model->SetPoseRelativeToGraph(poseGraph);
+
+  this->dataPtr->AssignEntityIds();
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+Errors Root::RemoveModel(const std::string &_worldName,
+                         const std::string &_modelName)
+{
+  sdf::Errors errors;
+
+  const uint64_t worldIndex =
+      this->dataPtr->WorldIndexWithModel(_worldName, _modelName, errors);
+  if (kNoIndex == worldIndex)
+    return errors;
+
+  World &world = this->dataPtr->worlds[worldIndex];
+  if (!this->dataPtr->HasGraphs(worldIndex))
+  {
+    world.RemoveModelByName(_modelName);
+    return this->UpdateGraphs();
+  }
+
+  this->dataPtr->DetachGraphs(worldIndex);
+  auto &frameGraph = this->dataPtr->worldFrameAttachedToGraphs[worldIndex];
+  auto &poseGraph = this->dataPtr->worldPoseRelativeToGraphs[worldIndex];
+  const bool removed = removeModelFromWorldGraph(frameGraph, _modelName) &&
+                       removeModelFromWorldGraph(poseGraph, _modelName);
+
+  world.RemoveModelByName(_modelName);
+
+  // Rebuilding the graphs reports the frames that refer to the model.
+  if (removed)
+  {
+    frameGraph.Freeze();
+    poseGraph.Freeze();
   }
   else
   {
-    // Worlds
-    for (const sdf::World &world : this->dataPtr->worlds)
-      elem->InsertElement(world.ToElement(_config), true);
+    this->dataPtr->RebuildGraphs(worldIndex, errors);
   }
 
-  return elem;
+  this->dataPtr->AssignEntityIds();
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a path in a form that can be compared with other paths.
+/// \param[in] _path A path.
+/// \return The absolute path, without "." or ".." components.
+static std::string comparablePath(const std::string &_path)
+{
+  return filesystem::weakly_canonical(_path);
+}
+
+/////////////////////////////////////////////////
+/// \brief Collect the files that a model element and its nested models were
+/// read from through an <include>.
+/// \param[in] _elem Element of a model.
+/// \param[in,out] _files The paths of the files.
+static void collectIncludedFiles(const ElementPtr &_elem,
+    std::set<std::string> &_files)
+{
+  if (_elem->GetIncludeElement() && !_elem->FilePath().empty())
+    _files.insert(comparablePath(_elem->FilePath()));
+
+  for (const ElementPtr &child : _elem->Children("model"))
+  {
+    collectIncludedFiles(child, _files);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the outermost elements of a model element and its nested
+/// models that were read from a file through an <include>.
+/// \param[in] _elem Element of a model.
+/// \param[in] _file Comparable path of the file, see comparablePath.
+/// \param[in,out] _found The elements that were read from the file.
+static void findIncludedElements(const ElementPtr &_elem,
+    const std::string &_file, std::vector<ElementPtr> &_found)
+{
+  if (_elem->GetIncludeElement() && comparablePath(_elem->FilePath()) == _file)
+  {
+    _found.push_back(_elem);
+    return;
+  }
+
+  for (const ElementPtr &child : _elem->Children("model"))
+  {
+    findIncludedElements(child, _file, _found);
+  }
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> Root::IncludedFiles() const
+{
+  std::set<std::string> files;
+  for (const World &world : this->dataPtr->worlds)
+  {
+    for (uint64_t i = 0; i < world.ModelCount(); ++i)
+    {
+      if (ElementPtr elem = world.ModelByIndex(i)->Element())
+        collectIncludedFiles(elem, files);
+    }
+  }
+  return {files.begin(), files.end()};
+}
+
+/////////////////////////////////////////////////
+std::map<std::string, std::uint64_t> Root::ModelContentHashes(
+    const std::string &_worldName) const
+{
+  std::map<std::string, std::uint64_t> hashes;
+  for (const World &world : this->dataPtr->worlds)
+  {
+    if (world.Name() != _worldName)
+      continue;
+
+    for (uint64_t i = 0; i < world.ModelCount(); ++i)
+    {
+      const sdf::Model *model = world.ModelByIndex(i);
+      ElementPtr elem = model->Element();
+      if (!elem)
+        elem = model->ToElement();
+      hashes[model->Name()] = elem->ContentHash();
+    }
+    break;
+  }
+  return hashes;
+}
+
+/////////////////////////////////////////////////
+Errors Root::ReloadIncludedFile(const std::string &_filename,
+                                const ParserConfig &_config)
+{
+  Errors errors;
+  const std::string file = comparablePath(_filename);
+
+  for (World &world : this->dataPtr->worlds)
+  {
+    // Find the models first, since loading them again may reorder them.
+    std::vector<std::string> modelNames;
+    for (uint64_t i = 0; i < world.ModelCount(); ++i)
+    {
+      ElementPtr elem = world.ModelByIndex(i)->Element();
+      std::vector<ElementPtr> found;
+      if (elem)
+        findIncludedElements(elem, file, found);
+      if (!found.empty())
+        modelNames.push_back(world.ModelByIndex(i)->Name());
+    }
+
+    for (const std::string &modelName : modelNames)
+    {
+      ElementPtr modelElem = world.ModelByName(modelName)->Element();
+      std::vector<ElementPtr> found;
+      findIncludedElements(modelElem, file, found);
+
+      // Read the changed file again for each of its includes, and splice
+      // the new elements into the elements of the model.
+      bool spliced = false;
+      for (const ElementPtr &elem : found)
+      {
+        ElementPtr parent = elem->GetParent();
+        ElementPtr reloaded = readIncludeElement(elem->GetIncludeElement(),
+            parent, _config, parent->FilePath(), errors);
+        if (!reloaded)
+          continue;
+
+        parent->ReplaceChild(elem, reloaded);
+        if (elem == modelElem)
+          modelElem = reloaded;
+        spliced = true;
+      }
+      if (!spliced)
+        continue;
+
+      // The other files of the model are not read again: the model is
+      // loaded from its elements, and only its graphs are rebuilt.
+      sdf::Model model;
+      Errors loadErrors = model.Load(modelElem, _config);
+      errors.insert(errors.end(), loadErrors.begin(), loadErrors.end());
+
+      const std::string reloadedName = model.Name();
+      if (reloadedName == modelName)
+      {
+        *world.ModelByName(modelName) = std::move(model);
+      }
+      else if (world.ModelNameExists(reloadedName))
+      {
+        errors.push_back({ErrorCode::DUPLICATE_NAME,
+            "Model [" + modelName + "] was renamed to [" + reloadedName +
+            "] when file [" + _filename + "] was read again, but world [" +
+            world.Name() + "] already has a model with that name."});
+        continue;
+      }
+      else
+      {
+        Errors removeErrors = this->RemoveModel(world.Name(), modelName);
+        errors.insert(errors.end(), removeErrors.begin(), removeErrors.end());
+        world.AddModel(std::move(model));
+      }
+
+      Errors graphErrors = this->UpdateGraphs(world.Name(), reloadedName);
+      errors.insert(errors.end(), graphErrors.begin(), graphErrors.end());
+    }
+  }
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+uint64_t Root::EntityCount() const
+{
+  return this->dataPtr->entities.size();
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+const T *Root::EntityById(const uint64_t _id) const
+{
+  return this->dataPtr->EntityById<T>(_id);
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+T *Root::EntityById(const uint64_t _id)
+{
+  return const_cast<T*>(
+      static_cast<const Root*>(this)->EntityById<T>(_id));
+}
+
+// Instantiate EntityById for every type of entity that has an ID.
+template const sdf::Model *Root::EntityById(const uint64_t) const;
+template const sdf::Link *Root::EntityById(const uint64_t) const;
+template const sdf::Joint *Root::EntityById(const uint64_t) const;
+template const sdf::Frame *Root::EntityById(const uint64_t) const;
+template const sdf::Collision *Root::EntityById(const uint64_t) const;
+template const sdf::Visual *Root::EntityById(const uint64_t) const;
+template const sdf::Sensor *Root::EntityById(const uint64_t) const;
+template sdf::Model *Root::EntityById(const uint64_t);
+template sdf::Link *Root::EntityById(const uint64_t);
+template sdf::Joint *Root::EntityById(const uint64_t);
+template sdf::Frame *Root::EntityById(const uint64_t);
+template sdf::Collision *Root::EntityById(const uint64_t);
+template sdf::Visual *Root::EntityById(const uint64_t);
+template sdf::Sensor *Root::EntityById(const uint64_t);
+
+//////////////////////////////////////////////////
+/// \brief Count a model and the entities it contains that have an ID.
+/// \param[in] _model The model.
+/// \return Number of entities, including _model.
+static uint64_t entityCountOf(const sdf::Model &_model)
+{
+  uint64_t count = 1 + _model.FrameCount();
+  for (uint64_t i = 0; i < _model.LinkCount(); ++i)
+  {
+    const sdf::Link *link = _model.LinkByIndex(i);
+    count += 1 + link->CollisionCount() + link->VisualCount() +
+        link->SensorCount();
+  }
+  for (uint64_t i = 0; i < _model.JointCount(); ++i)
+    count += 1 + _model.JointByIndex(i)->SensorCount();
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+    count += entityCountOf(*_model.ModelByIndex(i));
+  return count;
+}
+
+//////////////////////////////////////////////////
+Errors Root::ResolveAllPoses(std::vector<ignition::math::Pose3d> &_poses) const
+{
+  Errors errors;
+  _poses.clear();
+  _poses.reserve(this->dataPtr->entities.size());
+
+  // The entities of a model are numbered in the order of
+  // Model::ResolveAllPoses, so its poses are appended as they are, after
+  // being moved from the model frame to the world frame.
+  std::vector<ignition::math::Pose3d> modelPoses;
+  auto appendModel = [&](const sdf::Model &_model, bool _inWorld)
+  {
+    Errors modelErrors = _model.ResolveAllPoses(modelPoses);
+    ignition::math::Pose3d modelPose;
+    if (_inWorld)
+    {
+      Errors poseErrors = _model.ResolvePose(modelPose);
+      if (!poseErrors.empty())
+        modelPoses.clear();
+      modelErrors.insert(modelErrors.end(), poseErrors.begin(),
+                         poseErrors.end());
+    }
+    errors.insert(errors.end(), modelErrors.begin(), modelErrors.end());
+
+    // Models whose graphs are invalid have no resolved poses.
+    modelPoses.resize(entityCountOf(_model));
+    for (const auto &pose : modelPoses)
+      _poses.push_back(modelPose * pose);
+  };
+
+  for (const World &world : this->dataPtr->worlds)
+  {
+    for (uint64_t i = 0; i < world.ModelCount(); ++i)
+      appendModel(*world.ModelByIndex(i), true);
+    for (uint64_t i = 0; i < world.FrameCount(); ++i)
+    {
+      ignition::math::Pose3d pose;
+      Errors frameErrors = world.FrameByIndex(i)->ResolvePose(pose);
+      errors.insert(errors.end(), frameErrors.begin(), frameErrors.end());
+      _poses.push_back(frameErrors.empty() ?
+          pose : ignition::math::Pose3d::Zero);
+    }
+  }
+
+  if (const sdf::Model *model = this->Model())
+    appendModel(*model, false);
+
+  if (_poses.size() != this->dataPtr->entities.size())
+  {
+    errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Entities were added or removed since IDs were assigned. Call "
+        "Root::UpdateGraphs to assign IDs again."});
+    _poses.resize(this->dataPtr->entities.size());
+  }
+  return errors;
+}
+
+//////////////////////////////////////////////////
+/// \brief Set the raw pose of an entity, and queue the copy of the pose into
+/// the entity's element.
+/// \param[in, out] _entity The entity, or nullptr.
+/// \param[in] _pose The new raw pose, which must outlive _table.
+/// \param[in, out] _table Table the <pose> parameter is bound to.
+template <typename T>
+static void setRawPose(T *_entity, const ignition::math::Pose3d &_pose,
+    sdf::ParamUpdateTable &_table)
+{
+  if (!_entity)
+    return;
+
+  // Pose3d::operator== has a tolerance, so small motions are compared
+  // exactly to not be lost.
+  const ignition::math::Pose3d &current = _entity->RawPose();
+  if (current.Pos().X() == _pose.Pos().X() &&
+      current.Pos().Y() == _pose.Pos().Y() &&
+      current.Pos().Z() == _pose.Pos().Z() &&
+      current.Rot().W() == _pose.Rot().W() &&
+      current.Rot().X() == _pose.Rot().X() &&
+      current.Rot().Y() == _pose.Rot().Y() &&
+      current.Rot().Z() == _pose.Rot().Z())
+  {
+    return;
+  }
+  _entity->SetRawPose(_pose);
+
+  if (sdf::ElementPtr elem = _entity->Element())
+  {
+    sdf::ElementPtr poseElem = elem->GetElement("pose");
+    if (!_table.Add(poseElem, "", &_pose))
+      poseElem->Set<ignition::math::Pose3d>(_pose);
+  }
+}
+
+//////////////////////////////////////////////////
+Errors Root::SetRawPoses(const std::vector<ignition::math::Pose3d> &_poses)
+{
+  Errors errors;
+  if (_poses.size() != this->dataPtr->entities.size())
+  {
+    errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Expected " + std::to_string(this->dataPtr->entities.size()) +
+        " poses, one per entity ID, but got " +
+        std::to_string(_poses.size()) + "."});
+    return errors;
+  }
+
+  ParamUpdateTable table;
+  for (uint64_t id = 0; id < _poses.size(); ++id)
+  {
+    switch (this->dataPtr->entities[id].type)
+    {
+      case EntityType::MODEL:
+        setRawPose(this->EntityById<sdf::Model>(id), _poses[id], table);
+        break;
+      case EntityType::LINK:
+        setRawPose(this->EntityById<sdf::Link>(id), _poses[id], table);
+        break;
+      case EntityType::JOINT:
+        setRawPose(this->EntityById<sdf::Joint>(id), _poses[id], table);
+        break;
+      case EntityType::FRAME:
+        setRawPose(this->EntityById<sdf::Frame>(id), _poses[id], table);
+        break;
+      case EntityType::COLLISION:
+        setRawPose(this->EntityById<sdf::Collision>(id), _poses[id], table);
+        break;
+      case EntityType::VISUAL:
+        setRawPose(this->EntityById<sdf::Visual>(id), _poses[id], table);
+        break;
+      case EntityType::SENSOR:
+        setRawPose(this->EntityById<sdf::Sensor>(id), _poses[id], table);
+        break;
+    }
+  }
+  table.Update();
+  return errors;
+}
+
+//////////////////////////////////////////////////
+void Root::Implementation::UpdateGraphs(sdf::World &_world,
+    sdf::Errors &_errors)
+{
+  // Build the frame graph.
+  auto frameAttachedToGraph = addFrameAttachedToGraph(
+      this->worldFrameAttachedToGraphs, _world, _errors,
+      this->graphBuildThreadCount, this->validateGraphs, this->executor.get());
+  _world.SetFrameAttachedToGraph(frameAttachedToGraph);
+
+  // Build the pose graph.
+  auto poseRelativeToGraph = addPoseRelativeToGraph(
+      this->worldPoseRelativeToGraphs, _world, _errors,
+      this->graphBuildThreadCount, this->validateGraphs, this->executor.get());
+  _world.SetPoseRelativeToGraph(poseRelativeToGraph);
+
+  this->worldGraphTokens.push_back(std::make_shared<const int>(0));
+}
+
+//////////////////////////////////////////////////
+void Root::Implementation::UpdateGraphs(sdf::Model &_model,
+    sdf::Errors &_errors)
+{
+  this->modelFrameAttachedToGraph = createFrameAttachedToGraph(
+      _model, _errors, 0, this->validateGraphs);
+  _model.SetFrameAttachedToGraph(this->modelFrameAttachedToGraph);
+
+  this->modelPoseRelativeToGraph = createPoseRelativeToGraph(
+      _model, _errors, 0, this->validateGraphs);
+  _model.SetPoseRelativeToGraph(this->modelPoseRelativeToGraph);
+}
+
+//////////////////////////////////////////////////
+void Root::Implementation::RebuildGraphs(uint64_t _worldIndex,
+    sdf::Errors &_errors)
+{
+  World &world = this->worlds[_worldIndex];
+
+  this->worldFrameAttachedToGraphs[_worldIndex] =
+      createFrameAttachedToGraph(world, _errors, this->graphBuildThreadCount,
+          this->validateGraphs, this->executor.get());
+  world.SetFrameAttachedToGraph(
+      this->worldFrameAttachedToGraphs[_worldIndex]);
+
+  this->worldPoseRelativeToGraphs[_worldIndex] =
+      createPoseRelativeToGraph(world, _errors, this->graphBuildThreadCount,
+          this->validateGraphs, this->executor.get());
+  world.SetPoseRelativeToGraph(this->worldPoseRelativeToGraphs[_worldIndex]);
+
+  this->worldGraphTokens[_worldIndex] = std::make_shared<const int>(0);
+}
+
+//////////////////////////////////////////////////
+uint64_t Root::Implementation::WorldIndexWithModel(
+    const std::string &_worldName, const std::string &_modelName,
+    sdf::Errors &_errors) const
+{
+  for (uint64_t w = 0; w < this->worlds.size(); ++w)
+  {
+    const World &world = this->worlds[w];
+    if (world.Name() != _worldName)
+      continue;
+
+    for (uint64_t i = 0; i < world.ModelCount(); ++i)
+    {
+      if (world.ModelByIndex(i)->Name() == _modelName)
+        return w;
+    }
+
+    _errors.push_back({ErrorCode::ELEMENT_MISSING,
+        "Model with name[" + _modelName + "] not found in world with name[" +
+        _worldName + "]."});
+    return kNoIndex;
+  }
+
+  _errors.push_back({ErrorCode::ELEMENT_MISSING,
+      "World with name[" + _worldName + "] not found."});
+  return kNoIndex;
+}
+
+//////////////////////////////////////////////////
+bool Root::Implementation::HasGraphs(uint64_t _worldIndex) const
+{
+  return _worldIndex < this->worldFrameAttachedToGraphs.size() &&
+         _worldIndex < this->worldPoseRelativeToGraphs.size();
+}
+
+//////////////////////////////////////////////////
+void Root::Implementation::DetachGraphs(uint64_t _worldIndex)
+{
+  if (this->worldGraphTokens[_worldIndex].use_count() <= 1)
+    return;
+
+  World &world = this->worlds[_worldIndex];
+
+  this->worldFrameAttachedToGraphs[_worldIndex] =
+      this->worldFrameAttachedToGraphs[_worldIndex].CopyGraph();
+  world.SetFrameAttachedToGraph(
+      this->worldFrameAttachedToGraphs[_worldIndex]);
+
+  this->worldPoseRelativeToGraphs[_worldIndex] =
+      this->worldPoseRelativeToGraphs[_worldIndex].CopyGraph();
+  world.SetPoseRelativeToGraph(this->worldPoseRelativeToGraphs[_worldIndex]);
+
+  this->worldGraphTokens[_worldIndex] = std::make_shared<const int>(0);
+}
+
+//////////////////////////////////////////////////
+bool Root::Implementation::GraphsBuilt() const
+{
+  if (this->worldFrameAttachedToGraphs.size() != this->worlds.size() ||
+      this->worldPoseRelativeToGraphs.size() != this->worlds.size() ||
+      this->worldGraphTokens.size() != this->worlds.size())
+  {
+    return false;
+  }
+
+  if (std::holds_alternative<sdf::Model>(this->modelLightOrActor))
+  {
+    return this->modelFrameAttachedToGraph &&
+           this->modelPoseRelativeToGraph;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Root::Implementation::AssignEntityIds()
+{
+  this->entities.clear();
+
+  for (uint64_t w = 0; w < this->worlds.size(); ++w)
+  {
+    const World &world = this->worlds[w];
+    for (uint64_t i = 0; i < world.ModelCount(); ++i)
+      this->AssignEntityIds(*world.ModelByIndex(i), kNoIndex, w, i);
+    for (uint64_t i = 0; i < world.FrameCount(); ++i)
+      this->entities.push_back({EntityType::FRAME, kNoIndex, w, i});
+  }
+
+  if (const sdf::Model *model = std::get_if<sdf::Model>(
+          &this->modelLightOrActor))
+  {
+    this->AssignEntityIds(*model, kNoIndex, kNoIndex, 0);
+  }
+}
+
+//////////////////////////////////////////////////
+void Root::Implementation::AssignEntityIds(const sdf::Model &_model,
+    uint64_t _parent, uint64_t _world, uint64_t _index)
+{
+  const uint64_t modelId = this->entities.size();
+  this->entities.push_back({EntityType::MODEL, _parent, _world, _index});
+
+  for (uint64_t i = 0; i < _model.LinkCount(); ++i)
+  {
+    const sdf::Link *link = _model.LinkByIndex(i);
+    const uint64_t linkId = this->entities.size();
+    this->entities.push_back({EntityType::LINK, modelId, _world, i});
+    for (uint64_t j = 0; j < link->CollisionCount(); ++j)
+      this->entities.push_back({EntityType::COLLISION, linkId, _world, j});
+    for (uint64_t j = 0; j < link->VisualCount(); ++j)
+      this->entities.push_back({EntityType::VISUAL, linkId, _world, j});
+    for (uint64_t j = 0; j < link->SensorCount(); ++j)
+      this->entities.push_back({EntityType::SENSOR, linkId, _world, j});
+  }
+
+  for (uint64_t i = 0; i < _model.JointCount(); ++i)
+  {
+    const sdf::Joint *joint = _model.JointByIndex(i);
+    const uint64_t jointId = this->entities.size();
+    this->entities.push_back({EntityType::JOINT, modelId, _world, i});
+    for (uint64_t j = 0; j < joint->SensorCount(); ++j)
+      this->entities.push_back({EntityType::SENSOR, jointId, _world, j});
+  }
+
+  for (uint64_t i = 0; i < _model.FrameCount(); ++i)
+    this->entities.push_back({EntityType::FRAME, modelId, _world, i});
+
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+    this->AssignEntityIds(*_model.ModelByIndex(i), modelId, _world, i);
+}
+
+//////////////////////////////////////////////////
+template <typename T>
+const T *Root::Implementation::EntityById(uint64_t _id) const
+{
+  if (_id >= this->entities.size() ||
+      this->entities[_id].type != entityTypeOf<T>())
+  {
+    return nullptr;
+  }
+
+  const EntityLocation &location = this->entities[_id];
+  if constexpr (std::is_same_v<T, sdf::Model>)
+  {
+    if (location.parent != kNoIndex)
+    {
+      const sdf::Model *parent = this->EntityById<sdf::Model>(location.parent);
+      return parent ? parent->ModelByIndex(location.index) : nullptr;
+    }
+    if (location.world != kNoIndex)
+    {
+      return location.world < this->worlds.size() ?
+          this->worlds[location.world].ModelByIndex(location.index) : nullptr;
+    }
+    return std::get_if<sdf::Model>(&this->modelLightOrActor);
+  }
+  else if constexpr (std::is_same_v<T, sdf::Frame>)
+  {
+    if (location.parent != kNoIndex)
+    {
+      const sdf::Model *parent = this->EntityById<sdf::Model>(location.parent);
+      return parent ? parent->FrameByIndex(location.index) : nullptr;
+    }
+    return location.world < this->worlds.size() ?
+        this->worlds[location.world].FrameByIndex(location.index) : nullptr;
+  }
+  else if constexpr (std::is_same_v<T, sdf::Link>)
+  {
+    const sdf::Model *parent = this->EntityById<sdf::Model>(location.parent);
+    return parent ? parent->LinkByIndex(location.index) : nullptr;
+  }
+  else if constexpr (std::is_same_v<T, sdf::Joint>)
+  {
+    const sdf::Model *parent = this->EntityById<sdf::Model>(location.parent);
+    return parent ? parent->JointByIndex(location.index) : nullptr;
+  }
+  else if constexpr (std::is_same_v<T, sdf::Collision>)
+  {
+    const sdf::Link *parent = this->EntityById<sdf::Link>(location.parent);
+    return parent ? parent->CollisionByIndex(location.index) : nullptr;
+  }
+  else if constexpr (std::is_same_v<T, sdf::Visual>)
+  {
+    const sdf::Link *parent = this->EntityById<sdf::Link>(location.parent);
+    return parent ? parent->VisualByIndex(location.index) : nullptr;
+  }
+  else
+  {
+    // Sensors are contained in links or joints.
+    if (const sdf::Link *link = this->EntityById<sdf::Link>(location.parent))
+      return link->SensorByIndex(location.index);
+    if (const sdf::Joint *joint =
+            this->EntityById<sdf::Joint>(location.parent))
+    {
+      return joint->SensorByIndex(location.index);
+    }
+    return nullptr;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the key of an asset in the table of resolved assets.
+/// \param[in] _uri URI of the asset.
+/// \param[in] _filePath Path of the file the URI is written in.
+/// \return The URI, joined to the directory of _filePath if it is a
+/// relative path.
+static std::string assetKey(const std::string &_uri,
+                            const std::string &_filePath)
+{
+  if (_uri.empty() || _filePath.empty() ||
+      _uri.find("://") != std::string::npos ||
+      filesystem::is_absolute(_uri))
+  {
+    return _uri;
+  }
+  const std::string dir = filesystem::parent_path(_filePath);
+  return dir.empty() ? _uri : filesystem::append(dir, _uri);
+}
+
+/////////////////////////////////////////////////
+/// \brief Function called for each asset referenced by the DOM, with the
+/// type of the asset, its URI and the path of the file the URI is written
+/// in. Empty URIs are not reported.
+using AssetCallback = std::function<void(AssetType, const std::string &,
+                                         const std::string &)>;
+
+/////////////////////////////////////////////////
+/// \brief Report an asset if its URI is not empty.
+/// \param[in] _type Type of the asset.
+/// \param[in] _uri URI of the asset.
+/// \param[in] _filePath Path of the file the URI is written in.
+/// \param[in] _callback Function to call.
+static void visitAsset(AssetType _type, const std::string &_uri,
+                       const std::string &_filePath,
+                       const AssetCallback &_callback)
+{
+  if (!_uri.empty())
+    _callback(_type, _uri, _filePath);
+}
+
+/////////////////////////////////////////////////
+/// \brief Visit the textures and scripts of a material.
+/// \param[in] _material The material, which may be nullptr.
+/// \param[in] _callback Function called for each asset.
+static void visitAssets(const sdf::Material *_material,
+                        const AssetCallback &_callback)
+{
+  if (!_material)
+    return;
+
+  const std::string &filePath = _material->FilePath();
+  visitAsset(AssetType::MATERIAL_SCRIPT, _material->ScriptUri(), filePath,
+      _callback);
+  visitAsset(AssetType::TEXTURE, _material->NormalMap(), filePath,
+      _callback);
+  if (const sdf::Pbr *pbr = _material->PbrMaterial())
+  {
+    for (const auto type : {PbrWorkflowType::METAL, PbrWorkflowType::SPECULAR})
+    {
+      const sdf::PbrWorkflow *workflow = pbr->Workflow(type);
+      if (!workflow)
+        continue;
+      for (const std::string &texture : {workflow->AlbedoMap(),
+           workflow->NormalMap(), workflow->EnvironmentMap(),
+           workflow->AmbientOcclusionMap(), workflow->RoughnessMap(),
+           workflow->MetalnessMap(), workflow->EmissiveMap(),
+           workflow->LightMap(), workflow->GlossinessMap(),
+           workflow->SpecularMap()})
+      {
+        visitAsset(AssetType::TEXTURE, texture, filePath, _callback);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Visit the mesh or the heightmap and textures of a geometry.
+/// \param[in] _geometry The geometry, which may be nullptr.
+/// \param[in] _callback Function called for each asset.
+static void visitAssets(const sdf::Geometry *_geometry,
+                        const AssetCallback &_callback)
+{
+  if (!_geometry)
+    return;
+
+  if (const sdf::Mesh *mesh = _geometry->MeshShape())
+    visitAsset(AssetType::MESH, mesh->Uri(), mesh->FilePath(), _callback);
+
+  if (const sdf::Heightmap *heightmap = _geometry->HeightmapShape())
+  {
+    const std::string &filePath = heightmap->FilePath();
+    visitAsset(AssetType::HEIGHTMAP, heightmap->Uri(), filePath, _callback);
+    for (uint64_t i = 0; i < heightmap->TextureCount(); ++i)
+    {
+      const sdf::HeightmapTexture *texture = heightmap->TextureByIndex(i);
+      visitAsset(AssetType::TEXTURE, texture->Diffuse(), filePath,
+          _callback);
+      visitAsset(AssetType::TEXTURE, texture->Normal(), filePath, _callback);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Visit the libraries of plugins.
+/// \param[in] _plugins The plugins.
+/// \param[in] _callback Function called for each asset.
+static void visitAssets(const sdf::Plugins &_plugins,
+                        const AssetCallback &_callback)
+{
+  for (const sdf::Plugin &plugin : _plugins)
+    visitAsset(AssetType::PLUGIN, plugin.Filename(), "", _callback);
+}
+
+/////////////////////////////////////////////////
+/// \brief Visit the skin, animations and plugins of an actor.
+/// \param[in] _actor The actor.
+/// \param[in] _callback Function called for each asset.
+static void visitAssets(const sdf::Actor &_actor,
+                        const AssetCallback &_callback)
+{
+  visitAsset(AssetType::SKIN, _actor.SkinFilename(), _actor.FilePath(),
+      _callback);
+  for (uint64_t i = 0; i < _actor.AnimationCount(); ++i)
+  {
+    const sdf::Animation *animation = _actor.AnimationByIndex(i);
+    visitAsset(AssetType::ANIMATION, animation->Filename(),
+        animation->FilePath(), _callback);
+  }
+  visitAssets(_actor.Plugins(), _callback);
+}
+
+/////////////////////////////////////////////////
+/// \brief Visit the geometries and materials of a model and its nested
+/// models.
+/// \param[in] _model The model.
+/// \param[in] _callback Function called for each asset.
+static void visitAssets(const sdf::Model &_model,
+                        const AssetCallback &_callback)
+{
+  for (uint64_t i = 0; i < _model.LinkCount(); ++i)
+  {
+    const sdf::Link *link = _model.LinkByIndex(i);
+    for (uint64_t j = 0; j < link->VisualCount(); ++j)
+    {
+      const sdf::Visual *visual = link->VisualByIndex(j);
+      visitAssets(visual->Geom(), _callback);
+      visitAssets(visual->Material(), _callback);
+    }
+    for (uint64_t j = 0; j < link->CollisionCount(); ++j)
+      visitAssets(link->CollisionByIndex(j)->Geom(), _callback);
+  }
+
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+    visitAssets(*_model.ModelByIndex(i), _callback);
+}
+
+/////////////////////////////////////////////////
+Errors Root::ResolveAssets(const ParserConfig &_config,
+                           std::size_t _threadCount)
+{
+  std::map<std::string, std::string> assets;
+  auto addAsset = [&assets](AssetType, const std::string &_uri,
+                            const std::string &_filePath)
+  {
+    assets.emplace(assetKey(_uri, _filePath), _uri);
+  };
+  for (const sdf::World &world : this->dataPtr->worlds)
+  {
+    for (uint64_t i = 0; i < world.ModelCount(); ++i)
+      visitAssets(*world.ModelByIndex(i), addAsset);
+    for (uint64_t i = 0; i < world.PopulationCount(); ++i)
+      visitAssets(*world.PopulationByIndex(i)->Model(), addAsset);
+  }
+  if (const sdf::Model *model = this->Model())
+    visitAssets(*model, addAsset);
+
+  // The distinct assets are resolved concurrently, each one on its own
+  std::vector<std::pair<std::string, std::string>> keysAndUris(
+      assets.begin(), assets.end());
+  std::vector<std::string> paths(keysAndUris.size());
+  auto resolve = [&](std::size_t _index)
+  {
+    const auto &[key, uri] = keysAndUris[_index];
+    if (key != uri && sdf::filesystem::exists(key))
+      paths[_index] = key;
+    else
+      paths[_index] = sdf::findFile(uri, true, true, _config);
+  };
+
+  if (_threadCount == 0)
+    _threadCount = std::max(1u, std::thread::hardware_concurrency());
+  _threadCount = std::min(_threadCount, keysAndUris.size());
+  if (_threadCount > 1)
+  {
+    std::atomic<std::size_t> nextAsset{0};
+    auto resolveAssets = [&](std::size_t)
+    {
+      for (std::size_t i = nextAsset++; i < keysAndUris.size();
+           i = nextAsset++)
+      {
+        resolve(i);
+      }
+    };
+    _config.Executor()->RunAndWait(_threadCount, resolveAssets);
+  }
+  else
+  {
+    for (std::size_t i = 0; i < keysAndUris.size(); ++i)
+      resolve(i);
+  }
+
+  Errors errors;
+  this->dataPtr->resolvedAssets.clear();
+  for (std::size_t i = 0; i < keysAndUris.size(); ++i)
+  {
+    if (paths[i].empty())
+    {
+      errors.push_back({ErrorCode::URI_LOOKUP,
+          "Unable to find asset [" + keysAndUris[i].second + "]."});
+    }
+    this->dataPtr->resolvedAssets.emplace_hint(
+        this->dataPtr->resolvedAssets.end(), keysAndUris[i].first,
+        std::move(paths[i]));
+  }
+  return errors;
+}
+
+/////////////////////////////////////////////////
+std::vector<AssetReference> Root::CollectAssetReferences() const
+{
+  std::map<std::pair<AssetType, std::string>, AssetReference> references;
+  auto addReference = [&references](uint64_t _entityId)
+  {
+    return [&references, _entityId](AssetType _type,
+        const std::string &_uri, const std::string &_filePath)
+    {
+      const std::string key = _type == AssetType::PLUGIN ? _uri :
+          assetKey(_uri, _filePath);
+      AssetReference &reference = references[{_type, key}];
+      reference.uri = key;
+      reference.type = _type;
+      ++reference.referenceCount;
+      if (_entityId != kNoIndex && (reference.entityIds.empty() ||
+          reference.entityIds.back() != _entityId))
+      {
+        reference.entityIds.push_back(_entityId);
+      }
+    };
+  };
+
+  // Entities are visited in ID order, so the IDs of each asset are sorted
+  // and an entity that refers to an asset twice is only listed once
+  for (uint64_t id = 0; id < this->dataPtr->entities.size(); ++id)
+  {
+    switch (this->dataPtr->entities[id].type)
+    {
+      case EntityType::MODEL:
+        if (const sdf::Model *model = this->EntityById<sdf::Model>(id))
+          visitAssets(model->Plugins(), addReference(id));
+        break;
+      case EntityType::COLLISION:
+        if (const auto *collision = this->EntityById<sdf::Collision>(id))
+          visitAssets(collision->Geom(), addReference(id));
+        break;
+      case EntityType::VISUAL:
+        if (const sdf::Visual *visual = this->EntityById<sdf::Visual>(id))
+        {
+          visitAssets(visual->Geom(), addReference(id));
+          visitAssets(visual->Material(), addReference(id));
+          visitAssets(visual->Plugins(), addReference(id));
+        }
+        break;
+      case EntityType::SENSOR:
+        if (const sdf::Sensor *sensor = this->EntityById<sdf::Sensor>(id))
+          visitAssets(sensor->Plugins(), addReference(id));
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Worlds, actors and the models of populations have no entity ID
+  for (const sdf::World &world : this->dataPtr->worlds)
+  {
+    visitAssets(world.Plugins(), addReference(kNoIndex));
+    if (const sdf::Gui *gui = world.Gui())
+      visitAssets(gui->Plugins(), addReference(kNoIndex));
+    for (uint64_t i = 0; i < world.ActorCount(); ++i)
+      visitAssets(*world.ActorByIndex(i), addReference(kNoIndex));
+    for (uint64_t i = 0; i < world.PopulationCount(); ++i)
+    {
+      const sdf::Model *model = world.PopulationByIndex(i)->Model();
+      visitAssets(*model, addReference(kNoIndex));
+      visitAssets(model->Plugins(), addReference(kNoIndex));
+    }
+  }
+  if (const sdf::Actor *actor = this->Actor())
+    visitAssets(*actor, addReference(kNoIndex));
+
+  std::vector<AssetReference> result;
+  result.reserve(references.size());
+  for (auto &[key, reference] : references)
+    result.push_back(std::move(reference));
+  return result;
+}
+
+/////////////////////////////////////////////////
+const std::map<std::string, std::string> &Root::ResolvedAssets() const
+{
+  return this->dataPtr->resolvedAssets;
+}
+
+/////////////////////////////////////////////////
+std::string Root::ResolvedAssetPath(const std::string &_uri,
+                                    const std::string &_filePath) const
+{
+  auto it = this->dataPtr->resolvedAssets.find(assetKey(_uri, _filePath));
+  if (it == this->dataPtr->resolvedAssets.end())
+    return "";
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+sdf::ElementPtr Root::ToElement(const ParserConfig &_config) const
+{
+  sdf::ElementPtr elem(new sdf::Element);
+  sdf::initFile("root.sdf", _config, elem);
+
+  elem->GetAttribute("version")->Set(this->Version());
+
+  if (this->Model() != nullptr)
+  {
+    elem->InsertElement(this->Model()->ToElement(_config), true);
+  }
+  else if (this->Light() != nullptr)
+  {
+    elem->InsertElement(this->Light()->ToElement(), true);
+  }
+  else if (this->Actor() != nullptr)
+  {
+    elem->InsertElement(this->Actor()->ToElement(), true);
+  }
+  else
+  {
+    // Worlds
+    for (const sdf::World &world : this->dataPtr->worlds)
+      elem->InsertElement(world.ToElement(_config), true);
+  }
+
+  return elem;
+}
+
+/////////////////////////////////////////////////
+void Root::ToStream(std::ostream &_out, const PrintConfig &_printConfig,
+    const ParserConfig &_config) const
+{
+  _out << "<?xml version='1.0'?>\n";
+  this->ToElement(_config)->ToStream(_out, "", _printConfig);
+}
+
+/////////////////////////////////////////////////
+Errors Root::WriteFile(const std::string &_filename,
+    const PrintConfig &_printConfig, const ParserConfig &_config) const
+{
+  Errors errors;
+  const std::string tmpFile = _filename + ".tmp";
+  {
+    std::ofstream out(tmpFile, std::ios::out | std::ios::trunc);
+    if (!out)
+    {
+      errors.push_back({ErrorCode::FILE_WRITE,
+          "Unable to open file[" + tmpFile + "] for writing."});
+      return errors;
+    }
+
+    this->ToStream(out, _printConfig, _config);
+    out.close();
+    if (!out)
+    {
+      errors.push_back({ErrorCode::FILE_WRITE,
+          "Unable to write file[" + tmpFile + "]."});
+    }
+  }
+
+  if (errors.empty() && !filesystem::rename(tmpFile, _filename))
+  {
+    errors.push_back({ErrorCode::FILE_WRITE,
+        "Unable to rename file[" + tmpFile + "] to [" + _filename + "]."});
+  }
+  if (!errors.empty())
+  {
+    filesystem::remove(tmpFile);
+  }
+  return errors;
 }
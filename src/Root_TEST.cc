@@ -15,17 +15,37 @@
  *
 */
 
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include "sdf/Actor.hh"
+#include "sdf/Box.hh"
 #include "sdf/sdf_config.h"
 #include "sdf/Collision.hh"
 #include "sdf/Error.hh"
+#include "sdf/Geometry.hh"
 #include "sdf/Link.hh"
 #include "sdf/Light.hh"
 #include "sdf/Model.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/PerfCounters.hh"
+#include "sdf/Plugin.hh"
 #include "sdf/World.hh"
 #include "sdf/Frame.hh"
+#include "sdf/Joint.hh"
 #include "sdf/Root.hh"
+#include "sdf/Surface.hh"
+#include "sdf/Visual.hh"
+#include "test_config.h"
 
 /////////////////////////////////////////////////
 TEST(DOMRoot, Construction)
@@ -161,6 +181,63 @@ TEST(DOMRoot, StringLightSdfParse)
   EXPECT_EQ(0u, root.WorldCount());
 }
 
+/////////////////////////////////////////////////
+TEST(DOMRoot, BufferSdfParse)
+{
+  // The buffer holds two documents, and is not null terminated after the
+  // first one, which is the only one parsed.
+  const std::string first = "<?xml version=\"1.0\"?>"
+    "<sdf version=\"1.8\">"
+    "  <model name='first'><link name='link'/></model>"
+    "</sdf>";
+  const std::string buffer = first +
+    "<sdf version=\"1.8\"><model name='second'/></sdf>";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(buffer.data(), first.size(),
+      sdf::ParserConfig::GlobalConfig());
+  EXPECT_TRUE(errors.empty()) << errors;
+  ASSERT_NE(nullptr, root.Model());
+  EXPECT_EQ("first", root.Model()->Name());
+
+  sdf::Root badRoot;
+  errors = badRoot.LoadSdfString(buffer.data(), first.size() - 6,
+      sdf::ParserConfig::GlobalConfig());
+  ASSERT_FALSE(errors.empty());
+  EXPECT_EQ(sdf::ErrorCode::STRING_READ, errors.back().Code());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, LoadSdfStrings)
+{
+  std::vector<std::string> sdfs;
+  for (int i = 0; i < 4; ++i)
+  {
+    sdfs.push_back("<sdf version='1.8'><model name='model" +
+        std::to_string(i) + "'><link name='link'/></model></sdf>");
+  }
+  sdfs.push_back("<sdf version='1.8'><model name='bad'>");
+  std::vector<std::string_view> views(sdfs.begin(), sdfs.end());
+
+  sdf::ParserConfig config;
+  std::vector<sdf::Root> roots;
+  std::vector<sdf::Errors> errors =
+      sdf::Root::LoadSdfStrings(views, roots, config);
+  ASSERT_EQ(sdfs.size(), errors.size());
+  ASSERT_EQ(sdfs.size(), roots.size());
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_TRUE(errors[i].empty()) << errors[i];
+    ASSERT_NE(nullptr, roots[i].Model());
+    EXPECT_EQ("model" + std::to_string(i), roots[i].Model()->Name());
+  }
+  EXPECT_FALSE(errors[4].empty());
+  EXPECT_EQ(nullptr, roots[4].Model());
+
+  // The configuration is not changed by the batch.
+  EXPECT_FALSE(config.ReuseXmlDocuments());
+}
+
 /////////////////////////////////////////////////
 TEST(DOMRoot, StringActorSdfParse)
 {
@@ -319,6 +396,853 @@ TEST(DOMRoot, AddWorld)
   const sdf::World *worldFromRoot = root.WorldByIndex(0);
   ASSERT_NE(nullptr, worldFromRoot);
   EXPECT_EQ(worldFromRoot->Name(), world.Name());
+
+  sdf::World world2;
+  world2.SetName("world2");
+  sdf::Model model;
+  model.SetName("model");
+  EXPECT_TRUE(world2.AddModel(std::move(model)));
+  EXPECT_TRUE(root.AddWorld(std::move(world2)).empty());
+  EXPECT_EQ(2u, root.WorldCount());
+  ASSERT_NE(nullptr, root.WorldByIndex(1));
+  EXPECT_EQ("world2", root.WorldByIndex(1)->Name());
+  EXPECT_NE(nullptr, root.WorldByIndex(1)->ModelByName("model"));
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, EntityById)
+{
+  sdf::Root root;
+  EXPECT_EQ(0u, root.EntityCount());
+  EXPECT_EQ(nullptr, root.EntityById<sdf::Model>(0));
+
+  sdf::Link link;
+  link.SetName("link");
+  sdf::Collision collision;
+  collision.SetName("collision");
+  EXPECT_TRUE(link.AddCollision(collision));
+  sdf::Visual visual;
+  visual.SetName("visual");
+  EXPECT_TRUE(link.AddVisual(visual));
+
+  sdf::Model nested;
+  nested.SetName("nested");
+  EXPECT_TRUE(nested.AddLink(link));
+
+  sdf::Model model;
+  model.SetName("model");
+  EXPECT_TRUE(model.AddLink(link));
+  sdf::Joint joint;
+  joint.SetName("joint");
+  joint.SetParentLinkName("world");
+  joint.SetChildLinkName("link");
+  EXPECT_TRUE(model.AddJoint(joint));
+  EXPECT_TRUE(model.AddModel(nested));
+
+  sdf::World world;
+  world.SetName("world");
+  EXPECT_TRUE(world.AddModel(model));
+  sdf::Frame frame;
+  frame.SetName("frame");
+  EXPECT_TRUE(world.AddFrame(frame));
+
+  root.AddWorld(world);
+
+  // model, link, collision, visual, joint, nested, link, collision, visual,
+  // frame
+  ASSERT_EQ(10u, root.EntityCount());
+  const sdf::World *w = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, w);
+  EXPECT_EQ(w->ModelByIndex(0), root.EntityById<sdf::Model>(0));
+  EXPECT_EQ(w->ModelByIndex(0)->LinkByIndex(0),
+            root.EntityById<sdf::Link>(1));
+  EXPECT_EQ(w->ModelByIndex(0)->LinkByIndex(0)->CollisionByIndex(0),
+            root.EntityById<sdf::Collision>(2));
+  EXPECT_EQ(w->ModelByIndex(0)->LinkByIndex(0)->VisualByIndex(0),
+            root.EntityById<sdf::Visual>(3));
+  EXPECT_EQ(w->ModelByIndex(0)->JointByIndex(0),
+            root.EntityById<sdf::Joint>(4));
+  EXPECT_EQ(w->ModelByName("model::nested"), root.EntityById<sdf::Model>(5));
+  EXPECT_EQ(w->ModelByName("model::nested")->LinkByIndex(0)->VisualByIndex(0),
+            root.EntityById<sdf::Visual>(8));
+  EXPECT_EQ(w->FrameByIndex(0), root.EntityById<sdf::Frame>(9));
+
+  // The type must match and the ID must exist.
+  EXPECT_EQ(nullptr, root.EntityById<sdf::Link>(0));
+  EXPECT_EQ(nullptr, root.EntityById<sdf::Sensor>(2));
+  EXPECT_EQ(nullptr, root.EntityById<sdf::Frame>(10));
+
+  // IDs still refer to the same entities after the world's models are
+  // reallocated.
+  sdf::World *mutableWorld = root.WorldByIndex(0);
+  for (int i = 0; i < 10; ++i)
+  {
+    sdf::Model extra;
+    extra.SetName("extra" + std::to_string(i));
+    EXPECT_TRUE(mutableWorld->AddModel(extra));
+  }
+  EXPECT_EQ(mutableWorld->ModelByName("model::nested"),
+            root.EntityById<sdf::Model>(5));
+  EXPECT_EQ(10u, root.EntityCount());
+
+  sdf::Link *mutableLink = root.EntityById<sdf::Link>(1);
+  ASSERT_NE(nullptr, mutableLink);
+  mutableLink->SetName("renamed");
+  EXPECT_NE(nullptr, mutableWorld->ModelByName("model")->LinkByName("renamed"));
+
+  // Removed entities are no longer found.
+  mutableWorld->ModelByIndex(0)->ClearLinks();
+  EXPECT_EQ(nullptr, root.EntityById<sdf::Link>(1));
+  EXPECT_EQ(nullptr, root.EntityById<sdf::Collision>(2));
+
+  root.ClearWorlds();
+  EXPECT_EQ(0u, root.EntityCount());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, ResolveAllPoses)
+{
+  using ignition::math::Pose3d;
+  const std::string sdf =
+    "<?xml version=\"1.0\"?>"
+    "<sdf version=\"1.8\">"
+    "  <world name=\"default\">"
+    "    <frame name=\"F\"><pose>0 0 1 0 0 0</pose></frame>"
+    "    <model name=\"model\">"
+    "      <pose relative_to=\"F\">1 0 0 0 0 0</pose>"
+    "      <link name=\"link\">"
+    "        <pose>0 1 0 0 0 1.57</pose>"
+    "        <visual name=\"visual\">"
+    "          <pose>1 0 0 0 0 0</pose>"
+    "          <geometry><sphere><radius>1</radius></sphere></geometry>"
+    "        </visual>"
+    "      </link>"
+    "      <joint name=\"joint\" type=\"fixed\">"
+    "        <parent>world</parent>"
+    "        <child>link</child>"
+    "      </joint>"
+    "      <model name=\"nested\">"
+    "        <pose>0 0 2 0 0 0</pose>"
+    "        <link name=\"link\"/>"
+    "      </model>"
+    "    </model>"
+    "  </world>"
+    "</sdf>";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf);
+  ASSERT_TRUE(errors.empty()) << errors;
+
+  // model, link, visual, joint, nested, link, F
+  std::vector<Pose3d> poses;
+  errors = root.ResolveAllPoses(poses);
+  EXPECT_TRUE(errors.empty()) << errors;
+  ASSERT_EQ(7u, root.EntityCount());
+  ASSERT_EQ(root.EntityCount(), poses.size());
+
+  // Each pose is the one of SemanticPose().Resolve() in the world frame.
+  auto expectPose = [&](const auto *_entity, uint64_t _id)
+  {
+    ASSERT_NE(nullptr, _entity) << _id;
+    Pose3d expected;
+    EXPECT_TRUE(_entity->SemanticPose().Resolve(expected, "world").empty());
+    EXPECT_EQ(expected, poses[_id]) << _id;
+  };
+  expectPose(root.EntityById<sdf::Model>(0), 0);
+  expectPose(root.EntityById<sdf::Link>(1), 1);
+  expectPose(root.EntityById<sdf::Visual>(2), 2);
+  expectPose(root.EntityById<sdf::Joint>(3), 3);
+  expectPose(root.EntityById<sdf::Model>(4), 4);
+  expectPose(root.EntityById<sdf::Link>(5), 5);
+  expectPose(root.EntityById<sdf::Frame>(6), 6);
+  EXPECT_EQ(Pose3d(1, 0, 3, 0, 0, 0), poses[5]);
+
+  // Entities added since IDs were assigned are reported.
+  sdf::Frame frame;
+  frame.SetName("F2");
+  EXPECT_TRUE(root.WorldByIndex(0)->AddFrame(frame));
+  errors = root.ResolveAllPoses(poses);
+  ASSERT_FALSE(errors.empty());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_INVALID, errors.back().Code());
+  EXPECT_EQ(root.EntityCount(), poses.size());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, SetRawPoses)
+{
+  using ignition::math::Pose3d;
+  const std::string sdf =
+    "<?xml version=\"1.0\"?>"
+    "<sdf version=\"1.8\">"
+    "  <world name=\"default\">"
+    "    <model name=\"model\">"
+    "      <pose>1 0 0 0 0 0</pose>"
+    "      <link name=\"link\">"
+    "        <pose>0 1 0 0 0 0</pose>"
+    "      </link>"
+    "    </model>"
+    "    <model name=\"other\">"
+    "      <link name=\"link\"/>"
+    "    </model>"
+    "  </world>"
+    "</sdf>";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf);
+  ASSERT_TRUE(errors.empty()) << errors;
+
+  // model, link, other, link
+  ASSERT_EQ(4u, root.EntityCount());
+  sdf::Model *model = root.EntityById<sdf::Model>(0);
+  sdf::Link *link = root.EntityById<sdf::Link>(1);
+  sdf::Model *other = root.EntityById<sdf::Model>(2);
+  ASSERT_NE(nullptr, model);
+  ASSERT_NE(nullptr, link);
+  ASSERT_NE(nullptr, other);
+  const uint64_t modelHash = model->Element()->ContentHash();
+  const uint64_t otherHash = other->Element()->ContentHash();
+
+  std::vector<Pose3d> poses = {model->RawPose(), Pose3d(0, 2, 0, 0, 0, 0),
+      other->RawPose(), Pose3d(0, 0, 3, 0, 0, 0)};
+  errors = root.SetRawPoses(poses);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  EXPECT_EQ(Pose3d(1, 0, 0, 0, 0, 0), model->RawPose());
+  EXPECT_EQ(Pose3d(0, 2, 0, 0, 0, 0), link->RawPose());
+  EXPECT_EQ(Pose3d(0, 0, 3, 0, 0, 0),
+      root.EntityById<sdf::Link>(3)->RawPose());
+
+  // The elements hold the new poses, and only the elements that contain a
+  // moved entity have a new content hash.
+  EXPECT_EQ(Pose3d(0, 2, 0, 0, 0, 0),
+      link->Element()->Get<Pose3d>("pose"));
+  EXPECT_EQ(Pose3d(0, 0, 3, 0, 0, 0),
+      root.EntityById<sdf::Link>(3)->Element()->Get<Pose3d>("pose"));
+  EXPECT_NE(modelHash, model->Element()->ContentHash());
+  EXPECT_NE(otherHash, other->Element()->ContentHash());
+  const uint64_t movedHash = model->Element()->ContentHash();
+  errors = root.SetRawPoses(poses);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(movedHash, model->Element()->ContentHash());
+
+  // The new poses are written by ToElement.
+  sdf::ElementPtr elem = root.ToElement();
+  ASSERT_NE(nullptr, elem);
+  sdf::ElementPtr linkElem = elem->GetElement("world")->GetElement(
+      "model")->GetElement("link");
+  EXPECT_EQ(Pose3d(0, 2, 0, 0, 0, 0), linkElem->Get<Pose3d>("pose"));
+
+  // No pose is set if there is not one per entity.
+  poses.pop_back();
+  poses[1] = Pose3d::Zero;
+  errors = root.SetRawPoses(poses);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_INVALID, errors[0].Code());
+  EXPECT_EQ(Pose3d(0, 2, 0, 0, 0, 0), link->RawPose());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, UpdateModelGraphs)
+{
+  using ignition::math::Pose3d;
+
+  sdf::Link link;
+  link.SetName("link");
+
+  sdf::Model model1;
+  model1.SetName("model1");
+  model1.SetRawPose(Pose3d(1, 0, 0, 0, 0, 0));
+  EXPECT_TRUE(model1.AddLink(link));
+
+  sdf::Frame frame;
+  frame.SetName("frame");
+  frame.SetAttachedTo("model1");
+  frame.SetRawPose(Pose3d(0, 1, 0, 0, 0, 0));
+
+  sdf::World world;
+  world.SetName("world");
+  EXPECT_TRUE(world.AddModel(model1));
+  EXPECT_TRUE(world.AddFrame(frame));
+
+  sdf::Root root;
+  sdf::Errors errors = root.AddWorld(world);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(3u, root.EntityCount());
+
+  // Add a model whose pose is relative to a frame of the world.
+  sdf::Model model2;
+  model2.SetName("model2");
+  model2.SetRawPose(Pose3d(0, 0, 1, 0, 0, 0));
+  model2.SetPoseRelativeTo("frame");
+  EXPECT_TRUE(model2.AddLink(link));
+
+  sdf::World *w = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, w);
+  EXPECT_TRUE(w->AddModel(model2));
+  errors = root.UpdateGraphs("world", "model2");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(5u, root.EntityCount());
+
+  Pose3d pose;
+  const sdf::Link *link2 = w->ModelByName("model2")->LinkByName("link");
+  ASSERT_NE(nullptr, link2);
+  errors = link2->SemanticPose().Resolve(pose, "world");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(Pose3d(1, 1, 1, 0, 0, 0), pose);
+
+  // Update the graphs after editing the model.
+  w->ModelByName("model2")->SetRawPose(Pose3d(0, 0, 2, 0, 0, 0));
+  errors = root.UpdateGraphs("world", "model2");
+  EXPECT_TRUE(errors.empty()) << errors;
+  link2 = w->ModelByName("model2")->LinkByName("link");
+  ASSERT_NE(nullptr, link2);
+  errors = link2->SemanticPose().Resolve(pose, "world");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(Pose3d(1, 1, 2, 0, 0, 0), pose);
+
+  // Nothing else refers to model2, so only its vertices are removed.
+  errors = root.RemoveModel("world", "model2");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(nullptr, w->ModelByName("model2"));
+  EXPECT_EQ(3u, root.EntityCount());
+  errors = w->FrameByName("frame")->SemanticPose().Resolve(pose, "world");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(Pose3d(1, 1, 0, 0, 0, 0), pose);
+
+  // The frame is attached to model1, so the world graphs are rebuilt and
+  // report the frame.
+  errors = root.RemoveModel("world", "model1");
+  ASSERT_FALSE(errors.empty());
+  EXPECT_EQ(sdf::ErrorCode::FRAME_ATTACHED_TO_INVALID, errors[0].Code());
+  EXPECT_EQ(0u, w->ModelCount());
+
+  errors = root.UpdateGraphs("world", "missing");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_MISSING, errors[0].Code());
+
+  errors = root.RemoveModel("missing", "model1");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_MISSING, errors[0].Code());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, CloneSharesGraphs)
+{
+  using ignition::math::Pose3d;
+
+  sdf::World world;
+  world.SetName("world");
+  for (int i = 0; i < 3; ++i)
+  {
+    sdf::Link link;
+    link.SetName("link");
+    sdf::Model model;
+    model.SetName("model" + std::to_string(i));
+    model.SetRawPose(Pose3d(i, 0, 0, 0, 0, 0));
+    EXPECT_TRUE(model.AddLink(std::move(link)));
+    EXPECT_TRUE(world.AddModel(std::move(model)));
+  }
+
+  sdf::Root root;
+  sdf::Errors errors = root.AddWorld(world);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  auto resolveLink = [](const sdf::Root &_root, const std::string &_model)
+  {
+    Pose3d pose;
+    const sdf::Link *link =
+        _root.WorldByIndex(0)->ModelByName(_model)->LinkByName("link");
+    EXPECT_TRUE(link->SemanticPose().Resolve(pose, "world").empty());
+    return pose;
+  };
+
+  // The clone resolves poses with the graphs of the original root.
+  sdf::Root clone = root.Clone();
+  EXPECT_EQ(root.EntityCount(), clone.EntityCount());
+  EXPECT_EQ(Pose3d(2, 0, 0, 0, 0, 0), resolveLink(clone, "model2"));
+  EXPECT_EQ(clone.WorldByIndex(0)->ModelByIndex(0),
+            clone.EntityById<sdf::Model>(0));
+
+  // Updating the graphs of a model of the clone copies the graphs first, so
+  // the original root is not affected.
+  clone.WorldByIndex(0)->ModelByName("model1")->SetRawPose(
+      Pose3d(0, 5, 0, 0, 0, 0));
+  errors = clone.UpdateGraphs("world", "model1");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(Pose3d(0, 5, 0, 0, 0, 0), resolveLink(clone, "model1"));
+  EXPECT_EQ(Pose3d(2, 0, 0, 0, 0, 0), resolveLink(clone, "model2"));
+  EXPECT_EQ(Pose3d(1, 0, 0, 0, 0, 0), resolveLink(root, "model1"));
+
+  // And the other way around.
+  sdf::Root clone2 = root.Clone();
+  errors = root.RemoveModel("world", "model0");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(2u, root.WorldByIndex(0)->ModelCount());
+  EXPECT_EQ(Pose3d(0, 0, 0, 0, 0, 0), resolveLink(clone2, "model0"));
+  EXPECT_EQ(Pose3d(1, 0, 0, 0, 0, 0), resolveLink(clone2, "model1"));
+  EXPECT_EQ(Pose3d(2, 0, 0, 0, 0, 0), resolveLink(root, "model2"));
+
+  // A root whose graphs were not built gets new graphs.
+  sdf::Root modelRoot;
+  sdf::Model model;
+  model.SetName("model");
+  sdf::Link link;
+  link.SetName("link");
+  EXPECT_TRUE(model.AddLink(std::move(link)));
+  modelRoot.SetModel(model);
+  sdf::Root modelClone = modelRoot.Clone();
+  Pose3d pose;
+  ASSERT_NE(nullptr, modelClone.Model());
+  EXPECT_TRUE(modelClone.Model()->LinkByName("link")->SemanticPose().Resolve(
+      pose, "__model__").empty());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, GraphBuildThreadCount)
+{
+  using ignition::math::Pose3d;
+
+  std::string sdf = "<?xml version=\"1.0\"?>"
+    "<sdf version=\"1.8\">"
+    "  <world name=\"default\">"
+    "    <frame name=\"frame\">"
+    "      <pose>0 1 0 0 0 0</pose>"
+    "    </frame>";
+  for (int i = 0; i < 8; ++i)
+  {
+    const std::string name = "model" + std::to_string(i);
+    sdf +=
+      "    <model name=\"" + name + "\">"
+      "      <pose relative_to=\"frame\">" + std::to_string(i) +
+      " 0 0 0 0 0</pose>"
+      "      <link name=\"link\">"
+      "        <pose>0 0 1 0 0 0</pose>"
+      "      </link>"
+      "    </model>";
+  }
+  // A duplicate model name is reported the same way by both builds.
+  sdf +=
+    "    <model name=\"model0\">"
+    "      <link name=\"link\"/>"
+    "    </model>"
+    "  </world>"
+    "</sdf>";
+
+  sdf::ParserConfig serialConfig;
+  sdf::Root serialRoot;
+  sdf::Errors serialErrors = serialRoot.LoadSdfString(sdf, serialConfig);
+
+  sdf::ParserConfig config;
+  config.SetGraphBuildThreadCount(4);
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf, config);
+
+  ASSERT_EQ(serialErrors.size(), errors.size());
+  for (std::size_t i = 0; i < errors.size(); ++i)
+  {
+    EXPECT_EQ(serialErrors[i].Code(), errors[i].Code());
+    EXPECT_EQ(serialErrors[i].Message(), errors[i].Message());
+  }
+
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  for (int i = 0; i < 8; ++i)
+  {
+    const sdf::Model *model = world->ModelByName("model" + std::to_string(i));
+    ASSERT_NE(nullptr, model);
+    const sdf::Link *link = model->LinkByName("link");
+    ASSERT_NE(nullptr, link);
+    Pose3d pose;
+    sdf::Errors resolveErrors = link->SemanticPose().Resolve(pose, "world");
+    EXPECT_TRUE(resolveErrors.empty()) << resolveErrors;
+    EXPECT_EQ(Pose3d(i, 1, 1, 0, 0, 0), pose);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, WorldLoadThreadCount)
+{
+  using ignition::math::Pose3d;
+
+  std::string sdf = "<?xml version=\"1.0\"?>"
+    "<sdf version=\"1.8\">";
+  for (int i = 0; i < 6; ++i)
+  {
+    sdf +=
+      "  <world name=\"world" + std::to_string(i) + "\">"
+      "    <model name=\"model\">"
+      "      <pose>" + std::to_string(i) + " 0 0 0 0 0</pose>"
+      "      <link name=\"link\"/>"
+      "    </model>"
+      "  </world>";
+  }
+  // A duplicate world name and an invalid world are reported the same way
+  // by both loads.
+  sdf +=
+    "  <world name=\"world0\"/>"
+    "  <world name=\"invalid\">"
+    "    <frame name=\"frame\" attached_to=\"missing\"/>"
+    "  </world>"
+    "</sdf>";
+
+  sdf::Root serialRoot;
+  sdf::Errors serialErrors = serialRoot.LoadSdfString(sdf);
+  EXPECT_FALSE(serialErrors.empty());
+
+  sdf::ParserConfig config;
+  config.SetWorldLoadThreadCount(4);
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf, config);
+
+  ASSERT_EQ(serialErrors.size(), errors.size());
+  for (std::size_t i = 0; i < errors.size(); ++i)
+  {
+    EXPECT_EQ(serialErrors[i].Code(), errors[i].Code());
+    EXPECT_EQ(serialErrors[i].Message(), errors[i].Message());
+  }
+
+  ASSERT_EQ(8u, root.WorldCount());
+  for (int i = 0; i < 6; ++i)
+  {
+    const sdf::World *world = root.WorldByIndex(i);
+    ASSERT_NE(nullptr, world);
+    EXPECT_EQ("world" + std::to_string(i), world->Name());
+    const sdf::Model *model = world->ModelByName("model");
+    ASSERT_NE(nullptr, model);
+    Pose3d pose;
+    sdf::Errors resolveErrors =
+        model->LinkByName("link")->SemanticPose().Resolve(pose, "world");
+    EXPECT_TRUE(resolveErrors.empty()) << resolveErrors;
+    EXPECT_EQ(Pose3d(i, 0, 0, 0, 0, 0), pose);
+  }
+  EXPECT_EQ("invalid", root.WorldByIndex(7)->Name());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, ModelLoadThreadCount)
+{
+  using ignition::math::Pose3d;
+
+  std::string sdf = "<?xml version=\"1.0\"?>"
+    "<sdf version=\"1.8\">"
+    "  <model name=\"model\">";
+  for (int i = 0; i < 50; ++i)
+  {
+    const std::string index = std::to_string(i);
+    sdf +=
+      "    <link name=\"link" + index + "\">"
+      "      <pose>" + index + " 0 0 0 0 0</pose>"
+      "    </link>"
+      "    <frame name=\"frame" + index + "\" attached_to=\"link" + index +
+      "\"/>";
+    if (i > 0)
+    {
+      sdf +=
+        "    <joint name=\"joint" + index + "\" type=\"fixed\">"
+        "      <parent>link" + std::to_string(i - 1) + "</parent>"
+        "      <child>link" + index + "</child>"
+        "    </joint>";
+    }
+  }
+  // Duplicate names and an invalid joint are reported the same way by both
+  // loads.
+  sdf +=
+    "    <link name=\"link3\"/>"
+    "    <frame name=\"frame7\"/>"
+    "    <joint name=\"invalid\" type=\"unknown\">"
+    "      <parent>link0</parent>"
+    "      <child>link1</child>"
+    "    </joint>"
+    "  </model>"
+    "</sdf>";
+
+  sdf::Root serialRoot;
+  sdf::Errors serialErrors = serialRoot.LoadSdfString(sdf);
+  EXPECT_FALSE(serialErrors.empty());
+
+  sdf::ParserConfig config;
+  config.SetModelLoadThreadCount(4);
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf, config);
+
+  ASSERT_EQ(serialErrors.size(), errors.size());
+  for (std::size_t i = 0; i < errors.size(); ++i)
+  {
+    EXPECT_EQ(serialErrors[i].Code(), errors[i].Code());
+    EXPECT_EQ(serialErrors[i].Message(), errors[i].Message());
+  }
+
+  const sdf::Model *model = root.Model();
+  ASSERT_NE(nullptr, model);
+  ASSERT_EQ(serialRoot.Model()->LinkCount(), model->LinkCount());
+  ASSERT_EQ(serialRoot.Model()->JointCount(), model->JointCount());
+  ASSERT_EQ(serialRoot.Model()->FrameCount(), model->FrameCount());
+  ASSERT_EQ(50u, model->LinkCount());
+  for (uint64_t i = 0; i < model->LinkCount(); ++i)
+  {
+    const sdf::Link *link = model->LinkByIndex(i);
+    EXPECT_EQ("link" + std::to_string(i), link->Name());
+    Pose3d pose;
+    sdf::Errors resolveErrors =
+        link->SemanticPose().Resolve(pose, "__model__");
+    EXPECT_TRUE(resolveErrors.empty()) << resolveErrors;
+    EXPECT_EQ(Pose3d(static_cast<double>(i), 0, 0, 0, 0, 0), pose);
+  }
+  for (uint64_t i = 0; i < model->JointCount(); ++i)
+  {
+    EXPECT_EQ(serialRoot.Model()->JointByIndex(i)->Name(),
+              model->JointByIndex(i)->Name());
+  }
+  for (uint64_t i = 0; i < model->FrameCount(); ++i)
+  {
+    EXPECT_EQ(serialRoot.Model()->FrameByIndex(i)->Name(),
+              model->FrameByIndex(i)->Name());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, Freeze)
+{
+  using ignition::math::Pose3d;
+
+  std::string sdf = "<?xml version=\"1.0\"?>"
+    "<sdf version=\"1.8\">"
+    "  <world name=\"default\">";
+  for (int i = 0; i < 8; ++i)
+  {
+    sdf +=
+      "    <model name=\"model" + std::to_string(i) + "\">"
+      "      <pose>" + std::to_string(i) + " 0 0 0 0 0</pose>"
+      "      <link name=\"link\">"
+      "        <pose>0 1 0 0 0 0</pose>"
+      "      </link>"
+      "    </model>";
+  }
+  sdf +=
+    "    <light name=\"light\" type=\"point\">"
+    "      <attenuation><range>2</range></attenuation>"
+    "    </light>"
+    "  </world>"
+    "</sdf>";
+
+  sdf::ParserConfig config;
+  config.SetLazyWorldModels(true);
+  config.SetLazyParamParsing(true);
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  errors = root.Freeze();
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  const sdf::Root &frozen = root;
+  const sdf::World *world = frozen.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  ASSERT_EQ(8u, world->ModelCount());
+  for (uint64_t i = 0; i < world->ModelCount(); ++i)
+    EXPECT_TRUE(world->ModelLoaded(i));
+
+  // Every thread resolves the same poses and queries the spatial indices.
+  std::vector<std::thread> threads;
+  std::vector<int> failures(4, 0);
+  for (std::size_t t = 0; t < failures.size(); ++t)
+  {
+    threads.emplace_back([&, t]()
+    {
+      for (int repeat = 0; repeat < 10; ++repeat)
+      {
+        for (uint64_t i = 0; i < world->ModelCount(); ++i)
+        {
+          const sdf::Model *model = world->ModelByIndex(i);
+          const sdf::Link *link = model->LinkByName("link");
+          Pose3d modelPose;
+          Pose3d linkPose;
+          if (!model->SemanticPose().Resolve(modelPose, "world").empty() ||
+              !link->SemanticPose().Resolve(linkPose).empty() ||
+              modelPose * linkPose !=
+                  Pose3d(static_cast<double>(i), 1, 0, 0, 0, 0))
+          {
+            ++failures[t];
+          }
+        }
+        if (world->ModelsInRadius({0, 0, 0}, 100).size() != 8u ||
+            world->LightsInRadius({0, 0, 0}, 1).size() != 1u)
+        {
+          ++failures[t];
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+  for (int failureCount : failures)
+    EXPECT_EQ(0, failureCount);
+
+  // Editing the world after freezing it still updates the poses.
+  sdf::Model *model = root.WorldByIndex(0)->ModelByIndex(0);
+  ASSERT_NE(nullptr, model);
+  model->SetRawPose(Pose3d(0, 0, 5, 0, 0, 0));
+  errors = root.UpdateGraphs();
+  EXPECT_TRUE(errors.empty()) << errors;
+  Pose3d pose;
+  EXPECT_TRUE(model->SemanticPose().Resolve(pose, "world").empty());
+  EXPECT_EQ(Pose3d(0, 0, 5, 0, 0, 0), pose);
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, FreezeStoresAllPoses)
+{
+  using ignition::math::Pose3d;
+
+  const std::string sdf =
+    "<?xml version=\"1.0\"?>"
+    "<sdf version=\"1.8\">"
+    "  <world name=\"default\">"
+    "    <frame name=\"world_frame\">"
+    "      <pose>0 0 1 0 0 0</pose>"
+    "    </frame>"
+    "    <model name=\"model\">"
+    "      <pose relative_to=\"world_frame\">1 0 0 0 0 0</pose>"
+    "      <link name=\"base\"/>"
+    "      <link name=\"arm\">"
+    "        <pose relative_to=\"joint\">0 1 0 0 0 0</pose>"
+    "      </link>"
+    "      <joint name=\"joint\" type=\"fixed\">"
+    "        <pose relative_to=\"base\">0 0 2 0 0 0</pose>"
+    "        <parent>base</parent>"
+    "        <child>arm</child>"
+    "      </joint>"
+    "      <frame name=\"frame\" attached_to=\"arm\">"
+    "        <pose relative_to=\"arm\">3 0 0 0 0 0</pose>"
+    "      </frame>"
+    "      <model name=\"nested\">"
+    "        <pose relative_to=\"frame\">0 4 0 0 0 0</pose>"
+    "        <link name=\"link\"/>"
+    "      </model>"
+    "    </model>"
+    "  </world>"
+    "</sdf>";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf);
+  EXPECT_TRUE(errors.empty()) << errors;
+  errors = root.Freeze();
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  const sdf::Root &frozen = root;
+  const sdf::World *world = frozen.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  const sdf::Model *model = world->ModelByName("model");
+  ASSERT_NE(nullptr, model);
+  const sdf::Model *nested = model->ModelByName("nested");
+  ASSERT_NE(nullptr, nested);
+
+  // No pose was resolved before freezing, and all of them are read from the
+  // poses stored by Freeze, whatever frame they are resolved relative to.
+  sdf::ResetPerfCounters();
+  auto resolve = [](const sdf::SemanticPose &_semanticPose,
+                    const std::string &_resolveTo = "")
+  {
+    Pose3d pose;
+    sdf::Errors resolveErrors = _semanticPose.Resolve(pose, _resolveTo);
+    EXPECT_TRUE(resolveErrors.empty()) << resolveErrors;
+    return pose;
+  };
+  for (int repeat = 0; repeat < 2; ++repeat)
+  {
+    EXPECT_EQ(Pose3d(0, 0, 1, 0, 0, 0),
+              resolve(world->FrameByName("world_frame")->SemanticPose(),
+                      "world"));
+    EXPECT_EQ(Pose3d(1, 0, 1, 0, 0, 0),
+              resolve(model->SemanticPose(), "world"));
+    EXPECT_EQ(Pose3d(0, -1, -2, 0, 0, 0),
+              resolve(model->LinkByName("base")->SemanticPose(), "arm"));
+    EXPECT_EQ(Pose3d(0, 1, 2, 0, 0, 0),
+              resolve(model->LinkByName("arm")->SemanticPose(), "__model__"));
+    EXPECT_EQ(Pose3d(0, 0, 2, 0, 0, 0),
+              resolve(model->JointByName("joint")->SemanticPose(), "base"));
+    EXPECT_EQ(Pose3d(3, 1, 0, 0, 0, 0),
+              resolve(model->FrameByName("frame")->SemanticPose(), "joint"));
+    EXPECT_EQ(Pose3d(3, 5, 2, 0, 0, 0),
+              resolve(nested->SemanticPose(), "__model__"));
+    EXPECT_EQ(Pose3d::Zero,
+              resolve(nested->LinkByName("link")->SemanticPose()));
+    EXPECT_EQ(Pose3d(-3, -5, -2, 0, 0, 0),
+              resolve(model->LinkByName("base")->SemanticPose(),
+                      "nested::link"));
+  }
+  if (sdf::PerfCountersEnabled())
+    EXPECT_EQ(0u, sdf::GetPerfCounters().poseGraphWalks);
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, ReleaseElements)
+{
+  const std::string sdf =
+    "<?xml version=\"1.0\"?>"
+    "<sdf version=\"1.8\">"
+    "  <world name=\"default\">"
+    "    <model name=\"model\">"
+    "      <pose>1 2 3 0 0 0</pose>"
+    "      <link name=\"link\">"
+    "        <visual name=\"visual\">"
+    "          <geometry><box><size>1 2 3</size></box></geometry>"
+    "        </visual>"
+    "      </link>"
+    "      <plugin name=\"plugin\" filename=\"plugin.so\">"
+    "        <value>42</value>"
+    "      </plugin>"
+    "    </model>"
+    "  </world>"
+    "</sdf>";
+
+  sdf::Root retained;
+  sdf::Errors errors = retained.LoadSdfString(sdf);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_NE(nullptr, retained.Element());
+  ASSERT_NE(nullptr, retained.WorldByIndex(0));
+  EXPECT_NE(nullptr, retained.WorldByIndex(0)->Element());
+
+  sdf::ParserConfig config;
+  config.SetReleaseElements(true);
+  sdf::Root root;
+  errors = root.LoadSdfString(sdf, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(nullptr, root.Element());
+
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  EXPECT_EQ(nullptr, world->Element());
+  const sdf::Model *model = world->ModelByName("model");
+  ASSERT_NE(nullptr, model);
+  EXPECT_EQ(nullptr, model->Element());
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0), model->RawPose());
+  const sdf::Link *link = model->LinkByName("link");
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ(nullptr, link->Element());
+  const sdf::Visual *visual = link->VisualByName("visual");
+  ASSERT_NE(nullptr, visual);
+  EXPECT_EQ(nullptr, visual->Element());
+  ASSERT_NE(nullptr, visual->Geom()->BoxShape());
+  EXPECT_EQ(nullptr, visual->Geom()->BoxShape()->Element());
+  EXPECT_EQ(ignition::math::Vector3d(1, 2, 3),
+            visual->Geom()->BoxShape()->Size());
+
+  // The contents of plugins are part of the DOM, so they are kept
+  ASSERT_EQ(1u, model->Plugins().size());
+  const sdf::Plugin &plugin = model->Plugins()[0];
+  EXPECT_EQ(nullptr, plugin.Element());
+  ASSERT_EQ(1u, plugin.Contents().size());
+  EXPECT_EQ(42, plugin.Contents()[0]->Get<int>());
+
+  // Poses can still be resolved, and the DOM can be written out
+  ignition::math::Pose3d pose;
+  errors = link->SemanticPose().Resolve(pose, "world");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0), pose);
+  sdf::ElementPtr elem = root.ToElement();
+  ASSERT_NE(nullptr, elem);
+  EXPECT_NE(std::string::npos, elem->ToString("").find("<value>42</value>"));
 }
 
 /////////////////////////////////////////////////
@@ -502,3 +1426,495 @@ TEST(DOMRoot, ToElementWorld)
   ASSERT_NE(nullptr, root2.WorldByIndex(1));
   EXPECT_EQ("world2", root2.WorldByIndex(1)->Name());
 }
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, ToStream)
+{
+  const std::string sdfString = R"(
+<sdf version='1.9'>
+  <world name='world'>
+    <model name='model'>
+      <pose>1 2 3 0.1 0.2 0.3</pose>
+      <link name='link'>
+        <inertial>
+          <mass>2.5</mass>
+        </inertial>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  const std::string expected =
+      "<?xml version='1.0'?>\n" + root.ToElement()->ToString("");
+
+  std::ostringstream stream;
+  root.ToStream(stream);
+  EXPECT_EQ(expected, stream.str());
+
+  sdf::PrintConfig printConfig;
+  printConfig.SetRotationInDegrees(true);
+  std::ostringstream degreesStream;
+  root.ToStream(degreesStream, printConfig);
+  EXPECT_EQ("<?xml version='1.0'?>\n" +
+      root.ToElement()->ToString("", printConfig), degreesStream.str());
+  EXPECT_NE(std::string::npos, degreesStream.str().find("degrees='true'"));
+
+  sdf::Root root2;
+  errors = root2.LoadSdfString(stream.str());
+  EXPECT_TRUE(errors.empty()) << errors;
+  ASSERT_NE(nullptr, root2.WorldByIndex(0));
+  EXPECT_NE(nullptr, root2.WorldByIndex(0)->ModelByName("model"));
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, WriteFile)
+{
+  sdf::Root root;
+  sdf::World world;
+  world.SetName("world");
+  root.AddWorld(world);
+
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  std::filesystem::create_directories(tmpDir);
+  const std::string fileName =
+      (std::filesystem::path(tmpDir) / "root_write_file.sdf").string();
+
+  sdf::Errors errors = root.WriteFile(fileName);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_FALSE(std::filesystem::exists(fileName + ".tmp"));
+
+  std::ostringstream expected;
+  root.ToStream(expected);
+  std::ifstream file(fileName);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  EXPECT_EQ(expected.str(), contents.str());
+
+  sdf::Root root2;
+  errors = root2.Load(fileName);
+  EXPECT_TRUE(errors.empty()) << errors;
+  ASSERT_NE(nullptr, root2.WorldByIndex(0));
+  EXPECT_EQ("world", root2.WorldByIndex(0)->Name());
+
+  // The directory of the file does not exist
+  errors = root.WriteFile(
+      (std::filesystem::path(tmpDir) / "missing" / "root.sdf").string());
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::FILE_WRITE, errors[0].Code());
+
+  std::filesystem::remove(fileName);
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, ResolveAssets)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::filesystem::path dir =
+      std::filesystem::path(tmpDir) / "root_resolve_assets";
+  std::filesystem::create_directories(dir / "meshes");
+  std::ofstream(dir / "meshes" / "part.dae") << "mesh";
+
+  const std::string sdf = R"(
+<sdf version='1.9'>
+  <world name='default'>
+    <model name='robot'>
+      <link name='link'>
+        <visual name='visual'>
+          <geometry>
+            <mesh><uri>model://robot/meshes/arm.dae</uri></mesh>
+          </geometry>
+          <material>
+            <pbr>
+              <metal>
+                <albedo_map>model://robot/materials/albedo.png</albedo_map>
+              </metal>
+            </pbr>
+          </material>
+        </visual>
+        <collision name='collision'>
+          <geometry>
+            <mesh><uri>model://robot/meshes/arm.dae</uri></mesh>
+          </geometry>
+        </collision>
+        <collision name='part'>
+          <geometry>
+            <mesh><uri>meshes/part.dae</uri></mesh>
+          </geometry>
+        </collision>
+      </link>
+    </model>
+    <model name='ground'>
+      <static>true</static>
+      <link name='link'>
+        <collision name='collision'>
+          <geometry>
+            <heightmap>
+              <uri>model://ground/missing.png</uri>
+            </heightmap>
+          </geometry>
+        </collision>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+  const std::string fileName = (dir / "world.sdf").string();
+  std::ofstream(fileName) << sdf;
+
+  sdf::Root root;
+  sdf::Errors errors = root.Load(fileName);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_TRUE(root.ResolvedAssets().empty());
+
+  // Each distinct URI is passed to the find callback once, from any thread
+  std::mutex mutex;
+  std::map<std::string, int> calls;
+  sdf::ParserConfig config;
+  config.SetFindCallback([&](const std::string &_uri) -> std::string
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++calls[_uri];
+        if (_uri.find("missing") != std::string::npos)
+          return "";
+        return "/assets/" + _uri.substr(std::string("model://").size());
+      });
+
+  errors = root.ResolveAssets(config, 4);
+  ASSERT_EQ(1u, errors.size()) << errors;
+  EXPECT_EQ(sdf::ErrorCode::URI_LOOKUP, errors[0].Code());
+  EXPECT_NE(std::string::npos, errors[0].Message().find("missing.png"));
+
+  EXPECT_EQ(4u, root.ResolvedAssets().size());
+  EXPECT_EQ(3u, calls.size());
+  for (const auto &[uri, count] : calls)
+    EXPECT_EQ(1, count) << uri;
+
+  EXPECT_EQ("/assets/robot/meshes/arm.dae",
+            root.ResolvedAssetPath("model://robot/meshes/arm.dae"));
+  EXPECT_EQ("/assets/robot/materials/albedo.png",
+            root.ResolvedAssetPath("model://robot/materials/albedo.png"));
+  EXPECT_TRUE(root.ResolvedAssetPath("model://ground/missing.png").empty());
+  EXPECT_TRUE(root.ResolvedAssetPath("model://other.dae").empty());
+
+  // Relative URIs are found next to the file they are written in
+  EXPECT_EQ((dir / "meshes" / "part.dae").string(),
+            root.ResolvedAssetPath("meshes/part.dae", fileName));
+
+  // Resolving serially gives the same table
+  const auto resolved = root.ResolvedAssets();
+  EXPECT_EQ(1u, root.ResolveAssets(config, 1).size());
+  EXPECT_EQ(resolved, root.ResolvedAssets());
+  EXPECT_EQ(resolved, root.Clone().ResolvedAssets());
+
+  std::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, CollectAssetReferences)
+{
+  const std::string sdf = R"(
+<sdf version='1.9'>
+  <world name='default'>
+    <plugin name='world' filename='libworld.so'/>
+    <model name='robot'>
+      <plugin name='control' filename='libcontrol.so'/>
+      <link name='link'>
+        <collision name='collision'>
+          <geometry>
+            <mesh><uri>model://robot/arm.dae</uri></mesh>
+          </geometry>
+        </collision>
+        <visual name='visual'>
+          <geometry>
+            <mesh><uri>model://robot/arm.dae</uri></mesh>
+          </geometry>
+          <material>
+            <pbr>
+              <metal>
+                <albedo_map>model://robot/albedo.png</albedo_map>
+              </metal>
+            </pbr>
+          </material>
+        </visual>
+        <visual name='visual2'>
+          <geometry>
+            <mesh><uri>model://robot/arm.dae</uri></mesh>
+          </geometry>
+        </visual>
+      </link>
+    </model>
+    <actor name='walker'>
+      <skin>
+        <filename>model://walker/walk.dae</filename>
+      </skin>
+      <animation name='walk'>
+        <filename>model://walker/walk.dae</filename>
+      </animation>
+    </actor>
+  </world>
+</sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  // Model 0, link 1, collision 2 and visuals 3 and 4 have IDs
+  const std::vector<sdf::AssetReference> references =
+      root.CollectAssetReferences();
+  ASSERT_EQ(6u, references.size());
+
+  EXPECT_EQ(sdf::AssetType::MESH, references[0].type);
+  EXPECT_EQ("model://robot/arm.dae", references[0].uri);
+  EXPECT_EQ(3u, references[0].referenceCount);
+  EXPECT_EQ(std::vector<uint64_t>({2, 3, 4}), references[0].entityIds);
+
+  EXPECT_EQ(sdf::AssetType::TEXTURE, references[1].type);
+  EXPECT_EQ("model://robot/albedo.png", references[1].uri);
+  EXPECT_EQ(std::vector<uint64_t>({3}), references[1].entityIds);
+
+  // The skin and the animation are the same file, used in two ways
+  EXPECT_EQ(sdf::AssetType::SKIN, references[2].type);
+  EXPECT_EQ(sdf::AssetType::ANIMATION, references[3].type);
+  EXPECT_EQ(references[2].uri, references[3].uri);
+  EXPECT_EQ(1u, references[3].referenceCount);
+  EXPECT_TRUE(references[3].entityIds.empty());
+
+  EXPECT_EQ(sdf::AssetType::PLUGIN, references[4].type);
+  EXPECT_EQ("libcontrol.so", references[4].uri);
+  EXPECT_EQ(std::vector<uint64_t>({0}), references[4].entityIds);
+  EXPECT_EQ("libworld.so", references[5].uri);
+  EXPECT_EQ(1u, references[5].referenceCount);
+  EXPECT_TRUE(references[5].entityIds.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, ReloadIncludedFile)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::filesystem::path dir =
+      std::filesystem::path(tmpDir) / "root_reload_included_file";
+  std::filesystem::create_directories(dir / "robot");
+  std::ofstream(dir / "robot" / "model.config")
+      << "<?xml version='1.0'?>\n"
+      << "<model>\n"
+      << "  <name>robot</name>\n"
+      << "  <sdf version='1.9'>model.sdf</sdf>\n"
+      << "</model>\n";
+  const std::string modelFile = (dir / "robot" / "model.sdf").string();
+  std::ofstream(modelFile)
+      << "<sdf version='1.9'>\n"
+      << "  <model name='robot'>\n"
+      << "    <link name='base'/>\n"
+      << "  </model>\n"
+      << "</sdf>\n";
+
+  const std::string robotDir = (dir / "robot").string();
+  const std::string sdf = R"(
+<sdf version='1.9'>
+  <world name='default'>
+    <model name='box'>
+      <link name='link'/>
+    </model>
+    <include>
+      <uri>)" + robotDir + R"(</uri>
+      <name>robot_a</name>
+      <pose>1 0 0 0 0 0</pose>
+    </include>
+    <model name='holder'>
+      <link name='link'/>
+      <include>
+        <uri>)" + robotDir + R"(</uri>
+        <name>arm</name>
+      </include>
+    </model>
+  </world>
+</sdf>)";
+  const std::string worldFile = (dir / "world.sdf").string();
+  std::ofstream(worldFile) << sdf;
+
+  sdf::ParserConfig config;
+  sdf::Root root;
+  sdf::Errors errors = root.Load(worldFile, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(std::vector<std::string>(
+      {std::filesystem::weakly_canonical(modelFile).string()}),
+      root.IncludedFiles());
+
+  // Files that no model was included from are ignored.
+  errors = root.ReloadIncludedFile(worldFile, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  std::ofstream(modelFile)
+      << "<sdf version='1.9'>\n"
+      << "  <model name='robot'>\n"
+      << "    <link name='base'/>\n"
+      << "    <link name='tool'>\n"
+      << "      <pose>0 0 1 0 0 0</pose>\n"
+      << "    </link>\n"
+      << "  </model>\n"
+      << "</sdf>\n";
+  const auto hashes = root.ModelContentHashes("default");
+  ASSERT_EQ(3u, hashes.size());
+  EXPECT_TRUE(root.ModelContentHashes("missing").empty());
+
+  errors = root.ReloadIncludedFile(modelFile, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  // Only the hashes of the models that include the file changed.
+  const auto reloadedHashes = root.ModelContentHashes("default");
+  ASSERT_EQ(3u, reloadedHashes.size());
+  EXPECT_EQ(hashes.at("box"), reloadedHashes.at("box"));
+  EXPECT_NE(hashes.at("robot_a"), reloadedHashes.at("robot_a"));
+  EXPECT_NE(hashes.at("holder"), reloadedHashes.at("holder"));
+
+  // Both includes of the file were read again, in their place.
+  sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  ASSERT_EQ(3u, world->ModelCount());
+  EXPECT_EQ("box", world->ModelByIndex(0)->Name());
+  EXPECT_EQ("robot_a", world->ModelByIndex(1)->Name());
+  EXPECT_EQ("holder", world->ModelByIndex(2)->Name());
+  EXPECT_EQ(1u, world->ModelByIndex(0)->LinkCount());
+
+  const sdf::Model *robot = world->ModelByName("robot_a");
+  EXPECT_EQ(2u, robot->LinkCount());
+  EXPECT_EQ(ignition::math::Pose3d(1, 0, 0, 0, 0, 0), robot->RawPose());
+  const sdf::Model *arm = world->ModelByName("holder::arm");
+  ASSERT_NE(nullptr, arm);
+  EXPECT_EQ(2u, arm->LinkCount());
+
+  // The graphs of the world include the new links.
+  ignition::math::Pose3d pose;
+  errors = robot->LinkByName("tool")->SemanticPose().Resolve(pose, "world");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(ignition::math::Pose3d(1, 0, 1, 0, 0, 0), pose);
+  errors = arm->LinkByName("tool")->SemanticPose().Resolve(pose, "world");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(ignition::math::Pose3d(0, 0, 1, 0, 0, 0), pose);
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, MaxErrors)
+{
+  // Each frame has an attribute error that does not stop parsing.
+  std::string sdf = "<?xml version=\"1.0\"?><sdf version=\"1.8\">"
+                    "<world name=\"default\">";
+  for (int i = 0; i < 10; ++i)
+  {
+    sdf += "<frame name=\"frame" + std::to_string(i) +
+           "\" attached_to=\"__root__\"/>";
+  }
+  sdf += "</world></sdf>";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf);
+  EXPECT_LE(10u, errors.size());
+  EXPECT_EQ(1u, root.WorldCount());
+
+  // Parsing stops at the limit, and the DOM is not loaded.
+  sdf::ParserConfig config;
+  config.SetMaxErrors(3);
+  sdf::Root limitedRoot;
+  sdf::Errors limitedErrors = limitedRoot.LoadSdfString(sdf, config);
+  ASSERT_LT(3u, limitedErrors.size());
+  EXPECT_GT(errors.size(), limitedErrors.size());
+  for (std::size_t i = 0; i < 3; ++i)
+    EXPECT_EQ(errors[i].Message(), limitedErrors[i].Message());
+  EXPECT_EQ(sdf::ErrorCode::ERROR_LIMIT_REACHED, limitedErrors[3].Code());
+  EXPECT_EQ(0u, limitedRoot.WorldCount());
+
+  // A limit that is not reached does not change loading.
+  config.SetMaxErrors(100);
+  sdf::Root unlimitedRoot;
+  sdf::Errors unlimitedErrors = unlimitedRoot.LoadSdfString(sdf, config);
+  EXPECT_EQ(errors.size(), unlimitedErrors.size());
+  EXPECT_EQ(1u, unlimitedRoot.WorldCount());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMRoot, ShareIdenticalObjects)
+{
+  std::string models;
+  int count = 0;
+  for (const std::string size : {"1 1 1", "1 1 1", "2 2 2"})
+  {
+    models += "    <model name=\"m" + std::to_string(count++) + "\">"
+        "      <link name=\"link\">"
+        "        <collision name=\"collision\">"
+        "          <geometry><box><size>" + size + "</size></box></geometry>"
+        "          <surface><contact>"
+        "            <collide_bitmask>0x02</collide_bitmask>"
+        "          </contact></surface>"
+        "        </collision>"
+        "        <visual name=\"visual\">"
+        "          <geometry><box><size>" + size + "</size></box></geometry>"
+        "          <material><diffuse>1 0 0 1</diffuse></material>"
+        "        </visual>"
+        "      </link>"
+        "    </model>";
+  }
+  const std::string sdf =
+    "<?xml version=\"1.0\"?>"
+    "<sdf version=\"1.9\">"
+    "  <world name=\"default\">" + models + "  </world>"
+    "</sdf>";
+
+  auto collision = [](const sdf::Root &_root, uint64_t _model)
+  {
+    return _root.WorldByIndex(0)->ModelByIndex(_model)->LinkByIndex(0)->
+        CollisionByIndex(0);
+  };
+  auto visual = [](const sdf::Root &_root, uint64_t _model)
+  {
+    return _root.WorldByIndex(0)->ModelByIndex(_model)->LinkByIndex(0)->
+        VisualByIndex(0);
+  };
+
+  // By default each collision and visual has its own objects, with equal
+  // shape IDs for identical geometries.
+  sdf::Root separate;
+  sdf::Errors errors = separate.LoadSdfString(sdf);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_NE(collision(separate, 0)->Geom(), collision(separate, 1)->Geom());
+  EXPECT_EQ(collision(separate, 0)->Geom()->ShapeId(),
+            collision(separate, 1)->Geom()->ShapeId());
+  EXPECT_NE(collision(separate, 0)->Geom()->ShapeId(),
+            collision(separate, 2)->Geom()->ShapeId());
+
+  sdf::ParserConfig config;
+  config.SetShareIdenticalObjects(true);
+  sdf::Root shared;
+  errors = shared.LoadSdfString(sdf, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(collision(shared, 0)->Geom(), collision(shared, 1)->Geom());
+  EXPECT_EQ(collision(shared, 0)->Geom(), visual(shared, 1)->Geom());
+  EXPECT_NE(collision(shared, 0)->Geom(), collision(shared, 2)->Geom());
+  EXPECT_EQ(collision(shared, 0)->Geom()->ShapeId(),
+            collision(separate, 0)->Geom()->ShapeId());
+  EXPECT_EQ(collision(shared, 0)->Surface(), collision(shared, 2)->Surface());
+  EXPECT_EQ(visual(shared, 0)->Material(), visual(shared, 2)->Material());
+  EXPECT_EQ(0x02u,
+      collision(shared, 1)->Surface()->Contact()->CollideBitmask());
+
+  // Setters replace the shared object of one collision only.
+  sdf::Collision *first =
+      shared.WorldByIndex(0)->ModelByIndex(0)->LinkByIndex(0)->
+      CollisionByIndex(0);
+  sdf::Geometry geom = *first->Geom();
+  sdf::Box box;
+  box.SetSize(ignition::math::Vector3d(3, 3, 3));
+  geom.SetBoxShape(box);
+  first->SetGeom(geom);
+  EXPECT_EQ(ignition::math::Vector3d(3, 3, 3),
+            collision(shared, 0)->Geom()->BoxShape()->Size());
+  EXPECT_EQ(ignition::math::Vector3d(1, 1, 1),
+            collision(shared, 1)->Geom()->BoxShape()->Size());
+  EXPECT_NE(collision(shared, 0)->Geom()->ShapeId(),
+            collision(shared, 1)->Geom()->ShapeId());
+}
@@ -21,7 +21,9 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "sdf/parser.hh"
@@ -30,6 +32,10 @@
 #include "sdf/Filesystem.hh"
 #include "sdf/SDFImpl.hh"
 #include "SDFImplPrivate.hh"
+#include "FindFileCache.hh"
+#include "FindFileRequests.hh"
+#include "PerfCounting.hh"
+#include "Utils.hh"
 #include "sdf/sdf_config.h"
 #include "EmbeddedSdf.hh"
 
@@ -41,6 +47,10 @@ inline namespace SDF_VERSION_NAMESPACE
 // returns the version string when possible.
 std::string SDF::version = SDF_VERSION;  // NOLINT(runtime/string)
 
+/// \brief Mutex that protects SDF::version, which is read by every call to
+/// findFile.
+static std::mutex g_versionMutex;
+
 /////////////////////////////////////////////////
 void setFindCallback(std::function<std::string(const std::string &)> _cb)
 {
@@ -56,8 +66,29 @@ std::string findFile(
 }
 
 /////////////////////////////////////////////////
-std::string findFile(const std::string &_filename, bool _searchLocalPath,
-                          bool _useCallback, const ParserConfig &_config)
+/// \brief Check whether a candidate path of sdf::findFile exists.
+/// \param[in] _config Parser configuration, whose resource provider is
+/// used if it has one.
+/// \param[in] _path The path.
+/// \return True if the path exists.
+static bool probeFile(const ParserConfig &_config, const std::string &_path)
+{
+  countPerf(PerfCounter::FIND_FILE_PROBES);
+  return resourceExists(_config, _path);
+}
+
+/////////////////////////////////////////////////
+/// \brief Search for a file, as documented for sdf::findFile.
+/// \param[in] _filename Name of the file to find.
+/// \param[in] _searchLocalPath True to search for the file in the current
+/// working directory.
+/// \param[in] _useCallback True to find a file based on a registered
+/// callback if the file is not found via the normal mechanism.
+/// \param[in] _config Parser configuration.
+/// \param[out] _result The path of the file, and where it was found.
+static void findFileUncached(const std::string &_filename,
+    bool _searchLocalPath, bool _useCallback, const ParserConfig &_config,
+    FindFileCache::Result &_result)
 {
   // Check to see if _filename is URI. If so, resolve the URI path.
   for (const auto &[uriScheme, paths] : _config.URIPathMap())
@@ -78,9 +109,10 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
       {
         // Return the path string if the path + suffix exists.
         std::string pathSuffix = sdf::filesystem::append(path, suffix);
-        if (sdf::filesystem::exists(pathSuffix))
+        if (probeFile(_config, pathSuffix))
         {
-          return pathSuffix;
+          _result = {pathSuffix, path, uriScheme};
+          return;
         }
       }
     }
@@ -97,25 +129,28 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
 
   // Next check the install path.
   std::string path = sdf::filesystem::append(SDF_SHARE_PATH, filename);
-  if (sdf::filesystem::exists(path))
+  if (probeFile(_config, path))
   {
-    return path;
+    _result = {path, SDF_SHARE_PATH, ""};
+    return;
   }
 
   // Next check the versioned install path.
-  path = sdf::filesystem::append(SDF_SHARE_PATH,
-                                 "sdformat" SDF_MAJOR_VERSION_STR,
-                                 sdf::SDF::Version(), filename);
-  if (sdf::filesystem::exists(path))
+  const std::string versionedSharePath = sdf::filesystem::append(
+      SDF_SHARE_PATH, "sdformat" SDF_MAJOR_VERSION_STR, sdf::SDF::Version());
+  path = sdf::filesystem::append(versionedSharePath, filename);
+  if (probeFile(_config, path))
   {
-    return path;
+    _result = {path, versionedSharePath, ""};
+    return;
   }
 
   // Next check to see if the given file exists.
   path = filename;
-  if (sdf::filesystem::exists(path))
+  if (probeFile(_config, path))
   {
-    return path;
+    _result = {path, "", ""};
+    return;
   }
 
   // Next check SDF_PATH environment variable
@@ -134,9 +169,10 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
          iter != paths.end(); ++iter)
     {
       path = sdf::filesystem::append(*iter, filename);
-      if (sdf::filesystem::exists(path))
+      if (probeFile(_config, path))
       {
-        return path;
+        _result = {path, *iter, ""};
+        return;
       }
     }
   }
@@ -144,10 +180,12 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
   // Finally check the local path, if the flag is set.
   if (_searchLocalPath)
   {
-    path = sdf::filesystem::append(sdf::filesystem::current_path(), filename);
-    if (sdf::filesystem::exists(path))
+    const std::string currentPath = sdf::filesystem::current_path();
+    path = sdf::filesystem::append(currentPath, filename);
+    if (probeFile(_config, path))
     {
-      return path;
+      _result = {path, currentPath, ""};
+      return;
     }
   }
 
@@ -155,21 +193,48 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
   // flag has been set
   if (_useCallback)
   {
-    if (!_config.FindFileCallback())
+    if (auto requests = FindFileRequests::Of(_config))
+    {
+      _result.path = requests->Wait(_filename);
+      if (!_result.path.empty())
+        _result.searchRoot = FindFileCache::kCallbackRoot;
+    }
+    else if (!_config.FindFileCallback())
     {
       sdferr << "Tried to use callback in sdf::findFile(), but the callback "
         "is empty.  Did you call sdf::setFindCallback()?\n";
-      return std::string();
     }
     else
     {
-      return _config.FindFileCallback()(_filename);
+      _result.path = _config.FindFileCallback()(_filename);
+      if (!_result.path.empty())
+        _result.searchRoot = FindFileCache::kCallbackRoot;
     }
   }
+}
+
+/////////////////////////////////////////////////
+std::string findFile(const std::string &_filename, bool _searchLocalPath,
+                          bool _useCallback, const ParserConfig &_config)
+{
+  countPerf(PerfCounter::FIND_FILE_CALLS);
+  FindFileCache::Result result;
+  FindFileCache *cache = FindFileCache::Of(_config);
+  if (cache && cache->Find(_filename, _searchLocalPath, _useCallback, result))
+  {
+    return result.path;
+  }
 
-  return std::string();
+  findFileUncached(_filename, _searchLocalPath, _useCallback, _config,
+      result);
+
+  if (cache)
+    cache->Insert(_filename, _searchLocalPath, _useCallback, result);
+
+  return result.path;
 }
 
+
 /////////////////////////////////////////////////
 void addURIPath(const std::string &_uri, const std::string &_path)
 {
@@ -407,12 +472,14 @@ const std::string &SDF::OriginalVersion() const
 /////////////////////////////////////////////////
 std::string SDF::Version()
 {
+  std::lock_guard<std::mutex> lock(g_versionMutex);
   return version;
 }
 
 /////////////////////////////////////////////////
 void SDF::Version(const std::string &_version)
 {
+  std::lock_guard<std::mutex> lock(g_versionMutex);
   version = _version;
 }
 
@@ -432,19 +499,25 @@ ElementPtr SDF::WrapInRoot(const ElementPtr &_sdf)
 const std::string &SDF::EmbeddedSpec(
     const std::string &_filename, const bool _quiet)
 {
-  try
+  const std::string pathname = SDF::Version() + "/" + _filename;
+  if (const EmbeddedSdfFile *file = FindEmbeddedSdf(pathname))
   {
-    const std::string pathname = SDF::Version() + "/" + _filename;
-    return GetEmbeddedSdf().at(pathname);
-  }
-  catch(const std::out_of_range &)
-  {
-    if (!_quiet)
-      sdferr << "Unable to find SDF filename[" << _filename << "] with "
-        << "version " << SDF::Version() << "\n";
+    // The embedded files are string literals. Only the files that are asked
+    // for are copied into strings, once, since a reference is returned.
+    static std::mutex specsMutex;
+    static std::map<std::string_view, std::string> specs;
+    std::lock_guard<std::mutex> lock(specsMutex);
+    auto it = specs.find(file->pathname);
+    if (it == specs.end())
+      it = specs.emplace(file->pathname, std::string(file->content)).first;
+    return it->second;
   }
 
-  // An empty SDF string is returned if a query into the embeddedSdf map fails.
+  if (!_quiet)
+    sdferr << "Unable to find SDF filename[" << _filename << "] with "
+      << "version " << SDF::Version() << "\n";
+
+  // An empty SDF string is returned if the file is not embedded.
   static const std::string emptySdfString;
   return emptySdfString;
 }
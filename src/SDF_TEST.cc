@@ -537,6 +537,20 @@ TEST(SDF, Version)
   EXPECT_STREQ(SDF_VERSION, sdf::SDF::Version().c_str());
 }
 
+/////////////////////////////////////////////////
+TEST(SDF, EmbeddedSpec)
+{
+  const std::string &root = sdf::SDF::EmbeddedSpec("root.sdf", false);
+  EXPECT_NE(std::string::npos, root.find("<element name=\"sdf\""));
+  EXPECT_EQ(&root, &sdf::SDF::EmbeddedSpec("root.sdf", true));
+
+  const std::string &world = sdf::SDF::EmbeddedSpec("world.sdf", false);
+  EXPECT_NE(std::string::npos, world.find("<element name=\"world\""));
+  EXPECT_NE(&root, &world);
+
+  EXPECT_TRUE(sdf::SDF::EmbeddedSpec("missing.sdf", true).empty());
+}
+
 /////////////////////////////////////////////////
 TEST(SDF, FilePath)
 {
@@ -715,6 +729,79 @@ TEST(SDF, WriteURIPath)
   ASSERT_EQ(std::remove(tempFile.c_str()), 0);
   ASSERT_EQ(rmdir(tempDir.c_str()), 0);
 }
+
+/////////////////////////////////////////////////
+TEST(SDF, FindFileCache)
+{
+  std::string tempDir;
+  ASSERT_TRUE(create_new_temp_dir(tempDir));
+  const std::string tempFile = tempDir + "/test.sdf";
+  const std::string missingFile = tempDir + "/missing.sdf";
+
+  sdf::ParserConfig config;
+  EXPECT_FALSE(config.UseFindFileCache());
+  config.SetUseFindFileCache(true);
+  EXPECT_TRUE(config.UseFindFileCache());
+  config.AddURIPath("test://", tempDir);
+
+  sdf::SDF sdf;
+  sdf.Write(tempFile);
+  EXPECT_EQ(tempFile, sdf::findFile("test://test.sdf", false, false, config));
+  EXPECT_EQ("", sdf::findFile("test://missing.sdf", false, false, config));
+
+  // Cached results are returned without checking the file system.
+  sdf.Write(missingFile);
+  ASSERT_EQ(std::remove(tempFile.c_str()), 0);
+  EXPECT_EQ(tempFile, sdf::findFile("test://test.sdf", false, false, config));
+  EXPECT_EQ("", sdf::findFile("test://missing.sdf", false, false, config));
+
+  // Adding a path for the scheme discards the files that were not found, but
+  // keeps the ones found in the existing paths of the scheme.
+  std::string tempDir2;
+  ASSERT_TRUE(create_new_temp_dir(tempDir2));
+  config.AddURIPath("test://", tempDir2);
+  EXPECT_EQ(tempFile, sdf::findFile("test://test.sdf", false, false, config));
+  EXPECT_EQ(missingFile,
+      sdf::findFile("test://missing.sdf", false, false, config));
+
+  config.ClearFindFileCache();
+  EXPECT_EQ("", sdf::findFile("test://test.sdf", false, false, config));
+
+  // Results of the find callback are cached until the callback changes.
+  int callCount = 0;
+  config.SetFindCallback([&callCount](const std::string &)
+  {
+    ++callCount;
+    return "coconut";
+  });
+  EXPECT_EQ("coconut", sdf::findFile("banana", false, true, config));
+  EXPECT_EQ("coconut", sdf::findFile("banana", false, true, config));
+  EXPECT_EQ(1, callCount);
+
+  config.SetFindCallback([&callCount](const std::string &)
+  {
+    ++callCount;
+    return "papaya";
+  });
+  EXPECT_EQ("papaya", sdf::findFile("banana", false, true, config));
+  EXPECT_EQ(2, callCount);
+
+  // Copies of the configuration get their own copy of the cache.
+  sdf::ParserConfig configCopy = config;
+  configCopy.ClearFindFileCache();
+  EXPECT_EQ("papaya", sdf::findFile("banana", false, true, config));
+  EXPECT_EQ(2, callCount);
+
+  config.SetUseFindFileCache(false);
+  EXPECT_FALSE(config.UseFindFileCache());
+  EXPECT_EQ("papaya", sdf::findFile("banana", false, true, config));
+  EXPECT_EQ(3, callCount);
+
+  // Cleanup
+  ASSERT_EQ(std::remove(missingFile.c_str()), 0);
+  ASSERT_EQ(rmdir(tempDir.c_str()), 0);
+  ASSERT_EQ(rmdir(tempDir2.c_str()), 0);
+}
 #endif  // _WIN32
 
 /////////////////////////////////////////////////
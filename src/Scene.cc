@@ -58,7 +58,7 @@ Errors Scene::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <scene> element.
   // This is an error that cannot be recovered, so return an error.
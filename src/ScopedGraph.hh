@@ -19,15 +19,23 @@
 #define SDF_SCOPED_GRAPH_HH
 
 #include <algorithm>
+#include <cstddef>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/graph/Graph.hh>
 
+#include "sdf/KinematicTree.hh"
 #include "sdf/sdf_config.h"
+#include "FlatGraph.hh"
+#include "PerfCounting.hh"
 
 namespace sdf
 {
@@ -46,6 +54,66 @@ struct ScopedGraphData
 
   /// \brief The context name of this scope. Either world or __model__
   std::string scopeContextName {};
+
+  /// \brief Poses of vertices relative to the scope vertex that were
+  /// resolved from a PoseRelativeToGraph, keyed by vertex ID.
+  std::unordered_map<ignition::math::graph::VertexId, ignition::math::Pose3d>
+      resolvedPoses {};
+
+  /// \brief Links of a group of links welded by fixed joints, with their
+  /// poses relative to a frame.
+  using LinkPoses = std::vector<std::pair<std::string, ignition::math::Pose3d>>;
+
+  /// \brief Groups of links welded by fixed joints that were resolved by
+  /// Model::ResolveCompositeInertial, keyed by the scoped name of a link of
+  /// the group and the name of the frame that the poses are relative to.
+  std::map<std::pair<std::string, std::string>, LinkPoses>
+      resolvedLinkGroups {};
+
+  /// \brief Kinematic trees that were resolved by
+  /// Model::ResolveKinematicTree, keyed by the name of the model.
+  std::unordered_map<std::string, KinematicTree> resolvedKinematicTrees {};
+
+  /// \brief Poses of the collisions of a model and of its nested models
+  /// relative to the model frame that were resolved by Model::ResolveBounds,
+  /// keyed by the name of the model.
+  std::unordered_map<std::string, std::vector<ignition::math::Pose3d>>
+      resolvedCollisionPoses {};
+
+  /// \brief Bodies that frames are attached to that were resolved from a
+  /// FrameAttachedToGraph, keyed by the local name of the frame.
+  std::unordered_map<std::string, std::string> resolvedBodies {};
+
+  /// \brief Poses of frames relative to other frames that were resolved
+  /// from a PoseRelativeToGraph, keyed by the local names of the frame and
+  /// of the frame that the pose is relative to.
+  std::map<std::pair<std::string, std::string>, ignition::math::Pose3d>
+      resolvedRelativePoses {};
+
+  /// \brief Revision of the graph that the resolved poses, link groups and
+  /// bodies were resolved from.
+  std::size_t resolvedPosesRevision {0};
+
+  /// \brief Mutex that protects the resolved poses, link groups and bodies,
+  /// since they are resolved through const DOM objects that may be used
+  /// from several threads. It is not locked to read them once the graph is
+  /// sealed.
+  std::mutex resolvedPosesMutex {};
+
+  /// \brief IDs of the vertices of the scope keyed by their local names,
+  /// stored as the names are looked up once the graph is frozen, so that
+  /// the prefix of the scope is only prepended to each name once. Names
+  /// that were not found are stored with kNullId.
+  std::unordered_map<std::string, ignition::math::graph::VertexId>
+      localVertexIds {};
+
+  /// \brief Revision of the graph that localVertexIds was built from, if
+  /// it was built.
+  std::optional<std::size_t> localVertexIdsRevision {};
+
+  /// \brief Mutex that protects localVertexIds, which is built by the
+  /// first lookup through a const DOM object.
+  std::mutex localVertexIdsMutex {};
 };
 
 // Forward declarations for static_assert
@@ -144,6 +212,12 @@ class ScopedGraph
   // \return A new scope anchored at the root of the graph
   public: ScopedGraph<T> RootScope() const;
 
+  /// \brief Create the same scope on a copy of the underlying graph, so that
+  /// the copy can be modified without affecting the graph of this scope.
+  /// \return A scope with the prefix, scope vertex and context name of this
+  /// scope, on a new copy of the graph.
+  public: ScopedGraph<T> CopyGraph() const;
+
   /// \brief Checks if the scope points to a valid graph.
   /// \return True if the scope points to a valid graph.
   public: explicit operator bool() const;
@@ -184,6 +258,11 @@ class ScopedGraph
   public: Edge &AddEdge(const ignition::math::graph::VertexId_P &_vertexPair,
               const EdgeType &_data);
 
+  /// \brief Removes a vertex, and every edge connected to it, from the graph.
+  /// \param[in] _id ID of the vertex to remove.
+  /// \return True if the vertex was removed.
+  public: bool RemoveVertex(const VertexId &_id);
+
   /// \brief Gets all the local names of the vertices in the current scope.
   /// \return A list of vertex names in the current scope.
   public: std::vector<std::string> VertexNames() const;
@@ -207,6 +286,145 @@ class ScopedGraph
   /// \param[in] _data The new data.
   public: void UpdateEdge(Edge &_edge, const EdgeType &_data);
 
+  /// \brief Get the pose of a vertex relative to the scope vertex that was
+  /// stored with SetResolvedPose, if the graph was not modified since.
+  /// \param[in] _id ID of the vertex.
+  /// \return The stored pose, or nullopt if there is none.
+  public: std::optional<ignition::math::Pose3d> ResolvedPose(
+              const VertexId &_id) const;
+
+  /// \brief Store the pose of a vertex relative to the scope vertex, so that
+  /// it does not have to be resolved again. The stored poses of every scope
+  /// are discarded when the graph is modified with AddVertex, AddEdge,
+  /// RemoveVertex or UpdateEdge.
+  /// \param[in] _id ID of the vertex.
+  /// \param[in] _pose Pose of the vertex relative to the scope vertex.
+  public: void SetResolvedPose(const VertexId &_id,
+                               const ignition::math::Pose3d &_pose) const;
+
+  /// \brief Get a group of welded links stored with SetResolvedLinkGroup,
+  /// if the graph was not modified since.
+  /// \param[in] _link Scoped name of a link of the group.
+  /// \param[in] _resolveTo Name of the frame the poses are relative to.
+  /// \return The stored links and poses, or nullopt if there are none.
+  public: std::optional<ScopedGraphData::LinkPoses> ResolvedLinkGroup(
+              const std::string &_link, const std::string &_resolveTo) const;
+
+  /// \brief Store a group of welded links, so that it does not have to be
+  /// resolved again. Like the poses stored with SetResolvedPose, the groups
+  /// are discarded when the graph is modified.
+  /// \param[in] _link Scoped name of a link of the group.
+  /// \param[in] _resolveTo Name of the frame the poses are relative to.
+  /// \param[in] _group The links of the group and their poses.
+  public: void SetResolvedLinkGroup(const std::string &_link,
+              const std::string &_resolveTo,
+              const ScopedGraphData::LinkPoses &_group) const;
+
+  /// \brief Get a kinematic tree stored with SetResolvedKinematicTree, if
+  /// the graph was not modified since.
+  /// \param[in] _model Name of the model of the tree.
+  /// \return The stored tree, or nullopt if there is none.
+  public: std::optional<KinematicTree> ResolvedKinematicTree(
+              const std::string &_model) const;
+
+  /// \brief Store the kinematic tree of a model, so that it does not have to
+  /// be resolved again. Like the poses stored with SetResolvedPose, the
+  /// trees are discarded when the graph is modified.
+  /// \param[in] _model Name of the model of the tree.
+  /// \param[in] _tree The tree.
+  public: void SetResolvedKinematicTree(const std::string &_model,
+              const KinematicTree &_tree) const;
+
+  /// \brief Get the collision poses stored with SetResolvedCollisionPoses,
+  /// if the graph was not modified since.
+  /// \param[in] _model Name of the model of the collisions.
+  /// \return The stored poses, or nullopt if there are none.
+  public: std::optional<std::vector<ignition::math::Pose3d>>
+              ResolvedCollisionPoses(const std::string &_model) const;
+
+  /// \brief Store the poses of the collisions of a model, so that they do
+  /// not have to be resolved again. Like the poses stored with
+  /// SetResolvedPose, they are discarded when the graph is modified.
+  /// \param[in] _model Name of the model of the collisions.
+  /// \param[in] _poses The poses.
+  public: void SetResolvedCollisionPoses(const std::string &_model,
+              const std::vector<ignition::math::Pose3d> &_poses) const;
+
+  /// \brief Get the body that a frame is attached to that was stored with
+  /// SetResolvedBody, if the graph was not modified since.
+  /// \param[in] _name Local name of the frame.
+  /// \return Local name of the body, or nullopt if there is none.
+  public: std::optional<std::string> ResolvedBody(
+              const std::string &_name) const;
+
+  /// \brief Store the body that a frame is attached to, so that it does not
+  /// have to be resolved again. Like the poses stored with SetResolvedPose,
+  /// the bodies are discarded when the graph is modified.
+  /// \param[in] _name Local name of the frame.
+  /// \param[in] _body Local name of the body.
+  public: void SetResolvedBody(const std::string &_name,
+                               const std::string &_body) const;
+
+  /// \brief Get the pose of a frame relative to another frame that was
+  /// stored with SetResolvedRelativePose, if the graph was not modified
+  /// since.
+  /// \param[in] _name Local name of the frame.
+  /// \param[in] _resolveTo Local name of the frame the pose is relative to.
+  /// \return The stored pose, or nullopt if there is none.
+  public: std::optional<ignition::math::Pose3d> ResolvedRelativePose(
+              const std::string &_name, const std::string &_resolveTo) const;
+
+  /// \brief Store the pose of a frame relative to another frame, so that it
+  /// does not have to be resolved again. Like the poses stored with
+  /// SetResolvedPose, these poses are discarded when the graph is modified.
+  /// \param[in] _name Local name of the frame.
+  /// \param[in] _resolveTo Local name of the frame the pose is relative to.
+  /// \param[in] _pose Pose of the frame relative to _resolveTo.
+  public: void SetResolvedRelativePose(const std::string &_name,
+              const std::string &_resolveTo,
+              const ignition::math::Pose3d &_pose) const;
+
+  /// \brief Discard the resolved poses, link groups and bodies if the graph
+  /// was modified since they were stored. resolvedPosesMutex has to be
+  /// locked.
+  private: void DiscardStaleResolved() const;
+
+  /// \brief Make the resolved poses, link groups and bodies of all the
+  /// scopes of the graph read-only until the graph is modified. They are
+  /// then read without locking, and poses resolved afterwards are not
+  /// stored, so the graph can be used from several threads without
+  /// synchronization. The graph should be frozen first.
+  public: void Seal();
+
+  /// \brief Check whether the graph is sealed and was not modified since.
+  /// \return True if the resolved poses, link groups and bodies are
+  /// read-only.
+  public: bool Sealed() const;
+
+  /// \brief Lock resolvedPosesMutex to read the resolved poses, link
+  /// groups and bodies, unless the graph is sealed.
+  /// \return The lock, which does not own the mutex if the graph is sealed.
+  private: std::unique_lock<std::mutex> LockResolved() const;
+
+  /// \brief Build a flat copy of the whole graph that is used to answer
+  /// queries until the graph is modified again. This should be called once
+  /// the graph is completely built.
+  public: void Freeze();
+
+  /// \brief Get the flat copy of the graph built by Freeze.
+  /// \return The flat copy, or nullptr if Freeze was not called or the graph
+  /// was modified since.
+  public: const FlatGraph<EdgeType> *Flat() const;
+
+  /// \brief Get the sink vertex that is reached from a vertex by following
+  /// outgoing edges, as precomputed by Freeze. In a FrameAttachedTo graph,
+  /// this is the body the frame of the vertex is attached to.
+  /// \param[in] _id ID of the vertex.
+  /// \return ID of the sink vertex, or kNullId if the graph was not frozen,
+  /// was modified since, or there is no unique sink. The graph has to be
+  /// traversed to find out why in that case.
+  public: VertexId SinkVertexId(const VertexId &_id) const;
+
   /// \brief Count the number of vertices with a given local name in the scope.
   /// \param[in] _name Local name query
   /// \return Number of vertices that have the given local name in the scope.
@@ -253,6 +471,14 @@ class ScopedGraph
   public: std::pair<std::string, bool> FindAndRemovePrefix(
               const std::string &_name) const;
 
+  /// \brief Find a vertex by its local name. The prefix is prepended to the
+  /// name and it is looked up in the map of the graph. Once the graph is
+  /// frozen, the result is also stored in a table of the local names of the
+  /// scope.
+  /// \param[in] _name Local name of the vertex.
+  /// \return ID of the vertex, or kNullId if there is none.
+  private: VertexId FindVertexId(const std::string &_name) const;
+
   /// \brief Shared pointer to either a FrameAttachedToGraph or
   /// PoseRelativeToGraph.
   private: std::shared_ptr<T> graphPtr;
@@ -296,6 +522,17 @@ ScopedGraph<T> ScopedGraph<T>::RootScope() const
   return newScopedGraph;
 }
 
+/////////////////////////////////////////////////
+template <typename T>
+ScopedGraph<T> ScopedGraph<T>::CopyGraph() const
+{
+  ScopedGraph<T> newScopedGraph(std::make_shared<T>(*this->graphPtr));
+  newScopedGraph.dataPtr->prefix = this->dataPtr->prefix;
+  newScopedGraph.dataPtr->scopeVertexId = this->dataPtr->scopeVertexId;
+  newScopedGraph.dataPtr->scopeContextName = this->dataPtr->scopeContextName;
+  return newScopedGraph;
+}
+
 /////////////////////////////////////////////////
 template <typename T>
 ScopedGraph<T>::operator bool() const
@@ -339,7 +576,9 @@ auto ScopedGraph<T>::AddVertex(
 {
   const std::string newName = this->AddPrefix(_name);
   Vertex &vert = this->graphPtr->graph.AddVertex(newName, _data);
+  countPerf(PerfCounter::GRAPH_VERTICES_BUILT);
   this->graphPtr->map[newName] = vert.Id();
+  ++this->graphPtr->revision;
   return vert;
 }
 
@@ -350,9 +589,26 @@ auto ScopedGraph<T>::AddEdge(
     -> Edge &
 {
   Edge &edge = this->graphPtr->graph.AddEdge(_vertexPair, _data);
+  ++this->graphPtr->revision;
   return edge;
 }
 
+/////////////////////////////////////////////////
+template <typename T>
+bool ScopedGraph<T>::RemoveVertex(const VertexId &_id)
+{
+  auto &graph = this->graphPtr->graph;
+  const std::string name = graph.VertexFromId(_id).Name();
+  if (!graph.RemoveVertex(_id))
+    return false;
+
+  auto it = this->graphPtr->map.find(name);
+  if (it != this->graphPtr->map.end() && it->second == _id)
+    this->graphPtr->map.erase(it);
+  ++this->graphPtr->revision;
+  return true;
+}
+
 /////////////////////////////////////////////////
 template <typename T>
 std::vector<std::string> ScopedGraph<T>::VertexNames() const
@@ -394,6 +650,242 @@ void ScopedGraph<T>::UpdateEdge(Edge &_edge, const EdgeType &_data)
   auto &graph = this->graphPtr->graph;
   graph.RemoveEdge(_edge.Id());
   _edge = graph.AddEdge({tailVertexId, headVertexId}, _data);
+  ++this->graphPtr->revision;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+std::optional<ignition::math::Pose3d> ScopedGraph<T>::ResolvedPose(
+    const VertexId &_id) const
+{
+  auto lock = this->LockResolved();
+  if (this->dataPtr->resolvedPosesRevision != this->graphPtr->revision)
+    return std::nullopt;
+
+  auto it = this->dataPtr->resolvedPoses.find(_id);
+  if (it == this->dataPtr->resolvedPoses.end())
+    return std::nullopt;
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::SetResolvedPose(const VertexId &_id,
+    const ignition::math::Pose3d &_pose) const
+{
+  if (this->Sealed())
+    return;
+  std::lock_guard<std::mutex> lock(this->dataPtr->resolvedPosesMutex);
+  this->DiscardStaleResolved();
+  this->dataPtr->resolvedPoses[_id] = _pose;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+std::optional<ScopedGraphData::LinkPoses> ScopedGraph<T>::ResolvedLinkGroup(
+    const std::string &_link, const std::string &_resolveTo) const
+{
+  auto lock = this->LockResolved();
+  if (this->dataPtr->resolvedPosesRevision != this->graphPtr->revision)
+    return std::nullopt;
+
+  auto it = this->dataPtr->resolvedLinkGroups.find({_link, _resolveTo});
+  if (it == this->dataPtr->resolvedLinkGroups.end())
+    return std::nullopt;
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::SetResolvedLinkGroup(const std::string &_link,
+    const std::string &_resolveTo,
+    const ScopedGraphData::LinkPoses &_group) const
+{
+  if (this->Sealed())
+    return;
+  std::lock_guard<std::mutex> lock(this->dataPtr->resolvedPosesMutex);
+  this->DiscardStaleResolved();
+  this->dataPtr->resolvedLinkGroups[{_link, _resolveTo}] = _group;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+std::optional<KinematicTree> ScopedGraph<T>::ResolvedKinematicTree(
+    const std::string &_model) const
+{
+  auto lock = this->LockResolved();
+  if (this->dataPtr->resolvedPosesRevision != this->graphPtr->revision)
+    return std::nullopt;
+
+  auto it = this->dataPtr->resolvedKinematicTrees.find(_model);
+  if (it == this->dataPtr->resolvedKinematicTrees.end())
+    return std::nullopt;
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::SetResolvedKinematicTree(const std::string &_model,
+    const KinematicTree &_tree) const
+{
+  if (this->Sealed())
+    return;
+  std::lock_guard<std::mutex> lock(this->dataPtr->resolvedPosesMutex);
+  this->DiscardStaleResolved();
+  this->dataPtr->resolvedKinematicTrees[_model] = _tree;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+std::optional<std::vector<ignition::math::Pose3d>>
+ScopedGraph<T>::ResolvedCollisionPoses(const std::string &_model) const
+{
+  auto lock = this->LockResolved();
+  if (this->dataPtr->resolvedPosesRevision != this->graphPtr->revision)
+    return std::nullopt;
+
+  auto it = this->dataPtr->resolvedCollisionPoses.find(_model);
+  if (it == this->dataPtr->resolvedCollisionPoses.end())
+    return std::nullopt;
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::SetResolvedCollisionPoses(const std::string &_model,
+    const std::vector<ignition::math::Pose3d> &_poses) const
+{
+  if (this->Sealed())
+    return;
+  std::lock_guard<std::mutex> lock(this->dataPtr->resolvedPosesMutex);
+  this->DiscardStaleResolved();
+  this->dataPtr->resolvedCollisionPoses[_model] = _poses;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+std::optional<std::string> ScopedGraph<T>::ResolvedBody(
+    const std::string &_name) const
+{
+  auto lock = this->LockResolved();
+  if (this->dataPtr->resolvedPosesRevision != this->graphPtr->revision)
+    return std::nullopt;
+
+  auto it = this->dataPtr->resolvedBodies.find(_name);
+  if (it == this->dataPtr->resolvedBodies.end())
+    return std::nullopt;
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::SetResolvedBody(const std::string &_name,
+    const std::string &_body) const
+{
+  if (this->Sealed())
+    return;
+  std::lock_guard<std::mutex> lock(this->dataPtr->resolvedPosesMutex);
+  this->DiscardStaleResolved();
+  this->dataPtr->resolvedBodies[_name] = _body;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+std::optional<ignition::math::Pose3d> ScopedGraph<T>::ResolvedRelativePose(
+    const std::string &_name, const std::string &_resolveTo) const
+{
+  auto lock = this->LockResolved();
+  if (this->dataPtr->resolvedPosesRevision != this->graphPtr->revision)
+    return std::nullopt;
+
+  auto it = this->dataPtr->resolvedRelativePoses.find({_name, _resolveTo});
+  if (it == this->dataPtr->resolvedRelativePoses.end())
+    return std::nullopt;
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::SetResolvedRelativePose(const std::string &_name,
+    const std::string &_resolveTo, const ignition::math::Pose3d &_pose) const
+{
+  if (this->Sealed())
+    return;
+  std::lock_guard<std::mutex> lock(this->dataPtr->resolvedPosesMutex);
+  this->DiscardStaleResolved();
+  this->dataPtr->resolvedRelativePoses[{_name, _resolveTo}] = _pose;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::DiscardStaleResolved() const
+{
+  if (this->dataPtr->resolvedPosesRevision != this->graphPtr->revision)
+  {
+    this->dataPtr->resolvedPoses.clear();
+    this->dataPtr->resolvedLinkGroups.clear();
+    this->dataPtr->resolvedKinematicTrees.clear();
+    this->dataPtr->resolvedCollisionPoses.clear();
+    this->dataPtr->resolvedBodies.clear();
+    this->dataPtr->resolvedRelativePoses.clear();
+    this->dataPtr->resolvedPosesRevision = this->graphPtr->revision;
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::Seal()
+{
+  if (!this->graphPtr)
+    return;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->resolvedPosesMutex);
+    this->DiscardStaleResolved();
+  }
+  this->graphPtr->sealedRevision = this->graphPtr->revision;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+bool ScopedGraph<T>::Sealed() const
+{
+  return this->graphPtr &&
+         this->graphPtr->sealedRevision == this->graphPtr->revision;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+std::unique_lock<std::mutex> ScopedGraph<T>::LockResolved() const
+{
+  if (this->Sealed())
+    return std::unique_lock<std::mutex>();
+  return std::unique_lock<std::mutex>(this->dataPtr->resolvedPosesMutex);
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::Freeze()
+{
+  this->graphPtr->flat.Build(this->graphPtr->graph, this->graphPtr->revision);
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+auto ScopedGraph<T>::Flat() const -> const FlatGraph<EdgeType> *
+{
+  if (!this->graphPtr->flat.Current(this->graphPtr->revision))
+    return nullptr;
+  return &this->graphPtr->flat;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+auto ScopedGraph<T>::SinkVertexId(const VertexId &_id) const -> VertexId
+{
+  const auto *flat = this->Flat();
+  if (nullptr == flat)
+    return ignition::math::graph::kNullId;
+  return flat->Sink(_id);
 }
 
 /////////////////////////////////////////////////
@@ -414,19 +906,61 @@ void ScopedGraph<T>::SetScopeContextName(const std::string &_name)
 template <typename T>
 std::size_t ScopedGraph<T>::Count(const std::string &_name) const
 {
-  return this->graphPtr->map.count(this->AddPrefix(_name));
+  return ignition::math::graph::kNullId != this->FindVertexId(_name) ? 1 : 0;
 }
 
 /////////////////////////////////////////////////
 template <typename T>
 auto ScopedGraph<T>::VertexIdByName(const std::string &_name) const -> VertexId
 {
-  auto &map = this->Map();
-  auto it = map.find(this->AddPrefix(_name));
-  if (it != map.end())
-    return it->second;
-  else
-    return ignition::math::graph::kNullId;
+  return this->FindVertexId(_name);
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+auto ScopedGraph<T>::FindVertexId(const std::string &_name) const -> VertexId
+{
+  const auto &map = this->Map();
+  const std::string &prefix = this->dataPtr->prefix;
+  if (prefix.empty() || !this->graphPtr->flat.Current(this->graphPtr->revision))
+  {
+    auto it = map.find(prefix.empty() ? _name : this->AddPrefix(_name));
+    return it != map.end() ? it->second : ignition::math::graph::kNullId;
+  }
+
+  // The names stored before the graph was sealed are read without locking,
+  // and other names are not stored.
+  if (this->Sealed())
+  {
+    if (this->dataPtr->localVertexIdsRevision == this->graphPtr->revision)
+    {
+      auto it = this->dataPtr->localVertexIds.find(_name);
+      if (it != this->dataPtr->localVertexIds.end())
+        return it->second;
+    }
+    auto it = map.find(this->AddPrefix(_name));
+    return it != map.end() ? it->second : ignition::math::graph::kNullId;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->localVertexIdsMutex);
+  auto &localVertexIds = this->dataPtr->localVertexIds;
+  if (this->dataPtr->localVertexIdsRevision != this->graphPtr->revision)
+  {
+    localVertexIds.clear();
+    this->dataPtr->localVertexIdsRevision = this->graphPtr->revision;
+  }
+
+  // Only the names that are looked up are stored. Copying every name of the
+  // scope would copy the names of all the nested models into the table of
+  // each nested scope, which grows with the square of the nesting depth.
+  auto it = localVertexIds.find(_name);
+  if (it == localVertexIds.end())
+  {
+    auto mapIt = map.find(this->AddPrefix(_name));
+    it = localVertexIds.emplace(_name, mapIt != map.end() ? mapIt->second :
+        ignition::math::graph::kNullId).first;
+  }
+  return it->second;
 }
 
 /////////////////////////////////////////////////
@@ -461,7 +995,10 @@ std::string ScopedGraph<T>::AddPrefix(const std::string &_name) const
   }
   else
   {
-    return this->dataPtr->prefix + "::" + _name;
+    std::string name;
+    name.reserve(this->dataPtr->prefix.size() + 2 + _name.size());
+    name.append(this->dataPtr->prefix).append("::").append(_name);
+    return name;
   }
 }
 
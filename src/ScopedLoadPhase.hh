@@ -0,0 +1,133 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_SCOPEDLOADPHASE_HH
+#define SDFORMAT_SCOPEDLOADPHASE_HH
+
+#include <chrono>
+#include <string>
+
+#include "sdf/LoadProfile.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Records the time spent in a phase of loading a document, from
+  /// the creation of this object to its destruction, in a LoadProfile.
+  /// Scopes can be nested on a thread. The time of a nested scope is
+  /// subtracted from the time of the scope that contains it, so that each
+  /// phase only gets the time spent in it. When no profile is set, a scope
+  /// does not read the clock.
+  class ScopedLoadPhase
+  {
+    /// \brief Constructor for the entry points of the parser.
+    /// \param[in] _config Parser configuration, recording to its profile if
+    /// it has one.
+    /// \param[in] _phase The phase.
+    public: ScopedLoadPhase(const ParserConfig &_config, LoadPhase _phase)
+      : ScopedLoadPhase(_config.Profile().get(), _phase)
+    {
+    }
+
+    /// \brief Constructor for code without access to the parser
+    /// configuration.
+    /// \param[in] _phase The phase, recorded to the profile of the innermost
+    /// scope of the calling thread, if any.
+    public: explicit ScopedLoadPhase(LoadPhase _phase)
+      : ScopedLoadPhase(Current() ? Current()->profile : nullptr, _phase)
+    {
+    }
+
+    /// \brief Destructor. Records the time of the phase.
+    public: ~ScopedLoadPhase()
+    {
+      if (!this->profile)
+        return;
+
+      const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - this->start);
+      this->profile->Record(this->phase, elapsed - this->nested);
+      if (!this->includedFile.empty())
+        this->profile->RecordInclude(this->includedFile, elapsed);
+      if (this->previous)
+        this->previous->nested += elapsed;
+      Current() = this->previous;
+    }
+
+    /// \brief No copy constructor.
+    public: ScopedLoadPhase(const ScopedLoadPhase &) = delete;
+
+    /// \brief No copy assignment.
+    public: ScopedLoadPhase &operator=(const ScopedLoadPhase &) = delete;
+
+    /// \brief Also record the whole time of this scope, including the nested
+    /// scopes, as an inclusion of a file.
+    /// \param[in] _fileName Full path of the included file.
+    public: void SetIncludedFile(const std::string &_fileName)
+    {
+      if (this->profile)
+        this->includedFile = _fileName;
+    }
+
+    /// \brief Constructor.
+    /// \param[in] _profile Profile to record to, or nullptr to record
+    /// nothing.
+    /// \param[in] _phase The phase.
+    private: ScopedLoadPhase(LoadProfile *_profile, LoadPhase _phase)
+      : profile(_profile), phase(_phase)
+    {
+      if (!this->profile)
+        return;
+
+      this->previous = Current();
+      Current() = this;
+      this->start = std::chrono::steady_clock::now();
+    }
+
+    /// \brief Get the innermost scope of the calling thread.
+    /// \return Reference to the scope, or to nullptr if there is none.
+    private: static ScopedLoadPhase *&Current()
+    {
+      static thread_local ScopedLoadPhase *current = nullptr;
+      return current;
+    }
+
+    /// \brief Profile to record to, or nullptr.
+    private: LoadProfile *profile;
+
+    /// \brief The phase.
+    private: LoadPhase phase;
+
+    /// \brief Scope that was the innermost one when this one was created.
+    private: ScopedLoadPhase *previous = nullptr;
+
+    /// \brief Time at which this scope was created.
+    private: std::chrono::steady_clock::time_point start;
+
+    /// \brief Time spent in the nested scopes.
+    private: std::chrono::nanoseconds nested{0};
+
+    /// \brief Full path of the included file, if any.
+    private: std::string includedFile;
+  };
+  }
+}
+#endif
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDFORMAT_SCOPEDTRACEEVENT_HH
+#define SDFORMAT_SCOPEDTRACEEVENT_HH
+
+#include <chrono>
+#include <string>
+
+#include "sdf/LoadTrace.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Records an event of a LoadTrace, from the creation of this
+  /// object to its destruction. Events can be nested on a thread, and nested
+  /// events without access to the parser configuration are recorded to the
+  /// trace of the innermost event of the thread. When no trace is set, an
+  /// event does not read the clock nor copy its detail.
+  class ScopedTraceEvent
+  {
+    /// \brief Constructor for the entry points of the parser.
+    /// \param[in] _config Parser configuration, recording to its trace if it
+    /// has one.
+    /// \param[in] _name Name of the event, which must outlive this object.
+    /// \param[in] _category Category of the event, which must outlive this
+    /// object.
+    /// \param[in] _detail Detail of the event, such as a file name.
+    public: ScopedTraceEvent(const ParserConfig &_config, const char *_name,
+                             const char *_category,
+                             const std::string &_detail = "")
+      : ScopedTraceEvent(_config.Trace().get(), _name, _category, _detail)
+    {
+    }
+
+    /// \brief Constructor for code without access to the parser
+    /// configuration.
+    /// \param[in] _name Name of the event, which must outlive this object.
+    /// \param[in] _category Category of the event, which must outlive this
+    /// object.
+    /// \param[in] _detail Detail of the event, such as a file name.
+    public: ScopedTraceEvent(const char *_name, const char *_category,
+                             const std::string &_detail = "")
+      : ScopedTraceEvent(Current(), _name, _category, _detail)
+    {
+    }
+
+    /// \brief Destructor. Records the event.
+    public: ~ScopedTraceEvent()
+    {
+      if (!this->trace)
+        return;
+
+      this->trace->Record(this->name, this->category, this->start,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - this->start),
+          this->detail);
+      Current() = this->previous;
+    }
+
+    /// \brief No copy constructor.
+    public: ScopedTraceEvent(const ScopedTraceEvent &) = delete;
+
+    /// \brief No copy assignment.
+    public: ScopedTraceEvent &operator=(const ScopedTraceEvent &) = delete;
+
+    /// \brief Set the detail of the event, when it is only known after the
+    /// event started.
+    /// \param[in] _detail Detail of the event, such as a file name.
+    public: void SetDetail(const std::string &_detail)
+    {
+      if (this->trace)
+        this->detail = _detail;
+    }
+
+    /// \brief Constructor.
+    /// \param[in] _trace Trace to record to, or nullptr to record nothing.
+    /// \param[in] _name Name of the event.
+    /// \param[in] _category Category of the event.
+    /// \param[in] _detail Detail of the event.
+    private: ScopedTraceEvent(LoadTrace *_trace, const char *_name,
+                              const char *_category,
+                              const std::string &_detail)
+      : trace(_trace), name(_name), category(_category)
+    {
+      if (!this->trace)
+        return;
+
+      this->detail = _detail;
+      this->previous = Current();
+      Current() = this->trace;
+      this->start = std::chrono::steady_clock::now();
+    }
+
+    /// \brief Get the trace of the innermost event of the calling thread.
+    /// \return Reference to the trace, or to nullptr if there is none.
+    private: static LoadTrace *&Current()
+    {
+      static thread_local LoadTrace *current = nullptr;
+      return current;
+    }
+
+    /// \brief Trace to record to, or nullptr.
+    private: LoadTrace *trace;
+
+    /// \brief Name of the event.
+    private: const char *name;
+
+    /// \brief Category of the event.
+    private: const char *category;
+
+    /// \brief Detail of the event.
+    private: std::string detail;
+
+    /// \brief Trace of the innermost event when this one was created.
+    private: LoadTrace *previous = nullptr;
+
+    /// \brief Time at which this event was created.
+    private: std::chrono::steady_clock::time_point start;
+  };
+  }
+}
+#endif
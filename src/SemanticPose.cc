@@ -94,45 +94,9 @@ Errors SemanticPose::Resolve(
     ignition::math::Pose3d &_pose,
     const std::string &_resolveTo) const
 {
-  Errors errors;
-
-  auto graph = this->dataPtr->poseRelativeToGraph;
-  if (!graph)
-  {
-    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
-        "SemanticPose has invalid pointer to PoseRelativeToGraph."});
-    return errors;
-  }
-
-  std::string relativeTo = this->dataPtr->relativeTo;
-  if (relativeTo.empty())
-  {
-    relativeTo = this->dataPtr->defaultResolveTo;
-  }
-
-  std::string resolveTo = _resolveTo;
-  if (resolveTo.empty())
-  {
-    resolveTo = this->dataPtr->defaultResolveTo;
-  }
-
-  ignition::math::Pose3d pose;
-  if (this->dataPtr->name.empty())
-  {
-    errors = resolvePose(pose, graph, relativeTo, resolveTo);
-    pose *= this->RawPose();
-  }
-  else
-  {
-    errors = resolvePose(pose, graph, this->dataPtr->name, resolveTo);
-  }
-
-  if (errors.empty())
-  {
-    _pose = pose;
-  }
-
-  return errors;
+  return resolveSemanticPose(_pose, this->dataPtr->poseRelativeToGraph,
+      this->dataPtr->name, this->dataPtr->rawPose, this->dataPtr->relativeTo,
+      this->dataPtr->defaultResolveTo, _resolveTo);
 }
 }  // inline namespace
 }  // namespace sdf
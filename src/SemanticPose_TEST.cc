@@ -15,10 +15,20 @@
  *
  */
 
+#include <string>
+
 #include <gtest/gtest.h>
 #include <ignition/math/Pose3.hh>
+#include "sdf/Collision.hh"
+#include "sdf/Frame.hh"
+#include "sdf/Joint.hh"
+#include "sdf/Light.hh"
 #include "sdf/Link.hh"
+#include "sdf/Model.hh"
+#include "sdf/Root.hh"
 #include "sdf/SemanticPose.hh"
+#include "sdf/Sensor.hh"
+#include "sdf/Visual.hh"
 
 /////////////////////////////////////////////////
 TEST(SemanticPose, Construction)
@@ -110,3 +120,87 @@ TEST(SemanticPose, CopyAssignmentAfterMove)
   EXPECT_EQ(ignition::math::Pose3d::Zero, semPose1.RawPose());
   EXPECT_EQ(rawPose, semPose2.RawPose());
 }
+
+/////////////////////////////////////////////////
+TEST(SemanticPose, ResolvePose)
+{
+  using Pose = ignition::math::Pose3d;
+  const std::string sdf =
+    "<?xml version=\"1.0\"?>"
+    "<sdf version=\"1.8\">"
+    "  <model name=\"model\">"
+    "    <frame name=\"F\"><pose>0 0 1 0 0 0</pose></frame>"
+    "    <link name=\"L\">"
+    "      <pose relative_to=\"F\">1 0 0 0 0 1.57</pose>"
+    "      <visual name=\"V\">"
+    "        <pose>0 1 0 0 0 0</pose>"
+    "        <geometry><sphere><radius>1</radius></sphere></geometry>"
+    "      </visual>"
+    "      <collision name=\"C\">"
+    "        <pose relative_to=\"F\">0 0 2 0 0 0</pose>"
+    "        <geometry><sphere><radius>1</radius></sphere></geometry>"
+    "      </collision>"
+    "      <sensor name=\"S\" type=\"altimeter\">"
+    "        <pose>3 0 0 0 0 0</pose>"
+    "      </sensor>"
+    "      <light name=\"Li\" type=\"point\">"
+    "        <pose>0 3 0 0 0 0</pose>"
+    "      </light>"
+    "    </link>"
+    "    <link name=\"L2\"><pose>0 0 5 0 0 0</pose></link>"
+    "    <joint name=\"J\" type=\"fixed\">"
+    "      <pose>0 0 -1 0 0 0</pose>"
+    "      <parent>L</parent>"
+    "      <child>L2</child>"
+    "    </joint>"
+    "    <model name=\"M\">"
+    "      <pose relative_to=\"L\">0 0 0 0 0 0.5</pose>"
+    "      <link name=\"ML\"/>"
+    "    </model>"
+    "  </model>"
+    "</sdf>";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf);
+  ASSERT_TRUE(errors.empty()) << errors;
+  const sdf::Model *model = root.Model();
+  ASSERT_NE(nullptr, model);
+  const sdf::Link *link = model->LinkByName("L");
+  ASSERT_NE(nullptr, link);
+
+  // ResolvePose gives the same poses as SemanticPose().Resolve().
+  auto expectSame = [](const auto &_object, const std::string &_resolveTo)
+  {
+    Pose expected;
+    EXPECT_TRUE(_object.SemanticPose().Resolve(expected, _resolveTo).empty());
+    Pose pose;
+    EXPECT_TRUE(_object.ResolvePose(pose, _resolveTo).empty());
+    EXPECT_EQ(expected, pose) << _resolveTo;
+  };
+  for (const std::string resolveTo : {"", "__model__", "F", "L", "L2"})
+  {
+    expectSame(*model->FrameByName("F"), resolveTo);
+    expectSame(*link, resolveTo);
+    expectSame(*link->VisualByName("V"), resolveTo);
+    expectSame(*link->CollisionByName("C"), resolveTo);
+    expectSame(*link->SensorByName("S"), resolveTo);
+    expectSame(*link->LightByName("Li"), resolveTo);
+    expectSame(*model->JointByName("J"), resolveTo);
+    expectSame(*model->ModelByName("M"), resolveTo);
+  }
+
+  // Errors are also the same, and the output is not modified.
+  Pose pose(1, 2, 3, 0, 0, 0);
+  errors = link->ResolvePose(pose, "invalid");
+  sdf::Errors expectedErrors = link->SemanticPose().Resolve(pose, "invalid");
+  ASSERT_EQ(expectedErrors.size(), errors.size());
+  ASSERT_FALSE(errors.empty());
+  EXPECT_EQ(expectedErrors[0].Message(), errors[0].Message());
+  EXPECT_EQ(Pose(1, 2, 3, 0, 0, 0), pose);
+
+  sdf::Link unloaded;
+  errors = unloaded.ResolvePose(pose);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR, errors[0].Code());
+  EXPECT_EQ(Pose(1, 2, 3, 0, 0, 0), pose);
+}
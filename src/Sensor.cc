@@ -16,7 +16,7 @@
 */
 #include <memory>
 #include <string>
-#include <optional>
+#include <variant>
 #include <vector>
 #include <ignition/math/Pose3.hh>
 #include "sdf/AirPressure.hh"
@@ -33,6 +33,7 @@
 #include "sdf/Types.hh"
 #include "FrameSemantics.hh"
 #include "ScopedGraph.hh"
+#include "ScopedTraceEvent.hh"
 #include "Utils.hh"
 
 using namespace sdf;
@@ -98,29 +99,11 @@ class sdf::Sensor::Implementation
   /// \brief Scoped Pose Relative-To graph at the parent model scope.
   public: sdf::ScopedGraph<sdf::PoseRelativeToGraph> poseRelativeToGraph;
 
-  /// \brief Optional magnetometer.
-  public: std::optional<Magnetometer> magnetometer;
-
-  /// \brief Optional altimeter.
-  public: std::optional<Altimeter> altimeter;
-
-  /// \brief Optional NAVSAT sensor.
-  public: std::optional<NavSat> navSat;
-
-  /// \brief Optional air pressure sensor.
-  public: std::optional<AirPressure> airPressure;
-
-  /// \brief Optional camera.
-  public: std::optional<Camera> camera;
-
-  /// \brief Optional force torque sensor.
-  public: std::optional<ForceTorque> forceTorque;
-
-  /// \brief Optional IMU.
-  public: std::optional<Imu> imu;
-
-  /// \brief Optional lidar.
-  public: std::optional<Lidar> lidar;
+  /// \brief Type-specific data of the sensor. A sensor only ever holds
+  /// the data of one kind, so a single tagged storage is used instead of
+  /// one optional per kind.
+  public: std::variant<std::monostate, Magnetometer, Altimeter, NavSat,
+          AirPressure, Camera, ForceTorque, Imu, Lidar> data;
 
   // Developer note: If you add a new sensor type, make sure to also
   // update the Sensor::operator== function. Please bump this text down as
@@ -159,17 +142,11 @@ bool Sensor::operator==(const Sensor &_sensor) const
   switch (this->Type())
   {
     case SensorType::ALTIMETER:
-      return *(this->dataPtr->altimeter) == *(_sensor.dataPtr->altimeter);
     case SensorType::MAGNETOMETER:
-      return *(this->dataPtr->magnetometer) == *(_sensor.dataPtr->magnetometer);
     case SensorType::AIR_PRESSURE:
-      return *(this->dataPtr->airPressure) == *(_sensor.dataPtr->airPressure);
     case SensorType::FORCE_TORQUE:
-      return *(this->dataPtr->forceTorque) == *(_sensor.dataPtr->forceTorque);
     case SensorType::IMU:
-      return *(this->dataPtr->imu) == *(_sensor.dataPtr->imu);
     case SensorType::NAVSAT:
-      return *(this->dataPtr->navSat) == *(_sensor.dataPtr->navSat);
     case SensorType::CAMERA:
     case SensorType::DEPTH_CAMERA:
     case SensorType::RGBD_CAMERA:
@@ -177,9 +154,8 @@ bool Sensor::operator==(const Sensor &_sensor) const
     case SensorType::WIDE_ANGLE_CAMERA:
     case SensorType::SEGMENTATION_CAMERA:
     case SensorType::BOUNDINGBOX_CAMERA:
-      return *(this->dataPtr->camera) == *(_sensor.dataPtr->camera);
     case SensorType::LIDAR:
-      return *(this->dataPtr->lidar) == *(_sensor.dataPtr->lidar);
+      return this->dataPtr->data == _sensor.dataPtr->data;
     case SensorType::NONE:
     default:
       return true;
@@ -195,9 +171,10 @@ bool Sensor::operator!=(const Sensor &_sensor) const
 /////////////////////////////////////////////////
 Errors Sensor::Load(ElementPtr _sdf)
 {
+  ScopedTraceEvent event("Sensor::Load", "dom");
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that sdf is a valid pointer
   if (!_sdf)
@@ -246,23 +223,22 @@ Errors Sensor::Load(ElementPtr _sdf)
   if (type == "air_pressure")
   {
     this->dataPtr->type = SensorType::AIR_PRESSURE;
-    this->dataPtr->airPressure.emplace();
-    Errors err = this->dataPtr->airPressure->Load(
+    Errors err = this->dataPtr->data.emplace<AirPressure>().Load(
         _sdf->GetElement("air_pressure"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "altimeter")
   {
     this->dataPtr->type = SensorType::ALTIMETER;
-    this->dataPtr->altimeter.emplace();
-    Errors err = this->dataPtr->altimeter->Load(_sdf->GetElement("altimeter"));
+    Errors err = this->dataPtr->data.emplace<Altimeter>().Load(
+        _sdf->GetElement("altimeter"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "camera")
   {
     this->dataPtr->type = SensorType::CAMERA;
-    this->dataPtr->camera.emplace();
-    Errors err = this->dataPtr->camera->Load(_sdf->GetElement("camera"));
+    Errors err = this->dataPtr->data.emplace<Camera>().Load(
+        _sdf->GetElement("camera"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "contact")
@@ -276,74 +252,71 @@ Errors Sensor::Load(ElementPtr _sdf)
   else if (type == "depth" || type == "depth_camera")
   {
     this->dataPtr->type = SensorType::DEPTH_CAMERA;
-    this->dataPtr->camera.emplace();
-    Errors err = this->dataPtr->camera->Load(_sdf->GetElement("camera"));
+    Errors err = this->dataPtr->data.emplace<Camera>().Load(
+        _sdf->GetElement("camera"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "rgbd" || type == "rgbd_camera")
   {
     this->dataPtr->type = SensorType::RGBD_CAMERA;
-    this->dataPtr->camera.emplace();
-    Errors err = this->dataPtr->camera->Load(_sdf->GetElement("camera"));
+    Errors err = this->dataPtr->data.emplace<Camera>().Load(
+        _sdf->GetElement("camera"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "thermal" || type == "thermal_camera")
   {
     this->dataPtr->type = SensorType::THERMAL_CAMERA;
-    this->dataPtr->camera.emplace();
-    Errors err = this->dataPtr->camera->Load(_sdf->GetElement("camera"));
+    Errors err = this->dataPtr->data.emplace<Camera>().Load(
+        _sdf->GetElement("camera"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "segmentation" || type == "segmentation_camera")
   {
     this->dataPtr->type = SensorType::SEGMENTATION_CAMERA;
-    this->dataPtr->camera.emplace();
-    Errors err = this->dataPtr->camera->Load(_sdf->GetElement("camera"));
+    Errors err = this->dataPtr->data.emplace<Camera>().Load(
+        _sdf->GetElement("camera"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "boundingbox" || type == "boundingbox_camera")
   {
     this->dataPtr->type = SensorType::BOUNDINGBOX_CAMERA;
-    this->dataPtr->camera.emplace();
-    Errors err = this->dataPtr->camera->Load(_sdf->GetElement("camera"));
+    Errors err = this->dataPtr->data.emplace<Camera>().Load(
+        _sdf->GetElement("camera"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "wideanglecamera" || type == "wide_angle_camera")
   {
     this->dataPtr->type = SensorType::WIDE_ANGLE_CAMERA;
-    this->dataPtr->camera.emplace();
-    Errors err = this->dataPtr->camera->Load(_sdf->GetElement("camera"));
+    Errors err = this->dataPtr->data.emplace<Camera>().Load(
+        _sdf->GetElement("camera"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "force_torque")
   {
     this->dataPtr->type = SensorType::FORCE_TORQUE;
-    this->dataPtr->forceTorque.emplace();
-    Errors err = this->dataPtr->forceTorque->Load(
+    Errors err = this->dataPtr->data.emplace<ForceTorque>().Load(
         _sdf->GetElement("force_torque"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "navsat" || type == "gps")
   {
     this->dataPtr->type = SensorType::NAVSAT;
-    this->dataPtr->navSat.emplace();
-    Errors err = this->dataPtr->navSat->Load(
+    Errors err = this->dataPtr->data.emplace<NavSat>().Load(
       _sdf->GetElement(_sdf->HasElement("navsat") ? "navsat" : "gps"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "gpu_ray" || type == "gpu_lidar")
   {
     this->dataPtr->type = SensorType::GPU_LIDAR;
-    this->dataPtr->lidar.emplace();
-    Errors err = this->dataPtr->lidar->Load(
+    Errors err = this->dataPtr->data.emplace<Lidar>().Load(
         _sdf->GetElement(_sdf->HasElement("lidar") ? "lidar" : "ray"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "imu")
   {
     this->dataPtr->type = SensorType::IMU;
-    this->dataPtr->imu.emplace();
-    Errors err = this->dataPtr->imu->Load(_sdf->GetElement("imu"));
+    Errors err = this->dataPtr->data.emplace<Imu>().Load(
+        _sdf->GetElement("imu"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
   else if (type == "logical_camera")
@@ -353,8 +326,7 @@ Errors Sensor::Load(ElementPtr _sdf)
   else if (type == "magnetometer")
   {
     this->dataPtr->type = SensorType::MAGNETOMETER;
-    this->dataPtr->magnetometer.emplace();
-    Errors err = this->dataPtr->magnetometer->Load(
+    Errors err = this->dataPtr->data.emplace<Magnetometer>().Load(
         _sdf->GetElement("magnetometer"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
@@ -365,8 +337,7 @@ Errors Sensor::Load(ElementPtr _sdf)
   else if (type == "ray" || type == "lidar")
   {
     this->dataPtr->type = SensorType::LIDAR;
-    this->dataPtr->lidar.emplace();
-    Errors err = this->dataPtr->lidar->Load(
+    Errors err = this->dataPtr->data.emplace<Lidar>().Load(
         _sdf->GetElement(_sdf->HasElement("lidar") ? "lidar" : "ray"));
     errors.insert(errors.end(), err.begin(), err.end());
   }
@@ -492,6 +463,15 @@ sdf::SemanticPose Sensor::SemanticPose() const
       this->dataPtr->poseRelativeToGraph);
 }
 
+/////////////////////////////////////////////////
+Errors Sensor::ResolvePose(ignition::math::Pose3d &_pose,
+    const std::string &_resolveTo) const
+{
+  return resolveSemanticPose(_pose, this->dataPtr->poseRelativeToGraph, "",
+      this->dataPtr->pose, this->dataPtr->poseRelativeTo,
+      this->dataPtr->xmlParentName, _resolveTo);
+}
+
 /////////////////////////////////////////////////
 sdf::ElementPtr Sensor::Element() const
 {
@@ -527,73 +507,73 @@ bool Sensor::SetType(const std::string &_typeStr)
 /////////////////////////////////////////////////
 const Magnetometer *Sensor::MagnetometerSensor() const
 {
-  return optionalToPointer(this->dataPtr->magnetometer);
+  return std::get_if<Magnetometer>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 Magnetometer *Sensor::MagnetometerSensor()
 {
-  return optionalToPointer(this->dataPtr->magnetometer);
+  return std::get_if<Magnetometer>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 void Sensor::SetMagnetometerSensor(const Magnetometer &_mag)
 {
-  this->dataPtr->magnetometer = _mag;
+  this->dataPtr->data = _mag;
 }
 
 /////////////////////////////////////////////////
 const Altimeter *Sensor::AltimeterSensor() const
 {
-  return optionalToPointer(this->dataPtr->altimeter);
+  return std::get_if<Altimeter>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 Altimeter *Sensor::AltimeterSensor()
 {
-  return optionalToPointer(this->dataPtr->altimeter);
+  return std::get_if<Altimeter>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 void Sensor::SetAltimeterSensor(const Altimeter &_alt)
 {
-  this->dataPtr->altimeter = _alt;
+  this->dataPtr->data = _alt;
 }
 
 /////////////////////////////////////////////////
 const AirPressure *Sensor::AirPressureSensor() const
 {
-  return optionalToPointer(this->dataPtr->airPressure);
+  return std::get_if<AirPressure>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 AirPressure *Sensor::AirPressureSensor()
 {
-  return optionalToPointer(this->dataPtr->airPressure);
+  return std::get_if<AirPressure>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 void Sensor::SetAirPressureSensor(const AirPressure &_air)
 {
-  this->dataPtr->airPressure = _air;
+  this->dataPtr->data = _air;
 }
 
 /////////////////////////////////////////////////
 const Lidar *Sensor::LidarSensor() const
 {
-  return optionalToPointer(this->dataPtr->lidar);
+  return std::get_if<Lidar>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 Lidar *Sensor::LidarSensor()
 {
-  return optionalToPointer(this->dataPtr->lidar);
+  return std::get_if<Lidar>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 void Sensor::SetLidarSensor(const Lidar &_lidar)
 {
-  this->dataPtr->lidar = _lidar;
+  this->dataPtr->data = _lidar;
 }
 
 /////////////////////////////////////////////////
@@ -620,73 +600,73 @@ std::string Sensor::TypeStr() const
 /////////////////////////////////////////////////
 void Sensor::SetCameraSensor(const Camera &_cam)
 {
-  this->dataPtr->camera = _cam;
+  this->dataPtr->data = _cam;
 }
 
 /////////////////////////////////////////////////
 const Camera *Sensor::CameraSensor() const
 {
-  return optionalToPointer(this->dataPtr->camera);
+  return std::get_if<Camera>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 Camera *Sensor::CameraSensor()
 {
-  return optionalToPointer(this->dataPtr->camera);
+  return std::get_if<Camera>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 void Sensor::SetForceTorqueSensor(const ForceTorque &_ft)
 {
-  this->dataPtr->forceTorque = _ft;
+  this->dataPtr->data = _ft;
 }
 
 /////////////////////////////////////////////////
 const ForceTorque *Sensor::ForceTorqueSensor() const
 {
-  return optionalToPointer(this->dataPtr->forceTorque);
+  return std::get_if<ForceTorque>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 ForceTorque *Sensor::ForceTorqueSensor()
 {
-  return optionalToPointer(this->dataPtr->forceTorque);
+  return std::get_if<ForceTorque>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 void Sensor::SetNavSatSensor(const NavSat &_gps)
 {
-  this->dataPtr->navSat = _gps;
+  this->dataPtr->data = _gps;
 }
 
 /////////////////////////////////////////////////
 const NavSat *Sensor::NavSatSensor() const
 {
-  return optionalToPointer(this->dataPtr->navSat);
+  return std::get_if<NavSat>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 NavSat *Sensor::NavSatSensor()
 {
-  return optionalToPointer(this->dataPtr->navSat);
+  return std::get_if<NavSat>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 void Sensor::SetImuSensor(const Imu &_imu)
 {
-  this->dataPtr->imu = _imu;
+  this->dataPtr->data = _imu;
 }
 
 /////////////////////////////////////////////////
 const Imu *Sensor::ImuSensor() const
 {
-  return optionalToPointer(this->dataPtr->imu);
+  return std::get_if<Imu>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
 Imu *Sensor::ImuSensor()
 {
-  return optionalToPointer(this->dataPtr->imu);
+  return std::get_if<Imu>(&this->dataPtr->data);
 }
 
 /////////////////////////////////////////////////
@@ -711,52 +691,52 @@ sdf::ElementPtr Sensor::ToElement() const
 
   // air pressure
   if (this->Type() == sdf::SensorType::AIR_PRESSURE &&
-      this->dataPtr->airPressure)
+      this->AirPressureSensor())
   {
     sdf::ElementPtr airPressureElem = elem->GetElement("air_pressure");
-    airPressureElem->Copy(this->dataPtr->airPressure->ToElement());
+    airPressureElem->Copy(this->AirPressureSensor()->ToElement());
   }
   // altimeter
   else if (this->Type() == sdf::SensorType::ALTIMETER &&
-      this->dataPtr->altimeter)
+      this->AltimeterSensor())
   {
     sdf::ElementPtr altimeterElem = elem->GetElement("altimeter");
-    altimeterElem->Copy(this->dataPtr->altimeter->ToElement());
+    altimeterElem->Copy(this->AltimeterSensor()->ToElement());
   }
   // camera, depth, thermal, segmentation
   else if (this->CameraSensor())
   {
     sdf::ElementPtr cameraElem = elem->GetElement("camera");
-    cameraElem->Copy(this->dataPtr->camera->ToElement());
+    cameraElem->Copy(this->CameraSensor()->ToElement());
   }
   // force torque
   else if (this->Type() == sdf::SensorType::FORCE_TORQUE  &&
-      this->dataPtr->forceTorque)
+      this->ForceTorqueSensor())
   {
     sdf::ElementPtr forceTorqueElem = elem->GetElement("force_torque");
-    forceTorqueElem->Copy(this->dataPtr->forceTorque->ToElement());
+    forceTorqueElem->Copy(this->ForceTorqueSensor()->ToElement());
   }
   // imu
-  else if (this->Type() == sdf::SensorType::IMU && this->dataPtr->imu)
+  else if (this->Type() == sdf::SensorType::IMU && this->ImuSensor())
   {
     sdf::ElementPtr imuElem = elem->GetElement("imu");
-    imuElem->Copy(this->dataPtr->imu->ToElement());
+    imuElem->Copy(this->ImuSensor()->ToElement());
   }
   // lidar, gpu_lidar
   else if ((this->Type() == sdf::SensorType::GPU_LIDAR ||
             this->Type() == sdf::SensorType::LIDAR) &&
-           this->dataPtr->lidar)
+           this->LidarSensor())
   {
     sdf::ElementPtr rayElem = (elem->HasElement("ray")) ?
         elem->GetElement("ray") : elem->GetElement("lidar");
-    rayElem->Copy(this->dataPtr->lidar->ToElement());
+    rayElem->Copy(this->LidarSensor()->ToElement());
   }
   // magnetometer
   else if (this->Type() == sdf::SensorType::MAGNETOMETER &&
-      this->dataPtr->magnetometer)
+      this->MagnetometerSensor())
   {
     sdf::ElementPtr magnetometerElem = elem->GetElement("magnetometer");
-    magnetometerElem->Copy(this->dataPtr->magnetometer->ToElement());
+    magnetometerElem->Copy(this->MagnetometerSensor()->ToElement());
   }
   else
   {
@@ -503,6 +503,29 @@ TEST(DOMSensor, MutableSensors)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(DOMSensor, SingleSensorKind)
+{
+  sdf::Sensor sensor;
+  sensor.SetType(sdf::SensorType::CAMERA);
+  sensor.SetCameraSensor(sdf::Camera());
+  EXPECT_NE(nullptr, sensor.CameraSensor());
+  EXPECT_EQ(nullptr, sensor.ImuSensor());
+
+  // Setting another kind of sensor replaces the camera
+  sensor.SetType(sdf::SensorType::IMU);
+  sensor.SetImuSensor(sdf::Imu());
+  EXPECT_EQ(nullptr, sensor.CameraSensor());
+  EXPECT_NE(nullptr, sensor.ImuSensor());
+
+  sdf::Sensor sensor2(sensor);
+  EXPECT_EQ(sensor, sensor2);
+  sdf::Noise noise;
+  noise.SetMean(2.0);
+  sensor2.ImuSensor()->SetLinearAccelerationXNoise(noise);
+  EXPECT_NE(sensor, sensor2);
+}
+
 /////////////////////////////////////////////////
 TEST(DOMSensor, ToElement)
 {
@@ -159,7 +159,7 @@ Errors Sky::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <sky> element.
   // This is an error that cannot be recovered, so return an error.
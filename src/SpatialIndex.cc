@@ -0,0 +1,228 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "SpatialIndex.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/// \brief Maximum number of spheres in a leaf of the hierarchy.
+static const std::size_t kLeafSize = 8;
+
+/////////////////////////////////////////////////
+/// \brief Get the squared distance from a point to a box.
+/// \param[in] _point The point.
+/// \param[in] _min Minimum corner of the box.
+/// \param[in] _max Maximum corner of the box.
+/// \return The squared distance, zero if the point is inside the box.
+static double squaredDistanceToBox(const ignition::math::Vector3d &_point,
+    const ignition::math::Vector3d &_min, const ignition::math::Vector3d &_max)
+{
+  double distance = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    const double d = std::max({_min[i] - _point[i], 0.0, _point[i] - _max[i]});
+    distance += d * d;
+  }
+  return distance;
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Clear()
+{
+  this->spheres.clear();
+  this->treeSize = 0;
+  this->nodes.clear();
+  this->unbounded.clear();
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Insert(std::size_t _id,
+    const ignition::math::Vector3d &_center, double _radius)
+{
+  if (std::isinf(_radius))
+  {
+    this->unbounded.push_back(_id);
+    return;
+  }
+
+  this->spheres.push_back({_center, _radius, _id});
+
+  // Rebuild once the spheres tested linearly are a sizeable part of the
+  // index, so that inserting n spheres one by one costs O(n log n).
+  const std::size_t pending = this->spheres.size() - this->treeSize;
+  if (pending > std::max(kLeafSize, this->treeSize / 4))
+    this->Build();
+}
+
+/////////////////////////////////////////////////
+std::size_t SpatialIndex::Size() const
+{
+  return this->spheres.size() + this->unbounded.size();
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Build()
+{
+  this->nodes.clear();
+  this->treeSize = this->spheres.size();
+  if (this->treeSize > 0)
+    this->BuildNode(0, this->treeSize);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::BuildNode(std::size_t _first, std::size_t _count)
+{
+  const std::size_t index = this->nodes.size();
+  this->nodes.push_back(Node());
+
+  const double inf = std::numeric_limits<double>::infinity();
+  ignition::math::Vector3d min(inf, inf, inf);
+  ignition::math::Vector3d max(-inf, -inf, -inf);
+  ignition::math::Vector3d centerMin = min;
+  ignition::math::Vector3d centerMax = max;
+  for (std::size_t i = _first; i < _first + _count; ++i)
+  {
+    const Sphere &sphere = this->spheres[i];
+    const ignition::math::Vector3d extent(
+        sphere.radius, sphere.radius, sphere.radius);
+    min.Min(sphere.center - extent);
+    max.Max(sphere.center + extent);
+    centerMin.Min(sphere.center);
+    centerMax.Max(sphere.center);
+  }
+  this->nodes[index].min = min;
+  this->nodes[index].max = max;
+
+  if (_count <= kLeafSize)
+  {
+    this->nodes[index].first = _first;
+    this->nodes[index].count = _count;
+    return;
+  }
+
+  // Split at the median center along the axis where the centers spread the
+  // most.
+  const ignition::math::Vector3d spread = centerMax - centerMin;
+  int axis = 0;
+  if (spread.Y() > spread[axis])
+    axis = 1;
+  if (spread.Z() > spread[axis])
+    axis = 2;
+
+  const std::size_t half = _count / 2;
+  auto begin = this->spheres.begin() + static_cast<std::ptrdiff_t>(_first);
+  std::nth_element(begin, begin + static_cast<std::ptrdiff_t>(half),
+      begin + static_cast<std::ptrdiff_t>(_count),
+      [axis](const Sphere &_a, const Sphere &_b)
+      {
+        return _a.center[axis] < _b.center[axis];
+      });
+
+  this->nodes[index].count = 0;
+  this->BuildNode(_first, half);
+  this->nodes[index].second = this->nodes.size();
+  this->BuildNode(_first + half, _count - half);
+}
+
+/////////////////////////////////////////////////
+template <typename NodeTest, typename SphereTest>
+void SpatialIndex::Query(NodeTest _nodeTest, SphereTest _sphereTest,
+    std::vector<std::size_t> &_ids) const
+{
+  _ids.insert(_ids.end(), this->unbounded.begin(), this->unbounded.end());
+
+  if (!this->nodes.empty())
+  {
+    std::vector<std::size_t> stack = {0u};
+    while (!stack.empty())
+    {
+      const Node &node = this->nodes[stack.back()];
+      const std::size_t index = stack.back();
+      stack.pop_back();
+      if (!_nodeTest(node.min, node.max))
+        continue;
+
+      if (node.count == 0)
+      {
+        stack.push_back(node.second);
+        stack.push_back(index + 1);
+        continue;
+      }
+
+      for (std::size_t i = node.first; i < node.first + node.count; ++i)
+      {
+        if (_sphereTest(this->spheres[i]))
+          _ids.push_back(this->spheres[i].id);
+      }
+    }
+  }
+
+  for (std::size_t i = this->treeSize; i < this->spheres.size(); ++i)
+  {
+    if (_sphereTest(this->spheres[i]))
+      _ids.push_back(this->spheres[i].id);
+  }
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::QuerySphere(const ignition::math::Vector3d &_center,
+    double _radius, std::vector<std::size_t> &_ids) const
+{
+  this->Query(
+      [&](const ignition::math::Vector3d &_min,
+          const ignition::math::Vector3d &_max)
+      {
+        return squaredDistanceToBox(_center, _min, _max) <=
+            _radius * _radius;
+      },
+      [&](const Sphere &_sphere)
+      {
+        const double distance = _radius + _sphere.radius;
+        return (_sphere.center - _center).SquaredLength() <=
+            distance * distance;
+      },
+      _ids);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::QueryBox(const ignition::math::AxisAlignedBox &_box,
+    std::vector<std::size_t> &_ids) const
+{
+  const ignition::math::Vector3d min = _box.Min();
+  const ignition::math::Vector3d max = _box.Max();
+  this->Query(
+      [&](const ignition::math::Vector3d &_min,
+          const ignition::math::Vector3d &_max)
+      {
+        return _min.X() <= max.X() && _max.X() >= min.X() &&
+            _min.Y() <= max.Y() && _max.Y() >= min.Y() &&
+            _min.Z() <= max.Z() && _max.Z() >= min.Z();
+      },
+      [&](const Sphere &_sphere)
+      {
+        return squaredDistanceToBox(_sphere.center, min, max) <=
+            _sphere.radius * _sphere.radius;
+      },
+      _ids);
+}
+}
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_SPATIALINDEX_HH
+#define SDFORMAT_SPATIALINDEX_HH
+
+#include <cstddef>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Bounding volume hierarchy over bounding spheres, to find the
+  /// objects near a point or inside a box without testing every object.
+  /// Inserted spheres are kept in a list that is tested linearly until
+  /// enough of them accumulate, and the hierarchy is then rebuilt with all
+  /// the spheres. Spheres with an infinite radius, for objects without
+  /// known bounds, match every query.
+  class SpatialIndex
+  {
+    /// \brief Remove every sphere.
+    public: void Clear();
+
+    /// \brief Add a sphere.
+    /// \param[in] _id ID of the object that the sphere bounds, which is
+    /// returned by the queries.
+    /// \param[in] _center Center of the sphere.
+    /// \param[in] _radius Radius of the sphere, infinite if the object has
+    /// no known bounds.
+    public: void Insert(std::size_t _id,
+                        const ignition::math::Vector3d &_center,
+                        double _radius);
+
+    /// \brief Get the number of spheres.
+    /// \return Number of spheres.
+    public: std::size_t Size() const;
+
+    /// \brief Find the spheres that intersect a sphere.
+    /// \param[in] _center Center of the sphere to test.
+    /// \param[in] _radius Radius of the sphere to test.
+    /// \param[out] _ids IDs of the intersecting spheres, in no particular
+    /// order, appended to the vector.
+    public: void QuerySphere(const ignition::math::Vector3d &_center,
+                             double _radius,
+                             std::vector<std::size_t> &_ids) const;
+
+    /// \brief Find the spheres that intersect a box.
+    /// \param[in] _box The box to test.
+    /// \param[out] _ids IDs of the intersecting spheres, in no particular
+    /// order, appended to the vector.
+    public: void QueryBox(const ignition::math::AxisAlignedBox &_box,
+                          std::vector<std::size_t> &_ids) const;
+
+    /// \brief Rebuild the hierarchy with every bounded sphere.
+    private: void Build();
+
+    /// \brief Build the node of a range of spheres and its children.
+    /// \param[in] _first Index of the first sphere of the range.
+    /// \param[in] _count Number of spheres in the range.
+    private: void BuildNode(std::size_t _first, std::size_t _count);
+
+    /// \brief Visit the spheres whose node bounds pass a test.
+    /// \param[in] _nodeTest Test of the bounds of a node.
+    /// \param[in] _sphereTest Test of a sphere.
+    /// \param[out] _ids IDs of the spheres that pass _sphereTest.
+    private: template <typename NodeTest, typename SphereTest>
+             void Query(NodeTest _nodeTest, SphereTest _sphereTest,
+                        std::vector<std::size_t> &_ids) const;
+
+    /// \brief A bounding sphere.
+    private: struct Sphere
+    {
+      /// \brief Center.
+      ignition::math::Vector3d center;
+
+      /// \brief Radius.
+      double radius;
+
+      /// \brief ID of the object.
+      std::size_t id;
+    };
+
+    /// \brief A node of the hierarchy, which bounds a contiguous range of
+    /// the spheres of the hierarchy. The first child of an inner node
+    /// follows it.
+    private: struct Node
+    {
+      /// \brief Minimum corner of the box that bounds the spheres.
+      ignition::math::Vector3d min;
+
+      /// \brief Maximum corner of the box that bounds the spheres.
+      ignition::math::Vector3d max;
+
+      /// \brief Index of the first sphere of a leaf.
+      std::size_t first;
+
+      /// \brief Number of spheres of a leaf, zero for an inner node.
+      std::size_t count;
+
+      /// \brief Index of the second child of an inner node.
+      std::size_t second;
+    };
+
+    /// \brief Bounded spheres. The first treeSize spheres are in the
+    /// hierarchy, and the others are tested linearly.
+    private: std::vector<Sphere> spheres;
+
+    /// \brief Number of spheres in the hierarchy.
+    private: std::size_t treeSize = 0;
+
+    /// \brief Nodes of the hierarchy, starting with the root.
+    private: std::vector<Node> nodes;
+
+    /// \brief IDs of the spheres with an infinite radius.
+    private: std::vector<std::size_t> unbounded;
+  };
+  }
+}
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "SpatialIndex.hh"
+
+using ignition::math::Vector3d;
+
+/////////////////////////////////////////////////
+TEST(SpatialIndex, Queries)
+{
+  sdf::SpatialIndex index;
+  std::vector<std::size_t> ids;
+  index.QuerySphere(Vector3d::Zero, 1.0, ids);
+  EXPECT_TRUE(ids.empty());
+
+  // A row of unit spheres along the X axis, enough to build a hierarchy.
+  const std::size_t count = 1000;
+  for (std::size_t i = 0; i < count; ++i)
+    index.Insert(i, Vector3d(3.0 * i, 0, 0), 1.0);
+  EXPECT_EQ(count, index.Size());
+
+  index.QuerySphere(Vector3d(30, 0, 0), 0.5, ids);
+  EXPECT_EQ(std::vector<std::size_t>({10u}), ids);
+
+  ids.clear();
+  index.QuerySphere(Vector3d(31.5, 0, 0), 0.6, ids);
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(std::vector<std::size_t>({10u, 11u}), ids);
+
+  ids.clear();
+  index.QuerySphere(Vector3d(31.5, 10, 0), 1.0, ids);
+  EXPECT_TRUE(ids.empty());
+
+  ids.clear();
+  index.QueryBox(ignition::math::AxisAlignedBox(
+      Vector3d(59.5, -1, -1), Vector3d(66, 1, 1)), ids);
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(std::vector<std::size_t>({20u, 21u, 22u}), ids);
+
+  // Spheres without bounds match every query.
+  index.Insert(count, Vector3d::Zero,
+               std::numeric_limits<double>::infinity());
+  ids.clear();
+  index.QuerySphere(Vector3d(0, 100, 0), 1.0, ids);
+  EXPECT_EQ(std::vector<std::size_t>({count}), ids);
+
+  index.Clear();
+  EXPECT_EQ(0u, index.Size());
+  ids.clear();
+  index.QuerySphere(Vector3d(30, 0, 0), 0.5, ids);
+  EXPECT_TRUE(ids.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialIndex, MatchesLinearSearch)
+{
+  sdf::SpatialIndex index;
+  std::vector<Vector3d> centers;
+  for (std::size_t i = 0; i < 500; ++i)
+  {
+    // Points spread on a lattice with a varying radius.
+    const Vector3d center(
+        static_cast<double>(i % 10), static_cast<double>((i / 10) % 10),
+        static_cast<double>(i / 100));
+    centers.push_back(center);
+    index.Insert(i, center, 0.1 * (i % 3));
+  }
+
+  const Vector3d point(4.2, 5.1, 2.0);
+  const double radius = 1.5;
+  std::vector<std::size_t> expected;
+  for (std::size_t i = 0; i < centers.size(); ++i)
+  {
+    const double distance = radius + 0.1 * (i % 3);
+    if ((centers[i] - point).SquaredLength() <= distance * distance)
+      expected.push_back(i);
+  }
+
+  std::vector<std::size_t> ids;
+  index.QuerySphere(point, radius, ids);
+  std::sort(ids.begin(), ids.end());
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(expected, ids);
+}
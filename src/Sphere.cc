@@ -16,6 +16,7 @@
 */
 #include "sdf/parser.hh"
 #include "sdf/Sphere.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
@@ -40,7 +41,7 @@ Errors Sphere::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that sdf is a valid pointer
   if (!_sdf)
@@ -0,0 +1,361 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cctype>
+#include <fstream>
+#include <iterator>
+
+#include "StreamedDocument.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/// \brief Document being read on the calling thread.
+static thread_local const StreamedDocument *tCurrentDocument = nullptr;
+
+/// \brief Kind of markup found after a '<'.
+enum class MarkupKind
+{
+  /// \brief Not enough characters were read to tell.
+  UNKNOWN,
+
+  /// \brief Start, end or empty element tag.
+  TAG,
+
+  /// \brief Comment.
+  COMMENT,
+
+  /// \brief CDATA section.
+  CDATA,
+
+  /// \brief Processing instruction or XML declaration.
+  INSTRUCTION,
+
+  /// \brief Other declaration, such as a DOCTYPE.
+  DECLARATION
+};
+
+/////////////////////////////////////////////////
+/// \brief Check if a string starts with a prefix.
+/// \param[in] _str String to check.
+/// \param[in] _prefix Prefix.
+/// \return True if _str starts with _prefix.
+static bool startsWith(const std::string &_str, const std::string &_prefix)
+{
+  return _str.compare(0, _prefix.size(), _prefix) == 0;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if a string ends with a suffix.
+/// \param[in] _str String to check.
+/// \param[in] _suffix Suffix.
+/// \return True if _str ends with _suffix.
+static bool endsWith(const std::string &_str, const std::string &_suffix)
+{
+  return _str.size() >= _suffix.size() &&
+      _str.compare(_str.size() - _suffix.size(), _suffix.size(), _suffix) == 0;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the kind of a markup from its first characters.
+/// \param[in] _markup Characters read so far, starting with '<'.
+/// \return Kind of the markup, or UNKNOWN if more characters are needed.
+static MarkupKind classifyMarkup(const std::string &_markup)
+{
+  static const std::string kComment = "<!--";
+  static const std::string kCdata = "<![CDATA[";
+
+  if (_markup.size() < 2)
+    return MarkupKind::UNKNOWN;
+  if (_markup[1] == '?')
+    return MarkupKind::INSTRUCTION;
+  if (_markup[1] != '!')
+    return MarkupKind::TAG;
+
+  if (_markup == kComment)
+    return MarkupKind::COMMENT;
+  if (_markup == kCdata)
+    return MarkupKind::CDATA;
+  if (startsWith(kComment, _markup) || startsWith(kCdata, _markup))
+    return MarkupKind::UNKNOWN;
+  return MarkupKind::DECLARATION;
+}
+
+/////////////////////////////////////////////////
+bool StreamedDocument::Open(const std::string &_filename)
+{
+  this->filename = _filename;
+  this->skeleton.clear();
+  this->fragments.clear();
+
+  std::ifstream in(_filename, std::ios::binary);
+  if (!in)
+    return false;
+
+  // Names of the elements that are open.
+  std::vector<std::string> path;
+  // Markup being read, starting with '<'.
+  std::string markup;
+  bool inMarkup = false;
+  MarkupKind kind = MarkupKind::UNKNOWN;
+  char quote = '\0';
+  int bracketDepth = 0;
+  std::size_t markupBegin = 0;
+  int markupLine = 1;
+  bool inFragment = false;
+
+  std::size_t offset = 0;
+  int line = 1;
+
+  // Handle a complete markup. Returns false if the elements are not
+  // balanced.
+  auto endMarkup = [&]() -> bool
+  {
+    if (kind != MarkupKind::TAG)
+    {
+      if (!inFragment)
+        this->skeleton += markup;
+      return true;
+    }
+
+    const bool closing = markup[1] == '/';
+    const std::size_t nameBegin = closing ? 2u : 1u;
+    std::size_t nameEnd = nameBegin;
+    while (nameEnd < markup.size() &&
+           !std::isspace(static_cast<unsigned char>(markup[nameEnd])) &&
+           markup[nameEnd] != '/' && markup[nameEnd] != '>')
+    {
+      ++nameEnd;
+    }
+    if (nameEnd == nameBegin)
+      return false;
+    const std::string name = markup.substr(nameBegin, nameEnd - nameBegin);
+
+    if (closing)
+    {
+      if (path.empty() || path.back() != name)
+        return false;
+      path.pop_back();
+
+      if (inFragment && path.size() == 2u)
+      {
+        Fragment &fragment = this->fragments.back();
+        fragment.end = offset + 1;
+
+        // Keep the line breaks of the model, so the following elements keep
+        // their line numbers.
+        this->skeleton += "<model ";
+        this->skeleton += kFragmentAttribute;
+        this->skeleton += "=\"" + std::to_string(this->fragments.size() - 1) +
+            "\"" + std::string(line - fragment.line, '\n') + "/>";
+        inFragment = false;
+      }
+      else if (!inFragment)
+      {
+        this->skeleton += markup;
+      }
+      return true;
+    }
+
+    std::size_t last = markup.size() - 2;
+    while (last > nameEnd &&
+           std::isspace(static_cast<unsigned char>(markup[last])))
+    {
+      --last;
+    }
+    const bool empty = markup[last] == '/';
+
+    if (!inFragment && !empty && name == "model" && path.size() == 2u &&
+        path[0] == "sdf" && path[1] == "world")
+    {
+      this->fragments.push_back({markupBegin, 0u, markupLine});
+      inFragment = true;
+    }
+    else if (!inFragment)
+    {
+      this->skeleton += markup;
+    }
+
+    if (!empty)
+      path.push_back(name);
+    return true;
+  };
+
+  for (std::istreambuf_iterator<char> it(in), end; it != end; ++it, ++offset)
+  {
+    const char c = *it;
+    if (!inMarkup)
+    {
+      if (c == '<')
+      {
+        inMarkup = true;
+        markup.assign(1, c);
+        kind = MarkupKind::UNKNOWN;
+        quote = '\0';
+        bracketDepth = 0;
+        markupBegin = offset;
+        markupLine = line;
+      }
+      else if (!inFragment)
+      {
+        this->skeleton.push_back(c);
+      }
+    }
+    else
+    {
+      markup.push_back(c);
+      if (kind == MarkupKind::UNKNOWN)
+        kind = classifyMarkup(markup);
+
+      bool done = false;
+      switch (kind)
+      {
+        case MarkupKind::TAG:
+          if (quote != '\0')
+          {
+            if (c == quote)
+              quote = '\0';
+          }
+          else if (c == '"' || c == '\'')
+          {
+            quote = c;
+          }
+          else
+          {
+            done = c == '>';
+          }
+          break;
+        case MarkupKind::COMMENT:
+          done = markup.size() >= 7u && endsWith(markup, "-->");
+          break;
+        case MarkupKind::CDATA:
+          done = markup.size() >= 12u && endsWith(markup, "]]>");
+          break;
+        case MarkupKind::INSTRUCTION:
+          done = markup.size() >= 4u && endsWith(markup, "?>");
+          break;
+        case MarkupKind::DECLARATION:
+          if (c == '[')
+            ++bracketDepth;
+          else if (c == ']')
+            --bracketDepth;
+          else
+            done = c == '>' && bracketDepth <= 0;
+          break;
+        case MarkupKind::UNKNOWN:
+          break;
+      }
+
+      if (done)
+      {
+        if (!endMarkup())
+          return false;
+        inMarkup = false;
+      }
+    }
+
+    if (c == '\n')
+      ++line;
+  }
+
+  return !in.bad() && !inMarkup && !inFragment && path.empty();
+}
+
+/////////////////////////////////////////////////
+const std::string &StreamedDocument::Filename() const
+{
+  return this->filename;
+}
+
+/////////////////////////////////////////////////
+const std::string &StreamedDocument::Skeleton() const
+{
+  return this->skeleton;
+}
+
+/////////////////////////////////////////////////
+void StreamedDocument::ReleaseSkeleton()
+{
+  std::string().swap(this->skeleton);
+}
+
+/////////////////////////////////////////////////
+std::size_t StreamedDocument::FragmentCount() const
+{
+  return this->fragments.size();
+}
+
+/////////////////////////////////////////////////
+bool StreamedDocument::FragmentIndex(const tinyxml2::XMLElement *_xml,
+                                     std::size_t &_index)
+{
+  unsigned int index = 0;
+  if (nullptr == _xml ||
+      _xml->QueryUnsignedAttribute(kFragmentAttribute, &index) !=
+          tinyxml2::XML_SUCCESS)
+  {
+    return false;
+  }
+  _index = index;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool StreamedDocument::LoadFragment(std::size_t _index,
+    tinyxml2::XMLDocument &_doc, int &_lineOffset) const
+{
+  if (_index >= this->fragments.size())
+    return false;
+
+  const Fragment &fragment = this->fragments[_index];
+  std::ifstream in(this->filename, std::ios::binary);
+  if (!in)
+    return false;
+
+  std::string text(fragment.end - fragment.begin, '\0');
+  in.seekg(static_cast<std::streamoff>(fragment.begin));
+  if (!in.read(&text[0], static_cast<std::streamsize>(text.size())) ||
+      !startsWith(text, "<model"))
+  {
+    return false;
+  }
+
+  _doc.Parse(text.c_str(), text.size());
+  _lineOffset = fragment.line - 1;
+  return !_doc.Error();
+}
+
+/////////////////////////////////////////////////
+const StreamedDocument *StreamedDocument::Current()
+{
+  return tCurrentDocument;
+}
+
+/////////////////////////////////////////////////
+ScopedStreamedDocument::ScopedStreamedDocument(const StreamedDocument *_doc)
+  : previous(tCurrentDocument)
+{
+  tCurrentDocument = _doc;
+}
+
+/////////////////////////////////////////////////
+ScopedStreamedDocument::~ScopedStreamedDocument()
+{
+  tCurrentDocument = this->previous;
+}
+}
+}
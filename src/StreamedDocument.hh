@@ -0,0 +1,141 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_STREAMEDDOCUMENT_HH
+#define SDFORMAT_STREAMEDDOCUMENT_HH
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <tinyxml2.h>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief An SDFormat file whose top-level world models are parsed one at
+  /// a time. Opening the file scans it once, without building an XML DOM,
+  /// and produces a skeleton document in which each <model> child of a
+  /// <world> is replaced by an empty placeholder <model> element. The
+  /// placeholders keep the line breaks of the models they replace, so the
+  /// rest of the skeleton keeps the line numbers of the file. While the
+  /// skeleton is read, each model is parsed from the file on its own when
+  /// its placeholder is reached, and its XML is released as soon as it has
+  /// been converted to sdf::Element objects.
+  class StreamedDocument
+  {
+    /// \brief Name of the attribute that holds the index of the model
+    /// replaced by a placeholder.
+    public: static constexpr const char *kFragmentAttribute =
+                "__sdf_streamed_fragment__";
+
+    /// \brief Scan a file.
+    /// \param[in] _filename Path of the file.
+    /// \return True if the file was read and its elements are balanced.
+    public: bool Open(const std::string &_filename);
+
+    /// \brief Get the path of the file.
+    /// \return Path given to Open().
+    public: const std::string &Filename() const;
+
+    /// \brief Get the text of the skeleton document.
+    /// \return The text of the file with the top-level world models replaced
+    /// by placeholders.
+    public: const std::string &Skeleton() const;
+
+    /// \brief Release the text of the skeleton document, once it has been
+    /// parsed.
+    public: void ReleaseSkeleton();
+
+    /// \brief Get the number of models replaced by placeholders.
+    /// \return Number of models.
+    public: std::size_t FragmentCount() const;
+
+    /// \brief Get the index of the model replaced by a placeholder.
+    /// \param[in] _xml Element of the skeleton document.
+    /// \param[out] _index Index of the model.
+    /// \return True if _xml is a placeholder.
+    public: static bool FragmentIndex(const tinyxml2::XMLElement *_xml,
+                                      std::size_t &_index);
+
+    /// \brief Parse a model replaced by a placeholder.
+    /// \param[in] _index Index of the model.
+    /// \param[out] _doc Document to parse the model into.
+    /// \param[out] _lineOffset Number to add to the line numbers of _doc to
+    /// get the line numbers in the file.
+    /// \return True if the model was read and parsed.
+    public: bool LoadFragment(std::size_t _index, tinyxml2::XMLDocument &_doc,
+                              int &_lineOffset) const;
+
+    /// \brief Get the document being read on the calling thread.
+    /// \return The document, or nullptr if none is being read.
+    public: static const StreamedDocument *Current();
+
+    /// \brief Location of a model in the file.
+    private: struct Fragment
+    {
+      /// \brief Offset of the first character of the model.
+      std::size_t begin;
+
+      /// \brief Offset past the last character of the model.
+      std::size_t end;
+
+      /// \brief Line of the first character of the model.
+      int line;
+    };
+
+    /// \brief Path of the file.
+    private: std::string filename;
+
+    /// \brief Text of the skeleton document.
+    private: std::string skeleton;
+
+    /// \brief Models replaced by placeholders.
+    private: std::vector<Fragment> fragments;
+  };
+
+  /// \brief Makes a StreamedDocument the document being read on the calling
+  /// thread for the lifetime of this object. The previous document is
+  /// restored when the scope ends, so files read while reading another one,
+  /// such as included files, can use their own scope.
+  class ScopedStreamedDocument
+  {
+    /// \brief Constructor.
+    /// \param[in] _doc Document being read, or nullptr if the file being read
+    /// is not streamed.
+    public: explicit ScopedStreamedDocument(const StreamedDocument *_doc);
+
+    /// \brief Destructor. Restores the previous document.
+    public: ~ScopedStreamedDocument();
+
+    /// \brief No copy constructor.
+    public: ScopedStreamedDocument(const ScopedStreamedDocument &) = delete;
+
+    /// \brief No copy assignment.
+    public: ScopedStreamedDocument &operator=(
+                const ScopedStreamedDocument &) = delete;
+
+    /// \brief Document that was being read when this object was created.
+    private: const StreamedDocument *previous;
+  };
+  }
+}
+#endif
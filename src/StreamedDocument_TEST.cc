@@ -0,0 +1,173 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <tinyxml2.h>
+
+#include "sdf/Filesystem.hh"
+#include "StreamedDocument.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// \brief Write a file in the test directory.
+/// \param[in] _name Name of the file.
+/// \param[in] _contents Contents of the file.
+/// \return Path of the file.
+static std::string writeTmpFile(const std::string &_name,
+    const std::string &_contents)
+{
+  std::string tmpDir;
+  EXPECT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  std::filesystem::create_directories(tmpDir);
+  const std::string fileName = sdf::filesystem::append(tmpDir, _name);
+  std::ofstream out(fileName, std::ios::binary);
+  out << _contents;
+  return fileName;
+}
+
+/////////////////////////////////////////////////
+TEST(StreamedDocument, Open)
+{
+  const std::string fileName = writeTmpFile("streamed_document.sdf",
+      "<?xml version='1.0'?>\n"
+      "<sdf version='1.9'>\n"
+      "  <world name='default'>\n"
+      "    <!-- <model name='commented'> -->\n"
+      "    <model name='first'>\n"
+      "      <link name='link'/>\n"
+      "    </model>\n"
+      "    <model name='empty'/>\n"
+      "    <model name='second'><static>true</static></model>\n"
+      "    <include><uri><![CDATA[model://box]]></uri></include>\n"
+      "    <gravity>0 0 -9.8</gravity>\n"
+      "  </world>\n"
+      "</sdf>\n");
+
+  sdf::StreamedDocument doc;
+  ASSERT_TRUE(doc.Open(fileName));
+  EXPECT_EQ(fileName, doc.Filename());
+
+  // Empty models are kept in the skeleton.
+  EXPECT_EQ(2u, doc.FragmentCount());
+
+  tinyxml2::XMLDocument skeleton;
+  skeleton.Parse(doc.Skeleton().c_str(), doc.Skeleton().size());
+  ASSERT_FALSE(skeleton.Error()) << skeleton.ErrorStr();
+  doc.ReleaseSkeleton();
+  EXPECT_TRUE(doc.Skeleton().empty());
+
+  auto *world = skeleton.FirstChildElement("sdf")->FirstChildElement("world");
+  ASSERT_NE(nullptr, world);
+
+  std::size_t index = 0;
+  auto *first = world->FirstChildElement();
+  ASSERT_NE(nullptr, first);
+  EXPECT_STREQ("model", first->Value());
+  ASSERT_TRUE(sdf::StreamedDocument::FragmentIndex(first, index));
+  EXPECT_EQ(0u, index);
+  EXPECT_EQ(nullptr, first->Attribute("name"));
+  EXPECT_EQ(5, first->GetLineNum());
+
+  auto *empty = first->NextSiblingElement();
+  ASSERT_NE(nullptr, empty);
+  EXPECT_STREQ("empty", empty->Attribute("name"));
+  EXPECT_FALSE(sdf::StreamedDocument::FragmentIndex(empty, index));
+  EXPECT_EQ(8, empty->GetLineNum());
+
+  auto *second = empty->NextSiblingElement();
+  ASSERT_NE(nullptr, second);
+  ASSERT_TRUE(sdf::StreamedDocument::FragmentIndex(second, index));
+  EXPECT_EQ(1u, index);
+  EXPECT_EQ(9, second->GetLineNum());
+
+  // The rest of the skeleton keeps the line numbers of the file.
+  auto *include = second->NextSiblingElement();
+  ASSERT_NE(nullptr, include);
+  EXPECT_STREQ("include", include->Value());
+  EXPECT_EQ(10, include->GetLineNum());
+  EXPECT_STREQ("model://box",
+      include->FirstChildElement("uri")->GetText());
+  auto *gravity = include->NextSiblingElement();
+  ASSERT_NE(nullptr, gravity);
+  EXPECT_EQ(11, gravity->GetLineNum());
+
+  int lineOffset = 0;
+  tinyxml2::XMLDocument model;
+  ASSERT_TRUE(doc.LoadFragment(0, model, lineOffset));
+  EXPECT_EQ(4, lineOffset);
+  auto *modelXml = model.FirstChildElement("model");
+  ASSERT_NE(nullptr, modelXml);
+  EXPECT_STREQ("first", modelXml->Attribute("name"));
+  auto *link = modelXml->FirstChildElement("link");
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ(6, link->GetLineNum() + lineOffset);
+
+  ASSERT_TRUE(doc.LoadFragment(1, model, lineOffset));
+  EXPECT_EQ(8, lineOffset);
+  EXPECT_STREQ("second", model.FirstChildElement("model")->Attribute("name"));
+
+  EXPECT_FALSE(doc.LoadFragment(2, model, lineOffset));
+}
+
+/////////////////////////////////////////////////
+TEST(StreamedDocument, OpenInvalid)
+{
+  sdf::StreamedDocument doc;
+  EXPECT_FALSE(doc.Open("/non/existent/file.sdf"));
+
+  const std::string fileName = writeTmpFile("streamed_document_invalid.sdf",
+      "<sdf version='1.9'><world name='default'>"
+      "<model name='unclosed'></world></sdf>");
+  EXPECT_FALSE(doc.Open(fileName));
+}
+
+/////////////////////////////////////////////////
+TEST(StreamedDocument, ScopedStreamedDocument)
+{
+  EXPECT_EQ(nullptr, sdf::StreamedDocument::Current());
+
+  sdf::StreamedDocument doc;
+  sdf::StreamedDocument nestedDoc;
+  {
+    sdf::ScopedStreamedDocument scope(&doc);
+    EXPECT_EQ(&doc, sdf::StreamedDocument::Current());
+    {
+      sdf::ScopedStreamedDocument nested(&nestedDoc);
+      EXPECT_EQ(&nestedDoc, sdf::StreamedDocument::Current());
+    }
+    {
+      sdf::ScopedStreamedDocument notStreamed(nullptr);
+      EXPECT_EQ(nullptr, sdf::StreamedDocument::Current());
+    }
+    EXPECT_EQ(&doc, sdf::StreamedDocument::Current());
+  }
+  EXPECT_EQ(nullptr, sdf::StreamedDocument::Current());
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,12 +15,15 @@
  *
  */
 
+#include <optional>
+
 #include "sdf/Element.hh"
 #include "sdf/parser.hh"
 #include "sdf/Surface.hh"
 #include "sdf/Types.hh"
 #include "sdf/sdf_config.h"
 #include "sdf/system_util.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
@@ -29,6 +32,9 @@ class sdf::Contact::Implementation
   // \brief The bitmask used to filter collisions.
   public: uint16_t collideBitmask = 0xff;
 
+  /// \brief The bitmask of the categories of the collision, if it is set.
+  public: std::optional<uint16_t> categoryBitmask;
+
   /// \brief The SDF element pointer used during load.
   public: sdf::ElementPtr sdf{nullptr};
 };
@@ -53,7 +59,7 @@ Errors Contact::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that sdf is a valid pointer
   if (!_sdf)
@@ -80,6 +86,12 @@ Errors Contact::Load(ElementPtr _sdf)
         static_cast<uint16_t>(_sdf->Get<unsigned int>("collide_bitmask"));
   }
 
+  if (_sdf->HasElement("category_bitmask"))
+  {
+    this->dataPtr->categoryBitmask =
+        static_cast<uint16_t>(_sdf->Get<unsigned int>("category_bitmask"));
+  }
+
   // \todo(nkoenig) Parse the remaining collide properties.
   return errors;
 }
@@ -101,6 +113,19 @@ void Contact::SetCollideBitmask(const uint16_t _bitmask)
   this->dataPtr->collideBitmask = _bitmask;
 }
 
+/////////////////////////////////////////////////
+uint16_t Contact::CategoryBitmask() const
+{
+  return this->dataPtr->categoryBitmask.value_or(
+      this->dataPtr->collideBitmask);
+}
+
+/////////////////////////////////////////////////
+void Contact::SetCategoryBitmask(const uint16_t _bitmask)
+{
+  this->dataPtr->categoryBitmask = _bitmask;
+}
+
 /////////////////////////////////////////////////
 Surface::Surface()
   : dataPtr(ignition::utils::MakeImpl<Implementation>())
@@ -112,7 +137,7 @@ Errors Surface::Load(ElementPtr _sdf)
 {
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that sdf is a valid pointer
   if (!_sdf)
@@ -169,6 +194,8 @@ sdf::ElementPtr Surface::ToElement() const
   sdf::ElementPtr contactElem = elem->GetElement("contact");
   contactElem->GetElement("collide_bitmask")->Set(
       this->dataPtr->contact.CollideBitmask());
+  contactElem->GetElement("category_bitmask")->Set(
+      this->dataPtr->contact.CategoryBitmask());
 
   return elem;
 }
@@ -126,3 +126,15 @@ TEST(DOMcontact, CollideBitmask)
   EXPECT_EQ(contact.CollideBitmask(), 0x67);
 }
 
+
+/////////////////////////////////////////////////
+TEST(DOMcontact, CategoryBitmask)
+{
+  sdf::Contact contact;
+  contact.SetCollideBitmask(0x67);
+  EXPECT_EQ(contact.CategoryBitmask(), 0x67);
+
+  contact.SetCategoryBitmask(0x12);
+  EXPECT_EQ(contact.CategoryBitmask(), 0x12);
+  EXPECT_EQ(contact.CollideBitmask(), 0x67);
+}
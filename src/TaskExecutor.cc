@@ -0,0 +1,258 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "sdf/TaskExecutor.hh"
+
+using namespace sdf;
+
+namespace
+{
+/// \brief Group of tasks run by a ThreadedExecutor.
+class TaskGroup
+{
+  /// \brief Constructor.
+  /// \param[in] _count Number of tasks.
+  /// \param[in] _task Function that runs a task.
+  public: TaskGroup(std::size_t _count,
+              const std::function<void(std::size_t)> &_task)
+    : count(_count), remaining(_count), task(_task)
+  {
+  }
+
+  /// \brief Run tasks of the group that no other thread has started, until
+  /// all of them are started.
+  public: void RunTasks()
+  {
+    for (std::size_t i = this->next++; i < this->count; i = this->next++)
+    {
+      try
+      {
+        this->task(i);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->exception)
+          this->exception = std::current_exception();
+      }
+
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (--this->remaining == 0)
+        this->finished.notify_all();
+    }
+  }
+
+  /// \brief Record that a pool thread is going to run tasks of the group.
+  public: void AddHelper()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->helpers;
+  }
+
+  /// \brief Record that a pool thread no longer uses the group.
+  public: void RemoveHelper()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (--this->helpers == 0)
+      this->finished.notify_all();
+  }
+
+  /// \brief Wait for all the tasks of the group to finish and for the pool
+  /// threads to stop using it, and rethrow the first exception thrown by a
+  /// task.
+  public: void Wait()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->finished.wait(lock, [this]
+    {
+      return this->remaining == 0 && this->helpers == 0;
+    });
+    if (this->exception)
+      std::rethrow_exception(this->exception);
+  }
+
+  /// \brief Number of tasks.
+  private: const std::size_t count;
+
+  /// \brief Index of the next task to start.
+  private: std::atomic<std::size_t> next{0};
+
+  /// \brief Number of tasks that have not finished, guarded by mutex.
+  private: std::size_t remaining;
+
+  /// \brief Number of pool threads using the group, guarded by mutex.
+  private: std::size_t helpers = 0;
+
+  /// \brief Function that runs a task.
+  private: const std::function<void(std::size_t)> &task;
+
+  /// \brief First exception thrown by a task, guarded by mutex.
+  private: std::exception_ptr exception;
+
+  /// \brief Guards remaining, helpers and exception.
+  private: std::mutex mutex;
+
+  /// \brief Notified when the last task finishes or the last helper leaves.
+  private: std::condition_variable finished;
+};
+
+/// \brief Executor that runs the tasks of all groups on one pool of threads,
+/// together with the threads that wait for the groups. A thread that waits
+/// for a group runs the tasks of the group that no pool thread has started,
+/// so groups run from inside a task neither add threads nor wait for a pool
+/// thread to become free.
+class ThreadedExecutor : public TaskExecutor
+{
+  /// \brief Destructor. Stops the pool threads.
+  public: ~ThreadedExecutor() override
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->stop = true;
+    }
+    this->wake.notify_all();
+    for (auto &thread : this->threads)
+      thread.join();
+  }
+
+  // Documentation inherited.
+  public: void RunAndWait(std::size_t _count,
+              const std::function<void(std::size_t)> &_task) override
+  {
+    if (_count == 1)
+    {
+      _task(0);
+      return;
+    }
+    if (_count == 0)
+      return;
+
+    std::call_once(this->started, [this] { this->Start(); });
+
+    TaskGroup group(_count, _task);
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      const std::size_t helpers =
+          std::min(_count - 1, this->threads.size());
+      this->queue.insert(this->queue.end(), helpers, &group);
+    }
+    this->wake.notify_all();
+
+    group.RunTasks();
+
+    // All tasks are started, so pool threads that have not taken the group
+    // yet would have nothing left to run.
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->queue.erase(
+          std::remove(this->queue.begin(), this->queue.end(), &group),
+          this->queue.end());
+    }
+    group.Wait();
+  }
+
+  /// \brief Start the pool threads.
+  private: void Start()
+  {
+    const unsigned int threadCount =
+        std::max(2u, std::thread::hardware_concurrency()) - 1;
+    this->threads.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i)
+      this->threads.emplace_back([this] { this->Work(); });
+  }
+
+  /// \brief Run tasks of the queued groups until the executor stops.
+  private: void Work()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true)
+    {
+      this->wake.wait(lock,
+          [this] { return this->stop || !this->queue.empty(); });
+      if (this->stop)
+        return;
+
+      TaskGroup *group = this->queue.front();
+      this->queue.pop_front();
+      // The group waits for its helpers, so it outlives this use of it.
+      group->AddHelper();
+      lock.unlock();
+      group->RunTasks();
+      group->RemoveHelper();
+      lock.lock();
+    }
+  }
+
+  /// \brief Pool threads.
+  private: std::vector<std::thread> threads;
+
+  /// \brief Starts the pool threads on the first group.
+  private: std::once_flag started;
+
+  /// \brief Groups that pool threads can help run, once per helper.
+  private: std::deque<TaskGroup *> queue;
+
+  /// \brief Set when the executor is destroyed.
+  private: bool stop = false;
+
+  /// \brief Guards queue and stop.
+  private: std::mutex mutex;
+
+  /// \brief Notified when groups are queued or the executor stops.
+  private: std::condition_variable wake;
+};
+
+/// \brief Executor that runs the tasks on the calling thread.
+class InlineExecutor : public TaskExecutor
+{
+  // Documentation inherited.
+  public: void RunAndWait(std::size_t _count,
+              const std::function<void(std::size_t)> &_task) override
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+      _task(i);
+  }
+};
+}
+
+/////////////////////////////////////////////////
+TaskExecutor::~TaskExecutor() = default;
+
+/////////////////////////////////////////////////
+std::shared_ptr<TaskExecutor> TaskExecutor::Threaded()
+{
+  static const std::shared_ptr<TaskExecutor> executor =
+      std::make_shared<ThreadedExecutor>();
+  return executor;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<TaskExecutor> TaskExecutor::Inline()
+{
+  static const std::shared_ptr<TaskExecutor> executor =
+      std::make_shared<InlineExecutor>();
+  return executor;
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sdf/ParserConfig.hh"
+#include "sdf/Root.hh"
+#include "sdf/TaskExecutor.hh"
+#include "sdf/World.hh"
+
+/// \brief Executor that counts the groups and tasks it runs, and runs them
+/// on the calling thread.
+class CountingExecutor : public sdf::TaskExecutor
+{
+  public: void RunAndWait(std::size_t _count,
+              const std::function<void(std::size_t)> &_task) override
+  {
+    ++this->groups;
+    this->tasks += _count;
+    for (std::size_t i = 0; i < _count; ++i)
+      _task(i);
+  }
+
+  public: std::atomic<std::size_t> groups{0};
+  public: std::atomic<std::size_t> tasks{0};
+};
+
+/////////////////////////////////////////////////
+TEST(TaskExecutor, Inline)
+{
+  std::vector<std::size_t> indices;
+  const auto caller = std::this_thread::get_id();
+  sdf::TaskExecutor::Inline()->RunAndWait(3, [&](std::size_t _index)
+  {
+    EXPECT_EQ(caller, std::this_thread::get_id());
+    indices.push_back(_index);
+  });
+  EXPECT_EQ((std::vector<std::size_t>{0, 1, 2}), indices);
+  EXPECT_EQ(sdf::TaskExecutor::Inline(), sdf::TaskExecutor::Inline());
+}
+
+/////////////////////////////////////////////////
+TEST(TaskExecutor, Threaded)
+{
+  std::vector<std::atomic<int>> calls(8);
+  sdf::TaskExecutor::Threaded()->RunAndWait(calls.size(),
+      [&](std::size_t _index)
+      {
+        ++calls[_index];
+      });
+  for (const auto &count : calls)
+    EXPECT_EQ(1, count);
+
+  // Groups can be run from inside a task.
+  std::atomic<int> nested{0};
+  sdf::TaskExecutor::Threaded()->RunAndWait(2, [&](std::size_t)
+  {
+    sdf::TaskExecutor::Threaded()->RunAndWait(2, [&](std::size_t)
+    {
+      ++nested;
+    });
+  });
+  EXPECT_EQ(4, nested);
+
+  // Nested groups share the threads of the executor.
+  std::mutex mutex;
+  std::set<std::thread::id> threadIds;
+  sdf::TaskExecutor::Threaded()->RunAndWait(8, [&](std::size_t)
+  {
+    sdf::TaskExecutor::Threaded()->RunAndWait(8, [&](std::size_t)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      threadIds.insert(std::this_thread::get_id());
+    });
+  });
+  EXPECT_GE(std::max(2u, std::thread::hardware_concurrency()),
+            threadIds.size());
+}
+
+/////////////////////////////////////////////////
+TEST(TaskExecutor, ThreadedException)
+{
+  // The first exception thrown by a task is rethrown after all the tasks
+  // of the group finished.
+  std::atomic<int> calls{0};
+  EXPECT_THROW(sdf::TaskExecutor::Threaded()->RunAndWait(8,
+      [&](std::size_t _index)
+      {
+        ++calls;
+        if (_index % 2 == 1)
+          throw std::runtime_error("task " + std::to_string(_index));
+      }), std::runtime_error);
+  EXPECT_EQ(8, calls);
+
+  // The executor still runs groups afterwards.
+  calls = 0;
+  sdf::TaskExecutor::Threaded()->RunAndWait(4, [&](std::size_t)
+  {
+    ++calls;
+  });
+  EXPECT_EQ(4, calls);
+}
+
+/////////////////////////////////////////////////
+TEST(TaskExecutor, ParserConfig)
+{
+  sdf::ParserConfig config;
+  auto executor = std::make_shared<CountingExecutor>();
+  config.SetExecutor(executor);
+  EXPECT_EQ(executor, config.Executor());
+  config.SetExecutor(nullptr);
+  EXPECT_EQ(sdf::TaskExecutor::Threaded(), config.Executor());
+
+  std::string sdf = "<?xml version=\"1.0\"?><sdf version=\"1.8\">";
+  for (int w = 0; w < 3; ++w)
+  {
+    sdf += "<world name=\"world" + std::to_string(w) + "\">";
+    for (int m = 0; m < 3; ++m)
+    {
+      sdf += "<model name=\"model" + std::to_string(m) + "\">"
+             "<link name=\"link\"/></model>";
+    }
+    sdf += "</world>";
+  }
+  sdf += "</sdf>";
+
+  // Worlds and the graphs of their models are loaded by the executor of the
+  // configuration.
+  config.SetExecutor(executor);
+  config.SetWorldLoadThreadCount(2);
+  config.SetGraphBuildThreadCount(2);
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+  ASSERT_EQ(3u, root.WorldCount());
+  EXPECT_EQ(3u, root.WorldByIndex(2)->ModelCount());
+  EXPECT_LT(0u, executor->groups.load());
+  EXPECT_LE(2u, executor->tasks.load());
+}
@@ -15,8 +15,14 @@
  *
  */
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <locale>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "sdf/Types.hh"
@@ -26,43 +32,112 @@ namespace sdf
 inline namespace SDF_VERSION_NAMESPACE {
 
 /////////////////////////////////////////////////
-std::vector<std::string> split(const std::string &_str,
-                               const std::string &_splitter)
+/// \brief Part of the intern table. The table is split by the hash of the
+/// text so that threads loading documents concurrently seldom wait for
+/// each other.
+struct InternShard
 {
-  std::vector<std::string> ret;
-  size_t next = 0;
-  size_t current = next;
+  /// \brief Protects table and pruneSize.
+  std::mutex mutex;
+
+  /// \brief Interned strings by text. An entry expires with the last
+  /// InternedString that refers to it.
+  std::unordered_map<std::string, std::weak_ptr<const std::string>> table;
+
+  /// \brief Size of table at which expired entries are dropped.
+  std::size_t pruneSize = 64;
+};
 
-  if (_splitter.empty())
+/////////////////////////////////////////////////
+/// \brief Get the interned copy of a string, adding it to the intern table
+/// if no InternedString refers to it.
+/// \param[in] _str Text to intern.
+/// \return The entry in the intern table.
+static std::shared_ptr<const std::string> Intern(const std::string &_str)
+{
+  constexpr std::size_t kShardCount = 16;
+  // Intentionally leaked so that the table outlives any static objects
+  // that hold interned strings.
+  static auto *shards = new std::array<InternShard, kShardCount>();
+  InternShard &shard =
+      (*shards)[std::hash<std::string>()(_str) % kShardCount];
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  std::weak_ptr<const std::string> &entry = shard.table[_str];
+  std::shared_ptr<const std::string> str = entry.lock();
+  if (!str)
   {
-    // If the splitter is blank, just return the original
-    ret.push_back(_str);
-    return ret;
+    str = std::make_shared<const std::string>(_str);
+    entry = str;
   }
 
-  while (next != std::string::npos)
+  // Drop the entries that expired once the table has doubled in size
+  // since it was last pruned.
+  if (shard.table.size() >= shard.pruneSize)
   {
-    next = _str.find(_splitter, current);
-    ret.push_back(_str.substr(current, next - current));
-    current = next + _splitter.length();
+    for (auto it = shard.table.begin(); it != shard.table.end();)
+    {
+      if (it->second.expired())
+        it = shard.table.erase(it);
+      else
+        ++it;
+    }
+    shard.pruneSize = std::max<std::size_t>(64, 2 * shard.table.size());
   }
+  return str;
+}
 
+/////////////////////////////////////////////////
+InternedString::InternedString()
+{
+  // Intentionally leaked so that the empty string is never freed.
+  static const auto *empty =
+      new std::shared_ptr<const std::string>(Intern(std::string()));
+  this->str = *empty;
+}
+
+/////////////////////////////////////////////////
+InternedString::InternedString(const std::string &_str)
+  : str(Intern(_str))
+{
+}
+
+/////////////////////////////////////////////////
+InternedString::InternedString(const char *_str)
+  : str(Intern(_str))
+{
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> split(const std::string &_str,
+                               const std::string &_splitter)
+{
+  std::vector<std::string> ret;
+  Tokenizer tokens(_str, _splitter);
+  for (std::string_view token; tokens.Next(token);)
+    ret.emplace_back(token);
   return ret;
 }
 
 //////////////////////////////////////////////////
 std::string trim(const char *_in)
 {
-  return sdf::trim(std::string(_in));
+  return std::string(trimView(_in));
 }
 
 //////////////////////////////////////////////////
 std::string trim(const std::string &_in)
+{
+  return std::string(trimView(_in));
+}
+
+//////////////////////////////////////////////////
+std::string_view trimView(std::string_view _in)
 {
   const size_t strBegin = _in.find_first_not_of(" \t\n");
-  if (strBegin == std::string::npos)
+  if (strBegin == std::string_view::npos)
   {
-    return "";
+    return std::string_view();
   }
 
   const size_t strRange = _in.find_last_not_of(" \t\n") - strBegin + 1;
@@ -74,8 +149,11 @@ std::string trim(const std::string &_in)
 std::string lowercase(const std::string &_in)
 {
   std::string out = _in;
+  // Constructing a locale copies the global one under a lock, so it is only
+  // done once per string.
+  const std::locale locale;
   for (size_t i = 0; i < out.size(); ++i)
-    out[i] = std::tolower(out[i], std::locale());
+    out[i] = std::tolower(out[i], locale);
   return out;
 }
 
@@ -96,53 +174,25 @@ std::ostream &operator<<(std::ostream &_out, const sdf::Errors &_errs)
 std::pair<std::string, std::string> SplitName(
     const std::string &_absoluteName)
 {
-  const auto pos = _absoluteName.rfind(kSdfScopeDelimiter);
-  if (pos != std::string::npos)
+  const ScopedName name(_absoluteName);
+  if (name.IsScoped())
   {
-    const std::string first = _absoluteName.substr(0, pos);
-    const std::string second =
-        _absoluteName.substr(pos + kSdfScopeDelimiter.size());
-    return {first, second};
+    return {std::string(name.ScopeName().Name()),
+            std::string(name.LocalName())};
   }
   return {"", _absoluteName};
 }
 
-static bool EndsWithDelimiter(const std::string &_s)
-{
-  if (_s.size() < kSdfScopeDelimiter.size())
-    return false;
-
-  const size_t startPosition = _s.size() - kSdfScopeDelimiter.size();
-  return _s.compare(
-    startPosition, kSdfScopeDelimiter.size(), kSdfScopeDelimiter) == 0;
-}
-
-static bool StartsWithDelimiter(const std::string &_s)
-{
-  if (_s.size() < kSdfScopeDelimiter.size())
-    return false;
-
-  return _s.compare(0, kSdfScopeDelimiter.size(), kSdfScopeDelimiter) == 0;
-}
-
 // Join a scope name prefix with a local name using the scope delimeter
 std::string JoinName(
     const std::string &_scopeName, const std::string &_localName)
 {
-  if (_scopeName.empty())
-    return _localName;
-  if (_localName.empty())
-    return _scopeName;
-
-  const bool scopeNameEndsWithDelimiter = EndsWithDelimiter(_scopeName);
-  const bool localNameStartsWithDelimiter = StartsWithDelimiter(_localName);
-
-  if (scopeNameEndsWithDelimiter && localNameStartsWithDelimiter)
-    return _scopeName + _localName.substr(kSdfScopeDelimiter.size());
-  else if (scopeNameEndsWithDelimiter || localNameStartsWithDelimiter)
-    return _scopeName + _localName;
-  else
-    return _scopeName + kSdfScopeDelimiter + _localName;
+  std::string name;
+  name.reserve(_scopeName.size() + kSdfScopeDelimiter.size() +
+               _localName.size());
+  name = _scopeName;
+  ScopedName::Join(name, _localName);
+  return name;
 }
 }
 }
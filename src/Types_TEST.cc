@@ -17,8 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 #include "sdf/Error.hh"
@@ -101,6 +104,38 @@ TEST(Types, trim_nothing)
   EXPECT_EQ(out, "xyz");
 }
 
+/////////////////////////////////////////////////
+TEST(Types, trimView)
+{
+  const std::string str = "\n  hello there \t";
+  std::string_view view = sdf::trimView(str);
+  EXPECT_EQ("hello there", view);
+  EXPECT_EQ(str.data() + 3, view.data());
+
+  EXPECT_EQ("hello", sdf::trimView("hello"));
+  EXPECT_TRUE(sdf::trimView("").empty());
+  EXPECT_TRUE(sdf::trimView(" \t\n ").empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Types, Tokenizer)
+{
+  // The tokens are the same as the ones of split
+  for (const auto &[str, splitter] : std::vector<std::pair<const char *,
+       const char *>>{{"a b c", " "}, {" a  b ", " "}, {"a::b::", "::"},
+       {"", " "}, {"abc", ""}, {"", ""}, {"hello/there", ":"}})
+  {
+    std::vector<std::string> tokens;
+    sdf::Tokenizer tokenizer(str, splitter);
+    for (std::string_view token; tokenizer.Next(token);)
+      tokens.emplace_back(token);
+    EXPECT_EQ(sdf::split(str, splitter), tokens) << str;
+
+    std::string_view token;
+    EXPECT_FALSE(tokenizer.Next(token));
+  }
+}
+
 /////////////////////////////////////////////////
 TEST(Types, ErrorsOutputStream)
 {
@@ -199,6 +234,92 @@ TEST(Types, JoinName)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(Types, ScopedName)
+{
+  const std::string str = "a::bb::c";
+  const sdf::ScopedName name(str);
+  EXPECT_EQ(str, name.Name());
+  EXPECT_TRUE(name.IsScoped());
+  EXPECT_EQ("a", name.FirstSegment());
+  EXPECT_EQ("c", name.LocalName());
+  EXPECT_EQ(str.data() + 7, name.LocalName().data());
+
+  const sdf::ScopedName rest = name.WithoutFirstSegment();
+  EXPECT_EQ("bb::c", rest.Name());
+  EXPECT_EQ("bb", rest.FirstSegment());
+  EXPECT_EQ("c", rest.LocalName());
+  EXPECT_EQ("bb", rest.ScopeName().Name());
+  EXPECT_FALSE(rest.ScopeName().IsScoped());
+
+  const sdf::ScopedName scope = name.ScopeName();
+  EXPECT_EQ("a::bb", scope.Name());
+  EXPECT_EQ("a", scope.FirstSegment());
+  EXPECT_EQ("bb", scope.LocalName());
+  EXPECT_EQ("bb", scope.WithoutFirstSegment().Name());
+  EXPECT_FALSE(scope.WithoutFirstSegment().IsScoped());
+
+  const sdf::ScopedName local("c");
+  EXPECT_FALSE(local.IsScoped());
+  EXPECT_EQ("c", local.FirstSegment());
+  EXPECT_EQ("c", local.LocalName());
+  EXPECT_TRUE(local.ScopeName().Name().empty());
+  EXPECT_TRUE(local.WithoutFirstSegment().Name().empty());
+
+  // Join has the same result as JoinName
+  for (const auto &[scopeName, localName] :
+       std::vector<std::pair<std::string, std::string>>{{"a", "b"},
+       {"a::", "b"}, {"a", "::b"}, {"a::", "::b"}, {"", "b"}, {"a", ""}})
+  {
+    std::string joined = scopeName;
+    sdf::ScopedName::Join(joined, localName);
+    EXPECT_EQ(sdf::JoinName(scopeName, localName), joined);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Types, InternedString)
+{
+  sdf::InternedString empty;
+  EXPECT_TRUE(empty.Str().empty());
+  EXPECT_EQ(empty, sdf::InternedString(""));
+
+  sdf::InternedString link1("link");
+  sdf::InternedString link2(std::string("li") + "nk");
+  sdf::InternedString joint("joint");
+
+  // Equal text shares the same interned storage.
+  EXPECT_EQ(&link1.Str(), &link2.Str());
+  EXPECT_NE(&link1.Str(), &joint.Str());
+  EXPECT_EQ(link1, link2);
+  EXPECT_NE(link1, joint);
+
+  EXPECT_EQ(link1, "link");
+  EXPECT_EQ(link1, std::string("link"));
+  EXPECT_EQ(std::string("link"), link1);
+  EXPECT_NE(std::string("joint"), link1);
+
+  const std::string &str = link1;
+  EXPECT_EQ("link", str);
+
+  std::ostringstream stream;
+  stream << joint;
+  EXPECT_EQ("joint", stream.str());
+
+  link2 = "frame";
+  EXPECT_EQ("frame", link2.Str());
+  EXPECT_EQ("link", link1.Str());
+
+  // An entry lives as long as an InternedString refers to it, and text
+  // interned again while it lives shares it.
+  auto custom = std::make_unique<sdf::InternedString>("custom_description");
+  sdf::InternedString copy = *custom;
+  custom.reset();
+  EXPECT_EQ("custom_description", copy.Str());
+  EXPECT_EQ(&copy.Str(), &sdf::InternedString("custom_description").Str());
+  EXPECT_EQ(copy, sdf::InternedString(std::string("custom_description")));
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "sdf/Filesystem.hh"
+#include "sdf/SDFImpl.hh"
+#include "UpgradedFile.hh"
+#include "Utils.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/// \brief Start of the comment written by upgradedFileHeader.
+static constexpr char kHeaderStart[] = "<!-- sdformat upgrade source='";
+
+/// \brief Separator of the source name and hash in the comment.
+static constexpr char kHeaderHash[] = "' hash='";
+
+/// \brief Number of bytes at the start of a file that are searched for the
+/// comment.
+static constexpr std::streamsize kHeaderSearchSize = 4096;
+
+/////////////////////////////////////////////////
+/// \brief Get the suffix of the names of upgraded files.
+/// \return A dash followed by the SDFormat version, with underscores instead
+/// of periods.
+static std::string upgradedSuffix()
+{
+  std::string version = SDF::Version();
+  std::replace(version.begin(), version.end(), '.', '_');
+  return "-" + version;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the length of the stem of a file name, which is the name
+/// without its extension. A name that starts with its only period has no
+/// extension.
+/// \param[in] _name Name of a file, without a directory.
+/// \return The number of characters before the extension.
+static std::size_t stemLength(const std::string &_name)
+{
+  const std::size_t dot = _name.rfind('.');
+  return (dot == std::string::npos || dot == 0) ? _name.size() : dot;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the path of a file in the same directory as another file.
+/// \param[in] _path Path of a file.
+/// \param[in] _name Name of the other file.
+/// \return The path of _name in the directory of _path.
+static std::string siblingPath(const std::string &_path,
+    const std::string &_name)
+{
+  const std::string dir = filesystem::parent_path(_path);
+  return dir.empty() ? _name : filesystem::append(dir, _name);
+}
+
+/////////////////////////////////////////////////
+std::string upgradedFilePath(const std::string &_path)
+{
+  std::string name = filesystem::basename(_path);
+  name.insert(stemLength(name), upgradedSuffix());
+  return siblingPath(_path, name);
+}
+
+/////////////////////////////////////////////////
+std::string fileContentHash(const std::string &_path)
+{
+  std::uint64_t hash = 0;
+  std::uint64_t size = 0;
+  if (!hashFile(_path, hash, size))
+    return "";
+
+  std::ostringstream out;
+  out << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return out.str();
+}
+
+/////////////////////////////////////////////////
+std::string upgradedFileHeader(const std::string &_sourceName,
+    const std::string &_sourceHash)
+{
+  return kHeaderStart + _sourceName + kHeaderHash + _sourceHash + "' -->";
+}
+
+/////////////////////////////////////////////////
+bool readUpgradedFileHeader(const std::string &_path,
+    std::string &_sourceName, std::string &_sourceHash)
+{
+  std::ifstream in(_path, std::ios::binary);
+  if (!in)
+    return false;
+
+  std::string start(static_cast<std::size_t>(kHeaderSearchSize), '\0');
+  in.read(&start[0], kHeaderSearchSize);
+  start.resize(static_cast<std::size_t>(in.gcount()));
+
+  // The comment must come before the root element.
+  std::size_t begin = start.find(kHeaderStart);
+  if (begin == std::string::npos || start.find("<sdf") < begin)
+    return false;
+  begin += sizeof(kHeaderStart) - 1;
+
+  const std::size_t hash = start.find(kHeaderHash, begin);
+  if (hash == std::string::npos)
+    return false;
+  const std::size_t hashBegin = hash + sizeof(kHeaderHash) - 1;
+  const std::size_t end = start.find('\'', hashBegin);
+  if (end == std::string::npos)
+    return false;
+
+  _sourceName = start.substr(begin, hash - begin);
+  _sourceHash = start.substr(hashBegin, end - hashBegin);
+  return !_sourceName.empty() && !_sourceHash.empty();
+}
+
+/////////////////////////////////////////////////
+std::string preferredFilePath(const std::string &_path)
+{
+  const std::string name = filesystem::basename(_path);
+  const std::string stem = name.substr(0, stemLength(name));
+  const std::string suffix = upgradedSuffix();
+  std::string sourceName;
+  std::string sourceHash;
+
+  // An upgraded file, named by a model.config or directly. Its source is
+  // read instead if it was modified after it was upgraded, and the upgraded
+  // file is kept if the source was deleted.
+  if (stem.size() > suffix.size() &&
+      stem.compare(stem.size() - suffix.size(), suffix.size(), suffix) == 0 &&
+      readUpgradedFileHeader(_path, sourceName, sourceHash))
+  {
+    const std::string source = siblingPath(_path, sourceName);
+    const std::string hash = fileContentHash(source);
+    return (hash.empty() || hash == sourceHash) ? _path : source;
+  }
+
+  const std::string upgraded = upgradedFilePath(_path);
+  if (!filesystem::is_regular_file(upgraded))
+    return _path;
+
+  if (readUpgradedFileHeader(upgraded, sourceName, sourceHash) &&
+      sourceName == name &&
+      sourceHash == fileContentHash(_path))
+  {
+    return upgraded;
+  }
+  return _path;
+}
+}
+}
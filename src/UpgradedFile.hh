@@ -0,0 +1,72 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDFORMAT_UPGRADEDFILE_HH
+#define SDFORMAT_UPGRADEDFILE_HH
+
+#include <string>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Get the path of the upgraded copy of an SDFormat file, which is
+  /// written by `ign sdf --upgrade` next to the file. The version is
+  /// appended to the name of the file, for example model-1_9.sdf for
+  /// model.sdf.
+  /// \param[in] _path Path of the file.
+  /// \return Path of the upgraded copy for the current SDFormat version.
+  std::string upgradedFilePath(const std::string &_path);
+
+  /// \brief Compute the hash of the content of a file.
+  /// \param[in] _path Path of the file.
+  /// \return Hexadecimal FNV-1a hash of the bytes of the file, or an empty
+  /// string if it cannot be read.
+  std::string fileContentHash(const std::string &_path);
+
+  /// \brief Get the comment that records the source of an upgraded file.
+  /// It is written at the start of the upgraded file.
+  /// \param[in] _sourceName Name of the source file, relative to the
+  /// directory of the upgraded file.
+  /// \param[in] _sourceHash Hash of the source file, from fileContentHash.
+  /// \return The XML comment.
+  std::string upgradedFileHeader(const std::string &_sourceName,
+      const std::string &_sourceHash);
+
+  /// \brief Read the comment that records the source of an upgraded file.
+  /// \param[in] _path Path of the file.
+  /// \param[out] _sourceName Name of the source file.
+  /// \param[out] _sourceHash Hash of the source file when it was upgraded.
+  /// \return True if the file starts with a comment written by
+  /// upgradedFileHeader.
+  bool readUpgradedFileHeader(const std::string &_path,
+      std::string &_sourceName, std::string &_sourceHash);
+
+  /// \brief Choose between a file and its upgraded copy. The upgraded copy
+  /// is preferred when it was made from the current content of the source
+  /// file; if the source changed after it was upgraded, the source is read
+  /// and converted instead. This works both for source files and for
+  /// upgraded files that are named by a model.config.
+  /// \param[in] _path Path of the file to read.
+  /// \return Path of the file that should be read instead.
+  std::string preferredFilePath(const std::string &_path);
+  }
+}
+#endif
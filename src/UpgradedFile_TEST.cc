@@ -0,0 +1,142 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/parser.hh"
+#include "UpgradedFile.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _content Content of the file.
+void writeFile(const std::string &_path, const std::string &_content)
+{
+  std::ofstream out(_path, std::ios::binary);
+  out << _content;
+}
+
+/////////////////////////////////////////////////
+TEST(UpgradedFile, Paths)
+{
+  std::string version = sdf::SDF::Version();
+  std::replace(version.begin(), version.end(), '.', '_');
+  EXPECT_EQ(sdf::filesystem::append("models", "box", "model-" + version +
+                                    ".sdf"),
+            sdf::upgradedFilePath(
+                sdf::filesystem::append("models", "box", "model.sdf")));
+  EXPECT_EQ("empty-" + version + ".world",
+            sdf::upgradedFilePath("empty.world"));
+}
+
+/////////////////////////////////////////////////
+TEST(UpgradedFile, Header)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  std::filesystem::create_directories(tmpDir);
+  const std::string path =
+      sdf::filesystem::append(tmpDir, "upgraded_file_header.sdf");
+
+  writeFile(path, "<?xml version='1.0'?>\n<sdf version='1.9'/>\n");
+  const std::string hash = sdf::fileContentHash(path);
+  EXPECT_EQ(16u, hash.size());
+  EXPECT_EQ(hash, sdf::fileContentHash(path));
+  EXPECT_TRUE(sdf::fileContentHash(path + ".missing").empty());
+
+  std::string sourceName;
+  std::string sourceHash;
+  EXPECT_FALSE(sdf::readUpgradedFileHeader(path, sourceName, sourceHash));
+
+  writeFile(path, "<?xml version='1.0'?>\n" +
+      sdf::upgradedFileHeader("model.sdf", "0123456789abcdef") +
+      "\n<sdf version='1.9'/>\n");
+  EXPECT_NE(hash, sdf::fileContentHash(path));
+  EXPECT_TRUE(sdf::readUpgradedFileHeader(path, sourceName, sourceHash));
+  EXPECT_EQ("model.sdf", sourceName);
+  EXPECT_EQ("0123456789abcdef", sourceHash);
+
+  // The comment only counts before the root element.
+  writeFile(path, "<sdf version='1.9'>" +
+      sdf::upgradedFileHeader("model.sdf", "0123456789abcdef") + "</sdf>");
+  EXPECT_FALSE(sdf::readUpgradedFileHeader(path, sourceName, sourceHash));
+}
+
+/////////////////////////////////////////////////
+TEST(UpgradedFile, PreferredFilePath)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string dir = sdf::filesystem::append(tmpDir, "upgraded_file");
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+
+  const std::string source = sdf::filesystem::append(dir, "model.sdf");
+  const std::string upgraded = sdf::upgradedFilePath(source);
+  writeFile(source,
+      "<sdf version='1.6'><model name='old'><link name='link'/></model></sdf>");
+  EXPECT_EQ(source, sdf::preferredFilePath(source));
+
+  // An upgraded copy made from the current source is preferred.
+  writeFile(upgraded, "<?xml version='1.0'?>\n" +
+      sdf::upgradedFileHeader("model.sdf", sdf::fileContentHash(source)) +
+      "\n<sdf version='" + sdf::SDF::Version() + "'>" +
+      "<model name='new'><link name='link'/></model></sdf>\n");
+  EXPECT_EQ(upgraded, sdf::preferredFilePath(source));
+  EXPECT_EQ(upgraded, sdf::preferredFilePath(upgraded));
+
+  // The upgraded copy is read without conversion, unless disabled.
+  {
+    sdf::ParserConfig config;
+    sdf::SDFPtr sdf(new sdf::SDF());
+    sdf::init(sdf);
+    sdf::Errors errors;
+    EXPECT_TRUE(sdf::readFile(source, config, sdf, errors));
+    EXPECT_TRUE(errors.empty());
+    EXPECT_EQ(sdf::SDF::Version(), sdf->OriginalVersion());
+    EXPECT_EQ("new", sdf->Root()->GetElement("model")->Get<std::string>(
+        "name"));
+
+    config.SetUseUpgradedFiles(false);
+    sdf::SDFPtr original(new sdf::SDF());
+    sdf::init(original);
+    EXPECT_TRUE(sdf::readFile(source, config, original, errors));
+    EXPECT_TRUE(errors.empty());
+    EXPECT_EQ("1.6", original->OriginalVersion());
+    EXPECT_EQ("old", original->Root()->GetElement("model")->Get<std::string>(
+        "name"));
+  }
+
+  // The source is read once it is modified.
+  writeFile(source,
+      "<sdf version='1.6'><model name='edited'><link name='link'/></model>"
+      "</sdf>");
+  EXPECT_EQ(source, sdf::preferredFilePath(source));
+  EXPECT_EQ(source, sdf::preferredFilePath(upgraded));
+
+  // The upgraded copy is kept when its source is removed.
+  std::filesystem::remove(source);
+  EXPECT_EQ(upgraded, sdf::preferredFilePath(upgraded));
+}
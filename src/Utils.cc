@@ -14,10 +14,21 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <limits>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
+#include <ignition/math/Matrix3.hh>
+#include "sdf/Console.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/Geometry.hh"
 #include "sdf/SDFImpl.hh"
+#include "ErrorSink.hh"
+#include "InterfaceModelCache.hh"
 #include "Utils.hh"
 
 namespace sdf
@@ -38,6 +49,12 @@ bool isReservedName(const std::string &_name)
 bool loadName(sdf::ElementPtr _sdf, std::string &_name)
 {
   // Read the name
+  if (const std::string *name = _sdf->GetPtr<std::string>("name"))
+  {
+    _name = *name;
+    return true;
+  }
+
   std::pair<std::string, bool> namePair = _sdf->Get<std::string>("name", "");
 
   _name = namePair.first;
@@ -51,12 +68,20 @@ bool loadPose(sdf::ElementPtr _sdf, ignition::math::Pose3d &_pose,
   sdf::ElementPtr sdf = _sdf;
   if (_sdf->GetName() != "pose")
   {
-    if (_sdf->HasElement("pose"))
-      sdf = _sdf->GetElement("pose");
-    else
+    sdf = _sdf->FindElement("pose");
+    if (!sdf)
       return false;
   }
 
+  // Read the pose value and frame without temporary copies when possible.
+  if (const auto *pose = sdf->GetPtr<ignition::math::Pose3d>())
+  {
+    const std::string *frame = sdf->GetPtr<std::string>("relative_to");
+    _pose = *pose;
+    _frame = frame ? *frame : "";
+    return true;
+  }
+
   // Read the frame. An empty frame implies the parent frame.
   std::pair<std::string, bool> framePair =
       sdf->Get<std::string>("relative_to", "");
@@ -77,6 +102,65 @@ bool loadPose(sdf::ElementPtr _sdf, ignition::math::Pose3d &_pose,
   return posePair.second;
 }
 
+/// \brief Whether DOM objects loaded on this thread release their elements.
+static thread_local bool tReleaseElements = false;
+
+/////////////////////////////////////////////////
+sdf::ElementPtr retainedElement(const sdf::ElementPtr &_sdf)
+{
+  return tReleaseElements ? nullptr : _sdf;
+}
+
+/////////////////////////////////////////////////
+bool elementsReleased()
+{
+  return tReleaseElements;
+}
+
+/////////////////////////////////////////////////
+ScopedElementRelease::ScopedElementRelease(bool _release)
+  : previous(tReleaseElements)
+{
+  tReleaseElements = _release;
+}
+
+/////////////////////////////////////////////////
+ScopedElementRelease::~ScopedElementRelease()
+{
+  tReleaseElements = this->previous;
+}
+
+/// \brief Element whose descendants had their names checked on this
+/// thread, or nullptr.
+static thread_local const sdf::Element *tCheckedNamesElement = nullptr;
+
+/////////////////////////////////////////////////
+bool childNamesChecked(const sdf::ElementPtr &_sdf)
+{
+  if (nullptr == tCheckedNamesElement)
+    return false;
+
+  for (sdf::ElementPtr elem = _sdf; elem; elem = elem->GetParent())
+  {
+    if (elem.get() == tCheckedNamesElement)
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+ScopedCheckedNames::ScopedCheckedNames(const sdf::ElementPtr &_sdf)
+  : previous(tCheckedNamesElement)
+{
+  tCheckedNamesElement = _sdf.get();
+}
+
+/////////////////////////////////////////////////
+ScopedCheckedNames::~ScopedCheckedNames()
+{
+  tCheckedNamesElement = this->previous;
+}
+
 /////////////////////////////////////////////////
 // cppcheck-suppress unusedFunction
 double infiniteIfNegative(const double _value)
@@ -87,6 +171,159 @@ double infiniteIfNegative(const double _value)
   return _value;
 }
 
+/////////////////////////////////////////////////
+void hashBytes(std::uint64_t &_hash, const char *_data, std::size_t _size)
+{
+  for (std::size_t i = 0; i < _size; ++i)
+  {
+    _hash ^= static_cast<unsigned char>(_data[i]);
+    _hash *= 1099511628211ull;
+  }
+}
+
+/////////////////////////////////////////////////
+bool hashFile(const std::string &_path, std::uint64_t &_hash,
+    std::uint64_t &_size)
+{
+  std::ifstream in(_path, std::ios::binary);
+  if (!in)
+    return false;
+
+  std::uint64_t hash = kFnvOffsetBasis;
+  std::uint64_t size = 0;
+  char chunk[65536];
+  while (in.read(chunk, sizeof(chunk)) || in.gcount() > 0)
+  {
+    const std::size_t count = static_cast<std::size_t>(in.gcount());
+    hashBytes(hash, chunk, count);
+    size += count;
+  }
+  if (in.bad())
+    return false;
+
+  _hash = hash;
+  _size = size;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void hashString(std::uint64_t &_hash, const std::string &_str)
+{
+  hashBytes(_hash, _str.data(), _str.size());
+
+  // The length ends the string, so that consecutive strings are not
+  // confused with their concatenation.
+  _hash ^= _str.size();
+  _hash *= 1099511628211ull;
+}
+
+/////////////////////////////////////////////////
+void hashNumber(std::uint64_t &_hash, std::uint64_t _value)
+{
+  for (int i = 0; i < 8; ++i)
+  {
+    _hash ^= (_value >> (8 * i)) & 0xff;
+    _hash *= 1099511628211ull;
+  }
+}
+
+/////////////////////////////////////////////////
+bool identicalContent(const Element &_a, const Element &_b)
+{
+  if (&_a == &_b)
+    return true;
+  if (_a.GetName() != _b.GetName() || _a.RawXml() != _b.RawXml())
+    return false;
+
+  const Param_V &attributesA = _a.GetAttributes();
+  const Param_V &attributesB = _b.GetAttributes();
+  if (attributesA.size() != attributesB.size())
+    return false;
+  for (std::size_t i = 0; i < attributesA.size(); ++i)
+  {
+    if (attributesA[i]->GetKey() != attributesB[i]->GetKey() ||
+        attributesA[i]->GetAsString() != attributesB[i]->GetAsString())
+    {
+      return false;
+    }
+  }
+
+  const ParamPtr valueA = _a.GetValue();
+  const ParamPtr valueB = _b.GetValue();
+  if (static_cast<bool>(valueA) != static_cast<bool>(valueB) ||
+      (valueA && valueA->GetAsString() != valueB->GetAsString()))
+  {
+    return false;
+  }
+
+  const ElementChildren childrenA = _a.Children();
+  const ElementChildren childrenB = _b.Children();
+  auto itA = childrenA.begin();
+  auto itB = childrenB.begin();
+  for (; itA != childrenA.end() && itB != childrenB.end(); ++itA, ++itB)
+  {
+    if (!identicalContent(**itA, **itB))
+      return false;
+  }
+  return itA == childrenA.end() && itB == childrenB.end();
+}
+
+/////////////////////////////////////////////////
+bool isEmptyBox(const ignition::math::AxisAlignedBox &_box)
+{
+  return _box.Min().X() > _box.Max().X() ||
+         _box.Min().Y() > _box.Max().Y() ||
+         _box.Min().Z() > _box.Max().Z();
+}
+
+/////////////////////////////////////////////////
+ignition::math::AxisAlignedBox transformedBox(
+    const ignition::math::AxisAlignedBox &_box,
+    const ignition::math::Pose3d &_pose)
+{
+  if (isEmptyBox(_box))
+    return _box;
+
+  // Each axis of the result sums the extremes of the rotated axes of the
+  // box. Rotation terms that are zero are skipped so that an infinite extent
+  // does not turn into NaN on the axes it is not rotated to.
+  const ignition::math::Matrix3d rot(_pose.Rot());
+  ignition::math::Vector3d min = _pose.Pos();
+  ignition::math::Vector3d max = _pose.Pos();
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      const double r = rot(i, j);
+      if (r == 0.0)
+        continue;
+      const double a = r * _box.Min()[j];
+      const double b = r * _box.Max()[j];
+      min[i] += std::min(a, b);
+      max[i] += std::max(a, b);
+    }
+  }
+  return ignition::math::AxisAlignedBox(min, max);
+}
+
+/////////////////////////////////////////////////
+ignition::math::AxisAlignedBox placedGeometryBounds(const Geometry *_geom,
+    const ignition::math::Pose3d &_pose)
+{
+  if (nullptr == _geom)
+    return ignition::math::AxisAlignedBox();
+
+  const auto box = _geom->AxisAlignedBox();
+  if (!box)
+  {
+    const double inf = std::numeric_limits<double>::infinity();
+    return ignition::math::AxisAlignedBox(
+        ignition::math::Vector3d(-inf, -inf, -inf),
+        ignition::math::Vector3d(inf, inf, inf));
+  }
+  return transformedBox(*box, _pose);
+}
+
 /////////////////////////////////////////////////
 // cppcheck-suppress unusedFunction
 bool isValidFrameReference(const std::string &_name)
@@ -165,6 +402,47 @@ void enforceConfigurablePolicyCondition(
   }
 }
 
+/////////////////////////////////////////////////
+bool isPolicyConditionReported(const sdf::EnforcementPolicy _policy)
+{
+  switch (_policy)
+  {
+    case EnforcementPolicy::ERR:
+      return true;
+    case EnforcementPolicy::WARN:
+      return Console::WarningsReported();
+    case EnforcementPolicy::LOG:
+      return Console::LogReported();
+    default:
+      throw std::runtime_error("Unhandled warning policy enum value");
+  }
+}
+
+/////////////////////////////////////////////////
+bool resourceExists(const sdf::ParserConfig &_config,
+                    const std::string &_path)
+{
+  if (auto provider = _config.GetResourceProvider())
+    return provider->Exists(_path);
+  return sdf::filesystem::exists(_path);
+}
+
+/////////////////////////////////////////////////
+bool resourceIsDirectory(const sdf::ParserConfig &_config,
+                         const std::string &_path)
+{
+  if (auto provider = _config.GetResourceProvider())
+    return provider->IsDirectory(_path);
+  return sdf::filesystem::is_directory(_path);
+}
+
+/////////////////////////////////////////////////
+bool maxErrorsReached(const sdf::ParserConfig &_config,
+                      const sdf::Errors &_errors)
+{
+  return _config.MaxErrors() != 0 && _errors.size() >= _config.MaxErrors();
+}
+
 /////////////////////////////////////////////////
 /// \brief Compute the absolute name of an entity by walking up the element
 /// tree.
@@ -175,13 +453,15 @@ static std::optional<std::string> computeAbsoluteName(
     const sdf::ElementPtr &_sdf, sdf::Errors &_errors)
 {
   std::vector<std::string> names;
-  for (auto parent = _sdf;
+  std::size_t size = 0;
+  for (sdf::Element *parent = _sdf.get();
        parent->GetName() != "world" && parent->GetName() != "sdf";
-       parent = parent->GetParent())
+       parent = parent->ParentRaw())
   {
     if (parent->HasAttribute("name"))
     {
       names.push_back(parent->GetAttribute("name")->GetAsString());
+      size += names.back().size() + kSdfScopeDelimiter.size();
     }
     else
     {
@@ -192,7 +472,10 @@ static std::optional<std::string> computeAbsoluteName(
   }
   if (names.size() > 0)
   {
-    std::string absoluteParentName = names.back();
+    // The name is built in one string, sized for all the segments.
+    std::string absoluteParentName;
+    absoluteParentName.reserve(size);
+    absoluteParentName = names.back();
     auto it = names.rbegin();
     std::advance(it, 1);
     for (; it != names.rend(); ++it)
@@ -207,19 +490,136 @@ static std::optional<std::string> computeAbsoluteName(
   return std::nullopt;
 }
 
+/////////////////////////////////////////////////
+/// \brief Call the custom model parsers for an include until one of them
+/// parses it or reports errors.
+/// \param[in] _include The include.
+/// \param[in] _config Parser configuration options.
+/// \param[out] _errors Errors reported by the custom model parser.
+/// \return The interface model, or nullptr if no custom parser parsed it.
+static InterfaceModelPtr callCustomModelParsers(
+    const sdf::NestedInclude &_include, const sdf::ParserConfig &_config,
+    sdf::Errors &_errors)
+{
+  // Iterate through custom model parsers in reverse per the SDFormat
+  // proposal, see "Minimal libsdformat interface types for non-SDFormat
+  // models" in http://sdformat.org/tutorials?tut=composition_proposal
+  const auto &customParsers =  _config.CustomModelParsers();
+  for (auto parserIt = customParsers.rbegin();
+       parserIt != customParsers.rend(); ++parserIt)
+  {
+    sdf::Errors errors;
+    auto model = (*parserIt)(_include, errors);
+    if (!errors.empty())
+    {
+      // If there are any errors, stop iterating through the custom parsers
+      // and report the error
+      _errors.insert(_errors.end(), errors.begin(), errors.end());
+      return nullptr;
+    }
+    else if (nullptr != model)
+    {
+      return model;
+    }
+    // If there are no errors and model == nullptr, continue iterating through
+    // the custom parsers.
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse an included model with the custom model parsers.
+/// \param[in] _include The include.
+/// \param[in] _config Parser configuration options.
+/// \param[out] _errors Errors encountered.
+/// \return The interface model, or nullptr if no custom parser parsed it.
+static InterfaceModelPtr parseInterfaceModel(
+    const sdf::NestedInclude &_include, const sdf::ParserConfig &_config,
+    sdf::Errors &_errors)
+{
+  InterfaceModelPtr model;
+  auto cache = InterfaceModelCache::Of(_config);
+  if (cache)
+  {
+    // The cached model only depends on the file, its instances get the
+    // overrides of each include
+    InterfaceModelConstPtr cachedModel;
+    if (!cache->Find(_include.ResolvedFileName(), cachedModel))
+    {
+      sdf::NestedInclude fileInclude;
+      fileInclude.SetUri(_include.Uri());
+      fileInclude.SetResolvedFileName(_include.ResolvedFileName());
+
+      sdf::Errors errors;
+      cachedModel = callCustomModelParsers(fileInclude, _config, errors);
+      if (!errors.empty())
+      {
+        _errors.insert(_errors.end(), errors.begin(), errors.end());
+        return nullptr;
+      }
+      cache->Insert(_include.ResolvedFileName(), cachedModel);
+    }
+
+    if (cachedModel)
+      model = InterfaceModelCache::Instantiate(*cachedModel, _include);
+  }
+  else
+  {
+    model = callCustomModelParsers(_include, _config, _errors);
+  }
+
+  if (!model)
+    return nullptr;
+
+  if (model->Name() == "")
+  {
+    _errors.emplace_back(sdf::ErrorCode::ATTRIBUTE_INVALID,
+        "Missing name of custom model with URI [" + _include.Uri() + "]");
+  }
+  else if (_include.IsMerge().value_or(false) &&
+           !model->ParserSupportsMergeInclude())
+  {
+    _errors.emplace_back(sdf::ErrorCode::MERGE_INCLUDE_UNSUPPORTED,
+                         "Custom parser does not support "
+                         "merge-include, but merge-include was "
+                         "requested for model with uri [" +
+                             _include.Uri() + "]");
+  }
+  else
+  {
+    return model;
+  }
+  return nullptr;
+}
+
 /////////////////////////////////////////////////
 // cppcheck-suppress unusedFunction
 sdf::Errors loadIncludedInterfaceModels(sdf::ElementPtr _sdf,
     const sdf::ParserConfig &_config,
     std::vector<std::pair<NestedInclude, InterfaceModelPtr>> &_models)
 {
-  sdf::Errors allErrors;
-  for (auto includeElem = _sdf->GetElementImpl("include"); includeElem;
-       includeElem = includeElem->GetNextElement("include"))
+  /// \brief An include to be parsed by the custom model parsers.
+  struct InterfaceModelInclude
   {
+    /// \brief The include.
     sdf::NestedInclude include;
+
+    /// \brief The parsed model, or nullptr.
+    InterfaceModelPtr model;
+  };
+  std::vector<InterfaceModelInclude> includes;
+
+  // The errors of each include are merged in document order.
+  const auto includeElems = _sdf->Children("include");
+  ErrorSink includeErrors(includeElems.size());
+
+  for (const sdf::ElementPtr &includeElem : includeElems)
+  {
+    includes.emplace_back();
+    sdf::NestedInclude &include = includes.back().include;
     include.SetUri(includeElem->Get<std::string>("uri"));
-    auto absoluteParentName = computeAbsoluteName(_sdf, allErrors);
+    auto absoluteParentName = computeAbsoluteName(
+        _sdf, includeErrors.TaskErrors(includes.size() - 1));
 
     if (absoluteParentName.has_value())
     {
@@ -259,47 +659,44 @@ sdf::Errors loadIncludedInterfaceModels(sdf::ElementPtr _sdf,
     {
       include.SetIsMerge(includeElem->Get<bool>("merge"));
     }
+  }
 
-    // Iterate through custom model parsers in reverse per the SDFormat proposal
-    // See http://sdformat.org/tutorials?tut=composition_proposal&cat=pose_semantics_docs&#1-5-minimal-libsdformat-interface-types-for-non-sdformat-models
-    const auto &customParsers =  _config.CustomModelParsers();
-    for (auto parserIt = customParsers.rbegin();
-         parserIt != customParsers.rend(); ++parserIt)
+  // The models are parsed concurrently if the custom model parsers are
+  // thread-safe, and merged in document order.
+  auto parseInclude = [&](std::size_t _index)
+  {
+    includes[_index].model = parseInterfaceModel(includes[_index].include,
+        _config, includeErrors.TaskErrors(_index));
+    includeErrors.Finish(_index);
+  };
+  const std::size_t threadCount = std::min<std::size_t>(
+      std::max(1u, std::thread::hardware_concurrency()), includes.size());
+  if (_config.CustomModelParsersThreadSafe() && threadCount > 1 &&
+      !_config.CustomModelParsers().empty())
+  {
+    std::atomic<std::size_t> nextInclude{0};
+    auto parseIncludes = [&](std::size_t)
     {
-      sdf::Errors errors;
-      auto model = (*parserIt)(include, errors);
-      if (!errors.empty())
-      {
-        // If there are any errors, stop iterating through the custom parsers
-        // and report the error
-        allErrors.insert(allErrors.end(), errors.begin(), errors.end());
-        break;
-      }
-      else if (nullptr != model)
+      for (std::size_t i = nextInclude++; i < includes.size();
+           i = nextInclude++)
       {
-        if (model->Name() == "")
-        {
-          allErrors.emplace_back(sdf::ErrorCode::ATTRIBUTE_INVALID,
-              "Missing name of custom model with URI [" + include.Uri() + "]");
-        }
-        else if (include.IsMerge().value_or(false) &&
-                 !model->ParserSupportsMergeInclude())
-        {
-          allErrors.emplace_back(sdf::ErrorCode::MERGE_INCLUDE_UNSUPPORTED,
-                                 "Custom parser does not support "
-                                 "merge-include, but merge-include was "
-                                 "requested for model with uri [" +
-                                     include.Uri() + "]");
-        }
-        else
-        {
-          _models.emplace_back(include, model);
-        }
-        break;
+        parseInclude(i);
       }
-      // If there are no errors and model == nullptr, continue iterating through
-      // the custom parsers.
-    }
+    };
+    _config.Executor()->RunAndWait(threadCount, parseIncludes);
+  }
+  else
+  {
+    for (std::size_t i = 0; i < includes.size(); ++i)
+      parseInclude(i);
+  }
+
+  sdf::Errors allErrors;
+  includeErrors.MergeInto(allErrors);
+  for (auto &include : includes)
+  {
+    if (include.model)
+      _models.emplace_back(std::move(include.include), include.model);
   }
 
   return allErrors;
@@ -18,10 +18,15 @@
 #define SDFORMAT_UTILS_HH
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <optional>
+#include <type_traits>
 #include <utility>
 #include <vector>
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Pose3.hh>
 #include "sdf/Error.hh"
 #include "sdf/Element.hh"
 #include "sdf/InterfaceElements.hh"
@@ -34,6 +39,9 @@ namespace sdf
   inline namespace SDF_VERSION_NAMESPACE {
   //
 
+  // Forward declarations.
+  class Geometry;
+
   /// \brief Check if the passed string is a reserved name.
   /// This currently includes "world" and all strings that start
   /// and end with "__".
@@ -72,6 +80,70 @@ namespace sdf
   /// value.
   double infiniteIfNegative(double _value);
 
+  /// \brief Initial value of a 64-bit FNV-1a hash.
+  constexpr std::uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+
+  /// \brief Add bytes to a 64-bit FNV-1a hash. Unlike hashString, nothing
+  /// marks the end of the bytes, so data hashed in chunks has the hash of
+  /// the whole data.
+  /// \param[in,out] _hash The hash.
+  /// \param[in] _data The bytes.
+  /// \param[in] _size Number of bytes.
+  void hashBytes(std::uint64_t &_hash, const char *_data, std::size_t _size);
+
+  /// \brief Compute the 64-bit FNV-1a hash of the contents of a file.
+  /// \param[in] _path Path of the file.
+  /// \param[out] _hash Hash of the contents.
+  /// \param[out] _size Size of the file in bytes.
+  /// \return True if the file was read.
+  bool hashFile(const std::string &_path, std::uint64_t &_hash,
+                std::uint64_t &_size);
+
+  /// \brief Add a string to a 64-bit FNV-1a hash.
+  /// \param[in,out] _hash The hash.
+  /// \param[in] _str The string.
+  void hashString(std::uint64_t &_hash, const std::string &_str);
+
+  /// \brief Add a number to a 64-bit FNV-1a hash.
+  /// \param[in,out] _hash The hash.
+  /// \param[in] _value The number.
+  void hashNumber(std::uint64_t &_hash, std::uint64_t _value);
+
+  /// \brief Check whether two element trees have the same content, which
+  /// is what Element::ContentHash is a hash of: the element names, the
+  /// attributes, the values and the raw XML. Unlike diffElements, equal
+  /// hashes are not trusted, so this tells apart trees whose hashes
+  /// collide.
+  /// \param[in] _a The first tree.
+  /// \param[in] _b The second tree.
+  /// \return True if the trees have the same content.
+  bool identicalContent(const Element &_a, const Element &_b);
+
+  /// \brief Check whether a box contains no point, such as a box made by the
+  /// default constructor of ignition::math::AxisAlignedBox.
+  /// \param[in] _box The box.
+  /// \return True if the minimum corner exceeds the maximum on an axis.
+  bool isEmptyBox(const ignition::math::AxisAlignedBox &_box);
+
+  /// \brief Get the smallest axis-aligned box that contains a transformed
+  /// box. Infinite extents stay infinite along the axes they are rotated to.
+  /// \param[in] _box The box, in the source frame.
+  /// \param[in] _pose Pose of the source frame in the target frame.
+  /// \return The box that contains _box, in the target frame. Empty if _box
+  /// is empty.
+  ignition::math::AxisAlignedBox transformedBox(
+      const ignition::math::AxisAlignedBox &_box,
+      const ignition::math::Pose3d &_pose);
+
+  /// \brief Get the bounds of a geometry placed in a frame.
+  /// \param[in] _geom The geometry, or nullptr for no geometry.
+  /// \param[in] _pose Pose of the geometry in the frame.
+  /// \return The box that contains the geometry in the frame, which is
+  /// infinite if the bounds of the geometry are not known, and empty if
+  /// there is no geometry.
+  ignition::math::AxisAlignedBox placedGeometryBounds(const Geometry *_geom,
+      const ignition::math::Pose3d &_pose);
+
   /// \brief Handle a condition which can be treated as an error, warning or
   /// ignored entirely.
   /// Based on the policy, this will either add it to an errors vector, stream
@@ -84,6 +156,57 @@ namespace sdf
     const sdf::Error &_error,
     sdf::Errors &_errors);
 
+  /// \brief Check whether a condition handled with a policy is reported
+  /// anywhere. Conditions handled with ERR are always reported, while the
+  /// ones handled with WARN or LOG are dropped when the console has neither
+  /// a terminal output nor a log for them. This does not lock the console,
+  /// so it is cheap enough to check for every condition.
+  /// \param[in] _policy The enforcement policy to follow
+  /// \return True if the condition is reported.
+  bool isPolicyConditionReported(const sdf::EnforcementPolicy _policy);
+
+  /// \brief Check whether a file or directory exists, in the resource
+  /// provider of a configuration if it has one, or on the filesystem.
+  /// \param[in] _config Parser configuration.
+  /// \param[in] _path Path of the file or directory.
+  /// \return True if it exists.
+  bool resourceExists(const sdf::ParserConfig &_config,
+                      const std::string &_path);
+
+  /// \brief Check whether a path is a directory, in the resource provider
+  /// of a configuration if it has one, or on the filesystem.
+  /// \param[in] _config Parser configuration.
+  /// \param[in] _path Path to check.
+  /// \return True if it is a directory.
+  bool resourceIsDirectory(const sdf::ParserConfig &_config,
+                           const std::string &_path);
+
+  /// \brief Check whether errors have reached the limit set with
+  /// ParserConfig::SetMaxErrors, after which loading stops.
+  /// \param[in] _config Parser configuration with the limit.
+  /// \param[in] _errors The errors found so far.
+  /// \return True if there is a limit and _errors has reached it.
+  bool maxErrorsReached(const sdf::ParserConfig &_config,
+                        const sdf::Errors &_errors);
+
+  /// \brief Handle a condition which can be treated as an error, warning or
+  /// ignored entirely, building its error only if it is reported.
+  /// \param[in] _policy The enforcement policy to follow
+  /// \param[in] _makeError Function that returns the error, which is only
+  /// called if isPolicyConditionReported(_policy) is true.
+  /// \param[out] _errors The errors to append to if the policy is ERR
+  template <typename MakeError,
+            typename = std::enable_if_t<
+                std::is_invocable_r_v<sdf::Error, MakeError>>>
+  void enforceConfigurablePolicyCondition(
+    const sdf::EnforcementPolicy _policy,
+    MakeError &&_makeError,
+    sdf::Errors &_errors)
+  {
+    if (isPolicyConditionReported(_policy))
+      enforceConfigurablePolicyCondition(_policy, _makeError(), _errors);
+  }
+
   /// \brief Load all objects of a specific sdf element type. No error
   /// is returned if an element is not present. This function assumes that
   /// an element has a "name" attribute that must be unique.
@@ -102,44 +225,37 @@ namespace sdf
 
     std::vector<std::string> names;
 
-    // Check that an element exists.
-    if (_sdf->HasElement(_sdfName))
+    // Read all the elements, without copying pointers to iterate.
+    for (const sdf::ElementPtr &elem : _sdf->Children(_sdfName))
     {
-      // Read all the elements.
-      sdf::ElementPtr elem = _sdf->GetElement(_sdfName);
-      while (elem)
+      Class obj;
+
+      // Load the model and capture the errors.
+      Errors loadErrors = obj.Load(elem, std::forward<Args>(_args)...);
+
+      // keep processing even if there are loadErrors
       {
-        Class obj;
+        std::string name;
 
-        // Load the model and capture the errors.
-        Errors loadErrors = obj.Load(elem, std::forward<Args>(_args)...);
+        // Read the name for uniqueness checks. Don't report errors here.
+        // Errors are captured in obj.Load(elem) above.
+        sdf::loadName(elem, name);
 
-        // keep processing even if there are loadErrors
+        // Check that the name does not exist.
+        if (std::find(names.begin(), names.end(), name) != names.end())
+        {
+          errors.push_back({ErrorCode::DUPLICATE_NAME,
+              _sdfName + " with name[" + name + "] already exists."});
+        }
+        else
         {
-          std::string name;
-
-          // Read the name for uniqueness checks. Don't report errors here.
-          // Errors are captured in obj.Load(elem) above.
-          sdf::loadName(elem, name);
-
-          // Check that the name does not exist.
-          if (std::find(names.begin(), names.end(), name) != names.end())
-          {
-            errors.push_back({ErrorCode::DUPLICATE_NAME,
-                _sdfName + " with name[" + name + "] already exists."});
-          }
-          else
-          {
-            // Add the object to the result if no errors have been encountered.
-            _objs.push_back(std::move(obj));
-            names.push_back(name);
-          }
-
-          // Add the load errors to the master error list.
-          errors.insert(errors.end(), loadErrors.begin(), loadErrors.end());
+          // Add the object to the result if no errors have been encountered.
+          _objs.push_back(std::move(obj));
+          names.push_back(name);
         }
 
-        elem = elem->GetNextElement(_sdfName);
+        // Add the load errors to the master error list.
+        errors.insert(errors.end(), loadErrors.begin(), loadErrors.end());
       }
     }
     // Do not add an error if the model tag is missing. This is an internal
@@ -164,31 +280,24 @@ namespace sdf
   {
     Errors errors;
 
-    // Check that an element exists.
-    if (_sdf->HasElement(_sdfName))
+    // Read all the elements, without copying pointers to iterate.
+    for (const sdf::ElementPtr &elem : _sdf->Children(_sdfName))
     {
-      // Read all the elements.
-      sdf::ElementPtr elem = _sdf->GetElement(_sdfName);
-      while (elem)
+      Class obj;
+      if (_beforeLoadFunc)
       {
-        Class obj;
-        if (_beforeLoadFunc)
-        {
-          _beforeLoadFunc(obj);
-        }
-
-        // Load the model and capture the errors.
-        Errors loadErrors = obj.Load(elem);
+        _beforeLoadFunc(obj);
+      }
 
-        {
-          // Add the load errors to the master error list.
-          errors.insert(errors.end(), loadErrors.begin(), loadErrors.end());
+      // Load the model and capture the errors.
+      Errors loadErrors = obj.Load(elem);
 
-          // but keep object anyway
-          _objs.push_back(std::move(obj));
-        }
+      {
+        // Add the load errors to the master error list.
+        errors.insert(errors.end(), loadErrors.begin(), loadErrors.end());
 
-        elem = elem->GetNextElement(_sdfName);
+        // but keep object anyway
+        _objs.push_back(std::move(obj));
       }
     }
     // Do not add an error if the model tag is missing. This is an internal
@@ -207,6 +316,62 @@ namespace sdf
       const sdf::ParserConfig &_config,
       std::vector<std::pair<NestedInclude, InterfaceModelPtr>> &_models);
 
+  /// \brief Get the element a DOM object keeps a reference to after it is
+  /// loaded from _sdf.
+  /// \param[in] _sdf Element the DOM object is loaded from.
+  /// \return _sdf, or nullptr while a ScopedElementRelease that releases
+  /// elements is alive on the calling thread.
+  sdf::ElementPtr retainedElement(const sdf::ElementPtr &_sdf);
+
+  /// \brief Check whether DOM objects loaded on the calling thread release
+  /// their elements.
+  /// \return True while a ScopedElementRelease that releases elements is
+  /// alive on the calling thread.
+  bool elementsReleased();
+
+  /// \brief While an object of this class that releases elements is alive,
+  /// DOM objects loaded on the calling thread do not keep references to the
+  /// elements they are loaded from.
+  /// \sa ParserConfig::SetReleaseElements
+  class ScopedElementRelease
+  {
+    /// \brief Constructor.
+    /// \param[in] _release True to release the elements of DOM objects.
+    public: explicit ScopedElementRelease(bool _release);
+
+    /// \brief Destructor, restoring the previous behavior.
+    public: ~ScopedElementRelease();
+
+    /// \brief Whether elements were released before this object.
+    private: bool previous;
+  };
+
+  /// \brief Check whether the names of the children of a world or model
+  /// element were already checked by a ScopedCheckedNames alive on the
+  /// calling thread.
+  /// \param[in] _sdf Element of the world or model.
+  /// \return True if _sdf is the element of a ScopedCheckedNames alive on
+  /// the calling thread, or one of its descendants.
+  bool childNamesChecked(const sdf::ElementPtr &_sdf);
+
+  /// \brief While an object of this class is alive, World::Load and
+  /// Model::Load on the calling thread do not warn about the non-unique
+  /// names of the children of an element and its descendants, because they
+  /// were checked in a single traversal, see recursiveCheckNames.
+  class ScopedCheckedNames
+  {
+    /// \brief Constructor.
+    /// \param[in] _sdf Element whose descendants were checked, or nullptr
+    /// if they were not.
+    public: explicit ScopedCheckedNames(const sdf::ElementPtr &_sdf);
+
+    /// \brief Destructor, restoring the previous behavior.
+    public: ~ScopedCheckedNames();
+
+    /// \brief Element that was checked before this object.
+    private: const sdf::Element *previous;
+  };
+
   /// \brief Convenience function that returns a pointer to the value contained
   /// in a std::optional.
   /// \tparam T type of object contained in the std::optional
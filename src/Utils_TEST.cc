@@ -16,8 +16,14 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <sstream>
 #include <string>
+#include <vector>
+#include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/Pose3.hh>
+#include "sdf/Console.hh"
 #include "sdf/Element.hh"
 #include "Utils.hh"
 
@@ -153,3 +159,74 @@ TEST(PolicyUtils, EnforcementPolicyErrors)
   ASSERT_TRUE(errors[0].LineNumber().has_value());
   EXPECT_EQ(errors[0].LineNumber().value(), 10);
 }
+
+/////////////////////////////////////////////////
+TEST(PolicyUtils, LazyEnforcementPolicyErrors)
+{
+  sdf::Errors errors;
+  int built = 0;
+  auto makeError = [&built]()
+  {
+    ++built;
+    return sdf::Error(sdf::ErrorCode::FILE_READ, "Unable to read[{}]",
+        std::vector<std::string>{"file"});
+  };
+
+  EXPECT_TRUE(sdf::isPolicyConditionReported(sdf::EnforcementPolicy::ERR));
+  sdf::enforceConfigurablePolicyCondition(
+      sdf::EnforcementPolicy::ERR, makeError, errors);
+  EXPECT_EQ(1, built);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ("Unable to read[file]", errors[0].Message());
+
+  // Without a log sink, logged conditions are discarded before their
+  // error is built
+  sdf::Console::SetLogSink(nullptr);
+  EXPECT_FALSE(sdf::isPolicyConditionReported(sdf::EnforcementPolicy::LOG));
+  sdf::enforceConfigurablePolicyCondition(
+      sdf::EnforcementPolicy::LOG, makeError, errors);
+  EXPECT_EQ(1, built);
+  EXPECT_EQ(1u, errors.size());
+
+  std::stringstream sink;
+  sdf::Console::SetLogSink(&sink);
+  EXPECT_TRUE(sdf::isPolicyConditionReported(sdf::EnforcementPolicy::LOG));
+  sdf::enforceConfigurablePolicyCondition(
+      sdf::EnforcementPolicy::LOG, makeError, errors);
+  EXPECT_EQ(2, built);
+  EXPECT_EQ(1u, errors.size());
+  EXPECT_NE(std::string::npos, sink.str().find("Unable to read[file]"));
+  sdf::Console::ResetLogSink();
+}
+
+/////////////////////////////////////////////////
+TEST(DOMUtils, TransformedBox)
+{
+  using ignition::math::AxisAlignedBox;
+  using ignition::math::Pose3d;
+  using ignition::math::Vector3d;
+
+  const AxisAlignedBox box(Vector3d(-1, -2, -3), Vector3d(1, 2, 3));
+  AxisAlignedBox result = sdf::transformedBox(box, Pose3d(1, 2, 3, 0, 0, 0));
+  EXPECT_EQ(Vector3d(0, 0, 0), result.Min());
+  EXPECT_EQ(Vector3d(2, 4, 6), result.Max());
+
+  // A quarter turn about Z swaps the X and Y extents.
+  result = sdf::transformedBox(box, Pose3d(0, 0, 0, 0, 0, IGN_PI_2));
+  EXPECT_TRUE(result.Min().Equal(Vector3d(-2, -1, -3), 1e-9)) << result.Min();
+  EXPECT_TRUE(result.Max().Equal(Vector3d(2, 1, 3), 1e-9)) << result.Max();
+
+  // A box that is infinite along X stays finite along Z when turned about Z.
+  const double inf = std::numeric_limits<double>::infinity();
+  const AxisAlignedBox slab(Vector3d(-inf, -1, 0), Vector3d(inf, 1, 0));
+  result = sdf::transformedBox(slab, Pose3d(0, 0, 1, 0, 0, 0.5));
+  EXPECT_TRUE(std::isinf(result.Min().X()));
+  EXPECT_TRUE(std::isinf(result.Max().Y()));
+  EXPECT_DOUBLE_EQ(1.0, result.Min().Z());
+  EXPECT_DOUBLE_EQ(1.0, result.Max().Z());
+
+  // Empty boxes stay empty.
+  EXPECT_TRUE(sdf::isEmptyBox(
+      sdf::transformedBox(AxisAlignedBox(), Pose3d(1, 2, 3, 0, 0, 0))));
+  EXPECT_FALSE(sdf::isEmptyBox(box));
+}
@@ -17,6 +17,7 @@
 #include <memory>
 #include <string>
 #include <ignition/math/Pose3.hh>
+#include "DomInterner.hh"
 #include "FrameSemantics.hh"
 #include "ScopedGraph.hh"
 #include "sdf/Error.hh"
@@ -24,6 +25,7 @@
 #include "sdf/parser.hh"
 #include "sdf/Types.hh"
 #include "sdf/Visual.hh"
+#include "ScopedTraceEvent.hh"
 #include "Utils.hh"
 
 using namespace sdf;
@@ -46,13 +48,14 @@ class sdf::Visual::Implementation
   public: std::string poseRelativeTo = "";
 
   /// \brief The visual's a geometry.
-  public: Geometry geom;
+  public: std::shared_ptr<const Geometry> geom =
+      std::make_shared<const Geometry>();
 
   /// \brief The SDF element pointer used during load.
   public: sdf::ElementPtr sdf;
 
   /// \brief The visual's material properties.
-  public: std::optional<sdf::Material> material;
+  public: std::shared_ptr<const sdf::Material> material;
 
   /// \brief Name of xml parent object.
   public: std::string xmlParentName;
@@ -82,9 +85,10 @@ Visual::Visual()
 /////////////////////////////////////////////////
 Errors Visual::Load(ElementPtr _sdf)
 {
+  ScopedTraceEvent event("Visual::Load", "dom");
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
 
   // Check that the provided SDF element is a <visual>
   // This is an error that cannot be recovered, so return an error.
@@ -126,9 +130,10 @@ Errors Visual::Load(ElementPtr _sdf)
 
   if (_sdf->HasElement("material"))
   {
-    this->dataPtr->material.emplace();
-    Errors err = this->dataPtr->material->Load(_sdf->GetElement("material"));
+    auto material = std::make_shared<sdf::Material>();
+    Errors err = material->Load(_sdf->GetElement("material"));
     errors.insert(errors.end(), err.begin(), err.end());
+    this->dataPtr->material = std::move(material);
   }
 
   // Load the pose. Ignore the return value since the pose is optional.
@@ -143,8 +148,10 @@ Errors Visual::Load(ElementPtr _sdf)
   }
 
   // Load the geometry
-  Errors geomErr = this->dataPtr->geom.Load(_sdf->GetElement("geometry"));
+  auto geom = std::make_shared<Geometry>();
+  Errors geomErr = geom->Load(_sdf->GetElement("geometry"));
   errors.insert(errors.end(), geomErr.begin(), geomErr.end());
+  this->dataPtr->geom = std::move(geom);
 
   // Load the lidar reflective intensity if it is given
   if (_sdf->HasElement("laser_retro"))
@@ -223,13 +230,13 @@ void Visual::SetPoseRelativeTo(const std::string &_frame)
 /////////////////////////////////////////////////
 const Geometry *Visual::Geom() const
 {
-  return &this->dataPtr->geom;
+  return this->dataPtr->geom.get();
 }
 
 /////////////////////////////////////////////////
 void Visual::SetGeom(const Geometry &_geom)
 {
-  this->dataPtr->geom = _geom;
+  this->dataPtr->geom = std::make_shared<const Geometry>(_geom);
 }
 
 /////////////////////////////////////////////////
@@ -242,6 +249,15 @@ sdf::SemanticPose Visual::SemanticPose() const
       this->dataPtr->poseRelativeToGraph);
 }
 
+/////////////////////////////////////////////////
+Errors Visual::ResolvePose(ignition::math::Pose3d &_pose,
+    const std::string &_resolveTo) const
+{
+  return resolveSemanticPose(_pose, this->dataPtr->poseRelativeToGraph, "",
+      this->dataPtr->pose, this->dataPtr->poseRelativeTo,
+      this->dataPtr->xmlParentName, _resolveTo);
+}
+
 /////////////////////////////////////////////////
 sdf::ElementPtr Visual::Element() const
 {
@@ -251,13 +267,21 @@ sdf::ElementPtr Visual::Element() const
 /////////////////////////////////////////////////
 const sdf::Material *Visual::Material() const
 {
-  return optionalToPointer(this->dataPtr->material);
+  return this->dataPtr->material.get();
 }
 
 /////////////////////////////////////////////////
 void Visual::SetMaterial(const sdf::Material &_material)
 {
-  this->dataPtr->material = _material;
+  this->dataPtr->material = std::make_shared<const sdf::Material>(_material);
+}
+
+/////////////////////////////////////////////////
+void Visual::ShareProperties(DomInterner &_interner)
+{
+  this->dataPtr->geom = _interner.Share(this->dataPtr->geom);
+  if (this->dataPtr->material)
+    this->dataPtr->material = _interner.Share(this->dataPtr->material);
 }
 
 /////////////////////////////////////////////////
@@ -328,7 +352,7 @@ sdf::ElementPtr Visual::ToElement() const
   poseElem->Set<ignition::math::Pose3d>(this->RawPose());
 
   // Set the geometry
-  elem->InsertElement(this->dataPtr->geom.ToElement(), true);
+  elem->InsertElement(this->dataPtr->geom->ToElement(), true);
 
   elem->GetElement("cast_shadows")->Set(this->CastShadows());
   elem->GetElement("laser_retro")->Set(this->LaserRetro());
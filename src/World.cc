@@ -14,38 +14,231 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 #include <optional>
 #include <ignition/math/Vector3.hh>
 
 #include "sdf/Actor.hh"
+#include "sdf/Box.hh"
+#include "sdf/Capsule.hh"
+#include "sdf/Collision.hh"
+#include "sdf/Console.hh"
+#include "sdf/Cylinder.hh"
+#include "sdf/Ellipsoid.hh"
 #include "sdf/Frame.hh"
+#include "sdf/Geometry.hh"
+#include "sdf/Heightmap.hh"
 #include "sdf/InterfaceElements.hh"
 #include "sdf/InterfaceModel.hh"
 #include "sdf/InterfaceModelPoseGraph.hh"
+#include "sdf/Joint.hh"
 #include "sdf/Light.hh"
+#include "sdf/Link.hh"
+#include "sdf/Mesh.hh"
 #include "sdf/Model.hh"
 #include "sdf/ParserConfig.hh"
 #include "sdf/Physics.hh"
+#include "sdf/Plane.hh"
 #include "sdf/Plugin.hh"
+#include "sdf/Population.hh"
+#include "sdf/Sensor.hh"
+#include "sdf/Sphere.hh"
+#include "sdf/Surface.hh"
 #include "sdf/Types.hh"
+#include "sdf/Visual.hh"
 #include "sdf/World.hh"
 #include "FrameSemantics.hh"
+#include "GeodeticTransform.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
+#include "SpatialIndex.hh"
+#include "ScopedTraceEvent.hh"
 #include "Utils.hh"
 #include "sdf/parser.hh"
 
 using namespace sdf;
 
+/// \brief Spatial indices of the models and lights of a world, built on
+/// demand by the queries. A copy of a world builds its indices again.
+class WorldSpatialIndex
+{
+  /// \brief Default constructor.
+  public: WorldSpatialIndex() = default;
+
+  /// \brief Copy constructor.
+  public: WorldSpatialIndex(const WorldSpatialIndex &)
+  {
+  }
+
+  /// \brief Copy assignment operator.
+  /// \return Reference to this index.
+  public: WorldSpatialIndex &operator=(const WorldSpatialIndex &)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->modelsValid = false;
+    this->lightsValid = false;
+    this->frozen = false;
+    return *this;
+  }
+
+  /// \brief Discard the index of the models.
+  public: void InvalidateModels()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->modelsValid = false;
+    this->frozen = false;
+  }
+
+  /// \brief Discard the index of the lights.
+  public: void InvalidateLights()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->lightsValid = false;
+    this->frozen = false;
+  }
+
+  /// \brief Lock the mutex to query the indices, unless they are frozen.
+  /// \return The lock, which does not own the mutex if the indices are
+  /// frozen.
+  public: std::unique_lock<std::mutex> LockUnlessFrozen()
+  {
+    if (this->frozen)
+      return std::unique_lock<std::mutex>();
+    return std::unique_lock<std::mutex>(this->mutex);
+  }
+
+  /// \brief Mutex that protects the indices.
+  public: std::mutex mutex;
+
+  /// \brief Whether the index of the models is up to date.
+  public: bool modelsValid = false;
+
+  /// \brief Bounds of the models, with their index as ID.
+  public: SpatialIndex models;
+
+  /// \brief Whether the index of the lights is up to date.
+  public: bool lightsValid = false;
+
+  /// \brief Bounds of the lights, with their index as ID.
+  public: SpatialIndex lights;
+
+  /// \brief Whether both indices were built by World::Freeze and are only
+  /// read until they are invalidated.
+  public: bool frozen = false;
+};
+
+/// \brief Elements of the models of a world that are loaded on first use,
+/// see ParserConfig::SetLazyWorldModels.
+class WorldLazyModels
+{
+  /// \brief Default constructor.
+  public: WorldLazyModels() = default;
+
+  /// \brief Copy constructor.
+  /// \param[in] _other The models to copy.
+  public: WorldLazyModels(const WorldLazyModels &_other)
+  {
+    *this = _other;
+  }
+
+  /// \brief Copy assignment operator.
+  /// \param[in] _other The models to copy.
+  /// \return Reference to these models.
+  public: WorldLazyModels &operator=(const WorldLazyModels &_other)
+  {
+    if (this == &_other)
+      return *this;
+    std::scoped_lock lock(this->mutex, _other.mutex);
+    this->elements = _other.elements;
+    this->config = _other.config;
+    this->pending = _other.pending.load();
+    this->active = _other.active;
+    return *this;
+  }
+
+  /// \brief Forget the models that are not loaded.
+  public: void Clear()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->elements.clear();
+    this->config.reset();
+    this->pending = 0;
+    this->active = false;
+  }
+
+  /// \brief Mutex that protects the elements and the models while they are
+  /// loaded.
+  public: mutable std::mutex mutex;
+
+  /// \brief Element of each model, by the index of the model, or nullptr
+  /// for a model that is loaded. Models added after the world was loaded
+  /// have no entry.
+  public: std::vector<ElementPtr> elements;
+
+  /// \brief Configuration the models are loaded with.
+  public: std::optional<ParserConfig> config;
+
+  /// \brief Number of models that are not loaded, so that accessing the
+  /// models only takes the mutex while some are not loaded.
+  public: std::atomic<std::size_t> pending{0};
+
+  /// \brief Whether the world was loaded lazily and its models were not
+  /// all loaded by World::Freeze. It is only changed by non-const
+  /// functions, so that frozen worlds do not read pending.
+  public: bool active = false;
+};
+
 class sdf::World::Implementation
 {
+  /// \brief Read the names and poses of the models of a world, and keep
+  /// their elements to load them on first use.
+  /// \param[in] _sdf The <world> element.
+  /// \param[in] _config Parser configuration.
+  /// \return Errors for duplicate model names.
+  public: Errors LoadModelStubs(const ElementPtr &_sdf,
+                                const ParserConfig &_config);
+
+  /// \brief Load a model that was not loaded yet. Its errors are reported
+  /// on the console.
+  /// \param[in] _index Index of the model.
+  public: void LoadModel(std::size_t _index) const;
+
+  /// \brief Load every model that was not loaded yet.
+  public: void LoadAllModels() const;
+
   /// \brief Populate sphericalCoordinates
   /// \param[in] _elem `<spherical_coordinates>` element
   /// \return Errors, if any.
   public: Errors LoadSphericalCoordinates(sdf::ElementPtr _elem);
 
+  /// \brief Add the bounds of the last model to the spatial index of the
+  /// models, if the index is built.
+  public: void InsertLastModelBounds();
+
+  /// \brief Add the bounds of the last light to the spatial index of the
+  /// lights, if the index is built.
+  public: void InsertLastLightBounds();
+
+  /// \brief Build the spatial index of the models if it is not up to date.
+  /// The mutex of spatialIndex must be locked.
+  public: void UpdateModelIndex() const;
+
+  /// \brief Build the spatial index of the lights if it is not up to date.
+  /// The mutex of spatialIndex must be locked.
+  public: void UpdateLightIndex() const;
+
   /// \brief Optional atmosphere model.
   public: std::optional<sdf::Atmosphere> atmosphere;
 
@@ -65,12 +258,18 @@ class sdf::World::Implementation
   /// \brief The frames specified in this world.
   public: std::vector<Frame> frames;
 
+  /// \brief Index of the frames by name.
+  public: NameIndex<Frame> frameIndex;
+
   /// \brief The lights specified in this world.
   public: std::vector<Light> lights;
 
   /// \brief The actors specified in this world.
   public: std::vector<Actor> actors;
 
+  /// \brief The populations specified in this world.
+  public: std::vector<Population> populations;
+
   /// \brief Magnetic field.
   public: ignition::math::Vector3d magneticField =
            ignition::math::Vector3d(5.5645e-6, 22.8758e-6, -42.3884e-6);
@@ -79,8 +278,19 @@ class sdf::World::Implementation
   public: std::optional<ignition::math::SphericalCoordinates>
       sphericalCoordinates;
 
-  /// \brief The models specified in this world.
-  public: std::vector<Model> models;
+  /// \brief Conversions with the spherical coordinates, made when they are
+  /// set.
+  public: std::optional<GeodeticTransform> geodeticTransform;
+
+  /// \brief The models specified in this world. It is mutable so that the
+  /// models of lazyModels can be loaded by the const accessors.
+  public: mutable std::vector<Model> models;
+
+  /// \brief The models to load on first use.
+  public: mutable WorldLazyModels lazyModels;
+
+  /// \brief Index of the models by name.
+  public: NameIndex<Model> modelIndex;
 
   /// \brief The interface models specified in this world.
   public: std::vector<std::pair<sdf::NestedInclude, sdf::InterfaceModelPtr>>
@@ -109,6 +319,9 @@ class sdf::World::Implementation
 
   /// \brief World plugins.
   public: sdf::Plugins plugins;
+
+  /// \brief Spatial indices of the models and lights.
+  public: mutable WorldSpatialIndex spatialIndex;
 };
 
 /////////////////////////////////////////////////
@@ -127,9 +340,13 @@ Errors World::Load(sdf::ElementPtr _sdf)
 /////////////////////////////////////////////////
 Errors World::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
 {
+  ScopedTraceEvent event(_config, "World::Load", "dom");
   Errors errors;
 
-  this->dataPtr->sdf = _sdf;
+  this->dataPtr->sdf = retainedElement(_sdf);
+  this->dataPtr->spatialIndex.InvalidateModels();
+  this->dataPtr->spatialIndex.InvalidateLights();
+  this->dataPtr->lazyModels.Clear();
 
   // Check that the provided SDF element is a <world>
   // This is an error that cannot be recovered, so return an error.
@@ -201,25 +418,19 @@ Errors World::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
         sphericalCoordsErrors.end());
   }
 
-  for (const auto &[name, size] :
-       _sdf->CountNamedElements("", Element::NameUniquenessExceptions()))
-  {
-    if (size > 1)
-    {
-      sdfwarn << "Non-unique name[" << name << "] detected " << size
-              << " times in XML children of world with name[" << this->Name()
-              << "].\n";
-    }
-  }
-
-  for (const auto &[name, size] :
-       _sdf->CountNamedElements("", Element::NameUniquenessExceptions()))
+  // Root::Load checks the names of all its worlds and models at once.
+  if (_config.GetValidationLevel() != ValidationLevel::NONE &&
+      !childNamesChecked(_sdf))
   {
-    if (size > 1)
+    for (const auto &[name, size] :
+         _sdf->CountNamedElements("", Element::NameUniquenessExceptions()))
     {
-      sdfwarn << "Non-unique name[" << name << "] detected " << size
-              << " times in XML children of world with name[" << this->Name()
-              << "].\n";
+      if (size > 1)
+      {
+        sdfwarn << "Non-unique name[" << name << "] detected " << size
+                << " times in XML children of world with name["
+                << this->Name() << "].\n";
+      }
     }
   }
 
@@ -227,10 +438,13 @@ Errors World::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
   // name collisions
   std::unordered_set<std::string> frameNames;
 
-  // Load all the models.
-  Errors modelLoadErrors =
+  // Load all the models, or only their names and poses if they are loaded
+  // on first use.
+  Errors modelLoadErrors = _config.LazyWorldModels() ?
+      this->dataPtr->LoadModelStubs(_sdf, _config) :
       loadUniqueRepeated<Model>(_sdf, "model", this->dataPtr->models, _config);
   errors.insert(errors.end(), modelLoadErrors.begin(), modelLoadErrors.end());
+  this->dataPtr->modelIndex.Rebuild(this->dataPtr->models);
 
   // Models are loaded first, and loadUniqueRepeated ensures there are no
   // duplicate names, so these names can be added to frameNames without
@@ -266,6 +480,12 @@ Errors World::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
       this->dataPtr->actors);
   errors.insert(errors.end(), actorLoadErrors.begin(), actorLoadErrors.end());
 
+  // Load all the populations.
+  Errors populationLoadErrors = loadUniqueRepeated<Population>(_sdf,
+      "population", this->dataPtr->populations, _config);
+  errors.insert(errors.end(), populationLoadErrors.begin(),
+                populationLoadErrors.end());
+
   // Load all the lights.
   Errors lightLoadErrors = loadUniqueRepeated<Light>(_sdf, "light",
       this->dataPtr->lights);
@@ -296,6 +516,7 @@ Errors World::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
     }
     frameNames.insert(frameName);
   }
+  this->dataPtr->frameIndex.Rebuild(this->dataPtr->frames);
 
   // Load the Gui
   if (_sdf->HasElement("gui"))
@@ -403,42 +624,76 @@ uint64_t World::ModelCount() const
 const Model *World::ModelByIndex(const uint64_t _index) const
 {
   if (_index < this->dataPtr->models.size())
+  {
+    this->dataPtr->LoadModel(_index);
     return &this->dataPtr->models[_index];
+  }
   return nullptr;
 }
 
 /////////////////////////////////////////////////
 Model *World::ModelByIndex(uint64_t _index)
 {
+  this->dataPtr->spatialIndex.InvalidateModels();
   return const_cast<Model*>(
       static_cast<const World*>(this)->ModelByIndex(_index));
 }
 
+/////////////////////////////////////////////////
+const Model *World::ModelStubByIndex(const uint64_t _index) const
+{
+  if (_index < this->dataPtr->models.size())
+    return &this->dataPtr->models[_index];
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+bool World::ModelLoaded(const uint64_t _index) const
+{
+  if (_index >= this->dataPtr->models.size())
+    return false;
+  const WorldLazyModels &lazy = this->dataPtr->lazyModels;
+  if (!lazy.active || lazy.pending == 0)
+    return true;
+  std::lock_guard<std::mutex> lock(lazy.mutex);
+  return _index >= lazy.elements.size() || !lazy.elements[_index];
+}
+
 /////////////////////////////////////////////////
 bool World::ModelNameExists(const std::string &_name) const
 {
+  // The stub of a lazy model is enough to know the name of a top level
+  // model.
+  const ScopedName name(_name);
+  if (!name.IsScoped())
+  {
+    return nullptr != this->dataPtr->modelIndex.Find(this->dataPtr->models,
+                                                     _name);
+  }
   return nullptr != this->ModelByName(_name);
 }
 
 /////////////////////////////////////////////////
 const Model *World::ModelByName(const std::string &_name) const
 {
-  auto index = _name.find("::");
-  const std::string nextModelName = _name.substr(0, index);
-  const Model *nextModel = nullptr;
+  return this->ModelByScopedName(_name);
+}
 
-  for (auto const &m : this->dataPtr->models)
+/////////////////////////////////////////////////
+const Model *World::ModelByScopedName(ScopedName _name) const
+{
+  const Model *nextModel =
+      this->dataPtr->modelIndex.Find(this->dataPtr->models,
+                                     _name.FirstSegment());
+  if (nullptr != nextModel)
   {
-    if (m.Name() == nextModelName)
-    {
-      nextModel = &m;
-      break;
-    }
+    this->dataPtr->LoadModel(
+        static_cast<std::size_t>(nextModel - this->dataPtr->models.data()));
   }
 
-  if (nullptr != nextModel && index != std::string::npos)
+  if (nullptr != nextModel && _name.IsScoped())
   {
-    return nextModel->ModelByName(_name.substr(index + 2));
+    return nextModel->ModelByScopedName(_name.WithoutFirstSegment());
   }
   return nextModel;
 }
@@ -446,6 +701,8 @@ const Model *World::ModelByName(const std::string &_name) const
 /////////////////////////////////////////////////
 Model *World::ModelByName(const std::string &_name)
 {
+  this->dataPtr->spatialIndex.InvalidateModels();
+  this->dataPtr->modelIndex.Refresh(this->dataPtr->models);
   return const_cast<Model*>(
       static_cast<const World*>(this)->ModelByName(_name));
 }
@@ -474,6 +731,274 @@ void World::SetSphericalCoordinates(const ignition::math::SphericalCoordinates
     &_sphericalCoordinates)
 {
   this->dataPtr->sphericalCoordinates = _sphericalCoordinates;
+  this->dataPtr->geodeticTransform.emplace(_sphericalCoordinates);
+}
+
+/////////////////////////////////////////////////
+Errors World::LocalToGeodetic(
+    const std::vector<ignition::math::Vector3d> &_positions,
+    std::vector<ignition::math::Vector3d> &_geodetic) const
+{
+  Errors errors;
+  _geodetic.clear();
+  if (!this->dataPtr->geodeticTransform)
+  {
+    errors.push_back({ErrorCode::ELEMENT_MISSING,
+        "World [" + this->dataPtr->name + "] has no spherical coordinates."});
+    return errors;
+  }
+
+  _geodetic.resize(_positions.size());
+  this->dataPtr->geodeticTransform->LocalToGeodetic(
+      _positions.data(), _positions.size(), _geodetic.data());
+  return errors;
+}
+
+/////////////////////////////////////////////////
+Errors World::GeodeticToLocal(
+    const std::vector<ignition::math::Vector3d> &_geodetic,
+    std::vector<ignition::math::Vector3d> &_positions) const
+{
+  Errors errors;
+  _positions.clear();
+  if (!this->dataPtr->geodeticTransform)
+  {
+    errors.push_back({ErrorCode::ELEMENT_MISSING,
+        "World [" + this->dataPtr->name + "] has no spherical coordinates."});
+    return errors;
+  }
+
+  _positions.resize(_geodetic.size());
+  this->dataPtr->geodeticTransform->GeodeticToLocal(
+      _geodetic.data(), _geodetic.size(), _positions.data());
+  return errors;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the dimensions of a geometry, as documented by
+/// EntityTables::CollisionTable::geometryParameters.
+/// \param[in] _geom The geometry.
+/// \return The dimensions.
+static ignition::math::Vector3d geometryParameters(const Geometry &_geom)
+{
+  switch (_geom.Type())
+  {
+    case GeometryType::BOX:
+      if (_geom.BoxShape())
+        return _geom.BoxShape()->Size();
+      break;
+    case GeometryType::SPHERE:
+      if (_geom.SphereShape())
+        return {_geom.SphereShape()->Radius(), 0, 0};
+      break;
+    case GeometryType::CYLINDER:
+      if (_geom.CylinderShape())
+      {
+        return {_geom.CylinderShape()->Radius(),
+                _geom.CylinderShape()->Length(), 0};
+      }
+      break;
+    case GeometryType::CAPSULE:
+      if (_geom.CapsuleShape())
+      {
+        return {_geom.CapsuleShape()->Radius(),
+                _geom.CapsuleShape()->Length(), 0};
+      }
+      break;
+    case GeometryType::ELLIPSOID:
+      if (_geom.EllipsoidShape())
+        return _geom.EllipsoidShape()->Radii();
+      break;
+    case GeometryType::PLANE:
+      if (_geom.PlaneShape())
+      {
+        const ignition::math::Vector2d size = _geom.PlaneShape()->Size();
+        return {size.X(), size.Y(), 0};
+      }
+      break;
+    case GeometryType::HEIGHTMAP:
+      if (_geom.HeightmapShape())
+        return _geom.HeightmapShape()->Size();
+      break;
+    case GeometryType::MESH:
+      if (_geom.MeshShape())
+        return _geom.MeshShape()->Scale();
+      break;
+    default:
+      break;
+  }
+  return ignition::math::Vector3d::Zero;
+}
+
+/////////////////////////////////////////////////
+/// \brief State of World::ResolveEntityTables while it walks a model of the
+/// world.
+struct EntityTablesBuilder
+{
+  /// \brief Poses of the entities of the model, relative to the model
+  /// frame, in the order of Model::ResolveAllPoses.
+  std::vector<ignition::math::Pose3d> poses;
+
+  /// \brief Index in poses of the next entity.
+  std::size_t nextPose = 0;
+
+  /// \brief Pose of the model frame relative to the world frame.
+  ignition::math::Pose3d modelPose;
+
+  /// \brief Index of each link by its name scoped from the world.
+  std::unordered_map<std::string, uint64_t> linkIndices;
+
+  /// \brief Scoped names of the parent and child links of each joint of
+  /// the tables, or empty names if they are not resolved.
+  std::vector<std::pair<std::string, std::string>> jointLinks;
+
+  /// \brief Get the pose of the next entity relative to the world frame.
+  /// \return The pose, or zero if it was not resolved.
+  ignition::math::Pose3d NextPose()
+  {
+    const std::size_t i = this->nextPose++;
+    return i < this->poses.size() ?
+        this->modelPose * this->poses[i] : ignition::math::Pose3d::Zero;
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Append the entities of a model and of its nested models to the
+/// tables, in the order of Model::ResolveAllPoses.
+/// \param[in] _model The model.
+/// \param[in] _parent Index of the parent model, or EntityTables::kNoIndex.
+/// \param[in] _scope Name of the model scoped from the world.
+/// \param[in,out] _builder State of the walk.
+/// \param[out] _tables Tables to append to.
+/// \param[out] _errors Errors in resolving the joint links.
+static void appendEntityTables(const Model &_model, const uint64_t _parent,
+    const std::string &_scope, EntityTablesBuilder &_builder,
+    EntityTables &_tables, Errors &_errors)
+{
+  const uint64_t modelIndex = _tables.models.names.size();
+  _tables.models.names.push_back(_model.Name());
+  _tables.models.parents.push_back(_parent);
+  _tables.models.poses.push_back(_builder.NextPose());
+
+  auto appendSensor = [&](const Sensor &_sensor, const uint64_t _link,
+                          const uint64_t _joint)
+  {
+    _tables.sensors.names.push_back(_sensor.Name());
+    _tables.sensors.links.push_back(_link);
+    _tables.sensors.joints.push_back(_joint);
+    _tables.sensors.types.push_back(_sensor.Type());
+    _tables.sensors.updateRates.push_back(_sensor.UpdateRate());
+    _tables.sensors.poses.push_back(_builder.NextPose());
+  };
+
+  for (uint64_t i = 0; i < _model.LinkCount(); ++i)
+  {
+    const Link *link = _model.LinkByIndex(i);
+    const uint64_t linkIndex = _tables.links.names.size();
+    _builder.linkIndices.emplace(JoinName(_scope, link->Name()), linkIndex);
+    _tables.links.names.push_back(link->Name());
+    _tables.links.models.push_back(modelIndex);
+    _tables.links.inertials.push_back(link->Inertial());
+    _tables.links.poses.push_back(_builder.NextPose());
+
+    for (uint64_t j = 0; j < link->CollisionCount(); ++j)
+    {
+      const Collision *collision = link->CollisionByIndex(j);
+      _tables.collisions.names.push_back(collision->Name());
+      _tables.collisions.links.push_back(linkIndex);
+      _tables.collisions.geometryTypes.push_back(collision->Geom()->Type());
+      _tables.collisions.geometryParameters.push_back(
+          geometryParameters(*collision->Geom()));
+      _tables.collisions.poses.push_back(_builder.NextPose());
+    }
+
+    // Visuals are not part of the tables, but have a pose.
+    _builder.nextPose += link->VisualCount();
+
+    for (uint64_t j = 0; j < link->SensorCount(); ++j)
+      appendSensor(*link->SensorByIndex(j), linkIndex, EntityTables::kNoIndex);
+  }
+
+  for (uint64_t i = 0; i < _model.JointCount(); ++i)
+  {
+    const Joint *joint = _model.JointByIndex(i);
+    const uint64_t jointIndex = _tables.joints.names.size();
+    _tables.joints.names.push_back(joint->Name());
+    _tables.joints.models.push_back(modelIndex);
+    _tables.joints.types.push_back(joint->Type());
+    _tables.joints.poses.push_back(_builder.NextPose());
+
+    // The links are found once every model is in the tables, since a joint
+    // can refer to the links of nested models.
+    std::string parent;
+    std::string child;
+    Errors errors = joint->ResolveParentLink(parent);
+    if (!errors.empty() || parent == "world")
+      parent.clear();
+    else
+      parent = JoinName(_scope, parent);
+    Errors childErrors = joint->ResolveChildLink(child);
+    if (!childErrors.empty())
+      child.clear();
+    else
+      child = JoinName(_scope, child);
+    errors.insert(errors.end(), childErrors.begin(), childErrors.end());
+    _errors.insert(_errors.end(), errors.begin(), errors.end());
+    _builder.jointLinks.emplace_back(std::move(parent), std::move(child));
+
+    for (uint64_t j = 0; j < joint->SensorCount(); ++j)
+    {
+      appendSensor(*joint->SensorByIndex(j), EntityTables::kNoIndex,
+                   jointIndex);
+    }
+  }
+
+  // Frames are not part of the tables, but have a pose.
+  _builder.nextPose += _model.FrameCount();
+
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+  {
+    const Model *nested = _model.ModelByIndex(i);
+    appendEntityTables(*nested, modelIndex, JoinName(_scope, nested->Name()),
+                       _builder, _tables, _errors);
+  }
+}
+
+/////////////////////////////////////////////////
+Errors World::ResolveEntityTables(EntityTables &_tables) const
+{
+  Errors errors;
+  _tables = EntityTables();
+
+  EntityTablesBuilder builder;
+  this->dataPtr->LoadAllModels();
+  for (const Model &model : this->dataPtr->models)
+  {
+    builder.modelPose = ignition::math::Pose3d::Zero;
+    Errors modelErrors = model.ResolvePose(builder.modelPose);
+    Errors poseErrors = model.ResolveAllPoses(builder.poses);
+    modelErrors.insert(modelErrors.end(), poseErrors.begin(),
+                       poseErrors.end());
+    errors.insert(errors.end(), modelErrors.begin(), modelErrors.end());
+    builder.nextPose = 0;
+    appendEntityTables(model, EntityTables::kNoIndex, model.Name(), builder,
+                       _tables, errors);
+  }
+
+  auto linkIndex = [&](const std::string &_name) -> uint64_t
+  {
+    auto it = builder.linkIndices.find(_name);
+    return it == builder.linkIndices.end() ?
+        EntityTables::kNoIndex : it->second;
+  };
+  _tables.joints.parentLinks.reserve(builder.jointLinks.size());
+  _tables.joints.childLinks.reserve(builder.jointLinks.size());
+  for (const auto &[parent, child] : builder.jointLinks)
+  {
+    _tables.joints.parentLinks.push_back(linkIndex(parent));
+    _tables.joints.childLinks.push_back(linkIndex(child));
+  }
+  return errors;
 }
 
 /////////////////////////////////////////////////
@@ -536,35 +1061,29 @@ bool World::FrameNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 const Frame *World::FrameByName(const std::string &_name) const
 {
-  auto index = _name.rfind("::");
-  if (index != std::string::npos)
+  const ScopedName name(_name);
+  if (name.IsScoped())
   {
-    const Model *model = this->ModelByName(_name.substr(0, index));
+    const Model *model = this->ModelByScopedName(name.ScopeName());
     if (nullptr != model)
     {
-      return model->FrameByName(_name.substr(index + 2));
+      return model->FrameByScopedName(name.LocalName());
     }
 
     // The nested model name preceding the last "::" could not be found.
-    // For now, try to find a link that matches _name exactly.
+    // For now, try to find a frame that matches _name exactly.
     // When "::" are reserved and not allowed in names, then uncomment
     // the following line to return a nullptr.
     // return nullptr;
   }
 
-  for (auto const &f : this->dataPtr->frames)
-  {
-    if (f.Name() == _name)
-    {
-      return &f;
-    }
-  }
-  return nullptr;
+  return this->dataPtr->frameIndex.Find(this->dataPtr->frames, name.Name());
 }
 
 /////////////////////////////////////////////////
 Frame *World::FrameByName(const std::string &_name)
 {
+  this->dataPtr->frameIndex.Refresh(this->dataPtr->frames);
   return const_cast<Frame*>(
       static_cast<const World*>(this)->FrameByName(_name));
 }
@@ -586,6 +1105,7 @@ const Light *World::LightByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 Light *World::LightByIndex(uint64_t _index)
 {
+  this->dataPtr->spatialIndex.InvalidateLights();
   return const_cast<Light*>(
       static_cast<const World*>(this)->LightByIndex(_index));
 }
@@ -637,6 +1157,40 @@ bool World::ActorNameExists(const std::string &_name) const
   return false;
 }
 
+/////////////////////////////////////////////////
+uint64_t World::PopulationCount() const
+{
+  return this->dataPtr->populations.size();
+}
+
+/////////////////////////////////////////////////
+const Population *World::PopulationByIndex(const uint64_t _index) const
+{
+  if (_index < this->dataPtr->populations.size())
+    return &this->dataPtr->populations[_index];
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+Population *World::PopulationByIndex(uint64_t _index)
+{
+  return const_cast<Population*>(
+      static_cast<const World*>(this)->PopulationByIndex(_index));
+}
+
+/////////////////////////////////////////////////
+bool World::PopulationNameExists(const std::string &_name) const
+{
+  for (auto const &p : this->dataPtr->populations)
+  {
+    if (p.Name() == _name)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 //////////////////////////////////////////////////
 uint64_t World::PhysicsCount() const
 {
@@ -713,11 +1267,70 @@ const NestedInclude *World::InterfaceModelNestedIncludeByIndex(
   return nullptr;
 }
 
+/////////////////////////////////////////////////
+/// \brief Load the children of an interface model and of its nested
+/// interface models.
+/// \param[in] _model The interface model.
+static void loadInterfaceChildren(const InterfaceModel &_model)
+{
+  for (const InterfaceModelConstPtr &nested : _model.NestedModels())
+  {
+    if (nested)
+      loadInterfaceChildren(*nested);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Load the children of the interface models nested in a model and
+/// in its nested models.
+/// \param[in] _model The model.
+static void loadInterfaceChildren(const Model &_model)
+{
+  for (uint64_t i = 0; i < _model.InterfaceModelCount(); ++i)
+    loadInterfaceChildren(*_model.InterfaceModelByIndex(i));
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+    loadInterfaceChildren(*_model.ModelByIndex(i));
+}
+
+/////////////////////////////////////////////////
+void World::Freeze()
+{
+  this->dataPtr->LoadAllModels();
+  this->dataPtr->lazyModels.Clear();
+
+  for (const Model &model : this->dataPtr->models)
+    loadInterfaceChildren(model);
+  for (uint64_t i = 0; i < this->InterfaceModelCount(); ++i)
+    loadInterfaceChildren(*this->InterfaceModelByIndex(i));
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->spatialIndex.mutex);
+    this->dataPtr->UpdateModelIndex();
+    this->dataPtr->UpdateLightIndex();
+    this->dataPtr->spatialIndex.frozen = true;
+  }
+
+  if (this->dataPtr->frameAttachedToGraph)
+    this->dataPtr->frameAttachedToGraph.Seal();
+  if (this->dataPtr->poseRelativeToGraph)
+  {
+    // Poses resolved once the graph is sealed are not stored, so all of
+    // them are stored first.
+    storeResolvedPoses(this->dataPtr->poseRelativeToGraph);
+    for (const Model &model : this->dataPtr->models)
+      model.StoreResolvedPoses();
+    this->dataPtr->poseRelativeToGraph.Seal();
+  }
+}
+
 /////////////////////////////////////////////////
 void World::SetPoseRelativeToGraph(sdf::ScopedGraph<PoseRelativeToGraph> _graph)
 {
   this->dataPtr->poseRelativeToGraph = _graph;
+  this->dataPtr->spatialIndex.InvalidateModels();
+  this->dataPtr->spatialIndex.InvalidateLights();
 
+  this->dataPtr->LoadAllModels();
   for (auto &model : this->dataPtr->models)
   {
     model.SetPoseRelativeToGraph(this->dataPtr->poseRelativeToGraph);
@@ -748,6 +1361,7 @@ void World::SetFrameAttachedToGraph(
   {
     frame.SetFrameAttachedToGraph(this->dataPtr->frameAttachedToGraph);
   }
+  this->dataPtr->LoadAllModels();
   for (auto &model : this->dataPtr->models)
   {
     model.SetFrameAttachedToGraph(this->dataPtr->frameAttachedToGraph);
@@ -851,6 +1465,7 @@ Errors World::Implementation::LoadSphericalCoordinates(
   this->sphericalCoordinates =
       ignition::math::SphericalCoordinates(surfaceModel, latitude, longitude,
       elevation, heading);
+  this->geodeticTransform.emplace(*this->sphericalCoordinates);
 
   return errors;
 }
@@ -873,6 +1488,7 @@ sdf::ElementPtr World::ToElement(const ParserConfig &_config) const
     elem->InsertElement(physics.ToElement(), true);
 
   // Models
+  this->dataPtr->LoadAllModels();
   for (const sdf::Model &model : this->dataPtr->models)
     elem->InsertElement(model.ToElement(_config), true);
 
@@ -880,6 +1496,10 @@ sdf::ElementPtr World::ToElement(const ParserConfig &_config) const
   for (const sdf::Actor &actor : this->dataPtr->actors)
     elem->InsertElement(actor.ToElement(), true);
 
+  // Populations
+  for (const sdf::Population &population : this->dataPtr->populations)
+    elem->InsertElement(population.ToElement(), true);
+
   // Lights
   for (const sdf::Light &light : this->dataPtr->lights)
     elem->InsertElement(light.ToElement(), true);
@@ -929,6 +1549,26 @@ sdf::ElementPtr World::ToElement(const ParserConfig &_config) const
 void World::ClearModels()
 {
   this->dataPtr->models.clear();
+  this->dataPtr->modelIndex.Clear();
+  this->dataPtr->lazyModels.Clear();
+  this->dataPtr->spatialIndex.InvalidateModels();
+}
+
+/////////////////////////////////////////////////
+bool World::RemoveModelByName(const std::string &_name)
+{
+  // The elements of the models that are not loaded are kept by index.
+  this->dataPtr->LoadAllModels();
+  auto &models = this->dataPtr->models;
+  auto it = std::find_if(models.begin(), models.end(),
+      [&_name](const Model &_model) { return _model.Name() == _name; });
+  if (it == models.end())
+    return false;
+
+  models.erase(it);
+  this->dataPtr->modelIndex.Rebuild(models);
+  this->dataPtr->spatialIndex.InvalidateModels();
+  return true;
 }
 
 /////////////////////////////////////////////////
@@ -941,6 +1581,13 @@ void World::ClearActors()
 void World::ClearLights()
 {
   this->dataPtr->lights.clear();
+  this->dataPtr->spatialIndex.InvalidateLights();
+}
+
+/////////////////////////////////////////////////
+void World::ClearPopulations()
+{
+  this->dataPtr->populations.clear();
 }
 
 /////////////////////////////////////////////////
@@ -953,6 +1600,394 @@ void World::ClearPhysics()
 void World::ClearFrames()
 {
   this->dataPtr->frames.clear();
+  this->dataPtr->frameIndex.Clear();
+}
+
+/////////////////////////////////////////////////
+/// \brief Append the collisions of a model and of its nested models to a
+/// collision filter table.
+/// \param[in] _model The model.
+/// \param[in] _prefix Scoped name of the model.
+/// \param[out] _table The table to append to.
+static void appendCollisionFilters(const Model &_model,
+    const std::string &_prefix, CollisionFilterTable &_table)
+{
+  for (uint64_t i = 0; i < _model.LinkCount(); ++i)
+  {
+    const Link *link = _model.LinkByIndex(i);
+    const std::string linkName = JoinName(_prefix, link->Name());
+    for (uint64_t j = 0; j < link->CollisionCount(); ++j)
+    {
+      const Collision *collision = link->CollisionByIndex(j);
+      const Contact *contact = collision->Surface()->Contact();
+      _table.names.push_back(JoinName(linkName, collision->Name()));
+      _table.collideBitmasks.push_back(contact->CollideBitmask());
+      _table.categoryBitmasks.push_back(contact->CategoryBitmask());
+    }
+  }
+
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+  {
+    const Model *nested = _model.ModelByIndex(i);
+    appendCollisionFilters(*nested, JoinName(_prefix, nested->Name()),
+                           _table);
+  }
+}
+
+/////////////////////////////////////////////////
+CollisionFilterTable World::CollisionFilters() const
+{
+  CollisionFilterTable table;
+  this->dataPtr->LoadAllModels();
+  for (const Model &model : this->dataPtr->models)
+    appendCollisionFilters(model, model.Name(), table);
+
+  // Number the distinct pairs of bitmasks in the order they first appear.
+  std::map<uint32_t, uint32_t> groups;
+  std::vector<uint16_t> groupCollide;
+  std::vector<uint16_t> groupCategory;
+  table.groupIds.reserve(table.names.size());
+  for (std::size_t i = 0; i < table.names.size(); ++i)
+  {
+    const uint32_t key =
+        (static_cast<uint32_t>(table.categoryBitmasks[i]) << 16) |
+        table.collideBitmasks[i];
+    auto inserted = groups.emplace(key, static_cast<uint32_t>(groups.size()));
+    if (inserted.second)
+    {
+      groupCollide.push_back(table.collideBitmasks[i]);
+      groupCategory.push_back(table.categoryBitmasks[i]);
+    }
+    table.groupIds.push_back(inserted.first->second);
+  }
+
+  table.groupCount = static_cast<uint32_t>(groups.size());
+  table.groupCollides.resize(
+      static_cast<std::size_t>(table.groupCount) * table.groupCount);
+  for (uint32_t a = 0; a < table.groupCount; ++a)
+  {
+    for (uint32_t b = 0; b < table.groupCount; ++b)
+    {
+      table.groupCollides[a * table.groupCount + b] =
+          ((groupCategory[a] & groupCollide[b]) |
+           (groupCategory[b] & groupCollide[a])) != 0;
+    }
+  }
+  return table;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the radius of a sphere around the origin of a geometry that
+/// contains its shape.
+/// \param[in] _geom The geometry.
+/// \return The radius, infinite if the shape has no known bounds.
+static double geometryRadius(const Geometry &_geom)
+{
+  const auto box = _geom.AxisAlignedBox();
+  if (!box)
+    return std::numeric_limits<double>::infinity();
+  if (isEmptyBox(*box))
+    return 0.0;
+
+  // The farthest corner of the box from the origin
+  return ignition::math::Vector3d(
+      std::max(std::abs(box->Min().X()), std::abs(box->Max().X())),
+      std::max(std::abs(box->Min().Y()), std::abs(box->Max().Y())),
+      std::max(std::abs(box->Min().Z()), std::abs(box->Max().Z()))).Length();
+}
+
+/////////////////////////////////////////////////
+/// \brief Grow the radius of a sphere around the origin of a model to
+/// contain the shapes of a model and of its nested models.
+/// \param[in] _model The model.
+/// \param[in] _poses Poses of the entities of the top-level model resolved
+/// by Model::ResolveAllPoses, in the order documented there.
+/// \param[in,out] _index Index in _poses of the pose of _model, moved past
+/// the poses of the entities of _model.
+/// \param[in,out] _radius The radius to grow.
+static void growModelRadius(const Model &_model,
+    const std::vector<ignition::math::Pose3d> &_poses, std::size_t &_index,
+    double &_radius)
+{
+  auto grow = [&](const Geometry *_geom)
+  {
+    const double distance = _poses[_index++].Pos().Length();
+    if (nullptr != _geom)
+      _radius = std::max(_radius, distance + geometryRadius(*_geom));
+  };
+
+  ++_index;
+  for (uint64_t i = 0; i < _model.LinkCount(); ++i)
+  {
+    const Link *link = _model.LinkByIndex(i);
+    grow(nullptr);
+    for (uint64_t j = 0; j < link->CollisionCount(); ++j)
+      grow(link->CollisionByIndex(j)->Geom());
+    for (uint64_t j = 0; j < link->VisualCount(); ++j)
+      grow(link->VisualByIndex(j)->Geom());
+    _index += link->SensorCount();
+  }
+  for (uint64_t i = 0; i < _model.JointCount(); ++i)
+    _index += 1 + _model.JointByIndex(i)->SensorCount();
+  _index += _model.FrameCount();
+  for (uint64_t i = 0; i < _model.ModelCount(); ++i)
+    growModelRadius(*_model.ModelByIndex(i), _poses, _index, _radius);
+}
+
+/////////////////////////////////////////////////
+/// \brief Add the bounds of a model to a spatial index.
+/// \param[in] _model The model.
+/// \param[in] _id ID of the model in the index.
+/// \param[in,out] _index The index.
+static void insertModelBounds(const Model &_model, std::size_t _id,
+    SpatialIndex &_index)
+{
+  ignition::math::Pose3d pose;
+  std::vector<ignition::math::Pose3d> poses;
+  if (!_model.ResolvePose(pose).empty() ||
+      !_model.ResolveAllPoses(poses).empty())
+  {
+    _index.Insert(_id, pose.Pos(), std::numeric_limits<double>::infinity());
+    return;
+  }
+
+  double radius = 0.0;
+  std::size_t poseIndex = 0;
+  growModelRadius(_model, poses, poseIndex, radius);
+  _index.Insert(_id, pose.Pos(), radius);
+}
+
+/////////////////////////////////////////////////
+/// \brief Add the bounds of a light to a spatial index.
+/// \param[in] _light The light.
+/// \param[in] _id ID of the light in the index.
+/// \param[in,out] _index The index.
+static void insertLightBounds(const Light &_light, std::size_t _id,
+    SpatialIndex &_index)
+{
+  ignition::math::Pose3d pose;
+  if (_light.Type() == LightType::DIRECTIONAL ||
+      !_light.ResolvePose(pose).empty())
+  {
+    _index.Insert(_id, pose.Pos(), std::numeric_limits<double>::infinity());
+    return;
+  }
+  _index.Insert(_id, pose.Pos(), std::max(0.0, _light.AttenuationRange()));
+}
+
+/////////////////////////////////////////////////
+Errors World::Implementation::LoadModelStubs(const ElementPtr &_sdf,
+    const ParserConfig &_config)
+{
+  Errors errors;
+  std::unordered_set<std::string> names;
+
+  // Only the name and the pose are read. The other errors of a model are
+  // reported when it is loaded.
+  for (const ElementPtr &elem : _sdf->Children("model"))
+  {
+    std::string name;
+    loadName(elem, name);
+    if (!names.insert(name).second)
+    {
+      errors.push_back({ErrorCode::DUPLICATE_NAME,
+          "model with name[" + name + "] already exists."});
+      continue;
+    }
+
+    ignition::math::Pose3d pose;
+    std::string relativeTo;
+    loadPose(elem, pose, relativeTo);
+
+    Model stub;
+    stub.SetName(name);
+    stub.SetRawPose(pose);
+    stub.SetPoseRelativeTo(relativeTo);
+    this->models.push_back(std::move(stub));
+    this->lazyModels.elements.push_back(elem);
+  }
+
+  this->lazyModels.config = _config;
+  this->lazyModels.pending = this->lazyModels.elements.size();
+  this->lazyModels.active = true;
+  return errors;
+}
+
+/////////////////////////////////////////////////
+void World::Implementation::LoadModel(std::size_t _index) const
+{
+  WorldLazyModels &lazy = this->lazyModels;
+  if (!lazy.active || lazy.pending == 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(lazy.mutex);
+  if (_index >= lazy.elements.size() || !lazy.elements[_index])
+    return;
+
+  const ElementPtr elem = std::move(lazy.elements[_index]);
+  const ParserConfig &config = *lazy.config;
+
+  Model model;
+  Errors errors;
+  {
+    ScopedElementRelease release(config.ReleaseElements());
+    errors = model.Load(elem, config);
+  }
+
+  // The graphs of the world are only built by Root::UpdateGraphs, which
+  // loads every model, so the model has graphs of its own until then.
+  const bool validate = config.GetValidationLevel() != ValidationLevel::NONE;
+  auto frameGraph = ScopedGraph<FrameAttachedToGraph>(
+      std::make_shared<FrameAttachedToGraph>());
+  Errors graphErrors = buildFrameAttachedToGraph(frameGraph, &model);
+  frameGraph.Freeze();
+  if (validate && graphErrors.empty())
+    graphErrors = validateFrameAttachedToGraph(frameGraph);
+  errors.insert(errors.end(), graphErrors.begin(), graphErrors.end());
+  model.SetFrameAttachedToGraph(frameGraph);
+
+  auto poseGraph = ScopedGraph<PoseRelativeToGraph>(
+      std::make_shared<PoseRelativeToGraph>());
+  graphErrors = buildPoseRelativeToGraph(poseGraph, &model);
+  poseGraph.Freeze();
+  if (validate && graphErrors.empty())
+    graphErrors = validatePoseRelativeToGraph(poseGraph);
+  errors.insert(errors.end(), graphErrors.begin(), graphErrors.end());
+  model.SetPoseRelativeToGraph(poseGraph);
+
+  for (const Error &error : errors)
+  {
+    sdferr << "Error loading model [" << this->models[_index].Name()
+           << "] of world [" << this->name << "]: " << error << '\n';
+  }
+
+  this->models[_index] = std::move(model);
+  this->modelIndex.Track(this->models[_index]);
+  --lazy.pending;
+}
+
+/////////////////////////////////////////////////
+void World::Implementation::LoadAllModels() const
+{
+  for (std::size_t i = 0;
+       this->lazyModels.pending > 0 && i < this->models.size(); ++i)
+  {
+    this->LoadModel(i);
+  }
+}
+
+/////////////////////////////////////////////////
+void World::Implementation::InsertLastModelBounds()
+{
+  std::lock_guard<std::mutex> lock(this->spatialIndex.mutex);
+  if (this->spatialIndex.modelsValid)
+  {
+    insertModelBounds(this->models.back(), this->models.size() - 1,
+                      this->spatialIndex.models);
+  }
+}
+
+/////////////////////////////////////////////////
+void World::Implementation::InsertLastLightBounds()
+{
+  std::lock_guard<std::mutex> lock(this->spatialIndex.mutex);
+  if (this->spatialIndex.lightsValid)
+  {
+    insertLightBounds(this->lights.back(), this->lights.size() - 1,
+                      this->spatialIndex.lights);
+  }
+}
+
+/////////////////////////////////////////////////
+void World::Implementation::UpdateModelIndex() const
+{
+  if (this->spatialIndex.modelsValid)
+    return;
+  this->LoadAllModels();
+  this->spatialIndex.models.Clear();
+  for (std::size_t i = 0; i < this->models.size(); ++i)
+    insertModelBounds(this->models[i], i, this->spatialIndex.models);
+  this->spatialIndex.modelsValid = true;
+}
+
+/////////////////////////////////////////////////
+void World::Implementation::UpdateLightIndex() const
+{
+  if (this->spatialIndex.lightsValid)
+    return;
+  this->spatialIndex.lights.Clear();
+  for (std::size_t i = 0; i < this->lights.size(); ++i)
+    insertLightBounds(this->lights[i], i, this->spatialIndex.lights);
+  this->spatialIndex.lightsValid = true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the objects with the IDs found by a spatial query.
+/// \param[in] _objects The objects, indexed by ID.
+/// \param[in] _ids The IDs.
+/// \return Pointers to the objects, in the order of _objects.
+template <typename T>
+static std::vector<const T *> objectsById(const std::vector<T> &_objects,
+    std::vector<std::size_t> &_ids)
+{
+  std::sort(_ids.begin(), _ids.end());
+  std::vector<const T *> result;
+  result.reserve(_ids.size());
+  for (std::size_t id : _ids)
+    result.push_back(&_objects[id]);
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<const Model *> World::ModelsInRadius(
+    const ignition::math::Vector3d &_point, double _radius) const
+{
+  std::vector<std::size_t> ids;
+  {
+    auto lock = this->dataPtr->spatialIndex.LockUnlessFrozen();
+    this->dataPtr->UpdateModelIndex();
+    this->dataPtr->spatialIndex.models.QuerySphere(_point, _radius, ids);
+  }
+  return objectsById(this->dataPtr->models, ids);
+}
+
+/////////////////////////////////////////////////
+std::vector<const Model *> World::ModelsInBox(
+    const ignition::math::AxisAlignedBox &_box) const
+{
+  std::vector<std::size_t> ids;
+  {
+    auto lock = this->dataPtr->spatialIndex.LockUnlessFrozen();
+    this->dataPtr->UpdateModelIndex();
+    this->dataPtr->spatialIndex.models.QueryBox(_box, ids);
+  }
+  return objectsById(this->dataPtr->models, ids);
+}
+
+/////////////////////////////////////////////////
+std::vector<const Light *> World::LightsInRadius(
+    const ignition::math::Vector3d &_point, double _radius) const
+{
+  std::vector<std::size_t> ids;
+  {
+    auto lock = this->dataPtr->spatialIndex.LockUnlessFrozen();
+    this->dataPtr->UpdateLightIndex();
+    this->dataPtr->spatialIndex.lights.QuerySphere(_point, _radius, ids);
+  }
+  return objectsById(this->dataPtr->lights, ids);
+}
+
+/////////////////////////////////////////////////
+std::vector<const Light *> World::LightsInBox(
+    const ignition::math::AxisAlignedBox &_box) const
+{
+  std::vector<std::size_t> ids;
+  {
+    auto lock = this->dataPtr->spatialIndex.LockUnlessFrozen();
+    this->dataPtr->UpdateLightIndex();
+    this->dataPtr->spatialIndex.lights.QueryBox(_box, ids);
+  }
+  return objectsById(this->dataPtr->lights, ids);
 }
 
 /////////////////////////////////////////////////
@@ -961,6 +1996,21 @@ bool World::AddModel(const Model &_model)
   if (this->ModelNameExists(_model.Name()))
     return false;
   this->dataPtr->models.push_back(_model);
+  this->dataPtr->modelIndex.Add(
+      this->dataPtr->models, this->dataPtr->models.size() - 1);
+  this->dataPtr->InsertLastModelBounds();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool World::AddModel(Model &&_model)
+{
+  if (this->ModelNameExists(_model.Name()))
+    return false;
+  this->dataPtr->models.push_back(std::move(_model));
+  this->dataPtr->modelIndex.Add(
+      this->dataPtr->models, this->dataPtr->models.size() - 1);
+  this->dataPtr->InsertLastModelBounds();
   return true;
 }
 
@@ -974,12 +2024,44 @@ bool World::AddActor(const Actor &_actor)
   return true;
 }
 
+/////////////////////////////////////////////////
+bool World::AddActor(Actor &&_actor)
+{
+  if (this->ActorNameExists(_actor.Name()))
+    return false;
+  this->dataPtr->actors.push_back(std::move(_actor));
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool World::AddPopulation(const Population &_population)
+{
+  if (this->PopulationNameExists(_population.Name()))
+    return false;
+  this->dataPtr->populations.push_back(_population);
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 bool World::AddLight(const Light &_light)
 {
   if (this->LightNameExists(_light.Name()))
     return false;
   this->dataPtr->lights.push_back(_light);
+  this->dataPtr->InsertLastLightBounds();
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool World::AddLight(Light &&_light)
+{
+  if (this->LightNameExists(_light.Name()))
+    return false;
+  this->dataPtr->lights.push_back(std::move(_light));
+  this->dataPtr->InsertLastLightBounds();
 
   return true;
 }
@@ -994,12 +2076,36 @@ bool World::AddPhysics(const Physics &_physics)
   return true;
 }
 
+/////////////////////////////////////////////////
+bool World::AddPhysics(Physics &&_physics)
+{
+  if (this->PhysicsNameExists(_physics.Name()))
+    return false;
+  this->dataPtr->physics.push_back(std::move(_physics));
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 bool World::AddFrame(const Frame &_frame)
 {
   if (this->FrameNameExists(_frame.Name()))
     return false;
   this->dataPtr->frames.push_back(_frame);
+  this->dataPtr->frameIndex.Add(
+      this->dataPtr->frames, this->dataPtr->frames.size() - 1);
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool World::AddFrame(Frame &&_frame)
+{
+  if (this->FrameNameExists(_frame.Name()))
+    return false;
+  this->dataPtr->frames.push_back(std::move(_frame));
+  this->dataPtr->frameIndex.Add(
+      this->dataPtr->frames, this->dataPtr->frames.size() - 1);
 
   return true;
 }
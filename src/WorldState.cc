@@ -0,0 +1,1191 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+
+#include "sdf/WorldState.hh"
+#include "sdf/parser.hh"
+#include "ScopedTraceEvent.hh"
+#include "Utils.hh"
+
+using namespace sdf;
+
+/// \brief Private data for a WorldState.
+class sdf::WorldState::Implementation
+{
+  /// \brief Indices of the entities by scoped name.
+  public: struct NameIndices
+  {
+    /// \brief Indices of the models.
+    std::unordered_map<std::string, uint64_t> models;
+
+    /// \brief Indices of the links.
+    std::unordered_map<std::string, uint64_t> links;
+
+    /// \brief Indices of the joints.
+    std::unordered_map<std::string, uint64_t> joints;
+  };
+
+  /// \brief Load a model state and its nested model states.
+  /// \param[in] _sdf The <model> element.
+  /// \param[in] _parent Index of the parent model, or kNoParent.
+  public: void LoadModel(const ElementPtr &_sdf, uint64_t _parent);
+
+  /// \brief Append a model state, with an identity pose and a unit scale.
+  /// \param[in] _name Name of the model.
+  /// \param[in] _parent Index of the parent model, or kNoParent.
+  /// \return The index of the model.
+  public: uint64_t PushModel(const std::string &_name, uint64_t _parent);
+
+  /// \brief Append a link state, with identity pose, velocity,
+  /// acceleration and wrench.
+  /// \param[in] _name Name of the link.
+  /// \param[in] _model Index of the model of the link.
+  /// \return The index of the link.
+  public: uint64_t PushLink(const std::string &_name, uint64_t _model);
+
+  /// \brief Replace the angles of a joint by the angles of a joint of
+  /// another state.
+  /// \param[in] _joint Index of the joint.
+  /// \param[in] _other The other state.
+  /// \param[in] _otherJoint Index of the joint in _other.
+  public: void SetJointAngles(uint64_t _joint, const Implementation &_other,
+                              uint64_t _otherJoint);
+
+  /// \brief Remove entities. The nested models, links and joints of the
+  /// removed models are also removed.
+  /// \param[in] _models Whether each model is removed.
+  /// \param[in] _links Whether each link is removed.
+  /// \param[in] _joints Whether each joint is removed.
+  public: void RemoveEntities(std::vector<bool> _models,
+                              const std::vector<bool> &_links,
+                              const std::vector<bool> &_joints);
+
+  /// \brief Get the scoped names of the models.
+  /// \return The name of each model, scoped by the names of its parents.
+  public: std::vector<std::string> ScopedModelNames() const;
+
+  /// \brief Get the maps of scoped names to indices, which are built on
+  /// the first call after entities are added or removed.
+  /// \return The maps.
+  public: std::shared_ptr<const NameIndices> Indices() const;
+
+  /// \brief Clear the maps of scoped names to indices, when entities are
+  /// added or removed.
+  public: void ClearIndices();
+
+  /// \brief Name of the world.
+  public: std::string worldName = "__default__";
+
+  /// \brief Simulation time.
+  public: sdf::Time simTime;
+
+  /// \brief Wall time.
+  public: sdf::Time wallTime;
+
+  /// \brief Real time.
+  public: sdf::Time realTime;
+
+  /// \brief Number of iterations.
+  public: uint64_t iterations = 0;
+
+  /// \brief The <insertions> element.
+  public: sdf::ElementPtr insertions;
+
+  /// \brief Names of the deleted entities.
+  public: std::vector<std::string> deletions;
+
+  /// \brief Names of the models.
+  public: std::vector<std::string> modelNames;
+
+  /// \brief Indices of the parents of the models.
+  public: std::vector<uint64_t> modelParents;
+
+  /// \brief Poses of the models.
+  public: std::vector<ignition::math::Pose3d> modelPoses;
+
+  /// \brief Scales of the models.
+  public: std::vector<ignition::math::Vector3d> modelScales;
+
+  /// \brief Indices of the models of the links.
+  public: std::vector<uint64_t> linkModels;
+
+  /// \brief Names of the links.
+  public: std::vector<std::string> linkNames;
+
+  /// \brief Poses of the links.
+  public: std::vector<ignition::math::Pose3d> linkPoses;
+
+  /// \brief Velocities of the links.
+  public: std::vector<ignition::math::Pose3d> linkVelocities;
+
+  /// \brief Accelerations of the links.
+  public: std::vector<ignition::math::Pose3d> linkAccelerations;
+
+  /// \brief Wrenches of the links.
+  public: std::vector<ignition::math::Pose3d> linkWrenches;
+
+  /// \brief Indices of the models of the joints.
+  public: std::vector<uint64_t> jointModels;
+
+  /// \brief Names of the joints.
+  public: std::vector<std::string> jointNames;
+
+  /// \brief Offsets of the angles of each joint, with a last offset equal
+  /// to the number of angles.
+  public: std::vector<uint64_t> jointAngleOffsets{0};
+
+  /// \brief Angles of the joints.
+  public: std::vector<double> jointAngles;
+
+  /// \brief Axis of each angle.
+  public: std::vector<unsigned int> jointAxes;
+
+  /// \brief Maps of scoped names to indices, or nullptr if they are not
+  /// built yet. The maps are never modified once built, so copies of the
+  /// state share them, and they are accessed atomically because they are
+  /// built by const functions.
+  public: mutable std::shared_ptr<const NameIndices> indices;
+
+  /// \brief The SDF element pointer used during load.
+  public: sdf::ElementPtr sdf;
+};
+
+/////////////////////////////////////////////////
+void WorldState::Implementation::LoadModel(const ElementPtr &_sdf,
+    uint64_t _parent)
+{
+  const uint64_t model =
+      this->PushModel(_sdf->Get<std::string>("name"), _parent);
+
+  // Read the children in a single pass, instead of looking up each of
+  // them by name
+  for (ElementPtr child = _sdf->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    const std::string &name = child->GetName();
+    if (name == "link")
+    {
+      this->PushLink(child->Get<std::string>("name"), model);
+      for (ElementPtr linkChild = child->GetFirstElement(); linkChild;
+           linkChild = linkChild->GetNextElement())
+      {
+        const std::string &linkChildName = linkChild->GetName();
+        if (linkChildName == "pose")
+        {
+          this->linkPoses.back() =
+              linkChild->Get<ignition::math::Pose3d>();
+        }
+        else if (linkChildName == "velocity")
+        {
+          this->linkVelocities.back() =
+              linkChild->Get<ignition::math::Pose3d>();
+        }
+        else if (linkChildName == "acceleration")
+        {
+          this->linkAccelerations.back() =
+              linkChild->Get<ignition::math::Pose3d>();
+        }
+        else if (linkChildName == "wrench")
+        {
+          this->linkWrenches.back() =
+              linkChild->Get<ignition::math::Pose3d>();
+        }
+      }
+    }
+    else if (name == "joint")
+    {
+      this->jointModels.push_back(model);
+      this->jointNames.push_back(child->Get<std::string>("name"));
+      for (ElementPtr angle = child->GetFirstElement(); angle;
+           angle = angle->GetNextElement())
+      {
+        if (angle->GetName() == "angle")
+        {
+          this->jointAngles.push_back(angle->Get<double>());
+          this->jointAxes.push_back(angle->Get<unsigned int>("axis"));
+        }
+      }
+      this->jointAngleOffsets.push_back(this->jointAngles.size());
+    }
+    else if (name == "model")
+    {
+      this->LoadModel(child, model);
+    }
+    else if (name == "pose")
+    {
+      this->modelPoses[model] = child->Get<ignition::math::Pose3d>();
+    }
+    else if (name == "scale")
+    {
+      this->modelScales[model] = child->Get<ignition::math::Vector3d>();
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+uint64_t WorldState::Implementation::PushModel(const std::string &_name,
+    uint64_t _parent)
+{
+  this->modelNames.push_back(_name);
+  this->modelParents.push_back(_parent);
+  this->modelPoses.emplace_back();
+  this->modelScales.emplace_back(1, 1, 1);
+  return this->modelNames.size() - 1;
+}
+
+/////////////////////////////////////////////////
+uint64_t WorldState::Implementation::PushLink(const std::string &_name,
+    uint64_t _model)
+{
+  this->linkModels.push_back(_model);
+  this->linkNames.push_back(_name);
+  this->linkPoses.emplace_back();
+  this->linkVelocities.emplace_back();
+  this->linkAccelerations.emplace_back();
+  this->linkWrenches.emplace_back();
+  return this->linkNames.size() - 1;
+}
+
+/////////////////////////////////////////////////
+void WorldState::Implementation::SetJointAngles(uint64_t _joint,
+    const Implementation &_other, uint64_t _otherJoint)
+{
+  const uint64_t begin = this->jointAngleOffsets[_joint];
+  const uint64_t end = this->jointAngleOffsets[_joint + 1];
+  const uint64_t otherBegin = _other.jointAngleOffsets[_otherJoint];
+  const uint64_t otherEnd = _other.jointAngleOffsets[_otherJoint + 1];
+
+  if (end - begin == otherEnd - otherBegin)
+  {
+    std::copy(_other.jointAngles.begin() + otherBegin,
+              _other.jointAngles.begin() + otherEnd,
+              this->jointAngles.begin() + begin);
+    std::copy(_other.jointAxes.begin() + otherBegin,
+              _other.jointAxes.begin() + otherEnd,
+              this->jointAxes.begin() + begin);
+    return;
+  }
+
+  // The number of axes changed, so the angles of the next joints move
+  this->jointAngles.erase(this->jointAngles.begin() + begin,
+                          this->jointAngles.begin() + end);
+  this->jointAngles.insert(this->jointAngles.begin() + begin,
+                           _other.jointAngles.begin() + otherBegin,
+                           _other.jointAngles.begin() + otherEnd);
+  this->jointAxes.erase(this->jointAxes.begin() + begin,
+                        this->jointAxes.begin() + end);
+  this->jointAxes.insert(this->jointAxes.begin() + begin,
+                         _other.jointAxes.begin() + otherBegin,
+                         _other.jointAxes.begin() + otherEnd);
+  for (uint64_t j = _joint + 1; j < this->jointAngleOffsets.size(); ++j)
+  {
+    this->jointAngleOffsets[j] =
+        this->jointAngleOffsets[j] - (end - begin) + (otherEnd - otherBegin);
+  }
+}
+
+/////////////////////////////////////////////////
+void WorldState::Implementation::RemoveEntities(std::vector<bool> _models,
+    const std::vector<bool> &_links, const std::vector<bool> &_joints)
+{
+  // Compact the arrays in place. Parents come before their nested models,
+  // so the new index of a parent is known before its nested models move.
+  std::vector<uint64_t> newIndices(this->modelNames.size(), kNoParent);
+  uint64_t modelCount = 0;
+  for (uint64_t i = 0; i < this->modelNames.size(); ++i)
+  {
+    const uint64_t parent = this->modelParents[i];
+    if (parent != kNoParent && _models[parent])
+      _models[i] = true;
+    if (_models[i])
+      continue;
+
+    newIndices[i] = modelCount;
+    this->modelNames[modelCount] = std::move(this->modelNames[i]);
+    this->modelParents[modelCount] =
+        parent == kNoParent ? kNoParent : newIndices[parent];
+    this->modelPoses[modelCount] = this->modelPoses[i];
+    this->modelScales[modelCount] = this->modelScales[i];
+    ++modelCount;
+  }
+  this->modelNames.resize(modelCount);
+  this->modelParents.resize(modelCount);
+  this->modelPoses.resize(modelCount);
+  this->modelScales.resize(modelCount);
+
+  uint64_t linkCount = 0;
+  for (uint64_t i = 0; i < this->linkNames.size(); ++i)
+  {
+    if (_links[i] || _models[this->linkModels[i]])
+      continue;
+
+    this->linkModels[linkCount] = newIndices[this->linkModels[i]];
+    this->linkNames[linkCount] = std::move(this->linkNames[i]);
+    this->linkPoses[linkCount] = this->linkPoses[i];
+    this->linkVelocities[linkCount] = this->linkVelocities[i];
+    this->linkAccelerations[linkCount] = this->linkAccelerations[i];
+    this->linkWrenches[linkCount] = this->linkWrenches[i];
+    ++linkCount;
+  }
+  this->linkModels.resize(linkCount);
+  this->linkNames.resize(linkCount);
+  this->linkPoses.resize(linkCount);
+  this->linkVelocities.resize(linkCount);
+  this->linkAccelerations.resize(linkCount);
+  this->linkWrenches.resize(linkCount);
+
+  // The offset of the next joint is read before it is overwritten
+  uint64_t jointCount = 0;
+  uint64_t angleCount = 0;
+  uint64_t begin = 0;
+  for (uint64_t i = 0; i < this->jointNames.size(); ++i)
+  {
+    const uint64_t end = this->jointAngleOffsets[i + 1];
+    if (!_joints[i] && !_models[this->jointModels[i]])
+    {
+      for (uint64_t j = begin; j < end; ++j, ++angleCount)
+      {
+        this->jointAngles[angleCount] = this->jointAngles[j];
+        this->jointAxes[angleCount] = this->jointAxes[j];
+      }
+      this->jointModels[jointCount] = newIndices[this->jointModels[i]];
+      this->jointNames[jointCount] = std::move(this->jointNames[i]);
+      this->jointAngleOffsets[jointCount + 1] = angleCount;
+      ++jointCount;
+    }
+    begin = end;
+  }
+  this->jointModels.resize(jointCount);
+  this->jointNames.resize(jointCount);
+  this->jointAngleOffsets.resize(jointCount + 1);
+  this->jointAngles.resize(angleCount);
+  this->jointAxes.resize(angleCount);
+
+  this->ClearIndices();
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> WorldState::Implementation::ScopedModelNames() const
+{
+  std::vector<std::string> names;
+  names.reserve(this->modelNames.size());
+  for (uint64_t i = 0; i < this->modelNames.size(); ++i)
+  {
+    // Parents come before their nested models, so their scoped names are
+    // already known
+    const uint64_t parent = this->modelParents[i];
+    names.push_back(parent == kNoParent ? this->modelNames[i] :
+        names[parent] + kSdfScopeDelimiter + this->modelNames[i]);
+  }
+  return names;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const WorldState::Implementation::NameIndices>
+WorldState::Implementation::Indices() const
+{
+  std::shared_ptr<const NameIndices> current =
+      std::atomic_load(&this->indices);
+  if (current)
+    return current;
+
+  auto built = std::make_shared<NameIndices>();
+  const std::vector<std::string> scopedModelNames = this->ScopedModelNames();
+  for (uint64_t i = 0; i < scopedModelNames.size(); ++i)
+    built->models.emplace(scopedModelNames[i], i);
+
+  for (uint64_t i = 0; i < this->linkNames.size(); ++i)
+  {
+    built->links.emplace(scopedModelNames[this->linkModels[i]] +
+        kSdfScopeDelimiter + this->linkNames[i], i);
+  }
+
+  for (uint64_t i = 0; i < this->jointNames.size(); ++i)
+  {
+    built->joints.emplace(scopedModelNames[this->jointModels[i]] +
+        kSdfScopeDelimiter + this->jointNames[i], i);
+  }
+
+  current = built;
+  std::atomic_store(&this->indices, current);
+  return current;
+}
+
+/////////////////////////////////////////////////
+void WorldState::Implementation::ClearIndices()
+{
+  std::atomic_store(&this->indices, std::shared_ptr<const NameIndices>());
+}
+
+/////////////////////////////////////////////////
+/// \brief Find a scoped name in a map of indices.
+/// \param[in] _indices The map.
+/// \param[in] _scopedName The scoped name.
+/// \return The index, or std::nullopt if the name is not in the map.
+static std::optional<uint64_t> findIndex(
+    const std::unordered_map<std::string, uint64_t> &_indices,
+    const std::string &_scopedName)
+{
+  auto it = _indices.find(_scopedName);
+  if (it == _indices.end())
+    return std::nullopt;
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether two joints have the same angles.
+/// \param[in] _angles1 Angles of the joints of the first state.
+/// \param[in] _axes1 Axes of the joints of the first state.
+/// \param[in] _offsets1 Angle offsets of the joints of the first state.
+/// \param[in] _joint1 Index of the joint in the first state.
+/// \param[in] _angles2 Angles of the joints of the second state.
+/// \param[in] _axes2 Axes of the joints of the second state.
+/// \param[in] _offsets2 Angle offsets of the joints of the second state.
+/// \param[in] _joint2 Index of the joint in the second state.
+/// \return True if the joints have the same axes, with equal angles.
+static bool jointAnglesEqual(
+    const std::vector<double> &_angles1,
+    const std::vector<unsigned int> &_axes1,
+    const std::vector<uint64_t> &_offsets1, uint64_t _joint1,
+    const std::vector<double> &_angles2,
+    const std::vector<unsigned int> &_axes2,
+    const std::vector<uint64_t> &_offsets2, uint64_t _joint2)
+{
+  const uint64_t begin1 = _offsets1[_joint1];
+  const uint64_t begin2 = _offsets2[_joint2];
+  const uint64_t count = _offsets1[_joint1 + 1] - begin1;
+  if (count != _offsets2[_joint2 + 1] - begin2)
+    return false;
+
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    if (_axes1[begin1 + i] != _axes2[begin2 + i] ||
+        !ignition::math::equal(_angles1[begin1 + i], _angles2[begin2 + i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+WorldState::WorldState()
+  : dataPtr(ignition::utils::MakeImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+Errors WorldState::Load(ElementPtr _sdf)
+{
+  return this->Load(_sdf, ParserConfig::GlobalConfig());
+}
+
+/////////////////////////////////////////////////
+Errors WorldState::Load(ElementPtr _sdf, const ParserConfig &/*_config*/)
+{
+  ScopedTraceEvent event("WorldState::Load", "dom");
+  Errors errors;
+
+  this->dataPtr->sdf = retainedElement(_sdf);
+
+  // Check that sdf is a valid pointer
+  if (!_sdf)
+  {
+    errors.push_back({ErrorCode::ELEMENT_MISSING,
+        "Attempting to load a world state, but the provided SDF "
+        "element is null."});
+    return errors;
+  }
+
+  // Check that the provided SDF element is a <state>
+  // This is an error that cannot be recovered, so return an error.
+  if (_sdf->GetName() != "state")
+  {
+    errors.push_back({ErrorCode::ELEMENT_INCORRECT_TYPE,
+        "Attempting to load a WorldState, but the provided SDF element is "
+        "not a <state>."});
+    return errors;
+  }
+
+  this->ClearEntities();
+  this->dataPtr->deletions.clear();
+  this->dataPtr->insertions.reset();
+  this->dataPtr->simTime = sdf::Time();
+  this->dataPtr->wallTime = sdf::Time();
+  this->dataPtr->realTime = sdf::Time();
+  this->dataPtr->iterations = 0;
+
+  this->dataPtr->worldName = _sdf->Get<std::string>("world_name");
+
+  for (ElementPtr child = _sdf->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    const std::string &name = child->GetName();
+    if (name == "model")
+    {
+      this->dataPtr->LoadModel(child, kNoParent);
+    }
+    else if (name == "sim_time")
+    {
+      this->dataPtr->simTime = child->Get<sdf::Time>();
+    }
+    else if (name == "wall_time")
+    {
+      this->dataPtr->wallTime = child->Get<sdf::Time>();
+    }
+    else if (name == "real_time")
+    {
+      this->dataPtr->realTime = child->Get<sdf::Time>();
+    }
+    else if (name == "iterations")
+    {
+      this->dataPtr->iterations = child->Get<unsigned int>();
+    }
+    else if (name == "insertions")
+    {
+      this->dataPtr->insertions = child->Clone();
+    }
+    else if (name == "deletions")
+    {
+      for (ElementPtr deletion = child->GetFirstElement(); deletion;
+           deletion = deletion->GetNextElement("name"))
+      {
+        if (deletion->GetName() == "name")
+          this->dataPtr->deletions.push_back(deletion->Get<std::string>());
+      }
+    }
+  }
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+const std::string &WorldState::WorldName() const
+{
+  return this->dataPtr->worldName;
+}
+
+/////////////////////////////////////////////////
+void WorldState::SetWorldName(const std::string &_name)
+{
+  this->dataPtr->worldName = _name;
+}
+
+/////////////////////////////////////////////////
+const sdf::Time &WorldState::SimTime() const
+{
+  return this->dataPtr->simTime;
+}
+
+/////////////////////////////////////////////////
+void WorldState::SetSimTime(const sdf::Time &_time)
+{
+  this->dataPtr->simTime = _time;
+}
+
+/////////////////////////////////////////////////
+const sdf::Time &WorldState::WallTime() const
+{
+  return this->dataPtr->wallTime;
+}
+
+/////////////////////////////////////////////////
+void WorldState::SetWallTime(const sdf::Time &_time)
+{
+  this->dataPtr->wallTime = _time;
+}
+
+/////////////////////////////////////////////////
+const sdf::Time &WorldState::RealTime() const
+{
+  return this->dataPtr->realTime;
+}
+
+/////////////////////////////////////////////////
+void WorldState::SetRealTime(const sdf::Time &_time)
+{
+  this->dataPtr->realTime = _time;
+}
+
+/////////////////////////////////////////////////
+uint64_t WorldState::Iterations() const
+{
+  return this->dataPtr->iterations;
+}
+
+/////////////////////////////////////////////////
+void WorldState::SetIterations(uint64_t _iterations)
+{
+  this->dataPtr->iterations = _iterations;
+}
+
+/////////////////////////////////////////////////
+sdf::ElementPtr WorldState::Insertions() const
+{
+  return this->dataPtr->insertions;
+}
+
+/////////////////////////////////////////////////
+void WorldState::SetInsertions(sdf::ElementPtr _insertions)
+{
+  this->dataPtr->insertions = _insertions;
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &WorldState::Deletions() const
+{
+  return this->dataPtr->deletions;
+}
+
+/////////////////////////////////////////////////
+void WorldState::AddDeletion(const std::string &_name)
+{
+  this->dataPtr->deletions.push_back(_name);
+}
+
+/////////////////////////////////////////////////
+uint64_t WorldState::ModelCount() const
+{
+  return this->dataPtr->modelNames.size();
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &WorldState::ModelNames() const
+{
+  return this->dataPtr->modelNames;
+}
+
+/////////////////////////////////////////////////
+const std::vector<uint64_t> &WorldState::ModelParents() const
+{
+  return this->dataPtr->modelParents;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Pose3d> &WorldState::ModelPoses() const
+{
+  return this->dataPtr->modelPoses;
+}
+
+/////////////////////////////////////////////////
+std::vector<ignition::math::Pose3d> &WorldState::ModelPoses()
+{
+  return this->dataPtr->modelPoses;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Vector3d> &WorldState::ModelScales() const
+{
+  return this->dataPtr->modelScales;
+}
+
+/////////////////////////////////////////////////
+std::vector<ignition::math::Vector3d> &WorldState::ModelScales()
+{
+  return this->dataPtr->modelScales;
+}
+
+/////////////////////////////////////////////////
+std::optional<uint64_t> WorldState::ModelIndex(
+    const std::string &_scopedName) const
+{
+  return findIndex(this->dataPtr->Indices()->models, _scopedName);
+}
+
+/////////////////////////////////////////////////
+std::optional<uint64_t> WorldState::AddModel(const std::string &_name,
+    uint64_t _parent)
+{
+  if (_parent != kNoParent && _parent >= this->dataPtr->modelNames.size())
+    return std::nullopt;
+
+  this->dataPtr->ClearIndices();
+  return this->dataPtr->PushModel(_name, _parent);
+}
+
+/////////////////////////////////////////////////
+uint64_t WorldState::LinkCount() const
+{
+  return this->dataPtr->linkNames.size();
+}
+
+/////////////////////////////////////////////////
+const std::vector<uint64_t> &WorldState::LinkModels() const
+{
+  return this->dataPtr->linkModels;
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &WorldState::LinkNames() const
+{
+  return this->dataPtr->linkNames;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Pose3d> &WorldState::LinkPoses() const
+{
+  return this->dataPtr->linkPoses;
+}
+
+/////////////////////////////////////////////////
+std::vector<ignition::math::Pose3d> &WorldState::LinkPoses()
+{
+  return this->dataPtr->linkPoses;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Pose3d> &WorldState::LinkVelocities() const
+{
+  return this->dataPtr->linkVelocities;
+}
+
+/////////////////////////////////////////////////
+std::vector<ignition::math::Pose3d> &WorldState::LinkVelocities()
+{
+  return this->dataPtr->linkVelocities;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Pose3d> &
+WorldState::LinkAccelerations() const
+{
+  return this->dataPtr->linkAccelerations;
+}
+
+/////////////////////////////////////////////////
+std::vector<ignition::math::Pose3d> &WorldState::LinkAccelerations()
+{
+  return this->dataPtr->linkAccelerations;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Pose3d> &WorldState::LinkWrenches() const
+{
+  return this->dataPtr->linkWrenches;
+}
+
+/////////////////////////////////////////////////
+std::vector<ignition::math::Pose3d> &WorldState::LinkWrenches()
+{
+  return this->dataPtr->linkWrenches;
+}
+
+/////////////////////////////////////////////////
+std::optional<uint64_t> WorldState::LinkIndex(
+    const std::string &_scopedName) const
+{
+  return findIndex(this->dataPtr->Indices()->links, _scopedName);
+}
+
+/////////////////////////////////////////////////
+std::optional<uint64_t> WorldState::AddLink(const std::string &_name,
+    uint64_t _model)
+{
+  if (_model >= this->dataPtr->modelNames.size())
+    return std::nullopt;
+
+  this->dataPtr->ClearIndices();
+  return this->dataPtr->PushLink(_name, _model);
+}
+
+/////////////////////////////////////////////////
+uint64_t WorldState::JointCount() const
+{
+  return this->dataPtr->jointNames.size();
+}
+
+/////////////////////////////////////////////////
+const std::vector<uint64_t> &WorldState::JointModels() const
+{
+  return this->dataPtr->jointModels;
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &WorldState::JointNames() const
+{
+  return this->dataPtr->jointNames;
+}
+
+/////////////////////////////////////////////////
+const std::vector<uint64_t> &WorldState::JointAngleOffsets() const
+{
+  return this->dataPtr->jointAngleOffsets;
+}
+
+/////////////////////////////////////////////////
+const std::vector<double> &WorldState::JointAngles() const
+{
+  return this->dataPtr->jointAngles;
+}
+
+/////////////////////////////////////////////////
+std::vector<double> &WorldState::JointAngles()
+{
+  return this->dataPtr->jointAngles;
+}
+
+/////////////////////////////////////////////////
+const std::vector<unsigned int> &WorldState::JointAxes() const
+{
+  return this->dataPtr->jointAxes;
+}
+
+/////////////////////////////////////////////////
+std::optional<uint64_t> WorldState::JointIndex(
+    const std::string &_scopedName) const
+{
+  return findIndex(this->dataPtr->Indices()->joints, _scopedName);
+}
+
+/////////////////////////////////////////////////
+std::optional<uint64_t> WorldState::AddJoint(const std::string &_name,
+    uint64_t _model, unsigned int _axisCount)
+{
+  if (_model >= this->dataPtr->modelNames.size())
+    return std::nullopt;
+
+  this->dataPtr->ClearIndices();
+  this->dataPtr->jointModels.push_back(_model);
+  this->dataPtr->jointNames.push_back(_name);
+  for (unsigned int axis = 0; axis < _axisCount; ++axis)
+  {
+    this->dataPtr->jointAngles.push_back(0.0);
+    this->dataPtr->jointAxes.push_back(axis);
+  }
+  this->dataPtr->jointAngleOffsets.push_back(
+      this->dataPtr->jointAngles.size());
+  return this->dataPtr->jointNames.size() - 1;
+}
+
+/////////////////////////////////////////////////
+void WorldState::ClearEntities()
+{
+  this->dataPtr->ClearIndices();
+  this->dataPtr->modelNames.clear();
+  this->dataPtr->modelParents.clear();
+  this->dataPtr->modelPoses.clear();
+  this->dataPtr->modelScales.clear();
+  this->dataPtr->linkModels.clear();
+  this->dataPtr->linkNames.clear();
+  this->dataPtr->linkPoses.clear();
+  this->dataPtr->linkVelocities.clear();
+  this->dataPtr->linkAccelerations.clear();
+  this->dataPtr->linkWrenches.clear();
+  this->dataPtr->jointModels.clear();
+  this->dataPtr->jointNames.clear();
+  this->dataPtr->jointAngleOffsets.assign(1, 0);
+  this->dataPtr->jointAngles.clear();
+  this->dataPtr->jointAxes.clear();
+}
+
+/////////////////////////////////////////////////
+WorldState WorldState::Diff(const WorldState &_from, const WorldState &_to)
+{
+  const Implementation &from = *_from.dataPtr;
+  const Implementation &to = *_to.dataPtr;
+  const auto fromIndices = from.Indices();
+  const auto toIndices = to.Indices();
+  const std::vector<std::string> toNames = to.ScopedModelNames();
+
+  WorldState diff;
+  Implementation &out = *diff.dataPtr;
+  out.worldName = to.worldName;
+  out.simTime = to.simTime;
+  out.wallTime = to.wallTime;
+  out.realTime = to.realTime;
+  out.iterations = to.iterations;
+  out.insertions = to.insertions;
+  out.deletions = to.deletions;
+
+  // Find the models, links and joints that are new or changed
+  std::vector<bool> keepModels(to.modelNames.size());
+  for (uint64_t i = 0; i < to.modelNames.size(); ++i)
+  {
+    auto it = fromIndices->models.find(toNames[i]);
+    keepModels[i] = it == fromIndices->models.end() ||
+        from.modelPoses[it->second] != to.modelPoses[i] ||
+        from.modelScales[it->second] != to.modelScales[i];
+  }
+
+  std::vector<bool> keepLinks(to.linkNames.size());
+  for (uint64_t i = 0; i < to.linkNames.size(); ++i)
+  {
+    auto it = fromIndices->links.find(toNames[to.linkModels[i]] +
+        kSdfScopeDelimiter + to.linkNames[i]);
+    keepLinks[i] = it == fromIndices->links.end() ||
+        from.linkPoses[it->second] != to.linkPoses[i] ||
+        from.linkVelocities[it->second] != to.linkVelocities[i] ||
+        from.linkAccelerations[it->second] != to.linkAccelerations[i] ||
+        from.linkWrenches[it->second] != to.linkWrenches[i];
+    if (keepLinks[i])
+      keepModels[to.linkModels[i]] = true;
+  }
+
+  std::vector<bool> keepJoints(to.jointNames.size());
+  for (uint64_t i = 0; i < to.jointNames.size(); ++i)
+  {
+    auto it = fromIndices->joints.find(toNames[to.jointModels[i]] +
+        kSdfScopeDelimiter + to.jointNames[i]);
+    keepJoints[i] = it == fromIndices->joints.end() ||
+        !jointAnglesEqual(from.jointAngles, from.jointAxes,
+            from.jointAngleOffsets, it->second,
+            to.jointAngles, to.jointAxes, to.jointAngleOffsets, i);
+    if (keepJoints[i])
+      keepModels[to.jointModels[i]] = true;
+  }
+
+  // The parents of the kept models are kept to scope them. Nested models
+  // come after their parents, so a reverse pass reaches all the ancestors.
+  for (uint64_t i = to.modelNames.size(); i-- > 0;)
+  {
+    if (keepModels[i] && to.modelParents[i] != kNoParent)
+      keepModels[to.modelParents[i]] = true;
+  }
+
+  std::vector<uint64_t> outIndices(to.modelNames.size(), kNoParent);
+  for (uint64_t i = 0; i < to.modelNames.size(); ++i)
+  {
+    if (!keepModels[i])
+      continue;
+    const uint64_t parent = to.modelParents[i];
+    outIndices[i] = out.PushModel(to.modelNames[i],
+        parent == kNoParent ? kNoParent : outIndices[parent]);
+    out.modelPoses.back() = to.modelPoses[i];
+    out.modelScales.back() = to.modelScales[i];
+  }
+
+  for (uint64_t i = 0; i < to.linkNames.size(); ++i)
+  {
+    if (!keepLinks[i])
+      continue;
+    out.PushLink(to.linkNames[i], outIndices[to.linkModels[i]]);
+    out.linkPoses.back() = to.linkPoses[i];
+    out.linkVelocities.back() = to.linkVelocities[i];
+    out.linkAccelerations.back() = to.linkAccelerations[i];
+    out.linkWrenches.back() = to.linkWrenches[i];
+  }
+
+  for (uint64_t i = 0; i < to.jointNames.size(); ++i)
+  {
+    if (!keepJoints[i])
+      continue;
+    out.jointModels.push_back(outIndices[to.jointModels[i]]);
+    out.jointNames.push_back(to.jointNames[i]);
+    out.jointAngles.insert(out.jointAngles.end(),
+        to.jointAngles.begin() + to.jointAngleOffsets[i],
+        to.jointAngles.begin() + to.jointAngleOffsets[i + 1]);
+    out.jointAxes.insert(out.jointAxes.end(),
+        to.jointAxes.begin() + to.jointAngleOffsets[i],
+        to.jointAxes.begin() + to.jointAngleOffsets[i + 1]);
+    out.jointAngleOffsets.push_back(out.jointAngles.size());
+  }
+
+  // Entities that are not in the new state are deleted. Only the top-most
+  // deleted model is named, its nested entities are deleted with it.
+  const std::vector<std::string> fromNames = from.ScopedModelNames();
+  for (uint64_t i = 0; i < from.modelNames.size(); ++i)
+  {
+    const uint64_t parent = from.modelParents[i];
+    if (toIndices->models.count(fromNames[i]) == 0 &&
+        (parent == kNoParent || toIndices->models.count(fromNames[parent])))
+    {
+      out.deletions.push_back(fromNames[i]);
+    }
+  }
+
+  for (uint64_t i = 0; i < from.linkNames.size(); ++i)
+  {
+    const std::string &modelName = fromNames[from.linkModels[i]];
+    const std::string name =
+        modelName + kSdfScopeDelimiter + from.linkNames[i];
+    if (toIndices->models.count(modelName) && !toIndices->links.count(name))
+      out.deletions.push_back(name);
+  }
+
+  for (uint64_t i = 0; i < from.jointNames.size(); ++i)
+  {
+    const std::string &modelName = fromNames[from.jointModels[i]];
+    const std::string name =
+        modelName + kSdfScopeDelimiter + from.jointNames[i];
+    if (toIndices->models.count(modelName) && !toIndices->joints.count(name))
+      out.deletions.push_back(name);
+  }
+
+  return diff;
+}
+
+/////////////////////////////////////////////////
+void WorldState::ApplyDiff(const WorldState &_diff)
+{
+  const Implementation &diff = *_diff.dataPtr;
+  Implementation &state = *this->dataPtr;
+  state.worldName = diff.worldName;
+  state.simTime = diff.simTime;
+  state.wallTime = diff.wallTime;
+  state.realTime = diff.realTime;
+  state.iterations = diff.iterations;
+  state.insertions = diff.insertions;
+  state.deletions = diff.deletions;
+
+  if (!diff.deletions.empty())
+  {
+    const auto indices = state.Indices();
+    std::vector<bool> models(state.modelNames.size());
+    std::vector<bool> links(state.linkNames.size());
+    std::vector<bool> joints(state.jointNames.size());
+    for (const std::string &name : diff.deletions)
+    {
+      if (auto it = indices->models.find(name); it != indices->models.end())
+        models[it->second] = true;
+      else if (it = indices->links.find(name); it != indices->links.end())
+        links[it->second] = true;
+      else if (it = indices->joints.find(name); it != indices->joints.end())
+        joints[it->second] = true;
+    }
+    state.RemoveEntities(models, links, joints);
+  }
+
+  // The maps are held while entities are appended, since new entities are
+  // only looked up after their models, which are new as well
+  const auto indices = state.Indices();
+  const std::vector<std::string> diffNames = diff.ScopedModelNames();
+  std::vector<uint64_t> stateIndices(diff.modelNames.size());
+  for (uint64_t i = 0; i < diff.modelNames.size(); ++i)
+  {
+    auto it = indices->models.find(diffNames[i]);
+    const uint64_t parent = diff.modelParents[i];
+    const uint64_t model = it != indices->models.end() ? it->second :
+        state.PushModel(diff.modelNames[i],
+            parent == kNoParent ? kNoParent : stateIndices[parent]);
+    state.modelPoses[model] = diff.modelPoses[i];
+    state.modelScales[model] = diff.modelScales[i];
+    stateIndices[i] = model;
+  }
+
+  for (uint64_t i = 0; i < diff.linkNames.size(); ++i)
+  {
+    auto it = indices->links.find(diffNames[diff.linkModels[i]] +
+        kSdfScopeDelimiter + diff.linkNames[i]);
+    const uint64_t link = it != indices->links.end() ? it->second :
+        state.PushLink(diff.linkNames[i], stateIndices[diff.linkModels[i]]);
+    state.linkPoses[link] = diff.linkPoses[i];
+    state.linkVelocities[link] = diff.linkVelocities[i];
+    state.linkAccelerations[link] = diff.linkAccelerations[i];
+    state.linkWrenches[link] = diff.linkWrenches[i];
+  }
+
+  for (uint64_t i = 0; i < diff.jointNames.size(); ++i)
+  {
+    auto it = indices->joints.find(diffNames[diff.jointModels[i]] +
+        kSdfScopeDelimiter + diff.jointNames[i]);
+    uint64_t joint = 0;
+    if (it != indices->joints.end())
+    {
+      joint = it->second;
+    }
+    else
+    {
+      joint = state.jointNames.size();
+      state.jointModels.push_back(stateIndices[diff.jointModels[i]]);
+      state.jointNames.push_back(diff.jointNames[i]);
+      state.jointAngleOffsets.push_back(state.jointAngles.size());
+    }
+    state.SetJointAngles(joint, diff, i);
+  }
+
+  state.ClearIndices();
+}
+
+/////////////////////////////////////////////////
+sdf::ElementPtr WorldState::Element() const
+{
+  return this->dataPtr->sdf;
+}
+
+/////////////////////////////////////////////////
+sdf::ElementPtr WorldState::ToElement() const
+{
+  sdf::ElementPtr elem(new sdf::Element);
+  sdf::initFile("state.sdf", elem);
+
+  elem->GetAttribute("world_name")->Set(this->WorldName());
+  elem->GetElement("sim_time")->Set(this->SimTime());
+  elem->GetElement("wall_time")->Set(this->WallTime());
+  elem->GetElement("real_time")->Set(this->RealTime());
+  elem->GetElement("iterations")->Set<unsigned int>(
+      static_cast<unsigned int>(this->Iterations()));
+
+  if (this->dataPtr->insertions)
+    elem->InsertElement(this->dataPtr->insertions->Clone(), true);
+
+  if (!this->dataPtr->deletions.empty())
+  {
+    sdf::ElementPtr deletionsElem = elem->GetElement("deletions");
+    for (const std::string &deletion : this->dataPtr->deletions)
+      deletionsElem->AddElement("name")->Set(deletion);
+  }
+
+  // Parents come before their nested models, so the element of a parent
+  // always exists when a nested model is added to it
+  std::vector<sdf::ElementPtr> modelElems;
+  modelElems.reserve(this->dataPtr->modelNames.size());
+  for (uint64_t i = 0; i < this->dataPtr->modelNames.size(); ++i)
+  {
+    const uint64_t parent = this->dataPtr->modelParents[i];
+    sdf::ElementPtr modelElem = (parent == kNoParent ? elem :
+        modelElems[parent])->AddElement("model");
+    modelElem->GetAttribute("name")->Set(this->dataPtr->modelNames[i]);
+    modelElem->GetElement("pose")->Set(this->dataPtr->modelPoses[i]);
+    modelElem->GetElement("scale")->Set(this->dataPtr->modelScales[i]);
+    modelElems.push_back(modelElem);
+  }
+
+  for (uint64_t i = 0; i < this->dataPtr->jointNames.size(); ++i)
+  {
+    sdf::ElementPtr jointElem =
+        modelElems[this->dataPtr->jointModels[i]]->AddElement("joint");
+    jointElem->GetAttribute("name")->Set(this->dataPtr->jointNames[i]);
+    for (uint64_t j = this->dataPtr->jointAngleOffsets[i];
+         j < this->dataPtr->jointAngleOffsets[i + 1]; ++j)
+    {
+      sdf::ElementPtr angleElem = jointElem->AddElement("angle");
+      angleElem->GetAttribute("axis")->Set(this->dataPtr->jointAxes[j]);
+      angleElem->Set(this->dataPtr->jointAngles[j]);
+    }
+  }
+
+  for (uint64_t i = 0; i < this->dataPtr->linkNames.size(); ++i)
+  {
+    sdf::ElementPtr linkElem =
+        modelElems[this->dataPtr->linkModels[i]]->AddElement("link");
+    linkElem->GetAttribute("name")->Set(this->dataPtr->linkNames[i]);
+    linkElem->GetElement("velocity")->Set(this->dataPtr->linkVelocities[i]);
+    linkElem->GetElement("acceleration")->Set(
+        this->dataPtr->linkAccelerations[i]);
+    linkElem->GetElement("wrench")->Set(this->dataPtr->linkWrenches[i]);
+    linkElem->GetElement("pose")->Set(this->dataPtr->linkPoses[i]);
+  }
+
+  return elem;
+}
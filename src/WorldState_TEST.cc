@@ -0,0 +1,277 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "sdf/Element.hh"
+#include "sdf/WorldState.hh"
+#include "sdf/parser.hh"
+
+/////////////////////////////////////////////////
+TEST(DOMWorldState, Construction)
+{
+  sdf::WorldState state;
+  EXPECT_EQ(nullptr, state.Element());
+  EXPECT_EQ("__default__", state.WorldName());
+  EXPECT_EQ(sdf::Time(), state.SimTime());
+  EXPECT_EQ(0u, state.Iterations());
+  EXPECT_EQ(nullptr, state.Insertions());
+  EXPECT_TRUE(state.Deletions().empty());
+  EXPECT_EQ(0u, state.ModelCount());
+  EXPECT_EQ(0u, state.LinkCount());
+  EXPECT_EQ(0u, state.JointCount());
+  EXPECT_EQ(1u, state.JointAngleOffsets().size());
+
+  sdf::Errors errors = state.Load(nullptr);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_MISSING, errors[0].Code());
+
+  sdf::ElementPtr elem(new sdf::Element);
+  elem->SetName("world");
+  errors = state.Load(elem);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_INCORRECT_TYPE, errors[0].Code());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMWorldState, AddEntities)
+{
+  sdf::WorldState state;
+  auto robot = state.AddModel("robot");
+  ASSERT_TRUE(robot.has_value());
+  auto arm = state.AddModel("arm", *robot);
+  ASSERT_TRUE(arm.has_value());
+  EXPECT_FALSE(state.AddModel("orphan", 5u).has_value());
+  EXPECT_EQ(sdf::WorldState::kNoParent, state.ModelParents()[*robot]);
+  EXPECT_EQ(*robot, state.ModelParents()[*arm]);
+  EXPECT_EQ(ignition::math::Vector3d::One, state.ModelScales()[*arm]);
+
+  auto link = state.AddLink("hand", *arm);
+  ASSERT_TRUE(link.has_value());
+  EXPECT_FALSE(state.AddLink("hand", 5u).has_value());
+  auto joint = state.AddJoint("wrist", *arm, 2);
+  ASSERT_TRUE(joint.has_value());
+  EXPECT_EQ(2u, state.JointAngles().size());
+  EXPECT_EQ(1u, state.JointAxes()[1]);
+
+  // Scoped names are looked up, and the lookup follows later additions
+  EXPECT_EQ(arm, state.ModelIndex("robot::arm"));
+  EXPECT_EQ(link, state.LinkIndex("robot::arm::hand"));
+  EXPECT_EQ(joint, state.JointIndex("robot::arm::wrist"));
+  EXPECT_FALSE(state.LinkIndex("hand").has_value());
+  EXPECT_FALSE(state.ModelIndex("other").has_value());
+  auto other = state.AddModel("other");
+  EXPECT_EQ(other, state.ModelIndex("other"));
+
+  // States are updated in place
+  state.LinkPoses()[*link] = {1, 2, 3, 0, 0, 0};
+  state.JointAngles()[1] = 0.5;
+  const sdf::WorldState copy = state;
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0),
+            copy.LinkPoses()[*link]);
+  EXPECT_DOUBLE_EQ(0.5, copy.JointAngles()[1]);
+
+  state.ClearEntities();
+  EXPECT_EQ(0u, state.ModelCount());
+  EXPECT_FALSE(state.ModelIndex("robot").has_value());
+  EXPECT_EQ(arm, copy.ModelIndex("robot::arm"));
+}
+
+/////////////////////////////////////////////////
+TEST(DOMWorldState, LoadAndToElement)
+{
+  const std::string sdf = R"(
+<sdf version='1.9'>
+  <state world_name='default'>
+    <sim_time>12 500</sim_time>
+    <wall_time>100 0</wall_time>
+    <real_time>13 0</real_time>
+    <iterations>12000</iterations>
+    <deletions>
+      <name>box</name>
+      <name>sphere</name>
+    </deletions>
+    <model name='robot'>
+      <pose>1 0 0 0 0 0</pose>
+      <joint name='base_joint'>
+        <angle axis='0'>0.25</angle>
+      </joint>
+      <link name='base'>
+        <pose>1 0 0.5 0 0 0</pose>
+        <velocity>0.1 0 0 0 0 0.2</velocity>
+        <acceleration>0 0 -9.8 0 0 0</acceleration>
+      </link>
+      <model name='arm'>
+        <scale>2 2 2</scale>
+        <joint name='elbow'>
+          <angle axis='0'>0.5</angle>
+          <angle axis='1'>-0.5</angle>
+        </joint>
+        <link name='hand'>
+          <wrench>0 0 1 0 0 0</wrench>
+        </link>
+      </model>
+    </model>
+    <model name='table'/>
+  </state>
+</sdf>)";
+
+  sdf::ElementPtr elem(new sdf::Element);
+  sdf::initFile("state.sdf", elem);
+  ASSERT_TRUE(sdf::readString(sdf, elem));
+
+  sdf::WorldState state;
+  sdf::Errors errors = state.Load(elem);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(elem, state.Element());
+  EXPECT_EQ("default", state.WorldName());
+  EXPECT_EQ(sdf::Time(12, 500), state.SimTime());
+  EXPECT_EQ(sdf::Time(100, 0), state.WallTime());
+  EXPECT_EQ(sdf::Time(13, 0), state.RealTime());
+  EXPECT_EQ(12000u, state.Iterations());
+  ASSERT_EQ(2u, state.Deletions().size());
+  EXPECT_EQ("sphere", state.Deletions()[1]);
+
+  // Models are stored in depth-first order
+  ASSERT_EQ(3u, state.ModelCount());
+  EXPECT_EQ("robot", state.ModelNames()[0]);
+  EXPECT_EQ("arm", state.ModelNames()[1]);
+  EXPECT_EQ("table", state.ModelNames()[2]);
+  EXPECT_EQ(0u, state.ModelParents()[1]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 0, 0, 0, 0, 0), state.ModelPoses()[0]);
+  EXPECT_EQ(ignition::math::Vector3d(2, 2, 2), state.ModelScales()[1]);
+  EXPECT_EQ(ignition::math::Vector3d::One, state.ModelScales()[2]);
+
+  ASSERT_EQ(2u, state.LinkCount());
+  const auto base = state.LinkIndex("robot::base");
+  ASSERT_TRUE(base.has_value());
+  EXPECT_EQ(ignition::math::Pose3d(1, 0, 0.5, 0, 0, 0),
+            state.LinkPoses()[*base]);
+  EXPECT_EQ(ignition::math::Pose3d(0.1, 0, 0, 0, 0, 0.2),
+            state.LinkVelocities()[*base]);
+  EXPECT_EQ(ignition::math::Pose3d(0, 0, -9.8, 0, 0, 0),
+            state.LinkAccelerations()[*base]);
+  const auto hand = state.LinkIndex("robot::arm::hand");
+  ASSERT_TRUE(hand.has_value());
+  EXPECT_EQ(1u, state.LinkModels()[*hand]);
+  EXPECT_EQ(ignition::math::Pose3d(0, 0, 1, 0, 0, 0),
+            state.LinkWrenches()[*hand]);
+
+  ASSERT_EQ(2u, state.JointCount());
+  const auto elbow = state.JointIndex("robot::arm::elbow");
+  ASSERT_TRUE(elbow.has_value());
+  const uint64_t begin = state.JointAngleOffsets()[*elbow];
+  ASSERT_EQ(2u, state.JointAngleOffsets()[*elbow + 1] - begin);
+  EXPECT_DOUBLE_EQ(-0.5, state.JointAngles()[begin + 1]);
+  EXPECT_EQ(1u, state.JointAxes()[begin + 1]);
+
+  // Round trip through ToElement
+  sdf::WorldState state2;
+  errors = state2.Load(state.ToElement());
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(state.WorldName(), state2.WorldName());
+  EXPECT_EQ(state.SimTime(), state2.SimTime());
+  EXPECT_EQ(state.Iterations(), state2.Iterations());
+  EXPECT_EQ(state.Deletions(), state2.Deletions());
+  EXPECT_EQ(state.ModelNames(), state2.ModelNames());
+  EXPECT_EQ(state.ModelParents(), state2.ModelParents());
+  EXPECT_EQ(state.ModelPoses(), state2.ModelPoses());
+  EXPECT_EQ(state.ModelScales(), state2.ModelScales());
+  EXPECT_EQ(state.LinkModels(), state2.LinkModels());
+  EXPECT_EQ(state.LinkNames(), state2.LinkNames());
+  EXPECT_EQ(state.LinkVelocities(), state2.LinkVelocities());
+  EXPECT_EQ(state.LinkWrenches(), state2.LinkWrenches());
+  EXPECT_EQ(state.JointAngleOffsets(), state2.JointAngleOffsets());
+  EXPECT_EQ(state.JointAngles(), state2.JointAngles());
+  EXPECT_EQ(state.JointAxes(), state2.JointAxes());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMWorldState, Diff)
+{
+  sdf::WorldState from;
+  const uint64_t ground = *from.AddModel("ground");
+  from.AddLink("plane", ground);
+  const uint64_t robot = *from.AddModel("robot");
+  const uint64_t arm = *from.AddModel("arm", robot);
+  from.AddLink("hand", arm);
+  from.AddLink("base", robot);
+  from.AddJoint("elbow", arm, 2);
+  const uint64_t crate = *from.AddModel("crate");
+  from.AddLink("body", crate);
+  from.SetIterations(10);
+
+  // Only the hand and the elbow move, a box is added and the crate is
+  // removed
+  sdf::WorldState to = from;
+  to.SetIterations(11);
+  to.ClearEntities();
+  to.AddLink("plane", *to.AddModel("ground"));
+  const uint64_t toRobot = *to.AddModel("robot");
+  const uint64_t toArm = *to.AddModel("arm", toRobot);
+  to.LinkPoses()[*to.AddLink("hand", toArm)] = {0, 0, 1, 0, 0, 0};
+  to.AddLink("base", toRobot);
+  to.AddJoint("elbow", toArm, 2);
+  to.JointAngles()[1] = 0.5;
+  to.AddModel("box");
+
+  const sdf::WorldState diff = sdf::WorldState::Diff(from, to);
+  EXPECT_EQ(11u, diff.Iterations());
+  ASSERT_EQ(3u, diff.ModelCount());
+  EXPECT_TRUE(diff.ModelIndex("robot::arm").has_value());
+  EXPECT_TRUE(diff.ModelIndex("box").has_value());
+  EXPECT_FALSE(diff.ModelIndex("ground").has_value());
+  ASSERT_EQ(1u, diff.LinkCount());
+  EXPECT_EQ("hand", diff.LinkNames()[0]);
+  ASSERT_EQ(1u, diff.JointCount());
+  ASSERT_EQ(1u, diff.Deletions().size());
+  EXPECT_EQ("crate", diff.Deletions()[0]);
+
+  // The difference survives a round trip through ToElement
+  sdf::WorldState loadedDiff;
+  EXPECT_TRUE(loadedDiff.Load(diff.ToElement()).empty());
+  EXPECT_EQ(diff.ModelNames(), loadedDiff.ModelNames());
+  EXPECT_EQ(diff.Deletions(), loadedDiff.Deletions());
+
+  // Applying the difference to the previous state gives the next state
+  sdf::WorldState applied = from;
+  applied.ApplyDiff(loadedDiff);
+  EXPECT_EQ(11u, applied.Iterations());
+  ASSERT_EQ(to.ModelCount(), applied.ModelCount());
+  EXPECT_FALSE(applied.ModelIndex("crate").has_value());
+  EXPECT_FALSE(applied.LinkIndex("crate::body").has_value());
+  for (const std::string &name : to.ModelNames())
+    EXPECT_EQ(1, std::count(applied.ModelNames().begin(),
+                            applied.ModelNames().end(), name));
+  const auto appliedHand = applied.LinkIndex("robot::arm::hand");
+  ASSERT_TRUE(appliedHand.has_value());
+  EXPECT_EQ(ignition::math::Pose3d(0, 0, 1, 0, 0, 0),
+            applied.LinkPoses()[*appliedHand]);
+  EXPECT_EQ(to.JointAngles(), applied.JointAngles());
+  EXPECT_EQ(3u, applied.LinkCount());
+
+  // Nothing changed, so the difference is empty
+  const sdf::WorldState empty = sdf::WorldState::Diff(applied, applied);
+  EXPECT_EQ(0u, empty.ModelCount());
+  EXPECT_EQ(0u, empty.LinkCount());
+  EXPECT_EQ(0u, empty.JointCount());
+}
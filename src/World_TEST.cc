@@ -15,14 +15,24 @@
  *
 */
 
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <ignition/math/Color.hh>
+#include <ignition/math/Helpers.hh>
 #include <ignition/math/Vector3.hh>
+#include "sdf/Collision.hh"
 #include "sdf/Frame.hh"
 #include "sdf/Light.hh"
+#include "sdf/Link.hh"
 #include "sdf/Actor.hh"
 #include "sdf/Model.hh"
 #include "sdf/Physics.hh"
+#include "sdf/Root.hh"
+#include "sdf/Surface.hh"
 #include "sdf/World.hh"
 
 /////////////////////////////////////////////////
@@ -375,6 +385,58 @@ TEST(DOMWorld, AddModel)
   const sdf::Model *modelFromWorld = world.ModelByIndex(0);
   ASSERT_NE(nullptr, modelFromWorld);
   EXPECT_EQ(modelFromWorld->Name(), model.Name());
+
+  sdf::Model model2;
+  model2.SetName("model2");
+  EXPECT_TRUE(world.AddModel(model2));
+  EXPECT_FALSE(world.RemoveModelByName("missing"));
+  EXPECT_TRUE(world.RemoveModelByName("model1"));
+  EXPECT_EQ(1u, world.ModelCount());
+  EXPECT_EQ(nullptr, world.ModelByName("model1"));
+  ASSERT_NE(nullptr, world.ModelByName("model2"));
+  EXPECT_EQ(world.ModelByIndex(0), world.ModelByName("model2"));
+}
+
+/////////////////////////////////////////////////
+TEST(DOMWorld, AddModelMove)
+{
+  // Moving DOM objects, including when a vector of them grows, only moves
+  // their private data pointer.
+  static_assert(std::is_nothrow_move_constructible_v<sdf::World>);
+  static_assert(std::is_nothrow_move_constructible_v<sdf::Model>);
+  static_assert(std::is_nothrow_move_constructible_v<sdf::Link>);
+  static_assert(std::is_nothrow_move_constructible_v<sdf::Frame>);
+  static_assert(std::is_nothrow_move_assignable_v<sdf::Model>);
+
+  sdf::World world;
+  for (int i = 0; i < 100; ++i)
+  {
+    sdf::Link link;
+    link.SetName("link");
+    sdf::Model model;
+    model.SetName("model" + std::to_string(i));
+    EXPECT_TRUE(model.AddLink(std::move(link)));
+    EXPECT_TRUE(world.AddModel(std::move(model)));
+  }
+  EXPECT_EQ(100u, world.ModelCount());
+
+  const sdf::Model *model = world.ModelByName("model42");
+  ASSERT_NE(nullptr, model);
+  EXPECT_EQ(world.ModelByIndex(42), model);
+  ASSERT_EQ(1u, model->LinkCount());
+  EXPECT_EQ("link", model->LinkByIndex(0)->Name());
+
+  // A model with a duplicate name is not moved.
+  sdf::Model duplicate;
+  duplicate.SetName("model42");
+  EXPECT_FALSE(world.AddModel(std::move(duplicate)));
+  EXPECT_EQ(100u, world.ModelCount());
+  EXPECT_EQ("model42", duplicate.Name());
+
+  sdf::Frame frame;
+  frame.SetName("frame");
+  EXPECT_TRUE(world.AddFrame(std::move(frame)));
+  EXPECT_NE(nullptr, world.FrameByName("frame"));
 }
 
 /////////////////////////////////////////////////
@@ -668,6 +730,195 @@ TEST(DOMWorld, MutableByName)
   EXPECT_TRUE(world.FrameByName("frame2"));
 }
 
+/////////////////////////////////////////////////
+TEST(DOMWorld, ScopedNameLookup)
+{
+  sdf::World world;
+  for (int i = 0; i < 100; ++i)
+  {
+    sdf::Model model;
+    model.SetName("model" + std::to_string(i));
+    sdf::Frame frame;
+    frame.SetName("frame");
+    EXPECT_TRUE(model.AddFrame(frame));
+    EXPECT_TRUE(world.AddModel(model));
+  }
+  sdf::Frame frame;
+  frame.SetName("world_frame");
+  EXPECT_TRUE(world.AddFrame(frame));
+
+  ASSERT_NE(nullptr, world.ModelByName("model42"));
+  EXPECT_EQ(world.ModelByIndex(42), world.ModelByName("model42"));
+  EXPECT_EQ(world.ModelByIndex(99)->FrameByIndex(0),
+            world.FrameByName("model99::frame"));
+  EXPECT_EQ(world.FrameByIndex(0), world.FrameByName("world_frame"));
+  EXPECT_EQ(nullptr, world.ModelByName("model100"));
+  EXPECT_EQ(nullptr, world.FrameByName("model100::frame"));
+
+  world.ModelByName("model7")->SetName("renamed");
+  EXPECT_EQ(nullptr, world.ModelByName("model7"));
+  EXPECT_EQ(world.ModelByIndex(7), world.ModelByName("renamed"));
+
+  world.ClearModels();
+  EXPECT_EQ(nullptr, world.ModelByName("model42"));
+  world.ClearFrames();
+  EXPECT_EQ(nullptr, world.FrameByName("world_frame"));
+}
+
+/////////////////////////////////////////////////
+TEST(DOMWorld, CollisionFilters)
+{
+  auto makeCollision = [](const std::string &_name, uint16_t _collide,
+                          uint16_t _category)
+  {
+    sdf::Contact contact;
+    contact.SetCollideBitmask(_collide);
+    contact.SetCategoryBitmask(_category);
+    sdf::Surface surface;
+    surface.SetContact(contact);
+    sdf::Collision collision;
+    collision.SetName(_name);
+    collision.SetSurface(surface);
+    return collision;
+  };
+
+  sdf::Link link;
+  link.SetName("link");
+  EXPECT_TRUE(link.AddCollision(makeCollision("a", 0x01, 0x01)));
+  EXPECT_TRUE(link.AddCollision(makeCollision("b", 0x02, 0x02)));
+
+  sdf::Link nestedLink;
+  nestedLink.SetName("link");
+  EXPECT_TRUE(nestedLink.AddCollision(makeCollision("c", 0x01, 0x01)));
+  EXPECT_TRUE(nestedLink.AddCollision(makeCollision("d", 0x02, 0x01)));
+
+  sdf::Model nested;
+  nested.SetName("nested");
+  EXPECT_TRUE(nested.AddLink(nestedLink));
+
+  sdf::Model model;
+  model.SetName("model");
+  EXPECT_TRUE(model.AddLink(link));
+  EXPECT_TRUE(model.AddModel(nested));
+
+  sdf::World world;
+  EXPECT_EQ(0u, world.CollisionFilters().names.size());
+  EXPECT_TRUE(world.AddModel(model));
+
+  const sdf::CollisionFilterTable table = world.CollisionFilters();
+  ASSERT_EQ(4u, table.names.size());
+  EXPECT_EQ("model::link::a", table.names[0]);
+  EXPECT_EQ("model::link::b", table.names[1]);
+  EXPECT_EQ("model::nested::link::c", table.names[2]);
+  EXPECT_EQ("model::nested::link::d", table.names[3]);
+  EXPECT_EQ(0x02, table.collideBitmasks[3]);
+  EXPECT_EQ(0x01, table.categoryBitmasks[3]);
+
+  // a and c have the same bitmasks, so they share a group.
+  ASSERT_EQ(4u, table.groupIds.size());
+  EXPECT_EQ(3u, table.groupCount);
+  EXPECT_EQ(table.groupIds[0], table.groupIds[2]);
+  EXPECT_NE(table.groupIds[0], table.groupIds[1]);
+  EXPECT_NE(table.groupIds[1], table.groupIds[3]);
+
+  ASSERT_EQ(9u, table.groupCollides.size());
+  auto collides = [&](std::size_t _i, std::size_t _j)
+  {
+    return table.groupCollides[
+        table.groupIds[_i] * table.groupCount + table.groupIds[_j]] != 0;
+  };
+  EXPECT_TRUE(collides(0, 2));
+  EXPECT_FALSE(collides(0, 1));
+  EXPECT_TRUE(collides(0, 3));
+  EXPECT_TRUE(collides(3, 0));
+  EXPECT_TRUE(collides(1, 3));
+}
+
+/////////////////////////////////////////////////
+TEST(DOMWorld, SpatialQueries)
+{
+  const std::string sdf = R"(
+<sdf version="1.9">
+  <world name="default">
+    <model name="near">
+      <pose>1 0 0 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <pose>0 0 1 0 0 0</pose>
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="far">
+      <pose>100 0 0 0 0 0</pose>
+      <link name="link">
+        <visual name="visual">
+          <geometry><sphere><radius>2</radius></sphere></geometry>
+        </visual>
+      </link>
+    </model>
+    <model name="mesh">
+      <pose>-100 0 0 0 0 0</pose>
+      <link name="link">
+        <visual name="visual">
+          <geometry><mesh><uri>mesh.dae</uri></mesh></geometry>
+        </visual>
+      </link>
+    </model>
+    <light name="point" type="point">
+      <pose>0 50 0 0 0 0</pose>
+      <attenuation><range>5</range></attenuation>
+    </light>
+    <light name="sun" type="directional"/>
+  </world>
+</sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf);
+  ASSERT_TRUE(errors.empty()) << errors;
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+
+  // Models with meshes have no bounds, so they are always found.
+  std::vector<const sdf::Model *> models =
+      world->ModelsInRadius(ignition::math::Vector3d::Zero, 1.0);
+  ASSERT_EQ(2u, models.size());
+  EXPECT_EQ("near", models[0]->Name());
+  EXPECT_EQ("mesh", models[1]->Name());
+
+  models = world->ModelsInRadius(ignition::math::Vector3d(97, 0, 0), 1.5);
+  ASSERT_EQ(2u, models.size());
+  EXPECT_EQ("far", models[0]->Name());
+
+  models = world->ModelsInBox(ignition::math::AxisAlignedBox(
+      ignition::math::Vector3d(0, -1, 1.5),
+      ignition::math::Vector3d(2, 1, 3)));
+  ASSERT_EQ(2u, models.size());
+  EXPECT_EQ("near", models[0]->Name());
+
+  std::vector<const sdf::Light *> lights =
+      world->LightsInRadius(ignition::math::Vector3d::Zero, 1.0);
+  ASSERT_EQ(1u, lights.size());
+  EXPECT_EQ("sun", lights[0]->Name());
+
+  lights = world->LightsInRadius(ignition::math::Vector3d(0, 44, 0), 2.0);
+  ASSERT_EQ(2u, lights.size());
+  EXPECT_EQ("point", lights[0]->Name());
+
+  // Models added after the index is built are added to it. This one has no
+  // pose graph, so it has no bounds.
+  sdf::World copy = *world;
+  EXPECT_EQ(2u, copy.ModelsInRadius(ignition::math::Vector3d::Zero,
+                                    1.0).size());
+  sdf::Model model;
+  model.SetName("added");
+  EXPECT_TRUE(copy.AddModel(model));
+  models = copy.ModelsInRadius(ignition::math::Vector3d(0, 0, 500), 1.0);
+  ASSERT_EQ(2u, models.size());
+  EXPECT_EQ("mesh", models[0]->Name());
+  EXPECT_EQ("added", models[1]->Name());
+}
+
 /////////////////////////////////////////////////
 TEST(DOMWorld, Plugins)
 {
@@ -691,3 +942,45 @@ TEST(DOMWorld, Plugins)
   world.ClearPlugins();
   EXPECT_TRUE(world.Plugins().empty());
 }
+
+/////////////////////////////////////////////////
+TEST(DOMWorld, GeodeticConversions)
+{
+  sdf::World world;
+  world.SetName("default");
+  std::vector<ignition::math::Vector3d> geodetic;
+  sdf::Errors errors = world.LocalToGeodetic({{1, 2, 3}}, geodetic);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_MISSING, errors[0].Code());
+  EXPECT_TRUE(geodetic.empty());
+
+  const ignition::math::SphericalCoordinates coordinates(
+      ignition::math::SphericalCoordinates::EARTH_WGS84,
+      IGN_DTOR(-22.9), IGN_DTOR(-43.2), 120.0, IGN_DTOR(30.0));
+  world.SetSphericalCoordinates(coordinates);
+
+  const std::vector<ignition::math::Vector3d> positions = {
+      {0, 0, 0}, {1, 2, 3}, {-150.5, 2000, -12}, {10000, -30000, 500}};
+  errors = world.LocalToGeodetic(positions, geodetic);
+  EXPECT_TRUE(errors.empty()) << errors;
+  ASSERT_EQ(positions.size(), geodetic.size());
+
+  std::vector<ignition::math::Vector3d> local;
+  errors = world.GeodeticToLocal(geodetic, local);
+  EXPECT_TRUE(errors.empty()) << errors;
+  ASSERT_EQ(positions.size(), local.size());
+
+  for (std::size_t i = 0; i < positions.size(); ++i)
+  {
+    const ignition::math::Vector3d expected = coordinates.PositionTransform(
+        positions[i], ignition::math::SphericalCoordinates::LOCAL,
+        ignition::math::SphericalCoordinates::SPHERICAL);
+    EXPECT_NEAR(expected.X(), geodetic[i].X(), 1e-9);
+    EXPECT_NEAR(expected.Y(), geodetic[i].Y(), 1e-9);
+    EXPECT_NEAR(expected.Z(), geodetic[i].Z(), 1e-4);
+
+    EXPECT_NEAR(positions[i].X(), local[i].X(), 1e-4);
+    EXPECT_NEAR(positions[i].Y(), local[i].Y(), 1e-4);
+    EXPECT_NEAR(positions[i].Z(), local[i].Z(), 1e-4);
+  }
+}
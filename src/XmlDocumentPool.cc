@@ -0,0 +1,98 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "XmlDocumentPool.hh"
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+
+/////////////////////////////////////////////////
+XmlDocumentPool::Lease::Lease(std::shared_ptr<XmlDocumentPool> _pool,
+    std::unique_ptr<tinyxml2::XMLDocument> _doc)
+  : pool(std::move(_pool)), doc(std::move(_doc))
+{
+}
+
+/////////////////////////////////////////////////
+XmlDocumentPool::Lease::~Lease()
+{
+  if (this->pool && this->doc)
+    this->pool->Release(std::move(this->doc));
+}
+
+/////////////////////////////////////////////////
+tinyxml2::XMLDocument *XmlDocumentPool::Lease::Get() const
+{
+  return this->doc.get();
+}
+
+/////////////////////////////////////////////////
+tinyxml2::XMLDocument *XmlDocumentPool::Lease::operator->() const
+{
+  return this->doc.get();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<XmlDocumentPool> XmlDocumentPool::Of(
+    const ParserConfig &_config)
+{
+  return _config.XmlDocuments();
+}
+
+/////////////////////////////////////////////////
+XmlDocumentPool::Lease XmlDocumentPool::Acquire(const ParserConfig &_config)
+{
+  std::shared_ptr<XmlDocumentPool> pool = Of(_config);
+  if (pool)
+  {
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    if (!pool->documents.empty())
+    {
+      std::unique_ptr<tinyxml2::XMLDocument> doc =
+          std::move(pool->documents.back());
+      pool->documents.pop_back();
+      return Lease(std::move(pool), std::move(doc));
+    }
+  }
+
+  return Lease(std::move(pool), std::make_unique<tinyxml2::XMLDocument>(
+      true, tinyxml2::COLLAPSE_WHITESPACE));
+}
+
+/////////////////////////////////////////////////
+std::size_t XmlDocumentPool::Size() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->documents.size();
+}
+
+/////////////////////////////////////////////////
+void XmlDocumentPool::Release(std::unique_ptr<tinyxml2::XMLDocument> _doc)
+{
+  // Clearing deletes the nodes, but keeps the blocks of the memory pools.
+  _doc->Clear();
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->documents.size() < kMaxSize)
+    this->documents.push_back(std::move(_doc));
+}
+}
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDFORMAT_XMLDOCUMENTPOOL_HH
+#define SDFORMAT_XMLDOCUMENTPOOL_HH
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <tinyxml2.h>
+
+#include "sdf/ParserConfig.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Pool of tinyxml2 documents that are reused between parses. A
+  /// tinyxml2 document keeps the blocks of its memory pools when it is
+  /// cleared, so a reused document parses the next file without allocating
+  /// them again.
+  class XmlDocumentPool
+  {
+    /// \brief A document taken from a pool, which is cleared and given back
+    /// to the pool when this object is destroyed. Documents that are not
+    /// taken from a pool are destroyed instead.
+    public: class Lease
+    {
+      /// \brief Constructor.
+      /// \param[in] _pool The pool the document is given back to, or nullptr.
+      /// \param[in] _doc The document.
+      public: Lease(std::shared_ptr<XmlDocumentPool> _pool,
+                  std::unique_ptr<tinyxml2::XMLDocument> _doc);
+
+      /// \brief Move constructor.
+      public: Lease(Lease &&) = default;
+
+      /// \brief No copy constructor.
+      public: Lease(const Lease &) = delete;
+
+      /// \brief No assignment.
+      public: Lease &operator=(const Lease &) = delete;
+
+      /// \brief Destructor, which gives the document back to the pool.
+      public: ~Lease();
+
+      /// \brief Get the document.
+      /// \return The document.
+      public: tinyxml2::XMLDocument *Get() const;
+
+      /// \brief Access the document.
+      /// \return The document.
+      public: tinyxml2::XMLDocument *operator->() const;
+
+      /// \brief The pool, or nullptr.
+      private: std::shared_ptr<XmlDocumentPool> pool;
+
+      /// \brief The document.
+      private: std::unique_ptr<tinyxml2::XMLDocument> doc;
+    };
+
+    /// \brief Get the pool of XML documents of a parser configuration.
+    /// \param[in] _config Parser configuration.
+    /// \return The pool, or nullptr if XML documents are not reused.
+    public: static std::shared_ptr<XmlDocumentPool> Of(
+                const ParserConfig &_config);
+
+    /// \brief Get a document that collapses white space, as the parser
+    /// expects, from the pool of a configuration.
+    /// \param[in] _config Parser configuration.
+    /// \return A document from the pool, or a new document if XML documents
+    /// are not reused.
+    public: static Lease Acquire(const ParserConfig &_config);
+
+    /// \brief Get the number of documents that are kept for reuse.
+    /// \return Number of idle documents.
+    public: std::size_t Size() const;
+
+    /// \brief Give a document back to the pool.
+    /// \param[in] _doc The document, which is cleared.
+    private: void Release(std::unique_ptr<tinyxml2::XMLDocument> _doc);
+
+    /// \brief Largest number of documents that are kept for reuse. More are
+    /// only used while files include other files on several threads.
+    private: static constexpr std::size_t kMaxSize = 32;
+
+    /// \brief Mutex that protects the documents, since included files may
+    /// be read on several threads.
+    private: mutable std::mutex mutex;
+
+    /// \brief Documents that are kept for reuse.
+    private: std::vector<std::unique_ptr<tinyxml2::XMLDocument>> documents;
+  };
+  }
+}
+#endif
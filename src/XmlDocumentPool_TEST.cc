@@ -0,0 +1,117 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/parser.hh"
+#include "XmlDocumentPool.hh"
+
+/////////////////////////////////////////////////
+TEST(XmlDocumentPool, Acquire)
+{
+  sdf::ParserConfig config;
+  EXPECT_EQ(nullptr, sdf::XmlDocumentPool::Of(config));
+
+  // Without a pool, every document is new.
+  {
+    sdf::XmlDocumentPool::Lease lease =
+        sdf::XmlDocumentPool::Acquire(config);
+    ASSERT_NE(nullptr, lease.Get());
+    EXPECT_EQ(lease.Get(), lease.operator->());
+    EXPECT_EQ(tinyxml2::COLLAPSE_WHITESPACE, lease->WhitespaceMode());
+  }
+
+  config.SetReuseXmlDocuments(true);
+  EXPECT_TRUE(config.ReuseXmlDocuments());
+  std::shared_ptr<sdf::XmlDocumentPool> pool =
+      sdf::XmlDocumentPool::Of(config);
+  ASSERT_NE(nullptr, pool);
+  EXPECT_EQ(0u, pool->Size());
+
+  // Copies of the configuration share the pool.
+  sdf::ParserConfig configCopy = config;
+  EXPECT_EQ(pool, sdf::XmlDocumentPool::Of(configCopy));
+
+  // A document is cleared and reused once its lease ends.
+  tinyxml2::XMLDocument *first = nullptr;
+  {
+    sdf::XmlDocumentPool::Lease lease =
+        sdf::XmlDocumentPool::Acquire(config);
+    first = lease.Get();
+    EXPECT_EQ(tinyxml2::XML_SUCCESS, lease->Parse("<sdf version='1.9'/>"));
+    EXPECT_NE(nullptr, lease->FirstChildElement("sdf"));
+    EXPECT_EQ(0u, pool->Size());
+  }
+  EXPECT_EQ(1u, pool->Size());
+  {
+    sdf::XmlDocumentPool::Lease lease =
+        sdf::XmlDocumentPool::Acquire(configCopy);
+    EXPECT_EQ(first, lease.Get());
+    EXPECT_EQ(nullptr, lease->FirstChildElement());
+    EXPECT_FALSE(lease->Error());
+    EXPECT_EQ(0u, pool->Size());
+
+    // Documents used at the same time are different.
+    sdf::XmlDocumentPool::Lease other = sdf::XmlDocumentPool::Acquire(config);
+    EXPECT_NE(first, other.Get());
+  }
+  EXPECT_EQ(2u, pool->Size());
+
+  // Documents with errors are cleared as well.
+  {
+    sdf::XmlDocumentPool::Lease lease =
+        sdf::XmlDocumentPool::Acquire(config);
+    EXPECT_NE(tinyxml2::XML_SUCCESS, lease->Parse("<sdf"));
+  }
+  {
+    sdf::XmlDocumentPool::Lease lease =
+        sdf::XmlDocumentPool::Acquire(config);
+    EXPECT_FALSE(lease->Error());
+  }
+
+  config.SetReuseXmlDocuments(false);
+  EXPECT_FALSE(config.ReuseXmlDocuments());
+  EXPECT_EQ(nullptr, sdf::XmlDocumentPool::Of(config));
+  EXPECT_EQ(pool, sdf::XmlDocumentPool::Of(configCopy));
+}
+
+/////////////////////////////////////////////////
+TEST(XmlDocumentPool, ReadString)
+{
+  sdf::ParserConfig config;
+  config.SetReuseXmlDocuments(true);
+  std::shared_ptr<sdf::XmlDocumentPool> pool =
+      sdf::XmlDocumentPool::Of(config);
+
+  const std::string sdfString =
+      "<sdf version='1.9'><model name='m'><link name='l'/></model></sdf>";
+  for (int i = 0; i < 3; ++i)
+  {
+    sdf::SDFPtr sdf(new sdf::SDF());
+    sdf::init(sdf, config);
+    sdf::Errors errors;
+    EXPECT_TRUE(sdf::readString(sdfString, config, sdf, errors));
+    EXPECT_TRUE(errors.empty());
+    EXPECT_EQ("m", sdf->Root()->GetElement("model")->Get<std::string>(
+        "name"));
+    EXPECT_EQ(1u, pool->Size());
+  }
+}
@@ -41,18 +41,68 @@ tinyxml2::XMLNode *DeepClone(tinyxml2::XMLDocument *_doc,
     return nullptr;
   }
 
-  for (const tinyxml2::XMLNode *node = _src->FirstChild(); node != nullptr;
-       node = node->NextSibling())
+  // Copy the descendants in a single pre-order traversal instead of
+  // recursing, so that deep documents cannot exhaust the stack. The parent
+  // is always the copy of the parent of node.
+  const tinyxml2::XMLNode *node = _src->FirstChild();
+  tinyxml2::XMLNode *parent = copy;
+  while (node != nullptr)
   {
-    auto *childCopy = DeepClone(_doc, node);
-    if (childCopy == nullptr)
+    tinyxml2::XMLNode *nodeCopy = node->ShallowClone(_doc);
+    if (nodeCopy == nullptr)
     {
       sdferr << "Failed to clone child " << node->Value() << "\n";
+      _doc->DeleteNode(copy);
       return nullptr;
     }
-    copy->InsertEndChild(childCopy);
+    parent->InsertEndChild(nodeCopy);
+
+    if (node->FirstChild() != nullptr)
+    {
+      parent = nodeCopy;
+      node = node->FirstChild();
+      continue;
+    }
+
+    // Go back up to the first ancestor that has a next sibling.
+    while (node != _src && node->NextSibling() == nullptr)
+    {
+      node = node->Parent();
+      parent = parent->Parent();
+    }
+    node = node == _src ? nullptr : node->NextSibling();
+  }
+
+  return copy;
+}
+
+/////////////////////////////////////////////////
+tinyxml2::XMLNode *MoveNode(tinyxml2::XMLNode *_parent,
+                            tinyxml2::XMLNode *_src)
+{
+  if (_parent == nullptr || _src == nullptr)
+  {
+    sdferr << "Pointer to XML node _parent or _src is NULL\n";
+    return nullptr;
   }
 
+  // A node cannot be moved into itself or one of its descendants.
+  for (const tinyxml2::XMLNode *node = _parent; node != nullptr;
+       node = node->Parent())
+  {
+    if (node == _src)
+      return nullptr;
+  }
+
+  // Nodes of the same document are relinked without copying them.
+  if (_src->GetDocument() == _parent->GetDocument())
+    return _parent->InsertEndChild(_src);
+
+  tinyxml2::XMLNode *copy = DeepClone(_parent->GetDocument(), _src);
+  if (copy == nullptr)
+    return nullptr;
+  _parent->InsertEndChild(copy);
+  _src->GetDocument()->DeleteNode(_src);
   return copy;
 }
 
@@ -41,6 +41,21 @@ namespace sdf
   tinyxml2::XMLNode *DeepClone(tinyxml2::XMLDocument *_doc,
                                const tinyxml2::XMLNode *_src);
 
+  /// \brief Move an XML Node and all of its descendants to the end of the
+  /// children of another node.
+  ///
+  /// A node of the same document as _parent is relinked without copying
+  /// it. A node of another document is deep copied into the document of
+  /// _parent, and then deleted from its own document.
+  ///
+  /// \param[in] _parent Node that receives the moved node
+  /// \param[in] _src The node to move
+  /// \returns The moved node under _parent upon success OR
+  ///          nullptr if an error occurs, for example if _parent is _src or
+  ///          one of its descendants.
+  tinyxml2::XMLNode *MoveNode(tinyxml2::XMLNode *_parent,
+                              tinyxml2::XMLNode *_src);
+
   /// \brief Converts the XML Element to a string
   /// \param[in] _elem Element to be converted
   /// \return The string representation
@@ -53,3 +53,60 @@ TEST(XMLUtils, DeepClone)
   auto childB_text = newChildB->ToElement()->GetText();
   EXPECT_STREQ("Hello World", childB_text);
 }
+
+/////////////////////////////////////////////////
+TEST(XMLUtils, DeepCloneSiblings)
+{
+  tinyxml2::XMLDocument oldDoc;
+  tinyxml2::XMLDocument newDoc;
+
+  std::string docXml = R"(<a><b><c>1</c><d/></b><!--note--><e><f/></e></a>)";
+  ASSERT_EQ(tinyxml2::XML_SUCCESS, oldDoc.Parse(docXml.c_str()));
+
+  tinyxml2::XMLNode *newRoot = sdf::DeepClone(&newDoc, oldDoc.FirstChild());
+  ASSERT_NE(nullptr, newRoot);
+  EXPECT_EQ(&newDoc, newRoot->GetDocument());
+  newDoc.InsertEndChild(newRoot);
+
+  tinyxml2::XMLPrinter printer(nullptr, true);
+  newDoc.Print(&printer);
+  EXPECT_EQ(docXml, std::string(printer.CStr()));
+
+  EXPECT_EQ(nullptr, sdf::DeepClone(&newDoc, nullptr));
+}
+
+/////////////////////////////////////////////////
+TEST(XMLUtils, MoveNode)
+{
+  tinyxml2::XMLDocument doc;
+  ASSERT_EQ(tinyxml2::XML_SUCCESS,
+            doc.Parse("<a><b attr='1'><c/></b><d/></a>"));
+  tinyxml2::XMLElement *a = doc.FirstChildElement("a");
+  tinyxml2::XMLElement *b = a->FirstChildElement("b");
+  tinyxml2::XMLElement *d = a->FirstChildElement("d");
+
+  // A node of the same document is relinked, not copied.
+  EXPECT_EQ(b, sdf::MoveNode(d, b));
+  EXPECT_EQ(nullptr, a->FirstChildElement("b"));
+  EXPECT_EQ(b, d->FirstChildElement("b"));
+  EXPECT_NE(nullptr, b->FirstChildElement("c"));
+
+  // A node cannot be moved into itself or its descendants.
+  EXPECT_EQ(nullptr, sdf::MoveNode(b, b));
+  EXPECT_EQ(nullptr, sdf::MoveNode(b->FirstChildElement("c"), d));
+  EXPECT_EQ(b, d->FirstChildElement("b"));
+
+  // A node of another document is copied and deleted from it.
+  tinyxml2::XMLDocument newDoc;
+  tinyxml2::XMLElement *root = newDoc.NewElement("root");
+  newDoc.InsertEndChild(root);
+  tinyxml2::XMLNode *moved = sdf::MoveNode(root, b);
+  ASSERT_NE(nullptr, moved);
+  EXPECT_EQ(&newDoc, moved->GetDocument());
+  EXPECT_STREQ("1", moved->ToElement()->Attribute("attr"));
+  EXPECT_NE(nullptr, moved->FirstChildElement("c"));
+  EXPECT_EQ(nullptr, d->FirstChildElement("b"));
+
+  EXPECT_EQ(nullptr, sdf::MoveNode(nullptr, d));
+  EXPECT_EQ(nullptr, sdf::MoveNode(root, nullptr));
+}
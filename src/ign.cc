@@ -15,89 +15,741 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <optional>
+#include <set>
+#include <sstream>
 #include <string>
 #include <string.h>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 
 #include "sdf/sdf_config.h"
+#include "sdf/Bundle.hh"
 #include "sdf/Filesystem.hh"
+#include "sdf/LoadProfile.hh"
+#include "sdf/MemoryUsage.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/PerfCounters.hh"
 #include "sdf/Root.hh"
+#include "sdf/Types.hh"
 #include "sdf/parser.hh"
 #include "sdf/PrintConfig.hh"
 #include "sdf/system_util.hh"
 
+#include "CheckResultCache.hh"
 #include "FrameSemantics.hh"
 #include "ScopedGraph.hh"
+#include "UpgradedFile.hh"
 #include "ign.hh"
 
 //////////////////////////////////////////////////
-extern "C" SDFORMAT_VISIBLE int cmdCheck(const char *_path)
+/// \brief Add the paths of the files that the elements of a tree were read
+/// from to a set.
+/// \param[in] _elem Root of the tree.
+/// \param[in,out] _files The set of paths.
+static void collectFilePaths(const sdf::ElementPtr &_elem,
+    std::set<std::string> &_files)
+{
+  if (!_elem)
+    return;
+
+  if (!_elem->FilePath().empty())
+    _files.insert(_elem->FilePath());
+  for (auto child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    collectFilePaths(child, _files);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check an SDFormat file, or the document of a bundle file.
+/// \param[in] _path Path to the file to validate.
+/// \param[in] _config Parser configuration.
+/// \param[out] _out Stream for the result.
+/// \param[out] _err Stream for the errors.
+/// \param[out] _files If not null, the files the elements were read from
+/// are added to it.
+/// \return Zero on success, negative one otherwise.
+static int checkFile(const std::string &_path,
+    const sdf::ParserConfig &_config, std::ostream &_out, std::ostream &_err,
+    std::set<std::string> *_files = nullptr)
 {
   int result = 0;
 
+  // The document of a bundle is read from the bundle, with a copy of the
+  // configuration. Other files use the configuration of the caller, so that
+  // its caches are kept.
+  const sdf::ParserConfig *config = &_config;
+  std::optional<sdf::ParserConfig> bundleConfig;
+  std::string path = _path;
+  sdf::Bundle bundle;
+  if (sdf::Bundle::IsBundleFile(_path))
+  {
+    sdf::Errors bundleErrors = bundle.Open(_path);
+    if (!bundleErrors.empty())
+    {
+      _err << bundleErrors;
+      return -1;
+    }
+    bundleConfig = _config;
+    bundle.Configure(*bundleConfig);
+    config = &*bundleConfig;
+    path = bundle.MainFile();
+  }
+
   sdf::Root root;
-  sdf::Errors errors = root.Load(_path);
+  sdf::Errors errors = root.Load(path, *config);
+  if (_files)
+  {
+    collectFilePaths(root.Element(), *_files);
+  }
   if (!errors.empty())
   {
     for (auto &error : errors)
     {
-      std::cerr << error << std::endl;
+      _err << error << std::endl;
     }
     return -1;
   }
 
-  if (!sdf::checkCanonicalLinkNames(&root))
+  if (!sdf::checkRoot(&root, _err))
   {
     result = -1;
   }
 
-  if (!sdf::checkJointParentChildLinkNames(&root))
+  if (!sdf::filesystem::exists(_path))
   {
-    result = -1;
+    _err << "Error: File [" << _path << "] does not exist.\n";
+    return -1;
   }
 
-  if (!sdf::checkFrameAttachedToGraph(&root))
+  sdf::SDFPtr sdf(new sdf::SDF());
+
+  if (!sdf::init(sdf, *config))
   {
-    result = -1;
+    _err << "Error: SDF schema initialization failed.\n";
+    return -1;
   }
 
-  if (!sdf::checkPoseRelativeToGraph(&root))
+  sdf::Errors readErrors;
+  const bool read = sdf::readFile(path, *config, sdf, readErrors);
+  for (auto &error : readErrors)
   {
-    result = -1;
+    _err << error << std::endl;
+  }
+  if (!read)
+  {
+    _err << "Error: SDF parsing the xml failed.\n";
+    return -1;
   }
 
-  if (!sdf::recursiveSiblingUniqueNames(root.Element()))
+  if (result == 0)
   {
-    result = -1;
+    _out << "Valid.\n";
   }
+  return result;
+}
 
-  if (!sdf::filesystem::exists(_path))
+//////////////////////////////////////////////////
+/// \brief Get the path of the model.config file in the directory of a file.
+/// \param[in] _path Path to the file.
+/// \return The path of the model.config file, which may not exist.
+static std::string modelConfigPath(const std::string &_path)
+{
+  const std::string dir = sdf::filesystem::parent_path(_path);
+  return sdf::filesystem::append(dir.empty() ? "." : dir, "model.config");
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the model.config files next to a set of files to the set.
+/// They choose which model files are included.
+/// \param[in,out] _files The set of paths.
+static void addModelConfigPaths(std::set<std::string> &_files)
+{
+  std::set<std::string> configs;
+  for (const auto &file : _files)
   {
-    std::cerr << "Error: File [" << _path << "] does not exist.\n";
+    const std::string config = modelConfigPath(file);
+    if (sdf::filesystem::is_regular_file(config))
+      configs.insert(config);
+  }
+  _files.insert(configs.begin(), configs.end());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check a file like checkFile, and reuse the stored result of an
+/// earlier check if none of the files it read has changed since.
+/// \param[in] _path Path to the file to validate.
+/// \param[in] _config Parser configuration.
+/// \param[in] _cacheDir Directory of the stored results, or an empty string
+/// to always check the file.
+/// \param[out] _out Stream for the result.
+/// \param[out] _err Stream for the errors.
+/// \param[out] _cached If not null, set to true if the stored result was
+/// used.
+/// \return Zero on success, negative one otherwise.
+static int checkFileCached(const std::string &_path,
+    const sdf::ParserConfig &_config, const std::string &_cacheDir,
+    std::ostream &_out, std::ostream &_err, bool *_cached = nullptr)
+{
+  if (_cached)
+    *_cached = false;
+  if (_cacheDir.empty())
+    return checkFile(_path, _config, _out, _err);
+
+  sdf::CheckResultEntry entry;
+  if (sdf::readCheckResult(_cacheDir, _path, entry))
+  {
+    if (_cached)
+      *_cached = true;
+    _out << entry.output;
+    _err << entry.errors;
+    return entry.result;
+  }
+
+  std::ostringstream output;
+  std::ostringstream errors;
+  entry.files.insert(_path);
+  entry.result = checkFile(_path, _config, output, errors, &entry.files);
+  entry.output = output.str();
+  entry.errors = errors.str();
+  _out << entry.output;
+  _err << entry.errors;
+
+  // Only valid results are stored. A file that is invalid because an
+  // included file is missing would stay invalid once the file is added,
+  // since only the files that were read are recorded.
+  if (entry.result == 0)
+  {
+    addModelConfigPaths(entry.files);
+    sdf::writeCheckResult(_cacheDir, _path, entry);
+  }
+  return entry.result;
+}
+
+//////////////////////////////////////////////////
+extern "C" SDFORMAT_VISIBLE int cmdCheck(const char *_path)
+{
+  return checkFile(_path, sdf::ParserConfig::GlobalConfig(), std::cout,
+      std::cerr);
+}
+
+//////////////////////////////////////////////////
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE int cmdCheckCached(const char *_path,
+    const char *_cacheDir)
+{
+  return checkFileCached(_path, sdf::ParserConfig::GlobalConfig(),
+      _cacheDir ? _cacheDir : "", std::cout, std::cerr);
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the extension of a file name. A name that starts with its
+/// only period has no extension.
+/// \param[in] _name Name of the file.
+/// \return The extension, with its period, or an empty string.
+static std::string fileExtension(const std::string &_name)
+{
+  const std::size_t dot = _name.rfind('.');
+  return (dot == std::string::npos || dot == 0) ? "" : _name.substr(dot);
+}
+
+//////////////////////////////////////////////////
+/// \brief Find the .sdf, .world and .urdf files in a directory tree.
+/// Symbolic links to files are followed, but symbolic links to directories
+/// are not.
+/// \param[in] _dir Path of the directory.
+/// \param[in,out] _found The paths of the files found.
+static void findFilesToCheck(const std::string &_dir,
+    std::vector<std::string> &_found)
+{
+  std::vector<sdf::filesystem::DirEntry> entries;
+  if (!sdf::filesystem::read_directory(_dir, entries))
+    return;
+
+  for (const auto &entry : entries)
+  {
+    const std::string path = sdf::filesystem::append(_dir, entry.name);
+    if (entry.type == sdf::filesystem::FileType::DIRECTORY ||
+        (entry.type == sdf::filesystem::FileType::UNKNOWN &&
+         sdf::filesystem::is_directory(path)))
+    {
+      findFilesToCheck(path, _found);
+      continue;
+    }
+
+    const std::string extension = fileExtension(entry.name);
+    if ((extension == ".sdf" || extension == ".world" ||
+         extension == ".urdf") &&
+        (entry.type == sdf::filesystem::FileType::REGULAR ||
+         sdf::filesystem::is_regular_file(path)))
+    {
+      _found.push_back(path);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the files to check for a path.
+/// \param[in] _path Path to a file, or to a directory to search for
+/// .sdf, .world and .urdf files.
+/// \param[out] _files The files, in alphabetical order for directories.
+static void filesToCheck(const std::string &_path,
+    std::vector<std::string> &_files)
+{
+  if (!sdf::filesystem::is_directory(_path))
+  {
+    _files.push_back(_path);
+    return;
+  }
+
+  std::vector<std::string> found;
+  findFilesToCheck(_path, found);
+  std::sort(found.begin(), found.end());
+  _files.insert(_files.end(), found.begin(), found.end());
+}
+
+//////////////////////////////////////////////////
+/// \brief Result of checking a file with cmdCheckFiles.
+struct CheckResult
+{
+  /// \brief Zero if the file is valid, negative one otherwise.
+  int result = -1;
+
+  /// \brief Output and errors of the check.
+  std::string output;
+
+  /// \brief Time spent checking the file.
+  std::chrono::steady_clock::duration duration{};
+
+  /// \brief True if the stored result of an earlier check was used.
+  bool cached = false;
+};
+
+//////////////////////////////////////////////////
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE int cmdCheckFiles(const char *_paths, int _jobs,
+    const char *_cacheDir)
+{
+  const std::string cacheDir = _cacheDir ? _cacheDir : "";
+  std::vector<std::string> files;
+  std::istringstream paths(_paths);
+  for (std::string path; std::getline(paths, path);)
+  {
+    if (!path.empty())
+      filesToCheck(path, files);
+  }
+
+  if (files.empty())
+  {
+    std::cerr << "Error: No files to check.\n";
     return -1;
   }
 
+  // The files share the parser configuration, so that files included by
+  // several of them are only read once.
+  sdf::ParserConfig config = sdf::ParserConfig::GlobalConfig();
+  config.SetUseIncludeCache(true);
+  config.SetUseFindFileCache(true);
+
+  std::size_t jobs = _jobs > 0 ? static_cast<std::size_t>(_jobs) :
+      std::max(1u, std::thread::hardware_concurrency());
+  jobs = std::min(jobs, files.size());
+
+  std::vector<CheckResult> results(files.size());
+  std::atomic<std::size_t> nextFile{0};
+  auto checkFiles = [&](std::size_t)
+  {
+    for (std::size_t i = nextFile++; i < files.size(); i = nextFile++)
+    {
+      std::ostringstream output;
+      const auto start = std::chrono::steady_clock::now();
+      results[i].result = checkFileCached(files[i], config, cacheDir,
+          output, output, &results[i].cached);
+      results[i].duration = std::chrono::steady_clock::now() - start;
+      results[i].output = output.str();
+    }
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  config.Executor()->RunAndWait(jobs, checkFiles);
+  const auto duration = std::chrono::steady_clock::now() - start;
+
+  auto milliseconds = [](std::chrono::steady_clock::duration _duration)
+  {
+    return std::chrono::duration<double, std::milli>(_duration).count();
+  };
+
+  std::size_t invalid = 0;
+  std::size_t cached = 0;
+  for (std::size_t i = 0; i < files.size(); ++i)
+  {
+    if (results[i].cached)
+      ++cached;
+    if (results[i].result != 0)
+    {
+      ++invalid;
+      std::cerr << "Error: [" << files[i] << "] is not valid:\n"
+                << results[i].output;
+    }
+  }
+
+  std::cout << std::fixed << std::setprecision(1);
+  for (std::size_t i = 0; i < files.size(); ++i)
+  {
+    std::cout << std::setw(10) << milliseconds(results[i].duration) << " ms  "
+              << (results[i].result == 0 ? "valid  " : "invalid") << "  "
+              << files[i] << "\n";
+  }
+  std::cout << "Checked " << files.size() << " files in "
+            << milliseconds(duration) << " ms on " << jobs << " threads: "
+            << files.size() - invalid << " valid, " << invalid
+            << " invalid";
+  if (!cacheDir.empty())
+    std::cout << ", " << cached << " from the cache";
+  std::cout << ".\n";
+
+  return invalid == 0 ? 0 : -1;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the model file chosen by the model.config of a directory.
+/// \param[in] _dir The directory.
+/// \param[in] _config Parser configuration.
+/// \return The source of the model file if it is an upgraded file, the
+/// model file otherwise, or an empty string if the directory has no
+/// model.config.
+static std::string modelSourceFile(const std::string &_dir,
+    const sdf::ParserConfig &_config)
+{
+  if (!sdf::filesystem::is_regular_file(
+        sdf::filesystem::append(_dir, "model.config")))
+  {
+    return "";
+  }
+
+  const std::string modelFile = sdf::getModelFilePath(_dir, _config);
+  std::string sourceName;
+  std::string sourceHash;
+  if (!modelFile.empty() &&
+      sdf::readUpgradedFileHeader(modelFile, sourceName, sourceHash))
+  {
+    return sdf::filesystem::append(_dir, sourceName);
+  }
+  return modelFile;
+}
+
+//////////////////////////////////////////////////
+/// \brief Find the .sdf and .world files to upgrade in a directory tree.
+/// Symbolic links to files are followed, but symbolic links to directories
+/// are not.
+/// \param[in] _dir Path of the directory.
+/// \param[in] _config Parser configuration.
+/// \param[in,out] _found The paths of the files found.
+static void findFilesToUpgrade(const std::string &_dir,
+    const sdf::ParserConfig &_config, std::vector<std::string> &_found)
+{
+  std::vector<sdf::filesystem::DirEntry> entries;
+  if (!sdf::filesystem::read_directory(_dir, entries))
+    return;
+
+  std::string modelFile;
+  bool modelFileFound = false;
+  for (const auto &entry : entries)
+  {
+    const std::string path = sdf::filesystem::append(_dir, entry.name);
+    if (entry.type == sdf::filesystem::FileType::DIRECTORY ||
+        (entry.type == sdf::filesystem::FileType::UNKNOWN &&
+         sdf::filesystem::is_directory(path)))
+    {
+      findFilesToUpgrade(path, _config, _found);
+      continue;
+    }
+
+    const std::string extension = fileExtension(entry.name);
+    if ((extension != ".sdf" && extension != ".world") ||
+        (entry.type != sdf::filesystem::FileType::REGULAR &&
+         !sdf::filesystem::is_regular_file(path)))
+    {
+      continue;
+    }
+
+    if (!modelFileFound)
+    {
+      modelFile = modelSourceFile(_dir, _config);
+      modelFileFound = true;
+    }
+
+    std::string sourceName;
+    std::string sourceHash;
+    if ((modelFile.empty() || sdf::filesystem::equivalent(modelFile, path)) &&
+        !sdf::readUpgradedFileHeader(path, sourceName, sourceHash))
+    {
+      _found.push_back(path);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the files to upgrade for a path.
+/// \param[in] _path Path to a file, or to a directory to search for .sdf
+/// and .world files. Of the files in a directory with a model.config, only
+/// the model file it chooses is upgraded.
+/// \param[in] _config Parser configuration.
+/// \param[out] _files The files, in alphabetical order for directories.
+static void filesToUpgrade(const std::string &_path,
+    const sdf::ParserConfig &_config, std::vector<std::string> &_files)
+{
+  if (!sdf::filesystem::is_directory(_path))
+  {
+    _files.push_back(_path);
+    return;
+  }
+
+  std::vector<std::string> found;
+  findFilesToUpgrade(_path, _config, found);
+  std::sort(found.begin(), found.end());
+  _files.insert(_files.end(), found.begin(), found.end());
+}
+
+//////////////////////////////////////////////////
+/// \brief Result of upgrading a file with cmdUpgrade.
+enum class UpgradeStatus
+{
+  /// \brief The file could not be upgraded.
+  FAILED,
+
+  /// \brief The file is already at the current SDFormat version.
+  CURRENT,
+
+  /// \brief The upgraded copy of the file was already up to date.
+  UP_TO_DATE,
+
+  /// \brief The upgraded copy of the file was written.
+  UPGRADED
+};
+
+//////////////////////////////////////////////////
+/// \brief Write the upgraded copy of a file, converted to the current
+/// SDFormat version, next to the file.
+/// \param[in] _path Path to the file.
+/// \param[in] _config Parser configuration, which must not read upgraded
+/// files.
+/// \param[out] _err Stream for the errors.
+/// \return The result.
+static UpgradeStatus upgradeFile(const std::string &_path,
+    const sdf::ParserConfig &_config, std::ostream &_err)
+{
+  const std::string hash = sdf::fileContentHash(_path);
+  if (hash.empty())
+  {
+    _err << "Error: File [" << _path << "] cannot be read.\n";
+    return UpgradeStatus::FAILED;
+  }
+
+  const std::string upgraded = sdf::upgradedFilePath(_path);
+  std::string sourceName;
+  std::string sourceHash;
+  if (sdf::readUpgradedFileHeader(upgraded, sourceName, sourceHash) &&
+      sourceHash == hash)
+  {
+    return UpgradeStatus::UP_TO_DATE;
+  }
+
   sdf::SDFPtr sdf(new sdf::SDF());
+  if (!sdf::init(sdf, _config))
+  {
+    _err << "Error: SDF schema initialization failed.\n";
+    return UpgradeStatus::FAILED;
+  }
 
-  if (!sdf::init(sdf))
+  sdf::Errors errors;
+  const bool read = sdf::readFile(_path, _config, sdf, errors);
+  for (auto &error : errors)
   {
-    std::cerr << "Error: SDF schema initialization failed.\n";
-    return -1;
+    _err << error << std::endl;
+  }
+  if (!read || !errors.empty())
+  {
+    _err << "Error: SDF parsing the xml failed.\n";
+    return UpgradeStatus::FAILED;
   }
 
-  if (!sdf::readFile(_path, sdf))
+  if (sdf->OriginalVersion() == sdf::SDF::Version())
+    return UpgradeStatus::CURRENT;
+
+  // The included files are kept as <include> elements, and are upgraded on
+  // their own.
+  sdf::PrintConfig printConfig;
+  printConfig.SetPreserveIncludes(true);
+  std::string content = sdf->ToString(printConfig);
+  content.insert(content.find('\n') + 1, sdf::upgradedFileHeader(
+      sdf::filesystem::basename(_path), hash) + "\n");
+
+  // Write to a temporary file first, so that the parser never reads a
+  // partially written upgraded file.
+  const std::string tmpPath = upgraded + ".tmp";
   {
-    std::cerr << "Error: SDF parsing the xml failed.\n";
+    std::ofstream out(tmpPath, std::ios::binary);
+    out << content;
+    if (!out.flush())
+    {
+      _err << "Error: Unable to write file [" << tmpPath << "].\n";
+      return UpgradeStatus::FAILED;
+    }
+  }
+  if (!sdf::filesystem::rename(tmpPath, upgraded))
+  {
+    _err << "Error: Unable to write file [" << upgraded << "].\n";
+    sdf::filesystem::remove(tmpPath);
+    return UpgradeStatus::FAILED;
+  }
+  return UpgradeStatus::UPGRADED;
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the upgraded copy of the model file of a directory to its
+/// model.config, so that it is chosen as the model file.
+/// \param[in] _path Path to the model file that was upgraded.
+/// \param[in] _config Parser configuration.
+/// \param[out] _err Stream for the errors.
+/// \return True if the model.config was changed.
+static bool addUpgradedModelFile(const std::string &_path,
+    const sdf::ParserConfig &_config, std::ostream &_err)
+{
+  const std::string configPath = modelConfigPath(_path);
+  const std::string modelFile = modelSourceFile(
+      sdf::filesystem::parent_path(configPath), _config);
+  if (modelFile.empty() || !sdf::filesystem::equivalent(modelFile, _path))
+    return false;
+
+  std::ifstream in(configPath, std::ios::binary);
+  std::stringstream text;
+  text << in.rdbuf();
+  std::string content = text.str();
+
+  const std::string upgradedName =
+      sdf::filesystem::basename(sdf::upgradedFilePath(_path));
+  const std::string entry = "<sdf version=\"" + sdf::SDF::Version() + "\">" +
+      upgradedName + "</sdf>";
+  if (content.find(entry) != std::string::npos)
+    return false;
+
+  // Add the entry after the last <sdf> entry, with the same indentation.
+  const std::size_t last = content.rfind("</sdf>");
+  const std::size_t lastStart = content.rfind("<sdf", last);
+  if (last == std::string::npos || lastStart == std::string::npos)
+  {
+    _err << "Error: No <sdf> element in [" << configPath << "].\n";
+    return false;
+  }
+  const std::size_t lineStart = content.rfind('\n', lastStart);
+  const std::string indent = lineStart == std::string::npos ? "" :
+      content.substr(lineStart + 1, lastStart - lineStart - 1);
+  content.insert(last + std::strlen("</sdf>"), "\n" + indent + entry);
+
+  std::ofstream out(configPath, std::ios::binary);
+  out << content;
+  if (!out.flush())
+  {
+    _err << "Error: Unable to write file [" << configPath << "].\n";
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE int cmdUpgrade(const char *_paths, int _jobs)
+{
+  // The files share the parser configuration, so that files included by
+  // several of them are only read once. The files are always converted
+  // from their source.
+  sdf::ParserConfig config = sdf::ParserConfig::GlobalConfig();
+  config.SetUseIncludeCache(true);
+  config.SetUseFindFileCache(true);
+  config.SetUseUpgradedFiles(false);
+
+  std::vector<std::string> files;
+  std::istringstream paths(_paths);
+  for (std::string path; std::getline(paths, path);)
+  {
+    if (!path.empty())
+      filesToUpgrade(path, config, files);
+  }
+
+  if (files.empty())
+  {
+    std::cerr << "Error: No files to upgrade.\n";
     return -1;
   }
 
-  if (result == 0)
+  std::size_t jobs = _jobs > 0 ? static_cast<std::size_t>(_jobs) :
+      std::max(1u, std::thread::hardware_concurrency());
+  jobs = std::min(jobs, files.size());
+
+  std::vector<UpgradeStatus> results(files.size(), UpgradeStatus::FAILED);
+  std::vector<std::string> outputs(files.size());
+  std::atomic<std::size_t> nextFile{0};
+  auto upgradeFiles = [&](std::size_t)
+  {
+    for (std::size_t i = nextFile++; i < files.size(); i = nextFile++)
+    {
+      std::ostringstream output;
+      results[i] = upgradeFile(files[i], config, output);
+      outputs[i] = output.str();
+    }
+  };
+
+  config.Executor()->RunAndWait(jobs, upgradeFiles);
+
+  std::size_t failed = 0;
+  std::size_t upgraded = 0;
+  for (std::size_t i = 0; i < files.size(); ++i)
   {
-    std::cout << "Valid.\n";
+    switch (results[i])
+    {
+      case UpgradeStatus::FAILED:
+        ++failed;
+        std::cerr << "Error: [" << files[i] << "] was not upgraded:\n"
+                  << outputs[i];
+        break;
+      case UpgradeStatus::CURRENT:
+        std::cout << "current    " << files[i] << "\n";
+        break;
+      case UpgradeStatus::UP_TO_DATE:
+      case UpgradeStatus::UPGRADED:
+        if (results[i] == UpgradeStatus::UPGRADED)
+          ++upgraded;
+        std::cout << (results[i] == UpgradeStatus::UPGRADED ?
+                      "upgraded   " : "up to date ") << files[i] << " -> "
+                  << sdf::upgradedFilePath(files[i]) << "\n";
+        if (addUpgradedModelFile(files[i], config, std::cerr))
+        {
+          std::cout << "updated    " << modelConfigPath(files[i]) << "\n";
+        }
+        break;
+    }
   }
-  return result;
+  std::cout << "Upgraded " << upgraded << " of " << files.size()
+            << " files to version " << sdf::SDF::Version() << " on " << jobs
+            << " threads, " << failed << " failed.\n";
+
+  return failed == 0 ? 0 : -1;
 }
 
 //////////////////////////////////////////////////
@@ -157,6 +809,8 @@ extern "C" SDFORMAT_VISIBLE int cmdPrint(const char *_path,
   }
 
   sdf::PrintConfig config;
+  // The output is the same whatever the number of threads is.
+  config.SetThreadCount(std::thread::hardware_concurrency());
   if (inDegrees!= 0)
   {
     config.SetRotationInDegrees(true);
@@ -195,6 +849,7 @@ extern "C" SDFORMAT_VISIBLE int cmdPrintPreserveIncludes(const char *_path)
   }
 
   sdf::PrintConfig config;
+  config.SetThreadCount(std::thread::hardware_concurrency());
   config.SetPreserveIncludes(true);
   sdf->PrintValues(config);
 
@@ -267,3 +922,354 @@ extern "C" SDFORMAT_VISIBLE int cmdGraph(
 
   return 0;
 }
+
+//////////////////////////////////////////////////
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE int cmdMemory(const char *_path)
+{
+  if (!sdf::filesystem::exists(_path))
+  {
+    std::cerr << "Error: File [" << _path << "] does not exist.\n";
+    return -1;
+  }
+
+  sdf::Root root;
+  sdf::Errors errors = root.Load(_path);
+  if (!errors.empty())
+  {
+    std::cerr << errors << std::endl;
+  }
+
+  if (!root.Element())
+  {
+    std::cerr << "Error: SDF parsing the xml failed.\n";
+    return -1;
+  }
+
+  std::cout << sdf::MemoryUsage(root);
+  return 0;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the peak resident set size of the process.
+/// \return Peak resident set size in kilobytes, or -1 if it is not available
+/// on this platform.
+static long peakRssKb()
+{
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+#endif
+  return -1;
+}
+
+//////////////////////////////////////////////////
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE int cmdProfile(const char *_path, int _iterations)
+{
+  if (!sdf::filesystem::exists(_path))
+  {
+    std::cerr << "Error: File [" << _path << "] does not exist.\n";
+    return -1;
+  }
+
+  const int iterations = std::max(1, _iterations);
+  auto profile = std::make_shared<sdf::LoadProfile>();
+  sdf::ParserConfig config = sdf::ParserConfig::GlobalConfig();
+  config.SetProfile(profile);
+  sdf::ResetPerfCounters();
+
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  Milliseconds total{0};
+  Milliseconds fastest{0};
+  Milliseconds slowest{0};
+  for (int i = 0; i < iterations; ++i)
+  {
+    sdf::Root root;
+    const auto start = std::chrono::steady_clock::now();
+    sdf::Errors errors = root.Load(_path, config);
+    const Milliseconds duration = std::chrono::steady_clock::now() - start;
+
+    // Every load reports the same errors, so they are only printed once.
+    if (i == 0)
+    {
+      if (!errors.empty())
+        std::cerr << errors << std::endl;
+      if (!root.Element())
+      {
+        std::cerr << "Error: SDF parsing the xml failed.\n";
+        return -1;
+      }
+      fastest = duration;
+    }
+    total += duration;
+    fastest = std::min(fastest, duration);
+    slowest = std::max(slowest, duration);
+  }
+
+  // The times and counts are printed per load.
+  auto perLoad = [&](std::chrono::nanoseconds _duration)
+  {
+    return Milliseconds(_duration).count() / iterations;
+  };
+  double totalPhases = 0;
+  for (int p = 0; p <= static_cast<int>(sdf::LoadPhase::VALIDATION); ++p)
+    totalPhases += perLoad(profile->Duration(static_cast<sdf::LoadPhase>(p)));
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "Loaded [" << _path << "] " << iterations << " times: "
+            << total.count() / iterations << " ms per load, min "
+            << fastest.count() << " ms, max " << slowest.count() << " ms.\n";
+
+  std::cout << "\nPhases, per load:\n";
+  for (int p = 0; p <= static_cast<int>(sdf::LoadPhase::VALIDATION); ++p)
+  {
+    const auto phase = static_cast<sdf::LoadPhase>(p);
+    const double ms = perLoad(profile->Duration(phase));
+    std::cout << "  " << std::left << std::setw(18)
+              << sdf::LoadProfile::PhaseName(phase) << std::right
+              << std::setw(10) << ms << " ms" << std::setw(8)
+              << (totalPhases > 0 ? 100 * ms / totalPhases : 0.0) << " %"
+              << std::setw(10) << profile->Count(phase) / iterations
+              << " runs\n";
+  }
+
+  // The slowest included files first.
+  std::vector<std::string> includes = profile->IncludedFiles();
+  std::stable_sort(includes.begin(), includes.end(),
+      [&](const std::string &_a, const std::string &_b)
+      {
+        return profile->IncludeDuration(_a) > profile->IncludeDuration(_b);
+      });
+  const std::size_t kMaxIncludes = 20;
+  std::cout << "\nIncluded files, per load, slowest first:\n";
+  if (includes.empty())
+    std::cout << "  none\n";
+  for (std::size_t i = 0; i < includes.size() && i < kMaxIncludes; ++i)
+  {
+    std::cout << std::setw(12) << perLoad(profile->IncludeDuration(
+                 includes[i])) << " ms" << std::setw(8)
+              << profile->IncludeCount(includes[i]) / iterations << "x  "
+              << includes[i] << "\n";
+  }
+  if (includes.size() > kMaxIncludes)
+  {
+    std::cout << "  and " << includes.size() - kMaxIncludes
+              << " more files.\n";
+  }
+
+  std::cout << "\nPeak resident memory: ";
+  const long peakRss = peakRssKb();
+  if (peakRss < 0)
+    std::cout << "not available\n";
+  else
+    std::cout << peakRss << " kB\n";
+
+  std::cout << "\nCounters, per load:\n";
+  if (!sdf::PerfCountersEnabled())
+  {
+    std::cout << "  disabled at compile time\n";
+    return 0;
+  }
+  const sdf::PerfCounters counters = sdf::GetPerfCounters();
+  auto printCounter = [&](const std::string &_name, std::uint64_t _value)
+  {
+    std::cout << "  " << std::left << std::setw(40) << _name << std::right
+              << std::setw(12) << _value / iterations << "\n";
+  };
+  printCounter("element_clone_calls", counters.elementCloneCalls);
+  printCounter("elements_cloned", counters.elementsCloned);
+  printCounter("add_element_calls", counters.addElementCalls);
+  printCounter("get_element_comparisons", counters.getElementComparisons);
+  for (const auto &[type, calls] : counters.paramSetFromStringCalls)
+    printCounter("param_set_from_string[" + type + "]", calls);
+  printCounter("find_file_calls", counters.findFileCalls);
+  printCounter("find_file_probes", counters.findFileProbes);
+  printCounter("converter_node_visits", counters.converterNodeVisits);
+  printCounter("graph_vertices_built", counters.graphVerticesBuilt);
+  printCounter("pose_graph_walks", counters.poseGraphWalks);
+  printCounter("name_lookup_linear_searches",
+               counters.nameLookupLinearSearches);
+  return 0;
+}
+
+//////////////////////////////////////////////////
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE int cmdPack(const char *_path,
+    const char *_bundlePath)
+{
+  sdf::Errors errors = sdf::Bundle::Pack(_path, _bundlePath,
+      sdf::ParserConfig::GlobalConfig());
+  if (!errors.empty())
+  {
+    std::cerr << errors << "Error: [" << _path << "] was not packed.\n";
+    return -1;
+  }
+
+  sdf::Bundle bundle;
+  errors = bundle.Open(_bundlePath);
+  if (!errors.empty())
+  {
+    std::cerr << errors;
+    return -1;
+  }
+
+  std::cout << "Packed " << bundle.Files().size() << " files into ["
+            << _bundlePath << "].\n";
+  return 0;
+}
+
+//////////////////////////////////////////////////
+/// \brief Response to a request of cmdServe. A valid response is reused as
+/// long as the files it was computed from are not modified.
+struct ServedResponse
+{
+  /// \brief Zero on success, negative one otherwise.
+  int result = -1;
+
+  /// \brief Output of the request.
+  std::string output;
+
+  /// \brief Modification times of the files read for the request, in
+  /// nanoseconds. Empty if the response must be computed again.
+  std::map<std::string, std::int64_t> files;
+};
+
+//////////////////////////////////////////////////
+/// \brief Check whether the files of a response were modified.
+/// \param[in] _response The response.
+/// \return True if a file was modified or removed since the response was
+/// computed.
+static bool filesModified(const ServedResponse &_response)
+{
+  for (const auto &file : _response.files)
+  {
+    std::int64_t time = 0;
+    if (!sdf::filesystem::last_write_time(file.first, time) ||
+        time != file.second)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE int cmdServe()
+{
+  // The parser configuration is kept for the lifetime of the server, so
+  // that the file lookups are cached between requests. The include cache is
+  // not used: it only compares the modification time of each included file,
+  // so an edit to a file included by an included file would not be seen.
+  sdf::ParserConfig config = sdf::ParserConfig::GlobalConfig();
+  config.SetUseFindFileCache(true);
+
+  // The file lookups are forgotten after a file was modified or a request
+  // failed, since a lookup may then find a file that was added, or fail
+  // to find one that was removed, including failed lookups that are cached.
+  bool findFileCacheStale = false;
+
+  std::map<std::string, ServedResponse> responses;
+  for (std::string line; std::getline(std::cin, line);)
+  {
+    const std::size_t separator = line.find(' ');
+    const std::string request = line.substr(0, separator);
+    const std::string path = separator == std::string::npos ?
+        "" : sdf::trim(line.substr(separator + 1));
+
+    if (request.empty())
+      continue;
+
+    if (request == "quit")
+      break;
+
+    int result = 0;
+    if (request == "clear")
+    {
+      responses.clear();
+      config.ClearFindFileCache();
+    }
+    else if ((request == "check" || request == "print") && !path.empty())
+    {
+      ServedResponse &response = responses[request + " " + path];
+      const bool modified = !response.files.empty() && filesModified(response);
+      if (response.files.empty() || modified)
+      {
+        if (modified || findFileCacheStale)
+        {
+          config.ClearFindFileCache();
+          findFileCacheStale = false;
+        }
+
+        std::ostringstream output;
+        std::set<std::string> files{path};
+        if (request == "check")
+        {
+          response.result = checkFile(path, config, output, output, &files);
+        }
+        else
+        {
+          sdf::SDFPtr sdf(new sdf::SDF());
+          sdf::Errors errors;
+          response.result = -1;
+          if (!sdf::filesystem::exists(path))
+          {
+            output << "Error: File [" << path << "] does not exist.\n";
+          }
+          else if (!sdf::init(sdf, config))
+          {
+            output << "Error: SDF schema initialization failed.\n";
+          }
+          else if (!sdf::readFile(path, config, sdf, errors))
+          {
+            output << errors << "Error: SDF parsing the xml failed.\n";
+          }
+          else
+          {
+            collectFilePaths(sdf->Root(), files);
+            output << sdf->ToString(sdf::PrintConfig());
+            response.result = 0;
+          }
+        }
+
+        response.output = output.str();
+        addModelConfigPaths(files);
+        response.files.clear();
+        for (const auto &file : files)
+        {
+          std::int64_t time = 0;
+          if (sdf::filesystem::last_write_time(file, time))
+            response.files[file] = time;
+        }
+        // Only valid responses are reused. An invalid file may become valid
+        // without a change to the files that were read, when a missing file
+        // that it includes is added.
+        if (response.result != 0 || !response.files.count(path))
+        {
+          response.files.clear();
+          findFileCacheStale = true;
+        }
+      }
+      std::cout << response.output;
+      result = response.result;
+    }
+    else
+    {
+      std::cout << "Error: Unknown request [" << line << "]. Requests are "
+                << "[check <path>], [print <path>], [clear] and [quit].\n";
+      result = -1;
+    }
+
+    std::cout << "END " << result << std::endl;
+  }
+
+  return 0;
+}
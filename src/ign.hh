@@ -32,6 +32,15 @@ inline namespace SDF_VERSION_NAMESPACE {
 /// \return Zero on success, negative one otherwise.
 extern "C" SDFORMAT_VISIBLE int cmdCheck(const char *_path);
 
+/// \brief External hook to execute 'ign sdf -k --cache-dir' from the
+/// command line. The result of an earlier check of the file is reported if
+/// none of the files it read has changed since.
+/// \param[in] _path Path to the file to validate.
+/// \param[in] _cacheDir Directory where the results of checks are stored.
+/// \return Zero on success, negative one otherwise.
+extern "C" SDFORMAT_VISIBLE int cmdCheckCached(const char *_path,
+    const char *_cacheDir);
+
 /// \brief External hook to read the library version.
 /// \return C-string representing the version. Ex.: 0.1.2
 extern "C" SDFORMAT_VISIBLE char *ignitionVersion();
@@ -18,10 +18,15 @@
 #include <gtest/gtest.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 #include <string>
 
 #include <ignition/utilities/ExtraTestMacros.hh>
 
+#include "sdf/Filesystem.hh"
 #include "sdf/parser.hh"
 #include "sdf/SDFImpl.hh"
 #include "sdf/sdf_config.h"
@@ -1795,6 +1800,323 @@ TEST(GraphCmd, IGN_UTILS_TEST_DISABLED_ON_WIN32(ModelFrameAttachedTo))
   EXPECT_EQ(sdf::trim(expected.str()), sdf::trim(output));
 }
 
+/////////////////////////////////////////////////
+TEST(check, IGN_UTILS_TEST_DISABLED_ON_WIN32(MultipleFiles))
+{
+  const std::string pathBase = std::string(PROJECT_SOURCE_PATH) + "/test";
+  const std::string good = pathBase + "/sdf/box_plane_low_friction_test.world";
+  const std::string bad = pathBase + "/sdf/box_bad_test.world";
+  const std::string modelDir =
+    pathBase + "/integration/model/simple_model";
+
+  // Check several good files, one of them found in a directory
+  {
+    const std::string output = custom_exec_str(IgnCommand() + " sdf -k " +
+        good + " " + modelDir + " -j 2" + SdfVersion());
+    EXPECT_NE(output.find(" ms  valid    " + good + "\n"), std::string::npos)
+      << output;
+    EXPECT_NE(output.find(" ms  valid    " + modelDir + "/model.sdf\n"),
+              std::string::npos) << output;
+    EXPECT_NE(output.find("Checked 2 files in "), std::string::npos)
+      << output;
+    EXPECT_NE(output.find(" on 2 threads: 2 valid, 0 invalid.\n"),
+              std::string::npos) << output;
+  }
+
+  // Check a good and a bad file
+  {
+    const std::string output = custom_exec_str(IgnCommand() + " sdf -k " +
+        good + " " + bad + SdfVersion());
+    EXPECT_NE(output.find("Error: [" + bad + "] is not valid:"),
+              std::string::npos) << output;
+    EXPECT_NE(output.find("Required attribute"), std::string::npos)
+      << output;
+    EXPECT_NE(output.find(" ms  invalid  " + bad + "\n"), std::string::npos)
+      << output;
+    EXPECT_NE(output.find("1 valid, 1 invalid.\n"), std::string::npos)
+      << output;
+  }
+
+  // The errors of the checks run on the DOM follow the header of their file
+  {
+    const std::string duplicate =
+        pathBase + "/sdf/world_sibling_same_names.sdf";
+    const std::string output = custom_exec_str(IgnCommand() + " sdf -k " +
+        good + " " + duplicate + " -j 2" + SdfVersion());
+    const std::string header = "Error: [" + duplicate + "] is not valid:\n";
+    EXPECT_NE(output.find(header + "Error: Non-unique names detected in "),
+              std::string::npos) << output;
+    EXPECT_NE(output.find("1 valid, 1 invalid.\n"), std::string::npos)
+      << output;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(check, IGN_UTILS_TEST_DISABLED_ON_WIN32(CacheDirectory))
+{
+  const std::string pathBase = std::string(PROJECT_SOURCE_PATH) + "/test";
+  const std::string good = pathBase + "/sdf/box_plane_low_friction_test.world";
+  const std::string bad = pathBase + "/sdf/box_bad_test.world";
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string cacheDir = sdf::filesystem::append(tmpDir, "check_cache");
+  std::filesystem::remove_all(cacheDir);
+
+  const std::string command = IgnCommand() + " sdf -k " + good + " " + bad +
+      " --cache-dir " + cacheDir + SdfVersion();
+  {
+    const std::string output = custom_exec_str(command);
+    EXPECT_NE(output.find("1 valid, 1 invalid, 0 from the cache.\n"),
+              std::string::npos) << output;
+  }
+
+  // Only the result of the valid file is stored.
+  {
+    const std::string output = custom_exec_str(command);
+    EXPECT_NE(output.find("Required attribute"), std::string::npos)
+      << output;
+    EXPECT_NE(output.find("1 valid, 1 invalid, 1 from the cache.\n"),
+              std::string::npos) << output;
+  }
+
+  // A single file reports the stored output.
+  {
+    const std::string output = custom_exec_str(IgnCommand() + " sdf -k " +
+        good + " --cache-dir " + cacheDir + SdfVersion());
+    EXPECT_EQ("Valid.\n", output);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(UpgradeCmd, IGN_UTILS_TEST_DISABLED_ON_WIN32(ModelDirectory))
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string dir = sdf::filesystem::append(tmpDir, "upgrade_cmd");
+  const std::string modelDir = sdf::filesystem::append(dir, "box");
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  std::filesystem::copy(
+      std::string(PROJECT_SOURCE_PATH) + "/test/integration/model/box",
+      modelDir, std::filesystem::copy_options::recursive);
+
+  std::string version = sdf::SDF::Version();
+  std::replace(version.begin(), version.end(), '.', '_');
+  const std::string source = sdf::filesystem::append(modelDir, "model.sdf");
+  const std::string upgraded =
+      sdf::filesystem::append(modelDir, "model-" + version + ".sdf");
+  const std::string configFile =
+      sdf::filesystem::append(modelDir, "model.config");
+
+  {
+    const std::string output = custom_exec_str(IgnCommand() + " sdf -u " +
+        dir + " -j 2" + SdfVersion());
+    EXPECT_NE(output.find("upgraded   " + source + " -> " + upgraded + "\n"),
+              std::string::npos) << output;
+    EXPECT_NE(output.find("updated    " + configFile + "\n"),
+              std::string::npos) << output;
+    EXPECT_NE(output.find("Upgraded 1 of 1 files to version " +
+                          sdf::SDF::Version()), std::string::npos) << output;
+  }
+
+  // The model.config chooses the upgraded file, which is read without
+  // conversion.
+  EXPECT_EQ(upgraded, sdf::getModelFilePath(modelDir));
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf);
+  ASSERT_TRUE(sdf::readFile(modelDir, sdf));
+  EXPECT_EQ(sdf::SDF::Version(), sdf->OriginalVersion());
+
+  // Upgrading again does not change anything.
+  {
+    const std::string output = custom_exec_str(IgnCommand() + " sdf -u " +
+        dir + SdfVersion());
+    EXPECT_NE(output.find("up to date " + source + " -> " + upgraded + "\n"),
+              std::string::npos) << output;
+    EXPECT_EQ(output.find("updated    "), std::string::npos) << output;
+    EXPECT_NE(output.find("Upgraded 0 of 1 files"), std::string::npos)
+      << output;
+  }
+  std::ifstream in(configFile);
+  std::stringstream config;
+  config << in.rdbuf();
+  const std::string entry =
+      "<sdf version=\"" + sdf::SDF::Version() + "\">model-" + version;
+  const std::size_t first = config.str().find(entry);
+  EXPECT_NE(std::string::npos, first) << config.str();
+  EXPECT_EQ(std::string::npos, config.str().find(entry, first + 1))
+    << config.str();
+
+  // A modified source is read and converted until it is upgraded again.
+  {
+    std::ofstream out(source, std::ios::app);
+    out << "\n";
+  }
+  sdf::SDFPtr modified(new sdf::SDF());
+  sdf::init(modified);
+  ASSERT_TRUE(sdf::readFile(modelDir, modified));
+  EXPECT_EQ("1.5", modified->OriginalVersion());
+}
+
+/////////////////////////////////////////////////
+TEST(ServeCmd, IGN_UTILS_TEST_DISABLED_ON_WIN32(Requests))
+{
+  const std::string pathBase = std::string(PROJECT_SOURCE_PATH) + "/test/sdf";
+  const std::string good = pathBase + "/box_plane_low_friction_test.world";
+  const std::string bad = pathBase + "/box_bad_test.world";
+
+  const std::string requests =
+    "check " + good + "\\n" +
+    "check " + good + "\\n" +
+    "check " + bad + "\\n" +
+    "print " + good + "\\n" +
+    "clear\\n" +
+    "unknown\\n" +
+    "quit\\n" +
+    "check " + good + "\\n";
+  const std::string output = custom_exec_str("printf '" + requests + "' | " +
+      IgnCommand() + " sdf --serve" + SdfVersion());
+
+  // Repeated requests get the same response.
+  const std::string valid = "Valid.\nEND 0\n";
+  const std::size_t first = output.find(valid);
+  ASSERT_NE(std::string::npos, first) << output;
+  EXPECT_EQ(first + valid.size(), output.find(valid, first + 1)) << output;
+
+  EXPECT_NE(std::string::npos, output.find("Required attribute")) << output;
+  EXPECT_NE(std::string::npos, output.find("END -1\n")) << output;
+  EXPECT_NE(std::string::npos, output.find("<world name='default'>"))
+    << output;
+  EXPECT_NE(std::string::npos, output.find("Error: Unknown request [unknown]"))
+    << output;
+
+  // Requests after quit are not answered.
+  std::size_t count = 0;
+  for (std::size_t pos = output.find("END "); pos != std::string::npos;
+       pos = output.find("END ", pos + 1))
+  {
+    ++count;
+  }
+  EXPECT_EQ(6u, count) << output;
+}
+
+/////////////////////////////////////////////////
+TEST(ServeCmd, IGN_UTILS_TEST_DISABLED_ON_WIN32(ModelConfigChange))
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string dir = sdf::filesystem::append(tmpDir, "serve_cmd");
+  const std::string modelDir = sdf::filesystem::append(dir, "box");
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(modelDir);
+
+  const std::string version = sdf::SDF::Version();
+  for (const std::string name : {"a", "b"})
+  {
+    std::ofstream model(
+        sdf::filesystem::append(modelDir, "model_" + name + ".sdf"));
+    model << "<sdf version='" << version << "'><model name='box'>"
+          << "<link name='link_" << name << "'/></model></sdf>";
+    std::ofstream config(sdf::filesystem::append(dir, name + ".config"));
+    config << "<?xml version='1.0'?><model><name>box</name>"
+           << "<sdf version='" << version << "'>model_" << name << ".sdf"
+           << "</sdf></model>";
+  }
+  const std::string configFile =
+      sdf::filesystem::append(modelDir, "model.config");
+  std::filesystem::copy_file(sdf::filesystem::append(dir, "a.config"),
+                             configFile);
+
+  // The model.config chooses another model file between the requests, so
+  // the second response is not the cached one.
+  const std::string output = custom_exec_str(
+      "(printf 'print " + modelDir + "\\n'; sleep 1; cp " +
+      sdf::filesystem::append(dir, "b.config") + " " + configFile +
+      "; printf 'print " + modelDir + "\\nquit\\n') | " +
+      IgnCommand() + " sdf --serve" + SdfVersion());
+
+  const std::size_t first = output.find("<link name='link_a'");
+  ASSERT_NE(std::string::npos, first) << output;
+  EXPECT_NE(std::string::npos, output.find("<link name='link_b'", first))
+    << output;
+}
+
+/////////////////////////////////////////////////
+TEST(MemoryCmd, IGN_UTILS_TEST_DISABLED_ON_WIN32(ModelCanonicalLink))
+{
+  const std::string path =
+    std::string(PROJECT_SOURCE_PATH) + "/test/sdf/model_canonical_link.sdf";
+
+  const std::string output =
+    custom_exec_str(IgnCommand() + " sdf -m " + path + SdfVersion());
+
+  EXPECT_NE(std::string::npos, output.find("Elements: ")) << output;
+  EXPECT_NE(std::string::npos, output.find("Params: ")) << output;
+  EXPECT_NE(std::string::npos, output.find("Element descriptions: "))
+    << output;
+  EXPECT_NE(std::string::npos, output.find("Approximate bytes: ")) << output;
+  EXPECT_NE(std::string::npos, output.find("  link\n")) << output;
+  EXPECT_NE(std::string::npos, output.find("  model\n")) << output;
+}
+
+/////////////////////////////////////////////////
+TEST(MemoryCmd, IGN_UTILS_TEST_DISABLED_ON_WIN32(MissingFile))
+{
+  const std::string output =
+    custom_exec_str(IgnCommand() + " sdf -m missing_file.sdf" + SdfVersion());
+  EXPECT_NE(std::string::npos, output.find("does not exist")) << output;
+}
+
+/////////////////////////////////////////////////
+TEST(ProfileCmd, IGN_UTILS_TEST_DISABLED_ON_WIN32(Model))
+{
+  const std::string path = std::string(PROJECT_SOURCE_PATH) +
+    "/test/integration/model/double_pendulum.sdf";
+
+  const std::string output = custom_exec_str(IgnCommand() +
+      " sdf --profile " + path + " -n 2" + SdfVersion());
+
+  EXPECT_NE(std::string::npos,
+            output.find("Loaded [" + path + "] 2 times: ")) << output;
+  EXPECT_NE(std::string::npos, output.find("  xml_parse ")) << output;
+  EXPECT_NE(std::string::npos, output.find("  validation ")) << output;
+  EXPECT_NE(std::string::npos, output.find("Included files, per load"))
+    << output;
+  EXPECT_NE(std::string::npos, output.find("Peak resident memory: "))
+    << output;
+  EXPECT_NE(std::string::npos, output.find("Counters, per load:")) << output;
+}
+
+/////////////////////////////////////////////////
+TEST(ProfileCmd, IGN_UTILS_TEST_DISABLED_ON_WIN32(MissingFile))
+{
+  const std::string output = custom_exec_str(IgnCommand() +
+      " sdf --profile missing_file.sdf" + SdfVersion());
+  EXPECT_NE(std::string::npos, output.find("does not exist")) << output;
+}
+
+/////////////////////////////////////////////////
+TEST(PackCmd, IGN_UTILS_TEST_DISABLED_ON_WIN32(ModelDirectory))
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string dir = sdf::filesystem::append(tmpDir, "pack_cmd");
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const std::string bundle = sdf::filesystem::append(dir, "box.sdfb");
+  const std::string modelDir =
+      std::string(PROJECT_SOURCE_PATH) + "/test/integration/model/box";
+
+  std::string output = custom_exec_str(IgnCommand() + " sdf --pack " +
+      modelDir + " " + bundle + SdfVersion());
+  EXPECT_NE(output.find("Packed 2 files into [" + bundle + "]."),
+            std::string::npos) << output;
+
+  // The document of the bundle is checked.
+  output = custom_exec_str(IgnCommand() + " sdf -k " + bundle + SdfVersion());
+  EXPECT_EQ("Valid.\n", output) << output;
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -15,14 +15,23 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <cstdlib>
+#include <fstream>
 #include <map>
+#include <mutex>
 #include <set>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <ignition/math/SemanticVersion.hh>
+#include <ignition/math/Vector3.hh>
 
 #include "sdf/Console.hh"
 #include "sdf/Filesystem.hh"
@@ -31,6 +40,7 @@
 #include "sdf/Link.hh"
 #include "sdf/Model.hh"
 #include "sdf/Param.hh"
+#include "sdf/ResourceProvider.hh"
 #include "sdf/Root.hh"
 #include "sdf/SDFImpl.hh"
 #include "sdf/World.hh"
@@ -38,11 +48,25 @@
 #include "sdf/ParserConfig.hh"
 #include "sdf/sdf_config.h"
 
+#include "BinarySdf.hh"
 #include "Converter.hh"
+#include "DocumentFormat.hh"
+#include "EmbeddedSdf.hh"
+#include "FindFileRequests.hh"
 #include "FrameSemantics.hh"
+#include "IncludeCache.hh"
+#include "LoadMonitor.hh"
+#include "ModelConfigCache.hh"
 #include "ParamPassing.hh"
+#include "ParamValueChecks.hh"
 #include "ScopedGraph.hh"
+#include "ScopedLoadPhase.hh"
+#include "ScopedTraceEvent.hh"
+#include "StreamedDocument.hh"
+#include "UpgradedFile.hh"
 #include "Utils.hh"
+#include "XmlDocumentPool.hh"
+#include "XmlUtils.hh"
 #include "parser_private.hh"
 #include "parser_urdf.hh"
 
@@ -85,6 +109,73 @@ struct SourceLocation
     }
   }
 };
+
+//////////////////////////////////////////////////
+/// Holds the result of resolving and reading the file referenced by an
+/// <include> element. Errors are stored instead of being reported directly so
+/// that files can be loaded on other threads and the errors reported in
+/// document order.
+struct IncludeLoadResult
+{
+  /// \brief Resolved name of the included file.
+  public: std::string fileName;
+
+  /// \brief True if the URI of the include was resolved.
+  public: bool resolved = false;
+
+  /// \brief Errors found while resolving the URI.
+  public: Errors resolveErrors;
+
+  /// \brief The parsed file, or nullptr if the file is left to a custom
+  /// model parser.
+  public: SDFPtr sdf;
+
+  /// \brief True if the file was read successfully.
+  public: bool read = false;
+
+  /// \brief Errors found while reading the file.
+  public: Errors readErrors;
+};
+
+/// \brief True on threads that load included files concurrently. Includes
+/// nested inside those files are loaded serially.
+thread_local bool tLoadingIncludeConcurrently = false;
+
+/// \brief False while a thread reads a document whose elements cannot be
+/// deprecated, or whose deprecated elements are not reported, in which case
+/// readXml does not check the elements it reads.
+thread_local bool tCheckDeprecatedElements = true;
+
+//////////////////////////////////////////////////
+/// \brief Enables or disables, for the lifetime of this object, the checks
+/// of readXml for deprecated elements on the calling thread. The previous
+/// setting is restored when the scope ends.
+class ScopedDeprecationChecks
+{
+  /// \brief Constructor.
+  /// \param[in] _enable True to check for deprecated elements.
+  public: explicit ScopedDeprecationChecks(bool _enable)
+    : previous(tCheckDeprecatedElements)
+  {
+    tCheckDeprecatedElements = _enable;
+  }
+
+  /// \brief Destructor. Restores the previous setting.
+  public: ~ScopedDeprecationChecks()
+  {
+    tCheckDeprecatedElements = this->previous;
+  }
+
+  /// \brief No copy constructor.
+  public: ScopedDeprecationChecks(const ScopedDeprecationChecks &) = delete;
+
+  /// \brief No copy assignment.
+  public: ScopedDeprecationChecks &operator=(
+              const ScopedDeprecationChecks &) = delete;
+
+  /// \brief Setting that was active when this object was created.
+  private: bool previous;
+};
 }
 //////////////////////////////////////////////////
 /// \brief Internal helper for readFile, which populates the SDF values
@@ -119,7 +210,7 @@ bool readFileInternal(
 /// \param[out] _errors Parsing errors will be appended to this variable.
 /// \return True if successful.
 bool readStringInternal(
-    const std::string &_xmlString,
+    std::string_view _xmlString,
     const bool _convert,
     const ParserConfig &_config,
     SDFPtr _sdf,
@@ -153,6 +244,29 @@ static bool isSdfFile(const std::string &_fileName)
   return false;
 }
 
+//////////////////////////////////////////////////
+/// \brief Load an XML file into a document, reading it from the resource
+/// provider of a configuration if it has one.
+/// \param[in] _filename Path of the file.
+/// \param[in] _config Parser configuration.
+/// \param[out] _xmlDoc Document to load the file into.
+/// \return XML_SUCCESS if the file was read and parsed.
+static tinyxml2::XMLError loadXmlFile(const std::string &_filename,
+    const ParserConfig &_config, tinyxml2::XMLDocument &_xmlDoc)
+{
+  auto provider = _config.GetResourceProvider();
+  if (!provider)
+    return _xmlDoc.LoadFile(_filename.c_str());
+
+  ResourceData contents;
+  if (!provider->Read(_filename, contents))
+  {
+    _xmlDoc.Clear();
+    return tinyxml2::XML_ERROR_FILE_NOT_FOUND;
+  }
+  return _xmlDoc.Parse(contents.data.data(), contents.data.size());
+}
+
 //////////////////////////////////////////////////
 template <typename TPtr>
 static inline bool _initFile(const std::string &_filename,
@@ -170,6 +284,108 @@ static inline bool _initFile(const std::string &_filename,
   return initDoc(&xmlDoc, _config, _sdf);
 }
 
+//////////////////////////////////////////////////
+/// \brief Find a child element by type and name attribute.
+/// \param[in] _parent The parent element.
+/// \param[in] _type Type of the child, such as "link".
+/// \param[in] _name Name attribute of the child.
+/// \return The first matching child, or nullptr if there is none.
+static sdf::ElementPtr findChildElement(const sdf::ElementPtr &_parent,
+                                        const std::string &_type,
+                                        std::string_view _name)
+{
+  for (const ElementPtr &child : _parent->Children(_type))
+  {
+    if (child->Get<std::string>("name") == _name)
+      return child;
+  }
+  return nullptr;
+}
+
+//////////////////////////////////////////////////
+/// \brief Find the canonical link of a model element, with the rules of
+/// Model::CanonicalLinkAndRelativeName, without loading the model.
+/// \param[in] _model The <model> element.
+/// \param[out] _name Name of the canonical link relative to the model.
+/// \return False if the canonical link can only be found by loading the
+/// model, such as when it has no links, or when its first nested model may
+/// be an interface model.
+static bool findCanonicalLinkName(const sdf::ElementPtr &_model,
+                                  std::string &_name)
+{
+  const std::string canonicalLink =
+      _model->Get<std::string>("canonical_link", "").first;
+  if (!canonicalLink.empty())
+  {
+    // Check that the link exists, so that an invalid name is reported by
+    // the model.
+    sdf::ElementPtr elem = _model;
+    ScopedName name(canonicalLink);
+    while (nullptr != elem && name.IsScoped())
+    {
+      elem = findChildElement(elem, "model", name.FirstSegment());
+      name = name.WithoutFirstSegment();
+    }
+    if (nullptr == elem ||
+        nullptr == findChildElement(elem, "link", name.FirstSegment()))
+    {
+      return false;
+    }
+    _name = canonicalLink;
+    return true;
+  }
+
+  // Links come first, then the interface links and models that custom
+  // parsers may add for <include> elements, then nested models.
+  if (sdf::ElementPtr link = _model->FindElement("link"))
+  {
+    _name = link->Get<std::string>("name");
+    return true;
+  }
+  if (_model->HasElement("include"))
+    return false;
+
+  sdf::ElementPtr firstModel = _model->FindElement("model");
+  std::string nestedName;
+  if (nullptr == firstModel || !findCanonicalLinkName(firstModel, nestedName))
+    return false;
+
+  _name = JoinName(firstModel->Get<std::string>("name"), nestedName);
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Read what a merge-include needs to know about the frame of the
+/// included model directly from its element, without loading the model
+/// into a DOM and building its graphs. The elements of the included model
+/// are validated anyway when they are loaded as part of the parent model.
+/// \param[in] _model The included <model> element.
+/// \param[out] _name Name of the model.
+/// \param[out] _canonicalLink Name of the canonical link relative to the
+/// model.
+/// \param[out] _pose Raw pose of the model.
+/// \param[out] _relativeTo The //model/pose/@relative_to frame.
+/// \return False if the model has to be loaded to find these values, such
+/// as when it has a placement frame, or when it is invalid.
+static bool readMergedModelFrame(const sdf::ElementPtr &_model,
+                                 std::string &_name,
+                                 std::string &_canonicalLink,
+                                 ignition::math::Pose3d &_pose,
+                                 std::string &_relativeTo)
+{
+  if (!_model->Get<std::string>("placement_frame", "").first.empty())
+    return false;
+
+  if (!findCanonicalLinkName(_model, _canonicalLink))
+    return false;
+
+  _name = _model->Get<std::string>("name");
+  _pose = ignition::math::Pose3d::Zero;
+  _relativeTo.clear();
+  loadPose(_model, _pose, _relativeTo);
+  return true;
+}
+
 //////////////////////////////////////////////////
 /// Helper function to insert included elements into a parent element.
 /// \param[in] _includeSDF The SDFPtr corresponding to the included element
@@ -230,56 +446,64 @@ static void insertIncludedElement(sdf::SDFPtr _includeSDF,
     return;
   }
 
-  // Validate included model's frame semantics
-  // We create a throwaway sdf::Root object in order to validate the
-  // included entity.
-  sdf::Root includedRoot;
-  sdf::Errors includeDOMerrors = includedRoot.Load(_includeSDF, _config);
-  _errors.insert(_errors.end(), includeDOMerrors.begin(),
-                 includeDOMerrors.end());
+  std::string modelName;
+  std::string canonicalLinkName;
+  ignition::math::Pose3d modelPose;
+  std::string modelPoseRelativeTo;
+  if (!readMergedModelFrame(firstElem, modelName, canonicalLinkName,
+                            modelPose, modelPoseRelativeTo))
+  {
+    // Validate included model's frame semantics
+    // We create a throwaway sdf::Root object in order to validate the
+    // included entity.
+    sdf::Root includedRoot;
+    sdf::Errors includeDOMerrors = includedRoot.Load(_includeSDF, _config);
+    _errors.insert(_errors.end(), includeDOMerrors.begin(),
+                   includeDOMerrors.end());
+
+    const sdf::Model *model = includedRoot.Model();
+    if (nullptr == model)
+    {
+      Error unsupportedError(ErrorCode::MERGE_INCLUDE_UNSUPPORTED,
+                             "Included model is invalid. Skipping model.");
+      _sourceLoc.SetSourceLocationOnError(unsupportedError);
+      _errors.push_back(unsupportedError);
+      return;
+    }
 
-  const sdf::Model *model = includedRoot.Model();
-  if (nullptr == model)
-  {
-    Error unsupportedError(ErrorCode::MERGE_INCLUDE_UNSUPPORTED,
-                           "Included model is invalid. Skipping model.");
-    _sourceLoc.SetSourceLocationOnError(unsupportedError);
-    _errors.push_back(unsupportedError);
-    return;
+    modelName = model->Name();
+
+    // Determine the canonical link so the proxy frame can be attached to it
+    canonicalLinkName = model->CanonicalLinkAndRelativeName().second;
+
+    modelPose = model->RawPose();
+    if (!model->PlacementFrameName().empty())
+    {
+      // M - model frame (__model__)
+      // R - The `relative_to` frame of the placement frame's //pose element.
+      // See resolveModelPoseWithPlacementFrame in FrameSemantics.cc for
+      // notation and documentation
+      ignition::math::Pose3d X_RM = model->RawPose();
+      sdf::Errors resolveErrors = model->SemanticPose().Resolve(X_RM);
+      _errors.insert(_errors.end(), resolveErrors.begin(),
+                     resolveErrors.end());
+      modelPose = X_RM;
+    }
+    modelPoseRelativeTo = model->PoseRelativeTo();
   }
 
   ElementPtr proxyModelFrame = _parent->AddElement("frame");
   const std::string proxyModelFrameName =
-      computeMergedModelProxyFrameName(model->Name());
+      computeMergedModelProxyFrameName(modelName);
 
   proxyModelFrame->GetAttribute("name")->Set(proxyModelFrameName);
-
-  // Determine the canonical link so the proxy frame can be attached to it
-  const std::string canonicalLinkName =
-      model->CanonicalLinkAndRelativeName().second;
-
   proxyModelFrame->GetAttribute("attached_to")->Set(canonicalLinkName);
 
-  auto modelPose = model->RawPose();
-  if (!model->PlacementFrameName().empty())
-  {
-    // M - model frame (__model__)
-    // R - The `relative_to` frame of the placement frame's //pose element.
-    // See resolveModelPoseWithPlacementFrame in FrameSemantics.cc for
-    // notation and documentation
-    ignition::math::Pose3d X_RM = model->RawPose();
-    sdf::Errors resolveErrors = model->SemanticPose().Resolve(X_RM);
-    _errors.insert(_errors.end(), resolveErrors.begin(), resolveErrors.end());
-    modelPose = X_RM;
-  }
-
   ElementPtr proxyModelFramePose = proxyModelFrame->AddElement("pose");
   proxyModelFramePose->Set(modelPose);
 
   // Set the proxyModelFrame's //pose/@relative_to to the frame used in
   // //include/pose/@relative_to.
-  std::string modelPoseRelativeTo = model->PoseRelativeTo();
-
   // If empty, use "__model__", since leaving it empty would make it
   // relative_to the canonical link frame specified in //frame/@attached_to.
   if (modelPoseRelativeTo.empty())
@@ -367,6 +591,221 @@ static void insertIncludedElement(sdf::SDFPtr _includeSDF,
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Initialize an element description from a specification file that
+/// was pre-parsed when building the library. This is equivalent to calling
+/// initXml on the XML of the element, without parsing XML.
+/// \param[in] _schema The pre-parsed file.
+/// \param[in] _elem The element of the file to initialize from.
+/// \param[in] _config Custom parser configuration.
+/// \param[in,out] _sdf The element description to initialize.
+static void initSchema(const EmbeddedSchemaFile &_schema,
+                       const EmbeddedSchemaElement &_elem,
+                       const ParserConfig &_config,
+                       ElementPtr _sdf)
+{
+  if (_elem.ref)
+    _sdf->SetReferenceSDF(_elem.ref);
+
+  _sdf->SetName(_elem.name);
+  _sdf->SetRequired(_elem.required);
+
+  const std::string description =
+      _elem.description ? _elem.description : "";
+  if (_elem.type)
+  {
+    _sdf->AddValue(_elem.type, _elem.defaultValue,
+                   std::string(_elem.required) == "1", _elem.minValue,
+                   _elem.maxValue, description);
+  }
+
+  for (std::size_t i = 0; i < _elem.attributeCount; ++i)
+  {
+    const EmbeddedSchemaAttribute &attr =
+        _schema.attributes[_elem.firstAttribute + i];
+    _sdf->AddAttribute(attr.name, attr.type, attr.defaultValue,
+                       attr.required,
+                       attr.description ? attr.description : "");
+  }
+
+  if (_elem.description)
+    _sdf->SetDescription(description);
+
+  if (_elem.copyChildren)
+    _sdf->SetCopyChildren(true);
+
+  for (std::size_t i = 0; i < _elem.childCount; ++i)
+  {
+    const EmbeddedSchemaElement &child =
+        _schema.elements[_elem.firstChild + i];
+    ElementPtr element(new Element);
+    if (child.includeFilename)
+    {
+      initFile(child.includeFilename, _config, element);
+
+      // override description for include elements
+      if (child.description)
+        element->SetDescription(child.description);
+    }
+    else
+    {
+      initSchema(_schema, child, _config, element);
+    }
+    _sdf->AddElementDescription(element);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the element description of a specification file of the
+/// current version that was pre-parsed when building the library. The
+/// description is built once per process and shared by every caller, so it
+/// must not be modified; Element::Copy is used to initialize a new element
+/// from it, which shares its child element descriptions.
+/// \param[in] _filename Name of the file, such as "root.sdf".
+/// \param[in] _config Custom parser configuration.
+/// \return The shared element description, or nullptr if the file is not
+/// embedded.
+static ElementPtr embeddedSchema(const std::string &_filename,
+                                 const ParserConfig &_config)
+{
+  // Intentionally leaked so the descriptions remain valid during static
+  // destruction.
+  static auto *mutex = new std::mutex;
+  static auto *templates = new std::map<std::string, ElementPtr>;
+
+  // The ToElement functions look up a description for every entity they
+  // serialize, so each thread remembers the descriptions it has used and
+  // only takes the lock the first time it uses each one.
+  thread_local std::map<std::string, ElementPtr> threadTemplates;
+
+  const std::string pathname = SDF::Version() + "/" + _filename;
+  auto threadIt = threadTemplates.find(pathname);
+  if (threadIt != threadTemplates.end())
+    return threadIt->second;
+  {
+    std::lock_guard<std::mutex> lock(*mutex);
+    auto it = templates->find(pathname);
+    if (it != templates->end())
+    {
+      threadTemplates.emplace(pathname, it->second);
+      return it->second;
+    }
+  }
+
+  const EmbeddedSchemaFile *schema = GetEmbeddedSchema(pathname);
+  if (!schema)
+    return nullptr;
+
+  // The lock is not held while building, since included files are looked up
+  // recursively.
+  ElementPtr description(new Element);
+  initSchema(*schema, schema->elements[0], _config, description);
+
+  std::lock_guard<std::mutex> lock(*mutex);
+  description = templates->emplace(pathname, description).first->second;
+  threadTemplates.emplace(pathname, description);
+  return description;
+}
+
+//////////////////////////////////////////////////
+/// \brief Check whether an element of a pre-parsed specification file, or
+/// one of its descendants, is deprecated. Included files are not followed,
+/// since they are checked on their own.
+/// \param[in] _schema The pre-parsed file.
+/// \param[in] _elem The element of the file to check.
+/// \return True if an element is deprecated.
+static bool schemaHasDeprecatedElement(const EmbeddedSchemaFile &_schema,
+                                       const EmbeddedSchemaElement &_elem)
+{
+  if (!_elem.includeFilename && std::string_view(_elem.required) == "-1")
+    return true;
+
+  for (std::size_t i = 0; i < _elem.childCount; ++i)
+  {
+    if (schemaHasDeprecatedElement(
+          _schema, _schema.elements[_elem.firstChild + i]))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the specification versions that have a deprecated element.
+/// The pre-parsed specification files are searched once per process.
+/// Versions whose files were not pre-parsed are included, since they are
+/// not known to be free of deprecated elements.
+/// \return Set of versions, such as "1.8".
+static const std::set<std::string> &versionsWithDeprecatedElements()
+{
+  static const std::set<std::string> versions = []()
+  {
+    std::set<std::string> result;
+    for (const EmbeddedSdfFile &file : GetEmbeddedSdf())
+    {
+      const std::string pathname(file.pathname);
+      const std::size_t slash = pathname.find('/');
+      if (slash == std::string::npos ||
+          pathname.size() < 4 ||
+          pathname.compare(pathname.size() - 4, 4, ".sdf") != 0)
+      {
+        continue;
+      }
+
+      const EmbeddedSchemaFile *schema = GetEmbeddedSchema(pathname);
+      if (!schema || schemaHasDeprecatedElement(*schema, schema->elements[0]))
+        result.insert(pathname.substr(0, slash));
+    }
+    return result;
+  }();
+  return versions;
+}
+
+//////////////////////////////////////////////////
+/// \brief Check whether readXml has to look for deprecated elements while
+/// it reads a document into an element. This is not needed if the
+/// deprecated elements policy drops the condition, or if the element
+/// descriptions are those of a specification file of the current version,
+/// which has no deprecated element. Custom descriptions are always checked.
+/// \param[in] _sdf The element that the document is read into.
+/// \param[in] _filename Name of the specification file that _sdf would be
+/// initialized from, such as "root.sdf".
+/// \param[in] _config Custom parser configuration.
+/// \return True if the elements have to be checked.
+static bool checkDeprecatedElements(const ElementPtr &_sdf,
+                                    const std::string &_filename,
+                                    const ParserConfig &_config)
+{
+  if (!isPolicyConditionReported(_config.DeprecatedElementsPolicy()))
+    return false;
+
+  if (_sdf->GetRequired() == "-1" ||
+      versionsWithDeprecatedElements().count(SDF::Version()) > 0)
+  {
+    return true;
+  }
+
+  // The child descriptions of the specification are shared with the
+  // elements initialized from it, and are never modified.
+  ElementPtr description = embeddedSchema(_filename, _config);
+  if (!description || description->GetElementDescriptionCount() !=
+      _sdf->GetElementDescriptionCount())
+  {
+    return true;
+  }
+  for (unsigned int i = 0; i < description->GetElementDescriptionCount();
+       ++i)
+  {
+    if (description->GetElementDescription(i) !=
+        _sdf->GetElementDescription(i))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 //////////////////////////////////////////////////
 bool init(SDFPtr _sdf)
 {
@@ -376,6 +815,12 @@ bool init(SDFPtr _sdf)
 //////////////////////////////////////////////////
 bool init(SDFPtr _sdf, const ParserConfig &_config)
 {
+  if (ElementPtr description = embeddedSchema("root.sdf", _config))
+  {
+    _sdf->Root()->Copy(description);
+    return true;
+  }
+
   std::string xmldata = SDF::EmbeddedSpec("root.sdf", false);
   auto xmlDoc = makeSdfDoc();
   xmlDoc.Parse(xmldata.c_str());
@@ -392,6 +837,12 @@ bool initFile(const std::string &_filename, SDFPtr _sdf)
 bool initFile(
     const std::string &_filename, const ParserConfig &_config, SDFPtr _sdf)
 {
+  if (ElementPtr description = embeddedSchema(_filename, _config))
+  {
+    _sdf->Root()->Copy(description);
+    return true;
+  }
+
   std::string xmldata = SDF::EmbeddedSpec(_filename, true);
   if (!xmldata.empty())
   {
@@ -413,6 +864,12 @@ bool initFile(const std::string &_filename, ElementPtr _sdf)
 bool initFile(
     const std::string &_filename, const ParserConfig &_config, ElementPtr _sdf)
 {
+  if (ElementPtr description = embeddedSchema(_filename, _config))
+  {
+    _sdf->Copy(description);
+    return true;
+  }
+
   std::string xmldata = SDF::EmbeddedSpec(_filename, true);
   if (!xmldata.empty())
   {
@@ -721,7 +1178,8 @@ bool readFileWithoutConversion(const std::string &_filename,
 bool readFileInternal(const std::string &_filename, const bool _convert,
     const ParserConfig &_config, SDFPtr _sdf, Errors &_errors)
 {
-  auto xmlDoc = makeSdfDoc();
+  ScopedTraceEvent event(_config, "readFile", "parser", _filename);
+  auto xmlDoc = XmlDocumentPool::Acquire(_config);
   std::string filename = sdf::findFile(_filename, true, true, _config);
 
   if (filename.empty())
@@ -730,47 +1188,151 @@ bool readFileInternal(const std::string &_filename, const bool _convert,
     return false;
   }
 
-  if (filesystem::is_directory(filename))
+  if (resourceIsDirectory(_config, filename))
   {
-    filename = getModelFilePath(filename);
+    filename = getModelFilePath(filename, _config);
   }
 
-  if (!filesystem::exists(filename))
+  if (!resourceExists(_config, filename))
   {
     sdferr << "File [" << filename << "] doesn't exist.\n";
     return false;
   }
 
-  auto error_code = xmlDoc.LoadFile(filename.c_str());
-  if (error_code)
+  // Files that were upgraded by `ign sdf --upgrade` are read from their
+  // upgraded copies, which do not need to be converted. Upgraded copies are
+  // only written to the filesystem.
+  const auto provider = _config.GetResourceProvider();
+  if (_convert && _config.UseUpgradedFiles() && !provider)
+  {
+    filename = preferredFilePath(filename);
+  }
+
+  // A file of a resource provider is read once, for all the steps below.
+  ResourceData contents;
+  if (provider && !provider->Read(filename, contents))
   {
-    sdferr << "Error parsing XML in file [" << filename << "]: "
-           << xmlDoc.ErrorStr() << '\n';
+    sdferr << "Unable to read file [" << filename << "].\n";
     return false;
   }
 
-  // Suppress deprecation for sdf::URDF2SDF
-  if (readDoc(&xmlDoc, _sdf, filename, _convert, _config, _errors))
+  // Find out the format and version of the file from its first bytes, so
+  // that it is read by the right pipeline without parsing it first.
+  const DocumentInfo info = provider ?
+      sniffDocument(contents.data.substr(0, kDocumentSniffSize)) :
+      sniffFile(filename);
+  if (info.format == DocumentFormat::USD)
   {
-    return true;
+    sdferr << "File [" << filename << "] is a USD file, which cannot be "
+           << "read as SDFormat.\n";
+    return false;
   }
-  else if (URDF2SDF::IsURDF(filename))
+
+  // Binary documents are decoded into elements without parsing text. They
+  // are always in the version of the specification of this library.
+  if (info.format == DocumentFormat::BINARY_SDF)
   {
-    URDF2SDF u2g;
-    auto doc = makeSdfDoc();
-    u2g.InitModelFile(filename, _config, &doc);
-    if (sdf::readDoc(&doc, _sdf, "urdf file", _convert, _config, _errors))
+    std::string buffer;
+    if (!provider)
     {
-      sdfdbg << "parse from urdf file [" << _filename << "].\n";
-      return true;
+      std::ifstream file(filename, std::ios::binary);
+      if (!file)
+      {
+        sdferr << "Unable to read file [" << filename << "].\n";
+        return false;
+      }
+      std::ostringstream stream;
+      stream << file.rdbuf();
+      buffer = stream.str();
+    }
+
+    if (LoadMonitor *monitor = LoadMonitor::Of(_config))
+      monitor->FileParsed();
+    ScopedLoadPhase phase(_config, LoadPhase::READ_XML);
+    return BinarySdf::Decode(provider ? contents.data : buffer, filename,
+                             _config, _sdf, _errors);
+  }
+
+  if (info.format != DocumentFormat::URDF)
+  {
+    // Read the top-level models of worlds one at a time when requested. The
+    // converter needs the whole document, so files that must be converted
+    // are loaded as a whole, and so are files that cannot be scanned, so
+    // that their XML errors are reported by tinyxml2.
+    StreamedDocument streamedDoc;
+    bool streamed = false;
+    if (!provider && _config.StreamWorldModels() &&
+        (!_convert || info.version.empty() ||
+         info.version == SDF::Version()) &&
+        streamedDoc.Open(filename) && streamedDoc.FragmentCount() > 0)
+    {
+      ScopedLoadPhase phase(_config, LoadPhase::XML_PARSE);
+      xmlDoc->Parse(streamedDoc.Skeleton().c_str(),
+                   streamedDoc.Skeleton().size());
+      streamedDoc.ReleaseSkeleton();
+      const tinyxml2::XMLElement *sdfNode = xmlDoc->FirstChildElement("sdf");
+      streamed = !xmlDoc->Error() && sdfNode &&
+          sdfNode->Attribute("version") &&
+          (!_convert || SDF::Version() == sdfNode->Attribute("version"));
+    }
+
+    if (!streamed)
+    {
+      ScopedLoadPhase phase(_config, LoadPhase::XML_PARSE);
+      auto error_code = provider ?
+          xmlDoc->Parse(contents.data.data(), contents.data.size()) :
+          xmlDoc->LoadFile(filename.c_str());
+      if (error_code)
+      {
+        sdferr << "Error parsing XML in file [" << filename << "]: "
+               << xmlDoc->ErrorStr() << '\n';
+        return false;
+      }
     }
-    else
+
+    if (LoadMonitor *monitor = LoadMonitor::Of(_config))
+      monitor->FileParsed();
+
+    bool result = false;
+    {
+      ScopedStreamedDocument streamedScope(streamed ? &streamedDoc : nullptr);
+      result = readDoc(xmlDoc.Get(), _sdf, filename, _convert, _config,
+                       _errors);
+    }
+
+    // Only documents whose root element is not known to be <sdf> can still
+    // be URDF files.
+    if (result || info.format != DocumentFormat::UNKNOWN)
+    {
+      return result;
+    }
+  }
+
+  // Read and parse the file as URDF only once, reusing the parsed model for
+  // the conversion.
+  URDF2SDF u2g;
+  auto doc = makeSdfDoc();
+  {
+    ScopedLoadPhase phase(_config, LoadPhase::URDF_CONVERSION);
+    if (!u2g.InitModelFileIfURDF(filename, _config, &doc))
     {
-      sdferr << "parse as old deprecated model file failed.\n";
       return false;
     }
   }
 
+  if (info.format == DocumentFormat::URDF)
+  {
+    if (LoadMonitor *monitor = LoadMonitor::Of(_config))
+      monitor->FileParsed();
+  }
+
+  if (sdf::readDoc(&doc, _sdf, "urdf file", _convert, _config, _errors))
+  {
+    sdfdbg << "parse from urdf file [" << _filename << "].\n";
+    return true;
+  }
+
+  sdferr << "parse as old deprecated model file failed.\n";
   return false;
 }
 
@@ -800,6 +1362,14 @@ bool readString(const std::string &_xmlString, const ParserConfig &_config,
   return readStringInternal(_xmlString, true, _config, _sdf, _errors);
 }
 
+//////////////////////////////////////////////////
+bool readString(const char *_data, std::size_t _size,
+    const ParserConfig &_config, SDFPtr _sdf, Errors &_errors)
+{
+  return readStringInternal(std::string_view(_data, _size), true, _config,
+                            _sdf, _errors);
+}
+
 //////////////////////////////////////////////////
 bool readStringWithoutConversion(
     const std::string &_filename, SDFPtr _sdf, Errors &_errors)
@@ -816,40 +1386,57 @@ bool readStringWithoutConversion(const std::string &_filename,
 }
 
 //////////////////////////////////////////////////
-bool readStringInternal(const std::string &_xmlString, const bool _convert,
+bool readStringInternal(std::string_view _xmlString, const bool _convert,
     const ParserConfig &_config, SDFPtr _sdf, Errors &_errors)
 {
-  auto xmlDoc = makeSdfDoc();
-  xmlDoc.Parse(_xmlString.c_str());
-  if (xmlDoc.Error())
-  {
-    sdferr << "Error parsing XML from string: " << xmlDoc.ErrorStr() << '\n';
-    return false;
-  }
-  if (readDoc(&xmlDoc, _sdf, std::string(kSdfStringSource), _convert, _config,
-              _errors))
+  ScopedTraceEvent event(_config, "readString", "parser");
+  // URDF strings are parsed by the URDF converter only.
+  const DocumentInfo info = sniffDocument(_xmlString);
+  if (info.format == DocumentFormat::BINARY_SDF)
   {
-    return true;
+    ScopedLoadPhase phase(_config, LoadPhase::READ_XML);
+    return BinarySdf::Decode(_xmlString, std::string(kSdfStringSource),
+                             _config, _sdf, _errors);
   }
-  else
+  if (info.format != DocumentFormat::URDF)
   {
-    URDF2SDF u2g;
-    auto doc = makeSdfDoc();
-    u2g.InitModelString(_xmlString, _config, &doc);
-
-    if (sdf::readDoc(&doc, _sdf, std::string(kUrdfStringSource), _convert,
-                    _config, _errors))
+    auto xmlDoc = XmlDocumentPool::Acquire(_config);
+    {
+      ScopedLoadPhase phase(_config, LoadPhase::XML_PARSE);
+      xmlDoc->Parse(_xmlString.data(), _xmlString.size());
+    }
+    if (xmlDoc->Error())
+    {
+      sdferr << "Error parsing XML from string: " << xmlDoc->ErrorStr()
+             << '\n';
+      return false;
+    }
+    if (readDoc(xmlDoc.Get(), _sdf, std::string(kSdfStringSource), _convert,
+                _config, _errors))
     {
-      sdfdbg << "Parsing from urdf.\n";
       return true;
     }
-    else
+    else if (info.format != DocumentFormat::UNKNOWN)
     {
-      sdferr << "parse as old deprecated model file failed.\n";
       return false;
     }
   }
 
+  URDF2SDF u2g;
+  auto doc = makeSdfDoc();
+  {
+    ScopedLoadPhase phase(_config, LoadPhase::URDF_CONVERSION);
+    u2g.InitModelString(_xmlString, _config, &doc);
+  }
+
+  if (sdf::readDoc(&doc, _sdf, std::string(kUrdfStringSource), _convert,
+                  _config, _errors))
+  {
+    sdfdbg << "Parsing from urdf.\n";
+    return true;
+  }
+
+  sdferr << "parse as old deprecated model file failed.\n";
   return false;
 }
 
@@ -876,14 +1463,17 @@ bool readString(const std::string &_xmlString, ElementPtr _sdf, Errors &_errors)
 bool readString(const std::string &_xmlString, const ParserConfig &_config,
     ElementPtr _sdf, Errors &_errors)
 {
-  auto xmlDoc = makeSdfDoc();
-  xmlDoc.Parse(_xmlString.c_str());
-  if (xmlDoc.Error())
+  auto xmlDoc = XmlDocumentPool::Acquire(_config);
   {
-    sdferr << "Error parsing XML from string: " << xmlDoc.ErrorStr() << '\n';
+    ScopedLoadPhase phase(_config, LoadPhase::XML_PARSE);
+    xmlDoc->Parse(_xmlString.c_str());
+  }
+  if (xmlDoc->Error())
+  {
+    sdferr << "Error parsing XML from string: " << xmlDoc->ErrorStr() << '\n';
     return false;
   }
-  if (readDoc(&xmlDoc, _sdf, std::string(kSdfStringSource), true, _config,
+  if (readDoc(xmlDoc.Get(), _sdf, std::string(kSdfStringSource), true, _config,
               _errors))
   {
     return true;
@@ -952,13 +1542,15 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, SDFPtr _sdf,
         && strcmp(sdfNode->Attribute("version"), SDF::Version().c_str()) != 0)
     {
       sdfdbg << "Converting a deprecated source[" << _source << "].\n";
+      ScopedLoadPhase phase(_config, LoadPhase::CONVERSION);
       Converter::Convert(_xmlDoc, SDF::Version());
     }
 
     auto *elemXml = _xmlDoc->FirstChildElement(_sdf->Root()->GetName().c_str());
 
     // Perform all the pre-checks necessary for the XML elements before reading
-    if (!checkXmlFromRoot(elemXml, _source, _errors))
+    if (ScopedLoadPhase phase(_config, LoadPhase::VALIDATION);
+        !checkXmlFromRoot(elemXml, _source, _errors))
     {
       _errors.push_back({ErrorCode::ELEMENT_INVALID,
           "Errors were found when checking the XML of element<"
@@ -967,7 +1559,12 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, SDFPtr _sdf,
     }
 
     // parse new sdf xml
-    if (!readXml(elemXml, _sdf->Root(), _config, _source, _errors))
+    ScopedParamValueChecks valueChecks(
+        _config.GetValidationLevel() == ValidationLevel::FULL);
+    ScopedDeprecationChecks deprecationChecks(
+        checkDeprecatedElements(_sdf->Root(), "root.sdf", _config));
+    if (ScopedLoadPhase phase(_config, LoadPhase::READ_XML);
+        !readXml(elemXml, _sdf->Root(), _config, _source, _errors))
     {
       _errors.push_back({ErrorCode::ELEMENT_INVALID,
           "Error reading element <" + _sdf->Root()->GetName() + ">"});
@@ -976,7 +1573,9 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, SDFPtr _sdf,
 
     // delimiter '::' in element names not allowed in SDFormat >= 1.8
     ignition::math::SemanticVersion sdfVersion(_sdf->Root()->OriginalVersion());
-    if (sdfVersion >= ignition::math::SemanticVersion(1, 8)
+    if (ScopedLoadPhase phase(_config, LoadPhase::VALIDATION);
+        _config.GetValidationLevel() != ValidationLevel::NONE
+        && sdfVersion >= ignition::math::SemanticVersion(1, 8)
         && !recursiveSiblingNoDoubleColonInNames(_sdf->Root()))
     {
       _errors.push_back({ErrorCode::RESERVED_NAME,
@@ -1042,6 +1641,7 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, ElementPtr _sdf,
     {
       sdfdbg << "Converting a deprecated SDF source[" << _source << "].\n";
 
+      ScopedLoadPhase phase(_config, LoadPhase::CONVERSION);
       Converter::Convert(_xmlDoc, SDF::Version());
     }
 
@@ -1053,7 +1653,8 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, ElementPtr _sdf,
     }
 
     // Perform all the pre-checks necessary for the XML elements before reading
-    if (!checkXmlFromRoot(elemXml, _source, _errors))
+    if (ScopedLoadPhase phase(_config, LoadPhase::VALIDATION);
+        !checkXmlFromRoot(elemXml, _source, _errors))
     {
       _errors.push_back({ErrorCode::ELEMENT_INVALID,
           "Errors were found when checking the XML of element["
@@ -1062,7 +1663,12 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, ElementPtr _sdf,
     }
 
     // parse new sdf xml
-    if (!readXml(elemXml, _sdf, _config, _source, _errors))
+    ScopedParamValueChecks valueChecks(
+        _config.GetValidationLevel() == ValidationLevel::FULL);
+    ScopedDeprecationChecks deprecationChecks(
+        checkDeprecatedElements(_sdf, _sdf->GetName() + ".sdf", _config));
+    if (ScopedLoadPhase phase(_config, LoadPhase::READ_XML);
+        !readXml(elemXml, _sdf, _config, _source, _errors))
     {
       _errors.push_back({ErrorCode::ELEMENT_INVALID,
           "Unable to parse sdf element["+ _sdf->GetName() + "]"});
@@ -1071,7 +1677,9 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, ElementPtr _sdf,
 
     // delimiter '::' in element names not allowed in SDFormat >= 1.8
     ignition::math::SemanticVersion sdfVersion(_sdf->OriginalVersion());
-    if (sdfVersion >= ignition::math::SemanticVersion(1, 8)
+    if (ScopedLoadPhase phase(_config, LoadPhase::VALIDATION);
+        _config.GetValidationLevel() != ValidationLevel::NONE
+        && sdfVersion >= ignition::math::SemanticVersion(1, 8)
         && !recursiveSiblingNoDoubleColonInNames(_sdf))
     {
       _errors.push_back({ErrorCode::RESERVED_NAME,
@@ -1203,16 +1811,31 @@ std::string getBestSupportedModelVersion(tinyxml2::XMLElement *_modelXML,
 //////////////////////////////////////////////////
 std::string getModelFilePath(const std::string &_modelDirPath)
 {
+  return getModelFilePath(_modelDirPath, ParserConfig::GlobalConfig());
+}
+
+//////////////////////////////////////////////////
+std::string getModelFilePath(const std::string &_modelDirPath,
+                             const ParserConfig &_config)
+{
+  // The cache checks the modification times of files on the filesystem.
+  auto cache = _config.GetResourceProvider() ?
+      nullptr : ModelConfigCache::Of(_config);
+  std::string modelFilePath;
+  std::string version;
+  if (cache && cache->Find(_modelDirPath, modelFilePath, version))
+    return modelFilePath;
+
   std::string configFilePath;
 
   /// \todo This hardcoded bit is very Gazebo centric. It should
   /// be abstracted away, possibly through a plugin to SDF.
   configFilePath = sdf::filesystem::append(_modelDirPath, "model.config");
-  if (!sdf::filesystem::exists(configFilePath))
+  if (!resourceExists(_config, configFilePath))
   {
     // We didn't find model.config, look for manifest.xml instead
     configFilePath = sdf::filesystem::append(_modelDirPath, "manifest.xml");
-    if (!sdf::filesystem::exists(configFilePath))
+    if (!resourceExists(_config, configFilePath))
     {
       // We didn't find manifest.xml either, output an error and get out.
       sdferr << "Could not find model.config or manifest.xml in ["
@@ -1229,7 +1852,8 @@ std::string getModelFilePath(const std::string &_modelDirPath)
   }
 
   auto configFileDoc = makeSdfDoc();
-  if (tinyxml2::XML_SUCCESS != configFileDoc.LoadFile(configFilePath.c_str()))
+  if (tinyxml2::XML_SUCCESS !=
+      loadXmlFile(configFilePath, _config, configFileDoc))
   {
     sdferr << "Error parsing XML in file ["
            << configFilePath << "]: "
@@ -1246,12 +1870,16 @@ std::string getModelFilePath(const std::string &_modelDirPath)
   }
 
   std::string modelFileName;
-  if (getBestSupportedModelVersion(modelXML, modelFileName).empty())
+  version = getBestSupportedModelVersion(modelXML, modelFileName);
+  if (version.empty())
   {
     return std::string();
   }
 
-  return sdf::filesystem::append(_modelDirPath, modelFileName);
+  modelFilePath = sdf::filesystem::append(_modelDirPath, modelFileName);
+  if (cache)
+    cache->Insert(_modelDirPath, configFilePath, modelFilePath, version);
+  return modelFilePath;
 }
 
 //////////////////////////////////////////////////
@@ -1298,9 +1926,13 @@ static bool readAttributes(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
       continue;
     }
 
-    // Construct the Xml path of the current attribute
-    const std::string attributeXmlPath = _sdf->XmlPath() + "[@" +
-        attribute->Name() + "=\"" + attribute->Value() + "\"]";
+    // Construct the Xml path of the current attribute, only when it is
+    // given to an error
+    auto attributeXmlPath = [&_sdf, attribute]()
+    {
+      return _sdf->XmlPath() + "[@" + attribute->Name() + "=\"" +
+          attribute->Value() + "\"]";
+    };
 
     // Find the matching attribute in SDF
     for (i = 0; i < _sdf->GetAttributeCount(); ++i)
@@ -1319,18 +1951,21 @@ static bool readAttributes(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
                 "' is reserved; it cannot be used as a value of "
                 "attribute [" + p->GetKey() + "]",
                 _errorSourcePath, attribute->GetLineNum());
-            err.SetXmlPath(attributeXmlPath);
+            err.SetXmlPath(attributeXmlPath());
             _errors.push_back(err);
           }
         }
         // Set the value of the SDF attribute
-        if (!p->SetFromString(attribute->Value()))
+        const bool valueSet = _config.LazyParamParsing() ?
+            p->SetFromStringLazy(attribute->Value()) :
+            p->SetFromString(attribute->Value());
+        if (!valueSet)
         {
           Error err(
               ErrorCode::ATTRIBUTE_INVALID,
               "Unable to read attribute[" + p->GetKey() + "]",
               _errorSourcePath, attribute->GetLineNum());
-          err.SetXmlPath(attributeXmlPath);
+          err.SetXmlPath(attributeXmlPath());
           _errors.push_back(err);
           return false;
         }
@@ -1340,16 +1975,16 @@ static bool readAttributes(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
 
     if (i == _sdf->GetAttributeCount())
     {
-      std::stringstream ss;
-      ss << "XML Attribute[" << attribute->Name()
-              << "] in element[" << _xml->Value()
-              << "] not defined in SDF.\n";
-      Error err(
-          ErrorCode::ATTRIBUTE_INCORRECT_TYPE,
-          ss.str(), _errorSourcePath, _xml->GetLineNum());
-      err.SetXmlPath(attributeXmlPath);
-      enforceConfigurablePolicyCondition(
-          _config.WarningsPolicy(), err, _errors);
+      enforceConfigurablePolicyCondition(_config.WarningsPolicy(), [&]()
+      {
+        Error err(
+            ErrorCode::ATTRIBUTE_INCORRECT_TYPE,
+            "XML Attribute[{}] in element[{}] not defined in SDF.\n",
+            std::vector<std::string>{attribute->Name(), _xml->Value()},
+            _errorSourcePath, _xml->GetLineNum());
+        err.SetXmlPath(attributeXmlPath());
+        return err;
+      }, _errors);
     }
 
     attribute = attribute->Next();
@@ -1409,10 +2044,10 @@ static bool resolveFileNameFromUri(tinyxml2::XMLElement *_includeXml,
     }
     else
     {
-      if (sdf::filesystem::is_directory(modelPath))
+      if (resourceIsDirectory(_config, modelPath))
       {
         // Get the model.config filename
-        _fileName = getModelFilePath(modelPath);
+        _fileName = getModelFilePath(modelPath, _config);
 
         if (_fileName.empty())
         {
@@ -1466,7 +2101,7 @@ static void validateIncludeElement(tinyxml2::XMLElement *_xml,
   for (unsigned int descCounter = 0;
       descCounter != _sdf->GetElementDescriptionCount(); ++descCounter)
   {
-    ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
+    ElementConstPtr elemDesc = _sdf->GetElementDescription(descCounter);
     if (elemDesc->GetName() == _xml->Value())
     {
       ElementPtr element = elemDesc->Clone();
@@ -1485,18 +2120,308 @@ static void validateIncludeElement(tinyxml2::XMLElement *_xml,
 }
 
 //////////////////////////////////////////////////
-bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
-    const ParserConfig &_config, const std::string &_source, Errors &_errors)
+// Helper function called from readXml to resolve and read the file referenced
+// by an <include> element.
+/// \param[in] _includeXml Pointer to the TinyXML element that corresponds to
+/// the <include> element
+/// \param[in] _config Custom parser configuration
+/// \param[in] _includeXmlPath XML path of the <include> element
+/// \param[in] _source Source of the XML document
+/// \param[out] _result The resolved file name, the parsed file and the errors
+/// found while loading it.
+static void loadIncludeFile(tinyxml2::XMLElement *_includeXml,
+    const ParserConfig &_config, const std::string &_includeXmlPath,
+    const std::string &_source, IncludeLoadResult &_result)
 {
-  // Check if the element pointer is deprecated.
-  if (_sdf->GetRequired() == "-1")
+  ScopedLoadPhase phase(_config, LoadPhase::INCLUDE);
+  ScopedTraceEvent event(_config, "include", "parser");
+  _result.resolved = resolveFileNameFromUri(_includeXml, _config,
+      _includeXmlPath, _source, _result.fileName, _result.resolveErrors);
+  if (!_result.resolved)
+    return;
+  phase.SetIncludedFile(_result.fileName);
+  event.SetDetail(_result.fileName);
+
+  // If the file is not an SDFormat file, it is assumed that it will
+  // handled by a custom parser.
+  if (!sdf::isSdfFile(_result.fileName) &&
+      !_config.CustomModelParsers().empty())
   {
-    std::stringstream ss;
-    ss << "SDF Element[" + _sdf->GetName() + "] is deprecated\n";
-    Error err(ErrorCode::ELEMENT_DEPRECATED, ss.str());
-    err.SetXmlPath(_sdf->XmlPath());
-    enforceConfigurablePolicyCondition(
-        _config.DeprecatedElementsPolicy(), err, _errors);
+    return;
+  }
+
+  // The cache checks the modification times of files on the filesystem.
+  auto includeCache = _config.GetResourceProvider() ?
+      nullptr : IncludeCache::Of(_config);
+  if (includeCache &&
+      includeCache->Find(_result.fileName, _result.sdf, _result.readErrors))
+  {
+    _result.read = true;
+    return;
+  }
+
+  // NOTE: sdf::init is an expensive call. For performance reason,
+  // a new sdf pointer is created here by cloning a fresh sdf template
+  // pointer instead of calling init every iteration.
+  // SDFPtr includeSDF(new SDF);
+  // init(includeSDF, _config);
+  // The template is initialized once in a thread-safe way, so that
+  // documents can be read concurrently.
+  static const SDFPtr includeSDFTemplate = [&_config]()
+  {
+    SDFPtr sdfTemplate(new SDF);
+    init(sdfTemplate, _config);
+    return sdfTemplate;
+  }();
+  _result.sdf.reset(new SDF);
+  _result.sdf->Root(includeSDFTemplate->Root()->Clone());
+
+  _result.read =
+      readFile(_result.fileName, _config, _result.sdf, _result.readErrors);
+
+  if (includeCache && _result.read)
+  {
+    includeCache->Insert(_result.fileName, _result.sdf, _result.readErrors);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a child element is skipped by the element filters
+/// of a parser configuration.
+/// \param[in] _config Parser configuration.
+/// \param[in] _parentName Name of the parent of the element.
+/// \param[in] _xml XML of the element.
+/// \return True if the element is skipped.
+static bool isElementSkipped(const ParserConfig &_config,
+    const std::string &_parentName, const tinyxml2::XMLElement *_xml)
+{
+  const char *name = _xml->Value();
+  const std::vector<std::string> &skipped = _config.SkippedElements();
+  if (std::find(skipped.begin(), skipped.end(), name) != skipped.end())
+    return true;
+
+  const ParserConfig::ElementFilterFunction &filter = _config.ElementFilter();
+  if (!filter)
+    return false;
+
+  const char *type = _xml->Attribute("type");
+  return !filter(_parentName, name, type ? type : "");
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a top-level model of a world is outside the region
+/// of interest of a parser configuration.
+/// \param[in] _config Parser configuration.
+/// \param[in] _parent Element the model would be added to.
+/// \param[in] _xml XML of the <model> or <include> element.
+/// \return True if the model is placed outside the region of interest.
+static bool isOutsideRegionOfInterest(const ParserConfig &_config,
+    const ElementPtr &_parent, const tinyxml2::XMLElement *_xml)
+{
+  if (_parent->GetName() != "world")
+    return false;
+
+  const std::string_view name = _xml->Value();
+  if (name != "model" && name != "include")
+    return false;
+
+  const auto region = _config.RegionOfInterest();
+  if (!region)
+    return false;
+
+  ignition::math::Vector3d position = ignition::math::Vector3d::Zero;
+  if (const auto *poseXml = _xml->FirstChildElement("pose"))
+  {
+    // Only poses in the world frame can be evaluated before the model is
+    // read.
+    const char *relativeTo = poseXml->Attribute("relative_to");
+    if (relativeTo && *relativeTo && std::string_view(relativeTo) != "world")
+      return false;
+
+    if (poseXml->GetText())
+    {
+      std::istringstream stream(poseXml->GetText());
+      double x, y, z;
+      if (!(stream >> x >> y >> z))
+        return false;
+      position.Set(x, y, z);
+    }
+  }
+  return !region->Contains(position);
+}
+
+//////////////////////////////////////////////////
+// Helper function called from readXml to load the files referenced by the
+// <include> children of an element with the executor of the configuration.
+/// \param[in] _xml Pointer to the TinyXML element whose <include> children are
+/// loaded
+/// \param[in] _sdf SDF pointer to the parent of the <include> elements
+/// \param[in] _config Custom parser configuration
+/// \param[in] _source Source of the XML document
+/// \return The results of loading each <include>, in document order. The
+/// includes that are skipped by _config are not loaded.
+static std::vector<IncludeLoadResult> loadIncludeFilesConcurrently(
+    tinyxml2::XMLElement *_xml, ElementPtr _sdf, const ParserConfig &_config,
+    const std::string &_source)
+{
+  std::vector<tinyxml2::XMLElement *> includes;
+  for (auto *elemXml = _xml->FirstChildElement("include"); elemXml;
+       elemXml = elemXml->NextSiblingElement("include"))
+  {
+    includes.push_back(elemXml);
+  }
+
+  std::vector<IncludeLoadResult> results;
+  const std::size_t threadCount =
+      std::min(_config.IncludeLoadThreadCount(), includes.size());
+  if (threadCount < 2)
+    return results;
+
+  results.resize(includes.size());
+  std::atomic<std::size_t> nextInclude{0};
+  auto loadIncludes = [&](std::size_t)
+  {
+    // The executor may run this on the calling thread, so the flag is
+    // restored afterwards.
+    const bool wasLoadingConcurrently = tLoadingIncludeConcurrently;
+    tLoadingIncludeConcurrently = true;
+    for (std::size_t i = nextInclude++; i < includes.size();
+         i = nextInclude++)
+    {
+      if (LoadMonitor::Cancelled(_config))
+        break;
+
+      if (isElementSkipped(_config, _sdf->GetName(), includes[i]) ||
+          isOutsideRegionOfInterest(_config, _sdf, includes[i]))
+      {
+        continue;
+      }
+
+      const std::string includeXmlPath =
+          _sdf->XmlPath() + "/include[" + std::to_string(i) + "]";
+      loadIncludeFile(includes[i], _config, includeXmlPath, _source,
+          results[i]);
+    }
+    tLoadingIncludeConcurrently = wasLoadingConcurrently;
+  };
+
+  _config.Executor()->RunAndWait(threadCount, loadIncludes);
+
+  return results;
+}
+
+//////////////////////////////////////////////////
+/// \brief Add a number to the line numbers of an element and its
+/// descendants that were read from a file.
+/// \param[in,out] _sdf Element to update.
+/// \param[in] _offset Number to add.
+/// \param[in] _source Path of the file.
+static void offsetLineNumbers(ElementPtr _sdf, int _offset,
+    const std::string &_source)
+{
+  if (_sdf->LineNumber().has_value() && _sdf->FilePath() == _source)
+    _sdf->SetLineNumber(_sdf->LineNumber().value() + _offset);
+
+  for (ElementPtr child = _sdf->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    offsetLineNumbers(child, _offset, _source);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a top-level model of a world that was replaced by a
+/// placeholder in a streamed file. The XML of the model is parsed from the
+/// file, read into a new element and freed before returning.
+/// \param[in] _doc Streamed file being read.
+/// \param[in] _index Index of the model in _doc.
+/// \param[in] _placeholder Placeholder of the model.
+/// \param[in,out] _sdf World element the model is added to.
+/// \param[in] _config Custom parser configuration.
+/// \param[in] _source Path of the file.
+/// \param[out] _errors Parsing errors will be appended to this variable.
+/// \return True if the model was read.
+static bool readStreamedModel(const StreamedDocument &_doc,
+    std::size_t _index, const tinyxml2::XMLElement *_placeholder,
+    ElementPtr _sdf, const ParserConfig &_config, const std::string &_source,
+    Errors &_errors)
+{
+  auto xmlDoc = XmlDocumentPool::Acquire(_config);
+  int lineOffset = 0;
+  ElementConstPtr elemDesc = _sdf->GetElementDescription("model");
+  if (ScopedLoadPhase phase(_config, LoadPhase::XML_PARSE);
+      !elemDesc || !_doc.LoadFragment(_index, *xmlDoc.Get(), lineOffset))
+  {
+    Error err(
+        ErrorCode::FILE_READ,
+        "Unable to read element <model> from file[" + _source + "]",
+        _source,
+        _placeholder->GetLineNum());
+    err.SetXmlPath(_sdf->XmlPath() + "/model");
+    _errors.push_back(err);
+    return false;
+  }
+
+  tinyxml2::XMLElement *elemXml = xmlDoc->FirstChildElement("model");
+  if (isOutsideRegionOfInterest(_config, _sdf, elemXml))
+    return true;
+
+  std::string elemXmlPath = _sdf->XmlPath() + "/model";
+  const char *name = elemXml->Attribute("name");
+  if (name)
+    elemXmlPath += "[@name=\"" + std::string(name) + "\"]";
+
+  const std::size_t firstError = _errors.size();
+  ElementPtr element = elemDesc->Clone();
+  element->SetParent(_sdf);
+  element->SetLineNumber(elemXml->GetLineNum());
+  element->SetXmlPath(elemXmlPath);
+  const bool result = readXml(elemXml, element, _config, _source, _errors);
+
+  // The lines of the model XML are numbered from the start of the model.
+  offsetLineNumbers(element, lineOffset, _source);
+  for (std::size_t i = firstError; i < _errors.size(); ++i)
+  {
+    if (_errors[i].LineNumber().has_value() &&
+        _errors[i].FilePath() == _source)
+    {
+      _errors[i].SetLineNumber(_errors[i].LineNumber().value() + lineOffset);
+    }
+  }
+
+  if (result)
+  {
+    _sdf->InsertElement(element);
+  }
+  else
+  {
+    Error err(
+        ErrorCode::ELEMENT_INVALID,
+        "Error reading element <model>",
+        _source,
+        _placeholder->GetLineNum());
+    err.SetXmlPath(elemXmlPath);
+    _errors.push_back(err);
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
+    const ParserConfig &_config, const std::string &_source, Errors &_errors)
+{
+  // Check if the element pointer is deprecated.
+  if (tCheckDeprecatedElements && _sdf->GetRequired() == "-1")
+  {
+    enforceConfigurablePolicyCondition(_config.DeprecatedElementsPolicy(),
+        [&]()
+    {
+      Error err(ErrorCode::ELEMENT_DEPRECATED,
+          "SDF Element[{}] is deprecated\n",
+          std::vector<std::string>{_sdf->GetName()});
+      err.SetXmlPath(_sdf->XmlPath());
+      return err;
+    }, _errors);
   }
 
   if (!_xml)
@@ -1543,7 +2468,10 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
 
   if (_xml->GetText() != nullptr && _sdf->GetValue())
   {
-    if (!_sdf->GetValue()->SetFromString(_xml->GetText()))
+    const bool valueSet = _config.LazyParamParsing() ?
+        _sdf->GetValue()->SetFromStringLazy(_xml->GetText()) :
+        _sdf->GetValue()->SetFromString(_xml->GetText());
+    if (!valueSet)
       return false;
   }
   else if (_sdf->GetValue())
@@ -1556,54 +2484,140 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
 
   if (_sdf->GetCopyChildren())
   {
-    copyChildren(_sdf, _xml, false);
+    copyChildren(_sdf, _xml, false, _config);
   }
   else
   {
-    std::string filename;
-
     // Keep count of the include indices
     int includeElemIndex = -1;
 
+    // Start resolving the URIs of the includes that are left to the
+    // asynchronous find callback, so that they are resolved concurrently.
+    if (auto requests = FindFileRequests::Of(_config))
+    {
+      for (auto *includeXml = _xml->FirstChildElement("include"); includeXml;
+           includeXml = includeXml->NextSiblingElement("include"))
+      {
+        auto *uriXml = includeXml->FirstChildElement("uri");
+        if (uriXml && uriXml->GetText() &&
+            !isElementSkipped(_config, _sdf->GetName(), includeXml) &&
+            sdf::findFile(uriXml->GetText(), true, false, _config).empty())
+        {
+          requests->Start(uriXml->GetText());
+        }
+      }
+    }
+
+    // Load the included files up front when they are loaded on several
+    // threads. The results are used in document order below.
+    std::vector<IncludeLoadResult> prefetchedIncludes;
+    if (!tLoadingIncludeConcurrently)
+    {
+      prefetchedIncludes =
+          loadIncludeFilesConcurrently(_xml, _sdf, _config, _source);
+    }
+
     // Iterate over all the child elements
+    const std::string sdfXmlPath = _sdf->XmlPath();
     tinyxml2::XMLElement *elemXml = nullptr;
+    const StreamedDocument *streamedDoc = StreamedDocument::Current();
+    std::vector<std::string> skippedElements;
     for (elemXml = _xml->FirstChildElement(); elemXml;
          elemXml = elemXml->NextSiblingElement())
     {
-      if (std::string("include") == elemXml->Value())
+      const bool isInclude = std::string("include") == elemXml->Value();
+
+      // An asynchronous load stops before the next included file or model.
+      if ((isInclude || std::string("model") == elemXml->Value()) &&
+          LoadMonitor::Cancelled(_config))
+      {
+        _errors.push_back({ErrorCode::LOAD_CANCELLED,
+            "Loading was cancelled before element <" +
+            std::string(elemXml->Value()) + "> was read.", _source,
+            elemXml->GetLineNum()});
+        return false;
+      }
+
+      // Reading stops once the errors reach the limit of the configuration.
+      if (maxErrorsReached(_config, _errors))
+      {
+        _errors.push_back({ErrorCode::ERROR_LIMIT_REACHED,
+            "Reading stopped before element <" +
+            std::string(elemXml->Value()) + "> after " +
+            std::to_string(_config.MaxErrors()) + " errors.", _source,
+            elemXml->GetLineNum()});
+        return false;
+      }
+
+      // Elements removed by the configuration are not read at all.
+      if (isElementSkipped(_config, _sdf->GetName(), elemXml))
+      {
+        if (isInclude)
+          ++includeElemIndex;
+        skippedElements.push_back(elemXml->Value());
+        continue;
+      }
+
+      // Top-level models of a streamed file are read from the file here.
+      std::size_t fragmentIndex = 0;
+      if (streamedDoc && _source == streamedDoc->Filename() &&
+          StreamedDocument::FragmentIndex(elemXml, fragmentIndex))
+      {
+        if (!readStreamedModel(*streamedDoc, fragmentIndex, elemXml, _sdf,
+                               _config, _source, _errors))
+        {
+          return false;
+        }
+        continue;
+      }
+
+      // Top-level models of worlds that are outside the region of interest
+      // are skipped before their included files are loaded.
+      if (isOutsideRegionOfInterest(_config, _sdf, elemXml))
+      {
+        if (isInclude)
+          ++includeElemIndex;
+        continue;
+      }
+
+      if (isInclude)
       {
         validateIncludeElement(elemXml, _sdf, _config, _source, _errors);
 
         tinyxml2::XMLElement *uriElement = elemXml->FirstChildElement("uri");
 
-        const std::string includeXmlPath = _sdf->XmlPath() + "/include[" +
+        const std::string includeXmlPath = sdfXmlPath + "/include[" +
             std::to_string(++includeElemIndex) + "]";
         const std::string uriXmlPath = includeXmlPath + "/uri";
 
-        if (!resolveFileNameFromUri(elemXml, _config, includeXmlPath,
-                _source, filename, _errors))
+        IncludeLoadResult includeResult;
+        if (prefetchedIncludes.empty())
+        {
+          loadIncludeFile(elemXml, _config, includeXmlPath, _source,
+              includeResult);
+        }
+        else
+        {
+          includeResult = std::move(prefetchedIncludes[includeElemIndex]);
+        }
+
+        _errors.insert(_errors.end(), includeResult.resolveErrors.begin(),
+            includeResult.resolveErrors.end());
+        if (!includeResult.resolved)
           continue;
 
+        const std::string &filename = includeResult.fileName;
+
         // If the file is not an SDFormat file, it is assumed that it will
         // handled by a custom parser, so fall through and add the include
         // element into _sdf.
-        if (sdf::isSdfFile(filename) || _config.CustomModelParsers().empty())
+        if (includeResult.sdf)
         {
-          // NOTE: sdf::init is an expensive call. For performance reason,
-          // a new sdf pointer is created here by cloning a fresh sdf template
-          // pointer instead of calling init every iteration.
-          // SDFPtr includeSDF(new SDF);
-          // init(includeSDF, _config);
-          static SDFPtr includeSDFTemplate;
-          if (!includeSDFTemplate)
-          {
-            includeSDFTemplate.reset(new SDF);
-            init(includeSDFTemplate, _config);
-          }
-          SDFPtr includeSDF(new SDF);
-          includeSDF->Root(includeSDFTemplate->Root()->Clone());
+          SDFPtr includeSDF = includeResult.sdf;
 
-          if (!readFile(filename, _config, includeSDF, _errors))
+          _errors.insert(_errors.end(), includeResult.readErrors.begin(),
+              includeResult.readErrors.end());
+          if (!includeResult.read)
           {
             Error err(
                 ErrorCode::FILE_READ,
@@ -1799,6 +2813,7 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
           // ref: sdformat.org > Documentation > Proposal for parameter passing
           if (elemXml->FirstChildElement("experimental:params"))
           {
+            ScopedLoadPhase phase(_config, LoadPhase::PARAM_PASSING);
             ParamPassing::updateParams(
                 _config,
                 _source,
@@ -1814,7 +2829,7 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
             // Store the contents of the <include> tag as the includeElement of
             // the entity that was loaded from the included URI.
             auto includeInfo = includeDesc->Clone();
-            copyChildren(includeInfo, elemXml, false);
+            copyChildren(includeInfo, elemXml, false, _config);
             includeSDFFirstElem->SetIncludeElement(includeInfo);
           }
           bool toMerge = elemXml->BoolAttribute("merge", false);
@@ -1832,10 +2847,10 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
       for (descCounter = 0;
            descCounter != _sdf->GetElementDescriptionCount(); ++descCounter)
       {
-        ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
+        ElementConstPtr elemDesc = _sdf->GetElementDescription(descCounter);
         if (elemDesc->GetName() == elemXml->Value())
         {
-          std::string elemXmlPath = _sdf->XmlPath() + "/" + elemXml->Value();
+          std::string elemXmlPath = sdfXmlPath + "/" + elemXml->Value();
           const char *name = elemXml->Attribute("name");
           if (name)
             elemXmlPath += "[@name=\"" + std::string(name) + "\"]";
@@ -1867,44 +2882,47 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
       if (descCounter == _sdf->GetElementDescriptionCount()
             && std::strchr(elemXml->Value(), ':') == nullptr)
       {
-        std::string elemXmlPath = _sdf->XmlPath() + "/" + elemXml->Value();
-        const char *name = elemXml->Attribute("name");
-        if (name)
-          elemXmlPath += "[@name=\"" + std::string(name) + "\"]";
-
-        std::stringstream ss;
-        ss << "XML Element[" << elemXml->Value()
-           << "], child of element[" << _xml->Value()
-           << "], not defined in SDF. Copying[" << elemXml->Value() << "] "
-           << "as children of [" << _xml->Value() << "].\n";
-
-        Error err(
-            ErrorCode::ELEMENT_INCORRECT_TYPE,
-            ss.str(),
-            _source,
-            elemXml->GetLineNum());
-        err.SetXmlPath(elemXmlPath);
         enforceConfigurablePolicyCondition(
-            _config.UnrecognizedElementsPolicy(), err, _errors);
+            _config.UnrecognizedElementsPolicy(), [&]()
+        {
+          std::string elemXmlPath =
+              sdfXmlPath + "/" + elemXml->Value();
+          const char *name = elemXml->Attribute("name");
+          if (name)
+            elemXmlPath += "[@name=\"" + std::string(name) + "\"]";
+
+          Error err(
+              ErrorCode::ELEMENT_INCORRECT_TYPE,
+              "XML Element[{}], child of element[{}], not defined in SDF. "
+              "Copying[{}] as children of [{}].\n",
+              std::vector<std::string>{elemXml->Value(), _xml->Value(),
+                                       elemXml->Value(), _xml->Value()},
+              _source,
+              elemXml->GetLineNum());
+          err.SetXmlPath(elemXmlPath);
+          return err;
+        }, _errors);
 
         continue;
       }
     }
 
     // Copy unknown elements outside the loop so it only happens one time
-    copyChildren(_sdf, _xml, true);
+    copyChildren(_sdf, _xml, true, _config);
 
     // Check that all required elements have been set
     for (unsigned int descCounter = 0;
          descCounter != _sdf->GetElementDescriptionCount(); ++descCounter)
     {
-      ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
+      ElementConstPtr elemDesc = _sdf->GetElementDescription(descCounter);
 
       if (elemDesc->GetRequired() == "1" || elemDesc->GetRequired() == "+")
       {
-        if (!_sdf->HasElement(elemDesc->GetName()))
+        if (!_sdf->HasElement(elemDesc->GetName()) &&
+            std::find(skippedElements.begin(), skippedElements.end(),
+                      elemDesc->GetName()) == skippedElements.end())
         {
-          const std::string elemXmlPath = _sdf->XmlPath() + "/" +
+          const std::string elemXmlPath = sdfXmlPath + "/" +
               elemDesc->GetName();
           if (_sdf->GetName() == "joint" &&
               _sdf->Get<std::string>("type") != "ball")
@@ -1933,10 +2951,68 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
   return true;
 }
 
+//////////////////////////////////////////////////
+ElementPtr readIncludeElement(const ElementPtr &_include,
+    const ElementPtr &_parent, const ParserConfig &_config,
+    const std::string &_source, Errors &_errors)
+{
+  // The <include> is read into an empty copy of its parent, so that it is
+  // resolved, read and placed exactly as it was when the parent was read.
+  ElementPtr grandparent = _parent->GetParent();
+  ElementConstPtr parentDesc = grandparent ?
+      grandparent->GetElementDescription(_parent->GetName()) : nullptr;
+  if (!parentDesc)
+  {
+    _errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Unable to read the <include> of element <" + _parent->GetName() +
+        "> again, because the element has no parent.", _source});
+    return nullptr;
+  }
+
+  std::string parentXml = "<" + _parent->GetName();
+  if (ParamPtr name = _parent->GetAttribute("name"))
+    parentXml += " name='" + name->GetAsString() + "'";
+  parentXml += ">" + _include->ToString("") + "</" + _parent->GetName() + ">";
+
+  auto xmlDoc = makeSdfDoc();
+  xmlDoc.Parse(parentXml.c_str(), parentXml.size());
+  if (xmlDoc.Error())
+  {
+    _errors.push_back({ErrorCode::STRING_READ,
+        "Unable to read the <include> of element <" + _parent->GetName() +
+        "> again: " + std::string(xmlDoc.ErrorStr()), _source});
+    return nullptr;
+  }
+
+  ElementPtr parent = parentDesc->Clone();
+  parent->SetParent(grandparent);
+  parent->SetFilePath(_source);
+  parent->SetXmlPath(_parent->XmlPath());
+  parent->SetOriginalVersion(_parent->OriginalVersion());
+  if (!readXml(xmlDoc.RootElement(), parent, _config, _source, _errors))
+    return nullptr;
+
+  for (ElementPtr elem = parent->GetFirstElement(); elem;
+       elem = elem->GetNextElement())
+  {
+    if (elem->GetIncludeElement())
+    {
+      elem->SetParent(_parent);
+      return elem;
+    }
+  }
+
+  _errors.push_back({ErrorCode::ELEMENT_MISSING,
+      "The <include> of element <" + _parent->GetName() +
+      "> did not produce an element when it was read again.", _source});
+  return nullptr;
+}
+
 /////////////////////////////////////////////////
 void copyChildren(ElementPtr _sdf,
                   tinyxml2::XMLElement *_xml,
-                  const bool _onlyUnknown)
+                  const bool _onlyUnknown,
+                  const ParserConfig &_config)
 {
   // Iterate over all the child elements
   tinyxml2::XMLElement *elemXml = nullptr;
@@ -1945,6 +3021,11 @@ void copyChildren(ElementPtr _sdf,
   {
     std::string elemName = elemXml->Name();
 
+    // Unknown elements are removed by the configuration like the others, but
+    // the contents of copied elements such as <plugin> are kept as they are.
+    if (_onlyUnknown && isElementSkipped(_config, _sdf->GetName(), elemXml))
+      continue;
+
     if (_sdf->HasElementDescription(elemName))
     {
       if (!_onlyUnknown)
@@ -1965,7 +3046,7 @@ void copyChildren(ElementPtr _sdf,
         {
           element->GetValue()->SetFromString(value);
         }
-        copyChildren(element, elemXml, _onlyUnknown);
+        copyChildren(element, elemXml, _onlyUnknown, _config);
       }
     }
     else
@@ -1973,6 +3054,14 @@ void copyChildren(ElementPtr _sdf,
       ElementPtr element(new Element);
       element->SetParent(_sdf);
       element->SetName(elemName);
+      if (_config.CopyElementsAsRawXml())
+      {
+        // The subtree is not interpreted, so it is only kept as text
+        element->SetRawXml(ElementToString(elemXml));
+        _sdf->InsertElement(element);
+        continue;
+      }
+
       for (const tinyxml2::XMLAttribute *attribute = elemXml->FirstAttribute();
            attribute; attribute = attribute->Next())
       {
@@ -1986,7 +3075,7 @@ void copyChildren(ElementPtr _sdf,
         element->AddValue("string", elemXml->GetText(), true);
       }
 
-      copyChildren(element, elemXml, _onlyUnknown);
+      copyChildren(element, elemXml, _onlyUnknown, _config);
       _sdf->InsertElement(element);
     }
   }
@@ -2018,7 +3107,7 @@ bool convertFile(const std::string &_filename, const std::string &_version,
   }
 
   auto xmlDoc = makeSdfDoc();
-  if (!xmlDoc.LoadFile(filename.c_str()))
+  if (!loadXmlFile(filename, _config, xmlDoc))
   {
     // read initial sdf version
     std::string originalVersion;
@@ -2109,6 +3198,41 @@ bool convertString(const std::string &_sdfString, const std::string &_version,
   return false;
 }
 
+/////////////////////////////////////////////////
+bool encodeBinary(ElementPtr _sdf, std::string &_data, Errors &_errors)
+{
+  return encodeBinary(_sdf, ParserConfig::GlobalConfig(), _data, _errors);
+}
+
+/////////////////////////////////////////////////
+bool encodeBinary(ElementPtr _sdf, const ParserConfig &_config,
+    std::string &_data, Errors &_errors)
+{
+  return BinarySdf::Encode(_sdf, _config, _data, _errors);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the canonical_link attribute of a model, if set,
+/// matches the name of one of its links.
+/// \param[in] _model Model to check.
+/// \param[out] _err Stream for the errors.
+/// \return True if the canonical_link attribute is valid.
+static bool checkModelCanonicalLinkName(const sdf::Model *_model,
+    std::ostream &_err)
+{
+  bool modelResult = true;
+  std::string canonicalLink = _model->CanonicalLinkName();
+  if (!canonicalLink.empty() && !_model->LinkNameExists(canonicalLink))
+  {
+    _err << "Error: canonical_link with name[" << canonicalLink
+         << "] not found in model with name[" << _model->Name()
+         << "]."
+         << std::endl;
+    modelResult = false;
+  }
+  return modelResult;
+}
+
 //////////////////////////////////////////////////
 bool checkCanonicalLinkNames(const sdf::Root *_root)
 {
@@ -2122,25 +3246,10 @@ bool checkCanonicalLinkNames(const sdf::Root *_root)
 
   bool result = true;
 
-  auto checkModelCanonicalLinkName = [](
-      const sdf::Model *_model) -> bool
-  {
-    bool modelResult = true;
-    std::string canonicalLink = _model->CanonicalLinkName();
-    if (!canonicalLink.empty() && !_model->LinkNameExists(canonicalLink))
-    {
-      std::cerr << "Error: canonical_link with name[" << canonicalLink
-                << "] not found in model with name[" << _model->Name()
-                << "]."
-                << std::endl;
-      modelResult = false;
-    }
-    return modelResult;
-  };
-
   if (_root->Model())
   {
-    result = checkModelCanonicalLinkName(_root->Model()) && result;
+    result = checkModelCanonicalLinkName(_root->Model(), std::cerr) &&
+        result;
   }
 
   for (uint64_t w = 0; w < _root->WorldCount(); ++w)
@@ -2149,7 +3258,7 @@ bool checkCanonicalLinkNames(const sdf::Root *_root)
     for (uint64_t m = 0; m < world->ModelCount(); ++m)
     {
       auto model = world->ModelByIndex(m);
-      result = checkModelCanonicalLinkName(model) && result;
+      result = checkModelCanonicalLinkName(model, std::cerr) && result;
     }
   }
 
@@ -2157,122 +3266,128 @@ bool checkCanonicalLinkNames(const sdf::Root *_root)
 }
 
 //////////////////////////////////////////////////
-bool checkFrameAttachedToNames(const sdf::Root *_root)
+/// \brief Check the attached_to attributes of the frames of a model.
+/// \param[in] _model Model to check.
+/// \return True if all frames have valid attached_to attributes.
+static bool checkModelFrameAttachedToNames(const sdf::Model *_model)
 {
-  bool result = true;
-
-  auto checkModelFrameAttachedToNames = [](
-      const sdf::Model *_model) -> bool
+  bool modelResult = true;
+  for (uint64_t f = 0; f < _model->FrameCount(); ++f)
   {
-    bool modelResult = true;
-    for (uint64_t f = 0; f < _model->FrameCount(); ++f)
+    auto frame = _model->FrameByIndex(f);
+
+    const std::string &attachedTo = frame->AttachedTo();
+
+    // the attached_to attribute is always permitted to be empty
+    if (attachedTo.empty())
     {
-      auto frame = _model->FrameByIndex(f);
+      continue;
+    }
 
-      const std::string &attachedTo = frame->AttachedTo();
+    if (attachedTo == frame->Name())
+    {
+      std::cerr << "Error: attached_to name[" << attachedTo
+                << "] is identical to frame name[" << frame->Name()
+                << "], causing a graph cycle "
+                << "in model with name[" << _model->Name()
+                << "]."
+                << std::endl;
+      modelResult = false;
+    }
+    else if (!_model->LinkNameExists(attachedTo) &&
+             !_model->ModelNameExists(attachedTo) &&
+             !_model->JointNameExists(attachedTo) &&
+             !_model->FrameNameExists(attachedTo))
+    {
+      std::cerr << "Error: attached_to name[" << attachedTo
+                << "] specified by frame with name[" << frame->Name()
+                << "] does not match a nested model, link, joint, "
+                << "or frame name in model with name[" << _model->Name()
+                << "]."
+                << std::endl;
+      modelResult = false;
+    }
+  }
+  return modelResult;
+}
 
-      // the attached_to attribute is always permitted to be empty
-      if (attachedTo.empty())
-      {
-        continue;
-      }
+//////////////////////////////////////////////////
+/// \brief Check the attached_to attributes of the frames of a world.
+/// \param[in] _world World to check.
+/// \return True if all frames have valid attached_to attributes.
+static bool checkWorldFrameAttachedToNames(const sdf::World *_world)
+{
+  auto findNameInWorld = [](const sdf::World *_inWorld,
+      const std::string &_name) -> bool {
+    if (_inWorld->ModelNameExists(_name) ||
+        _inWorld->FrameNameExists(_name))
+    {
+      return true;
+    }
 
-      if (attachedTo == frame->Name())
+    const auto delimIndex = _name.find("::");
+    if (delimIndex != std::string::npos && delimIndex + 2 < _name.size())
+    {
+      std::string modelName = _name.substr(0, delimIndex);
+      std::string nameToCheck = _name.substr(delimIndex + 2);
+      const auto *model = _inWorld->ModelByName(modelName);
+      if (nullptr == model)
       {
-        std::cerr << "Error: attached_to name[" << attachedTo
-                  << "] is identical to frame name[" << frame->Name()
-                  << "], causing a graph cycle "
-                  << "in model with name[" << _model->Name()
-                  << "]."
-                  << std::endl;
-        modelResult = false;
+        return false;
       }
-      else if (!_model->LinkNameExists(attachedTo) &&
-               !_model->ModelNameExists(attachedTo) &&
-               !_model->JointNameExists(attachedTo) &&
-               !_model->FrameNameExists(attachedTo))
+
+      if (model->LinkNameExists(nameToCheck) ||
+          model->ModelNameExists(nameToCheck) ||
+          model->JointNameExists(nameToCheck) ||
+          model->FrameNameExists(nameToCheck))
       {
-        std::cerr << "Error: attached_to name[" << attachedTo
-                  << "] specified by frame with name[" << frame->Name()
-                  << "] does not match a nested model, link, joint, "
-                  << "or frame name in model with name[" << _model->Name()
-                  << "]."
-                  << std::endl;
-        modelResult = false;
+        return true;
       }
     }
-    return modelResult;
+    return false;
   };
 
-  auto checkWorldFrameAttachedToNames = [](
-      const sdf::World *_world) -> bool
+  bool worldResult = true;
+  for (uint64_t f = 0; f < _world->FrameCount(); ++f)
   {
-    auto findNameInWorld = [](const sdf::World *_inWorld,
-        const std::string &_name) -> bool {
-      if (_inWorld->ModelNameExists(_name) ||
-          _inWorld->FrameNameExists(_name))
-      {
-        return true;
-      }
+    auto frame = _world->FrameByIndex(f);
 
-      const auto delimIndex = _name.find("::");
-      if (delimIndex != std::string::npos && delimIndex + 2 < _name.size())
-      {
-        std::string modelName = _name.substr(0, delimIndex);
-        std::string nameToCheck = _name.substr(delimIndex + 2);
-        const auto *model = _inWorld->ModelByName(modelName);
-        if (nullptr == model)
-        {
-          return false;
-        }
-
-        if (model->LinkNameExists(nameToCheck) ||
-            model->ModelNameExists(nameToCheck) ||
-            model->JointNameExists(nameToCheck) ||
-            model->FrameNameExists(nameToCheck))
-        {
-          return true;
-        }
-      }
-      return false;
-    };
+    const std::string &attachedTo = frame->AttachedTo();
 
-    bool worldResult = true;
-    for (uint64_t f = 0; f < _world->FrameCount(); ++f)
+    // the attached_to attribute is always permitted to be empty
+    if (attachedTo.empty())
     {
-      auto frame = _world->FrameByIndex(f);
-
-      const std::string &attachedTo = frame->AttachedTo();
-
-      // the attached_to attribute is always permitted to be empty
-      if (attachedTo.empty())
-      {
-        continue;
-      }
+      continue;
+    }
 
-      if (attachedTo == frame->Name())
-      {
-        std::cerr << "Error: attached_to name[" << attachedTo
-                  << "] is identical to frame name[" << frame->Name()
-                  << "], causing a graph cycle "
-                  << "in world with name[" << _world->Name()
-                  << "]."
-                  << std::endl;
-        worldResult = false;
-      }
-      else if (!findNameInWorld(_world, attachedTo))
-      {
-        std::cerr << "Error: attached_to name[" << attachedTo
-                  << "] specified by frame with name[" << frame->Name()
-                  << "] does not match a model or frame name "
-                  << "in world with name[" << _world->Name()
-                  << "]."
-                  << std::endl;
-        worldResult = false;
-      }
+    if (attachedTo == frame->Name())
+    {
+      std::cerr << "Error: attached_to name[" << attachedTo
+                << "] is identical to frame name[" << frame->Name()
+                << "], causing a graph cycle "
+                << "in world with name[" << _world->Name()
+                << "]."
+                << std::endl;
+      worldResult = false;
     }
-    return worldResult;
-  };
+    else if (!findNameInWorld(_world, attachedTo))
+    {
+      std::cerr << "Error: attached_to name[" << attachedTo
+                << "] specified by frame with name[" << frame->Name()
+                << "] does not match a model or frame name "
+                << "in world with name[" << _world->Name()
+                << "]."
+                << std::endl;
+      worldResult = false;
+    }
+  }
+  return worldResult;
+}
+
+//////////////////////////////////////////////////
+bool checkFrameAttachedToNames(const sdf::Root *_root)
+{
+  bool result = true;
 
   if (_root->Model())
   {
@@ -2294,29 +3409,137 @@ bool checkFrameAttachedToNames(const sdf::Root *_root)
 }
 
 //////////////////////////////////////////////////
-bool recursiveSameTypeUniqueNames(sdf::ElementPtr _elem)
+/// \brief Buffers reused for every element visited by checkNamesInElement,
+/// so that the names of the children of each element are gathered without
+/// allocating new containers.
+struct NameCheckBuffers
+{
+  /// \brief Type and name of each named child of an element.
+  std::vector<std::pair<std::string, std::string>> typedNames;
+
+  /// \brief Name of each named child of an element that is not an
+  /// exception to sibling name uniqueness.
+  std::vector<std::string> names;
+
+  /// \brief Types of elements whose names need not be unique among their
+  /// siblings.
+  std::vector<std::string> exceptions = Element::NameUniquenessExceptions();
+};
+
+//////////////////////////////////////////////////
+/// \brief Check the name rules selected by the flags on an element and its
+/// descendants. See recursiveCheckNames.
+/// \param[in] _elem SDF Element to check recursively.
+/// \param[in] _sameTypeUniqueNames Check recursiveSameTypeUniqueNames.
+/// \param[in] _siblingUniqueNames Check recursiveSiblingUniqueNames.
+/// \param[in] _noDoubleColonInNames Check
+/// recursiveSiblingNoDoubleColonInNames.
+/// \param[in] _warnNonUniqueDomNames Warn about the non-unique names of the
+/// children of worlds and models, as World::Load and Model::Load do.
+/// \param[in,out] _buffers Buffers shared by all the visited elements.
+/// \param[out] _err Stream for the errors.
+/// \return True if all selected rules are satisfied.
+static bool checkNamesInElement(sdf::ElementPtr _elem,
+    bool _sameTypeUniqueNames, bool _siblingUniqueNames,
+    bool _noDoubleColonInNames, bool _warnNonUniqueDomNames,
+    NameCheckBuffers &_buffers, std::ostream &_err)
 {
   if (!shouldValidateElement(_elem))
     return true;
 
   bool result = true;
-  auto typeNames = _elem->GetElementTypeNames();
-  for (const std::string &typeName : typeNames)
+  if (_noDoubleColonInNames && _elem->HasAttribute("name")
+      && _elem->Get<std::string>("name").find("::") != std::string::npos)
+  {
+    _err << "Error: Detected delimiter '::' in element name in\n"
+         << _elem->ToString("")
+         << std::endl;
+    result = false;
+  }
+
+  const bool warnNames = _warnNonUniqueDomNames &&
+      (_elem->GetName() == "world" || _elem->GetName() == "model");
+  if (_sameTypeUniqueNames || _siblingUniqueNames || warnNames)
   {
-    if (!_elem->HasUniqueChildNames(typeName))
+    auto &typedNames = _buffers.typedNames;
+    auto &names = _buffers.names;
+    const auto &exceptions = _buffers.exceptions;
+    typedNames.clear();
+    names.clear();
+    for (sdf::ElementPtr child = _elem->GetFirstElement(); child;
+         child = child->GetNextElement())
     {
-      std::cerr << "Error: Non-unique names detected in type "
-                << typeName << " in\n"
-                << _elem->ToString("")
-                << std::endl;
+      if (!child->HasAttribute("name"))
+        continue;
+
+      std::string name = child->Get<std::string>("name");
+      if ((_siblingUniqueNames || warnNames) &&
+          std::find(exceptions.begin(), exceptions.end(), child->GetName()) ==
+          exceptions.end())
+      {
+        names.push_back(name);
+      }
+      if (_sameTypeUniqueNames)
+      {
+        typedNames.emplace_back(child->GetName(), std::move(name));
+      }
+    }
+
+    // Sorting groups the duplicates, and reports types in the same order as
+    // the sorted type names used by recursiveSameTypeUniqueNames.
+    std::sort(typedNames.begin(), typedNames.end());
+    const std::string *reportedType = nullptr;
+    for (std::size_t i = 1; i < typedNames.size(); ++i)
+    {
+      if (typedNames[i] == typedNames[i - 1] &&
+          (nullptr == reportedType || *reportedType != typedNames[i].first))
+      {
+        _err << "Error: Non-unique names detected in type "
+             << typedNames[i].first << " in\n"
+             << _elem->ToString("")
+             << std::endl;
+        reportedType = &typedNames[i].first;
+        result = false;
+      }
+    }
+
+    std::sort(names.begin(), names.end());
+    if (_siblingUniqueNames &&
+        std::adjacent_find(names.begin(), names.end()) != names.end())
+    {
+      _err << "Error: Non-unique names detected in "
+           << _elem->ToString("")
+           << std::endl;
       result = false;
     }
+
+    if (warnNames)
+    {
+      std::string scopeName;
+      loadName(_elem, scopeName);
+      std::size_t i = 0;
+      while (i < names.size())
+      {
+        std::size_t j = i + 1;
+        while (j < names.size() && names[j] == names[i])
+          ++j;
+        if (j - i > 1)
+        {
+          sdfwarn << "Non-unique name[" << names[i] << "] detected " << j - i
+                  << " times in XML children of " << _elem->GetName()
+                  << " with name[" << scopeName << "].\n";
+        }
+        i = j;
+      }
+    }
   }
 
   sdf::ElementPtr child = _elem->GetFirstElement();
   while (child)
   {
-    result = recursiveSameTypeUniqueNames(child) && result;
+    result = checkNamesInElement(child, _sameTypeUniqueNames,
+        _siblingUniqueNames, _noDoubleColonInNames, _warnNonUniqueDomNames,
+        _buffers, _err) && result;
     child = child->GetNextElement();
   }
 
@@ -2324,55 +3547,77 @@ bool recursiveSameTypeUniqueNames(sdf::ElementPtr _elem)
 }
 
 //////////////////////////////////////////////////
-bool recursiveSiblingUniqueNames(sdf::ElementPtr _elem)
+bool recursiveCheckNames(sdf::ElementPtr _elem, bool _sameTypeUniqueNames,
+    bool _siblingUniqueNames, bool _noDoubleColonInNames)
 {
-  if (!shouldValidateElement(_elem))
-    return true;
+  return recursiveCheckNames(_elem, _sameTypeUniqueNames, _siblingUniqueNames,
+      _noDoubleColonInNames, false, std::cerr);
+}
 
-  bool result =
-      _elem->HasUniqueChildNames("", Element::NameUniquenessExceptions());
-  if (!result)
-  {
-    std::cerr << "Error: Non-unique names detected in "
-              << _elem->ToString("")
-              << std::endl;
-    result = false;
-  }
+//////////////////////////////////////////////////
+bool recursiveCheckNames(sdf::ElementPtr _elem, bool _sameTypeUniqueNames,
+    bool _siblingUniqueNames, bool _noDoubleColonInNames,
+    bool _warnNonUniqueDomNames, std::ostream &_err)
+{
+  NameCheckBuffers buffers;
+  return checkNamesInElement(_elem, _sameTypeUniqueNames, _siblingUniqueNames,
+      _noDoubleColonInNames, _warnNonUniqueDomNames, buffers, _err);
+}
 
-  sdf::ElementPtr child = _elem->GetFirstElement();
-  while (child)
-  {
-    result = recursiveSiblingUniqueNames(child) && result;
-    child = child->GetNextElement();
-  }
+//////////////////////////////////////////////////
+bool recursiveSameTypeUniqueNames(sdf::ElementPtr _elem)
+{
+  return recursiveCheckNames(_elem, true, false, false);
+}
 
-  return result;
+//////////////////////////////////////////////////
+bool recursiveSiblingUniqueNames(sdf::ElementPtr _elem)
+{
+  return recursiveCheckNames(_elem, false, true, false);
 }
 
 //////////////////////////////////////////////////
 bool recursiveSiblingNoDoubleColonInNames(sdf::ElementPtr _elem)
 {
-  if (!shouldValidateElement(_elem))
-    return true;
+  return recursiveCheckNames(_elem, false, false, true);
+}
 
-  bool result = true;
-  if (_elem->HasAttribute("name")
-      && _elem->Get<std::string>("name").find("::") != std::string::npos)
+//////////////////////////////////////////////////
+/// \brief Build the attached_to graph of a model or world and check that it
+/// is valid.
+/// \param[in] _scope Model or world to check.
+/// \param[out] _err Stream for the errors.
+/// \return True if the graph builds without errors and is valid.
+template <typename T>
+static bool checkScopeFrameAttachedToGraph(const T *_scope, std::ostream &_err)
+{
+  bool scopeResult = true;
+  auto ownedGraph = std::make_shared<sdf::FrameAttachedToGraph>();
+  sdf::ScopedGraph<sdf::FrameAttachedToGraph> graph(ownedGraph);
+  auto errors = sdf::buildFrameAttachedToGraph(graph, _scope);
+  if (!errors.empty())
   {
-    std::cerr << "Error: Detected delimiter '::' in element name in\n"
-             << _elem->ToString("")
-             << std::endl;
-    result = false;
+    for (auto &error : errors)
+    {
+      _err << "Error: " << error.Message() << std::endl;
+    }
+    scopeResult = false;
   }
-
-  sdf::ElementPtr child = _elem->GetFirstElement();
-  while (child)
+  // Freeze the graph so that it is validated from its flat copy, like the
+  // graphs of the DOM.
+  graph.Freeze();
+  errors = sdf::validateFrameAttachedToGraph(graph);
+  if (!errors.empty())
   {
-    result = recursiveSiblingNoDoubleColonInNames(child) && result;
-    child = child->GetNextElement();
+    for (auto &error : errors)
+    {
+      _err << "Error in validateFrameAttachedToGraph: "
+           << error.Message()
+           << std::endl;
+    }
+    scopeResult = false;
   }
-
-  return result;
+  return scopeResult;
 }
 
 //////////////////////////////////////////////////
@@ -2380,77 +3625,20 @@ bool checkFrameAttachedToGraph(const sdf::Root *_root)
 {
   bool result = true;
 
-  auto checkModelFrameAttachedToGraph = [](
-      const sdf::Model *_model) -> bool
-  {
-    bool modelResult = true;
-    auto ownedGraph = std::make_shared<sdf::FrameAttachedToGraph>();
-    sdf::ScopedGraph<sdf::FrameAttachedToGraph> graph(ownedGraph);
-    auto errors = sdf::buildFrameAttachedToGraph(graph, _model);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error: " << error.Message() << std::endl;
-      }
-      modelResult = false;
-    }
-    errors = sdf::validateFrameAttachedToGraph(graph);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error in validateFrameAttachedToGraph: "
-                  << error.Message()
-                  << std::endl;
-      }
-      modelResult = false;
-    }
-    return modelResult;
-  };
-
-  auto checkWorldFrameAttachedToGraph = [](
-      const sdf::World *_world) -> bool
-  {
-    bool worldResult = true;
-    auto ownedGraph = std::make_shared<sdf::FrameAttachedToGraph>();
-    sdf::ScopedGraph<sdf::FrameAttachedToGraph> graph(ownedGraph);
-    auto errors = sdf::buildFrameAttachedToGraph(graph, _world);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error: " << error.Message() << std::endl;
-      }
-      worldResult = false;
-    }
-    errors = sdf::validateFrameAttachedToGraph(graph);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error in validateFrameAttachedToGraph: "
-                  << error.Message()
-                  << std::endl;
-      }
-      worldResult = false;
-    }
-    return worldResult;
-  };
-
   if (_root->Model())
   {
-    result = checkModelFrameAttachedToGraph(_root->Model()) && result;
+    result = checkScopeFrameAttachedToGraph(_root->Model(), std::cerr) &&
+        result;
   }
 
   for (uint64_t w = 0; w < _root->WorldCount(); ++w)
   {
     auto world = _root->WorldByIndex(w);
-    result = checkWorldFrameAttachedToGraph(world) && result;
+    result = checkScopeFrameAttachedToGraph(world, std::cerr) && result;
     for (uint64_t m = 0; m < world->ModelCount(); ++m)
     {
       auto model = world->ModelByIndex(m);
-      result = checkModelFrameAttachedToGraph(model) && result;
+      result = checkScopeFrameAttachedToGraph(model, std::cerr) && result;
     }
   }
 
@@ -2458,81 +3646,62 @@ bool checkFrameAttachedToGraph(const sdf::Root *_root)
 }
 
 //////////////////////////////////////////////////
-bool checkPoseRelativeToGraph(const sdf::Root *_root)
+/// \brief Build the pose relative_to graph of a model or world and check
+/// that it is valid.
+/// \param[in] _scope Model or world to check.
+/// \param[out] _err Stream for the errors.
+/// \return True if the graph builds without errors and is valid.
+template <typename T>
+static bool checkScopePoseRelativeToGraph(const T *_scope, std::ostream &_err)
 {
-  bool result = true;
-
-  auto checkModelPoseRelativeToGraph = [](
-      const sdf::Model *_model) -> bool
+  bool scopeResult = true;
+  auto ownedGraph = std::make_shared<sdf::PoseRelativeToGraph>();
+  sdf::ScopedGraph<PoseRelativeToGraph> graph(ownedGraph);
+  auto errors = sdf::buildPoseRelativeToGraph(graph, _scope);
+  if (!errors.empty())
   {
-    bool modelResult = true;
-    auto ownedGraph = std::make_shared<sdf::PoseRelativeToGraph>();
-    sdf::ScopedGraph<PoseRelativeToGraph> graph(ownedGraph);
-    auto errors = sdf::buildPoseRelativeToGraph(graph, _model);
-    if (!errors.empty())
+    for (auto &error : errors)
     {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error: " << error.Message() << std::endl;
-      }
-      modelResult = false;
+      _err << "Error: " << error.Message() << std::endl;
     }
-    errors = sdf::validatePoseRelativeToGraph(graph);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error in validatePoseRelativeToGraph: "
-                  << error.Message()
-                  << std::endl;
-      }
-      modelResult = false;
-    }
-    return modelResult;
-  };
-
-  auto checkWorldPoseRelativeToGraph = [](
-      const sdf::World *_world) -> bool
+    scopeResult = false;
+  }
+  // Freeze the graph so that it is validated from its flat copy, like the
+  // graphs of the DOM.
+  graph.Freeze();
+  errors = sdf::validatePoseRelativeToGraph(graph);
+  if (!errors.empty())
   {
-    bool worldResult = true;
-    auto ownedGraph = std::make_shared<sdf::PoseRelativeToGraph>();
-    sdf::ScopedGraph<PoseRelativeToGraph> graph(ownedGraph);
-    auto errors = sdf::buildPoseRelativeToGraph(graph, _world);
-    if (!errors.empty())
+    for (auto &error : errors)
     {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error: " << error.Message() << std::endl;
-      }
-      worldResult = false;
-    }
-    errors = sdf::validatePoseRelativeToGraph(graph);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error in validatePoseRelativeToGraph: "
-                  << error.Message()
-                  << std::endl;
-      }
-      worldResult = false;
+      _err << "Error in validatePoseRelativeToGraph: "
+           << error.Message()
+           << std::endl;
     }
-    return worldResult;
-  };
+    scopeResult = false;
+  }
+  return scopeResult;
+}
+
+//////////////////////////////////////////////////
+bool checkPoseRelativeToGraph(const sdf::Root *_root)
+{
+  bool result = true;
 
   if (_root->Model())
   {
-    result = checkModelPoseRelativeToGraph(_root->Model()) && result;
+    result = checkScopePoseRelativeToGraph(_root->Model(), std::cerr) &&
+        result;
   }
 
   for (uint64_t w = 0; w < _root->WorldCount(); ++w)
   {
     auto world = _root->WorldByIndex(w);
-    result = checkWorldPoseRelativeToGraph(world) && result;
+    result = checkScopePoseRelativeToGraph(world, std::cerr) && result;
     for (uint64_t m = 0; m < world->ModelCount(); ++m)
     {
       auto model = world->ModelByIndex(m);
-      result = checkModelPoseRelativeToGraph(model) && result;
+      result = checkScopePoseRelativeToGraph(model, std::cerr) && result;
     }
   }
 
@@ -2540,99 +3709,115 @@ bool checkPoseRelativeToGraph(const sdf::Root *_root)
 }
 
 //////////////////////////////////////////////////
-bool checkJointParentChildLinkNames(const sdf::Root *_root)
+/// \brief Print the errors found by checkJointParentChildNames.
+/// \param[in] _errors Errors found in the joints.
+/// \param[out] _err Stream for the errors.
+/// \return True if there are no errors.
+static bool reportJointParentChildLinkNames(const Errors &_errors,
+    std::ostream &_err)
 {
-  Errors errors;
-  checkJointParentChildNames(_root, errors);
-  if (!errors.empty())
+  if (!_errors.empty())
   {
-    std::cerr << "Error when attempting to resolve child link name:"
-              << std::endl
-              << errors;
+    _err << "Error when attempting to resolve child link name:"
+         << std::endl
+         << _errors;
     return false;
   }
   return true;
 }
 
 //////////////////////////////////////////////////
-void checkJointParentChildNames(const sdf::Root *_root, Errors &_errors)
+bool checkJointParentChildLinkNames(const sdf::Root *_root)
 {
-  auto checkModelJointParentChildNames = [](
-      const sdf::Model *_model, Errors &errors) -> void
+  Errors errors;
+  checkJointParentChildNames(_root, errors);
+  return reportJointParentChildLinkNames(errors, std::cerr);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the joints of a model specify valid and different
+/// parent and child frames.
+/// \param[in] _model Model to check.
+/// \param[out] errors Detected errors will be appended to this variable.
+static void checkModelJointParentChildNames(
+    const sdf::Model *_model, Errors &errors)
+{
+  for (uint64_t j = 0; j < _model->JointCount(); ++j)
   {
-    for (uint64_t j = 0; j < _model->JointCount(); ++j)
-    {
-      auto joint = _model->JointByIndex(j);
+    auto joint = _model->JointByIndex(j);
 
-      const std::string &parentName = joint->ParentLinkName();
-      const std::string parentLocalName = sdf::SplitName(parentName).second;
+    const std::string &parentName = joint->ParentLinkName();
+    const std::string parentLocalName = sdf::SplitName(parentName).second;
 
-      if (parentName != "world" && parentLocalName != "__model__" &&
-          !_model->NameExistsInFrameAttachedToGraph(parentName))
-      {
-        errors.push_back({ErrorCode::JOINT_PARENT_LINK_INVALID,
-          "parent frame with name[" + parentName +
-          "] specified by joint with name[" + joint->Name() +
-          "] not found in model with name[" + _model->Name() + "]."});
-      }
+    if (parentName != "world" && parentLocalName != "__model__" &&
+        !_model->NameExistsInFrameAttachedToGraph(parentName))
+    {
+      errors.push_back({ErrorCode::JOINT_PARENT_LINK_INVALID,
+        "parent frame with name[" + parentName +
+        "] specified by joint with name[" + joint->Name() +
+        "] not found in model with name[" + _model->Name() + "]."});
+    }
 
-      const std::string &childName = joint->ChildLinkName();
-      const std::string childLocalName = sdf::SplitName(childName).second;
-      if (childName == "world")
-      {
-        errors.push_back({ErrorCode::JOINT_CHILD_LINK_INVALID,
-          "invalid child name[world] specified by joint with name[" +
-          joint->Name() + "] in model with name[" + _model->Name() + "]."});
-      }
+    const std::string &childName = joint->ChildLinkName();
+    const std::string childLocalName = sdf::SplitName(childName).second;
+    if (childName == "world")
+    {
+      errors.push_back({ErrorCode::JOINT_CHILD_LINK_INVALID,
+        "invalid child name[world] specified by joint with name[" +
+        joint->Name() + "] in model with name[" + _model->Name() + "]."});
+    }
 
-      if (childLocalName != "__model__" &&
-          !_model->NameExistsInFrameAttachedToGraph(childName))
-      {
-        errors.push_back({ErrorCode::JOINT_CHILD_LINK_INVALID,
-          "child frame with name[" + childName +
-          "] specified by joint with name[" + joint->Name() +
-          "] not found in model with name[" + _model->Name() + "]."});
-      }
+    if (childLocalName != "__model__" &&
+        !_model->NameExistsInFrameAttachedToGraph(childName))
+    {
+      errors.push_back({ErrorCode::JOINT_CHILD_LINK_INVALID,
+        "child frame with name[" + childName +
+        "] specified by joint with name[" + joint->Name() +
+        "] not found in model with name[" + _model->Name() + "]."});
+    }
 
-      if (childName == joint->Name())
-      {
-        errors.push_back({ErrorCode::JOINT_CHILD_LINK_INVALID,
-          "joint with name[" + joint->Name() +
-          "] in model with name[" + _model->Name() +
-          "] must not specify its own name as the child frame."});
-      }
+    if (childName == joint->Name())
+    {
+      errors.push_back({ErrorCode::JOINT_CHILD_LINK_INVALID,
+        "joint with name[" + joint->Name() +
+        "] in model with name[" + _model->Name() +
+        "] must not specify its own name as the child frame."});
+    }
 
-      if (parentName == joint->Name())
-      {
-        errors.push_back({ErrorCode::JOINT_PARENT_LINK_INVALID,
-          "joint with name[" + joint->Name() +
-          "] in model with name[" + _model->Name() +
-          "] must not specify its own name as the parent frame."});
-      }
+    if (parentName == joint->Name())
+    {
+      errors.push_back({ErrorCode::JOINT_PARENT_LINK_INVALID,
+        "joint with name[" + joint->Name() +
+        "] in model with name[" + _model->Name() +
+        "] must not specify its own name as the parent frame."});
+    }
 
-      // Check that parent and child frames resolve to different links
-      std::string resolvedChildName;
-      std::string resolvedParentName;
+    // Check that parent and child frames resolve to different links
+    std::string resolvedChildName;
+    std::string resolvedParentName;
 
-      auto resolveErrors = joint->ResolveChildLink(resolvedChildName);
-      errors.insert(errors.end(), resolveErrors.begin(), resolveErrors.end());
+    auto resolveErrors = joint->ResolveChildLink(resolvedChildName);
+    errors.insert(errors.end(), resolveErrors.begin(), resolveErrors.end());
 
-      resolveErrors = joint->ResolveParentLink(resolvedParentName);
-      errors.insert(errors.end(), resolveErrors.begin(), resolveErrors.end());
+    resolveErrors = joint->ResolveParentLink(resolvedParentName);
+    errors.insert(errors.end(), resolveErrors.begin(), resolveErrors.end());
 
-      if (resolvedChildName == resolvedParentName)
-      {
-        errors.push_back({ErrorCode::JOINT_PARENT_SAME_AS_CHILD,
-          "joint with name[" + joint->Name() +
-          "] in model with name[" + _model->Name() +
-          "] specified parent frame [" + parentName +
-          "] and child frame [" + childName +
-          "] that both resolve to [" + resolvedChildName +
-          "], but they should resolve to different values."});
-      }
+    if (resolvedChildName == resolvedParentName)
+    {
+      errors.push_back({ErrorCode::JOINT_PARENT_SAME_AS_CHILD,
+        "joint with name[" + joint->Name() +
+        "] in model with name[" + _model->Name() +
+        "] specified parent frame [" + parentName +
+        "] and child frame [" + childName +
+        "] that both resolve to [" + resolvedChildName +
+        "], but they should resolve to different values."});
     }
-  };
+  }
+}
 
+//////////////////////////////////////////////////
+void checkJointParentChildNames(const sdf::Root *_root, Errors &_errors)
+{
   if (_root->Model())
   {
     checkModelJointParentChildNames(_root->Model(), _errors);
@@ -2649,6 +3834,62 @@ void checkJointParentChildNames(const sdf::Root *_root, Errors &_errors)
   }
 }
 
+//////////////////////////////////////////////////
+bool checkRoot(const sdf::Root *_root)
+{
+  return checkRoot(_root, std::cerr);
+}
+
+//////////////////////////////////////////////////
+bool checkRoot(const sdf::Root *_root, std::ostream &_err)
+{
+  if (!_root)
+  {
+    _err << "Error: invalid sdf::Root pointer, unable to "
+         << "check the root."
+         << std::endl;
+    return false;
+  }
+
+  bool result = true;
+  Errors jointErrors;
+
+  auto checkModel = [&](const sdf::Model *_model)
+  {
+    result = checkModelCanonicalLinkName(_model, _err) && result;
+    checkModelJointParentChildNames(_model, jointErrors);
+    result = checkScopeFrameAttachedToGraph(_model, _err) && result;
+    result = checkScopePoseRelativeToGraph(_model, _err) && result;
+  };
+
+  if (_root->Model())
+  {
+    checkModel(_root->Model());
+  }
+
+  for (uint64_t w = 0; w < _root->WorldCount(); ++w)
+  {
+    auto world = _root->WorldByIndex(w);
+    result = checkScopeFrameAttachedToGraph(world, _err) && result;
+    result = checkScopePoseRelativeToGraph(world, _err) && result;
+    for (uint64_t m = 0; m < world->ModelCount(); ++m)
+    {
+      checkModel(world->ModelByIndex(m));
+    }
+  }
+
+  result = reportJointParentChildLinkNames(jointErrors, _err) && result;
+
+  if (_root->Element())
+  {
+    NameCheckBuffers buffers;
+    result = checkNamesInElement(_root->Element(), false, true, false, false,
+        buffers, _err) && result;
+  }
+
+  return result;
+}
+
 //////////////////////////////////////////////////
 bool shouldValidateElement(sdf::ElementPtr _elem)
 {
@@ -2671,7 +3912,10 @@ bool shouldValidateElement(sdf::ElementPtr _elem)
 /////////////////////////////////////////////////
 std::string computeMergedModelProxyFrameName(const std::string &_modelName)
 {
-  return "_merged__" + _modelName + "__model__";
+  std::string name;
+  name.reserve(_modelName.size() + 18);
+  name.append("_merged__").append(_modelName).append("__model__");
+  return name;
 }
 }
 }
@@ -18,11 +18,16 @@
 #include <sstream>
 #include <fstream>
 #include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 #include "sdf/parser.hh"
 #include "sdf/Element.hh"
 #include "sdf/Console.hh"
 #include "sdf/Filesystem.hh"
+#include "sdf/Model.hh"
+#include "sdf/Root.hh"
 #include "test_config.h"
 
 /////////////////////////////////////////////////
@@ -277,6 +282,70 @@ TEST(Parser, NameUniqueness)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(Parser, RecursiveCheckNames)
+{
+  // Each rule of the combined check matches the individual validator.
+  const std::vector<std::string> files = {
+    "world_duplicate.sdf",
+    "world_sibling_same_names.sdf",
+    "model_duplicate_links.sdf",
+    "model_link_joint_same_name.sdf",
+    "link_duplicate_cousin_collisions.sdf",
+    "link_duplicate_cousin_visuals.sdf",
+  };
+  for (const auto &file : files)
+  {
+    const auto path = sdf::testing::TestFile("sdf", file);
+    sdf::SDFPtr sdf = InitSDF();
+    ASSERT_TRUE(sdf::readFile(path, sdf)) << file;
+
+    const bool sameType = sdf::recursiveSameTypeUniqueNames(sdf->Root());
+    const bool sibling = sdf::recursiveSiblingUniqueNames(sdf->Root());
+    const bool doubleColon =
+        sdf::recursiveSiblingNoDoubleColonInNames(sdf->Root());
+    EXPECT_EQ(sameType,
+        sdf::recursiveCheckNames(sdf->Root(), true, false, false)) << file;
+    EXPECT_EQ(sibling,
+        sdf::recursiveCheckNames(sdf->Root(), false, true, false)) << file;
+    EXPECT_EQ(doubleColon,
+        sdf::recursiveCheckNames(sdf->Root(), false, false, true)) << file;
+    EXPECT_EQ(sameType && sibling && doubleColon,
+        sdf::recursiveCheckNames(sdf->Root())) << file;
+  }
+
+  // An empty root has nothing to check, and a null root is an error.
+  sdf::Root root;
+  EXPECT_TRUE(sdf::checkRoot(&root));
+  EXPECT_FALSE(sdf::checkRoot(nullptr));
+}
+
+/////////////////////////////////////////////////
+TEST(Parser, CheckRootStream)
+{
+  // The errors go to the given stream only.
+  std::stringstream buffer;
+  auto old = std::cerr.rdbuf(buffer.rdbuf());
+
+  sdf::Root root;
+  sdf::Errors errors = root.Load(
+      sdf::testing::TestFile("sdf", "world_sibling_same_names.sdf"));
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  std::ostringstream err;
+  EXPECT_FALSE(sdf::checkRoot(&root, err));
+  EXPECT_NE(err.str().find("Error: Non-unique names detected in "),
+            std::string::npos) << err.str();
+
+  std::ostringstream nullErr;
+  EXPECT_FALSE(sdf::checkRoot(nullptr, nullErr));
+  EXPECT_NE(nullErr.str().find("invalid sdf::Root pointer"),
+            std::string::npos) << nullErr.str();
+
+  std::cerr.rdbuf(old);
+  EXPECT_TRUE(buffer.str().empty()) << buffer.str();
+}
+
 /////////////////////////////////////////////////
 /// Check that _a contains _b
 static bool contains(const std::string &_a, const std::string &_b)
@@ -831,6 +900,165 @@ TEST(Parser, ElementRemovedAfterDeprecation)
   EXPECT_EQ(errors[0].LineNumber().value(), 10);
 }
 
+/////////////////////////////////////////////////
+/// Check that two element descriptions are the same, including their child
+/// element descriptions.
+void ExpectSameDescription(sdf::ElementConstPtr _expected,
+                           sdf::ElementConstPtr _actual)
+{
+  ASSERT_NE(nullptr, _expected);
+  ASSERT_NE(nullptr, _actual);
+  const std::string name = _expected->GetName();
+  EXPECT_EQ(name, _actual->GetName());
+  EXPECT_EQ(_expected->GetRequired(), _actual->GetRequired()) << name;
+  EXPECT_EQ(_expected->GetDescription(), _actual->GetDescription()) << name;
+  EXPECT_EQ(_expected->ReferenceSDF(), _actual->ReferenceSDF()) << name;
+  EXPECT_EQ(_expected->GetCopyChildren(), _actual->GetCopyChildren()) << name;
+
+  auto expectSameParam = [&name](sdf::ParamPtr _a, sdf::ParamPtr _b)
+  {
+    ASSERT_NE(nullptr, _a) << name;
+    ASSERT_NE(nullptr, _b) << name;
+    EXPECT_EQ(_a->GetKey(), _b->GetKey()) << name;
+    EXPECT_EQ(_a->GetTypeName(), _b->GetTypeName()) << name;
+    EXPECT_EQ(_a->GetDefaultAsString(), _b->GetDefaultAsString()) << name;
+    EXPECT_EQ(_a->GetRequired(), _b->GetRequired()) << name;
+    EXPECT_EQ(_a->GetDescription(), _b->GetDescription()) << name;
+    EXPECT_EQ(_a->GetMinValueAsString(), _b->GetMinValueAsString()) << name;
+    EXPECT_EQ(_a->GetMaxValueAsString(), _b->GetMaxValueAsString()) << name;
+  };
+
+  ASSERT_EQ(nullptr == _expected->GetValue(), nullptr == _actual->GetValue())
+      << name;
+  if (_expected->GetValue())
+    expectSameParam(_expected->GetValue(), _actual->GetValue());
+
+  ASSERT_EQ(_expected->GetAttributeCount(), _actual->GetAttributeCount())
+      << name;
+  for (unsigned int i = 0; i < _expected->GetAttributeCount(); ++i)
+    expectSameParam(_expected->GetAttribute(i), _actual->GetAttribute(i));
+
+  ASSERT_EQ(_expected->GetElementDescriptionCount(),
+            _actual->GetElementDescriptionCount()) << name;
+  for (unsigned int i = 0; i < _expected->GetElementDescriptionCount(); ++i)
+  {
+    ExpectSameDescription(_expected->GetElementDescription(i),
+                          _actual->GetElementDescription(i));
+  }
+}
+
+/////////////////////////////////////////////////
+/// Check that the specification files pre-parsed when building the library
+/// give the same descriptions as parsing their XML. The XML of each file is
+/// parsed on its own, with included files taken from the pre-parsed files,
+/// so every file is compared once.
+TEST(Parser, EmbeddedSchemaMatchesXml)
+{
+  std::string pathBase;
+  ASSERT_TRUE(sdf::testing::ProjectSourcePath(pathBase));
+  const std::string specDir =
+      sdf::filesystem::append(pathBase, "sdf", SDF_PROTOCOL_VERSION);
+
+  std::size_t fileCount = 0;
+  for (sdf::filesystem::DirIter dirIter(specDir);
+       dirIter != sdf::filesystem::DirIter(); ++dirIter)
+  {
+    const std::string filename = sdf::filesystem::basename(*dirIter);
+    if (filename.size() < 4 ||
+        filename.compare(filename.size() - 4, 4, ".sdf") != 0)
+    {
+      continue;
+    }
+    ++fileCount;
+
+    sdf::SDFPtr fromSchema(new sdf::SDF());
+    ASSERT_TRUE(sdf::initFile(filename, fromSchema)) << filename;
+
+    sdf::SDFPtr fromXml(new sdf::SDF());
+    ASSERT_TRUE(sdf::initString(sdf::SDF::EmbeddedSpec(filename, false),
+                                fromXml)) << filename;
+
+    ExpectSameDescription(fromXml->Root(), fromSchema->Root());
+  }
+  EXPECT_LT(0u, fileCount);
+}
+
+/////////////////////////////////////////////////
+TEST(Parser, SharedDescriptionTemplate)
+{
+  sdf::SDFPtr first(new sdf::SDF());
+  sdf::SDFPtr second(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(first));
+  ASSERT_TRUE(sdf::init(second));
+
+  // Element descriptions are built once and shared between roots.
+  sdf::ElementConstPtr world =
+      first->Root()->GetElementDescription("world");
+  ASSERT_NE(nullptr, world);
+  EXPECT_EQ(world, second->Root()->GetElementDescription("world"));
+
+  // Attributes and values belong to each root.
+  ASSERT_TRUE(first->Root()->GetAttribute("version")->Set<std::string>("1.0"));
+  EXPECT_NE(first->Root()->GetAttribute("version"),
+            second->Root()->GetAttribute("version"));
+  EXPECT_NE("1.0", second->Root()->GetAttribute("version")->GetAsString());
+
+  // Elements added to one root do not appear in the other.
+  first->Root()->AddElement("world");
+  EXPECT_TRUE(first->Root()->HasElement("world"));
+  EXPECT_FALSE(second->Root()->HasElement("world"));
+
+  sdf::SDFPtr third(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(third));
+  EXPECT_FALSE(third->Root()->HasElement("world"));
+  EXPECT_EQ(world, third->Root()->GetElementDescription("world"));
+
+  // Files that are included by another file share the same description too.
+  sdf::ElementPtr link(new sdf::Element);
+  ASSERT_TRUE(sdf::initFile("link.sdf", link));
+  sdf::ElementConstPtr model = world->GetElementDescription("model");
+  ASSERT_NE(nullptr, model);
+  ASSERT_NE(nullptr, model->GetElementDescription("link"));
+  EXPECT_EQ(link->GetElementDescription("visual"),
+            model->GetElementDescription("link")->GetElementDescription(
+                "visual"));
+}
+
+/////////////////////////////////////////////////
+TEST(Parser, ToElementSharesDescriptions)
+{
+  sdf::Model first;
+  first.SetName("first");
+  sdf::Model second;
+  second.SetName("second");
+
+  // The elements of the DOM objects are initialized from the same
+  // description, and have attributes of their own.
+  sdf::ElementPtr firstElem = first.ToElement();
+  sdf::ElementPtr secondElem = second.ToElement();
+  ASSERT_NE(nullptr, firstElem);
+  ASSERT_NE(nullptr, secondElem);
+  ASSERT_NE(nullptr, firstElem->GetElementDescription("link"));
+  EXPECT_EQ(firstElem->GetElementDescription("link"),
+            secondElem->GetElementDescription("link"));
+  EXPECT_NE(firstElem->GetAttribute("name"),
+            secondElem->GetAttribute("name"));
+  EXPECT_EQ("first", firstElem->Get<std::string>("name"));
+  EXPECT_EQ("second", secondElem->Get<std::string>("name"));
+  EXPECT_EQ(firstElem, firstElem->GetAttribute("name")->GetParentElement());
+
+  // Descriptions used from another thread are the same
+  sdf::ElementPtr threadElem;
+  std::thread thread([&]()
+  {
+    threadElem = sdf::Model().ToElement();
+  });
+  thread.join();
+  ASSERT_NE(nullptr, threadElem);
+  EXPECT_EQ(firstElem->GetElementDescription("link"),
+            threadElem->GetElementDescription("link"));
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -19,6 +19,7 @@
 
 #include <tinyxml2.h>
 
+#include <ostream>
 #include <string>
 
 #include "sdf/SDFImpl.hh"
@@ -113,14 +114,54 @@ namespace sdf
   bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
       const ParserConfig &_config, const std::string &_source, Errors &_errors);
 
+  /// \brief Read the entity of an <include> element again, for example after
+  /// the included file changed. The <include> is resolved and read as it was
+  /// when its parent was read.
+  /// \remark For internal use only. Do not use this function.
+  /// \param[in] _include The <include> element, as stored by the included
+  /// entity, see Element::GetIncludeElement.
+  /// \param[in] _parent Element that contains the <include>.
+  /// \param[in] _config Custom parser configuration
+  /// \param[in] _source Source of the document that contains the <include>.
+  /// \param[out] _errors Captures errors found during parsing.
+  /// \return The element of the included entity, whose parent is _parent but
+  /// which is not one of its children, or nullptr if it could not be read.
+  ElementPtr readIncludeElement(const ElementPtr &_include,
+      const ElementPtr &_parent, const ParserConfig &_config,
+      const std::string &_source, Errors &_errors);
+
   /// \brief Copy child XML elements into the _sdf element.
   /// \param[in] _sdf Parent Element.
   /// \param[in] _xml Pointer to element from which child elements should be
   /// copied.
   /// \param[in] _onlyUnknown True to copy only elements that are NOT part of
   /// the SDF spec. Set this to false to copy everything.
+  /// \param[in] _config Custom parser configuration. Elements that are not
+  /// part of the SDF spec are copied as XML text if
+  /// ParserConfig::CopyElementsAsRawXml is enabled.
   void copyChildren(ElementPtr _sdf, tinyxml2::XMLElement *_xml,
-                    const bool _onlyUnknown);
+                    const bool _onlyUnknown, const ParserConfig &_config);
+
+  /// \brief Run the checks of recursiveCheckNames that are enabled and, in
+  /// the same traversal, warn about the non-unique names of the children of
+  /// each <world> and <model> with the warnings of World::Load and
+  /// Model::Load. Root::Load uses this to check the names of a document once,
+  /// see ScopedCheckedNames.
+  /// \remark For internal use only. Do not use this function.
+  /// \param[in] _elem SDF Element to check recursively.
+  /// \param[in] _sameTypeUniqueNames True to check that sibling elements of
+  /// the same type have unique names.
+  /// \param[in] _siblingUniqueNames True to check that sibling elements of
+  /// any type have unique names.
+  /// \param[in] _noDoubleColonInNames True to check that element names do
+  /// not contain the delimiter '::'.
+  /// \param[in] _warnNonUniqueDomNames True to warn about the non-unique
+  /// names of the children of worlds and models.
+  /// \param[out] _err Stream for the errors of the checks.
+  /// \return True if all enabled checks are satisfied.
+  bool recursiveCheckNames(ElementPtr _elem, bool _sameTypeUniqueNames,
+      bool _siblingUniqueNames, bool _noDoubleColonInNames,
+      bool _warnNonUniqueDomNames, std::ostream &_err);
   }
 }
 #endif
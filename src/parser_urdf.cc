@@ -16,12 +16,18 @@
  */
 
 #include <algorithm>
+#include <charconv>
+#include <cstdint>
 #include <fstream>
+#include <iomanip>
 #include <map>
 #include <memory>
+#include <random>
 #include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -31,10 +37,13 @@
 #include <urdf_model/link.h>
 #include <urdf_parser/urdf_parser.h>
 
+#include "sdf/Filesystem.hh"
 #include "sdf/sdf.hh"
 
+#include "DocumentFormat.hh"
 #include "XmlUtils.hh"
 #include "SDFExtension.hh"
+#include "Utils.hh"
 #include "parser_urdf.hh"
 
 using namespace sdf;
@@ -49,19 +58,61 @@ typedef std::shared_ptr<SDFExtension> SDFExtensionPtr;
 typedef std::map<std::string, std::vector<SDFExtensionPtr> >
   StringSDFExtensionPtrMap;
 
-/// create SDF geometry block based on URDF
-StringSDFExtensionPtrMap g_extensions;
-bool g_reduceFixedJoints;
-bool g_enforceLimits;
 const char kCollisionExt[] = "_collision";
 const char kVisualExt[] = "_visual";
 const char kLumpPrefix[] = "_fixed_joint_lump__";
-urdf::Pose g_initialRobotPose;
-bool g_initialRobotPoseValid = false;
-std::set<std::string> g_fixedJointsTransformedInRevoluteJoints;
-std::set<std::string> g_fixedJointsTransformedInFixedJoints;
 const int g_outputDecimalPrecision = 16;
 
+/// \brief State of a URDF conversion. Each URDF2SDF instance owns its own,
+/// so different instances can convert models on different threads at the
+/// same time.
+class URDF2SDFPrivate
+{
+  /// \brief SDF extensions parsed from the <gazebo> elements, indexed by
+  /// the name of the element they refer to.
+  public: StringSDFExtensionPtrMap extensions;
+
+  /// \brief True to lump links connected by fixed joints.
+  public: bool reduceFixedJoints = true;
+
+  /// \brief True to enforce joint limits.
+  public: bool enforceLimits = true;
+
+  /// \brief Pose of the robot given by a <gazebo> extension.
+  public: urdf::Pose initialRobotPose;
+
+  /// \brief True if initialRobotPose was set.
+  public: bool initialRobotPoseValid = false;
+
+  /// \brief Fixed joints converted to revolute joints.
+  public: std::set<std::string> fixedJointsTransformedInRevoluteJoints;
+
+  /// \brief Fixed joints that are kept as fixed joints.
+  public: std::set<std::string> fixedJointsTransformedInFixedJoints;
+};
+
+/// \brief A link that is kept by fixed joint reduction, together with the
+/// visuals and collisions it holds, so that lumping a visual or collision
+/// into it does not search its arrays.
+struct LumpTarget
+{
+  /// \brief The link.
+  urdf::LinkSharedPtr link;
+
+  /// \brief Visuals of the link.
+  std::unordered_set<const urdf::Visual *> visuals;
+
+  /// \brief Collisions of the link.
+  std::unordered_set<const urdf::Collision *> collisions;
+};
+
+/// \brief State of a fixed joint reduction.
+struct FixedJointReduction
+{
+  /// \brief Extensions with a blob that can refer to a link by name, which
+  /// are the only ones ReduceSDFExtensionFrameReplace can change.
+  std::vector<SDFExtensionPtr> frameExtensions;
+};
 
 /// \brief parser xml string into urdf::Vector3
 /// \param[in] _key XML key where vector3 value might be
@@ -71,25 +122,30 @@ urdf::Vector3 ParseVector3(tinyxml2::XMLNode *_key, double _scale = 1.0);
 urdf::Vector3 ParseVector3(const std::string &_str, double _scale = 1.0);
 
 /// insert extensions into collision geoms
-void InsertSDFExtensionCollision(tinyxml2::XMLElement *_elem,
+void InsertSDFExtensionCollision(const URDF2SDFPrivate &_state,
+                                 tinyxml2::XMLElement *_elem,
                                  const std::string &_linkName);
 
 /// insert extensions into model
-void InsertSDFExtensionRobot(tinyxml2::XMLElement *_elem);
+void InsertSDFExtensionRobot(const URDF2SDFPrivate &_state,
+                             tinyxml2::XMLElement *_elem);
 
 /// insert extensions into visuals
-void InsertSDFExtensionVisual(tinyxml2::XMLElement *_elem,
+void InsertSDFExtensionVisual(const URDF2SDFPrivate &_state,
+                              tinyxml2::XMLElement *_elem,
                               const std::string &_linkName);
 
 
 /// insert extensions into joints
-void InsertSDFExtensionJoint(tinyxml2::XMLElement *_elem,
+void InsertSDFExtensionJoint(const URDF2SDFPrivate &_state,
+                             tinyxml2::XMLElement *_elem,
                              const std::string &_jointName);
 
 /// reduced fixed joints:  check if a fixed joint should be lumped
 ///   checking both the joint type and if disabledFixedJointLumping
 ///   option is set
-bool FixedJointShouldBeReduced(urdf::JointSharedPtr _jnt);
+bool FixedJointShouldBeReduced(const URDF2SDFPrivate &_state,
+                               urdf::JointSharedPtr _jnt);
 
 /// reduced fixed joints:  apply transform reduction for ray sensors
 ///   in extensions when doing fixed joint reduction
@@ -108,42 +164,55 @@ void ReduceSDFExtensionProjectorTransformReduction(
 ///   when doing fixed joint reduction
 void ReduceSDFExtensionsTransform(SDFExtensionPtr _ge);
 
-/// reduce fixed joints:  lump joints to parent link
-void ReduceJointsToParent(urdf::LinkSharedPtr _link);
+/// reduce fixed joints:  check if a link is lumped into its parent
+bool LinkShouldBeReduced(const URDF2SDFPrivate &_state,
+                         urdf::LinkConstSharedPtr _link);
 
-/// reduce fixed joints:  lump collisions to parent link
-void ReduceCollisionsToParent(urdf::LinkSharedPtr _link);
+/// reduce fixed joints:  lump joints to the link kept for a reduced link
+void ReduceJointsToParent(const URDF2SDFPrivate &_state,
+                          urdf::LinkSharedPtr _link, LumpTarget &_target,
+    const ignition::math::Pose3d &_linkToTarget);
 
-/// reduce fixed joints:  lump visuals to parent link
-void ReduceVisualsToParent(urdf::LinkSharedPtr _link);
+/// reduce fixed joints:  lump collisions to the link kept for a reduced link
+void ReduceCollisionsToParent(urdf::LinkSharedPtr _link, LumpTarget &_target,
+    const ignition::math::Pose3d &_linkToTarget);
+
+/// reduce fixed joints:  lump visuals to the link kept for a reduced link
+void ReduceVisualsToParent(urdf::LinkSharedPtr _link, LumpTarget &_target,
+    const ignition::math::Pose3d &_linkToTarget);
 
 /// reduce fixed joints:  lump inertial to parent link
 void ReduceInertialToParent(urdf::LinkSharedPtr /*_link*/);
 
 /// create SDF Collision block based on URDF
-void CreateCollision(tinyxml2::XMLElement* _elem,
+void CreateCollision(const URDF2SDFPrivate &_state, tinyxml2::XMLElement* _elem,
                      urdf::LinkConstSharedPtr _link,
                      urdf::CollisionSharedPtr _collision,
                      const std::string &_oldLinkName = std::string(""));
 
 /// create SDF Visual block based on URDF
-void CreateVisual(tinyxml2::XMLElement *_elem, urdf::LinkConstSharedPtr _link,
+void CreateVisual(const URDF2SDFPrivate &_state,
+                  tinyxml2::XMLElement *_elem, urdf::LinkConstSharedPtr _link,
                   urdf::VisualSharedPtr _visual,
                   const std::string &_oldLinkName = std::string(""));
 
 /// create SDF Joint block based on URDF
-void CreateJoint(tinyxml2::XMLElement *_root, urdf::LinkConstSharedPtr _link,
+void CreateJoint(const URDF2SDFPrivate &_state,
+                 tinyxml2::XMLElement *_root, urdf::LinkConstSharedPtr _link,
                  ignition::math::Pose3d &_currentTransform);
 
 /// insert extensions into links
-void InsertSDFExtensionLink(tinyxml2::XMLElement *_elem,
+void InsertSDFExtensionLink(const URDF2SDFPrivate &_state,
+                            tinyxml2::XMLElement *_elem,
                             const std::string &_linkName);
 
 /// create visual blocks from urdf visuals
-void CreateVisuals(tinyxml2::XMLElement* _elem, urdf::LinkConstSharedPtr _link);
+void CreateVisuals(const URDF2SDFPrivate &_state,
+                   tinyxml2::XMLElement* _elem, urdf::LinkConstSharedPtr _link);
 
 /// create collision blocks from urdf collisions
-void CreateCollisions(tinyxml2::XMLElement* _elem,
+void CreateCollisions(const URDF2SDFPrivate &_state,
+                      tinyxml2::XMLElement* _elem,
                       urdf::LinkConstSharedPtr _link);
 
 /// create SDF Inertial block based on URDF
@@ -155,11 +224,13 @@ void AddTransform(tinyxml2::XMLElement *_elem,
     const ignition::math::Pose3d &_transform);
 
 /// create SDF from URDF link
-void CreateSDF(tinyxml2::XMLElement *_root, urdf::LinkConstSharedPtr _link,
+void CreateSDF(const URDF2SDFPrivate &_state,
+               tinyxml2::XMLElement *_root, urdf::LinkConstSharedPtr _link,
                const ignition::math::Pose3d &_transform);
 
 /// create SDF Link block based on URDF
-void CreateLink(tinyxml2::XMLElement *_root, urdf::LinkConstSharedPtr _link,
+void CreateLink(const URDF2SDFPrivate &_state,
+                tinyxml2::XMLElement *_root, urdf::LinkConstSharedPtr _link,
                 ignition::math::Pose3d &_currentTransform);
 
 /// reduced fixed joints:  apply appropriate frame updates in joint
@@ -203,8 +274,12 @@ void ReduceSDFExtensionContactSensorFrameReplace(
 /// referenced link names with plugins and update references to current
 /// link to the parent link. (ReduceSDFExtensionFrameReplace())
 ///
+/// \param[in,out] _state state of the conversion
 /// \param[in] _link pointer to urdf link, its extensions will be reduced
-void ReduceSDFExtensionToParent(urdf::LinkSharedPtr _link);
+/// \param[in] _reduction state of the fixed joint reduction
+void ReduceSDFExtensionToParent(URDF2SDFPrivate &_state,
+                                urdf::LinkSharedPtr _link,
+    const FixedJointReduction &_reduction);
 
 /// reduced fixed joints:  apply appropriate frame updates
 ///   in urdf extensions when doing fixed joint reduction
@@ -252,16 +327,61 @@ ignition::math::Pose3d CopyPose(urdf::Pose _pose);
 ///   math::Pose
 urdf::Pose CopyPose(ignition::math::Pose3d _pose);
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Read the contents of a file.
+/// \param[in] _filename Path of the file.
+/// \param[out] _contents Contents of the file.
+/// \return True if the file was read.
+static bool readFileContents(const std::string &_filename,
+                             std::string &_contents)
+{
+  std::ifstream in(_filename, std::ios::binary);
+  if (!in)
+    return false;
+
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  if (in.bad())
+    return false;
+
+  _contents = contents.str();
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Read the contents of a file, from the resource provider of a
+/// configuration if it has one.
+/// \param[in] _filename Path of the file.
+/// \param[in] _config Parser configuration.
+/// \param[out] _contents Contents of the file.
+/// \return True if the file was read.
+static bool readFileContents(const std::string &_filename,
+                             const ParserConfig &_config,
+                             std::string &_contents)
+{
+  auto provider = _config.GetResourceProvider();
+  if (!provider)
+    return readFileContents(_filename, _contents);
+
+  ResourceData data;
+  if (!provider->Read(_filename, data))
+    return false;
+
+  _contents.assign(data.data);
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool URDF2SDF::IsURDF(const std::string &_filename)
 {
-  tinyxml2::XMLDocument xmlDoc;
+  // Files whose root element is known not to be <robot> are not parsed.
+  const DocumentFormat format = sniffFile(_filename).format;
+  if (format != DocumentFormat::URDF && format != DocumentFormat::UNKNOWN)
+    return false;
 
-  if (tinyxml2::XML_SUCCESS == xmlDoc.LoadFile(_filename.c_str()))
+  std::string urdfStr;
+  if (readFileContents(_filename, urdfStr))
   {
-    tinyxml2::XMLPrinter printer;
-    xmlDoc.Print(&printer);
-    std::string urdfStr = printer.CStr();
     urdf::ModelInterfaceSharedPtr robotModel = urdf::parseURDF(urdfStr);
     return robotModel != nullptr;
   }
@@ -272,28 +392,35 @@ bool URDF2SDF::IsURDF(const std::string &_filename)
 /////////////////////////////////////////////////
 urdf::Vector3 ParseVector3(const std::string &_str, double _scale)
 {
-  std::vector<std::string> pieces = sdf::split(_str, " ");
-  std::vector<double> vals;
+  double vals[3];
+  std::size_t valCount = 0;
 
-  for (unsigned int i = 0; i < pieces.size(); ++i)
+  sdf::Tokenizer pieces(_str, " ");
+  std::string_view piece;
+  for (unsigned int i = 0; pieces.Next(piece); ++i)
   {
-    if (pieces[i] != "")
+    if (!piece.empty())
     {
       try
       {
-        vals.push_back(_scale * std::stod(pieces[i]));
+        // More than three values are counted but not kept, since they are
+        // not a 3-tuple.
+        const double val = _scale * std::stod(std::string(piece));
+        if (valCount < 3)
+          vals[valCount] = val;
+        ++valCount;
       }
       catch(std::invalid_argument &)
       {
         sdferr << "xml key [" << _str
-               << "][" << i << "] value [" << pieces[i]
+               << "][" << i << "] value [" << piece
                << "] is not a valid double from a 3-tuple\n";
         return urdf::Vector3(0, 0, 0);
       }
     }
   }
 
-  if (vals.size() == 3)
+  if (valCount == 3)
   {
     return urdf::Vector3(vals[0], vals[1], vals[2]);
   }
@@ -340,113 +467,205 @@ std::string Vector32Str(const urdf::Vector3 _vector)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Check and add collision to parent link
-/// \param[in] _parentLink destination for _collision
+/// \param[in] _target destination for _collision
 /// \param[in] _name urdfdom 0.3+: urdf collision group name with lumped
 ///            collision info (see ReduceCollisionsToParent).
 ///            urdfdom 0.2: collision name with lumped
 ///            collision info (see ReduceCollisionsToParent).
-/// \param[in] _collision move this collision to _parentLink
-void ReduceCollisionToParent(urdf::LinkSharedPtr _parentLink,
+/// \param[in] _collision move this collision to _target
+void ReduceCollisionToParent(LumpTarget &_target,
                              const std::string &_name,
                              urdf::CollisionSharedPtr _collision)
 {
   // added a check to see if _collision already exist in
-  // _parentLink::collision_array if not, add it.
+  // _target.link->collision_array if not, add it.
   _collision->name = _name;
-  std::vector<urdf::CollisionSharedPtr>::iterator collisionIt =
-    find(_parentLink->collision_array.begin(),
-         _parentLink->collision_array.end(),
-         _collision);
-  if (collisionIt != _parentLink->collision_array.end())
+  if (!_target.collisions.insert(_collision.get()).second)
   {
     sdfwarn << "attempted to add collision [" << _collision->name
             << "] to link ["
-            << _parentLink->name
+            << _target.link->name
             << "], but it already exists in collision_array under name ["
-            << (*collisionIt)->name << "]\n";
+            << _collision->name << "]\n";
   }
   else
   {
-    _parentLink->collision_array.push_back(_collision);
+    _target.link->collision_array.push_back(_collision);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Check and add visual to parent link
-/// \param[in] _parentLink destination for _visual
+/// \param[in] _target destination for _visual
 /// \param[in] _name urdfdom 0.3+: urdf visual group name with lumped
 ///            visual info (see ReduceVisualsToParent).
 ///            urdfdom 0.2: visual name with lumped
 ///            visual info (see ReduceVisualsToParent).
-/// \param[in] _visual move this visual to _parentLink
-void ReduceVisualToParent(urdf::LinkSharedPtr _parentLink,
+/// \param[in] _visual move this visual to _target
+void ReduceVisualToParent(LumpTarget &_target,
                           const std::string &_name,
                           urdf::VisualSharedPtr _visual)
 {
   // added a check to see if _visual already exist in
-  // _parentLink::visual_array if not, add it.
+  // _target.link->visual_array if not, add it.
   _visual->name = _name;
-  std::vector<urdf::VisualSharedPtr>::iterator visualIt =
-    find(_parentLink->visual_array.begin(),
-         _parentLink->visual_array.end(),
-         _visual);
-  if (visualIt != _parentLink->visual_array.end())
+  if (!_target.visuals.insert(_visual.get()).second)
   {
     sdfwarn << "attempted to add visual [" << _visual->name
             << "] to link ["
-            << _parentLink->name
+            << _target.link->name
             << "], but it already exists in visual_array under name ["
-            << (*visualIt)->name << "]\n";
+            << _visual->name << "]\n";
   }
   else
   {
-    _parentLink->visual_array.push_back(_visual);
+    _target.link->visual_array.push_back(_visual);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// reduce fixed joints by lumping inertial, visual and
-// collision elements of the child link into the parent link
-void ReduceFixedJoints(tinyxml2::XMLElement *_root, urdf::LinkSharedPtr _link)
+bool LinkShouldBeReduced(const URDF2SDFPrivate &_state,
+                         urdf::LinkConstSharedPtr _link)
+{
+  // skip first joint if it's the world
+  return _link->getParent() && _link->getParent()->name != "world" &&
+         _link->parent_joint &&
+         FixedJointShouldBeReduced(_state, _link->parent_joint);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Lump the visuals, collisions and child joints of the links reduced
+/// by fixed joints into the link that is kept for them, in a single pre-order
+/// traversal. Each visual, collision and joint is transformed once, by the
+/// transform from its link to the kept link accumulated on the way down.
+/// \param[in] _state state of the conversion.
+/// \param[in] _link link to lump, or to keep if it is not reduced.
+/// \param[in] _target link kept for _link if it is reduced.
+/// \param[in] _linkToTarget pose of _link in the frame of _target.
+void LumpFixedJoints(const URDF2SDFPrivate &_state,
+                     urdf::LinkSharedPtr _link, LumpTarget *_target,
+                     const ignition::math::Pose3d &_linkToTarget)
+{
+  LumpTarget kept;
+  LumpTarget *target = _target;
+  ignition::math::Pose3d linkToTarget = _linkToTarget;
+  const bool reduced = nullptr != _target && LinkShouldBeReduced(_state, _link);
+  if (reduced)
+  {
+    sdfdbg << "Fixed Joint Reduction: lumping from ["
+           << _link->name << "] to [" << _target->link->name << "]\n";
+
+    // reduce _link elements to the kept link
+    ReduceVisualsToParent(_link, *_target, _linkToTarget);
+    ReduceCollisionsToParent(_link, *_target, _linkToTarget);
+    ReduceJointsToParent(_state, _link, *_target, _linkToTarget);
+  }
+  else
+  {
+    kept.link = _link;
+    for (const auto &visual : _link->visual_array)
+      kept.visuals.insert(visual.get());
+    for (const auto &collision : _link->collision_array)
+      kept.collisions.insert(collision.get());
+    target = &kept;
+    linkToTarget = ignition::math::Pose3d::Zero;
+  }
+
+  for (const auto &child : _link->child_links)
+  {
+    if (LinkShouldBeReduced(_state, child))
+    {
+      LumpFixedJoints(_state, child, target, TransformToParentFrame(
+          CopyPose(child->parent_joint->parent_to_joint_origin_transform),
+          linkToTarget));
+    }
+    else
+    {
+      LumpFixedJoints(_state, child, nullptr, ignition::math::Pose3d::Zero);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Lump the inertials and extensions of the links reduced by fixed
+/// joints into their parents, in a post-order traversal.
+/// \param[in,out] _state state of the conversion, whose extensions are
+/// moved to the links that are kept.
+/// \param[in] _link link to reduce.
+/// \param[in] _reduction state of the fixed joint reduction.
+void ReduceFixedJoints(URDF2SDFPrivate &_state, urdf::LinkSharedPtr _link,
+                       const FixedJointReduction &_reduction)
 {
   // if child is attached to self by fixed _link first go up the tree,
   //   check it's children recursively
   for (unsigned int i = 0 ; i < _link->child_links.size() ; ++i)
   {
-    if (FixedJointShouldBeReduced(_link->child_links[i]->parent_joint))
+    if (FixedJointShouldBeReduced(_state, _link->child_links[i]->parent_joint))
     {
-      ReduceFixedJoints(_root, _link->child_links[i]);
+      ReduceFixedJoints(_state, _link->child_links[i], _reduction);
     }
   }
 
   // reduce this _link's stuff up the tree to parent but skip first joint
   //   if it's the world
-  if (_link->getParent() && _link->getParent()->name != "world" &&
-      _link->parent_joint && FixedJointShouldBeReduced(_link->parent_joint) )
+  if (LinkShouldBeReduced(_state, _link))
   {
     sdfdbg << "Fixed Joint Reduction: extension lumping from ["
            << _link->name << "] to [" << _link->getParent()->name << "]\n";
 
     // lump sdf extensions to parent, (give them new reference _link names)
-    ReduceSDFExtensionToParent(_link);
+    ReduceSDFExtensionToParent(_state, _link, _reduction);
 
-    // reduce _link elements to parent
+    // reduce _link inertial to parent
     ReduceInertialToParent(_link);
-    ReduceVisualsToParent(_link);
-    ReduceCollisionsToParent(_link);
-    ReduceJointsToParent(_link);
   }
 
   // continue down the tree for non-fixed joints
   for (unsigned int i = 0 ; i < _link->child_links.size() ; ++i)
   {
-    if (!FixedJointShouldBeReduced(_link->child_links[i]->parent_joint))
+    if (!FixedJointShouldBeReduced(_state, _link->child_links[i]->parent_joint))
     {
-      ReduceFixedJoints(_root, _link->child_links[i]);
+      ReduceFixedJoints(_state, _link->child_links[i], _reduction);
     }
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// reduce fixed joints by lumping inertial, visual and
+// collision elements of the child link into the parent link
+void ReduceFixedJoints(URDF2SDFPrivate &_state,
+                       tinyxml2::XMLElement * /*_root*/,
+                       urdf::LinkSharedPtr _link)
+{
+  // Only blobs with these root elements refer to links by name, see
+  // ReduceSDFExtensionFrameReplace. Collect their extensions once, instead
+  // of searching all the extensions for each reduced link.
+  FixedJointReduction reduction;
+  for (const auto &ext : _state.extensions)
+  {
+    for (const auto &ge : ext.second)
+    {
+      for (const auto &blob : ge->blobs)
+      {
+        const tinyxml2::XMLElement *blobRoot = blob->FirstChildElement();
+        if (blobRoot &&
+            (strcmp(blobRoot->Name(), "sensor") == 0 ||
+             strcmp(blobRoot->Name(), "plugin") == 0 ||
+             strcmp(blobRoot->Name(), "projector") == 0 ||
+             strcmp(blobRoot->Name(), "gripper") == 0 ||
+             strcmp(blobRoot->Name(), "joint") == 0))
+        {
+          reduction.frameExtensions.push_back(ge);
+          break;
+        }
+      }
+    }
+  }
+
+  LumpFixedJoints(_state, _link, nullptr, ignition::math::Pose3d::Zero);
+  ReduceFixedJoints(_state, _link, reduction);
+}
+
 // ODE dMatrix
 typedef double dMatrix3[4*3];
 typedef double dVector3[4];
@@ -911,10 +1130,13 @@ void ReduceInertialToParent(urdf::LinkSharedPtr _link)
 /////////////////////////////////////////////////
 /// \brief reduce fixed joints:  lump visuals to parent link
 /// \param[in] _link take all visuals from _link and lump/move them
-///            to the parent link (_link->getParentLink()).
-void ReduceVisualsToParent(urdf::LinkSharedPtr _link)
+///            to the link kept for it.
+/// \param[in] _target link kept for _link.
+/// \param[in] _linkToTarget pose of _link in the frame of _target.
+void ReduceVisualsToParent(urdf::LinkSharedPtr _link, LumpTarget &_target,
+                           const ignition::math::Pose3d &_linkToTarget)
 {
-  // lump all visuals of _link to _link->getParent().
+  // lump all visuals of _link to the kept ancestor _target.
   // modify visual name (urdf 0.3.x) or
   //        visual group name (urdf 0.2.x)
   // to indicate that it was lumped (fixed joint reduced)
@@ -937,7 +1159,7 @@ void ReduceVisualsToParent(urdf::LinkSharedPtr _link)
       newVisualName = (*visualIt)->name;
       sdfdbg << "re-lumping visual [" << (*visualIt)->name
              << "] for link [" << _link->name
-             << "] to parent [" << _link->getParent()->name
+             << "] to parent [" << _target.link->name
              << "] with name [" << newVisualName << "]\n";
     }
     else
@@ -952,29 +1174,30 @@ void ReduceVisualsToParent(urdf::LinkSharedPtr _link)
       }
       sdfdbg << "lumping visual [" << (*visualIt)->name
              << "] for link [" << _link->name
-             << "] to parent [" << _link->getParent()->name
+             << "] to parent [" << _target.link->name
              << "] with name [" << newVisualName << "]\n";
     }
 
     // transform visual origin from _link frame to
-    // parent link frame before adding to parent
-    (*visualIt)->origin = TransformToParentFrame(
-        (*visualIt)->origin,
-        _link->parent_joint->parent_to_joint_origin_transform);
+    // the kept link frame before adding to it
+    (*visualIt)->origin = CopyPose(TransformToParentFrame(
+        CopyPose((*visualIt)->origin), _linkToTarget));
 
     // add the modified visual to parent
-    ReduceVisualToParent(_link->getParent(), newVisualName,
-                         *visualIt);
+    ReduceVisualToParent(_target, newVisualName, *visualIt);
   }
 }
 
 /////////////////////////////////////////////////
 /// \brief reduce fixed joints:  lump collisions to parent link
 /// \param[in] _link take all collisions from _link and lump/move them
-///            to the parent link (_link->getParentLink()).
-void ReduceCollisionsToParent(urdf::LinkSharedPtr _link)
+///            to the link kept for it.
+/// \param[in] _target link kept for _link.
+/// \param[in] _linkToTarget pose of _link in the frame of _target.
+void ReduceCollisionsToParent(urdf::LinkSharedPtr _link, LumpTarget &_target,
+                              const ignition::math::Pose3d &_linkToTarget)
 {
-  // lump all collisions of _link to _link->getParent().
+  // lump all collisions of _link to the kept ancestor _target.
   // modify collision name (urdf 0.3.x) or
   //        collision group name (urdf 0.2.x)
   // to indicate that it was lumped (fixed joint reduced)
@@ -996,7 +1219,7 @@ void ReduceCollisionsToParent(urdf::LinkSharedPtr _link)
       newCollisionName = (*collisionIt)->name;
       sdfdbg << "re-lumping collision [" << (*collisionIt)->name
              << "] for link [" << _link->name
-             << "] to parent [" << _link->getParent()->name
+             << "] to parent [" << _target.link->name
              << "] with name [" << newCollisionName << "]\n";
     }
     else
@@ -1011,52 +1234,47 @@ void ReduceCollisionsToParent(urdf::LinkSharedPtr _link)
       }
       sdfdbg << "lumping collision [" << (*collisionIt)->name
              << "] for link [" << _link->name
-             << "] to parent [" << _link->getParent()->name
+             << "] to parent [" << _target.link->name
              << "] with name [" << newCollisionName << "]\n";
     }
     // transform collision origin from _link frame to
-    // parent link frame before adding to parent
-    (*collisionIt)->origin = TransformToParentFrame(
-        (*collisionIt)->origin,
-        _link->parent_joint->parent_to_joint_origin_transform);
+    // the kept link frame before adding to it
+    (*collisionIt)->origin = CopyPose(TransformToParentFrame(
+        CopyPose((*collisionIt)->origin), _linkToTarget));
 
     // add the modified collision to parent
-    ReduceCollisionToParent(_link->getParent(), newCollisionName,
-                            *collisionIt);
+    ReduceCollisionToParent(_target, newCollisionName, *collisionIt);
   }
 }
 
 /////////////////////////////////////////////////
-/// reduce fixed joints:  lump joints to parent link
-void ReduceJointsToParent(urdf::LinkSharedPtr _link)
+/// \brief reduce fixed joints:  lump joints to parent link
+/// \param[in] _link reduced link whose child joints that are not reduced
+///            are moved to the link kept for it.
+/// \param[in] _target link kept for _link.
+/// \param[in] _linkToTarget pose of _link in the frame of _target.
+void ReduceJointsToParent(const URDF2SDFPrivate &_state,
+                          urdf::LinkSharedPtr _link, LumpTarget &_target,
+                          const ignition::math::Pose3d &_linkToTarget)
 {
   // set child link's parentJoint's parent link to
   // a parent link up stream that does not have a fixed parentJoint
   for (unsigned int i = 0 ; i < _link->child_links.size() ; ++i)
   {
     urdf::JointSharedPtr parentJoint = _link->child_links[i]->parent_joint;
-    if (!FixedJointShouldBeReduced(parentJoint))
-    {
-      // go down the tree until we hit a parent joint that is not fixed
-      urdf::LinkSharedPtr newParentLink = _link;
-      ignition::math::Pose3d jointAnchorTransform;
-      while (newParentLink->parent_joint &&
-             newParentLink->getParent()->name != "world" &&
-             FixedJointShouldBeReduced(newParentLink->parent_joint) )
-      {
-        jointAnchorTransform = jointAnchorTransform * jointAnchorTransform;
-        parentJoint->parent_to_joint_origin_transform =
-          TransformToParentFrame(
-              parentJoint->parent_to_joint_origin_transform,
-              newParentLink->parent_joint->parent_to_joint_origin_transform);
-        newParentLink = newParentLink->getParent();
-      }
+    if (!FixedJointShouldBeReduced(_state, parentJoint))
+    {
+      // the transform to the kept link was accumulated while going down
+      // the tree
+      parentJoint->parent_to_joint_origin_transform =
+        CopyPose(TransformToParentFrame(
+            CopyPose(parentJoint->parent_to_joint_origin_transform),
+            _linkToTarget));
+
       // now set the _link->child_links[i]->parent_joint's parent link to
-      // the newParentLink
-      _link->child_links[i]->setParent(newParentLink);
-      parentJoint->parent_link_name = newParentLink->name;
-      // and set the _link->child_links[i]->parent_joint's
-      // parent_to_joint_origin_transform as the aggregated anchor transform?
+      // the kept link
+      _link->child_links[i]->setParent(_target.link);
+      parentJoint->parent_link_name = _target.link->name;
     }
   }
 }
@@ -1075,14 +1293,8 @@ std::string lowerStr(const std::string &_str)
 
 ////////////////////////////////////////////////////////////////////////////////
 URDF2SDF::URDF2SDF()
+  : dataPtr(new URDF2SDFPrivate)
 {
-  // default options
-  g_enforceLimits = true;
-  g_reduceFixedJoints = true;
-  g_extensions.clear();
-  g_initialRobotPoseValid = false;
-  g_fixedJointsTransformedInRevoluteJoints.clear();
-  g_fixedJointsTransformedInFixedJoints.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1093,37 +1305,68 @@ URDF2SDF::~URDF2SDF()
 
 
 ////////////////////////////////////////////////////////////////////////////////
-std::string Values2str(unsigned int _count, const double *_values)
+/// \brief Append a number to a string the way a stream with the classic
+/// locale and a precision of g_outputDecimalPrecision prints it. The
+/// generated document holds one such string for each value of the model,
+/// so this avoids constructing a stream for each of them.
+/// \param[in,out] _str String to append to.
+/// \param[in] _value Number to append.
+static void appendValue(std::string &_str, double _value)
 {
-  std::stringstream ss;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  char buffer[64];
+  const std::to_chars_result result = std::to_chars(buffer,
+      buffer + sizeof(buffer), _value, std::chars_format::general,
+      g_outputDecimalPrecision);
+  if (result.ec == std::errc())
+  {
+    _str.append(buffer, result.ptr);
+    return;
+  }
+#endif
+  // Floating point std::to_chars is not provided by this standard library.
+  std::ostringstream ss;
+  ss.imbue(std::locale::classic());
   ss.precision(g_outputDecimalPrecision);
+  ss << _value;
+  _str += ss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string Values2str(unsigned int _count, const double *_values)
+{
+  std::string str;
+  str.reserve(_count * 8u);
   for (unsigned int i = 0 ; i < _count ; ++i)
   {
     if (i > 0)
     {
-      ss << " ";
+      str += ' ';
     }
     if (std::fpclassify(_values[i]) == FP_ZERO)
-      ss << 0;
+      str += '0';
     else
-      ss << _values[i];
+      appendValue(str, _values[i]);
   }
-  return ss.str();
+  return str;
 }
 
 /////////////////////////////////////////////////
 std::string Values2str(unsigned int _count, const int *_values)
 {
-  std::stringstream ss;
+  std::string str;
+  char buffer[16];
   for (unsigned int i = 0 ; i < _count ; ++i)
   {
     if (i > 0)
     {
-      ss << " ";
+      str += ' ';
     }
-    ss << _values[i];
+    const std::to_chars_result result =
+        std::to_chars(buffer, buffer + sizeof(buffer), _values[i]);
+    str.append(buffer, result.ptr);
   }
-  return ss.str();
+  return str;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1193,7 +1436,7 @@ std::string GetKeyValueAsString(tinyxml2::XMLElement* _elem)
 }
 
 /////////////////////////////////////////////////
-void ParseRobotOrigin(tinyxml2::XMLDocument &_urdfXml)
+void ParseRobotOrigin(URDF2SDFPrivate &_state, tinyxml2::XMLDocument &_urdfXml)
 {
   tinyxml2::XMLElement *robotXml = _urdfXml.FirstChildElement("robot");
   tinyxml2::XMLElement *originXml = robotXml->FirstChildElement("origin");
@@ -1202,11 +1445,11 @@ void ParseRobotOrigin(tinyxml2::XMLDocument &_urdfXml)
     const char *xyzstr = originXml->Attribute("xyz");
     if (xyzstr == nullptr)
     {
-      g_initialRobotPose.position = urdf::Vector3(0, 0, 0);
+      _state.initialRobotPose.position = urdf::Vector3(0, 0, 0);
     }
     else
     {
-      g_initialRobotPose.position = ParseVector3(std::string(xyzstr));
+      _state.initialRobotPose.position = ParseVector3(std::string(xyzstr));
     }
     const char *rpystr = originXml->Attribute("rpy");
     urdf::Vector3 rpy;
@@ -1218,22 +1461,23 @@ void ParseRobotOrigin(tinyxml2::XMLDocument &_urdfXml)
     {
       rpy = ParseVector3(std::string(rpystr));
     }
-    g_initialRobotPose.rotation.setFromRPY(rpy.x, rpy.y, rpy.z);
-    g_initialRobotPoseValid = true;
+    _state.initialRobotPose.rotation.setFromRPY(rpy.x, rpy.y, rpy.z);
+    _state.initialRobotPoseValid = true;
   }
 }
 
 /////////////////////////////////////////////////
-void InsertRobotOrigin(tinyxml2::XMLElement *_elem)
+void InsertRobotOrigin(const URDF2SDFPrivate &_state,
+                       tinyxml2::XMLElement *_elem)
 {
-  if (g_initialRobotPoseValid)
+  if (_state.initialRobotPoseValid)
   {
     // set transform
     double pose[6];
-    pose[0] = g_initialRobotPose.position.x;
-    pose[1] = g_initialRobotPose.position.y;
-    pose[2] = g_initialRobotPose.position.z;
-    g_initialRobotPose.rotation.getRPY(pose[3], pose[4], pose[5]);
+    pose[0] = _state.initialRobotPose.position.x;
+    pose[1] = _state.initialRobotPose.position.y;
+    pose[2] = _state.initialRobotPose.position.z;
+    _state.initialRobotPose.rotation.getRPY(pose[3], pose[4], pose[5]);
     AddKeyValue(_elem, "pose", Values2str(6, pose));
   }
 }
@@ -1244,7 +1488,7 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
   tinyxml2::XMLElement* robotXml = _urdfXml.FirstChildElement("robot");
 
   // Get all SDF extension elements, put everything in
-  //   g_extensions map, containing a key string
+  //   extensions map, containing a key string
   //   (link/joint name) and values
   for (tinyxml2::XMLElement* sdfXml = robotXml->FirstChildElement("gazebo");
        sdfXml; sdfXml = sdfXml->NextSiblingElement("gazebo"))
@@ -1262,11 +1506,12 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
       refStr = std::string(ref);
     }
 
-    if (g_extensions.find(refStr) == g_extensions.end())
+    if (this->dataPtr->extensions.find(refStr) ==
+        this->dataPtr->extensions.end())
     {
       // create extension map for reference
       std::vector<SDFExtensionPtr> ge;
-      g_extensions.insert(std::make_pair(refStr, ge));
+      this->dataPtr->extensions.insert(std::make_pair(refStr, ge));
     }
 
     // create and insert a new SDFExtension into the map
@@ -1502,7 +1747,7 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
         if (lowerStr(valueStr) == "true" || lowerStr(valueStr) == "yes" ||
             valueStr == "1")
         {
-          g_fixedJointsTransformedInRevoluteJoints.insert(refStr);
+          this->dataPtr->fixedJointsTransformedInRevoluteJoints.insert(refStr);
         }
       }
       else if (strcmp(childElem->Name(), "preserveFixedJoint") == 0)
@@ -1512,7 +1757,7 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
         if (lowerStr(valueStr) == "true" || lowerStr(valueStr) == "yes" ||
             valueStr == "1")
         {
-          g_fixedJointsTransformedInFixedJoints.insert(refStr);
+          this->dataPtr->fixedJointsTransformedInFixedJoints.insert(refStr);
         }
       }
       else
@@ -1532,20 +1777,21 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
     }
 
     // insert into my map
-    (g_extensions.find(refStr))->second.push_back(sdf);
+    (this->dataPtr->extensions.find(refStr))->second.push_back(sdf);
   }
 
   // Handle fixed joints for which both disableFixedJointLumping
   // and preserveFixedJoint options are present
   for (auto& fixedJointConvertedToFixed:
-             g_fixedJointsTransformedInFixedJoints)
+             this->dataPtr->fixedJointsTransformedInFixedJoints)
   {
     // If both options are present, the model creator is aware of the
     // existence of the preserveFixedJoint option and the
     // disableFixedJointLumping option is there only for backward compatibility
     // For this reason, if both options are present then the preserveFixedJoint
     // option has the precedence
-    g_fixedJointsTransformedInRevoluteJoints.erase(fixedJointConvertedToFixed);
+    this->dataPtr->fixedJointsTransformedInRevoluteJoints.erase(
+        fixedJointConvertedToFixed);
   }
 }
 
@@ -1569,503 +1815,495 @@ void CopyBlob(tinyxml2::XMLElement *_src, tinyxml2::XMLElement *_blob_parent)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void InsertSDFExtensionCollision(tinyxml2::XMLElement *_elem,
+void InsertSDFExtensionCollision(const URDF2SDFPrivate &_state,
+                                 tinyxml2::XMLElement *_elem,
                                  const std::string &_linkName)
 {
-  // loop through extensions for the whole model
-  // and see which ones belong to _linkName
+  // look up the extensions of the whole model that belong to _linkName
   // This might be complicated since there's:
   //   - urdf collision name -> sdf collision name conversion
   //   - fixed joint reduction / lumping
-  for (StringSDFExtensionPtrMap::iterator
-      sdfIt = g_extensions.begin();
-      sdfIt != g_extensions.end(); ++sdfIt)
-  {
-    if (sdfIt->first == _linkName)
-    {
-      // std::cerr << "============================\n";
-      // std::cerr << "working on g_extensions for link ["
-      //           << sdfIt->first << "]\n";
-      // if _elem already has a surface element, use it
-      tinyxml2::XMLNode *surface = _elem->FirstChildElement("surface");
-      tinyxml2::XMLNode *friction = nullptr;
-      tinyxml2::XMLNode *frictionOde = nullptr;
-      tinyxml2::XMLNode *contact = nullptr;
-      tinyxml2::XMLNode *contactOde = nullptr;
-
-      // loop through all the gazebo extensions stored in sdfIt->second
-      for (std::vector<SDFExtensionPtr>::iterator ge = sdfIt->second.begin();
-           ge != sdfIt->second.end(); ++ge)
-      {
-        // Check if this blob belongs to _elem based on
-        //   - blob's reference link name (_linkName or sdfIt->first)
-        //   - _elem (destination for blob, which is a collision sdf).
-
-        if (!_elem->Attribute("name"))
-        {
-          sdferr << "ERROR: collision _elem has no name,"
-                 << " something is wrong" << "\n";
-        }
+  StringSDFExtensionPtrMap::iterator sdfIt = _state.extensions.find(_linkName);
+  if (sdfIt != _state.extensions.end())
+  {
+    // std::cerr << "============================\n";
+    // std::cerr << "working on extensions for link ["
+    //           << sdfIt->first << "]\n";
+    // if _elem already has a surface element, use it
+    tinyxml2::XMLNode *surface = _elem->FirstChildElement("surface");
+    tinyxml2::XMLNode *friction = nullptr;
+    tinyxml2::XMLNode *frictionOde = nullptr;
+    tinyxml2::XMLNode *contact = nullptr;
+    tinyxml2::XMLNode *contactOde = nullptr;
+
+    // loop through all the gazebo extensions stored in sdfIt->second
+    for (std::vector<SDFExtensionPtr>::iterator ge = sdfIt->second.begin();
+         ge != sdfIt->second.end(); ++ge)
+    {
+      // Check if this blob belongs to _elem based on
+      //   - blob's reference link name (_linkName or sdfIt->first)
+      //   - _elem (destination for blob, which is a collision sdf).
+
+      if (!_elem->Attribute("name"))
+      {
+        sdferr << "ERROR: collision _elem has no name,"
+               << " something is wrong" << "\n";
+      }
 
-        std::string sdfCollisionName(_elem->Attribute("name"));
+      std::string sdfCollisionName(_elem->Attribute("name"));
 
-        // std::cerr << "----------------------------\n";
-        // std::cerr << "blob belongs to [" << _linkName
-        //           << "] with old parent LinkName [" << (*ge)->oldLinkName
-        //           << "]\n";
-        // std::cerr << "_elem sdf collision name [" << sdfCollisionName
-        //           << "]\n";
-        // std::cerr << "----------------------------\n";
+      // std::cerr << "----------------------------\n";
+      // std::cerr << "blob belongs to [" << _linkName
+      //           << "] with old parent LinkName [" << (*ge)->oldLinkName
+      //           << "]\n";
+      // std::cerr << "_elem sdf collision name [" << sdfCollisionName
+      //           << "]\n";
+      // std::cerr << "----------------------------\n";
 
-        std::string lumpCollisionName = kLumpPrefix +
-          (*ge)->oldLinkName + kCollisionExt;
+      std::string lumpCollisionName = kLumpPrefix +
+        (*ge)->oldLinkName + kCollisionExt;
 
-        bool wasReduced = (_linkName == (*ge)->oldLinkName);
-        bool collisionNameContainsLinkname =
-          sdfCollisionName.find(_linkName) != std::string::npos;
-        bool collisionNameContainsLumpedLinkname =
-          sdfCollisionName.find(lumpCollisionName) != std::string::npos;
-        bool collisionNameContainsLumpedRef =
-          sdfCollisionName.find(kLumpPrefix) != std::string::npos;
+      bool wasReduced = (_linkName == (*ge)->oldLinkName);
+      bool collisionNameContainsLinkname =
+        sdfCollisionName.find(_linkName) != std::string::npos;
+      bool collisionNameContainsLumpedLinkname =
+        sdfCollisionName.find(lumpCollisionName) != std::string::npos;
+      bool collisionNameContainsLumpedRef =
+        sdfCollisionName.find(kLumpPrefix) != std::string::npos;
 
-        if (!collisionNameContainsLinkname)
-        {
-          sdferr << "collision name does not contain link name,"
-                 << " file an issue.\n";
-        }
+      if (!collisionNameContainsLinkname)
+      {
+        sdferr << "collision name does not contain link name,"
+               << " file an issue.\n";
+      }
 
-        // if the collision _elem was not reduced,
-        // its name should not have kLumpPrefix in it.
-        // otherwise, its name should have
-        // "kLumpPrefix+[original link name before reduction]".
-        if ((wasReduced && !collisionNameContainsLumpedRef) ||
-            (!wasReduced && collisionNameContainsLumpedLinkname))
+      // if the collision _elem was not reduced,
+      // its name should not have kLumpPrefix in it.
+      // otherwise, its name should have
+      // "kLumpPrefix+[original link name before reduction]".
+      if ((wasReduced && !collisionNameContainsLumpedRef) ||
+          (!wasReduced && collisionNameContainsLumpedLinkname))
+      {
+        // insert any blobs (including visual plugins)
+        // warning, if you insert a <surface> sdf here, it might
+        // duplicate what was constructed above.
+        // in the future, we should use blobs (below) in place of
+        // explicitly specified fields (above).
+        if (!(*ge)->collision_blobs.empty())
         {
-          // insert any blobs (including visual plugins)
-          // warning, if you insert a <surface> sdf here, it might
-          // duplicate what was constructed above.
-          // in the future, we should use blobs (below) in place of
-          // explicitly specified fields (above).
-          if (!(*ge)->collision_blobs.empty())
+          for (auto blob = (*ge)->collision_blobs.begin();
+              blob != (*ge)->collision_blobs.end(); ++blob)
           {
-            for (auto blob = (*ge)->collision_blobs.begin();
-                blob != (*ge)->collision_blobs.end(); ++blob)
-            {
-              // find elements and assign pointers if they exist
-              // for mu1, mu2, minDepth, maxVel, fdir1, kp, kd
-              // otherwise, they are allocated by 'new' below.
-              // std::cerr << ">>>>> working on extension blob: ["
-              //           << (*blob)->Value() << "]\n";
+            // find elements and assign pointers if they exist
+            // for mu1, mu2, minDepth, maxVel, fdir1, kp, kd
+            // otherwise, they are allocated by 'new' below.
+            // std::cerr << ">>>>> working on extension blob: ["
+            //           << (*blob)->Value() << "]\n";
 
-              if (strcmp((*blob)->FirstChildElement()->Name(), "surface") == 0)
+            if (strcmp((*blob)->FirstChildElement()->Name(), "surface") == 0)
+            {
+              // blob is a <surface>, tread carefully otherwise
+              // we end up with multiple copies of <surface>.
+              // Also, get pointers (contact[Ode], friction[Ode])
+              // below for backwards (non-blob) compatibility.
+              if (surface == nullptr)
               {
-                // blob is a <surface>, tread carefully otherwise
-                // we end up with multiple copies of <surface>.
-                // Also, get pointers (contact[Ode], friction[Ode])
-                // below for backwards (non-blob) compatibility.
-                if (surface == nullptr)
-                {
-                  // <surface> do not exist, it simple,
-                  // just add it to the current collision
-                  // and it's done.
-                  CopyBlob((*blob)->FirstChildElement(), _elem);
-                  surface = _elem->LastChildElement("surface");
-                  // std::cerr << " --- surface created "
-                  //           <<  (void*)surface << "\n";
-                }
-                else
-                {
-                  // <surface> exist already, remove it and
-                  // overwrite with the blob.
-                  _elem->DeleteChild(surface);
-                  CopyBlob((*blob)->FirstChildElement(), _elem);
-                  surface = _elem->FirstChildElement("surface");
-                  // std::cerr << " --- surface exists, replace with blob.\n";
-                }
-
-                // Extra code for backwards compatibility, to
-                // deal with old way of specifying collision attributes
-                // using individual elements listed below:
-                //   "mu"
-                //   "mu2"
-                //   "fdir1"
-                //   "kp"
-                //   "kd"
-                //   "max_vel"
-                //   "min_depth"
-                //   "laser_retro"
-                //   "max_contacts"
-                // Get contact[Ode] and friction[Ode] node pointers
-                // if they exist.
-                contact  = surface->FirstChildElement("contact");
-                if (contact != nullptr)
-                {
-                  contactOde  = contact->FirstChildElement("ode");
-                }
-                friction = surface->FirstChildElement("friction");
-                if (friction != nullptr)
-                {
-                  frictionOde  = friction->FirstChildElement("ode");
-                }
+                // <surface> do not exist, it simple,
+                // just add it to the current collision
+                // and it's done.
+                CopyBlob((*blob)->FirstChildElement(), _elem);
+                surface = _elem->LastChildElement("surface");
+                // std::cerr << " --- surface created "
+                //           <<  (void*)surface << "\n";
               }
               else
               {
-                // If the blob is not a <surface>, we don't have
-                // to worry about backwards compatibility.
-                // Simply add to master element.
+                // <surface> exist already, remove it and
+                // overwrite with the blob.
+                _elem->DeleteChild(surface);
                 CopyBlob((*blob)->FirstChildElement(), _elem);
+                surface = _elem->FirstChildElement("surface");
+                // std::cerr << " --- surface exists, replace with blob.\n";
               }
-            }
-          }
-
-          // Extra code for backwards compatibility, to
-          // deal with old way of specifying collision attributes
-          // using individual elements listed below:
-          //   "mu"
-          //   "mu2"
-          //   "fdir1"
-          //   "kp"
-          //   "kd"
-          //   "max_vel"
-          //   "min_depth"
-          //   "laser_retro"
-          //   "max_contacts"
-          // The new way to do this is to specify everything
-          // in collision blobs by using the <collision> tag.
-          // So there's no need for custom code for each property.
 
-          // construct new elements if not in blobs
-          auto* doc = _elem->GetDocument();
-          if (surface == nullptr)
-          {
-            surface  = doc->NewElement("surface");
-            if (!surface)
-            {
-              // Memory allocation error
-              sdferr << "Memory allocation error while"
-                     << " processing <surface>.\n";
-            }
-            _elem->LinkEndChild(surface);
-          }
-
-          // construct new elements if not in blobs
-          if (contact == nullptr)
-          {
-            if (surface->FirstChildElement("contact") == nullptr)
-            {
-              contact  = doc->NewElement("contact");
-              if (!contact)
+              // Extra code for backwards compatibility, to
+              // deal with old way of specifying collision attributes
+              // using individual elements listed below:
+              //   "mu"
+              //   "mu2"
+              //   "fdir1"
+              //   "kp"
+              //   "kd"
+              //   "max_vel"
+              //   "min_depth"
+              //   "laser_retro"
+              //   "max_contacts"
+              // Get contact[Ode] and friction[Ode] node pointers
+              // if they exist.
+              contact  = surface->FirstChildElement("contact");
+              if (contact != nullptr)
               {
-                // Memory allocation error
-                sdferr << "Memory allocation error while"
-                       << " processing <contact>.\n";
+                contactOde  = contact->FirstChildElement("ode");
               }
-              surface->LinkEndChild(contact);
-            }
-            else
-            {
-              contact  = surface->FirstChildElement("contact");
-            }
-          }
-
-          if (contactOde == nullptr)
-          {
-            if (contact->FirstChildElement("ode") == nullptr)
-            {
-              contactOde  = doc->NewElement("ode");
-              if (!contactOde)
+              friction = surface->FirstChildElement("friction");
+              if (friction != nullptr)
               {
-                // Memory allocation error
-                sdferr << "Memory allocation error while"
-                       << " processing <contact><ode>.\n";
+                frictionOde  = friction->FirstChildElement("ode");
               }
-              contact->LinkEndChild(contactOde);
             }
             else
             {
-              contactOde  = contact->FirstChildElement("ode");
+              // If the blob is not a <surface>, we don't have
+              // to worry about backwards compatibility.
+              // Simply add to master element.
+              CopyBlob((*blob)->FirstChildElement(), _elem);
             }
           }
+        }
 
-          if (friction == nullptr)
+        // Extra code for backwards compatibility, to
+        // deal with old way of specifying collision attributes
+        // using individual elements listed below:
+        //   "mu"
+        //   "mu2"
+        //   "fdir1"
+        //   "kp"
+        //   "kd"
+        //   "max_vel"
+        //   "min_depth"
+        //   "laser_retro"
+        //   "max_contacts"
+        // The new way to do this is to specify everything
+        // in collision blobs by using the <collision> tag.
+        // So there's no need for custom code for each property.
+
+        // construct new elements if not in blobs
+        auto* doc = _elem->GetDocument();
+        if (surface == nullptr)
+        {
+          surface  = doc->NewElement("surface");
+          if (!surface)
           {
-            if (surface->FirstChildElement("friction") == nullptr)
-            {
-              friction  = doc->NewElement("friction");
-              if (!friction)
-              {
-                // Memory allocation error
-                sdferr << "Memory allocation error while"
-                       << " processing <friction>.\n";
-              }
-              surface->LinkEndChild(friction);
-            }
-            else
-            {
-              friction  = surface->FirstChildElement("friction");
-            }
+            // Memory allocation error
+            sdferr << "Memory allocation error while"
+                   << " processing <surface>.\n";
           }
+          _elem->LinkEndChild(surface);
+        }
 
-          if (frictionOde == nullptr)
+        // construct new elements if not in blobs
+        if (contact == nullptr)
+        {
+          if (surface->FirstChildElement("contact") == nullptr)
           {
-            if (friction->FirstChildElement("ode") == nullptr)
-            {
-              frictionOde  = doc->NewElement("ode");
-              if (!frictionOde)
-              {
-                // Memory allocation error
-                sdferr << "Memory allocation error while"
-                       << " processing <friction><ode>.\n";
-              }
-              friction->LinkEndChild(frictionOde);
-            }
-            else
+            contact  = doc->NewElement("contact");
+            if (!contact)
             {
-              frictionOde = friction->FirstChildElement("ode");
+              // Memory allocation error
+              sdferr << "Memory allocation error while"
+                     << " processing <contact>.\n";
             }
+            surface->LinkEndChild(contact);
           }
-
-          // insert mu1, mu2, kp, kd for collision
-          if ((*ge)->isMu1)
-          {
-            AddKeyValue(frictionOde->ToElement(), "mu",
-                        Values2str(1, &(*ge)->mu1));
-          }
-          if ((*ge)->isMu2)
-          {
-            AddKeyValue(frictionOde->ToElement(), "mu2",
-                        Values2str(1, &(*ge)->mu2));
-          }
-          if (!(*ge)->fdir1.empty())
+          else
           {
-            AddKeyValue(frictionOde->ToElement(), "fdir1", (*ge)->fdir1);
+            contact  = surface->FirstChildElement("contact");
           }
-          if ((*ge)->isKp)
+        }
+
+        if (contactOde == nullptr)
+        {
+          if (contact->FirstChildElement("ode") == nullptr)
           {
-            AddKeyValue(contactOde->ToElement(), "kp",
-                        Values2str(1, &(*ge)->kp));
+            contactOde  = doc->NewElement("ode");
+            if (!contactOde)
+            {
+              // Memory allocation error
+              sdferr << "Memory allocation error while"
+                     << " processing <contact><ode>.\n";
+            }
+            contact->LinkEndChild(contactOde);
           }
-          if ((*ge)->isKd)
+          else
           {
-            AddKeyValue(contactOde->ToElement(), "kd",
-                        Values2str(1, &(*ge)->kd));
+            contactOde  = contact->FirstChildElement("ode");
           }
-          // max contact interpenetration correction velocity
-          if ((*ge)->isMaxVel)
+        }
+
+        if (friction == nullptr)
+        {
+          if (surface->FirstChildElement("friction") == nullptr)
           {
-            AddKeyValue(contactOde->ToElement(), "max_vel",
-                        Values2str(1, &(*ge)->maxVel));
+            friction  = doc->NewElement("friction");
+            if (!friction)
+            {
+              // Memory allocation error
+              sdferr << "Memory allocation error while"
+                     << " processing <friction>.\n";
+            }
+            surface->LinkEndChild(friction);
           }
-          // contact interpenetration margin tolerance
-          if ((*ge)->isMinDepth)
+          else
           {
-            AddKeyValue(contactOde->ToElement(), "min_depth",
-                        Values2str(1, &(*ge)->minDepth));
+            friction  = surface->FirstChildElement("friction");
           }
-          if ((*ge)->isLaserRetro)
+        }
+
+        if (frictionOde == nullptr)
+        {
+          if (friction->FirstChildElement("ode") == nullptr)
           {
-            AddKeyValue(_elem, "laser_retro",
-                        Values2str(1, &(*ge)->laserRetro));
+            frictionOde  = doc->NewElement("ode");
+            if (!frictionOde)
+            {
+              // Memory allocation error
+              sdferr << "Memory allocation error while"
+                     << " processing <friction><ode>.\n";
+            }
+            friction->LinkEndChild(frictionOde);
           }
-          if ((*ge)->isMaxContacts)
+          else
           {
-            AddKeyValue(_elem, "max_contacts",
-                        Values2str(1, &(*ge)->maxContacts));
+            frictionOde = friction->FirstChildElement("ode");
           }
         }
+
+        // insert mu1, mu2, kp, kd for collision
+        if ((*ge)->isMu1)
+        {
+          AddKeyValue(frictionOde->ToElement(), "mu",
+                      Values2str(1, &(*ge)->mu1));
+        }
+        if ((*ge)->isMu2)
+        {
+          AddKeyValue(frictionOde->ToElement(), "mu2",
+                      Values2str(1, &(*ge)->mu2));
+        }
+        if (!(*ge)->fdir1.empty())
+        {
+          AddKeyValue(frictionOde->ToElement(), "fdir1", (*ge)->fdir1);
+        }
+        if ((*ge)->isKp)
+        {
+          AddKeyValue(contactOde->ToElement(), "kp",
+                      Values2str(1, &(*ge)->kp));
+        }
+        if ((*ge)->isKd)
+        {
+          AddKeyValue(contactOde->ToElement(), "kd",
+                      Values2str(1, &(*ge)->kd));
+        }
+        // max contact interpenetration correction velocity
+        if ((*ge)->isMaxVel)
+        {
+          AddKeyValue(contactOde->ToElement(), "max_vel",
+                      Values2str(1, &(*ge)->maxVel));
+        }
+        // contact interpenetration margin tolerance
+        if ((*ge)->isMinDepth)
+        {
+          AddKeyValue(contactOde->ToElement(), "min_depth",
+                      Values2str(1, &(*ge)->minDepth));
+        }
+        if ((*ge)->isLaserRetro)
+        {
+          AddKeyValue(_elem, "laser_retro",
+                      Values2str(1, &(*ge)->laserRetro));
+        }
+        if ((*ge)->isMaxContacts)
+        {
+          AddKeyValue(_elem, "max_contacts",
+                      Values2str(1, &(*ge)->maxContacts));
+        }
       }
     }
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void InsertSDFExtensionVisual(tinyxml2::XMLElement *_elem,
+void InsertSDFExtensionVisual(const URDF2SDFPrivate &_state,
+                              tinyxml2::XMLElement *_elem,
                               const std::string &_linkName)
 {
-  // loop through extensions for the whole model
-  // and see which ones belong to _linkName
+  // look up the extensions of the whole model that belong to _linkName
   // This might be complicated since there's:
   //   - urdf visual name -> sdf visual name conversion
   //   - fixed joint reduction / lumping
-  for (StringSDFExtensionPtrMap::iterator
-      sdfIt = g_extensions.begin();
-      sdfIt != g_extensions.end(); ++sdfIt)
+  StringSDFExtensionPtrMap::iterator sdfIt = _state.extensions.find(_linkName);
+  if (sdfIt != _state.extensions.end())
   {
-    if (sdfIt->first == _linkName)
+    // std::cerr << "============================\n";
+    // std::cerr << "working on extensions for link ["
+    //           << sdfIt->first << "]\n";
+    // if _elem already has a material element, use it
+    tinyxml2::XMLElement *material = _elem->FirstChildElement("material");
+    tinyxml2::XMLElement *script = nullptr;
+
+    // loop through all the gazebo extensions stored in sdfIt->second
+    for (std::vector<SDFExtensionPtr>::iterator ge = sdfIt->second.begin();
+         ge != sdfIt->second.end(); ++ge)
     {
-      // std::cerr << "============================\n";
-      // std::cerr << "working on g_extensions for link ["
-      //           << sdfIt->first << "]\n";
-      // if _elem already has a material element, use it
-      tinyxml2::XMLElement *material = _elem->FirstChildElement("material");
-      tinyxml2::XMLElement *script = nullptr;
+      // Check if this blob belongs to _elem based on
+      //   - blob's reference link name (_linkName or sdfIt->first)
+      //   - _elem (destination for blob, which is a visual sdf).
 
-      // loop through all the gazebo extensions stored in sdfIt->second
-      for (std::vector<SDFExtensionPtr>::iterator ge = sdfIt->second.begin();
-           ge != sdfIt->second.end(); ++ge)
+      if (!_elem->Attribute("name"))
       {
-        // Check if this blob belongs to _elem based on
-        //   - blob's reference link name (_linkName or sdfIt->first)
-        //   - _elem (destination for blob, which is a visual sdf).
-
-        if (!_elem->Attribute("name"))
-        {
-          sdferr << "ERROR: visual _elem has no name,"
-                 << " something is wrong" << "\n";
-        }
+        sdferr << "ERROR: visual _elem has no name,"
+               << " something is wrong" << "\n";
+      }
 
-        std::string sdfVisualName(_elem->Attribute("name"));
+      std::string sdfVisualName(_elem->Attribute("name"));
 
-        // std::cerr << "----------------------------\n";
-        // std::cerr << "blob belongs to [" << _linkName
-        //           << "] with old parent LinkName [" << (*ge)->oldLinkName
-        //           << "]\n";
-        // std::cerr << "_elem sdf visual name [" << sdfVisualName
-        //           << "]\n";
-        // std::cerr << "----------------------------\n";
+      // std::cerr << "----------------------------\n";
+      // std::cerr << "blob belongs to [" << _linkName
+      //           << "] with old parent LinkName [" << (*ge)->oldLinkName
+      //           << "]\n";
+      // std::cerr << "_elem sdf visual name [" << sdfVisualName
+      //           << "]\n";
+      // std::cerr << "----------------------------\n";
 
-        std::string lumpVisualName = kLumpPrefix +
-          (*ge)->oldLinkName + kVisualExt;
+      std::string lumpVisualName = kLumpPrefix +
+        (*ge)->oldLinkName + kVisualExt;
 
-        bool wasReduced = (_linkName == (*ge)->oldLinkName);
-        bool visualNameContainsLinkname =
-          sdfVisualName.find(_linkName) != std::string::npos;
-        bool visualNameContainsLumpedLinkname =
-          sdfVisualName.find(lumpVisualName) != std::string::npos;
-        bool visualNameContainsLumpedRef =
-          sdfVisualName.find(kLumpPrefix) != std::string::npos;
+      bool wasReduced = (_linkName == (*ge)->oldLinkName);
+      bool visualNameContainsLinkname =
+        sdfVisualName.find(_linkName) != std::string::npos;
+      bool visualNameContainsLumpedLinkname =
+        sdfVisualName.find(lumpVisualName) != std::string::npos;
+      bool visualNameContainsLumpedRef =
+        sdfVisualName.find(kLumpPrefix) != std::string::npos;
 
-        if (!visualNameContainsLinkname)
-        {
-          sdferr << "visual name does not contain link name,"
-                 << " file an issue.\n";
-        }
+      if (!visualNameContainsLinkname)
+      {
+        sdferr << "visual name does not contain link name,"
+               << " file an issue.\n";
+      }
 
-        // if the visual _elem was not reduced,
-        // its name should not have kLumpPrefix in it.
-        // otherwise, its name should have
-        // "kLumpPrefix+[original link name before reduction]".
-        if ((wasReduced && !visualNameContainsLumpedRef) ||
-            (!wasReduced && visualNameContainsLumpedLinkname))
+      // if the visual _elem was not reduced,
+      // its name should not have kLumpPrefix in it.
+      // otherwise, its name should have
+      // "kLumpPrefix+[original link name before reduction]".
+      if ((wasReduced && !visualNameContainsLumpedRef) ||
+          (!wasReduced && visualNameContainsLumpedLinkname))
+      {
+        // insert any blobs (including visual plugins)
+        // warning, if you insert a <material> sdf here, it might
+        // duplicate what was constructed above.
+        // in the future, we should use blobs (below) in place of
+        // explicitly specified fields (above).
+        if (!(*ge)->visual_blobs.empty())
         {
-          // insert any blobs (including visual plugins)
-          // warning, if you insert a <material> sdf here, it might
-          // duplicate what was constructed above.
-          // in the future, we should use blobs (below) in place of
-          // explicitly specified fields (above).
-          if (!(*ge)->visual_blobs.empty())
+          for (auto blob = (*ge)->visual_blobs.begin();
+              blob != (*ge)->visual_blobs.end(); ++blob)
           {
-            for (auto blob = (*ge)->visual_blobs.begin();
-                blob != (*ge)->visual_blobs.end(); ++blob)
+            // find elements and assign pointers if they exist
+            // for mu1, mu2, minDepth, maxVel, fdir1, kp, kd
+            // otherwise, they are allocated by 'new' below.
+            // std::cerr << ">>>>> working on extension blob: ["
+            //           << (*blob)->Value() << "]\n";
+
+            // print for debug
+            // std::ostringstream origStream;
+            // origStream << *(*blob)->Clone();
+            // std::cerr << "visual extension ["
+            //           << origStream.str() << "]\n";
+
+            if (strcmp((*blob)->FirstChildElement()->Name(), "material") == 0)
             {
-              // find elements and assign pointers if they exist
-              // for mu1, mu2, minDepth, maxVel, fdir1, kp, kd
-              // otherwise, they are allocated by 'new' below.
-              // std::cerr << ">>>>> working on extension blob: ["
-              //           << (*blob)->Value() << "]\n";
-
-              // print for debug
-              // std::ostringstream origStream;
-              // origStream << *(*blob)->Clone();
-              // std::cerr << "visual extension ["
-              //           << origStream.str() << "]\n";
-
-              if (strcmp((*blob)->FirstChildElement()->Name(), "material") == 0)
+              // blob is a <material>, tread carefully otherwise
+              // we end up with multiple copies of <material>.
+              // Also, get pointers (script)
+              // below for backwards (non-blob) compatibility.
+              if (material == nullptr)
               {
-                // blob is a <material>, tread carefully otherwise
-                // we end up with multiple copies of <material>.
-                // Also, get pointers (script)
-                // below for backwards (non-blob) compatibility.
-                if (material == nullptr)
-                {
-                  // <material> do not exist, it simple,
-                  // just add it to the current visual
-                  // and it's done.
-                  CopyBlob((*blob)->FirstChildElement(), _elem);
-                  material = _elem->LastChildElement("material");
-                  // std::cerr << " --- material created "
-                  //           <<  (void*)material << "\n";
-                }
-                else
-                {
-                  // <material> exist already, remove it and
-                  // overwrite with the blob.
-                  _elem->DeleteChild(material);
-                  CopyBlob((*blob)->FirstChildElement(), _elem);
-                  material = _elem->FirstChildElement("material");
-                  // std::cerr << " --- material exists, replace with blob.\n";
-                }
-
-                // Extra code for backwards compatibility, to
-                // deal with old way of specifying visual attributes
-                // using individual element:
-                //   "script"
-                // Get script node pointers
-                // if they exist.
-                script = material->FirstChildElement("script");
+                // <material> do not exist, it simple,
+                // just add it to the current visual
+                // and it's done.
+                CopyBlob((*blob)->FirstChildElement(), _elem);
+                material = _elem->LastChildElement("material");
+                // std::cerr << " --- material created "
+                //           <<  (void*)material << "\n";
               }
               else
               {
-                // std::cerr << "***** working on extension blob: ["
-                //           << (*blob)->Value() << "]\n";
-                // If the blob is not a <material>, we don't have
-                // to worry about backwards compatibility.
-                // Simply add to master element.
+                // <material> exist already, remove it and
+                // overwrite with the blob.
+                _elem->DeleteChild(material);
                 CopyBlob((*blob)->FirstChildElement(), _elem);
+                material = _elem->FirstChildElement("material");
+                // std::cerr << " --- material exists, replace with blob.\n";
               }
+
+              // Extra code for backwards compatibility, to
+              // deal with old way of specifying visual attributes
+              // using individual element:
+              //   "script"
+              // Get script node pointers
+              // if they exist.
+              script = material->FirstChildElement("script");
+            }
+            else
+            {
+              // std::cerr << "***** working on extension blob: ["
+              //           << (*blob)->Value() << "]\n";
+              // If the blob is not a <material>, we don't have
+              // to worry about backwards compatibility.
+              // Simply add to master element.
+              CopyBlob((*blob)->FirstChildElement(), _elem);
             }
           }
+        }
 
-          // Extra code for backwards compatibility, to
-          // deal with old way of specifying visual attributes
-          // using individual element:
-          //   "script"
-          // The new way to do this is to specify everything
-          // in visual blobs by using the <visual> tag.
-          // So there's no need for custom code for each property.
-
-          // backward compatibility for old code
-          // insert material/script block for visual
-          // (*ge)->material block goes under sdf <material><script><name>.
-          if (!(*ge)->material.empty())
+        // Extra code for backwards compatibility, to
+        // deal with old way of specifying visual attributes
+        // using individual element:
+        //   "script"
+        // The new way to do this is to specify everything
+        // in visual blobs by using the <visual> tag.
+        // So there's no need for custom code for each property.
+
+        // backward compatibility for old code
+        // insert material/script block for visual
+        // (*ge)->material block goes under sdf <material><script><name>.
+        if (!(*ge)->material.empty())
+        {
+          // construct new elements if not in blobs
+          if (material == nullptr)
           {
-            // construct new elements if not in blobs
-            if (material == nullptr)
+            material  = _elem->GetDocument()->NewElement("material");
+            if (!material)
             {
-              material  = _elem->GetDocument()->NewElement("material");
-              if (!material)
+              // Memory allocation error
+              sdferr << "Memory allocation error while"
+                     << " processing <material>.\n";
+            }
+            _elem->LinkEndChild(material);
+          }
+
+          if (script == nullptr)
+          {
+            if (material->FirstChildElement("script") == nullptr)
+            {
+              script  = _elem->GetDocument()->NewElement("script");
+              if (!script)
               {
                 // Memory allocation error
                 sdferr << "Memory allocation error while"
-                       << " processing <material>.\n";
+                       << " processing <script>.\n";
               }
-              _elem->LinkEndChild(material);
+              material->LinkEndChild(script);
             }
-
-            if (script == nullptr)
+            else
             {
-              if (material->FirstChildElement("script") == nullptr)
-              {
-                script  = _elem->GetDocument()->NewElement("script");
-                if (!script)
-                {
-                  // Memory allocation error
-                  sdferr << "Memory allocation error while"
-                         << " processing <script>.\n";
-                }
-                material->LinkEndChild(script);
-              }
-              else
-              {
-                script = material->FirstChildElement("script");
-              }
+              script = material->FirstChildElement("script");
             }
-
-            AddKeyValue(script, "name", (*ge)->material);
-            // hard code original default gazebo materials files
-            AddKeyValue(script, "uri",
-              "file://media/materials/scripts/gazebo.material");
           }
+
+          AddKeyValue(script, "name", (*ge)->material);
+          // hard code original default gazebo materials files
+          AddKeyValue(script, "uri",
+            "file://media/materials/scripts/gazebo.material");
         }
       }
     }
@@ -2073,232 +2311,224 @@ void InsertSDFExtensionVisual(tinyxml2::XMLElement *_elem,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void InsertSDFExtensionLink(tinyxml2::XMLElement *_elem,
+void InsertSDFExtensionLink(const URDF2SDFPrivate &_state,
+                            tinyxml2::XMLElement *_elem,
                             const std::string &_linkName)
 {
-  for (StringSDFExtensionPtrMap::iterator
-       sdfIt = g_extensions.begin();
-       sdfIt != g_extensions.end(); ++sdfIt)
+  StringSDFExtensionPtrMap::iterator sdfIt = _state.extensions.find(_linkName);
+  if (sdfIt != _state.extensions.end())
   {
-    if (sdfIt->first == _linkName)
+    sdfdbg << "inserting extension with reference ["
+           << _linkName << "] into link.\n";
+    for (std::vector<SDFExtensionPtr>::iterator ge =
+        sdfIt->second.begin(); ge != sdfIt->second.end(); ++ge)
     {
-      sdfdbg << "inserting extension with reference ["
-             << _linkName << "] into link.\n";
-      for (std::vector<SDFExtensionPtr>::iterator ge =
-          sdfIt->second.begin(); ge != sdfIt->second.end(); ++ge)
+      // insert gravity
+      if ((*ge)->isGravity)
       {
-        // insert gravity
-        if ((*ge)->isGravity)
-        {
-          AddKeyValue(_elem, "gravity", (*ge)->gravity ? "true" : "false");
-        }
+        AddKeyValue(_elem, "gravity", (*ge)->gravity ? "true" : "false");
+      }
 
-        // damping factor
-        if ((*ge)->isDampingFactor)
-        {
-          tinyxml2::XMLElement *velocityDecay =
-            _elem->GetDocument()->NewElement("velocity_decay");
-          /// @todo separate linear and angular velocity decay
-          AddKeyValue(velocityDecay, "linear",
-                      Values2str(1, &(*ge)->dampingFactor));
-          AddKeyValue(velocityDecay, "angular",
-                      Values2str(1, &(*ge)->dampingFactor));
-          _elem->LinkEndChild(velocityDecay);
-        }
-        // selfCollide tag
-        if ((*ge)->isSelfCollide)
-        {
-          AddKeyValue(_elem, "self_collide", (*ge)->selfCollide ? "1" : "0");
-        }
-        // insert blobs into body
-        for (auto blobIt = (*ge)->blobs.begin();
-            blobIt != (*ge)->blobs.end(); ++blobIt)
-        {
-          // Be sure to always copy only the first element; code in
-          // ReduceSDFExtensionSensorTransformReduction depends in this behavior
-          CopyBlob((*blobIt)->FirstChildElement(), _elem);
-        }
+      // damping factor
+      if ((*ge)->isDampingFactor)
+      {
+        tinyxml2::XMLElement *velocityDecay =
+          _elem->GetDocument()->NewElement("velocity_decay");
+        /// @todo separate linear and angular velocity decay
+        AddKeyValue(velocityDecay, "linear",
+                    Values2str(1, &(*ge)->dampingFactor));
+        AddKeyValue(velocityDecay, "angular",
+                    Values2str(1, &(*ge)->dampingFactor));
+        _elem->LinkEndChild(velocityDecay);
+      }
+      // selfCollide tag
+      if ((*ge)->isSelfCollide)
+      {
+        AddKeyValue(_elem, "self_collide", (*ge)->selfCollide ? "1" : "0");
+      }
+      // insert blobs into body
+      for (auto blobIt = (*ge)->blobs.begin();
+          blobIt != (*ge)->blobs.end(); ++blobIt)
+      {
+        // Be sure to always copy only the first element; code in
+        // ReduceSDFExtensionSensorTransformReduction depends in this behavior
+        CopyBlob((*blobIt)->FirstChildElement(), _elem);
       }
     }
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void InsertSDFExtensionJoint(tinyxml2::XMLElement *_elem,
+void InsertSDFExtensionJoint(const URDF2SDFPrivate &_state,
+                             tinyxml2::XMLElement *_elem,
                              const std::string &_jointName)
 {
   auto* doc = _elem->GetDocument();
-  for (StringSDFExtensionPtrMap::iterator
-      sdfIt = g_extensions.begin();
-      sdfIt != g_extensions.end(); ++sdfIt)
+  StringSDFExtensionPtrMap::iterator sdfIt =
+      _state.extensions.find(_jointName);
+  if (sdfIt != _state.extensions.end())
   {
-    if (sdfIt->first == _jointName)
+    for (std::vector<SDFExtensionPtr>::iterator
+        ge = sdfIt->second.begin();
+        ge != sdfIt->second.end(); ++ge)
     {
-      for (std::vector<SDFExtensionPtr>::iterator
-          ge = sdfIt->second.begin();
-          ge != sdfIt->second.end(); ++ge)
+      tinyxml2::XMLElement *physics = _elem->FirstChildElement("physics");
+      bool newPhysics = false;
+      if (physics == nullptr)
       {
-        tinyxml2::XMLElement *physics = _elem->FirstChildElement("physics");
-        bool newPhysics = false;
-        if (physics == nullptr)
-        {
-          physics = doc->NewElement("physics");
-          newPhysics = true;
-        }
+        physics = doc->NewElement("physics");
+        newPhysics = true;
+      }
 
-        tinyxml2::XMLElement *physicsOde = physics->FirstChildElement("ode");
-        bool newPhysicsOde = false;
-        if (physicsOde == nullptr)
-        {
-          physicsOde = doc->NewElement("ode");
-          newPhysicsOde = true;
-        }
+      tinyxml2::XMLElement *physicsOde = physics->FirstChildElement("ode");
+      bool newPhysicsOde = false;
+      if (physicsOde == nullptr)
+      {
+        physicsOde = doc->NewElement("ode");
+        newPhysicsOde = true;
+      }
 
-        tinyxml2::XMLElement *limit = physicsOde->FirstChildElement("limit");
-        bool newLimit = false;
-        if (limit == nullptr)
-        {
-          limit = doc->NewElement("limit");
-          newLimit = true;
-        }
+      tinyxml2::XMLElement *limit = physicsOde->FirstChildElement("limit");
+      bool newLimit = false;
+      if (limit == nullptr)
+      {
+        limit = doc->NewElement("limit");
+        newLimit = true;
+      }
 
-        tinyxml2::XMLElement *axis = _elem->FirstChildElement("axis");
-        bool newAxis = false;
-        if (axis == nullptr)
-        {
-          axis = doc->NewElement("axis");
-          newAxis = true;
-        }
+      tinyxml2::XMLElement *axis = _elem->FirstChildElement("axis");
+      bool newAxis = false;
+      if (axis == nullptr)
+      {
+        axis = doc->NewElement("axis");
+        newAxis = true;
+      }
 
-        tinyxml2::XMLElement *dynamics = axis->FirstChildElement("dynamics");
-        bool newDynamics = false;
-        if (dynamics == nullptr)
-        {
-          dynamics = doc->NewElement("dynamics");
-          newDynamics = true;
-        }
+      tinyxml2::XMLElement *dynamics = axis->FirstChildElement("dynamics");
+      bool newDynamics = false;
+      if (dynamics == nullptr)
+      {
+        dynamics = doc->NewElement("dynamics");
+        newDynamics = true;
+      }
 
-        // insert stopCfm, stopErp, fudgeFactor
-        if ((*ge)->isStopCfm)
-        {
-          AddKeyValue(limit, "cfm", Values2str(1, &(*ge)->stopCfm));
-        }
-        if ((*ge)->isStopErp)
-        {
-          AddKeyValue(limit, "erp", Values2str(1, &(*ge)->stopErp));
-        }
-        if ((*ge)->isSpringReference)
+      // insert stopCfm, stopErp, fudgeFactor
+      if ((*ge)->isStopCfm)
+      {
+        AddKeyValue(limit, "cfm", Values2str(1, &(*ge)->stopCfm));
+      }
+      if ((*ge)->isStopErp)
+      {
+        AddKeyValue(limit, "erp", Values2str(1, &(*ge)->stopErp));
+      }
+      if ((*ge)->isSpringReference)
+      {
+        AddKeyValue(dynamics, "spring_reference",
+                    Values2str(1, &(*ge)->springReference));
+      }
+      if ((*ge)->isSpringStiffness)
+      {
+        AddKeyValue(dynamics, "spring_stiffness",
+                    Values2str(1, &(*ge)->springStiffness));
+      }
+
+      // insert provideFeedback
+      if ((*ge)->isProvideFeedback)
+      {
+        if ((*ge)->provideFeedback)
         {
-          AddKeyValue(dynamics, "spring_reference",
-                      Values2str(1, &(*ge)->springReference));
+          AddKeyValue(physics, "provide_feedback", "true");
+          AddKeyValue(physicsOde, "provide_feedback", "true");
         }
-        if ((*ge)->isSpringStiffness)
+        else
         {
-          AddKeyValue(dynamics, "spring_stiffness",
-                      Values2str(1, &(*ge)->springStiffness));
+          AddKeyValue(physics, "provide_feedback", "false");
+          AddKeyValue(physicsOde, "provide_feedback", "false");
         }
+      }
 
-        // insert provideFeedback
-        if ((*ge)->isProvideFeedback)
+      // insert implicitSpringDamper
+      if ((*ge)->isImplicitSpringDamper)
+      {
+        if ((*ge)->implicitSpringDamper)
         {
-          if ((*ge)->provideFeedback)
-          {
-            AddKeyValue(physics, "provide_feedback", "true");
-            AddKeyValue(physicsOde, "provide_feedback", "true");
-          }
-          else
-          {
-            AddKeyValue(physics, "provide_feedback", "false");
-            AddKeyValue(physicsOde, "provide_feedback", "false");
-          }
+          AddKeyValue(physicsOde, "implicit_spring_damper", "true");
+          /// \TODO: deprecating cfm_damping, transitional tag below
+          AddKeyValue(physicsOde, "cfm_damping", "true");
         }
-
-        // insert implicitSpringDamper
-        if ((*ge)->isImplicitSpringDamper)
+        else
         {
-          if ((*ge)->implicitSpringDamper)
-          {
-            AddKeyValue(physicsOde, "implicit_spring_damper", "true");
-            /// \TODO: deprecating cfm_damping, transitional tag below
-            AddKeyValue(physicsOde, "cfm_damping", "true");
-          }
-          else
-          {
-            AddKeyValue(physicsOde, "implicit_spring_damper", "false");
-            /// \TODO: deprecating cfm_damping, transitional tag below
-            AddKeyValue(physicsOde, "cfm_damping", "false");
-          }
+          AddKeyValue(physicsOde, "implicit_spring_damper", "false");
+          /// \TODO: deprecating cfm_damping, transitional tag below
+          AddKeyValue(physicsOde, "cfm_damping", "false");
         }
+      }
 
-        // insert fudgeFactor
-        if ((*ge)->isFudgeFactor)
-        {
-          AddKeyValue(physicsOde, "fudge_factor",
-                      Values2str(1, &(*ge)->fudgeFactor));
-        }
+      // insert fudgeFactor
+      if ((*ge)->isFudgeFactor)
+      {
+        AddKeyValue(physicsOde, "fudge_factor",
+                    Values2str(1, &(*ge)->fudgeFactor));
+      }
 
-        if (newDynamics)
-        {
-          axis->LinkEndChild(dynamics);
-        }
-        if (newAxis)
-        {
-          _elem->LinkEndChild(axis);
-        }
+      if (newDynamics)
+      {
+        axis->LinkEndChild(dynamics);
+      }
+      if (newAxis)
+      {
+        _elem->LinkEndChild(axis);
+      }
 
-        if (newLimit)
-        {
-          physicsOde->LinkEndChild(limit);
-        }
-        if (newPhysicsOde)
-        {
-          physics->LinkEndChild(physicsOde);
-        }
-        if (newPhysics)
-        {
-          _elem->LinkEndChild(physics);
-        }
+      if (newLimit)
+      {
+        physicsOde->LinkEndChild(limit);
+      }
+      if (newPhysicsOde)
+      {
+        physics->LinkEndChild(physicsOde);
+      }
+      if (newPhysics)
+      {
+        _elem->LinkEndChild(physics);
+      }
 
-        // insert all additional blobs into joint
-        for (auto blobIt = (*ge)->blobs.begin();
-            blobIt != (*ge)->blobs.end(); ++blobIt)
-        {
-          CopyBlob((*blobIt)->FirstChildElement(), _elem);
-        }
+      // insert all additional blobs into joint
+      for (auto blobIt = (*ge)->blobs.begin();
+          blobIt != (*ge)->blobs.end(); ++blobIt)
+      {
+        CopyBlob((*blobIt)->FirstChildElement(), _elem);
       }
     }
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void InsertSDFExtensionRobot(tinyxml2::XMLElement *_elem)
+void InsertSDFExtensionRobot(const URDF2SDFPrivate &_state,
+                             tinyxml2::XMLElement *_elem)
 {
-  for (StringSDFExtensionPtrMap::iterator
-      sdfIt = g_extensions.begin();
-      sdfIt != g_extensions.end(); ++sdfIt)
+  StringSDFExtensionPtrMap::iterator sdfIt = _state.extensions.find("");
+  if (sdfIt != _state.extensions.end())
   {
-    if (sdfIt->first.empty())
+    // no reference specified
+    for (std::vector<SDFExtensionPtr>::iterator
+        ge = sdfIt->second.begin(); ge != sdfIt->second.end(); ++ge)
     {
-      // no reference specified
-      for (std::vector<SDFExtensionPtr>::iterator
-          ge = sdfIt->second.begin(); ge != sdfIt->second.end(); ++ge)
+      // insert static flag
+      if ((*ge)->setStaticFlag)
       {
-        // insert static flag
-        if ((*ge)->setStaticFlag)
-        {
-          AddKeyValue(_elem, "static", "true");
-        }
-        else
-        {
-          AddKeyValue(_elem, "static", "false");
-        }
+        AddKeyValue(_elem, "static", "true");
+      }
+      else
+      {
+        AddKeyValue(_elem, "static", "false");
+      }
 
-        // copy extension containing blobs and without reference
-        for (auto blobIt = (*ge)->blobs.begin();
-            blobIt != (*ge)->blobs.end(); ++blobIt)
-        {
-          CopyBlob((*blobIt)->FirstChildElement(), _elem);
-        }
+      // copy extension containing blobs and without reference
+      for (auto blobIt = (*ge)->blobs.begin();
+          blobIt != (*ge)->blobs.end(); ++blobIt)
+      {
+        CopyBlob((*blobIt)->FirstChildElement(), _elem);
       }
     }
   }
@@ -2452,7 +2682,9 @@ ignition::math::Pose3d TransformToParentFrame(
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ReduceSDFExtensionToParent(urdf::LinkSharedPtr _link)
+void ReduceSDFExtensionToParent(URDF2SDFPrivate &_state,
+                                urdf::LinkSharedPtr _link,
+                                const FixedJointReduction &_reduction)
 {
   /// \todo: move to header
   /// Take the link's existing list of gazebo extensions, transfer them
@@ -2468,8 +2700,8 @@ void ReduceSDFExtensionToParent(urdf::LinkSharedPtr _link)
 
   // update extension map with references to linkName
   // this->ListSDFExtensions();
-  StringSDFExtensionPtrMap::iterator ext = g_extensions.find(linkName);
-  if (ext != g_extensions.end())
+  StringSDFExtensionPtrMap::iterator ext = _state.extensions.find(linkName);
+  if (ext != _state.extensions.end())
   {
     sdfdbg << "  REDUCE EXTENSION: moving reference from ["
            << linkName << "] to [" << _link->getParent()->name << "]\n";
@@ -2486,40 +2718,21 @@ void ReduceSDFExtensionToParent(urdf::LinkSharedPtr _link)
       ReduceSDFExtensionsTransform((*ge));
     }
 
-    // find pointer to the existing extension with the new _link reference
-    std::string parentLinkName = _link->getParent()->name;
-    StringSDFExtensionPtrMap::iterator parentExt =
-      g_extensions.find(parentLinkName);
-
-    // if none exist, create new extension with parentLinkName
-    if (parentExt == g_extensions.end())
-    {
-      std::vector<SDFExtensionPtr> ge;
-      g_extensions.insert(std::make_pair(parentLinkName, ge));
-      parentExt = g_extensions.find(parentLinkName);
-    }
-
-    // move sdf extensions from _link into the parent _link's extensions
-    for (std::vector<SDFExtensionPtr>::iterator ge = ext->second.begin();
-         ge != ext->second.end(); ++ge)
-    {
-      parentExt->second.push_back(*ge);
-    }
+    // find the extensions with the new _link reference, creating them if
+    // none exist, and move the sdf extensions of _link there
+    std::vector<SDFExtensionPtr> &parentExt =
+        _state.extensions[_link->getParent()->name];
+    parentExt.insert(parentExt.end(), ext->second.begin(), ext->second.end());
     ext->second.clear();
   }
 
   // for extensions with empty reference, search and replace
   // _link name patterns within the plugin with new _link name
   // and assign the proper reduction transform for the _link name pattern
-  for (StringSDFExtensionPtrMap::iterator sdfIt = g_extensions.begin();
-       sdfIt != g_extensions.end(); ++sdfIt)
+  // update reduction transform (for contacts, rays, cameras for now).
+  for (const SDFExtensionPtr &ge : _reduction.frameExtensions)
   {
-    // update reduction transform (for contacts, rays, cameras for now).
-    for (std::vector<SDFExtensionPtr>::iterator ge = sdfIt->second.begin();
-         ge != sdfIt->second.end(); ++ge)
-    {
-      ReduceSDFExtensionFrameReplace(*ge, _link);
-    }
+    ReduceSDFExtensionFrameReplace(ge, _link);
   }
 
   // this->ListSDFExtensions();
@@ -2580,8 +2793,8 @@ void ReduceSDFExtensionsTransform(SDFExtensionPtr _ge)
 void URDF2SDF::ListSDFExtensions()
 {
   for (StringSDFExtensionPtrMap::iterator
-      sdfIt = g_extensions.begin();
-      sdfIt != g_extensions.end(); ++sdfIt)
+      sdfIt = this->dataPtr->extensions.begin();
+      sdfIt != this->dataPtr->extensions.end(); ++sdfIt)
   {
     int extCount = 0;
     for (std::vector<SDFExtensionPtr>::iterator ge = sdfIt->second.begin();
@@ -2607,31 +2820,28 @@ void URDF2SDF::ListSDFExtensions()
 ////////////////////////////////////////////////////////////////////////////////
 void URDF2SDF::ListSDFExtensions(const std::string &_reference)
 {
-  for (StringSDFExtensionPtrMap::iterator
-      sdfIt = g_extensions.begin();
-      sdfIt != g_extensions.end(); ++sdfIt)
+  StringSDFExtensionPtrMap::iterator sdfIt =
+      this->dataPtr->extensions.find(_reference);
+  if (sdfIt != this->dataPtr->extensions.end())
   {
-    if (sdfIt->first == _reference)
+    sdfdbg <<  "  PRINTING [" << static_cast<int>(sdfIt->second.size())
+           << "] extensions referencing [" << _reference << "]\n";
+    for (std::vector<SDFExtensionPtr>::iterator
+        ge = sdfIt->second.begin(); ge != sdfIt->second.end(); ++ge)
     {
-      sdfdbg <<  "  PRINTING [" << static_cast<int>(sdfIt->second.size())
-             << "] extensions referencing [" << _reference << "]\n";
-      for (std::vector<SDFExtensionPtr>::iterator
-          ge = sdfIt->second.begin(); ge != sdfIt->second.end(); ++ge)
+      for (auto blobIt = (*ge)->blobs.begin();
+          blobIt != (*ge)->blobs.end(); ++blobIt)
       {
-        for (auto blobIt = (*ge)->blobs.begin();
-            blobIt != (*ge)->blobs.end(); ++blobIt)
-        {
-          tinyxml2::XMLPrinter streamIn;
-          (*blobIt)->Print(&streamIn);
-          sdfdbg << "    BLOB: [" << streamIn.CStr() << "]\n";
-        }
+        tinyxml2::XMLPrinter streamIn;
+        (*blobIt)->Print(&streamIn);
+        sdfdbg << "    BLOB: [" << streamIn.CStr() << "]\n";
       }
     }
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateSDF(tinyxml2::XMLElement *_root,
+void CreateSDF(const URDF2SDFPrivate &_state, tinyxml2::XMLElement *_root,
                urdf::LinkConstSharedPtr _link,
                const ignition::math::Pose3d &_transform)
 {
@@ -2674,17 +2884,17 @@ void CreateSDF(tinyxml2::XMLElement *_root,
 
   // create <body:...> block for non fixed joint attached bodies
   if ((_link->getParent() && _link->getParent()->name == "world") ||
-      !g_reduceFixedJoints ||
+      !_state.reduceFixedJoints ||
       (!_link->parent_joint ||
-       !FixedJointShouldBeReduced(_link->parent_joint)))
+       !FixedJointShouldBeReduced(_state, _link->parent_joint)))
   {
-    CreateLink(_root, _link, _currentTransform);
+    CreateLink(_state, _root, _link, _currentTransform);
   }
 
   // recurse into children
   for (unsigned int i = 0 ; i < _link->child_links.size() ; ++i)
   {
-    CreateSDF(_root, _link->child_links[i], _currentTransform);
+    CreateSDF(_state, _root, _link->child_links[i], _currentTransform);
   }
 }
 
@@ -2717,7 +2927,7 @@ urdf::Pose CopyPose(ignition::math::Pose3d _pose)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateLink(tinyxml2::XMLElement *_root,
+void CreateLink(const URDF2SDFPrivate &_state, tinyxml2::XMLElement *_root,
                 urdf::LinkConstSharedPtr _link,
                 ignition::math::Pose3d &_currentTransform)
 {
@@ -2752,23 +2962,24 @@ void CreateLink(tinyxml2::XMLElement *_root,
   CreateInertial(elem, _link);
 
   // create new collision block
-  CreateCollisions(elem, _link);
+  CreateCollisions(_state, elem, _link);
 
   // create new visual block
-  CreateVisuals(elem, _link);
+  CreateVisuals(_state, elem, _link);
 
   // copy sdf extensions data
-  InsertSDFExtensionLink(elem, _link->name);
+  InsertSDFExtensionLink(_state, elem, _link->name);
 
   // make a <joint:...> block
-  CreateJoint(_root, _link, _currentTransform);
+  CreateJoint(_state, _root, _link, _currentTransform);
 
   // add body to document
   _root->LinkEndChild(elem);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateCollisions(tinyxml2::XMLElement* _elem,
+void CreateCollisions(const URDF2SDFPrivate &_state,
+                      tinyxml2::XMLElement* _elem,
                       urdf::LinkConstSharedPtr _link)
 {
   // loop through all collisions in
@@ -2806,14 +3017,14 @@ void CreateCollisions(tinyxml2::XMLElement* _elem,
     }
 
     // make a <collision> block
-    CreateCollision(_elem, _link, *collision, collisionName);
+    CreateCollision(_state, _elem, _link, *collision, collisionName);
 
     ++collisionCount;
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateVisuals(tinyxml2::XMLElement* _elem,
+void CreateVisuals(const URDF2SDFPrivate &_state, tinyxml2::XMLElement* _elem,
                    urdf::LinkConstSharedPtr _link)
 {
   // loop through all visuals in
@@ -2851,7 +3062,7 @@ void CreateVisuals(tinyxml2::XMLElement* _elem,
     }
 
     // make a <visual> block
-    CreateVisual(_elem, _link, *visual, visualName);
+    CreateVisual(_state, _elem, _link, *visual, visualName);
 
     ++visualCount;
   }
@@ -2897,7 +3108,7 @@ void CreateInertial(tinyxml2::XMLElement *_elem,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateJoint(tinyxml2::XMLElement *_root,
+void CreateJoint(const URDF2SDFPrivate &_state, tinyxml2::XMLElement *_root,
                  urdf::LinkConstSharedPtr _link,
                  ignition::math::Pose3d &/*_currentTransform*/)
 {
@@ -2936,17 +3147,18 @@ void CreateJoint(tinyxml2::XMLElement *_root,
   bool fixedJointConvertedToRevoluteJoint = false;
   if (jtype == "fixed")
   {
+    const auto &revoluteJoints = _state.fixedJointsTransformedInRevoluteJoints;
     fixedJointConvertedToRevoluteJoint =
-      (g_fixedJointsTransformedInRevoluteJoints.find(_link->parent_joint->name)
-       != g_fixedJointsTransformedInRevoluteJoints.end());
+      (revoluteJoints.find(_link->parent_joint->name) !=
+       revoluteJoints.end());
   }
 
   // skip if joint type is fixed and it is lumped
   //   skip/return with the exception of root link being world,
   //   because there's no lumping there
   if (_link->getParent() && _link->getParent()->name != "world"
-      && FixedJointShouldBeReduced(_link->parent_joint)
-      && g_reduceFixedJoints)
+      && FixedJointShouldBeReduced(_state, _link->parent_joint)
+      && _state.reduceFixedJoints)
   {
     return;
   }
@@ -3004,7 +3216,7 @@ void CreateJoint(tinyxml2::XMLElement *_root,
                     Values2str(1, &_link->parent_joint->dynamics->friction));
       }
 
-      if (g_enforceLimits && _link->parent_joint->limits)
+      if (_state.enforceLimits && _link->parent_joint->limits)
       {
         if (jtype == "slider")
         {
@@ -3058,7 +3270,7 @@ void CreateJoint(tinyxml2::XMLElement *_root,
     }
 
     // copy sdf extensions data
-    InsertSDFExtensionJoint(joint, _link->parent_joint->name);
+    InsertSDFExtensionJoint(_state, joint, _link->parent_joint->name);
 
     // add joint to document
     _root->LinkEndChild(joint);
@@ -3066,7 +3278,7 @@ void CreateJoint(tinyxml2::XMLElement *_root,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateCollision(tinyxml2::XMLElement* _elem,
+void CreateCollision(const URDF2SDFPrivate &_state, tinyxml2::XMLElement* _elem,
                      urdf::LinkConstSharedPtr _link,
                      urdf::CollisionSharedPtr _collision,
                      const std::string &_oldLinkName)
@@ -3114,14 +3326,15 @@ void CreateCollision(tinyxml2::XMLElement* _elem,
   }
 
   // set additional data from extensions
-  InsertSDFExtensionCollision(sdfCollision, _link->name);
+  InsertSDFExtensionCollision(_state, sdfCollision, _link->name);
 
   // add geometry to body
   _elem->LinkEndChild(sdfCollision);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateVisual(tinyxml2::XMLElement *_elem, urdf::LinkConstSharedPtr _link,
+void CreateVisual(const URDF2SDFPrivate &_state,
+                  tinyxml2::XMLElement *_elem, urdf::LinkConstSharedPtr _link,
     urdf::VisualSharedPtr _visual, const std::string &_oldLinkName)
 {
   auto* doc = _elem->GetDocument();
@@ -3160,7 +3373,7 @@ void CreateVisual(tinyxml2::XMLElement *_elem, urdf::LinkConstSharedPtr _link,
   }
 
   // set additional data from extensions
-  InsertSDFExtensionVisual(sdfVisual, _link->name);
+  InsertSDFExtensionVisual(_state, sdfVisual, _link->name);
 
   if (_visual->material)
   {
@@ -3212,15 +3425,32 @@ void CreateVisual(tinyxml2::XMLElement *_elem, urdf::LinkConstSharedPtr _link,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void URDF2SDF::InitModelString(const std::string &_urdfStr,
+void URDF2SDF::InitModelString(std::string_view _urdfStr,
                                const ParserConfig& _config,
                                tinyxml2::XMLDocument* _sdfXmlOut,
                                bool _enforceLimits)
 {
-  g_enforceLimits = _enforceLimits;
+  // The document is parsed once, for both the robot model and the sdf
+  // extensions.
+  tinyxml2::XMLDocument urdfXml;
+  if (urdfXml.Parse(_urdfStr.data(), _urdfStr.size()))
+  {
+    sdferr << "Unable to call parseURDF on robot model\n";
+    return;
+  }
 
-  // Create a RobotModel from string
-  urdf::ModelInterfaceSharedPtr robotModel = urdf::parseURDF(_urdfStr);
+  this->InitModelXml(urdfXml, _config, _sdfXmlOut, _enforceLimits);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URDF2SDF::InitModelXml(tinyxml2::XMLDocument &_urdfXml,
+                            const ParserConfig& _config,
+                            tinyxml2::XMLDocument* _sdfXmlOut,
+                            bool _enforceLimits)
+{
+  // Create a RobotModel from the document
+  urdf::ModelInterfaceSharedPtr robotModel =
+      urdf::parseURDFDocument(_urdfXml);
 
   if (!robotModel)
   {
@@ -3228,6 +3458,22 @@ void URDF2SDF::InitModelString(const std::string &_urdfStr,
     return;
   }
 
+  this->InitModel(robotModel, _urdfXml, _config, _sdfXmlOut, _enforceLimits);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URDF2SDF::InitModel(const std::shared_ptr<urdf::ModelInterface> &_robot,
+                         tinyxml2::XMLDocument &_urdfXml,
+                         const ParserConfig &_config,
+                         tinyxml2::XMLDocument *_sdfXmlOut,
+                         bool _enforceLimits)
+{
+  this->dataPtr->enforceLimits = _enforceLimits;
+  this->dataPtr->initialRobotPoseValid = false;
+
+  const urdf::ModelInterfaceSharedPtr &robotModel = _robot;
+  tinyxml2::XMLDocument &urdfXml = _urdfXml;
+
   // create root element and define needed namespaces
   tinyxml2::XMLElement *robot = _sdfXmlOut->NewElement("model");
 
@@ -3238,24 +3484,16 @@ void URDF2SDF::InitModelString(const std::string &_urdfStr,
   // while sdf defines all links relative to model frame
   ignition::math::Pose3d transform;
 
-  // parse sdf extension
-  tinyxml2::XMLDocument urdfXml;
-  if (urdfXml.Parse(_urdfStr.c_str()))
-  {
-    sdferr << "Unable to parse URDF string: " << urdfXml.ErrorStr() << "\n";
-    return;
-  }
-
-  // Set g_reduceFixedJoints based on config value.
-  g_reduceFixedJoints = !_config.URDFPreserveFixedJoint();
+  // Set reduceFixedJoints based on config value.
+  this->dataPtr->reduceFixedJoints = !_config.URDFPreserveFixedJoint();
 
-  g_extensions.clear();
-  g_fixedJointsTransformedInFixedJoints.clear();
-  g_fixedJointsTransformedInRevoluteJoints.clear();
+  this->dataPtr->extensions.clear();
+  this->dataPtr->fixedJointsTransformedInFixedJoints.clear();
+  this->dataPtr->fixedJointsTransformedInRevoluteJoints.clear();
   this->ParseSDFExtension(urdfXml);
 
   // Parse robot pose
-  ParseRobotOrigin(urdfXml);
+  ParseRobotOrigin(*this->dataPtr, urdfXml);
 
   urdf::LinkConstSharedPtr rootLink = robotModel->getRoot();
   tinyxml2::XMLElement *sdf;
@@ -3272,9 +3510,10 @@ void URDF2SDF::InitModelString(const std::string &_urdfStr,
     // parent link recursively
     // using the disabledFixedJointLumping or preserveFixedJoint options
     // is possible to disable fixed joint lumping only for selected joints
-    if (g_reduceFixedJoints)
+    if (this->dataPtr->reduceFixedJoints)
     {
-      ReduceFixedJoints(robot, urdf::const_pointer_cast<urdf::Link>(rootLink));
+      ReduceFixedJoints(*this->dataPtr, robot,
+                        urdf::const_pointer_cast<urdf::Link>(rootLink));
     }
 
     if (rootLink->name == "world")
@@ -3284,19 +3523,19 @@ void URDF2SDF::InitModelString(const std::string &_urdfStr,
           child = rootLink->child_links.begin();
           child != rootLink->child_links.end(); ++child)
       {
-        CreateSDF(robot, (*child), transform);
+        CreateSDF(*this->dataPtr, robot, (*child), transform);
       }
     }
     else
     {
       // convert, starting from root link
-      CreateSDF(robot, rootLink, transform);
+      CreateSDF(*this->dataPtr, robot, rootLink, transform);
     }
 
     // insert the extensions without reference into <robot> root level
-    InsertSDFExtensionRobot(robot);
+    InsertSDFExtensionRobot(*this->dataPtr, robot);
 
-    InsertRobotOrigin(robot);
+    InsertRobotOrigin(*this->dataPtr, robot);
 
     // Create new sdf
     sdf = _sdfXmlOut->NewElement("sdf");
@@ -3327,10 +3566,10 @@ void URDF2SDF::InitModelDoc(const tinyxml2::XMLDocument *_xmlDoc,
                             const ParserConfig& _config,
                             tinyxml2::XMLDocument *_sdfXmlDoc)
 {
-  tinyxml2::XMLPrinter printer;
-  _xmlDoc->Print(&printer);
-  std::string urdfStr = printer.CStr();
-  InitModelString(urdfStr, _config, _sdfXmlDoc);
+  // Copy the nodes instead of printing the document and parsing it again.
+  tinyxml2::XMLDocument urdfXml;
+  _xmlDoc->DeepCopy(&urdfXml);
+  this->InitModelXml(urdfXml, _config, _sdfXmlDoc);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3338,29 +3577,123 @@ void URDF2SDF::InitModelFile(const std::string &_filename,
                              const ParserConfig& _config,
                              tinyxml2::XMLDocument *_sdfXmlDoc)
 {
-  tinyxml2::XMLDocument xmlDoc;
-  if (!xmlDoc.LoadFile(_filename.c_str()))
+  std::string urdfStr;
+  if (readFileContents(_filename, _config, urdfStr))
   {
-    this->InitModelDoc(&xmlDoc, _config, _sdfXmlDoc);
+    this->InitModelString(urdfStr, _config, _sdfXmlDoc);
   }
   else
   {
-    sdferr << "Unable to load file["
-      << _filename << "]:" << xmlDoc.ErrorStr() << "\n";
+    sdferr << "Unable to load file[" << _filename << "]\n";
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool FixedJointShouldBeReduced(urdf::JointSharedPtr _jnt)
+/// \brief Get the path of the file where the conversion of a URDF document
+/// is cached.
+/// \param[in] _urdfStr Content of the URDF file.
+/// \param[in] _config Parser configuration, with the cache directory and the
+/// URDF options.
+/// \return Path of the cache file, or an empty string if URDF conversions
+/// are not cached.
+static std::string urdfCachePath(const std::string &_urdfStr,
+                                 const ParserConfig &_config)
+{
+  if (_config.URDFCacheDirectory().empty())
+    return "";
+
+  // 64-bit FNV-1a hash of everything the converted document depends on.
+  std::uint64_t hash = kFnvOffsetBasis;
+  hashString(hash, SDF::Version());
+  hashString(hash, _config.URDFPreserveFixedJoint() ? "1" : "0");
+  hashString(hash, _urdfStr);
+
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash << ".sdf";
+  return filesystem::append(_config.URDFCacheDirectory(), name.str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Store a converted URDF document in the cache. The document is
+/// written to a temporary file that is renamed, so that other processes
+/// never read a partial document.
+/// \param[in] _cachePath Path of the cache file, from urdfCachePath.
+/// \param[in] _sdfXmlDoc The converted document.
+static void writeUrdfCache(const std::string &_cachePath,
+                           const tinyxml2::XMLDocument &_sdfXmlDoc)
+{
+  filesystem::create_directories(filesystem::parent_path(_cachePath));
+
+  std::ostringstream tmpName;
+  tmpName << _cachePath << ".tmp" << std::random_device()();
+  const std::string tmpPath = tmpName.str();
+
+  tinyxml2::XMLPrinter printer;
+  _sdfXmlDoc.Print(&printer);
+  {
+    std::ofstream out(tmpPath, std::ios::binary);
+    out.write(printer.CStr(), printer.CStrSize() - 1);
+    if (!out)
+    {
+      sdfwarn << "Unable to write URDF conversion cache file["
+              << tmpPath << "]\n";
+      out.close();
+      filesystem::remove(tmpPath);
+      return;
+    }
+  }
+
+  if (!filesystem::rename(tmpPath, _cachePath))
+    filesystem::remove(tmpPath);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool URDF2SDF::InitModelFileIfURDF(const std::string &_filename,
+                                   const ParserConfig &_config,
+                                   tinyxml2::XMLDocument *_sdfXmlDoc)
+{
+  std::string urdfStr;
+  if (!readFileContents(_filename, _config, urdfStr))
+    return false;
+
+  // Only URDF models that were converted are cached, so a cache hit is a
+  // URDF model.
+  const std::string cachePath = urdfCachePath(urdfStr, _config);
+  if (!cachePath.empty())
+  {
+    if (_sdfXmlDoc->LoadFile(cachePath.c_str()) == tinyxml2::XML_SUCCESS)
+      return true;
+    _sdfXmlDoc->Clear();
+    _sdfXmlDoc->ClearError();
+  }
+
+  tinyxml2::XMLDocument urdfXml;
+  if (urdfXml.Parse(urdfStr.c_str(), urdfStr.size()))
+    return false;
+
+  urdf::ModelInterfaceSharedPtr robotModel =
+      urdf::parseURDFDocument(urdfXml);
+  if (!robotModel)
+    return false;
+
+  this->InitModel(robotModel, urdfXml, _config, _sdfXmlDoc, true);
+  if (!cachePath.empty())
+    writeUrdfCache(cachePath, *_sdfXmlDoc);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FixedJointShouldBeReduced(const URDF2SDFPrivate &_state,
+                               urdf::JointSharedPtr _jnt)
 {
     // A joint should be lumped only if its type is fixed and
     // the disabledFixedJointLumping or preserveFixedJoint
     // joint options are not set
+    const auto &revoluteJoints = _state.fixedJointsTransformedInRevoluteJoints;
+    const auto &fixedJoints = _state.fixedJointsTransformedInFixedJoints;
     return (_jnt->type == urdf::Joint::FIXED &&
-              (g_fixedJointsTransformedInRevoluteJoints.find(_jnt->name) ==
-                 g_fixedJointsTransformedInRevoluteJoints.end()) &&
-              (g_fixedJointsTransformedInFixedJoints.find(_jnt->name) ==
-                 g_fixedJointsTransformedInFixedJoints.end()));
+              (revoluteJoints.find(_jnt->name) == revoluteJoints.end()) &&
+              (fixedJoints.find(_jnt->name) == fixedJoints.end()));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
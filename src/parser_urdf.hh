@@ -20,20 +20,31 @@
 #include <tinyxml2.h>
 #include <sdf/sdf_config.h>
 
+#include <memory>
 #include <string>
+#include <string_view>
 
 #include "sdf/Console.hh"
 #include "sdf/ParserConfig.hh"
 #include "sdf/Types.hh"
 #include "sdf/system_util.hh"
 
+namespace urdf
+{
+  class ModelInterface;
+}
+
 namespace sdf
 {
   // Inline bracket to help doxygen filtering.
   inline namespace SDF_VERSION_NAMESPACE {
   //
 
-  /// \brief URDF to SDF converter
+  class URDF2SDFPrivate;
+
+  /// \brief URDF to SDF converter. The conversion state, such as the gazebo
+  /// extensions of the model, is held by each instance, so different
+  /// instances can be used on different threads at the same time.
   class URDF2SDF
   {
     /// \brief constructor
@@ -64,11 +75,34 @@ namespace sdf
     /// \param[in] _config Custom parser configuration
     /// \param[inout] _sdfXmlDoc document to populate with the sdf model.
     /// \param[in] _enforceLimits option to enforce joint limits
-    public: void InitModelString(const std::string &_urdfStr,
+    public: void InitModelString(std::string_view _urdfStr,
                                  const ParserConfig& _parserConfig,
                                  tinyxml2::XMLDocument *_sdfXmlDoc,
                                  bool _enforceLimits = true);
 
+    /// \brief convert a parsed urdf xml document to sdf xml document, with
+    /// option to enforce limits. The robot model and the sdf extensions are
+    /// read from the same document.
+    /// \param[in] _urdfXml document containing the urdf model.
+    /// \param[in] _config Custom parser configuration
+    /// \param[inout] _sdfXmlDoc document to populate with the sdf model.
+    /// \param[in] _enforceLimits option to enforce joint limits
+    private: void InitModelXml(tinyxml2::XMLDocument &_urdfXml,
+                               const ParserConfig& _config,
+                               tinyxml2::XMLDocument *_sdfXmlDoc,
+                               bool _enforceLimits = true);
+
+    /// \brief Convert a urdf file to an sdf xml document if it holds a urdf
+    /// model. The file is read once, and the urdf model parsed to check it is
+    /// the one that is converted.
+    /// \param[in] _filename Path of the file.
+    /// \param[in] _config Custom parser configuration
+    /// \param[inout] _sdfXmlDoc document to populate with the sdf model.
+    /// \return True if _filename is a URDF model and was converted.
+    public: bool InitModelFileIfURDF(const std::string &_filename,
+                                     const ParserConfig &_config,
+                                     tinyxml2::XMLDocument *_sdfXmlDoc);
+
     /// \brief Return true if the filename is a URDF model.
     /// \param[in] _filename File to check.
     /// \return True if _filename is a URDF model.
@@ -83,6 +117,22 @@ namespace sdf
     /// things that do not belong in urdf but should be mapped into sdf
     /// @todo: do this using sdf definitions, not hard coded stuff
     private: void ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml);
+
+    /// \brief Convert a parsed urdf model to an sdf xml document.
+    /// \param[in] _robot The urdf model.
+    /// \param[in] _urdfXml xml document the urdf model was parsed from, used
+    /// to read the gazebo extensions.
+    /// \param[in] _config Custom parser configuration
+    /// \param[inout] _sdfXmlOut document to populate with the sdf model.
+    /// \param[in] _enforceLimits option to enforce joint limits
+    private: void InitModel(const std::shared_ptr<urdf::ModelInterface> &_robot,
+                            tinyxml2::XMLDocument &_urdfXml,
+                            const ParserConfig &_config,
+                            tinyxml2::XMLDocument *_sdfXmlOut,
+                            bool _enforceLimits);
+
+    /// \brief Private data pointer
+    private: std::unique_ptr<URDF2SDFPrivate> dataPtr;
   };
   }
 }
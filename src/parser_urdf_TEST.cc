@@ -17,10 +17,15 @@
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
 #include <list>
+#include <thread>
+#include <vector>
 
 #include "sdf/sdf.hh"
 #include "parser_urdf.hh"
+#include "test_config.h"
 
 /////////////////////////////////////////////////
 std::string getMinimalUrdfTxt()
@@ -81,6 +86,109 @@ TEST(URDFParser, InitModelDoc_BasicModel_NoThrow)
   );    // NOLINT(whitespace/parens)
 }
 
+/////////////////////////////////////////////////
+TEST(URDFParser, InitModelFileIfURDF)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  std::filesystem::create_directories(tmpDir);
+
+  const std::string urdfFile = sdf::filesystem::append(tmpDir, "minimal.urdf");
+  {
+    std::ofstream out(urdfFile);
+    out << getMinimalUrdfTxt();
+  }
+
+  sdf::URDF2SDF parser_;
+  sdf::ParserConfig config_;
+  tinyxml2::XMLDocument sdf_result;
+  EXPECT_TRUE(parser_.InitModelFileIfURDF(urdfFile, config_, &sdf_result));
+
+  tinyxml2::XMLPrinter printer;
+  sdf_result.Accept(&printer);
+  EXPECT_EQ(convertUrdfStrToSdfStr(getMinimalUrdfTxt(), config_),
+            std::string(printer.CStr()));
+
+  // Files that do not hold a URDF model are not converted.
+  const std::string sdfFile = sdf::filesystem::append(tmpDir, "minimal.sdf");
+  {
+    std::ofstream out(sdfFile);
+    out << "<sdf version='1.9'><model name='test_robot'/></sdf>";
+  }
+  tinyxml2::XMLDocument sdf_result2;
+  EXPECT_FALSE(parser_.InitModelFileIfURDF(sdfFile, config_, &sdf_result2));
+  EXPECT_EQ(nullptr, sdf_result2.FirstChildElement());
+  EXPECT_FALSE(parser_.InitModelFileIfURDF(
+      sdf::filesystem::append(tmpDir, "missing.urdf"), config_, &sdf_result2));
+}
+
+/////////////////////////////////////////////////
+TEST(URDFParser, CacheDirectory)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string cacheDir = sdf::filesystem::append(tmpDir, "urdf_cache");
+  std::filesystem::remove_all(cacheDir);
+  std::filesystem::create_directories(tmpDir);
+
+  const std::string urdfFile = sdf::filesystem::append(tmpDir, "cached.urdf");
+  {
+    std::ofstream out(urdfFile);
+    out << getMinimalUrdfTxt();
+  }
+
+  auto convert = [&urdfFile](const sdf::ParserConfig &_config)
+  {
+    sdf::URDF2SDF parser_;
+    tinyxml2::XMLDocument sdf_result;
+    EXPECT_TRUE(parser_.InitModelFileIfURDF(urdfFile, _config, &sdf_result));
+    tinyxml2::XMLPrinter printer;
+    sdf_result.Accept(&printer);
+    return std::string(printer.CStr());
+  };
+
+  sdf::ParserConfig config_;
+  EXPECT_TRUE(config_.URDFCacheDirectory().empty());
+  config_.URDFSetCacheDirectory(cacheDir);
+  EXPECT_EQ(cacheDir, config_.URDFCacheDirectory());
+
+  // The first conversion stores the converted document.
+  const std::string expected = convertUrdfStrToSdfStr(getMinimalUrdfTxt());
+  EXPECT_EQ(expected, convert(config_));
+  std::vector<std::filesystem::path> cached;
+  for (const auto &entry : std::filesystem::directory_iterator(cacheDir))
+    cached.push_back(entry.path());
+  ASSERT_EQ(1u, cached.size());
+  EXPECT_EQ(".sdf", cached[0].extension().string());
+
+  // Later conversions read it instead of converting the file.
+  {
+    std::ofstream out(cached[0]);
+    out << "<sdf version='1.9'><model name='from_cache'/></sdf>";
+  }
+  EXPECT_NE(std::string::npos, convert(config_).find("from_cache"));
+
+  // The URDF options are part of the key.
+  sdf::ParserConfig preserveConfig = config_;
+  preserveConfig.URDFSetPreserveFixedJoint(true);
+  EXPECT_EQ(std::string::npos, convert(preserveConfig).find("from_cache"));
+
+  // So is the content of the file.
+  {
+    std::ofstream out(urdfFile);
+    out << "<robot name='changed'><link name='link1'/></robot>";
+  }
+  EXPECT_EQ(std::string::npos, convert(config_).find("from_cache"));
+
+  std::size_t count = 0;
+  for (const auto &entry : std::filesystem::directory_iterator(cacheDir))
+  {
+    EXPECT_EQ(".sdf", entry.path().extension().string());
+    ++count;
+  }
+  EXPECT_EQ(3u, count);
+}
+
 /////////////////////////////////////////////////
 TEST(URDFParser, ParseResults_BasicModel_ParseEqualToModel)
 {
@@ -866,6 +974,147 @@ TEST(URDFParser, CheckJointTransform)
   std::string sdfStr = convertUrdfStrToSdfStr(str.str());
   EXPECT_EQ(expectedSdf, sdfStr);
 }
+/////////////////////////////////////////////////
+TEST(URDFParser, FixedJointChainReduction)
+{
+  // A chain of links connected by fixed joints is lumped into its first link,
+  // with the transforms of the chain accumulated.
+  const int chainLength = 4;
+  std::ostringstream str;
+  str << "<robot name='test_robot'>";
+  for (int i = 0; i <= chainLength; ++i)
+  {
+    str << "  <link name='link" << i << "'>"
+        << "    <inertial>"
+        << "      <mass value='1.0'/>"
+        << "      <inertia ixx='1.0' ixy='0.0' ixz='0.0'"
+        << "               iyy='1.0' iyz='0.0' izz='1.0'/>"
+        << "    </inertial>"
+        << "    <visual>"
+        << "      <origin xyz='0 0.5 0' rpy='0 0 0'/>"
+        << "      <geometry><box size='1 1 1'/></geometry>"
+        << "    </visual>"
+        << "  </link>";
+  }
+  for (int i = 1; i < chainLength; ++i)
+  {
+    str << "  <joint name='joint" << i << "' type='fixed'>"
+        << "    <parent link='link" << i - 1 << "'/>"
+        << "    <child link='link" << i << "'/>"
+        << "    <origin xyz='1 0 0' rpy='0 0 0'/>"
+        << "  </joint>";
+  }
+  str << "  <joint name='joint" << chainLength << "' type='revolute'>"
+      << "    <parent link='link" << chainLength - 1 << "'/>"
+      << "    <child link='link" << chainLength << "'/>"
+      << "    <origin xyz='0 0 1' rpy='0 0 0'/>"
+      << "    <limit lower='-1' upper='1' effort='1' velocity='1'/>"
+      << "  </joint>"
+      << "</robot>";
+
+  sdf::SDF sdfResult;
+  convertUrdfStrToSdf(str.str(), sdfResult);
+  sdf::ElementPtr model = sdfResult.Root()->GetElement("model");
+  ASSERT_NE(nullptr, model);
+
+  sdf::ElementPtr link = model->GetElement("link");
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ("link0", link->Get<std::string>("name"));
+
+  // The visuals of the chain are kept in order, in the frame of link0.
+  int visualCount = 0;
+  for (sdf::ElementPtr visual = link->GetElement("visual"); visual;
+       visual = visual->GetNextElement("visual"), ++visualCount)
+  {
+    EXPECT_EQ(ignition::math::Pose3d(visualCount, 0.5, 0, 0, 0, 0),
+              visual->Get<ignition::math::Pose3d>("pose"));
+  }
+  EXPECT_EQ(chainLength, visualCount);
+
+  sdf::ElementPtr joint = model->GetElement("joint");
+  ASSERT_NE(nullptr, joint);
+  EXPECT_EQ("joint" + std::to_string(chainLength),
+            joint->Get<std::string>("name"));
+  EXPECT_EQ("link0", joint->Get<std::string>("parent"));
+  EXPECT_EQ(ignition::math::Pose3d(chainLength - 1, 0, 1, 0, 0, 0),
+            joint->Get<ignition::math::Pose3d>("pose"));
+
+  link = link->GetNextElement("link");
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ("link" + std::to_string(chainLength),
+            link->Get<std::string>("name"));
+  EXPECT_EQ(nullptr, link->GetNextElement("link"));
+}
+
+/////////////////////////////////////////////////
+TEST(URDFParser, ConcurrentConversions)
+{
+  // Two models whose conversions depend on their gazebo extensions: the
+  // fixed joint of the first one is preserved, the one of the second is
+  // lumped.
+  std::vector<std::string> urdfs;
+  for (const std::string preserve : {"true", "false"})
+  {
+    std::ostringstream str;
+    str << "<robot name='test_robot_" << preserve << "'>"
+        << "  <link name='link1'>"
+        << "    <inertial>"
+        << "      <mass value='1.0'/>"
+        << "      <inertia ixx='1.0' ixy='0.0' ixz='0.0'"
+        << "               iyy='1.0' iyz='0.0' izz='1.0'/>"
+        << "    </inertial>"
+        << "  </link>"
+        << "  <link name='link2'>"
+        << "    <inertial>"
+        << "      <mass value='1.0'/>"
+        << "      <inertia ixx='1.0' ixy='0.0' ixz='0.0'"
+        << "               iyy='1.0' iyz='0.0' izz='1.0'/>"
+        << "    </inertial>"
+        << "  </link>"
+        << "  <joint name='joint1_2' type='fixed'>"
+        << "    <parent link='link1' />"
+        << "    <child  link='link2' />"
+        << "    <origin xyz='1.0 0.0 0.0' rpy='0.0 0.0 0.0' />"
+        << "  </joint>"
+        << "  <gazebo reference='joint1_2'>"
+        << "    <preserveFixedJoint>" << preserve << "</preserveFixedJoint>"
+        << "  </gazebo>"
+        << "  <gazebo reference='link2'>"
+        << "    <selfCollide>true</selfCollide>"
+        << "  </gazebo>"
+        << "</robot>";
+    urdfs.push_back(str.str());
+  }
+
+  std::vector<std::string> expected;
+  for (const auto &urdf : urdfs)
+    expected.push_back(convertUrdfStrToSdfStr(urdf));
+  EXPECT_NE(expected[0], expected[1]);
+
+  // Each thread converts with its own URDF2SDF instance.
+  const std::size_t threadCount = 8;
+  const int conversionCount = 20;
+  std::vector<int> mismatches(threadCount, 0);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < threadCount; ++i)
+  {
+    threads.emplace_back([&, i]()
+    {
+      for (int j = 0; j < conversionCount; ++j)
+      {
+        const std::size_t model = (i + j) % urdfs.size();
+        if (convertUrdfStrToSdfStr(urdfs[model]) != expected[model])
+          ++mismatches[i];
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (std::size_t i = 0; i < threadCount; ++i)
+    EXPECT_EQ(0, mismatches[i]) << "thread " << i;
+}
+
 /////////////////////////////////////////////////
 TEST(URDFParser, OutputPrecision)
 {
@@ -64,27 +64,30 @@ public:
   bool init(const std::string &vector_str)
   {
     this->clear();
-    std::vector<std::string> pieces;
-    std::vector<float> rgba;
-    urdf::split_string( pieces, vector_str, " ");
-    for (unsigned int i = 0; i < pieces.size(); ++i)
+    float rgba[4];
+    std::size_t count = 0;
+    bool parsed = true;
+    urdf::for_each_token(vector_str, ' ',
+        [&](const char *begin, const char *end)
     {
-      if (!pieces[i].empty())
+      if (!parsed)
+        return;
+      try
       {
-        try
-        {
-          rgba.push_back(std::stof(pieces[i]));
-        }
-        catch (std::invalid_argument &/*e*/) {
-          return false;
-        }
-        catch (std::out_of_range &/*e*/) {
-          return false;
-        }
+        const float value = urdf::token_to_float(begin, end);
+        if (count < 4)
+          rgba[count] = value;
+        ++count;
       }
-    }
+      catch (std::invalid_argument &/*e*/) {
+        parsed = false;
+      }
+      catch (std::out_of_range &/*e*/) {
+        parsed = false;
+      }
+    });
 
-    if (rgba.size() != 4)
+    if (!parsed || count != 4)
     {
       return false;
     }
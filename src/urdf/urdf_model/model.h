@@ -52,20 +52,18 @@ public:
   LinkConstSharedPtr getLink(const std::string& name) const
   {
     LinkConstSharedPtr ptr;
-    if (this->links_.find(name) == this->links_.end())
-      ptr.reset();
-    else
-      ptr = this->links_.find(name)->second;
+    auto it = this->links_.find(name);
+    if (it != this->links_.end())
+      ptr = it->second;
     return ptr;
   };
   
   JointConstSharedPtr getJoint(const std::string& name) const
   {
     JointConstSharedPtr ptr;
-    if (this->joints_.find(name) == this->joints_.end())
-      ptr.reset();
-    else
-      ptr = this->joints_.find(name)->second;
+    auto it = this->joints_.find(name);
+    if (it != this->joints_.end())
+      ptr = it->second;
     return ptr;
   };
   
@@ -92,10 +90,9 @@ public:
   void getLink(const std::string& name, LinkSharedPtr &link) const
   {
     LinkSharedPtr ptr;
-    if (this->links_.find(name) == this->links_.end())
-      ptr.reset();
-    else
-      ptr = this->links_.find(name)->second;
+    auto it = this->links_.find(name);
+    if (it != this->links_.end())
+      ptr = it->second;
     link = ptr;
   };
   
@@ -103,10 +100,9 @@ public:
   MaterialSharedPtr getMaterial(const std::string& name) const
   {
     MaterialSharedPtr ptr;
-    if (this->materials_.find(name) == this->materials_.end())
-      ptr.reset();
-    else
-      ptr = this->materials_.find(name)->second;
+    auto it = this->materials_.find(name);
+    if (it != this->materials_.end())
+      ptr = it->second;
     return ptr;
   };
   
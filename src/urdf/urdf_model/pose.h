@@ -69,25 +69,35 @@ public:
   void init(const std::string &vector_str)
   {
     this->clear();
-    std::vector<std::string> pieces;
-    std::vector<double> xyz;
-    urdf::split_string( pieces, vector_str, " ");
-    for (unsigned int i = 0; i < pieces.size(); ++i){
-      if (pieces[i] != ""){
-        try {
-          xyz.push_back(std::stod(pieces[i]));
-        }
-        catch (std::invalid_argument &/*e*/) {
-          throw ParseError("Unable to parse component [" + pieces[i] + "] to a double (while parsing a vector value)");
-        }
-        catch (std::out_of_range &/*e*/) {
-          throw ParseError("Unable to parse component [" + pieces[i] + "] to a double, out of range (while parsing a vector value)");
-        }
+    double xyz[3];
+    std::size_t count = 0;
+    urdf::for_each_token(vector_str, ' ',
+        [&](const char *begin, const char *end)
+    {
+      double value;
+      try {
+        value = urdf::token_to_double(begin, end);
       }
-    }
-
-    if (xyz.size() != 3)
-      throw ParseError("Parser found " + std::to_string(xyz.size())  + " elements but 3 expected while parsing vector [" + vector_str + "]");
+      catch (std::invalid_argument &/*e*/) {
+        throw ParseError("Unable to parse component [" +
+                         std::string(begin, end) +
+                         "] to a double (while parsing a vector value)");
+      }
+      catch (std::out_of_range &/*e*/) {
+        throw ParseError("Unable to parse component [" +
+                         std::string(begin, end) +
+                         "] to a double, out of range (while parsing a "
+                         "vector value)");
+      }
+      if (count < 3)
+        xyz[count] = value;
+      ++count;
+    });
+
+    if (count != 3)
+      throw ParseError("Parser found " + std::to_string(count) +
+                       " elements but 3 expected while parsing vector [" +
+                       vector_str + "]");
 
     this->x = xyz[0];
     this->y = xyz[1];
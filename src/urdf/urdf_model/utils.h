@@ -37,6 +37,9 @@
 #ifndef URDF_INTERFACE_UTILS_H
 #define URDF_INTERFACE_UTILS_H
 
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -62,6 +65,59 @@ void split_string(std::vector<std::string> &result,
   }
 }
 
+// Call f(begin, end) for each non-empty token of input delimited by delim,
+// like split_string, without copying the tokens to strings
+template <typename Function>
+inline
+void for_each_token(const std::string &input, char delim, Function f)
+{
+  const char *begin = input.c_str();
+  const char *const last = begin + input.size();
+  while (begin < last)
+  {
+    const char *end = begin;
+    while (end < last && *end != delim)
+      ++end;
+    if (end != begin)
+      f(begin, end);
+    begin = end + 1;
+  }
+}
+
+// Parse the number at the start of the token [begin, end) with convert
+// (std::strtod or std::strtof) the way std::stod or std::stof parse a string
+// holding the token, without copying it.
+// Throws std::invalid_argument or std::out_of_range like they do
+template <typename T>
+inline
+T token_to_number(const char *begin, const char *end,
+                  T (*convert)(const char *, char **))
+{
+  char *parsed = nullptr;
+  const int saved_errno = errno;
+  errno = 0;
+  const T value = convert(begin, &parsed);
+  const bool out_of_range = errno == ERANGE;
+  errno = saved_errno;
+  if (parsed == begin || parsed > end)
+    throw std::invalid_argument("token_to_number");
+  if (out_of_range)
+    throw std::out_of_range("token_to_number");
+  return value;
+}
+
+inline
+double token_to_double(const char *begin, const char *end)
+{
+  return token_to_number<double>(begin, end, &std::strtod);
+}
+
+inline
+float token_to_float(const char *begin, const char *end)
+{
+  return token_to_number<float>(begin, end, &std::strtof);
+}
+
 }
 
 #endif
@@ -61,17 +61,20 @@ ModelInterfaceSharedPtr  parseURDFFile(const std::string &path)
 
 ModelInterfaceSharedPtr  parseURDF(const std::string &xml_string)
 {
-  ModelInterfaceSharedPtr model(new ModelInterface);
-  model->clear();
-
   tinyxml2::XMLDocument xml_doc;
-  xml_doc.Parse(xml_string.c_str());
+  xml_doc.Parse(xml_string.c_str(), xml_string.size());
   if (xml_doc.Error())
   {
     xml_doc.ClearError();
-    model.reset();
-    return model;
+    return ModelInterfaceSharedPtr();
   }
+  return parseURDFDocument(xml_doc);
+}
+
+ModelInterfaceSharedPtr  parseURDFDocument(tinyxml2::XMLDocument &xml_doc)
+{
+  ModelInterfaceSharedPtr model(new ModelInterface);
+  model->clear();
 
   tinyxml2::XMLElement *robot_xml = xml_doc.FirstChildElement("robot");
   if (!robot_xml)
@@ -123,7 +126,7 @@ ModelInterfaceSharedPtr  parseURDF(const std::string &xml_string)
 
     try {
       parseLink(*link, link_xml);
-      if (model->getLink(link->name))
+      if (model->links_.count(link->name))
       {
         model.reset();
         return model;
@@ -135,9 +138,11 @@ ModelInterfaceSharedPtr  parseURDF(const std::string &xml_string)
         {
           if (!link->visual->material_name.empty())
           {
-            if (model->getMaterial(link->visual->material_name))
+            MaterialSharedPtr material =
+                model->getMaterial(link->visual->material_name);
+            if (material)
             {
-              link->visual->material = model->getMaterial( link->visual->material_name.c_str() );
+              link->visual->material = material;
             }
             else
             {
@@ -59,6 +59,11 @@ URDFDOM_DLLAPI std::string values2str(double d);
 namespace urdf{
 
   URDFDOM_DLLAPI ModelInterfaceSharedPtr parseURDF(const std::string &xml_string);
+  // Parse a URDF document that is already parsed as XML, so that callers
+  // which also read the XML, such as the URDF to SDFormat converter, only
+  // parse it once.
+  URDFDOM_DLLAPI ModelInterfaceSharedPtr parseURDFDocument(
+      tinyxml2::XMLDocument &xml_doc);
   URDFDOM_DLLAPI ModelInterfaceSharedPtr parseURDFFile(const std::string &path);
   URDFDOM_DLLAPI tinyxml2::XMLDocument*  exportURDF(ModelInterfaceSharedPtr &model);
   URDFDOM_DLLAPI tinyxml2::XMLDocument*  exportURDF(const ModelInterface &model);
@@ -127,3 +127,34 @@ TEST(DeprecatedElements, CanEmitWarningWithErrorEnforcmentPolicy)
     EXPECT_EQ(sdf::ErrorCode::ELEMENT_DEPRECATED, errors[0].Code());
   }
 }
+
+////////////////////////////////////////////////////
+TEST(DeprecatedElements, ChecksCustomDescriptions)
+{
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf);
+  auto elem = std::make_shared<sdf::Element>();
+  elem->SetRequired("-1");
+  elem->SetName("testElem");
+  // A custom description makes the root differ from the specification,
+  // which has no deprecated element, so the document is still checked.
+  sdf->Root()->AddElementDescription(elem);
+  auto config = sdf::ParserConfig::GlobalConfig();
+  config.SetDeprecatedElementsPolicy(sdf::EnforcementPolicy::ERR);
+  const std::string version = SDF_VERSION;
+  sdf::Errors errors;
+  EXPECT_TRUE(sdf::readString(
+      "<sdf version='" + version + "'><testElem/></sdf>", config, sdf,
+      errors));
+  ASSERT_FALSE(errors.empty());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_DEPRECATED, errors[0].Code());
+
+  // The elements of the specification are not deprecated.
+  sdf::SDFPtr worldSdf(new sdf::SDF());
+  sdf::init(worldSdf);
+  errors.clear();
+  EXPECT_TRUE(sdf::readString(
+      "<sdf version='" + version + "'><world name='default'/></sdf>",
+      config, worldSdf, errors));
+  EXPECT_TRUE(errors.empty());
+}
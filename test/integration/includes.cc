@@ -18,6 +18,9 @@
 #include <gtest/gtest.h>
 
 #include <ignition/math/Pose3.hh>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <string>
 
@@ -33,6 +36,8 @@
 #include "sdf/Mesh.hh"
 #include "sdf/Model.hh"
 #include "sdf/parser.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/PrintConfig.hh"
 #include "sdf/Root.hh"
 #include "sdf/SDFImpl.hh"
 #include "sdf/Visual.hh"
@@ -582,6 +587,42 @@ TEST(IncludesTest, MergeIncludePlacementFrame)
   EXPECT_EQ(expectedtopLinkPose, topLinkPose);
 }
 
+//////////////////////////////////////////////////
+TEST(IncludesTest, MergeIncludeNestedCanonicalLink)
+{
+  using ignition::math::Pose3d;
+  sdf::ParserConfig config;
+  config.AddURIPath("file://", sdf::testing::TestFile("sdf"));
+
+  const std::string sdfString = R"(
+    <sdf version="1.9">
+      <model name="M">
+        <include merge="true">
+          <uri>file://model_merge_nested_canonical_link.sdf</uri>
+        </include>
+      </model>
+    </sdf>)";
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  const sdf::Model *model = root.Model();
+  ASSERT_NE(nullptr, model);
+  EXPECT_EQ(1u, model->ModelCount());
+  const sdf::Frame *proxyFrame =
+      model->FrameByName("_merged__nested_canonical_link__model__");
+  ASSERT_NE(nullptr, proxyFrame);
+  EXPECT_EQ("inner::L2", proxyFrame->AttachedTo());
+
+  Pose3d pose;
+  EXPECT_TRUE(proxyFrame->SemanticPose().Resolve(pose, "__model__").empty());
+  EXPECT_EQ(Pose3d(1, 0, 0, 0, 0, 0), pose);
+
+  std::string body;
+  EXPECT_TRUE(proxyFrame->ResolveAttachedToBody(body).empty());
+  EXPECT_EQ("inner::L2", body);
+}
+
 //////////////////////////////////////////////////
 TEST(IncludesTest, InvalidMergeInclude)
 {
@@ -710,3 +751,171 @@ TEST(IncludesTest, InvalidMergeInclude)
                 std::string::npos) << buffer.str();
   }
 }
+
+//////////////////////////////////////////////////
+TEST(IncludesTest, IncludesLoadedConcurrently)
+{
+  sdf::ParserConfig serialConfig;
+  serialConfig.SetFindCallback(findFileCb);
+
+  sdf::ParserConfig concurrentConfig = serialConfig;
+  concurrentConfig.SetIncludeLoadThreadCount(4);
+  EXPECT_EQ(4u, concurrentConfig.IncludeLoadThreadCount());
+
+  for (const auto &fileName : {"includes.sdf", "includes_missing_model.sdf",
+                               "includes_missing_uri.sdf"})
+  {
+    const auto worldFile = sdf::testing::TestFile("sdf", fileName);
+
+    sdf::Root serialRoot;
+    sdf::Errors serialErrors = serialRoot.Load(worldFile, serialConfig);
+
+    sdf::Root concurrentRoot;
+    sdf::Errors concurrentErrors =
+        concurrentRoot.Load(worldFile, concurrentConfig);
+
+    // The document and the errors are the same regardless of the order in
+    // which the included files were loaded.
+    ASSERT_EQ(serialErrors.size(), concurrentErrors.size()) << fileName;
+    for (std::size_t i = 0; i < serialErrors.size(); ++i)
+    {
+      EXPECT_EQ(serialErrors[i].Code(), concurrentErrors[i].Code());
+      EXPECT_EQ(serialErrors[i].Message(), concurrentErrors[i].Message());
+      EXPECT_EQ(serialErrors[i].XmlPath(), concurrentErrors[i].XmlPath());
+    }
+
+    ASSERT_NE(nullptr, serialRoot.Element()) << fileName;
+    ASSERT_NE(nullptr, concurrentRoot.Element()) << fileName;
+    EXPECT_EQ(serialRoot.Element()->ToString(""),
+              concurrentRoot.Element()->ToString("")) << fileName;
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(IncludesTest, LoadCached)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  std::filesystem::create_directories(tmpDir);
+
+  sdf::ParserConfig config;
+  config.SetFindCallback(findFileCb);
+
+  sdf::PrintConfig printConfig;
+  printConfig.SetPreserveIncludes(true);
+
+  // A document loaded from the cache is the same as one read from XML.
+  {
+    const auto worldFile = sdf::testing::TestFile("sdf", "includes.sdf");
+    const std::string cacheFile =
+        sdf::filesystem::append(tmpDir, "includes.sdfcache");
+    std::filesystem::remove(cacheFile);
+
+    sdf::Root root;
+    sdf::Errors errors = root.Load(worldFile, config);
+    EXPECT_TRUE(errors.empty()) << errors;
+
+    sdf::Root firstRoot;
+    errors = firstRoot.LoadCached(worldFile, cacheFile, config);
+    EXPECT_TRUE(errors.empty()) << errors;
+    EXPECT_TRUE(std::filesystem::exists(cacheFile));
+
+    sdf::Root cachedRoot;
+    errors = cachedRoot.LoadCached(worldFile, cacheFile, config);
+    EXPECT_TRUE(errors.empty()) << errors;
+
+    ASSERT_NE(nullptr, cachedRoot.Element());
+    EXPECT_EQ(worldFile, cachedRoot.Element()->FilePath());
+    EXPECT_EQ("1.8", cachedRoot.Element()->OriginalVersion());
+    EXPECT_EQ(root.Element()->ToString("", printConfig),
+              cachedRoot.Element()->ToString("", printConfig));
+
+    const sdf::World *world = root.WorldByIndex(0);
+    const sdf::World *cachedWorld = cachedRoot.WorldByIndex(0);
+    ASSERT_NE(nullptr, world);
+    ASSERT_NE(nullptr, cachedWorld);
+    ASSERT_EQ(world->ModelCount(), cachedWorld->ModelCount());
+    for (uint64_t i = 0; i < world->ModelCount(); ++i)
+    {
+      const sdf::Model *model = world->ModelByIndex(i);
+      const sdf::Model *cachedModel = cachedWorld->ModelByIndex(i);
+      EXPECT_EQ(model->Name(), cachedModel->Name());
+      EXPECT_EQ(model->RawPose(), cachedModel->RawPose());
+      EXPECT_EQ(model->Element()->FilePath(),
+                cachedModel->Element()->FilePath());
+      EXPECT_EQ(model->Element()->LineNumber(),
+                cachedModel->Element()->LineNumber());
+      EXPECT_EQ(model->Element()->XmlPath(),
+                cachedModel->Element()->XmlPath());
+      EXPECT_EQ(nullptr != model->Element()->GetIncludeElement(),
+                nullptr != cachedModel->Element()->GetIncludeElement());
+    }
+  }
+
+  // The cache is written again when an included file changes.
+  {
+    const std::string modelFile =
+        sdf::filesystem::append(tmpDir, "load_cached_model.sdf");
+    const std::string worldFile =
+        sdf::filesystem::append(tmpDir, "load_cached_world.sdf");
+    const std::string cacheFile =
+        sdf::filesystem::append(tmpDir, "load_cached_world.sdfcache");
+    std::filesystem::remove(cacheFile);
+
+    auto writeModel = [&modelFile](const std::string &_linkName)
+    {
+      std::ofstream out(modelFile);
+      out << "<sdf version='1.9'><model name='cached'><link name='"
+          << _linkName << "'/></model></sdf>";
+    };
+    {
+      std::ofstream out(worldFile);
+      out << "<sdf version='1.9'><world name='default'>"
+          << "<include><uri>" << modelFile << "</uri></include>"
+          << "</world></sdf>";
+    }
+
+    auto loadLinkName = [&]()
+    {
+      sdf::Root root;
+      sdf::Errors errors = root.LoadCached(worldFile, cacheFile, config);
+      EXPECT_TRUE(errors.empty()) << errors;
+      const sdf::World *world = root.WorldByIndex(0);
+      if (nullptr == world || world->ModelCount() != 1u)
+        return std::string();
+      return world->ModelByIndex(0)->LinkByIndex(0)->Name();
+    };
+
+    writeModel("link1");
+    EXPECT_EQ("link1", loadLinkName());
+    ASSERT_TRUE(std::filesystem::exists(cacheFile));
+
+    // The cache is used, and not written again, while the inputs are
+    // unchanged.
+    const auto cacheTime = std::filesystem::last_write_time(cacheFile) -
+        std::chrono::seconds(10);
+    std::filesystem::last_write_time(cacheFile, cacheTime);
+    EXPECT_EQ("link1", loadLinkName());
+    EXPECT_EQ(cacheTime, std::filesystem::last_write_time(cacheFile));
+
+    writeModel("link2");
+    EXPECT_EQ("link2", loadLinkName());
+    EXPECT_NE(cacheTime, std::filesystem::last_write_time(cacheFile));
+
+    // A corrupted cache is ignored.
+    {
+      std::ofstream out(cacheFile, std::ios::binary | std::ios::trunc);
+      out << "SDFC";
+    }
+    EXPECT_EQ("link2", loadLinkName());
+
+    // The cache is not used for another file name.
+    sdf::Root root;
+    sdf::Errors errors = root.LoadCached(
+        sdf::testing::TestFile("sdf", "empty.sdf"), cacheFile, config);
+    EXPECT_TRUE(errors.empty()) << errors;
+    EXPECT_EQ(1u, root.WorldCount());
+    ASSERT_NE(nullptr, root.WorldByIndex(0));
+    EXPECT_TRUE(root.WorldByIndex(0)->ModelNameExists("ground_plane"));
+  }
+}
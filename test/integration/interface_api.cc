@@ -21,6 +21,7 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -298,6 +299,80 @@ TEST_F(InterfaceAPI, CustomParserPrecedence)
   EXPECT_EQ(customParserCallOrderExpected, customParserCallOrder);
 }
 
+/////////////////////////////////////////////////
+TEST_F(InterfaceAPI, ThreadSafeCustomParsers)
+{
+  const int includeCount = 32;
+  std::string testSdf = R"(
+<sdf version="1.8">
+  <world name="default">)";
+  for (int i = 0; i < includeCount; ++i)
+  {
+    testSdf += "<include><uri>model_" + std::to_string(i) +
+        ".nonce_1</uri></include>";
+  }
+  testSdf += R"(
+  </world>
+</sdf>)";
+
+  std::atomic<int> callCount{0};
+  auto testParser = [&](const sdf::NestedInclude &_include,
+                        sdf::Errors &_errors) -> sdf::InterfaceModelPtr
+  {
+    ++callCount;
+    const std::string name =
+        _include.Uri().substr(0, _include.Uri().find('.'));
+
+    // Every third include is reported as an error
+    if (std::stoi(name.substr(name.find('_') + 1)) % 3 == 0)
+    {
+      _errors.emplace_back(sdf::ErrorCode::URI_INVALID, name);
+      return nullptr;
+    }
+
+    auto model = std::make_shared<sdf::InterfaceModel>(
+        name, nullptr, false, "base_link", ignition::math::Pose3d());
+    model->AddLink({"base_link", {}});
+    return model;
+  };
+
+  this->config.RegisterCustomModelParser(testParser);
+  this->config.SetCustomModelParsersThreadSafe(true);
+  EXPECT_TRUE(this->config.CustomModelParsersThreadSafe());
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(testSdf, this->config);
+  EXPECT_EQ(includeCount, callCount);
+
+  // The models and errors are in document order
+  std::vector<std::string> expectedErrors;
+  std::vector<std::string> expectedModels;
+  for (int i = 0; i < includeCount; ++i)
+  {
+    const std::string name = "model_" + std::to_string(i);
+    if (i % 3 == 0)
+      expectedErrors.push_back(name);
+    else
+      expectedModels.push_back(name);
+  }
+
+  ASSERT_EQ(expectedErrors.size(), errors.size()) << errors;
+  for (std::size_t i = 0; i < errors.size(); ++i)
+  {
+    EXPECT_EQ(sdf::ErrorCode::URI_INVALID, errors[i].Code());
+    EXPECT_EQ(expectedErrors[i], errors[i].Message());
+  }
+
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  ASSERT_EQ(expectedModels.size(), world->InterfaceModelCount());
+  for (std::size_t i = 0; i < expectedModels.size(); ++i)
+  {
+    auto interfaceModel = world->InterfaceModelByIndex(i);
+    ASSERT_NE(nullptr, interfaceModel);
+    EXPECT_EQ(expectedModels[i], interfaceModel->Name());
+  }
+}
+
 /////////////////////////////////////////////////
 void TomlParserTest(const sdf::InterfaceModelConstPtr &_interfaceModel)
 {
@@ -377,6 +452,150 @@ TEST_F(InterfaceAPI, TomlParserWorldInclude)
   TomlParserTest(interfaceModel);
 }
 
+/////////////////////////////////////////////////
+TEST_F(InterfaceAPI, InterfaceModelCache)
+{
+  const std::string testSdf = R"(
+<sdf version="1.8">
+  <world name="default">
+    <include>
+      <uri>double_pendulum.toml</uri>
+      <name>pendulum1</name>
+    </include>
+    <include>
+      <uri>double_pendulum.toml</uri>
+      <name>pendulum2</name>
+      <pose>0 5 0 0 0 0</pose>
+      <static>1</static>
+    </include>
+    <include>
+      <uri>double_pendulum.toml</uri>
+    </include>
+  </world>
+</sdf>)";
+
+  int callCount = 0;
+  this->config.RegisterCustomModelParser(
+      [&](const sdf::NestedInclude &_include, sdf::Errors &_errors)
+      {
+        ++callCount;
+        // The cached model is parsed without the overrides of an include
+        EXPECT_FALSE(_include.LocalModelName().has_value());
+        EXPECT_FALSE(_include.IsStatic().has_value());
+        EXPECT_FALSE(_include.IncludeRawPose().has_value());
+        return this->customTomlParser(_include, _errors);
+      });
+  this->config.SetUseInterfaceModelCache(true);
+
+  for (int i = 0; i < 2; ++i)
+  {
+    sdf::Root root;
+    sdf::Errors errors = root.LoadSdfString(testSdf, this->config);
+    EXPECT_TRUE(errors.empty()) << errors;
+    const sdf::World *world = root.WorldByIndex(0);
+    ASSERT_NE(nullptr, world);
+    ASSERT_EQ(3u, world->InterfaceModelCount());
+
+    // The file is parsed once for all the includes and loads
+    EXPECT_EQ(1, callCount);
+
+    auto pendulum1 = world->InterfaceModelByIndex(0);
+    auto pendulum2 = world->InterfaceModelByIndex(1);
+    auto pendulum3 = world->InterfaceModelByIndex(2);
+    ASSERT_NE(nullptr, pendulum1);
+    ASSERT_NE(nullptr, pendulum2);
+    ASSERT_NE(nullptr, pendulum3);
+    EXPECT_EQ("pendulum1", pendulum1->Name());
+    EXPECT_FALSE(pendulum1->Static());
+    EXPECT_EQ("pendulum2", pendulum2->Name());
+    EXPECT_TRUE(pendulum2->Static());
+    EXPECT_EQ("double_pendulum", pendulum3->Name());
+    EXPECT_EQ(pendulum1->Links().size(), pendulum2->Links().size());
+    EXPECT_EQ(pendulum1->NestedModels(), pendulum2->NestedModels());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(InterfaceAPI, LazyChildren)
+{
+  const std::string testSdf = R"(
+<sdf version="1.8">
+  <world name="default">
+    <include>
+      <uri>file_wont_be_parsed.nonce_1</uri>
+      <name>far</name>
+    </include>
+    <include>
+      <uri>file_wont_be_parsed.nonce_1</uri>
+      <name>near</name>
+      <pose>0 5 0 0 0 0</pose>
+    </include>
+    <frame name="F" attached_to="near::arm"/>
+  </world>
+</sdf>)";
+
+  int loadCount = 0;
+  this->config.RegisterCustomModelParser(
+      [&](const sdf::NestedInclude &_include, sdf::Errors &)
+      {
+        auto model = std::make_shared<sdf::InterfaceModel>(
+            _include.LocalModelName().value_or("lazy"), nullptr, false,
+            "base_link", ignition::math::Pose3d());
+        model->AddLink({"base_link", {}});
+        model->SetChildrenFunction([&](sdf::InterfaceModel &_model)
+            {
+              ++loadCount;
+              _model.AddLink({"arm", ignition::math::Pose3d(0, 0, 1, 0, 0, 0)});
+              _model.AddJoint({"joint", "arm", {}});
+            });
+        return model;
+      });
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(testSdf, this->config);
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  ASSERT_EQ(2u, world->InterfaceModelCount());
+
+  // Only the model referenced by the frame is loaded
+  auto farModel = world->InterfaceModelByIndex(0);
+  auto nearModel = world->InterfaceModelByIndex(1);
+  ASSERT_NE(nullptr, farModel);
+  ASSERT_NE(nullptr, nearModel);
+  EXPECT_FALSE(farModel->ChildrenLoaded());
+  EXPECT_TRUE(nearModel->ChildrenLoaded());
+  EXPECT_EQ(1, loadCount);
+
+  const sdf::Frame *frame = world->FrameByName("F");
+  ASSERT_NE(nullptr, frame);
+  ignition::math::Pose3d pose;
+  errors = frame->SemanticPose().Resolve(pose, "near");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(ignition::math::Pose3d(0, 0, 1, 0, 0, 0), pose);
+
+  // The children of the other model are loaded once, on first access
+  EXPECT_EQ(2u, farModel->Links().size());
+  EXPECT_EQ(1u, farModel->Joints().size());
+  EXPECT_EQ(2u, farModel->Links().size());
+  EXPECT_TRUE(farModel->ChildrenLoaded());
+  EXPECT_EQ(2, loadCount);
+
+  // A copy of a model that is not loaded loads its children on its own
+  sdf::InterfaceModel lazy("lazy", nullptr, false, "base_link");
+  lazy.AddLink({"base_link", {}});
+  lazy.SetChildrenFunction([&](sdf::InterfaceModel &_model)
+      {
+        ++loadCount;
+        _model.AddLink({"arm", {}});
+      });
+  sdf::InterfaceModel copy = lazy;
+  EXPECT_EQ(2u, copy.Links().size());
+  EXPECT_FALSE(lazy.ChildrenLoaded());
+  EXPECT_EQ(2u, lazy.Links().size());
+  EXPECT_EQ(4, loadCount);
+}
+
 /////////////////////////////////////////////////
 TEST_F(InterfaceAPI, TomlParserModelInclude)
 {
@@ -619,12 +838,28 @@ TEST_F(InterfaceAPI, Reposturing)
       auto modelIt = models.find(modelName);
       if (modelIt != models.end())
       {
+        // The poses resolved in one traversal are the ones resolved frame
+        // by frame.
+        std::unordered_map<std::string, Pose3d> allPoses;
+        sdf::Errors allErrors = _graph.ResolveAllNestedFramePoses(allPoses);
+        EXPECT_TRUE(allErrors.empty()) << allErrors;
+        EXPECT_EQ(posesAfterReposture[modelName], allPoses["__model__"]);
+
         for (const auto &link : modelIt->second->Links())
         {
           ignition::math::Pose3d pose;
           sdf::Errors errors = _graph.ResolveNestedFramePose(pose, link.Name());
           EXPECT_TRUE(errors.empty()) << errors;
           posesAfterReposture[sdf::JoinName(modelName, link.Name())] = pose;
+          EXPECT_EQ(pose, allPoses[link.Name()]) << link.Name();
+        }
+        for (const auto &nested : modelIt->second->NestedModels())
+        {
+          ignition::math::Pose3d pose;
+          sdf::Errors errors =
+              _graph.ResolveNestedFramePose(pose, nested->Name());
+          EXPECT_TRUE(errors.empty()) << errors;
+          EXPECT_EQ(pose, allPoses[nested->Name()]) << nested->Name();
         }
       }
     };
@@ -15,18 +15,28 @@
  *
  */
 
+#include <cmath>
 #include <string>
+#include <vector>
 #include <gtest/gtest.h>
 
+#include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/Pose3.hh>
+#include "sdf/Collision.hh"
 #include "sdf/Element.hh"
 #include "sdf/Error.hh"
 #include "sdf/Filesystem.hh"
 #include "sdf/Frame.hh"
+#include "sdf/Geometry.hh"
+#include "sdf/Joint.hh"
+#include "sdf/KinematicTree.hh"
 #include "sdf/Link.hh"
+#include "sdf/Mesh.hh"
 #include "sdf/Model.hh"
 #include "sdf/Root.hh"
+#include "sdf/Sensor.hh"
 #include "sdf/Types.hh"
+#include "sdf/Visual.hh"
 #include "sdf/World.hh"
 #include "test_config.h"
 #include "test_utils.hh"
@@ -751,3 +761,413 @@ TEST(DOMModel, IncludeModelWithPlugin)
     ASSERT_EQ(nullptr, pluginElem->GetNextElement("plugin"));
   }
 }
+
+/////////////////////////////////////////////////
+TEST(DOMModel, ResolveAllPoses)
+{
+  const std::string sdfString = R"(
+    <sdf version="1.9">
+      <world name="default">
+        <model name="M">
+          <pose>1 0 0 0 0 0</pose>
+          <link name="L1">
+            <pose>0 1 0 0 0 1.5707963</pose>
+            <collision name="C">
+              <pose>0 0 1 0 0 0</pose>
+              <geometry><sphere><radius>1</radius></sphere></geometry>
+            </collision>
+            <visual name="V">
+              <pose relative_to="F">0 0 2 0 0 0</pose>
+              <geometry><sphere><radius>1</radius></sphere></geometry>
+            </visual>
+            <sensor name="S" type="imu">
+              <pose>0 0 3 0 0 0</pose>
+            </sensor>
+          </link>
+          <link name="L2">
+            <pose relative_to="L1">1 0 0 0 0 0</pose>
+          </link>
+          <joint name="J" type="revolute">
+            <pose>0 0 1 0 0 0</pose>
+            <parent>L1</parent>
+            <child>L2</child>
+            <axis><xyz>0 0 1</xyz></axis>
+          </joint>
+          <frame name="F" attached_to="L2">
+            <pose relative_to="L2">0 2 0 0 0 0</pose>
+          </frame>
+          <model name="N">
+            <pose relative_to="L2">0 0 1 0 0 0</pose>
+            <link name="L3">
+              <pose>1 1 1 0 0 0</pose>
+            </link>
+          </model>
+        </model>
+      </world>
+    </sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString);
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::Model *model = root.WorldByIndex(0)->ModelByIndex(0);
+  ASSERT_NE(nullptr, model);
+  const sdf::Link *link1 = model->LinkByName("L1");
+  const sdf::Link *link2 = model->LinkByName("L2");
+  const sdf::Model *nested = model->ModelByName("N");
+  ASSERT_NE(nullptr, link1);
+  ASSERT_NE(nullptr, link2);
+  ASSERT_NE(nullptr, nested);
+
+  for (const std::string resolveTo : {"", "__model__", "L2", "N::L3"})
+  {
+    std::vector<ignition::math::Pose3d> poses;
+    errors = model->ResolveAllPoses(poses, resolveTo);
+    EXPECT_TRUE(errors.empty()) << errors;
+
+    std::vector<sdf::SemanticPose> semanticPoses = {
+      link1->SemanticPose(),
+      link1->CollisionByIndex(0)->SemanticPose(),
+      link1->VisualByIndex(0)->SemanticPose(),
+      link1->SensorByIndex(0)->SemanticPose(),
+      link2->SemanticPose(),
+      model->JointByIndex(0)->SemanticPose(),
+      model->FrameByIndex(0)->SemanticPose(),
+      nested->LinkByIndex(0)->SemanticPose()};
+    std::vector<std::size_t> indices = {1, 2, 3, 4, 5, 6, 7, 9};
+
+    ASSERT_EQ(10u, poses.size());
+    for (std::size_t i = 0; i < semanticPoses.size(); ++i)
+    {
+      ignition::math::Pose3d expected;
+      errors = semanticPoses[i].Resolve(expected,
+          resolveTo.empty() ? "__model__" : resolveTo);
+      EXPECT_TRUE(errors.empty()) << errors;
+      EXPECT_EQ(expected, poses[indices[i]]) << resolveTo << " " << i;
+    }
+  }
+
+  // Relative to the model frame, the model itself is at the origin and the
+  // nested model is at its resolved pose.
+  std::vector<ignition::math::Pose3d> poses;
+  EXPECT_TRUE(model->ResolveAllPoses(poses).empty());
+  ASSERT_EQ(10u, poses.size());
+  EXPECT_EQ(ignition::math::Pose3d::Zero, poses[0]);
+  ignition::math::Pose3d nestedPose;
+  EXPECT_TRUE(nested->SemanticPose().Resolve(nestedPose, "__model__").empty());
+  EXPECT_EQ(nestedPose, poses[8]);
+
+  errors = model->ResolveAllPoses(poses, "missing");
+  EXPECT_FALSE(errors.empty());
+  EXPECT_TRUE(poses.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMModel, ResolveCompositeInertial)
+{
+  const std::string sdfString = R"(
+    <sdf version="1.9">
+      <world name="default">
+        <model name="M">
+          <pose>1 0 0 0 0 0</pose>
+          <link name="L1">
+            <inertial>
+              <mass>2</mass>
+              <inertia><ixx>1</ixx><iyy>1</iyy><izz>1</izz></inertia>
+            </inertial>
+          </link>
+          <link name="L2">
+            <pose>2 0 0 0 0 1.5707963267948966</pose>
+            <inertial>
+              <mass>2</mass>
+              <inertia><ixx>1</ixx><iyy>1</iyy><izz>1</izz></inertia>
+            </inertial>
+          </link>
+          <link name="L3">
+            <pose>0 0 5 0 0 0</pose>
+          </link>
+          <joint name="J1" type="fixed">
+            <parent>L1</parent>
+            <child>L2</child>
+          </joint>
+          <joint name="J2" type="fixed">
+            <parent>L2</parent>
+            <child>N::L4</child>
+          </joint>
+          <joint name="J3" type="revolute">
+            <parent>L2</parent>
+            <child>L3</child>
+            <axis><xyz>0 0 1</xyz></axis>
+          </joint>
+          <joint name="J4" type="fixed">
+            <parent>world</parent>
+            <child>L1</child>
+          </joint>
+          <model name="N">
+            <pose>1 0 0 0 0 0</pose>
+            <link name="L4">
+              <inertial>
+                <mass>4</mass>
+                <inertia><ixx>1</ixx><iyy>1</iyy><izz>1</izz></inertia>
+              </inertial>
+            </link>
+          </model>
+        </model>
+      </world>
+    </sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString);
+  EXPECT_TRUE(errors.empty()) << errors;
+  sdf::Model *model = root.WorldByIndex(0)->ModelByIndex(0);
+  ASSERT_NE(nullptr, model);
+
+  // L1, L2 and N::L4 are welded, whichever of them the group is found from,
+  // while L3 is on a revolute joint
+  for (const std::string link : {"L1", "L2", "N::L4"})
+  {
+    ignition::math::Inertiald inertial;
+    errors = model->ResolveCompositeInertial(inertial, link);
+    EXPECT_TRUE(errors.empty()) << errors;
+    EXPECT_DOUBLE_EQ(8.0, inertial.MassMatrix().Mass()) << link;
+    EXPECT_EQ(ignition::math::Vector3d(1, 0, 0), inertial.Pose().Pos());
+    EXPECT_EQ(ignition::math::Vector3d(3, 7, 7),
+              inertial.MassMatrix().DiagonalMoments());
+    EXPECT_EQ(ignition::math::Vector3d::Zero,
+              inertial.MassMatrix().OffDiagonalMoments());
+  }
+
+  ignition::math::Inertiald inertial;
+  errors = model->ResolveCompositeInertial(inertial, "L3");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_DOUBLE_EQ(1.0, inertial.MassMatrix().Mass());
+  EXPECT_EQ(ignition::math::Vector3d(0, 0, 5), inertial.Pose().Pos());
+
+  // Relative to the rotated L2, the moments are expressed in its axes
+  errors = model->ResolveCompositeInertial(inertial, "L1", "L2");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(ignition::math::Vector3d(0, 1, 0), inertial.Pose().Pos());
+  EXPECT_EQ(ignition::math::Vector3d(7, 3, 7),
+            inertial.MassMatrix().DiagonalMoments());
+
+  // The welded links are cached, but their inertials are read on each call
+  ignition::math::Inertiald heavier = model->LinkByName("L1")->Inertial();
+  ignition::math::MassMatrix3d massMatrix = heavier.MassMatrix();
+  massMatrix.SetMass(6);
+  heavier.SetMassMatrix(massMatrix);
+  ASSERT_TRUE(model->LinkByName("L1")->SetInertial(heavier));
+  errors = model->ResolveCompositeInertial(inertial, "L2");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_DOUBLE_EQ(12.0, inertial.MassMatrix().Mass());
+
+  errors = model->ResolveCompositeInertial(inertial, "missing");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_MISSING, errors[0].Code());
+  errors = model->ResolveCompositeInertial(inertial, "L1", "missing");
+  EXPECT_FALSE(errors.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMModel, ResolveKinematicTree)
+{
+  const std::string sdfString = R"(
+    <sdf version="1.9">
+      <world name="default">
+        <model name="M">
+          <pose>1 0 0 0 0 0</pose>
+          <link name="L2">
+            <pose>2 0 0 0 0 0</pose>
+          </link>
+          <link name="L1">
+            <pose>1 0 0 0 0 0</pose>
+          </link>
+          <link name="base"/>
+          <link name="L3">
+            <pose>0 1 0 0 0 0</pose>
+          </link>
+          <joint name="J_b" type="revolute">
+            <pose relative_to="L2">0 0 1 0 0 0</pose>
+            <parent>L1</parent>
+            <child>L2</child>
+            <axis><xyz>0 0 1</xyz></axis>
+          </joint>
+          <joint name="J_a" type="revolute">
+            <parent>base</parent>
+            <child>L1</child>
+            <axis><xyz>0 0 1</xyz></axis>
+          </joint>
+          <joint name="J_c" type="fixed">
+            <parent>base</parent>
+            <child>L3</child>
+          </joint>
+          <joint name="J_w" type="fixed">
+            <parent>world</parent>
+            <child>base</child>
+          </joint>
+          <joint name="J_n" type="fixed">
+            <parent>base</parent>
+            <child>N::L4</child>
+          </joint>
+          <model name="N">
+            <link name="L4"/>
+          </model>
+        </model>
+        <model name="Loop">
+          <link name="A"/>
+          <link name="B"/>
+          <link name="C"/>
+          <joint name="AC" type="fixed">
+            <parent>A</parent>
+            <child>C</child>
+          </joint>
+          <joint name="BC" type="fixed">
+            <parent>B</parent>
+            <child>C</child>
+          </joint>
+        </model>
+      </world>
+    </sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString);
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::Model *model = root.WorldByIndex(0)->ModelByName("M");
+  ASSERT_NE(nullptr, model);
+
+  // Resolving the tree again returns the cached tree.
+  for (int i = 0; i < 2; ++i)
+  {
+    sdf::KinematicTree tree;
+    errors = model->ResolveKinematicTree(tree);
+    EXPECT_TRUE(errors.empty()) << errors;
+
+    // Parents come before their children, and the joint to the nested
+    // model is not part of the tree.
+    const uint64_t none = sdf::KinematicTree::kNoIndex;
+    EXPECT_EQ((std::vector<uint64_t>{2, 1, 3, 0}), tree.links);
+    EXPECT_EQ((std::vector<uint64_t>{none, 0, 0, 1}), tree.parents);
+    EXPECT_EQ((std::vector<uint64_t>{3, 1, 2, 0}), tree.joints);
+
+    using ignition::math::Pose3d;
+    EXPECT_EQ((std::vector<Pose3d>{Pose3d::Zero, Pose3d(1, 0, 0, 0, 0, 0),
+                Pose3d(0, 1, 0, 0, 0, 0), Pose3d(1, 0, 1, 0, 0, 0)}),
+              tree.jointPoses);
+    EXPECT_EQ((std::vector<Pose3d>{Pose3d::Zero, Pose3d::Zero, Pose3d::Zero,
+                Pose3d(0, 0, -1, 0, 0, 0)}),
+              tree.linkPoses);
+  }
+
+  // A link with two parent joints is reported.
+  const sdf::Model *loop = root.WorldByIndex(0)->ModelByName("Loop");
+  ASSERT_NE(nullptr, loop);
+  sdf::KinematicTree tree;
+  errors = loop->ResolveKinematicTree(tree);
+  ASSERT_EQ(1u, errors.size()) << errors;
+  EXPECT_EQ(sdf::ErrorCode::KINEMATIC_TREE_INVALID, errors[0].Code());
+  EXPECT_TRUE(tree.links.empty());
+
+  // Models without graphs have no tree.
+  sdf::Model standalone;
+  errors = standalone.ResolveKinematicTree(tree);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR, errors[0].Code());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMModel, ResolveBounds)
+{
+  const std::string sdfString = R"(
+    <sdf version="1.9">
+      <world name="default">
+        <model name="M">
+          <pose>10 0 0 0 0 0</pose>
+          <link name="L">
+            <pose>1 0 0 0 0 0</pose>
+            <collision name="box">
+              <pose>0 0 1 0 0 0</pose>
+              <geometry><box><size>2 2 2</size></box></geometry>
+            </collision>
+            <collision name="cylinder">
+              <pose>0 0 0 0 1.5707963267948966 0</pose>
+              <geometry>
+                <cylinder><radius>0.5</radius><length>4</length></cylinder>
+              </geometry>
+            </collision>
+          </link>
+          <model name="N">
+            <pose>0 5 0 0 0 0</pose>
+            <link name="L">
+              <collision name="sphere">
+                <geometry><sphere><radius>1</radius></sphere></geometry>
+              </collision>
+            </link>
+          </model>
+        </model>
+        <model name="Mesh">
+          <link name="L">
+            <collision name="mesh">
+              <pose>0 0 1 0 0 0</pose>
+              <geometry><mesh><uri>mesh.dae</uri></mesh></geometry>
+            </collision>
+          </link>
+        </model>
+      </world>
+    </sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString);
+  EXPECT_TRUE(errors.empty()) << errors;
+  sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  const sdf::Model *model = world->ModelByName("M");
+  ASSERT_NE(nullptr, model);
+
+  using ignition::math::Vector3d;
+  ignition::math::AxisAlignedBox bounds;
+  errors = model->LinkByName("L")->ResolveCollisionBounds(bounds);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_TRUE(bounds.Min().Equal(Vector3d(-2, -1, -0.5), 1e-9))
+      << bounds.Min();
+  EXPECT_TRUE(bounds.Max().Equal(Vector3d(2, 1, 2), 1e-9)) << bounds.Max();
+
+  // Resolving the bounds again uses the cached collision poses.
+  for (int i = 0; i < 2; ++i)
+  {
+    errors = model->ResolveBounds(bounds);
+    EXPECT_TRUE(errors.empty()) << errors;
+    EXPECT_TRUE(bounds.Min().Equal(Vector3d(-1, -1, -1), 1e-9))
+        << bounds.Min();
+    EXPECT_TRUE(bounds.Max().Equal(Vector3d(3, 6, 2), 1e-9))
+        << bounds.Max();
+  }
+
+  // Meshes are unbounded until their extents are given, and the shapes are
+  // read again with the cached poses.
+  sdf::Model *meshModel = world->ModelByName("Mesh");
+  ASSERT_NE(nullptr, meshModel);
+  errors = meshModel->ResolveBounds(bounds);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_TRUE(std::isinf(bounds.Min().X()));
+  EXPECT_TRUE(std::isinf(bounds.Max().Z()));
+
+  sdf::Collision *collision =
+      meshModel->LinkByName("L")->CollisionByName("mesh");
+  ASSERT_NE(nullptr, collision);
+  sdf::Geometry geom = *collision->Geom();
+  sdf::Mesh mesh = *geom.MeshShape();
+  mesh.SetExtents(ignition::math::AxisAlignedBox(
+      Vector3d(-1, -1, -1), Vector3d(1, 1, 1)));
+  mesh.SetScale(Vector3d(2, 1, 1));
+  geom.SetMeshShape(mesh);
+  collision->SetGeom(geom);
+  errors = meshModel->ResolveBounds(bounds);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(Vector3d(-2, -1, 0), bounds.Min());
+  EXPECT_EQ(Vector3d(2, 1, 2), bounds.Max());
+
+  // Models without graphs have no bounds.
+  sdf::Model empty;
+  errors = empty.ResolveBounds(bounds);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR, errors[0].Code());
+  EXPECT_GT(bounds.Min().X(), bounds.Max().X());
+}
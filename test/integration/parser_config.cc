@@ -17,11 +17,28 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+
+#include "sdf/Error.hh"
 #include "sdf/Filesystem.hh"
+#include "sdf/Frame.hh"
+#include "sdf/Link.hh"
+#include "sdf/LoadProfile.hh"
+#include "sdf/LoadTrace.hh"
 #include "sdf/Model.hh"
 #include "sdf/ParserConfig.hh"
 #include "sdf/Root.hh"
 #include "sdf/SDFImpl.hh"
+#include "sdf/Sensor.hh"
 #include "sdf/World.hh"
 #include "sdf/parser.hh"
 
@@ -258,3 +275,605 @@ TEST(ParserConfig, NestedModelIncludesFilePath)
   sdf::Errors errors = root.Load(path, config);
   EXPECT_TRUE(errors.empty()) << errors;
 }
+
+/////////////////////////////////////////////////
+/// Test recording the phases of loading a document in a profile
+TEST(ParserConfig, Profile)
+{
+  const auto path =
+      sdf::testing::TestFile("integration", "model", "top_nested", "model.sdf");
+
+  auto findFileCb = [](const std::string &_uri)
+  {
+    return sdf::testing::TestFile("integration", "model", _uri);
+  };
+  sdf::ParserConfig config;
+  config.SetFindCallback(findFileCb);
+  auto profile = std::make_shared<sdf::LoadProfile>();
+  config.SetProfile(profile);
+  EXPECT_EQ(profile, config.Profile());
+
+  {
+    sdf::Root root;
+    sdf::Errors errors = root.Load(path, config);
+    EXPECT_TRUE(errors.empty()) << errors;
+  }
+
+  // The top-level file, sub_nested and simple_model twice.
+  EXPECT_EQ(4u, profile->Count(sdf::LoadPhase::XML_PARSE));
+  EXPECT_EQ(4u, profile->Count(sdf::LoadPhase::READ_XML));
+  EXPECT_EQ(3u, profile->Count(sdf::LoadPhase::INCLUDE));
+  EXPECT_EQ(0u, profile->Count(sdf::LoadPhase::CONVERSION));
+  EXPECT_EQ(0u, profile->Count(sdf::LoadPhase::URDF_CONVERSION));
+  EXPECT_EQ(0u, profile->Count(sdf::LoadPhase::PARAM_PASSING));
+  EXPECT_EQ(1u, profile->Count(sdf::LoadPhase::DOM_LOAD));
+  EXPECT_EQ(2u, profile->Count(sdf::LoadPhase::GRAPH_BUILD));
+  EXPECT_LT(0u, profile->Count(sdf::LoadPhase::VALIDATION));
+  EXPECT_LT(0, profile->Duration(sdf::LoadPhase::READ_XML).count());
+  EXPECT_LT(0, profile->Duration(sdf::LoadPhase::DOM_LOAD).count());
+
+  const std::vector<std::string> files = profile->IncludedFiles();
+  ASSERT_EQ(2u, files.size());
+  for (const auto &file : files)
+  {
+    const std::string modelName =
+        std::filesystem::path(file).parent_path().filename().string();
+    EXPECT_EQ(modelName == "simple_model" ? 2u : 1u,
+              profile->IncludeCount(file)) << file;
+    EXPECT_LT(0, profile->IncludeDuration(file).count()) << file;
+  }
+  EXPECT_EQ(0u, profile->IncludeCount(path));
+
+  // Documents of older versions are converted, and profiles accumulate
+  // until they are reset.
+  profile->Reset();
+  EXPECT_EQ(0u, profile->Count(sdf::LoadPhase::XML_PARSE));
+  EXPECT_TRUE(profile->IncludedFiles().empty());
+  {
+    sdf::Root root;
+    sdf::Errors errors = root.LoadSdfString(
+        "<sdf version='1.6'><model name='m'><link name='l'/></model></sdf>",
+        config);
+    EXPECT_TRUE(errors.empty()) << errors;
+    errors = root.LoadSdfString(
+        "<sdf version='1.6'><model name='m'><link name='l'/></model></sdf>",
+        config);
+    EXPECT_TRUE(errors.empty()) << errors;
+  }
+  EXPECT_EQ(2u, profile->Count(sdf::LoadPhase::XML_PARSE));
+  EXPECT_EQ(2u, profile->Count(sdf::LoadPhase::CONVERSION));
+  EXPECT_EQ(2u, profile->Count(sdf::LoadPhase::DOM_LOAD));
+  EXPECT_TRUE(profile->IncludedFiles().empty());
+
+  // Nothing is recorded once the profile is unset.
+  profile->Reset();
+  config.SetProfile(nullptr);
+  {
+    sdf::Root root;
+    sdf::Errors errors = root.Load(path, config);
+    EXPECT_TRUE(errors.empty()) << errors;
+  }
+  EXPECT_EQ(0u, profile->Count(sdf::LoadPhase::XML_PARSE));
+  EXPECT_EQ(0u, profile->Count(sdf::LoadPhase::DOM_LOAD));
+}
+
+/////////////////////////////////////////////////
+TEST(ParserConfig, Trace)
+{
+  const auto path =
+      sdf::testing::TestFile("integration", "model", "top_nested", "model.sdf");
+
+  auto findFileCb = [](const std::string &_uri)
+  {
+    return sdf::testing::TestFile("integration", "model", _uri);
+  };
+  sdf::ParserConfig config;
+  config.SetFindCallback(findFileCb);
+  auto trace = std::make_shared<sdf::LoadTrace>();
+  config.SetTrace(trace);
+  EXPECT_EQ(trace, config.Trace());
+
+  {
+    sdf::Root root;
+    sdf::Errors errors = root.Load(path, config);
+    EXPECT_TRUE(errors.empty()) << errors;
+  }
+
+  EXPECT_LE(1u, trace->EventCount("readFile"));
+  EXPECT_EQ(3u, trace->EventCount("include"));
+  EXPECT_EQ(1u, trace->EventCount("Root::Load"));
+  EXPECT_LE(1u, trace->EventCount("Model::Load"));
+  EXPECT_LE(1u, trace->EventCount("Link::Load"));
+  EXPECT_LE(1u, trace->EventCount("buildFrameAttachedToGraph"));
+  EXPECT_LE(1u, trace->EventCount("validatePoseRelativeToGraph"));
+  EXPECT_EQ(0u, trace->EventCount("Converter::Convert"));
+
+  std::ostringstream json;
+  trace->WriteJson(json);
+  EXPECT_EQ(0u, json.str().find("{\"traceEvents\":["));
+  EXPECT_NE(std::string::npos,
+            json.str().find("\"name\":\"include\",\"cat\":\"parser\""));
+  EXPECT_NE(std::string::npos, json.str().find("simple_model"));
+
+  // Documents of older versions are converted.
+  trace->Reset();
+  {
+    sdf::Root root;
+    sdf::Errors errors = root.LoadSdfString(
+        "<sdf version='1.6'><model name='m'><link name='l'/></model></sdf>",
+        config);
+    EXPECT_TRUE(errors.empty()) << errors;
+  }
+  EXPECT_EQ(1u, trace->EventCount("readString"));
+  EXPECT_LE(1u, trace->EventCount("Converter::Convert"));
+  EXPECT_EQ(0u, trace->EventCount("include"));
+
+  // Nothing is recorded once the trace is unset.
+  trace->Reset();
+  config.SetTrace(nullptr);
+  {
+    sdf::Root root;
+    sdf::Errors errors = root.Load(path, config);
+    EXPECT_TRUE(errors.empty()) << errors;
+  }
+  EXPECT_EQ(0u, trace->EventCount());
+}
+
+/////////////////////////////////////////////////
+/// Test loading files concurrently, each with its own parser configuration
+TEST(ParserConfig, ConcurrentRootLoad)
+{
+  const auto path =
+      sdf::testing::TestFile("integration", "model", "top_nested", "model.sdf");
+
+  const std::size_t threadCount = 8;
+  std::vector<sdf::Errors> errors(threadCount);
+  std::vector<std::string> modelNames(threadCount);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < threadCount; ++i)
+  {
+    threads.emplace_back([&, i]()
+    {
+      sdf::ParserConfig config;
+      config.SetFindCallback([](const std::string &_uri)
+      {
+        return sdf::testing::TestFile("integration", "model", _uri);
+      });
+
+      sdf::Root root;
+      errors[i] = root.Load(path, config);
+      if (root.Model())
+      {
+        modelNames[i] = root.Model()->Name();
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  for (std::size_t i = 0; i < threadCount; ++i)
+  {
+    EXPECT_TRUE(errors[i].empty()) << errors[i];
+    EXPECT_EQ("top_nested", modelNames[i]);
+  }
+}
+
+/////////////////////////////////////////////////
+/// Test that included files are cached and invalidated when modified
+TEST(ParserConfig, IncludeCache)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string modelDir = sdf::filesystem::append(tmpDir, "include_cache");
+  std::filesystem::create_directories(modelDir);
+  const std::string modelFile = sdf::filesystem::append(modelDir, "model.sdf");
+
+  auto writeModel = [&modelFile](const std::string &_linkName)
+  {
+    std::ofstream out(modelFile);
+    out << "<sdf version='1.9'><model name='cached'><link name='" << _linkName
+        << "'/></model></sdf>";
+  };
+
+  const std::string worldString =
+      "<sdf version='1.9'><world name='default'>"
+      "<include><uri>" + modelFile + "</uri><name>first</name></include>"
+      "<include><uri>" + modelFile + "</uri><name>second</name></include>"
+      "</world></sdf>";
+
+  sdf::ParserConfig config;
+  config.SetUseIncludeCache(true);
+  EXPECT_TRUE(config.UseIncludeCache());
+
+  auto loadLinkNames = [&]()
+  {
+    sdf::Root root;
+    sdf::Errors errors = root.LoadSdfString(worldString, config);
+    EXPECT_TRUE(errors.empty()) << errors;
+    std::vector<std::string> names;
+    const sdf::World *world = root.WorldByIndex(0);
+    if (nullptr != world)
+    {
+      for (uint64_t i = 0; i < world->ModelCount(); ++i)
+      {
+        const sdf::Model *model = world->ModelByIndex(i);
+        // Overrides are applied to every copy of the cached model.
+        names.push_back(model->Name() + "::" + model->LinkByIndex(0)->Name());
+      }
+    }
+    return names;
+  };
+
+  writeModel("link1");
+  const auto writeTime = std::filesystem::last_write_time(modelFile);
+  std::vector<std::string> expected{"first::link1", "second::link1"};
+  EXPECT_EQ(expected, loadLinkNames());
+
+  // The cached file is used as long as its modification time is unchanged.
+  writeModel("link2");
+  std::filesystem::last_write_time(modelFile, writeTime);
+  EXPECT_EQ(expected, loadLinkNames());
+
+  // The file is read again once it is modified.
+  std::filesystem::last_write_time(modelFile,
+      writeTime + std::chrono::seconds(1));
+  expected = {"first::link2", "second::link2"};
+  EXPECT_EQ(expected, loadLinkNames());
+
+  // Clearing the cache also makes the file be read again.
+  writeModel("link3");
+  std::filesystem::last_write_time(modelFile,
+      writeTime + std::chrono::seconds(1));
+  config.ClearIncludeCache();
+  expected = {"first::link3", "second::link3"};
+  EXPECT_EQ(expected, loadLinkNames());
+
+  // Without the cache, the file is always read.
+  config.SetUseIncludeCache(false);
+  EXPECT_FALSE(config.UseIncludeCache());
+  writeModel("link4");
+  std::filesystem::last_write_time(modelFile,
+      writeTime + std::chrono::seconds(1));
+  expected = {"first::link4", "second::link4"};
+  EXPECT_EQ(expected, loadLinkNames());
+}
+
+/////////////////////////////////////////////////
+/// Test converting values when they are first used
+TEST(ParserConfig, LazyParamParsing)
+{
+  const std::string sdfString =
+      "<sdf version='1.9'><model name='lazy'>"
+      "<pose>1 2 3 0 0 0</pose>"
+      "<link name='link'><inertial><mass>not_a_number</mass></inertial>"
+      "</link></model></sdf>";
+
+  // Invalid values are parsing errors by default.
+  {
+    sdf::ParserConfig config;
+    EXPECT_FALSE(config.LazyParamParsing());
+    sdf::SDFPtr sdf(new sdf::SDF());
+    sdf::init(sdf);
+    sdf::Errors errors;
+    EXPECT_FALSE(sdf::readString(sdfString, config, sdf, errors));
+    EXPECT_FALSE(errors.empty());
+  }
+
+  sdf::ParserConfig config;
+  config.SetLazyParamParsing(true);
+  EXPECT_TRUE(config.LazyParamParsing());
+
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf);
+  sdf::Errors errors;
+  EXPECT_TRUE(sdf::readString(sdfString, config, sdf, errors));
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  sdf::ElementPtr modelElem = sdf->Root()->GetElement("model");
+  ASSERT_NE(nullptr, modelElem);
+  EXPECT_EQ("lazy", modelElem->Get<std::string>("name"));
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0),
+            modelElem->Get<ignition::math::Pose3d>("pose"));
+
+  // The invalid value is reported when it is used, and the default value is
+  // used instead.
+  sdf::ElementPtr massElem =
+      modelElem->GetElement("link")->GetElement("inertial")->GetElement("mass");
+  ASSERT_NE(nullptr, massElem);
+  double mass = 0.0;
+  EXPECT_FALSE(massElem->GetValue()->Get<double>(mass));
+  EXPECT_FALSE(massElem->GetValue()->GetSet());
+  EXPECT_TRUE(massElem->GetValue()->Get<double>(mass));
+  EXPECT_DOUBLE_EQ(1.0, mass);
+}
+
+/////////////////////////////////////////////////
+/// Test skipping validation of trusted documents
+TEST(ParserConfig, ValidationLevel)
+{
+  const std::string sdfString =
+      "<sdf version='1.9'><model name='trusted'>"
+      "<pose>1 2 3 0 0 0</pose>"
+      "<link name='link'>"
+      "<pose>0 0 1 0 0 0</pose>"
+      "<sensor name='camera' type='camera'><camera>"
+      "<horizontal_fov>7.0</horizontal_fov>"
+      "</camera></sensor></link>"
+      "<joint name='joint' type='fixed'>"
+      "<parent>link</parent><child>link</child></joint>"
+      "</model></sdf>";
+
+  auto hasErrorCode = [](const sdf::Errors &_errors, sdf::ErrorCode _code)
+  {
+    for (const auto &error : _errors)
+    {
+      if (error.Code() == _code)
+        return true;
+    }
+    return false;
+  };
+
+  auto horizontalFov = [](const sdf::Root &_root)
+  {
+    return _root.Model()->LinkByName("link")->SensorByName("camera")
+        ->Element()->GetElement("camera")->Get<double>("horizontal_fov");
+  };
+
+  // By default, the value above its maximum is a parsing error and the joint
+  // is reported.
+  {
+    sdf::ParserConfig config;
+    EXPECT_EQ(sdf::ValidationLevel::FULL, config.GetValidationLevel());
+    sdf::Root root;
+    sdf::Errors errors = root.LoadSdfString(sdfString, config);
+    EXPECT_FALSE(errors.empty());
+  }
+
+  // Structural validation accepts the value but still checks the joint.
+  {
+    sdf::ParserConfig config;
+    config.SetValidationLevel(sdf::ValidationLevel::STRUCTURAL);
+    EXPECT_EQ(sdf::ValidationLevel::STRUCTURAL, config.GetValidationLevel());
+    sdf::Root root;
+    sdf::Errors errors = root.LoadSdfString(sdfString, config);
+    EXPECT_TRUE(
+        hasErrorCode(errors, sdf::ErrorCode::JOINT_PARENT_SAME_AS_CHILD))
+        << errors;
+    ASSERT_NE(nullptr, root.Model());
+    EXPECT_DOUBLE_EQ(7.0, horizontalFov(root));
+  }
+
+  // Trusted documents skip both checks, and their poses can still be
+  // resolved.
+  {
+    sdf::ParserConfig config;
+    config.SetValidationLevel(sdf::ValidationLevel::NONE);
+    sdf::Root root;
+    sdf::Errors errors = root.LoadSdfString(sdfString, config);
+    EXPECT_TRUE(errors.empty()) << errors;
+    ASSERT_NE(nullptr, root.Model());
+    EXPECT_DOUBLE_EQ(7.0, horizontalFov(root));
+
+    ignition::math::Pose3d pose;
+    errors = root.Model()->LinkByName("link")->SemanticPose().Resolve(
+        pose, "__model__");
+    EXPECT_TRUE(errors.empty()) << errors;
+    EXPECT_EQ(ignition::math::Pose3d(0, 0, 1, 0, 0, 0), pose);
+  }
+}
+
+/////////////////////////////////////////////////
+/// Test reading the top-level models of a world one at a time
+TEST(ParserConfig, StreamWorldModels)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  std::filesystem::create_directories(tmpDir);
+  const std::string worldFile =
+      sdf::filesystem::append(tmpDir, "stream_world_models.sdf");
+  {
+    std::ofstream out(worldFile);
+    out << "<?xml version='1.0'?>\n"
+        << "<sdf version='" << SDF_VERSION << "'>\n"
+        << "  <world name='default'>\n";
+    for (int i = 0; i < 20; ++i)
+    {
+      out << "    <model name='model" << i << "'>\n"
+          << "      <pose>" << i << " 0 0 0 0 0</pose>\n"
+          << "      <link name='link'>\n"
+          << "        <unknown_element/>\n"
+          << "      </link>\n"
+          << "    </model>\n";
+    }
+    out << "    <frame name='frame' attached_to='model19'/>\n"
+        << "  </world>\n"
+        << "</sdf>\n";
+  }
+
+  auto load = [&worldFile](bool _stream, sdf::Root &_root)
+  {
+    sdf::ParserConfig config;
+    config.SetUnrecognizedElementsPolicy(sdf::EnforcementPolicy::ERR);
+    config.SetStreamWorldModels(_stream);
+    EXPECT_EQ(_stream, config.StreamWorldModels());
+    return _root.Load(worldFile, config);
+  };
+
+  sdf::Root root;
+  sdf::Errors errors = load(false, root);
+  sdf::Root streamedRoot;
+  sdf::Errors streamedErrors = load(true, streamedRoot);
+
+  // The unknown elements are reported at the same lines.
+  ASSERT_EQ(20u, errors.size()) << errors;
+  ASSERT_EQ(errors.size(), streamedErrors.size()) << streamedErrors;
+  for (std::size_t i = 0; i < errors.size(); ++i)
+  {
+    EXPECT_EQ(errors[i].Code(), streamedErrors[i].Code());
+    EXPECT_EQ(errors[i].Message(), streamedErrors[i].Message());
+    EXPECT_EQ(worldFile, streamedErrors[i].FilePath());
+    ASSERT_TRUE(streamedErrors[i].LineNumber().has_value());
+    EXPECT_EQ(7 + 6 * static_cast<int>(i),
+        streamedErrors[i].LineNumber().value());
+    EXPECT_EQ(errors[i].LineNumber(), streamedErrors[i].LineNumber());
+    EXPECT_EQ(errors[i].XmlPath(), streamedErrors[i].XmlPath());
+  }
+
+  EXPECT_EQ(root.Element()->ToString(""),
+            streamedRoot.Element()->ToString(""));
+
+  const sdf::World *world = streamedRoot.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  ASSERT_EQ(20u, world->ModelCount());
+  EXPECT_EQ(1u, world->FrameCount());
+  for (uint64_t i = 0; i < world->ModelCount(); ++i)
+  {
+    const sdf::Model *model = world->ModelByIndex(i);
+    EXPECT_EQ("model" + std::to_string(i), model->Name());
+    EXPECT_EQ(ignition::math::Pose3d(static_cast<double>(i), 0, 0, 0, 0, 0),
+              model->RawPose());
+
+    sdf::ElementPtr linkElem = model->LinkByIndex(0)->Element();
+    ASSERT_TRUE(linkElem->LineNumber().has_value());
+    EXPECT_EQ(6 + 6 * static_cast<int>(i), linkElem->LineNumber().value());
+    EXPECT_EQ(worldFile, linkElem->FilePath());
+    EXPECT_EQ(
+        root.WorldByIndex(0)->ModelByIndex(i)->Element()->LineNumber(),
+        model->Element()->LineNumber());
+  }
+
+  const sdf::Frame *frame = world->FrameByName("frame");
+  ASSERT_NE(nullptr, frame);
+  ASSERT_TRUE(frame->Element()->LineNumber().has_value());
+  EXPECT_EQ(124, frame->Element()->LineNumber().value());
+}
+
+/////////////////////////////////////////////////
+/// Test skipping elements while reading documents
+TEST(ParserConfig, SkipElements)
+{
+  const std::string sdfString =
+      "<sdf version='1.9'><model name='robot'>"
+      "<link name='link'>"
+      "<visual name='visual'><geometry><box/></geometry></visual>"
+      "<collision name='collision'><geometry><box/></geometry>"
+      "<surface><friction/></surface></collision>"
+      "<sensor name='camera' type='camera'><camera/></sensor>"
+      "<sensor name='imu' type='imu'><imu/></sensor>"
+      "</link>"
+      "<link name='link2'/>"
+      "<joint name='joint' type='fixed'>"
+      "<parent>link</parent><child>link2</child></joint>"
+      "</model></sdf>";
+
+  sdf::ParserConfig config;
+  EXPECT_TRUE(config.SkippedElements().empty());
+  EXPECT_FALSE(config.ElementFilter());
+  config.AddSkippedElement("visual");
+  config.AddSkippedElement("surface");
+  config.AddSkippedElement("visual");
+  EXPECT_EQ(2u, config.SkippedElements().size());
+
+  // Skip camera sensors, and the required <geometry> of collisions.
+  config.SetElementFilter([](const std::string &_parentName,
+      const std::string &_name, const std::string &_type)
+  {
+    if (_name == "sensor" && _type == "camera")
+      return false;
+    return !(_parentName == "collision" && _name == "geometry");
+  });
+  EXPECT_TRUE(config.ElementFilter());
+
+  // The skipped elements are not read, and the missing <geometry> is not
+  // replaced by a default element.
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf);
+  sdf::Errors readErrors;
+  EXPECT_TRUE(sdf::readString(sdfString, config, sdf, readErrors));
+  EXPECT_TRUE(readErrors.empty()) << readErrors;
+  sdf::ElementPtr linkElem =
+      sdf->Root()->GetElement("model")->GetElement("link");
+  EXPECT_FALSE(linkElem->HasElement("visual"));
+  ASSERT_TRUE(linkElem->HasElement("collision"));
+  EXPECT_FALSE(linkElem->GetElement("collision")->HasElement("geometry"));
+  EXPECT_FALSE(linkElem->GetElement("collision")->HasElement("surface"));
+  ASSERT_TRUE(linkElem->HasElement("sensor"));
+  EXPECT_EQ("imu", linkElem->GetElement("sensor")->Get<std::string>("type"));
+  EXPECT_EQ(nullptr, linkElem->GetElement("sensor")->GetNextElement("sensor"));
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+  ASSERT_NE(nullptr, root.Model());
+  const sdf::Link *link = root.Model()->LinkByName("link");
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ(0u, link->VisualCount());
+  EXPECT_EQ(1u, link->CollisionCount());
+  EXPECT_EQ(1u, link->SensorCount());
+  EXPECT_EQ(nullptr, link->SensorByName("camera"));
+  EXPECT_NE(nullptr, link->SensorByName("imu"));
+  EXPECT_EQ(1u, root.Model()->JointCount());
+
+  // Without the filters, everything is read.
+  sdf::Root fullRoot;
+  errors = fullRoot.LoadSdfString(sdfString);
+  EXPECT_TRUE(errors.empty()) << errors;
+  ASSERT_NE(nullptr, fullRoot.Model());
+  link = fullRoot.Model()->LinkByName("link");
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ(1u, link->VisualCount());
+  EXPECT_EQ(2u, link->SensorCount());
+}
+
+/////////////////////////////////////////////////
+/// Test reading only the world models in a region
+TEST(ParserConfig, RegionOfInterest)
+{
+  const std::string sdfString =
+      "<sdf version='1.9'><world name='default'>"
+      "<frame name='far_frame'><pose>100 0 0 0 0 0</pose></frame>"
+      "<model name='inside'><pose>1 1 0 0 0 0</pose>"
+      "<link name='link'/></model>"
+      "<model name='origin'><link name='link'/></model>"
+      "<model name='outside'><pose>50 0 0 0 0 0</pose>"
+      "<link name='link'/></model>"
+      "<model name='relative'><pose relative_to='far_frame'>0 0 0 0 0 0</pose>"
+      "<link name='link'/></model>"
+      "<include><uri>file:///no/such/model</uri>"
+      "<pose>-50 0 0 0 0 0</pose></include>"
+      "</world></sdf>";
+
+  sdf::ParserConfig config;
+  EXPECT_FALSE(config.RegionOfInterest().has_value());
+  const ignition::math::AxisAlignedBox region(
+      ignition::math::Vector3d(-10, -10, -10),
+      ignition::math::Vector3d(10, 10, 10));
+  config.SetRegionOfInterest(region);
+  ASSERT_TRUE(config.RegionOfInterest().has_value());
+  EXPECT_EQ(region, config.RegionOfInterest().value());
+
+  // The include outside of the region is never resolved.
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  EXPECT_EQ(3u, world->ModelCount());
+  EXPECT_TRUE(world->ModelNameExists("inside"));
+  EXPECT_TRUE(world->ModelNameExists("origin"));
+  EXPECT_FALSE(world->ModelNameExists("outside"));
+
+  // Poses relative to other frames are not evaluated before reading.
+  EXPECT_TRUE(world->ModelNameExists("relative"));
+
+  config.ClearRegionOfInterest();
+  EXPECT_FALSE(config.RegionOfInterest().has_value());
+  sdf::Root fullRoot;
+  errors = fullRoot.LoadSdfString(sdfString, config);
+  EXPECT_FALSE(errors.empty());
+  ASSERT_NE(nullptr, fullRoot.WorldByIndex(0));
+  EXPECT_TRUE(fullRoot.WorldByIndex(0)->ModelNameExists("outside"));
+}
@@ -23,6 +23,43 @@
 
 #include "test_config.h"
 
+/////////////////////////////////////////////////
+TEST(SDFParser, CustomElementsAsRawXml)
+{
+  const std::string sdfTestFile =
+      sdf::testing::TestFile("integration", "custom_elems_attrs.sdf");
+
+  sdf::ParserConfig config;
+  config.SetCopyElementsAsRawXml(true);
+  sdf::Root root;
+  sdf::Errors errors = root.Load(sdfTestFile, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  const sdf::Model *model = world->ModelByIndex(0);
+  ASSERT_NE(nullptr, model);
+
+  // Custom attributes of known elements are still parsed
+  EXPECT_EQ("2d", world->Element()->Get<std::string>("mysim:type"));
+
+  // Custom elements only keep their name and text
+  sdf::ElementPtr transmission =
+      model->Element()->FindElement("mysim:transmission");
+  ASSERT_NE(nullptr, transmission);
+  EXPECT_EQ(nullptr, transmission->GetFirstElement());
+  EXPECT_FALSE(transmission->HasAttribute("name"));
+  const std::string &xml = transmission->RawXml();
+  EXPECT_EQ(0u, xml.find("<mysim:transmission name=\"simple_trans\">"));
+  EXPECT_NE(std::string::npos, xml.find(
+      "<mysim:hardwareInterface>EffortJointInterface"
+      "</mysim:hardwareInterface>"));
+
+  // The text is printed in place of the element
+  EXPECT_NE(std::string::npos, model->Element()->ToString("").find(
+      "<mysim:hardwareInterface>EffortJointInterface"));
+}
+
 /////////////////////////////////////////////////
 TEST(SDFParser, CustomElements)
 {
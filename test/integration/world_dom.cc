@@ -17,12 +17,16 @@
 
 #include <iostream>
 #include <string>
+#include <ignition/math/Pose3.hh>
 #include <gtest/gtest.h>
 
 #include "sdf/SDFImpl.hh"
 #include "sdf/parser.hh"
+#include "sdf/EntityTables.hh"
 #include "sdf/Frame.hh"
+#include "sdf/Link.hh"
 #include "sdf/Model.hh"
+#include "sdf/ParserConfig.hh"
 #include "sdf/Root.hh"
 #include "sdf/World.hh"
 #include "test_config.h"
@@ -339,7 +343,27 @@ TEST(DOMWorld, LoadWorldWithDuplicateChildNames)
     auto errors = root.Load(testFile);
     EXPECT_TRUE(errors.empty()) << errors;
 
-    // Check warning message
+    // Check warning message, which is printed once
+    const std::string warning = "Non-unique name[spot] detected 2 times in "
+        "XML children of world with name[default]";
+    const std::size_t pos = buffer.str().find(warning);
+    EXPECT_NE(std::string::npos, pos);
+    EXPECT_EQ(std::string::npos, buffer.str().find(warning, pos + 1));
+  }
+
+  // Check that a world loaded without a Root checks the names itself
+  {
+    buffer.str("");
+    const std::string testFile =
+      sdf::testing::TestFile("sdf", "world_sibling_same_names.sdf");
+
+    sdf::Errors errors;
+    sdf::SDFPtr sdfParsed = sdf::readFile(testFile, errors);
+    ASSERT_NE(nullptr, sdfParsed);
+    EXPECT_TRUE(errors.empty()) << errors;
+
+    sdf::World world;
+    errors = world.Load(sdfParsed->Root()->GetElement("world"));
     EXPECT_NE(std::string::npos,
         buffer.str().find("Non-unique name[spot] detected 2 times in XML "
           "children of world with name[default]"));
@@ -380,3 +404,207 @@ TEST(DOMWorld, WorldPlugins)
   EXPECT_EQ("world_plugin2", world->Plugins()[1].Name());
   EXPECT_EQ("test/file/world2", world->Plugins()[1].Filename());
 }
+
+//////////////////////////////////////////////////
+TEST(DOMWorld, ResolveEntityTables)
+{
+  const std::string sdfString = R"(
+  <sdf version='1.8'>
+    <world name='default'>
+      <model name='robot'>
+        <pose>1 0 0 0 0 0</pose>
+        <link name='base'>
+          <pose>0 0 1 0 0 0</pose>
+          <inertial>
+            <mass>2</mass>
+          </inertial>
+          <collision name='box'>
+            <pose>0 0 1 0 0 0</pose>
+            <geometry>
+              <box><size>1 2 3</size></box>
+            </geometry>
+          </collision>
+          <visual name='visual'>
+            <geometry>
+              <sphere><radius>1</radius></sphere>
+            </geometry>
+          </visual>
+          <sensor name='imu' type='imu'>
+            <update_rate>100</update_rate>
+          </sensor>
+        </link>
+        <joint name='anchor' type='fixed'>
+          <parent>world</parent>
+          <child>base</child>
+        </joint>
+        <joint name='shoulder' type='revolute'>
+          <parent>base</parent>
+          <child>arm::tip</child>
+          <axis><xyz>0 0 1</xyz></axis>
+          <sensor name='force_torque' type='force_torque'/>
+        </joint>
+        <frame name='frame'/>
+        <model name='arm'>
+          <pose>0 1 0 0 0 0</pose>
+          <link name='tip'>
+            <collision name='cylinder'>
+              <geometry>
+                <cylinder><radius>0.5</radius><length>2</length></cylinder>
+              </geometry>
+            </collision>
+          </link>
+        </model>
+      </model>
+    </world>
+  </sdf>)";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString);
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+
+  sdf::EntityTables tables;
+  errors = world->ResolveEntityTables(tables);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  const uint64_t none = sdf::EntityTables::kNoIndex;
+  ASSERT_EQ(2u, tables.models.names.size());
+  EXPECT_EQ("robot", tables.models.names[0]);
+  EXPECT_EQ("arm", tables.models.names[1]);
+  EXPECT_EQ(none, tables.models.parents[0]);
+  EXPECT_EQ(0u, tables.models.parents[1]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 0, 0, 0, 0, 0),
+            tables.models.poses[0]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 1, 0, 0, 0, 0),
+            tables.models.poses[1]);
+
+  ASSERT_EQ(2u, tables.links.names.size());
+  EXPECT_EQ("base", tables.links.names[0]);
+  EXPECT_EQ("tip", tables.links.names[1]);
+  EXPECT_EQ(0u, tables.links.models[0]);
+  EXPECT_EQ(1u, tables.links.models[1]);
+  EXPECT_DOUBLE_EQ(2.0, tables.links.inertials[0].MassMatrix().Mass());
+  EXPECT_EQ(ignition::math::Pose3d(1, 0, 1, 0, 0, 0),
+            tables.links.poses[0]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 1, 0, 0, 0, 0),
+            tables.links.poses[1]);
+
+  ASSERT_EQ(2u, tables.collisions.names.size());
+  EXPECT_EQ("box", tables.collisions.names[0]);
+  EXPECT_EQ(0u, tables.collisions.links[0]);
+  EXPECT_EQ(sdf::GeometryType::BOX, tables.collisions.geometryTypes[0]);
+  EXPECT_EQ(ignition::math::Vector3d(1, 2, 3),
+            tables.collisions.geometryParameters[0]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 0, 2, 0, 0, 0),
+            tables.collisions.poses[0]);
+  EXPECT_EQ("cylinder", tables.collisions.names[1]);
+  EXPECT_EQ(1u, tables.collisions.links[1]);
+  EXPECT_EQ(sdf::GeometryType::CYLINDER, tables.collisions.geometryTypes[1]);
+  EXPECT_EQ(ignition::math::Vector3d(0.5, 2, 0),
+            tables.collisions.geometryParameters[1]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 1, 0, 0, 0, 0),
+            tables.collisions.poses[1]);
+
+  ASSERT_EQ(2u, tables.joints.names.size());
+  EXPECT_EQ("anchor", tables.joints.names[0]);
+  EXPECT_EQ(sdf::JointType::FIXED, tables.joints.types[0]);
+  EXPECT_EQ(none, tables.joints.parentLinks[0]);
+  EXPECT_EQ(0u, tables.joints.childLinks[0]);
+  EXPECT_EQ("shoulder", tables.joints.names[1]);
+  EXPECT_EQ(0u, tables.joints.models[1]);
+  EXPECT_EQ(sdf::JointType::REVOLUTE, tables.joints.types[1]);
+  EXPECT_EQ(0u, tables.joints.parentLinks[1]);
+  EXPECT_EQ(1u, tables.joints.childLinks[1]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 1, 0, 0, 0, 0),
+            tables.joints.poses[1]);
+
+  ASSERT_EQ(2u, tables.sensors.names.size());
+  EXPECT_EQ("imu", tables.sensors.names[0]);
+  EXPECT_EQ(0u, tables.sensors.links[0]);
+  EXPECT_EQ(none, tables.sensors.joints[0]);
+  EXPECT_EQ(sdf::SensorType::IMU, tables.sensors.types[0]);
+  EXPECT_DOUBLE_EQ(100.0, tables.sensors.updateRates[0]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 0, 1, 0, 0, 0),
+            tables.sensors.poses[0]);
+  EXPECT_EQ("force_torque", tables.sensors.names[1]);
+  EXPECT_EQ(none, tables.sensors.links[1]);
+  EXPECT_EQ(1u, tables.sensors.joints[1]);
+  EXPECT_EQ(sdf::SensorType::FORCE_TORQUE, tables.sensors.types[1]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 1, 0, 0, 0, 0),
+            tables.sensors.poses[1]);
+
+  // The poses are relative to the world frame.
+  ignition::math::Pose3d pose;
+  EXPECT_TRUE(world->ModelByIndex(0)->LinkByIndex(0)->SemanticPose().Resolve(
+      pose, "world").empty());
+  EXPECT_EQ(pose, tables.links.poses[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(DOMWorld, LazyWorldModels)
+{
+  const std::string sdfString = R"(
+  <sdf version='1.8'>
+    <world name='default'>
+      <model name='robot'>
+        <pose>1 0 0 0 0 0</pose>
+        <link name='base'>
+          <pose>0 0 1 0 0 0</pose>
+        </link>
+        <model name='arm'>
+          <link name='tip'/>
+        </model>
+      </model>
+      <model name='box'>
+        <pose relative_to='robot'>0 2 0 0 0 0</pose>
+        <link name='link'/>
+      </model>
+    </world>
+  </sdf>)";
+
+  sdf::ParserConfig config;
+  config.SetLazyWorldModels(true);
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdfString, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+  sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+
+  // Only the stubs of the models are loaded.
+  ASSERT_EQ(2u, world->ModelCount());
+  EXPECT_FALSE(world->ModelLoaded(0));
+  EXPECT_FALSE(world->ModelLoaded(1));
+  EXPECT_FALSE(world->ModelLoaded(2));
+  const sdf::Model *stub = world->ModelStubByIndex(1);
+  ASSERT_NE(nullptr, stub);
+  EXPECT_EQ("box", stub->Name());
+  EXPECT_EQ(ignition::math::Pose3d(0, 2, 0, 0, 0, 0), stub->RawPose());
+  EXPECT_EQ("robot", stub->PoseRelativeTo());
+  EXPECT_EQ(0u, stub->LinkCount());
+  EXPECT_EQ(nullptr, world->ModelStubByIndex(2));
+  EXPECT_TRUE(world->ModelNameExists("box"));
+
+  // A model is loaded on first access, and its poses resolve within the
+  // model until the world graphs are built.
+  const sdf::Model *robot = world->ModelByIndex(0);
+  ASSERT_NE(nullptr, robot);
+  EXPECT_TRUE(world->ModelLoaded(0));
+  EXPECT_FALSE(world->ModelLoaded(1));
+  ASSERT_EQ(1u, robot->LinkCount());
+  ignition::math::Pose3d pose;
+  EXPECT_TRUE(robot->LinkByIndex(0)->SemanticPose().Resolve(
+      pose, "__model__").empty());
+  EXPECT_EQ(ignition::math::Pose3d(0, 0, 1, 0, 0, 0), pose);
+  EXPECT_NE(nullptr, world->ModelByName("robot::arm"));
+
+  // Building the graphs loads the remaining models.
+  errors = root.UpdateGraphs();
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_TRUE(world->ModelLoaded(1));
+  const sdf::Model *box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  EXPECT_EQ(1u, box->LinkCount());
+  EXPECT_TRUE(box->SemanticPose().Resolve(pose, "world").empty());
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 0, 0, 0, 0), pose);
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_TEST_PERFORMANCE_BENCHMARK_HH_
+#define SDF_TEST_PERFORMANCE_BENCHMARK_HH_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <fstream>
+#endif
+
+#include <gtest/gtest.h>
+
+// This header replaces the global allocation operators to count the
+// allocations, so it must be included by a single source file of each
+// benchmark executable.
+
+/// \brief Number of allocations made by the process.
+static std::atomic<std::uint64_t> gAllocationCount{0};
+
+/// \brief Number of bytes allocated by the process.
+static std::atomic<std::uint64_t> gAllocatedBytes{0};
+
+/////////////////////////////////////////////////
+// Count the allocations of the benchmarks. The array and nothrow forms of
+// the default operators call these ones.
+void *operator new(std::size_t _size)
+{
+  ++gAllocationCount;
+  gAllocatedBytes += _size;
+  if (void *ptr = std::malloc(_size == 0 ? 1 : _size))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the peak resident set size of the process.
+/// \return Peak resident set size in kilobytes, or -1 if it is not available
+/// on this platform.
+static long peakRssKb()
+{
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+#endif
+  return -1;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the current resident set size of the process.
+/// \return Resident set size in kilobytes, or -1 if it is not available on
+/// this platform.
+static long currentRssKb()
+{
+#ifdef __linux__
+  std::ifstream statm("/proc/self/statm");
+  long pages = 0;
+  long residentPages = 0;
+  if (statm >> pages >> residentPages)
+    return residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+  return -1;
+}
+
+/////////////////////////////////////////////////
+/// \brief Run an operation a number of times and report the time and the
+/// allocations per operation and the peak resident set size. The results
+/// are printed as a JSON object on a line starting with "BENCHMARK ", and
+/// recorded as properties of the running test, so that they are also in
+/// the XML test results.
+/// \param[in] _name Name of the benchmark.
+/// \param[in] _iterations Number of times to run _op.
+/// \param[in] _op Operation to measure.
+template <typename Op>
+void benchmark(const std::string &_name, int _iterations, Op _op)
+{
+  const std::uint64_t allocationsBefore = gAllocationCount;
+  const std::uint64_t bytesBefore = gAllocatedBytes;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _op();
+  const auto end = std::chrono::steady_clock::now();
+
+  const auto nsPerOp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      end - start).count() / _iterations;
+  const auto allocationsPerOp =
+      (gAllocationCount - allocationsBefore) / _iterations;
+  const auto bytesPerOp = (gAllocatedBytes - bytesBefore) / _iterations;
+  const long peakRss = peakRssKb();
+
+  std::ostringstream json;
+  json << "{\"name\": \"" << _name << "\""
+       << ", \"iterations\": " << _iterations
+       << ", \"ns_per_op\": " << nsPerOp
+       << ", \"allocs_per_op\": " << allocationsPerOp
+       << ", \"bytes_per_op\": " << bytesPerOp
+       << ", \"peak_rss_kb\": " << peakRss << "}";
+  std::cout << "BENCHMARK " << json.str() << std::endl;
+
+  ::testing::Test::RecordProperty(_name + ".ns_per_op",
+      std::to_string(nsPerOp));
+  ::testing::Test::RecordProperty(_name + ".allocs_per_op",
+      std::to_string(allocationsPerOp));
+  ::testing::Test::RecordProperty(_name + ".bytes_per_op",
+      std::to_string(bytesPerOp));
+  ::testing::Test::RecordProperty(_name + ".peak_rss_kb",
+      std::to_string(peakRss));
+}
+
+#endif
@@ -0,0 +1,356 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/Actor.hh"
+#include "sdf/Camera.hh"
+#include "sdf/Collision.hh"
+#include "sdf/Joint.hh"
+#include "sdf/Lidar.hh"
+#include "sdf/Link.hh"
+#include "sdf/Model.hh"
+#include "sdf/Sensor.hh"
+#include "sdf/Visual.hh"
+#include "sdf/sdf.hh"
+
+#include "benchmark.hh"
+
+// These benchmarks measure the Load functions of the DOM classes on
+// elements that are parsed once, so that the cost of the DOM layer is not
+// hidden by the cost of reading XML.
+
+/// \brief Number of times each Load function is measured.
+static constexpr int kIterations = 2000;
+
+/////////////////////////////////////////////////
+/// \brief Link with a visual, a collision, a camera and a lidar.
+/// \param[in] _name Name of the link.
+/// \return The SDFormat of the link.
+static std::string linkSdf(const std::string &_name)
+{
+  return "<link name='" + _name + "'>"
+    "  <pose>0 0 1 0 0 0</pose>"
+    "  <inertial>"
+    "    <mass>2</mass>"
+    "    <inertia><ixx>1</ixx><iyy>1</iyy><izz>1</izz></inertia>"
+    "  </inertial>"
+    "  <visual name='visual'>"
+    "    <pose>0 0 0.1 0 0 0</pose>"
+    "    <geometry><box><size>1 2 3</size></box></geometry>"
+    "    <material>"
+    "      <ambient>0.1 0.2 0.3 1</ambient>"
+    "      <diffuse>0.4 0.5 0.6 1</diffuse>"
+    "    </material>"
+    "  </visual>"
+    "  <collision name='collision'>"
+    "    <geometry><cylinder><radius>0.5</radius><length>2</length>"
+    "    </cylinder></geometry>"
+    "    <surface><friction><ode><mu>0.5</mu></ode></friction></surface>"
+    "  </collision>"
+    "  <sensor name='camera' type='camera'>"
+    "    <update_rate>30</update_rate>"
+    "    <camera>"
+    "      <horizontal_fov>1.05</horizontal_fov>"
+    "      <image><width>640</width><height>480</height></image>"
+    "      <clip><near>0.1</near><far>100</far></clip>"
+    "      <noise><type>gaussian</type><stddev>0.007</stddev></noise>"
+    "    </camera>"
+    "  </sensor>"
+    "  <sensor name='lidar' type='gpu_lidar'>"
+    "    <lidar>"
+    "      <scan>"
+    "        <horizontal>"
+    "          <samples>640</samples>"
+    "          <min_angle>-1.4</min_angle><max_angle>1.4</max_angle>"
+    "        </horizontal>"
+    "      </scan>"
+    "      <range><min>0.1</min><max>30</max></range>"
+    "    </lidar>"
+    "  </sensor>"
+    "</link>";
+}
+
+/////////////////////////////////////////////////
+/// \brief Model with a chain of links connected by revolute joints.
+/// \param[in] _linkCount Number of links.
+/// \return The SDFormat of the model.
+static std::string modelSdf(int _linkCount)
+{
+  std::string sdf = "<model name='model'>";
+  for (int i = 0; i < _linkCount; ++i)
+    sdf += linkSdf("link" + std::to_string(i));
+  for (int i = 1; i < _linkCount; ++i)
+  {
+    sdf += "<joint name='joint" + std::to_string(i) + "' type='revolute'>"
+      "  <parent>link" + std::to_string(i - 1) + "</parent>"
+      "  <child>link" + std::to_string(i) + "</child>"
+      "  <pose>0 0 0.5 0 0 0</pose>"
+      "  <axis>"
+      "    <xyz>0 0 1</xyz>"
+      "    <limit><lower>-1.57</lower><upper>1.57</upper></limit>"
+      "    <dynamics><damping>0.1</damping></dynamics>"
+      "  </axis>"
+      "</joint>";
+  }
+  return sdf + "</model>";
+}
+
+/////////////////////////////////////////////////
+/// \brief Actor with a skin, an animation and a scripted trajectory.
+/// \param[in] _waypointCount Number of waypoints of the trajectory.
+/// \return The SDFormat of the actor.
+static std::string actorSdf(int _waypointCount)
+{
+  std::string sdf = "<actor name='actor'>"
+    "  <skin><filename>walk.dae</filename></skin>"
+    "  <animation name='walking'><filename>walk.dae</filename></animation>"
+    "  <script>"
+    "    <loop>true</loop>"
+    "    <trajectory id='0' type='walking'>";
+  for (int i = 0; i < _waypointCount; ++i)
+  {
+    sdf += "<waypoint><time>" + std::to_string(i) + "</time>"
+      "<pose>" + std::to_string(i) + " 0 0 0 0 0</pose></waypoint>";
+  }
+  sdf += "    </trajectory>"
+    "  </script>"
+    + linkSdf("link") +
+    "</actor>";
+  return sdf;
+}
+
+/////////////////////////////////////////////////
+/// \brief Base fixture that parses a document once, so that the benchmarks
+/// only measure the Load function of a DOM class.
+class DomLoad : public ::testing::Test
+{
+  /// \brief Parse a document.
+  /// \param[in] _body Children of the <sdf> element.
+  protected: void Parse(const std::string &_body)
+  {
+    this->sdf.reset(new sdf::SDF());
+    sdf::init(this->sdf);
+    ASSERT_TRUE(sdf::readString(
+        "<sdf version='" + sdf::SDF::Version() + "'>" + _body + "</sdf>",
+        this->sdf));
+  }
+
+  /// \brief Get the first link of the parsed model.
+  /// \return The link element.
+  protected: sdf::ElementPtr Link() const
+  {
+    return this->sdf->Root()->GetElement("model")->GetElement("link");
+  }
+
+  /// \brief Get a sensor of the first link of the parsed model.
+  /// \param[in] _name Name of the sensor.
+  /// \return The sensor element, or nullptr if it is not found.
+  protected: sdf::ElementPtr Sensor(const std::string &_name) const
+  {
+    for (sdf::ElementPtr sensor = this->Link()->GetElement("sensor"); sensor;
+         sensor = sensor->GetNextElement("sensor"))
+    {
+      if (sensor->Get<std::string>("name") == _name)
+        return sensor;
+    }
+    return nullptr;
+  }
+
+  /// \brief Measure the Load function of a DOM class on the element.
+  /// \param[in] _name Name of the benchmark.
+  protected: template <typename T>
+             void Measure(const std::string &_name)
+  {
+    ASSERT_NE(nullptr, this->elem);
+    {
+      T object;
+      const sdf::Errors errors = object.Load(this->elem);
+      EXPECT_TRUE(errors.empty()) << errors;
+    }
+    benchmark(_name, kIterations, [&]()
+        {
+          T object;
+          object.Load(this->elem);
+        });
+  }
+
+  /// \brief The parsed document.
+  protected: sdf::SDFPtr sdf;
+
+  /// \brief The element that is loaded.
+  protected: sdf::ElementPtr elem;
+};
+
+/////////////////////////////////////////////////
+/// \brief Fixture for Model::Load, with a chain of 20 links.
+class ModelLoad : public DomLoad
+{
+  protected: void SetUp() override
+  {
+    this->Parse(modelSdf(20));
+    this->elem = this->sdf->Root()->GetElement("model");
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(ModelLoad, Benchmark)
+{
+  this->Measure<sdf::Model>("dom_model_load_20_links");
+}
+
+/////////////////////////////////////////////////
+/// \brief Fixture for Link::Load.
+class LinkLoad : public DomLoad
+{
+  protected: void SetUp() override
+  {
+    this->Parse(modelSdf(1));
+    this->elem = this->Link();
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(LinkLoad, Benchmark)
+{
+  this->Measure<sdf::Link>("dom_link_load");
+}
+
+/////////////////////////////////////////////////
+/// \brief Fixture for Joint::Load.
+class JointLoad : public DomLoad
+{
+  protected: void SetUp() override
+  {
+    this->Parse(modelSdf(2));
+    this->elem = this->sdf->Root()->GetElement("model")->GetElement("joint");
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(JointLoad, Benchmark)
+{
+  this->Measure<sdf::Joint>("dom_joint_load");
+}
+
+/////////////////////////////////////////////////
+/// \brief Fixture for Visual::Load.
+class VisualLoad : public DomLoad
+{
+  protected: void SetUp() override
+  {
+    this->Parse(modelSdf(1));
+    this->elem = this->Link()->GetElement("visual");
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(VisualLoad, Benchmark)
+{
+  this->Measure<sdf::Visual>("dom_visual_load");
+}
+
+/////////////////////////////////////////////////
+/// \brief Fixture for Collision::Load.
+class CollisionLoad : public DomLoad
+{
+  protected: void SetUp() override
+  {
+    this->Parse(modelSdf(1));
+    this->elem = this->Link()->GetElement("collision");
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(CollisionLoad, Benchmark)
+{
+  this->Measure<sdf::Collision>("dom_collision_load");
+}
+
+/////////////////////////////////////////////////
+/// \brief Fixture for Sensor::Load, with a camera sensor.
+class SensorLoad : public DomLoad
+{
+  protected: void SetUp() override
+  {
+    this->Parse(modelSdf(1));
+    this->elem = this->Sensor("camera");
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(SensorLoad, Benchmark)
+{
+  this->Measure<sdf::Sensor>("dom_sensor_load_camera");
+}
+
+/////////////////////////////////////////////////
+/// \brief Fixture for Camera::Load.
+class CameraLoad : public DomLoad
+{
+  protected: void SetUp() override
+  {
+    this->Parse(modelSdf(1));
+    sdf::ElementPtr sensor = this->Sensor("camera");
+    ASSERT_NE(nullptr, sensor);
+    this->elem = sensor->GetElement("camera");
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(CameraLoad, Benchmark)
+{
+  this->Measure<sdf::Camera>("dom_camera_load");
+}
+
+/////////////////////////////////////////////////
+/// \brief Fixture for Lidar::Load.
+class LidarLoad : public DomLoad
+{
+  protected: void SetUp() override
+  {
+    this->Parse(modelSdf(1));
+    sdf::ElementPtr sensor = this->Sensor("lidar");
+    ASSERT_NE(nullptr, sensor);
+    this->elem = sensor->GetElement("lidar");
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(LidarLoad, Benchmark)
+{
+  this->Measure<sdf::Lidar>("dom_lidar_load");
+}
+
+/////////////////////////////////////////////////
+/// \brief Fixture for Actor::Load, with 100 waypoints.
+class ActorLoad : public DomLoad
+{
+  protected: void SetUp() override
+  {
+    this->Parse(actorSdf(100));
+    this->elem = this->sdf->Root()->GetElement("actor");
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(ActorLoad, Benchmark)
+{
+  this->Measure<sdf::Actor>("dom_actor_load_100_waypoints");
+}
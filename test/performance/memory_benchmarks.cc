@@ -0,0 +1,193 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/MemoryUsage.hh"
+#include "sdf/Root.hh"
+#include "sdf/sdf.hh"
+
+#include "benchmark.hh"
+#include "test_config.h"
+#include "world_generator.hh"
+
+// These benchmarks measure the memory kept by loaded documents, to guard
+// the layout of the elements and the DOM classes. The budgets are read from
+// these environment variables and only checked when they are set:
+//
+//   SDF_MEMORY_BUDGET_ELEMENT_BYTES  Resident bytes per element.
+//   SDF_MEMORY_BUDGET_PARAM_BYTES    Resident bytes per parameter.
+//   SDF_MEMORY_BUDGET_ENTITY_BYTES   Resident bytes per DOM entity.
+//   SDF_MEMORY_BUDGET_PEAK_RSS_KB    Growth of the peak resident set size
+//                                    while loading a document.
+//
+// The resident bytes are measured from the resident set size of the process,
+// which is only available on Linux, so the budgets are not checked on other
+// platforms. The approximation of sdf::MemoryUsage is reported alongside.
+
+/// \brief Names of the elements loaded into DOM objects that are counted
+/// as entities.
+static const char *kEntityNames[] = {
+  "world", "model", "link", "joint", "collision", "visual", "sensor",
+  "frame", "light", "actor", "plugin"
+};
+
+/////////////////////////////////////////////////
+/// \brief Check a value against a budget set in the environment.
+/// \param[in] _name Name of the benchmark.
+/// \param[in] _variable Name of the environment variable of the budget.
+/// \param[in] _value Measured value, ignored when negative.
+static void expectWithinBudget(const std::string &_name,
+    const char *_variable, double _value)
+{
+  const char *budget = std::getenv(_variable);
+  if (budget == nullptr || _value < 0)
+    return;
+  EXPECT_LE(_value, std::strtod(budget, nullptr))
+      << _name << " exceeds " << _variable;
+}
+
+/////////////////////////////////////////////////
+/// \brief Load a document and report the memory it keeps per element,
+/// parameter and DOM entity and the growth of the peak resident set size.
+/// The documents should be measured from the smallest to the largest, since
+/// the peak resident set size of the process never decreases.
+/// \param[in] _name Name of the benchmark.
+/// \param[in] _load Function loading the document into a Root.
+static void memoryBenchmark(const std::string &_name,
+    const std::function<sdf::Errors(sdf::Root &)> &_load)
+{
+  const long peakBefore = peakRssKb();
+  const long rssBefore = currentRssKb();
+  const std::uint64_t bytesBefore = gAllocatedBytes;
+
+  auto root = std::make_unique<sdf::Root>();
+  const sdf::Errors errors = _load(*root);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  const long rssAfter = currentRssKb();
+  const long peakAfter = peakRssKb();
+  const std::uint64_t allocatedBytes = gAllocatedBytes - bytesBefore;
+
+  const sdf::MemoryUsage usage(*root);
+  std::uint64_t entities = 0;
+  for (const char *entityName : kEntityNames)
+    entities += usage.ElementCount(entityName);
+
+  auto perUnit = [](long _kb, std::uint64_t _count) -> double
+  {
+    if (_kb < 0 || _count == 0)
+      return -1;
+    return static_cast<double>(_kb) * 1024 / static_cast<double>(_count);
+  };
+  const long residentKb =
+      rssBefore < 0 || rssAfter < 0 ? -1 : std::max(rssAfter - rssBefore, 0L);
+  const double elementBytes = perUnit(residentKb, usage.ElementCount());
+  const double paramBytes = perUnit(residentKb, usage.ParamCount());
+  const double entityBytes = perUnit(residentKb, entities);
+  const long peakGrowthKb =
+      peakBefore < 0 || peakAfter < 0 ? -1 : peakAfter - peakBefore;
+
+  std::ostringstream json;
+  json << "{\"name\": \"" << _name << "\""
+       << ", \"elements\": " << usage.ElementCount()
+       << ", \"params\": " << usage.ParamCount()
+       << ", \"entities\": " << entities
+       << ", \"resident_kb\": " << residentKb
+       << ", \"bytes_per_element\": " << elementBytes
+       << ", \"bytes_per_param\": " << paramBytes
+       << ", \"bytes_per_entity\": " << entityBytes
+       << ", \"estimated_element_bytes\": " << usage.Bytes()
+       << ", \"allocated_bytes\": " << allocatedBytes
+       << ", \"peak_rss_growth_kb\": " << peakGrowthKb
+       << ", \"peak_rss_kb\": " << peakAfter << "}";
+  std::cout << "BENCHMARK " << json.str() << std::endl;
+
+  ::testing::Test::RecordProperty(_name + ".bytes_per_element",
+      std::to_string(elementBytes));
+  ::testing::Test::RecordProperty(_name + ".bytes_per_param",
+      std::to_string(paramBytes));
+  ::testing::Test::RecordProperty(_name + ".bytes_per_entity",
+      std::to_string(entityBytes));
+  ::testing::Test::RecordProperty(_name + ".estimated_element_bytes",
+      std::to_string(usage.Bytes()));
+  ::testing::Test::RecordProperty(_name + ".peak_rss_growth_kb",
+      std::to_string(peakGrowthKb));
+
+  expectWithinBudget(_name, "SDF_MEMORY_BUDGET_ELEMENT_BYTES", elementBytes);
+  expectWithinBudget(_name, "SDF_MEMORY_BUDGET_PARAM_BYTES", paramBytes);
+  expectWithinBudget(_name, "SDF_MEMORY_BUDGET_ENTITY_BYTES", entityBytes);
+  expectWithinBudget(_name, "SDF_MEMORY_BUDGET_PEAK_RSS_KB",
+      static_cast<double>(peakGrowthKb));
+}
+
+/////////////////////////////////////////////////
+TEST(Benchmark, RepresentativeWorldMemory)
+{
+  for (const char *file :
+      {"shapes_world.sdf", "world_complete.sdf", "double_pendulum.sdf"})
+  {
+    const std::string path = sdf::testing::TestFile("sdf", file);
+    memoryBenchmark(std::string("memory_") + file,
+        [&](sdf::Root &_root)
+        {
+          return _root.Load(path);
+        });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Benchmark, ScaledWorldMemory)
+{
+  for (const int modelCount : {100, 1000, 10000})
+  {
+    sdf::testing::WorldGeneratorOptions options;
+    options.modelCount = modelCount;
+    options.frameChainLength = 1;
+    const std::string sdf = sdf::testing::GenerateWorld(options);
+    memoryBenchmark("memory_world_" + std::to_string(modelCount),
+        [&](sdf::Root &_root)
+        {
+          return _root.LoadSdfString(sdf);
+        });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Benchmark, RichWorldMemory)
+{
+  sdf::testing::WorldGeneratorOptions options;
+  options.modelCount = 1000;
+  options.linkDepth = 4;
+  options.frameChainLength = 8;
+  options.sensors = true;
+  options.plugins = true;
+  const std::string sdf = sdf::testing::GenerateWorld(options);
+  memoryBenchmark("memory_rich_world_" + std::to_string(options.modelCount),
+      [&](sdf::Root &_root)
+      {
+        return _root.LoadSdfString(sdf);
+      });
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <ignition/math/Pose3.hh>
+
+#include "sdf/Link.hh"
+#include "sdf/Model.hh"
+#include "sdf/Root.hh"
+#include "sdf/SemanticPose.hh"
+#include "sdf/World.hh"
+#include "sdf/sdf.hh"
+
+#include "benchmark.hh"
+#include "test_config.h"
+#include "world_generator.hh"
+
+/////////////////////////////////////////////////
+/// \brief Load a document, expecting no errors.
+/// \param[in] _sdf The document.
+/// \param[out] _root Root to load the document into.
+static void loadString(const std::string &_sdf, sdf::Root &_root)
+{
+  sdf::Errors errors = _root.LoadSdfString(_sdf);
+  EXPECT_TRUE(errors.empty()) << errors;
+}
+
+/////////////////////////////////////////////////
+TEST(Benchmark, WorldLoad)
+{
+  for (const int modelCount : {100, 1000, 10000})
+  {
+    sdf::testing::WorldGeneratorOptions options;
+    options.modelCount = modelCount;
+    options.frameChainLength = 1;
+    const std::string sdf = sdf::testing::GenerateWorld(options);
+    benchmark("world_load_" + std::to_string(modelCount),
+        modelCount >= 10000 ? 1 : 10000 / modelCount / 2,
+        [&]()
+        {
+          sdf::Root root;
+          loadString(sdf, root);
+        });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Benchmark, IncludeWorldLoad)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string modelDir =
+      (std::filesystem::path(tmpDir) / "benchmark_models").string();
+
+  sdf::testing::WorldGeneratorOptions options;
+  options.modelCount = 500;
+  options.includeDepth = 2;
+  std::string includeUri;
+  ASSERT_TRUE(
+      sdf::testing::WriteIncludedModels(options, modelDir, includeUri));
+  const std::string sdf = sdf::testing::GenerateWorld(options, includeUri);
+
+  benchmark("include_world_load_" + std::to_string(options.modelCount), 5,
+      [&]()
+      {
+        sdf::Root root;
+        loadString(sdf, root);
+      });
+}
+
+/////////////////////////////////////////////////
+TEST(Benchmark, SensorsAndPluginsWorldLoad)
+{
+  sdf::testing::WorldGeneratorOptions options;
+  options.modelCount = 1000;
+  options.linkDepth = 4;
+  options.frameChainLength = 8;
+  options.sensors = true;
+  options.plugins = true;
+  const std::string sdf = sdf::testing::GenerateWorld(options);
+
+  benchmark("rich_world_load_" + std::to_string(options.modelCount), 3,
+      [&]()
+      {
+        sdf::Root root;
+        loadString(sdf, root);
+      });
+}
+
+/////////////////////////////////////////////////
+TEST(Benchmark, LegacyVersionConversion)
+{
+  sdf::testing::WorldGeneratorOptions options;
+  options.version = "1.6";
+  options.modelCount = 1000;
+  const std::string sdf = sdf::testing::GenerateWorld(options);
+  benchmark("legacy_1_6_world_load_" + std::to_string(options.modelCount), 5,
+      [&]()
+      {
+        sdf::Root root;
+        loadString(sdf, root);
+      });
+}
+
+/////////////////////////////////////////////////
+TEST(Benchmark, URDFConversion)
+{
+  const std::string urdfFile =
+      sdf::testing::TestFile("performance", "parser_urdf_atlas.urdf");
+  benchmark("urdf_atlas_read_file", 5,
+      [&]()
+      {
+        sdf::SDFPtr sdf = sdf::readFile(urdfFile);
+        EXPECT_NE(nullptr, sdf);
+      });
+}
+
+/////////////////////////////////////////////////
+TEST(Benchmark, ToStringRoundTrip)
+{
+  sdf::testing::WorldGeneratorOptions options;
+  options.modelCount = 1000;
+  options.frameChainLength = 1;
+  const int modelCount = options.modelCount;
+  sdf::Root root;
+  loadString(sdf::testing::GenerateWorld(options), root);
+  ASSERT_NE(nullptr, root.Element());
+
+  benchmark("to_string_" + std::to_string(modelCount), 10,
+      [&]()
+      {
+        EXPECT_FALSE(root.Element()->ToString("").empty());
+      });
+
+  benchmark("to_string_round_trip_" + std::to_string(modelCount), 5,
+      [&]()
+      {
+        sdf::Root reloaded;
+        loadString(root.Element()->ToString(""), reloaded);
+      });
+}
+
+/////////////////////////////////////////////////
+TEST(Benchmark, NestedModelLoad)
+{
+  // The time per level should stay the same as the nesting gets deeper.
+  for (const int depth : {10, 20, 40, 80})
+  {
+    sdf::testing::WorldGeneratorOptions options;
+    options.frameChainLength = 1;
+    const std::string sdf = sdf::testing::GenerateNestedModel(options, depth);
+    benchmark("nested_model_load_" + std::to_string(depth), 20,
+        [&]()
+        {
+          sdf::Root root;
+          loadString(sdf, root);
+        });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Benchmark, GraphResolution)
+{
+  sdf::testing::WorldGeneratorOptions options;
+  options.modelCount = 1000;
+  options.frameChainLength = 1;
+  const int modelCount = options.modelCount;
+  sdf::Root root;
+  loadString(sdf::testing::GenerateWorld(options), root);
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  ASSERT_EQ(static_cast<uint64_t>(modelCount), world->ModelCount());
+
+  std::vector<ignition::math::Pose3d> poses;
+  benchmark("resolve_all_poses_" + std::to_string(modelCount), 10,
+      [&]()
+      {
+        for (uint64_t i = 0; i < world->ModelCount(); ++i)
+        {
+          sdf::Errors errors = world->ModelByIndex(i)->ResolveAllPoses(poses);
+          EXPECT_TRUE(errors.empty()) << errors;
+        }
+      });
+
+  benchmark("resolve_link_poses_" + std::to_string(modelCount), 10,
+      [&]()
+      {
+        ignition::math::Pose3d pose;
+        for (uint64_t i = 0; i < world->ModelCount(); ++i)
+        {
+          const sdf::Model *model = world->ModelByIndex(i);
+          for (uint64_t l = 0; l < model->LinkCount(); ++l)
+          {
+            sdf::Errors errors =
+                model->LinkByIndex(l)->SemanticPose().Resolve(pose);
+            EXPECT_TRUE(errors.empty()) << errors;
+          }
+        }
+      });
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "world_generator.hh"
+
+/////////////////////////////////////////////////
+/// \brief Print the usage of the tool.
+/// \param[in] _name Name of the executable.
+static void usage(const char *_name)
+{
+  std::cerr
+    << "Usage: " << _name << " [options]\n"
+    << "Write a synthetic SDFormat world for benchmarks.\n\n"
+    << "  --models N        number of models (default 100)\n"
+    << "  --link-depth N    links per model, in a joint chain (default 2)\n"
+    << "  --include-depth N depth of the nested <include>s of each model\n"
+    << "                    (default 0, no includes)\n"
+    << "  --frames N        length of the <frame> chain of each model\n"
+    << "  --sensors         add sensors to the links\n"
+    << "  --plugins         add a plugin to each model\n"
+    << "  --mesh URI        use a mesh for the visuals instead of a box\n"
+    << "  --version V       SDFormat version (default " << SDF_VERSION << ")\n"
+    << "  --model-dir DIR   directory for the included model files\n"
+    << "                    (default: current directory)\n"
+    << "  -o FILE           output file (default: standard output)\n";
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  sdf::testing::WorldGeneratorOptions options;
+  std::string modelDir = ".";
+  std::string output;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--models" && hasValue)
+      options.modelCount = std::atoi(argv[++i]);
+    else if (arg == "--link-depth" && hasValue)
+      options.linkDepth = std::atoi(argv[++i]);
+    else if (arg == "--include-depth" && hasValue)
+      options.includeDepth = std::atoi(argv[++i]);
+    else if (arg == "--frames" && hasValue)
+      options.frameChainLength = std::atoi(argv[++i]);
+    else if (arg == "--sensors")
+      options.sensors = true;
+    else if (arg == "--plugins")
+      options.plugins = true;
+    else if (arg == "--mesh" && hasValue)
+      options.meshUri = argv[++i];
+    else if (arg == "--version" && hasValue)
+      options.version = argv[++i];
+    else if (arg == "--model-dir" && hasValue)
+      modelDir = argv[++i];
+    else if (arg == "-o" && hasValue)
+      output = argv[++i];
+    else
+    {
+      usage(argv[0]);
+      return arg == "-h" || arg == "--help" ? 0 : 1;
+    }
+  }
+
+  std::string includeUri;
+  if (!sdf::testing::WriteIncludedModels(options, modelDir, includeUri))
+  {
+    std::cerr << "Unable to write the included models to [" << modelDir
+              << "]\n";
+    return 1;
+  }
+
+  const std::string world = sdf::testing::GenerateWorld(options, includeUri);
+  if (output.empty())
+  {
+    std::cout << world;
+    return 0;
+  }
+
+  std::ofstream out(output);
+  out << world;
+  if (!out)
+  {
+    std::cerr << "Unable to write [" << output << "]\n";
+    return 1;
+  }
+  return 0;
+}
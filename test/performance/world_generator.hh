@@ -0,0 +1,277 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_TEST_PERFORMANCE_WORLD_GENERATOR_HH_
+#define SDF_TEST_PERFORMANCE_WORLD_GENERATOR_HH_
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+namespace testing
+{
+
+/// \brief Options of the synthetic worlds generated for the benchmarks.
+struct WorldGeneratorOptions
+{
+  /// \brief SDFormat version of the generated documents. Frames are only
+  /// generated for version 1.7 and later.
+  std::string version = SDF_VERSION;
+
+  /// \brief Number of models in the world.
+  int modelCount = 100;
+
+  /// \brief Number of links of each model, in a chain of revolute joints.
+  int linkDepth = 2;
+
+  /// \brief Depth of the nested <include>s. When not zero, each model of the
+  /// world is an <include> of a model file that includes another one, down
+  /// to this depth. The model files are written by WriteIncludedModels.
+  int includeDepth = 0;
+
+  /// \brief Number of frames of each model, each attached to the previous
+  /// one and the first to the last link.
+  int frameChainLength = 0;
+
+  /// \brief True to add an IMU sensor to each link and a camera to the
+  /// first one.
+  bool sensors = false;
+
+  /// \brief True to add a plugin with custom content to each model.
+  bool plugins = false;
+
+  /// \brief URI of a mesh used by the visuals instead of a box, or empty.
+  std::string meshUri;
+};
+
+/// \brief Generate the contents of a model, without the <model> element.
+/// \param[in] _options Generator options.
+/// \param[in] _includeUri URI of a model to include in this one, or empty.
+/// \return The contents of the model.
+inline std::string GenerateModelContents(
+    const WorldGeneratorOptions &_options, const std::string &_includeUri)
+{
+  const bool frames = _options.version != "1.4" &&
+      _options.version != "1.5" && _options.version != "1.6";
+
+  std::ostringstream str;
+  for (int l = 0; l < _options.linkDepth; ++l)
+  {
+    str << "  <link name='link" << l << "'>\n";
+    if (l > 0)
+      str << "    <pose>0 0 1 0 0 0</pose>\n";
+    str << "    <inertial>\n"
+        << "      <mass>1</mass>\n"
+        << "      <inertia><ixx>0.1</ixx><iyy>0.1</iyy><izz>0.1</izz>"
+        << "</inertia>\n"
+        << "    </inertial>\n"
+        << "    <collision name='collision'>\n"
+        << "      <geometry><box><size>0.5 0.5 1</size></box></geometry>\n"
+        << "    </collision>\n"
+        << "    <visual name='visual'>\n";
+    if (_options.meshUri.empty())
+    {
+      str << "      <geometry><box><size>0.5 0.5 1</size></box></geometry>\n";
+    }
+    else
+    {
+      str << "      <geometry><mesh><uri>" << _options.meshUri
+          << "</uri></mesh></geometry>\n";
+    }
+    str << "      <material><diffuse>0.8 0.2 0.2 1</diffuse></material>\n"
+        << "    </visual>\n";
+    if (_options.sensors)
+    {
+      str << "    <sensor name='imu' type='imu'>\n"
+          << "      <update_rate>100</update_rate>\n"
+          << "      <imu/>\n"
+          << "    </sensor>\n";
+      if (l == 0)
+      {
+        str << "    <sensor name='camera' type='camera'>\n"
+            << "      <pose>0.3 0 0 0 0 0</pose>\n"
+            << "      <camera>\n"
+            << "        <horizontal_fov>1.047</horizontal_fov>\n"
+            << "        <image><width>640</width><height>480</height>"
+            << "</image>\n"
+            << "        <clip><near>0.1</near><far>100</far></clip>\n"
+            << "      </camera>\n"
+            << "    </sensor>\n";
+      }
+    }
+    str << "  </link>\n";
+  }
+
+  for (int l = 1; l < _options.linkDepth; ++l)
+  {
+    str << "  <joint name='joint" << l << "' type='revolute'>\n"
+        << "    <parent>link" << l - 1 << "</parent>\n"
+        << "    <child>link" << l << "</child>\n"
+        << "    <axis>\n"
+        << "      <xyz>0 1 0</xyz>\n"
+        << "      <limit><lower>-1.57</lower><upper>1.57</upper></limit>\n"
+        << "    </axis>\n"
+        << "  </joint>\n";
+  }
+
+  if (frames && _options.linkDepth > 0)
+  {
+    for (int f = 0; f < _options.frameChainLength; ++f)
+    {
+      str << "  <frame name='frame" << f << "' attached_to='";
+      if (f == 0)
+        str << "link" << _options.linkDepth - 1;
+      else
+        str << "frame" << f - 1;
+      str << "'>\n"
+          << "    <pose>0 0 0.1 0 0 0</pose>\n"
+          << "  </frame>\n";
+    }
+  }
+
+  if (!_includeUri.empty())
+  {
+    str << "  <include>\n"
+        << "    <uri>" << _includeUri << "</uri>\n"
+        << "    <name>nested</name>\n"
+        << "    <pose>0 1 0 0 0 0</pose>\n"
+        << "  </include>\n";
+  }
+
+  if (_options.plugins)
+  {
+    str << "  <plugin name='controller' filename='libcontroller.so'>\n"
+        << "    <gain>1.5</gain>\n"
+        << "    <topic>/cmd</topic>\n"
+        << "  </plugin>\n";
+  }
+  return str.str();
+}
+
+/// \brief Write the model files included by the models of a generated world,
+/// one model directory with a model.config and a model.sdf for each level
+/// of WorldGeneratorOptions::includeDepth.
+/// \param[in] _options Generator options.
+/// \param[in] _dir Directory to write the model directories to.
+/// \param[out] _uri URI to include the first model with.
+/// \return True if the files were written, or if there are no includes.
+inline bool WriteIncludedModels(const WorldGeneratorOptions &_options,
+    const std::string &_dir, std::string &_uri)
+{
+  _uri.clear();
+  std::error_code ec;
+  // Write the deepest model first, so each one can refer to the next.
+  for (int d = _options.includeDepth - 1; d >= 0; --d)
+  {
+    const std::filesystem::path modelDir =
+        std::filesystem::absolute(_dir, ec) /
+        ("generated_model_" + std::to_string(d));
+    std::filesystem::create_directories(modelDir, ec);
+    if (ec)
+      return false;
+
+    std::ofstream config(modelDir / "model.config");
+    config << "<?xml version='1.0'?>\n"
+           << "<model>\n"
+           << "  <name>generated_model_" << d << "</name>\n"
+           << "  <sdf version='" << _options.version << "'>model.sdf</sdf>\n"
+           << "</model>\n";
+
+    std::ofstream model(modelDir / "model.sdf");
+    model << "<?xml version='1.0'?>\n"
+          << "<sdf version='" << _options.version << "'>\n"
+          << "<model name='generated_model_" << d << "'>\n"
+          << GenerateModelContents(_options, _uri)
+          << "</model>\n"
+          << "</sdf>\n";
+    if (!config || !model)
+      return false;
+
+    _uri = modelDir.string();
+  }
+  return true;
+}
+
+/// \brief Generate a model document with models nested in each other, each
+/// one with the contents of GenerateModelContents, so that the frame
+/// graphs have one scope for each level of nesting.
+/// \param[in] _options Generator options.
+/// \param[in] _depth Number of nested models below the top level model.
+/// \return The model document.
+inline std::string GenerateNestedModel(const WorldGeneratorOptions &_options,
+    int _depth)
+{
+  std::ostringstream str;
+  str << "<?xml version='1.0'?>\n"
+      << "<sdf version='" << _options.version << "'>\n";
+  for (int d = 0; d <= _depth; ++d)
+  {
+    str << "<model name='model" << d << "'>\n";
+    if (d > 0)
+      str << "  <pose>0 1 0 0 0 0</pose>\n";
+    str << GenerateModelContents(_options, "");
+  }
+  for (int d = 0; d <= _depth; ++d)
+    str << "</model>\n";
+  str << "</sdf>\n";
+  return str.str();
+}
+
+/// \brief Generate a world.
+/// \param[in] _options Generator options.
+/// \param[in] _includeUri URI given by WriteIncludedModels, used when
+/// WorldGeneratorOptions::includeDepth is not zero.
+/// \return The world document.
+inline std::string GenerateWorld(const WorldGeneratorOptions &_options,
+    const std::string &_includeUri = "")
+{
+  std::ostringstream str;
+  str << "<?xml version='1.0'?>\n"
+      << "<sdf version='" << _options.version << "'>\n"
+      << "<world name='default'>\n";
+  for (int i = 0; i < _options.modelCount; ++i)
+  {
+    const int x = i % 100;
+    const int y = i / 100;
+    if (_options.includeDepth > 0)
+    {
+      str << "<include>\n"
+          << "  <uri>" << _includeUri << "</uri>\n"
+          << "  <name>model" << i << "</name>\n"
+          << "  <pose>" << x << " " << y << " 0 0 0 0</pose>\n"
+          << "</include>\n";
+    }
+    else
+    {
+      str << "<model name='model" << i << "'>\n"
+          << "  <pose>" << x << " " << y << " 0 0 0 0</pose>\n"
+          << GenerateModelContents(_options, "")
+          << "</model>\n";
+    }
+  }
+  str << "</world>\n"
+      << "</sdf>\n";
+  return str.str();
+}
+
+}
+}
+#endif
@@ -52,6 +52,22 @@ namespace sdf
     UsdErrors IGNITION_SDFORMAT_USD_VISIBLE ParseSdfGeometry(
         const sdf::Geometry &_geometry, pxr::UsdStageRefPtr &_stage,
         const std::string &_path);
+
+    /// \brief Set the directory of the mesh cache. Each mesh file converted
+    /// by ParseSdfGeometry is stored there, converted to the buffers of USD
+    /// meshes, in a file named after a hash of the content of the mesh file.
+    /// Later conversions of a mesh file with the same content, including
+    /// the conversions of other processes, read the buffers from the cache
+    /// instead of loading and decoding the mesh file.
+    /// \param[in] _directory The directory, which is created when the first
+    /// mesh is stored. An empty string, the default, disables the cache.
+    void IGNITION_SDFORMAT_USD_VISIBLE SetMeshCacheDirectory(
+        const std::string &_directory);
+
+    /// \brief Get the directory of the mesh cache.
+    /// \return The directory, or an empty string if the cache is disabled.
+    /// \sa SetMeshCacheDirectory
+    std::string IGNITION_SDFORMAT_USD_VISIBLE MeshCacheDirectory();
   }
   }
 }
@@ -41,7 +41,9 @@ namespace sdf
   //
   namespace usd
   {
-    /// \brief Parse an SDF material into a USD stage.
+    /// \brief Parse an SDF material into a USD stage. Materials with the
+    /// same parameters are authored once per stage: later materials that
+    /// match one that was already authored get the path of its USD material.
     /// \param[in] _materialSdf The SDF material to parse.
     /// \param[in] _stage The stage that should contain the USD representation
     /// of _material.
@@ -26,6 +26,7 @@
 // included.
 #pragma push_macro ("__DEPRECATED")
 #undef __DEPRECATED
+#include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/usd/stage.h>
 #pragma pop_macro ("__DEPRECATED")
 
@@ -53,6 +54,57 @@ namespace sdf
         const sdf::World &_world,
         pxr::UsdStageRefPtr &_stage,
         const std::string &_path);
+
+    /// \brief Parse an SDF world into a USD stage, converting its models
+    /// concurrently. Each model is converted on a worker thread into a stage
+    /// of its own, and the prims of these stages are then copied, in the
+    /// order of the models, into the root layer of _stage. The result is the
+    /// same as the one of the serial overload.
+    /// \param[in] _world The SDF world to parse.
+    /// \param[in] _stage The stage that should contain the USD representation
+    /// of _world. It must be initialized first
+    /// \param[in] _path The USD path of the parsed world in _stage, which must
+    /// be a valid USD path.
+    /// \param[in] _threads Number of workers, which run on the threads of
+    /// sdf::TaskExecutor::Threaded(). 0 uses one worker per hardware thread,
+    /// and 1 converts the models serially on the calling thread.
+    /// \return UsdErrors, which is a vector of UsdError objects. Each UsdError
+    /// includes an error code and message. An empty vector indicates no error.
+    UsdErrors IGNITION_SDFORMAT_USD_VISIBLE ParseSdfWorld(
+        const sdf::World &_world,
+        pxr::UsdStageRefPtr &_stage,
+        const std::string &_path,
+        unsigned int _threads);
+
+    /// \brief Export an SDF world to a USD file, writing each model to a
+    /// layer of its own. Each model is converted into a stage that is saved
+    /// and released before the next model is converted, so the peak memory
+    /// is bounded by the largest model rather than by the whole world.
+    /// The exported file contains the world prim, its physics scene and its
+    /// lights, and lists the model layers as sublayers. The model layers are
+    /// written in a directory next to the file, named after the file with a
+    /// "_models" suffix, e.g. world_models/box.usd for world.usd. The
+    /// materials of each layer are named after the layer.
+    /// \param[in] _world The SDF world to export.
+    /// \param[in] _path The USD path of the world prim, which must be a
+    /// valid USD path.
+    /// \param[in] _fileName The USD file to write.
+    /// \param[in] _args File format arguments used to write the file and the
+    /// model layers, such as {"format", "usda"} for text .usd files.
+    /// \param[in] _incremental True to only author the layers of the models
+    /// that changed since the previous export. A manifest in the directory
+    /// of the layers records a hash of the element tree and resolved pose of
+    /// each model. Layers whose hash is unchanged are reused, and the layers
+    /// of models removed from the world are deleted. Changes to the files
+    /// used by a model, such as meshes and textures, are not detected.
+    /// \return UsdErrors, which is a vector of UsdError objects. Each UsdError
+    /// includes an error code and message. An empty vector indicates no error.
+    UsdErrors IGNITION_SDFORMAT_USD_VISIBLE ExportSdfWorldWithModelLayers(
+        const sdf::World &_world,
+        const std::string &_path,
+        const std::string &_fileName,
+        const pxr::SdfLayer::FileFormatArguments &_args = {},
+        bool _incremental = false);
   }
   }
 }
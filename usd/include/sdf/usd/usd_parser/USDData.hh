@@ -23,6 +23,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <ignition/utils/ImplPtr.hh>
 
@@ -62,11 +63,22 @@ namespace sdf
       /// an error code and message. An empty vector indicates no error.
       public: UsdErrors AddStage(const std::string &_ref);
 
-      /// \brief Read materials
+      /// \brief Read materials of the stage opened by Init
       /// \return A vector of Error objects. Each Error includes
       /// an error code and message. An empty vector indicates no error.
       public: UsdErrors ParseMaterials();
 
+      /// \brief Get the main stage, which Init opens once so that the
+      /// import does not need to open it again
+      /// \return The main stage, or a null pointer if Init was not called
+      /// or could not open it
+      public: pxr::UsdStageRefPtr Stage() const;
+
+      /// \brief Get the physics scene prims of the main stage, found by
+      /// Init while traversing the stage
+      /// \return The physics scene prims
+      public: const std::vector<pxr::UsdPrim> &PhysicsScenes() const;
+
       /// \brief Get all materials readed in the stage
       public: const std::unordered_map<std::string, sdf::Material> &
         Materials() const;
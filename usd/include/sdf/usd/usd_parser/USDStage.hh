@@ -18,11 +18,22 @@
 #ifndef SDF_USD_USD_PARSER_USDSTAGE_HH_
 #define SDF_USD_USD_PARSER_USDSTAGE_HH_
 
+#include <functional>
 #include <set>
 #include <string>
 
 #include <ignition/utils/ImplPtr.hh>
 
+// TODO(ahcorde) this is to remove deprecated "warnings" in usd, these warnings
+// are reported using #pragma message so normal diagnostic flags cannot remove
+// them. This workaround requires this block to be used whenever usd is
+// included.
+#pragma push_macro ("__DEPRECATED")
+#undef __DEPRECATED
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
+#pragma pop_macro ("__DEPRECATED")
+
 #include "sdf/Types.hh"
 #include "sdf/sdf_config.h"
 #include "sdf/system_util.hh"
@@ -51,6 +62,17 @@ namespace sdf
       /// an error code and message. An empty vector indicates no error.
       public: UsdErrors Init();
 
+      /// \brief Initialize the data structure from a stage that is already
+      /// open, in a single traversal of its prims.
+      /// \param[in] _stage The stage of the file given to the constructor
+      /// \param[in] _visitPrim Optional function called with every prim of
+      /// the stage during the traversal, so that callers can read the prims
+      /// without traversing the stage again
+      /// \return A vector of Error objects. Each Error includes
+      /// an error code and message. An empty vector indicates no error.
+      public: UsdErrors Init(const pxr::UsdStageRefPtr &_stage,
+          const std::function<void(const pxr::UsdPrim &)> &_visitPrim = {});
+
       /// \brief Get stage up axis
       public: const std::string &UpAxis() const;
 
@@ -18,6 +18,13 @@
 #ifndef SDF_USD_SDF_PARSER_UTILS_HH_
 #define SDF_USD_SDF_PARSER_UTILS_HH_
 
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
@@ -146,6 +153,88 @@ namespace sdf
       return collision->Geom()->Type() == sdf::GeometryType::PLANE;
     }
 
+    /// \brief Get the mutex that serializes the file lookups, file copies and
+    /// mesh loads of ign-common, which are not safe to run from more than one
+    /// thread at a time, while models are converted concurrently (see
+    /// ParseSdfWorld).
+    /// \return The mutex.
+    inline std::mutex &ResourceMutex()
+    {
+      static std::mutex mutex;
+      return mutex;
+    }
+
+    /// \brief Prefix of the names of the materials that ParseSdfMaterial
+    /// creates on the calling thread, set for the duration of a scope.
+    /// Layers that are authored separately and composed later use distinct
+    /// prefixes, so that their materials do not collide.
+    class ScopedMaterialNamePrefix
+    {
+      /// \brief Constructor.
+      /// \param[in] _prefix The prefix, which must be valid in a USD prim
+      /// name.
+      public: explicit ScopedMaterialNamePrefix(const std::string &_prefix)
+        : previous(Current())
+      {
+        Current() = _prefix;
+      }
+
+      /// \brief Destructor. Restores the previous prefix.
+      public: ~ScopedMaterialNamePrefix()
+      {
+        Current() = this->previous;
+      }
+
+      /// \brief No copy constructor.
+      public: ScopedMaterialNamePrefix(const ScopedMaterialNamePrefix &) =
+                  delete;
+
+      /// \brief No copy assignment.
+      public: ScopedMaterialNamePrefix &operator=(
+                  const ScopedMaterialNamePrefix &) = delete;
+
+      /// \brief Get the prefix of the calling thread.
+      /// \return Reference to the prefix, empty by default.
+      public: static std::string &Current()
+      {
+        static thread_local std::string prefix;
+        return prefix;
+      }
+
+      /// \brief Prefix that was set when this scope was created.
+      private: std::string previous;
+    };
+
+    /// \brief Offset basis of the 64 bit FNV-1a hash, which is the hash of
+    /// no data.
+    static const uint64_t kFnv1aOffsetBasis = 14695981039346656037ull;
+
+    /// \brief Add data to a 64 bit FNV-1a hash.
+    /// \param[in] _data The data.
+    /// \param[in] _size Number of bytes of _data.
+    /// \param[in] _hash Hash of the data that precedes _data.
+    /// \return The hash of the preceding data followed by _data.
+    inline uint64_t Fnv1aHash(const char *_data, std::size_t _size,
+        uint64_t _hash = kFnv1aOffsetBasis)
+    {
+      for (std::size_t i = 0; i < _size; ++i)
+      {
+        _hash ^= static_cast<unsigned char>(_data[i]);
+        _hash *= 1099511628211ull;
+      }
+      return _hash;
+    }
+
+    /// \brief Format a hash as a string.
+    /// \param[in] _hash The hash.
+    /// \return The hash as 16 hexadecimal digits.
+    inline std::string HashString(uint64_t _hash)
+    {
+      std::ostringstream hex;
+      hex << std::hex << std::setw(16) << std::setfill('0') << _hash;
+      return hex.str();
+    }
+
     /// \brief Pre-defined USD plane thickness. This is a temporary variable
     /// that will no longer be needed once USD supports their own plane class
     static const double kPlaneThickness = 0.25;
@@ -28,10 +28,12 @@
 // included.
 #pragma push_macro ("__DEPRECATED")
 #undef __DEPRECATED
+#include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/usd/stage.h>
 #pragma pop_macro ("__DEPRECATED")
 
 #include "sdf/sdf.hh"
+#include "sdf/usd/sdf_parser/Geometry.hh"
 #include "sdf/usd/sdf_parser/World.hh"
 
 //////////////////////////////////////////////////
@@ -53,6 +55,24 @@ struct Options
 
   /// \brief output filename
   std::string outputFilename{"output.usd"};
+
+  /// \brief Number of threads converting the models, 0 for one per
+  /// hardware thread
+  unsigned int jobs{1};
+
+  /// \brief Write each model to a layer of its own, one model at a time
+  bool modelLayers{false};
+
+  /// \brief Only author the model layers of the models that changed since
+  /// the previous export, implies modelLayers
+  bool incremental{false};
+
+  /// \brief Encoding of output files with the .usd extension, "usdc" for
+  /// binary crate files or "usda" for text files
+  std::string format{"usdc"};
+
+  /// \brief Directory of the mesh cache, empty to disable the cache
+  std::string meshCache;
 };
 
 //////////////////////////////////////////////////
@@ -238,10 +258,38 @@ void runCommand(const Options &_opt)
     exit(-4);
   }
 
-  auto stage = pxr::UsdStage::CreateInMemory();
+  // The .usda and .usdc extensions determine the encoding of the output, the
+  // .usd extension can hold either of them
+  pxr::SdfLayer::FileFormatArguments formatArgs;
+  if (ignition::common::lowercase(
+        _opt.outputFilename.substr(_opt.outputFilename.rfind('.') + 1)) ==
+      "usd")
+  {
+    formatArgs["format"] = _opt.format;
+  }
+
+  sdf::usd::SetMeshCacheDirectory(_opt.meshCache);
 
   const auto worldPath = std::string("/" + world->Name());
-  auto usdErrors = sdf::usd::ParseSdfWorld(*world, stage, worldPath);
+  if (_opt.modelLayers || _opt.incremental)
+  {
+    auto usdErrors = sdf::usd::ExportSdfWorldWithModelLayers(
+        *world, worldPath, _opt.outputFilename, formatArgs, _opt.incremental);
+    if (!usdErrors.empty())
+    {
+      std::cerr << "The following errors occurred when exporting world ["
+                << world->Name() << "]:" << std::endl;
+      for (const auto &e : usdErrors)
+        std::cout << e << "\n";
+      exit(-5);
+    }
+    return;
+  }
+
+  auto stage = pxr::UsdStage::CreateInMemory();
+
+  auto usdErrors =
+    sdf::usd::ParseSdfWorld(*world, stage, worldPath, _opt.jobs);
   if (!usdErrors.empty())
   {
     std::cerr << "The following errors occurred when parsing world ["
@@ -251,7 +299,7 @@ void runCommand(const Options &_opt)
     exit(-5);
   }
 
-  if (!stage->GetRootLayer()->Export(_opt.outputFilename))
+  if (!stage->GetRootLayer()->Export(_opt.outputFilename, "", formatArgs))
   {
     std::cerr << "Issue saving USD to " << _opt.outputFilename << "\n";
     exit(-6);
@@ -270,6 +318,40 @@ void addFlags(CLI::App &_app)
     opt->outputFilename,
     "Output filename. Defaults to output.usd unless otherwise specified.");
 
+  _app.add_option("-j,--jobs",
+    opt->jobs,
+    "Number of threads converting the models of the world concurrently. "
+    "0 uses one thread per hardware thread. Defaults to 1.");
+
+  _app.add_flag("--model-layers",
+    opt->modelLayers,
+    "Write each model to a layer of its own, in a <output>_models "
+    "directory, converting and saving one model at a time to bound the "
+    "memory used by large worlds. The output file lists the model layers "
+    "as sublayers. Models are converted serially in this mode.");
+
+  _app.add_flag("--incremental",
+    opt->incremental,
+    "Like --model-layers, but only convert the models that changed since "
+    "the previous export to the same output, as recorded in "
+    "<output>_models/manifest.txt. The layers of unchanged models are "
+    "reused.");
+
+  _app.add_option("-f,--format",
+    opt->format,
+    "Encoding of output files with the .usd extension: usdc for binary "
+    "files or usda for text files. Defaults to usdc. Files with the .usda "
+    "or .usdc extension are always written in the encoding of their "
+    "extension.")
+    ->check(CLI::IsMember({"usda", "usdc"}));
+
+  _app.add_option("--mesh-cache",
+    opt->meshCache,
+    "Directory of a cache of the converted meshes, shared by all the "
+    "conversions that use it. Meshes whose files have the same content as "
+    "a mesh already in the cache are read from the cache instead of being "
+    "loaded and decoded again.");
+
   _app.callback([&_app, opt](){
     runCommand(*opt);
   });
@@ -17,9 +17,12 @@
 
 #include "sdf/usd/sdf_parser/Geometry.hh"
 
+#include <functional>
+#include <mutex>
 #include <string>
 
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
 #include <ignition/common/Mesh.hh>
 #include <ignition/common/MeshManager.hh>
 #include <ignition/common/Util.hh>
@@ -35,8 +38,10 @@
 #undef __DEPRECATED
 #include <pxr/base/gf/vec2f.h>
 #include <pxr/base/gf/vec3f.h>
+#include <pxr/base/tf/stringUtils.h>
 #include <pxr/base/vt/array.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/references.h>
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usdGeom/capsule.h>
 #include <pxr/usd/usdGeom/cube.h>
@@ -58,10 +63,10 @@
 #include "sdf/Mesh.hh"
 #include "sdf/Plane.hh"
 #include "sdf/Sphere.hh"
-#include "sdf/usd/Conversions.hh"
 #include "sdf/usd/sdf_parser/Material.hh"
 
 #include "../UsdUtils.hh"
+#include "MeshCache.hh"
 
 namespace sdf
 {
@@ -70,6 +75,11 @@ inline namespace SDF_VERSION_NAMESPACE {
 //
 namespace usd
 {
+  /// \brief Path of the class prim that contains the prototypes of the meshes
+  /// that are referenced by the mesh geometries. Being abstract, the
+  /// prototypes are not rendered or traversed by default.
+  static const char kMeshPrototypesPath[] = "/MeshPrototypes";
+
   /// \brief Parse a SDF box geometry into a USD box geometry
   /// \param[in] _geometry The SDF box geometry
   /// \param[in] _stage The stage that will contain the parsed USD equivalent
@@ -183,6 +193,115 @@ namespace usd
     return errors;
   }
 
+  /// \brief Author the vertices, indices, texture coordinates and normals
+  /// of a submesh on a USD mesh, which is used as a prototype referenced by
+  /// every geometry that uses the submesh.
+  /// \param[in] _subMesh The submesh, with its buffers
+  /// \param[in] _mesh The mesh that contains _subMesh
+  /// \param[in] _stage The stage that will contain the prototype
+  /// \param[in] _path Where the prototype should exist in _stage
+  /// \return UsdErrors, which is a vector of UsdError objects. Each UsdError
+  /// includes an error code and message. An empty vector indicates no error
+  /// occurred when creating the prototype
+  UsdErrors ParseSdfSubMeshPrototype(const SubMeshData &_subMesh,
+    const MeshData &_mesh, pxr::UsdStageRefPtr &_stage,
+    const pxr::SdfPath &_path)
+  {
+    UsdErrors errors;
+
+    // set the usd mesh's "faceVertexCounts" array according to
+    // the submesh primitive type
+    // TODO(adlarkin) support all primitive types. The computations are more
+    // involved for LINESTRIPS, TRIFANS, and TRISTRIPS. I will need to spend
+    // some time deriving what the number of faces for these primitive types
+    // are, given the number of indices. The "faceVertexCounts" array will
+    // also not have the same value for every element in the array for these
+    // more complex primitive types (see the TODO note in the for loop below)
+    unsigned int verticesPerFace = 0;
+    unsigned int numFaces = 0;
+    switch (_subMesh.primitiveType)
+    {
+      case ignition::common::SubMesh::PrimitiveType::POINTS:
+        verticesPerFace = 1;
+        numFaces = _subMesh.indices.size();
+        break;
+      case ignition::common::SubMesh::PrimitiveType::LINES:
+        verticesPerFace = 2;
+        numFaces = _subMesh.indices.size() / 2;
+        break;
+      case ignition::common::SubMesh::PrimitiveType::TRIANGLES:
+        verticesPerFace = 3;
+        numFaces = _subMesh.indices.size() / 3;
+        break;
+      case ignition::common::SubMesh::PrimitiveType::LINESTRIPS:
+      case ignition::common::SubMesh::PrimitiveType::TRIFANS:
+      case ignition::common::SubMesh::PrimitiveType::TRISTRIPS:
+      default:
+        errors.push_back(UsdError(
+              sdf::usd::UsdErrorCode::INVALID_SUBMESH_PRIMITIVE_TYPE,
+              "Submesh " + _subMesh.name + " has a primitive type that is "
+              "not supported."));
+        return errors;
+    }
+    // TODO(adlarkin) update this loop to allow for varying element
+    // values in the array (see TODO note above). Right now, the
+    // array only allows for all elements to have one value, which in
+    // this case is "verticesPerFace"
+    const pxr::VtArray<int> faceVertexCounts(
+        numFaces, static_cast<int>(verticesPerFace));
+
+    auto usdMesh = pxr::UsdGeomMesh::Define(_stage, _path);
+    if (!usdMesh)
+    {
+      errors.push_back(UsdError(sdf::usd::UsdErrorCode::FAILED_USD_DEFINITION,
+          "Unable to define a USD mesh geometry at path ["
+          + _path.GetString() + "]"));
+      return errors;
+    }
+    usdMesh.CreatePointsAttr().Set(_subMesh.points);
+    usdMesh.CreateFaceVertexIndicesAttr().Set(_subMesh.indices);
+    usdMesh.CreateFaceVertexCountsAttr().Set(faceVertexCounts);
+
+    auto coordinates = usdMesh.CreatePrimvar(
+        pxr::TfToken("st"), pxr::SdfValueTypeNames->Float2Array,
+        pxr::UsdGeomTokens->vertex);
+    coordinates.Set(_subMesh.uvs);
+
+    usdMesh.CreateNormalsAttr().Set(_subMesh.normals);
+    usdMesh.SetNormalsInterpolation(pxr::TfToken("vertex"));
+
+    usdMesh.CreateSubdivisionSchemeAttr(pxr::VtValue(pxr::TfToken("none")));
+
+    const auto &meshMin = _mesh.min;
+    const auto &meshMax = _mesh.max;
+    pxr::VtArray<pxr::GfVec3f> extentBounds;
+    extentBounds.push_back(
+      pxr::GfVec3f(meshMin.X(), meshMin.Y(), meshMin.Z()));
+    extentBounds.push_back(
+      pxr::GfVec3f(meshMax.X(), meshMax.Y(), meshMax.Z()));
+    usdMesh.CreateExtentAttr().Set(extentBounds);
+
+    return errors;
+  }
+
+  /// \brief Get the path of the prototype of a mesh on a stage.
+  /// \param[in] _fullName Full path of the mesh file
+  /// \param[in] _subMeshName Name of the only submesh of the mesh that is
+  /// used, or an empty string if all the submeshes are used
+  /// \return The path of the prim that contains the prototypes of the
+  /// submeshes, below the kMeshPrototypesPath class prim
+  pxr::SdfPath meshPrototypePath(const std::string &_fullName,
+    const std::string &_subMeshName)
+  {
+    const std::string key = _fullName + "#" + _subMeshName;
+    // The file name makes the prototypes readable, the hash of the full key
+    // keeps meshes with the same file name in different directories apart.
+    const std::string name = pxr::TfMakeValidIdentifier(
+        ignition::common::basename(_fullName) + "_" + _subMeshName) + "_" +
+      std::to_string(std::hash<std::string>()(key));
+    return pxr::SdfPath(kMeshPrototypesPath).AppendChild(pxr::TfToken(name));
+  }
+
   /// \brief Parse a SDF mesh geometry into a USD mesh geometry
   /// \param[in] _geometry The SDF mesh geometry
   /// \param[in] _stage The stage that will contain the parsed USD equivalent
@@ -197,6 +316,8 @@ namespace usd
   {
     UsdErrors errors;
 
+    std::unique_lock<std::mutex> resourceLock(ResourceMutex());
+
     ignition::common::URI uri(_geometry.MeshShape()->Uri());
     std::string fullName;
 
@@ -211,14 +332,25 @@ namespace usd
         ignition::common::findFile(_geometry.MeshShape()->Uri());
     }
 
-    auto ignMesh = ignition::common::MeshManager::Instance()->Load(
-        fullName);
-    if (!ignMesh)
+    // When the mesh is in the mesh cache, the mesh file is not loaded and
+    // only the description of the mesh is read until its buffers are needed
+    const std::string cacheFile = MeshCacheFile(fullName);
+    MeshData meshData;
+    const ignition::common::Mesh *ignMesh = nullptr;
+    if (cacheFile.empty() || !ReadMeshCache(cacheFile, meshData, false))
     {
-      errors.push_back(UsdError(sdf::usd::UsdErrorCode::MESH_LOAD_FAILURE,
-              "Unable to load mesh named [" + fullName + "]"));
-      return errors;
+      ignMesh = ignition::common::MeshManager::Instance()->Load(fullName);
+      if (!ignMesh)
+      {
+        errors.push_back(UsdError(sdf::usd::UsdErrorCode::MESH_LOAD_FAILURE,
+                "Unable to load mesh named [" + fullName + "]"));
+        return errors;
+      }
+      UsdErrors meshErrors = ConvertMesh(*ignMesh, meshData);
+      if (!meshErrors.empty())
+        return meshErrors;
     }
+    resourceLock.unlock();
 
     // If a mesh has more than one submesh, only process the submesh who's name
     // is a part of the USD path
@@ -229,130 +361,93 @@ namespace usd
     // most meshes
     bool subMeshNameInUsdPath = false;
     std::string targetSubMeshName = "";
-    if (ignMesh->SubMeshCount() > 1)
+    if (meshData.subMeshes.size() > 1)
     {
-      for (unsigned int i = 0; i < ignMesh->SubMeshCount(); ++i)
+      for (const auto &subMesh : meshData.subMeshes)
       {
-        auto subMesh = ignMesh->SubMeshByIndex(i).lock();
-        if (!subMesh)
-        {
-          errors.push_back(UsdError(sdf::usd::UsdErrorCode::MESH_LOAD_FAILURE,
-                "Unable to get a shared pointer to submesh at index ["
-                + std::to_string(i) + "] of parent mesh [" + ignMesh->Name()
-                + "]"));
-          return errors;
-        }
-
         std::string pathLowerCase = ignition::common::lowercase(_path);
         std::string subMeshLowerCase =
-          ignition::common::lowercase(subMesh->Name());
+          ignition::common::lowercase(subMesh.name);
 
         if (pathLowerCase.find(subMeshLowerCase) != std::string::npos)
         {
           subMeshNameInUsdPath = true;
-          targetSubMeshName = subMesh->Name();
+          targetSubMeshName = subMesh.name;
           break;
         }
       }
     }
 
-    for (unsigned int i = 0; i < ignMesh->SubMeshCount(); ++i)
+    // Each mesh is authored once per stage, under a prototype prim, and every
+    // geometry that uses it references the prototype. The path of the
+    // prototype only depends on the mesh file and the selected submesh, so
+    // the prototypes already authored on the stage are found by path.
+    const pxr::SdfPath prototypePath =
+      meshPrototypePath(fullName, targetSubMeshName);
+    const bool prototypeAuthored =
+      static_cast<bool>(_stage->GetPrimAtPath(prototypePath));
+    if (!prototypeAuthored)
     {
-      pxr::VtArray<pxr::GfVec3f> meshPoints;
-      pxr::VtArray<pxr::GfVec2f> uvs;
-      pxr::VtArray<pxr::GfVec3f> normals;
-      pxr::VtArray<int> faceVertexIndices;
-      pxr::VtArray<int> faceVertexCounts;
-
-      auto subMesh = ignMesh->SubMeshByIndex(i).lock();
-      if (!subMesh)
+      _stage->CreateClassPrim(prototypePath.GetParentPath());
+      if (!_stage->DefinePrim(prototypePath))
       {
-        errors.push_back(UsdError(sdf::usd::UsdErrorCode::MESH_LOAD_FAILURE,
-              "Unable to get a shared pointer to submesh at index ["
-              + std::to_string(i) + "] of parent mesh [" + ignMesh->Name()
-              + "]"));
+        errors.push_back(UsdError(sdf::usd::UsdErrorCode::FAILED_USD_DEFINITION,
+            "Unable to define a mesh prototype at path ["
+            + prototypePath.GetString() + "]"));
         return errors;
       }
 
-      if (subMeshNameInUsdPath && (subMesh->Name() != targetSubMeshName))
+      // The buffers are read from the mesh cache, or converted from the mesh
+      // and stored in the cache
+      resourceLock.lock();
+      if (ignMesh)
       {
-        continue;
+        UsdErrors bufferErrors = ConvertMeshBuffers(*ignMesh, meshData);
+        if (!bufferErrors.empty())
+          return bufferErrors;
+        if (!cacheFile.empty() && !WriteMeshCache(cacheFile, meshData))
+        {
+          ignwarn << "Unable to write the mesh cache file [" << cacheFile
+                  << "] of mesh [" << fullName << "]\n";
+        }
       }
-
-      // copy the submesh's vertices to the usd mesh's "points" array
-      for (unsigned int v = 0; v < subMesh->VertexCount(); ++v)
+      else if (!ReadMeshCache(cacheFile, meshData, true))
       {
-        const auto &vertex = subMesh->Vertex(v);
-        meshPoints.push_back(pxr::GfVec3f(vertex.X(), vertex.Y(), vertex.Z()));
+        errors.push_back(UsdError(sdf::usd::UsdErrorCode::MESH_LOAD_FAILURE,
+              "Unable to read mesh named [" + fullName
+              + "] from the mesh cache file [" + cacheFile + "]"));
+        return errors;
       }
+      resourceLock.unlock();
+    }
 
-      // copy the submesh's indices to the usd mesh's "faceVertexIndices" array
-      for (unsigned int j = 0; j < subMesh->IndexCount(); ++j)
-        faceVertexIndices.push_back(subMesh->Index(j));
-
-      // copy the submesh's texture coordinates
-      for (unsigned int j = 0; j < subMesh->TexCoordCount(); ++j)
+    for (unsigned int i = 0; i < meshData.subMeshes.size(); ++i)
+    {
+      const SubMeshData &subMesh = meshData.subMeshes[i];
+      if (subMeshNameInUsdPath && (subMesh.name != targetSubMeshName))
       {
-        const auto &uv = subMesh->TexCoord(j);
-        uvs.push_back(pxr::GfVec2f(uv[0], 1 - uv[1]));
+        continue;
       }
 
-      // copy the submesh's normals
-      for (unsigned int j = 0; j < subMesh->NormalCount(); ++j)
-      {
-        const auto &normal = subMesh->Normal(j);
-        normals.push_back(pxr::GfVec3f(normal[0], normal[1], normal[2]));
-      }
+      std::string subMeshPrimName;
+      if (!subMesh.name.empty())
+        subMeshPrimName = subMesh.name;
+      else
+        subMeshPrimName = "submesh_" + std::to_string(i);
+      subMeshPrimName = ignition::common::replaceAll(subMeshPrimName, "-", "_");
+      const pxr::SdfPath prototypeSubMeshPath =
+        prototypePath.AppendChild(pxr::TfToken(subMeshPrimName));
 
-      // set the usd mesh's "faceVertexCounts" array according to
-      // the submesh primitive type
-      // TODO(adlarkin) support all primitive types. The computations are more
-      // involved for LINESTRIPS, TRIFANS, and TRISTRIPS. I will need to spend
-      // some time deriving what the number of faces for these primitive types
-      // are, given the number of indices. The "faceVertexCounts" array will
-      // also not have the same value for every element in the array for these
-      // more complex primitive types (see the TODO note in the for loop below)
-      unsigned int verticesPerFace = 0;
-      unsigned int numFaces = 0;
-      switch (subMesh->SubMeshPrimitiveType())
+      if (!prototypeAuthored)
       {
-        case ignition::common::SubMesh::PrimitiveType::POINTS:
-          verticesPerFace = 1;
-          numFaces = subMesh->IndexCount();
-          break;
-        case ignition::common::SubMesh::PrimitiveType::LINES:
-          verticesPerFace = 2;
-          numFaces = subMesh->IndexCount() / 2;
-          break;
-        case ignition::common::SubMesh::PrimitiveType::TRIANGLES:
-          verticesPerFace = 3;
-          numFaces = subMesh->IndexCount() / 3;
-          break;
-        case ignition::common::SubMesh::PrimitiveType::LINESTRIPS:
-        case ignition::common::SubMesh::PrimitiveType::TRIFANS:
-        case ignition::common::SubMesh::PrimitiveType::TRISTRIPS:
-        default:
-          errors.push_back(UsdError(
-                sdf::usd::UsdErrorCode::INVALID_SUBMESH_PRIMITIVE_TYPE,
-                "Submesh " + subMesh->Name() + " has a primitive type that is "
-                "not supported."));
-          return errors;
+        UsdErrors prototypeErrors = ParseSdfSubMeshPrototype(
+            subMesh, meshData, _stage, prototypeSubMeshPath);
+        if (!prototypeErrors.empty())
+          return prototypeErrors;
       }
-      // TODO(adlarkin) update this loop to allow for varying element
-      // values in the array (see TODO note above). Right now, the
-      // array only allows for all elements to have one value, which in
-      // this case is "verticesPerFace"
-      for (unsigned int n = 0; n < numFaces; ++n)
-        faceVertexCounts.push_back(verticesPerFace);
-
-      std::string primName;
-      if (!subMesh->Name().empty())
-        primName = _path + "/" + subMesh->Name();
-      else
-        primName = _path + "/submesh_" + std::to_string(i);
-
-      primName = ignition::common::replaceAll(primName, "-", "_");
 
+      const std::string primName =
+        ignition::common::replaceAll(_path, "-", "_") + "/" + subMeshPrimName;
       auto usdMesh = pxr::UsdGeomMesh::Define(_stage, pxr::SdfPath(primName));
       if (!usdMesh)
       {
@@ -360,37 +455,19 @@ namespace usd
             "Unable to define a USD mesh geometry at path [" + primName + "]"));
         return errors;
       }
-      usdMesh.CreatePointsAttr().Set(meshPoints);
-      usdMesh.CreateFaceVertexIndicesAttr().Set(faceVertexIndices);
-      usdMesh.CreateFaceVertexCountsAttr().Set(faceVertexCounts);
-
-      auto coordinates = usdMesh.CreatePrimvar(
-          pxr::TfToken("st"), pxr::SdfValueTypeNames->Float2Array,
-          pxr::UsdGeomTokens->vertex);
-      coordinates.Set(uvs);
-
-      usdMesh.CreateNormalsAttr().Set(normals);
-      usdMesh.SetNormalsInterpolation(pxr::TfToken("vertex"));
-
-      usdMesh.CreateSubdivisionSchemeAttr(pxr::VtValue(pxr::TfToken("none")));
-
-      const auto &meshMin = ignMesh->Min();
-      const auto &meshMax = ignMesh->Max();
-      pxr::VtArray<pxr::GfVec3f> extentBounds;
-      extentBounds.push_back(
-        pxr::GfVec3f(meshMin.X(), meshMin.Y(), meshMin.Z()));
-      extentBounds.push_back(
-        pxr::GfVec3f(meshMax.X(), meshMax.Y(), meshMax.Z()));
-      usdMesh.CreateExtentAttr().Set(extentBounds);
-
-      // TODO(adlarkin) update this call in sdf13 to avoid casting the index to
-      // an int:
-      // https://github.com/ignitionrobotics/ign-common/pull/319
-      int materialIndex = subMesh->MaterialIndex();
-      if (materialIndex != -1)
+      if (!usdMesh.GetPrim().GetReferences().AddInternalReference(
+            prototypeSubMeshPath))
+      {
+        errors.push_back(UsdError(
+            sdf::usd::UsdErrorCode::SDF_TO_USD_PARSING_ERROR,
+            "Unable to reference the mesh prototype at path ["
+            + prototypeSubMeshPath.GetString() + "] from [" + primName + "]"));
+        return errors;
+      }
+
+      if (subMesh.material)
       {
-        const auto material = ignMesh->MaterialByIndex(materialIndex).get();
-        const sdf::Material materialSdf = sdf::usd::convert(material);
+        const sdf::Material &materialSdf = *subMesh.material;
         pxr::SdfPath materialPath;
         UsdErrors materialErrors = ParseSdfMaterial(
           &materialSdf, _stage, materialPath);
@@ -398,9 +475,8 @@ namespace usd
         {
           errors.push_back(UsdError(
             sdf::usd::UsdErrorCode::SDF_TO_USD_PARSING_ERROR,
-            "Unable to convert material [" + std::to_string(materialIndex)
-            + "] of submesh named [" + subMesh->Name()
-            + "] to a USD material."));
+            "Unable to convert the material of submesh named ["
+            + subMesh.name + "] to a USD material."));
           return errors;
         }
 
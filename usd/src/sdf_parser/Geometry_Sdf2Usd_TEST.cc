@@ -19,6 +19,7 @@
 
 #include <gtest/gtest.h>
 
+#include <ignition/common/Filesystem.hh>
 #include <ignition/common/Util.hh>
 
 // TODO(ahcorde) this is to remove deprecated "warnings" in usd, these warnings
@@ -38,8 +39,12 @@
 #include <pxr/usd/usd/stage.h>
 #pragma pop_macro ("__DEPRECATED")
 
+#include "sdf/usd/sdf_parser/Geometry.hh"
 #include "sdf/usd/sdf_parser/World.hh"
+#include "sdf/Link.hh"
+#include "sdf/Model.hh"
 #include "sdf/Root.hh"
+#include "sdf/Visual.hh"
 #include "test_config.h"
 #include "test_utils.hh"
 #include "../UsdTestUtils.hh"
@@ -293,4 +298,109 @@ TEST_F(UsdStageFixture, Geometry)
   pxr::TfToken subdivisionScheme;
   usdMesh.GetSubdivisionSchemeAttr().Get(&subdivisionScheme);
   EXPECT_EQ(pxr::TfToken("none"), subdivisionScheme);
+
+  // The mesh data is authored once, on an abstract prototype that is
+  // referenced by every geometry using the mesh
+  EXPECT_TRUE(meshGeometry.HasAuthoredReferences());
+  const auto prototypes = this->stage->GetPrimAtPath(
+      pxr::SdfPath("/MeshPrototypes"));
+  ASSERT_TRUE(prototypes);
+  EXPECT_TRUE(prototypes.IsAbstract());
+  ASSERT_EQ(1u, prototypes.GetAllChildren().size());
+
+  const auto meshVisual = world->ModelByName("mesh")->LinkByIndex(0u)
+    ->VisualByIndex(0u);
+  ASSERT_NE(nullptr, meshVisual);
+  const std::string otherGeometryPath = meshVisualPath + "/other_geometry";
+  EXPECT_TRUE(sdf::usd::ParseSdfGeometry(*meshVisual->Geom(), this->stage,
+      otherGeometryPath).empty());
+  EXPECT_EQ(1u, prototypes.GetAllChildren().size());
+  const auto otherMeshGeometry = pxr::UsdGeomMesh(this->stage->GetPrimAtPath(
+      pxr::SdfPath(otherGeometryPath + "/Cube")));
+  ASSERT_TRUE(otherMeshGeometry);
+  EXPECT_TRUE(otherMeshGeometry.GetPrim().HasAuthoredReferences());
+  pxr::VtArray<pxr::GfVec3f> otherPoints;
+  otherMeshGeometry.GetPointsAttr().Get(&otherPoints);
+  EXPECT_EQ(points, otherPoints);
+}
+
+/////////////////////////////////////////////////
+TEST_F(UsdStageFixture, MeshCache)
+{
+  sdf::setFindCallback(sdf::usd::testing::findFileCb);
+  ignition::common::addFindFileURICallback(
+    std::bind(&sdf::usd::testing::FindResourceUri, std::placeholders::_1));
+
+  const auto path = sdf::testing::TestFile("sdf", "basic_shapes.sdf");
+  sdf::Root root;
+
+  ASSERT_TRUE(sdf::testing::LoadSdfFile(path, root));
+  ASSERT_EQ(1u, root.WorldCount());
+  const auto world = root.WorldByIndex(0u);
+  const auto meshVisual = world->ModelByName("mesh")->LinkByIndex(0u)
+    ->VisualByIndex(0u);
+  ASSERT_NE(nullptr, meshVisual);
+
+  const std::string cacheDir = ignition::common::joinPaths(
+      ignition::common::cwd(), "mesh_cache");
+  EXPECT_TRUE(sdf::usd::MeshCacheDirectory().empty());
+  sdf::usd::SetMeshCacheDirectory(cacheDir);
+  sdf::testing::ScopeExit removeCache(
+      [&]
+      {
+        sdf::usd::SetMeshCacheDirectory("");
+        ignition::common::removeAll(cacheDir);
+      });
+  EXPECT_EQ(cacheDir, sdf::usd::MeshCacheDirectory());
+
+  // The first conversion stores the mesh in the cache
+  const std::string geometryPath = "/mesh_geometry";
+  EXPECT_TRUE(sdf::usd::ParseSdfGeometry(*meshVisual->Geom(), this->stage,
+      geometryPath).empty());
+  std::size_t cacheFiles = 0;
+  for (ignition::common::DirIter file(cacheDir);
+       file != ignition::common::DirIter(); ++file)
+  {
+    EXPECT_EQ(".mesh", (*file).substr((*file).size() - 5));
+    ++cacheFiles;
+  }
+  EXPECT_EQ(1u, cacheFiles);
+
+  // A conversion to another stage reads the mesh from the cache, with the
+  // same buffers
+  auto cachedStage = pxr::UsdStage::CreateInMemory();
+  EXPECT_TRUE(sdf::usd::ParseSdfGeometry(*meshVisual->Geom(), cachedStage,
+      geometryPath).empty());
+
+  const std::string meshPath = geometryPath + "/Cube";
+  const auto usdMesh = pxr::UsdGeomMesh(
+      this->stage->GetPrimAtPath(pxr::SdfPath(meshPath)));
+  const auto cachedMesh = pxr::UsdGeomMesh(
+      cachedStage->GetPrimAtPath(pxr::SdfPath(meshPath)));
+  ASSERT_TRUE(usdMesh);
+  ASSERT_TRUE(cachedMesh);
+
+  pxr::VtArray<pxr::GfVec3f> points;
+  pxr::VtArray<pxr::GfVec3f> cachedPoints;
+  usdMesh.GetPointsAttr().Get(&points);
+  cachedMesh.GetPointsAttr().Get(&cachedPoints);
+  EXPECT_EQ(24u, cachedPoints.size());
+  EXPECT_EQ(points, cachedPoints);
+
+  pxr::VtIntArray indices;
+  pxr::VtIntArray cachedIndices;
+  usdMesh.GetFaceVertexIndicesAttr().Get(&indices);
+  cachedMesh.GetFaceVertexIndicesAttr().Get(&cachedIndices);
+  EXPECT_EQ(36u, cachedIndices.size());
+  EXPECT_EQ(indices, cachedIndices);
+
+  pxr::VtArray<pxr::GfVec3f> normals;
+  pxr::VtArray<pxr::GfVec3f> cachedNormals;
+  usdMesh.GetNormalsAttr().Get(&normals);
+  cachedMesh.GetNormalsAttr().Get(&cachedNormals);
+  EXPECT_EQ(normals, cachedNormals);
+
+  pxr::VtArray<pxr::GfVec3f> extent;
+  cachedMesh.GetExtentAttr().Get(&extent);
+  this->CheckExtent(extent, pxr::GfVec3f(-1, -1.000001, -1), pxr::GfVec3f(1));
 }
@@ -17,8 +17,14 @@
 
 #include "sdf/usd/sdf_parser/Material.hh"
 
+#include <atomic>
+#include <iomanip>
+#include <limits>
 #include <map>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <utility>
 
 #include <ignition/common/Filesystem.hh>
 #include <ignition/common/Util.hh>
@@ -35,12 +41,15 @@
 #include <pxr/base/tf/stringUtils.h>
 #include <pxr/usd/sdf/types.h>
 #include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usdShade/connectableAPI.h>
 #include <pxr/usd/usdShade/materialBindingAPI.h>
 #pragma pop_macro ("__DEPRECATED")
 
 #include "sdf/Pbr.hh"
 
+#include "../UsdUtils.hh"
+
 namespace sdf
 {
 // Inline bracket to help doxygen filtering.
@@ -56,6 +65,7 @@ namespace usd
   {
     if (!_path.empty() && !_fullPath.empty())
     {
+      std::lock_guard<std::mutex> lock(ResourceMutex());
       auto fileName = ignition::common::basename(_path);
       auto filePathIndex = _path.rfind(fileName);
       auto filePath = _path.substr(0, filePathIndex);
@@ -68,6 +78,16 @@ namespace usd
     return false;
   }
 
+  /// \brief Find a texture file
+  /// \param[in] _uri URI of the texture
+  /// \return The full path of the texture, or an empty string if it could
+  /// not be found
+  std::string findTexture(const std::string &_uri)
+  {
+    std::lock_guard<std::mutex> lock(ResourceMutex());
+    return ignition::common::findFile(ignition::common::basename(_uri));
+  }
+
   /// \brief Get the path to copy the material to
   /// \param[in] _uri full path of the file to copy
   /// \return A relative path to save the material. The path looks like:
@@ -153,7 +173,105 @@ namespace usd
     return errors;
   }
 
-  UsdErrors ParseSdfMaterial(const sdf::Material *_materialSdf,
+  /// \brief Get a key that identifies the parameters of an SDF material
+  /// that are authored in USD, so that materials with the same key are
+  /// authored as the same USD material.
+  /// \param[in] _materialSdf The SDF material.
+  /// \return The key.
+  std::string materialKey(const sdf::Material &_materialSdf)
+  {
+    std::ostringstream key;
+    key << std::setprecision(std::numeric_limits<float>::max_digits10);
+    const ignition::math::Color diffuse = _materialSdf.Diffuse();
+    const ignition::math::Color emissive = _materialSdf.Emissive();
+    key << diffuse.R() << ' ' << diffuse.G() << ' ' << diffuse.B() << ' '
+        << emissive.R() << ' ' << emissive.G() << ' ' << emissive.B() << ' '
+        << emissive.A();
+
+    const sdf::Pbr *pbr = _materialSdf.PbrMaterial();
+    const sdf::PbrWorkflow *pbrWorkflow = nullptr;
+    if (pbr)
+    {
+      pbrWorkflow = pbr->Workflow(sdf::PbrWorkflowType::METAL);
+      if (!pbrWorkflow)
+        pbrWorkflow = pbr->Workflow(sdf::PbrWorkflowType::SPECULAR);
+    }
+    if (pbrWorkflow)
+    {
+      // Texture names are separated by a character that cannot be part of
+      // a path.
+      key << " pbr " << pbrWorkflow->Metalness() << ' '
+          << pbrWorkflow->Roughness() << ' '
+          << pbrWorkflow->AlbedoMap() << '\0'
+          << pbrWorkflow->MetalnessMap() << '\0'
+          << pbrWorkflow->NormalMap() << '\0'
+          << pbrWorkflow->RoughnessMap();
+    }
+    return key.str();
+  }
+
+  /// \brief The USD materials that ParseSdfMaterial authored in a stage.
+  struct StageMaterials
+  {
+    /// \brief The stage, which is null once it is destroyed.
+    pxr::UsdStageWeakPtr stage;
+
+    /// \brief Paths of the materials, indexed by material name prefix and
+    /// material key.
+    std::map<std::pair<std::string, std::string>, pxr::SdfPath> paths;
+  };
+
+  /// \brief The USD materials authored by ParseSdfMaterial in each stage.
+  struct AuthoredMaterials
+  {
+    /// \brief Mutex that protects stages, since models may be converted
+    /// concurrently (see ParseSdfWorld).
+    std::mutex mutex;
+
+    /// \brief The materials of each stage.
+    std::map<const pxr::UsdStage *, StageMaterials> stages;
+
+    /// \brief Get the materials of a stage.
+    /// \param[in] _stage The stage.
+    /// \return The materials of the stage, which are empty the first time
+    /// the stage is used. The mutex must be locked.
+    StageMaterials &Of(const pxr::UsdStageRefPtr &_stage)
+    {
+      auto it = this->stages.find(get_pointer(_stage));
+      if (it != this->stages.end() && it->second.stage)
+        return it->second;
+
+      // A new stage, possibly at the address of a destroyed one. Forget the
+      // materials of the stages that were destroyed.
+      for (auto stageIt = this->stages.begin();
+           stageIt != this->stages.end();)
+      {
+        if (stageIt->second.stage)
+          ++stageIt;
+        else
+          stageIt = this->stages.erase(stageIt);
+      }
+      StageMaterials &materials = this->stages[get_pointer(_stage)];
+      materials.stage = pxr::UsdStageWeakPtr(_stage);
+      return materials;
+    }
+  };
+
+  /// \brief Get the USD materials authored by ParseSdfMaterial.
+  /// \return The materials.
+  AuthoredMaterials &authoredMaterials()
+  {
+    static AuthoredMaterials materials;
+    return materials;
+  }
+
+  /// \brief Author an SDF material as a new USD material.
+  /// \param[in] _materialSdf The SDF material to parse.
+  /// \param[in] _stage The stage that should contain the USD material.
+  /// \param[out] _materialPath USD Material path
+  /// \return UsdErrors, which is a list of UsdError objects. This list is
+  /// empty if no errors occurred when authoring the material.
+  UsdErrors authorSdfMaterial(const sdf::Material *_materialSdf,
       pxr::UsdStageRefPtr &_stage, pxr::SdfPath &_materialPath)
   {
     UsdErrors errors;
@@ -166,11 +284,13 @@ namespace usd
     }
 
     // This variable will increase with every new material to avoid collision
-    // with the names of the materials
-    static int i = 0;
+    // with the names of the materials. It is atomic because models may be
+    // converted concurrently (see ParseSdfWorld)
+    static std::atomic<int> i{0};
 
-    _materialPath = pxr::SdfPath("/Looks/Material_" + std::to_string(i));
-    i++;
+    _materialPath = pxr::SdfPath("/Looks/" +
+        ScopedMaterialNamePrefix::Current() + "Material_" +
+        std::to_string(i++));
 
     pxr::UsdShadeMaterial materialUsd;
     auto usdMaterialPrim = _stage->GetPrimAtPath(_materialPath);
@@ -395,9 +515,7 @@ namespace usd
         {
           std::string copyPath = getMaterialCopyPath(pbrWorkflow->AlbedoMap());
 
-          std::string fullnameAlbedoMap =
-            ignition::common::findFile(
-              ignition::common::basename(pbrWorkflow->AlbedoMap()));
+          std::string fullnameAlbedoMap = findTexture(pbrWorkflow->AlbedoMap());
 
           if (fullnameAlbedoMap.empty())
           {
@@ -435,8 +553,7 @@ namespace usd
             getMaterialCopyPath(pbrWorkflow->MetalnessMap());
 
           std::string fullnameMetallnessMap =
-            ignition::common::findFile(
-              ignition::common::basename(pbrWorkflow->MetalnessMap()));
+            findTexture(pbrWorkflow->MetalnessMap());
 
           if (fullnameMetallnessMap.empty())
           {
@@ -472,9 +589,7 @@ namespace usd
         {
           std::string copyPath = getMaterialCopyPath(pbrWorkflow->NormalMap());
 
-          std::string fullnameNormalMap =
-            ignition::common::findFile(
-              ignition::common::basename(pbrWorkflow->NormalMap()));
+          std::string fullnameNormalMap = findTexture(pbrWorkflow->NormalMap());
 
           if (fullnameNormalMap.empty())
           {
@@ -512,8 +627,7 @@ namespace usd
             getMaterialCopyPath(pbrWorkflow->RoughnessMap());
 
           std::string fullnameRoughnessMap =
-            ignition::common::findFile(
-              ignition::common::basename(pbrWorkflow->RoughnessMap()));
+            findTexture(pbrWorkflow->RoughnessMap());
 
           if (fullnameRoughnessMap.empty())
           {
@@ -581,6 +695,35 @@ namespace usd
 
     return errors;
   }
+
+  UsdErrors ParseSdfMaterial(const sdf::Material *_materialSdf,
+      pxr::UsdStageRefPtr &_stage, pxr::SdfPath &_materialPath)
+  {
+    // Visuals that share the same material parameters are bound to a
+    // single USD material and shader network.
+    const auto key = std::make_pair(ScopedMaterialNamePrefix::Current(),
+        materialKey(*_materialSdf));
+    AuthoredMaterials &authored = authoredMaterials();
+    {
+      std::lock_guard<std::mutex> lock(authored.mutex);
+      const StageMaterials &materials = authored.Of(_stage);
+      auto it = materials.paths.find(key);
+      if (it != materials.paths.end() &&
+          _stage->GetPrimAtPath(it->second).IsA<pxr::UsdShadeMaterial>())
+      {
+        _materialPath = it->second;
+        return UsdErrors();
+      }
+    }
+
+    UsdErrors errors = authorSdfMaterial(_materialSdf, _stage, _materialPath);
+    if (errors.empty())
+    {
+      std::lock_guard<std::mutex> lock(authored.mutex);
+      authored.Of(_stage).paths[key] = _materialPath;
+    }
+    return errors;
+  }
 }
 }
 }
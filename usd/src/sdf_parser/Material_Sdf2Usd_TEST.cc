@@ -29,7 +29,9 @@
 #include <pxr/usd/usd/stage.h>
 #pragma pop_macro ("__DEPRECATED")
 
+#include "sdf/usd/sdf_parser/Material.hh"
 #include "sdf/usd/sdf_parser/World.hh"
+#include "sdf/Material.hh"
 #include "sdf/Root.hh"
 #include "test_config.h"
 #include "test_utils.hh"
@@ -248,3 +250,38 @@ TEST_F(UsdStageFixture, Material)
       false);
   }
 }
+
+/////////////////////////////////////////////////
+TEST_F(UsdStageFixture, SharedMaterials)
+{
+  sdf::Material red;
+  red.SetDiffuse(ignition::math::Color(1, 0, 0));
+  sdf::Material sameRed;
+  sameRed.SetDiffuse(ignition::math::Color(1, 0, 0));
+  sdf::Material green;
+  green.SetDiffuse(ignition::math::Color(0, 1, 0));
+
+  pxr::SdfPath redPath;
+  EXPECT_TRUE(sdf::usd::ParseSdfMaterial(&red, this->stage, redPath).empty());
+  pxr::SdfPath sameRedPath;
+  EXPECT_TRUE(sdf::usd::ParseSdfMaterial(
+        &sameRed, this->stage, sameRedPath).empty());
+  pxr::SdfPath greenPath;
+  EXPECT_TRUE(sdf::usd::ParseSdfMaterial(
+        &green, this->stage, greenPath).empty());
+
+  // Materials with the same parameters are authored once.
+  EXPECT_EQ(redPath, sameRedPath);
+  EXPECT_NE(redPath, greenPath);
+  EXPECT_TRUE(pxr::UsdShadeMaterial(this->stage->GetPrimAtPath(redPath)));
+  EXPECT_TRUE(pxr::UsdShadeMaterial(this->stage->GetPrimAtPath(greenPath)));
+
+  // Other stages get their own materials.
+  auto otherStage = pxr::UsdStage::CreateInMemory();
+  ASSERT_TRUE(otherStage);
+  pxr::SdfPath otherRedPath;
+  EXPECT_TRUE(sdf::usd::ParseSdfMaterial(
+        &red, otherStage, otherRedPath).empty());
+  EXPECT_TRUE(pxr::UsdShadeMaterial(otherStage->GetPrimAtPath(otherRedPath)));
+  EXPECT_FALSE(this->stage->GetPrimAtPath(otherRedPath));
+}
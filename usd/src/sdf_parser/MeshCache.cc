@@ -0,0 +1,512 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "MeshCache.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Material.hh>
+
+#include "sdf/Element.hh"
+#include "sdf/parser.hh"
+#include "sdf/usd/Conversions.hh"
+#include "sdf/usd/sdf_parser/Geometry.hh"
+
+#include "../UsdUtils.hh"
+
+namespace sdf
+{
+// Inline bracke to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+//
+namespace usd
+{
+  /// \brief Magic number at the start of the mesh cache files.
+  static const char kMeshCacheMagic[8] = {'S', 'D', 'F', 'M', 'E', 'S', 'H',
+    '\0'};
+
+  /// \brief Version of the format of the mesh cache files, which is part of
+  /// the names of the files. Increment it whenever the format or the
+  /// conversion of the meshes changes.
+  static const uint32_t kMeshCacheVersion = 1;
+
+  /// \brief Extension of the mesh cache files.
+  static const char kMeshCacheExtension[] = ".mesh";
+
+  /// \brief Get the mutex that protects the cache directory and the hashes
+  /// of the mesh files.
+  /// \return The mutex.
+  static std::mutex &meshCacheMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  /// \brief Get the directory of the mesh cache.
+  /// \return Reference to the directory, empty if the cache is disabled.
+  static std::string &meshCacheDirectory()
+  {
+    static std::string directory;
+    return directory;
+  }
+
+  /////////////////////////////////////////////////
+  void SetMeshCacheDirectory(const std::string &_directory)
+  {
+    std::lock_guard<std::mutex> lock(meshCacheMutex());
+    meshCacheDirectory() = _directory;
+  }
+
+  /////////////////////////////////////////////////
+  std::string MeshCacheDirectory()
+  {
+    std::lock_guard<std::mutex> lock(meshCacheMutex());
+    return meshCacheDirectory();
+  }
+
+  /////////////////////////////////////////////////
+  UsdErrors ConvertMesh(const ignition::common::Mesh &_mesh,
+      MeshData &_data)
+  {
+    UsdErrors errors;
+
+    _data = MeshData();
+    _data.name = _mesh.Name();
+    _data.min = _mesh.Min();
+    _data.max = _mesh.Max();
+    _data.subMeshes.resize(_mesh.SubMeshCount());
+    for (unsigned int i = 0; i < _mesh.SubMeshCount(); ++i)
+    {
+      auto subMesh = _mesh.SubMeshByIndex(i).lock();
+      if (!subMesh)
+      {
+        errors.push_back(UsdError(sdf::usd::UsdErrorCode::MESH_LOAD_FAILURE,
+              "Unable to get a shared pointer to submesh at index ["
+              + std::to_string(i) + "] of parent mesh [" + _mesh.Name()
+              + "]"));
+        return errors;
+      }
+
+      SubMeshData &subMeshData = _data.subMeshes[i];
+      subMeshData.name = subMesh->Name();
+      subMeshData.primitiveType = subMesh->SubMeshPrimitiveType();
+
+      // TODO(adlarkin) update this call in sdf13 to avoid casting the index to
+      // an int:
+      // https://github.com/ignitionrobotics/ign-common/pull/319
+      const int materialIndex = subMesh->MaterialIndex();
+      if (materialIndex != -1)
+      {
+        const auto material = _mesh.MaterialByIndex(materialIndex);
+        if (material)
+          subMeshData.material = sdf::usd::convert(material.get());
+      }
+    }
+
+    return errors;
+  }
+
+  /////////////////////////////////////////////////
+  UsdErrors ConvertMeshBuffers(const ignition::common::Mesh &_mesh,
+      MeshData &_data)
+  {
+    UsdErrors errors;
+
+    for (unsigned int i = 0; i < _data.subMeshes.size(); ++i)
+    {
+      auto subMesh = _mesh.SubMeshByIndex(i).lock();
+      if (!subMesh)
+      {
+        errors.push_back(UsdError(sdf::usd::UsdErrorCode::MESH_LOAD_FAILURE,
+              "Unable to get a shared pointer to submesh at index ["
+              + std::to_string(i) + "] of parent mesh [" + _mesh.Name()
+              + "]"));
+        return errors;
+      }
+      SubMeshData &subMeshData = _data.subMeshes[i];
+
+      // Each array is sized once and filled through its data pointer, which
+      // avoids growing the arrays one element at a time. GfVec2f and GfVec3f
+      // are contiguous floats, so the arrays are written as float buffers.
+      const unsigned int vertexCount = subMesh->VertexCount();
+      const unsigned int indexCount = subMesh->IndexCount();
+      subMeshData.points = pxr::VtArray<pxr::GfVec3f>(vertexCount);
+      subMeshData.indices = pxr::VtArray<int>(indexCount);
+      float *pointData = reinterpret_cast<float *>(subMeshData.points.data());
+      int *indexData = subMeshData.indices.data();
+      if (vertexCount > 0 && indexCount > 0)
+      {
+        // copy the submesh's vertices and indices as contiguous buffers, then
+        // convert the coordinates to float in a single pass
+        double *vertexArr = nullptr;
+        int *indexArr = nullptr;
+        subMesh->FillArrays(&vertexArr, &indexArr);
+        std::unique_ptr<double[]> vertices(vertexArr);
+        std::unique_ptr<int[]> indices(indexArr);
+        const std::size_t coordinateCount = 3u * vertexCount;
+        for (std::size_t c = 0; c < coordinateCount; ++c)
+          pointData[c] = static_cast<float>(vertices[c]);
+        std::copy_n(indices.get(), indexCount, indexData);
+      }
+      else
+      {
+        // FillArrays requires both vertices and indices
+        for (unsigned int v = 0; v < vertexCount; ++v)
+        {
+          const auto vertex = subMesh->Vertex(v);
+          pointData[3 * v] = static_cast<float>(vertex.X());
+          pointData[3 * v + 1] = static_cast<float>(vertex.Y());
+          pointData[3 * v + 2] = static_cast<float>(vertex.Z());
+        }
+        for (unsigned int j = 0; j < indexCount; ++j)
+          indexData[j] = subMesh->Index(j);
+      }
+
+      // copy the submesh's texture coordinates
+      const unsigned int texCoordCount = subMesh->TexCoordCount();
+      subMeshData.uvs = pxr::VtArray<pxr::GfVec2f>(texCoordCount);
+      float *uvData = reinterpret_cast<float *>(subMeshData.uvs.data());
+      for (unsigned int j = 0; j < texCoordCount; ++j)
+      {
+        const auto uv = subMesh->TexCoord(j);
+        uvData[2 * j] = static_cast<float>(uv[0]);
+        uvData[2 * j + 1] = static_cast<float>(1 - uv[1]);
+      }
+
+      // copy the submesh's normals
+      const unsigned int normalCount = subMesh->NormalCount();
+      subMeshData.normals = pxr::VtArray<pxr::GfVec3f>(normalCount);
+      float *normalData = reinterpret_cast<float *>(subMeshData.normals.data());
+      for (unsigned int j = 0; j < normalCount; ++j)
+      {
+        const auto normal = subMesh->Normal(j);
+        normalData[3 * j] = static_cast<float>(normal[0]);
+        normalData[3 * j + 1] = static_cast<float>(normal[1]);
+        normalData[3 * j + 2] = static_cast<float>(normal[2]);
+      }
+    }
+    _data.buffers = true;
+
+    return errors;
+  }
+
+  /////////////////////////////////////////////////
+  std::string MeshCacheFile(const std::string &_meshFile)
+  {
+    std::lock_guard<std::mutex> lock(meshCacheMutex());
+    const std::string &directory = meshCacheDirectory();
+    if (directory.empty())
+      return "";
+
+    // The same mesh is usually used by many geometries, so each file is only
+    // read and hashed once
+    static std::map<std::string, std::string> hashes;
+    auto hashIt = hashes.find(_meshFile);
+    if (hashIt == hashes.end())
+    {
+      std::ifstream in(_meshFile, std::ios::binary);
+      if (!in)
+        return "";
+
+      uint64_t hash = Fnv1aHash(reinterpret_cast<const char *>(
+            &kMeshCacheVersion), sizeof(kMeshCacheVersion));
+      const std::string meshDirectory = ignition::common::parentPath(
+          _meshFile);
+      hash = Fnv1aHash(meshDirectory.data(), meshDirectory.size(), hash);
+      char buffer[65536];
+      while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0)
+        hash = Fnv1aHash(buffer, static_cast<std::size_t>(in.gcount()), hash);
+      hashIt = hashes.emplace(_meshFile, HashString(hash)).first;
+    }
+
+    return ignition::common::joinPaths(directory,
+        hashIt->second + kMeshCacheExtension);
+  }
+
+  /// \brief Write a value to a cache file.
+  /// \param[in] _out The cache file
+  /// \param[in] _value The value, which must be trivially copyable
+  template <typename T>
+  static void writeValue(std::ostream &_out, const T &_value)
+  {
+    _out.write(reinterpret_cast<const char *>(&_value), sizeof(T));
+  }
+
+  /// \brief Write a string to a cache file, as its size and its characters.
+  /// \param[in] _out The cache file
+  /// \param[in] _value The string
+  static void writeString(std::ostream &_out, const std::string &_value)
+  {
+    writeValue(_out, static_cast<uint32_t>(_value.size()));
+    _out.write(_value.data(), static_cast<std::streamsize>(_value.size()));
+  }
+
+  /// \brief Write the elements of an array to a cache file, as one block.
+  /// \param[in] _out The cache file
+  /// \param[in] _array The array
+  template <typename T>
+  static void writeArray(std::ostream &_out, const pxr::VtArray<T> &_array)
+  {
+    _out.write(reinterpret_cast<const char *>(_array.cdata()),
+        static_cast<std::streamsize>(_array.size() * sizeof(T)));
+  }
+
+  /// \brief Read a value from a cache file.
+  /// \param[in] _in The cache file
+  /// \param[out] _value The value, which must be trivially copyable
+  /// \return True if the value was read.
+  template <typename T>
+  static bool readValue(std::istream &_in, T &_value)
+  {
+    return static_cast<bool>(
+        _in.read(reinterpret_cast<char *>(&_value), sizeof(T)));
+  }
+
+  /// \brief Read a string from a cache file.
+  /// \param[in] _in The cache file
+  /// \param[in] _remaining Number of bytes left in the cache file, which
+  /// bounds the size of the string
+  /// \param[out] _value The string
+  /// \return True if the string was read.
+  static bool readCacheString(std::istream &_in, std::streamoff _remaining,
+      std::string &_value)
+  {
+    uint32_t size = 0;
+    if (!readValue(_in, size) ||
+        static_cast<std::streamoff>(size) > _remaining)
+    {
+      return false;
+    }
+    _value.resize(size);
+    return static_cast<bool>(_in.read(&_value[0], size));
+  }
+
+  /// \brief Read the elements of an array from a cache file, straight into
+  /// the storage of the array.
+  /// \param[in] _in The cache file
+  /// \param[in] _count Number of elements
+  /// \param[out] _array The array
+  /// \return True if the elements were read.
+  template <typename T>
+  static bool readArray(std::istream &_in, uint32_t _count,
+      pxr::VtArray<T> &_array)
+  {
+    _array = pxr::VtArray<T>(_count);
+    return static_cast<bool>(_in.read(reinterpret_cast<char *>(_array.data()),
+          static_cast<std::streamsize>(_count * sizeof(T))));
+  }
+
+  /// \brief Number of elements of the arrays of a submesh in a cache file.
+  struct SubMeshCounts
+  {
+    /// \brief Number of points.
+    uint32_t points = 0;
+
+    /// \brief Number of indices.
+    uint32_t indices = 0;
+
+    /// \brief Number of texture coordinates.
+    uint32_t uvs = 0;
+
+    /// \brief Number of normals.
+    uint32_t normals = 0;
+  };
+
+  /////////////////////////////////////////////////
+  bool ReadMeshCache(const std::string &_fileName, MeshData &_data,
+      bool _buffers)
+  {
+    std::ifstream in(_fileName, std::ios::binary | std::ios::ate);
+    if (!in)
+      return false;
+    const std::streamoff fileSize = in.tellg();
+    in.seekg(0);
+
+    // The cache files are only read by the process that wrote them, or by
+    // another process of the same version on the same machine, so the values
+    // are stored with the native byte order
+    char magic[sizeof(kMeshCacheMagic)];
+    uint32_t version = 0;
+    if (!in.read(magic, sizeof(magic)) ||
+        !std::equal(magic, magic + sizeof(magic), kMeshCacheMagic) ||
+        !readValue(in, version) || version != kMeshCacheVersion)
+    {
+      return false;
+    }
+
+    MeshData data;
+    double bounds[6];
+    uint32_t subMeshCount = 0;
+    if (!readValue(in, bounds) ||
+        !readCacheString(in, fileSize - in.tellg(), data.name) ||
+        !readValue(in, subMeshCount))
+    {
+      return false;
+    }
+    data.min.Set(bounds[0], bounds[1], bounds[2]);
+    data.max.Set(bounds[3], bounds[4], bounds[5]);
+
+    // Every description is at least 24 bytes, so a corrupt count cannot
+    // allocate more than the file
+    if (static_cast<std::streamoff>(subMeshCount) * 24 >
+        fileSize - in.tellg())
+    {
+      return false;
+    }
+    data.subMeshes.resize(subMeshCount);
+    std::vector<SubMeshCounts> counts(subMeshCount);
+    std::streamoff bufferBytes = 0;
+    for (uint32_t i = 0; i < subMeshCount; ++i)
+    {
+      SubMeshData &subMeshData = data.subMeshes[i];
+      int32_t primitiveType = 0;
+      std::string materialXml;
+      if (!readCacheString(in, fileSize - in.tellg(), subMeshData.name) ||
+          !readValue(in, primitiveType) ||
+          !readCacheString(in, fileSize - in.tellg(), materialXml) ||
+          !readValue(in, counts[i]))
+      {
+        return false;
+      }
+      subMeshData.primitiveType =
+        static_cast<ignition::common::SubMesh::PrimitiveType>(primitiveType);
+
+      if (!materialXml.empty())
+      {
+        sdf::ElementPtr materialElem(new sdf::Element);
+        sdf::initFile("material.sdf", materialElem);
+        sdf::Errors errors;
+        sdf::Material material;
+        const std::string materialSdf = std::string("<sdf version='") +
+          SDF_VERSION + "'>" + materialXml + "</sdf>";
+        if (!sdf::readString(materialSdf, materialElem, errors) ||
+            !material.Load(materialElem).empty())
+        {
+          return false;
+        }
+        subMeshData.material = material;
+      }
+
+      bufferBytes +=
+        static_cast<std::streamoff>(counts[i].points) * sizeof(pxr::GfVec3f) +
+        static_cast<std::streamoff>(counts[i].indices) * sizeof(int) +
+        static_cast<std::streamoff>(counts[i].uvs) * sizeof(pxr::GfVec2f) +
+        static_cast<std::streamoff>(counts[i].normals) * sizeof(pxr::GfVec3f);
+    }
+
+    // The buffers follow the descriptions, and end the file
+    if (bufferBytes != fileSize - in.tellg())
+      return false;
+
+    if (_buffers)
+    {
+      for (uint32_t i = 0; i < subMeshCount; ++i)
+      {
+        SubMeshData &subMeshData = data.subMeshes[i];
+        if (!readArray(in, counts[i].points, subMeshData.points) ||
+            !readArray(in, counts[i].indices, subMeshData.indices) ||
+            !readArray(in, counts[i].uvs, subMeshData.uvs) ||
+            !readArray(in, counts[i].normals, subMeshData.normals))
+        {
+          return false;
+        }
+      }
+      data.buffers = true;
+    }
+
+    _data = std::move(data);
+    return true;
+  }
+
+  /////////////////////////////////////////////////
+  bool WriteMeshCache(const std::string &_fileName, const MeshData &_data)
+  {
+    if (!_data.buffers)
+      return false;
+
+    const std::string directory = ignition::common::parentPath(_fileName);
+    if (!ignition::common::isDirectory(directory) &&
+        !ignition::common::createDirectories(directory))
+    {
+      return false;
+    }
+
+    std::ostringstream suffix;
+    suffix << ".tmp" << std::this_thread::get_id();
+    const std::string tmpFileName = _fileName + suffix.str();
+    {
+      std::ofstream out(tmpFileName, std::ios::binary | std::ios::trunc);
+      if (!out)
+        return false;
+
+      out.write(kMeshCacheMagic, sizeof(kMeshCacheMagic));
+      writeValue(out, kMeshCacheVersion);
+      const double bounds[6] = {_data.min.X(), _data.min.Y(), _data.min.Z(),
+        _data.max.X(), _data.max.Y(), _data.max.Z()};
+      writeValue(out, bounds);
+      writeString(out, _data.name);
+      writeValue(out, static_cast<uint32_t>(_data.subMeshes.size()));
+      for (const auto &subMeshData : _data.subMeshes)
+      {
+        writeString(out, subMeshData.name);
+        writeValue(out, static_cast<int32_t>(subMeshData.primitiveType));
+        writeString(out, subMeshData.material ?
+            subMeshData.material->ToElement()->ToString("") : "");
+        SubMeshCounts counts;
+        counts.points = static_cast<uint32_t>(subMeshData.points.size());
+        counts.indices = static_cast<uint32_t>(subMeshData.indices.size());
+        counts.uvs = static_cast<uint32_t>(subMeshData.uvs.size());
+        counts.normals = static_cast<uint32_t>(subMeshData.normals.size());
+        writeValue(out, counts);
+      }
+      for (const auto &subMeshData : _data.subMeshes)
+      {
+        writeArray(out, subMeshData.points);
+        writeArray(out, subMeshData.indices);
+        writeArray(out, subMeshData.uvs);
+        writeArray(out, subMeshData.normals);
+      }
+      if (!out.flush())
+      {
+        out.close();
+        std::remove(tmpFileName.c_str());
+        return false;
+      }
+    }
+
+    if (std::rename(tmpFileName.c_str(), _fileName.c_str()) != 0)
+    {
+      std::remove(tmpFileName.c_str());
+      return false;
+    }
+    return true;
+  }
+}
+}
+}
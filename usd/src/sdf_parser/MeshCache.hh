@@ -0,0 +1,148 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SDF_USD_SDF_PARSER_MESHCACHE_HH_
+#define SDF_USD_SDF_PARSER_MESHCACHE_HH_
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <ignition/common/Mesh.hh>
+#include <ignition/common/SubMesh.hh>
+#include <ignition/math/Vector3.hh>
+
+// TODO(adlarkin) this is to remove deprecated "warnings" in usd, these warnings
+// are reported using #pragma message so normal diagnostic flags cannot remove
+// them. This workaround requires this block to be used whenever usd is
+// included.
+#pragma push_macro ("__DEPRECATED")
+#undef __DEPRECATED
+#include <pxr/base/gf/vec2f.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/vt/array.h>
+#pragma pop_macro ("__DEPRECATED")
+
+#include "sdf/Material.hh"
+#include "sdf/config.hh"
+#include "sdf/usd/UsdError.hh"
+
+namespace sdf
+{
+  // Inline bracke to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+  namespace usd
+  {
+    /// \brief A submesh, converted to the buffers of a USD mesh.
+    struct SubMeshData
+    {
+      /// \brief Name of the submesh, which may be empty.
+      std::string name;
+
+      /// \brief Primitive type of the submesh.
+      ignition::common::SubMesh::PrimitiveType primitiveType =
+        ignition::common::SubMesh::PrimitiveType::TRIANGLES;
+
+      /// \brief Material of the submesh, if it has one.
+      std::optional<sdf::Material> material;
+
+      /// \brief Vertices.
+      pxr::VtArray<pxr::GfVec3f> points;
+
+      /// \brief Vertex indices of the faces.
+      pxr::VtArray<int> indices;
+
+      /// \brief Texture coordinates, with the v axis pointing up as USD
+      /// expects.
+      pxr::VtArray<pxr::GfVec2f> uvs;
+
+      /// \brief Vertex normals.
+      pxr::VtArray<pxr::GfVec3f> normals;
+    };
+
+    /// \brief A mesh, converted to the buffers of USD meshes. The
+    /// description of the mesh and of its submeshes can be used without the
+    /// buffers, which are only needed to author a mesh.
+    struct MeshData
+    {
+      /// \brief Name of the mesh.
+      std::string name;
+
+      /// \brief Minimum corner of the bounding box of the mesh.
+      ignition::math::Vector3d min;
+
+      /// \brief Maximum corner of the bounding box of the mesh.
+      ignition::math::Vector3d max;
+
+      /// \brief The submeshes, in the order of the mesh.
+      std::vector<SubMeshData> subMeshes;
+
+      /// \brief True if the buffers of the submeshes are filled.
+      bool buffers = false;
+    };
+
+    /// \brief Convert the description of a mesh and of its submeshes,
+    /// without their buffers.
+    /// \param[in] _mesh The mesh
+    /// \param[out] _data The converted mesh
+    /// \return UsdErrors, which is a vector of UsdError objects. Each UsdError
+    /// includes an error code and message. An empty vector indicates no error.
+    UsdErrors ConvertMesh(const ignition::common::Mesh &_mesh,
+        MeshData &_data);
+
+    /// \brief Fill the buffers of the submeshes of a converted mesh.
+    /// \param[in] _mesh The mesh that was converted to _data
+    /// \param[in,out] _data The mesh converted with ConvertMesh
+    /// \return UsdErrors, which is a vector of UsdError objects. Each UsdError
+    /// includes an error code and message. An empty vector indicates no error.
+    UsdErrors ConvertMeshBuffers(const ignition::common::Mesh &_mesh,
+        MeshData &_data);
+
+    /// \brief Get the file of the mesh cache for a mesh file. The file is
+    /// named after a hash of the content of the mesh file and of the
+    /// directory that contains it, which the mesh loaders resolve the
+    /// textures from. The hash of each mesh file is computed once per
+    /// process.
+    /// \param[in] _meshFile Full path of the mesh file
+    /// \return The cache file, which may not exist yet, or an empty string if
+    /// the cache is disabled (see SetMeshCacheDirectory) or _meshFile cannot
+    /// be read.
+    std::string MeshCacheFile(const std::string &_meshFile);
+
+    /// \brief Read a mesh from a cache file.
+    /// \param[in] _fileName The cache file
+    /// \param[out] _data The mesh
+    /// \param[in] _buffers True to read the buffers of the submeshes, false
+    /// to only read the description of the mesh
+    /// \return True if the mesh was read. False if the file does not exist,
+    /// was written by another version, or is truncated.
+    bool ReadMeshCache(const std::string &_fileName, MeshData &_data,
+        bool _buffers);
+
+    /// \brief Write a mesh, with its buffers, to a cache file. The file is
+    /// written under a temporary name and renamed, so that concurrent
+    /// conversions never read a partial file.
+    /// \param[in] _fileName The cache file
+    /// \param[in] _data The mesh
+    /// \return True if the file was written.
+    bool WriteMeshCache(const std::string &_fileName, const MeshData &_data);
+  }
+  }
+}
+
+#endif
@@ -17,9 +17,19 @@
 
 #include "sdf/usd/sdf_parser/World.hh"
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include <ignition/common/Filesystem.hh>
 #include <ignition/common/Util.hh>
 
 // TODO(ahcorde) this is to remove deprecated "warnings" in usd, these warnings
@@ -29,17 +39,25 @@
 #pragma push_macro ("__DEPRECATED")
 #undef __DEPRECATED
 #include <pxr/base/gf/vec3f.h>
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/usd/sdf/changeBlock.h>
+#include <pxr/usd/sdf/copyUtils.h>
+#include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/primSpec.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usdGeom/tokens.h>
 #include <pxr/usd/usdPhysics/scene.h>
 #pragma pop_macro ("__DEPRECATED")
 
+#include "sdf/TaskExecutor.hh"
 #include "sdf/World.hh"
 #include "sdf/usd/sdf_parser/Light.hh"
 #include "sdf/usd/sdf_parser/Model.hh"
 
+#include "../UsdUtils.hh"
+
 namespace sdf
 {
 // Inline bracke to help doxygen filtering.
@@ -47,10 +65,127 @@ inline namespace SDF_VERSION_NAMESPACE {
 //
 namespace usd
 {
-  UsdErrors ParseSdfWorld(const sdf::World &_world,
-    pxr::UsdStageRefPtr &_stage, const std::string &_path)
+  /// \brief Copy the prims of a layer that are missing from another layer.
+  /// Prims that exist in both layers, such as the world prim or the scope of
+  /// the materials, are kept and their children are merged recursively.
+  /// \param[in] _src The layer to copy the prims from
+  /// \param[in] _dst The layer to copy the prims to
+  /// \param[in] _path Path of the prim whose children should be merged
+  /// \return True if all the missing prims were copied
+  bool mergeLayerPrims(const pxr::SdfLayerHandle &_src,
+    const pxr::SdfLayerHandle &_dst, const pxr::SdfPath &_path)
+  {
+    const pxr::SdfPrimSpecHandle srcPrim = _src->GetPrimAtPath(_path);
+    if (!srcPrim)
+      return true;
+
+    for (const auto &child : srcPrim->GetNameChildren())
+    {
+      const pxr::SdfPath childPath = child->GetPath();
+      if (_dst->GetPrimAtPath(childPath))
+      {
+        if (!mergeLayerPrims(_src, _dst, childPath))
+          return false;
+      }
+      else if (!pxr::SdfCopySpec(_src, childPath, _dst, childPath))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Get the USD path of a model of a world.
+  /// \param[in] _model The model
+  /// \param[in] _path The USD path of the world
+  /// \return The USD path of _model
+  std::string modelPrimPath(const sdf::Model &_model, const std::string &_path)
+  {
+    return ignition::common::replaceAll(_path + "/" + _model.Name(), " ", "");
+  }
+
+  /// \brief Add the errors of a model to the errors of the world.
+  /// \param[in] _model The model
+  /// \param[in] _modelErrors The errors of _model
+  /// \param[out] _errors The errors of the world
+  void addModelErrors(const sdf::Model &_model, const UsdErrors &_modelErrors,
+    UsdErrors &_errors)
   {
+    if (_modelErrors.empty())
+      return;
+
+    _errors.push_back(UsdError(
+          sdf::usd::UsdErrorCode::SDF_TO_USD_PARSING_ERROR,
+          "Error parsing model [" + _model.Name() + "]"));
+    _errors.insert(_errors.end(), _modelErrors.begin(), _modelErrors.end());
+  }
+
+  /// \brief Convert the models of a world concurrently, and copy them into
+  /// a stage.
+  /// \param[in] _world The world
+  /// \param[in] _stage The stage that contains the world prim
+  /// \param[in] _path The USD path of the world prim
+  /// \param[in] _threads Number of workers, at least 2
+  /// \return The errors of the models, in the order of the models
+  UsdErrors parseSdfModelsConcurrently(const sdf::World &_world,
+    pxr::UsdStageRefPtr &_stage, const std::string &_path,
+    unsigned int _threads)
+  {
+    const pxr::SdfPath worldPrimPath(_path);
+    const uint64_t modelCount = _world.ModelCount();
+    std::vector<pxr::UsdStageRefPtr> modelStages(modelCount);
+    std::vector<UsdErrors> modelErrors(modelCount);
+
+    // Each model is converted into a stage of its own, since a stage can only
+    // be authored by one thread at a time. The workers run on the shared
+    // threads of libsdformat, each taking models until none are left
+    std::atomic<uint64_t> next{0};
+    auto worker = [&](std::size_t)
+    {
+      for (uint64_t i = next++; i < modelCount; i = next++)
+      {
+        const auto &model = *(_world.ModelByIndex(i));
+        auto modelStage = pxr::UsdStage::CreateInMemory();
+        modelStage->DefinePrim(worldPrimPath);
+        modelErrors[i] = ParseSdfModel(model, modelStage,
+            modelPrimPath(model, _path), worldPrimPath);
+        modelStages[i] = modelStage;
+      }
+    };
+
+    const uint64_t workerCount = std::min<uint64_t>(_threads, modelCount);
+    sdf::TaskExecutor::Threaded()->RunAndWait(
+        static_cast<std::size_t>(workerCount), worker);
+
+    // The copies only use the Sdf API, so the change notifications of all the
+    // models are batched and the stage is recomposed once, after the block
     UsdErrors errors;
+    const pxr::SdfLayerHandle rootLayer = _stage->GetRootLayer();
+    pxr::SdfChangeBlock changeBlock;
+    for (uint64_t i = 0; i < modelCount; ++i)
+    {
+      const auto &model = *(_world.ModelByIndex(i));
+      addModelErrors(model, modelErrors[i], errors);
+      if (!mergeLayerPrims(modelStages[i]->GetRootLayer(), rootLayer,
+            pxr::SdfPath::AbsoluteRootPath()))
+      {
+        errors.push_back(UsdError(
+              sdf::usd::UsdErrorCode::SDF_TO_USD_PARSING_ERROR,
+              "Unable to copy the prims of model [" + model.Name()
+              + "] to the stage"));
+      }
+    }
+    return errors;
+  }
+
+  /// \brief Set the metadata of a stage and define the world prim and its
+  /// physics scene.
+  /// \param[in] _world The world
+  /// \param[in] _stage The stage
+  /// \param[in] _path The USD path of the world prim
+  void parseSdfWorldPrim(const sdf::World &_world,
+    pxr::UsdStageRefPtr &_stage, const std::string &_path)
+  {
     _stage->SetMetadata(pxr::UsdGeomTokens->upAxis, pxr::UsdGeomTokens->z);
     _stage->SetEndTimeCode(100);
     _stage->SetMetadata(pxr::TfToken("metersPerUnit"), 1.0);
@@ -68,39 +203,251 @@ namespace usd
           normalizedGravity.X(), normalizedGravity.Y(), normalizedGravity.Z()));
     usdPhysics.CreateGravityMagnitudeAttr().Set(
         static_cast<float>(sdfWorldGravity.Length()));
+  }
+
+  /// \brief Convert the lights of a world.
+  /// \param[in] _world The world
+  /// \param[in] _stage The stage that contains the world prim
+  /// \param[in] _path The USD path of the world prim
+  /// \param[out] _errors The errors of the world
+  void parseSdfWorldLights(const sdf::World &_world,
+    pxr::UsdStageRefPtr &_stage, const std::string &_path, UsdErrors &_errors)
+  {
+    for (uint64_t i = 0; i < _world.LightCount(); ++i)
+    {
+      const auto light = *(_world.LightByIndex(i));
+      auto lightPath = std::string(_path + "/" + light.Name());
+      lightPath = ignition::common::replaceAll(lightPath, " ", "");
+      UsdErrors lightErrors = ParseSdfLight(light, _stage, lightPath);
+      if (!lightErrors.empty())
+      {
+        _errors.push_back(UsdError(
+              sdf::usd::UsdErrorCode::SDF_TO_USD_PARSING_ERROR,
+              "Error parsing light [" + light.Name() + "]"));
+        _errors.insert(_errors.end(), lightErrors.begin(), lightErrors.end());
+      }
+    }
+  }
+
+  UsdErrors ParseSdfWorld(const sdf::World &_world,
+    pxr::UsdStageRefPtr &_stage, const std::string &_path)
+  {
+    return ParseSdfWorld(_world, _stage, _path, 1u);
+  }
+
+  UsdErrors ParseSdfWorld(const sdf::World &_world,
+    pxr::UsdStageRefPtr &_stage, const std::string &_path,
+    unsigned int _threads)
+  {
+    UsdErrors errors;
+    parseSdfWorldPrim(_world, _stage, _path);
+    const pxr::SdfPath worldPrimPath(_path);
+
+    if (_threads == 0)
+      _threads = std::max(1u, std::thread::hardware_concurrency());
 
     // parse all of the world's models and convert them to USD
-    for (uint64_t i = 0; i < _world.ModelCount(); ++i)
+    if (_threads > 1 && _world.ModelCount() > 1)
     {
-      const auto model = *(_world.ModelByIndex(i));
-      auto modelPath = std::string(_path + "/" + model.Name());
-      modelPath = ignition::common::replaceAll(modelPath, " ", "");
       UsdErrors modelErrors =
-        ParseSdfModel(model, _stage, modelPath, worldPrimPath);
+        parseSdfModelsConcurrently(_world, _stage, _path, _threads);
+      errors.insert(errors.end(), modelErrors.begin(), modelErrors.end());
+    }
+    else
+    {
+      for (uint64_t i = 0; i < _world.ModelCount(); ++i)
+      {
+        const auto &model = *(_world.ModelByIndex(i));
+        UsdErrors modelErrors = ParseSdfModel(model, _stage,
+            modelPrimPath(model, _path), worldPrimPath);
+        addModelErrors(model, modelErrors, errors);
+      }
+    }
+
+    parseSdfWorldLights(_world, _stage, _path, errors);
+    return errors;
+  }
+
+  /// \brief Name of the manifest of the model layers, in their directory.
+  static const char kModelLayersManifest[] = "manifest.txt";
+
+  /// \brief Compute a hash of the content of a model, which changes when the
+  /// USD layer of the model needs to be authored again.
+  /// \param[in] _model The model
+  /// \param[in] _args File format arguments used to write the layer
+  /// \return A 64 bit FNV-1a hash, as a hexadecimal string
+  std::string modelContentHash(const sdf::Model &_model,
+    const pxr::SdfLayer::FileFormatArguments &_args)
+  {
+    // The pose of the model may be relative to other models, so the
+    // resolved pose is part of the content
+    ignition::math::Pose3d pose;
+    _model.SemanticPose().Resolve(pose);
+    std::ostringstream content;
+    content << (_model.Element() ? _model.Element()->ToString("") : "")
+            << "\npose " << pose << "\n";
+    for (const auto &arg : _args)
+      content << arg.first << "=" << arg.second << "\n";
+
+    const std::string data = content.str();
+    return HashString(Fnv1aHash(data.data(), data.size()));
+  }
+
+  /// \brief Read the manifest of the model layers.
+  /// \param[in] _fileName Path of the manifest
+  /// \return The content hash of each model layer, by layer name. Empty if
+  /// there is no manifest.
+  std::map<std::string, std::string> readModelLayersManifest(
+    const std::string &_fileName)
+  {
+    std::map<std::string, std::string> hashes;
+    std::ifstream manifest(_fileName);
+    std::string line;
+    while (std::getline(manifest, line))
+    {
+      if (line.empty() || line[0] == '#')
+        continue;
+      std::istringstream fields(line);
+      std::string layerName;
+      std::string hash;
+      if (fields >> layerName >> hash)
+        hashes[layerName] = hash;
+    }
+    return hashes;
+  }
+
+  UsdErrors ExportSdfWorldWithModelLayers(const sdf::World &_world,
+    const std::string &_path, const std::string &_fileName,
+    const pxr::SdfLayer::FileFormatArguments &_args, bool _incremental)
+  {
+    UsdErrors errors;
+
+    // The model layers are written next to the exported file, in a
+    // directory named after it, and use the same file format
+    const std::string baseName = ignition::common::basename(_fileName);
+    const auto extensionIndex = baseName.rfind('.');
+    std::string layersDir = _fileName;
+    std::string extension = ".usd";
+    if (extensionIndex != std::string::npos)
+    {
+      extension = baseName.substr(extensionIndex);
+      layersDir.resize(_fileName.size() - extension.size());
+    }
+    layersDir += "_models";
+    if (!ignition::common::createDirectories(layersDir))
+    {
+      errors.push_back(UsdError(
+            sdf::usd::UsdErrorCode::SDF_TO_USD_PARSING_ERROR,
+            "Unable to create the directory of the model layers ["
+            + layersDir + "]"));
+      return errors;
+    }
+
+    const std::string manifestFile =
+      ignition::common::joinPaths(layersDir, kModelLayersManifest);
+    std::map<std::string, std::string> previousHashes;
+    if (_incremental)
+      previousHashes = readModelLayersManifest(manifestFile);
+
+    const pxr::SdfPath worldPrimPath(_path);
+    std::vector<std::string> subLayerPaths;
+    std::vector<std::pair<std::string, std::string>> hashes;
+    std::set<std::string> layerNames;
+    for (uint64_t i = 0; i < _world.ModelCount(); ++i)
+    {
+      const auto &model = *(_world.ModelByIndex(i));
+
+      // Layers are named after their model, so that a model keeps its layer
+      // when other models are added or removed
+      std::string layerStem = pxr::TfMakeValidIdentifier(model.Name());
+      if (layerNames.count(layerStem + extension))
+        layerStem += "_" + std::to_string(i);
+      const std::string layerName = layerStem + extension;
+      layerNames.insert(layerName);
+      const std::string layerFile =
+        ignition::common::joinPaths(layersDir, layerName);
+      const std::string layerPath =
+        ignition::common::basename(layersDir) + "/" + layerName;
+
+      const std::string hash = modelContentHash(model, _args);
+      hashes.emplace_back(layerName, hash);
+
+      const auto previous = previousHashes.find(layerName);
+      if (previous != previousHashes.end() && previous->second == hash &&
+          ignition::common::isFile(layerFile))
+      {
+        subLayerPaths.push_back(layerPath);
+        continue;
+      }
+
+      // The stage of the model is released at the end of each iteration, so
+      // only one model is held in memory at a time. The materials are named
+      // after the layer, so that they do not collide with the materials of
+      // layers authored by other exports.
+      ScopedMaterialNamePrefix materialPrefix(layerStem + "_");
+      auto modelStage = pxr::UsdStage::CreateInMemory();
+      modelStage->DefinePrim(worldPrimPath);
+      UsdErrors modelErrors = ParseSdfModel(model, modelStage,
+          modelPrimPath(model, _path), worldPrimPath);
+      addModelErrors(model, modelErrors, errors);
       if (!modelErrors.empty())
+        hashes.back().second.clear();
+
+      if (!modelStage->GetRootLayer()->Export(layerFile, "", _args))
       {
         errors.push_back(UsdError(
               sdf::usd::UsdErrorCode::SDF_TO_USD_PARSING_ERROR,
-              "Error parsing model [" + model.Name() + "]"));
-        errors.insert(errors.end(), modelErrors.begin(), modelErrors.end());
+              "Unable to save the layer of model [" + model.Name()
+              + "] to [" + layerFile + "]"));
+        hashes.pop_back();
+        continue;
       }
+      subLayerPaths.push_back(layerPath);
     }
 
-    for (uint64_t i = 0; i < _world.LightCount(); ++i)
+    // Remove the layers of the models that are no longer in the world
+    for (const auto &previous : previousHashes)
     {
-      const auto light = *(_world.LightByIndex(i));
-      auto lightPath = std::string(_path + "/" + light.Name());
-      lightPath = ignition::common::replaceAll(lightPath, " ", "");
-      UsdErrors lightErrors = ParseSdfLight(light, _stage, lightPath);
-      if (!lightErrors.empty())
+      if (!layerNames.count(previous.first))
       {
-        errors.push_back(UsdError(
-              sdf::usd::UsdErrorCode::SDF_TO_USD_PARSING_ERROR,
-              "Error parsing light [" + light.Name() + "]"));
-        errors.insert(errors.end(), lightErrors.begin(), lightErrors.end());
+        ignition::common::removeFile(
+            ignition::common::joinPaths(layersDir, previous.first));
       }
     }
 
+    // Models whose conversion failed are not recorded, so they are authored
+    // again by the next export
+    std::ofstream manifest(manifestFile);
+    manifest << "# Content hashes of the model layers of "
+             << baseName << "\n";
+    for (const auto &hash : hashes)
+    {
+      if (!hash.second.empty())
+        manifest << hash.first << " " << hash.second << "\n";
+    }
+    if (!manifest)
+    {
+      errors.push_back(UsdError(
+            sdf::usd::UsdErrorCode::SDF_TO_USD_PARSING_ERROR,
+            "Unable to write the manifest of the model layers ["
+            + manifestFile + "]"));
+    }
+
+    auto stage = pxr::UsdStage::CreateInMemory();
+    parseSdfWorldPrim(_world, stage, _path);
+    parseSdfWorldLights(_world, stage, _path, errors);
+
+    // The sublayers are added to a copy of the root layer that is not used
+    // by a stage, so they are not opened again
+    auto rootLayer = pxr::SdfLayer::CreateAnonymous();
+    rootLayer->TransferContent(stage->GetRootLayer());
+    rootLayer->SetSubLayerPaths(subLayerPaths);
+    if (!rootLayer->Export(_fileName, "", _args))
+    {
+      errors.push_back(UsdError(
+            sdf::usd::UsdErrorCode::SDF_TO_USD_PARSING_ERROR,
+            "Unable to save the world to [" + _fileName + "]"));
+    }
     return errors;
   }
 }
@@ -15,10 +15,15 @@
  *
  */
 
+#include <fstream>
+#include <iterator>
 #include <string>
 
 #include <gtest/gtest.h>
 
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Util.hh>
+
 // TODO(ahcorde) this is to remove deprecated "warnings" in usd, these warnings
 // are reported using #pragma message so normal diagnostic flags cannot remove
 // them. This workaround requires this block to be used whenever usd is
@@ -27,6 +32,7 @@
 #undef __DEPRECATED
 #include <pxr/base/gf/vec3f.h>
 #include <pxr/base/tf/token.h>
+#include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usd/primRange.h>
 #include <pxr/usd/usd/stage.h>
@@ -38,6 +44,7 @@
 #include "sdf/Root.hh"
 #include "test_config.h"
 #include "test_utils.hh"
+#include "../UsdTestUtils.hh"
 
 /////////////////////////////////////////////////
 // Fixture that creates a USD stage for each test case.
@@ -94,3 +101,138 @@ TEST_F(UsdStageFixture, World)
   EXPECT_TRUE(physicsScene.GetGravityMagnitudeAttr().Get(&gravityMagnitudeVal));
   EXPECT_FLOAT_EQ(gravityMagnitudeVal, 9.8f);
 }
+
+/////////////////////////////////////////////////
+TEST_F(UsdStageFixture, ConcurrentModels)
+{
+  sdf::setFindCallback(sdf::usd::testing::findFileCb);
+  ignition::common::addFindFileURICallback(
+    std::bind(&sdf::usd::testing::FindResourceUri, std::placeholders::_1));
+
+  const auto path = sdf::testing::TestFile("sdf", "basic_shapes.sdf");
+  sdf::Root root;
+
+  ASSERT_TRUE(sdf::testing::LoadSdfFile(path, root));
+  ASSERT_EQ(1u, root.WorldCount());
+  auto world = root.WorldByIndex(0u);
+  ASSERT_LT(1u, world->ModelCount());
+
+  const auto worldPath = std::string("/" + world->Name());
+  EXPECT_TRUE(sdf::usd::ParseSdfWorld(*world, stage, worldPath).empty());
+
+  auto concurrentStage = pxr::UsdStage::CreateInMemory();
+  ASSERT_TRUE(concurrentStage);
+  EXPECT_TRUE(sdf::usd::ParseSdfWorld(
+        *world, concurrentStage, worldPath, 4u).empty());
+
+  // The models have the same prims as when converted serially. Materials
+  // are numbered in the order they are converted, so only the prims of the
+  // world are compared.
+  const auto worldPrim = this->stage->GetPrimAtPath(pxr::SdfPath(worldPath));
+  ASSERT_TRUE(worldPrim);
+  unsigned int primCount = 0;
+  for (const auto &prim : pxr::UsdPrimRange(worldPrim))
+  {
+    const auto concurrentPrim =
+      concurrentStage->GetPrimAtPath(prim.GetPath());
+    ASSERT_TRUE(concurrentPrim) << prim.GetPath();
+    EXPECT_EQ(prim.GetTypeName(), concurrentPrim.GetTypeName())
+      << prim.GetPath();
+    EXPECT_EQ(prim.GetAuthoredProperties().size(),
+        concurrentPrim.GetAuthoredProperties().size()) << prim.GetPath();
+    ++primCount;
+  }
+  const auto concurrentWorldPrim =
+    concurrentStage->GetPrimAtPath(pxr::SdfPath(worldPath));
+  ASSERT_TRUE(concurrentWorldPrim);
+  const pxr::UsdPrimRange concurrentRange(concurrentWorldPrim);
+  EXPECT_EQ(primCount, static_cast<unsigned int>(
+        std::distance(concurrentRange.begin(), concurrentRange.end())));
+}
+
+/////////////////////////////////////////////////
+TEST_F(UsdStageFixture, ExportWithModelLayers)
+{
+  sdf::setFindCallback(sdf::usd::testing::findFileCb);
+  ignition::common::addFindFileURICallback(
+    std::bind(&sdf::usd::testing::FindResourceUri, std::placeholders::_1));
+
+  const auto path = sdf::testing::TestFile("sdf", "basic_shapes.sdf");
+  sdf::Root root;
+
+  ASSERT_TRUE(sdf::testing::LoadSdfFile(path, root));
+  ASSERT_EQ(1u, root.WorldCount());
+  auto world = root.WorldByIndex(0u);
+
+  const std::string fileName = ignition::common::joinPaths(
+      ignition::common::cwd(), "world_model_layers.usda");
+  const std::string layersDir = ignition::common::joinPaths(
+      ignition::common::cwd(), "world_model_layers_models");
+  sdf::testing::ScopeExit removeExport(
+      [&]
+      {
+        ignition::common::removeAll(layersDir);
+        ignition::common::removeFile(fileName);
+        ignition::common::removeAll(
+          ignition::common::joinPaths(ignition::common::cwd(), "materials"));
+      });
+
+  const auto worldPath = std::string("/" + world->Name());
+  EXPECT_TRUE(sdf::usd::ExportSdfWorldWithModelLayers(
+        *world, worldPath, fileName).empty());
+  EXPECT_TRUE(ignition::common::isFile(fileName));
+  EXPECT_TRUE(ignition::common::isDirectory(layersDir));
+
+  // Each model is in a sublayer of its own
+  auto rootLayer = pxr::SdfLayer::FindOrOpen(fileName);
+  ASSERT_TRUE(rootLayer);
+  EXPECT_EQ(world->ModelCount(), rootLayer->GetNumSubLayerPaths());
+  EXPECT_TRUE(rootLayer->GetPrimAtPath(pxr::SdfPath(worldPath + "/physics")));
+
+  // The composed stage has all the models, as when converting in memory
+  auto exported = pxr::UsdStage::Open(fileName);
+  ASSERT_TRUE(exported);
+  EXPECT_TRUE(sdf::usd::ParseSdfWorld(*world, stage, worldPath).empty());
+  const auto worldPrim = this->stage->GetPrimAtPath(pxr::SdfPath(worldPath));
+  ASSERT_TRUE(worldPrim);
+  for (const auto &prim : pxr::UsdPrimRange(worldPrim))
+  {
+    const auto exportedPrim = exported->GetPrimAtPath(prim.GetPath());
+    ASSERT_TRUE(exportedPrim) << prim.GetPath();
+    EXPECT_EQ(prim.GetTypeName(), exportedPrim.GetTypeName())
+      << prim.GetPath();
+  }
+  exported.Reset();
+  rootLayer.Reset();
+
+  // An incremental export reuses the layers of the models that did not
+  // change, which keeps the comment appended to one of them
+  const std::string boxLayer =
+    ignition::common::joinPaths(layersDir, "box.usda");
+  ASSERT_TRUE(ignition::common::isFile(boxLayer));
+  ASSERT_TRUE(ignition::common::isFile(
+        ignition::common::joinPaths(layersDir, "manifest.txt")));
+  {
+    std::ofstream layer(boxLayer, std::ios::app);
+    layer << "# reused\n";
+  }
+  auto hasComment = [&boxLayer]()
+  {
+    std::ifstream layer(boxLayer);
+    const std::string content((std::istreambuf_iterator<char>(layer)),
+        std::istreambuf_iterator<char>());
+    return content.find("# reused") != std::string::npos;
+  };
+  EXPECT_TRUE(sdf::usd::ExportSdfWorldWithModelLayers(
+        *world, worldPath, fileName, {}, true).empty());
+  EXPECT_TRUE(hasComment());
+  rootLayer = pxr::SdfLayer::FindOrOpen(fileName);
+  ASSERT_TRUE(rootLayer);
+  EXPECT_EQ(world->ModelCount(), rootLayer->GetNumSubLayerPaths());
+  rootLayer.Reset();
+
+  // A full export authors all the layers again
+  EXPECT_TRUE(sdf::usd::ExportSdfWorldWithModelLayers(
+        *world, worldPath, fileName).empty());
+  EXPECT_FALSE(hasComment());
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ignition/common/Filesystem.hh>
+
+// TODO(adlarkin) this is to remove deprecated "warnings" in usd, these warnings
+// are reported using #pragma message so normal diagnostic flags cannot remove
+// them. This workaround requires this block to be used whenever usd is
+// included.
+#pragma push_macro ("__DEPRECATED")
+#undef __DEPRECATED
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/stage.h>
+#pragma pop_macro ("__DEPRECATED")
+
+#include "sdf/Geometry.hh"
+#include "sdf/Mesh.hh"
+#include "sdf/Root.hh"
+#include "sdf/World.hh"
+#include "sdf/usd/sdf_parser/Geometry.hh"
+#include "sdf/usd/sdf_parser/World.hh"
+#include "test_config.h"
+#include "test_utils.hh"
+#include "usd_parser/USDWorld.hh"
+
+#include "performance/benchmark.hh"
+#include "performance/world_generator.hh"
+
+/////////////////////////////////////////////////
+/// \brief Load a generated world, expecting no errors.
+/// \param[in] _options Generator options.
+/// \param[out] _root Root to load the world into.
+/// \return The world, or nullptr if it could not be loaded.
+static const sdf::World *loadWorld(
+    const sdf::testing::WorldGeneratorOptions &_options, sdf::Root &_root)
+{
+  sdf::Errors errors = _root.LoadSdfString(
+      sdf::testing::GenerateWorld(_options));
+  EXPECT_TRUE(errors.empty()) << errors;
+  return _root.WorldByIndex(0u);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a temporary directory for the files of a benchmark.
+/// \param[in] _name Name of the directory.
+/// \return The directory, which is removed if it exists.
+static std::string benchmarkDir(const std::string &_name)
+{
+  std::string tmpDir;
+  EXPECT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string dir = ignition::common::joinPaths(tmpDir, _name);
+  ignition::common::removeAll(dir);
+  EXPECT_TRUE(ignition::common::createDirectories(dir));
+  return dir;
+}
+
+/////////////////////////////////////////////////
+TEST(UsdBenchmark, ParseSdfWorld)
+{
+  for (const int modelCount : {100, 1000})
+  {
+    sdf::testing::WorldGeneratorOptions options;
+    options.modelCount = modelCount;
+    sdf::Root root;
+    const sdf::World *world = loadWorld(options, root);
+    ASSERT_NE(nullptr, world);
+
+    const int iterations = modelCount >= 1000 ? 2 : 10;
+    for (const unsigned int threads : {1u, 0u})
+    {
+      benchmark("sdf2usd_world_" + std::to_string(modelCount) +
+          (threads == 1u ? "" : "_parallel"), iterations,
+          [&]()
+          {
+            auto stage = pxr::UsdStage::CreateInMemory();
+            EXPECT_TRUE(sdf::usd::ParseSdfWorld(
+                *world, stage, "/" + world->Name(), threads).empty());
+          });
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(UsdBenchmark, ParseSdfWorldWithMeshes)
+{
+  sdf::testing::WorldGeneratorOptions options;
+  options.modelCount = 1000;
+  options.meshUri = sdf::testing::TestFile("sdf", "box.dae");
+  sdf::Root root;
+  const sdf::World *world = loadWorld(options, root);
+  ASSERT_NE(nullptr, world);
+
+  // Every visual uses the same mesh, which is authored once per stage
+  benchmark("sdf2usd_mesh_world_" + std::to_string(options.modelCount), 2,
+      [&]()
+      {
+        auto stage = pxr::UsdStage::CreateInMemory();
+        EXPECT_TRUE(sdf::usd::ParseSdfWorld(
+            *world, stage, "/" + world->Name()).empty());
+      });
+}
+
+/////////////////////////////////////////////////
+TEST(UsdBenchmark, ParseSdfMeshGeometry)
+{
+  sdf::Mesh mesh;
+  mesh.SetUri(sdf::testing::TestFile("sdf", "box.dae"));
+  sdf::Geometry geometry;
+  geometry.SetType(sdf::GeometryType::MESH);
+  geometry.SetMeshShape(mesh);
+
+  // A new stage for each geometry, which authors the mesh every time
+  benchmark("sdf2usd_mesh_geometry", 100,
+      [&]()
+      {
+        auto stage = pxr::UsdStage::CreateInMemory();
+        EXPECT_TRUE(sdf::usd::ParseSdfGeometry(
+            geometry, stage, "/geometry").empty());
+      });
+
+  // Many geometries on the same stage, which reference the same mesh
+  const int instanceCount = 1000;
+  benchmark("sdf2usd_mesh_geometry_" + std::to_string(instanceCount) +
+      "_instances", 2,
+      [&]()
+      {
+        auto stage = pxr::UsdStage::CreateInMemory();
+        for (int i = 0; i < instanceCount; ++i)
+        {
+          EXPECT_TRUE(sdf::usd::ParseSdfGeometry(
+              geometry, stage, "/geometry_" + std::to_string(i)).empty());
+        }
+      });
+
+  // A new stage for each geometry, with the mesh read from the mesh cache
+  const std::string cacheDir = benchmarkDir("usd_benchmark_mesh_cache");
+  sdf::usd::SetMeshCacheDirectory(cacheDir);
+  sdf::testing::ScopeExit removeCache(
+      [&]
+      {
+        sdf::usd::SetMeshCacheDirectory("");
+        ignition::common::removeAll(cacheDir);
+      });
+  benchmark("sdf2usd_mesh_geometry_cached", 100,
+      [&]()
+      {
+        auto stage = pxr::UsdStage::CreateInMemory();
+        EXPECT_TRUE(sdf::usd::ParseSdfGeometry(
+            geometry, stage, "/geometry").empty());
+      });
+}
+
+/////////////////////////////////////////////////
+TEST(UsdBenchmark, ExportSdfWorldWithModelLayers)
+{
+  sdf::testing::WorldGeneratorOptions options;
+  options.modelCount = 1000;
+  sdf::Root root;
+  const sdf::World *world = loadWorld(options, root);
+  ASSERT_NE(nullptr, world);
+
+  const std::string dir = benchmarkDir("usd_benchmark_model_layers");
+  sdf::testing::ScopeExit removeDir(
+      [&]
+      {
+        ignition::common::removeAll(dir);
+      });
+  const std::string fileName =
+    ignition::common::joinPaths(dir, "world.usda");
+  const std::string modelCount = std::to_string(options.modelCount);
+
+  benchmark("sdf2usd_model_layers_" + modelCount, 2,
+      [&]()
+      {
+        EXPECT_TRUE(sdf::usd::ExportSdfWorldWithModelLayers(
+            *world, "/" + world->Name(), fileName).empty());
+      });
+
+  // Nothing changed since the previous export, so no model is converted
+  benchmark("sdf2usd_model_layers_incremental_" + modelCount, 2,
+      [&]()
+      {
+        EXPECT_TRUE(sdf::usd::ExportSdfWorldWithModelLayers(
+            *world, "/" + world->Name(), fileName, {}, true).empty());
+      });
+}
+
+/////////////////////////////////////////////////
+TEST(UsdBenchmark, ParseUsdWorld)
+{
+  const std::string dir = benchmarkDir("usd_benchmark_usd2sdf");
+  sdf::testing::ScopeExit removeDir(
+      [&]
+      {
+        ignition::common::removeAll(dir);
+      });
+
+  for (const int modelCount : {100, 1000})
+  {
+    // The USD files are written by sdf2usd from generated worlds
+    sdf::testing::WorldGeneratorOptions options;
+    options.modelCount = modelCount;
+    sdf::Root root;
+    const sdf::World *world = loadWorld(options, root);
+    ASSERT_NE(nullptr, world);
+    auto stage = pxr::UsdStage::CreateInMemory();
+    ASSERT_TRUE(sdf::usd::ParseSdfWorld(
+        *world, stage, "/" + world->Name()).empty());
+    stage->SetDefaultPrim(
+        stage->GetPrimAtPath(pxr::SdfPath("/" + world->Name())));
+    const std::string fileName = ignition::common::joinPaths(
+        dir, "world_" + std::to_string(modelCount) + ".usdc");
+    ASSERT_TRUE(stage->GetRootLayer()->Export(fileName));
+
+    benchmark("usd2sdf_world_" + std::to_string(modelCount),
+        modelCount >= 1000 ? 2 : 10,
+        [&]()
+        {
+          sdf::World usdWorld;
+          EXPECT_TRUE(sdf::usd::parseUSDWorld(fileName, usdWorld).empty());
+        });
+  }
+}
@@ -19,6 +19,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // TODO(ahcorde) this is to remove deprecated "warnings" in usd, these warnings
 // are reported using #pragma message so normal diagnostic flags cannot remove
@@ -26,8 +27,8 @@
 // included.
 #pragma push_macro ("__DEPRECATED")
 #undef __DEPRECATED
+#include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/usd/primCompositionQuery.h>
-#include <pxr/usd/usd/primRange.h>
 #include <pxr/usd/usdPhysics/scene.h>
 #include <pxr/usd/usdShade/material.h>
 #pragma pop_macro ("__DEPRECATED")
@@ -62,6 +63,18 @@ namespace usd {
       /// Materials availables in the stage and substages
       std::unordered_map<std::string, sdf::Material> materials;
 
+      /// The main stage, opened once by Init
+      pxr::UsdStageRefPtr stage;
+
+      /// Material prims of the main stage, found by Init
+      std::vector<pxr::UsdPrim> materialPrims;
+
+      /// Physics scene prims of the main stage, found by Init
+      std::vector<pxr::UsdPrim> physicsScenes;
+
+      /// Layers whose asset dependencies were already added as stages
+      std::set<pxr::SdfLayerHandle> visitedLayers;
+
       /// Add all subdirectories that are inside the stage folder
       /// This will help us to find other stages and/or textures.
       /// \param[in] _path Path of the subdirectory to add
@@ -114,23 +127,9 @@ namespace usd {
   {
     UsdErrors errors;
 
-    auto usdStage = std::make_shared<USDStage>(this->dataPtr->filename);
-    UsdErrors errorsInit = usdStage->Init();
-    if(!errorsInit.empty())
-    {
-      errors.insert(errors.end(), errorsInit.begin(), errorsInit.end());
-      return errors;
-    }
-
-    // Add the base stage to the structure
-    this->dataPtr->references.insert(
-      {this->dataPtr->filename,
-       usdStage
-      });
-
-    // it's the stage available
-    auto referencee = pxr::UsdStage::Open(this->dataPtr->filename);
-    if (!referencee)
+    // Open the main stage once, it is used by all the steps of the import
+    this->dataPtr->stage = pxr::UsdStage::Open(this->dataPtr->filename);
+    if (!this->dataPtr->stage)
     {
       errors.emplace_back(UsdError(
         sdf::usd::UsdErrorCode::INVALID_USD_FILE,
@@ -148,18 +147,22 @@ namespace usd {
 
     this->dataPtr->AddSubdirectories(this->dataPtr->directoryPath);
 
-    auto range = pxr::UsdPrimRange::Stage(referencee);
-
-    for (auto const &_prim : range)
+    // The metadata and paths of the main stage, its materials, physics
+    // scenes, models and references are all read in one traversal
+    this->dataPtr->materialPrims.clear();
+    this->dataPtr->physicsScenes.clear();
+    auto visitPrim = [this](const pxr::UsdPrim &_prim)
     {
       if (_prim.IsA<pxr::UsdShadeMaterial>())
       {
-        continue;
+        this->dataPtr->materialPrims.push_back(_prim);
+        return;
       }
 
       if (_prim.IsA<pxr::UsdPhysicsScene>())
       {
-        continue;
+        this->dataPtr->physicsScenes.push_back(_prim);
+        return;
       }
 
       std::string primName = pxr::TfStringify(_prim.GetPath());
@@ -178,13 +181,36 @@ namespace usd {
       {
         pxr::SdfLayerHandle handler = a.GetIntroducingLayer();
 
+        // The dependencies of a layer are the same for all the prims it
+        // introduces, so they are only added once
+        if (!this->dataPtr->visitedLayers.insert(handler).second)
+          continue;
+
         for (auto & ref : handler->GetCompositionAssetDependencies())
         {
-          this->AddStage(ref);
+          if (this->dataPtr->references.find(ref) ==
+              this->dataPtr->references.end())
+          {
+            this->AddStage(ref);
+          }
         }
       }
+    };
+
+    auto usdStage = std::make_shared<USDStage>(this->dataPtr->filename);
+    UsdErrors errorsInit = usdStage->Init(this->dataPtr->stage, visitPrim);
+    if(!errorsInit.empty())
+    {
+      errors.insert(errors.end(), errorsInit.begin(), errorsInit.end());
+      return errors;
     }
 
+    // Add the base stage to the structure
+    this->dataPtr->references.insert(
+      {this->dataPtr->filename,
+       usdStage
+      });
+
     return errors;
   }
 
@@ -192,8 +218,7 @@ namespace usd {
   UsdErrors USDData::ParseMaterials()
   {
     UsdErrors errors;
-    auto referencee = pxr::UsdStage::Open(this->dataPtr->filename);
-    if (!referencee)
+    if (!this->dataPtr->stage)
     {
       errors.emplace_back(UsdError(
         sdf::usd::UsdErrorCode::INVALID_USD_FILE,
@@ -201,39 +226,45 @@ namespace usd {
       return errors;
     }
 
-    auto range = pxr::UsdPrimRange::Stage(referencee);
-
-    for (auto const &prim : range)
+    for (auto const &prim : this->dataPtr->materialPrims)
     {
-      std::string primName = pxr::TfStringify(prim.GetPath());
-      if (prim.IsA<pxr::UsdShadeMaterial>())
-      {
-        std::string materialName = prim.GetName();
+      std::string materialName = prim.GetName();
 
-        if (this->dataPtr->materials.find(materialName)
-            != this->dataPtr->materials.end())
-        {
-          continue;
-        }
+      if (this->dataPtr->materials.find(materialName)
+          != this->dataPtr->materials.end())
+      {
+        continue;
+      }
 
-        sdf::Material material;
-        UsdErrors errrosMaterial = ParseMaterial(prim, material);
-        if (!errrosMaterial.empty())
-        {
-          errors.emplace_back(UsdError(
-            sdf::usd::UsdErrorCode::SDF_TO_USD_PARSING_ERROR,
-            "Error parsing material"));
-          errors.insert(
-            errors.end(), errrosMaterial.begin(), errrosMaterial.end());
-          return errors;
-        }
-        this->dataPtr->materials.insert(std::pair<std::string, sdf::Material>(
-          materialName, material));
+      sdf::Material material;
+      UsdErrors errrosMaterial = ParseMaterial(prim, material);
+      if (!errrosMaterial.empty())
+      {
+        errors.emplace_back(UsdError(
+          sdf::usd::UsdErrorCode::SDF_TO_USD_PARSING_ERROR,
+          "Error parsing material"));
+        errors.insert(
+          errors.end(), errrosMaterial.begin(), errrosMaterial.end());
+        return errors;
       }
+      this->dataPtr->materials.insert(std::pair<std::string, sdf::Material>(
+        materialName, material));
     }
     return errors;
   }
 
+  /////////////////////////////////////////////////
+  pxr::UsdStageRefPtr USDData::Stage() const
+  {
+    return this->dataPtr->stage;
+  }
+
+  /////////////////////////////////////////////////
+  const std::vector<pxr::UsdPrim> &USDData::PhysicsScenes() const
+  {
+    return this->dataPtr->physicsScenes;
+  }
+
   /////////////////////////////////////////////////
   const std::pair<std::string, std::shared_ptr<USDStage>>
     USDData::FindStage(const std::string &_name)
@@ -292,7 +323,7 @@ namespace usd {
 
       this->dataPtr->references.insert(
         {key,
-         std::make_shared<USDStage>(fileNameRef)
+         usdStage
         });
         return errors;
     }
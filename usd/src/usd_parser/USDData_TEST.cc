@@ -22,6 +22,15 @@
 
 #include <ignition/utilities/ExtraTestMacros.hh>
 
+// TODO(ahcorde) this is to remove deprecated "warnings" in usd, these warnings
+// are reported using #pragma message so normal diagnostic flags cannot remove
+// them. This workaround requires this block to be used whenever usd is
+// included.
+#pragma push_macro ("__DEPRECATED")
+#undef __DEPRECATED
+#include <pxr/usd/usdPhysics/scene.h>
+#pragma pop_macro ("__DEPRECATED")
+
 #include <sdf/usd/usd_parser/USDData.hh>
 #include <sdf/usd/UsdError.hh>
 
@@ -38,6 +47,8 @@ TEST(USDData, Constructor)
   sdf::usd::USDData data(sdf::testing::TestFile("usd", "invalid_name"));
   sdf::usd::UsdErrors errors = data.Init();
   EXPECT_EQ(1u, errors.size());
+  EXPECT_FALSE(data.Stage());
+  EXPECT_TRUE(data.PhysicsScenes().empty());
 
   // Add test/usd directory to find some resources
   auto systemPaths = ignition::common::systemPaths();
@@ -58,6 +69,9 @@ TEST(USDData, Constructor)
     EXPECT_EQ(0u, usdData.ParseMaterials().size());
 
     EXPECT_EQ(1u, usdData.AllReferences().size());
+    EXPECT_TRUE(usdData.Stage());
+    ASSERT_EQ(1u, usdData.PhysicsScenes().size());
+    EXPECT_TRUE(usdData.PhysicsScenes()[0].IsA<pxr::UsdPhysicsScene>());
     EXPECT_EQ(2u, usdData.Models().size());
     EXPECT_EQ(7u, usdData.Materials().size());
 
@@ -77,16 +77,25 @@ namespace usd
       return errors;
     }
 
+    return this->Init(referencee);
+  }
+
+  /////////////////////////////////////////////////
+  UsdErrors USDStage::Init(const pxr::UsdStageRefPtr &_stage,
+      const std::function<void(const pxr::UsdPrim &)> &_visitPrim)
+  {
+    UsdErrors errors;
+
     // Get meters per unit
     this->dataPtr->metersPerUnit =
-      pxr::UsdGeomGetStageMetersPerUnit(referencee);
+      pxr::UsdGeomGetStageMetersPerUnit(_stage);
 
     // is it up axis define, if so, read the value, if the value is
     // not 'Y' or 'Z' throw an exception
-    if (referencee->HasAuthoredMetadata(pxr::UsdGeomTokens->upAxis))
+    if (_stage->HasAuthoredMetadata(pxr::UsdGeomTokens->upAxis))
     {
       pxr::TfToken axis;
-      referencee->GetMetadata(pxr::UsdGeomTokens->upAxis, &axis);
+      _stage->GetMetadata(pxr::UsdGeomTokens->upAxis, &axis);
       this->dataPtr->upAxis = axis.GetText();
 
       if (this->dataPtr->upAxis != "Y" && this->dataPtr->upAxis != "Z")
@@ -100,9 +109,12 @@ namespace usd
     }
 
     // Keep all the USD paths
-    auto range = pxr::UsdPrimRange::Stage(referencee);
+    auto range = pxr::UsdPrimRange::Stage(_stage);
     for (auto const &_prim : range)
     {
+      if (_visitPrim)
+        _visitPrim(_prim);
+
       if (_prim.IsA<pxr::UsdShadeMaterial>())
       {
         continue;
@@ -22,7 +22,6 @@
 
 #pragma push_macro ("__DEPRECATED")
 #undef __DEPRECATED
-#include <pxr/usd/usd/primRange.h>
 #include <pxr/usd/usdPhysics/scene.h>
 #pragma pop_macro ("__DEPRECATED")
 
@@ -50,7 +49,7 @@ namespace usd
     if (!errors.empty())
       return errors;
 
-    auto reference = pxr::UsdStage::Open(_inputFileName);
+    auto reference = usdData.Stage();
     if (!reference)
     {
       errors.emplace_back(UsdErrorCode::INVALID_USD_FILE,
@@ -67,27 +66,22 @@ namespace usd
       _world.SetName(worldName + "_world");
     }
 
-    auto range = pxr::UsdPrimRange::Stage(reference);
-    for (auto const &prim : range)
+    for (auto const &prim : usdData.PhysicsScenes())
     {
       std::string primName = prim.GetName();
 
-      if (prim.IsA<pxr::UsdPhysicsScene>())
+      std::pair<std::string, std::shared_ptr<USDStage>> data =
+        usdData.FindStage(primName);
+      if (!data.second)
       {
-        std::pair<std::string, std::shared_ptr<USDStage>> data =
-          usdData.FindStage(primName);
-        if (!data.second)
-        {
-          errors.push_back(UsdError(UsdErrorCode::INVALID_PRIM_PATH,
-                "Unable to retrieve the pxr::UsdPhysicsScene named ["
-                + primName + "]"));
-          return errors;
-        }
-
-        ParseUSDPhysicsScene(pxr::UsdPhysicsScene(prim), _world,
-            data.second->MetersPerUnit());
-        continue;
+        errors.push_back(UsdError(UsdErrorCode::INVALID_PRIM_PATH,
+              "Unable to retrieve the pxr::UsdPhysicsScene named ["
+              + primName + "]"));
+        return errors;
       }
+
+      ParseUSDPhysicsScene(pxr::UsdPhysicsScene(prim), _world,
+          data.second->MetersPerUnit());
     }
 
     // Add some plugins to run the Ignition Gazebo simulation